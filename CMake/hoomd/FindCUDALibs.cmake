@@ -148,6 +148,26 @@ else()
     add_library(CUDA::nvToolsExt UNKNOWN IMPORTED)
 endif()
 
+if (HIP_PLATFORM STREQUAL "nvcc" AND ENABLE_CUPTI)
+    find_library(CUDA_cupti_LIBRARY cupti
+                 HINTS ${CUDA_LIB_PATH} "${CUDA_LIB_PATH}/../extras/CUPTI/lib64")
+    find_path(CUDA_cupti_INCLUDE_DIR cupti.h
+              HINTS ${CMAKE_CUDA_TOOLKIT_INCLUDE_DIRECTORIES}
+                    "${CUDA_LIB_PATH}/../extras/CUPTI/include")
+    mark_as_advanced(CUDA_cupti_LIBRARY CUDA_cupti_INCLUDE_DIR)
+    if(CUDA_cupti_LIBRARY AND CUDA_cupti_INCLUDE_DIR AND NOT TARGET CUDA::cupti)
+      add_library(CUDA::cupti UNKNOWN IMPORTED)
+      set_target_properties(CUDA::cupti PROPERTIES
+        IMPORTED_LOCATION "${CUDA_cupti_LIBRARY}"
+        INTERFACE_INCLUDE_DIRECTORIES "${CUDA_cupti_INCLUDE_DIR}"
+      )
+    endif()
+    list(APPEND REQUIRED_CUDA_LIB_VARS CUDA_cupti_LIBRARY CUDA_cupti_INCLUDE_DIR)
+else()
+    # cupti not supported by HIP
+    add_library(CUDA::cupti UNKNOWN IMPORTED)
+endif()
+
 if (HIP_PLATFORM STREQUAL "nvcc")
     find_library(CUDA_cusolver_LIBRARY cusolver HINTS ${CUDA_LIB_PATH})
     mark_as_advanced(CUDA_cusolver_LIBRARY)
@@ -255,6 +275,25 @@ if (HIP_PLATFORM STREQUAL "hip-clang" OR HIP_PLATFORM STREQUAL "hcc")
         INTERFACE_INCLUDE_DIRECTORIES "${HIP_roctracer_INCLUDE_DIR};${HIP_roctracer_INCLUDE_DIR}"
         )
     endif()
+
+    find_library(HIP_roctx_LIBRARY roctx64
+        PATHS
+        "${HIP_ROOT_DIR}"
+        ENV ROCM_PATH
+        ENV HIP_PATH
+        /opt/rocm
+        /opt/rocm/roctracer
+        PATH_SUFFIXES lib
+        NO_DEFAULT_PATH)
+
+    mark_as_advanced(HIP_roctx_LIBRARY)
+    if(HIP_roctx_LIBRARY AND NOT TARGET HIP::roctx)
+      add_library(HIP::roctx UNKNOWN IMPORTED)
+      set_target_properties(HIP::roctx PROPERTIES
+        IMPORTED_LOCATION "${HIP_roctx_LIBRARY}"
+        INTERFACE_INCLUDE_DIRECTORIES "${HIP_roctracer_INCLUDE_DIR}"
+        )
+    endif()
 endif()
 
 
@@ -0,0 +1,22 @@
+# Find the single precision FFTW3 library
+#
+# To use the FFTW3 interface of MKL, set FFTW_INCLUDE_DIR to the MKL fftw include directory
+# (e.g. ${MKLROOT}/include/fftw) and FFTW_LIBRARY to the MKL single dynamic library (mkl_rt).
+
+find_path(FFTW_INCLUDE_DIR fftw3.h)
+
+find_library(FFTW_LIBRARY fftw3f
+             HINTS ${FFTW_INCLUDE_DIR}/../lib )
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(FFTW
+                                  REQUIRED_VARS FFTW_LIBRARY FFTW_INCLUDE_DIR)
+
+mark_as_advanced(FFTW_INCLUDE_DIR FFTW_LIBRARY)
+
+if(FFTW_LIBRARY AND NOT TARGET FFTW::fftw3f)
+    add_library(FFTW::fftw3f UNKNOWN IMPORTED)
+    set_target_properties(FFTW::fftw3f PROPERTIES
+        IMPORTED_LOCATION "${FFTW_LIBRARY}"
+        INTERFACE_INCLUDE_DIRECTORIES "${FFTW_INCLUDE_DIR}")
+endif()
@@ -1,8 +1,12 @@
 option(ENABLE_NVTOOLS "Enable NVTools profiler integration" off)
+option(ENABLE_CUPTI "Count managed memory page faults with CUPTI" off)
 
 option(ALWAYS_USE_MANAGED_MEMORY "Use CUDA managed memory also when running on single GPU" OFF)
 MARK_AS_ADVANCED(ALWAYS_USE_MANAGED_MEMORY)
 
+option(GPU_PER_THREAD_DEFAULT_STREAM "Give each host thread its own default GPU stream" OFF)
+MARK_AS_ADVANCED(GPU_PER_THREAD_DEFAULT_STREAM)
+
 # setup CUDA compile options
 if (ENABLE_HIP)
     if (HIP_PLATFORM STREQUAL "nvcc")
@@ -44,8 +48,16 @@ if (ENABLE_HIP)
             set(CMAKE_CUDA_FLAGS "${CMAKE_CUDA_FLAGS} -gencode=arch=compute_${_cuda_max_arch},code=compute_${_cuda_max_arch}")
         endif()
 
+        if (GPU_PER_THREAD_DEFAULT_STREAM)
+            set(CMAKE_CUDA_FLAGS "${CMAKE_CUDA_FLAGS} --default-stream per-thread")
+        endif()
+
     elseif(HIP_PLATFORM STREQUAL "hip-clang")
         set(_cuda_min_arch 35)
+
+        if (GPU_PER_THREAD_DEFAULT_STREAM)
+            set(CMAKE_CUDA_FLAGS "${CMAKE_CUDA_FLAGS} -fgpu-default-stream=per-thread")
+        endif()
     endif()
 endif (ENABLE_HIP)
 
@@ -0,0 +1,213 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ADIOS2Writer.cc
+    \brief Defines the ADIOS2Writer class
+*/
+
+#include "ADIOS2Writer.h"
+
+#ifdef ENABLE_ADIOS2
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+/*! \param sysdef SystemDefinition containing the ParticleData to write
+    \param fname File (or stream) name to write to
+    \param group Group of particles to include in the output
+    \param engine ADIOS2 engine type, such as "BP5" or "SST"
+
+    The engine is not opened until the first call to analyze().
+*/
+ADIOS2Writer::ADIOS2Writer(std::shared_ptr<SystemDefinition> sysdef,
+                           const std::string& fname,
+                           std::shared_ptr<ParticleGroup> group,
+                           const std::string& engine)
+    : Analyzer(sysdef), m_fname(fname), m_engine_type(engine), m_group(group),
+#ifdef ENABLE_MPI
+      m_adios(m_exec_conf->getMPICommunicator()),
+#endif
+      m_is_initialized(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing ADIOS2Writer: " << fname << " " << engine
+                                << endl;
+    m_io = m_adios.DeclareIO("hoomd");
+    m_io.SetEngine(engine);
+    }
+
+ADIOS2Writer::~ADIOS2Writer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying ADIOS2Writer" << endl;
+
+    if (m_is_initialized)
+        {
+        m_engine.Close();
+        }
+    }
+
+/*! Open the engine, store the type names, and define the variables. The shapes and selections of
+    the per-particle variables are set on every step.
+*/
+void ADIOS2Writer::initIO()
+    {
+    m_exec_conf->msg->notice(3) << "ADIOS2: open " << m_engine_type << " engine " << m_fname
+                                << endl;
+
+    std::vector<std::string> type_mapping;
+    for (unsigned int i = 0; i < m_pdata->getNTypes(); i++)
+        type_mapping.push_back(m_pdata->getNameByType(i));
+    m_io.DefineAttribute<std::string>("particles/types",
+                                      type_mapping.data(),
+                                      type_mapping.size());
+
+    m_var_step = m_io.DefineVariable<uint64_t>("configuration/step");
+    m_var_box = m_io.DefineVariable<float>("configuration/box", {6}, {0}, {6});
+    m_var_tag = m_io.DefineVariable<uint32_t>("particles/tag", {0}, {0}, {0});
+    m_var_typeid = m_io.DefineVariable<uint32_t>("particles/typeid", {0}, {0}, {0});
+    m_var_position = m_io.DefineVariable<float>("particles/position", {0, 3}, {0, 0}, {0, 3});
+    m_var_image = m_io.DefineVariable<int32_t>("particles/image", {0, 3}, {0, 0}, {0, 3});
+
+    m_engine = m_io.Open(m_fname, adios2::Mode::Write);
+    m_is_initialized = true;
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    Each rank writes its local group members as one block of the global per-particle arrays.
+*/
+void ADIOS2Writer::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+    if (m_prof)
+        m_prof->push("Dump ADIOS2");
+
+    if (!m_is_initialized)
+        initIO();
+
+    bool root = true;
+#ifdef ENABLE_MPI
+    root = m_exec_conf->isRoot();
+#endif
+
+    // copy the local group members into the write buffers
+    const unsigned int n_local = m_group->getNumMembers();
+    m_tag.resize(n_local);
+    m_typeid.resize(n_local);
+    m_position.resize(3 * n_local);
+    m_image.resize(3 * n_local);
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+
+        const BoxDim& global_box = m_pdata->getGlobalBox();
+        const Scalar3 origin = m_pdata->getOrigin();
+        const int3 origin_image = m_pdata->getOriginImage();
+
+        for (unsigned int group_idx = 0; group_idx < n_local; group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
+
+            // shift and wrap the position the same way as ParticleData::takeSnapshot
+            Scalar3 pos = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z) - origin;
+            int3 img = h_image.data[j];
+            img.x -= origin_image.x;
+            img.y -= origin_image.y;
+            img.z -= origin_image.z;
+            global_box.wrap(pos, img);
+
+            m_tag[group_idx] = h_tag.data[j];
+            m_typeid[group_idx] = __scalar_as_int(h_pos.data[j].w);
+            m_position[3 * group_idx + 0] = float(pos.x);
+            m_position[3 * group_idx + 1] = float(pos.y);
+            m_position[3 * group_idx + 2] = float(pos.z);
+            m_image[3 * group_idx + 0] = img.x;
+            m_image[3 * group_idx + 1] = img.y;
+            m_image[3 * group_idx + 2] = img.z;
+            }
+        }
+
+    // place the block of this rank in the global arrays
+    size_t n_global = m_group->getNumMembersGlobal();
+    size_t offset = 0;
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        unsigned long long n = n_local;
+        unsigned long long start = 0;
+        MPI_Exscan(&n,
+                   &start,
+                   1,
+                   MPI_UNSIGNED_LONG_LONG,
+                   MPI_SUM,
+                   m_exec_conf->getMPICommunicator());
+        if (!root)
+            offset = size_t(start);
+        }
+#endif
+
+    m_var_tag.SetShape({n_global});
+    m_var_tag.SetSelection({{offset}, {size_t(n_local)}});
+    m_var_typeid.SetShape({n_global});
+    m_var_typeid.SetSelection({{offset}, {size_t(n_local)}});
+    m_var_position.SetShape({n_global, 3});
+    m_var_position.SetSelection({{offset, 0}, {size_t(n_local), 3}});
+    m_var_image.SetShape({n_global, 3});
+    m_var_image.SetSelection({{offset, 0}, {size_t(n_local), 3}});
+
+    m_engine.BeginStep();
+
+    if (root)
+        {
+        const BoxDim& box = m_pdata->getGlobalBox();
+        Scalar3 L = box.getL();
+        m_box = {float(L.x),
+                 float(L.y),
+                 float(L.z),
+                 float(box.getTiltFactorXY()),
+                 float(box.getTiltFactorXZ()),
+                 float(box.getTiltFactorYZ())};
+        m_engine.Put(m_var_step, timestep);
+        m_engine.Put(m_var_box, m_box.data());
+        }
+
+    m_engine.Put(m_var_tag, m_tag.data());
+    m_engine.Put(m_var_typeid, m_typeid.data());
+    m_engine.Put(m_var_position, m_position.data());
+    m_engine.Put(m_var_image, m_image.data());
+
+    m_engine.EndStep();
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+namespace detail
+    {
+void export_ADIOS2Writer(pybind11::module& m)
+    {
+    pybind11::class_<ADIOS2Writer, Analyzer, std::shared_ptr<ADIOS2Writer>>(m, "ADIOS2Writer")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::string,
+                            std::shared_ptr<ParticleGroup>,
+                            std::string>())
+        .def_property_readonly("filename", &ADIOS2Writer::getFilename)
+        .def_property_readonly("engine", &ADIOS2Writer::getEngine)
+        .def_property_readonly("filter",
+                               [](const std::shared_ptr<ADIOS2Writer> writer)
+                               { return writer->getGroup()->getFilter(); });
+    }
+
+    } // end namespace detail
+
+    } // end namespace hoomd
+
+#endif // ENABLE_ADIOS2
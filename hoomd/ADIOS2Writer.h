@@ -0,0 +1,113 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __ADIOS2_WRITER_H__
+#define __ADIOS2_WRITER_H__
+
+#ifdef ENABLE_ADIOS2
+
+#include "Analyzer.h"
+#include "ParticleGroup.h"
+
+#include <adios2.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*! \file ADIOS2Writer.h
+    \brief Declares the ADIOS2Writer class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+/// Analyzer that publishes the particle data through ADIOS2
+/*! ADIOS2Writer writes the group members owned by each rank directly through an ADIOS2 engine
+    without gathering them to the root rank. Each call to analyze() is one ADIOS2 step. The engine
+    is chosen at construction: "BP5" writes a file, while "SST" stages the steps in memory for
+    analysis codes that read them as they are produced.
+
+    The per-particle variables are global arrays of shape (N, M) and follow the naming of the GSD
+    HOOMD schema (particles/tag, particles/typeid, particles/position, and particles/image). Each
+    rank writes a contiguous block of rows, so the rows are in rank order rather than tag order and
+    readers should use particles/tag to identify particles. The step and box are written by the
+    root rank, and the type names are stored in the particles/types attribute.
+
+    The data are put in deferred mode from buffers owned by the writer, so the cost on the
+    simulation ranks is the copy of the local particles into these buffers and the copy made by
+    the engine at the end of the step.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT ADIOS2Writer : public Analyzer
+    {
+    public:
+    /// Construct the writer
+    ADIOS2Writer(std::shared_ptr<SystemDefinition> sysdef,
+                 const std::string& fname,
+                 std::shared_ptr<ParticleGroup> group,
+                 const std::string& engine);
+
+    /// Destructor
+    ~ADIOS2Writer();
+
+    /// Write out the data for the current timestep
+    void analyze(uint64_t timestep);
+
+    std::string getFilename()
+        {
+        return m_fname;
+        }
+
+    std::string getEngine()
+        {
+        return m_engine_type;
+        }
+
+    std::shared_ptr<ParticleGroup> getGroup()
+        {
+        return m_group;
+        }
+
+    private:
+    std::string m_fname;                    //!< The file (or stream) name
+    std::string m_engine_type;              //!< The ADIOS2 engine type
+    std::shared_ptr<ParticleGroup> m_group; //!< Group to write out
+
+    adios2::ADIOS m_adios;   //!< The ADIOS2 context
+    adios2::IO m_io;         //!< The IO object that declares the variables
+    adios2::Engine m_engine; //!< The engine writing the steps
+    bool m_is_initialized;   //!< True if the engine is open
+
+    adios2::Variable<uint64_t> m_var_step;   //!< configuration/step
+    adios2::Variable<float> m_var_box;       //!< configuration/box
+    adios2::Variable<uint32_t> m_var_tag;    //!< particles/tag
+    adios2::Variable<uint32_t> m_var_typeid; //!< particles/typeid
+    adios2::Variable<float> m_var_position;  //!< particles/position
+    adios2::Variable<int32_t> m_var_image;   //!< particles/image
+
+    std::vector<float> m_box;       //!< Buffer for the box
+    std::vector<uint32_t> m_tag;    //!< Buffer for the tags of the local group members
+    std::vector<uint32_t> m_typeid; //!< Buffer for the types of the local group members
+    std::vector<float> m_position;  //!< Buffer for the positions of the local group members
+    std::vector<int32_t> m_image;   //!< Buffer for the images of the local group members
+
+    /// Open the engine and define the variables
+    void initIO();
+    };
+
+namespace detail
+    {
+/// Exports the ADIOS2Writer class to python
+void export_ADIOS2Writer(pybind11::module& m);
+    } // end namespace detail
+
+    } // end namespace hoomd
+
+#endif // ENABLE_ADIOS2
+#endif // __ADIOS2_WRITER_H__
@@ -44,7 +44,8 @@ void export_Analyzer(pybind11::module& m)
         .def(pybind11::init<std::shared_ptr<SystemDefinition>>())
         .def("analyze", &Analyzer::analyze)
         .def("setProfiler", &Analyzer::setProfiler)
-        .def("notifyDetach", &Analyzer::notifyDetach);
+        .def("notifyDetach", &Analyzer::notifyDetach)
+        .def_property_readonly("execution_time", &Analyzer::getExecutionTime);
     }
 
     } // end namespace detail
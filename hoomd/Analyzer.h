@@ -17,6 +17,7 @@
 #define __ANALYZER_H__
 
 #include "Communicator.h"
+#include "DataDependencies.h"
 #include "Profiler.h"
 #include "SharedSignal.h"
 #include "SystemDefinition.h"
@@ -70,6 +71,16 @@ class PYBIND11_EXPORT Analyzer
         */
     virtual void analyze(uint64_t timestep) { }
 
+    //! Start copying the data that analyze() reads to the host
+    /*! \param timestep Time step that analyze() will be called on
+
+        System calls prefetch() on every analyzer that executes on a step before it calls the first
+        analyze(). Derived classes that read particle data on the host may override this to queue
+        asynchronous device to host copies (see GPUArray::prefetchToHost), so that the copies of
+        all arrays run back to back instead of each waiting for its own synchronous copy.
+    */
+    virtual void prefetch(uint64_t timestep) { }
+
     //! Sets the profiler for the analyzer to use
     void setProfiler(std::shared_ptr<Profiler> prof);
 
@@ -97,6 +108,16 @@ class PYBIND11_EXPORT Analyzer
         return PDataFlags(0);
         }
 
+    //! Get the data that analyze() reads and writes
+    /*! System executes analyzers that depend on none of the data the integrator accesses on a
+        worker thread, concurrently with the other analyzers. Derived classes should override this when they access
+        only a subset of the simulation data.
+    */
+    virtual DataDependencies getDataDependencies()
+        {
+        return DataDependencies();
+        }
+
     std::shared_ptr<const ExecutionConfiguration> getExecConf()
         {
         return m_exec_conf;
@@ -127,6 +148,18 @@ class PYBIND11_EXPORT Analyzer
     /// Python will notify C++ objects when they are detached from Simulation
     virtual void notifyDetach() {};
 
+    /// Get the total wall clock time spent executing this analyzer [s]
+    double getExecutionTime() const
+        {
+        return double(m_execution_time) / 1e9;
+        }
+
+    /// Add to the total execution time (System calls this after each analyze()) [ns]
+    void addExecutionTime(int64_t t)
+        {
+        m_execution_time += t;
+        }
+
     protected:
     const std::shared_ptr<SystemDefinition>
         m_sysdef; //!< The system definition this analyzer is associated with
@@ -138,6 +171,9 @@ class PYBIND11_EXPORT Analyzer
         m_exec_conf; //!< Stored shared ptr to the execution configuration
     std::vector<std::shared_ptr<hoomd::detail::SignalSlot>>
         m_slots; //!< Stored shared ptr to the system signals
+
+    /// Total wall clock time spent in analyze() [ns]
+    int64_t m_execution_time = 0;
     };
 
 namespace detail
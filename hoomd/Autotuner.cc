@@ -2,6 +2,7 @@
 // This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
 
 #include "Autotuner.h"
+#include "AutotunerCache.h"
 
 #ifdef ENABLE_MPI
 #include "HOOMDMPI.h"
@@ -58,6 +59,7 @@ Autotuner::Autotuner(const std::vector<unsigned int>& parameters,
         {
         m_samples[i].resize(m_nsamples);
         }
+    m_sampled.resize(m_parameters.size());
 
     m_current_param = m_parameters[m_current_element];
 
@@ -125,6 +127,7 @@ Autotuner::Autotuner(unsigned int start,
         {
         m_samples[i].resize(m_nsamples);
         }
+    m_sampled.resize(m_parameters.size());
 
     m_current_param = m_parameters[m_current_element];
 
@@ -138,6 +141,77 @@ Autotuner::Autotuner(unsigned int start,
     m_sync = false;
     }
 
+/*! \param dimensions List of valid values of each parameter
+    \param is_valid Returns true for valid combinations of parameter values, or nullptr to accept
+           all combinations
+    \param nsamples Number of time samples to take at each combination
+    \param period Number of calls to begin() before sampling is redone
+    \param name Descriptive name (used in messenger output)
+    \param exec_conf Execution configuration
+*/
+Autotuner::Autotuner(const std::vector<std::vector<unsigned int>>& dimensions,
+                     std::function<bool(const std::vector<unsigned int>&)> is_valid,
+                     unsigned int nsamples,
+                     unsigned int period,
+                     const std::string& name,
+                     std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    : m_nsamples(nsamples), m_period(period), m_enabled(true), m_name(name),
+      m_dimensions(dimensions), m_state(STARTUP), m_current_sample(0), m_current_element(0),
+      m_calls(0), m_current_param(0), m_exec_conf(exec_conf), m_mode(mode_median)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing Autotuner " << dimensions.size() << " "
+                                << nsamples << " " << period << " " << name << endl;
+
+    // ensure that m_nsamples is odd (so the median is easy to get). This also ensures that
+    // m_nsamples > 0.
+    if ((m_nsamples & 1) == 0)
+        m_nsamples += 1;
+
+    // enumerate the valid combinations, the last dimension varies fastest
+    bool empty = m_dimensions.size() == 0;
+    for (const auto& values : m_dimensions)
+        empty = empty || values.size() == 0;
+
+    std::vector<unsigned int> idx(m_dimensions.size(), 0);
+    std::vector<unsigned int> point(m_dimensions.size());
+    while (!empty)
+        {
+        for (unsigned int d = 0; d < m_dimensions.size(); d++)
+            point[d] = m_dimensions[d][idx[d]];
+
+        if (!is_valid || is_valid(point))
+            m_points.push_back(point);
+
+        int d = int(m_dimensions.size()) - 1;
+        while (d >= 0 && ++idx[d] == m_dimensions[d].size())
+            {
+            idx[d] = 0;
+            d--;
+            }
+        if (d < 0)
+            break;
+        }
+
+    if (m_points.size() == 0)
+        {
+        std::ostringstream s;
+        s << "Error initializing autotuner: Autotuner " << m_name << " got no valid parameters";
+        throw std::runtime_error(s.str());
+        }
+
+    m_point_samples.resize(m_points.size());
+    startScan();
+
+// create CUDA events
+#ifdef ENABLE_HIP
+    hipEventCreate(&m_start);
+    hipEventCreate(&m_stop);
+    CHECK_CUDA_ERROR();
+#endif
+
+    m_sync = false;
+    }
+
 Autotuner::~Autotuner()
     {
     m_exec_conf->msg->notice(5) << "Destroying Autotuner " << m_name << endl;
@@ -154,9 +228,13 @@ void Autotuner::begin()
     if (!m_enabled)
         return;
 
+    // start from the optimal parameter found by a previous run
+    if (!m_cache_checked)
+        beginWarmStart();
+
 #ifdef ENABLE_HIP
     // if we are scanning, record a cuda event - otherwise do nothing
-    if (m_state == STARTUP || m_state == SCANNING)
+    if (m_state == STARTUP || m_state == SCANNING || m_state == WARMSTART)
         {
         hipEventRecord(m_start, 0);
         if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -173,13 +251,14 @@ void Autotuner::end()
 
 #ifdef ENABLE_HIP
     // handle timing updates if scanning
-    if (m_state == STARTUP || m_state == SCANNING)
+    if (m_state == STARTUP || m_state == SCANNING || m_state == WARMSTART)
         {
         hipEventRecord(m_stop, 0);
         hipEventSynchronize(m_stop);
         hipEventElapsedTime(&m_samples[m_current_element][m_current_sample], m_start, m_stop);
         m_exec_conf->msg->notice(9)
-            << "Autotuner " << m_name << ": t(" << m_current_param << "," << m_current_sample
+            << "Autotuner " << m_name << ": t(" << formatParam(m_current_param) << ","
+            << m_current_sample
             << ") = " << m_samples[m_current_element][m_current_sample] << endl;
 
         if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -197,15 +276,20 @@ void Autotuner::end()
         if (m_current_sample >= m_nsamples)
             {
             m_current_sample = 0;
-            m_current_element++;
+            m_current_element = nextUnsampled(m_current_element + 1);
+
+            // with multiple parameters, move the coordinate descent on to the next line
+            bool done = m_current_element >= m_parameters.size()
+                        && (m_dimensions.empty() || advanceDescent());
 
             // if we hit the end of the elements, transition to the IDLE state and compute the
             // optimal parameter
-            if (m_current_element >= m_parameters.size())
+            if (done)
                 {
                 m_current_element = 0;
                 m_state = IDLE;
                 m_current_param = computeOptimalParameter();
+                storeOptimalParameter();
                 }
             else
                 {
@@ -234,6 +318,14 @@ void Autotuner::end()
             m_current_param = m_parameters[m_current_element];
             }
         }
+    else if (m_state == WARMSTART)
+        {
+        // sample the stored parameter repeatedly
+        m_current_sample++;
+
+        if (m_current_sample >= m_nsamples)
+            endWarmStart();
+        }
     else if (m_state == IDLE)
         {
         // increment the calls counter and see if we should transition to the scanning state
@@ -295,33 +387,7 @@ unsigned int Autotuner::computeOptimalParameter()
 #endif
         if (is_root)
             {
-            if (m_mode == mode_avg)
-                {
-                // compute average
-                float sum = 0.0f;
-                for (std::vector<float>::iterator it = v.begin(); it != v.end(); ++it)
-                    sum += *it;
-                m_sample_median[i] = sum / float(v.size());
-                }
-            else if (m_mode == mode_max)
-                {
-                // compute maximum
-                m_sample_median[i] = -FLT_MIN;
-                for (std::vector<float>::iterator it = v.begin(); it != v.end(); ++it)
-                    {
-                    if (*it > m_sample_median[i])
-                        {
-                        m_sample_median[i] = *it;
-                        }
-                    }
-                }
-            else
-                {
-                // compute median
-                size_t n = v.size() / 2;
-                nth_element(v.begin(), v.begin() + n, v.end());
-                m_sample_median[i] = v[n];
-                }
+            m_sample_median[i] = computeSampleTime(v);
             }
         }
 
@@ -354,8 +420,8 @@ unsigned int Autotuner::computeOptimalParameter()
         // unsigned int percent = int(max/min * 100.0f)-100;
 
         // print stats
-        m_exec_conf->msg->notice(4)
-            << "Autotuner " << m_name << " found optimal parameter " << opt << endl;
+        m_exec_conf->msg->notice(4) << "Autotuner " << m_name << " found optimal parameter "
+                                    << formatParam(opt) << endl;
         }
 
 #ifdef ENABLE_MPI
@@ -365,6 +431,315 @@ unsigned int Autotuner::computeOptimalParameter()
     return opt;
     }
 
+/*! \param samples Kernel times sampled for one parameter
+    \returns The median, average, or maximum of \a samples, depending on the sampling mode
+*/
+float Autotuner::computeSampleTime(std::vector<float> samples)
+    {
+    if (m_mode == mode_avg)
+        {
+        // compute average
+        float sum = 0.0f;
+        for (std::vector<float>::iterator it = samples.begin(); it != samples.end(); ++it)
+            sum += *it;
+        return sum / float(samples.size());
+        }
+    else if (m_mode == mode_max)
+        {
+        // compute maximum
+        float max = -FLT_MIN;
+        for (std::vector<float>::iterator it = samples.begin(); it != samples.end(); ++it)
+            {
+            if (*it > max)
+                {
+                max = *it;
+                }
+            }
+        return max;
+        }
+    else
+        {
+        // compute median
+        size_t n = samples.size() / 2;
+        nth_element(samples.begin(), samples.begin() + n, samples.end());
+        return samples[n];
+        }
+    }
+
+/*! Called on the first call to begin(). When the AutotunerCache holds a valid parameter for this
+    Autotuner, switch to the WARMSTART state to sample only that parameter.
+*/
+void Autotuner::beginWarmStart()
+    {
+    m_cache_checked = true;
+
+    const AutotunerCache& cache = m_exec_conf->getAutotunerCache();
+    if (!cache.isEnabled() || m_state != STARTUP || m_current_element != 0
+        || m_current_sample != 0)
+        return;
+
+    unsigned int parameter = 0;
+    float time = 0;
+    bool found = cache.lookup(m_name, parameter, time);
+
+#ifdef ENABLE_MPI
+    // all ranks must make the same choice when synchronizing
+    if (m_sync && m_exec_conf->getNRanks() > 1)
+        {
+        bcast(found, 0, m_exec_conf->getMPICommunicator());
+        bcast(parameter, 0, m_exec_conf->getMPICommunicator());
+        bcast(time, 0, m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    if (!found)
+        return;
+
+    // sample the stored point along with the points near it in the periodic scans
+    if (!m_dimensions.empty() && parameter < m_points.size())
+        setActiveSet(getCross(parameter));
+
+    // the stored parameter may not be valid for this build or device
+    auto it = std::find(m_parameters.begin(), m_parameters.end(), parameter);
+    if (it == m_parameters.end())
+        return;
+
+    m_current_element = (unsigned int)(it - m_parameters.begin());
+    m_current_param = parameter;
+    m_cached_time = time;
+    m_state = WARMSTART;
+
+    m_exec_conf->msg->notice(4) << "Autotuner " << m_name << " - warm start from cached parameter "
+                                << formatParam(parameter) << endl;
+    }
+
+/*! Accept the stored parameter when its sampled time has not drifted by more than the tolerance
+    of the AutotunerCache. Otherwise, fall back to a full initial scan.
+*/
+void Autotuner::endWarmStart()
+    {
+    float time = computeSampleTime(m_samples[m_current_element]);
+    int drifted
+        = time > m_cached_time * (1.0f + m_exec_conf->getAutotunerCache().getDriftTolerance());
+
+#ifdef ENABLE_MPI
+    if (m_sync && m_exec_conf->getNRanks() > 1)
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &drifted,
+                      1,
+                      MPI_INT,
+                      MPI_MAX,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    m_current_sample = 0;
+
+    if (drifted)
+        {
+        m_exec_conf->msg->notice(4)
+            << "Autotuner " << m_name << " - cached parameter " << formatParam(m_current_param)
+            << " took " << time << " ms instead of " << m_cached_time << " ms, beginning scan"
+            << endl;
+
+        startScan();
+        }
+    else
+        {
+        // the other parameters have not been sampled, so they lose until later scans sample them
+        for (unsigned int i = 0; i < m_parameters.size(); i++)
+            {
+            if (i != m_current_element)
+                std::fill(m_samples[i].begin(), m_samples[i].end(), FLT_MAX);
+            }
+
+        m_current_element = 0;
+        m_state = IDLE;
+
+        m_exec_conf->msg->notice(4) << "Autotuner " << m_name << " found optimal parameter "
+                                    << formatParam(m_current_param) << " in cache" << endl;
+        }
+    }
+
+/*! Called when the initial scan completes. Only the root rank writes the cache file.
+*/
+void Autotuner::storeOptimalParameter()
+    {
+    AutotunerCache& cache = m_exec_conf->getAutotunerCache();
+    if (!cache.isEnabled() || !m_exec_conf->isRoot())
+        return;
+
+    auto it = std::find(m_parameters.begin(), m_parameters.end(), m_current_param);
+    float time = m_sample_median[it - m_parameters.begin()];
+
+    if (!cache.store(m_name, m_current_param, time))
+        {
+        m_exec_conf->msg->warning() << "Autotuner " << m_name << " could not write "
+                                    << cache.getFilename() << endl;
+        }
+    }
+
+/*! Resets the coordinate descent when there are multiple parameters.
+*/
+void Autotuner::startScan()
+    {
+    m_state = STARTUP;
+    m_current_sample = 0;
+    m_current_element = 0;
+
+    if (!m_dimensions.empty())
+        {
+        for (auto& samples : m_point_samples)
+            samples.clear();
+
+        m_best_point = 0;
+        m_descent_dim = 0;
+        m_descent_changed = false;
+        setActiveSet(getLine(m_best_point, m_descent_dim));
+        }
+
+    m_current_param = m_parameters[m_current_element];
+    }
+
+/*! \param i Index to start from
+    \returns The index of the first unsampled element, or the number of elements if there is none
+*/
+unsigned int Autotuner::nextUnsampled(unsigned int i) const
+    {
+    while (i < m_parameters.size() && m_sampled[i])
+        i++;
+    return i;
+    }
+
+/*! \param points Indices into m_points
+
+    Points that were already sampled keep their samples and are not sampled again by the initial
+    scan.
+*/
+void Autotuner::setActiveSet(const std::vector<unsigned int>& points)
+    {
+    m_parameters = points;
+    m_samples.resize(points.size());
+    m_sample_median.assign(points.size(), 0.0f);
+    m_sampled.assign(points.size(), false);
+
+    for (unsigned int i = 0; i < points.size(); i++)
+        {
+        if (!m_point_samples[points[i]].empty())
+            {
+            m_samples[i] = m_point_samples[points[i]];
+            m_sampled[i] = true;
+            }
+        else
+            {
+            m_samples[i].assign(m_nsamples, 0.0f);
+            }
+        }
+    }
+
+/*! \param point Index into m_points
+    \param dim Dimension to vary
+    \returns Indices of the valid points, starting with \a point itself so that it wins ties
+*/
+std::vector<unsigned int> Autotuner::getLine(unsigned int point, unsigned int dim) const
+    {
+    std::vector<unsigned int> line(1, point);
+    for (unsigned int j = 0; j < m_points.size(); j++)
+        {
+        if (j == point)
+            continue;
+
+        bool on_line = true;
+        for (unsigned int d = 0; d < m_dimensions.size(); d++)
+            on_line = on_line && (d == dim || m_points[j][d] == m_points[point][d]);
+
+        if (on_line)
+            line.push_back(j);
+        }
+    return line;
+    }
+
+/*! \param point Index into m_points
+    \returns Indices of the valid points, starting with \a point itself so that it wins ties
+*/
+std::vector<unsigned int> Autotuner::getCross(unsigned int point) const
+    {
+    std::vector<unsigned int> cross(1, point);
+    for (unsigned int j = 0; j < m_points.size(); j++)
+        {
+        if (j == point)
+            continue;
+
+        unsigned int n_different = 0;
+        for (unsigned int d = 0; d < m_dimensions.size(); d++)
+            n_different += m_points[j][d] != m_points[point][d];
+
+        if (n_different <= 1)
+            cross.push_back(j);
+        }
+    return cross;
+    }
+
+/*! Called when all points on the current line have been sampled. Chooses the best point on the
+    line, then steps to the next line that has unsampled points. Because the best point is the
+    first element of each line, it changes only when another point is strictly faster, so the
+    descent terminates.
+
+    \returns true when the descent has converged. m_parameters then holds the points that differ
+    from the optimum in at most one dimension.
+*/
+bool Autotuner::advanceDescent()
+    {
+    while (true)
+        {
+        // remember the samples of the completed line
+        for (unsigned int i = 0; i < m_parameters.size(); i++)
+            m_point_samples[m_parameters[i]] = m_samples[i];
+
+        unsigned int best = computeOptimalParameter();
+        if (best != m_best_point)
+            {
+            m_best_point = best;
+            m_descent_changed = true;
+            }
+
+        m_descent_dim++;
+        if (m_descent_dim >= m_dimensions.size())
+            {
+            if (!m_descent_changed)
+                {
+                setActiveSet(getCross(m_best_point));
+                return true;
+                }
+
+            m_descent_dim = 0;
+            m_descent_changed = false;
+            }
+
+        setActiveSet(getLine(m_best_point, m_descent_dim));
+        m_current_element = nextUnsampled(0);
+        if (m_current_element < m_parameters.size())
+            return false;
+        }
+    }
+
+/*! \param param Element of m_parameters
+    \returns \a param, or the values of the point it refers to with multiple parameters
+*/
+std::string Autotuner::formatParam(unsigned int param) const
+    {
+    if (m_dimensions.empty())
+        return std::to_string(param);
+
+    std::ostringstream s;
+    s << "(";
+    for (unsigned int d = 0; d < m_points[param].size(); d++)
+        s << (d > 0 ? ", " : "") << m_points[param][d];
+    s << ")";
+    return s.str();
+    }
+
 namespace detail
     {
 void export_Autotuner(pybind11::module& m)
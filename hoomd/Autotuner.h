@@ -11,6 +11,7 @@
 
 #include "ExecutionConfiguration.h"
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -46,6 +47,24 @@ namespace hoomd
 
     Each Autotuner instance has a string name to help identify it's output on the notice stream.
 
+    **Multiple parameters** <br>
+    Kernels with more than one tunable parameter (such as block size and threads per particle)
+   construct the Autotuner with a list of values for each parameter and an optional validity filter
+   that rejects invalid combinations. getParams() returns the values of all parameters for the
+   kernel launch. Instead of sampling every valid combination, the initial scan performs a
+   coordinate descent: starting from the first valid combination, it samples all valid values of
+   one parameter while holding the others at the best combination found so far, then moves on to
+   the next parameter. Combinations are sampled at most once. The scan ends after a full cycle over
+   all parameters fails to improve the best combination. The periodic scans then sample the
+   combinations that differ from the optimum in at most one parameter.
+
+    When the AutotunerCache of the execution configuration is enabled, the first call to begin()
+   looks up the optimal parameter stored by a previous run under the same name, GPU model, and
+   system signature. The Autotuner then samples only that parameter. When its time is within the
+   drift tolerance of the stored time, the Autotuner skips the initial scan and returns the stored
+   parameter. Otherwise, it scans all parameters as usual. The result of every complete initial
+   scan is stored in the cache.
+
     Autotuner is not useful in non-GPU builds. Timing is performed with CUDA events and requires
    ENABLE_HIP=on. Behavior of Autotuner is undefined when ENABLE_HIP=off.
 
@@ -75,6 +94,14 @@ class PYBIND11_EXPORT Autotuner
               const std::string& name,
               std::shared_ptr<const ExecutionConfiguration> exec_conf);
 
+    /// Constructor with multiple parameters
+    Autotuner(const std::vector<std::vector<unsigned int>>& dimensions,
+              std::function<bool(const std::vector<unsigned int>&)> is_valid,
+              unsigned int nsamples,
+              unsigned int period,
+              const std::string& name,
+              std::shared_ptr<const ExecutionConfiguration> exec_conf);
+
     //! Destructor
     ~Autotuner();
 
@@ -95,6 +122,17 @@ class PYBIND11_EXPORT Autotuner
         return m_current_param;
         }
 
+    /// Get the values of all parameters to set for the kernel launch
+    /*! \returns One value for each dimension when the Autotuner was constructed with multiple
+        parameters, otherwise the single value returned by getParam().
+    */
+    std::vector<unsigned int> getParams() const
+        {
+        if (m_dimensions.empty())
+            return std::vector<unsigned int>(1, m_current_param);
+        return m_points[m_current_param];
+        }
+
     //! Check if tuner is enabled
     /*!
      * \returns True if enabled.
@@ -140,7 +178,7 @@ class PYBIND11_EXPORT Autotuner
      */
     bool isComplete()
         {
-        if (m_state != STARTUP)
+        if (m_state != STARTUP && m_state != WARMSTART)
             return true;
         else
             return false;
@@ -203,12 +241,46 @@ class PYBIND11_EXPORT Autotuner
     protected:
     unsigned int computeOptimalParameter();
 
+    /// Compute the kernel time of one parameter from its samples with the current mode
+    float computeSampleTime(std::vector<float> samples);
+
+    /// Start sampling the parameter stored in the AutotunerCache, if any
+    void beginWarmStart();
+
+    /// Finish the warm start after all samples of the stored parameter are taken
+    void endWarmStart();
+
+    /// Store the optimal parameter in the AutotunerCache
+    void storeOptimalParameter();
+
+    /// Begin the initial scan
+    void startScan();
+
+    /// Get the index of the first element of m_parameters at or after \a i that has no samples
+    unsigned int nextUnsampled(unsigned int i) const;
+
+    /// Replace m_parameters with the given points and restore their samples
+    void setActiveSet(const std::vector<unsigned int>& points);
+
+    /// Get the points that differ from \a point only in dimension \a dim
+    std::vector<unsigned int> getLine(unsigned int point, unsigned int dim) const;
+
+    /// Get the points that differ from \a point in at most one dimension
+    std::vector<unsigned int> getCross(unsigned int point) const;
+
+    /// Move the coordinate descent on to the next line with unsampled points
+    bool advanceDescent();
+
+    /// Format a parameter for messages
+    std::string formatParam(unsigned int param) const;
+
     //! State names
     enum State
         {
         STARTUP,
         IDLE,
-        SCANNING
+        SCANNING,
+        WARMSTART
         };
 
     // parameters
@@ -218,6 +290,15 @@ class PYBIND11_EXPORT Autotuner
     std::string m_name;                     //!< Descriptive name
     std::vector<unsigned int> m_parameters; //!< valid parameters
 
+    // multiple parameters, m_parameters holds indices into m_points
+    std::vector<std::vector<unsigned int>> m_dimensions; //!< Values of each parameter
+    std::vector<std::vector<unsigned int>> m_points;     //!< Valid combinations of values
+    std::vector<std::vector<float>> m_point_samples;     //!< Samples of each point, if taken
+    std::vector<bool> m_sampled;                         //!< True for sampled elements
+    unsigned int m_best_point = 0;                       //!< Best point found so far
+    unsigned int m_descent_dim = 0;                      //!< Dimension of the current line
+    bool m_descent_changed = false;                      //!< True if the best point changed
+
     // state info
     State m_state;                  //!< Current state
     unsigned int m_current_sample;  //!< Current sample taken
@@ -225,6 +306,9 @@ class PYBIND11_EXPORT Autotuner
     unsigned int m_calls;           //!< Count of the number of calls since the last sample
     unsigned int m_current_param;   //!< Value of the current parameter
 
+    bool m_cache_checked = false; //!< True after the AutotunerCache has been checked
+    float m_cached_time = 0;      //!< Kernel time stored in the AutotunerCache
+
     std::vector<std::vector<float>> m_samples; //!< Raw sample data for each element
     std::vector<float> m_sample_median;        //!< Current sample median for each element
 
@@ -0,0 +1,172 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "AutotunerCache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+
+/*! \file AutotunerCache.cc
+    \brief Definition of AutotunerCache
+*/
+
+namespace hoomd
+    {
+namespace
+    {
+/// Replace whitespace so that \a s can be written as a single token
+std::string sanitize(std::string s)
+    {
+    std::replace_if(
+        s.begin(),
+        s.end(),
+        [](char c) { return std::isspace(static_cast<unsigned char>(c)); },
+        '_');
+    return s;
+    }
+    } // end anonymous namespace
+
+AutotunerCache::AutotunerCache(const std::string& device) : m_device(sanitize(device)) { }
+
+/*! \param filename Name of the cache file, or an empty string to disable the cache
+
+    A missing file is not an error, it will be created by the first call to store().
+*/
+void AutotunerCache::setFilename(const std::string& filename)
+    {
+    m_filename = filename;
+    m_entries.clear();
+    read();
+    }
+
+/*! \param N Number of particles in the system
+    \param density Number density of the system
+*/
+void AutotunerCache::setSystem(unsigned int N, Scalar density)
+    {
+    m_N_bucket = 0;
+    while ((N >>= 1) > 0)
+        m_N_bucket++;
+
+    m_density = float(density);
+    }
+
+/*! \param r_cut Cutoff radius
+
+    The key includes the largest cutoff registered so far.
+*/
+void AutotunerCache::addCutoff(Scalar r_cut)
+    {
+    m_cutoff = std::max(m_cutoff, float(r_cut));
+    }
+
+/*! \param name Name of the Autotuner
+    \returns Key that identifies the Autotuner, the GPU model, and the system
+*/
+std::string AutotunerCache::getKey(const std::string& name) const
+    {
+    std::ostringstream s;
+    s << sanitize(name) << "/" << m_device << "/N2^" << m_N_bucket << "/rho"
+      << std::setprecision(2) << m_density << "/rc" << std::fixed << std::setprecision(1)
+      << m_cutoff;
+    return s.str();
+    }
+
+/*! \param name Name of the Autotuner
+    \param parameter Set to the stored optimal parameter
+    \param time Set to the stored kernel time of the optimal parameter
+    \returns true when the cache holds an entry for \a name
+*/
+bool AutotunerCache::lookup(const std::string& name, unsigned int& parameter, float& time) const
+    {
+    if (!isEnabled())
+        return false;
+
+    auto it = m_entries.find(getKey(name));
+    if (it == m_entries.end())
+        return false;
+
+    parameter = it->second.parameter;
+    time = it->second.time;
+    return true;
+    }
+
+/*! \param name Name of the Autotuner
+    \param parameter Optimal parameter
+    \param time Kernel time of the optimal parameter in milliseconds
+
+    Entries written to the file by other processes since it was last read are kept.
+
+    \returns false when the file could not be written
+*/
+bool AutotunerCache::store(const std::string& name, unsigned int parameter, float time)
+    {
+    if (!isEnabled())
+        return true;
+
+    read();
+    m_entries[getKey(name)] = Entry {parameter, time};
+
+    // write to a temporary file first so that readers never see a partially written cache
+    std::string tmp_filename = m_filename + ".tmp" + std::to_string(getpid());
+        {
+        std::ofstream f(tmp_filename);
+        if (!f.good())
+            return false;
+
+        for (const auto& entry : m_entries)
+            {
+            f << entry.first << " " << entry.second.parameter << " " << entry.second.time
+              << "\n";
+            }
+
+        if (!f.good())
+            {
+            std::remove(tmp_filename.c_str());
+            return false;
+            }
+        }
+
+    if (std::rename(tmp_filename.c_str(), m_filename.c_str()) != 0)
+        {
+        std::remove(tmp_filename.c_str());
+        return false;
+        }
+
+    return true;
+    }
+
+void AutotunerCache::read()
+    {
+    std::ifstream f(m_filename);
+    std::string line;
+    while (std::getline(f, line))
+        {
+        std::istringstream s(line);
+        std::string key;
+        Entry entry;
+        if (s >> key >> entry.parameter >> entry.time)
+            m_entries[key] = entry;
+        }
+    }
+
+namespace detail
+    {
+void export_AutotunerCache(pybind11::module& m)
+    {
+    pybind11::class_<AutotunerCache>(m, "AutotunerCache")
+        .def_property("filename", &AutotunerCache::getFilename, &AutotunerCache::setFilename)
+        .def_property("drift_tolerance",
+                      &AutotunerCache::getDriftTolerance,
+                      &AutotunerCache::setDriftTolerance);
+    }
+
+    } // end namespace detail
+
+    } // end namespace hoomd
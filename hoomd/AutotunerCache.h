@@ -0,0 +1,117 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "HOOMDMath.h"
+
+#include <map>
+#include <string>
+
+#ifndef __HIPCC__
+#include <pybind11/pybind11.h>
+#endif
+
+/*! \file AutotunerCache.h
+    \brief Declaration of AutotunerCache
+*/
+
+namespace hoomd
+    {
+/// Persistent store of optimal autotuner parameters
+/*! Many short simulations of similar systems on the same GPU model tune their kernels to the same
+    parameters. AutotunerCache stores the optimal parameter and its kernel time for each Autotuner
+    in a text file so that later runs can start from the stored optimum instead of scanning all
+    parameters.
+
+    Entries are keyed by the Autotuner name, the GPU model, and a coarse signature of the system:
+    the number of particles rounded down to a power of 2, the number density rounded to 2
+    significant digits, and the largest neighbor list cutoff rounded to 0.1. System sets the
+    particle number and density at the start of every run and NeighborList registers its cutoffs.
+
+    The file is read when the file name is set. store() merges the new entry with the current
+    contents of the file and atomically replaces it, so concurrent jobs sharing one file may lose
+    each other's updates but never corrupt it. The cache is disabled when the file name is empty.
+
+    Each line of the file lists the key, the parameter, and the kernel time in milliseconds.
+*/
+class PYBIND11_EXPORT AutotunerCache
+    {
+    public:
+    /// Constructor
+    /*! \param device Description of the GPU model that the kernel times refer to
+     */
+    AutotunerCache(const std::string& device);
+
+    /// Set the name of the cache file and read its entries
+    void setFilename(const std::string& filename);
+
+    /// Get the name of the cache file
+    std::string getFilename() const
+        {
+        return m_filename;
+        }
+
+    /// Test if the cache is enabled
+    bool isEnabled() const
+        {
+        return !m_filename.empty();
+        }
+
+    /// Set the size and density of the system included in the keys
+    void setSystem(unsigned int N, Scalar density);
+
+    /// Register a neighbor list cutoff included in the keys
+    void addCutoff(Scalar r_cut);
+
+    /// Get the relative increase in kernel time that triggers a new scan
+    float getDriftTolerance() const
+        {
+        return m_drift_tolerance;
+        }
+
+    /// Set the relative increase in kernel time that triggers a new scan
+    void setDriftTolerance(float drift_tolerance)
+        {
+        m_drift_tolerance = drift_tolerance;
+        }
+
+    /// Get the key of the named Autotuner for the current system
+    std::string getKey(const std::string& name) const;
+
+    /// Look up the optimal parameter of the named Autotuner
+    bool lookup(const std::string& name, unsigned int& parameter, float& time) const;
+
+    /// Store the optimal parameter of the named Autotuner and write the file
+    bool store(const std::string& name, unsigned int parameter, float time);
+
+    private:
+    /// An optimal parameter and its kernel time
+    struct Entry
+        {
+        unsigned int parameter; //!< Optimal parameter
+        float time;             //!< Kernel time in milliseconds
+        };
+
+    /// Read entries from the file, replacing those in memory with the same key
+    void read();
+
+    std::string m_device;           //!< GPU model
+    std::string m_filename;         //!< Name of the cache file
+    unsigned int m_N_bucket = 0;    //!< Base 2 logarithm of the number of particles
+    float m_density = 0;            //!< Number density of the system
+    float m_cutoff = 0;             //!< Largest registered cutoff
+    float m_drift_tolerance = 0.2f; //!< Relative time increase that triggers a new scan
+
+    std::map<std::string, Entry> m_entries; //!< Entries by key
+    };
+
+namespace detail
+    {
+#ifndef __HIPCC__
+/// Export the AutotunerCache class to python
+void export_AutotunerCache(pybind11::module& m);
+#endif
+
+    } // end namespace detail
+    } // end namespace hoomd
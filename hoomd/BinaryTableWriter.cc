@@ -0,0 +1,180 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file BinaryTableWriter.cc
+    \brief Defines the BinaryTableWriter class
+*/
+
+#include "BinaryTableWriter.h"
+
+#include <pybind11/numpy.h>
+
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace detail
+    {
+//! simple helper function to write an integer
+/*! \param file file to write to
+    \param val integer to write
+*/
+static void write_uint32(fstream& file, uint32_t val)
+    {
+    file.write((char*)&val, sizeof(uint32_t));
+    }
+    } // end namespace detail
+
+/*! \param sysdef SystemDefinition of the simulation
+    \param fname File name to write to, an existing file is overwritten
+    \param buffer_rows Number of rows to buffer before writing them to the file
+
+    The file is not opened until the first call to analyze().
+*/
+BinaryTableWriter::BinaryTableWriter(std::shared_ptr<SystemDefinition> sysdef,
+                                     const std::string& fname,
+                                     unsigned int buffer_rows)
+    : Analyzer(sysdef), m_fname(fname), m_buffer_rows(buffer_rows), m_is_initialized(false),
+      m_n_columns(0), m_row_size(0), m_n_buffered(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing BinaryTableWriter: " << fname << " "
+                                << buffer_rows << endl;
+    if (m_buffer_rows == 0)
+        {
+        throw invalid_argument("BinaryTable: buffer_rows must be positive");
+        }
+    m_log_writer = pybind11::none();
+    }
+
+BinaryTableWriter::~BinaryTableWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying BinaryTableWriter" << endl;
+
+    if (m_is_initialized)
+        {
+        try
+            {
+            flush();
+            }
+        catch (const std::exception& e)
+            {
+            m_exec_conf->msg->error() << e.what() << endl;
+            }
+        m_file.close();
+        }
+    }
+
+/*! Opens the file, writes the column names, and allocates the row buffer.
+ */
+void BinaryTableWriter::initFileIO()
+    {
+    pybind11::list names = m_log_writer.attr("names")();
+    m_n_columns = (unsigned int)pybind11::len(names);
+    m_row_size = sizeof(uint64_t) + m_n_columns * sizeof(double);
+    m_buffer.resize(m_row_size * m_buffer_rows);
+    m_n_buffered = 0;
+
+    m_exec_conf->msg->notice(3) << "BinaryTable: create or overwrite file " << m_fname << endl;
+    m_file.open(m_fname.c_str(), ios::trunc | ios::out | ios::binary);
+
+    char magic[] = "HOOMDTBL";
+    m_file.write(magic, 8);
+    detail::write_uint32(m_file, 1);
+    detail::write_uint32(m_file, m_n_columns);
+    for (auto name_obj : names)
+        {
+        std::string name = pybind11::cast<std::string>(name_obj);
+        detail::write_uint32(m_file, (uint32_t)name.size());
+        m_file.write(name.data(), name.size());
+        }
+
+    if (!m_file.good())
+        {
+        throw runtime_error("BinaryTable: I/O error while writing the header of " + m_fname);
+        }
+    m_is_initialized = true;
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void BinaryTableWriter::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+    if (m_log_writer.is_none())
+        return;
+
+    // all ranks take part in evaluating the loggables
+    pybind11::object values_obj = m_log_writer.attr("values")();
+
+#ifdef ENABLE_MPI
+    if (!m_exec_conf->isRoot())
+        return;
+#endif
+
+    if (m_prof)
+        m_prof->push("BinaryTable");
+
+    if (!m_is_initialized)
+        initFileIO();
+
+    auto values = pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast>(
+        values_obj);
+    if ((unsigned int)values.size() != m_n_columns)
+        {
+        throw runtime_error("BinaryTable: The number of logged quantities changed");
+        }
+
+    char* row = m_buffer.data() + m_n_buffered * m_row_size;
+    memcpy(row, &timestep, sizeof(uint64_t));
+    memcpy(row + sizeof(uint64_t), values.data(), m_n_columns * sizeof(double));
+    m_n_buffered++;
+
+    if (m_n_buffered == m_buffer_rows)
+        flush();
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! Writes the buffered rows to the file and flushes the file.
+ */
+void BinaryTableWriter::flush()
+    {
+    if (!m_is_initialized)
+        return;
+
+    if (m_n_buffered > 0)
+        {
+        m_file.write(m_buffer.data(), m_n_buffered * m_row_size);
+        m_n_buffered = 0;
+        }
+    m_file.flush();
+
+    if (!m_file.good())
+        {
+        throw runtime_error("BinaryTable: I/O error while writing " + m_fname);
+        }
+    }
+
+namespace detail
+    {
+void export_BinaryTableWriter(pybind11::module& m)
+    {
+    pybind11::class_<BinaryTableWriter, Analyzer, std::shared_ptr<BinaryTableWriter>>(
+        m,
+        "BinaryTableWriter")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>, std::string, unsigned int>())
+        .def("flush", &BinaryTableWriter::flush)
+        .def_property("log_writer",
+                      &BinaryTableWriter::getLogWriter,
+                      &BinaryTableWriter::setLogWriter)
+        .def_property_readonly("filename", &BinaryTableWriter::getFilename)
+        .def_property_readonly("buffer_rows", &BinaryTableWriter::getBufferRows);
+    }
+
+    } // end namespace detail
+
+    } // end namespace hoomd
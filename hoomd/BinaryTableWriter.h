@@ -0,0 +1,117 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "Analyzer.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*! \file BinaryTableWriter.h
+    \brief Declares the BinaryTableWriter class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+/// Analyzer that writes logged scalar quantities to a binary table
+/*! BinaryTableWriter evaluates the log writer on every call to analyze() and appends the values
+    to a preallocated row buffer on the root rank. Rows are written to the file only when the
+    buffer is full, when flush() is called, and when the writer is destroyed. No values are
+    formatted as text.
+
+    The file starts with the 8 byte magic string HOOMDTBL, the uint32 format version, and the
+    uint32 number of columns, followed by the name of each column as a uint32 length and the
+    characters of the name. Each row is the uint64 timestep followed by the float64 value of each
+    column. All values are little endian.
+
+    The log writer is a Python object that provides names(), which returns the list of column
+    names, and values(), which returns the row of values as a sequence of floats. values() is
+    called on all ranks because evaluating a loggable may require collective communication.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT BinaryTableWriter : public Analyzer
+    {
+    public:
+    /// Construct the writer
+    BinaryTableWriter(std::shared_ptr<SystemDefinition> sysdef,
+                      const std::string& fname,
+                      unsigned int buffer_rows);
+
+    /// Destructor
+    ~BinaryTableWriter();
+
+    /// Buffer the logged quantities for the current timestep
+    void analyze(uint64_t timestep);
+
+    /// Write the buffered rows to the file
+    void flush();
+
+    std::string getFilename()
+        {
+        return m_fname;
+        }
+
+    unsigned int getBufferRows()
+        {
+        return m_buffer_rows;
+        }
+
+    /// Set the log writer
+    void setLogWriter(pybind11::object log_writer)
+        {
+        m_log_writer = log_writer;
+        }
+
+    /// Get the log writer
+    pybind11::object getLogWriter()
+        {
+        return m_log_writer;
+        }
+
+    /// Get needed pdata flags
+    virtual PDataFlags getRequestedPDataFlags()
+        {
+        PDataFlags flags;
+
+        if (!m_log_writer.is_none())
+            {
+            flags.set();
+            }
+
+        return flags;
+        }
+
+    private:
+    std::string m_fname;        //!< The file name we are writing to
+    unsigned int m_buffer_rows; //!< Number of rows buffered before they are written
+    std::fstream m_file;        //!< The file object
+    bool m_is_initialized;      //!< True if the file is open
+
+    pybind11::object m_log_writer; //!< Python object that evaluates the logged quantities
+
+    unsigned int m_n_columns;   //!< Number of logged quantities in a row
+    size_t m_row_size;          //!< Size of a row in bytes
+    std::vector<char> m_buffer; //!< Rows waiting to be written
+    unsigned int m_n_buffered;  //!< Number of rows in m_buffer
+
+    /// Open the file and write the header
+    void initFileIO();
+    };
+
+namespace detail
+    {
+/// Exports the BinaryTableWriter class to python
+void export_BinaryTableWriter(pybind11::module& m);
+    } // end namespace detail
+
+    } // end namespace hoomd
@@ -12,6 +12,7 @@
 #include "ParticleData.h"
 
 #include <pybind11/numpy.h>
+#include <pybind11/stl.h>
 
 #ifdef ENABLE_HIP
 #include "BondedGroupData.cuh"
@@ -216,6 +217,23 @@ template<unsigned int group_size, typename Group, const char* name, bool has_typ
 void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromSnapshot(
     const Snapshot& snapshot)
     {
+    initializeReplicated(snapshot, 1, 0);
+    }
+
+/*! \param snapshot Snapshot of the groups in one copy of the system
+    \param n_replicas Number of copies of the system
+    \param n_particles Number of particles in one copy of the system
+
+    Copy r of group g refers to the particles with tags offset by r * n_particles, and the groups
+    are added in order of copy, the same order as Snapshot::replicate(). In MPI simulations, only
+    the groups of one copy are broadcast from the root rank.
+*/
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeReplicated(
+    const Snapshot& snapshot,
+    unsigned int n_replicas,
+    unsigned int n_particles)
+    {
     // check that all fields in the snapshot have correct length
     if (m_exec_conf->getRank() == 0 && !snapshot.validate())
         {
@@ -227,6 +245,9 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromS
     // re-initialize data structures
     initialize();
 
+    // observers rebuild their state from the number change signal instead of following each group
+    m_notify_group_changes = false;
+
 #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
@@ -268,35 +289,43 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromS
         bcast(m_type_mapping, 0, m_exec_conf->getMPICommunicator());
 
         // iterate over groups and add those that have local particles
-        for (unsigned int group_tag = 0; group_tag < all_groups.size(); ++group_tag)
-            addBondedGroup(Group(all_typeval[group_tag], all_groups[group_tag]));
+        for (unsigned int r = 0; r < n_replicas; ++r)
+            for (unsigned int group_tag = 0; group_tag < all_groups.size(); ++group_tag)
+                {
+                members_t members = all_groups[group_tag];
+                for (unsigned int j = 0; j < group_size; ++j)
+                    members.tag[j] += r * n_particles;
+                addBondedGroup(Group(all_typeval[group_tag], members));
+                }
         }
     else
 #endif
         {
         m_type_mapping = snapshot.type_mapping;
 
-        if (has_type_mapping)
-            {
-            // create bonded groups with types
+        for (unsigned int r = 0; r < n_replicas; ++r)
             for (unsigned group_idx = 0; group_idx < snapshot.groups.size(); group_idx++)
                 {
                 typeval_t t;
-                t.type = snapshot.type_id[group_idx];
-                addBondedGroup(Group(t, snapshot.groups[group_idx]));
-                }
-            }
-        else
-            {
-            // create constraints
-            for (unsigned group_idx = 0; group_idx < snapshot.groups.size(); group_idx++)
-                {
-                typeval_t t;
-                t.val = snapshot.val[group_idx];
-                addBondedGroup(Group(t, snapshot.groups[group_idx]));
+                if (has_type_mapping)
+                    {
+                    // create bonded groups with types
+                    t.type = snapshot.type_id[group_idx];
+                    }
+                else
+                    {
+                    // create constraints
+                    t.val = snapshot.val[group_idx];
+                    }
+
+                members_t members = snapshot.groups[group_idx];
+                for (unsigned int j = 0; j < group_size; ++j)
+                    members.tag[j] += r * n_particles;
+                addBondedGroup(Group(t, members));
                 }
-            }
         }
+
+    m_notify_group_changes = true;
     }
 
 template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
@@ -419,12 +448,83 @@ unsigned int BondedGroupData<group_size, Group, name, has_type_mapping>::addBond
     m_nglobal++;
 
     // notify observers
-    m_group_num_change_signal.emit();
-    notifyGroupReorder();
+    if (m_notify_group_changes)
+        m_group_change_signal.emit(member_tags, true);
+    if (!m_batch_group_changes)
+        {
+        m_group_num_change_signal.emit();
+        notifyGroupReorder();
+        }
 
     return tag;
     }
 
+/*! The number change and reorder signals are emitted once for the whole batch, so the GPU table
+    and the observers of the group number are updated once. The group change signal is emitted for
+    each group.
+*/
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+std::vector<unsigned int>
+BondedGroupData<group_size, Group, name, has_type_mapping>::addBondedGroups(
+    const std::vector<Group>& groups)
+    {
+    std::vector<unsigned int> tags;
+    tags.reserve(groups.size());
+
+    m_batch_group_changes = true;
+    try
+        {
+        for (const Group& g : groups)
+            tags.push_back(addBondedGroup(g));
+        }
+    catch (...)
+        {
+        m_batch_group_changes = false;
+        m_group_num_change_signal.emit();
+        notifyGroupReorder();
+        throw;
+        }
+    m_batch_group_changes = false;
+
+    if (groups.size())
+        {
+        m_group_num_change_signal.emit();
+        notifyGroupReorder();
+        }
+
+    return tags;
+    }
+
+/*! \param group_tags Tags of the bonded groups to remove
+
+    See addBondedGroups().
+*/
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::removeBondedGroups(
+    const std::vector<unsigned int>& group_tags)
+    {
+    m_batch_group_changes = true;
+    try
+        {
+        for (unsigned int tag : group_tags)
+            removeBondedGroup(tag);
+        }
+    catch (...)
+        {
+        m_batch_group_changes = false;
+        m_group_num_change_signal.emit();
+        notifyGroupReorder();
+        throw;
+        }
+    m_batch_group_changes = false;
+
+    if (group_tags.size())
+        {
+        m_group_num_change_signal.emit();
+        notifyGroupReorder();
+        }
+    }
+
 //! Return the nth active global tag
 /*! \param n Index of bond in global bond table
  */
@@ -597,6 +697,9 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::removeBondedGro
         throw runtime_error(s.str());
         }
 
+    // the members are needed to notify observers, fetch them before the group is gone
+    members_t member_tags = getGroupByTag(tag).get_members();
+
     // delete from map
     m_group_rtag[tag] = GROUP_NOT_LOCAL;
 
@@ -638,8 +741,12 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::removeBondedGro
     m_nglobal--;
 
     // notify observers
-    m_group_num_change_signal.emit();
-    notifyGroupReorder();
+    m_group_change_signal.emit(member_tags, false);
+    if (!m_batch_group_changes)
+        {
+        m_group_num_change_signal.emit();
+        notifyGroupReorder();
+        }
     }
 
 /*! \param name Type name
@@ -1317,6 +1424,8 @@ void export_BondedGroupData(pybind11::module& m,
         .def("getNameByType", &T::getNameByType)
         .def("addBondedGroup", &T::addBondedGroup)
         .def("removeBondedGroup", &T::removeBondedGroup)
+        .def("addBondedGroups", &T::addBondedGroups)
+        .def("removeBondedGroups", &T::removeBondedGroups)
         .def("setProfiler", &T::setProfiler)
         .def("getTypes", &T::getTypesPy);
 
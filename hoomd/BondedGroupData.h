@@ -255,6 +255,11 @@ class BondedGroupData
     //! Initialize from a snapshot
     virtual void initializeFromSnapshot(const Snapshot& snapshot);
 
+    //! Initialize from copies of a snapshot
+    void initializeReplicated(const Snapshot& snapshot,
+                              unsigned int n_replicas,
+                              unsigned int n_particles);
+
     //! Take a snapshot
     virtual std::map<unsigned int, unsigned int> takeSnapshot(Snapshot& snapshot) const;
 
@@ -580,6 +585,17 @@ class BondedGroupData
      */
     void removeBondedGroup(unsigned int group_tag);
 
+    //! Add a batch of bonded groups on all processors
+    /*! \param groups Definitions of the groups to add
+        \returns The tags of the added groups
+    */
+    std::vector<unsigned int> addBondedGroups(const std::vector<Group>& groups);
+
+    //! Remove a batch of bonded groups from all processors
+    /*! \param group_tags Tags of the bonded groups to remove
+     */
+    void removeBondedGroups(const std::vector<unsigned int>& group_tags);
+
     //! Set the profiler
     /*! \param prof The profiler
      */
@@ -594,6 +610,15 @@ class BondedGroupData
         return m_group_num_change_signal;
         }
 
+    //! Connects a function to be called with the members of each group that is added or removed
+    /*! The second argument is true for an added group. The signal is emitted on every rank before
+        the group number change signal. Groups added by initializeFromSnapshot() are not reported.
+    */
+    Nano::Signal<void(const members_t&, bool)>& getGroupChangeSignal()
+        {
+        return m_group_change_signal;
+        }
+
     //! Connects a function to be called every time the local number of bonded groups changes
     Nano::Signal<void()>& getGroupReorderSignal()
         {
@@ -666,6 +691,11 @@ class BondedGroupData
 
     private:
     bool m_groups_dirty; //!< Is it necessary to rebuild the lookup-by-index table?
+    bool m_notify_group_changes = true; //!< False while initializing from a snapshot
+    bool m_batch_group_changes = false; //!< True while adding or removing a batch of groups
+
+    Nano::Signal<void(const members_t&, bool)>
+        m_group_change_signal; //!< Signal that is triggered with each added or removed group
 
     Nano::Signal<void()> m_group_num_change_signal; //!< Signal that is triggered when groups are
                                                     //!< added or deleted (globally)
@@ -88,6 +88,10 @@ class PYBIND11_EXPORT BoxResizeUpdater : public Updater
     /// Update box interpolation based on provided timestep
     virtual void update(uint64_t timestep);
 
+    protected:
+    /// Scale the particles in the group from the current box to the new box
+    virtual void scaleAndWrapParticles(const BoxDim& cur_box, const BoxDim& new_box);
+
     private:
     pybind11::object m_py_box1;             ///< The python box assoc with min
     pybind11::object m_py_box2;             ///< The python box assoc with max
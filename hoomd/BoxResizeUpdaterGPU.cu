@@ -0,0 +1,140 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file BoxResizeUpdaterGPU.cu
+    \brief Defines the GPU functions used by BoxResizeUpdaterGPU
+*/
+
+#include "BoxResizeUpdaterGPU.cuh"
+
+namespace hoomd
+    {
+namespace kernel
+    {
+//! Scale the positions of the particles in a group
+/*! \param num_members Number of particles in the group
+    \param d_pos Particle positions
+    \param d_group_members Local indices of the particles in the group
+    \param cur_box Global box before the resize
+    \param new_box Global box after the resize
+
+    One thread per group member.
+*/
+__global__ void gpu_box_resize_scale_kernel(const unsigned int num_members,
+                                            Scalar4* d_pos,
+                                            const unsigned int* d_group_members,
+                                            const BoxDim cur_box,
+                                            const BoxDim new_box)
+    {
+    const unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (group_idx >= num_members)
+        return;
+
+    const unsigned int idx = d_group_members[group_idx];
+    Scalar4 postype = d_pos[idx];
+    Scalar3 fractional_pos = cur_box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+    Scalar3 scaled_pos = new_box.makeCoordinates(fractional_pos);
+    d_pos[idx] = make_scalar4(scaled_pos.x, scaled_pos.y, scaled_pos.z, postype.w);
+    }
+
+//! Wrap the particles into the local box
+/*! \param N Number of local particles
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param local_box Local box
+
+    One thread per particle.
+*/
+__global__ void gpu_box_resize_wrap_kernel(const unsigned int N,
+                                           Scalar4* d_pos,
+                                           int3* d_image,
+                                           const BoxDim local_box)
+    {
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    Scalar4 postype = d_pos[idx];
+    int3 image = d_image[idx];
+    local_box.wrap(postype, image);
+    d_pos[idx] = postype;
+    d_image[idx] = image;
+    }
+
+/*! \param num_members Number of particles in the group
+    \param d_pos Particle positions
+    \param d_group_members Local indices of the particles in the group
+    \param cur_box Global box before the resize
+    \param new_box Global box after the resize
+    \param block_size Kernel launch block size
+*/
+hipError_t gpu_box_resize_scale(const unsigned int num_members,
+                                Scalar4* d_pos,
+                                const unsigned int* d_group_members,
+                                const BoxDim& cur_box,
+                                const BoxDim& new_box,
+                                const unsigned int block_size)
+    {
+    if (num_members == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_box_resize_scale_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    unsigned int n_blocks = num_members / run_block_size + 1;
+
+    hipLaunchKernelGGL(gpu_box_resize_scale_kernel,
+                       dim3(n_blocks),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       num_members,
+                       d_pos,
+                       d_group_members,
+                       cur_box,
+                       new_box);
+
+    return hipSuccess;
+    }
+
+/*! \param N Number of local particles
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param local_box Local box
+    \param block_size Kernel launch block size
+*/
+hipError_t gpu_box_resize_wrap(const unsigned int N,
+                               Scalar4* d_pos,
+                               int3* d_image,
+                               const BoxDim& local_box,
+                               const unsigned int block_size)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_box_resize_wrap_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    unsigned int n_blocks = N / run_block_size + 1;
+
+    hipLaunchKernelGGL(gpu_box_resize_wrap_kernel,
+                       dim3(n_blocks),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       N,
+                       d_pos,
+                       d_image,
+                       local_box);
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace hoomd
@@ -0,0 +1,72 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file BoxResizeUpdaterGPU.h
+    \brief Declares an updater that resizes the simulation box of the system on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifdef ENABLE_HIP
+
+#pragma once
+
+#include "Autotuner.h"
+#include "BoxResizeUpdater.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+/// Updates the simulation box over time on the GPU
+/** BoxResizeUpdaterGPU scales and wraps the particles with kernels so that the positions and
+ * images stay on the device when the box changes every step.
+ * \ingroup updaters
+ */
+class PYBIND11_EXPORT BoxResizeUpdaterGPU : public BoxResizeUpdater
+    {
+    public:
+    /// Constructor
+    BoxResizeUpdaterGPU(std::shared_ptr<SystemDefinition> sysdef,
+                        pybind11::object box1,
+                        pybind11::object box2,
+                        std::shared_ptr<Variant> variant,
+                        std::shared_ptr<ParticleGroup> group);
+
+    /// Destructor
+    virtual ~BoxResizeUpdaterGPU();
+
+    /// Set autotuner parameters
+    /** \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        BoxResizeUpdater::setAutotunerParams(enable, period);
+        m_tuner_scale->setPeriod(period);
+        m_tuner_scale->setEnabled(enable);
+        m_tuner_wrap->setPeriod(period);
+        m_tuner_wrap->setEnabled(enable);
+        }
+
+    protected:
+    /// Scale the particles in the group from the current box to the new box
+    virtual void scaleAndWrapParticles(const BoxDim& cur_box, const BoxDim& new_box);
+
+    private:
+    std::unique_ptr<Autotuner> m_tuner_scale; //!< Autotuner for the block size of the scaling
+    std::unique_ptr<Autotuner> m_tuner_wrap;  //!< Autotuner for the block size of the wrapping
+    };
+
+namespace detail
+    {
+/// Export the BoxResizeUpdaterGPU to python
+void export_BoxResizeUpdaterGPU(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace hoomd
+
+#endif // ENABLE_HIP
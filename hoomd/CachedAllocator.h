@@ -4,7 +4,7 @@
 // Maintainer: jglaser
 
 /*! \file CachedAllocator.h
-    \brief Declares a cached allocator for temporary allocations and a helper class
+    \brief Declares a cached allocator for temporary and persistent allocations and a helper class
 
     Inspired by thrust/examples/cuda/custom_temporary_allocation.cu
 */
@@ -15,8 +15,10 @@
 #ifdef ENABLE_HIP
 #include <hip/hip_runtime.h>
 
+#include <algorithm>
 #include <cassert>
 #include <map>
+#include <mutex>
 #include <stdexcept>
 
 //! Need to define an error checking macro that can be used in .cu files
@@ -39,6 +41,17 @@
 namespace hoomd
     {
 //! CachedAllocator: a simple allocator for caching allocation requests
+/*! Requests are rounded up to size classes, eight per power of two, so that arrays that are
+    resized by small amounts reuse the same cached block. Released blocks are kept in the cache until
+    the total size of the free blocks exceeds max_cached_bytes, and the cache is released before
+    retrying an allocation that fails.
+
+    The allocator keeps high-water statistics of the memory it holds from the device and of the
+    memory in use by its callers.
+
+    Allocations and deallocations are serialized with a mutex so that simulations advancing in
+    separate threads may share the allocator of one ExecutionConfiguration.
+*/
 class __attribute__((visibility("default"))) CachedAllocator
     {
     public:
@@ -46,14 +59,15 @@ class __attribute__((visibility("default"))) CachedAllocator
     typedef char value_type;
 
     //! Constructor
-    /*  \param max_cached_bytes Maximum size of cache
+    /*  \param max_cached_bytes Maximum size of the free blocks in the cache
      *   \param cache_reltol Relative tolerance for cache hits
      */
     CachedAllocator(bool managed,
-                    unsigned int max_cached_bytes = 100u * 1024u * 1024u,
+                    size_t max_cached_bytes = 100u * 1024u * 1024u,
                     float cache_reltol = 0.1f)
-        : m_managed(managed), m_num_bytes_tot(0), m_max_cached_bytes(max_cached_bytes),
-          m_cache_reltol(cache_reltol)
+        : m_managed(managed), m_num_bytes_tot(0), m_num_bytes_cached(0), m_peak_bytes_tot(0),
+          m_peak_bytes_in_use(0), m_num_allocations(0), m_num_cache_hits(0),
+          m_max_cached_bytes(max_cached_bytes), m_cache_reltol(cache_reltol)
         {
         }
 
@@ -64,9 +78,69 @@ class __attribute__((visibility("default"))) CachedAllocator
     CachedAllocator& operator=(const CachedAllocator&&) = delete;
 
     //! Set maximum cache size
-    void setMaxCachedBytes(unsigned int max_cached_bytes)
+    void setMaxCachedBytes(size_t max_cached_bytes)
         {
+        std::lock_guard<std::mutex> lock(m_mutex);
         m_max_cached_bytes = max_cached_bytes;
+        trimCache(m_max_cached_bytes);
+        }
+
+    //! Free all cached blocks that are not in use
+    void releaseCache()
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        trimCache(0);
+        }
+
+    //! Get the number of bytes held from the device, in use or cached
+    size_t getNumBytesReserved() const
+        {
+        return m_num_bytes_tot;
+        }
+
+    //! Get the number of bytes in use by the callers
+    size_t getNumBytesInUse() const
+        {
+        return m_num_bytes_tot - m_num_bytes_cached;
+        }
+
+    //! Get the largest number of bytes held from the device
+    size_t getPeakBytesReserved() const
+        {
+        return m_peak_bytes_tot;
+        }
+
+    //! Get the largest number of bytes in use by the callers
+    size_t getPeakBytesInUse() const
+        {
+        return m_peak_bytes_in_use;
+        }
+
+    //! Get the number of blocks allocated from the device
+    size_t getNumAllocations() const
+        {
+        return m_num_allocations;
+        }
+
+    //! Get the number of requests served from the cache
+    size_t getNumCacheHits() const
+        {
+        return m_num_cache_hits;
+        }
+
+    //! Round a request up to its size class
+    static size_t roundToSizeClass(size_t num_bytes)
+        {
+        const size_t min_bytes = 256;
+        if (num_bytes <= min_bytes)
+            return min_bytes;
+
+        // eight classes per power of two
+        size_t p = min_bytes;
+        while (p <= num_bytes / 2)
+            p *= 2;
+        size_t step = p / 8;
+        return (num_bytes + step - 1) / step * step;
         }
 
     //! Destructor
@@ -94,6 +168,8 @@ class __attribute__((visibility("default"))) CachedAllocator
         if (ptr == NULL)
             return;
 
+        std::lock_guard<std::mutex> lock(m_mutex);
+
         // erase the allocated block from the allocated blocks map
         allocated_blocks_type::iterator iter = m_allocated_blocks.find(ptr);
         assert(iter != m_allocated_blocks.end());
@@ -102,6 +178,9 @@ class __attribute__((visibility("default"))) CachedAllocator
 
         // insert the block into the free blocks map
         m_free_blocks.insert(std::make_pair(num_bytes, ptr));
+        m_num_bytes_cached += num_bytes;
+
+        trimCache(m_max_cached_bytes);
         }
 
     private:
@@ -110,13 +189,38 @@ class __attribute__((visibility("default"))) CachedAllocator
 
     bool m_managed; //! True if we use unified memory
 
-    size_t m_num_bytes_tot;
+    size_t m_num_bytes_tot;     //!< Bytes held from the device
+    size_t m_num_bytes_cached;  //!< Bytes in free blocks
+    size_t m_peak_bytes_tot;    //!< Largest value of m_num_bytes_tot
+    size_t m_peak_bytes_in_use; //!< Largest number of bytes in use
+    size_t m_num_allocations;   //!< Number of device allocations
+    size_t m_num_cache_hits;    //!< Number of requests served from the cache
     size_t m_max_cached_bytes;
     float m_cache_reltol;
 
     free_blocks_type m_free_blocks;
     allocated_blocks_type m_allocated_blocks;
 
+    std::mutex m_mutex; //!< Serializes access to the block maps
+
+    //! Free the largest cached blocks until the cache holds at most max_bytes
+    void trimCache(size_t max_bytes)
+        {
+        while (m_num_bytes_cached > max_bytes && m_free_blocks.size())
+            {
+            // eliminate largest cached block
+            free_blocks_type::reverse_iterator i = m_free_blocks.rbegin();
+
+            hipFree((void*)i->second);
+
+            CHECK_CUDA();
+            m_num_bytes_tot -= i->first;
+            m_num_bytes_cached -= i->first;
+
+            m_free_blocks.erase((++i).base());
+            }
+        }
+
     //! Free all allocated blocks
     void free_all()
         {
@@ -176,6 +280,10 @@ template<typename T> T* CachedAllocator::getTemporaryBuffer(size_t num_elements)
     if (!num_bytes)
         return (T*)NULL;
 
+    num_bytes = roundToSizeClass(num_bytes);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     size_t num_allocated_bytes = num_bytes;
 
     // search the cache for a free block
@@ -183,7 +291,7 @@ template<typename T> T* CachedAllocator::getTemporaryBuffer(size_t num_elements)
 
     // look for a cached buffer within m_cache_reltol relative tolerance
     if (free_block != m_free_blocks.end()
-        && free_block->first <= (num_bytes + (unsigned int)((float)num_bytes * m_cache_reltol)))
+        && free_block->first <= (num_bytes + (std::ptrdiff_t)((float)num_bytes * m_cache_reltol)))
         {
         //        m_exec_conf->msg->notice(10) << "CachedAllocator: found a hit "
         //            << "(" << float(num_bytes)/1024.0f/1024.0f << " MB)" << std::endl;
@@ -195,6 +303,8 @@ template<typename T> T* CachedAllocator::getTemporaryBuffer(size_t num_elements)
 
         // erase from the free_blocks map
         m_free_blocks.erase(free_block);
+        m_num_bytes_cached -= num_allocated_bytes;
+        m_num_cache_hits++;
         }
     else
         {
@@ -203,34 +313,33 @@ template<typename T> T* CachedAllocator::getTemporaryBuffer(size_t num_elements)
         //        m_exec_conf->msg->notice(10) << "CachedAllocator: no free block found;"
         //            << " allocating " << float(num_bytes)/1024.0f/1024.0f << " MB" << std::endl;
 
+        hipError_t err;
         if (m_managed)
-            hipMallocManaged((void**)&result, num_bytes);
+            err = hipMallocManaged((void**)&result, num_bytes);
         else
-            hipMalloc((void**)&result, num_bytes);
-        CHECK_CUDA();
+            err = hipMalloc((void**)&result, num_bytes);
 
-        m_num_bytes_tot += num_bytes;
-
-        while (m_num_bytes_tot > m_max_cached_bytes && m_free_blocks.size())
+        if (err == hipErrorOutOfMemory && m_free_blocks.size())
             {
-            // eliminate largest cached block
-            free_blocks_type::reverse_iterator i = m_free_blocks.rbegin();
-
-            //            m_exec_conf->msg->notice(10) << "CachedAllocator: maximum cache size "
-            //                << "reached; removing unused block ("
-            //                << float(i->first)/1024.0f/1024.0f << " MB)" << std::endl;
-
-            hipFree((void*)i->second);
-
-            CHECK_CUDA();
-            m_num_bytes_tot -= i->first;
-
-            m_free_blocks.erase((++i).base());
+            // clear the error, return the cached blocks to the device, and try again
+            hipGetLastError();
+            trimCache(0);
+
+            if (m_managed)
+                hipMallocManaged((void**)&result, num_bytes);
+            else
+                hipMalloc((void**)&result, num_bytes);
             }
+        CHECK_CUDA();
+
+        m_num_bytes_tot += num_bytes;
+        m_num_allocations++;
+        m_peak_bytes_tot = std::max(m_peak_bytes_tot, m_num_bytes_tot);
         }
 
     // insert the allocated pointer into the allocated_blocks map
     m_allocated_blocks.insert(std::make_pair(result, num_allocated_bytes));
+    m_peak_bytes_in_use = std::max(m_peak_bytes_in_use, getNumBytesInUse());
 
     return (T*)result;
     }
@@ -286,6 +286,11 @@ void CellList::initializeMemory()
         m_Nmax = estim_Nmax;
         if (m_Nmax == 0)
             m_Nmax = 1;
+
+        // start from the size saved in a restart file, the hint is sized for all particles
+        std::vector<unsigned int> hint = m_sysdef->getSizeHint("cell_list/Nmax");
+        if (hint.size() == 1 && m_types.empty())
+            m_Nmax = std::max(m_Nmax, hint[0]);
         }
 
     m_exec_conf->msg->notice(6) << "cell list: allocating " << m_dim.x << " x " << m_dim.y << " x "
@@ -458,6 +463,34 @@ void CellList::initializeCellAdj()
         m_prof->pop();
     }
 
+/*! Particles of other types are left out of the cell list. Neighbor lists that search the small
+    and large particles of a size-asymmetric mixture with different cell widths build one cell list
+    per size class.
+*/
+void CellList::setTypeFilter(const std::vector<unsigned int>& types)
+    {
+    const unsigned int ntypes = m_pdata->getNTypes();
+    GlobalArray<unsigned int> type_filter(types.empty() ? 0 : ntypes, m_exec_conf);
+
+    if (!types.empty())
+        {
+        ArrayHandle<unsigned int> h_type_filter(type_filter,
+                                                access_location::host,
+                                                access_mode::overwrite);
+        std::fill(h_type_filter.data, h_type_filter.data + ntypes, 0);
+        for (unsigned int type : types)
+            {
+            if (type >= ntypes)
+                throw std::runtime_error("Invalid type in the cell list type filter.");
+            h_type_filter.data[type] = 1;
+            }
+        }
+
+    std::swap(m_type_filter, type_filter);
+    m_types = types;
+    m_params_changed = true;
+    }
+
 void CellList::computeCellList()
     {
     if (m_prof)
@@ -475,6 +508,9 @@ void CellList::computeCellList()
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
                                    access_location::host,
                                    access_mode::read);
+    ArrayHandle<unsigned int> h_type_filter(m_type_filter,
+                                            access_location::host,
+                                            access_mode::read);
     const BoxDim& box = m_pdata->getBox();
 
     // access the cell list data arrays
@@ -513,6 +549,10 @@ void CellList::computeCellList()
             continue;
             }
 
+        // skip particles of types that are not binned
+        if (!m_types.empty() && !h_type_filter.data[__scalar_as_int(h_pos.data[n].w)])
+            continue;
+
         // find the bin each particle belongs in
         Scalar3 f = box.makeFraction(p, ghost_width);
         int ib = (int)(f.x * m_dim.x);
@@ -625,6 +665,8 @@ bool CellList::checkConditions()
     if (conditions.x > m_Nmax)
         {
         m_Nmax = conditions.x;
+        if (m_types.empty())
+            m_sysdef->raiseSizeHint("cell_list/Nmax", std::vector<unsigned int>(1, m_Nmax));
         result = true;
         }
 
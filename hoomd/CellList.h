@@ -11,6 +11,7 @@
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
+#include <vector>
 
 /*! \file CellList.h
     \brief Declares the CellList class
@@ -217,6 +218,17 @@ class PYBIND11_EXPORT CellList : public Compute
         m_params_changed = true;
         }
 
+    //! Bin only the particles of the given types
+    /*! \param types Type ids to bin. An empty list bins all particles.
+     */
+    void setTypeFilter(const std::vector<unsigned int>& types);
+
+    //! Get the types binned by the cell list (empty when all particles are binned)
+    const std::vector<unsigned int>& getTypeFilter() const
+        {
+        return m_types;
+        }
+
     //! Request a multi-GPU cell list
     virtual void setPerDevice(bool per_device)
         {
@@ -396,6 +408,9 @@ class PYBIND11_EXPORT CellList : public Compute
     bool m_sort_cell_list;   //!< If true, sort cell list
     bool m_compute_adj_list; //!< If true, compute the cell adjacency lists
 
+    std::vector<unsigned int> m_types;       //!< Types to bin (empty to bin all particles)
+    GlobalArray<unsigned int> m_type_filter; //!< Per type flag, non-zero if the type is binned
+
 #ifdef ENABLE_MPI
     /// The system's communicator.
     std::shared_ptr<Communicator> m_comm;
@@ -431,12 +446,111 @@ class PYBIND11_EXPORT CellList : public Compute
     Nano::Signal<void()> m_width_change; //!< Signal that is triggered when the cell width changes
     };
 
+/// Allow the usage of CellList arrays in Python.
+/** Uses the LocalDataAccess templated class to expose the local cell list to Python. The cells are
+ *  indexed in C order as [k, j, i] over the cell list dimensions (including the ghost layer), and
+ *  each cell has getNmax() slots of which the first cell_size[k, j, i] are filled. The arrays are
+ *  read only and reflect the most recent cell list build.
+ *
+ *  Template Parameters
+ *  Output: The buffer output type (either HOOMDHostBuffer or HOOMDDeviceBuffer)
+ */
+template<class Output>
+class PYBIND11_EXPORT LocalCellListData : public LocalDataAccess<Output, CellList>
+    {
+    public:
+    LocalCellListData(CellList& data)
+        : LocalDataAccess<Output, CellList>(data), m_cl(data), m_cell_size_handle(),
+          m_xyzf_handle()
+        {
+        }
+
+    virtual ~LocalCellListData() = default;
+
+    Output getCellSize()
+        {
+        const uint3 dim = m_cl.getDim();
+        const ssize_t item = sizeof(unsigned int);
+        return this->template getArrayBuffer<unsigned int, unsigned int>(
+            m_cell_size_handle,
+            m_cl.getCellSizeArray(),
+            std::vector<ssize_t>({dim.z, dim.y, dim.x}),
+            std::vector<ssize_t>({dim.y * dim.x * item, dim.x * item, item}));
+        }
+
+    Output getPosition()
+        {
+        return this->template getArrayBuffer<Scalar4, Scalar>(m_xyzf_handle,
+                                                               m_cl.getXYZFArray(),
+                                                               getCellListShape(3),
+                                                               getCellListStrides(sizeof(Scalar)));
+        }
+
+    Output getFlag()
+        {
+        return this->template getArrayBuffer<Scalar4, unsigned int>(m_xyzf_handle,
+                                                                    m_cl.getXYZFArray(),
+                                                                    getCellListShape(0),
+                                                                    getCellListStrides(0),
+                                                                    true,
+                                                                    3 * sizeof(Scalar));
+        }
+
+    protected:
+    void clear()
+        {
+        m_cell_size_handle.reset(nullptr);
+        m_xyzf_handle.reset(nullptr);
+        }
+
+    private:
+    /// Shape of a per-slot array, with an optional last dimension
+    std::vector<ssize_t> getCellListShape(ssize_t second_dimension_size)
+        {
+        const uint3 dim = m_cl.getDim();
+        std::vector<ssize_t> shape({dim.z, dim.y, dim.x, m_cl.getNmax()});
+        if (second_dimension_size != 0)
+            shape.push_back(second_dimension_size);
+        return shape;
+        }
+
+    /// Strides of a per-slot Scalar4 array, with an optional last dimension
+    std::vector<ssize_t> getCellListStrides(ssize_t element_size)
+        {
+        const uint3 dim = m_cl.getDim();
+        const ssize_t slot = sizeof(Scalar4);
+        const ssize_t cell = m_cl.getNmax() * slot;
+        std::vector<ssize_t> strides({dim.y * dim.x * cell, dim.x * cell, cell, slot});
+        if (element_size != 0)
+            strides.push_back(element_size);
+        return strides;
+        }
+
+    CellList& m_cl;
+    std::unique_ptr<ArrayHandle<unsigned int>> m_cell_size_handle;
+    std::unique_ptr<ArrayHandle<Scalar4>> m_xyzf_handle;
+    };
+
 namespace detail
     {
 //! Export the CellList class to python
 #ifndef __HIPCC__
 void export_CellList(pybind11::module& m);
 #endif
+
+/// Export local access to CellList
+template<class Output> void export_LocalCellListData(pybind11::module& m, std::string name)
+    {
+    pybind11::class_<LocalCellListData<Output>, std::shared_ptr<LocalCellListData<Output>>>(
+        m,
+        name.c_str())
+        .def(pybind11::init<CellList&>())
+        .def("getCellSize", &LocalCellListData<Output>::getCellSize)
+        .def("getPosition", &LocalCellListData<Output>::getPosition)
+        .def("getFlag", &LocalCellListData<Output>::getFlag)
+        .def("enter", &LocalCellListData<Output>::enter)
+        .def("exit", &LocalCellListData<Output>::exit);
+    }
     } // end namespace detail
 
     } // end namespace hoomd
@@ -101,6 +101,11 @@ void CellListGPU::computeCellList()
                                         access_location::device,
                                         access_mode::overwrite);
 
+        // types to bin
+        ArrayHandle<unsigned int> d_type_filter(m_type_filter,
+                                                access_location::device,
+                                                access_mode::read);
+
         // reset cell list contents
         hipMemsetAsync(d_cell_size.data,
                        0,
@@ -139,6 +144,7 @@ void CellListGPU::computeCellList()
             d_charge.data,
             d_diameter.data,
             d_body.data,
+            d_type_filter.data,
             m_pdata->getN(),
             m_pdata->getNGhosts(),
             m_Nmax,
@@ -29,6 +29,7 @@ namespace hoomd
     \param d_charge Particle charge array
     \param d_diameter Particle diameter array
     \param d_body Particle body array
+    \param d_type_filter Per type flag, non-zero if the type is binned (NULL to bin all types)
     \param N Number of particles
     \param n_ghost Number of ghost particles
     \param Nmax Maximum number of particles that can be placed in a single cell
@@ -52,6 +53,7 @@ __global__ void gpu_compute_cell_list_kernel(unsigned int* d_cell_size,
                                              const Scalar* d_charge,
                                              const Scalar* d_diameter,
                                              const unsigned int* d_body,
+                                             const unsigned int* d_type_filter,
                                              const unsigned int N,
                                              const unsigned int n_ghost,
                                              const unsigned int Nmax,
@@ -103,6 +105,10 @@ __global__ void gpu_compute_cell_list_kernel(unsigned int* d_cell_size,
         return;
         }
 
+    // skip particles of types that are not binned
+    if (d_type_filter != NULL && !d_type_filter[__scalar_as_int(type)])
+        return;
+
     uchar3 periodic = box.getPeriodic();
     Scalar3 f = box.makeFraction(pos, ghost_width);
 
@@ -185,6 +191,7 @@ void gpu_compute_cell_list(unsigned int* d_cell_size,
                            const Scalar* d_charge,
                            const Scalar* d_diameter,
                            const unsigned int* d_body,
+                           const unsigned int* d_type_filter,
                            const unsigned int N,
                            const unsigned int n_ghost,
                            const unsigned int Nmax,
@@ -233,6 +240,7 @@ void gpu_compute_cell_list(unsigned int* d_cell_size,
                            d_charge,
                            d_diameter,
                            d_body,
+                           d_type_filter,
                            N,
                            n_ghost,
                            Nmax,
@@ -33,6 +33,7 @@ void gpu_compute_cell_list(unsigned int* d_cell_size,
                            const Scalar* d_charge,
                            const Scalar* d_diameter,
                            const unsigned int* d_body,
+                           const unsigned int* d_type_filter,
                            const unsigned int N,
                            const unsigned int n_ghost,
                            const unsigned int Nmax,
@@ -31,6 +31,82 @@ Communicator::GroupCommunicator<group_data>::GroupCommunicator(Communicator& com
     assert(sizeof(unsigned int) * 8 >= group_data::size);
     }
 
+/*! \param sendbuf Elements to send, sorted by destination rank
+    \param recvbuf Buffer to resize and fill with the received elements
+
+    The elements for the i-th unique neighbor are sendbuf[m_comm.m_begin[i], m_comm.m_end[i]).
+    Every neighbor is sent a message, which may be empty, and the receiver sizes its buffer from the
+    probed message. This avoids a separate round trip to exchange the element counts.
+*/
+template<class group_data>
+template<class element_t>
+void Communicator::GroupCommunicator<group_data>::exchangeElements(
+    std::vector<element_t>& sendbuf, std::vector<element_t>& recvbuf)
+    {
+    ArrayHandle<unsigned int> h_begin(m_comm.m_begin, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_end(m_comm.m_end, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
+                                                 access_location::host,
+                                                 access_mode::read);
+
+    if (m_comm.m_prof)
+        m_comm.m_prof->push("MPI send/recv");
+
+    unsigned int n_neigh = m_comm.m_n_unique_neigh;
+    std::vector<MPI_Request> reqs(2 * n_neigh);
+    std::vector<unsigned int> n_recv(n_neigh);
+
+    unsigned int send_bytes = 0;
+    unsigned int recv_bytes = 0;
+
+    // post all sends, including empty ones, so that every receiver can probe for its message
+    for (unsigned int ineigh = 0; ineigh < n_neigh; ineigh++)
+        {
+        unsigned int n_send = h_end.data[ineigh] - h_begin.data[ineigh];
+        MPI_Isend(sendbuf.data() + h_begin.data[ineigh],
+                  int(n_send * sizeof(element_t)),
+                  MPI_BYTE,
+                  h_unique_neighbors.data[ineigh],
+                  1,
+                  m_comm.m_mpi_comm,
+                  &reqs[ineigh]);
+        send_bytes += (unsigned int)(n_send * sizeof(element_t));
+        }
+
+    // size the receive buffer from the incoming messages
+    unsigned int n_recv_tot = 0;
+    for (unsigned int ineigh = 0; ineigh < n_neigh; ineigh++)
+        {
+        MPI_Status status;
+        MPI_Probe(h_unique_neighbors.data[ineigh], 1, m_comm.m_mpi_comm, &status);
+        int count;
+        MPI_Get_count(&status, MPI_BYTE, &count);
+        n_recv[ineigh] = (unsigned int)(count / sizeof(element_t));
+        n_recv_tot += n_recv[ineigh];
+        }
+
+    recvbuf.resize(n_recv_tot);
+
+    unsigned int offset = 0;
+    for (unsigned int ineigh = 0; ineigh < n_neigh; ineigh++)
+        {
+        MPI_Irecv(recvbuf.data() + offset,
+                  int(n_recv[ineigh] * sizeof(element_t)),
+                  MPI_BYTE,
+                  h_unique_neighbors.data[ineigh],
+                  1,
+                  m_comm.m_mpi_comm,
+                  &reqs[n_neigh + ineigh]);
+        offset += n_recv[ineigh];
+        recv_bytes += (unsigned int)(n_recv[ineigh] * sizeof(element_t));
+        }
+
+    MPI_Waitall((unsigned int)reqs.size(), reqs.data(), MPI_STATUSES_IGNORE);
+
+    if (m_comm.m_prof)
+        m_comm.m_prof->pop(0, send_bytes + recv_bytes);
+    }
+
 template<class group_data>
 void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                                                                 bool local_multiple)
@@ -245,136 +321,8 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
         /*
          * communicate rank information (phase 1)
          */
-        unsigned int n_send_groups[m_comm.m_n_unique_neigh];
-        unsigned int n_recv_groups[m_comm.m_n_unique_neigh];
-        unsigned int offs[m_comm.m_n_unique_neigh];
-        unsigned int n_recv_tot = 0;
-
-            {
-            ArrayHandle<unsigned int> h_begin(m_comm.m_begin,
-                                              access_location::host,
-                                              access_mode::read);
-            ArrayHandle<unsigned int> h_end(m_comm.m_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-
-            unsigned int send_bytes = 0;
-            unsigned int recv_bytes = 0;
-            if (m_comm.m_prof)
-                m_comm.m_prof->push("MPI send/recv");
-
-            // compute send counts
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                n_send_groups[ineigh] = h_end.data[ineigh] - h_begin.data[ineigh];
-
-            MPI_Request req[2 * m_comm.m_n_unique_neigh];
-            MPI_Status stat[2 * m_comm.m_n_unique_neigh];
-
-            unsigned int nreq = 0;
-
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                MPI_Isend(&n_send_groups[ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_comm.m_mpi_comm,
-                          &req[nreq++]);
-                MPI_Irecv(&n_recv_groups[ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_comm.m_mpi_comm,
-                          &req[nreq++]);
-                send_bytes += (unsigned int)sizeof(unsigned int);
-                recv_bytes += (unsigned int)sizeof(unsigned int);
-                } // end neighbor loop
-
-            MPI_Waitall(nreq, req, stat);
-
-            // sum up receive counts
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                {
-                if (ineigh == 0)
-                    offs[ineigh] = 0;
-                else
-                    offs[ineigh] = offs[ineigh - 1] + n_recv_groups[ineigh - 1];
-
-                n_recv_tot += n_recv_groups[ineigh];
-                }
-
-            if (m_comm.m_prof)
-                m_comm.m_prof->pop(0, send_bytes + recv_bytes);
-            }
-
-        // Resize receive buffer
-        m_ranks_recvbuf.resize(n_recv_tot);
-
-            {
-            ArrayHandle<unsigned int> h_begin(m_comm.m_begin,
-                                              access_location::host,
-                                              access_mode::read);
-            ArrayHandle<unsigned int> h_end(m_comm.m_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-
-            if (m_comm.m_prof)
-                m_comm.m_prof->push("MPI send/recv");
-
-            std::vector<MPI_Request> reqs;
-            MPI_Request req;
-
-            unsigned int send_bytes = 0;
-            unsigned int recv_bytes = 0;
-
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                // exchange particle data
-                if (n_send_groups[ineigh])
-                    {
-                    MPI_Isend(&m_ranks_sendbuf.front() + h_begin.data[ineigh],
-                              int(n_send_groups[ineigh] * sizeof(rank_element_t)),
-                              MPI_BYTE,
-                              neighbor,
-                              1,
-                              m_comm.m_mpi_comm,
-                              &req);
-                    reqs.push_back(req);
-                    }
-                send_bytes += (unsigned int)(n_send_groups[ineigh] * sizeof(rank_element_t));
-
-                if (n_recv_groups[ineigh])
-                    {
-                    MPI_Irecv(&m_ranks_recvbuf.front() + offs[ineigh],
-                              int(n_recv_groups[ineigh] * sizeof(rank_element_t)),
-                              MPI_BYTE,
-                              neighbor,
-                              1,
-                              m_comm.m_mpi_comm,
-                              &req);
-                    reqs.push_back(req);
-                    }
-                recv_bytes += (unsigned int)(n_recv_groups[ineigh] * sizeof(rank_element_t));
-                }
-
-            std::vector<MPI_Status> stats(reqs.size());
-            MPI_Waitall((unsigned int)reqs.size(), &reqs.front(), &stats.front());
-
-            if (m_comm.m_prof)
-                m_comm.m_prof->pop(0, send_bytes + recv_bytes);
-            }
+        exchangeElements(m_ranks_sendbuf, m_ranks_recvbuf);
+        unsigned int n_recv_tot = (unsigned int)m_ranks_recvbuf.size();
 
             {
             // access receive buffers
@@ -598,133 +546,8 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
         /*
          * communicate groups (phase 2)
          */
-
-        n_recv_tot = 0;
-            {
-            ArrayHandle<unsigned int> h_begin(m_comm.m_begin,
-                                              access_location::host,
-                                              access_mode::read);
-            ArrayHandle<unsigned int> h_end(m_comm.m_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-
-            unsigned int send_bytes = 0;
-            unsigned int recv_bytes = 0;
-            if (m_comm.m_prof)
-                m_comm.m_prof->push("MPI send/recv");
-
-            // compute send counts
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                n_send_groups[ineigh] = h_end.data[ineigh] - h_begin.data[ineigh];
-
-            MPI_Request req[2 * m_comm.m_n_unique_neigh];
-            MPI_Status stat[2 * m_comm.m_n_unique_neigh];
-
-            unsigned int nreq = 0;
-
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                MPI_Isend(&n_send_groups[ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_comm.m_mpi_comm,
-                          &req[nreq++]);
-                MPI_Irecv(&n_recv_groups[ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_comm.m_mpi_comm,
-                          &req[nreq++]);
-                send_bytes += (unsigned int)sizeof(unsigned int);
-                recv_bytes += (unsigned int)sizeof(unsigned int);
-                } // end neighbor loop
-
-            MPI_Waitall(nreq, req, stat);
-
-            // sum up receive counts
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                {
-                if (ineigh == 0)
-                    offs[ineigh] = 0;
-                else
-                    offs[ineigh] = offs[ineigh - 1] + n_recv_groups[ineigh - 1];
-
-                n_recv_tot += n_recv_groups[ineigh];
-                }
-
-            if (m_comm.m_prof)
-                m_comm.m_prof->pop(0, send_bytes + recv_bytes);
-            }
-
-        // Resize receive buffer
-        m_groups_recvbuf.resize(n_recv_tot);
-
-            {
-            ArrayHandle<unsigned int> h_begin(m_comm.m_begin,
-                                              access_location::host,
-                                              access_mode::read);
-            ArrayHandle<unsigned int> h_end(m_comm.m_end, access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_comm.m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-
-            if (m_comm.m_prof)
-                m_comm.m_prof->push("MPI send/recv");
-
-            std::vector<MPI_Request> reqs;
-            MPI_Request req;
-
-            unsigned int send_bytes = 0;
-            unsigned int recv_bytes = 0;
-
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_comm.m_n_unique_neigh; ineigh++)
-                {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                // exchange particle data
-                if (n_send_groups[ineigh])
-                    {
-                    MPI_Isend(&m_groups_sendbuf.front() + h_begin.data[ineigh],
-                              int(n_send_groups[ineigh] * sizeof(group_element_t)),
-                              MPI_BYTE,
-                              neighbor,
-                              1,
-                              m_comm.m_mpi_comm,
-                              &req);
-                    reqs.push_back(req);
-                    }
-                send_bytes += (unsigned int)(n_send_groups[ineigh] * sizeof(group_element_t));
-
-                if (n_recv_groups[ineigh])
-                    {
-                    MPI_Irecv(&m_groups_recvbuf.front() + offs[ineigh],
-                              int(n_recv_groups[ineigh] * sizeof(group_element_t)),
-                              MPI_BYTE,
-                              neighbor,
-                              1,
-                              m_comm.m_mpi_comm,
-                              &req);
-                    reqs.push_back(req);
-                    }
-                recv_bytes += (unsigned int)(n_recv_groups[ineigh] * sizeof(group_element_t));
-                }
-
-            std::vector<MPI_Status> stats(reqs.size());
-            MPI_Waitall((unsigned int)reqs.size(), &reqs.front(), &stats.front());
-
-            if (m_comm.m_prof)
-                m_comm.m_prof->pop(0, send_bytes + recv_bytes);
-            }
+        exchangeElements(m_groups_sendbuf, m_groups_recvbuf);
+        n_recv_tot = (unsigned int)m_groups_recvbuf.size();
 
         // use a std::map, i.e. single-key, to filter out duplicate groups in input buffer
         typedef std::map<unsigned int, group_element_t> recv_map_t;
@@ -1241,6 +1064,8 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
       m_netforce_reverse_copybuf(m_exec_conf), m_netforce_reverse_recvbuf(m_exec_conf),
       m_r_ghost_max(Scalar(0.0)), m_r_extra_ghost_max(Scalar(0.0)), m_ghosts_added(0),
       m_has_ghost_particles(false), m_last_flags(0), m_comm_pending(false),
+      m_ghost_requests_valid(false), m_ghost_request_flags(0), m_compact_ghost_positions(false),
+      m_delta_ghost_updates(false), m_delta_ghosts_valid(false), m_delta_flags(0),
       m_bond_comm(*this, m_sysdef->getBondData()), m_angle_comm(*this, m_sysdef->getAngleData()),
       m_dihedral_comm(*this, m_sysdef->getDihedralData()),
       m_improper_comm(*this, m_sysdef->getImproperData()),
@@ -1296,6 +1121,33 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
     GlobalArray<Scalar> r_ghost_body(m_pdata->getNTypes(), m_exec_conf);
     m_r_ghost_body.swap(r_ghost_body);
 
+    // count the buffers under the communicator in the memory accounting
+    TAG_ALLOCATION(m_pos_copybuf);
+    TAG_ALLOCATION(m_charge_copybuf);
+    TAG_ALLOCATION(m_diameter_copybuf);
+    TAG_ALLOCATION(m_body_copybuf);
+    TAG_ALLOCATION(m_image_copybuf);
+    TAG_ALLOCATION(m_velocity_copybuf);
+    TAG_ALLOCATION(m_orientation_copybuf);
+    TAG_ALLOCATION(m_plan_copybuf);
+    TAG_ALLOCATION(m_tag_copybuf);
+    TAG_ALLOCATION(m_netforce_copybuf);
+    TAG_ALLOCATION(m_nettorque_copybuf);
+    TAG_ALLOCATION(m_netvirial_copybuf);
+    TAG_ALLOCATION(m_netvirial_recvbuf);
+    TAG_ALLOCATION(m_plan);
+    TAG_ALLOCATION(m_plan_reverse);
+    TAG_ALLOCATION(m_tag_reverse);
+    TAG_ALLOCATION(m_netforce_reverse_copybuf);
+    TAG_ALLOCATION(m_netforce_reverse_recvbuf);
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        TAG_ALLOCATION(m_copy_ghosts[dir]);
+        TAG_ALLOCATION(m_copy_ghosts_reverse[dir]);
+        TAG_ALLOCATION(m_plan_reverse_copybuf[dir]);
+        TAG_ALLOCATION(m_forward_ghosts_reverse[dir]);
+        }
+
     /*
      * Bonded group communication
      */
@@ -1395,6 +1247,7 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
 Communicator::~Communicator()
     {
     m_exec_conf->msg->notice(5) << "Destroying Communicator" << std::endl;
+    freeGhostUpdateRequests();
     m_pdata->getParticleSortSignal().disconnect<Communicator, &Communicator::forceMigrate>(this);
     m_pdata->getGhostParticlesRemovedSignal()
         .disconnect<Communicator, &Communicator::slotGhostParticlesRemoved>(this);
@@ -1426,74 +1279,85 @@ void Communicator::initializeNeighborArrays()
     Index3D di = m_decomposition->getDomainIndexer();
 
     uint3 mypos = m_decomposition->getGridPos();
-    int l = mypos.x;
-    int m = mypos.y;
-    int n = mypos.z;
+    Scalar3 my_lo, my_hi;
+    m_decomposition->getDomainBounds(di(mypos.x, mypos.y, mypos.z), my_lo, my_hi);
 
-    ArrayHandle<unsigned int> h_neighbors(m_neighbors,
-                                          access_location::host,
-                                          access_mode::overwrite);
-    ArrayHandle<unsigned int> h_adj_mask(m_adj_mask, access_location::host, access_mode::overwrite);
-    ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(),
-                                           access_location::host,
-                                           access_mode::read);
+    // periodic images are only considered along directions with more than one domain
+    const int3 n_shift
+        = make_int3(di.getW() > 1 ? 1 : 0, di.getH() > 1 ? 1 : 0, di.getD() > 1 ? 1 : 0);
+
+    // relative position (-1, 0, 1) of a domain along one direction, false if it does not touch
+    auto relative_position = [](Scalar lo, Scalar hi, Scalar my_lo, Scalar my_hi, int& rel)
+    {
+        const Scalar tol(1e-6);
+        if (std::abs(hi - my_lo) < tol)
+            rel = -1;
+        else if (std::abs(lo - my_hi) < tol)
+            rel = 1;
+        else if (lo < my_hi && hi > my_lo)
+            rel = 0;
+        else
+            return false;
+        return true;
+    };
 
-    m_nneigh = 0;
+    std::vector<unsigned int> neighbors;
+    std::vector<unsigned int> masks;
 
-    // loop over neighbors
-    for (int ix = -1; ix <= 1; ix++)
         {
-        int i = ix + l;
-        if (i == (int)di.getW())
-            i = 0;
-        else if (i < 0)
-            i += di.getW();
-
-        // only if communicating along x-direction
-        if (ix && di.getW() == 1)
-            continue;
+        ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(),
+                                               access_location::host,
+                                               access_mode::read);
 
-        for (int iy = -1; iy <= 1; iy++)
+        // every domain that touches this one, possibly across a periodic boundary, is a neighbor.
+        // With a bisection decomposition, several neighbors may share a face.
+        for (unsigned int cart_idx = 0; cart_idx < di.getNumElements(); ++cart_idx)
             {
-            int j = iy + m;
+            Scalar3 lo, hi;
+            m_decomposition->getDomainBounds(cart_idx, lo, hi);
 
-            if (j == (int)di.getH())
-                j = 0;
-            else if (j < 0)
-                j += di.getH();
-
-            // only if communicating along y-direction
-            if (iy && di.getH() == 1)
-                continue;
-
-            for (int iz = -1; iz <= 1; iz++)
+            for (int sx = -n_shift.x; sx <= n_shift.x; sx++)
                 {
-                int k = iz + n;
-
-                if (k == (int)di.getD())
-                    k = 0;
-                else if (k < 0)
-                    k += di.getD();
-
-                // only if communicating along z-direction
-                if (iz && di.getD() == 1)
-                    continue;
-
-                // exclude ourselves
-                if (!ix && !iy && !iz)
-                    continue;
-
-                unsigned int dir = ((iz + 1) * 3 + (iy + 1)) * 3 + (ix + 1);
-                unsigned int mask = 1 << dir;
-
-                unsigned int neighbor = h_cart_ranks.data[di(i, j, k)];
-                h_neighbors.data[m_nneigh] = neighbor;
-                h_adj_mask.data[m_nneigh] = mask;
-                m_nneigh++;
+                for (int sy = -n_shift.y; sy <= n_shift.y; sy++)
+                    {
+                    for (int sz = -n_shift.z; sz <= n_shift.z; sz++)
+                        {
+                        int ix, iy, iz;
+                        if (!relative_position(lo.x + sx, hi.x + sx, my_lo.x, my_hi.x, ix)
+                            || !relative_position(lo.y + sy, hi.y + sy, my_lo.y, my_hi.y, iy)
+                            || !relative_position(lo.z + sz, hi.z + sz, my_lo.z, my_hi.z, iz))
+                            continue;
+
+                        // exclude ourselves
+                        if (!ix && !iy && !iz)
+                            continue;
+
+                        unsigned int dir = ((iz + 1) * 3 + (iy + 1)) * 3 + (ix + 1);
+                        neighbors.push_back(h_cart_ranks.data[cart_idx]);
+                        masks.push_back(1 << dir);
+                        }
+                    }
                 }
             }
         }
 
+    m_nneigh = (unsigned int)neighbors.size();
+    if (m_nneigh > m_neighbors.getNumElements())
+        {
+        m_neighbors.resize(m_nneigh);
+        m_unique_neighbors.resize(m_nneigh);
+        m_adj_mask.resize(m_nneigh);
+        m_begin.resize(m_nneigh);
+        m_end.resize(m_nneigh);
+        }
+
+    ArrayHandle<unsigned int> h_neighbors(m_neighbors,
+                                          access_location::host,
+                                          access_mode::overwrite);
+    ArrayHandle<unsigned int> h_adj_mask(m_adj_mask, access_location::host, access_mode::overwrite);
+    std::copy(neighbors.begin(), neighbors.end(), h_neighbors.data);
+    std::copy(masks.begin(), masks.end(), h_adj_mask.data);
+
     ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
                                                  access_location::host,
                                                  access_mode::overwrite);
@@ -1514,7 +1378,7 @@ void Communicator::initializeNeighborArrays()
 
     m_n_unique_neigh = (unsigned int)neigh_map.size();
 
-    n = 0;
+    unsigned int n = 0;
     for (std::map<unsigned int, unsigned int>::iterator it = neigh_map.begin();
          it != neigh_map.end();
          ++it)
@@ -1526,11 +1390,14 @@ void Communicator::initializeNeighborArrays()
     }
 
 //! Interface to the communication methods.
-void Communicator::communicate(uint64_t timestep)
+void Communicator::communicate(uint64_t timestep, bool defer_ghost_finish)
     {
     // Guard to prevent recursive triggering of migration
     m_is_communicating = true;
 
+    // complete a ghost update left pending by the previous call
+    finishUpdateGhosts(timestep);
+
     // update ghost communication flags
     m_flags = CommFlags(0);
     m_requested_flags.emit_accumulate([&](CommFlags f) { m_flags |= f; }, timestep);
@@ -1564,7 +1431,8 @@ void Communicator::communicate(uint64_t timestep)
         {
         beginUpdateGhosts(timestep);
 
-        finishUpdateGhosts(timestep);
+        if (!defer_ghost_finish)
+            finishUpdateGhosts(timestep);
         }
 
     // Check if migration of particles is requested
@@ -1572,12 +1440,17 @@ void Communicator::communicate(uint64_t timestep)
         {
         m_force_migrate = false;
 
+        // reallocate the per-particle arrays of subscribers at most once for both steps
+        m_pdata->beginCapacityBatch();
+
         // If so, migrate atoms
         migrateParticles();
 
         // Construct ghost send lists, exchange ghost atom data
         exchangeGhosts();
 
+        m_pdata->endCapacityBatch();
+
         // update particle data now that ghosts are available
         m_compute_callbacks.emit(timestep);
 
@@ -1603,6 +1476,15 @@ void Communicator::migrateParticles()
     // remove ghost particles from system
     m_pdata->removeAllGhostParticles();
 
+    if (m_decomposition->isBisection())
+        {
+        migrateParticlesBisection();
+
+        if (m_prof)
+            m_prof->pop();
+        return;
+        }
+
     // get box dimensions
     const BoxDim& box = m_pdata->getBox();
 
@@ -1825,6 +1707,19 @@ void Communicator::exchangeGhosts()
 
     m_exec_conf->msg->notice(7) << "Communicator: exchange ghosts" << std::endl;
 
+    // the ghosts on the neighboring ranks are replaced
+    m_delta_ghosts_valid = false;
+    m_ghost_requests_valid = false;
+
+    if (m_decomposition->isBisection())
+        {
+        exchangeGhostsBisection();
+
+        if (m_prof)
+            m_prof->pop();
+        return;
+        }
+
     const BoxDim& box = m_pdata->getBox();
 
     // Sending ghosts proceeds in two stages:
@@ -2691,8 +2586,72 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
 
     m_exec_conf->msg->notice(7) << "Communicator: update ghosts" << std::endl;
 
-    // update data in these arrays
+    // the ghost positions are overwritten
+    m_pdata->notifyPositionsChanged();
+
+    if (m_decomposition->isBisection())
+        {
+        updateGhostsBisection(false);
+
+        if (m_prof)
+            m_prof->pop();
+        return;
+        }
+
+    if (m_delta_ghost_updates)
+        {
+        updateGhostsDelta();
+
+        if (m_prof)
+            m_prof->pop();
+        return;
+        }
+
+    CommFlags flags = getFlags();
+
+    // only non-permanent fields (position, velocity, orientation) need to be considered here
+    // charge, body, image and diameter are not updated between neighbor list builds
+    CommFlags fields(0);
+    fields[comm_flag::position] = flags[comm_flag::position];
+    fields[comm_flag::velocity] = flags[comm_flag::velocity];
+    fields[comm_flag::orientation] = flags[comm_flag::orientation];
+    if (fields.none())
+        {
+        if (m_prof)
+            m_prof->pop();
+        return;
+        }
 
+    // compact positions are sent in a separate message from the other fields
+    const bool compact_pos = m_compact_ghost_positions && fields[comm_flag::position];
+    const unsigned int n_fields = (unsigned int)fields.count() - compact_pos;
+
+    // the ghost lists and fields stay the same between ghost exchanges, reuse the requests
+    if (!m_ghost_requests_valid || fields != m_ghost_request_flags)
+        initGhostUpdateRequests(fields);
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    // the fields of every ghost are packed contiguously into one message per direction
+    Scalar4* field_data[3];
+    unsigned int n = 0;
+    if (fields[comm_flag::position] && !compact_pos)
+        field_data[n++] = h_pos.data;
+    if (fields[comm_flag::velocity])
+        field_data[n++] = h_vel.data;
+    if (fields[comm_flag::orientation])
+        field_data[n++] = h_orientation.data;
+
+    const BoxDim shifted_box = getShiftedBox();
     unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
 
     for (unsigned int dir = 0; dir < 6; dir++)
@@ -2700,89 +2659,114 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
         if (!isCommunicating(dir))
             continue;
 
-        CommFlags flags = getFlags();
-
-        if (flags[comm_flag::position])
             {
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                       access_location::host,
-                                       access_mode::read);
-            ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf,
-                                               access_location::host,
-                                               access_mode::overwrite);
             ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
                                                     access_location::host,
                                                     access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
-                                             access_location::host,
-                                             access_mode::read);
 
-            // copy positions of ghost particles
+            // copy the fields of the ghost particles into the send buffer
+            Scalar4* sendbuf = m_ghost_sendbuf[dir].data();
             for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
                 {
                 unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
 
                 assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
 
-                // copy position into send buffer
-                h_pos_copybuf.data[ghost_idx] = h_pos.data[idx];
+                for (unsigned int f = 0; f < n_fields; ++f)
+                    *sendbuf++ = field_data[f][idx];
+                }
+
+            if (compact_pos)
+                {
+                const Scalar3 ref = getGhostFaceCenter(dir);
+                float3* pos_sendbuf = m_ghost_pos_sendbuf[dir].data();
+                for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+                    {
+                    const Scalar4& pos = h_pos.data[h_rtag.data[h_copy_ghosts.data[ghost_idx]]];
+                    *pos_sendbuf++ = make_float3(float(pos.x - ref.x),
+                                                 float(pos.y - ref.y),
+                                                 float(pos.z - ref.z));
+                    }
                 }
             }
 
-        if (flags[comm_flag::velocity])
+        unsigned int start_idx = m_pdata->getN() + num_tot_recv_ghosts;
+        num_tot_recv_ghosts += m_num_recv_ghosts[dir];
+
+        if (m_prof)
+            m_prof->push("MPI send/recv");
+
+        if (n_fields)
+            MPI_Startall(2, &m_ghost_requests[4 * dir]);
+        if (compact_pos)
+            MPI_Startall(2, &m_ghost_requests[4 * dir + 2]);
+        MPI_Waitall(4, &m_ghost_requests[4 * dir], MPI_STATUSES_IGNORE);
+
+        if (m_prof)
+            m_prof->pop(0,
+                        (m_num_recv_ghosts[dir] + m_num_copy_ghosts[dir])
+                            * (n_fields * sizeof(Scalar4) + compact_pos * sizeof(float3)));
+
+        // unpack the received ghosts into the particle data arrays
+        const Scalar4* recvbuf = m_ghost_recvbuf[dir].data();
+        for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
             {
-            ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
-                                       access_location::host,
-                                       access_mode::read);
-            ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf,
-                                                    access_location::host,
-                                                    access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
-                                                    access_location::host,
-                                                    access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
-                                             access_location::host,
-                                             access_mode::read);
+            for (unsigned int f = 0; f < n_fields; ++f)
+                field_data[f][idx] = *recvbuf++;
+            }
 
-            // copy velocity of ghost particles
-            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+        // the ghosts came from the neighbor across the opposite face, keep their types
+        if (compact_pos)
+            {
+            const Scalar3 ref = getGhostFaceCenter(dir ^ 1);
+            const float3* pos_recvbuf = m_ghost_pos_recvbuf[dir].data();
+            for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
                 {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
-
-                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
-
-                // copy velocity into send buffer
-                h_velocity_copybuf.data[ghost_idx] = h_vel.data[idx];
+                const float3& offset = *pos_recvbuf++;
+                h_pos.data[idx].x = ref.x + Scalar(offset.x);
+                h_pos.data[idx].y = ref.y + Scalar(offset.y);
+                h_pos.data[idx].z = ref.z + Scalar(offset.z);
                 }
             }
 
-        if (flags[comm_flag::orientation])
+        // wrap particle positions (only if copying positions)
+        if (fields[comm_flag::position])
             {
-            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                               access_location::host,
-                                               access_mode::read);
-            ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf,
-                                                       access_location::host,
-                                                       access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
-                                                    access_location::host,
-                                                    access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
-                                             access_location::host,
-                                             access_mode::read);
-
-            // copy orientation of ghost particles
-            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+            for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
                 {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
-
-                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+                Scalar4& pos = h_pos.data[idx];
 
-                // copy orientation into send buffer
-                h_orientation_copybuf.data[ghost_idx] = h_orientation.data[idx];
+                // wrap particles received across a global boundary
+                int3 img = make_int3(0, 0, 0);
+                shifted_box.wrap(pos, img);
                 }
             }
 
+        } // end dir loop
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! The ghost update sends one message per direction, with the fields of every ghost packed
+    contiguously. The number of ghosts and the fields stay the same between ghost exchanges, so
+    the messages are set up once as persistent requests that every update starts again. Compact
+    positions are sent in a second message per direction.
+
+    \param fields Ghost fields to send
+ */
+void Communicator::initGhostUpdateRequests(const CommFlags& fields)
+    {
+    freeGhostUpdateRequests();
+
+    const bool compact_pos = m_compact_ghost_positions && fields[comm_flag::position];
+    const unsigned int n_fields = (unsigned int)fields.count() - compact_pos;
+    m_ghost_requests.resize(24, MPI_REQUEST_NULL);
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        if (!isCommunicating(dir))
+            continue;
+
         unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
 
         // we receive from the direction opposite to the one we send to
@@ -2792,139 +2776,85 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
         else
             recv_neighbor = m_decomposition->getNeighborRank(dir - 1);
 
-        unsigned int start_idx;
-
-        if (m_prof)
-            m_prof->push("MPI send/recv");
-
-        start_idx = m_pdata->getN() + num_tot_recv_ghosts;
-
-        num_tot_recv_ghosts += m_num_recv_ghosts[dir];
-
-        size_t sz = 0;
-        // only non-permanent fields (position, velocity, orientation) need to be considered here
-        // charge, body, image and diameter are not updated between neighbor list builds
-        if (flags[comm_flag::position])
-            {
-            m_reqs.resize(2);
-            m_stats.resize(2);
-
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                       access_location::host,
-                                       access_mode::readwrite);
-            ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf,
-                                               access_location::host,
-                                               access_mode::read);
-
-            // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_pos_copybuf.data,
-                      (unsigned int)(m_num_copy_ghosts[dir] * sizeof(Scalar4)),
-                      MPI_BYTE,
-                      send_neighbor,
-                      1,
-                      m_mpi_comm,
-                      &m_reqs[0]);
-            MPI_Irecv(h_pos.data + start_idx,
-                      (unsigned int)(m_num_recv_ghosts[dir] * sizeof(Scalar4)),
-                      MPI_BYTE,
-                      recv_neighbor,
-                      1,
-                      m_mpi_comm,
-                      &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
-
-            sz += sizeof(Scalar4);
-            }
-
-        if (flags[comm_flag::velocity])
+        if (n_fields)
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
+            m_ghost_sendbuf[dir].resize(m_num_copy_ghosts[dir] * n_fields);
+            m_ghost_recvbuf[dir].resize(m_num_recv_ghosts[dir] * n_fields);
 
-            ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
-                                       access_location::host,
-                                       access_mode::readwrite);
-            ArrayHandle<Scalar4> h_vel_copybuf(m_velocity_copybuf,
-                                               access_location::host,
-                                               access_mode::read);
-
-            // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_vel_copybuf.data,
-                      (unsigned int)(m_num_copy_ghosts[dir] * sizeof(Scalar4)),
-                      MPI_BYTE,
-                      send_neighbor,
-                      2,
-                      m_mpi_comm,
-                      &m_reqs[0]);
-            MPI_Irecv(h_vel.data + start_idx,
-                      (unsigned int)(m_num_recv_ghosts[dir] * sizeof(Scalar4)),
-                      MPI_BYTE,
-                      recv_neighbor,
-                      2,
-                      m_mpi_comm,
-                      &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
-
-            sz += sizeof(Scalar4);
+            MPI_Send_init(m_ghost_sendbuf[dir].data(),
+                          (int)(m_ghost_sendbuf[dir].size() * sizeof(Scalar4)),
+                          MPI_BYTE,
+                          send_neighbor,
+                          1,
+                          m_mpi_comm,
+                          &m_ghost_requests[4 * dir]);
+            MPI_Recv_init(m_ghost_recvbuf[dir].data(),
+                          (int)(m_ghost_recvbuf[dir].size() * sizeof(Scalar4)),
+                          MPI_BYTE,
+                          recv_neighbor,
+                          1,
+                          m_mpi_comm,
+                          &m_ghost_requests[4 * dir + 1]);
             }
 
-        if (flags[comm_flag::orientation])
+        if (compact_pos)
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
-
-            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                               access_location::host,
-                                               access_mode::readwrite);
-            ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf,
-                                                       access_location::host,
-                                                       access_mode::read);
-
-            // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_orientation_copybuf.data,
-                      (unsigned int)(m_num_copy_ghosts[dir] * sizeof(Scalar4)),
-                      MPI_BYTE,
-                      send_neighbor,
-                      3,
-                      m_mpi_comm,
-                      &m_reqs[0]);
-            MPI_Irecv(h_orientation.data + start_idx,
-                      (unsigned int)(m_num_recv_ghosts[dir] * sizeof(Scalar4)),
-                      MPI_BYTE,
-                      recv_neighbor,
-                      3,
-                      m_mpi_comm,
-                      &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+            m_ghost_pos_sendbuf[dir].resize(m_num_copy_ghosts[dir]);
+            m_ghost_pos_recvbuf[dir].resize(m_num_recv_ghosts[dir]);
 
-            sz += sizeof(Scalar4);
+            MPI_Send_init(m_ghost_pos_sendbuf[dir].data(),
+                          (int)(m_ghost_pos_sendbuf[dir].size() * sizeof(float3)),
+                          MPI_BYTE,
+                          send_neighbor,
+                          2,
+                          m_mpi_comm,
+                          &m_ghost_requests[4 * dir + 2]);
+            MPI_Recv_init(m_ghost_pos_recvbuf[dir].data(),
+                          (int)(m_ghost_pos_recvbuf[dir].size() * sizeof(float3)),
+                          MPI_BYTE,
+                          recv_neighbor,
+                          2,
+                          m_mpi_comm,
+                          &m_ghost_requests[4 * dir + 3]);
             }
+        }
 
-        if (m_prof)
-            m_prof->pop(0, (m_num_recv_ghosts[dir] + m_num_copy_ghosts[dir]) * sz);
-
-        // wrap particle positions (only if copying positions)
-        if (flags[comm_flag::position])
-            {
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                       access_location::host,
-                                       access_mode::readwrite);
-
-            const BoxDim shifted_box = getShiftedBox();
-            for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
-                {
-                Scalar4& pos = h_pos.data[idx];
+    m_ghost_requests_valid = true;
+    m_ghost_request_flags = fields;
+    }
 
-                // wrap particles received across a global boundary
-                int3 img = make_int3(0, 0, 0);
-                shifted_box.wrap(pos, img);
-                }
-            }
+void Communicator::freeGhostUpdateRequests()
+    {
+    // the requests are released with MPI when the communicator outlives it
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    for (MPI_Request& req : m_ghost_requests)
+        {
+        if (req != MPI_REQUEST_NULL && !finalized)
+            MPI_Request_free(&req);
+        }
+    m_ghost_requests.clear();
+    m_ghost_requests_valid = false;
+    }
 
-        } // end dir loop
+/*! \param dir Direction of the face (see faceEnum)
+    \returns The center of the face of the local domain
 
-    if (m_prof)
-        m_prof->pop();
+    Neighboring domains of the grid decomposition share their faces, so the rank that sends a
+    ghost across a face and the rank that receives it compute the same point, up to a periodic
+    image of the global box that wrapping the ghost position removes.
+ */
+Scalar3 Communicator::getGhostFaceCenter(unsigned int dir) const
+    {
+    Scalar3 f = make_scalar3(0.5, 0.5, 0.5);
+    Scalar face = (dir % 2 == 0) ? Scalar(1.0) : Scalar(0.0);
+    if (dir / 2 == 0)
+        f.x = face;
+    else if (dir / 2 == 1)
+        f.y = face;
+    else
+        f.z = face;
+    return m_pdata->getBox().makeCoordinates(f);
     }
 
 void Communicator::updateNetForce(uint64_t timestep)
@@ -2960,6 +2890,15 @@ void Communicator::updateNetForce(uint64_t timestep)
 
     m_exec_conf->msg->notice(7) << oss.str() << std::endl;
 
+    if (m_decomposition->isBisection())
+        {
+        updateGhostsBisection(true);
+
+        if (m_prof)
+            m_prof->pop();
+        return;
+        }
+
     // Set some global counters
     unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
     unsigned int num_tot_recv_ghosts_reverse
@@ -3375,6 +3314,880 @@ void Communicator::updateNetForce(uint64_t timestep)
         m_prof->pop();
     }
 
+namespace
+    {
+//! Exchange per-neighbor segments of a buffer with every unique neighbor
+/*!
+ * \param send Send buffer, grouped by neighbor
+ * \param n_send Number of elements sent to every neighbor
+ * \param recv Receive buffer (resized), grouped by neighbor
+ * \param n_recv Number of elements received from every neighbor
+ * \param neighbors Ranks of the unique neighbors
+ * \param n_neigh Number of unique neighbors
+ * \param comm MPI communicator
+ */
+template<class T>
+void exchangeNeighborBuffers(const std::vector<T>& send,
+                             const std::vector<unsigned int>& n_send,
+                             std::vector<T>& recv,
+                             const std::vector<unsigned int>& n_recv,
+                             const unsigned int* neighbors,
+                             unsigned int n_neigh,
+                             const MPI_Comm comm)
+    {
+    unsigned int n_recv_tot = 0;
+    for (unsigned int ineigh = 0; ineigh < n_neigh; ++ineigh)
+        n_recv_tot += n_recv[ineigh];
+    recv.resize(n_recv_tot);
+
+    std::vector<MPI_Request> reqs;
+    unsigned int send_offset = 0;
+    unsigned int recv_offset = 0;
+    for (unsigned int ineigh = 0; ineigh < n_neigh; ++ineigh)
+        {
+        MPI_Request req;
+        if (n_send[ineigh])
+            {
+            MPI_Isend(send.data() + send_offset,
+                      int(n_send[ineigh] * sizeof(T)),
+                      MPI_BYTE,
+                      neighbors[ineigh],
+                      1,
+                      comm,
+                      &req);
+            reqs.push_back(req);
+            }
+        if (n_recv[ineigh])
+            {
+            MPI_Irecv(recv.data() + recv_offset,
+                      int(n_recv[ineigh] * sizeof(T)),
+                      MPI_BYTE,
+                      neighbors[ineigh],
+                      1,
+                      comm,
+                      &req);
+            reqs.push_back(req);
+            }
+        send_offset += n_send[ineigh];
+        recv_offset += n_recv[ineigh];
+        }
+
+    std::vector<MPI_Status> stats(reqs.size());
+    if (!reqs.empty())
+        MPI_Waitall((unsigned int)reqs.size(), &reqs.front(), &stats.front());
+    }
+
+//! Exchange the number of elements sent to every unique neighbor
+void exchangeNeighborCounts(const std::vector<unsigned int>& n_send,
+                            std::vector<unsigned int>& n_recv,
+                            const unsigned int* neighbors,
+                            unsigned int n_neigh,
+                            const MPI_Comm comm)
+    {
+    n_recv.resize(n_neigh);
+    std::vector<MPI_Request> reqs(2 * n_neigh);
+    std::vector<MPI_Status> stats(2 * n_neigh);
+    for (unsigned int ineigh = 0; ineigh < n_neigh; ++ineigh)
+        {
+        MPI_Isend(&n_send[ineigh], 1, MPI_UNSIGNED, neighbors[ineigh], 0, comm, &reqs[2 * ineigh]);
+        MPI_Irecv(&n_recv[ineigh],
+                  1,
+                  MPI_UNSIGNED,
+                  neighbors[ineigh],
+                  0,
+                  comm,
+                  &reqs[2 * ineigh + 1]);
+        }
+    if (n_neigh)
+        MPI_Waitall(2 * n_neigh, &reqs.front(), &stats.front());
+    }
+    } // end namespace
+
+void Communicator::checkBisectionSupport()
+    {
+    if (m_sysdef->getBondData()->getNGlobal() || m_sysdef->getAngleData()->getNGlobal()
+        || m_sysdef->getDihedralData()->getNGlobal() || m_sysdef->getImproperData()->getNGlobal()
+        || m_sysdef->getConstraintData()->getNGlobal() || m_sysdef->getPairData()->getNGlobal())
+        {
+        throw std::runtime_error(
+            "Bonded groups are not supported with a bisection domain decomposition.");
+        }
+
+    if (getFlags()[comm_flag::reverse_net_force])
+        {
+        throw std::runtime_error(
+            "Reverse net force communication is not supported with a bisection domain "
+            "decomposition.");
+        }
+    }
+
+/*! Particles that left the local domain are wrapped into the global box and sent directly to the
+ * neighboring domain that contains them.
+ */
+void Communicator::migrateParticlesBisection()
+    {
+    checkBisectionSupport();
+
+    const BoxDim& box = m_pdata->getBox();
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> h_comm_flag(m_pdata->getCommFlags(),
+                                              access_location::host,
+                                              access_mode::readwrite);
+
+        for (unsigned int idx = 0; idx < m_pdata->getN(); ++idx)
+            {
+            const Scalar4& postype = h_pos.data[idx];
+            Scalar3 f = box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+
+            bool leaves = false;
+            if (isCommunicating(face_east))
+                leaves |= f.x >= Scalar(1.0) || f.x < Scalar(0.0);
+            if (isCommunicating(face_north))
+                leaves |= f.y >= Scalar(1.0) || f.y < Scalar(0.0);
+            if (isCommunicating(face_up))
+                leaves |= f.z >= Scalar(1.0) || f.z < Scalar(0.0);
+            h_comm_flag.data[idx] = leaves ? 1 : 0;
+            }
+        }
+
+    std::vector<unsigned int> comm_flag_out; // not currently used
+    m_pdata->removeParticles(m_sendbuf, comm_flag_out);
+
+    ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(),
+                                           access_location::host,
+                                           access_mode::read);
+    ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
+                                                 access_location::host,
+                                                 access_mode::read);
+
+    // find the neighbor every particle is sent to, particles that stay are kept aside
+    const unsigned int my_rank = m_exec_conf->getRank();
+    std::vector<unsigned int> n_send(m_n_unique_neigh, 0);
+    std::vector<unsigned int> dest(m_sendbuf.size());
+    std::vector<detail::pdata_element> keep;
+    for (unsigned int i = 0; i < m_sendbuf.size(); ++i)
+        {
+        detail::pdata_element& p = m_sendbuf[i];
+        global_box.wrap(p.pos, p.image);
+
+        unsigned int rank
+            = m_decomposition->placeParticle(global_box,
+                                             make_scalar3(p.pos.x, p.pos.y, p.pos.z),
+                                             h_cart_ranks.data);
+        if (rank == my_rank)
+            {
+            keep.push_back(p);
+            dest[i] = m_n_unique_neigh;
+            continue;
+            }
+
+        const unsigned int* it = std::find(h_unique_neighbors.data,
+                                           h_unique_neighbors.data + m_n_unique_neigh,
+                                           rank);
+        if (it == h_unique_neighbors.data + m_n_unique_neigh)
+            {
+            std::ostringstream o;
+            o << "Particle " << p.tag << " moved beyond the neighboring domains." << std::endl;
+            throw std::runtime_error(o.str());
+            }
+        dest[i] = (unsigned int)(it - h_unique_neighbors.data);
+        n_send[dest[i]]++;
+        }
+
+    // group the particles by neighbor
+    std::vector<unsigned int> offset(m_n_unique_neigh + 1, 0);
+    for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
+        offset[ineigh + 1] = offset[ineigh] + n_send[ineigh];
+    std::vector<detail::pdata_element> sendbuf(offset[m_n_unique_neigh]);
+    for (unsigned int i = 0; i < m_sendbuf.size(); ++i)
+        {
+        if (dest[i] < m_n_unique_neigh)
+            sendbuf[offset[dest[i]]++] = m_sendbuf[i];
+        }
+
+    if (m_prof)
+        m_prof->push("MPI send/recv");
+
+    std::vector<unsigned int> n_recv;
+    exchangeNeighborCounts(n_send, n_recv, h_unique_neighbors.data, m_n_unique_neigh, m_mpi_comm);
+    exchangeNeighborBuffers(sendbuf,
+                            n_send,
+                            m_recvbuf,
+                            n_recv,
+                            h_unique_neighbors.data,
+                            m_n_unique_neigh,
+                            m_mpi_comm);
+
+    if (m_prof)
+        m_prof->pop();
+
+    m_recvbuf.insert(m_recvbuf.end(), keep.begin(), keep.end());
+    m_pdata->addParticles(m_recvbuf);
+    }
+
+/*! Every local particle is sent to every neighboring domain (and periodic image of it) whose box,
+ * extended by the ghost layer, contains the particle. The send lists are kept for the ghost
+ * updates.
+ */
+void Communicator::exchangeGhostsBisection()
+    {
+    checkBisectionSupport();
+    updateGhostWidth();
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    const int3 n_shift
+        = make_int3(di.getW() > 1 ? 1 : 0, di.getH() > 1 ? 1 : 0, di.getD() > 1 ? 1 : 0);
+
+    // the ghost layer widths as fractions of the global box
+    std::vector<Scalar3> ghost_fractions(m_pdata->getNTypes());
+    std::vector<Scalar3> ghost_fractions_body(m_pdata->getNTypes());
+        {
+        ArrayHandle<Scalar> h_r_ghost(m_r_ghost, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_r_ghost_body(m_r_ghost_body,
+                                           access_location::host,
+                                           access_mode::read);
+        const Scalar3 global_dist = global_box.getNearestPlaneDistance();
+        for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
+            {
+            ghost_fractions[cur_type] = h_r_ghost.data[cur_type] / global_dist;
+            ghost_fractions_body[cur_type] = h_r_ghost_body.data[cur_type] / global_dist;
+            }
+        }
+
+    ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
+                                                 access_location::host,
+                                                 access_mode::read);
+    std::vector<unsigned int> n_recv;
+    std::vector<detail::pdata_element> recvbuf;
+
+        {
+        ArrayHandle<unsigned int> h_cart_ranks_inv(m_decomposition->getInverseCartRanks(),
+                                                   access_location::host,
+                                                   access_mode::read);
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+
+        m_bisect_ghost_tags.clear();
+        m_bisect_ghost_shift.clear();
+        m_bisect_n_send.assign(m_n_unique_neigh, 0);
+        std::vector<detail::pdata_element> sendbuf;
+
+        for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
+            {
+            Scalar3 lo, hi;
+            m_decomposition->getDomainBounds(h_cart_ranks_inv.data[h_unique_neighbors.data[ineigh]],
+                                             lo,
+                                             hi);
+
+            for (unsigned int idx = 0; idx < m_pdata->getN(); ++idx)
+                {
+                const Scalar4& postype = h_pos.data[idx];
+                const unsigned int type = __scalar_as_int(postype.w);
+                Scalar3 ghost_fraction = ghost_fractions[type];
+                if (h_body.data[idx] < MIN_FLOPPY)
+                    ghost_fraction += ghost_fractions_body[type];
+
+                Scalar3 f = global_box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+
+                // test every periodic image of the neighbor
+                for (int sx = -n_shift.x; sx <= n_shift.x; sx++)
+                    {
+                    for (int sy = -n_shift.y; sy <= n_shift.y; sy++)
+                        {
+                        for (int sz = -n_shift.z; sz <= n_shift.z; sz++)
+                            {
+                            if (f.x < lo.x + sx - ghost_fraction.x
+                                || f.x >= hi.x + sx + ghost_fraction.x
+                                || f.y < lo.y + sy - ghost_fraction.y
+                                || f.y >= hi.y + sy + ghost_fraction.y
+                                || f.z < lo.z + sz - ghost_fraction.z
+                                || f.z >= hi.z + sz + ghost_fraction.z)
+                                continue;
+
+                            // move the ghost into the frame of the neighbor
+                            const int3 shift = make_int3(-sx, -sy, -sz);
+
+                            detail::pdata_element p = {};
+                            Scalar3 pos = global_box.shift(
+                                make_scalar3(postype.x, postype.y, postype.z),
+                                shift);
+                            p.pos = make_scalar4(pos.x, pos.y, pos.z, postype.w);
+                            p.vel = h_vel.data[idx];
+                            p.charge = h_charge.data[idx];
+                            p.diameter = h_diameter.data[idx];
+                            p.image = h_image.data[idx] - shift;
+                            p.body = h_body.data[idx];
+                            p.orientation = h_orientation.data[idx];
+                            p.tag = h_tag.data[idx];
+                            sendbuf.push_back(p);
+
+                            m_bisect_ghost_tags.push_back(h_tag.data[idx]);
+                            m_bisect_ghost_shift.push_back(shift);
+                            m_bisect_n_send[ineigh]++;
+                            }
+                        }
+                    }
+                }
+            }
+
+        if (m_prof)
+            m_prof->push("MPI send/recv");
+
+        exchangeNeighborCounts(m_bisect_n_send,
+                               n_recv,
+                               h_unique_neighbors.data,
+                               m_n_unique_neigh,
+                               m_mpi_comm);
+        exchangeNeighborBuffers(sendbuf,
+                                m_bisect_n_send,
+                                recvbuf,
+                                n_recv,
+                                h_unique_neighbors.data,
+                                m_n_unique_neigh,
+                                m_mpi_comm);
+
+        if (m_prof)
+            m_prof->pop();
+        }
+
+    m_bisect_n_recv = n_recv;
+
+    // append the ghosts at the end of the particle data arrays
+    unsigned int start_idx = m_pdata->getN() + m_pdata->getNGhosts();
+    m_pdata->addGhostParticles((unsigned int)recvbuf.size());
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
+                                     access_location::host,
+                                     access_mode::readwrite);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+        ArrayHandle<int3> h_image(m_pdata->getImages(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::readwrite);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::readwrite);
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::readwrite);
+
+        for (unsigned int i = 0; i < recvbuf.size(); ++i)
+            {
+            const detail::pdata_element& p = recvbuf[i];
+            unsigned int idx = start_idx + i;
+            h_pos.data[idx] = p.pos;
+            h_vel.data[idx] = p.vel;
+            h_charge.data[idx] = p.charge;
+            h_diameter.data[idx] = p.diameter;
+            h_image.data[idx] = p.image;
+            h_body.data[idx] = p.body;
+            h_orientation.data[idx] = p.orientation;
+            h_tag.data[idx] = p.tag;
+
+            assert(h_rtag.data[p.tag] == NOT_LOCAL);
+            h_rtag.data[p.tag] = idx;
+            }
+        }
+
+    m_ghosts_added = m_pdata->getNGhosts();
+    m_last_flags = getFlags();
+    }
+
+/*!
+ * \param net If true, update the net force, torque, and virial of the ghosts. Otherwise update the
+ *        positions, velocities, and orientations.
+ *
+ * The fields requested by the communication flags are packed into one buffer per ghost, in the
+ * order of the send lists built by exchangeGhostsBisection().
+ */
+void Communicator::updateGhostsBisection(bool net)
+    {
+    CommFlags flags = getFlags();
+    const bool send_pos = !net && flags[comm_flag::position];
+    const bool send_vel = !net && flags[comm_flag::velocity];
+    const bool send_orientation = !net && flags[comm_flag::orientation];
+    const bool send_force = net && flags[comm_flag::net_force];
+    const bool send_torque = net && flags[comm_flag::net_torque];
+    const bool send_virial = net && flags[comm_flag::net_virial];
+
+    const unsigned int stride
+        = 4 * (send_pos + send_vel + send_orientation + send_force + send_torque) + 6 * send_virial;
+    if (!stride)
+        return;
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const unsigned int pitch = (unsigned int)m_pdata->getNetVirial().getPitch();
+
+    auto pack4 = [](std::vector<Scalar>& buf, const Scalar4& v)
+    {
+        buf.push_back(v.x);
+        buf.push_back(v.y);
+        buf.push_back(v.z);
+        buf.push_back(v.w);
+    };
+    auto unpack4 = [](const Scalar*& ptr)
+    {
+        Scalar4 v = make_scalar4(ptr[0], ptr[1], ptr[2], ptr[3]);
+        ptr += 4;
+        return v;
+    };
+
+    std::vector<Scalar> sendbuf;
+    sendbuf.reserve(m_bisect_ghost_tags.size() * stride);
+
+        {
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::read);
+        ArrayHandle<Scalar4> h_netforce(m_pdata->getNetForce(),
+                                        access_location::host,
+                                        access_mode::read);
+        ArrayHandle<Scalar4> h_nettorque(m_pdata->getNetTorqueArray(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<Scalar> h_netvirial(m_pdata->getNetVirial(),
+                                        access_location::host,
+                                        access_mode::read);
+
+        for (unsigned int i = 0; i < m_bisect_ghost_tags.size(); ++i)
+            {
+            unsigned int idx = h_rtag.data[m_bisect_ghost_tags[i]];
+            assert(idx < m_pdata->getN());
+
+            if (send_pos)
+                {
+                const Scalar4& postype = h_pos.data[idx];
+                Scalar3 pos = global_box.shift(make_scalar3(postype.x, postype.y, postype.z),
+                                               m_bisect_ghost_shift[i]);
+                pack4(sendbuf, make_scalar4(pos.x, pos.y, pos.z, postype.w));
+                }
+            if (send_vel)
+                pack4(sendbuf, h_vel.data[idx]);
+            if (send_orientation)
+                pack4(sendbuf, h_orientation.data[idx]);
+            if (send_force)
+                pack4(sendbuf, h_netforce.data[idx]);
+            if (send_torque)
+                pack4(sendbuf, h_nettorque.data[idx]);
+            if (send_virial)
+                {
+                for (unsigned int k = 0; k < 6; ++k)
+                    sendbuf.push_back(h_netvirial.data[k * pitch + idx]);
+                }
+            }
+        }
+
+    // exchange in units of Scalar
+    std::vector<unsigned int> n_send(m_n_unique_neigh);
+    std::vector<unsigned int> n_recv(m_n_unique_neigh);
+    for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
+        {
+        n_send[ineigh] = m_bisect_n_send[ineigh] * stride;
+        n_recv[ineigh] = m_bisect_n_recv[ineigh] * stride;
+        }
+
+    if (m_prof)
+        m_prof->push("MPI send/recv");
+
+    std::vector<Scalar> recvbuf;
+        {
+        ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
+                                                     access_location::host,
+                                                     access_mode::read);
+        exchangeNeighborBuffers(sendbuf,
+                                n_send,
+                                recvbuf,
+                                n_recv,
+                                h_unique_neighbors.data,
+                                m_n_unique_neigh,
+                                m_mpi_comm);
+        }
+
+    if (m_prof)
+        m_prof->pop();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+    ArrayHandle<Scalar4> h_netforce(m_pdata->getNetForce(),
+                                    access_location::host,
+                                    access_mode::readwrite);
+    ArrayHandle<Scalar4> h_nettorque(m_pdata->getNetTorqueArray(),
+                                     access_location::host,
+                                     access_mode::readwrite);
+    ArrayHandle<Scalar> h_netvirial(m_pdata->getNetVirial(),
+                                    access_location::host,
+                                    access_mode::readwrite);
+
+    const Scalar* ptr = recvbuf.data();
+    const unsigned int n_ghosts = (unsigned int)(recvbuf.size() / stride);
+    for (unsigned int i = 0; i < n_ghosts; ++i)
+        {
+        unsigned int idx = m_pdata->getN() + i;
+        if (send_pos)
+            h_pos.data[idx] = unpack4(ptr);
+        if (send_vel)
+            h_vel.data[idx] = unpack4(ptr);
+        if (send_orientation)
+            h_orientation.data[idx] = unpack4(ptr);
+        if (send_force)
+            h_netforce.data[idx] = unpack4(ptr);
+        if (send_torque)
+            h_nettorque.data[idx] = unpack4(ptr);
+        if (send_virial)
+            {
+            for (unsigned int k = 0; k < 6; ++k)
+                h_netvirial.data[k * pitch + idx] = *ptr++;
+            }
+        }
+    }
+
+/*! Each direction first sends the indices (in the send list) of the ghosts whose communicated
+    fields changed since they were last sent, followed by the changed fields. The receiving rank
+    scatters them into its ghost arrays and keeps the values of all other ghosts. The first update
+    after a ghost exchange, or after the communicated fields change, sends all ghosts.
+ */
+void Communicator::updateGhostsDelta()
+    {
+    CommFlags flags = getFlags();
+
+    // the fields that are updated between ghost exchanges
+    CommFlags fields(0);
+    fields[comm_flag::position] = flags[comm_flag::position];
+    fields[comm_flag::velocity] = flags[comm_flag::velocity];
+    fields[comm_flag::orientation] = flags[comm_flag::orientation];
+
+    const bool full = !m_delta_ghosts_valid || fields != m_delta_flags;
+    const bool send_field[3] = {fields[comm_flag::position],
+                                fields[comm_flag::velocity],
+                                fields[comm_flag::orientation]};
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    Scalar4* const field_data[3] = {h_pos.data, h_vel.data, h_orientation.data};
+
+    const BoxDim shifted_box = getShiftedBox();
+    unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
+
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        if (!isCommunicating(dir))
+            continue;
+
+        const unsigned int n_copy = m_num_copy_ghosts[dir];
+        std::vector<Scalar4>* const sent[3]
+            = {&m_delta_sent_pos[dir], &m_delta_sent_vel[dir], &m_delta_sent_orientation[dir]};
+
+        // collect the ghosts that changed since they were last sent
+        m_delta_send_idx.clear();
+        for (unsigned int f = 0; f < 3; ++f)
+            {
+            m_delta_sendbuf[f].clear();
+            if (full)
+                sent[f]->resize(send_field[f] ? n_copy : 0);
+            }
+
+            {
+            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
+                                                    access_location::host,
+                                                    access_mode::read);
+
+            for (unsigned int ghost_idx = 0; ghost_idx < n_copy; ghost_idx++)
+                {
+                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+
+                bool changed = full;
+                for (unsigned int f = 0; f < 3 && !changed; ++f)
+                    {
+                    if (!send_field[f])
+                        continue;
+
+                    const Scalar4& cur = field_data[f][idx];
+                    const Scalar4& last = (*sent[f])[ghost_idx];
+                    changed = cur.x != last.x || cur.y != last.y || cur.z != last.z
+                              || cur.w != last.w;
+                    }
+
+                if (!changed)
+                    continue;
+
+                m_delta_send_idx.push_back(ghost_idx);
+                for (unsigned int f = 0; f < 3; ++f)
+                    {
+                    if (!send_field[f])
+                        continue;
+
+                    (*sent[f])[ghost_idx] = field_data[f][idx];
+                    m_delta_sendbuf[f].push_back(field_data[f][idx]);
+                    }
+                }
+            }
+
+        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+
+        // we receive from the direction opposite to the one we send to
+        unsigned int recv_neighbor;
+        if (dir % 2 == 0)
+            recv_neighbor = m_decomposition->getNeighborRank(dir + 1);
+        else
+            recv_neighbor = m_decomposition->getNeighborRank(dir - 1);
+
+        const unsigned int start_idx = m_pdata->getN() + num_tot_recv_ghosts;
+        num_tot_recv_ghosts += m_num_recv_ghosts[dir];
+
+        if (m_prof)
+            m_prof->push("MPI send/recv");
+
+        // the number of changed ghosts is given by the size of the index message
+        m_reqs.resize(1);
+        m_stats.resize(1);
+        MPI_Isend(m_delta_send_idx.data(),
+                  (int)m_delta_send_idx.size(),
+                  MPI_UNSIGNED,
+                  send_neighbor,
+                  1,
+                  m_mpi_comm,
+                  &m_reqs[0]);
+
+        MPI_Status status;
+        int n_recv = 0;
+        MPI_Probe(recv_neighbor, 1, m_mpi_comm, &status);
+        MPI_Get_count(&status, MPI_UNSIGNED, &n_recv);
+        assert((unsigned int)n_recv <= m_num_recv_ghosts[dir]);
+
+        m_delta_recv_idx.resize(n_recv);
+        MPI_Recv(m_delta_recv_idx.data(),
+                 n_recv,
+                 MPI_UNSIGNED,
+                 recv_neighbor,
+                 1,
+                 m_mpi_comm,
+                 MPI_STATUS_IGNORE);
+        MPI_Waitall(1, &m_reqs.front(), &m_stats.front());
+
+        // exchange the changed fields
+        m_reqs.clear();
+        for (unsigned int f = 0; f < 3; ++f)
+            {
+            if (!send_field[f])
+                continue;
+
+            m_delta_recvbuf[f].resize(n_recv);
+
+            MPI_Request req[2];
+            MPI_Isend(m_delta_sendbuf[f].data(),
+                      (int)(m_delta_sendbuf[f].size() * sizeof(Scalar4)),
+                      MPI_BYTE,
+                      send_neighbor,
+                      2 + f,
+                      m_mpi_comm,
+                      &req[0]);
+            MPI_Irecv(m_delta_recvbuf[f].data(),
+                      (int)(n_recv * sizeof(Scalar4)),
+                      MPI_BYTE,
+                      recv_neighbor,
+                      2 + f,
+                      m_mpi_comm,
+                      &req[1]);
+            m_reqs.push_back(req[0]);
+            m_reqs.push_back(req[1]);
+            }
+        m_stats.resize(m_reqs.size());
+        MPI_Waitall((int)m_reqs.size(), m_reqs.data(), m_stats.data());
+
+        if (m_prof)
+            m_prof->pop(0,
+                        (m_delta_send_idx.size() + n_recv)
+                            * (sizeof(unsigned int) + fields.count() * sizeof(Scalar4)));
+
+        // scatter the changed ghosts into the particle data
+        for (unsigned int f = 0; f < 3; ++f)
+            {
+            if (!send_field[f])
+                continue;
+
+            for (int i = 0; i < n_recv; ++i)
+                field_data[f][start_idx + m_delta_recv_idx[i]] = m_delta_recvbuf[f][i];
+            }
+
+        // wrap particles received across a global boundary
+        if (send_field[0])
+            {
+            for (int i = 0; i < n_recv; ++i)
+                {
+                int3 img = make_int3(0, 0, 0);
+                shifted_box.wrap(h_pos.data[start_idx + m_delta_recv_idx[i]], img);
+                }
+            }
+        } // end dir loop
+
+    m_delta_ghosts_valid = true;
+    m_delta_flags = fields;
+    }
+
+void Communicator::updateGhostScalars(GlobalArray<Scalar>& data)
+    {
+    assert(data.getNumElements() >= m_pdata->getN() + m_pdata->getNGhosts());
+
+    if (m_prof)
+        m_prof->push("comm_ghost_scalar");
+
+    ArrayHandle<Scalar> h_data(data, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    std::vector<Scalar> sendbuf;
+
+    if (m_decomposition->isBisection())
+        {
+        // the ghosts were received directly from every neighbor, in the order of the ghost tags
+        sendbuf.resize(m_bisect_ghost_tags.size());
+        for (unsigned int i = 0; i < m_bisect_ghost_tags.size(); ++i)
+            {
+            unsigned int idx = h_rtag.data[m_bisect_ghost_tags[i]];
+            assert(idx < m_pdata->getN());
+            sendbuf[i] = h_data.data[idx];
+            }
+
+        std::vector<Scalar> recvbuf;
+        ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
+                                                     access_location::host,
+                                                     access_mode::read);
+        exchangeNeighborBuffers(sendbuf,
+                                m_bisect_n_send,
+                                recvbuf,
+                                m_bisect_n_recv,
+                                h_unique_neighbors.data,
+                                m_n_unique_neigh,
+                                m_mpi_comm);
+
+        std::copy(recvbuf.begin(), recvbuf.end(), h_data.data + m_pdata->getN());
+
+        if (m_prof)
+            m_prof->pop();
+        return;
+        }
+
+    unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
+
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        if (!isCommunicating(dir))
+            continue;
+
+            {
+            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir],
+                                                    access_location::host,
+                                                    access_mode::read);
+
+            // ghosts received from previous directions are forwarded with the local particles
+            sendbuf.resize(m_num_copy_ghosts[dir]);
+            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+                {
+                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                assert(idx < m_pdata->getN() + num_tot_recv_ghosts);
+                sendbuf[ghost_idx] = h_data.data[idx];
+                }
+            }
+
+        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+
+        // we receive from the direction opposite to the one we send to
+        unsigned int recv_neighbor;
+        if (dir % 2 == 0)
+            recv_neighbor = m_decomposition->getNeighborRank(dir + 1);
+        else
+            recv_neighbor = m_decomposition->getNeighborRank(dir - 1);
+
+        unsigned int start_idx = m_pdata->getN() + num_tot_recv_ghosts;
+        num_tot_recv_ghosts += m_num_recv_ghosts[dir];
+
+        m_reqs.resize(2);
+        m_stats.resize(2);
+        MPI_Isend(sendbuf.data(),
+                  (int)(m_num_copy_ghosts[dir] * sizeof(Scalar)),
+                  MPI_BYTE,
+                  send_neighbor,
+                  1,
+                  m_mpi_comm,
+                  &m_reqs[0]);
+        MPI_Irecv(h_data.data + start_idx,
+                  (int)(m_num_recv_ghosts[dir] * sizeof(Scalar)),
+                  MPI_BYTE,
+                  recv_neighbor,
+                  1,
+                  m_mpi_comm,
+                  &m_reqs[1]);
+        MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 void Communicator::removeGhostParticleTags()
     {
     // wipe out reverse-lookup tag -> idx for old ghost atoms
@@ -3503,7 +4316,11 @@ void export_Communicator(pybind11::module& m)
     pybind11::class_<Communicator, std::shared_ptr<Communicator>>(m, "Communicator")
         .def(pybind11::init<std::shared_ptr<SystemDefinition>,
                             std::shared_ptr<DomainDecomposition>>())
-        .def_property_readonly("domain_decomposition", &Communicator::getDomainDecomposition);
+        .def_property_readonly("domain_decomposition", &Communicator::getDomainDecomposition)
+        .def("setDeltaGhostUpdates", &Communicator::setDeltaGhostUpdates)
+        .def("getDeltaGhostUpdates", &Communicator::getDeltaGhostUpdates)
+        .def("setCompactGhostPositions", &Communicator::setCompactGhostPositions)
+        .def("getCompactGhostPositions", &Communicator::getCompactGhostPositions);
     }
     } // end namespace detail
 
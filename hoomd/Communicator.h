@@ -277,6 +277,40 @@ class PYBIND11_EXPORT Communicator
         m_flags = flags;
         }
 
+    //! Set whether ghost updates send only the ghosts that changed since the last update
+    /*! Between two ghost exchanges, the receiving ranks keep the values of ghost particles that
+     *  did not change. Ghosts of static or slow particles then cost no bandwidth. Only the CPU
+     *  communicator with a grid decomposition supports delta updates.
+     */
+    void setDeltaGhostUpdates(bool delta)
+        {
+        m_delta_ghost_updates = delta;
+        m_delta_ghosts_valid = false;
+        }
+
+    //! Get whether ghost updates send only the ghosts that changed since the last update
+    bool getDeltaGhostUpdates() const
+        {
+        return m_delta_ghost_updates;
+        }
+
+    //! Set whether ghost updates send positions as single precision offsets
+    /*! The offsets are taken from the center of the domain face that the ghosts cross and the
+     *  particle types are not sent, as they only change in a ghost exchange. Only the CPU
+     *  communicator with a grid decomposition and without delta updates supports compact positions.
+     */
+    void setCompactGhostPositions(bool compact)
+        {
+        m_compact_ghost_positions = compact;
+        m_ghost_requests_valid = false;
+        }
+
+    //! Get whether ghost updates send positions as single precision offsets
+    bool getCompactGhostPositions() const
+        {
+        return m_compact_ghost_positions;
+        }
+
     //@}
 
     //! \name communication methods
@@ -285,8 +319,18 @@ class PYBIND11_EXPORT Communicator
     /*! Interface to the communication methods.
      * This method is supposed to be called every time step and automatically performs all necessary
      * communication steps.
+     *
+     * \param timestep The time step
+     * \param defer_ghost_finish If true, a ghost position update may be left pending on return.
+     *        The caller must then complete it with finishUpdateGhosts() before ghost data is read.
      */
-    void communicate(uint64_t timestep);
+    void communicate(uint64_t timestep, bool defer_ghost_finish = false);
+
+    //! Check whether a ghost update has begun but not yet finished
+    bool isGhostUpdatePending() const
+        {
+        return m_comm_pending;
+        }
 
     //@}
 
@@ -328,6 +372,18 @@ class PYBIND11_EXPORT Communicator
      */
     virtual void updateNetForce(uint64_t timestep);
 
+    /*! Copy a per-particle scalar from the local particles to their ghosts
+     * \param data Per-particle values, indexed like the particle data (at least N + Nghosts
+     *        elements)
+     *
+     * The values of the local particles are sent along the same paths as the ghost positions and
+     * written to the ghost elements of \a data on the neighboring ranks. Computes use this to
+     * share intermediate per-particle results, such as the embedding derivative of EAM.
+     *
+     * This is a collective call.
+     */
+    virtual void updateGhostScalars(GlobalArray<Scalar>& data);
+
     /*! This methods finds all the particles that are no longer inside the domain
      * boundaries and transfers them to neighboring processors.
      *
@@ -438,6 +494,10 @@ class PYBIND11_EXPORT Communicator
             m_groups_sendbuf; //!< Send buffer for group elements
         std::vector<typename group_data::packed_t>
             m_groups_recvbuf; //!< Receive buffer for group elements
+
+        //! Exchange rank-sorted elements with all unique neighbors
+        template<class element_t>
+        void exchangeElements(std::vector<element_t>& sendbuf, std::vector<element_t>& recvbuf);
         };
 
     //! Returns true if we are communicating particles along a given direction
@@ -463,6 +523,30 @@ class PYBIND11_EXPORT Communicator
     //! Helper function to update the shifted box for ghost particle PBC
     const BoxDim getShiftedBox() const;
 
+    //! Check that the system can be communicated with a bisection domain decomposition
+    void checkBisectionSupport();
+
+    //! Send particles directly to the neighboring domain that contains them (bisection)
+    void migrateParticlesBisection();
+
+    //! Exchange ghosts directly with all neighboring domains (bisection)
+    void exchangeGhostsBisection();
+
+    //! Update the ghosts directly from all neighboring domains (bisection)
+    void updateGhostsBisection(bool net);
+
+    //! Update only the ghosts that changed since the last update
+    void updateGhostsDelta();
+
+    //! Set up the persistent requests of the ghost update for the given fields
+    void initGhostUpdateRequests(const CommFlags& fields);
+
+    //! Free the persistent requests of the ghost update
+    void freeGhostUpdateRequests();
+
+    //! Get the point that compact ghost positions crossing a face of the local domain refer to
+    Scalar3 getGhostFaceCenter(unsigned int dir) const;
+
     std::shared_ptr<SystemDefinition> m_sysdef;                //!< System definition
     std::shared_ptr<ParticleData> m_pdata;                     //!< Particle data
     std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
@@ -671,6 +755,34 @@ class PYBIND11_EXPORT Communicator
     std::vector<detail::pdata_element> m_sendbuf; //!< Buffer for particles that are sent
     std::vector<detail::pdata_element> m_recvbuf; //!< Buffer for particles that are received
 
+    /* Direct ghost exchange with the neighbors of a bisection domain decomposition */
+    std::vector<unsigned int> m_bisect_ghost_tags; //!< Tags of the ghosts sent, by neighbor
+    std::vector<int3> m_bisect_ghost_shift;        //!< Periodic shift of every ghost sent
+    std::vector<unsigned int> m_bisect_n_send;     //!< Number of ghosts sent to every neighbor
+    std::vector<unsigned int> m_bisect_n_recv;     //!< Number of ghosts received per neighbor
+
+    /* Persistent requests of the ghost update */
+    bool m_ghost_requests_valid;                //!< True if the requests match the ghost lists
+    CommFlags m_ghost_request_flags;            //!< Ghost fields sent by the requests
+    std::vector<MPI_Request> m_ghost_requests;  //!< Send and receive request for every direction
+    std::vector<Scalar4> m_ghost_sendbuf[6];    //!< Packed ghost fields to send, per direction
+    std::vector<Scalar4> m_ghost_recvbuf[6];    //!< Packed ghost fields received, per direction
+    bool m_compact_ghost_positions;             //!< True if positions are sent as float offsets
+    std::vector<float3> m_ghost_pos_sendbuf[6]; //!< Compact ghost positions to send, per direction
+    std::vector<float3> m_ghost_pos_recvbuf[6]; //!< Compact ghost positions received, per direction
+
+    /* Delta updates of the ghosts */
+    bool m_delta_ghost_updates; //!< True if ghost updates only send the changed ghosts
+    bool m_delta_ghosts_valid;  //!< True if the last sent values match the ghosts of the neighbors
+    CommFlags m_delta_flags;    //!< Ghost fields communicated in the last delta update
+    std::vector<Scalar4> m_delta_sent_pos[6];         //!< Last sent positions, per direction
+    std::vector<Scalar4> m_delta_sent_vel[6];         //!< Last sent velocities, per direction
+    std::vector<Scalar4> m_delta_sent_orientation[6]; //!< Last sent orientations, per direction
+    std::vector<unsigned int> m_delta_send_idx;       //!< Send list indices of the changed ghosts
+    std::vector<unsigned int> m_delta_recv_idx;       //!< Receive indices of the changed ghosts
+    std::vector<Scalar4> m_delta_sendbuf[3];          //!< Changed ghost fields to send
+    std::vector<Scalar4> m_delta_recvbuf[3];          //!< Changed ghost fields received
+
     /* Communication of bonded groups */
     GroupCommunicator<BondData> m_bond_comm; //!< Communication helper for bonds
     friend class GroupCommunicator<BondData>;
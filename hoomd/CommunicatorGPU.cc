@@ -15,19 +15,32 @@
 #include "System.h"
 
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef OPEN_MPI
+#include <mpi-ext.h>
+#endif
 
 namespace hoomd
     {
 //! Constructor
 CommunicatorGPU::CommunicatorGPU(std::shared_ptr<SystemDefinition> sysdef,
                                  std::shared_ptr<DomainDecomposition> decomposition)
-    : Communicator(sysdef, decomposition), m_max_stages(1), m_num_stages(0), m_comm_mask(0),
+    : Communicator(sysdef, decomposition), m_mpi_cuda_aware(queryMPIDeviceSupport()),
+      m_max_stages(1), m_num_stages(0), m_comm_mask(0),
       m_bond_comm(*this, m_sysdef->getBondData()), m_angle_comm(*this, m_sysdef->getAngleData()),
       m_dihedral_comm(*this, m_sysdef->getDihedralData()),
       m_improper_comm(*this, m_sysdef->getImproperData()),
       m_constraint_comm(*this, m_sysdef->getConstraintData()),
       m_pair_comm(*this, m_sysdef->getPairData())
     {
+    if (m_decomposition->isBisection())
+        {
+        throw std::runtime_error(
+            "A bisection domain decomposition is not supported on the GPU communicator.");
+        }
+
     if (m_exec_conf->allConcurrentManagedAccess())
         {
         // inform the user to use a cuda-aware MPI
@@ -36,6 +49,17 @@ CommunicatorGPU::CommunicatorGPU(std::shared_ptr<SystemDefinition> sysdef,
             << std::endl;
         }
 
+    if (m_mpi_cuda_aware)
+        {
+        m_exec_conf->msg->notice(2) << "CommunicatorGPU: passing device buffers directly to MPI"
+                                    << std::endl;
+        }
+    else
+        {
+        m_exec_conf->msg->notice(3) << "CommunicatorGPU: staging MPI buffers through host memory"
+                                    << std::endl;
+        }
+
     // allocate memory
     allocateBuffers();
 
@@ -53,6 +77,41 @@ CommunicatorGPU::~CommunicatorGPU()
     hipEventDestroy(m_event);
     }
 
+/*! Open MPI reports the capabilities of the library loaded at run time. Other implementations
+    are detected through the environment variables that enable their GPU support. Without either,
+    fall back to the build configuration.
+*/
+bool CommunicatorGPU::queryMPIDeviceSupport()
+    {
+#if defined(__HIP_PLATFORM_NVCC__) && defined(MPIX_CUDA_AWARE_SUPPORT)
+#if MPIX_CUDA_AWARE_SUPPORT
+    return MPIX_Query_cuda_support() == 1;
+#else
+    return false;
+#endif
+#elif defined(__HIP_PLATFORM_HCC__) && defined(MPIX_ROCM_AWARE_SUPPORT)
+#if MPIX_ROCM_AWARE_SUPPORT
+    return MPIX_Query_rocm_support() == 1;
+#else
+    return false;
+#endif
+#else
+    // MVAPICH2 and Cray MPICH
+    for (const char* var : {"MV2_USE_CUDA", "MPICH_GPU_SUPPORT_ENABLED"})
+        {
+        const char* value = std::getenv(var);
+        if (value)
+            return std::strcmp(value, "1") == 0;
+        }
+
+#ifdef ENABLE_MPI_CUDA
+    return true;
+#else
+    return false;
+#endif
+#endif
+    }
+
 void CommunicatorGPU::allocateBuffers()
     {
     /*
@@ -139,6 +198,12 @@ void CommunicatorGPU::allocateBuffers()
     GlobalVector<Scalar> netvirial_ghost_sendbuf(m_exec_conf);
     m_netvirial_ghost_sendbuf.swap(netvirial_ghost_sendbuf);
 
+    GlobalVector<Scalar> scalar_ghost_sendbuf(m_exec_conf);
+    m_scalar_ghost_sendbuf.swap(scalar_ghost_sendbuf);
+
+    GlobalVector<Scalar> scalar_ghost_recvbuf(m_exec_conf);
+    m_scalar_ghost_recvbuf.swap(scalar_ghost_recvbuf);
+
     GlobalVector<Scalar> netvirial_ghost_recvbuf(m_exec_conf);
     m_netvirial_ghost_recvbuf.swap(netvirial_ghost_recvbuf);
 
@@ -162,6 +227,43 @@ void CommunicatorGPU::allocateBuffers()
 
     GlobalVector<unsigned int> scan(m_exec_conf);
     m_scan.swap(scan);
+
+    // count the buffers under the communicator in the memory accounting
+    TAG_ALLOCATION(m_gpu_sendbuf);
+    TAG_ALLOCATION(m_gpu_recvbuf);
+    TAG_ALLOCATION(m_comm_flags);
+    TAG_ALLOCATION(m_send_keys);
+    TAG_ALLOCATION(m_tag_ghost_sendbuf);
+    TAG_ALLOCATION(m_tag_ghost_recvbuf);
+    TAG_ALLOCATION(m_pos_ghost_sendbuf);
+    TAG_ALLOCATION(m_pos_ghost_recvbuf);
+    TAG_ALLOCATION(m_vel_ghost_sendbuf);
+    TAG_ALLOCATION(m_vel_ghost_recvbuf);
+    TAG_ALLOCATION(m_charge_ghost_sendbuf);
+    TAG_ALLOCATION(m_charge_ghost_recvbuf);
+    TAG_ALLOCATION(m_body_ghost_sendbuf);
+    TAG_ALLOCATION(m_body_ghost_recvbuf);
+    TAG_ALLOCATION(m_image_ghost_sendbuf);
+    TAG_ALLOCATION(m_image_ghost_recvbuf);
+    TAG_ALLOCATION(m_diameter_ghost_sendbuf);
+    TAG_ALLOCATION(m_diameter_ghost_recvbuf);
+    TAG_ALLOCATION(m_orientation_ghost_sendbuf);
+    TAG_ALLOCATION(m_orientation_ghost_recvbuf);
+    TAG_ALLOCATION(m_netforce_ghost_sendbuf);
+    TAG_ALLOCATION(m_netforce_ghost_recvbuf);
+    TAG_ALLOCATION(m_nettorque_ghost_sendbuf);
+    TAG_ALLOCATION(m_nettorque_ghost_recvbuf);
+    TAG_ALLOCATION(m_netvirial_ghost_sendbuf);
+    TAG_ALLOCATION(m_scalar_ghost_sendbuf);
+    TAG_ALLOCATION(m_scalar_ghost_recvbuf);
+    TAG_ALLOCATION(m_netvirial_ghost_recvbuf);
+    TAG_ALLOCATION(m_ghost_begin);
+    TAG_ALLOCATION(m_ghost_end);
+    TAG_ALLOCATION(m_ghost_plan);
+    TAG_ALLOCATION(m_ghost_idx_adj);
+    TAG_ALLOCATION(m_ghost_neigh);
+    TAG_ALLOCATION(m_neigh_counts);
+    TAG_ALLOCATION(m_scan);
     }
 
 void CommunicatorGPU::initializeCommunicationStages()
@@ -719,24 +821,19 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::migrateGroups(bool incom
             if (m_gpu_comm.m_prof)
                 m_gpu_comm.m_prof->push(m_exec_conf, "MPI send/recv");
 
-#ifdef ENABLE_MPI_CUDA
+            const access_location::Enum mpi_location = m_gpu_comm.m_mpi_cuda_aware
+                                                            ? access_location::device
+                                                            : access_location::host;
             ArrayHandle<rank_element_t> ranks_sendbuf_handle(m_ranks_sendbuf,
-                                                             access_location::device,
+                                                             mpi_location,
                                                              access_mode::read);
             ArrayHandle<rank_element_t> ranks_recvbuf_handle(m_ranks_recvbuf,
-                                                             access_location::device,
+                                                             mpi_location,
                                                              access_mode::overwrite);
 
             // MPI library may use non-zero stream
-            hipDeviceSynchronize();
-#else
-            ArrayHandle<rank_element_t> ranks_sendbuf_handle(m_ranks_sendbuf,
-                                                             access_location::host,
-                                                             access_mode::read);
-            ArrayHandle<rank_element_t> ranks_recvbuf_handle(m_ranks_recvbuf,
-                                                             access_location::host,
-                                                             access_mode::overwrite);
-#endif
+            if (m_gpu_comm.m_mpi_cuda_aware)
+                hipDeviceSynchronize();
 
             std::vector<MPI_Request> reqs;
             MPI_Request req;
@@ -1975,21 +2072,18 @@ void CommunicatorGPU::migrateParticles()
             if (m_prof)
                 m_prof->push(m_exec_conf, "MPI send/recv");
 
-#if defined(ENABLE_MPI_CUDA)
-            ArrayHandle<detail::pdata_element> gpu_sendbuf_handle(m_gpu_sendbuf,
-                                                                  access_location::device,
-                                                                  access_mode::read);
-            ArrayHandle<detail::pdata_element> gpu_recvbuf_handle(m_gpu_recvbuf,
-                                                                  access_location::device,
-                                                                  access_mode::overwrite);
-#else
+            const access_location::Enum mpi_location
+                = m_mpi_cuda_aware ? access_location::device : access_location::host;
             ArrayHandle<detail::pdata_element> gpu_sendbuf_handle(m_gpu_sendbuf,
-                                                                  access_location::host,
+                                                                  mpi_location,
                                                                   access_mode::read);
             ArrayHandle<detail::pdata_element> gpu_recvbuf_handle(m_gpu_recvbuf,
-                                                                  access_location::host,
+                                                                  mpi_location,
                                                                   access_mode::overwrite);
-#endif
+
+            // device-aware MPI transfers raw bytes, host staging uses the derived datatype
+            MPI_Datatype mpi_element = m_mpi_cuda_aware ? MPI_BYTE : m_mpi_pdata_element;
+            int element_count = m_mpi_cuda_aware ? int(sizeof(detail::pdata_element)) : 1;
 
             std::vector<MPI_Request> reqs;
             MPI_Request req;
@@ -2007,13 +2101,8 @@ void CommunicatorGPU::migrateParticles()
                 if (n_send_ptls[ineigh])
                     {
                     MPI_Isend(gpu_sendbuf_handle.data + h_begin.data[ineigh],
-#ifndef ENABLE_MPI_CUDA
-                              n_send_ptls[ineigh],
-                              m_mpi_pdata_element,
-#else
-                              n_send_ptls[ineigh] * sizeof(detail::pdata_element),
-                              MPI_BYTE,
-#endif
+                              int(n_send_ptls[ineigh]) * element_count,
+                              mpi_element,
                               neighbor,
                               1,
                               m_mpi_comm,
@@ -2025,13 +2114,8 @@ void CommunicatorGPU::migrateParticles()
                 if (n_recv_ptls[ineigh])
                     {
                     MPI_Irecv(gpu_recvbuf_handle.data + offs[ineigh],
-#ifndef ENABLE_MPI_CUDA
-                              n_recv_ptls[ineigh],
-                              m_mpi_pdata_element,
-#else
-                              n_recv_ptls[ineigh] * sizeof(detail::pdata_element),
-                              MPI_BYTE,
-#endif
+                              int(n_recv_ptls[ineigh]) * element_count,
+                              mpi_element,
                               neighbor,
                               1,
                               m_mpi_comm,
@@ -2529,118 +2613,76 @@ void CommunicatorGPU::exchangeGhosts()
         m_pdata->addGhostParticles(m_n_recv_ghosts_tot[stage]);
 
             {
-            unsigned int offs = 0;
-#ifdef ENABLE_MPI_CUDA
-            // recv buffers, write directly into particle data arrays
-            offs = first_idx;
-            ArrayHandle<unsigned int> tag_ghost_recvbuf_handle(m_pdata->getTags(),
-                                                               access_location::device,
-                                                               access_mode::readwrite);
-            ArrayHandle<Scalar4> pos_ghost_recvbuf_handle(m_pdata->getPositions(),
-                                                          access_location::device,
-                                                          access_mode::readwrite);
-            ArrayHandle<Scalar4> vel_ghost_recvbuf_handle(m_pdata->getVelocities(),
-                                                          access_location::device,
-                                                          access_mode::readwrite);
-            ArrayHandle<Scalar> charge_ghost_recvbuf_handle(m_pdata->getCharges(),
-                                                            access_location::device,
-                                                            access_mode::readwrite);
-            ArrayHandle<Scalar> diameter_ghost_recvbuf_handle(m_pdata->getDiameters(),
-                                                              access_location::device,
-                                                              access_mode::readwrite);
-            ArrayHandle<unsigned int> body_ghost_recvbuf_handle(m_pdata->getBodies(),
-                                                                access_location::device,
-                                                                access_mode::readwrite);
-            ArrayHandle<int3> image_ghost_recvbuf_handle(m_pdata->getImages(),
-                                                         access_location::device,
-                                                         access_mode::readwrite);
-            ArrayHandle<Scalar4> orientation_ghost_recvbuf_handle(m_pdata->getOrientationArray(),
-                                                                  access_location::device,
-                                                                  access_mode::readwrite);
-
-            // send buffers
-            ArrayHandle<unsigned int> tag_ghost_sendbuf_handle(m_tag_ghost_sendbuf,
-                                                               access_location::device,
-                                                               access_mode::read);
-            ArrayHandle<Scalar4> pos_ghost_sendbuf_handle(m_pos_ghost_sendbuf,
-                                                          access_location::device,
-                                                          access_mode::read);
-            ArrayHandle<Scalar4> vel_ghost_sendbuf_handle(m_vel_ghost_sendbuf,
-                                                          access_location::device,
-                                                          access_mode::read);
-            ArrayHandle<Scalar> charge_ghost_sendbuf_handle(m_charge_ghost_sendbuf,
-                                                            access_location::device,
-                                                            access_mode::read);
-            ArrayHandle<unsigned int> body_ghost_sendbuf_handle(m_body_ghost_sendbuf,
-                                                                access_location::device,
-                                                                access_mode::read);
-            ArrayHandle<int3> image_ghost_sendbuf_handle(m_image_ghost_sendbuf,
-                                                         access_location::device,
-                                                         access_mode::read);
-            ArrayHandle<Scalar> diameter_ghost_sendbuf_handle(m_diameter_ghost_sendbuf,
-                                                              access_location::device,
-                                                              access_mode::read);
-            ArrayHandle<Scalar4> orientation_ghost_sendbuf_handle(m_orientation_ghost_sendbuf,
-                                                                  access_location::device,
-                                                                  access_mode::read);
+            // with device-aware MPI, receive directly into the particle data arrays
+            unsigned int offs = m_mpi_cuda_aware ? first_idx : 0;
+            const access_location::Enum mpi_location
+                = m_mpi_cuda_aware ? access_location::device : access_location::host;
+            const access_mode::Enum recv_mode
+                = m_mpi_cuda_aware ? access_mode::readwrite : access_mode::overwrite;
 
-            // MPI library may use non-zero stream
-            hipDeviceSynchronize();
-#else
             // recv buffers
-            ArrayHandleAsync<unsigned int> tag_ghost_recvbuf_handle(m_tag_ghost_recvbuf,
-                                                                    access_location::host,
-                                                                    access_mode::overwrite);
-            ArrayHandleAsync<Scalar4> pos_ghost_recvbuf_handle(m_pos_ghost_recvbuf,
-                                                               access_location::host,
-                                                               access_mode::overwrite);
-            ArrayHandleAsync<Scalar4> vel_ghost_recvbuf_handle(m_vel_ghost_recvbuf,
-                                                               access_location::host,
-                                                               access_mode::overwrite);
-            ArrayHandleAsync<Scalar> charge_ghost_recvbuf_handle(m_charge_ghost_recvbuf,
-                                                                 access_location::host,
-                                                                 access_mode::overwrite);
-            ArrayHandleAsync<unsigned int> body_ghost_recvbuf_handle(m_body_ghost_recvbuf,
-                                                                     access_location::host,
-                                                                     access_mode::overwrite);
-            ArrayHandleAsync<int3> image_ghost_recvbuf_handle(m_image_ghost_recvbuf,
-                                                              access_location::host,
-                                                              access_mode::overwrite);
-            ArrayHandleAsync<Scalar> diameter_ghost_recvbuf_handle(m_diameter_ghost_recvbuf,
-                                                                   access_location::host,
-                                                                   access_mode::overwrite);
-            ArrayHandleAsync<Scalar4> orientation_ghost_recvbuf_handle(m_orientation_ghost_recvbuf,
-                                                                       access_location::host,
-                                                                       access_mode::overwrite);
+            ArrayHandleAsync<unsigned int> tag_ghost_recvbuf_handle(
+                m_mpi_cuda_aware ? m_pdata->getTags() : m_tag_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<Scalar4> pos_ghost_recvbuf_handle(
+                m_mpi_cuda_aware ? m_pdata->getPositions() : m_pos_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<Scalar4> vel_ghost_recvbuf_handle(
+                m_mpi_cuda_aware ? m_pdata->getVelocities() : m_vel_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<Scalar> charge_ghost_recvbuf_handle(
+                m_mpi_cuda_aware ? m_pdata->getCharges() : m_charge_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<Scalar> diameter_ghost_recvbuf_handle(
+                m_mpi_cuda_aware ? m_pdata->getDiameters() : m_diameter_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<unsigned int> body_ghost_recvbuf_handle(
+                m_mpi_cuda_aware ? m_pdata->getBodies() : m_body_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<int3> image_ghost_recvbuf_handle(
+                m_mpi_cuda_aware ? m_pdata->getImages() : m_image_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<Scalar4> orientation_ghost_recvbuf_handle(
+                m_mpi_cuda_aware ? m_pdata->getOrientationArray() : m_orientation_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+
             // send buffers
             ArrayHandleAsync<unsigned int> tag_ghost_sendbuf_handle(m_tag_ghost_sendbuf,
-                                                                    access_location::host,
+                                                                    mpi_location,
                                                                     access_mode::read);
             ArrayHandleAsync<Scalar4> pos_ghost_sendbuf_handle(m_pos_ghost_sendbuf,
-                                                               access_location::host,
+                                                               mpi_location,
                                                                access_mode::read);
             ArrayHandleAsync<Scalar4> vel_ghost_sendbuf_handle(m_vel_ghost_sendbuf,
-                                                               access_location::host,
+                                                               mpi_location,
                                                                access_mode::read);
             ArrayHandleAsync<Scalar> charge_ghost_sendbuf_handle(m_charge_ghost_sendbuf,
-                                                                 access_location::host,
+                                                                 mpi_location,
                                                                  access_mode::read);
+            ArrayHandleAsync<Scalar> diameter_ghost_sendbuf_handle(m_diameter_ghost_sendbuf,
+                                                                   mpi_location,
+                                                                   access_mode::read);
             ArrayHandleAsync<unsigned int> body_ghost_sendbuf_handle(m_body_ghost_sendbuf,
-                                                                     access_location::host,
+                                                                     mpi_location,
                                                                      access_mode::read);
             ArrayHandleAsync<int3> image_ghost_sendbuf_handle(m_image_ghost_sendbuf,
-                                                              access_location::host,
+                                                              mpi_location,
                                                               access_mode::read);
-            ArrayHandleAsync<Scalar> diameter_ghost_sendbuf_handle(m_diameter_ghost_sendbuf,
-                                                                   access_location::host,
-                                                                   access_mode::read);
             ArrayHandleAsync<Scalar4> orientation_ghost_sendbuf_handle(m_orientation_ghost_sendbuf,
-                                                                       access_location::host,
+                                                                       mpi_location,
                                                                        access_mode::read);
 
-            // lump together into one synchronization call
+            // lump together into one synchronization call, this also covers MPI libraries that
+            // use a non-zero stream
             hipDeviceSynchronize();
-#endif
 
             ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
                                                          access_location::host,
@@ -2919,12 +2961,14 @@ void CommunicatorGPU::exchangeGhosts()
                 m_prof->pop(m_exec_conf, 0, send_bytes + recv_bytes);
             } // end ArrayHandle scope
 
-#ifdef ENABLE_MPI_CUDA
-        // MPI library may use non-zero stream
-        hipDeviceSynchronize();
-#else
-            // only unpack in non-CUDA MPI builds
+        if (m_mpi_cuda_aware)
+            {
+            // MPI library may use non-zero stream
+            hipDeviceSynchronize();
+            }
+        else
             {
+            // unpack the host staged receive buffers into the particle data
             // access receive buffers
             ArrayHandle<unsigned int> d_tag_ghost_recvbuf(m_tag_ghost_recvbuf,
                                                           access_location::device,
@@ -3006,7 +3050,6 @@ void CommunicatorGPU::exchangeGhosts()
             if (m_exec_conf->isCUDAErrorCheckingEnabled())
                 CHECK_CUDA_ERROR();
             }
-#endif
 
         if (flags[comm_flag::tag])
             {
@@ -3043,6 +3086,9 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
     {
     m_exec_conf->msg->notice(7) << "CommunicatorGPU: ghost update" << std::endl;
 
+    // the ghost positions are overwritten
+    m_pdata->notifyPositionsChanged();
+
     if (m_prof)
         m_prof->push(m_exec_conf, "comm_ghost_update");
 
@@ -3142,62 +3188,36 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
             }
 
             {
-            unsigned int offs = 0;
-// access particle data
-#ifdef ENABLE_MPI_CUDA
-            offs = first_idx;
-            // recv buffers, directly write into particle data arrays
-            ArrayHandle<Scalar4> pos_ghost_recvbuf_handle(m_pdata->getPositions(),
-                                                          access_location::device,
-                                                          access_mode::readwrite);
-            ArrayHandle<Scalar4> vel_ghost_recvbuf_handle(m_pdata->getVelocities(),
-                                                          access_location::device,
-                                                          access_mode::readwrite);
-            ArrayHandle<Scalar4> orientation_ghost_recvbuf_handle(m_pdata->getOrientationArray(),
-                                                                  access_location::device,
-                                                                  access_mode::readwrite);
-
-            // send buffers
-            ArrayHandle<Scalar4> pos_ghost_sendbuf_handle(m_pos_ghost_sendbuf,
-                                                          access_location::device,
-                                                          access_mode::read);
-            ArrayHandle<Scalar4> vel_ghost_sendbuf_handle(m_vel_ghost_sendbuf,
-                                                          access_location::device,
-                                                          access_mode::read);
-            ArrayHandle<Scalar4> orientation_ghost_sendbuf_handle(m_orientation_ghost_sendbuf,
-                                                                  access_location::device,
-                                                                  access_mode::read);
-
-            ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-            ArrayHandle<unsigned int> h_ghost_begin(m_ghost_begin,
-                                                    access_location::host,
-                                                    access_mode::read);
+            // with device-aware MPI, receive directly into the particle data arrays
+            unsigned int offs = m_mpi_cuda_aware ? first_idx : 0;
+            const access_location::Enum mpi_location
+                = m_mpi_cuda_aware ? access_location::device : access_location::host;
+            const access_mode::Enum recv_mode
+                = m_mpi_cuda_aware ? access_mode::readwrite : access_mode::overwrite;
 
-            // MPI library may use non-zero stream
-            hipDeviceSynchronize();
-#else
             // recv buffers
-            ArrayHandle<Scalar4> pos_ghost_recvbuf_handle(m_pos_ghost_recvbuf,
-                                                          access_location::host,
-                                                          access_mode::overwrite);
-            ArrayHandle<Scalar4> vel_ghost_recvbuf_handle(m_vel_ghost_recvbuf,
-                                                          access_location::host,
-                                                          access_mode::overwrite);
-            ArrayHandle<Scalar4> orientation_ghost_recvbuf_handle(m_orientation_ghost_recvbuf,
-                                                                  access_location::host,
-                                                                  access_mode::overwrite);
+            ArrayHandleAsync<Scalar4> pos_ghost_recvbuf_handle(
+                m_mpi_cuda_aware ? m_pdata->getPositions() : m_pos_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<Scalar4> vel_ghost_recvbuf_handle(
+                m_mpi_cuda_aware ? m_pdata->getVelocities() : m_vel_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
+            ArrayHandleAsync<Scalar4> orientation_ghost_recvbuf_handle(
+                m_mpi_cuda_aware ? m_pdata->getOrientationArray() : m_orientation_ghost_recvbuf,
+                mpi_location,
+                recv_mode);
 
             // send buffers
             ArrayHandleAsync<Scalar4> pos_ghost_sendbuf_handle(m_pos_ghost_sendbuf,
-                                                               access_location::host,
+                                                               mpi_location,
                                                                access_mode::read);
             ArrayHandleAsync<Scalar4> vel_ghost_sendbuf_handle(m_vel_ghost_sendbuf,
-                                                               access_location::host,
+                                                               mpi_location,
                                                                access_mode::read);
             ArrayHandleAsync<Scalar4> orientation_ghost_sendbuf_handle(m_orientation_ghost_sendbuf,
-                                                                       access_location::host,
+                                                                       mpi_location,
                                                                        access_mode::read);
 
             ArrayHandleAsync<unsigned int> h_unique_neighbors(m_unique_neighbors,
@@ -3208,9 +3228,16 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
                                                          access_mode::read);
 
             // lump together into one synchronization call
-            hipEventRecord(m_event);
-            hipEventSynchronize(m_event);
-#endif
+            if (m_mpi_cuda_aware)
+                {
+                // MPI library may use non-zero stream
+                hipDeviceSynchronize();
+                }
+            else
+                {
+                hipEventRecord(m_event);
+                hipEventSynchronize(m_event);
+                }
 
             // access send buffers
             if (m_prof)
@@ -3342,8 +3369,114 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
 
         if (!m_comm_pending)
             {
-#ifndef ENABLE_MPI_CUDA
-            // only unpack in non-CUDA MPI builds
+            // only unpack when the receive buffers were staged on the host
+            if (!m_mpi_cuda_aware)
+                {
+                if (m_prof)
+                    {
+                    m_prof->push(m_exec_conf, "unpack");
+                    }
+
+                    {
+                    // access receive buffers
+                    ArrayHandle<Scalar4> d_pos_ghost_recvbuf(m_pos_ghost_recvbuf,
+                                                             access_location::device,
+                                                             access_mode::read);
+                    ArrayHandle<Scalar4> d_vel_ghost_recvbuf(m_vel_ghost_recvbuf,
+                                                             access_location::device,
+                                                             access_mode::read);
+                    ArrayHandle<Scalar4> d_orientation_ghost_recvbuf(m_orientation_ghost_recvbuf,
+                                                                     access_location::device,
+                                                                     access_mode::read);
+                    // access particle data
+                    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                               access_location::device,
+                                               access_mode::readwrite);
+                    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                                               access_location::device,
+                                               access_mode::readwrite);
+                    ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
+                                                       access_location::device,
+                                                       access_mode::readwrite);
+
+                    // copy recv buf into particle data
+                    gpu_exchange_ghosts_copy_buf(m_n_recv_ghosts_tot[stage],
+                                                 NULL,
+                                                 d_pos_ghost_recvbuf.data,
+                                                 d_vel_ghost_recvbuf.data,
+                                                 NULL,
+                                                 NULL,
+                                                 NULL,
+                                                 NULL,
+                                                 d_orientation_ghost_recvbuf.data,
+                                                 NULL,
+                                                 d_pos.data + first_idx,
+                                                 d_vel.data + first_idx,
+                                                 NULL,
+                                                 NULL,
+                                                 NULL,
+                                                 NULL,
+                                                 d_orientation.data + first_idx,
+                                                 false,
+                                                 flags[comm_flag::position],
+                                                 flags[comm_flag::velocity],
+                                                 false,
+                                                 false,
+                                                 false,
+                                                 false,
+                                                 flags[comm_flag::orientation]);
+
+                    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                        CHECK_CUDA_ERROR();
+                    }
+                if (m_prof)
+                    m_prof->pop(m_exec_conf);
+                }
+            }
+        } // end main communication loop
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+/*! Finish ghost update
+ *
+ * \param timestep The time step
+ */
+void CommunicatorGPU::finishUpdateGhosts(uint64_t timestep)
+    {
+    if (m_comm_pending)
+        {
+        m_comm_pending = false;
+
+        // the received ghost positions are unpacked below
+        m_pdata->notifyPositionsChanged();
+
+        if (m_prof)
+            m_prof->push(m_exec_conf, "comm_ghost_update");
+
+        // complete communication
+        if (m_prof)
+            m_prof->push(m_exec_conf, "MPI send/recv");
+        std::vector<MPI_Status> stats(m_reqs.size());
+        MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &stats.front());
+        if (m_prof)
+            {
+            m_prof->pop(m_exec_conf);
+            }
+
+        if (m_mpi_cuda_aware)
+            {
+            // MPI library may use non-zero stream
+            hipDeviceSynchronize();
+            }
+        else
+            {
+            // only unpack when the receive buffers were staged on the host
+            assert(m_num_stages == 1);
+            unsigned int stage = 0;
+            unsigned int first_idx = m_pdata->getN();
+            CommFlags flags = m_last_flags;
             if (m_prof)
                 {
                 m_prof->push(m_exec_conf, "unpack");
@@ -3403,107 +3536,8 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
                 }
             if (m_prof)
                 m_prof->pop(m_exec_conf);
-#endif
-            }
-        } // end main communication loop
-
-    if (m_prof)
-        m_prof->pop(m_exec_conf);
-    }
-
-/*! Finish ghost update
- *
- * \param timestep The time step
- */
-void CommunicatorGPU::finishUpdateGhosts(uint64_t timestep)
-    {
-    if (m_comm_pending)
-        {
-        m_comm_pending = false;
-
-        if (m_prof)
-            m_prof->push(m_exec_conf, "comm_ghost_update");
-
-        // complete communication
-        if (m_prof)
-            m_prof->push(m_exec_conf, "MPI send/recv");
-        std::vector<MPI_Status> stats(m_reqs.size());
-        MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &stats.front());
-        if (m_prof)
-            {
-            m_prof->pop(m_exec_conf);
-            }
-
-#ifdef ENABLE_MPI_CUDA
-        // MPI library may use non-zero stream
-        hipDeviceSynchronize();
-#else
-        // only unpack in non-CUDA-MPI builds
-        assert(m_num_stages == 1);
-        unsigned int stage = 0;
-        unsigned int first_idx = m_pdata->getN();
-        CommFlags flags = m_last_flags;
-        if (m_prof)
-            {
-            m_prof->push(m_exec_conf, "unpack");
             }
 
-            {
-            // access receive buffers
-            ArrayHandle<Scalar4> d_pos_ghost_recvbuf(m_pos_ghost_recvbuf,
-                                                     access_location::device,
-                                                     access_mode::read);
-            ArrayHandle<Scalar4> d_vel_ghost_recvbuf(m_vel_ghost_recvbuf,
-                                                     access_location::device,
-                                                     access_mode::read);
-            ArrayHandle<Scalar4> d_orientation_ghost_recvbuf(m_orientation_ghost_recvbuf,
-                                                             access_location::device,
-                                                             access_mode::read);
-            // access particle data
-            ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
-                                       access_location::device,
-                                       access_mode::readwrite);
-            ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
-                                       access_location::device,
-                                       access_mode::readwrite);
-            ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
-                                               access_location::device,
-                                               access_mode::readwrite);
-
-            // copy recv buf into particle data
-            gpu_exchange_ghosts_copy_buf(m_n_recv_ghosts_tot[stage],
-                                         NULL,
-                                         d_pos_ghost_recvbuf.data,
-                                         d_vel_ghost_recvbuf.data,
-                                         NULL,
-                                         NULL,
-                                         NULL,
-                                         NULL,
-                                         d_orientation_ghost_recvbuf.data,
-                                         NULL,
-                                         d_pos.data + first_idx,
-                                         d_vel.data + first_idx,
-                                         NULL,
-                                         NULL,
-                                         NULL,
-                                         NULL,
-                                         d_orientation.data + first_idx,
-                                         false,
-                                         flags[comm_flag::position],
-                                         flags[comm_flag::velocity],
-                                         false,
-                                         false,
-                                         false,
-                                         false,
-                                         flags[comm_flag::orientation]);
-
-            if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                CHECK_CUDA_ERROR();
-            }
-        if (m_prof)
-            m_prof->pop(m_exec_conf);
-#endif
-
         if (m_prof)
             m_prof->pop(m_exec_conf);
         }
@@ -3902,6 +3936,139 @@ void CommunicatorGPU::updateNetForce(uint64_t timestep)
         m_prof->pop(m_exec_conf);
     }
 
+/*! \param data Per-particle values, indexed like the particle data (at least N + Nghosts
+           elements)
+ */
+void CommunicatorGPU::updateGhostScalars(GlobalArray<Scalar>& data)
+    {
+    assert(data.getNumElements() >= m_pdata->getN() + m_pdata->getNGhosts());
+
+    if (m_prof)
+        m_prof->push(m_exec_conf, "comm_ghost_scalar");
+
+    // main communication loop
+    for (unsigned int stage = 0; stage < m_num_stages; ++stage)
+        {
+        // compute maximum send buf size
+        unsigned int n_max = 0;
+        for (unsigned int istage = 0; istage <= stage; ++istage)
+            if (m_n_send_ghosts_tot[istage] > n_max)
+                n_max = m_n_send_ghosts_tot[istage];
+
+        m_scalar_ghost_sendbuf.resize(n_max);
+
+            {
+            ArrayHandle<Scalar> d_data(data, access_location::device, access_mode::read);
+            ArrayHandle<uint2> d_ghost_idx_adj(m_ghost_idx_adj,
+                                               access_location::device,
+                                               access_mode::read);
+            ArrayHandle<Scalar> d_scalar_ghost_sendbuf(m_scalar_ghost_sendbuf,
+                                                       access_location::device,
+                                                       access_mode::overwrite);
+
+            // Pack ghosts into send buffers
+            gpu_exchange_ghosts_pack_scalar(m_n_send_ghosts_tot[stage],
+                                            d_ghost_idx_adj.data + m_idx_offs[stage],
+                                            d_data.data,
+                                            d_scalar_ghost_sendbuf.data);
+
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+
+        n_max = 0;
+        // compute maximum number of received ghosts
+        for (unsigned int istage = 0; istage <= stage; ++istage)
+            if (m_n_recv_ghosts_tot[istage] > n_max)
+                n_max = m_n_recv_ghosts_tot[istage];
+
+        m_scalar_ghost_recvbuf.resize(n_max);
+
+        // first ghost ptl index
+        unsigned int first_idx = m_pdata->getN();
+
+        // total up ghosts received thus far
+        for (unsigned int istage = 0; istage < stage; ++istage)
+            {
+            first_idx += m_n_recv_ghosts_tot[istage];
+            }
+
+            {
+            ArrayHandle<Scalar> h_scalar_ghost_recvbuf(m_scalar_ghost_recvbuf,
+                                                       access_location::host,
+                                                       access_mode::overwrite);
+            ArrayHandle<Scalar> h_scalar_ghost_sendbuf(m_scalar_ghost_sendbuf,
+                                                       access_location::host,
+                                                       access_mode::read);
+
+            ArrayHandleAsync<unsigned int> h_unique_neighbors(m_unique_neighbors,
+                                                              access_location::host,
+                                                              access_mode::read);
+            ArrayHandleAsync<unsigned int> h_ghost_begin(m_ghost_begin,
+                                                         access_location::host,
+                                                         access_mode::read);
+
+            m_reqs.clear();
+            MPI_Request req;
+
+            // loop over neighbors
+            for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
+                {
+                // rank of neighbor processor
+                unsigned int neighbor = h_unique_neighbors.data[ineigh];
+
+                if (m_n_send_ghosts[stage][ineigh])
+                    {
+                    MPI_Isend(h_scalar_ghost_sendbuf.data
+                                  + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
+                              int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar)),
+                              MPI_BYTE,
+                              neighbor,
+                              5,
+                              m_mpi_comm,
+                              &req);
+                    m_reqs.push_back(req);
+                    }
+
+                if (m_n_recv_ghosts[stage][ineigh])
+                    {
+                    MPI_Irecv(h_scalar_ghost_recvbuf.data + m_ghost_offs[stage][ineigh],
+                              int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar)),
+                              MPI_BYTE,
+                              neighbor,
+                              5,
+                              m_mpi_comm,
+                              &req);
+                    m_reqs.push_back(req);
+                    }
+                }
+
+            // complete communication
+            std::vector<MPI_Status> stats(m_reqs.size());
+            if (!m_reqs.empty())
+                MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &stats.front());
+            }
+
+            {
+            ArrayHandle<Scalar> d_scalar_ghost_recvbuf(m_scalar_ghost_recvbuf,
+                                                       access_location::device,
+                                                       access_mode::read);
+            ArrayHandle<Scalar> d_data(data, access_location::device, access_mode::readwrite);
+
+            // copy recv buf into the ghost elements
+            gpu_exchange_ghosts_copy_scalar_buf(m_n_recv_ghosts_tot[stage],
+                                                d_scalar_ghost_recvbuf.data,
+                                                d_data.data + first_idx);
+
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+        } // end main communication loop
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
 namespace detail
     {
 //! Export CommunicatorGPU class to python
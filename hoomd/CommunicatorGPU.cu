@@ -1333,6 +1333,47 @@ void gpu_exchange_ghosts_copy_netvirial_buf(unsigned int n_recv,
                        pitch_out);
     }
 
+void gpu_exchange_ghosts_pack_scalar(unsigned int n_out,
+                                     const uint2* d_ghost_idx_adj,
+                                     const Scalar* d_data,
+                                     Scalar* d_sendbuf)
+    {
+    assert(d_ghost_idx_adj);
+    assert(d_data);
+    assert(d_sendbuf);
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = n_out / block_size + 1;
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_pack_kernel<Scalar>),
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       n_out,
+                       d_ghost_idx_adj,
+                       d_data,
+                       d_sendbuf);
+    }
+
+void gpu_exchange_ghosts_copy_scalar_buf(unsigned int n_recv,
+                                         const Scalar* d_recvbuf,
+                                         Scalar* d_data)
+    {
+    assert(d_recvbuf);
+    assert(d_data);
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = n_recv / block_size + 1;
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_unpack_kernel<Scalar>),
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       n_recv,
+                       d_recvbuf,
+                       d_data);
+    }
+
 template<class members_t, class ranks_t, class group_element_t>
 __global__ void gpu_unpack_groups_kernel(unsigned int nrecv,
                                          const group_element_t* d_groups_recvbuf,
@@ -338,5 +338,14 @@ void gpu_exchange_ghosts_copy_netvirial_buf(unsigned int n_recv,
                                             const Scalar* d_netvirial_recvbuf,
                                             Scalar* d_netvirial,
                                             unsigned int pitch_out);
+
+void gpu_exchange_ghosts_pack_scalar(unsigned int n_out,
+                                     const uint2* d_ghost_idx_adj,
+                                     const Scalar* d_data,
+                                     Scalar* d_sendbuf);
+
+void gpu_exchange_ghosts_copy_scalar_buf(unsigned int n_recv,
+                                         const Scalar* d_recvbuf,
+                                         Scalar* d_data);
     }  // end namespace hoomd
 #endif // ENABLE_MPI
@@ -59,6 +59,12 @@ class PYBIND11_EXPORT CommunicatorGPU : public Communicator
      */
     virtual void finishUpdateGhosts(uint64_t timestep);
 
+    //! Check whether device buffers are passed directly to MPI
+    bool isMPICUDAAware() const
+        {
+        return m_mpi_cuda_aware;
+        }
+
     //! Transfer particles between neighboring domains
     virtual void migrateParticles();
 
@@ -69,6 +75,9 @@ class PYBIND11_EXPORT CommunicatorGPU : public Communicator
      * \parm timestep The time step
      */
     virtual void updateNetForce(uint64_t timestep);
+
+    //! Copy a per-particle scalar from the local particles to their ghosts
+    virtual void updateGhostScalars(GlobalArray<Scalar>& data);
     //@}
 
     //! Set maximum number of communication stages
@@ -158,8 +167,12 @@ class PYBIND11_EXPORT CommunicatorGPU : public Communicator
     //! Remove tags of ghost particles
     virtual void removeGhostParticleTags();
 
+    //! Query whether the MPI library in use can access device memory
+    static bool queryMPIDeviceSupport();
+
     private:
     /* General communication */
+    bool m_mpi_cuda_aware;                 //!< True if MPI calls are passed device buffers
     unsigned int m_max_stages;             //!< Maximum number of (dependent) communication stages
     unsigned int m_num_stages;             //!< Number of stages
     std::vector<unsigned int> m_comm_mask; //!< Communication mask per stage
@@ -226,6 +239,9 @@ class PYBIND11_EXPORT CommunicatorGPU : public Communicator
     GlobalVector<Scalar> m_netvirial_ghost_sendbuf; //!< Send buffer for netvirial
     GlobalVector<Scalar> m_netvirial_ghost_recvbuf; //!< Recv buffer for netvirial
 
+    GlobalVector<Scalar> m_scalar_ghost_sendbuf; //!< Send buffer for per-particle scalars
+    GlobalVector<Scalar> m_scalar_ghost_recvbuf; //!< Recv buffer for per-particle scalars
+
     GlobalVector<unsigned int>
         m_ghost_begin; //!< Begin index for every stage and neighbor in send buf
     GlobalVector<unsigned int> m_ghost_end; //!< Begin index for every and neighbor in send buf
@@ -123,7 +123,8 @@ void export_Compute(pybind11::module& m)
         .def("compute", &Compute::compute)
         .def("benchmark", &Compute::benchmark)
         .def("setProfiler", &Compute::setProfiler)
-        .def("notifyDetach", &Compute::notifyDetach);
+        .def("notifyDetach", &Compute::notifyDetach)
+        .def_property_readonly("execution_time", &Compute::getExecutionTime);
     }
     } // end namespace detail
 
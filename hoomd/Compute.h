@@ -103,6 +103,12 @@ class PYBIND11_EXPORT Compute
     /// Python will notify C++ objects when they are detached from Simulation
     virtual void notifyDetach() {};
 
+    /// Get the total wall clock time spent executing this compute [s]
+    double getExecutionTime() const
+        {
+        return double(m_execution_time) / 1e9;
+        }
+
     void addSlot(std::shared_ptr<hoomd::detail::SignalSlot> slot)
         {
         m_slots.push_back(slot);
@@ -139,6 +145,12 @@ class PYBIND11_EXPORT Compute
     uint64_t m_last_computed; //!< Stores the last timestep compute was called
     bool m_first_compute;     //!< true if compute has not yet been called
 
+    /// Clock that derived classes use to time their computations
+    ClockSource m_execution_clock;
+
+    /// Total wall clock time spent in computations [ns]
+    int64_t m_execution_time = 0;
+
     //! Simple method for testing if the computation should be run or not
     virtual bool shouldCompute(uint64_t timestep);
 
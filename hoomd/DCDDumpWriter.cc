@@ -48,6 +48,26 @@ static unsigned int read_int(fstream& file)
     file.read((char*)&val, sizeof(unsigned int));
     return val;
     }
+
+//! simple helper function to append bytes to a buffer
+/*! \param buf buffer to append to
+    \param data bytes to append
+    \param n number of bytes
+*/
+static void append_bytes(std::vector<char>& buf, const void* data, size_t n)
+    {
+    const char* bytes = (const char*)data;
+    buf.insert(buf.end(), bytes, bytes + n);
+    }
+
+//! simple helper function to append an integer to a buffer
+/*! \param buf buffer to append to
+    \param val integer to append
+*/
+static void append_int(std::vector<char>& buf, unsigned int val)
+    {
+    append_bytes(buf, &val, sizeof(unsigned int));
+    }
     } // end namespace detail
 
 /*! Constructs the DCDDumpWriter. After construction, settings are set. No file operations are
@@ -80,7 +100,6 @@ DCDDumpWriter::DCDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
 //! Initializes the output file for writing
 void DCDDumpWriter::initFileIO(uint64_t timestep)
     {
-    m_staging_buffer = new float[m_pdata->getNGlobal()];
     m_is_initialized = true;
 
     m_nglobal = m_pdata->getNGlobal();
@@ -137,10 +156,28 @@ DCDDumpWriter::~DCDDumpWriter()
     if (m_is_initialized)
         {
         m_file.close();
-        delete[] m_staging_buffer;
         }
     }
 
+/*! \param timestep Current time step of the simulation
+    Queues the device to host copies of the arrays that analyze() reads.
+*/
+void DCDDumpWriter::prefetch(uint64_t timestep)
+    {
+#ifdef ENABLE_HIP
+    if (!m_exec_conf->isCUDAEnabled())
+        return;
+
+    m_pdata->getPositions().prefetchToHost();
+    m_pdata->getImages().prefetchToHost();
+    m_pdata->getTags().prefetchToHost();
+    if (m_unwrap_rigid)
+        m_pdata->getBodies().prefetchToHost();
+    if (m_angle)
+        m_pdata->getOrientationArray().prefetchToHost();
+#endif
+    }
+
 /*! \param timestep Current time step of the simulation
     The very first call to analyze() will result in the creation (or overwriting) of the
     file fname and the writing of the current timestep snapshot. After that, each call to analyze
@@ -152,10 +189,14 @@ void DCDDumpWriter::analyze(uint64_t timestep)
     if (m_prof)
         m_prof->push("Dump DCD");
 
-    // take particle data snapshot
-    SnapshotParticleData<Scalar> snapshot;
+    // rigid bodies are unwrapped with the image of the central particle, which may be on another
+    // rank, so gather the fields of all particles in that case
+    bool unwrap_rigid = m_unwrap_rigid && !m_unwrap_full;
 
-    m_pdata->takeSnapshot(snapshot);
+    if (unwrap_rigid)
+        gatherSnapshotPositions();
+    else
+        gatherFramePositions();
 
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
@@ -197,10 +238,22 @@ void DCDDumpWriter::analyze(uint64_t timestep)
             << " which is not specified in the period of the DCD file: " << m_start_timestep
             << " + i * " << m_period << endl;
 
-    // write the data for the current time step
+    if (unwrap_rigid)
+        fillFramePositions();
+
+    // write the data for the current time step with a single call
+    m_write_buffer.clear();
+    write_frame_header();
+    write_frame_data();
+
     m_file.seekp(0, std::ios_base::end);
-    write_frame_header(m_file);
-    write_frame_data(m_file, snapshot);
+    m_file.write(m_write_buffer.data(), m_write_buffer.size());
+
+    // check for errors
+    if (!m_file.good())
+        {
+        throw runtime_error("DCD: I/O error while writing DCD frame.");
+        }
 
     // update the header with the number of frames written
     m_num_frames_written++;
@@ -280,11 +333,10 @@ void DCDDumpWriter::write_file_header(std::fstream& file)
         }
     }
 
-/*! \param file File to write to
-    Writes the header that precedes each snapshot in the file. This header
+/*! Appends the header that precedes each snapshot to the write buffer. This header
     includes information on the box size of the simulation.
 */
-void DCDDumpWriter::write_frame_header(std::fstream& file)
+void DCDDumpWriter::write_frame_header()
     {
     double unitcell[6];
     BoxDim box = m_pdata->getGlobalBox();
@@ -308,105 +360,194 @@ void DCDDumpWriter::write_frame_header(std::fstream& file)
     unitcell[3] = beta;
     unitcell[4] = alpha;
 
-    detail::write_int(file, 48);
-    file.write((char*)unitcell, 48);
-    detail::write_int(file, 48);
+    detail::append_int(m_write_buffer, 48);
+    detail::append_bytes(m_write_buffer, unitcell, 48);
+    detail::append_int(m_write_buffer, 48);
+    }
 
-    // check for errors
-    if (!file.good())
+/*! Appends the x, y, and z blocks of the frame coordinates to the write buffer.
+ */
+void DCDDumpWriter::write_frame_data()
+    {
+    unsigned int nparticles = m_group->getNumMembersGlobal();
+    unsigned int block_size = (unsigned int)(nparticles * sizeof(float));
+
+    for (unsigned int d = 0; d < 3; d++)
         {
-        throw runtime_error("DCD: I/O error while writing DCD frame header.");
+        detail::append_int(m_write_buffer, block_size);
+        detail::append_bytes(m_write_buffer, m_frame_pos.data() + d * nparticles, block_size);
+        detail::append_int(m_write_buffer, block_size);
         }
     }
 
-/*! \param file File to write to
-    \param snapshot Snapshot to write
-    Writes the actual particle positions for all particles at the current time step
+/*! Each rank unwraps the positions of its local group members and converts them to float. The
+    tags and coordinates are gathered to the root rank, which places them in group order in the x,
+    y, and z blocks of m_frame_pos.
+
+    \note This is a collective call.
+*/
+void DCDDumpWriter::gatherFramePositions()
+    {
+    const BoxDim& box = m_pdata->getGlobalBox();
+    const unsigned int n_local = m_group->getNumMembers();
+    m_local_tag.resize(n_local);
+    m_local_pos.resize(3 * n_local);
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+
+        for (unsigned int group_idx = 0; group_idx < n_local; group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
+            vec3<Scalar> pos(h_pos.data[j]);
+            if (m_unwrap_full)
+                pos = box.shift(pos, h_image.data[j]);
+
+            m_local_tag[group_idx] = h_tag.data[j];
+            m_local_pos[3 * group_idx] = float(pos.x);
+            m_local_pos[3 * group_idx + 1] = float(pos.y);
+            m_local_pos[3 * group_idx + 2] = float(pos.z);
+            }
+        }
+
+    // m_angle set to True turns on a hack where the particle orientation angle is written out to
+    // the z component this only works in 2D simulations, obviously
+    if (m_angle)
+        {
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::read);
+        for (unsigned int group_idx = 0; group_idx < n_local; group_idx++)
+            {
+            unsigned int j = m_group->getMemberIndex(group_idx);
+            quat<Scalar> q(h_orientation.data[j]);
+            m_local_pos[3 * group_idx + 2] = float(atan2(q.v.z, q.s) * 2);
+            }
+        }
+
+#ifdef ENABLE_MPI
+    std::vector<std::vector<unsigned int>> tag_proc;
+    std::vector<std::vector<float>> pos_proc;
+    if (m_sysdef->isDomainDecomposed())
+        {
+        gather_v(m_local_tag, tag_proc, 0, m_exec_conf->getMPICommunicator());
+        gather_v(m_local_pos, pos_proc, 0, m_exec_conf->getMPICommunicator());
+
+        if (!m_exec_conf->isRoot())
+            return;
+        }
+    else
+        {
+        tag_proc.push_back(m_local_tag);
+        pos_proc.push_back(m_local_pos);
+        }
+#endif
+
+    // map tags to their index in the group, which is in sorted tag order
+    unsigned int nparticles = m_group->getNumMembersGlobal();
+    m_frame_pos.resize(3 * nparticles);
+    if (nparticles == 0)
+        return;
+
+    m_group_idx.resize(m_group->getMemberTag(nparticles - 1) + 1);
+    for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
+        m_group_idx[m_group->getMemberTag(group_idx)] = group_idx;
+
+    auto place = [&](const std::vector<unsigned int>& tag, const std::vector<float>& pos)
+    {
+        for (unsigned int i = 0; i < tag.size(); i++)
+            {
+            unsigned int group_idx = m_group_idx[tag[i]];
+            m_frame_pos[group_idx] = pos[3 * i];
+            m_frame_pos[nparticles + group_idx] = pos[3 * i + 1];
+            m_frame_pos[2 * nparticles + group_idx] = pos[3 * i + 2];
+            }
+    };
+
+#ifdef ENABLE_MPI
+    for (unsigned int rank = 0; rank < tag_proc.size(); rank++)
+        place(tag_proc[rank], pos_proc[rank]);
+#else
+    place(m_local_tag, m_local_pos);
+#endif
+    }
+
+/*! Gathers only the positions, images, body ids, and (with m_angle) orientations instead of a
+    full snapshot.
 */
-void DCDDumpWriter::write_frame_data(std::fstream& file,
-                                     const SnapshotParticleData<Scalar>& snapshot)
+void DCDDumpWriter::gatherSnapshotPositions()
     {
-    // we need to unsort the positions and write in tag order
-    assert(m_staging_buffer);
+    bool root = true;
+#ifdef ENABLE_MPI
+    root = m_exec_conf->isRoot();
+#endif
+    const size_t N = root ? m_pdata->getNGlobal() : 0;
+    m_snap_pos.resize(N * 3);
+    m_snap_image.resize(N * 3);
+    m_snap_body.resize(N);
+    m_snap_orientation.resize(m_angle ? N * 4 : 0);
+
+    SnapshotFieldBuffers<Scalar> buffers;
+    buffers.pos = m_snap_pos.data();
+    buffers.image = m_snap_image.data();
+    buffers.body = m_snap_body.data();
+    if (m_angle)
+        buffers.orientation = m_snap_orientation.data();
+    m_pdata->gatherSnapshotFields(buffers);
+    }
 
+/*! Places the coordinates of the group members in group order in the x, y, and z blocks of
+    m_frame_pos, unwrapping rigid bodies so that they are continuous.
+*/
+void DCDDumpWriter::fillFramePositions()
+    {
     BoxDim box = m_pdata->getGlobalBox();
 
     unsigned int nparticles = m_group->getNumMembersGlobal();
+    m_frame_pos.resize(3 * nparticles);
 
-    // Create a tmp copy of the particle data and unwrap particles
-    std::vector<vec3<Scalar>> tmp_pos(snapshot.pos);
     for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
         {
         unsigned int i = m_group->getMemberTag(group_idx);
+        vec3<Scalar> pos(m_snap_pos[i * 3 + 0], m_snap_pos[i * 3 + 1], m_snap_pos[i * 3 + 2]);
+        int3 particle_img
+            = make_int3(m_snap_image[i * 3 + 0], m_snap_image[i * 3 + 1], m_snap_image[i * 3 + 2]);
 
         if (m_unwrap_full)
             {
-            tmp_pos[i] = box.shift(tmp_pos[i], snapshot.image[i]);
+            pos = box.shift(pos, particle_img);
             }
-        else if (m_unwrap_rigid && snapshot.body[i] < MIN_FLOPPY)
+        else if (m_unwrap_rigid && m_snap_body[i] < MIN_FLOPPY)
             {
-            unsigned int central_ptl_tag = snapshot.body[i];
-            int body_ix = snapshot.image[central_ptl_tag].x;
-            int body_iy = snapshot.image[central_ptl_tag].y;
-            int body_iz = snapshot.image[central_ptl_tag].z;
-            int3 particle_img = snapshot.image[i];
+            unsigned int central_ptl_tag = m_snap_body[i];
+            int body_ix = m_snap_image[central_ptl_tag * 3 + 0];
+            int body_iy = m_snap_image[central_ptl_tag * 3 + 1];
+            int body_iz = m_snap_image[central_ptl_tag * 3 + 2];
             int3 img_diff = make_int3(particle_img.x - body_ix,
                                       particle_img.y - body_iy,
                                       particle_img.z - body_iz);
 
-            tmp_pos[i] = box.shift(tmp_pos[i], img_diff);
+            pos = box.shift(pos, img_diff);
             }
-        }
-
-    // prepare x coords for writing, looping in tag order
-    for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
-        {
-        unsigned int i = m_group->getMemberTag(group_idx);
-        m_staging_buffer[group_idx] = float(tmp_pos[i].x);
-        }
-
-    // write x coords
-    detail::write_int(file, (unsigned int)(nparticles * sizeof(float)));
-    file.write((char*)m_staging_buffer, nparticles * sizeof(float));
-    detail::write_int(file, (unsigned int)(nparticles * sizeof(float)));
 
-    // prepare y coords for writing
-    for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
-        {
-        unsigned int i = m_group->getMemberTag(group_idx);
-        m_staging_buffer[group_idx] = float(tmp_pos[i].y);
-        }
-
-    // write y coords
-    detail::write_int(file, (unsigned int)(nparticles * sizeof(float)));
-    file.write((char*)m_staging_buffer, nparticles * sizeof(float));
-    detail::write_int(file, (unsigned int)(nparticles * sizeof(float)));
-
-    // prepare z coords for writing
-    for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
-        {
-        unsigned int i = m_group->getMemberTag(group_idx);
-        m_staging_buffer[group_idx] = float(tmp_pos[i].z);
+        m_frame_pos[group_idx] = float(pos.x);
+        m_frame_pos[nparticles + group_idx] = float(pos.y);
+        m_frame_pos[2 * nparticles + group_idx] = float(pos.z);
 
         // m_angle set to True turns on a hack where the particle orientation angle is written out
         // to the z component this only works in 2D simulations, obviously
         if (m_angle)
             {
-            m_staging_buffer[group_idx]
-                = float(atan2(snapshot.orientation[i].v.z, snapshot.orientation[i].s) * 2);
+            m_frame_pos[2 * nparticles + group_idx]
+                = float(atan2(m_snap_orientation[i * 4 + 3], m_snap_orientation[i * 4 + 0]) * 2);
             }
         }
-
-    // write z coords
-    detail::write_int(file, (unsigned int)(nparticles * sizeof(float)));
-    file.write((char*)m_staging_buffer, nparticles * sizeof(float));
-    detail::write_int(file, (unsigned int)(nparticles * sizeof(float)));
-
-    // check for errors
-    if (!file.good())
-        {
-        throw runtime_error("I/O error while writing DCD frame data.");
-        }
     }
 
 /*! \param file File to write to
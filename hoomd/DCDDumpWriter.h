@@ -12,6 +12,7 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <vector>
 
 /*! \file DCDDumpWriter.h
     \brief Declares the DCDDumpWriter class
@@ -44,6 +45,11 @@ namespace hoomd
     On the first call to analyze() \a fname is created with a dcd header. If the file already
    exists, it is overwritten.
 
+    Each rank unwraps the positions of its local group members and converts them to float, and only
+    the tags and float coordinates are gathered to the root rank. The root rank assembles the whole
+    frame in one buffer and writes it with a single call. A full snapshot is only taken when rigid
+    bodies are unwrapped, because the image of the central particle may be on another rank.
+
     Due to a limitation in the DCD format, the time step period between calls to
     analyze() \b must be specified up front. If analyze() detects that this period is
     not being maintained, it will print a warning but continue.
@@ -65,6 +71,9 @@ class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
     //! Write out the data for the current timestep
     void analyze(uint64_t timestep);
 
+    //! Start copying the particle fields written in the next frame to the host
+    virtual void prefetch(uint64_t timestep);
+
     //! Set whether coordinates should be written out wrapped or unwrapped.
     void setUnwrapFull(bool enable)
         {
@@ -119,17 +128,32 @@ class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
     bool m_is_initialized;  //!< True if file IO has been initialized
     unsigned int m_nglobal; //!< Initial number of particles
 
-    float* m_staging_buffer; //!< Buffer for staging particle positions in tag order
-    std::fstream m_file;     //!< The file object
+    std::vector<float> m_frame_pos;        //!< x, y, and z blocks of the frame in group order
+    std::vector<unsigned int> m_local_tag; //!< Tags of the local group members
+    std::vector<float> m_local_pos;        //!< Unwrapped coordinates of the local group members
+    std::vector<unsigned int> m_group_idx; //!< Maps tags to the index in the group (root only)
+    std::vector<char> m_write_buffer;      //!< Frame assembled for a single write
+
+    std::vector<Scalar> m_snap_pos;         //!< Gathered positions in tag order (root only)
+    std::vector<int> m_snap_image;          //!< Gathered images in tag order (root only)
+    std::vector<unsigned int> m_snap_body;  //!< Gathered body ids in tag order (root only)
+    std::vector<Scalar> m_snap_orientation; //!< Gathered orientations in tag order (root only)
+    std::fstream m_file;                   //!< The file object
 
     // helper functions
 
     //! Initializes the file header
     void write_file_header(std::fstream& file);
-    //! Writes the frame header
-    void write_frame_header(std::fstream& file);
-    //! Writes the particle positions for a frame
-    void write_frame_data(std::fstream& file, const SnapshotParticleData<Scalar>& snapshot);
+    //! Appends the frame header to the write buffer
+    void write_frame_header();
+    //! Appends the particle positions of the frame to the write buffer
+    void write_frame_data();
+    //! Unwraps the local group members and gathers their coordinates to the root rank
+    void gatherFramePositions();
+    //! Gathers the fields needed to unwrap rigid bodies in tag order on the root rank
+    void gatherSnapshotPositions();
+    //! Fills the frame coordinates from the gathered fields, unwrapping rigid bodies
+    void fillFramePositions();
     //! Updates the file header
     void write_updated_header(std::fstream& file, uint64_t timestep);
     //! Initializes the output file for writing
@@ -0,0 +1,55 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file DataDependencies.h
+    \brief Declares the data that operations read and write
+*/
+
+namespace hoomd
+    {
+//! Simulation data that operations read or write
+struct data_dependency
+    {
+    //! The enum
+    enum Enum : unsigned int
+        {
+        none = 0,
+        particles = 1 << 0,  //!< Particle data (positions, velocities, types, ...)
+        bonded = 1 << 1,     //!< Bonds, angles, dihedrals, impropers, constraints, and pairs
+        box = 1 << 2,        //!< The simulation box
+        forces = 1 << 3,     //!< Net forces, torques, and virials
+        parameters = 1 << 4, //!< Parameters of the integrator, forces, and other operations
+        all = 0xffffffff
+        };
+    };
+
+//! Data that an operation reads and writes when it executes
+/*! System::run executes the updaters and analyzers that depend on none of the data that the
+    integrator accesses on a worker thread, concurrently with the integrator step and with the
+    other analyzers. The default (all data) is conservative: operations only execute concurrently
+    when they declare their dependencies explicitly.
+*/
+struct DataDependencies
+    {
+    //! Depend on all data
+    DataDependencies() : read(data_dependency::all), write(data_dependency::all) { }
+
+    //! Depend on the given data
+    /*! \param _read Bitwise or of data_dependency values the operation reads
+        \param _write Bitwise or of data_dependency values the operation writes
+    */
+    DataDependencies(unsigned int _read, unsigned int _write) : read(_read), write(_write) { }
+
+    //! Test if one operation accesses data the other writes
+    bool conflictsWith(const DataDependencies& other) const
+        {
+        return (write & (other.read | other.write)) != 0 || (read & other.write) != 0;
+        }
+
+    unsigned int read;  //!< Data that the operation reads
+    unsigned int write; //!< Data that the operation writes
+    };
+
+    } // end namespace hoomd
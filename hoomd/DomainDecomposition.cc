@@ -18,7 +18,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <iomanip>
 #include <numeric>
+#include <sstream>
 
 using namespace std;
 
@@ -34,7 +36,7 @@ DomainDecomposition::DomainDecomposition(std::shared_ptr<ExecutionConfiguration>
                                          unsigned int ny,
                                          unsigned int nz,
                                          bool twolevel)
-    : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator())
+    : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator()), m_bisection(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing DomainDecomposition" << endl;
 
@@ -54,6 +56,7 @@ DomainDecomposition::DomainDecomposition(std::shared_ptr<ExecutionConfiguration>
  * \param fxs Array of fractions to decompose box in x for first nx-1 processors
  * \param fys Array of fractions to decompose box in y for first ny-1 processors
  * \param fzs Array of fractions to decompose box in z for first nz-1 processors
+ * \param twolevel If true, attempt two level decomposition (default == false)
  *
  * If a fraction is not specified, a default value is chosen with uniform spacing. Note that the
  * chosen value for the number of processors is not guaranteed to be optimal.
@@ -62,15 +65,16 @@ DomainDecomposition::DomainDecomposition(std::shared_ptr<ExecutionConfiguration>
                                          Scalar3 L,
                                          const std::vector<Scalar>& fxs,
                                          const std::vector<Scalar>& fys,
-                                         const std::vector<Scalar>& fzs)
-    : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator())
+                                         const std::vector<Scalar>& fzs,
+                                         bool twolevel)
+    : m_exec_conf(exec_conf), m_mpi_comm(m_exec_conf->getMPICommunicator()), m_bisection(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing DomainDecomposition" << endl;
 
     size_t nx = (fxs.size() > 0) ? (fxs.size() + 1) : 0;
     size_t ny = (fys.size() > 0) ? (fys.size() + 1) : 0;
     size_t nz = (fzs.size() > 0) ? (fzs.size() + 1) : 0;
-    initializeDomainGrid(L, (unsigned int)nx, (unsigned int)ny, (unsigned int)nz, false);
+    initializeDomainGrid(L, (unsigned int)nx, (unsigned int)ny, (unsigned int)nz, twolevel);
 
     std::vector<Scalar> try_fxs = fxs;
     std::vector<Scalar> try_fys = fys;
@@ -133,33 +137,28 @@ void DomainDecomposition::initializeDomainGrid(Scalar3 L,
     unsigned int nx_node = 0, ny_node = 0, nz_node = 0;
     unsigned int nx_intra = 0, ny_intra = 0, nz_intra = 0;
 
-    if (nx || ny || nz)
-        m_twolevel = false;
-
     if (rank == 0)
         {
+        bool found_decomposition = findDecomposition(nranks, L, nx, ny, nz);
+        if (!found_decomposition)
+            {
+            throw std::invalid_argument(
+                "Unable to find a decomposition with the requested dimensions.");
+            }
+
         if (m_twolevel)
             {
             // every node has the same number of ranks, so nranks == num_nodes * num_ranks_per_node
             unsigned int n_nodes = (unsigned int)(m_nodes.size());
 
-            // subdivide the global grid
-            findDecomposition(nranks, L, nx, ny, nz);
-
-            // subdivide the local grid
-            subdivide(nranks / n_nodes, L, nx, ny, nz, nx_intra, ny_intra, nz_intra);
-
-            nx_node = nx / nx_intra;
-            ny_node = ny / ny_intra;
-            nz_node = nz / nz_intra;
-            }
-        else
-            {
-            bool found_decomposition = findDecomposition(nranks, L, nx, ny, nz);
-            if (!found_decomposition)
+            // tile the global grid with one compact block of domains per node, fall back to the
+            // sequential placement if the node blocks do not tile the grid
+            m_twolevel = subdivide(nranks / n_nodes, L, nx, ny, nz, nx_intra, ny_intra, nz_intra);
+            if (m_twolevel)
                 {
-                throw std::invalid_argument(
-                    "Unable to find a decomposition with the requested dimensions.");
+                nx_node = nx / nx_intra;
+                ny_node = ny / ny_intra;
+                nz_node = nz / nz_intra;
                 }
             }
         m_nx = nx;
@@ -168,6 +167,7 @@ void DomainDecomposition::initializeDomainGrid(Scalar3 L,
         }
 
     // broadcast grid dimensions
+    bcast(m_twolevel, 0, m_mpi_comm);
     bcast(m_nx, 0, m_mpi_comm);
     bcast(m_ny, 0, m_mpi_comm);
     bcast(m_nz, 0, m_mpi_comm);
@@ -323,6 +323,137 @@ void DomainDecomposition::initializeCumulativeFractions(const std::vector<Scalar
     MPI_Bcast(&m_cumulative_frac_x[0], m_nx + 1, MPI_HOOMD_SCALAR, 0, m_mpi_comm);
     MPI_Bcast(&m_cumulative_frac_y[0], m_ny + 1, MPI_HOOMD_SCALAR, 0, m_mpi_comm);
     MPI_Bcast(&m_cumulative_frac_z[0], m_nz + 1, MPI_HOOMD_SCALAR, 0, m_mpi_comm);
+
+    updateDomainBounds();
+    }
+
+void DomainDecomposition::updateDomainBounds()
+    {
+    m_domain_lo.resize(m_index.getNumElements());
+    m_domain_hi.resize(m_index.getNumElements());
+    for (unsigned int k = 0; k < m_nz; ++k)
+        for (unsigned int j = 0; j < m_ny; ++j)
+            for (unsigned int i = 0; i < m_nx; ++i)
+                {
+                unsigned int idx = m_index(i, j, k);
+                m_domain_lo[idx] = make_scalar3(m_cumulative_frac_x[i],
+                                                m_cumulative_frac_y[j],
+                                                m_cumulative_frac_z[k]);
+                m_domain_hi[idx] = make_scalar3(m_cumulative_frac_x[i + 1],
+                                                m_cumulative_frac_y[j + 1],
+                                                m_cumulative_frac_z[k + 1]);
+                }
+    }
+
+namespace
+    {
+//! Place the cuts that split an interval into domains holding equal numbers of particles
+/*!
+ * \param vals Particle coordinates in the interval (will be sorted)
+ * \param n Number of domains
+ * \param lo Lower end of the interval
+ * \param hi Upper end of the interval
+ * \returns The n+1 cut positions, starting with \a lo and ending with \a hi
+ *
+ * Every domain is kept at least half as wide as in a uniform split, so that sparse regions do not
+ * collapse into domains narrower than the ghost layer.
+ */
+std::vector<Scalar> bisectInterval(std::vector<Scalar>& vals, unsigned int n, Scalar lo, Scalar hi)
+    {
+    std::sort(vals.begin(), vals.end());
+
+    std::vector<Scalar> cuts(n + 1);
+    cuts[0] = lo;
+    cuts[n] = hi;
+
+    const Scalar min_width = (hi - lo) / Scalar(2 * n);
+    const size_t N = vals.size();
+    for (unsigned int i = 1; i < n; ++i)
+        {
+        Scalar cut = lo + (hi - lo) * Scalar(i) / Scalar(n);
+        size_t k = N * i / n;
+        if (k > 0 && k < N)
+            cut = Scalar(0.5) * (vals[k - 1] + vals[k]);
+
+        cut = std::max(cut, cuts[i - 1] + min_width);
+        cut = std::min(cut, hi - Scalar(n - i) * min_width);
+        cuts[i] = cut;
+        }
+    return cuts;
+    }
+    } // end namespace
+
+/*!
+ * \param frac Fractional coordinates of all particles in the global box (only used on \a root)
+ * \param root Rank that places the cuts and broadcasts them
+ *
+ * The slabs along z are cut first, then the rows along y in every slab, and then the domains along
+ * x in every row. This is a collective call.
+ */
+void DomainDecomposition::computeBisection(const std::vector<Scalar3>& frac, unsigned int root)
+    {
+    if (m_exec_conf->getRank() == root)
+        {
+        std::vector<Scalar> z(frac.size());
+        for (size_t i = 0; i < frac.size(); ++i)
+            z[i] = frac[i].z;
+        m_cumulative_frac_z = bisectInterval(z, m_nz, Scalar(0.0), Scalar(1.0));
+
+        // sort the particles into slabs
+        std::vector<std::vector<Scalar3>> slabs(m_nz);
+        for (const Scalar3& f : frac)
+            {
+            unsigned int k = (unsigned int)(std::upper_bound(m_cumulative_frac_z.begin() + 1,
+                                                             m_cumulative_frac_z.end() - 1,
+                                                             f.z)
+                                            - (m_cumulative_frac_z.begin() + 1));
+            slabs[k].push_back(f);
+            }
+
+        for (unsigned int k = 0; k < m_nz; ++k)
+            {
+            std::vector<Scalar> y(slabs[k].size());
+            for (size_t i = 0; i < slabs[k].size(); ++i)
+                y[i] = slabs[k][i].y;
+            std::vector<Scalar> y_cuts = bisectInterval(y, m_ny, Scalar(0.0), Scalar(1.0));
+
+            // sort the particles of the slab into rows
+            std::vector<std::vector<Scalar>> rows(m_ny);
+            for (const Scalar3& f : slabs[k])
+                {
+                unsigned int j = (unsigned int)(std::upper_bound(y_cuts.begin() + 1,
+                                                                 y_cuts.end() - 1,
+                                                                 f.y)
+                                                - (y_cuts.begin() + 1));
+                rows[j].push_back(f.x);
+                }
+
+            for (unsigned int j = 0; j < m_ny; ++j)
+                {
+                std::vector<Scalar> x_cuts
+                    = bisectInterval(rows[j], m_nx, Scalar(0.0), Scalar(1.0));
+                for (unsigned int i = 0; i < m_nx; ++i)
+                    {
+                    unsigned int idx = m_index(i, j, k);
+                    m_domain_lo[idx] = make_scalar3(x_cuts[i], y_cuts[j], m_cumulative_frac_z[k]);
+                    m_domain_hi[idx]
+                        = make_scalar3(x_cuts[i + 1], y_cuts[j + 1], m_cumulative_frac_z[k + 1]);
+                    }
+                }
+            }
+        }
+
+    MPI_Bcast(&m_cumulative_frac_z[0], m_nz + 1, MPI_HOOMD_SCALAR, root, m_mpi_comm);
+    MPI_Bcast(&m_domain_lo[0],
+              (int)(m_domain_lo.size() * sizeof(Scalar3)),
+              MPI_BYTE,
+              root,
+              m_mpi_comm);
+    MPI_Bcast(&m_domain_hi[0],
+              (int)(m_domain_hi.size() * sizeof(Scalar3)),
+              MPI_BYTE,
+              root,
+              m_mpi_comm);
     }
 
 //! Find a domain decomposition with given parameters
@@ -410,7 +541,12 @@ bool DomainDecomposition::findDecomposition(unsigned int nranks,
     }
 
 //! Find a two-level decomposition of the global grid
-void DomainDecomposition::subdivide(unsigned int n_node_ranks,
+/*! The block of domains on every node is chosen to minimize its surface area, which is the area
+    across which ghosts are exchanged with other nodes.
+
+    \returns true if a block of \a n_node_ranks domains tiles the global grid
+ */
+bool DomainDecomposition::subdivide(unsigned int n_node_ranks,
                                     Scalar3 L,
                                     unsigned int nx,
                                     unsigned int ny,
@@ -421,12 +557,10 @@ void DomainDecomposition::subdivide(unsigned int n_node_ranks,
     {
     assert(L.x > 0);
     assert(L.y > 0);
-    assert(L.z > 0);
 
-    // initial guess
-    nx_intra = 1;
-    ny_intra = 1;
-    nz_intra = n_node_ranks;
+    bool is2D = L.z == 0.0;
+    bool found = false;
+    double min_surface_area = 0.0;
 
     for (unsigned int nx_intra_try = 1; nx_intra_try <= n_node_ranks; nx_intra_try++)
         for (unsigned int ny_intra_try = 1; nx_intra_try * ny_intra_try <= n_node_ranks;
@@ -440,10 +574,23 @@ void DomainDecomposition::subdivide(unsigned int n_node_ranks,
                 if (nx % nx_intra_try || ny % ny_intra_try || nz % nz_intra_try)
                     continue;
 
-                nx_intra = nx_intra_try;
-                ny_intra = ny_intra_try;
-                nz_intra = nz_intra_try;
+                // dimensions of the block of domains
+                double bx = L.x * nx_intra_try / nx;
+                double by = L.y * ny_intra_try / ny;
+                double bz = L.z * nz_intra_try / nz;
+                double surface_area = is2D ? bx + by : bx * by + by * bz + bx * bz;
+
+                if (!found || surface_area < min_surface_area)
+                    {
+                    nx_intra = nx_intra_try;
+                    ny_intra = ny_intra_try;
+                    nz_intra = nz_intra_try;
+                    min_surface_area = surface_area;
+                    found = true;
+                    }
                 }
+
+    return found;
     }
 
 /*! \param dir Spatial direction to find neighbor in
@@ -506,6 +653,12 @@ void DomainDecomposition::setCumulativeFractions(unsigned int dir,
         throw std::invalid_argument("Requested direction does not exist.");
         }
 
+    if (m_bisection)
+        {
+        throw std::runtime_error(
+            "Cumulative fractions cannot be set for a bisection domain decomposition.");
+        }
+
     bool changed = false;
     if (m_exec_conf->getRank() == root)
         {
@@ -560,6 +713,8 @@ void DomainDecomposition::setCumulativeFractions(unsigned int dir,
                 throw std::invalid_argument("Specified fractions are invalid.");
                 }
             }
+
+        updateDomainBounds();
         }
     else // if no change, it's because things don't match up
         {
@@ -578,16 +733,11 @@ const BoxDim DomainDecomposition::calculateLocalBox(const BoxDim& global_box)
     BoxDim box = global_box;
     Scalar3 L = global_box.getL();
 
-    // position of this domain in the grid
-    Scalar3 lo_cumulative_frac = make_scalar3(m_cumulative_frac_x[m_grid_pos.x],
-                                              m_cumulative_frac_y[m_grid_pos.y],
-                                              m_cumulative_frac_z[m_grid_pos.z]);
-    Scalar3 lo = global_box.getLo() + lo_cumulative_frac * L;
-
-    Scalar3 hi_cumulative_frac = make_scalar3(m_cumulative_frac_x[m_grid_pos.x + 1],
-                                              m_cumulative_frac_y[m_grid_pos.y + 1],
-                                              m_cumulative_frac_z[m_grid_pos.z + 1]);
-    Scalar3 hi = global_box.getLo() + hi_cumulative_frac * L;
+    // bounds of this domain
+    Scalar3 lo_frac, hi_frac;
+    getDomainBounds(m_index(m_grid_pos.x, m_grid_pos.y, m_grid_pos.z), lo_frac, hi_frac);
+    Scalar3 lo = global_box.getLo() + lo_frac * L;
+    Scalar3 hi = global_box.getLo() + hi_frac * L;
 
     // set periodic flags
     // we are periodic in a direction along which there is only one box
@@ -638,20 +788,6 @@ unsigned int DomainDecomposition::placeParticle(const BoxDim& global_box,
     // correct boxes, as long as we don't wrap them around. Therefore, shift back into nearest box
     // if that is the case
     std::vector<Scalar>::iterator it;
-    it = std::lower_bound(m_cumulative_frac_x.begin(), m_cumulative_frac_x.end(), f.x);
-    int ix = int(it - 1 - m_cumulative_frac_x.begin());
-    if (ix < 0)
-        ix++;
-    else if (ix >= (int)m_nx)
-        ix--;
-
-    it = std::lower_bound(m_cumulative_frac_y.begin(), m_cumulative_frac_y.end(), f.y);
-    int iy = int(it - 1 - m_cumulative_frac_y.begin());
-    if (iy < 0)
-        iy++;
-    else if (iy >= (int)m_ny)
-        iy--;
-
     it = std::lower_bound(m_cumulative_frac_z.begin(), m_cumulative_frac_z.end(), f.z);
     int iz = int(it - 1 - m_cumulative_frac_z.begin());
     if (iz < 0)
@@ -659,18 +795,65 @@ unsigned int DomainDecomposition::placeParticle(const BoxDim& global_box,
     else if (iz >= (int)m_nz)
         iz--;
 
+    // the rows and columns are cut independently in every slab and row with bisection
+    int iy = 0;
+    if (m_bisection)
+        {
+        while (iy + 1 < (int)m_ny && m_domain_lo[m_index(0, iy + 1, iz)].y < f.y)
+            iy++;
+        }
+    else
+        {
+        it = std::lower_bound(m_cumulative_frac_y.begin(), m_cumulative_frac_y.end(), f.y);
+        iy = int(it - 1 - m_cumulative_frac_y.begin());
+        if (iy < 0)
+            iy++;
+        else if (iy >= (int)m_ny)
+            iy--;
+        }
+
+    int ix = 0;
+    if (m_bisection)
+        {
+        while (ix + 1 < (int)m_nx && m_domain_lo[m_index(ix + 1, iy, iz)].x < f.x)
+            ix++;
+        }
+    else
+        {
+        it = std::lower_bound(m_cumulative_frac_x.begin(), m_cumulative_frac_x.end(), f.x);
+        ix = int(it - 1 - m_cumulative_frac_x.begin());
+        if (ix < 0)
+            ix++;
+        else if (ix >= (int)m_nx)
+            ix--;
+        }
+
     unsigned int rank = cart_ranks[m_index(ix, iy, iz)];
 
     return rank;
     }
 
+/*! Ranks that share memory are grouped into a node. Every node is identified by the lowest rank
+    on it.
+ */
 void DomainDecomposition::findCommonNodes()
     {
-    // get MPI node name
-    char procname[MPI_MAX_PROCESSOR_NAME];
-    int len;
-    MPI_Get_processor_name(procname, &len);
-    std::string s(procname, len);
+    // split the communicator into groups of ranks that can share memory
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(m_mpi_comm,
+                        MPI_COMM_TYPE_SHARED,
+                        m_exec_conf->getRank(),
+                        MPI_INFO_NULL,
+                        &node_comm);
+
+    unsigned int node_leader = m_exec_conf->getRank();
+    MPI_Bcast(&node_leader, 1, MPI_UNSIGNED, 0, node_comm);
+    MPI_Comm_free(&node_comm);
+
+    // zero-pad the name so that the nodes are ordered by their lowest rank
+    std::ostringstream oss;
+    oss << std::setw(10) << std::setfill('0') << node_leader;
+    std::string s = oss.str();
 
     // collect node names from all ranks on rank zero
     std::vector<std::string> nodes;
@@ -732,8 +915,11 @@ void export_DomainDecomposition(pybind11::module& m)
                             Scalar3,
                             const std::vector<Scalar>&,
                             const std::vector<Scalar>&,
-                            const std::vector<Scalar>&>())
-        .def("getCumulativeFractions", &DomainDecomposition::getCumulativeFractions);
+                            const std::vector<Scalar>&,
+                            bool>())
+        .def("getCumulativeFractions", &DomainDecomposition::getCumulativeFractions)
+        .def("setBisection", &DomainDecomposition::setBisection)
+        .def("isBisection", &DomainDecomposition::isBisection);
     }
     } // end namespace detail
 
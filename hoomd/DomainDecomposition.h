@@ -46,6 +46,13 @@ namespace hoomd
  * box is covered. If the specified number of ranks does not match the number that is available,
  * behavior is reverted to the normal default with uniform cuts along each dimension.
  *
+ *  A recursive coordinate bisection can be requested with setBisection(). The grid of ranks is
+ * kept, but the cuts are staggered: the box is first cut into slabs along z, every slab is cut into
+ * rows along y independently, and every row is cut along x independently. The cuts are placed so
+ * that every domain holds the same number of particles when the particles are distributed. Every
+ * domain then has its own bounds (see getDomainBounds()), and the neighbors of a domain across a y
+ * or z face are no longer unique.
+ *
  *  The initialization of the domain decomposition scheme is performed in the constructor.
  */
 class PYBIND11_EXPORT DomainDecomposition
@@ -59,6 +66,11 @@ class PYBIND11_EXPORT DomainDecomposition
      * \param ny Requested number of domains along the y direction (0 == choose default)
      * \param nz Requested number of domains along the z direction (0 == choose default)
      * \param twolevel If true, attempt two level decomposition (default == false)
+     *
+     * The two level decomposition assigns every node (group of ranks that share memory) a compact
+     * block of domains, so that most ghost particles are exchanged within a node. It falls back to
+     * the one level decomposition when the nodes have different numbers of ranks or when no block
+     * of domains tiles the grid.
      */
     DomainDecomposition(std::shared_ptr<ExecutionConfiguration> exec_conf,
                         Scalar3 L,
@@ -72,7 +84,8 @@ class PYBIND11_EXPORT DomainDecomposition
                         Scalar3 L,
                         const std::vector<Scalar>& fxs,
                         const std::vector<Scalar>& fys,
-                        const std::vector<Scalar>& fzs);
+                        const std::vector<Scalar>& fzs,
+                        bool twolevel = false);
 
     //! Calculate MPI ranks of neighboring domain.
     unsigned int getNeighborRank(unsigned int dir) const;
@@ -170,6 +183,34 @@ class PYBIND11_EXPORT DomainDecomposition
         return make_uint3(m_nx, m_ny, m_nz);
         }
 
+    //! Request a recursive coordinate bisection when the particles are distributed
+    void setBisection(bool bisection)
+        {
+        m_bisection = bisection;
+        }
+
+    //! Get whether the domains are placed by recursive coordinate bisection
+    bool isBisection() const
+        {
+        return m_bisection;
+        }
+
+    //! Collectively place the bisection cuts so that the domains hold equal numbers of particles
+    void computeBisection(const std::vector<Scalar3>& frac, unsigned int root);
+
+    //! Get the fractional bounds of a domain in the global box
+    /*!
+     * \param cart_idx Linear cartesian index of the domain
+     * \param lo Lower bound (output)
+     * \param hi Upper bound (output)
+     */
+    void getDomainBounds(unsigned int cart_idx, Scalar3& lo, Scalar3& hi) const
+        {
+        assert(cart_idx < m_domain_lo.size());
+        lo = m_domain_lo[cart_idx];
+        hi = m_domain_hi[cart_idx];
+        }
+
     private:
     unsigned int m_nx; //!< Number of processors along the x-axis
     unsigned int m_ny; //!< Number of processors along the y-axis
@@ -197,7 +238,7 @@ class PYBIND11_EXPORT DomainDecomposition
                            unsigned int& nz);
 
     //! Find a two-level decomposition of the global grid
-    void subdivide(unsigned int n_node_ranks,
+    bool subdivide(unsigned int n_node_ranks,
                    Scalar3 L,
                    unsigned int nx,
                    unsigned int ny,
@@ -224,12 +265,19 @@ class PYBIND11_EXPORT DomainDecomposition
                                        const std::vector<Scalar>& fys,
                                        const std::vector<Scalar>& fzs);
 
+    //! Helper function to set the domain bounds from the cumulative fractions
+    void updateDomainBounds();
+
     std::shared_ptr<ExecutionConfiguration> m_exec_conf; //!< The execution configuration
     const MPI_Comm m_mpi_comm;                           //!< MPI communicator
 
     std::vector<Scalar> m_cumulative_frac_x; //!< Cumulative fractions in x below cut plane index
     std::vector<Scalar> m_cumulative_frac_y; //!< Cumulative fractions in y below cut plane index
     std::vector<Scalar> m_cumulative_frac_z; //!< Cumulative fractions in z below cut plane index
+
+    bool m_bisection;                 //!< True if the domains are placed by bisection
+    std::vector<Scalar3> m_domain_lo; //!< Lower fractional bound of every domain (cartesian index)
+    std::vector<Scalar3> m_domain_hi; //!< Upper fractional bound of every domain (cartesian index)
 #endif                                       // ENABLE_MPI
     };
 
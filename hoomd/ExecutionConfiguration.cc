@@ -4,7 +4,9 @@
 // Maintainer: joaander
 
 #include "ExecutionConfiguration.h"
+#include "AutotunerCache.h"
 #include "HOOMDVersion.h"
+#include "ManagedMemoryCounters.h"
 
 #ifdef ENABLE_HIP
 #include <hip/hip_runtime.h>
@@ -182,14 +184,25 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
         hipError_t err_sync = hipGetLastError();
         handleHIPError(err_sync, __FILE__, __LINE__);
 
-        // initialize cached allocator, max allocation 0.5*global mem
-        m_cached_alloc.reset(
-            new CachedAllocator(false, (unsigned int)(0.5f * (float)dev_prop.totalGlobalMem)));
-        m_cached_alloc_managed.reset(
-            new CachedAllocator(true, (unsigned int)(0.5f * (float)dev_prop.totalGlobalMem)));
+        // initialize cached allocators, max cache size 0.5*global mem
+        // the managed allocator also backs the persistent GlobalArray allocations
+        m_cached_alloc.reset(new CachedAllocator(false, dev_prop.totalGlobalMem / 2));
+        m_cached_alloc_managed.reset(new CachedAllocator(true, dev_prop.totalGlobalMem / 2));
         }
 #endif
 
+    // optimal autotuner parameters are specific to the GPU model
+    std::string device_model = "cpu";
+#if defined(ENABLE_HIP)
+    if (exec_mode == GPU)
+        {
+        device_model = std::string(dev_prop.name);
+        if (m_gpu_id.size() > 1)
+            device_model += "x" + std::to_string(m_gpu_id.size());
+        }
+#endif
+    m_autotuner_cache.reset(new AutotunerCache(device_model));
+
 #ifdef ENABLE_MPI
     // ensure that all ranks are on the same execution configuration
     if (getNRanks() > 1)
@@ -251,11 +264,62 @@ ExecutionConfiguration::~ExecutionConfiguration()
     // the destructors of these objects can issue hip calls, so free them before the device reset
     m_cached_alloc.reset();
     m_cached_alloc_managed.reset();
+    m_managed_memory_counters.reset();
 #endif
     }
 
 #if defined(ENABLE_HIP)
 
+std::map<std::string, size_t> ExecutionConfiguration::getMemoryPoolStatistics() const
+    {
+    std::map<std::string, size_t> stats;
+    stats["bytes_reserved"] = 0;
+    stats["bytes_in_use"] = 0;
+    stats["peak_bytes_reserved"] = 0;
+    stats["peak_bytes_in_use"] = 0;
+    stats["num_allocations"] = 0;
+    stats["num_cache_hits"] = 0;
+
+    for (const CachedAllocator* alloc : {m_cached_alloc.get(), m_cached_alloc_managed.get()})
+        {
+        if (!alloc)
+            continue;
+
+        stats["bytes_reserved"] += alloc->getNumBytesReserved();
+        stats["bytes_in_use"] += alloc->getNumBytesInUse();
+        stats["peak_bytes_reserved"] += alloc->getPeakBytesReserved();
+        stats["peak_bytes_in_use"] += alloc->getPeakBytesInUse();
+        stats["num_allocations"] += alloc->getNumAllocations();
+        stats["num_cache_hits"] += alloc->getNumCacheHits();
+        }
+
+    return stats;
+    }
+
+void ExecutionConfiguration::releaseMemoryPool() const
+    {
+    if (m_cached_alloc)
+        m_cached_alloc->releaseCache();
+    if (m_cached_alloc_managed)
+        m_cached_alloc_managed->releaseCache();
+    }
+
+void ExecutionConfiguration::setManagedMemoryCounting(bool enable)
+    {
+    if (enable && !m_managed_memory_counters)
+        m_managed_memory_counters.reset(new detail::ManagedMemoryCounters());
+    else if (!enable)
+        m_managed_memory_counters.reset();
+    }
+
+std::map<std::string, uint64_t> ExecutionConfiguration::getManagedMemoryCounts() const
+    {
+    if (!m_managed_memory_counters)
+        throw runtime_error("Managed memory page faults are not being counted.");
+
+    return m_managed_memory_counters->getCounts();
+    }
+
 std::pair<unsigned int, unsigned int>
 ExecutionConfiguration::getComputeCapability(unsigned int idev) const
     {
@@ -677,6 +741,12 @@ void export_ExecutionConfiguration(pybind11::module& m)
         .def("getComputeCapability", &ExecutionConfiguration::getComputeCapability)
         .def("hipProfileStart", &ExecutionConfiguration::hipProfileStart)
         .def("hipProfileStop", &ExecutionConfiguration::hipProfileStop)
+        .def("getMemoryPoolStatistics", &ExecutionConfiguration::getMemoryPoolStatistics)
+        .def("releaseMemoryPool", &ExecutionConfiguration::releaseMemoryPool)
+        .def("setManagedMemoryCounting", &ExecutionConfiguration::setManagedMemoryCounting)
+        .def("isManagedMemoryCountingEnabled",
+             &ExecutionConfiguration::isManagedMemoryCountingEnabled)
+        .def("getManagedMemoryCounts", &ExecutionConfiguration::getManagedMemoryCounts)
 #endif
         .def("getPartition", &ExecutionConfiguration::getPartition)
         .def("getNRanks", &ExecutionConfiguration::getNRanks)
@@ -688,6 +758,14 @@ void export_ExecutionConfiguration(pybind11::module& m)
         .def("setMemoryTracing", &ExecutionConfiguration::setMemoryTracing)
         .def("getMemoryTracer", &ExecutionConfiguration::getMemoryTracer)
         .def("memoryTracingEnabled", &ExecutionConfiguration::memoryTracingEnabled)
+        .def("getMemoryUsage", &ExecutionConfiguration::getMemoryUsage)
+        .def("getAutotunerCache",
+             &ExecutionConfiguration::getAutotunerCache,
+             pybind11::return_value_policy::reference_internal)
+        .def("setJITCacheDir", &ExecutionConfiguration::setJITCacheDir)
+        .def("getJITCacheDir", &ExecutionConfiguration::getJITCacheDir)
+        .def("setMemoryPlacement", &ExecutionConfiguration::setMemoryPlacement)
+        .def("getMemoryPlacement", &ExecutionConfiguration::getMemoryPlacement)
         .def_static("getCapableDevices", &ExecutionConfiguration::getCapableDevices)
         .def_static("getScanMessages", &ExecutionConfiguration::getScanMessages)
         .def("getActiveDevices", &ExecutionConfiguration::getActiveDevices);
@@ -697,6 +775,11 @@ void export_ExecutionConfiguration(pybind11::module& m)
         .value("CPU", ExecutionConfiguration::executionMode::CPU)
         .value("AUTO", ExecutionConfiguration::executionMode::AUTO)
         .export_values();
+
+    pybind11::enum_<ExecutionConfiguration::MemoryPlacement>(executionconfiguration,
+                                                             "MemoryPlacement")
+        .value("interleave", ExecutionConfiguration::MemoryPlacement::interleave)
+        .value("partition", ExecutionConfiguration::MemoryPlacement::partition);
     }
     } // end namespace detail
 
@@ -15,6 +15,7 @@
 
 #include "MPIConfiguration.h"
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -29,9 +30,13 @@
 #endif
 
 #ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
 #include <tbb/task_arena.h>
 #endif
 
+#include "MemoryAccounting.h"
 #include "MemoryTraceback.h"
 #include "Messenger.h"
 
@@ -51,8 +56,15 @@ namespace hoomd
 #if defined(ENABLE_HIP)
 //! Forward declaration
 class CachedAllocator;
+
+namespace detail
+    {
+class ManagedMemoryCounters;
+    } // end namespace detail
 #endif
 
+class AutotunerCache;
+
 //! Defines the execution configuration for the simulation
 /*! \ingroup data_structs
     ExecutionConfiguration is a data structure needed to support the hybrid CPU/GPU code. It
@@ -297,6 +309,79 @@ class PYBIND11_EXPORT ExecutionConfiguration
         {
         return *m_cached_alloc_managed;
         }
+
+    /// Get the high-water statistics of the cached allocators, summed over both
+    std::map<std::string, size_t> getMemoryPoolStatistics() const;
+
+    /// Return the cached blocks that are not in use to the device
+    void releaseMemoryPool() const;
+
+    /// Start or stop counting managed memory page faults (requires ENABLE_CUPTI)
+    void setManagedMemoryCounting(bool enable);
+
+    /// Test if managed memory page faults are counted
+    bool isManagedMemoryCountingEnabled() const
+        {
+        return bool(m_managed_memory_counters);
+        }
+
+    /// Get the managed memory page faults and migrated bytes since counting started
+    std::map<std::string, uint64_t> getManagedMemoryCounts() const;
+#endif
+
+    /// Returns the persistent store of optimal autotuner parameters
+    AutotunerCache& getAutotunerCache() const
+        {
+        return *m_autotuner_cache;
+        }
+
+    /// Set the directory that caches compiled JIT code, an empty string disables the cache
+    void setJITCacheDir(const std::string& jit_cache_dir)
+        {
+        m_jit_cache_dir = jit_cache_dir;
+        }
+
+    /// Get the directory that caches compiled JIT code
+    const std::string& getJITCacheDir() const
+        {
+        return m_jit_cache_dir;
+        }
+
+    /// Placement of the pages of new host arrays over the NUMA nodes of the TBB threads
+    enum class MemoryPlacement
+        {
+        interleave, //!< Spread the pages round robin over the threads
+        partition   //!< Each thread first touches the block of the particle loops it processes
+        };
+
+    /// Set the placement of new host arrays
+    void setMemoryPlacement(MemoryPlacement memory_placement)
+        {
+        m_memory_placement = memory_placement;
+        }
+
+    /// Get the placement of new host arrays
+    MemoryPlacement getMemoryPlacement() const
+        {
+        return m_memory_placement;
+        }
+
+#ifdef ENABLE_TBB
+    /// Loop over the indices [begin, end) in parallel, call inside the task arena
+    /*! With MemoryPlacement::partition, the range is split statically into one contiguous block
+        per thread, the same split that host_memclear() uses to first touch new host arrays. Each
+        thread then processes the elements on its own NUMA node. Otherwise TBB balances the load
+        dynamically.
+    */
+    template<class Body> void parallelFor(unsigned int begin, unsigned int end, const Body& body)
+        const
+        {
+        tbb::blocked_range<unsigned int> range(begin, end);
+        if (m_memory_placement == MemoryPlacement::partition)
+            tbb::parallel_for(range, body, tbb::static_partitioner());
+        else
+            tbb::parallel_for(range, body);
+        }
 #endif
 
     //! Set up memory tracing
@@ -319,6 +404,18 @@ class PYBIND11_EXPORT ExecutionConfiguration
         return m_memory_traceback.get() != nullptr;
         }
 
+    //! Returns the counters of the bytes allocated per array tag
+    const MemoryAccounting& getMemoryAccounting() const
+        {
+        return m_memory_accounting;
+        }
+
+    //! Get the number of bytes allocated per array tag on this rank
+    std::map<std::string, size_t> getMemoryUsage() const
+        {
+        return m_memory_accounting.getBytes();
+        }
+
     //! Returns true if we are in a multi-GPU block
     bool inMultiGPUBlock() const
         {
@@ -414,8 +511,20 @@ class PYBIND11_EXPORT ExecutionConfiguration
     std::unique_ptr<CachedAllocator> m_cached_alloc; //!< Cached allocator for temporary allocations
     std::unique_ptr<CachedAllocator>
         m_cached_alloc_managed; //!< Cached allocator for temporary allocations in managed memory
+
+    /// Managed memory page fault counters, null when not counting
+    std::unique_ptr<detail::ManagedMemoryCounters> m_managed_memory_counters;
 #endif
 
+    /// Persistent store of optimal autotuner parameters
+    std::unique_ptr<AutotunerCache> m_autotuner_cache;
+
+    /// Directory that caches compiled JIT code
+    std::string m_jit_cache_dir;
+
+    /// Placement of the pages of new host arrays
+    MemoryPlacement m_memory_placement = MemoryPlacement::interleave;
+
 #ifdef ENABLE_TBB
     std::shared_ptr<tbb::task_arena> m_task_arena; //!< The TBB task arena
     unsigned int m_num_threads;                    //!<  The number of TBB threads used
@@ -425,6 +534,7 @@ class PYBIND11_EXPORT ExecutionConfiguration
     void setupStats();
 
     std::unique_ptr<MemoryTraceback> m_memory_traceback; //!< Keeps track of allocations
+    MemoryAccounting m_memory_accounting;                //!< Bytes allocated per array tag
     };
 
 #if defined(ENABLE_HIP)
@@ -135,42 +135,9 @@ void ForceCompute::updateGPUAdvice()
 
         // split preferred location of particle data across GPUs
         const GPUPartition& gpu_partition = m_pdata->getGPUPartition();
-
-        for (unsigned int idev = 0; idev < m_exec_conf->getNumActiveGPUs(); ++idev)
-            {
-            // set preferred location
-            auto range = gpu_partition.getRange(idev);
-            unsigned int nelem = range.second - range.first;
-
-            if (!nelem)
-                continue;
-
-            cudaMemAdvise(m_force.get() + range.first,
-                          sizeof(Scalar4) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            for (unsigned int i = 0; i < 6; ++i)
-                cudaMemAdvise(m_virial.get() + i * m_virial.getPitch() + range.first,
-                              sizeof(Scalar) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-            cudaMemAdvise(m_torque.get() + range.first,
-                          sizeof(Scalar4) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-
-            cudaMemPrefetchAsync(m_force.get() + range.first,
-                                 sizeof(Scalar4) * nelem,
-                                 gpu_map[idev]);
-            for (unsigned int i = 0; i < 6; ++i)
-                cudaMemPrefetchAsync(m_virial.get() + i * m_virial.getPitch() + range.first,
-                                     sizeof(Scalar) * nelem,
-                                     gpu_map[idev]);
-            cudaMemPrefetchAsync(m_torque.get() + range.first,
-                                 sizeof(Scalar4) * nelem,
-                                 gpu_map[idev]);
-            }
-        CHECK_CUDA_ERROR();
+        m_force.prefetchPartition(gpu_partition, true);
+        m_virial.prefetchPartition(gpu_partition, true);
+        m_torque.prefetchPartition(gpu_partition, true);
 
         // set up GPU memory mappings
         for (unsigned int idev = 0; idev < m_exec_conf->getNumActiveGPUs(); ++idev)
@@ -201,7 +168,29 @@ ForceCompute::~ForceCompute()
         this);
     m_pdata->getMaxParticleNumberChangeSignal().disconnect<ForceCompute, &ForceCompute::reallocate>(
         this);
+
+#ifdef ENABLE_HIP
+    if (m_stream_event)
+        hipEventDestroy(m_stream_event);
+#endif
+    }
+
+#ifdef ENABLE_HIP
+/*! Kernels on m_stream read the data that the default stream prepares (e.g. the neighbor list and
+    the particle data copied to the device), so they must not start before it is complete.
+*/
+void ForceCompute::waitDefaultStream()
+    {
+    if (!m_stream)
+        return;
+
+    if (!m_stream_event)
+        hipEventCreateWithFlags(&m_stream_event, hipEventDisableTiming);
+
+    hipEventRecord(m_stream_event, 0);
+    hipStreamWaitEvent(m_stream, m_stream_event, 0);
     }
+#endif
 
 /*! Sums the total potential energy calculated by the last call to compute() and returns it.
  */
@@ -517,13 +506,32 @@ void ForceCompute::compute(uint64_t timestep)
     // flags do not match
     if (m_particles_sorted || shouldCompute(timestep) || m_pdata->getFlags() != m_computed_flags)
         {
+        int64_t start_time = m_execution_clock.getTime();
         computeForces(timestep);
+        m_execution_time += m_execution_clock.getTime() - start_time;
         }
 
     m_particles_sorted = false;
     m_computed_flags = m_pdata->getFlags();
     }
 
+/*! \param timestep Current Timestep
+
+    Sets pdata_flag::potential_energy before calling compute(), so that the energies are valid even
+    when no part of the simulation requested them for this step. System::run() sets the flags again
+    on the next step.
+*/
+void ForceCompute::computeEnergies(uint64_t timestep)
+    {
+    PDataFlags flags = m_pdata->getFlags();
+    if (!flags[pdata_flag::potential_energy])
+        {
+        flags[pdata_flag::potential_energy] = 1;
+        m_pdata->setFlags(flags);
+        }
+    compute(timestep);
+    }
+
 /*! \param num_iters Number of iterations to average for the benchmark
     \returns Milliseconds of execution time per calculation
 
@@ -672,11 +680,15 @@ void export_ForceCompute(pybind11::module& m)
         .def("getEnergy", &ForceCompute::getEnergy)
         .def("getExternalEnergy", &ForceCompute::getExternalEnergy)
         .def("getExternalVirial", &ForceCompute::getExternalVirial)
+        .def("computeEnergies", &ForceCompute::computeEnergies)
         .def("calcEnergySum", &ForceCompute::calcEnergySum)
         .def("getEnergies", &ForceCompute::getEnergiesPython)
         .def("getForces", &ForceCompute::getForcesPython)
         .def("getTorques", &ForceCompute::getTorquesPython)
-        .def("getVirials", &ForceCompute::getVirialsPython);
+        .def("getVirials", &ForceCompute::getVirialsPython)
+        .def_property("respa_interval",
+                      &ForceCompute::getRespaInterval,
+                      &ForceCompute::setRespaInterval);
     }
     } // end namespace detail
 
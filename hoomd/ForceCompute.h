@@ -4,10 +4,12 @@
 // Maintainer: joaander
 
 #include "Compute.h"
+#include "DataDependencies.h"
 #include "Index1D.h"
 #include "ParticleGroup.h"
 
 #include "GlobalArray.h"
+#include "PythonLocalDataAccess.h"
 
 #ifdef ENABLE_HIP
 #include "ParticleData.cuh"
@@ -19,6 +21,7 @@
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
+#include <stdexcept>
 
 /*! \file ForceCompute.h
     \brief Declares the ForceCompute class
@@ -77,6 +80,9 @@ class PYBIND11_EXPORT ForceCompute : public Compute
     //! Computes the forces
     virtual void compute(uint64_t timestep);
 
+    //! Computes the forces and energies
+    void computeEnergies(uint64_t timestep);
+
     //! Benchmark the force compute
     virtual double benchmark(unsigned int num_iters);
 
@@ -171,6 +177,32 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         }
 #endif
 
+    //! Returns true if this ForceCompute can start before a pending ghost update completes
+    /*! Derived classes that return true must call Communicator::finishUpdateGhosts() before they
+        read ghost particle data. By default, the ghost update is completed before compute().
+    */
+    virtual bool overlapsGhostUpdate()
+        {
+        return false;
+        }
+
+    //! Returns true if this ForceCompute adds its forces directly to the net force
+    /*! The Integrator calls addToNetForce() instead of compute() for these forces, after it sums
+        the force arrays of the others, which saves a force array pass per step. compute() still
+        fills the force arrays when they are requested outside of the integration, for example to
+        log the energies. Forces that return true must not have external virial or energy terms.
+    */
+    virtual bool addsToNetForce()
+        {
+        return false;
+        }
+
+    //! Add the forces, energies, and virials directly to the net force and virial
+    /*! \param timestep Current time step
+        \param scale Factor that scales the force (see getRespaScale())
+    */
+    virtual void addToNetForce(uint64_t timestep, Scalar scale) { }
+
     //! Returns true if this ForceCompute requires anisotropic integration
     virtual bool isAnisotropic()
         {
@@ -178,6 +210,56 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         return false;
         }
 
+    //! Get the data that computeForces() reads and writes, besides the force arrays of this force
+    /*! With concurrent forces enabled, Integrator launches the kernels of forces that write no
+        shared data and do not depend on each other on separate streams. The default (all data)
+        keeps the force on the default stream, ordered after all forces before it.
+    */
+    virtual DataDependencies getDataDependencies()
+        {
+        return DataDependencies();
+        }
+
+#ifdef ENABLE_HIP
+    //! Set the stream that computeForces() launches its kernels on
+    /*! Derived classes that launch on m_stream must call waitDefaultStream() before each launch.
+        The others ignore the stream and launch on the default stream.
+    */
+    void setStream(hipStream_t stream)
+        {
+        m_stream = stream;
+        }
+#endif
+
+    /// Set the number of timesteps between evaluations of this force in RESPA integration
+    void setRespaInterval(unsigned int interval)
+        {
+        if (interval == 0)
+            {
+            throw std::invalid_argument("respa_interval must be positive.");
+            }
+        m_respa_interval = interval;
+        }
+
+    /// Get the number of timesteps between evaluations of this force in RESPA integration
+    unsigned int getRespaInterval()
+        {
+        return m_respa_interval;
+        }
+
+    /** Get the factor that scales this force in the net force on the given timestep
+
+        The integrator applies a force with a RESPA interval k as an impulse: it is evaluated only
+        on timesteps that are multiples of k, where it enters the net force multiplied by k.
+
+        @param timestep Timestep at which the net force is evaluated.
+        @returns k on impulse steps and 0 on all other steps.
+    */
+    Scalar getRespaScale(uint64_t timestep)
+        {
+        return (timestep % m_respa_interval == 0) ? Scalar(m_respa_interval) : Scalar(0.0);
+        }
+
     protected:
     bool m_particles_sorted; //!< Flag set to true when particles are resorted in memory
 
@@ -190,16 +272,37 @@ class PYBIND11_EXPORT ForceCompute : public Compute
     void setParticlesSorted()
         {
         m_particles_sorted = true;
+
+#ifdef ENABLE_HIP
+        // move the forces of the reordered particles to the GPUs that own them
+        if (m_exec_conf->isCUDAEnabled())
+            {
+            m_force.prefetchPartition(m_pdata->getGPUPartition(), false);
+            m_virial.prefetchPartition(m_pdata->getGPUPartition(), false);
+            m_torque.prefetchPartition(m_pdata->getGPUPartition(), false);
+            }
+#endif
         }
 
     //! Reallocate internal arrays
     void reallocate();
 
+#ifdef ENABLE_HIP
+    //! Order m_stream after the work queued on the default stream
+    void waitDefaultStream();
+
+    hipStream_t m_stream = 0;            //!< Stream to launch the force kernels on
+    hipEvent_t m_stream_event = nullptr; //!< Event that waitDefaultStream() records
+#endif
+
     //! Update GPU memory hints
     void updateGPUAdvice();
 
     Scalar m_deltaT; //!< timestep size (required for some types of non-conservative forces)
 
+    /// Number of timesteps between evaluations of this force in RESPA integration
+    unsigned int m_respa_interval = 1;
+
     GlobalArray<Scalar4> m_force; //!< m_force.x,m_force.y,m_force.z are the x,y,z components of the
                                   //!< force, m_force.u is the PE
 
@@ -227,12 +330,103 @@ class PYBIND11_EXPORT ForceCompute : public Compute
     virtual void computeForces(uint64_t timestep) { }
     };
 
+/// Allow the usage of ForceCompute arrays in Python.
+/** Uses the LocalDataAccess templated class to expose the per-particle force, potential energy,
+ *  torque, and virial of a single force to Python. The arrays are read only and have one entry for
+ *  each local particle, in the order of the local particle data.
+ *
+ *  Template Parameters
+ *  Output: The buffer output type (either HOOMDHostBuffer or HOOMDDeviceBuffer)
+ */
+template<class Output>
+class PYBIND11_EXPORT LocalForceComputeData : public LocalDataAccess<Output, ForceCompute>
+    {
+    public:
+    LocalForceComputeData(ForceCompute& data, ParticleData& pdata)
+        : LocalDataAccess<Output, ForceCompute>(data), m_force_compute(data), m_pdata(pdata),
+          m_force_handle(), m_virial_handle(), m_torque_handle()
+        {
+        }
+
+    virtual ~LocalForceComputeData() = default;
+
+    Output getForce()
+        {
+        return this->template getArrayBuffer<Scalar4, Scalar>(
+            m_force_handle,
+            m_force_compute.getForceArray(),
+            std::vector<ssize_t>({m_pdata.getN(), 3}),
+            std::vector<ssize_t>({sizeof(Scalar4), sizeof(Scalar)}));
+        }
+
+    Output getPotentialEnergy()
+        {
+        return this->template getArrayBuffer<Scalar4, Scalar>(
+            m_force_handle,
+            m_force_compute.getForceArray(),
+            std::vector<ssize_t>({m_pdata.getN()}),
+            std::vector<ssize_t>({sizeof(Scalar4)}),
+            true,
+            3 * sizeof(Scalar));
+        }
+
+    Output getTorque()
+        {
+        return this->template getArrayBuffer<Scalar4, Scalar>(
+            m_torque_handle,
+            m_force_compute.getTorqueArray(),
+            std::vector<ssize_t>({m_pdata.getN(), 3}),
+            std::vector<ssize_t>({sizeof(Scalar4), sizeof(Scalar)}));
+        }
+
+    Output getVirial()
+        {
+        // the virial is stored as 6 rows of length pitch, expose it transposed as (N, 6)
+        const GlobalArray<Scalar>& virial = m_force_compute.getVirialArray();
+        return this->template getArrayBuffer<Scalar, Scalar>(
+            m_virial_handle,
+            virial,
+            std::vector<ssize_t>({m_pdata.getN(), 6}),
+            std::vector<ssize_t>({sizeof(Scalar), (ssize_t)(virial.getPitch() * sizeof(Scalar))}));
+        }
+
+    protected:
+    void clear()
+        {
+        m_force_handle.reset(nullptr);
+        m_virial_handle.reset(nullptr);
+        m_torque_handle.reset(nullptr);
+        }
+
+    private:
+    ForceCompute& m_force_compute;
+    ParticleData& m_pdata;
+    std::unique_ptr<ArrayHandle<Scalar4>> m_force_handle;
+    std::unique_ptr<ArrayHandle<Scalar>> m_virial_handle;
+    std::unique_ptr<ArrayHandle<Scalar4>> m_torque_handle;
+    };
+
 namespace detail
     {
 //! Exports the ForceCompute class to python
 #ifndef __HIPCC__
 void export_ForceCompute(pybind11::module& m);
 #endif
+
+/// Export local access to ForceCompute
+template<class Output> void export_LocalForceComputeData(pybind11::module& m, std::string name)
+    {
+    pybind11::class_<LocalForceComputeData<Output>, std::shared_ptr<LocalForceComputeData<Output>>>(
+        m,
+        name.c_str())
+        .def(pybind11::init<ForceCompute&, ParticleData&>())
+        .def("getForce", &LocalForceComputeData<Output>::getForce)
+        .def("getPotentialEnergy", &LocalForceComputeData<Output>::getPotentialEnergy)
+        .def("getTorque", &LocalForceComputeData<Output>::getTorque)
+        .def("getVirial", &LocalForceComputeData<Output>::getVirial)
+        .def("enter", &LocalForceComputeData<Output>::enter)
+        .def("exit", &LocalForceComputeData<Output>::exit);
+    }
     } // end namespace detail
 
     } // end namespace hoomd
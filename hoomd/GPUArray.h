@@ -28,10 +28,17 @@
 #include <stdexcept>
 #include <stdlib.h>
 #include <string.h>
+#include <utility>
 
 #include <cxxabi.h>
 #include <sstream>
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
 namespace hoomd
     {
 //! Specifies where to acquire the data
@@ -172,6 +179,101 @@ template<class T> class host_deleter
     bool m_use_device;                                         //!< Whether to use hostMallocManaged
     size_t m_N;                                                //!< Number of elements in array
     };
+
+//! Zero a region of host memory
+/*! \param exec_conf Execution configuration
+    \param ptr Start of the region
+    \param size Size of the region in bytes
+    \param n_rows Number of equally sized rows of a 2D array in the region
+
+    The operating system places each page on the NUMA node of the thread that first writes to it.
+    When the execution configuration runs more than one TBB thread, large regions are cleared by
+    all threads of the task arena, placed according to ExecutionConfiguration::MemoryPlacement:
+     - interleave: the threads clear the pages round robin.
+     - partition: each row is split statically into one contiguous block per thread, matching the
+       split of the particle loops in ExecutionConfiguration::parallelFor().
+*/
+inline void host_memclear(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                          void* ptr,
+                          size_t size,
+                          size_t n_rows = 1)
+    {
+#ifdef ENABLE_TBB
+    // smaller regions span only a few pages and are not worth the task overhead
+    const size_t min_parallel_size = size_t(1) << 20;
+    if (exec_conf && exec_conf->getNumThreads() > 1 && size >= min_parallel_size)
+        {
+        char* data = static_cast<char*>(ptr);
+        exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                if (exec_conf->getMemoryPlacement()
+                    == ExecutionConfiguration::MemoryPlacement::partition)
+                    {
+                    const size_t row_size = size / n_rows;
+                    for (size_t row = 0; row < n_rows; ++row)
+                        {
+                        char* row_data = data + row * row_size;
+                        tbb::parallel_for(
+                            tbb::blocked_range<size_t>(0, row_size),
+                            [&](const tbb::blocked_range<size_t>& r)
+                            { memset(row_data + r.begin(), 0, r.end() - r.begin()); },
+                            tbb::static_partitioner());
+                        }
+                    return;
+                    }
+
+                const size_t page_size = 4096;
+                const size_t n_pages = (size + page_size - 1) / page_size;
+                const unsigned int n_threads = exec_conf->getNumThreads();
+                tbb::parallel_for(
+                    tbb::blocked_range<unsigned int>(0, n_threads, 1),
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                        for (unsigned int t = r.begin(); t != r.end(); ++t)
+                            for (size_t page = t; page < n_pages; page += n_threads)
+                                {
+                                size_t offset = page * page_size;
+                                memset(data + offset, 0, std::min(page_size, size - offset));
+                                }
+                    },
+                    tbb::static_partitioner());
+            });
+        return;
+        }
+#endif
+    memset(ptr, 0, size);
+    }
+
+#ifdef ENABLE_HIP
+class event_deleter
+    {
+    public:
+    //! Default constructor
+    event_deleter() { }
+
+    //! Constructor with execution configuration
+    /*! \param exec_conf The execution configuration (needed for CHECK_CUDA_ERROR)
+     */
+    event_deleter(std::shared_ptr<const ExecutionConfiguration> exec_conf) : m_exec_conf(exec_conf)
+        {
+        }
+
+    //! Destroy the event and free the memory location
+    /*! \param ptr Start of memory area
+     */
+    void operator()(hipEvent_t* ptr)
+        {
+        hipEventDestroy(*ptr);
+        CHECK_CUDA_ERROR();
+
+        delete ptr;
+        }
+
+    private:
+    std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
+    };
+#endif
     } // end namespace detail
 
 //! Forward declarations
@@ -239,6 +341,14 @@ template<class T, class Derived> class GPUArrayBase
         static_cast<Derived&>(*this).resize(width, height);
         }
 
+#ifdef ENABLE_HIP
+    //! Start an asynchronous copy of the device data to the host
+    void prefetchToHost(hipStream_t stream = 0) const
+        {
+        static_cast<Derived const&>(*this).prefetchToHost(stream);
+        }
+#endif
+
     protected:
     //! Acquires the data pointer for use
     inline ArrayHandleDispatch<T> acquire(const access_location::Enum location,
@@ -436,6 +546,12 @@ ArrayHandle<int> h_handle(gpu_array, access_location::host, access_mode::readwri
 h_handle.data[i*pitch + j] = 5;
 \endcode
 
+The host memory of GPUArray is page-locked, so copies to and from the device run at full bandwidth
+and may be asynchronous. Code that knows ahead of time that it will read the data on the host can
+call prefetchToHost() to queue the device to host copy on a stream. The next host acquire then
+waits for that copy to complete instead of copying synchronously, so the copy overlaps with the
+work that the host does in the meantime.
+
 A future modification of GPUArray will allow mirroring or splitting the data across multiple GPUs.
 
 \ingroup data_structs
@@ -453,7 +569,12 @@ template<class T> class GPUArray : public GPUArrayBase<T, GPUArray<T>>
     //! Constructs a 2-D GPUArray
     GPUArray(size_t width, size_t height, std::shared_ptr<const ExecutionConfiguration> exec_conf);
     //! Frees memory
-    virtual ~GPUArray() { }
+    virtual ~GPUArray()
+        {
+#ifdef ENABLE_HIP
+        waitPrefetch();
+#endif
+        }
 
 #ifdef ENABLE_HIP
     //! Constructs a 1-D GPUArray
@@ -564,6 +685,11 @@ template<class T> class GPUArray : public GPUArrayBase<T, GPUArray<T>>
         return m_exec_conf;
         }
 
+#ifdef ENABLE_HIP
+    //! Start an asynchronous copy of the device data to the host
+    inline void prefetchToHost(hipStream_t stream = 0) const;
+#endif
+
     protected:
     //! Clear memory starting from a given element
     /*! \param first The first element to clear
@@ -609,6 +735,12 @@ template<class T> class GPUArray : public GPUArrayBase<T, GPUArray<T>>
     mutable data_location::Enum m_data_location; //!< Tracks the current location of the data
 #ifdef ENABLE_HIP
     bool m_mapped; //!< True if we are using mapped memory
+
+    //! Event recorded after the last prefetchToHost() copy, created on first use
+    mutable std::unique_ptr<hipEvent_t, hoomd::detail::event_deleter> m_prefetch_event;
+
+    //! True when a copy queued by prefetchToHost() has not yet been consumed by a host acquire
+    mutable bool m_prefetch_pending = false;
 #endif
 
     // ok, this looks weird, but I want m_exec_conf to be protected and not have to go reorder all
@@ -633,6 +765,8 @@ template<class T> class GPUArray : public GPUArrayBase<T, GPUArray<T>>
     inline void memcpyDeviceToHost(bool async) const;
     //! Helper function to copy memory from the host to device
     inline void memcpyHostToDevice(bool async) const;
+    //! Wait for a pending prefetchToHost() copy to complete
+    inline void waitPrefetch() const;
 #endif
 
     //! Helper function to resize host array
@@ -838,6 +972,11 @@ template<class T> GPUArray<T>& GPUArray<T>::operator=(const GPUArray& rhs) noexc
         // sanity check
         assert(!m_acquired && !rhs.m_acquired);
 
+#ifdef ENABLE_HIP
+        // the copy must not write to the host memory after it is freed
+        waitPrefetch();
+#endif
+
         // copy over basic elements
         m_num_elements = rhs.m_num_elements;
         m_pitch = rhs.m_pitch;
@@ -879,7 +1018,9 @@ GPUArray<T>::GPUArray(GPUArray&& from) noexcept
       m_height(std::move(from.m_height)), m_acquired(std::move(from.m_acquired)),
       m_data_location(std::move(from.m_data_location)),
 #ifdef ENABLE_HIP
-      m_mapped(std::move(from.m_mapped)), d_data(std::move(from.d_data)),
+      m_mapped(std::move(from.m_mapped)), m_prefetch_event(std::move(from.m_prefetch_event)),
+      m_prefetch_pending(std::exchange(from.m_prefetch_pending, false)),
+      d_data(std::move(from.d_data)),
 #endif
       h_data(std::move(from.h_data)), m_exec_conf(std::move(from.m_exec_conf))
     {
@@ -890,12 +1031,18 @@ template<class T> GPUArray<T>& GPUArray<T>::operator=(GPUArray&& rhs) noexcept
     {
     if (&rhs != this)
         {
+#ifdef ENABLE_HIP
+        // the copy must not write to the host memory after it is freed
+        waitPrefetch();
+#endif
         m_num_elements = std::move(rhs.m_num_elements);
         m_pitch = std::move(rhs.m_pitch);
         m_height = std::move(rhs.m_height);
         m_exec_conf = std::move(rhs.m_exec_conf);
 #ifdef ENABLE_HIP
         m_mapped = std::move(rhs.m_mapped);
+        m_prefetch_event = std::move(rhs.m_prefetch_event);
+        m_prefetch_pending = std::exchange(rhs.m_prefetch_pending, false);
         d_data = std::move(rhs.d_data);
 #endif
         h_data = std::move(rhs.h_data);
@@ -934,6 +1081,8 @@ template<class T> void GPUArray<T>::swap(GPUArray& from)
 #ifdef ENABLE_HIP
     std::swap(d_data, from.d_data);
     std::swap(m_mapped, from.m_mapped);
+    std::swap(m_prefetch_event, from.m_prefetch_event);
+    std::swap(m_prefetch_pending, from.m_prefetch_pending);
 #endif
     std::swap(h_data, from.h_data);
     }
@@ -1048,8 +1197,11 @@ template<class T> void GPUArray<T>::memclear(size_t first)
     assert(h_data);
     assert(first < m_num_elements);
 
-    // clear memory
-    memset((void*)(h_data.get() + first), 0, sizeof(T) * (m_num_elements - first));
+    // clear memory, place the rows of 2D arrays like the particle loops that read them
+    hoomd::detail::host_memclear(m_exec_conf,
+                                 (void*)(h_data.get() + first),
+                                 sizeof(T) * (m_num_elements - first),
+                                 first == 0 && m_height > 0 ? m_height : 1);
 
 #if defined(ENABLE_HIP)
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
@@ -1136,6 +1288,56 @@ template<class T> void GPUArray<T>::memcpyHostToDevice(bool async) const
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
     }
+
+/*! \param stream Stream to queue the copy on
+
+    Queues a device to host copy of the array on \a stream when the current data is only on the
+    device. The next host acquire waits for this copy instead of copying the data synchronously.
+    Device acquires that write to the array before the next host acquire discard the prefetched
+    copy. Those writes must be ordered after the copy, which holds for all work on the default
+    stream and on \a stream.
+*/
+template<class T> void GPUArray<T>::prefetchToHost(hipStream_t stream) const
+    {
+    if (m_acquired)
+        throw std::runtime_error("Cannot prefetch an array in use.");
+
+    if (isNull() || !m_exec_conf || !m_exec_conf->isCUDAEnabled() || m_mapped
+        || m_data_location != data_location::device || m_prefetch_pending)
+        return;
+
+    m_exec_conf->msg->notice(10)
+        << "GPUArray: Prefetching " << float(m_num_elements * sizeof(T)) / 1024.0f / 1024.0f
+        << " MB device->host" << std::endl;
+
+    if (!m_prefetch_event)
+        {
+        m_prefetch_event = std::unique_ptr<hipEvent_t, hoomd::detail::event_deleter>(
+            new hipEvent_t,
+            hoomd::detail::event_deleter(m_exec_conf));
+        hipEventCreateWithFlags(m_prefetch_event.get(), hipEventDisableTiming);
+        }
+
+    hipMemcpyAsync(h_data.get(),
+                   d_data.get(),
+                   sizeof(T) * m_num_elements,
+                   hipMemcpyDeviceToHost,
+                   stream);
+    hipEventRecord(*m_prefetch_event, stream);
+    m_prefetch_pending = true;
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+template<class T> void GPUArray<T>::waitPrefetch() const
+    {
+    if (!m_prefetch_pending)
+        return;
+
+    hipEventSynchronize(*m_prefetch_event);
+    m_prefetch_pending = false;
+    }
 #endif
 
 /*! \param location Desired location to access the data
@@ -1197,18 +1399,25 @@ ArrayHandleDispatch<T> GPUArray<T>::acquire(const access_location::Enum location
             }
         else if (m_data_location == data_location::device)
             {
+            // a prefetched copy replaces the synchronous copy, wait for it in every mode so that
+            // it does not overwrite the data written on the host
+            bool prefetched = m_prefetch_pending;
+            waitPrefetch();
+
             // finally perform the action based on the access mode requested
             if (mode == access_mode::read)
                 {
                 // need to copy data from the device to the host
-                memcpyDeviceToHost(async);
+                if (!prefetched)
+                    memcpyDeviceToHost(async);
                 // state goes to hostdevice
                 m_data_location = data_location::hostdevice;
                 }
             else if (mode == access_mode::readwrite)
                 {
                 // need to copy data from the device to the host
-                memcpyDeviceToHost(async);
+                if (!prefetched)
+                    memcpyDeviceToHost(async);
                 // state goes to host
                 m_data_location = data_location::host;
                 }
@@ -1297,6 +1506,11 @@ ArrayHandleDispatch<T> GPUArray<T>::acquire(const access_location::Enum location
             }
         else if (m_data_location == data_location::device)
             {
+            // writes on the device invalidate a prefetched copy, the copy is ordered before them
+            // in the stream
+            if (mode != access_mode::read)
+                m_prefetch_pending = false;
+
             // the stat stays on the device regardless of the access mode
             return GPUArrayDispatch<T>(d_data.get(), *this);
             }
@@ -1349,7 +1563,7 @@ template<class T> T* GPUArray<T>::resizeHostArray(size_t num_elements)
         }
 #endif
     // clear memory
-    memset((void*)h_tmp, 0, sizeof(T) * num_elements);
+    hoomd::detail::host_memclear(m_exec_conf, (void*)h_tmp, sizeof(T) * num_elements);
 
     // copy over data
     size_t num_copy_elements = m_num_elements > num_elements ? num_elements : m_num_elements;
@@ -1414,7 +1628,10 @@ T* GPUArray<T>::resize2DHostArray(size_t pitch, size_t new_pitch, size_t height,
 #endif
 
     // clear memory
-    memset((void*)h_tmp, 0, sizeof(T) * new_pitch * new_height);
+    hoomd::detail::host_memclear(m_exec_conf,
+                                 (void*)h_tmp,
+                                 sizeof(T) * new_pitch * new_height,
+                                 new_height);
 
     // copy over data
     // every column is copied separately such as to align with the new pitch
@@ -1567,6 +1784,10 @@ template<class T> void GPUArray<T>::resize(size_t num_elements)
     assert(!m_acquired);
     assert(num_elements > 0);
 
+#ifdef ENABLE_HIP
+    waitPrefetch();
+#endif
+
     // if not allocated, simply allocate
     if (isNull())
         {
@@ -1607,6 +1828,10 @@ template<class T> void GPUArray<T>::resize(size_t width, size_t height)
     {
     assert(!m_acquired);
 
+#ifdef ENABLE_HIP
+    waitPrefetch();
+#endif
+
     // make m_pitch the next multiple of 16 larger or equal to the given width
     size_t new_pitch = (width + (16 - (width & 15)));
 
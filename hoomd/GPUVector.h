@@ -75,6 +75,14 @@ template<class T, class Array> class GPUVectorBase : public Array
      */
     virtual void resize(size_t new_size, const T& value);
 
+    //! Allocate memory for a number of elements without changing the size
+    /*! \param n Number of elements to allocate memory for
+     */
+    void reserve(size_t n)
+        {
+        reallocate(n);
+        }
+
     //! Insert an element at the end of the vector
     /*! \param val The new element
      */
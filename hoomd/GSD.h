@@ -98,6 +98,12 @@ class GSDUtils
             throw std::runtime_error(s.str());
             }
         }
+
+    /// Get the name of the shard file that MPI rank *rank* writes in distributed mode
+    static std::string getShardFilename(const std::string& fname, unsigned int rank)
+        {
+        return fname + ".shard" + std::to_string(rank);
+        }
     };
     } // namespace detail
     } // namespace hoomd
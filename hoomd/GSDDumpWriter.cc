@@ -13,6 +13,7 @@
 #include <pybind11/numpy.h>
 #include <pybind11/stl_bind.h>
 
+#include <algorithm>
 #include <limits>
 #include <list>
 #include <sstream>
@@ -120,9 +121,74 @@ void GSDDumpWriter::initFileIO()
         throw std::invalid_argument("Invalid GSD file mode: " + m_mode);
         }
 
+    m_nframes = gsd_get_nframes(&m_handle);
     m_is_initialized = true;
     }
 
+/*! Open this rank's shard file in the same mode as the main file. The shard of every active rank
+    must contain one frame for each frame in the main file, so an existing file may only be appended
+    to with at most as many ranks as the run that created it.
+*/
+void GSDDumpWriter::initShardFileIO()
+    {
+    m_shard_fname = GSDUtils::getShardFilename(m_fname, m_exec_conf->getRank());
+
+    if (m_mode == "wb" || m_mode == "xb"
+        || (m_mode == "ab" && !filesystem::exists(m_shard_fname)))
+        {
+        ostringstream o;
+        o << "HOOMD-blue " << HOOMD_VERSION;
+
+        m_exec_conf->msg->notice(3)
+            << "GSD: create or overwrite gsd file " << m_shard_fname << endl;
+        int retval = gsd_create_and_open(&m_shard_handle,
+                                         m_shard_fname.c_str(),
+                                         o.str().c_str(),
+                                         "hoomd",
+                                         gsd_make_version(1, 4),
+                                         GSD_OPEN_APPEND,
+                                         m_mode == "xb");
+        GSDUtils::checkError(retval, m_shard_fname);
+        }
+    else
+        {
+        m_exec_conf->msg->notice(3) << "GSD: open gsd file " << m_shard_fname << endl;
+        int retval = gsd_open(&m_shard_handle, m_shard_fname.c_str(), GSD_OPEN_APPEND);
+        GSDUtils::checkError(retval, m_shard_fname);
+
+        if (string(m_shard_handle.header.schema) != string("hoomd"))
+            {
+            throw runtime_error("GSD: Invalid schema in " + m_shard_fname);
+            }
+        }
+    m_shard_is_initialized = true;
+
+    // the shard frames must line up with the frames in the main file
+    uint64_t nframes = m_nframes;
+#ifdef ENABLE_MPI
+    bcast(nframes, 0, m_exec_conf->getMPICommunicator());
+#endif
+
+    unsigned int mismatch = gsd_get_nframes(&m_shard_handle) != nframes;
+#ifdef ENABLE_MPI
+    MPI_Allreduce(MPI_IN_PLACE,
+                  &mismatch,
+                  1,
+                  MPI_UNSIGNED,
+                  MPI_MAX,
+                  m_exec_conf->getMPICommunicator());
+#endif
+
+    if (mismatch)
+        {
+        std::ostringstream s;
+        s << "GSD: The shard files of " << m_fname << " do not match its " << nframes
+          << " frames. Append to distributed files with at most as many MPI ranks as the run "
+             "that created them.";
+        throw runtime_error(s.str());
+        }
+    }
+
 GSDDumpWriter::~GSDDumpWriter()
     {
     m_exec_conf->msg->notice(5) << "Destroying GSDDumpWriter" << endl;
@@ -132,11 +198,257 @@ GSDDumpWriter::~GSDDumpWriter()
     root = m_exec_conf->isRoot();
 #endif
 
+    stopWriterThread();
+    if (!m_writer_error.empty())
+        {
+        m_exec_conf->msg->error() << m_writer_error << endl;
+        }
+
     if (root && m_is_initialized)
         {
         m_exec_conf->msg->notice(5) << "GSD: close gsd file " << m_fname << endl;
         gsd_close(&m_handle);
         }
+
+    if (m_shard_is_initialized)
+        {
+        m_exec_conf->msg->notice(5) << "GSD: close gsd file " << m_shard_fname << endl;
+        gsd_close(&m_shard_handle);
+        }
+    }
+
+/*! \param async_write Set to true to write frames from a background thread
+
+    Disabling asynchronous mode writes out all buffered frames before returning.
+*/
+void GSDDumpWriter::setAsyncWrite(bool async_write)
+    {
+    if (async_write && m_distributed)
+        {
+        throw std::invalid_argument("GSD: async_write is not supported in distributed mode");
+        }
+    if (!async_write)
+        {
+        stopWriterThread();
+        checkWriterError();
+        }
+    m_async_write = async_write;
+    }
+
+/*! \param distributed Set to true to write particles to per-rank shard files
+
+    The mode must be chosen before the first frame is written.
+*/
+void GSDDumpWriter::setDistributed(bool distributed)
+    {
+    if (distributed == m_distributed)
+        return;
+
+    if (m_is_initialized || m_shard_is_initialized)
+        {
+        throw std::runtime_error("GSD: Cannot change distributed after the file is opened");
+        }
+    if (distributed && m_async_write)
+        {
+        throw std::invalid_argument("GSD: async_write is not supported in distributed mode");
+        }
+    m_distributed = distributed;
+    }
+
+/*! Blocks until the background writer thread has written all buffered frames to the file.
+ */
+void GSDDumpWriter::flush()
+    {
+    if (m_writer_thread.joinable())
+        {
+        std::unique_lock<std::mutex> lock(m_writer_mutex);
+        m_writer_cond.wait(lock, [this] { return m_queued_frames.empty(); });
+        }
+    checkWriterError();
+    }
+
+void GSDDumpWriter::startWriterThread()
+    {
+    m_free_frames.clear();
+    m_queued_frames.clear();
+    for (auto& frame : m_frame_buffers)
+        {
+        m_free_frames.push_back(&frame);
+        }
+
+    m_writer_stop = false;
+    m_writer_thread = std::thread(&GSDDumpWriter::writerThreadLoop, this);
+    }
+
+void GSDDumpWriter::stopWriterThread()
+    {
+    if (!m_writer_thread.joinable())
+        {
+        return;
+        }
+
+        {
+        std::lock_guard<std::mutex> lock(m_writer_mutex);
+        m_writer_stop = true;
+        }
+    m_writer_cond.notify_all();
+    m_writer_thread.join();
+    }
+
+/*! Write out queued frames in order until stopWriterThread() is called. The thread owns m_handle
+    while a frame is queued, all other accesses to the file wait for the queue to drain.
+*/
+void GSDDumpWriter::writerThreadLoop()
+    {
+    while (true)
+        {
+        FrameBuffer* frame;
+            {
+            std::unique_lock<std::mutex> lock(m_writer_mutex);
+            m_writer_cond.wait(lock, [this] { return m_writer_stop || !m_queued_frames.empty(); });
+            if (m_queued_frames.empty())
+                return;
+            frame = m_queued_frames.front();
+            }
+
+        int retval = 0;
+        if (frame->truncate)
+            retval = gsd_truncate(&m_handle);
+
+        for (auto it = frame->chunks.begin(); it != frame->chunks.end() && retval == 0; ++it)
+            {
+            retval = gsd_write_chunk(&m_handle,
+                                     it->name.c_str(),
+                                     it->type,
+                                     it->N,
+                                     it->M,
+                                     0,
+                                     frame->data.data() + it->offset);
+            }
+
+        if (retval == 0)
+            {
+            retval = gsd_end_frame(&m_handle);
+            }
+
+            {
+            std::lock_guard<std::mutex> lock(m_writer_mutex);
+            if (retval != 0 && m_writer_error.empty())
+                {
+                try
+                    {
+                    GSDUtils::checkError(retval, m_fname);
+                    }
+                catch (const std::exception& e)
+                    {
+                    m_writer_error = e.what();
+                    }
+                }
+            m_queued_frames.pop_front();
+            m_free_frames.push_back(frame);
+            }
+        m_writer_cond.notify_all();
+        }
+    }
+
+void GSDDumpWriter::checkWriterError()
+    {
+    std::string error;
+        {
+        std::lock_guard<std::mutex> lock(m_writer_mutex);
+        error.swap(m_writer_error);
+        }
+
+    if (!error.empty())
+        throw std::runtime_error(error);
+    }
+
+/*! \param name Name of the chunk
+    \param type Data type of the chunk
+    \param N Number of rows
+    \param M Number of columns
+    \param data Chunk data, N*M elements of \a type
+
+    In asynchronous mode, the data is copied to the current frame buffer and \a data may be freed
+    immediately after the call.
+
+    Per-particle chunks are recorded in frame 0 and skipped in later frames when they are unchanged,
+    readers then read them from frame 0.
+*/
+void GSDDumpWriter::writeChunk(const char* name,
+                               gsd_type type,
+                               uint64_t N,
+                               uint32_t M,
+                               const void* data)
+    {
+    size_t size = N * M * gsd_sizeof_type(type);
+
+    if (std::find(particle_chunks.begin(), particle_chunks.end(), name) != particle_chunks.end())
+        {
+        if (m_nframes == 0)
+            {
+            m_frame0_chunks[name].assign((const char*)data, (const char*)data + size);
+            }
+        else
+            {
+            auto it = m_frame0_chunks.find(name);
+            if (it != m_frame0_chunks.end() && it->second.size() == size
+                && memcmp(it->second.data(), data, size) == 0)
+                {
+                m_exec_conf->msg->notice(10) << "GSD: " << name << " is unchanged" << endl;
+                return;
+                }
+            }
+        }
+
+    if (m_frame)
+        {
+        size_t offset = m_frame->data.size();
+        m_frame->data.resize(offset + size);
+        memcpy(m_frame->data.data() + offset, data, size);
+        m_frame->chunks.push_back(FrameBuffer::Chunk {name, type, N, M, offset});
+        }
+    else
+        {
+        int retval = gsd_write_chunk(&m_handle, name, type, N, M, 0, data);
+        GSDUtils::checkError(retval, m_fname);
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    Queues the device to host copies of the arrays that analyze() reads for the chunk categories
+    it writes in this frame.
+*/
+void GSDDumpWriter::prefetch(uint64_t timestep)
+    {
+#ifdef ENABLE_HIP
+    if (!m_exec_conf->isCUDAEnabled())
+        return;
+
+    const bool attributes = m_write_attribute || m_nframes == 0;
+    const bool properties = m_write_property || m_nframes == 0;
+    const bool momenta = m_write_momentum || m_nframes == 0;
+
+    m_pdata->getTags().prefetchToHost();
+    if (attributes || properties)
+        m_pdata->getPositions().prefetchToHost();
+    if (attributes || momenta)
+        m_pdata->getVelocities().prefetchToHost();
+    if (attributes)
+        {
+        m_pdata->getCharges().prefetchToHost();
+        m_pdata->getDiameters().prefetchToHost();
+        m_pdata->getBodies().prefetchToHost();
+        m_pdata->getMomentsOfInertiaArray().prefetchToHost();
+        }
+    if (properties)
+        m_pdata->getOrientationArray().prefetchToHost();
+    if (properties || momenta)
+        m_pdata->getImages().prefetchToHost();
+    if (momenta)
+        m_pdata->getAngularMomentumArray().prefetchToHost();
+#endif
     }
 
 /*! \param timestep Current time step of the simulation
@@ -154,11 +466,6 @@ void GSDDumpWriter::analyze(uint64_t timestep)
     if (m_prof)
         m_prof->push("Dump GSD");
 
-    // take particle data snapshot
-    m_exec_conf->msg->notice(10) << "GSD: taking particle data snapshot" << endl;
-    SnapshotParticleData<float> snapshot;
-    const std::map<unsigned int, unsigned int>& map = m_pdata->takeSnapshot<float>(snapshot);
-
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
     root = m_exec_conf->isRoot();
@@ -167,19 +474,56 @@ void GSDDumpWriter::analyze(uint64_t timestep)
     // open the file if it is not yet opened
     if (!m_is_initialized && root)
         initFileIO();
+    if (m_distributed && !m_shard_is_initialized)
+        initShardFileIO();
+
+    if (m_async_write && root)
+        {
+        checkWriterError();
+        if (!m_writer_thread.joinable())
+            startWriterThread();
+
+        // wait for a free frame buffer, this blocks only when both buffers are queued. Reuse the
+        // buffer of a frame that was interrupted by an exception.
+        if (!m_frame)
+            {
+            std::unique_lock<std::mutex> lock(m_writer_mutex);
+            m_writer_cond.wait(lock, [this] { return !m_free_frames.empty(); });
+            m_frame = m_free_frames.front();
+            m_free_frames.pop_front();
+            }
+
+        m_frame->chunks.clear();
+        m_frame->data.clear();
+        m_frame->truncate = false;
+        }
 
     // truncate the file if requested
     if (m_truncate && root)
         {
         m_exec_conf->msg->notice(10) << "GSD: truncating file" << endl;
-        retval = gsd_truncate(&m_handle);
-        GSDUtils::checkError(retval, m_fname);
+        if (m_frame)
+            {
+            m_frame->truncate = true;
+            }
+        else
+            {
+            retval = gsd_truncate(&m_handle);
+            GSDUtils::checkError(retval, m_fname);
+            }
+        m_nframes = 0;
+        m_frame0_chunks.clear();
+        }
+    if (m_truncate && m_distributed)
+        {
+        retval = gsd_truncate(&m_shard_handle);
+        GSDUtils::checkError(retval, m_shard_fname);
         }
 
     uint64_t nframes = 0;
     if (root)
         {
-        nframes = gsd_get_nframes(&m_handle);
+        nframes = m_nframes;
         m_exec_conf->msg->notice(10)
             << "GSD: " << m_fname << " has " << nframes << " frames" << endl;
         }
@@ -188,20 +532,41 @@ void GSDDumpWriter::analyze(uint64_t timestep)
     bcast(nframes, 0, m_exec_conf->getMPICommunicator());
 #endif
 
+    // gather the particle fields, distributed mode writes the local particles directly
+    if (!m_distributed)
+        gatherParticles(nframes);
+
     if (root)
         {
         // write out the frame header on all frames
         writeFrameHeader(timestep);
 
-        // only write out data chunk categories if requested, or if on frame 0
-        if (m_write_attribute || nframes == 0)
-            writeAttributes(snapshot, map);
-        if (m_write_property || nframes == 0)
-            writeProperties(snapshot, map);
-        if (m_write_momentum || nframes == 0)
-            writeMomenta(snapshot, map);
+        if (m_distributed)
+            {
+            // the main file indexes the shards that hold the particles
+            std::vector<std::string> type_mapping;
+            for (unsigned int i = 0; i < m_pdata->getNTypes(); i++)
+                type_mapping.push_back(m_pdata->getNameByType(i));
+            writeTypeMapping("particles/types", type_mapping);
+
+            uint32_t n_shards = m_exec_conf->getNRanks();
+            writeChunk("shard/N", GSD_TYPE_UINT32, 1, 1, (void*)&n_shards);
+            }
+        else
+            {
+            // only write out data chunk categories if requested, or if on frame 0
+            if (m_write_attribute || nframes == 0)
+                writeAttributes();
+            if (m_write_property || nframes == 0)
+                writeProperties();
+            if (m_write_momentum || nframes == 0)
+                writeMomenta();
+            }
         }
 
+    if (m_distributed)
+        writeShard(timestep);
+
     // topology is only meaningful if this is the all group
     if (m_group->getNumMembersGlobal() == m_pdata->getNGlobal()
         && (m_write_topology || nframes == 0))
@@ -233,6 +598,18 @@ void GSDDumpWriter::analyze(uint64_t timestep)
                           pdata_snapshot);
         }
 
+    // slots write to the file directly, so the background writer must be idle
+    if (m_frame && m_write_signal.getNumSlots() > 0)
+        {
+        flush();
+        if (m_frame->truncate)
+            {
+            retval = gsd_truncate(&m_handle);
+            GSDUtils::checkError(retval, m_fname);
+            m_frame->truncate = false;
+            }
+        }
+
     // emit on all ranks, the slot needs to handle the mpi logic.
     m_write_signal.emit(m_handle);
 
@@ -241,13 +618,27 @@ void GSDDumpWriter::analyze(uint64_t timestep)
         m_log_writer.attr("_write_frame")(this);
         }
 
-    if (root)
+    if (m_frame)
+        {
+        // hand the frame to the background writer
+        m_exec_conf->msg->notice(10) << "GSD: queueing frame" << endl;
+            {
+            std::lock_guard<std::mutex> lock(m_writer_mutex);
+            m_queued_frames.push_back(m_frame);
+            }
+        m_writer_cond.notify_all();
+        m_frame = nullptr;
+        }
+    else if (root)
         {
         m_exec_conf->msg->notice(10) << "GSD: ending frame" << endl;
         retval = gsd_end_frame(&m_handle);
         GSDUtils::checkError(retval, m_fname);
         }
 
+    if (root)
+        m_nframes++;
+
     if (m_prof)
         m_prof->pop();
     }
@@ -266,14 +657,7 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector<std::string>
         std::vector<char> types(max_len * type_mapping.size());
         for (unsigned int i = 0; i < type_mapping.size(); i++)
             strncpy(&types[max_len * i], type_mapping[i].c_str(), max_len);
-        int retval = gsd_write_chunk(&m_handle,
-                                     chunk.c_str(),
-                                     GSD_TYPE_UINT8,
-                                     type_mapping.size(),
-                                     max_len,
-                                     0,
-                                     (void*)&types[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk(chunk.c_str(), GSD_TYPE_UINT8, type_mapping.size(), max_len, (void*)&types[0]);
         }
     }
 
@@ -287,25 +671,15 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector<std::string>
 */
 void GSDDumpWriter::writeFrameHeader(uint64_t timestep)
     {
-    int retval;
     m_exec_conf->msg->notice(10) << "GSD: writing configuration/step" << endl;
     uint64_t step = timestep;
-    retval
-        = gsd_write_chunk(&m_handle, "configuration/step", GSD_TYPE_UINT64, 1, 1, 0, (void*)&step);
-    GSDUtils::checkError(retval, m_fname);
+    writeChunk("configuration/step", GSD_TYPE_UINT64, 1, 1, (void*)&step);
 
-    if (gsd_get_nframes(&m_handle) == 0)
+    if (m_nframes == 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing configuration/dimensions" << endl;
         uint8_t dimensions = (uint8_t)m_sysdef->getNDimensions();
-        retval = gsd_write_chunk(&m_handle,
-                                 "configuration/dimensions",
-                                 GSD_TYPE_UINT8,
-                                 1,
-                                 1,
-                                 0,
-                                 (void*)&dimensions);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("configuration/dimensions", GSD_TYPE_UINT8, 1, 1, (void*)&dimensions);
         }
 
     m_exec_conf->msg->notice(10) << "GSD: writing configuration/box" << endl;
@@ -317,28 +691,99 @@ void GSDDumpWriter::writeFrameHeader(uint64_t timestep)
     box_a[3] = (float)box.getTiltFactorXY();
     box_a[4] = (float)box.getTiltFactorXZ();
     box_a[5] = (float)box.getTiltFactorYZ();
-    retval = gsd_write_chunk(&m_handle, "configuration/box", GSD_TYPE_FLOAT, 6, 1, 0, (void*)box_a);
-    GSDUtils::checkError(retval, m_fname);
+    writeChunk("configuration/box", GSD_TYPE_FLOAT, 6, 1, (void*)box_a);
 
     m_exec_conf->msg->notice(10) << "GSD: writing particles/N" << endl;
     uint32_t N = m_group->getNumMembersGlobal();
-    retval = gsd_write_chunk(&m_handle, "particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
-    GSDUtils::checkError(retval, m_fname);
+    writeChunk("particles/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
     }
 
-/*! \param snapshot particle data snapshot to write out to the file
+/*! \param nframes Number of frames in the file
 
-    Writes the data chunks types, typeid, mass, charge, diameter, body, moment_inertia in
+    Gathers only the fields of the chunk categories that analyze() writes in this frame, in tag
+    order on the root rank. This avoids the full double buffered snapshot and the tag map of
+    takeSnapshot.
+*/
+void GSDDumpWriter::gatherParticles(uint64_t nframes)
+    {
+    m_exec_conf->msg->notice(10) << "GSD: gathering particle data" << endl;
+
+    bool root = true;
+#ifdef ENABLE_MPI
+    root = m_exec_conf->isRoot();
+#endif
+
+    const bool attributes = m_write_attribute || nframes == 0;
+    const bool properties = m_write_property || nframes == 0;
+    const bool momenta = m_write_momentum || nframes == 0;
+
+    // only the root rank stores the gathered fields
+    const size_t N = root ? m_pdata->getNGlobal() : 0;
+    m_particles.tag.resize(N);
+    m_particles.type.resize(attributes ? N : 0);
+    m_particles.mass.resize(attributes ? N : 0);
+    m_particles.charge.resize(attributes ? N : 0);
+    m_particles.diameter.resize(attributes ? N : 0);
+    m_particles.body.resize(attributes ? N : 0);
+    m_particles.inertia.resize(attributes ? N * 3 : 0);
+    m_particles.pos.resize(properties ? N * 3 : 0);
+    m_particles.orientation.resize(properties ? N * 4 : 0);
+    m_particles.vel.resize(momenta ? N * 3 : 0);
+    m_particles.angmom.resize(momenta ? N * 4 : 0);
+    m_particles.image.resize(momenta ? N * 3 : 0);
+
+    // the root rank selects the fields, the pointers on other ranks are ignored
+    SnapshotFieldBuffers<float> buffers;
+    buffers.tag = m_particles.tag.data();
+    if (attributes)
+        {
+        buffers.type = m_particles.type.data();
+        buffers.mass = m_particles.mass.data();
+        buffers.charge = m_particles.charge.data();
+        buffers.diameter = m_particles.diameter.data();
+        buffers.body = m_particles.body.data();
+        buffers.inertia = m_particles.inertia.data();
+        }
+    if (properties)
+        {
+        buffers.pos = m_particles.pos.data();
+        buffers.orientation = m_particles.orientation.data();
+        }
+    if (momenta)
+        {
+        buffers.vel = m_particles.vel.data();
+        buffers.angmom = m_particles.angmom.data();
+        buffers.image = m_particles.image.data();
+        }
+    m_pdata->gatherSnapshotFields(buffers);
+
+    if (!root)
+        return;
+
+    // the gathered tags are sorted, find the group members with a binary search
+    unsigned int n_members = m_group->getNumMembersGlobal();
+    m_particles.index.resize(n_members);
+    for (unsigned int group_idx = 0; group_idx < n_members; group_idx++)
+        {
+        unsigned int t = m_group->getMemberTag(group_idx);
+        auto it = std::lower_bound(m_particles.tag.begin(), m_particles.tag.end(), t);
+        assert(it != m_particles.tag.end() && *it == t);
+        m_particles.index[group_idx] = (unsigned int)(it - m_particles.tag.begin());
+        }
+    }
+
+/*! Writes the data chunks types, typeid, mass, charge, diameter, body, moment_inertia in
    particles/.
 */
-void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
-                                    const std::map<unsigned int, unsigned int>& map)
+void GSDDumpWriter::writeAttributes()
     {
     uint32_t N = m_group->getNumMembersGlobal();
-    int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
-    writeTypeMapping("particles/types", snapshot.type_mapping);
+    std::vector<std::string> type_mapping;
+    for (unsigned int i = 0; i < m_pdata->getNTypes(); i++)
+        type_mapping.push_back(m_pdata->getNameByType(i));
+    writeTypeMapping("particles/types", type_mapping);
 
         {
         std::vector<uint32_t> type(N);
@@ -347,29 +792,18 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int idx = m_particles.index[group_idx];
 
-            if (snapshot.type[it->second] != 0)
+            if (m_particles.type[idx] != 0)
                 all_default = false;
 
-            type[group_idx] = uint32_t(snapshot.type[it->second]);
+            type[group_idx] = uint32_t(m_particles.type[idx]);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/typeid"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/typeid" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/typeid",
-                                     GSD_TYPE_UINT32,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&type[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/typeid", GSD_TYPE_UINT32, N, 1, (void*)&type[0]);
             if (nframes == 0)
                 m_nondefault["particles/typeid"] = true;
             }
@@ -382,29 +816,18 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int idx = m_particles.index[group_idx];
 
-            if (snapshot.mass[it->second] != float(1.0))
+            if (m_particles.mass[idx] != float(1.0))
                 all_default = false;
 
-            data[group_idx] = float(snapshot.mass[it->second]);
+            data[group_idx] = m_particles.mass[idx];
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/mass"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/mass" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/mass",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/mass", GSD_TYPE_FLOAT, N, 1, (void*)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/mass"] = true;
             }
@@ -413,28 +836,17 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int idx = m_particles.index[group_idx];
 
-            if (snapshot.charge[it->second] != float(0.0))
+            if (m_particles.charge[idx] != float(0.0))
                 all_default = false;
-            data[group_idx] = float(snapshot.charge[it->second]);
+            data[group_idx] = m_particles.charge[idx];
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/charge"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/charge" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/charge",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/charge", GSD_TYPE_FLOAT, N, 1, (void*)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/charge"] = true;
             }
@@ -443,29 +855,18 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int idx = m_particles.index[group_idx];
 
-            if (snapshot.diameter[it->second] != float(1.0))
+            if (m_particles.diameter[idx] != float(1.0))
                 all_default = false;
 
-            data[group_idx] = float(snapshot.diameter[it->second]);
+            data[group_idx] = m_particles.diameter[idx];
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/diameter"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/diameter" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/diameter",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/diameter", GSD_TYPE_FLOAT, N, 1, (void*)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/diameter"] = true;
             }
@@ -478,29 +879,18 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int idx = m_particles.index[group_idx];
 
-            if (snapshot.body[it->second] != NO_BODY)
+            if (m_particles.body[idx] != NO_BODY)
                 all_default = false;
 
-            body[group_idx] = int32_t(snapshot.body[it->second]);
+            body[group_idx] = int32_t(m_particles.body[idx]);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/body"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/body" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/body",
-                                     GSD_TYPE_INT32,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&body[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/body", GSD_TYPE_INT32, N, 1, (void*)&body[0]);
             if (nframes == 0)
                 m_nondefault["particles/body"] = true;
             }
@@ -513,78 +903,54 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int idx = m_particles.index[group_idx];
 
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
-
-            if (snapshot.inertia[it->second].x != float(0.0)
-                || snapshot.inertia[it->second].y != float(0.0)
-                || snapshot.inertia[it->second].z != float(0.0))
+            if (m_particles.inertia[idx * 3 + 0] != float(0.0)
+                || m_particles.inertia[idx * 3 + 1] != float(0.0)
+                || m_particles.inertia[idx * 3 + 2] != float(0.0))
                 {
                 all_default = false;
                 }
 
-            data[group_idx * 3 + 0] = float(snapshot.inertia[it->second].x);
-            data[group_idx * 3 + 1] = float(snapshot.inertia[it->second].y);
-            data[group_idx * 3 + 2] = float(snapshot.inertia[it->second].z);
+            data[group_idx * 3 + 0] = m_particles.inertia[idx * 3 + 0];
+            data[group_idx * 3 + 1] = m_particles.inertia[idx * 3 + 1];
+            data[group_idx * 3 + 2] = m_particles.inertia[idx * 3 + 2];
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/moment_inertia"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/moment_inertia" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/moment_inertia",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     3,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, (void*)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/moment_inertia"] = true;
             }
         }
     }
 
-/*! \param snapshot particle data snapshot to write out to the file
-
-    Writes the data chunks position and orientation in particles/.
+/*! Writes the data chunks position and orientation in particles/.
 */
-void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
-                                    const std::map<unsigned int, unsigned int>& map)
+void GSDDumpWriter::writeProperties()
     {
     uint32_t N = m_group->getNumMembersGlobal();
-    int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
         {
         std::vector<float> data(uint64_t(N) * 3);
         data.reserve(1); //! make sure we allocate
+        const BoxDim& global_box = m_pdata->getGlobalBox();
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int idx = m_particles.index[group_idx];
 
-            data[group_idx * 3 + 0] = float(snapshot.pos[it->second].x);
-            data[group_idx * 3 + 1] = float(snapshot.pos[it->second].y);
-            data[group_idx * 3 + 2] = float(snapshot.pos[it->second].z);
+            Scalar3 pos = make_scalar3(m_particles.pos[idx * 3 + 0],
+                                       m_particles.pos[idx * 3 + 1],
+                                       m_particles.pos[idx * 3 + 2]);
+            quantizePosition(pos, global_box, &data[group_idx * 3]);
             }
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/position" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/position",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)&data[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("particles/position", GSD_TYPE_FLOAT, N, 3, (void*)&data[0]);
         }
 
         {
@@ -594,53 +960,38 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int idx = m_particles.index[group_idx];
 
-            if (snapshot.orientation[it->second].s != float(1.0)
-                || snapshot.orientation[it->second].v.x != float(0.0)
-                || snapshot.orientation[it->second].v.y != float(0.0)
-                || snapshot.orientation[it->second].v.z != float(0.0))
+            if (m_particles.orientation[idx * 4 + 0] != float(1.0)
+                || m_particles.orientation[idx * 4 + 1] != float(0.0)
+                || m_particles.orientation[idx * 4 + 2] != float(0.0)
+                || m_particles.orientation[idx * 4 + 3] != float(0.0))
                 {
                 all_default = false;
                 }
 
-            data[group_idx * 4 + 0] = float(snapshot.orientation[it->second].s);
-            data[group_idx * 4 + 1] = float(snapshot.orientation[it->second].v.x);
-            data[group_idx * 4 + 2] = float(snapshot.orientation[it->second].v.y);
-            data[group_idx * 4 + 3] = float(snapshot.orientation[it->second].v.z);
+            data[group_idx * 4 + 0] = m_particles.orientation[idx * 4 + 0];
+            data[group_idx * 4 + 1] = m_particles.orientation[idx * 4 + 1];
+            data[group_idx * 4 + 2] = m_particles.orientation[idx * 4 + 2];
+            data[group_idx * 4 + 3] = m_particles.orientation[idx * 4 + 3];
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/orientation"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/orientation" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/orientation",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     4,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/orientation", GSD_TYPE_FLOAT, N, 4, (void*)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/orientation"] = true;
             }
         }
     }
 
-/*! \param snapshot particle data snapshot to write out to the file
-
-    Writes the data chunks velocity, angmom, and image in particles/.
+/*! Writes the data chunks velocity, angmom, and image in particles/.
 */
-void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot,
-                                 const std::map<unsigned int, unsigned int>& map)
+void GSDDumpWriter::writeMomenta()
     {
     uint32_t N = m_group->getNumMembersGlobal();
-    int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
         {
         std::vector<float> data(uint64_t(N) * 3);
@@ -649,34 +1000,24 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
+            unsigned int idx = m_particles.index[group_idx];
 
-            if (snapshot.vel[it->second].x != float(0.0) || snapshot.vel[it->second].y != float(0.0)
-                || snapshot.vel[it->second].z != float(0.0))
+            if (m_particles.vel[idx * 3 + 0] != float(0.0)
+                || m_particles.vel[idx * 3 + 1] != float(0.0)
+                || m_particles.vel[idx * 3 + 2] != float(0.0))
                 {
                 all_default = false;
                 }
 
-            data[group_idx * 3 + 0] = float(snapshot.vel[it->second].x);
-            data[group_idx * 3 + 1] = float(snapshot.vel[it->second].y);
-            data[group_idx * 3 + 2] = float(snapshot.vel[it->second].z);
+            data[group_idx * 3 + 0] = m_particles.vel[idx * 3 + 0];
+            data[group_idx * 3 + 1] = m_particles.vel[idx * 3 + 1];
+            data[group_idx * 3 + 2] = m_particles.vel[idx * 3 + 2];
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/velocity"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/velocity" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/velocity",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     3,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/velocity", GSD_TYPE_FLOAT, N, 3, (void*)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/velocity"] = true;
             }
@@ -689,37 +1030,26 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int idx = m_particles.index[group_idx];
 
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
-
-            if (snapshot.angmom[it->second].s != float(0.0)
-                || snapshot.angmom[it->second].v.x != float(0.0)
-                || snapshot.angmom[it->second].v.y != float(0.0)
-                || snapshot.angmom[it->second].v.z != float(0.0))
+            if (m_particles.angmom[idx * 4 + 0] != float(0.0)
+                || m_particles.angmom[idx * 4 + 1] != float(0.0)
+                || m_particles.angmom[idx * 4 + 2] != float(0.0)
+                || m_particles.angmom[idx * 4 + 3] != float(0.0))
                 {
                 all_default = false;
                 }
 
-            data[group_idx * 4 + 0] = float(snapshot.angmom[it->second].s);
-            data[group_idx * 4 + 1] = float(snapshot.angmom[it->second].v.x);
-            data[group_idx * 4 + 2] = float(snapshot.angmom[it->second].v.y);
-            data[group_idx * 4 + 3] = float(snapshot.angmom[it->second].v.z);
+            data[group_idx * 4 + 0] = m_particles.angmom[idx * 4 + 0];
+            data[group_idx * 4 + 1] = m_particles.angmom[idx * 4 + 1];
+            data[group_idx * 4 + 2] = m_particles.angmom[idx * 4 + 2];
+            data[group_idx * 4 + 3] = m_particles.angmom[idx * 4 + 3];
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/angmom"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/angmom" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/angmom",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     4,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/angmom", GSD_TYPE_FLOAT, N, 4, (void*)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/angmom"] = true;
             }
@@ -732,40 +1062,194 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
+            unsigned int idx = m_particles.index[group_idx];
 
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
-
-            if (snapshot.image[it->second].x != 0 || snapshot.image[it->second].y != 0
-                || snapshot.image[it->second].z != 0)
+            if (m_particles.image[idx * 3 + 0] != 0 || m_particles.image[idx * 3 + 1] != 0
+                || m_particles.image[idx * 3 + 2] != 0)
                 {
                 all_default = false;
                 }
 
-            data[group_idx * 3 + 0] = snapshot.image[it->second].x;
-            data[group_idx * 3 + 1] = snapshot.image[it->second].y;
-            data[group_idx * 3 + 2] = snapshot.image[it->second].z;
+            data[group_idx * 3 + 0] = m_particles.image[idx * 3 + 0];
+            data[group_idx * 3 + 1] = m_particles.image[idx * 3 + 1];
+            data[group_idx * 3 + 2] = m_particles.image[idx * 3 + 2];
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/image"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/image" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/image",
-                                     GSD_TYPE_INT32,
-                                     N,
-                                     3,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("particles/image", GSD_TYPE_INT32, N, 3, (void*)&data[0]);
             if (nframes == 0)
                 m_nondefault["particles/image"] = true;
             }
         }
     }
 
+/*! \param timestep Current time step of the simulation
+
+    Write the group members owned by this rank to its shard file in ascending tag order, along with
+   their tags in particles/tag. Particles migrate between ranks, so each shard frame stores every
+   non-default particle quantity and readers never fall back to frame 0 of a shard.
+*/
+void GSDDumpWriter::writeShard(uint64_t timestep)
+    {
+    auto write_chunk = [&](const char* name, gsd_type type, uint64_t N, uint32_t M, void* data)
+    {
+        m_exec_conf->msg->notice(10) << "GSD: writing " << name << " to shard" << endl;
+        int retval = gsd_write_chunk(&m_shard_handle, name, type, N, M, 0, data);
+        GSDUtils::checkError(retval, m_shard_fname);
+    };
+
+    // collect the local group members
+    std::vector<unsigned int> local_idx(m_group->getNumMembers());
+    for (unsigned int group_idx = 0; group_idx < local_idx.size(); group_idx++)
+        local_idx[group_idx] = m_group->getMemberIndex(group_idx);
+
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                  access_location::host,
+                                  access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+
+    std::sort(local_idx.begin(),
+              local_idx.end(),
+              [&h_tag](unsigned int a, unsigned int b) { return h_tag.data[a] < h_tag.data[b]; });
+
+    uint32_t N = (uint32_t)local_idx.size();
+    std::vector<uint32_t> tag(N);
+    std::vector<uint32_t> type(N);
+    std::vector<float> mass(N);
+    std::vector<float> charge(N);
+    std::vector<float> diameter(N);
+    std::vector<int32_t> body(N);
+    std::vector<float> inertia(uint64_t(N) * 3);
+    std::vector<float> position(uint64_t(N) * 3);
+    std::vector<float> orientation(uint64_t(N) * 4);
+    std::vector<float> velocity(uint64_t(N) * 3);
+    std::vector<float> angmom(uint64_t(N) * 4);
+    std::vector<int32_t> image(uint64_t(N) * 3);
+
+    bool default_type = true, default_mass = true, default_charge = true, default_diameter = true;
+    bool default_body = true, default_inertia = true, default_orientation = true;
+    bool default_velocity = true, default_angmom = true, default_image = true;
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const Scalar3 origin = m_pdata->getOrigin();
+    const int3 origin_image = m_pdata->getOriginImage();
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        unsigned int idx = local_idx[i];
+        tag[i] = h_tag.data[idx];
+
+        // shift and wrap the position the same way as ParticleData::takeSnapshot
+        Scalar3 pos
+            = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - origin;
+        int3 img = h_image.data[idx];
+        img.x -= origin_image.x;
+        img.y -= origin_image.y;
+        img.z -= origin_image.z;
+        global_box.wrap(pos, img);
+
+        type[i] = __scalar_as_int(h_pos.data[idx].w);
+        mass[i] = float(h_vel.data[idx].w);
+        charge[i] = float(h_charge.data[idx]);
+        diameter[i] = float(h_diameter.data[idx]);
+        body[i] = int32_t(h_body.data[idx]);
+
+        inertia[i * 3 + 0] = float(h_inertia.data[idx].x);
+        inertia[i * 3 + 1] = float(h_inertia.data[idx].y);
+        inertia[i * 3 + 2] = float(h_inertia.data[idx].z);
+
+        quantizePosition(pos, global_box, &position[i * 3]);
+
+        orientation[i * 4 + 0] = float(h_orientation.data[idx].x);
+        orientation[i * 4 + 1] = float(h_orientation.data[idx].y);
+        orientation[i * 4 + 2] = float(h_orientation.data[idx].z);
+        orientation[i * 4 + 3] = float(h_orientation.data[idx].w);
+
+        velocity[i * 3 + 0] = float(h_vel.data[idx].x);
+        velocity[i * 3 + 1] = float(h_vel.data[idx].y);
+        velocity[i * 3 + 2] = float(h_vel.data[idx].z);
+
+        angmom[i * 4 + 0] = float(h_angmom.data[idx].x);
+        angmom[i * 4 + 1] = float(h_angmom.data[idx].y);
+        angmom[i * 4 + 2] = float(h_angmom.data[idx].z);
+        angmom[i * 4 + 3] = float(h_angmom.data[idx].w);
+
+        image[i * 3 + 0] = img.x;
+        image[i * 3 + 1] = img.y;
+        image[i * 3 + 2] = img.z;
+
+        default_type = default_type && type[i] == 0;
+        default_mass = default_mass && mass[i] == 1.0f;
+        default_charge = default_charge && charge[i] == 0.0f;
+        default_diameter = default_diameter && diameter[i] == 1.0f;
+        default_body = default_body && h_body.data[idx] == NO_BODY;
+        default_inertia = default_inertia && inertia[i * 3 + 0] == 0.0f
+                          && inertia[i * 3 + 1] == 0.0f && inertia[i * 3 + 2] == 0.0f;
+        default_orientation = default_orientation && orientation[i * 4 + 0] == 1.0f
+                              && orientation[i * 4 + 1] == 0.0f && orientation[i * 4 + 2] == 0.0f
+                              && orientation[i * 4 + 3] == 0.0f;
+        default_velocity = default_velocity && velocity[i * 3 + 0] == 0.0f
+                           && velocity[i * 3 + 1] == 0.0f && velocity[i * 3 + 2] == 0.0f;
+        default_angmom = default_angmom && angmom[i * 4 + 0] == 0.0f && angmom[i * 4 + 1] == 0.0f
+                         && angmom[i * 4 + 2] == 0.0f && angmom[i * 4 + 3] == 0.0f;
+        default_image = default_image && img.x == 0 && img.y == 0 && img.z == 0;
+        }
+
+    uint64_t step = timestep;
+    write_chunk("configuration/step", GSD_TYPE_UINT64, 1, 1, (void*)&step);
+    write_chunk("particles/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
+
+    // gsd does not store empty chunks, a shard with no particles holds only the header
+    if (N > 0)
+        {
+        write_chunk("particles/tag", GSD_TYPE_UINT32, N, 1, (void*)&tag[0]);
+        write_chunk("particles/position", GSD_TYPE_FLOAT, N, 3, (void*)&position[0]);
+
+        if (!default_type)
+            write_chunk("particles/typeid", GSD_TYPE_UINT32, N, 1, (void*)&type[0]);
+        if (!default_mass)
+            write_chunk("particles/mass", GSD_TYPE_FLOAT, N, 1, (void*)&mass[0]);
+        if (!default_charge)
+            write_chunk("particles/charge", GSD_TYPE_FLOAT, N, 1, (void*)&charge[0]);
+        if (!default_diameter)
+            write_chunk("particles/diameter", GSD_TYPE_FLOAT, N, 1, (void*)&diameter[0]);
+        if (!default_body)
+            write_chunk("particles/body", GSD_TYPE_INT32, N, 1, (void*)&body[0]);
+        if (!default_inertia)
+            write_chunk("particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, (void*)&inertia[0]);
+        if (!default_orientation)
+            write_chunk("particles/orientation", GSD_TYPE_FLOAT, N, 4, (void*)&orientation[0]);
+        if (!default_velocity)
+            write_chunk("particles/velocity", GSD_TYPE_FLOAT, N, 3, (void*)&velocity[0]);
+        if (!default_angmom)
+            write_chunk("particles/angmom", GSD_TYPE_FLOAT, N, 4, (void*)&angmom[0]);
+        if (!default_image)
+            write_chunk("particles/image", GSD_TYPE_INT32, N, 3, (void*)&image[0]);
+        }
+
+    m_exec_conf->msg->notice(10) << "GSD: ending shard frame" << endl;
+    int retval = gsd_end_frame(&m_shard_handle);
+    GSDUtils::checkError(retval, m_shard_fname);
+    }
+
 /*! \param bond Bond data snapshot
     \param angle Angle data snapshot
     \param dihedral Dihedral data snapshot
@@ -786,126 +1270,64 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/N" << endl;
         uint32_t N = bond.size;
-        int retval = gsd_write_chunk(&m_handle, "bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("bonds/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
 
         writeTypeMapping("bonds/types", bond.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "bonds/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&bond.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("bonds/typeid", GSD_TYPE_UINT32, N, 1, (void*)&bond.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "bonds/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 2,
-                                 0,
-                                 (void*)&bond.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("bonds/group", GSD_TYPE_UINT32, N, 2, (void*)&bond.groups[0]);
         }
     if (angle.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing angles/N" << endl;
         uint32_t N = angle.size;
-        int retval = gsd_write_chunk(&m_handle, "angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("angles/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
 
         writeTypeMapping("angles/types", angle.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing angles/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "angles/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&angle.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("angles/typeid", GSD_TYPE_UINT32, N, 1, (void*)&angle.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing angles/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "angles/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)&angle.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("angles/group", GSD_TYPE_UINT32, N, 3, (void*)&angle.groups[0]);
         }
     if (dihedral.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/N" << endl;
         uint32_t N = dihedral.size;
-        int retval = gsd_write_chunk(&m_handle, "dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("dihedrals/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
 
         writeTypeMapping("dihedrals/types", dihedral.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "dihedrals/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&dihedral.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("dihedrals/typeid", GSD_TYPE_UINT32, N, 1, (void*)&dihedral.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "dihedrals/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 4,
-                                 0,
-                                 (void*)&dihedral.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("dihedrals/group", GSD_TYPE_UINT32, N, 4, (void*)&dihedral.groups[0]);
         }
     if (improper.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/N" << endl;
         uint32_t N = improper.size;
-        int retval = gsd_write_chunk(&m_handle, "impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("impropers/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
 
         writeTypeMapping("impropers/types", improper.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "impropers/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&improper.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("impropers/typeid", GSD_TYPE_UINT32, N, 1, (void*)&improper.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "impropers/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 4,
-                                 0,
-                                 (void*)&improper.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("impropers/group", GSD_TYPE_UINT32, N, 4, (void*)&improper.groups[0]);
         }
 
     if (constraint.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/N" << endl;
         uint32_t N = constraint.size;
-        int retval
-            = gsd_write_chunk(&m_handle, "constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("constraints/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
 
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/value" << endl;
             {
@@ -914,55 +1336,26 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
             for (unsigned int i = 0; i < N; i++)
                 data[i] = float(constraint.val[i]);
 
-            retval = gsd_write_chunk(&m_handle,
-                                     "constraints/value",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&data[0]);
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk("constraints/value", GSD_TYPE_FLOAT, N, 1, (void*)&data[0]);
             }
 
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "constraints/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 2,
-                                 0,
-                                 (void*)&constraint.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("constraints/group", GSD_TYPE_UINT32, N, 2, (void*)&constraint.groups[0]);
         }
 
     if (pair.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/N" << endl;
         uint32_t N = pair.size;
-        int retval = gsd_write_chunk(&m_handle, "pairs/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("pairs/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
 
         writeTypeMapping("pairs/types", pair.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "pairs/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&pair.type_id[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("pairs/typeid", GSD_TYPE_UINT32, N, 1, (void*)&pair.type_id[0]);
 
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "pairs/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 2,
-                                 0,
-                                 (void*)&pair.groups[0]);
-        GSDUtils::checkError(retval, m_fname);
+        writeChunk("pairs/group", GSD_TYPE_UINT32, N, 2, (void*)&pair.groups[0]);
         }
     }
 
@@ -1062,14 +1455,7 @@ void GSDDumpWriter::writeLogQuantities(pybind11::dict dict)
                 throw invalid_argument("Invalid numpy dimension in gsd log data [" + name + "]");
                 }
 
-            int retval = gsd_write_chunk(&m_handle,
-                                         name.c_str(),
-                                         type,
-                                         N,
-                                         (uint32_t)M,
-                                         0,
-                                         (void*)arr.data());
-            GSDUtils::checkError(retval, m_fname);
+            writeChunk(name.c_str(), type, N, (uint32_t)M, (void*)arr.data());
             }
         }
     }
@@ -1106,6 +1492,15 @@ void GSDDumpWriter::populateNonDefault()
         {
         const gsd_index_entry* entry = gsd_find_chunk(&m_handle, 0, chunk.c_str());
         m_nondefault[chunk] = (entry != nullptr);
+
+        // keep the frame 0 data to detect unchanged chunks in the appended frames
+        if (entry != nullptr)
+            {
+            std::vector<char>& data = m_frame0_chunks[chunk];
+            data.resize(entry->N * entry->M * gsd_sizeof_type((enum gsd_type)entry->type));
+            retval = gsd_read_chunk(&m_handle, data.data(), entry);
+            GSDUtils::checkError(retval, m_fname);
+            }
         }
 
     // close the file
@@ -1129,6 +1524,14 @@ void export_GSDDumpWriter(pybind11::module& m)
         .def("setWriteMomentum", &GSDDumpWriter::setWriteMomentum)
         .def("setWriteTopology", &GSDDumpWriter::setWriteTopology)
         .def("writeLogQuantities", &GSDDumpWriter::writeLogQuantities)
+        .def("flush", &GSDDumpWriter::flush)
+        .def_property("distributed",
+                      &GSDDumpWriter::getDistributed,
+                      &GSDDumpWriter::setDistributed)
+        .def_property("async_write", &GSDDumpWriter::getAsyncWrite, &GSDDumpWriter::setAsyncWrite)
+        .def_property("position_precision",
+                      &GSDDumpWriter::getPositionPrecision,
+                      &GSDDumpWriter::setPositionPrecision)
         .def_property("log_writer", &GSDDumpWriter::getLogWriter, &GSDDumpWriter::setLogWriter)
         .def_property_readonly("filename", &GSDDumpWriter::getFilename)
         .def_property_readonly("mode", &GSDDumpWriter::getMode)
@@ -8,8 +8,14 @@
 #include "SharedSignal.h"
 
 #include "hoomd/extern/gsd.h"
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 /*! \file GSDDumpWriter.h
     \brief Declares the GSDDumpWriter class
@@ -30,6 +36,25 @@ namespace hoomd
 
     The file is not opened until the first call to analyze().
 
+    Readers fall back to frame 0 when a chunk is missing from a frame, so per-particle chunks in
+    particle_chunks that are identical to the ones written in frame 0 are not written again. This
+    keeps dynamic attributes that rarely change, such as typeid and body, out of later frames.
+
+    In asynchronous mode, analyze() copies the chunks of each frame into one of two frame buffers
+    and a background thread on the root rank writes them to the file. analyze() blocks only when
+    both buffers are waiting to be written.
+
+    In distributed mode, no particle data is gathered. Each rank writes the group members it owns
+    to its own shard file (see GSDUtils::getShardFilename) and the root rank writes the frame
+    header, types, topology, and log quantities to the main file, which serves as the index.
+    GSDReader merges the shards back into a single snapshot.
+
+    When the position precision is positive, each position component is rounded to the nearest
+    multiple of the precision before it is written. The chunks remain float, so the files are
+    readable by any GSD reader, but the reduced number of distinct values makes the trajectories
+    much more compressible by general purpose compressors. Positions that would round out of the
+    box are written unrounded so that every frame reads back inside the box.
+
     \ingroup analyzers
 */
 class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
@@ -101,12 +126,52 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         return pybind11::tuple(result);
         }
 
+    /// Set whether frames are written to the file by a background thread
+    void setAsyncWrite(bool async_write);
+
+    /// Get whether frames are written to the file by a background thread
+    bool getAsyncWrite()
+        {
+        return m_async_write;
+        }
+
+    /// Write all buffered frames to the file
+    void flush();
+
+    /// Set whether each rank writes its local particles to its own shard file
+    void setDistributed(bool distributed);
+
+    /// Get whether each rank writes its local particles to its own shard file
+    bool getDistributed()
+        {
+        return m_distributed;
+        }
+
+    /// Set the spacing that position components are rounded to, 0 to write full precision
+    void setPositionPrecision(Scalar position_precision)
+        {
+        if (position_precision < Scalar(0.0))
+            {
+            throw std::invalid_argument("GSD: position_precision must be non-negative");
+            }
+        m_position_precision = position_precision;
+        }
+
+    /// Get the spacing that position components are rounded to
+    Scalar getPositionPrecision()
+        {
+        return m_position_precision;
+        }
+
     //! Destructor
     ~GSDDumpWriter();
 
     //! Write out the data for the current timestep
     void analyze(uint64_t timestep);
 
+    //! Start copying the particle fields written in the next frame to the host
+    virtual void prefetch(uint64_t timestep);
+
     hoomd::detail::SharedSignal<int(gsd_handle&)>& getWriteSignal()
         {
         return m_write_signal;
@@ -150,6 +215,7 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     bool m_write_momentum;  //!< True if momenta should be written
     bool m_write_topology;  //!< True if topology should be written
     gsd_handle m_handle;    //!< Handle to the file
+    uint64_t m_nframes = 0; //!< Number of frames in the file, including buffered frames
 
     static std::list<std::string> particle_chunks;
 
@@ -160,28 +226,157 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     std::map<std::string, bool>
         m_nondefault; //!< Map of quantities (true when non-default in frame 0)
 
+    /// Contents of the per-particle chunks in frame 0, used to skip unchanged chunks
+    std::map<std::string, std::vector<char>> m_frame0_chunks;
+
     hoomd::detail::SharedSignal<int(gsd_handle&)> m_write_signal;
 
+    /// Chunks of one frame waiting to be written by the background thread
+    struct FrameBuffer
+        {
+        /// Location of a single chunk in data
+        struct Chunk
+            {
+            std::string name;
+            gsd_type type;
+            uint64_t N;
+            uint32_t M;
+            size_t offset;
+            };
+
+        std::vector<Chunk> chunks;
+        std::vector<char> data;
+
+        /// True when the file is truncated before writing this frame
+        bool truncate = false;
+        };
+
+    /// True when frames are written by the background thread
+    bool m_async_write = false;
+
+    /// The two frame buffers, their storage is reused from frame to frame
+    FrameBuffer m_frame_buffers[2];
+
+    /// Frame buffer filled by analyze(), nullptr when chunks are written directly
+    FrameBuffer* m_frame = nullptr;
+
+    /// Frame buffers available to analyze()
+    std::deque<FrameBuffer*> m_free_frames;
+
+    /// Frame buffers waiting for (or being written by) the background thread
+    std::deque<FrameBuffer*> m_queued_frames;
+
+    std::thread m_writer_thread;           //!< Background writer thread
+    std::mutex m_writer_mutex;             //!< Protects the frame queues and m_writer_error
+    std::condition_variable m_writer_cond; //!< Signals changes to the frame queues
+    bool m_writer_stop = false;            //!< Set to request the writer thread to exit
+    std::string m_writer_error;            //!< Error raised by the writer thread
+
+    /// True when particles are written to per-rank shard files instead of the main file
+    bool m_distributed = false;
+
+    /// Spacing that position components are rounded to, 0 when positions are not quantized
+    Scalar m_position_precision = 0;
+
+    //! Round a position to the position precision
+    /*! \param pos Position wrapped into \a box
+        \param box Global simulation box
+        \param out Destination of the three written components
+
+        Rounding moves a particle by up to half the precision, which can take particles near the
+        box faces outside of it. Such positions are written unrounded.
+    */
+    void quantizePosition(const Scalar3& pos, const BoxDim& box, float* out) const
+        {
+        if (m_position_precision > Scalar(0.0))
+            {
+            const Scalar p = m_position_precision;
+            Scalar3 q = make_scalar3(std::round(pos.x / p) * p,
+                                     std::round(pos.y / p) * p,
+                                     std::round(pos.z / p) * p);
+            Scalar3 f = box.makeFraction(q);
+            if (f.x >= Scalar(0.0) && f.x < Scalar(1.0) && f.y >= Scalar(0.0) && f.y < Scalar(1.0)
+                && f.z >= Scalar(0.0) && f.z < Scalar(1.0))
+                {
+                out[0] = float(q.x);
+                out[1] = float(q.y);
+                out[2] = float(q.z);
+                return;
+                }
+            }
+        out[0] = float(pos.x);
+        out[1] = float(pos.y);
+        out[2] = float(pos.z);
+        }
+
+    /// Particle fields of one frame in tag order, the storage is reused from frame to frame
+    struct GatheredParticles
+        {
+        std::vector<unsigned int> tag;
+        std::vector<unsigned int> type;
+        std::vector<float> mass;
+        std::vector<float> charge;
+        std::vector<float> diameter;
+        std::vector<unsigned int> body;
+        std::vector<float> inertia;
+        std::vector<float> pos;
+        std::vector<float> orientation;
+        std::vector<float> vel;
+        std::vector<float> angmom;
+        std::vector<int> image;
+
+        /// Index of each group member in the gathered fields
+        std::vector<unsigned int> index;
+        };
+
+    /// Fields gathered for the current frame, only valid on the root rank
+    GatheredParticles m_particles;
+
+    bool m_shard_is_initialized = false; //!< True if the shard file is open
+    std::string m_shard_fname;           //!< Name of this rank's shard file
+    gsd_handle m_shard_handle;           //!< Handle to this rank's shard file
+
+    //! Write a chunk to the file, or buffer it in asynchronous mode
+    void writeChunk(const char* name, gsd_type type, uint64_t N, uint32_t M, const void* data);
+
+    //! Start the background writer thread
+    void startWriterThread();
+
+    //! Write all buffered frames and stop the background writer thread
+    void stopWriterThread();
+
+    //! Main loop of the background writer thread
+    void writerThreadLoop();
+
+    //! Raise an exception if the background writer thread failed
+    void checkWriterError();
+
     //! Write a type mapping out to the file
     void writeTypeMapping(std::string chunk, std::vector<std::string> type_mapping);
 
     //! Initializes the output file for writing
     void initFileIO();
 
+    //! Initializes this rank's shard file for writing
+    void initShardFileIO();
+
+    //! Write the local group members to this rank's shard file
+    void writeShard(uint64_t timestep);
+
     //! Write frame header
     void writeFrameHeader(uint64_t timestep);
 
+    //! Gather the particle fields written in this frame into m_particles
+    void gatherParticles(uint64_t nframes);
+
     //! Write particle attributes
-    void writeAttributes(const SnapshotParticleData<float>& snapshot,
-                         const std::map<unsigned int, unsigned int>& map);
+    void writeAttributes();
 
     //! Write particle properties
-    void writeProperties(const SnapshotParticleData<float>& snapshot,
-                         const std::map<unsigned int, unsigned int>& map);
+    void writeProperties();
 
     //! Write particle momenta
-    void writeMomenta(const SnapshotParticleData<float>& snapshot,
-                      const std::map<unsigned int, unsigned int>& map);
+    void writeMomenta();
 
     //! Write bond topology
     void writeTopology(BondData::Snapshot& bond,
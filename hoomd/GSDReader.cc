@@ -6,8 +6,11 @@
 #include "GSD.h"
 #include "SnapshotSystemData.h"
 #include "hoomd/extern/gsd.h"
+#include <algorithm>
+#include <numeric>
 #include <sstream>
 #include <string.h>
+#include <unistd.h>
 
 #include <stdexcept>
 using namespace std;
@@ -19,6 +22,8 @@ namespace hoomd
     \param name File name to read
     \param frame Frame index to read from the file
     \param from_end Count frames back from the end of the file
+    \param stream_window When nonzero, do not read the particles into the snapshot and instead
+        read them at most \a stream_window at a time with readParticleWindow()
 
     The GSDReader constructor opens the GSD file, initializes an empty snapshot, and reads the file
    into memory (on the root rank).
@@ -26,8 +31,10 @@ namespace hoomd
 GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                      const std::string& name,
                      const uint64_t frame,
-                     bool from_end)
-    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame)
+                     bool from_end,
+                     unsigned int stream_window)
+    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame),
+      m_stream_window(stream_window)
     {
     m_snapshot = std::shared_ptr<SnapshotSystemData<float>>(new SnapshotSystemData<float>);
 
@@ -72,8 +79,25 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
         throw runtime_error(s.str());
         }
 
+    // files written in distributed mode store the particles in per-rank shard files
+    uint32_t n_shards = 0;
+    readChunk(&n_shards, m_frame, "shard/N", 4);
+    if (n_shards > 0 && m_stream_window > 0)
+        {
+        m_exec_conf->msg->notice(2)
+            << "data.gsd_snapshot: reading all particles of distributed file " << name << endl;
+        m_stream_window = 0;
+        }
+
     readHeader();
-    readParticles();
+
+    if (n_shards > 0)
+        readShards(n_shards);
+    else if (m_stream_window == 0)
+        readParticles();
+    else
+        m_snapshot->particle_data.type_mapping = readTypes(m_frame, "particles/types");
+
     readTopology();
     }
 
@@ -203,7 +227,11 @@ void GSDReader::readHeader()
         s << "Cannot read a file with 0 particles.";
         throw runtime_error(s.str());
         }
-    m_snapshot->particle_data.resize(N);
+    m_n_particles = N;
+
+    // particles are read later in streaming mode
+    if (m_stream_window == 0)
+        m_snapshot->particle_data.resize(N);
     }
 
 /*! Read the same data chunks for particles
@@ -236,6 +264,243 @@ void GSDReader::readParticles()
     readChunk(&m_snapshot->particle_data.image[0], m_frame, "particles/image", N * 12, N);
     }
 
+/*! \param data Pointer to data to read into
+    \param name Name of the data chunk
+    \param row_size Expected size of one row of the chunk in bytes.
+    \param first First row to read
+    \param count Number of rows to read
+
+    Like readChunk(), fall back to frame 0 when the chunk is not present in the current frame and
+   keep the default when the chunk is not found or its N does not match the current N. Only the
+   requested rows are read from the file.
+
+    Return true if data is actually read from the file.
+*/
+bool GSDReader::readChunkRows(void* data,
+                              const char* name,
+                              size_t row_size,
+                              uint64_t first,
+                              uint64_t count)
+    {
+    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, m_frame, name);
+    if (entry == NULL && m_frame != 0)
+        entry = gsd_find_chunk(&m_handle, 0, name);
+
+    if (entry == NULL || entry->N != m_n_particles)
+        return false;
+
+    size_t actual_row_size = entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (actual_row_size != row_size)
+        {
+        std::ostringstream s;
+        s << "Expecting " << row_size << " bytes per particle in " << name << " but found "
+          << actual_row_size << ".";
+        throw runtime_error(s.str());
+        }
+
+    // read the rows directly, gsd_read_chunk can only read whole chunks
+    char* ptr = (char*)data;
+    size_t remaining = count * row_size;
+    off_t offset = entry->location + first * row_size;
+    while (remaining > 0)
+        {
+        ssize_t bytes_read = ::pread(m_handle.fd, ptr, remaining, offset);
+        if (bytes_read <= 0)
+            GSDUtils::checkError(GSD_ERROR_IO, m_name);
+
+        ptr += bytes_read;
+        remaining -= bytes_read;
+        offset += bytes_read;
+        }
+
+    return true;
+    }
+
+/*! \param first Index of the first particle to read
+    \param window Snapshot to read the particles into, sized to the number of particles to read
+
+    Read the same data chunks as readParticles() for particles first to first + window.size - 1.
+   Chunks that are not present keep the defaults in \a window.
+*/
+void GSDReader::readParticleWindow(unsigned int first, SnapshotParticleData<float>& window)
+    {
+    unsigned int n = window.size;
+    if (uint64_t(first) + n > m_n_particles)
+        {
+        throw runtime_error("Particle window exceeds the particles in " + m_name);
+        }
+    if (n == 0)
+        return;
+
+    m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading particles " << first << " to "
+                                << first + n - 1 << endl;
+
+    readChunkRows(&window.type[0], "particles/typeid", 4, first, n);
+    readChunkRows(&window.mass[0], "particles/mass", 4, first, n);
+    readChunkRows(&window.charge[0], "particles/charge", 4, first, n);
+    readChunkRows(&window.diameter[0], "particles/diameter", 4, first, n);
+    readChunkRows(&window.body[0], "particles/body", 4, first, n);
+    readChunkRows(&window.inertia[0], "particles/moment_inertia", 12, first, n);
+    readChunkRows(&window.pos[0], "particles/position", 12, first, n);
+    readChunkRows(&window.orientation[0], "particles/orientation", 16, first, n);
+    readChunkRows(&window.vel[0], "particles/velocity", 12, first, n);
+    readChunkRows(&window.angmom[0], "particles/angmom", 16, first, n);
+    readChunkRows(&window.image[0], "particles/image", 12, first, n);
+    }
+
+/*! \param handle Handle to open
+    \param fname Name of the shard file
+
+    Open a shard file written by GSDDumpWriter in distributed mode and check that it contains the
+   current frame.
+*/
+void GSDReader::openShard(gsd_handle& handle, const std::string& fname)
+    {
+    m_exec_conf->msg->notice(3) << "data.gsd_snapshot: open gsd file " << fname << endl;
+    int retval = gsd_open(&handle, fname.c_str(), GSD_OPEN_READONLY);
+    GSDUtils::checkError(retval, fname);
+
+    if (string(handle.header.schema) != string("hoomd") || gsd_get_nframes(&handle) <= m_frame)
+        {
+        gsd_close(&handle);
+        std::ostringstream s;
+        s << "Shard " << fname << " does not match frame " << m_frame << " of " << m_name << ".";
+        throw runtime_error(s.str());
+        }
+    }
+
+/*! \param handle Handle to the shard file
+    \param fname Name of the shard file
+    \param data Pointer to data to read into
+    \param name Name of the data chunk
+    \param expected_size Expected size of the data chunk in bytes.
+
+    Shard frames are self contained, so unlike readChunk() this does not fall back to frame 0.
+    Return true if data is actually read from the file.
+*/
+bool GSDReader::readShardChunk(gsd_handle& handle,
+                               const std::string& fname,
+                               void* data,
+                               const char* name,
+                               size_t expected_size)
+    {
+    const struct gsd_index_entry* entry = gsd_find_chunk(&handle, m_frame, name);
+    if (entry == NULL)
+        return false;
+
+    size_t actual_size = entry->N * entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (actual_size != expected_size)
+        {
+        std::ostringstream s;
+        s << "Expecting " << expected_size << " bytes in " << name << " but found " << actual_size
+          << " in " << fname << ".";
+        throw runtime_error(s.str());
+        }
+    int retval = gsd_read_chunk(&handle, data, entry);
+    GSDUtils::checkError(retval, fname);
+    return true;
+    }
+
+/*! \param n_shards Number of shard files that hold the particles of this frame
+
+    Read the particles written by GSDDumpWriter in distributed mode and place them in the snapshot
+   in ascending tag order, the same order that a gathered snapshot uses. The first pass over the
+   shards collects the tags to determine each particle's snapshot index, the second reads the
+   particle data.
+*/
+void GSDReader::readShards(unsigned int n_shards)
+    {
+    SnapshotParticleData<float>& pdata = m_snapshot->particle_data;
+    unsigned int N = pdata.size;
+    pdata.type_mapping = readTypes(m_frame, "particles/types");
+
+    std::vector<unsigned int> tags;
+    tags.reserve(N);
+    std::vector<unsigned int> shard_n(n_shards, 0);
+
+    for (unsigned int shard = 0; shard < n_shards; shard++)
+        {
+        std::string fname = GSDUtils::getShardFilename(m_name, shard);
+        gsd_handle handle;
+        openShard(handle, fname);
+
+        readShardChunk(handle, fname, &shard_n[shard], "particles/N", 4);
+        if (tags.size() + shard_n[shard] > N)
+            {
+            gsd_close(&handle);
+            std::ostringstream s;
+            s << "The shards of " << m_name << " hold more than " << N << " particles.";
+            throw runtime_error(s.str());
+            }
+
+        size_t offset = tags.size();
+        tags.resize(offset + shard_n[shard]);
+        if (shard_n[shard] > 0)
+            readShardChunk(handle, fname, &tags[offset], "particles/tag", shard_n[shard] * 4);
+        gsd_close(&handle);
+        }
+
+    if (tags.size() != N)
+        {
+        std::ostringstream s;
+        s << "The shards of " << m_name << " hold " << tags.size() << " of " << N
+          << " particles.";
+        throw runtime_error(s.str());
+        }
+
+    // sort the particles by tag
+    std::vector<unsigned int> order(N);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(),
+              order.end(),
+              [&tags](unsigned int a, unsigned int b) { return tags[a] < tags[b]; });
+    std::vector<unsigned int> snap_idx(N);
+    for (unsigned int i = 0; i < N; i++)
+        snap_idx[order[i]] = i;
+
+    // read each chunk into a buffer and scatter it to the snapshot, chunks that are not present
+    // in a shard keep the snapshot defaults
+    std::vector<char> buffer;
+    size_t offset = 0;
+    for (unsigned int shard = 0; shard < n_shards; shard++)
+        {
+        unsigned int n = shard_n[shard];
+        if (n == 0)
+            continue;
+
+        std::string fname = GSDUtils::getShardFilename(m_name, shard);
+        gsd_handle handle;
+        openShard(handle, fname);
+
+        auto read_scatter = [&](const char* name, void* out, size_t element_size)
+        {
+            buffer.resize(n * element_size);
+            if (readShardChunk(handle, fname, buffer.data(), name, buffer.size()))
+                {
+                for (unsigned int i = 0; i < n; i++)
+                    memcpy((char*)out + snap_idx[offset + i] * element_size,
+                           &buffer[i * element_size],
+                           element_size);
+                }
+        };
+
+        read_scatter("particles/typeid", &pdata.type[0], 4);
+        read_scatter("particles/mass", &pdata.mass[0], 4);
+        read_scatter("particles/charge", &pdata.charge[0], 4);
+        read_scatter("particles/diameter", &pdata.diameter[0], 4);
+        read_scatter("particles/body", &pdata.body[0], 4);
+        read_scatter("particles/moment_inertia", &pdata.inertia[0], 12);
+        read_scatter("particles/position", &pdata.pos[0], 12);
+        read_scatter("particles/orientation", &pdata.orientation[0], 16);
+        read_scatter("particles/velocity", &pdata.vel[0], 12);
+        read_scatter("particles/angmom", &pdata.angmom[0], 16);
+        read_scatter("particles/image", &pdata.image[0], 12);
+
+        gsd_close(&handle);
+        offset += n;
+        }
+    }
+
 /*! Read the same data chunks for topology
  */
 void GSDReader::readTopology()
@@ -468,7 +733,13 @@ void export_GSDReader(pybind11::module& m)
                             const string&,
                             const uint64_t,
                             bool>())
+        .def(pybind11::init<std::shared_ptr<const ExecutionConfiguration>,
+                            const string&,
+                            const uint64_t,
+                            bool,
+                            unsigned int>())
         .def("getTimeStep", &GSDReader::getTimeStep)
+        .def("getStreamWindow", &GSDReader::getStreamWindow)
         .def("getSnapshot", &GSDReader::getSnapshot)
         .def("clearSnapshot", &GSDReader::clearSnapshot)
         .def("readTypeShapesPy", &GSDReader::readTypeShapesPy);
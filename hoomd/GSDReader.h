@@ -24,6 +24,16 @@ template<class Real> struct SnapshotSystemData;
 /*! Read an input GSD file and generate a system snapshot. GSDReader can read any frame from a GSD
     file into the snapshot. For information on the GSD specification, see http://gsd.readthedocs.io/
 
+    With a nonzero stream window, GSDReader does not read the particles into the snapshot. Instead,
+    the root rank keeps the file open and readParticleWindow() reads them a window at a time, which
+    lets ParticleData::initializeFromWindows() distribute them without holding all particles in
+    memory at once.
+
+    Opening a file does not scan it: in read only mode gsd_open() maps the index block of the file
+    into memory and gsd_find_chunk() locates the chunks of the requested frame (or frame 0) by
+    binary search. Only those chunks are read, so the time to open a frame does not grow with the
+    number of frames in the file.
+
     \ingroup data_structs
 */
 class PYBIND11_EXPORT GSDReader
@@ -33,7 +43,8 @@ class PYBIND11_EXPORT GSDReader
     GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
               const std::string& name,
               const uint64_t frame,
-              bool from_end);
+              bool from_end,
+              unsigned int stream_window = 0);
 
     //! Destructor
     ~GSDReader();
@@ -64,6 +75,29 @@ class PYBIND11_EXPORT GSDReader
         return m_frame;
         }
 
+    //! Get the maximum number of particles read at once, 0 when the snapshot holds all particles
+    unsigned int getStreamWindow() const
+        {
+        unsigned int stream_window = m_stream_window;
+
+// shard files disable streaming on the root, broadcast to the other nodes
+#ifdef ENABLE_MPI
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        bcast(stream_window, 0, mpi_comm);
+#endif
+
+        return stream_window;
+        }
+
+    //! Get the number of particles in the frame (on the root rank)
+    unsigned int getNParticles() const
+        {
+        return m_n_particles;
+        }
+
+    //! Read particles first to first + window.size - 1 of the frame (on the root rank)
+    void readParticleWindow(unsigned int first, SnapshotParticleData<float>& window);
+
     //! Helper function to read a quantity from the file
     bool readChunk(void* data,
                    uint64_t frame,
@@ -92,6 +126,8 @@ class PYBIND11_EXPORT GSDReader
     uint64_t m_frame;                                          //!< Cached frame
     std::shared_ptr<SnapshotSystemData<float>> m_snapshot;     //!< The snapshot to read
     gsd_handle m_handle;                                       //!< Handle to the file
+    unsigned int m_stream_window;                              //!< Particles read at once
+    unsigned int m_n_particles = 0;                            //!< Particles in the frame
 
     //! Helper function to read a type list from the file
     std::vector<std::string> readTypes(uint64_t frame, const char* name);
@@ -100,6 +136,26 @@ class PYBIND11_EXPORT GSDReader
     void readHeader();
     void readParticles();
     void readTopology();
+
+    //! Read rows of a per-particle quantity from the file
+    bool readChunkRows(void* data,
+                       const char* name,
+                       size_t row_size,
+                       uint64_t first,
+                       uint64_t count);
+
+    //! Read the particles from the shard files written in distributed mode
+    void readShards(unsigned int n_shards);
+
+    //! Open a shard file and validate it
+    void openShard(gsd_handle& handle, const std::string& fname);
+
+    //! Read a quantity from the current frame of a shard file
+    bool readShardChunk(gsd_handle& handle,
+                        const std::string& fname,
+                        void* data,
+                        const char* name,
+                        size_t expected_size);
     };
 
 /** Read state information from a GSD file
@@ -5,6 +5,7 @@
 #include "GetarDumpIterators.h"
 #include "ParticleData.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <iostream>
 
@@ -252,6 +253,124 @@ string makeTypeList(const vector<string>& names)
     return result.str();
     }
 
+// return true if a description is a per-particle property that can be
+// written from the local particle data in per-rank mode
+bool isLocalProperty(const GetarDumpDescription& desc)
+    {
+    if (desc.m_res != Individual)
+        return false;
+
+    switch (desc.m_prop)
+        {
+    case AngularMomentum:
+    case Body:
+    case Charge:
+    case Diameter:
+    case Image:
+    case Mass:
+    case MomentInertia:
+    case Orientation:
+    case Position:
+    case PotentialEnergy:
+    case Type:
+    case Velocity:
+    case Virial:
+        return true;
+    default:
+        return false;
+        }
+    }
+
+// write a vector of values as type T
+template<typename T, typename V>
+void writeVector(GetarFrame& writer, const string& path, vector<V>& values, CompressMode mode)
+    {
+    writer.writeIndividual<typename vector<V>::iterator, T>(path,
+                                                            values.begin(),
+                                                            values.end(),
+                                                            mode);
+    }
+
+GetarBackgroundWriter::GetarBackgroundWriter(std::shared_ptr<GTAR> archive, unsigned int maxQueued)
+    : m_archive(archive), m_maxQueued(max(maxQueued, (unsigned int)1)), m_queue(), m_busy(false),
+      m_stop(false), m_error()
+    {
+    m_thread = std::thread(&GetarBackgroundWriter::run, this);
+    }
+
+GetarBackgroundWriter::~GetarBackgroundWriter()
+    {
+        {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        }
+    m_cond.notify_all();
+    m_thread.join();
+    }
+
+void GetarBackgroundWriter::enqueue(std::shared_ptr<GetarFrame> frame)
+    {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cond.wait(lock, [this] { return m_queue.size() < m_maxQueued || m_error; });
+    checkError();
+    m_queue.push_back(frame);
+    lock.unlock();
+    m_cond.notify_all();
+    }
+
+void GetarBackgroundWriter::flush()
+    {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cond.wait(lock, [this] { return (m_queue.empty() && !m_busy) || m_error; });
+    checkError();
+    }
+
+// the caller must hold m_mutex
+void GetarBackgroundWriter::checkError()
+    {
+    if (m_error)
+        {
+        std::exception_ptr error(m_error);
+        m_error = nullptr;
+        std::rethrow_exception(error);
+        }
+    }
+
+void GetarBackgroundWriter::run()
+    {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+        {
+        m_cond.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+
+        // stop only after all queued frames are written
+        if (m_queue.empty())
+            return;
+
+        std::shared_ptr<GetarFrame> frame(m_queue.front());
+        m_queue.pop_front();
+        m_busy = true;
+        lock.unlock();
+        m_cond.notify_all();
+
+        std::exception_ptr error;
+        try
+            {
+            frame->writeTo(*m_archive);
+            }
+        catch (...)
+            {
+            error = std::current_exception();
+            }
+
+        lock.lock();
+        if (error)
+            m_error = error;
+        m_busy = false;
+        m_cond.notify_all();
+        }
+    }
+
 NeedSnapshots::NeedSnapshots()
     {
     for (unsigned int i(0); i < 9; ++i)
@@ -289,49 +408,109 @@ const bool& NeedSnapshots::operator[](NeedSnapshotIdx index) const
     return needs[(unsigned int)index];
     }
 
+// insert a tag before the extension of a file name
+string insertBeforeExtension(const string& filename, const string& tag)
+    {
+    const size_t dot(filename.find_last_of("."));
+    if (dot != std::string::npos)
+        return filename.substr(0, dot) + "." + tag + filename.substr(dot);
+    else
+        return filename + "." + tag;
+    }
+
 GetarDumpWriter::GetarDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
                                  const std::string& filename,
                                  GetarDumpMode operationMode,
-                                 unsigned int offset)
-    : Analyzer(sysdef), m_archive(), m_periods(), m_offset(offset), m_staticRecords(),
+                                 unsigned int offset,
+                                 bool background,
+                                 bool perRank)
+    : Analyzer(sysdef), m_archive(), m_backgroundWriter(), m_background(background),
+      m_perRank(perRank), m_periods(), m_offset(offset), m_staticRecords(),
       m_operationMode(operationMode), m_filename(filename), m_tempName(), m_systemSnap(),
       m_neededSnapshots()
     {
     if (m_operationMode == getardump::OneShot)
         {
-        const size_t dot(m_filename.find_last_of("."));
-        if (dot != std::string::npos)
+        if (m_perRank)
             {
-            const string base(m_filename.substr(0, dot));
-            const string suffix(m_filename.substr(dot));
-            m_tempName = base + ".getardump_temp" + suffix;
-            }
-        else
-            {
-            m_tempName = m_filename + ".getardump_temp";
+            string msg("Per-rank getar archives are not supported in one-shot mode");
+            m_exec_conf->msg->error() << msg << endl;
+            throw runtime_error(msg);
             }
+
+        m_tempName = insertBeforeExtension(m_filename, "getardump_temp");
         }
     else
         {
         OpenMode openMode(operationMode == getardump::Append ? gtar::Append : gtar::Write);
+        if (m_perRank)
+            {
+            // every rank writes its own archive
+            std::ostringstream rank;
+            rank << m_exec_conf->getRank();
+            m_archive.reset(new GTAR(insertBeforeExtension(filename, rank.str()), openMode));
+            }
+        else
+            {
 #ifdef ENABLE_MPI
-        // only open archive on root processor
-        if (m_exec_conf->isRoot())
+            // only open archive on root processor
+            if (m_exec_conf->isRoot())
 #endif
-            m_archive.reset(new GTAR(filename, openMode));
+                m_archive.reset(new GTAR(filename, openMode));
+            }
+
+        if (m_archive && m_background)
+            m_backgroundWriter.reset(new GetarBackgroundWriter(m_archive));
+        }
+
+    if (m_perRank && m_exec_conf->isRoot())
+        {
+        // merge index: the archives that hold the particles of each rank
+        std::ostringstream index;
+        index << "{\"num_ranks\": " << m_exec_conf->getNRanks() << ", \"files\": [";
+        for (unsigned int rank(0); rank < m_exec_conf->getNRanks(); ++rank)
+            {
+            std::ostringstream rankStr;
+            rankStr << rank;
+            index << (rank ? ", " : "") << "\"" << insertBeforeExtension(filename, rankStr.str())
+                  << "\"";
+            }
+        index << "]}";
+
+        std::shared_ptr<GetarFrame> frame(new GetarFrame());
+        frame->writeString("getar_ranks.json", index.str(), gtar::FastCompress);
+        commit(frame);
         }
 
     m_systemSnap = takeSystemSnapshot(m_sysdef);
     }
 
-GetarDumpWriter::~GetarDumpWriter() { }
+GetarDumpWriter::~GetarDumpWriter()
+    {
+    // write the queued frames before the archive closes
+    m_backgroundWriter.reset();
+    }
 
 void GetarDumpWriter::close()
     {
+    if (m_backgroundWriter)
+        {
+        m_backgroundWriter->flush();
+        m_backgroundWriter.reset();
+        }
+
     if (m_archive)
         m_archive->close();
     }
 
+void GetarDumpWriter::commit(std::shared_ptr<GetarFrame> frame)
+    {
+    if (m_backgroundWriter)
+        m_backgroundWriter->enqueue(frame);
+    else if (m_archive)
+        frame->writeTo(*m_archive);
+    }
+
 void GetarDumpWriter::analyze(uint64_t timestep)
     {
     Analyzer::analyze(timestep);
@@ -350,6 +529,54 @@ void GetarDumpWriter::analyze(uint64_t timestep)
             }
         }
 
+    if (m_perRank)
+        {
+        // per-particle properties come from the local particle data, only the global records
+        // need the (collective) system snapshot
+        bool needGlobal(false);
+        for (PeriodMap::iterator pIter(m_periods.begin()); pIter != m_periods.end(); ++pIter)
+            if (!(shiftedTimestep % pIter->first))
+                for (vector<GetarDumpDescription>::iterator dIter(pIter->second.begin());
+                     dIter != pIter->second.end();
+                     ++dIter)
+                    needGlobal |= !isLocalProperty(*dIter) && dIter->m_prop != Box;
+
+        if (needGlobal)
+            m_systemSnap = takeSystemSnapshot(m_sysdef);
+
+        std::shared_ptr<GetarFrame> frame(new GetarFrame());
+        bool wroteLocal(false);
+        for (PeriodMap::iterator pIter(m_periods.begin()); pIter != m_periods.end(); ++pIter)
+            {
+            if (shiftedTimestep % pIter->first)
+                continue;
+
+            for (vector<GetarDumpDescription>::iterator dIter(pIter->second.begin());
+                 dIter != pIter->second.end();
+                 ++dIter)
+                {
+                if (isLocalProperty(*dIter))
+                    {
+                    writeLocal(*frame, *dIter, timestep);
+                    wroteLocal = true;
+                    }
+                else if (m_exec_conf->isRoot())
+                    write(*frame, *dIter, timestep);
+                }
+            }
+
+        if (wroteLocal)
+            {
+            std::ostringstream path;
+            path << "frames/" << timestep << "/tag.u32.ind";
+            writeLocalTags(*frame, path.str());
+            }
+
+        if (!frame->empty())
+            commit(frame);
+        return;
+        }
+
     if (neededSnapshots[NeedSystem])
         m_systemSnap = takeSystemSnapshot(m_sysdef);
 
@@ -369,7 +596,7 @@ void GetarDumpWriter::analyze(uint64_t timestep)
             {
             m_archive.reset(new GTAR(m_tempName, gtar::Write));
                 {
-                GTAR::BulkWriter writer(*m_archive);
+                GetarFrame writer;
 
                 for (PeriodMap::iterator pIter(m_periods.begin()); pIter != m_periods.end();
                      ++pIter)
@@ -393,6 +620,9 @@ void GetarDumpWriter::analyze(uint64_t timestep)
                      iter != m_staticRecords.end();
                      ++iter)
                     write(writer, *iter, 0);
+
+                // one-shot archives are renamed right after writing, so write synchronously
+                writer.writeTo(*m_archive);
                 }
 
             m_archive.reset();
@@ -409,7 +639,8 @@ void GetarDumpWriter::analyze(uint64_t timestep)
         }
     else if (m_archive)
         {
-        GTAR::BulkWriter writer(*m_archive);
+        std::shared_ptr<GetarFrame> frame(new GetarFrame());
+        GetarFrame& writer(*frame);
 
         for (PeriodMap::iterator pIter(m_periods.begin()); pIter != m_periods.end(); ++pIter)
             {
@@ -429,10 +660,13 @@ void GetarDumpWriter::analyze(uint64_t timestep)
                     }
                 }
             }
+
+        if (!frame->empty())
+            commit(frame);
         }
     }
 
-void GetarDumpWriter::write(GTAR::BulkWriter& writer,
+void GetarDumpWriter::write(GetarFrame& writer,
                             const GetarDumpDescription& desc,
                             uint64_t timestep)
     {
@@ -447,7 +681,7 @@ void GetarDumpWriter::write(GTAR::BulkWriter& writer,
         writeUniform(writer, desc, timestep);
     }
 
-void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
+void GetarDumpWriter::writeIndividual(GetarFrame& writer,
                                       const GetarDumpDescription& desc,
                                       uint64_t timestep)
     {
@@ -783,7 +1017,7 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     }
 
-void GetarDumpWriter::writeUniform(GTAR::BulkWriter& writer,
+void GetarDumpWriter::writeUniform(GetarFrame& writer,
                                    const GetarDumpDescription& desc,
                                    uint64_t timestep)
     {
@@ -831,7 +1065,7 @@ void GetarDumpWriter::writeUniform(GTAR::BulkWriter& writer,
         }
     }
 
-void GetarDumpWriter::writeText(GTAR::BulkWriter& writer,
+void GetarDumpWriter::writeText(GetarFrame& writer,
                                 const GetarDumpDescription& desc,
                                 uint64_t timestep)
     {
@@ -873,6 +1107,209 @@ void GetarDumpWriter::writeText(GTAR::BulkWriter& writer,
         }
     }
 
+void GetarDumpWriter::writeLocal(GetarFrame& writer,
+                                 const GetarDumpDescription& desc,
+                                 uint64_t timestep)
+    {
+    const unsigned int N(m_pdata->getN());
+    const string path(desc.getFormattedPath(timestep));
+
+    if (desc.m_prop == Position || desc.m_prop == Image)
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        const BoxDim& globalBox(m_pdata->getGlobalBox());
+        const Scalar3 origin(m_pdata->getOrigin());
+        const int3 originImage(m_pdata->getOriginImage());
+
+        // shift and wrap into the global box, as in the snapshot
+        vector<vec3<Scalar>> pos(N);
+        vector<int3> image(N);
+        for (unsigned int i(0); i < N; ++i)
+            {
+            Scalar3 p(make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z) - origin);
+            int3 img(h_image.data[i]);
+            img.x -= originImage.x;
+            img.y -= originImage.y;
+            img.z -= originImage.z;
+            globalBox.wrap(p, img);
+            pos[i] = vec3<Scalar>(p);
+            image[i] = img;
+            }
+
+        if (desc.m_prop == Image)
+            {
+            typedef Int3xyzIterator<vector<int3>::iterator> iter_t;
+            writer.writeIndividual<iter_t, int32_t>(path,
+                                                    iter_t(image.begin()),
+                                                    iter_t(image.end()),
+                                                    desc.m_compression);
+            }
+        else if (desc.m_highPrecision == false)
+            {
+            typedef Scalar3xyzIterator<float, vector<vec3<Scalar>>::iterator> iter_t;
+            writer.writeIndividual<iter_t, float>(path,
+                                                  iter_t(pos.begin()),
+                                                  iter_t(pos.end()),
+                                                  desc.m_compression);
+            }
+        else
+            {
+            typedef Scalar3xyzIterator<double, vector<vec3<Scalar>>::iterator> iter_t;
+            writer.writeIndividual<iter_t, double>(path,
+                                                   iter_t(pos.begin()),
+                                                   iter_t(pos.end()),
+                                                   desc.m_compression);
+            }
+        }
+    else if (desc.m_prop == Type)
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        vector<unsigned int> type(N);
+        for (unsigned int i(0); i < N; ++i)
+            type[i] = __scalar_as_int(h_pos.data[i].w);
+        writeVector<uint32_t>(writer, path, type, desc.m_compression);
+        }
+    else if (desc.m_prop == Velocity || desc.m_prop == Mass)
+        {
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        if (desc.m_prop == Mass)
+            {
+            vector<Scalar> mass(N);
+            for (unsigned int i(0); i < N; ++i)
+                mass[i] = h_vel.data[i].w;
+            writeVector<float>(writer, path, mass, desc.m_compression);
+            }
+        else
+            {
+            vector<vec3<Scalar>> vel(N);
+            for (unsigned int i(0); i < N; ++i)
+                vel[i] = vec3<Scalar>(h_vel.data[i].x, h_vel.data[i].y, h_vel.data[i].z);
+
+            if (desc.m_highPrecision == false)
+                {
+                typedef Scalar3xyzIterator<float, vector<vec3<Scalar>>::iterator> iter_t;
+                writer.writeIndividual<iter_t, float>(path,
+                                                      iter_t(vel.begin()),
+                                                      iter_t(vel.end()),
+                                                      desc.m_compression);
+                }
+            else
+                {
+                typedef Scalar3xyzIterator<double, vector<vec3<Scalar>>::iterator> iter_t;
+                writer.writeIndividual<iter_t, double>(path,
+                                                       iter_t(vel.begin()),
+                                                       iter_t(vel.end()),
+                                                       desc.m_compression);
+                }
+            }
+        }
+    else if (desc.m_prop == Charge || desc.m_prop == Diameter)
+        {
+        ArrayHandle<Scalar> h_values(desc.m_prop == Charge ? m_pdata->getCharges()
+                                                           : m_pdata->getDiameters(),
+                                     access_location::host,
+                                     access_mode::read);
+        vector<Scalar> values(h_values.data, h_values.data + N);
+        writeVector<float>(writer, path, values, desc.m_compression);
+        }
+    else if (desc.m_prop == Body)
+        {
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                         access_location::host,
+                                         access_mode::read);
+        vector<unsigned int> body(h_body.data, h_body.data + N);
+        writeVector<int32_t>(writer, path, body, desc.m_compression);
+        }
+    else if (desc.m_prop == Orientation || desc.m_prop == AngularMomentum)
+        {
+        ArrayHandle<Scalar4> h_quat(desc.m_prop == Orientation
+                                        ? m_pdata->getOrientationArray()
+                                        : m_pdata->getAngularMomentumArray(),
+                                    access_location::host,
+                                    access_mode::read);
+        vector<quat<Scalar>> quats(N);
+        for (unsigned int i(0); i < N; ++i)
+            quats[i] = quat<Scalar>(h_quat.data[i]);
+
+        if (desc.m_prop == Orientation && desc.m_highPrecision)
+            {
+            typedef QuatsxyzIterator<double, vector<quat<Scalar>>::iterator> iter_t;
+            writer.writeIndividual<iter_t, double>(path,
+                                                   iter_t(quats.begin()),
+                                                   iter_t(quats.end()),
+                                                   desc.m_compression);
+            }
+        else
+            {
+            typedef QuatsxyzIterator<float, vector<quat<Scalar>>::iterator> iter_t;
+            writer.writeIndividual<iter_t, float>(path,
+                                                  iter_t(quats.begin()),
+                                                  iter_t(quats.end()),
+                                                  desc.m_compression);
+            }
+        }
+    else if (desc.m_prop == MomentInertia)
+        {
+        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                       access_location::host,
+                                       access_mode::read);
+        vector<vec3<Scalar>> inertia(N);
+        for (unsigned int i(0); i < N; ++i)
+            inertia[i] = vec3<Scalar>(h_inertia.data[i]);
+
+        typedef Scalar3xyzIterator<float, vector<vec3<Scalar>>::iterator> iter_t;
+        writer.writeIndividual<iter_t, float>(path,
+                                              iter_t(inertia.begin()),
+                                              iter_t(inertia.end()),
+                                              desc.m_compression);
+        }
+    else if (desc.m_prop == PotentialEnergy)
+        {
+        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(),
+                                         access_location::host,
+                                         access_mode::read);
+        vector<Scalar> energy(N);
+        for (unsigned int i(0); i < N; ++i)
+            energy[i] = h_net_force.data[i].w;
+        writeVector<float>(writer, path, energy, desc.m_compression);
+        }
+    else if (desc.m_prop == Virial)
+        {
+        ArrayHandle<Scalar> h_net_virial(m_pdata->getNetVirial(),
+                                         access_location::host,
+                                         access_mode::read);
+        const size_t virialPitch(m_pdata->getNetVirial().getPitch());
+
+        // Produce elements in the following order: xx, xy, xz, yy, yz, zz
+        vector<Scalar> virial(size_t(N) * 6);
+        for (unsigned int i(0); i < N; ++i)
+            for (unsigned int j(0); j < 6; ++j)
+                virial[size_t(i) * 6 + j] = h_net_virial.data[j * virialPitch + i];
+        writeVector<float>(writer, path, virial, desc.m_compression);
+        }
+    else
+        {
+        string msg("Asked to write a local property we don't know: ");
+        msg += path;
+        m_exec_conf->msg->error() << msg << endl;
+        throw runtime_error(msg);
+        }
+    }
+
+void GetarDumpWriter::writeLocalTags(GetarFrame& writer, const string& path)
+    {
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    vector<unsigned int> tags(h_tag.data, h_tag.data + m_pdata->getN());
+    writeVector<uint32_t>(writer, path, tags, gtar::FastCompress);
+    }
+
 unsigned int GetarDumpWriter::getPeriod() const
     {
     unsigned int result(1);
@@ -906,8 +1343,15 @@ void GetarDumpWriter::setPeriod(Property prop,
         m_staticRecords.push_back(desc);
         if (m_archive)
             {
-            GTAR::BulkWriter writer(*m_archive);
-            write(writer, desc, 0);
+            std::shared_ptr<GetarFrame> frame(new GetarFrame());
+            if (m_perRank && isLocalProperty(desc))
+                {
+                writeLocal(*frame, desc, 0);
+                writeLocalTags(*frame, "tag.u32.ind");
+                }
+            else if (!m_perRank || m_exec_conf->isRoot())
+                write(*frame, desc, 0);
+            commit(frame);
             }
         }
     else if (behavior == Discrete)
@@ -975,7 +1419,11 @@ void GetarDumpWriter::writeStr(const std::string& name,
     // only write on root rank
     if (m_exec_conf->isRoot())
 #endif
-        m_archive->writeString(rec.getPath(), contents, gtar::FastCompress);
+        {
+        std::shared_ptr<GetarFrame> frame(new GetarFrame());
+        frame->writeString(rec.getPath(), contents, gtar::FastCompress);
+        commit(frame);
+        }
     }
 
 void export_GetarDumpWriter(pybind11::module& m)
@@ -986,6 +1434,12 @@ void export_GetarDumpWriter(pybind11::module& m)
                             std::string,
                             getardump::GetarDumpMode,
                             unsigned int>())
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::string,
+                            getardump::GetarDumpMode,
+                            unsigned int,
+                            bool,
+                            bool>())
         .def("close", &GetarDumpWriter::close)
         .def("getPeriod", &GetarDumpWriter::getPeriod)
         .def("setPeriod", &GetarDumpWriter::setPeriod)
@@ -11,8 +11,14 @@
 #include "hoomd/extern/libgetar/src/Record.hpp"
 #include <memory>
 
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <map>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #ifndef __HIPCC__
@@ -220,7 +226,145 @@ class GetarDumpDescription
     std::string m_suffix;
     };
 
+/// Records of one frame, serialized in memory before they are written
+///
+/// GetarFrame provides the writing interface of gtar::GTAR::BulkWriter, so
+/// the same code fills either one. Serializing is cheap compared to
+/// compressing the records, which happens when the frame is written to an
+/// archive with writeTo().
+class GetarFrame
+    {
+    public:
+    /// Serialize a range of values as type T
+    template<typename iter, typename T>
+    void writeIndividual(const std::string& path,
+                         const iter& start,
+                         const iter& end,
+                         gtar::CompressMode mode)
+        {
+        std::vector<T> values;
+        for (iter it(start); it != end; ++it)
+            values.push_back(T(*it));
+        append(path, values.data(), values.size() * sizeof(T), mode);
+        }
+
+    /// Serialize a single value
+    template<typename T> void writeUniform(const std::string& path, const T& value)
+        {
+        append(path, &value, sizeof(T), gtar::NoCompress);
+        }
+
+    /// Serialize a string
+    void writeString(const std::string& path, const std::string& contents, gtar::CompressMode mode)
+        {
+        append(path, contents.data(), contents.size(), mode);
+        }
+
+    /// Test if the frame has no records
+    bool empty() const
+        {
+        return m_records.empty();
+        }
+
+    /// Write (and compress) all records to an archive
+    void writeTo(gtar::GTAR& archive) const
+        {
+        gtar::GTAR::BulkWriter writer(archive);
+        for (const auto& record : m_records)
+            writer.writePtr(record.path, record.data.data(), record.data.size(), record.mode);
+        }
+
+    private:
+    /// One serialized record
+    struct Record
+        {
+        /// Path within the archive
+        std::string path;
+        /// Serialized contents
+        std::vector<char> data;
+        /// Compression to apply when writing
+        gtar::CompressMode mode;
+        };
+
+    /// Add a record
+    void append(const std::string& path, const void* data, size_t size, gtar::CompressMode mode)
+        {
+        Record record;
+        record.path = path;
+        record.data.resize(size);
+        if (size)
+            std::memcpy(record.data.data(), data, size);
+        record.mode = mode;
+        m_records.push_back(std::move(record));
+        }
+
+    /// Serialized records
+    std::vector<Record> m_records;
+    };
+
+/// Writes frames to an archive in a background thread
+///
+/// Compressing large frames takes much longer than serializing them. The
+/// background thread compresses and writes the queued frames in order while
+/// the simulation continues. At most maxQueued frames wait in the queue,
+/// enqueue() blocks when the queue is full. Errors in the background thread
+/// are rethrown by the next call to enqueue() or flush().
+class GetarBackgroundWriter
+    {
+    public:
+    /// Constructor
+    ///
+    /// :param archive: Archive to write to
+    /// :param maxQueued: Maximum number of frames waiting to be written
+    GetarBackgroundWriter(std::shared_ptr<gtar::GTAR> archive, unsigned int maxQueued = 2);
+
+    /// Destructor: writes the queued frames and stops the thread
+    ~GetarBackgroundWriter();
+
+    /// Queue a frame to be written
+    void enqueue(std::shared_ptr<GetarFrame> frame);
+
+    /// Wait until all queued frames are written
+    void flush();
+
+    private:
+    /// Body of the background thread
+    void run();
+
+    /// Rethrow the error of the background thread, if any
+    void checkError();
+
+    /// Archive to write to
+    std::shared_ptr<gtar::GTAR> m_archive;
+    /// Maximum number of queued frames
+    unsigned int m_maxQueued;
+    /// Frames waiting to be written
+    std::deque<std::shared_ptr<GetarFrame>> m_queue;
+    /// true while the background thread writes a frame
+    bool m_busy;
+    /// Set to stop the background thread
+    bool m_stop;
+    /// Error raised in the background thread
+    std::exception_ptr m_error;
+    /// Protects the queue and the flags
+    std::mutex m_mutex;
+    /// Signals changes to the queue and the flags
+    std::condition_variable m_cond;
+    /// The background thread
+    std::thread m_thread;
+    };
+
 /// HOOMD analyzer which periodically dumps a set of properties
+///
+/// By default, a background thread compresses and writes the frames (see
+/// GetarBackgroundWriter). In per-rank mode, every MPI rank writes the
+/// per-particle properties of its local particles to its own archive
+/// ``<base>.<rank><suffix>``, along with their tags (``frames/<step>/tag.u32.ind``)
+/// so that the archives can be merged. The archive of rank 0 also stores the
+/// global records (box, type names, bonded topology) and a merge index
+/// (``getar_ranks.json``) that lists the archives of all ranks. Per-rank mode
+/// skips the gather of the particle data to rank 0 and compresses the frames
+/// on all ranks in parallel.
 class PYBIND11_EXPORT GetarDumpWriter : public Analyzer
     {
     public:
@@ -233,10 +377,14 @@ class PYBIND11_EXPORT GetarDumpWriter : public Analyzer
     /// :param filename: File name to dump to
     /// :param operationMode: Operation mode
     /// :param offset: Timestep offset
+    /// :param background: Compress and write frames in a background thread
+    /// :param perRank: Write one archive per MPI rank
     GetarDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
                     const std::string& filename,
                     GetarDumpMode operationMode,
-                    unsigned int offset = 0);
+                    unsigned int offset = 0,
+                    bool background = true,
+                    bool perRank = false);
 
     /// Destructor: closes the file and finalizes any IO
     ~GetarDumpWriter();
@@ -287,21 +435,29 @@ class PYBIND11_EXPORT GetarDumpWriter : public Analyzer
 
     private:
     /// Write any GetarDumpDescription for the given timestep
-    void write(gtar::GTAR::BulkWriter& writer, const GetarDumpDescription& desc, uint64_t timestep);
+    void write(GetarFrame& writer, const GetarDumpDescription& desc, uint64_t timestep);
     /// Write an individual GetarDumpDescription for the given timestep
-    void writeIndividual(gtar::GTAR::BulkWriter& writer,
-                         const GetarDumpDescription& desc,
-                         uint64_t timestep);
+    void writeIndividual(GetarFrame& writer, const GetarDumpDescription& desc, uint64_t timestep);
     /// Write a uniform GetarDumpDescription for the given timestep
-    void writeUniform(gtar::GTAR::BulkWriter& writer,
-                      const GetarDumpDescription& desc,
-                      uint64_t timestep);
+    void writeUniform(GetarFrame& writer, const GetarDumpDescription& desc, uint64_t timestep);
     /// Write a text GetarDumpDescription for the given timestep
-    void
-    writeText(gtar::GTAR::BulkWriter& writer, const GetarDumpDescription& desc, uint64_t timestep);
+    void writeText(GetarFrame& writer, const GetarDumpDescription& desc, uint64_t timestep);
+    /// Write a per-particle property of the local particles for the given timestep
+    void writeLocal(GetarFrame& writer, const GetarDumpDescription& desc, uint64_t timestep);
+    /// Write the tags of the local particles to the given path
+    void writeLocalTags(GetarFrame& writer, const std::string& path);
+
+    /// Write a frame to the archive, in the background if enabled
+    void commit(std::shared_ptr<GetarFrame> frame);
 
     /// File archive interface
     std::shared_ptr<gtar::GTAR> m_archive;
+    /// Background writer (null when writing synchronously)
+    std::unique_ptr<GetarBackgroundWriter> m_backgroundWriter;
+    /// true to compress and write frames in a background thread
+    bool m_background;
+    /// true to write one archive per MPI rank
+    bool m_perRank;
     /// Stored properties to dump
     PeriodMap m_periods;
     /// Timestep offset
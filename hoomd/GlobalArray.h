@@ -29,6 +29,8 @@
 #pragma once
 
 #ifdef ENABLE_HIP
+#include "CachedAllocator.h"
+#include "GPUPartition.cuh"
 #include <hip/hip_runtime.h>
 #endif
 
@@ -46,15 +48,28 @@
 #include <unistd.h>
 #include <vector>
 
-#define TAG_ALLOCATION(array)              \
-        {                                  \
-        array.setTag(std::string(#array)); \
+#define TAG_ALLOCATION(array)                                           \
+        {                                                               \
+        array.setTag(hoomd::detail::allocation_tag(__FILE__, #array)); \
         }
 
 namespace hoomd
     {
 namespace detail
     {
+//! Build the tag of an array from the source file that tags it and the name of the array
+/*! \param file Path of the source file
+    \param array Name of the array
+    \returns "Subsystem::array", where Subsystem is the file name without directory and extension
+*/
+inline std::string allocation_tag(const char* file, const char* array)
+    {
+    std::string subsystem(file);
+    subsystem = subsystem.substr(subsystem.find_last_of("/\\") + 1);
+    subsystem = subsystem.substr(0, subsystem.find('.'));
+    return subsystem + "::" + array;
+    }
+
 #ifdef __GNUC__
 #define GCC_VERSION (__GNUC__ * 10000 + __GNUC_MINOR__ * 100 + __GNUC_PATCHLEVEL__)
 /* Test for GCC < 5.0 */
@@ -144,8 +159,8 @@ template<class T> class managed_deleter
             oss << std::endl;
             this->m_exec_conf->msg->notice(10) << oss.str();
 
-            hipFree(m_allocation_ptr);
-            CHECK_CUDA_ERROR();
+            // return the block to the pool
+            m_exec_conf->getCachedAllocatorManaged().deallocate((char*)m_allocation_ptr);
             }
         else
 #endif
@@ -176,36 +191,6 @@ template<class T> class managed_deleter
     std::string m_tag;                                         //!< Name of the array
     };
 
-#ifdef ENABLE_HIP
-class event_deleter
-    {
-    public:
-    //! Default constructor
-    event_deleter() { }
-
-    //! Constructor with execution configuration
-    /*! \param exec_conf The execution configuration (needed for CHECK_CUDA_ERROR)
-     */
-    event_deleter(std::shared_ptr<const ExecutionConfiguration> exec_conf) : m_exec_conf(exec_conf)
-        {
-        }
-
-    //! Destroy the event and free the memory location
-    /*! \param ptr Start of memory area
-     */
-    void operator()(hipEvent_t* ptr)
-        {
-        hipEventDestroy(*ptr);
-        CHECK_CUDA_ERROR();
-
-        delete ptr;
-        }
-
-    private:
-    std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
-    };
-#endif
-
     } // end namespace detail
 
 //! Forward declarations
@@ -247,7 +232,10 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         {
 #ifndef ALWAYS_USE_MANAGED_MEMORY
         if (!(m_is_managed))
+            {
+            updateAccounting();
             return;
+            }
 #endif
 
         assert(this->m_exec_conf);
@@ -261,10 +249,14 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
 
         if (m_num_elements > 0)
             allocate();
+        updateAccounting();
         }
 
     //! Destructor
-    virtual ~GlobalArray() { }
+    virtual ~GlobalArray()
+        {
+        releaseAccounting();
+        }
 
     //! Copy constructor
     GlobalArray(const GlobalArray& from) noexcept
@@ -295,6 +287,7 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
 
             std::copy(from.m_data.get(), from.m_data.get() + from.m_num_elements, m_data.get());
             }
+        updateAccounting();
         }
 
     //! = operator
@@ -337,6 +330,7 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
                 {
                 m_data.reset();
                 }
+            updateAccounting();
             }
 
         return *this;
@@ -351,12 +345,17 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
           m_data(std::move(other.m_data)), m_num_elements(std::move(other.m_num_elements)),
           m_pitch(std::move(other.m_pitch)), m_height(std::move(other.m_height)),
           m_acquired(std::move(other.m_acquired)), m_tag(std::move(other.m_tag)),
-          m_align_bytes(std::move(other.m_align_bytes)), m_is_managed(std::move(other.m_is_managed))
+          m_align_bytes(std::move(other.m_align_bytes)),
+          m_is_managed(std::move(other.m_is_managed)),
+          m_accounted_tag(std::move(other.m_accounted_tag)),
+          m_accounted_bytes(other.m_accounted_bytes)
 #ifdef ENABLE_HIP
           ,
           m_event(std::move(other.m_event))
 #endif
         {
+        // the allocation is now counted by this array
+        other.m_accounted_bytes = 0;
         }
 
     //! Move assignment operator
@@ -365,6 +364,9 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         // call base clas method
         if (&other != this)
             {
+            // the current allocation is freed
+            releaseAccounting();
+
             m_exec_conf = std::move(other.m_exec_conf);
 #ifndef ALWAYS_USE_MANAGED_MEMORY
             m_fallback = std::move(other.m_fallback);
@@ -377,6 +379,9 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
             m_tag = std::move(other.m_tag);
             m_align_bytes = std::move(other.m_align_bytes);
             m_is_managed = std::move(other.m_is_managed);
+            m_accounted_tag = std::move(other.m_accounted_tag);
+            m_accounted_bytes = other.m_accounted_bytes;
+            other.m_accounted_bytes = 0;
 #ifdef ENABLE_HIP
             m_event = std::move(other.m_event);
 #endif
@@ -409,7 +414,10 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         {
 #ifndef ALWAYS_USE_MANAGED_MEMORY
         if (!m_is_managed)
+            {
+            updateAccounting();
             return;
+            }
 #endif
 
         // make m_pitch the next multiple of 16 larger or equal to the given width
@@ -427,6 +435,7 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
 
         if (m_num_elements > 0)
             allocate();
+        updateAccounting();
         }
 
     //! Swap the pointers of two GlobalArrays
@@ -445,6 +454,8 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         std::swap(m_tag, from.m_tag);
         std::swap(m_align_bytes, from.m_align_bytes);
         std::swap(m_is_managed, from.m_is_managed);
+        std::swap(m_accounted_tag, from.m_accounted_tag);
+        std::swap(m_accounted_bytes, from.m_accounted_bytes);
 #ifdef ENABLE_HIP
         std::swap(m_event, from.m_event);
 #endif
@@ -536,6 +547,7 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         if (!this->m_exec_conf || !m_is_managed)
             {
             m_fallback.resize(num_elements);
+            updateAccounting();
             this->outputRepresentation();
             return;
             }
@@ -576,6 +588,7 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         m_pitch = m_num_elements;
         m_height = 1;
 
+        updateAccounting();
         outputRepresentation();
         }
 
@@ -588,6 +601,7 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         if (!m_is_managed)
             {
             m_fallback.resize(width, height);
+            updateAccounting();
             outputRepresentation();
             return;
             }
@@ -635,6 +649,7 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
 
         m_height = height;
         m_pitch = pitch;
+        updateAccounting();
         outputRepresentation();
         }
 
@@ -654,10 +669,89 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         if (!isNull() && m_data)
             m_data.get_deleter().setTag(tag);
 
+        // count the allocation under the new tag
+        updateAccounting();
+
         // for debugging
         this->outputRepresentation();
         }
 
+#ifdef ENABLE_HIP
+    //! Migrate the elements owned by each GPU to that GPU
+    /*! \param gpu_partition Range of elements owned by each active GPU
+        \param set_preferred_location Also set the preferred location of each range to its GPU
+
+        Call this after the array is reallocated (with \a set_preferred_location) and after the
+        elements are reordered, so that the kernels do not fault on pages that another GPU touched
+        last. The partition applies to every row of 2D arrays. This has no effect unless the array
+        is in managed memory and all GPUs support concurrent managed access.
+    */
+    inline void prefetchPartition(const GPUPartition& gpu_partition,
+                                  bool set_preferred_location) const
+        {
+#ifdef __HIP_PLATFORM_NVCC__
+        if (!this->m_exec_conf || !m_is_managed || isNull()
+            || !this->m_exec_conf->allConcurrentManagedAccess())
+            return;
+
+        auto gpu_map = this->m_exec_conf->getGPUIds();
+        for (unsigned int idev = 0; idev < gpu_partition.getNumActiveGPUs(); ++idev)
+            {
+            auto range = gpu_partition.getRange(idev);
+            size_t nelem = range.second - range.first;
+
+            if (!nelem)
+                continue;
+
+            for (size_t row = 0; row < m_height; ++row)
+                {
+                T* ptr = m_data.get() + row * m_pitch + range.first;
+                if (set_preferred_location)
+                    cudaMemAdvise(ptr,
+                                  sizeof(T) * nelem,
+                                  cudaMemAdviseSetPreferredLocation,
+                                  gpu_map[idev]);
+                cudaMemPrefetchAsync(ptr, sizeof(T) * nelem, gpu_map[idev]);
+                }
+            }
+        CHECK_CUDA_ERROR();
+#endif
+        }
+
+    //! Start an asynchronous copy of the device data to the host
+    /*! \param stream Stream to queue the copy on
+
+        Arrays in zero-copy memory forward to GPUArray::prefetchToHost(). Arrays in managed memory
+        migrate their pages to the host on \a stream when the devices support concurrent managed
+        access.
+    */
+    inline void prefetchToHost(hipStream_t stream = 0) const
+        {
+#ifndef ALWAYS_USE_MANAGED_MEMORY
+        if (!this->m_exec_conf || !m_is_managed)
+            {
+            m_fallback.prefetchToHost(stream);
+            return;
+            }
+#endif
+
+        if (m_acquired)
+            throw std::runtime_error("Cannot prefetch an array in use [" + this->m_tag + "]");
+
+        if (isNull() || !this->m_exec_conf->isCUDAEnabled())
+            return;
+
+#ifdef __HIP_PLATFORM_NVCC__
+        if (this->m_exec_conf->allConcurrentManagedAccess())
+            {
+            cudaMemPrefetchAsync(m_data.get(), sizeof(T) * m_num_elements, cudaCpuDeviceId, stream);
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+#endif
+        }
+#endif
+
     //! Return a string representation of this array
     inline std::string getRepresentation() const
         {
@@ -759,11 +853,38 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
     size_t m_align_bytes; //!< Size of alignment in bytes
     bool m_is_managed;    //!< Whether or not this array is stored using managed memory.
 
+    std::string m_accounted_tag;  //!< Tag the allocation is counted under in the accounting
+    size_t m_accounted_bytes = 0; //!< Size the allocation is counted with in the accounting
+
 #ifdef ENABLE_HIP
     std::unique_ptr<hipEvent_t, hoomd::detail::event_deleter>
         m_event; //! CUDA event for synchronization
 #endif
 
+    //! Count the current size and tag of the allocation in the memory accounting
+    void updateAccounting()
+        {
+        size_t bytes = getNumElements() * sizeof(T);
+        if (this->m_exec_conf)
+            this->m_exec_conf->getMemoryAccounting().update(m_accounted_tag,
+                                                            m_accounted_bytes,
+                                                            m_tag,
+                                                            bytes);
+        m_accounted_tag = m_tag;
+        m_accounted_bytes = bytes;
+        }
+
+    //! Remove the allocation from the memory accounting
+    void releaseAccounting()
+        {
+        if (this->m_exec_conf && m_accounted_bytes)
+            this->m_exec_conf->getMemoryAccounting().update(m_accounted_tag,
+                                                            m_accounted_bytes,
+                                                            std::string(),
+                                                            0);
+        m_accounted_bytes = 0;
+        }
+
     //! Allocate the managed array and construct the items
     void allocate()
         {
@@ -786,8 +907,19 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
             this->m_exec_conf->msg->notice(10)
                 << "Allocating " << allocation_bytes << " bytes of managed memory." << std::endl;
 
-            hipMallocManaged(&ptr, allocation_bytes, hipMemAttachGlobal);
-            CHECK_CUDA_ERROR();
+            // take the block from the pool, reallocations during resizes are usually cache hits
+            ptr = this->m_exec_conf->getCachedAllocatorManaged().allocate(allocation_bytes);
+
+#ifdef __HIP_PLATFORM_NVCC__
+            // a reused block may carry memory hints of its previous owner
+            if (this->m_exec_conf->allConcurrentManagedAccess())
+                {
+                cudaMemAdvise(ptr, allocation_bytes, cudaMemAdviseUnsetReadMostly, 0);
+                cudaMemAdvise(ptr, allocation_bytes, cudaMemAdviseUnsetPreferredLocation, 0);
+                for (auto gpu_id : this->m_exec_conf->getGPUIds())
+                    cudaMemAdvise(ptr, allocation_bytes, cudaMemAdviseUnsetAccessedBy, gpu_id);
+                }
+#endif
 
             allocation_ptr = ptr;
 
@@ -430,6 +430,58 @@ void all_gather_v(const T& in_value, std::vector<T>& out_values, const MPI_Comm
     delete[] rbuf;
     }
 
+//! Wrapper around MPI_Alltoallv for trivially copyable elements
+/*! \param in_values Elements to send, indexed by destination rank
+    \param out_values Elements received, indexed by source rank
+    \param mpi_comm MPI communicator
+*/
+template<typename T>
+void all_to_all_v(const std::vector<std::vector<T>>& in_values,
+                  std::vector<std::vector<T>>& out_values,
+                  const MPI_Comm mpi_comm)
+    {
+    int size;
+    MPI_Comm_size(mpi_comm, &size);
+    assert(in_values.size() == (unsigned int)size);
+
+    std::vector<int> send_counts(size), send_displs(size), recv_counts(size), recv_displs(size);
+    for (int i = 0; i < size; i++)
+        {
+        send_counts[i] = (int)(in_values[i].size() * sizeof(T));
+        send_displs[i] = (i > 0) ? send_displs[i - 1] + send_counts[i - 1] : 0;
+        }
+
+    // exchange the sizes of the buffers
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, mpi_comm);
+
+    unsigned int len = 0;
+    for (int i = 0; i < size; i++)
+        {
+        recv_displs[i] = (i > 0) ? recv_displs[i - 1] + recv_counts[i - 1] : 0;
+        len += recv_counts[i];
+        }
+
+    std::vector<T> send_buf;
+    for (int i = 0; i < size; i++)
+        send_buf.insert(send_buf.end(), in_values[i].begin(), in_values[i].end());
+    std::vector<T> recv_buf(len / sizeof(T));
+
+    MPI_Alltoallv(send_buf.data(),
+                  send_counts.data(),
+                  send_displs.data(),
+                  MPI_BYTE,
+                  recv_buf.data(),
+                  recv_counts.data(),
+                  recv_displs.data(),
+                  MPI_BYTE,
+                  mpi_comm);
+
+    out_values.resize(size);
+    for (int i = 0; i < size; i++)
+        out_values[i].assign(recv_buf.begin() + recv_displs[i] / sizeof(T),
+                             recv_buf.begin() + (recv_displs[i] + recv_counts[i]) / sizeof(T));
+    }
+
 //! Wrapper around MPI_Send that handles any serializable object
 template<typename T> void send(const T& val, const unsigned int dest, const MPI_Comm mpi_comm)
     {
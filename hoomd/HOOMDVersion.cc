@@ -163,6 +163,24 @@ bool BuildInfo::getEnableMPI()
 #endif
     }
 
+bool BuildInfo::getEnableADIOS2()
+    {
+#ifdef ENABLE_ADIOS2
+    return true;
+#else
+    return false;
+#endif
+    }
+
+bool BuildInfo::getEnableTorch()
+    {
+#ifdef ENABLE_TORCH
+    return true;
+#else
+    return false;
+#endif
+    }
+
 std::string BuildInfo::getSourceDir()
     {
     return std::string(HOOMD_SOURCE_DIR);
@@ -16,6 +16,28 @@
 
 namespace hoomd
     {
+#ifdef ENABLE_HIP
+//! Device arrays of the local particles passed to HalfStepHook::updateGPU()
+/*! The pointers are only valid during the call. Ghost particles follow the local particles in the
+    per particle arrays.
+*/
+struct HalfStepHookDeviceData
+    {
+    unsigned int N;            //!< Number of local particles
+    unsigned int n_ghost;      //!< Number of ghost particles
+    BoxDim box;                //!< Local simulation box
+    Scalar4* d_pos;            //!< Positions and types
+    Scalar4* d_vel;            //!< Velocities and masses
+    Scalar3* d_accel;          //!< Accelerations
+    int3* d_image;             //!< Image flags
+    const unsigned int* d_tag; //!< Tags
+    Scalar4* d_net_force;      //!< Net forces and potential energies
+    Scalar* d_net_virial;      //!< Net virials
+    size_t net_virial_pitch;   //!< Pitch of the 2D net virial array
+    Scalar4* d_net_torque;     //!< Net torques
+    };
+#endif
+
 class HalfStepHook
     {
     public:
@@ -25,6 +47,30 @@ class HalfStepHook
     // Synchronize snapshot with external library after computing forces
     virtual void update(uint64_t timestep) = 0;
 
+#ifdef ENABLE_HIP
+    //! Returns true when the hook implements updateGPU()
+    /*! In GPU runs, the integrator calls updateGPU() instead of update() for these hooks.
+     */
+    virtual bool hasGPUUpdate()
+        {
+        return false;
+        }
+
+    //! Synchronize with the external library on the GPU after computing forces
+    /*! \param timestep Time step of the computed forces
+        \param data Device arrays of the particle data
+        \param stream Stream of the integrator
+
+        Work queued on \a stream executes in order with the kernels of the integrator, so the hook
+        does not need to synchronize with the device. The hook must not access the particle data
+        through ArrayHandle during the call, the integrator holds the arrays.
+    */
+    virtual void
+    updateGPU(uint64_t timestep, const HalfStepHookDeviceData& data, hipStream_t stream)
+        {
+        }
+#endif
+
     virtual ~HalfStepHook() {};
     };
 
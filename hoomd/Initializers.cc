@@ -4,10 +4,17 @@
 // Maintainer: joaander
 
 #include "Initializers.h"
+#include "RNGIdentifiers.h"
+#include "RandomNumbers.h"
 #include "SnapshotSystemData.h"
 
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
 #include <stdlib.h>
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <stdexcept>
@@ -15,6 +22,7 @@
 using namespace std;
 
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 /*! \file Initializers.cc
     \brief Defines a few initializers for setting up ParticleData instances
@@ -186,4 +194,501 @@ std::shared_ptr<SnapshotSystemData<Scalar>> RandomInitializer::getSnapshot() con
     return snapshot;
     }
 
+/////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////
+
+namespace
+    {
+//! Get the fractional bounds of the local domain in the global box
+/*! \param decomposition Domain decomposition (may be null)
+    \param lo Lower bound (output)
+    \param hi Upper bound (output)
+    \param periodic Set to true for the dimensions that are not decomposed (output)
+*/
+void getLocalDomainBounds(std::shared_ptr<DomainDecomposition> decomposition,
+                          Scalar3& lo,
+                          Scalar3& hi,
+                          bool periodic[3])
+    {
+    lo = make_scalar3(0, 0, 0);
+    hi = make_scalar3(1, 1, 1);
+    periodic[0] = periodic[1] = periodic[2] = true;
+
+#ifdef ENABLE_MPI
+    if (decomposition)
+        {
+        const Index3D& di = decomposition->getDomainIndexer();
+        uint3 grid_pos = decomposition->getGridPos();
+        decomposition->getDomainBounds(di(grid_pos.x, grid_pos.y, grid_pos.z), lo, hi);
+        periodic[0] = di.getW() == 1;
+        periodic[1] = di.getH() == 1;
+        periodic[2] = di.getD() == 1;
+        }
+#endif
+    }
+
+//! Fill a snapshot with particles at the given positions and types and default properties
+void setPositionsAndTypes(SnapshotParticleData<Scalar>& local,
+                          const std::vector<Scalar3>& pos,
+                          const std::vector<unsigned int>& type)
+    {
+    local.resize((unsigned int)pos.size());
+    for (unsigned int idx = 0; idx < pos.size(); idx++)
+        {
+        local.pos[idx] = vec3<Scalar>(pos[idx]);
+        local.type[idx] = type[idx];
+        }
+    }
+    } // end anonymous namespace
+
+/*! \param num_replicas Number of unit cells along each box vector
+    \param basis_positions Fractional positions of the basis sites in the unit cell
+    \param basis_types Type ids of the basis sites
+*/
+LatticeInitializer::LatticeInitializer(uint3 num_replicas,
+                                       const std::vector<Scalar3>& basis_positions,
+                                       const std::vector<unsigned int>& basis_types)
+    : m_num_replicas(num_replicas), m_basis_positions(basis_positions), m_basis_types(basis_types)
+    {
+    if (num_replicas.x == 0 || num_replicas.y == 0 || num_replicas.z == 0)
+        {
+        throw runtime_error("LatticeInitializer: num_replicas must be positive");
+        }
+    if (basis_positions.size() == 0 || basis_positions.size() != basis_types.size())
+        {
+        throw runtime_error("LatticeInitializer: basis_positions and basis_types must have the "
+                            "same non-zero length");
+        }
+    for (const Scalar3& f : basis_positions)
+        {
+        if (f.x < 0 || f.x >= 1 || f.y < 0 || f.y >= 1 || f.z < 0 || f.z >= 1)
+            {
+            throw runtime_error("LatticeInitializer: basis positions must be in [0,1)");
+            }
+        }
+    }
+
+/*! The sites are numbered by unit cell (x fastest) and then by basis site, so the tags do not
+    depend on the domain decomposition. Each rank visits the unit cells that overlap its domain
+    (plus one cell of margin) and keeps the sites that DomainDecomposition::placeParticle() assigns
+    to it.
+*/
+void LatticeInitializer::generate(const BoxDim& global_box,
+                                  std::shared_ptr<DomainDecomposition> decomposition,
+                                  std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                                  unsigned int n_dimensions,
+                                  SnapshotParticleData<Scalar>& local,
+                                  std::vector<unsigned int>& tag)
+    {
+    std::vector<Scalar3> pos;
+    std::vector<unsigned int> type;
+    if (n_dimensions == 2 && m_num_replicas.z != 1)
+        {
+        throw runtime_error("LatticeInitializer: num_replicas.z must be 1 in 2D");
+        }
+
+    Scalar3 lo, hi;
+    bool periodic[3];
+    getLocalDomainBounds(decomposition, lo, hi, periodic);
+
+    // range of unit cells to visit
+    const unsigned int n[3] = {m_num_replicas.x, m_num_replicas.y, m_num_replicas.z};
+    const Scalar f_lo[3] = {lo.x, lo.y, lo.z};
+    const Scalar f_hi[3] = {hi.x, hi.y, hi.z};
+    unsigned int begin[3], end[3];
+    for (unsigned int d = 0; d < 3; d++)
+        {
+        int b = int(slow::floor(f_lo[d] * Scalar(n[d]))) - 1;
+        int e = int(slow::ceil(f_hi[d] * Scalar(n[d]))) + 1;
+        begin[d] = periodic[d] ? 0 : (unsigned int)std::max(b, 0);
+        end[d] = periodic[d] ? n[d] : std::min((unsigned int)std::max(e, 0), n[d]);
+        }
+
+#ifdef ENABLE_MPI
+    std::unique_ptr<ArrayHandle<unsigned int>> h_cart_ranks;
+    if (decomposition)
+        {
+        h_cart_ranks.reset(new ArrayHandle<unsigned int>(decomposition->getCartRanks(),
+                                                         access_location::host,
+                                                         access_mode::read));
+        }
+#endif
+
+    const unsigned int n_basis = (unsigned int)m_basis_positions.size();
+    for (unsigned int k = begin[2]; k < end[2]; k++)
+        for (unsigned int j = begin[1]; j < end[1]; j++)
+            for (unsigned int i = begin[0]; i < end[0]; i++)
+                for (unsigned int b = 0; b < n_basis; b++)
+                    {
+                    const Scalar3& basis = m_basis_positions[b];
+                    Scalar3 f = make_scalar3((Scalar(i) + basis.x) / Scalar(n[0]),
+                                             (Scalar(j) + basis.y) / Scalar(n[1]),
+                                             (Scalar(k) + basis.z) / Scalar(n[2]));
+                    if (n_dimensions == 2)
+                        {
+                        f.z = Scalar(0.5);
+                        }
+                    Scalar3 p = global_box.makeCoordinates(f);
+
+#ifdef ENABLE_MPI
+                    if (decomposition
+                        && decomposition->placeParticle(global_box, p, h_cart_ranks->data)
+                               != exec_conf->getRank())
+                        {
+                        continue;
+                        }
+#endif
+
+                    pos.push_back(p);
+                    type.push_back(m_basis_types[b]);
+                    tag.push_back(((k * n[1] + j) * n[0] + i) * n_basis + b);
+                    }
+
+    setPositionsAndTypes(local, pos, type);
+    }
+
+/*! \param type_counts Number of particles of each type
+    \param min_dist Minimum distance between particles
+    \param seed Random number seed
+*/
+RandomSequentialInitializer::RandomSequentialInitializer(
+    const std::vector<unsigned int>& type_counts,
+    Scalar min_dist,
+    uint16_t seed)
+    : m_type_counts(type_counts), m_min_dist(min_dist), m_seed(seed)
+    {
+    if (min_dist < 0)
+        {
+        throw runtime_error("RandomSequentialInitializer: min_dist must not be negative");
+        }
+    }
+
+/*! Ranks divide the tags in order of their rank, each taking a number of particles proportional
+    to the volume of its domain. Particle types are assigned by tag in the order of type_counts.
+    The trial positions of a particle are drawn from a random stream seeded by its tag.
+
+    When a rank fails to place a particle after many trials, it reports an error and returns the
+    particles placed so far, so that ParticleData::initializeFromLocal() raises the error on all
+    ranks.
+*/
+void RandomSequentialInitializer::generate(const BoxDim& global_box,
+                                           std::shared_ptr<DomainDecomposition> decomposition,
+                                           std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                                           unsigned int n_dimensions,
+                                           SnapshotParticleData<Scalar>& local,
+                                           std::vector<unsigned int>& tag)
+    {
+    std::vector<Scalar3> pos;
+    std::vector<unsigned int> type;
+    Scalar3 lo, hi;
+    bool periodic[3];
+    getLocalDomainBounds(decomposition, lo, hi, periodic);
+
+    // assign a contiguous range of tags to this rank
+    const unsigned int N = getNGlobal();
+    double volume_frac = double(hi.x - lo.x) * double(hi.y - lo.y);
+    if (n_dimensions == 3)
+        {
+        volume_frac *= double(hi.z - lo.z);
+        }
+    double volume_frac_below = 0;
+    bool last_rank = true;
+
+#ifdef ENABLE_MPI
+    if (decomposition)
+        {
+        MPI_Comm mpi_comm = exec_conf->getMPICommunicator();
+        MPI_Exscan(&volume_frac, &volume_frac_below, 1, MPI_DOUBLE, MPI_SUM, mpi_comm);
+        if (exec_conf->getRank() == 0)
+            {
+            volume_frac_below = 0;
+            }
+        last_rank = exec_conf->getRank() == exec_conf->getNRanks() - 1;
+        }
+#endif
+
+    unsigned int first_tag
+        = std::min(N, (unsigned int)std::llround(double(N) * volume_frac_below));
+    unsigned int end_tag
+        = last_rank ? N
+                    : std::min(N,
+                               (unsigned int)std::llround(double(N)
+                                                          * (volume_frac_below + volume_frac)));
+
+    // keep clear of the domain boundaries on decomposed dimensions
+    Scalar3 npd = global_box.getNearestPlaneDistance();
+    const Scalar npd_d[3] = {npd.x, npd.y, npd.z};
+    Scalar f_lo[3] = {lo.x, lo.y, lo.z};
+    Scalar f_hi[3] = {hi.x, hi.y, hi.z};
+    for (unsigned int d = 0; d < 3; d++)
+        {
+        if (!periodic[d])
+            {
+            Scalar margin = m_min_dist / Scalar(2.0) / npd_d[d];
+            f_lo[d] += margin;
+            f_hi[d] -= margin;
+            if (f_hi[d] <= f_lo[d])
+                {
+                throw runtime_error(
+                    "RandomSequentialInitializer: min_dist is larger than the local domain");
+                }
+            }
+        }
+
+    // cell list over the local domain with cells no smaller than min_dist
+    unsigned int n_cell[3];
+    for (unsigned int d = 0; d < 3; d++)
+        {
+        n_cell[d] = 1;
+        if (m_min_dist > Scalar(0.0) && !(d == 2 && n_dimensions == 2))
+            {
+            Scalar width = (f_hi[d] - f_lo[d]) * npd_d[d] / m_min_dist;
+            n_cell[d] = std::max(1u, std::min(1024u, (unsigned int)width));
+            }
+        }
+    Index3D cell_indexer(n_cell[0], n_cell[1], n_cell[2]);
+    std::vector<std::vector<unsigned int>> cells(cell_indexer.getNumElements());
+
+    const unsigned int max_trials = 10000;
+    const Scalar min_dist_sq = m_min_dist * m_min_dist;
+    pos.reserve(end_tag - first_tag);
+
+    for (unsigned int cur_tag = first_tag; cur_tag < end_tag; cur_tag++)
+        {
+        hoomd::RandomGenerator rng(
+            hoomd::Seed(hoomd::RNGIdentifier::RandomSequentialInitializer, 0, m_seed),
+            hoomd::Counter(cur_tag));
+
+        bool placed = false;
+        for (unsigned int trial = 0; trial < max_trials && !placed; trial++)
+            {
+            Scalar f[3];
+            int c[3];
+            for (unsigned int d = 0; d < 3; d++)
+                {
+                f[d] = hoomd::UniformDistribution<Scalar>(f_lo[d], f_hi[d])(rng);
+                c[d] = std::min(int(n_cell[d]) - 1,
+                                int((f[d] - f_lo[d]) / (f_hi[d] - f_lo[d]) * Scalar(n_cell[d])));
+                }
+            if (n_dimensions == 2)
+                {
+                f[2] = Scalar(0.5);
+                }
+            Scalar3 p = global_box.makeCoordinates(make_scalar3(f[0], f[1], f[2]));
+
+            // list the distinct neighboring cells along each dimension
+            std::vector<unsigned int> neighbors[3];
+            for (unsigned int d = 0; d < 3; d++)
+                {
+                for (int offset = -1; offset <= 1; offset++)
+                    {
+                    int nc = c[d] + offset;
+                    if (periodic[d])
+                        {
+                        nc = (nc + int(n_cell[d])) % int(n_cell[d]);
+                        }
+                    if (nc >= 0 && nc < int(n_cell[d])
+                        && std::find(neighbors[d].begin(), neighbors[d].end(), nc)
+                               == neighbors[d].end())
+                        {
+                        neighbors[d].push_back(nc);
+                        }
+                    }
+                }
+
+            // check the neighboring cells for overlaps
+            placed = true;
+            for (unsigned int nk : neighbors[2])
+                for (unsigned int nj : neighbors[1])
+                    for (unsigned int ni : neighbors[0])
+                        for (unsigned int other : cells[cell_indexer(ni, nj, nk)])
+                            {
+                            Scalar3 dr = global_box.minImage(p - pos[other]);
+                            if (dot(dr, dr) < min_dist_sq)
+                                {
+                                placed = false;
+                                }
+                            }
+
+            if (placed)
+                {
+                cells[cell_indexer(c[0], c[1], c[2])].push_back((unsigned int)pos.size());
+                pos.push_back(p);
+                }
+            }
+
+        if (!placed)
+            {
+            exec_conf->msg->error() << "RandomSequentialInitializer: Unable to place particle "
+                                    << cur_tag << " after " << max_trials << " trials."
+                                    << std::endl;
+            break;
+            }
+
+        tag.push_back(cur_tag);
+        unsigned int cur_type = 0;
+        unsigned int type_end = m_type_counts.size() ? m_type_counts[0] : 0;
+        while (cur_tag >= type_end && cur_type + 1 < m_type_counts.size())
+            {
+            cur_type++;
+            type_end += m_type_counts[cur_type];
+            }
+        type.push_back(cur_type);
+        }
+
+    setPositionsAndTypes(local, pos, type);
+    }
+
+/*! \param unit Particles in the unit cell, present on every rank
+    \param unit_box Unit cell box
+    \param num_replicas Number of unit cells along each box vector
+*/
+ReplicateInitializer::ReplicateInitializer(std::shared_ptr<const SnapshotParticleData<double>> unit,
+                                           const BoxDim& unit_box,
+                                           uint3 num_replicas)
+    : m_unit(unit), m_unit_box(unit_box), m_num_replicas(num_replicas)
+    {
+    if (num_replicas.x == 0 || num_replicas.y == 0 || num_replicas.z == 0)
+        {
+        throw runtime_error("ReplicateInitializer: num_replicas must be positive");
+        }
+
+    unsigned int n_copies = num_replicas.x * num_replicas.y * num_replicas.z;
+    for (unsigned int i = 0; i < unit->size; ++i)
+        {
+        unsigned int body = unit->body[i];
+        if (body < MIN_FLOPPY && (n_copies - 1) * unit->size + body >= MIN_FLOPPY)
+            {
+            throw runtime_error("Replication would create more distinct rigid bodies than HOOMD "
+                                "supports!");
+            }
+        }
+    }
+
+/*! For each particle in the unit cell, each rank visits the copies that may fall in its domain
+    (plus one copy of margin) and keeps those that DomainDecomposition::placeParticle() assigns to
+    it. Copy (l, m, n) is numbered ((l * ny) + m) * nz + n.
+*/
+void ReplicateInitializer::generate(const BoxDim& global_box,
+                                    std::shared_ptr<DomainDecomposition> decomposition,
+                                    std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                                    unsigned int n_dimensions,
+                                    SnapshotParticleData<Scalar>& local,
+                                    std::vector<unsigned int>& tag)
+    {
+    Scalar3 lo, hi;
+    bool periodic[3];
+    getLocalDomainBounds(decomposition, lo, hi, periodic);
+
+    const int n[3] = {int(m_num_replicas.x), int(m_num_replicas.y), int(m_num_replicas.z)};
+    const Scalar f_lo[3] = {lo.x, lo.y, lo.z};
+    const Scalar f_hi[3] = {hi.x, hi.y, hi.z};
+    const unsigned int old_size = m_unit->size;
+
+#ifdef ENABLE_MPI
+    std::unique_ptr<ArrayHandle<unsigned int>> h_cart_ranks;
+    if (decomposition)
+        {
+        h_cart_ranks.reset(new ArrayHandle<unsigned int>(decomposition->getCartRanks(),
+                                                         access_location::host,
+                                                         access_mode::read));
+        }
+#endif
+
+    local.is_accel_set = m_unit->is_accel_set;
+    for (unsigned int i = 0; i < old_size; ++i)
+        {
+        // unwrap position of particle i in the unit cell using image flags
+        vec3<Scalar> p = m_unit_box.shift(vec3<Scalar>(m_unit->pos[i]), m_unit->image[i]);
+        vec3<Scalar> f = m_unit_box.makeFraction(p);
+        const Scalar f_unit[3] = {f.x, f.y, f.z};
+
+        // copy l is at fraction (f + l) / n of the global box, up to a periodic wrap
+        int begin[3], end[3];
+        for (unsigned int d = 0; d < 3; d++)
+            {
+            begin[d] = 0;
+            end[d] = n[d];
+            if (!periodic[d])
+                {
+                begin[d] = int(slow::floor(f_lo[d] * Scalar(n[d]) - f_unit[d])) - 1;
+                end[d] = std::min(int(slow::ceil(f_hi[d] * Scalar(n[d]) - f_unit[d])) + 2,
+                                  begin[d] + n[d]);
+                }
+            }
+
+        for (int a = begin[0]; a < end[0]; a++)
+            for (int b = begin[1]; b < end[1]; b++)
+                for (int c = begin[2]; c < end[2]; c++)
+                    {
+                    unsigned int l = (unsigned int)(((a % n[0]) + n[0]) % n[0]);
+                    unsigned int m = (unsigned int)(((b % n[1]) + n[1]) % n[1]);
+                    unsigned int nn = (unsigned int)(((c % n[2]) + n[2]) % n[2]);
+                    unsigned int j = (l * n[1] + m) * n[2] + nn;
+
+                    Scalar3 f_new = make_scalar3((f.x + Scalar(l)) / Scalar(n[0]),
+                                                 (f.y + Scalar(m)) / Scalar(n[1]),
+                                                 (f.z + Scalar(nn)) / Scalar(n[2]));
+                    Scalar3 q = global_box.makeCoordinates(f_new);
+
+                    // wrap by multiple box vectors if necessary
+                    int3 img = global_box.getImage(q);
+                    q = global_box.shift(q, make_int3(-img.x, -img.y, -img.z));
+
+                    // rewrap using wrap so that rounding is consistent
+                    global_box.wrap(q, img);
+
+#ifdef ENABLE_MPI
+                    if (decomposition
+                        && decomposition->placeParticle(global_box, q, h_cart_ranks->data)
+                               != exec_conf->getRank())
+                        {
+                        continue;
+                        }
+#endif
+
+                    unsigned int k = local.size;
+                    local.resize(k + 1);
+                    local.pos[k] = vec3<Scalar>(q);
+                    local.image[k] = img;
+                    local.vel[k] = vec3<Scalar>(m_unit->vel[i]);
+                    local.accel[k] = vec3<Scalar>(m_unit->accel[i]);
+                    local.type[k] = m_unit->type[i];
+                    local.mass[k] = Scalar(m_unit->mass[i]);
+                    local.charge[k] = Scalar(m_unit->charge[i]);
+                    local.diameter[k] = Scalar(m_unit->diameter[i]);
+                    local.body[k]
+                        = (m_unit->body[i] != NO_BODY ? j * old_size + m_unit->body[i] : NO_BODY);
+                    local.orientation[k] = quat<Scalar>(m_unit->orientation[i]);
+                    local.angmom[k] = quat<Scalar>(m_unit->angmom[i]);
+                    local.inertia[k] = vec3<Scalar>(m_unit->inertia[i]);
+                    tag.push_back(j * old_size + i);
+                    }
+        }
+    }
+
+namespace detail
+    {
+void export_DistributedInitializers(pybind11::module& m)
+    {
+    pybind11::class_<DistributedInitializer, std::shared_ptr<DistributedInitializer>>(
+        m,
+        "DistributedInitializer")
+        .def("getNGlobal", &DistributedInitializer::getNGlobal);
+
+    pybind11::class_<LatticeInitializer,
+                     DistributedInitializer,
+                     std::shared_ptr<LatticeInitializer>>(m, "LatticeInitializer")
+        .def(pybind11::
+                 init<uint3, const std::vector<Scalar3>&, const std::vector<unsigned int>&>());
+
+    pybind11::class_<RandomSequentialInitializer,
+                     DistributedInitializer,
+                     std::shared_ptr<RandomSequentialInitializer>>(m,
+                                                                   "RandomSequentialInitializer")
+        .def(pybind11::init<const std::vector<unsigned int>&, Scalar, uint16_t>());
+    }
+
+    } // end namespace detail
+
     } // end namespace hoomd
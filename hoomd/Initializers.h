@@ -11,8 +11,11 @@
 #error This header cannot be compiled by nvcc
 #endif
 
+#include "DomainDecomposition.h"
 #include "ParticleData.h"
 
+#include <vector>
+
 #ifndef __INITIALIZERS_H__
 #define __INITIALIZERS_H__
 
@@ -71,6 +74,154 @@ class PYBIND11_EXPORT RandomInitializer
     std::string m_type_name; //!< Name of the particle type created
     };
 
+//! Generates the particles of each rank directly in its own domain
+/*! Snapshot based initialization builds the full system on the root rank and scatters it, which
+    limits the size of the systems that can be created on many ranks. A DistributedInitializer
+    instead generates on every rank only the particles that belong to the local domain, along with
+    their global tags. ParticleData::initializeFromLocal() verifies that the ranks together
+    generated every tag exactly once.
+
+    Every rank must construct the initializer with the same parameters.
+*/
+class PYBIND11_EXPORT DistributedInitializer
+    {
+    public:
+    //! Destructor
+    virtual ~DistributedInitializer() { }
+
+    //! Get the total number of particles generated on all ranks
+    virtual unsigned int getNGlobal() const = 0;
+
+    //! Generate the particles in the local domain
+    /*! \param global_box Global simulation box
+        \param decomposition Domain decomposition (may be null)
+        \param exec_conf Execution configuration
+        \param n_dimensions Number of dimensions of the system
+        \param local Snapshot of the generated particles (output)
+        \param tag Tags of the generated particles (output)
+
+        generate() is called collectively on all ranks.
+    */
+    virtual void generate(const BoxDim& global_box,
+                          std::shared_ptr<DomainDecomposition> decomposition,
+                          std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                          unsigned int n_dimensions,
+                          SnapshotParticleData<Scalar>& local,
+                          std::vector<unsigned int>& tag)
+        = 0;
+    };
+
+//! Places particles on the sites of a lattice that fills the global box
+/*! The global box is divided into num_replicas unit cells along its box vectors. Each unit cell
+    holds one particle per basis site, at the given fractional coordinates within the cell. Each
+    rank loops only over the unit cells that overlap its domain.
+*/
+class PYBIND11_EXPORT LatticeInitializer : public DistributedInitializer
+    {
+    public:
+    //! Set the parameters
+    LatticeInitializer(uint3 num_replicas,
+                       const std::vector<Scalar3>& basis_positions,
+                       const std::vector<unsigned int>& basis_types);
+
+    //! Get the total number of particles generated on all ranks
+    virtual unsigned int getNGlobal() const
+        {
+        return m_num_replicas.x * m_num_replicas.y * m_num_replicas.z
+               * (unsigned int)m_basis_positions.size();
+        }
+
+    //! Generate the particles in the local domain
+    virtual void generate(const BoxDim& global_box,
+                          std::shared_ptr<DomainDecomposition> decomposition,
+                          std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                          unsigned int n_dimensions,
+                          SnapshotParticleData<Scalar>& local,
+                          std::vector<unsigned int>& tag);
+
+    private:
+    uint3 m_num_replicas;                    //!< Number of unit cells along each box vector
+    std::vector<Scalar3> m_basis_positions;  //!< Fractional positions of the basis sites
+    std::vector<unsigned int> m_basis_types; //!< Type ids of the basis sites
+    };
+
+//! Places particles at random in the global box
+/*! Each rank generates a share of the particles proportional to the volume of its domain by random
+    sequential addition, rejecting trial positions closer than min_dist to an already placed
+    particle. On decomposed dimensions, particles keep a distance of min_dist / 2 from the domain
+    boundaries so that particles in neighboring domains never overlap.
+*/
+class PYBIND11_EXPORT RandomSequentialInitializer : public DistributedInitializer
+    {
+    public:
+    //! Set the parameters
+    RandomSequentialInitializer(const std::vector<unsigned int>& type_counts,
+                                Scalar min_dist,
+                                uint16_t seed);
+
+    //! Get the total number of particles generated on all ranks
+    virtual unsigned int getNGlobal() const
+        {
+        unsigned int N = 0;
+        for (unsigned int n : m_type_counts)
+            N += n;
+        return N;
+        }
+
+    //! Generate the particles in the local domain
+    virtual void generate(const BoxDim& global_box,
+                          std::shared_ptr<DomainDecomposition> decomposition,
+                          std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                          unsigned int n_dimensions,
+                          SnapshotParticleData<Scalar>& local,
+                          std::vector<unsigned int>& tag);
+
+    private:
+    std::vector<unsigned int> m_type_counts; //!< Number of particles of each type
+    Scalar m_min_dist;                       //!< Minimum distance between particles
+    uint16_t m_seed;                         //!< Random number seed
+    };
+
+//! Replicates a snapshot of a unit cell to fill the global box
+/*! The global box holds num_replicas copies of the unit cell box along its box vectors. Every rank
+    holds the particles of the unit cell and constructs only the copies that fall in its own
+    domain. The tags, body ids, positions, and images match SnapshotParticleData::replicate().
+*/
+class PYBIND11_EXPORT ReplicateInitializer : public DistributedInitializer
+    {
+    public:
+    //! Set the parameters
+    ReplicateInitializer(std::shared_ptr<const SnapshotParticleData<double>> unit,
+                         const BoxDim& unit_box,
+                         uint3 num_replicas);
+
+    //! Get the total number of particles generated on all ranks
+    virtual unsigned int getNGlobal() const
+        {
+        return m_num_replicas.x * m_num_replicas.y * m_num_replicas.z * m_unit->size;
+        }
+
+    //! Generate the particles in the local domain
+    virtual void generate(const BoxDim& global_box,
+                          std::shared_ptr<DomainDecomposition> decomposition,
+                          std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                          unsigned int n_dimensions,
+                          SnapshotParticleData<Scalar>& local,
+                          std::vector<unsigned int>& tag);
+
+    private:
+    std::shared_ptr<const SnapshotParticleData<double>> m_unit; //!< Particles in the unit cell
+    BoxDim m_unit_box;                                          //!< Unit cell box
+    uint3 m_num_replicas; //!< Number of unit cells along each box vector
+    };
+
+namespace detail
+    {
+//! Exports the distributed initializers to python
+void export_DistributedInitializers(pybind11::module& m);
+
+    } // end namespace detail
+
     } // end namespace hoomd
 
 #endif
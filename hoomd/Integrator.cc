@@ -11,6 +11,8 @@
 #include "Communicator.h"
 #endif
 
+#include <cstring>
+
 #include <pybind11/stl_bind.h>
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<hoomd::ForceConstraint>>);
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<hoomd::ForceCompute>>);
@@ -45,6 +47,19 @@ Integrator::Integrator(std::shared_ptr<SystemDefinition> sysdef, Scalar deltaT)
 
 Integrator::~Integrator()
     {
+#ifdef ENABLE_HIP
+    for (auto stream : m_force_streams)
+        hipStreamDestroy(stream);
+    for (auto event : m_force_stream_events)
+        hipEventDestroy(event);
+#endif
+
+#if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
+    destroyNetForceGraph();
+    if (m_graph_capture_stream)
+        cudaStreamDestroy(m_graph_capture_stream);
+#endif
+
 #ifdef ENABLE_MPI
     // disconnect
     if (m_sysdef->isDomainDecomposed())
@@ -73,6 +88,69 @@ void Integrator::removeHalfStepHook()
     m_half_step_hook.reset();
     }
 
+/** @param timestep Time step of the computed forces
+
+    In GPU runs, hooks with a GPU update receive the device arrays and queue their work on the
+    default stream that the integrator uses, without a host synchronization.
+*/
+void Integrator::callHalfStepHook(uint64_t timestep)
+    {
+    if (!m_half_step_hook)
+        return;
+
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled() && m_half_step_hook->hasGPUUpdate())
+        {
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
+                                     access_location::device,
+                                     access_mode::readwrite);
+        ArrayHandle<int3> d_image(m_pdata->getImages(),
+                                  access_location::device,
+                                  access_mode::readwrite);
+        ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                        access_location::device,
+                                        access_mode::read);
+        ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(),
+                                         access_location::device,
+                                         access_mode::readwrite);
+        ArrayHandle<Scalar> d_net_virial(m_pdata->getNetVirial(),
+                                         access_location::device,
+                                         access_mode::readwrite);
+        ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(),
+                                          access_location::device,
+                                          access_mode::readwrite);
+
+        HalfStepHookDeviceData data;
+        data.N = m_pdata->getN();
+        data.n_ghost = m_pdata->getNGhosts();
+        data.box = m_pdata->getBox();
+        data.d_pos = d_pos.data;
+        data.d_vel = d_vel.data;
+        data.d_accel = d_accel.data;
+        data.d_image = d_image.data;
+        data.d_tag = d_tag.data;
+        data.d_net_force = d_net_force.data;
+        data.d_net_virial = d_net_virial.data;
+        data.net_virial_pitch = m_pdata->getNetVirial().getPitch();
+        data.d_net_torque = d_net_torque.data;
+
+        m_half_step_hook->updateGPU(timestep, data, 0);
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        return;
+        }
+#endif
+
+    m_half_step_hook->update(timestep);
+    }
+
 /** @param deltaT New time step to set
  */
 void Integrator::setDeltaT(Scalar deltaT)
@@ -206,6 +284,126 @@ Scalar Integrator::computeTotalMomentum(uint64_t timestep)
     return Scalar(p_tot);
     }
 
+/** @param timestep Current time step of the simulation
+
+    When a ghost update is still pending, the force computes that overlap it are computed first.
+    They complete the ghost update themselves, after which the remaining forces are computed.
+    The ghost update is always complete on return.
+
+    Forces with a RESPA interval that does not divide \a timestep are not computed.
+*/
+void Integrator::computeForces(uint64_t timestep)
+    {
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed() && m_comm->isGhostUpdatePending())
+        {
+        for (auto& force : m_forces)
+            {
+            if (force->overlapsGhostUpdate() && !force->addsToNetForce()
+                && force->getRespaScale(timestep) != Scalar(0.0))
+                computeForce(force, timestep);
+            }
+
+        // the ghost update writes the particle data that the forces in flight read
+        joinForceStreams();
+        m_comm->finishUpdateGhosts(timestep);
+
+        for (auto& force : m_forces)
+            {
+            if (!force->overlapsGhostUpdate() && !force->addsToNetForce()
+                && force->getRespaScale(timestep) != Scalar(0.0))
+                computeForce(force, timestep);
+            }
+        joinForceStreams();
+        return;
+        }
+#endif
+
+    // forces that add to the net force directly are evaluated in addForcesToNetForce()
+    for (auto& force : m_forces)
+        {
+        if (!force->addsToNetForce() && force->getRespaScale(timestep) != Scalar(0.0))
+            computeForce(force, timestep);
+        }
+    joinForceStreams();
+    }
+
+/** @param force Force to compute
+    @param timestep Current time step of the simulation
+
+    With concurrent forces enabled on a single GPU, forces that write no shared data and that do not
+    depend on the data of the forces in flight launch their kernels on a separate stream. The
+    others wait for the forces in flight and execute on the default stream, so the forces execute
+    as a task graph of their declared data dependencies. The net force summation on the default
+    stream starts after joinForceStreams().
+*/
+void Integrator::computeForce(const std::shared_ptr<ForceCompute>& force, uint64_t timestep)
+    {
+#ifdef ENABLE_HIP
+    if (m_concurrent_forces && m_exec_conf->isCUDAEnabled()
+        && m_exec_conf->getNumActiveGPUs() == 1)
+        {
+        DataDependencies dependencies = force->getDataDependencies();
+        if (dependencies.write != data_dependency::none
+            || dependencies.conflictsWith(m_busy_force_dependencies))
+            {
+            joinForceStreams();
+            force->compute(timestep);
+            return;
+            }
+
+        if (m_n_busy_force_streams == m_force_streams.size())
+            {
+            hipStream_t stream;
+            hipStreamCreate(&stream);
+            m_force_streams.push_back(stream);
+
+            hipEvent_t event;
+            hipEventCreateWithFlags(&event, hipEventDisableTiming);
+            m_force_stream_events.push_back(event);
+            }
+
+        force->setStream(m_force_streams[m_n_busy_force_streams]);
+        force->compute(timestep);
+        force->setStream(0);
+
+        m_n_busy_force_streams++;
+        m_busy_force_dependencies.read |= dependencies.read;
+        m_busy_force_dependencies.write |= dependencies.write;
+        return;
+        }
+#endif
+
+    force->compute(timestep);
+    }
+
+void Integrator::joinForceStreams()
+    {
+#ifdef ENABLE_HIP
+    for (unsigned int i = 0; i < m_n_busy_force_streams; i++)
+        {
+        hipEventRecord(m_force_stream_events[i], m_force_streams[i]);
+        hipStreamWaitEvent(0, m_force_stream_events[i], 0);
+        }
+    m_n_busy_force_streams = 0;
+    m_busy_force_dependencies = DataDependencies(data_dependency::none, data_dependency::none);
+#endif
+    }
+
+/** @param timestep Current time step of the simulation
+
+    Called after the force arrays of the other forces are summed into the net force.
+*/
+void Integrator::addForcesToNetForce(uint64_t timestep)
+    {
+    for (auto& force : m_forces)
+        {
+        Scalar scale = force->getRespaScale(timestep);
+        if (force->addsToNetForce() && scale != Scalar(0.0))
+            force->addToNetForce(timestep, scale);
+        }
+    }
+
 /** @param timestep Current time step of the simulation
     \post All added force computes in \a m_forces are computed and totaled up in \a m_net_force and
    \a m_net_virial \note The summation step is performed <b>on the CPU</b> and will result in a lot
@@ -214,10 +412,7 @@ Scalar Integrator::computeTotalMomentum(uint64_t timestep)
 */
 void Integrator::computeNetForce(uint64_t timestep)
     {
-    for (auto& force : m_forces)
-        {
-        force->compute(timestep);
-        }
+    computeForces(timestep);
 
     if (m_prof)
         {
@@ -259,6 +454,11 @@ void Integrator::computeNetForce(uint64_t timestep)
 
         for (const auto& force : m_forces)
             {
+            // forces with a RESPA interval are applied as an impulse on every k-th step
+            Scalar scale = force->getRespaScale(timestep);
+            if (scale == Scalar(0.0) || force->addsToNetForce())
+                continue;
+
             GlobalArray<Scalar4>& h_force_array = force->getForceArray();
             GlobalArray<Scalar>& h_virial_array = force->getVirialArray();
             GlobalArray<Scalar4>& h_torque_array = force->getTorqueArray();
@@ -274,14 +474,16 @@ void Integrator::computeNetForce(uint64_t timestep)
             size_t virial_pitch = h_virial_array.getPitch();
             for (unsigned int j = 0; j < nparticles; j++)
                 {
-                h_net_force.data[j].x += h_force.data[j].x;
-                h_net_force.data[j].y += h_force.data[j].y;
-                h_net_force.data[j].z += h_force.data[j].z;
+                // the energy and virial are not scaled so that thermodynamic quantities are
+                // correct on the impulse steps
+                h_net_force.data[j].x += scale * h_force.data[j].x;
+                h_net_force.data[j].y += scale * h_force.data[j].y;
+                h_net_force.data[j].z += scale * h_force.data[j].z;
                 h_net_force.data[j].w += h_force.data[j].w;
 
-                h_net_torque.data[j].x += h_torque.data[j].x;
-                h_net_torque.data[j].y += h_torque.data[j].y;
-                h_net_torque.data[j].z += h_torque.data[j].z;
+                h_net_torque.data[j].x += scale * h_torque.data[j].x;
+                h_net_torque.data[j].y += scale * h_torque.data[j].y;
+                h_net_torque.data[j].z += scale * h_torque.data[j].z;
                 h_net_torque.data[j].w += h_torque.data[j].w;
 
                 for (unsigned int k = 0; k < 6; k++)
@@ -300,6 +502,8 @@ void Integrator::computeNetForce(uint64_t timestep)
             }
         }
 
+    addForcesToNetForce(timestep);
+
     for (unsigned int k = 0; k < 6; k++)
         {
         m_pdata->setExternalVirial(k, external_virial[k]);
@@ -423,10 +627,7 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
 
     // compute all the normal forces first
 
-    for (auto& force : m_forces)
-        {
-        force->compute(timestep);
-        }
+    computeForces(timestep);
 
     if (m_prof)
         {
@@ -437,6 +638,14 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
     Scalar external_virial[6];
     Scalar external_energy;
 
+    // forces with a RESPA interval are applied as an impulse on every k-th step
+    std::vector<std::shared_ptr<ForceCompute>> active_forces;
+    for (const auto& force : m_forces)
+        {
+        if (!force->addsToNetForce() && force->getRespaScale(timestep) != Scalar(0.0))
+            active_forces.push_back(force);
+        }
+
         {
         // access the net force and virial arrays
         const GlobalArray<Scalar4>& net_force = m_pdata->getNetForce();
@@ -469,7 +678,7 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         // there is no need to zero out the initial net force and virial here, the first call to the
         // addition kernel will do that ahh!, but we do need to zer out the net force and virial if
         // there are 0 forces!
-        if (m_forces.size() == 0)
+        if (active_forces.size() == 0)
             {
             // start by zeroing the net force and virial arrays
             hipMemset(d_net_force.data, 0, sizeof(Scalar4) * net_force.getNumElements());
@@ -482,20 +691,24 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         // now, add up the accelerations
         // sum all the forces into the net force
         // perform the sum in groups of 6 to avoid kernel launch and memory access overheads
-        for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force += 6)
+        std::vector<kernel::gpu_force_list> force_lists;
+        for (unsigned int cur_force = 0; cur_force < active_forces.size(); cur_force += 6)
             {
             // grab the device pointers for the current set
             kernel::gpu_force_list force_list;
 
-            const GlobalArray<Scalar4>& d_force_array0 = m_forces[cur_force]->getForceArray();
+            const GlobalArray<Scalar4>& d_force_array0
+                = active_forces[cur_force]->getForceArray();
             ArrayHandle<Scalar4> d_force0(d_force_array0,
                                           access_location::device,
                                           access_mode::read);
-            const GlobalArray<Scalar>& d_virial_array0 = m_forces[cur_force]->getVirialArray();
+            const GlobalArray<Scalar>& d_virial_array0
+                = active_forces[cur_force]->getVirialArray();
             ArrayHandle<Scalar> d_virial0(d_virial_array0,
                                           access_location::device,
                                           access_mode::read);
-            const GlobalArray<Scalar4>& d_torque_array0 = m_forces[cur_force]->getTorqueArray();
+            const GlobalArray<Scalar4>& d_torque_array0
+                = active_forces[cur_force]->getTorqueArray();
             ArrayHandle<Scalar4> d_torque0(d_torque_array0,
                                            access_location::device,
                                            access_mode::read);
@@ -503,21 +716,22 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
             force_list.v0 = d_virial0.data;
             force_list.vpitch0 = d_virial_array0.getPitch();
             force_list.t0 = d_torque0.data;
+            force_list.s0 = active_forces[cur_force]->getRespaScale(timestep);
 
-            if (cur_force + 1 < m_forces.size())
+            if (cur_force + 1 < active_forces.size())
                 {
                 const GlobalArray<Scalar4>& d_force_array1
-                    = m_forces[cur_force + 1]->getForceArray();
+                    = active_forces[cur_force + 1]->getForceArray();
                 ArrayHandle<Scalar4> d_force1(d_force_array1,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar>& d_virial_array1
-                    = m_forces[cur_force + 1]->getVirialArray();
+                    = active_forces[cur_force + 1]->getVirialArray();
                 ArrayHandle<Scalar> d_virial1(d_virial_array1,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar4>& d_torque_array1
-                    = m_forces[cur_force + 1]->getTorqueArray();
+                    = active_forces[cur_force + 1]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque1(d_torque_array1,
                                                access_location::device,
                                                access_mode::read);
@@ -525,21 +739,22 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 force_list.v1 = d_virial1.data;
                 force_list.vpitch1 = d_virial_array1.getPitch();
                 force_list.t1 = d_torque1.data;
+                force_list.s1 = active_forces[cur_force + 1]->getRespaScale(timestep);
                 }
-            if (cur_force + 2 < m_forces.size())
+            if (cur_force + 2 < active_forces.size())
                 {
                 const GlobalArray<Scalar4>& d_force_array2
-                    = m_forces[cur_force + 2]->getForceArray();
+                    = active_forces[cur_force + 2]->getForceArray();
                 ArrayHandle<Scalar4> d_force2(d_force_array2,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar>& d_virial_array2
-                    = m_forces[cur_force + 2]->getVirialArray();
+                    = active_forces[cur_force + 2]->getVirialArray();
                 ArrayHandle<Scalar> d_virial2(d_virial_array2,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar4>& d_torque_array2
-                    = m_forces[cur_force + 2]->getTorqueArray();
+                    = active_forces[cur_force + 2]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque2(d_torque_array2,
                                                access_location::device,
                                                access_mode::read);
@@ -547,21 +762,22 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 force_list.v2 = d_virial2.data;
                 force_list.vpitch2 = d_virial_array2.getPitch();
                 force_list.t2 = d_torque2.data;
+                force_list.s2 = active_forces[cur_force + 2]->getRespaScale(timestep);
                 }
-            if (cur_force + 3 < m_forces.size())
+            if (cur_force + 3 < active_forces.size())
                 {
                 const GlobalArray<Scalar4>& d_force_array3
-                    = m_forces[cur_force + 3]->getForceArray();
+                    = active_forces[cur_force + 3]->getForceArray();
                 ArrayHandle<Scalar4> d_force3(d_force_array3,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar>& d_virial_array3
-                    = m_forces[cur_force + 3]->getVirialArray();
+                    = active_forces[cur_force + 3]->getVirialArray();
                 ArrayHandle<Scalar> d_virial3(d_virial_array3,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar4>& d_torque_array3
-                    = m_forces[cur_force + 3]->getTorqueArray();
+                    = active_forces[cur_force + 3]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque3(d_torque_array3,
                                                access_location::device,
                                                access_mode::read);
@@ -569,21 +785,22 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 force_list.v3 = d_virial3.data;
                 force_list.vpitch3 = d_virial_array3.getPitch();
                 force_list.t3 = d_torque3.data;
+                force_list.s3 = active_forces[cur_force + 3]->getRespaScale(timestep);
                 }
-            if (cur_force + 4 < m_forces.size())
+            if (cur_force + 4 < active_forces.size())
                 {
                 const GlobalArray<Scalar4>& d_force_array4
-                    = m_forces[cur_force + 4]->getForceArray();
+                    = active_forces[cur_force + 4]->getForceArray();
                 ArrayHandle<Scalar4> d_force4(d_force_array4,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar>& d_virial_array4
-                    = m_forces[cur_force + 4]->getVirialArray();
+                    = active_forces[cur_force + 4]->getVirialArray();
                 ArrayHandle<Scalar> d_virial4(d_virial_array4,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar4>& d_torque_array4
-                    = m_forces[cur_force + 4]->getTorqueArray();
+                    = active_forces[cur_force + 4]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque4(d_torque_array4,
                                                access_location::device,
                                                access_mode::read);
@@ -591,21 +808,22 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 force_list.v4 = d_virial4.data;
                 force_list.vpitch4 = d_virial_array4.getPitch();
                 force_list.t4 = d_torque4.data;
+                force_list.s4 = active_forces[cur_force + 4]->getRespaScale(timestep);
                 }
-            if (cur_force + 5 < m_forces.size())
+            if (cur_force + 5 < active_forces.size())
                 {
                 const GlobalArray<Scalar4>& d_force_array5
-                    = m_forces[cur_force + 5]->getForceArray();
+                    = active_forces[cur_force + 5]->getForceArray();
                 ArrayHandle<Scalar4> d_force5(d_force_array5,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar>& d_virial_array5
-                    = m_forces[cur_force + 5]->getVirialArray();
+                    = active_forces[cur_force + 5]->getVirialArray();
                 ArrayHandle<Scalar> d_virial5(d_virial_array5,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar4>& d_torque_array5
-                    = m_forces[cur_force + 5]->getTorqueArray();
+                    = active_forces[cur_force + 5]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque5(d_torque_array5,
                                                access_location::device,
                                                access_mode::read);
@@ -613,35 +831,28 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 force_list.v5 = d_virial5.data;
                 force_list.vpitch5 = d_virial_array5.getPitch();
                 force_list.t5 = d_torque5.data;
+                force_list.s5 = active_forces[cur_force + 5]->getRespaScale(timestep);
                 }
 
-            // clear on the first iteration only
-            bool clear = (cur_force == 0);
-
-            // access flags
-            PDataFlags flags = this->m_pdata->getFlags();
-
-            m_exec_conf->beginMultiGPU();
-
-            gpu_integrator_sum_net_force(d_net_force.data,
-                                         d_net_virial.data,
-                                         net_virial_pitch,
-                                         d_net_torque.data,
-                                         force_list,
-                                         nparticles,
-                                         clear,
-                                         flags[pdata_flag::pressure_tensor],
-                                         m_pdata->getGPUPartition());
+            force_lists.push_back(force_list);
+            }
 
-            if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                CHECK_CUDA_ERROR();
+        // access flags
+        PDataFlags flags = this->m_pdata->getFlags();
 
-            m_exec_conf->endMultiGPU();
-            }
+        sumNetForceGPU(d_net_force.data,
+                       d_net_virial.data,
+                       net_virial_pitch,
+                       d_net_torque.data,
+                       force_lists,
+                       nparticles,
+                       flags[pdata_flag::pressure_tensor]);
         }
 
+    addForcesToNetForce(timestep);
+
     // add up external virials and energies
-    for (const auto& force : m_forces)
+    for (const auto& force : active_forces)
         {
         for (unsigned int k = 0; k < 6; k++)
             external_virial[k] += force->getExternalVirial(k);
@@ -887,6 +1098,157 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         m_prof->pop(m_exec_conf);
         }
     }
+
+/*! \param d_net_force Net force to write
+    \param d_net_virial Net virial to write
+    \param net_virial_pitch Pitch of the net virial array
+    \param d_net_torque Net torque to write
+    \param force_lists Force arrays to sum, in groups of up to 6
+    \param nparticles Number of particles (including ghosts) to sum over
+    \param compute_virial True if the virial should be summed
+
+    When m_gpu_graph is set on a single GPU, the kernel launches are captured into a CUDA graph
+    once and replayed on subsequent calls. The graph stores the kernel arguments by value, so it is
+    recaptured whenever any pointer, pitch, scale factor, or particle count changes (e.g. after the
+    arrays are reallocated or the particle number changes). When a capture or replay fails, the
+    graph is disabled and the summation falls back to direct kernel launches.
+*/
+void Integrator::sumNetForceGPU(Scalar4* d_net_force,
+                                Scalar* d_net_virial,
+                                size_t net_virial_pitch,
+                                Scalar4* d_net_torque,
+                                const std::vector<kernel::gpu_force_list>& force_lists,
+                                unsigned int nparticles,
+                                bool compute_virial)
+    {
+    auto launch = [&](hipStream_t stream)
+    {
+        for (unsigned int i = 0; i < force_lists.size(); ++i)
+            {
+            // clear on the first iteration only
+            gpu_integrator_sum_net_force(d_net_force,
+                                         d_net_virial,
+                                         net_virial_pitch,
+                                         d_net_torque,
+                                         force_lists[i],
+                                         nparticles,
+                                         i == 0,
+                                         compute_virial,
+                                         m_pdata->getGPUPartition(),
+                                         stream);
+            }
+    };
+
+#ifdef __HIP_PLATFORM_NVCC__
+    if (m_gpu_graph && m_exec_conf->getNumActiveGPUs() == 1 && !force_lists.empty())
+        {
+        // key on the exact bit patterns, so that e.g. scale factors 0.5 and 0 differ
+        auto bits = [](auto value)
+        {
+            uint64_t b = 0;
+            std::memcpy(&b, &value, sizeof(value));
+            return b;
+        };
+
+        auto range = m_pdata->getGPUPartition().getRange(0);
+        std::vector<uint64_t> key = {bits(d_net_force),
+                                     bits(d_net_virial),
+                                     bits(net_virial_pitch),
+                                     bits(d_net_torque),
+                                     bits(nparticles),
+                                     bits(compute_virial),
+                                     bits(range.first),
+                                     bits(range.second)};
+        for (const auto& l : force_lists)
+            {
+            key.insert(key.end(),
+                       {bits(l.f0),      bits(l.f1),      bits(l.f2),      bits(l.f3),
+                        bits(l.f4),      bits(l.f5),      bits(l.t0),      bits(l.t1),
+                        bits(l.t2),      bits(l.t3),      bits(l.t4),      bits(l.t5),
+                        bits(l.v0),      bits(l.v1),      bits(l.v2),      bits(l.v3),
+                        bits(l.v4),      bits(l.v5),      bits(l.vpitch0), bits(l.vpitch1),
+                        bits(l.vpitch2), bits(l.vpitch3), bits(l.vpitch4), bits(l.vpitch5),
+                        bits(l.s0),      bits(l.s1),      bits(l.s2),      bits(l.s3),
+                        bits(l.s4),      bits(l.s5)});
+            }
+
+        cudaError_t status = cudaSuccess;
+        if (!m_net_force_graph || key != m_net_force_graph_key)
+            {
+            destroyNetForceGraph();
+
+            if (!m_graph_capture_stream)
+                {
+                status = cudaStreamCreateWithFlags(&m_graph_capture_stream, cudaStreamNonBlocking);
+                if (status != cudaSuccess)
+                    m_graph_capture_stream = nullptr;
+                }
+
+            cudaGraph_t graph = nullptr;
+            if (status == cudaSuccess)
+                status = cudaStreamBeginCapture(m_graph_capture_stream,
+                                                cudaStreamCaptureModeThreadLocal);
+            if (status == cudaSuccess)
+                {
+                launch(m_graph_capture_stream);
+                // end the capture even when a launch failed so that the stream is usable again
+                status = cudaStreamEndCapture(m_graph_capture_stream, &graph);
+                }
+            if (status == cudaSuccess)
+                status = cudaGraphInstantiateWithFlags(&m_net_force_graph, graph, 0);
+            if (graph)
+                cudaGraphDestroy(graph);
+
+            if (status == cudaSuccess)
+                {
+                m_net_force_graph_key = key;
+                m_exec_conf->msg->notice(6) << "Captured net force graph with "
+                                            << force_lists.size() << " kernel launches"
+                                            << std::endl;
+                }
+            }
+
+        // replay in the legacy default stream, ordered with the force computes
+        if (status == cudaSuccess)
+            status = cudaGraphLaunch(m_net_force_graph, 0);
+
+        if (status == cudaSuccess)
+            {
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            return;
+            }
+
+        // clear the error and sum with direct launches from now on
+        cudaGetLastError();
+        m_exec_conf->msg->warning()
+            << "Failed to capture or launch the net force graph (" << cudaGetErrorString(status)
+            << "), summing the net force with direct kernel launches." << std::endl;
+        destroyNetForceGraph();
+        m_gpu_graph = false;
+        }
+#endif
+
+    m_exec_conf->beginMultiGPU();
+    launch(0);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    m_exec_conf->endMultiGPU();
+    }
+
+void Integrator::destroyNetForceGraph()
+    {
+#ifdef __HIP_PLATFORM_NVCC__
+    if (m_net_force_graph)
+        {
+        cudaGraphExecDestroy(m_net_force_graph);
+        m_net_force_graph = nullptr;
+        }
+    m_net_force_graph_key.clear();
+#endif
+    }
 #endif
 
 /** The base class integrator actually does nothing in update()
@@ -908,6 +1270,23 @@ void Integrator::update(uint64_t timestep)
         }
     }
 
+/** @param timestep Time step of the first step in the batch
+    @param nsteps Number of steps to take
+
+    System calls updateBatch() for runs of time steps on which no tuner, updater, or analyzer
+    executes and the particle data flags do not change, so the integrator may advance through the
+    whole batch without returning. The base implementation calls update() for each step. Derived
+    classes may override it to avoid per-step host work, for example by replaying captured GPU
+    graphs.
+*/
+void Integrator::updateBatch(uint64_t timestep, uint64_t nsteps)
+    {
+    for (uint64_t i = 0; i < nsteps; i++)
+        {
+        update(timestep + i);
+        }
+    }
+
 /** prepRun() is to be called at the very beginning of each run, before any analyzers are called,
    but after the full simulation is defined. It allows the integrator to perform any one-off setup
    tasks and update net_force and net_virial, if needed.
@@ -995,7 +1374,14 @@ void export_Integrator(pybind11::module& m)
         .def("updateGroupDOF", &Integrator::updateGroupDOF)
         .def_property("dt", &Integrator::getDeltaT, &Integrator::setDeltaT)
         .def_property_readonly("forces", &Integrator::getForces)
-        .def_property_readonly("constraints", &Integrator::getConstraintForces);
+        .def_property_readonly("constraints", &Integrator::getConstraintForces)
+        .def_property("gpu_graph", &Integrator::getGPUGraph, &Integrator::setGPUGraph)
+        .def_property("overlap_ghost_update",
+                      &Integrator::getOverlapGhostUpdate,
+                      &Integrator::setOverlapGhostUpdate)
+        .def_property("concurrent_forces",
+                      &Integrator::getConcurrentForces,
+                      &Integrator::setConcurrentForces);
     }
 
     } // end namespace detail
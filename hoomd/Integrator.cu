@@ -25,6 +25,7 @@ __device__ void add_force_total(Scalar4& net_force,
                                 Scalar* d_v,
                                 const size_t virial_pitch,
                                 Scalar4* d_t,
+                                Scalar scale,
                                 int idx)
     {
     if (d_f != NULL && d_v != NULL && d_t != NULL)
@@ -32,9 +33,10 @@ __device__ void add_force_total(Scalar4& net_force,
         Scalar4 f = d_f[idx];
         Scalar4 t = d_t[idx];
 
-        net_force.x += f.x;
-        net_force.y += f.y;
-        net_force.z += f.z;
+        // scale only the force and torque, the energy and virial are summed as is
+        net_force.x += scale * f.x;
+        net_force.y += scale * f.y;
+        net_force.z += scale * f.z;
         net_force.w += f.w;
 
         if (compute_virial)
@@ -43,9 +45,9 @@ __device__ void add_force_total(Scalar4& net_force,
                 net_virial[i] += d_v[i * virial_pitch + idx];
             }
 
-        net_torque.x += t.x;
-        net_torque.y += t.y;
-        net_torque.z += t.z;
+        net_torque.x += scale * t.x;
+        net_torque.y += scale * t.y;
+        net_torque.z += scale * t.z;
         net_torque.w += t.w;
         }
     }
@@ -117,6 +119,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v0,
                                         force_list.vpitch0,
                                         force_list.t0,
+                                        force_list.s0,
                                         idx);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
@@ -125,6 +128,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v1,
                                         force_list.vpitch1,
                                         force_list.t1,
+                                        force_list.s1,
                                         idx);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
@@ -133,6 +137,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v2,
                                         force_list.vpitch2,
                                         force_list.t2,
+                                        force_list.s2,
                                         idx);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
@@ -141,6 +146,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v3,
                                         force_list.vpitch3,
                                         force_list.t3,
+                                        force_list.s3,
                                         idx);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
@@ -149,6 +155,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v4,
                                         force_list.vpitch4,
                                         force_list.t4,
+                                        force_list.s4,
                                         idx);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
@@ -157,6 +164,7 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v5,
                                         force_list.vpitch5,
                                         force_list.t5,
+                                        force_list.s5,
                                         idx);
 
         // write out the final result
@@ -178,7 +186,8 @@ hipError_t gpu_integrator_sum_net_force(Scalar4* d_net_force,
                                         unsigned int nparticles,
                                         bool clear,
                                         bool compute_virial,
-                                        const GPUPartition& gpu_partition)
+                                        const GPUPartition& gpu_partition,
+                                        hipStream_t stream)
     {
     // sanity check
     assert(d_net_force);
@@ -200,7 +209,7 @@ hipError_t gpu_integrator_sum_net_force(Scalar4* d_net_force,
                                dim3(nwork / block_size + 1),
                                dim3(block_size),
                                0,
-                               0,
+                               stream,
                                d_net_force,
                                d_net_virial,
                                net_virial_pitch,
@@ -216,7 +225,7 @@ hipError_t gpu_integrator_sum_net_force(Scalar4* d_net_force,
                                dim3(nwork / block_size + 1),
                                dim3(block_size),
                                0,
-                               0,
+                               stream,
                                d_net_force,
                                d_net_virial,
                                net_virial_pitch,
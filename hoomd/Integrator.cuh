@@ -30,7 +30,8 @@ struct gpu_force_list
     gpu_force_list()
         : f0(NULL), f1(NULL), f2(NULL), f3(NULL), f4(NULL), f5(NULL), t0(NULL), t1(NULL), t2(NULL),
           t3(NULL), t4(NULL), t5(NULL), v0(NULL), v1(NULL), v2(NULL), v3(NULL), v4(NULL), v5(NULL),
-          vpitch0(0), vpitch1(0), vpitch2(0), vpitch3(0), vpitch4(0), vpitch5(0)
+          vpitch0(0), vpitch1(0), vpitch2(0), vpitch3(0), vpitch4(0), vpitch5(0), s0(1), s1(1),
+          s2(1), s3(1), s4(1), s5(1)
         {
         }
 
@@ -61,6 +62,13 @@ struct gpu_force_list
     size_t vpitch3; //!< Pitch of virial array 3
     size_t vpitch4; //!< Pitch of virial array 4
     size_t vpitch5; //!< Pitch of virial array 5
+
+    Scalar s0; //!< Factor that scales force and torque 0
+    Scalar s1; //!< Factor that scales force and torque 1
+    Scalar s2; //!< Factor that scales force and torque 2
+    Scalar s3; //!< Factor that scales force and torque 3
+    Scalar s4; //!< Factor that scales force and torque 4
+    Scalar s5; //!< Factor that scales force and torque 5
     };
 
 //! Driver for gpu_integrator_sum_net_force_kernel()
@@ -72,7 +80,8 @@ hipError_t gpu_integrator_sum_net_force(Scalar4* d_net_force,
                                         unsigned int nparticles,
                                         bool clear,
                                         bool compute_virial,
-                                        const GPUPartition& gpu_partition);
+                                        const GPUPartition& gpu_partition,
+                                        hipStream_t stream = 0);
 
     } // end namespace kernel
 
@@ -17,6 +17,7 @@
 #include <vector>
 
 #ifdef ENABLE_HIP
+#include "Integrator.cuh"
 #include <hip/hip_runtime.h>
 #endif
 
@@ -69,6 +70,9 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// Take one timestep forward
     virtual void update(uint64_t timestep);
 
+    /// Take several timesteps forward
+    virtual void updateBatch(uint64_t timestep, uint64_t nsteps);
+
     /// Get the list of force computes
     std::vector<std::shared_ptr<ForceCompute>>& getForces()
         {
@@ -130,6 +134,46 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// Prepare for the run
     virtual void prepRun(uint64_t timestep);
 
+    /// Set whether the net force summation is replayed from a captured GPU graph
+    void setGPUGraph(bool gpu_graph)
+        {
+        m_gpu_graph = gpu_graph;
+#ifdef ENABLE_HIP
+        if (!m_gpu_graph)
+            destroyNetForceGraph();
+#endif
+        }
+
+    /// Get whether the net force summation is replayed from a captured GPU graph
+    bool getGPUGraph()
+        {
+        return m_gpu_graph;
+        }
+
+    /// Set whether the local force computation overlaps the ghost position update
+    void setOverlapGhostUpdate(bool overlap_ghost_update)
+        {
+        m_overlap_ghost_update = overlap_ghost_update;
+        }
+
+    /// Get whether the local force computation overlaps the ghost position update
+    bool getOverlapGhostUpdate()
+        {
+        return m_overlap_ghost_update;
+        }
+
+    /// Set whether independent forces launch their kernels on separate GPU streams
+    void setConcurrentForces(bool concurrent_forces)
+        {
+        m_concurrent_forces = concurrent_forces;
+        }
+
+    /// Get whether independent forces launch their kernels on separate GPU streams
+    bool getConcurrentForces()
+        {
+        return m_concurrent_forces;
+        }
+
 #ifdef ENABLE_MPI
     /// Callback for pre-computing the forces
     void computeCallback(uint64_t timestep);
@@ -148,15 +192,77 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// The HalfStepHook, if active
     std::shared_ptr<HalfStepHook> m_half_step_hook;
 
+    /// Call the HalfStepHook, with device arrays when it has a GPU update
+    void callHalfStepHook(uint64_t timestep);
+
     /// helper function to compute initial accelerations
     void computeAccelerations(uint64_t timestep);
 
+    /// helper function to compute all forces in m_forces
+    void computeForces(uint64_t timestep);
+
+    /// Compute one force, on a separate stream when it is independent of the forces in flight
+    void computeForce(const std::shared_ptr<ForceCompute>& force, uint64_t timestep);
+
+    /// Order the default stream after the forces in flight on separate streams
+    void joinForceStreams();
+
+    /// Add the forces that add to the net force directly
+    void addForcesToNetForce(uint64_t timestep);
+
     /// helper function to compute net force/virial
     virtual void computeNetForce(uint64_t timestep);
 
 #ifdef ENABLE_HIP
     /// helper function to compute net force/virial on the GPU
     virtual void computeNetForceGPU(uint64_t timestep);
+
+    /// Sum the given force lists into the net force on the GPU
+    void sumNetForceGPU(Scalar4* d_net_force,
+                        Scalar* d_net_virial,
+                        size_t net_virial_pitch,
+                        Scalar4* d_net_torque,
+                        const std::vector<kernel::gpu_force_list>& force_lists,
+                        unsigned int nparticles,
+                        bool compute_virial);
+
+    /// Release the captured net force graph
+    void destroyNetForceGraph();
+#endif
+
+    /// True when the net force summation is replayed from a captured GPU graph
+    bool m_gpu_graph = false;
+
+    /// True when the ghost position update may complete during the force computation
+    bool m_overlap_ghost_update = false;
+
+    /// True when independent forces launch their kernels on separate GPU streams
+    bool m_concurrent_forces = false;
+
+#ifdef ENABLE_HIP
+    /// Streams of the concurrent forces, one per force in flight
+    std::vector<hipStream_t> m_force_streams;
+
+    /// Events that order the default stream after the concurrent forces
+    std::vector<hipEvent_t> m_force_stream_events;
+
+    /// Number of streams with force kernels in flight
+    unsigned int m_n_busy_force_streams = 0;
+
+    /// Union of the data dependencies of the forces in flight
+    DataDependencies m_busy_force_dependencies
+        = DataDependencies(data_dependency::none, data_dependency::none);
+#endif
+
+#if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
+    /// Executable graph of the net force summation kernels
+    cudaGraphExec_t m_net_force_graph = nullptr;
+
+    /// Stream used only to capture m_net_force_graph
+    cudaStream_t m_graph_capture_stream = nullptr;
+
+    /// Kernel arguments m_net_force_graph was captured with
+    std::vector<uint64_t> m_net_force_graph_key;
 #endif
 
 #ifdef ENABLE_MPI
@@ -9,6 +9,7 @@
 
 #include "LoadBalancer.h"
 #include "Communicator.h"
+#include "System.h"
 
 #include "hoomd/extern/BVLSSolver.h"
 #include <Eigen/Dense>
@@ -36,8 +37,10 @@ LoadBalancer::LoadBalancer(std::shared_ptr<SystemDefinition> sysdef,
 #endif
       m_max_imbalance(Scalar(1.0)), m_recompute_max_imbalance(true), m_needs_migrate(false),
       m_needs_recount(false), m_tolerance(Scalar(1.05)), m_maxiter(1), m_max_scale(Scalar(0.05)),
-      m_N_own(m_pdata->getN()), m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
-      m_n_iterations(0), m_n_rebalances(0)
+      m_weighted(false), m_weighted_active(false), m_last_force_time(0.0),
+      m_cost_per_particle(Scalar(1.0)), m_total_load(Scalar(m_pdata->getNGlobal())),
+      m_load_own(Scalar(m_pdata->getN())), m_max_max_imbalance(1.0), m_total_max_imbalance(0.0),
+      m_n_calls(0), m_n_iterations(0), m_n_rebalances(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing LoadBalancer" << endl;
 
@@ -86,8 +89,9 @@ void LoadBalancer::update(uint64_t timestep)
     if (m_prof)
         m_prof->push(m_exec_conf, "balance");
 
-    // no adjustment has been made yet, so set m_N_own to the number of particles on the rank
-    resetNOwn(m_pdata->getN());
+    // no adjustment has been made yet, so the load is that of the particles on the rank
+    measureLoad();
+    resetLoad(Scalar(m_pdata->getN()) * m_cost_per_particle);
 
     // figure out which rank is the reduction root for broadcasting
     const Index3D& di = m_decomposition->getDomainIndexer();
@@ -144,17 +148,17 @@ void LoadBalancer::update(uint64_t timestep)
                 min_frac_i = min_domain_frac.z;
                 }
 
-            vector<unsigned int> N_i;
+            vector<Scalar> W_i;
             bool adjusted = false;
 
-            // reduce the number of particles in the slice along dim
-            bool active = reduce(N_i, dim, reduce_root);
+            // reduce the load in the slice along dim
+            bool active = reduce(W_i, dim, reduce_root);
 
             // attempt an adjustment
             vector<Scalar> cum_frac = m_decomposition->getCumulativeFractions(dim);
             if (active)
                 {
-                adjusted = adjust(cum_frac, N_i, L_i, min_frac_i);
+                adjusted = adjust(cum_frac, W_i, L_i, min_frac_i);
                 }
 
             // broadcast if an adjustment has been made on the root
@@ -172,9 +176,12 @@ void LoadBalancer::update(uint64_t timestep)
         // force a particle migration if one is needed
         if (m_needs_migrate)
             {
+            // migrated particles carry their cost to their new rank
+            Scalar load = m_weighted_active ? getLoad() : Scalar(0.0);
+
             m_comm->forceMigrate();
             m_comm->communicate(timestep);
-            resetNOwn(m_pdata->getN());
+            resetLoad(m_weighted_active ? load : Scalar(m_pdata->getN()));
             m_needs_migrate = false;
 
             // increment the number of rebalances actually performed
@@ -190,15 +197,14 @@ void LoadBalancer::update(uint64_t timestep)
 #ifdef ENABLE_MPI
 
 /*!
- * Computes the imbalance factor I = N / <N> for each rank, and computes the maximum among all
- * ranks.
+ * Computes the imbalance factor I = W / <W> for each rank, and computes the maximum among all
+ * ranks. The load W is the number of particles, or the force computation time in weighted mode.
  */
 Scalar LoadBalancer::getMaxImbalance()
     {
     if (m_recompute_max_imbalance)
         {
-        Scalar cur_imb = Scalar(getNOwn())
-                         / (Scalar(m_pdata->getNGlobal()) / Scalar(m_exec_conf->getNRanks()));
+        Scalar cur_imb = getLoad() / (m_total_load / Scalar(m_exec_conf->getNRanks()));
         Scalar max_imb(0.0);
         MPI_Allreduce(&cur_imb, &max_imb, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_mpi_comm);
 
@@ -213,37 +219,91 @@ Scalar LoadBalancer::getMaxImbalance()
     }
 
 /*!
- * \param N_i Vector holding the total number of particles in each slice (will be allocated on call)
+ * In weighted mode, the load of each rank is the time it spent computing the forces of the
+ * integrator since the last balancing step. Weighting falls back to the number of particles when a
+ * rank with particles has no measured time, e.g. on the first step or after the integrator changed.
+ */
+void LoadBalancer::measureLoad()
+    {
+    m_weighted_active = false;
+    m_cost_per_particle = Scalar(1.0);
+    m_total_load = Scalar(m_pdata->getNGlobal());
+
+    if (!m_weighted)
+        return;
+
+    const double force_time = getForceTime();
+    const double elapsed = force_time - m_last_force_time;
+    m_last_force_time = force_time;
+
+    int valid = (elapsed > 0.0 || m_pdata->getN() == 0) ? 1 : 0;
+    MPI_Allreduce(MPI_IN_PLACE, &valid, 1, MPI_INT, MPI_MIN, m_mpi_comm);
+    if (!valid)
+        return;
+
+    Scalar load = (elapsed > 0.0) ? Scalar(elapsed) : Scalar(0.0);
+    Scalar total_load(0.0);
+    MPI_Allreduce(&load, &total_load, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_mpi_comm);
+    if (total_load <= Scalar(0.0))
+        return;
+
+    m_weighted_active = true;
+    m_cost_per_particle = (m_pdata->getN() > 0) ? load / Scalar(m_pdata->getN()) : Scalar(0.0);
+    m_total_load = total_load;
+    }
+
+double LoadBalancer::getForceTime()
+    {
+    std::shared_ptr<System> system = m_system.lock();
+    if (!system || !system->getIntegrator())
+        return 0.0;
+
+    std::shared_ptr<Integrator> integrator = system->getIntegrator();
+    double force_time = 0.0;
+    for (auto& force : integrator->getForces())
+        force_time += force->getExecutionTime();
+    for (auto& force : integrator->getConstraintForces())
+        force_time += force->getExecutionTime();
+    return force_time;
+    }
+
+/*!
+ * \param W_i Vector holding the total load in each slice (will be allocated on call)
  * \param dim The dimension of the slices (x=0, y=1, z=2)
  * \param reduce_root The rank to perform the reduction on
- * \returns true if the current rank holds the active \a N_i
+ * \returns true if the current rank holds the active \a W_i
  *
- * \post \a N_i holds the number of particles in each slice along \a dim
+ * \post \a W_i holds the load in each slice along \a dim
  *
  * \note reduce() relies on collective MPI calls, and so all ranks must call it. However, for
  * efficiency the data will be active only on Cartesian rank \a reduce_root, as indicated by the
- * return value. As a result, only \a reduce_root actually needs to allocate memory for \a N_i.
+ * return value. As a result, only \a reduce_root actually needs to allocate memory for \a W_i.
  *
  * The reduction is performed by performing an all-to-one gather, followed by summation on \a
  * reduce_root. This operation may be suboptimal for very large numbers of processors, and could be
  * replaced by cascading send operations down dimensions. Generally, load balancing should not be
  * performed too frequently, and so we do not pursue this optimization right now.
  */
-bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
-                          unsigned int dim,
-                          unsigned int reduce_root)
+bool LoadBalancer::reduce(std::vector<Scalar>& W_i, unsigned int dim, unsigned int reduce_root)
     {
     // do nothing if there is only one rank
-    if (N_i.size() == 1)
+    if (W_i.size() == 1)
         return false;
 
     const Index3D& di = m_decomposition->getDomainIndexer();
-    std::vector<unsigned int> N_per_rank(di.getNumElements());
+    std::vector<Scalar> W_per_rank(di.getNumElements());
 
-    // get the number of particles the current rank owns (the quantity to be reduced)
-    unsigned int N_own = getNOwn();
+    // get the load of the current rank (the quantity to be reduced)
+    Scalar W_own = getLoad();
 
-    MPI_Gather(&N_own, 1, MPI_UNSIGNED, &N_per_rank[0], 1, MPI_UNSIGNED, reduce_root, m_mpi_comm);
+    MPI_Gather(&W_own,
+               1,
+               MPI_HOOMD_SCALAR,
+               &W_per_rank[0],
+               1,
+               MPI_HOOMD_SCALAR,
+               reduce_root,
+               m_mpi_comm);
 
     // only the root rank performs the reduction
     if (m_exec_conf->getRank() != reduce_root)
@@ -253,57 +313,57 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
     ArrayHandle<unsigned int> h_cart_ranks_inv(m_decomposition->getInverseCartRanks(),
                                                access_location::host,
                                                access_mode::read);
-    std::vector<unsigned int> N_per_cart_rank(di.getNumElements());
+    std::vector<Scalar> W_per_cart_rank(di.getNumElements());
     for (unsigned int cur_rank = 0; cur_rank < di.getNumElements(); ++cur_rank)
         {
-        N_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = N_per_rank[cur_rank];
+        W_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = W_per_rank[cur_rank];
         }
 
     // perform the summation along dim in as cache friendly of a way as we can manage
     if (dim == 0) // to x
         {
-        N_i.clear();
-        N_i.resize(di.getW());
+        W_i.clear();
+        W_i.resize(di.getW());
         for (unsigned int i = 0; i < di.getW(); ++i)
             {
-            N_i[i] = 0;
+            W_i[i] = Scalar(0.0);
             for (unsigned int k = 0; k < di.getD(); ++k)
                 {
                 for (unsigned int j = 0; j < di.getH(); ++j)
                     {
-                    N_i[i] += N_per_cart_rank[di(i, j, k)];
+                    W_i[i] += W_per_cart_rank[di(i, j, k)];
                     }
                 }
             }
         }
     else if (dim == 1) // to y
         {
-        N_i.clear();
-        N_i.resize(di.getH());
+        W_i.clear();
+        W_i.resize(di.getH());
         for (unsigned int j = 0; j < di.getH(); ++j)
             {
-            N_i[j] = 0;
+            W_i[j] = Scalar(0.0);
             for (unsigned int k = 0; k < di.getD(); ++k)
                 {
                 for (unsigned int i = 0; i < di.getW(); ++i)
                     {
-                    N_i[j] += N_per_cart_rank[di(i, j, k)];
+                    W_i[j] += W_per_cart_rank[di(i, j, k)];
                     }
                 }
             }
         }
     else if (dim == 2) // to z
         {
-        N_i.clear();
-        N_i.resize(di.getD());
+        W_i.clear();
+        W_i.resize(di.getD());
         for (unsigned int k = 0; k < di.getD(); ++k)
             {
-            N_i[k] = 0;
+            W_i[k] = Scalar(0.0);
             for (unsigned int j = 0; j < di.getH(); ++j)
                 {
                 for (unsigned int i = 0; i < di.getW(); ++i)
                     {
-                    N_i[k] += N_per_cart_rank[di(i, j, k)];
+                    W_i[k] += W_per_cart_rank[di(i, j, k)];
                     }
                 }
             }
@@ -318,7 +378,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
 
 /*!
  * \param cum_frac_i The cumulative fraction array to write output into
- * \param N_i The reduced number of particles along the dimension
+ * \param W_i The reduced load along the dimension
  * \param L_i The global box length along the dimension
  * \param min_frac_i The minimum fractional width of a domain
  *
@@ -337,31 +397,31 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
  * minimization was successful, apply the adjustment to \a cum_frac_i.
  */
 bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
-                          const vector<unsigned int>& N_i,
+                          const vector<Scalar>& W_i,
                           Scalar L_i,
                           Scalar min_frac_i)
     {
-    if (N_i.size() == 1)
+    if (W_i.size() == 1)
         return false;
 
-    // target particles per rank is uniform distribution
-    const Scalar target = Scalar(m_pdata->getNGlobal()) / Scalar(N_i.size());
+    // target load per rank is uniform distribution
+    const Scalar target = m_total_load / Scalar(W_i.size());
 
     // make the minimum domain slightly bigger so that the optimization won't fail at equality
     const Scalar min_domain_size = Scalar(1.00001) * min_frac_i * L_i;
     // if system is overconstrained (exactly decomposed) don't do any adjusting
-    if (min_domain_size * Scalar(N_i.size()) >= L_i)
+    if (min_domain_size * Scalar(W_i.size()) >= L_i)
         {
         return false;
         }
 
     // imbalance factors for each rank
-    vector<Scalar> new_widths(N_i.size());
-    for (unsigned int i = 0; i < N_i.size(); ++i)
+    vector<Scalar> new_widths(W_i.size());
+    for (unsigned int i = 0; i < W_i.size(); ++i)
         {
-        const Scalar imb_factor = Scalar(N_i[i]) / target;
+        const Scalar imb_factor = W_i[i] / target;
         Scalar scale_factor
-            = (N_i[i] > 0)
+            = (W_i[i] > Scalar(0.0))
                   ? Scalar(1.0) / imb_factor
                   : (Scalar(1.0)
                      + m_max_scale); // as in gromacs, use half the imbalance factor to scale
@@ -386,7 +446,7 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
     // setup the augmented A matrix, with scale factor eps for the actual least squares part (to
     // enforce the inequality constraints correctly)
     const Scalar eps(0.001);
-    unsigned int m = (unsigned int)N_i.size();
+    unsigned int m = (unsigned int)W_i.size();
     unsigned int n = m - 1;
     Eigen::MatrixXd A = Eigen::MatrixXd::Zero(2 * m, n + m);
     A(0, 0) = 1.0;
@@ -546,8 +606,9 @@ void LoadBalancer::countParticlesOffRank(std::map<unsigned int, unsigned int>& c
 
 /*!
  * Each rank calls countParticlesOffRank() to count the number of particles to send to other ranks.
- * Neighboring ranks then perform send/receive calls, and count the new number of particles they own
- * as the number they owned locally plus the number received minus the number sent.
+ * Neighboring ranks then perform send/receive calls, and count the new load they own as the load
+ * they owned locally plus the load received minus the load sent. Each sent particle carries the
+ * cost per particle of the sending rank.
  *
  * \note All ranks must participate in this call since it involves send/receive operations between
  * neighboring domains.
@@ -576,23 +637,23 @@ void LoadBalancer::computeOwnedParticles()
     MPI_Status stat[2 * m_comm->getNUniqueNeighbors()];
     unsigned int nreq = 0;
 
-    unsigned int n_send_ptls[m_comm->getNUniqueNeighbors()];
-    unsigned int n_recv_ptls[m_comm->getNUniqueNeighbors()];
+    Scalar send_load[m_comm->getNUniqueNeighbors()];
+    Scalar recv_load[m_comm->getNUniqueNeighbors()];
     for (unsigned int cur_neigh = 0; cur_neigh < m_comm->getNUniqueNeighbors(); ++cur_neigh)
         {
         unsigned int neigh_rank = h_unique_neigh.data[cur_neigh];
-        n_send_ptls[cur_neigh] = cnts[neigh_rank];
+        send_load[cur_neigh] = Scalar(cnts[neigh_rank]) * m_cost_per_particle;
 
-        MPI_Isend(&n_send_ptls[cur_neigh],
+        MPI_Isend(&send_load[cur_neigh],
                   1,
-                  MPI_UNSIGNED,
+                  MPI_HOOMD_SCALAR,
                   neigh_rank,
                   0,
                   m_mpi_comm,
                   &req[nreq++]);
-        MPI_Irecv(&n_recv_ptls[cur_neigh],
+        MPI_Irecv(&recv_load[cur_neigh],
                   1,
-                  MPI_UNSIGNED,
+                  MPI_HOOMD_SCALAR,
                   neigh_rank,
                   0,
                   m_mpi_comm,
@@ -600,16 +661,18 @@ void LoadBalancer::computeOwnedParticles()
         }
     MPI_Waitall(nreq, req, stat);
 
-    // reduce the particles sent to me
-    int N_own = m_pdata->getN();
+    // reduce the load sent to me
+    Scalar load_own = Scalar(m_pdata->getN()) * m_cost_per_particle;
     for (unsigned int cur_neigh = 0; cur_neigh < m_comm->getNUniqueNeighbors(); ++cur_neigh)
         {
-        N_own += n_recv_ptls[cur_neigh];
-        N_own -= n_send_ptls[cur_neigh];
+        load_own += recv_load[cur_neigh];
+        load_own -= send_load[cur_neigh];
         }
 
-    // set the count
-    resetNOwn(N_own);
+    // set the load without changing the cost per particle
+    m_load_own = load_own;
+    m_recompute_max_imbalance = true;
+    m_needs_recount = false;
     }
 
 #endif // ENABLE_MPI
@@ -636,7 +699,9 @@ void export_LoadBalancer(pybind11::module& m)
                       &LoadBalancer::setMaxIterations)
         .def_property("x", &LoadBalancer::getEnableX, &LoadBalancer::setEnableX)
         .def_property("y", &LoadBalancer::getEnableY, &LoadBalancer::setEnableY)
-        .def_property("z", &LoadBalancer::getEnableZ, &LoadBalancer::setEnableZ);
+        .def_property("z", &LoadBalancer::getEnableZ, &LoadBalancer::setEnableZ)
+        .def_property("weighted", &LoadBalancer::getWeighted, &LoadBalancer::setWeighted)
+        .def("setSystem", &LoadBalancer::setSystem);
     }
 
     } // end namespace detail
@@ -23,6 +23,8 @@
 
 namespace hoomd
     {
+class System;
+
 //! Updates domain decompositions to balance the load
 /*!
  * Adjusts the boundaries of the processor domains to distribute the load close to evenly between
@@ -39,6 +41,11 @@ namespace hoomd
  * Constraints are satisfied by solving a least-squares problem with box constraints, where the cost
  * function is the deviation of the domain sizes from the proposed rescaled width.
  *
+ * In weighted mode, the load of a rank is the wall time it spent computing the forces of the
+ * integrator since the last balancing step instead of its number of particles. Each particle carries
+ * the average cost of the particles on its rank when it is counted on a new rank, so the balancer
+ * minimizes the maximum force computation time per rank.
+ *
  * \ingroup updaters
  */
 class PYBIND11_EXPORT LoadBalancer : public Tuner
@@ -138,6 +145,24 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
         return m_enable_z;
         }
 
+    /// Set whether to balance the force computation time instead of the number of particles
+    void setWeighted(bool weighted)
+        {
+        m_weighted = weighted;
+        }
+
+    /// Get whether to balance the force computation time instead of the number of particles
+    bool getWeighted()
+        {
+        return m_weighted;
+        }
+
+    /// Set the System whose integrator forces are timed in weighted mode
+    void setSystem(std::shared_ptr<System> system)
+        {
+        m_system = system;
+        }
+
     //! Take one timestep forward
     virtual void update(uint64_t timestep);
 
@@ -157,8 +182,14 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
     //! Computes the maximum imbalance factor
     Scalar getMaxImbalance();
 
-    //! Reduce the particle numbers per rank down to one dimension
-    bool reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root);
+    //! Reduce the load per rank down to one dimension
+    bool reduce(std::vector<Scalar>& W_i, unsigned int dim, unsigned int reduce_root);
+
+    //! Measure the cost per particle and the total load for this balancing step
+    void measureLoad();
+
+    //! Get the total wall time spent computing the forces of the integrator [s]
+    double getForceTime();
 
     //! Set flags within the class that a resize has been performed
     void signalResize()
@@ -170,30 +201,38 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
 
     //! Adjust the partitioning along a single dimension
     bool adjust(std::vector<Scalar>& cum_frac_i,
-                const std::vector<unsigned int>& N_i,
+                const std::vector<Scalar>& W_i,
                 Scalar L_i,
                 Scalar min_domain_frac);
 
-    //! Compute the number of particles on each rank after an adjustment
+    //! Compute the load on each rank after an adjustment
     void computeOwnedParticles();
 
     //! Count the number of particles that have gone off the rank
     virtual void countParticlesOffRank(std::map<unsigned int, unsigned int>& cnts);
 
-    //! Gets the number of owned particles, updating if necessary
-    unsigned int getNOwn()
+    //! Gets the load of the owned particles, updating if necessary
+    Scalar getLoad()
         {
         computeOwnedParticles();
-        return m_N_own;
+        return m_load_own;
         }
 
-    //! Force a reset of the number of owned particles without counting
+    //! Force a reset of the load of the owned particles without counting
     /*!
-     * \param N number of particles owned by the rank
+     * \param load Load of the particles owned by the rank
+     *
+     * In weighted mode, the cost per particle is updated to the average cost of the owned
+     * particles.
      */
-    void resetNOwn(unsigned int N)
+    void resetLoad(Scalar load)
         {
-        m_N_own = N;
+        m_load_own = load;
+        if (m_weighted_active)
+            {
+            m_cost_per_particle
+                = (m_pdata->getN() > 0) ? load / Scalar(m_pdata->getN()) : Scalar(0.0);
+            }
         m_recompute_max_imbalance = true;
         m_needs_recount = false;
         }
@@ -213,8 +252,15 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
 
     const Scalar m_max_scale; //!< Maximum fraction to rescale either direction (5%)
 
+    bool m_weighted;                //!< Flag to balance the force computation time
+    bool m_weighted_active;         //!< True if the current step balances measured times
+    std::weak_ptr<System> m_system; //!< System whose integrator forces are timed
+    double m_last_force_time;       //!< Force computation time at the last balancing step [s]
+    Scalar m_cost_per_particle;     //!< Load of a particle owned by this rank
+    Scalar m_total_load;            //!< Total load of all ranks
+
     private:
-    unsigned int m_N_own; //!< Number of particles owned by this rank
+    Scalar m_load_own; //!< Load of the particles owned by this rank
 
     Scalar m_max_max_imbalance;   //!< The maximum imbalance of any check
     double m_total_max_imbalance; //!< The average imbalance over checks
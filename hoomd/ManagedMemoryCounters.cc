@@ -0,0 +1,171 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ManagedMemoryCounters.cc
+    \brief Defines the ManagedMemoryCounters class
+*/
+
+#include "ManagedMemoryCounters.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <stdexcept>
+
+#ifdef ENABLE_CUPTI
+#include <cupti.h>
+#endif
+
+namespace hoomd
+    {
+namespace detail
+    {
+#ifdef ENABLE_CUPTI
+namespace
+    {
+//! Counts accumulated by the activity callbacks
+std::atomic<uint64_t> s_gpu_page_faults(0);
+std::atomic<uint64_t> s_cpu_page_faults(0);
+std::atomic<uint64_t> s_bytes_htod(0);
+std::atomic<uint64_t> s_bytes_dtoh(0);
+std::atomic<uint64_t> s_bytes_dtod(0);
+
+//! True while an instance exists
+std::atomic<bool> s_active(false);
+
+//! Throw an exception when a CUPTI call fails
+void checkCUPTI(CUptiResult result, const char* call)
+    {
+    if (result != CUPTI_SUCCESS)
+        {
+        const char* message = "";
+        cuptiGetResultString(result, &message);
+        throw std::runtime_error(std::string("Error counting managed memory faults: ") + call
+                                 + " failed: " + message);
+        }
+    }
+
+//! Provide CUPTI with an empty activity buffer
+void CUPTIAPI bufferRequested(uint8_t** buffer, size_t* size, size_t* max_num_records)
+    {
+    const size_t buffer_size = 1 << 20;
+    *buffer = static_cast<uint8_t*>(aligned_alloc(8, buffer_size));
+    *size = buffer_size;
+    *max_num_records = 0;
+    }
+
+//! Count the unified memory records in a filled activity buffer
+void CUPTIAPI bufferCompleted(CUcontext context,
+                              uint32_t stream_id,
+                              uint8_t* buffer,
+                              size_t size,
+                              size_t valid_size)
+    {
+    CUpti_Activity* record = nullptr;
+    while (cuptiActivityGetNextRecord(buffer, valid_size, &record) == CUPTI_SUCCESS)
+        {
+        if (record->kind != CUPTI_ACTIVITY_KIND_UNIFIED_MEMORY_COUNTER)
+            continue;
+
+        auto* counter = reinterpret_cast<CUpti_ActivityUnifiedMemoryCounter2*>(record);
+        switch (counter->counterKind)
+            {
+        case CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_GPU_PAGE_FAULT:
+            s_gpu_page_faults += counter->value;
+            break;
+        case CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_CPU_PAGE_FAULT_COUNT:
+            s_cpu_page_faults += counter->value;
+            break;
+        case CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_BYTES_TRANSFER_HTOD:
+            s_bytes_htod += counter->value;
+            break;
+        case CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_BYTES_TRANSFER_DTOH:
+            s_bytes_dtoh += counter->value;
+            break;
+        case CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_BYTES_TRANSFER_DTOD:
+            s_bytes_dtod += counter->value;
+            break;
+        default:
+            break;
+            }
+        }
+
+    free(buffer);
+    }
+    } // end anonymous namespace
+#endif
+
+ManagedMemoryCounters::ManagedMemoryCounters()
+    {
+#ifdef ENABLE_CUPTI
+    if (s_active.exchange(true))
+        throw std::runtime_error("Managed memory faults are already being counted.");
+
+    s_gpu_page_faults = 0;
+    s_cpu_page_faults = 0;
+    s_bytes_htod = 0;
+    s_bytes_dtoh = 0;
+    s_bytes_dtod = 0;
+
+    const CUpti_ActivityUnifiedMemoryCounterKind kinds[]
+        = {CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_GPU_PAGE_FAULT,
+           CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_CPU_PAGE_FAULT_COUNT,
+           CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_BYTES_TRANSFER_HTOD,
+           CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_BYTES_TRANSFER_DTOH,
+           CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_KIND_BYTES_TRANSFER_DTOD};
+    const unsigned int n_kinds = sizeof(kinds) / sizeof(kinds[0]);
+
+    CUpti_ActivityUnifiedMemoryCounterConfig config[n_kinds];
+    for (unsigned int i = 0; i < n_kinds; i++)
+        {
+        config[i].scope = CUPTI_ACTIVITY_UNIFIED_MEMORY_COUNTER_SCOPE_PROCESS_ALL_DEVICES;
+        config[i].kind = kinds[i];
+        config[i].deviceId = 0;
+        config[i].enable = 1;
+        }
+
+    try
+        {
+        checkCUPTI(cuptiActivityRegisterCallbacks(bufferRequested, bufferCompleted),
+                   "cuptiActivityRegisterCallbacks");
+        checkCUPTI(cuptiActivityConfigureUnifiedMemoryCounter(config, n_kinds),
+                   "cuptiActivityConfigureUnifiedMemoryCounter");
+        checkCUPTI(cuptiActivityEnable(CUPTI_ACTIVITY_KIND_UNIFIED_MEMORY_COUNTER),
+                   "cuptiActivityEnable");
+        }
+    catch (...)
+        {
+        s_active = false;
+        throw;
+        }
+#else
+    throw std::runtime_error("Counting managed memory faults requires a build of HOOMD-blue with "
+                             "ENABLE_CUPTI.");
+#endif
+    }
+
+ManagedMemoryCounters::~ManagedMemoryCounters()
+    {
+#ifdef ENABLE_CUPTI
+    cuptiActivityFlushAll(0);
+    cuptiActivityDisable(CUPTI_ACTIVITY_KIND_UNIFIED_MEMORY_COUNTER);
+    s_active = false;
+#endif
+    }
+
+std::map<std::string, uint64_t> ManagedMemoryCounters::getCounts() const
+    {
+    std::map<std::string, uint64_t> counts;
+#ifdef ENABLE_CUPTI
+    checkCUPTI(cuptiActivityFlushAll(0), "cuptiActivityFlushAll");
+
+    counts["gpu_page_faults"] = s_gpu_page_faults;
+    counts["cpu_page_faults"] = s_cpu_page_faults;
+    counts["bytes_htod"] = s_bytes_htod;
+    counts["bytes_dtoh"] = s_bytes_dtoh;
+    counts["bytes_dtod"] = s_bytes_dtod;
+#endif
+    return counts;
+    }
+
+    } // end namespace detail
+    } // end namespace hoomd
@@ -0,0 +1,53 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file ManagedMemoryCounters.h
+    \brief Declares a class that counts managed memory page faults and migrations
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace hoomd
+    {
+namespace detail
+    {
+//! Counts managed memory page faults and migrations with CUPTI
+/*! CUPTI reports unified memory events in activity records, which it delivers in buffers that it
+    requests from and returns to callbacks. The callbacks are process wide, so only one instance
+    may exist at a time. The counters are only available in builds with ENABLE_CUPTI, elsewhere
+    the constructor throws.
+
+    Page faults are expensive in multi-GPU runs with managed memory: each fault stalls the
+    faulting kernel while the driver migrates the page. A sudden increase of the GPU page faults
+    per step (e.g. after particle sorts) indicates arrays that lack a prefetch to the GPU that
+    owns them.
+*/
+class ManagedMemoryCounters
+    {
+    public:
+    //! Start counting on all devices
+    ManagedMemoryCounters();
+
+    //! Stop counting
+    ~ManagedMemoryCounters();
+
+    //! Get the counts since construction
+    /*! \returns The number of GPU page fault groups (gpu_page_faults), CPU page faults
+        (cpu_page_faults), and the bytes migrated from the host to the device (bytes_htod), from
+        the device to the host (bytes_dtoh), and between devices (bytes_dtod).
+
+        Flushes the pending activity records, so this synchronizes with the devices.
+    */
+    std::map<std::string, uint64_t> getCounts() const;
+    };
+
+    } // end namespace detail
+    } // end namespace hoomd
@@ -0,0 +1,53 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file MemoryAccounting.cc
+    \brief Implements a class that counts the bytes allocated per array tag
+*/
+
+#include "MemoryAccounting.h"
+
+namespace hoomd
+    {
+void MemoryAccounting::update(const std::string& old_tag,
+                              size_t old_bytes,
+                              const std::string& new_tag,
+                              size_t new_bytes) const
+    {
+    if (old_bytes == new_bytes && old_tag == new_tag)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (old_bytes)
+        {
+        auto it = m_bytes.find(old_tag);
+        if (it != m_bytes.end())
+            {
+            it->second -= old_bytes;
+            if (it->second == 0)
+                m_bytes.erase(it);
+            }
+        m_total_bytes -= old_bytes;
+        }
+
+    if (new_bytes)
+        {
+        m_bytes[new_tag] += new_bytes;
+        m_total_bytes += new_bytes;
+        }
+    }
+
+std::map<std::string, size_t> MemoryAccounting::getBytes() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bytes;
+    }
+
+size_t MemoryAccounting::getTotalBytes() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_total_bytes;
+    }
+
+    } // end namespace hoomd
@@ -0,0 +1,52 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file MemoryAccounting.h
+    \brief Declares a class that counts the bytes allocated per array tag
+*/
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+//! Counts the bytes held by arrays, grouped by the tag of each array
+/*! GlobalArray reports every change in the size or the tag of its allocation, so the counters
+    always reflect the live allocations. Unlike MemoryTraceback, the accounting is always enabled:
+    each update is a map lookup and costs nothing compared to the allocation itself.
+
+    Tags set with TAG_ALLOCATION have the form "Subsystem::m_array", where Subsystem is the name
+    of the source file that tags the array. Arrays without a tag are counted under an empty tag.
+*/
+class PYBIND11_EXPORT MemoryAccounting
+    {
+    public:
+    //! Move an allocation from one tag and size to another
+    /*! \param old_tag Tag the allocation was counted under
+        \param old_bytes Size the allocation was counted with
+        \param new_tag Tag to count the allocation under
+        \param new_bytes Size to count the allocation with
+    */
+    void update(const std::string& old_tag,
+                size_t old_bytes,
+                const std::string& new_tag,
+                size_t new_bytes) const;
+
+    //! Get the number of bytes allocated by each tag
+    std::map<std::string, size_t> getBytes() const;
+
+    //! Get the total number of bytes allocated
+    size_t getTotalBytes() const;
+
+    private:
+    mutable std::map<std::string, size_t> m_bytes; //!< Allocated bytes by tag
+    mutable size_t m_total_bytes = 0;              //!< Total allocated bytes
+    mutable std::mutex m_mutex;                    //!< Protects the counters
+    };
+
+    } // end namespace hoomd
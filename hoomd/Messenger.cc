@@ -16,6 +16,11 @@
 #endif
 
 #include <stdlib.h>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include <assert.h>
@@ -27,8 +32,122 @@ namespace hoomd
     {
 namespace detail
     {
+//! Size of the output buffers of the file streams
+const size_t messenger_buffer_size = 4096;
+
+//! Maximum number of distinct repeated messages counted between calls to flushRepeated()
+const size_t max_repeated_messages = 1000;
+
+//! Key of a repeated message: the notice level (-1 for warnings) and the text
+typedef std::pair<int, std::string> repeated_key;
+
+struct RepeatedMessages
+    {
+    std::mutex mutex;                        //!< Protects the members
+    std::map<repeated_key, uint64_t> counts; //!< Number of occurrences of each message
+    uint64_t n_dropped = 0;                  //!< Occurrences past max_repeated_messages
+    };
+
+//! Stream buffer that writes to a file in a background thread
+/*! sync() (called by std::endl and std::flush) hands the buffered characters to the writer
+    thread and returns immediately, so frequent flushes do not wait for the file system.
+*/
+class async_filebuf : public std::streambuf
+    {
+    public:
+    //! Constructor
+    async_filebuf(const std::string& filename)
+        : m_file(filename.c_str()), m_buffer(messenger_buffer_size), m_done(false)
+        {
+        setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+        m_thread = std::thread(&async_filebuf::writeLoop, this);
+        }
+
+    //! Destructor
+    /*! Writes the remaining output before closing the file
+     */
+    virtual ~async_filebuf()
+        {
+        queueBuffer();
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_done = true;
+            }
+        m_cond.notify_one();
+        m_thread.join();
+        }
+
+    protected:
+    //! Queue the full buffer and store a character
+    virtual int overflow(int ch)
+        {
+        queueBuffer();
+        if (ch != traits_type::eof())
+            {
+            *pptr() = char(ch);
+            pbump(1);
+            }
+        return traits_type::not_eof(ch);
+        }
+
+    //! Queue the buffered characters and wake the writer thread
+    virtual int sync()
+        {
+        queueBuffer();
+        m_cond.notify_one();
+        return 0;
+        }
+
+    private:
+    std::ofstream m_file;            //!< The output file
+    std::vector<char> m_buffer;      //!< Characters written since the last sync
+    std::deque<std::string> m_queue; //!< Chunks waiting for the writer thread
+    std::mutex m_mutex;              //!< Protects m_queue and m_done
+    std::condition_variable m_cond;  //!< Signals new chunks to the writer thread
+    bool m_done;                     //!< Set when the writer thread should exit
+    std::thread m_thread;            //!< The writer thread
+
+    //! Move the buffered characters to the queue
+    void queueBuffer()
+        {
+        if (pptr() == pbase())
+            return;
+
+            {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.emplace_back(pbase(), pptr());
+            }
+        setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+        }
+
+    //! Write the queued chunks until the destructor sets m_done
+    void writeLoop()
+        {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+            {
+            m_cond.wait(lock, [this] { return m_done || !m_queue.empty(); });
+
+            std::deque<std::string> chunks;
+            chunks.swap(m_queue);
+            bool done = m_done;
+
+            lock.unlock();
+            for (const std::string& chunk : chunks)
+                m_file.write(chunk.data(), chunk.size());
+            m_file.flush();
+            lock.lock();
+
+            if (done && m_queue.empty())
+                break;
+            }
+        }
+    };
+
 #ifdef ENABLE_MPI
 //! Class that supports writing to a shared log file using MPI-IO
+/*! Characters are buffered and each sync() writes them with one call to MPI_File_write_shared.
+ */
 class mpi_io : public std::streambuf
     {
     public:
@@ -48,13 +167,17 @@ class mpi_io : public std::streambuf
         return m_file_open;
         }
 
-    //! Write a character
+    //! Write the full buffer and store a character
     virtual int overflow(int ch);
 
+    //! Write the buffered characters
+    virtual int sync();
+
     private:
-    MPI_Comm m_mpi_comm; //!< The MPI communicator
-    MPI_File m_file;     //!< The file handle
-    bool m_file_open;    //!< Whether the file is open
+    MPI_Comm m_mpi_comm;        //!< The MPI communicator
+    MPI_File m_file;            //!< The file handle
+    bool m_file_open;           //!< Whether the file is open
+    std::vector<char> m_buffer; //!< Characters written since the last sync
     };
 #endif
 
@@ -87,6 +210,8 @@ Messenger::Messenger(std::shared_ptr<MPIConfiguration> mpi_config) : m_mpi_confi
     assert(m_mpi_config);
     if (m_mpi_config->getRank() != 0)
         m_notice_level = 0;
+
+    m_repeated = std::make_shared<detail::RepeatedMessages>();
     }
 
 Messenger::Messenger(const Messenger& msg)
@@ -103,6 +228,7 @@ Messenger::Messenger(const Messenger& msg)
     m_warning_prefix = msg.m_warning_prefix;
     m_notice_prefix = msg.m_notice_prefix;
     m_notice_level = msg.m_notice_level;
+    m_repeated = msg.m_repeated;
 
     m_mpi_config = msg.m_mpi_config;
     }
@@ -121,6 +247,7 @@ Messenger& Messenger::operator=(Messenger& msg)
     m_warning_prefix = msg.m_warning_prefix;
     m_notice_prefix = msg.m_notice_prefix;
     m_notice_level = msg.m_notice_level;
+    m_repeated = msg.m_repeated;
 
     m_mpi_config = msg.m_mpi_config;
 
@@ -306,6 +433,120 @@ void Messenger::noticeStr(unsigned int level, const std::string& msg)
     notice(level) << msg << std::flush;
     }
 
+/*! \param msg Message to print (without a trailing newline)
+
+    Use warningRepeated() for warnings that code may issue on every time step or on many ranks. Any
+    rank may call it.
+    \sa flushRepeated()
+*/
+void Messenger::warningRepeated(const std::string& msg)
+    {
+    recordRepeated(-1, msg);
+    }
+
+/*! \param level Notice level
+    \param msg Message to print (without a trailing newline)
+    \sa warningRepeated()
+*/
+void Messenger::noticeRepeated(unsigned int level, const std::string& msg)
+    {
+    recordRepeated(int(level), msg);
+    }
+
+/*! \param level Notice level, -1 for warnings
+    \param msg Message to print
+
+    Messages are counted only up to max_repeated_messages distinct texts between flushes, so that
+    messages that include changing values do not grow the counts without bound.
+*/
+void Messenger::recordRepeated(int level, const std::string& msg)
+    {
+        {
+        std::lock_guard<std::mutex> lock(m_repeated->mutex);
+        detail::repeated_key key(level, msg);
+        auto it = m_repeated->counts.find(key);
+        if (it != m_repeated->counts.end())
+            {
+            it->second++;
+            return;
+            }
+
+        if (m_repeated->counts.size() >= detail::max_repeated_messages)
+            {
+            m_repeated->n_dropped++;
+            return;
+            }
+
+        m_repeated->counts[key] = 1;
+        }
+
+    // rank 0 prints the first occurrence, the other ranks report theirs in flushRepeated()
+    if (level < 0)
+        warning() << msg << std::endl;
+    else
+        notice(level) << msg << std::endl;
+    }
+
+/*! flushRepeated() is a collective call. Rank 0 prints each message that occurred more than once,
+    or on a rank other than 0, since the last flush with the total count and the number of ranks
+    that issued it.
+*/
+void Messenger::flushRepeated()
+    {
+    std::map<detail::repeated_key, uint64_t> counts;
+    uint64_t n_dropped;
+        {
+        std::lock_guard<std::mutex> lock(m_repeated->mutex);
+        counts.swap(m_repeated->counts);
+        n_dropped = m_repeated->n_dropped;
+        m_repeated->n_dropped = 0;
+        }
+
+    std::vector<std::map<detail::repeated_key, uint64_t>> rank_counts;
+    std::vector<uint64_t> rank_dropped;
+#ifdef ENABLE_MPI
+    gather_v(counts, rank_counts, 0, m_mpi_config->getCommunicator());
+    gather_v(n_dropped, rank_dropped, 0, m_mpi_config->getCommunicator());
+#else
+    rank_counts.push_back(counts);
+    rank_dropped.push_back(n_dropped);
+#endif
+
+    if (m_mpi_config->getRank() != 0)
+        return;
+
+    // total count and number of ranks of each message
+    std::map<detail::repeated_key, std::pair<uint64_t, unsigned int>> totals;
+    for (const auto& counts_on_rank : rank_counts)
+        {
+        for (const auto& count : counts_on_rank)
+            {
+            totals[count.first].first += count.second;
+            totals[count.first].second++;
+            }
+        }
+
+    for (const auto& total : totals)
+        {
+        // skip messages that rank 0 already printed in full
+        if (total.second.first == 1 && rank_counts[0].count(total.first))
+            continue;
+
+        const int level = total.first.first;
+        std::ostream& s = (level < 0) ? warning() : notice(level);
+        s << total.first.second << " (" << total.second.first
+          << (total.second.first == 1 ? " time" : " times") << " on " << total.second.second
+          << (total.second.second == 1 ? " rank)" : " ranks)") << std::endl;
+        }
+
+    uint64_t total_dropped = 0;
+    for (uint64_t dropped : rank_dropped)
+        total_dropped += dropped;
+    if (total_dropped > 0)
+        warning() << total_dropped << " occurrences of other repeated messages were not printed."
+                  << std::endl;
+    }
+
 /*! \param fname File name
     The file is overwritten if it exists. If there is an error opening the file, all level's streams
    are left as is and an error() is issued.
@@ -326,10 +567,12 @@ void Messenger::openFile(const std::string& fname)
     else
         {
         // open the file
-        m_file_out = std::make_shared<std::ofstream>(fname.c_str());
+        m_streambuf_out = std::make_shared<detail::async_filebuf>(fname);
+        m_file_out = std::make_shared<std::ostream>(m_streambuf_out.get());
         }
 #else
-    m_file_out = std::make_shared<std::ofstream>(fname.c_str());
+    m_streambuf_out = std::make_shared<detail::async_filebuf>(fname);
+    m_file_out = std::make_shared<std::ostream>(m_streambuf_out.get());
 #endif
 
     // update the error, warning, and notice streams
@@ -378,6 +621,9 @@ void Messenger::reopenPythonIfNeeded()
     // and python is initialized
     if (m_python_open && Py_IsInitialized())
         {
+        // messages may be written while System::run has released the GIL
+        pybind11::gil_scoped_acquire acquire;
+
         // flush and reopen the streams if sys.stdout or sys.stderr change
         pybind11::object new_pystdout = m_sys.attr("stdout");
         pybind11::object new_pystderr = m_sys.attr("stderr");
@@ -395,6 +641,7 @@ void Messenger::reopenPythonIfNeeded()
 void Messenger::openStd()
     {
     m_file_out = std::shared_ptr<std::ostream>();
+    m_streambuf_out = std::shared_ptr<std::streambuf>();
     m_file_err = std::shared_ptr<std::ostream>();
     m_err_stream = &cerr;
     m_warning_stream = &cerr;
@@ -406,8 +653,10 @@ void Messenger::openStd()
     \param mpi_comm The MPI communicator to use for MPI file IO
  */
 detail::mpi_io::mpi_io(const MPI_Comm& mpi_comm, const std::string& filename)
-    : m_mpi_comm(mpi_comm), m_file_open(false)
+    : m_mpi_comm(mpi_comm), m_file_open(false), m_buffer(messenger_buffer_size)
     {
+    setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+
     assert(m_mpi_comm);
 
     // overwrite old file
@@ -426,20 +675,37 @@ detail::mpi_io::mpi_io(const MPI_Comm& mpi_comm, const std::string& filename)
 
 int detail::mpi_io::overflow(int ch)
     {
-    assert(m_file_open);
+    sync();
+    if (ch != traits_type::eof())
+        {
+        *pptr() = char(ch);
+        pbump(1);
+        }
+    return traits_type::not_eof(ch);
+    }
 
-    char out_data = char(ch);
+int detail::mpi_io::sync()
+    {
+    assert(m_file_open);
 
-    // write value to log file using MPI-IO
-    MPI_Status status;
-    MPI_File_write_shared(m_file, &out_data, 1, MPI_CHAR, &status);
+    int n = int(pptr() - pbase());
+    if (n > 0)
+        {
+        // write the buffer to the log file using MPI-IO
+        MPI_Status status;
+        MPI_File_write_shared(m_file, pbase(), n, MPI_CHAR, &status);
+        setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+        }
     return 0;
     }
 
 void detail::mpi_io::close()
     {
     if (m_file_open)
+        {
+        sync();
         MPI_File_close(&m_file);
+        }
 
     m_file_open = false;
     }
@@ -455,6 +721,9 @@ void export_Messenger(pybind11::module& m)
         .def("error", &Messenger::errorStr)
         .def("warning", &Messenger::warningStr)
         .def("notice", &Messenger::noticeStr)
+        .def("warningRepeated", &Messenger::warningRepeated)
+        .def("noticeRepeated", &Messenger::noticeRepeated)
+        .def("flushRepeated", &Messenger::flushRepeated)
         .def("getNoticeLevel", &Messenger::getNoticeLevel)
         .def("setNoticeLevel", &Messenger::setNoticeLevel)
         .def("getErrorPrefix",
@@ -37,6 +37,9 @@ struct PYBIND11_EXPORT nullstream : std::ostream
     nullstream() : std::ios(0), std::ostream(0) { }
     };
 
+//! Counts of the repeated messages, shared by copies of a Messenger
+struct RepeatedMessages;
+
     } // end namespace detail
 
 //! Utility class for controlling message printing
@@ -72,7 +75,10 @@ struct PYBIND11_EXPORT nullstream : std::ostream
      - Arbitrary streams may be set - however, since they are stored by pointer the caller is
    responsible for deleting them when set in this manner.
      - An alternate interface openFile opens a file for overwrite for all output levels, owned by
-   the Messenger.
+   the Messenger. A background thread writes to the file so that flushes do not stall the caller.
+     - warningRepeated() and noticeRepeated() print messages that code may issue every time step.
+   Each rank counts the messages and rank 0 prints only the first occurrence. flushRepeated()
+   combines the counts of all ranks and rank 0 prints each message once with its total count.
 
     \b HOOMD specific
 
@@ -140,6 +146,15 @@ class PYBIND11_EXPORT Messenger
     //! Alternate method to print notice strings
     void noticeStr(unsigned int level, const std::string& msg);
 
+    //! Print a warning that may repeat many times
+    void warningRepeated(const std::string& msg);
+
+    //! Print a notice that may repeat many times
+    void noticeRepeated(unsigned int level, const std::string& msg);
+
+    //! Print the counts of the repeated messages on all ranks and reset them
+    void flushRepeated();
+
     //! Get the notice level
     /*! \returns Current notice level
      */
@@ -279,6 +294,11 @@ class PYBIND11_EXPORT Messenger
 
     unsigned int m_notice_level; //!< Notice level
 
+    std::shared_ptr<detail::RepeatedMessages> m_repeated; //!< Counts of the repeated messages
+
+    //! Count a repeated message and print it on its first occurrence
+    void recordRepeated(int level, const std::string& msg);
+
     bool m_python_open = false;  //!< True when the python output stream is open
     pybind11::module m_sys;      //!< sys module
     pybind11::object m_pystdout; //!< Currently bound python sys.stdout
@@ -22,9 +22,13 @@
 #include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 
+#include <algorithm>
+#include <bitset>
 #include <cassert>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
 #include <sstream>
 #include <stdexcept>
 #include <stdlib.h>
@@ -80,7 +84,10 @@ ParticleData::ParticleData(unsigned int N,
                            std::shared_ptr<ExecutionConfiguration> exec_conf,
                            std::shared_ptr<DomainDecomposition> decomposition)
     : m_exec_conf(exec_conf), m_nparticles(0), m_nghosts(0), m_max_nparticles(0), m_nglobal(0),
-      m_accel_set(false), m_resize_factor(9. / 8.), m_arrays_allocated(false)
+      m_accel_set(false), m_resize_factor(9. / 8.), m_shrink_threshold(0), m_peak_nparticles(0),
+      m_num_resizes(0), m_capacity_batch_depth(0), m_capacity_change_pending(false),
+      m_particle_number_batch_depth(0), m_particle_number_change_pending(false),
+      m_group_membership_bits(0), m_group_membership_valid(false), m_arrays_allocated(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing ParticleData" << endl;
 
@@ -145,7 +152,10 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
                            std::shared_ptr<ExecutionConfiguration> exec_conf,
                            std::shared_ptr<DomainDecomposition> decomposition)
     : m_exec_conf(exec_conf), m_nparticles(0), m_nghosts(0), m_max_nparticles(0), m_nglobal(0),
-      m_accel_set(false), m_resize_factor(9. / 8.), m_arrays_allocated(false)
+      m_accel_set(false), m_resize_factor(9. / 8.), m_shrink_threshold(0), m_peak_nparticles(0),
+      m_num_resizes(0), m_capacity_batch_depth(0), m_capacity_change_pending(false),
+      m_particle_number_batch_depth(0), m_particle_number_change_pending(false),
+      m_group_membership_bits(0), m_group_membership_valid(false), m_arrays_allocated(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing ParticleData" << endl;
 
@@ -231,6 +241,7 @@ void ParticleData::setGlobalBox(const BoxDim& box)
         m_box = box;
         }
 
+    notifyPositionsChanged();
     m_boxchange_signal.emit();
     }
 
@@ -257,9 +268,140 @@ void ParticleData::notifyParticleSort()
         }
 #endif
 
+    m_group_membership_valid = false;
+    notifyPositionsChanged();
     m_sort_signal.emit();
     }
 
+/*! \returns The reserved bit, or NO_GROUP_MEMBERSHIP_BIT when all 64 bits are in use.
+ */
+unsigned int ParticleData::acquireGroupMembershipBit()
+    {
+    for (unsigned int bit = 0; bit < 64; bit++)
+        {
+        if (!(m_group_membership_bits & (uint64_t(1) << bit)))
+            {
+            m_group_membership_bits |= uint64_t(1) << bit;
+            return bit;
+            }
+        }
+    return NO_GROUP_MEMBERSHIP_BIT;
+    }
+
+/*! \param bit Bit to release
+
+    The bit is cleared in all masks so that the next group to reserve it starts with no members.
+*/
+void ParticleData::releaseGroupMembershipBit(unsigned int bit)
+    {
+    if (bit == NO_GROUP_MEMBERSHIP_BIT)
+        return;
+
+    const uint64_t keep = ~(uint64_t(1) << bit);
+    if (!m_group_membership_tag.isNull())
+        {
+        ArrayHandle<uint64_t> h_group_membership_tag(m_group_membership_tag,
+                                                     access_location::host,
+                                                     access_mode::readwrite);
+        for (size_t tag = 0; tag < m_group_membership_tag.getNumElements(); tag++)
+            h_group_membership_tag.data[tag] &= keep;
+        }
+
+    m_group_membership_bits &= keep;
+    m_group_membership_valid = false;
+    }
+
+/*! The masks are resized to the current number of tags. Masks of new tags are zero.
+ */
+GlobalArray<uint64_t>& ParticleData::getGroupMembershipByTag()
+    {
+    const size_t n_tags = m_rtag.size();
+    if (n_tags == 0)
+        return m_group_membership_tag;
+
+    if (m_group_membership_tag.isNull())
+        {
+        GlobalArray<uint64_t>(n_tags, m_exec_conf).swap(m_group_membership_tag);
+        TAG_ALLOCATION(m_group_membership_tag);
+        ArrayHandle<uint64_t> h_group_membership_tag(m_group_membership_tag,
+                                                     access_location::host,
+                                                     access_mode::overwrite);
+        memset(h_group_membership_tag.data, 0, sizeof(uint64_t) * n_tags);
+        }
+    else if (m_group_membership_tag.getNumElements() != n_tags)
+        {
+        const size_t old_n_tags = m_group_membership_tag.getNumElements();
+        m_group_membership_tag.resize(n_tags);
+        if (n_tags > old_n_tags)
+            {
+            ArrayHandle<uint64_t> h_group_membership_tag(m_group_membership_tag,
+                                                         access_location::host,
+                                                         access_mode::readwrite);
+            memset(h_group_membership_tag.data + old_n_tags,
+                   0,
+                   sizeof(uint64_t) * (n_tags - old_n_tags));
+            }
+        }
+    return m_group_membership_tag;
+    }
+
+/*! Gathering the masks once per sort replaces the random access lookup of every group by tag
+    with a single pass over the particles.
+*/
+const GlobalArray<uint64_t>& ParticleData::getGroupMembership()
+    {
+    if (getMaxN() == 0)
+        return m_group_membership;
+
+    if (m_group_membership.isNull() || m_group_membership.getNumElements() < getMaxN())
+        {
+        GlobalArray<uint64_t>(getMaxN(), m_exec_conf).swap(m_group_membership);
+        TAG_ALLOCATION(m_group_membership);
+        m_group_membership_valid = false;
+        }
+
+    if (m_group_membership_valid)
+        return m_group_membership;
+
+    const GlobalArray<uint64_t>& group_membership_tag = getGroupMembershipByTag();
+
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        ArrayHandle<uint64_t> d_group_membership(m_group_membership,
+                                                 access_location::device,
+                                                 access_mode::overwrite);
+        ArrayHandle<uint64_t> d_group_membership_tag(group_membership_tag,
+                                                     access_location::device,
+                                                     access_mode::read);
+        ArrayHandle<unsigned int> d_tag(getTags(), access_location::device, access_mode::read);
+
+        kernel::gpu_gather_group_membership(getN(),
+                                            d_tag.data,
+                                            d_group_membership_tag.data,
+                                            d_group_membership.data);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+    else
+#endif
+        {
+        ArrayHandle<uint64_t> h_group_membership(m_group_membership,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+        ArrayHandle<uint64_t> h_group_membership_tag(group_membership_tag,
+                                                     access_location::host,
+                                                     access_mode::read);
+        ArrayHandle<unsigned int> h_tag(getTags(), access_location::host, access_mode::read);
+
+        for (unsigned int idx = 0; idx < getN(); idx++)
+            h_group_membership.data[idx] = h_group_membership_tag.data[h_tag.data[idx]];
+        }
+
+    m_group_membership_valid = true;
+    return m_group_membership;
+    }
+
 /*! This function is called any time the ghost particles are removed
  *
  * The rationale is that a subscriber (i.e. the Communicator) can perform clean-up for ghost
@@ -628,6 +770,13 @@ void ParticleData::setNGlobal(unsigned int nglobal)
     // Set global particle number
     m_nglobal = nglobal;
 
+    // notify subscribers once per batch
+    if (m_particle_number_batch_depth > 0)
+        {
+        m_particle_number_change_pending = true;
+        return;
+        }
+
     // we have changed the global particle number, notify subscribers
     m_global_particle_num_signal.emit();
 
@@ -649,6 +798,37 @@ void ParticleData::setNGlobal(unsigned int nglobal)
 #endif
     }
 
+void ParticleData::endParticleNumberBatch()
+    {
+    assert(m_particle_number_batch_depth > 0);
+    m_particle_number_batch_depth--;
+    if (m_particle_number_batch_depth == 0 && m_particle_number_change_pending)
+        {
+        m_particle_number_change_pending = false;
+        setNGlobal(m_nglobal);
+        }
+    }
+
+/*! \param n Number of particles to add
+
+    Grows the particle data arrays on rank 0, where addParticle() places new particles, and the
+    tag tables (the reverse-lookup table, the active tags, and their cache) on all ranks, so that
+    the next \a n calls to addParticle() do not reallocate memory or emit the maximum particle
+    number change signal.
+ */
+void ParticleData::reserveParticles(unsigned int n)
+    {
+    // addParticle() reuses the tags of removed particles before it creates new ones
+    size_t n_new_tags = n > m_recycled_tags.size() ? n - m_recycled_tags.size() : 0;
+    m_rtag.reserve(m_rtag.size() + n_new_tags);
+    m_tag_active.reserve(m_tag_active.size() + n_new_tags);
+    m_cached_tag_set.reserve(m_n_active_tags + n);
+
+    // addParticle() removes the ghosts before it adds a particle
+    if (m_exec_conf->getRank() == 0 && m_arrays_allocated && getN() + n > m_max_nparticles)
+        reallocate(getN() + n);
+    }
+
 /*! \param new_nparticles New particle number
  */
 void ParticleData::resize(unsigned int new_nparticles)
@@ -684,13 +864,64 @@ void ParticleData::resize(unsigned int new_nparticles)
         // reallocate particle data arrays
         reallocate(max_nparticles);
         }
+    else if (m_shrink_threshold > 0)
+        {
+        // shrink only if the peak particle number has stayed well below the capacity for a full
+        // period, so that fluctuations of N (e.g. from load balancing) do not reallocate every step
+        m_peak_nparticles = std::max(m_peak_nparticles, new_nparticles + m_nghosts);
+        if (++m_num_resizes >= SHRINK_CHECK_PERIOD)
+            {
+            if (m_peak_nparticles < (unsigned int)((float)max_nparticles * m_shrink_threshold))
+                {
+                reallocate(((unsigned int)(((float)m_peak_nparticles) * m_resize_factor)) + 1);
+                }
+            m_peak_nparticles = new_nparticles + m_nghosts;
+            m_num_resizes = 0;
+            }
+        }
 
     m_nparticles = new_nparticles;
     }
 
+/*! \param resize_factor Factor by which the particle data arrays grow when they are full
+ */
+void ParticleData::setResizeFactor(float resize_factor)
+    {
+    if (resize_factor <= 1.0f)
+        {
+        throw std::runtime_error("The resize factor must be greater than 1.");
+        }
+    if (m_shrink_threshold * resize_factor >= 1.0f)
+        {
+        throw std::runtime_error("The product of the resize factor and the shrink threshold must "
+                                 "be less than 1.");
+        }
+    m_resize_factor = resize_factor;
+    }
+
+/*! \param shrink_threshold Fraction of the capacity below which the particle data arrays shrink
+
+    The arrays shrink when the largest number of local and ghost particles over the last
+    SHRINK_CHECK_PERIOD calls to resize() is less than \a shrink_threshold times the capacity. The new
+    capacity leaves room for one growth step above that peak. Set \a shrink_threshold to 0 to never
+    shrink the arrays.
+*/
+void ParticleData::setShrinkThreshold(float shrink_threshold)
+    {
+    if (shrink_threshold < 0.0f || shrink_threshold * m_resize_factor >= 1.0f)
+        {
+        throw std::runtime_error("The shrink threshold must be non-negative and less than the "
+                                 "inverse of the resize factor.");
+        }
+    m_shrink_threshold = shrink_threshold;
+    m_peak_nparticles = m_nparticles + m_nghosts;
+    m_num_resizes = 0;
+    }
+
 /*! \param max_n new maximum size of particle data arrays (can be greater or smaller than the
  * current maximum size) To inform classes that allocate arrays for per-particle information of the
- * change of the particle data size, this method issues a m_max_particle_num_signal.emit().
+ * change of the particle data size, this method issues a m_max_particle_num_signal.emit(). Inside
+ * a capacity batch, the signal is emitted once by endCapacityBatch().
  *
  *  \note To keep unnecessary data copying to a minimum, arrays are not reallocated with every
  * change of the particle number, rather an amortized array expanding strategy is used.
@@ -874,8 +1105,11 @@ void ParticleData::reallocate(unsigned int max_n)
 #endif
         }
 
-    // notify observers
-    m_max_particle_num_signal.emit();
+    // notify observers, once per batch
+    if (m_capacity_batch_depth > 0)
+        m_capacity_change_pending = true;
+    else
+        m_max_particle_num_signal.emit();
     }
 
 /*! Rebuild the cached vector of active tags, if necessary
@@ -886,20 +1120,60 @@ void ParticleData::maybe_rebuild_tag_cache()
         return;
 
     // GlobalVector checks if the resize is necessary
-    m_cached_tag_set.resize(m_tag_set.size());
+    m_cached_tag_set.resize(m_n_active_tags);
 
-    // iterate over each element in the set, building a mapping
+    // iterate over the active tags, building a mapping
     // from dense array indices to sparse particle tag indices
     unsigned int i(0);
-    for (std::set<unsigned int>::const_iterator it(m_tag_set.begin()); it != m_tag_set.end();
-         ++it, ++i)
+    for (unsigned int tag = 0; tag < m_tag_active.size(); ++tag)
         {
-        m_cached_tag_set[i] = *it;
+        if (m_tag_active[tag])
+            m_cached_tag_set[i++] = tag;
         }
+    assert(i == m_n_active_tags);
 
     m_invalid_cached_tags = false;
     }
 
+/*! \param tag Tag to mark as active
+
+    The table of active tags grows geometrically, or ahead of time with reserveParticles().
+*/
+void ParticleData::insertActiveTag(unsigned int tag)
+    {
+    if (tag >= m_tag_active.size())
+        m_tag_active.resize(tag + 1, false);
+    if (m_tag_active[tag])
+        return;
+
+    m_tag_active[tag] = true;
+    if (m_n_active_tags == 0 || tag > m_max_active_tag)
+        m_max_active_tag = tag;
+    m_n_active_tags++;
+    }
+
+/*! \param tag Tag to mark as inactive
+ */
+void ParticleData::eraseActiveTag(unsigned int tag)
+    {
+    if (tag >= m_tag_active.size() || !m_tag_active[tag])
+        return;
+
+    m_tag_active[tag] = false;
+    m_n_active_tags--;
+
+    // find the new largest active tag
+    while (m_n_active_tags > 0 && !m_tag_active[m_max_active_tag])
+        m_max_active_tag--;
+    }
+
+void ParticleData::clearActiveTags()
+    {
+    m_tag_active.clear();
+    m_n_active_tags = 0;
+    m_max_active_tag = 0;
+    }
+
 /*! \return true If and only if all particles are in the simulation box
  */
 template<class Real> bool ParticleData::inBox(const SnapshotParticleData<Real>& snap)
@@ -964,7 +1238,7 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
         }
 
     // clear set of active tags
-    m_tag_set.clear();
+    clearActiveTags();
 
     // clear reservoir of recycled tags
     while (!m_recycled_tags.empty())
@@ -1017,17 +1291,31 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
         tag_proc.resize(size);
         N_proc.resize(size, 0);
 
+        // place the bisection cuts before distributing the particles
+        if (m_decomposition->isBisection())
+            {
+            std::vector<Scalar3> frac;
+            if (my_rank == root)
+                {
+                frac.reserve(snapshot.size);
+                for (unsigned int snap_idx = 0; snap_idx < snapshot.size; ++snap_idx)
+                    {
+                    Scalar3 f
+                        = m_global_box.makeFraction(vec_to_scalar3(snapshot.pos[snap_idx]));
+                    frac.push_back(
+                        make_scalar3(f.x - floor(f.x), f.y - floor(f.y), f.z - floor(f.z)));
+                    }
+                }
+            m_decomposition->computeBisection(frac, root);
+            m_box = m_decomposition->calculateLocalBox(m_global_box);
+            }
+
         if (my_rank == 0)
             {
             ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(),
                                                    access_location::host,
                                                    access_mode::read);
 
-            const Index3D& di = m_decomposition->getDomainIndexer();
-            unsigned int n_ranks = m_exec_conf->getNRanks();
-
-            BoxDim global_box = m_global_box;
-
             // loop over particles in snapshot, place them into domains
             for (typename std::vector<vec3<Real>>::const_iterator it = snapshot.pos.begin();
                  it != snapshot.pos.end();
@@ -1044,61 +1332,8 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
 
                 // determine domain the particle is placed into
                 Scalar3 pos = vec_to_scalar3(*it);
-                Scalar3 f = m_global_box.makeFraction(pos);
-                int i = int(f.x * ((Scalar)di.getW()));
-                int j = int(f.y * ((Scalar)di.getH()));
-                int k = int(f.z * ((Scalar)di.getD()));
-
-                // wrap particles that are exactly on a boundary
-                // we only need to wrap in the negative direction, since
-                // processor ids are rounded toward zero
-                char3 flags = make_char3(0, 0, 0);
-                if (i == (int)di.getW())
-                    {
-                    i = 0;
-                    flags.x = 1;
-                    }
-
-                if (j == (int)di.getH())
-                    {
-                    j = 0;
-                    flags.y = 1;
-                    }
-
-                if (k == (int)di.getD())
-                    {
-                    k = 0;
-                    flags.z = 1;
-                    }
-
                 int3 img = snapshot.image[snap_idx];
-
-                // only wrap if the particles is on one of the boundaries
-                uchar3 periodic = make_uchar3(flags.x, flags.y, flags.z);
-                global_box.setPeriodic(periodic);
-                global_box.wrap(pos, img, flags);
-
-                // place particle using actual domain fractions, not global box fraction
-                unsigned int rank
-                    = m_decomposition->placeParticle(m_global_box, pos, h_cart_ranks.data);
-
-                if (rank >= n_ranks)
-                    {
-                    ostringstream s;
-                    s << "init.*: Particle " << snap_idx << " out of bounds." << std::endl;
-                    s << "Cartesian coordinates: " << std::endl;
-                    s << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
-                    s << "Fractional coordinates: " << std::endl;
-                    s << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
-                    Scalar3 lo = m_global_box.getLo();
-                    Scalar3 hi = m_global_box.getHi();
-                    s << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")"
-                      << std::endl;
-                    s << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")"
-                      << std::endl;
-
-                    throw std::runtime_error(s.str());
-                    }
+                unsigned int rank = placeSnapshotParticle(pos, img, snap_idx, h_cart_ranks.data);
 
                 // fill up per-processor data structures
                 pos_proc[rank].push_back(pos);
@@ -1186,7 +1421,7 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
         // update list of active tags
         for (unsigned int tag = 0; tag < nglobal; tag++)
             {
-            m_tag_set.insert(tag);
+            insertActiveTag(tag);
             }
 
         // Now that active tag list has changed, invalidate the cache
@@ -1296,18 +1531,568 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
         // update list of active tags
         for (unsigned int tag = 0; tag < nglobal; tag++)
             {
-            m_tag_set.insert(tag);
+            insertActiveTag(tag);
+            }
+
+        // rtag size reflects actual number of tags
+        m_rtag.resize(nglobal);
+
+        // initialize type mapping
+        m_type_mapping = snapshot.type_mapping;
+        }
+
+    // copy over accel_set flag from snapshot
+    m_accel_set = snapshot.is_accel_set;
+
+    // set global number of particles
+    setNGlobal(nglobal);
+
+    // notify listeners about resorting of local particles
+    notifyParticleSort();
+
+    // zero the origin
+    m_origin = make_scalar3(0, 0, 0);
+    m_o_image = make_int3(0, 0, 0);
+
+    unsigned int snapshot_size = snapshot.size;
+
+// Raise an exception if there are any invalid type ids. This is done here (instead of in the
+// loops above) to avoid MPI communication deadlocks when only some ranks have invalid types.
+// As a convenience, broadcast the values needed to evaluate the condition the same on all
+// ranks.
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        bcast(max_typeid, 0, m_exec_conf->getMPICommunicator());
+        bcast(snapshot_size, 0, m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    if (snapshot_size != 0 && max_typeid >= m_type_mapping.size())
+        {
+        std::ostringstream s;
+        s << "Particle typeid " << max_typeid << " is invalid in a system with "
+          << m_type_mapping.size() << " types.";
+        throw std::runtime_error(s.str());
+        }
+    }
+
+#ifdef ENABLE_MPI
+/*! \param pos Position of the particle, wrapped when it is exactly on a boundary of the box
+    \param img Image of the particle, updated when \a pos is wrapped
+    \param snap_idx Index of the particle in the snapshot, for error messages
+    \param cart_ranks Map from cartesian domain index to rank
+
+    \returns the rank of the domain the particle is placed into
+*/
+unsigned int ParticleData::placeSnapshotParticle(Scalar3& pos,
+                                                 int3& img,
+                                                 unsigned int snap_idx,
+                                                 const unsigned int* cart_ranks)
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    BoxDim global_box = m_global_box;
+
+    Scalar3 f = m_global_box.makeFraction(pos);
+    int i = int(f.x * ((Scalar)di.getW()));
+    int j = int(f.y * ((Scalar)di.getH()));
+    int k = int(f.z * ((Scalar)di.getD()));
+
+    // wrap particles that are exactly on a boundary
+    // we only need to wrap in the negative direction, since
+    // processor ids are rounded toward zero
+    char3 flags = make_char3(0, 0, 0);
+    if (i == (int)di.getW())
+        {
+        i = 0;
+        flags.x = 1;
+        }
+
+    if (j == (int)di.getH())
+        {
+        j = 0;
+        flags.y = 1;
+        }
+
+    if (k == (int)di.getD())
+        {
+        k = 0;
+        flags.z = 1;
+        }
+
+    // only wrap if the particles is on one of the boundaries
+    uchar3 periodic = make_uchar3(flags.x, flags.y, flags.z);
+    global_box.setPeriodic(periodic);
+    global_box.wrap(pos, img, flags);
+
+    // place particle using actual domain fractions, not global box fraction
+    unsigned int rank = m_decomposition->placeParticle(m_global_box, pos, cart_ranks);
+
+    if (rank >= m_exec_conf->getNRanks())
+        {
+        ostringstream s;
+        s << "init.*: Particle " << snap_idx << " out of bounds." << std::endl;
+        s << "Cartesian coordinates: " << std::endl;
+        s << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
+        s << "Fractional coordinates: " << std::endl;
+        s << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
+        Scalar3 lo = m_global_box.getLo();
+        Scalar3 hi = m_global_box.getHi();
+        s << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")" << std::endl;
+        s << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")" << std::endl;
+
+        throw std::runtime_error(s.str());
+        }
+
+    return rank;
+    }
+#endif
+
+/*! \param nglobal Number of particles to read (only used on the root rank)
+    \param type_mapping Particle type names (only used on the root rank)
+    \param window_size Maximum number of particles to read at once
+    \param read_window Called on the root rank to fill a window with particles first to first +
+        window.size - 1
+
+    Initialize the particle data without holding all particles in memory on the root rank. The root
+   rank reads the particles one window at a time and sends the particles in each window directly to
+   the ranks that own them. Particles are tagged in the order they are read, which is the same order
+   initializeFromSnapshot() uses.
+
+    \pre In parallel simulations, the local box size must be set before a call to
+   initializeFromWindows().
+ */
+void ParticleData::initializeFromWindows(
+    unsigned int nglobal,
+    const std::vector<std::string>& type_mapping,
+    unsigned int window_size,
+    const std::function<void(unsigned int, SnapshotParticleData<float>&)>& read_window)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing from snapshot windows of "
+                                << window_size << " particles" << std::endl;
+
+    if (window_size == 0)
+        {
+        throw std::invalid_argument("The snapshot window must hold at least one particle.");
+        }
+
+    // remove all ghost particles
+    removeAllGhostParticles();
+
+    // clear set of active tags
+    clearActiveTags();
+
+    // clear reservoir of recycled tags
+    while (!m_recycled_tags.empty())
+        m_recycled_tags.pop();
+
+    const bool root = m_exec_conf->getRank() == 0;
+    unsigned int n_ranks = 1;
+    m_type_mapping = type_mapping;
+
+#ifdef ENABLE_MPI
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    if (m_decomposition)
+        {
+        n_ranks = m_exec_conf->getNRanks();
+        bcast(m_type_mapping, 0, mpi_comm);
+        bcast(nglobal, 0, mpi_comm);
+        }
+#endif
+
+    // Local particle data
+    std::vector<Scalar3> pos;
+    std::vector<Scalar3> vel;
+    std::vector<Scalar3> accel;
+    std::vector<unsigned int> type;
+    std::vector<Scalar> mass;
+    std::vector<Scalar> charge;
+    std::vector<Scalar> diameter;
+    std::vector<int3> image;
+    std::vector<unsigned int> body;
+    std::vector<Scalar4> orientation;
+    std::vector<Scalar4> angmom;
+    std::vector<Scalar3> inertia;
+    std::vector<unsigned int> tag;
+
+    // append the particles that one window sends to this rank
+    auto distribute = [&](auto& values_proc, auto& values)
+    {
+#ifdef ENABLE_MPI
+        if (m_decomposition)
+            {
+            typename std::remove_reference<decltype(values)>::type received;
+            scatter_v(values_proc, received, 0, mpi_comm);
+            values.insert(values.end(), received.begin(), received.end());
+            return;
+            }
+#endif
+        values.insert(values.end(), values_proc[0].begin(), values_proc[0].end());
+    };
+
+    unsigned int max_typeid = 0;
+    for (unsigned int first = 0; first < nglobal; first += window_size)
+        {
+        unsigned int window_n = std::min(window_size, nglobal - first);
+
+        // Define per-processor particle data for this window
+        std::vector<std::vector<Scalar3>> pos_proc(n_ranks);
+        std::vector<std::vector<Scalar3>> vel_proc(n_ranks);
+        std::vector<std::vector<Scalar3>> accel_proc(n_ranks);
+        std::vector<std::vector<unsigned int>> type_proc(n_ranks);
+        std::vector<std::vector<Scalar>> mass_proc(n_ranks);
+        std::vector<std::vector<Scalar>> charge_proc(n_ranks);
+        std::vector<std::vector<Scalar>> diameter_proc(n_ranks);
+        std::vector<std::vector<int3>> image_proc(n_ranks);
+        std::vector<std::vector<unsigned int>> body_proc(n_ranks);
+        std::vector<std::vector<Scalar4>> orientation_proc(n_ranks);
+        std::vector<std::vector<Scalar4>> angmom_proc(n_ranks);
+        std::vector<std::vector<Scalar3>> inertia_proc(n_ranks);
+        std::vector<std::vector<unsigned int>> tag_proc(n_ranks);
+
+        // the window starts at the snapshot defaults, only the root rank reads particles into it
+        SnapshotParticleData<float> window(root ? window_n : 0);
+        if (root)
+            {
+            read_window(first, window);
+            if (!window.validate())
+                {
+                throw std::runtime_error("Invalid particle data in snapshot.");
+                }
+            }
+
+        // it is an error for particles to be initialized outside of their box
+        if (!inBox(window))
+            {
+            m_exec_conf->msg->warning()
+                << "Not all particles were found inside the given box" << endl;
+            throw runtime_error("Error initializing ParticleData");
+            }
+
+        if (root)
+            {
+#ifdef ENABLE_MPI
+            std::unique_ptr<ArrayHandle<unsigned int>> h_cart_ranks;
+            if (m_decomposition)
+                {
+                h_cart_ranks.reset(new ArrayHandle<unsigned int>(m_decomposition->getCartRanks(),
+                                                                 access_location::host,
+                                                                 access_mode::read));
+                }
+#endif
+
+            for (unsigned int window_idx = 0; window_idx < window_n; window_idx++)
+                {
+                Scalar3 p = vec_to_scalar3(window.pos[window_idx]);
+                int3 img = window.image[window_idx];
+                unsigned int rank = 0;
+
+#ifdef ENABLE_MPI
+                if (m_decomposition)
+                    rank = placeSnapshotParticle(p, img, first + window_idx, h_cart_ranks->data);
+#endif
+
+                pos_proc[rank].push_back(p);
+                image_proc[rank].push_back(img);
+                vel_proc[rank].push_back(vec_to_scalar3(window.vel[window_idx]));
+                accel_proc[rank].push_back(vec_to_scalar3(window.accel[window_idx]));
+                type_proc[rank].push_back(window.type[window_idx]);
+                mass_proc[rank].push_back(window.mass[window_idx]);
+                charge_proc[rank].push_back(window.charge[window_idx]);
+                diameter_proc[rank].push_back(window.diameter[window_idx]);
+                body_proc[rank].push_back(window.body[window_idx]);
+                orientation_proc[rank].push_back(quat_to_scalar4(window.orientation[window_idx]));
+                angmom_proc[rank].push_back(quat_to_scalar4(window.angmom[window_idx]));
+                inertia_proc[rank].push_back(vec_to_scalar3(window.inertia[window_idx]));
+                tag_proc[rank].push_back(first + window_idx);
+
+                max_typeid = std::max(max_typeid, window.type[window_idx]);
+                }
+            }
+
+        distribute(pos_proc, pos);
+        distribute(vel_proc, vel);
+        distribute(accel_proc, accel);
+        distribute(type_proc, type);
+        distribute(mass_proc, mass);
+        distribute(charge_proc, charge);
+        distribute(diameter_proc, diameter);
+        distribute(image_proc, image);
+        distribute(body_proc, body);
+        distribute(orientation_proc, orientation);
+        distribute(angmom_proc, angmom);
+        distribute(inertia_proc, inertia);
+        distribute(tag_proc, tag);
+        }
+
+    m_nparticles = (unsigned int)tag.size();
+
+    // resize array for reverse-lookup tags
+    m_rtag.resize(nglobal);
+
+        {
+        // reset all reverse lookup tags to NOT_LOCAL flag
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::overwrite);
+
+        // we have to reset all previous rtags, to remove 'leftover' ghosts
+        unsigned int max_tag = (unsigned int)m_rtag.size();
+        for (unsigned int t = 0; t < max_tag; t++)
+            h_rtag.data[t] = NOT_LOCAL;
+        }
+
+    // update list of active tags
+    for (unsigned int t = 0; t < nglobal; t++)
+        {
+        insertActiveTag(t);
+        }
+
+    // Now that active tag list has changed, invalidate the cache
+    m_invalid_cached_tags = true;
+
+    // resize particle data
+    resize(m_nparticles);
+
+        {
+        // Load particle data
+        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_accel(m_accel, access_location::host, access_mode::overwrite);
+        ArrayHandle<int3> h_image(m_image, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_charge(m_charge, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_body(m_body, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_orientation(m_orientation,
+                                           access_location::host,
+                                           access_mode::overwrite);
+        ArrayHandle<Scalar4> h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_comm_flag(m_comm_flags,
+                                              access_location::host,
+                                              access_mode::overwrite);
+        ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+
+        for (unsigned int idx = 0; idx < m_nparticles; idx++)
+            {
+            h_pos.data[idx]
+                = make_scalar4(pos[idx].x, pos[idx].y, pos[idx].z, __int_as_scalar(type[idx]));
+            h_vel.data[idx] = make_scalar4(vel[idx].x, vel[idx].y, vel[idx].z, mass[idx]);
+            h_accel.data[idx] = accel[idx];
+            h_charge.data[idx] = charge[idx];
+            h_diameter.data[idx] = diameter[idx];
+            h_image.data[idx] = image[idx];
+            h_tag.data[idx] = tag[idx];
+            h_rtag.data[tag[idx]] = idx;
+            h_body.data[idx] = body[idx];
+            h_orientation.data[idx] = orientation[idx];
+            h_angmom.data[idx] = angmom[idx];
+            h_inertia.data[idx] = inertia[idx];
+
+            h_comm_flag.data[idx] = 0; // initialize with zero
             }
+        }
+
+    // windows do not carry accelerations
+    m_accel_set = false;
+
+    // set global number of particles
+    setNGlobal(nglobal);
+
+    // notify listeners about resorting of local particles
+    notifyParticleSort();
+
+    // zero the origin
+    m_origin = make_scalar3(0, 0, 0);
+    m_o_image = make_int3(0, 0, 0);
+
+// Raise an exception if there are any invalid type ids. This is done here (instead of in the
+// loop above) to avoid MPI communication deadlocks when only some ranks have invalid types.
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        bcast(max_typeid, 0, mpi_comm);
+        }
+#endif
+
+    if (nglobal != 0 && max_typeid >= m_type_mapping.size())
+        {
+        std::ostringstream s;
+        s << "Particle typeid " << max_typeid << " is invalid in a system with "
+          << m_type_mapping.size() << " types.";
+        throw std::runtime_error(s.str());
+        }
+    }
+
+/*! \param nglobal Total number of particles on all ranks
+    \param type_mapping Particle type names
+    \param generate Called once on every rank to generate the local particles (inside the local
+        domain) in a snapshot, and their globally unique tags in [0, nglobal)
+
+    Initialize the particle data from particles generated independently on each rank. No rank holds
+   more than its own particles and no particle data is communicated.
+
+    \pre In parallel simulations, the local box size must be set before a call to
+   initializeFromLocal().
+ */
+void ParticleData::initializeFromLocal(
+    unsigned int nglobal,
+    const std::vector<std::string>& type_mapping,
+    const std::function<void(SnapshotParticleData<Scalar>&, std::vector<unsigned int>&)>&
+        generate)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing " << nglobal
+                                << " particles generated on each rank" << std::endl;
+
+    // remove all ghost particles
+    removeAllGhostParticles();
+
+    // clear set of active tags
+    clearActiveTags();
+
+    // clear reservoir of recycled tags
+    while (!m_recycled_tags.empty())
+        m_recycled_tags.pop();
+
+    m_type_mapping = type_mapping;
+
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        bcast(m_type_mapping, 0, m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    SnapshotParticleData<Scalar> local;
+    std::vector<unsigned int> tag;
+    generate(local, tag);
+
+    if (local.size != tag.size())
+        {
+        throw std::runtime_error("Generated particles and tags differ in number.");
+        }
+
+    // mark the generated tags in a bit mask, the ranks generated every tag exactly once when the
+    // union of the masks holds as many tags as were generated in total
+    unsigned int max_typeid = 0;
+    std::vector<unsigned long long> tag_mask((nglobal + 63) / 64, 0);
+    for (unsigned int idx = 0; idx < tag.size(); idx++)
+        {
+        max_typeid = std::max(max_typeid, local.type[idx]);
+        if (tag[idx] < nglobal)
+            tag_mask[tag[idx] / 64] |= 1ull << (tag[idx] % 64);
+        }
+
+    // Raise exceptions only after a collective reduction to avoid MPI communication deadlocks when
+    // only some ranks have invalid particles.
+    unsigned int n_local = (unsigned int)tag.size();
+    unsigned int n_total = n_local;
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        MPI_Allreduce(MPI_IN_PLACE, &max_typeid, 1, MPI_UNSIGNED, MPI_MAX, mpi_comm);
+        MPI_Allreduce(MPI_IN_PLACE, &n_total, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+        MPI_Allreduce(MPI_IN_PLACE,
+                      tag_mask.data(),
+                      (int)tag_mask.size(),
+                      MPI_UNSIGNED_LONG_LONG,
+                      MPI_BOR,
+                      mpi_comm);
+        }
+#endif
+
+    // duplicate tags and tags outside of [0, nglobal) leave fewer distinct tags than particles
+    unsigned int n_distinct = 0;
+    for (unsigned long long word : tag_mask)
+        n_distinct += (unsigned int)std::bitset<64>(word).count();
+
+    if (n_total != nglobal || n_distinct != nglobal)
+        {
+        std::ostringstream s;
+        s << "Generated " << n_total << " particles with " << n_distinct
+          << " distinct tags in [0, " << nglobal << "), expected " << nglobal
+          << " particles with unique tags.";
+        throw std::runtime_error(s.str());
+        }
+
+    if (nglobal != 0 && max_typeid >= m_type_mapping.size())
+        {
+        std::ostringstream s;
+        s << "Particle typeid " << max_typeid << " is invalid in a system with "
+          << m_type_mapping.size() << " types.";
+        throw std::runtime_error(s.str());
+        }
+
+    m_nparticles = n_local;
+
+    // resize array for reverse-lookup tags
+    m_rtag.resize(nglobal);
+
+        {
+        // reset all reverse lookup tags to NOT_LOCAL flag
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::overwrite);
+        for (unsigned int t = 0; t < nglobal; t++)
+            h_rtag.data[t] = NOT_LOCAL;
+        }
+
+    // update list of active tags
+    for (unsigned int t = 0; t < nglobal; t++)
+        {
+        insertActiveTag(t);
+        }
+
+    // Now that active tag list has changed, invalidate the cache
+    m_invalid_cached_tags = true;
+
+    // resize particle data
+    resize(m_nparticles);
+
+        {
+        // Load particle data with the generated particles
+        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_accel(m_accel, access_location::host, access_mode::overwrite);
+        ArrayHandle<int3> h_image(m_image, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_charge(m_charge, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_body(m_body, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_orientation(m_orientation,
+                                           access_location::host,
+                                           access_mode::overwrite);
+        ArrayHandle<Scalar4> h_angmom(m_angmom, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_inertia(m_inertia, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_comm_flag(m_comm_flags,
+                                              access_location::host,
+                                              access_mode::overwrite);
+        ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::readwrite);
 
-        // rtag size reflects actual number of tags
-        m_rtag.resize(nglobal);
+        for (unsigned int idx = 0; idx < m_nparticles; idx++)
+            {
+            h_pos.data[idx] = make_scalar4(local.pos[idx].x,
+                                           local.pos[idx].y,
+                                           local.pos[idx].z,
+                                           __int_as_scalar(local.type[idx]));
+            h_vel.data[idx] = make_scalar4(local.vel[idx].x,
+                                           local.vel[idx].y,
+                                           local.vel[idx].z,
+                                           local.mass[idx]);
+            h_accel.data[idx] = vec_to_scalar3(local.accel[idx]);
+            h_charge.data[idx] = local.charge[idx];
+            h_diameter.data[idx] = local.diameter[idx];
+            h_image.data[idx] = local.image[idx];
+            h_tag.data[idx] = tag[idx];
+            h_rtag.data[tag[idx]] = idx;
+            h_body.data[idx] = local.body[idx];
+            h_orientation.data[idx] = quat_to_scalar4(local.orientation[idx]);
+            h_angmom.data[idx] = quat_to_scalar4(local.angmom[idx]);
+            h_inertia.data[idx] = vec_to_scalar3(local.inertia[idx]);
 
-        // initialize type mapping
-        m_type_mapping = snapshot.type_mapping;
+            h_comm_flag.data[idx] = 0; // initialize with zero
+            }
         }
 
-    // copy over accel_set flag from snapshot
-    m_accel_set = snapshot.is_accel_set;
+    m_accel_set = local.is_accel_set;
 
     // set global number of particles
     setNGlobal(nglobal);
@@ -1318,28 +2103,6 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
     // zero the origin
     m_origin = make_scalar3(0, 0, 0);
     m_o_image = make_int3(0, 0, 0);
-
-    unsigned int snapshot_size = snapshot.size;
-
-// Raise an exception if there are any invalid type ids. This is done here (instead of in the
-// loops above) to avoid MPI communication deadlocks when only some ranks have invalid types.
-// As a convenience, broadcast the values needed to evaluate the condition the same on all
-// ranks.
-#ifdef ENABLE_MPI
-    if (m_decomposition)
-        {
-        bcast(max_typeid, 0, m_exec_conf->getMPICommunicator());
-        bcast(snapshot_size, 0, m_exec_conf->getMPICommunicator());
-        }
-#endif
-
-    if (snapshot_size != 0 && max_typeid >= m_type_mapping.size())
-        {
-        std::ostringstream s;
-        s << "Particle typeid " << max_typeid << " is invalid in a system with "
-          << m_type_mapping.size() << " types.";
-        throw std::runtime_error(s.str());
-        }
     }
 
 //! take a particle data snapshot
@@ -1486,13 +2249,13 @@ ParticleData::takeSnapshot(SnapshotParticleData<Real>& snapshot)
                             std::pair<unsigned int, unsigned int>(irank, it->second)));
 
             // add particles to snapshot
-            assert(m_tag_set.size() == getNGlobal());
-            std::set<unsigned int>::const_iterator tag_set_it = m_tag_set.begin();
+            assert(m_n_active_tags == getNGlobal());
+            maybe_rebuild_tag_cache();
 
             std::map<unsigned int, std::pair<unsigned int, unsigned int>>::iterator rank_rtag_it;
             for (unsigned int snap_id = 0; snap_id < getNGlobal(); snap_id++)
                 {
-                unsigned int tag = *tag_set_it;
+                unsigned int tag = m_cached_tag_set[snap_id];
                 assert(tag <= getMaximumTag());
                 rank_rtag_it = rank_rtag_map.find(tag);
 
@@ -1530,7 +2293,6 @@ ParticleData::takeSnapshot(SnapshotParticleData<Real>& snapshot)
                 m_global_box.wrap(tmp, snapshot.image[snap_id]);
                 snapshot.pos[snap_id] = vec3<Real>(tmp);
 
-                std::advance(tag_set_it, 1);
                 }
             }
         }
@@ -1540,13 +2302,13 @@ ParticleData::takeSnapshot(SnapshotParticleData<Real>& snapshot)
         // allocate memory in snapshot
         snapshot.resize(getNGlobal());
 
-        assert(m_tag_set.size() == m_nparticles);
-        std::set<unsigned int>::const_iterator it = m_tag_set.begin();
+        assert(m_n_active_tags == m_nparticles);
+        maybe_rebuild_tag_cache();
 
         // iterate through active tags
         for (unsigned int snap_id = 0; snap_id < m_nparticles; snap_id++)
             {
-            unsigned int tag = *it;
+            unsigned int tag = m_cached_tag_set[snap_id];
             assert(tag <= getMaximumTag());
             unsigned int idx = h_rtag.data[tag];
             assert(idx < m_nparticles);
@@ -1577,7 +2339,6 @@ ParticleData::takeSnapshot(SnapshotParticleData<Real>& snapshot)
             m_global_box.wrap(tmp, snapshot.image[snap_id]);
             snapshot.pos[snap_id] = vec3<Real>(tmp);
 
-            std::advance(it, 1);
             }
         }
 
@@ -1589,6 +2350,476 @@ ParticleData::takeSnapshot(SnapshotParticleData<Real>& snapshot)
     return index;
     }
 
+namespace detail
+    {
+//! Bits that select the fields in ParticleData::gatherSnapshotFields
+enum snapshot_field_bit
+    {
+    field_tag = 1 << 0,
+    field_pos = 1 << 1,
+    field_vel = 1 << 2,
+    field_accel = 1 << 3,
+    field_type = 1 << 4,
+    field_mass = 1 << 5,
+    field_charge = 1 << 6,
+    field_diameter = 1 << 7,
+    field_image = 1 << 8,
+    field_body = 1 << 9,
+    field_orientation = 1 << 10,
+    field_angmom = 1 << 11,
+    field_inertia = 1 << 12
+    };
+
+//! Where each gathered particle goes in tag order
+struct TagOrderPlan
+    {
+    std::vector<unsigned int> tag;  //!< Tags of the gathered particles (root rank only)
+    std::vector<unsigned int> slot; //!< Index in tag order of each gathered particle (root only)
+    std::vector<int> counts;        //!< Number of particles on each rank (root rank only)
+    std::vector<int> displs;        //!< Offset of the particles of each rank (root rank only)
+    bool root = true;               //!< True on the rank that receives the data
+#ifdef ENABLE_MPI
+    MPI_Comm mpi_comm = MPI_COMM_NULL; //!< Communicator to gather over, null in serial
+#endif
+    };
+
+//! Store one field of the local particles in tag order on the root rank
+/*! \param local Values of the local particles, components values per particle
+    \param out Destination, components values per particle in tag order (root rank only)
+    \param components Number of values per particle
+    \param plan Placement of the gathered particles
+*/
+template<class T>
+static void store_field_by_tag(const std::vector<T>& local,
+                               T* out,
+                               unsigned int components,
+                               const TagOrderPlan& plan)
+    {
+    const T* received = local.data();
+    std::vector<T> received_buffer;
+
+#ifdef ENABLE_MPI
+    if (plan.mpi_comm != MPI_COMM_NULL)
+        {
+        // send whole particles so that the counts do not overflow for large systems
+        MPI_Datatype particle_type;
+        MPI_Type_contiguous(int(sizeof(T) * components), MPI_BYTE, &particle_type);
+        MPI_Type_commit(&particle_type);
+
+        if (plan.root)
+            received_buffer.resize(plan.slot.size() * components);
+
+        MPI_Gatherv(local.data(),
+                    int(local.size() / components),
+                    particle_type,
+                    received_buffer.data(),
+                    plan.counts.data(),
+                    plan.displs.data(),
+                    particle_type,
+                    0,
+                    plan.mpi_comm);
+        MPI_Type_free(&particle_type);
+        received = received_buffer.data();
+        }
+#endif
+
+    if (!plan.root)
+        return;
+
+    for (size_t i = 0; i < plan.slot.size(); i++)
+        for (unsigned int j = 0; j < components; j++)
+            out[size_t(plan.slot[i]) * components + j] = received[i * components + j];
+    }
+    } // end namespace detail
+
+/*! \param buffers Destinations of the selected fields (see SnapshotFieldBuffers)
+
+    gatherSnapshotFields is a lean alternative to takeSnapshot for callers that need only some of
+    the fields: it gathers only the selected fields, converts them to the requested precision on
+    the sending ranks, and stores them directly in the caller's buffers. The root rank holds the
+    received values of one field at a time in addition to the buffers.
+
+    This is a collective call. The fields selected on the root rank are gathered on all ranks.
+*/
+template<class Real>
+void ParticleData::gatherSnapshotFields(const SnapshotFieldBuffers<Real>& buffers)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: gathering snapshot fields" << std::endl;
+
+    const unsigned int N = m_nparticles;
+    detail::TagOrderPlan plan;
+
+    // the root rank selects the fields
+    unsigned int selected = 0;
+    if (buffers.tag)
+        selected |= detail::field_tag;
+    if (buffers.pos)
+        selected |= detail::field_pos;
+    if (buffers.vel)
+        selected |= detail::field_vel;
+    if (buffers.accel)
+        selected |= detail::field_accel;
+    if (buffers.type)
+        selected |= detail::field_type;
+    if (buffers.mass)
+        selected |= detail::field_mass;
+    if (buffers.charge)
+        selected |= detail::field_charge;
+    if (buffers.diameter)
+        selected |= detail::field_diameter;
+    if (buffers.image)
+        selected |= detail::field_image;
+    if (buffers.body)
+        selected |= detail::field_body;
+    if (buffers.orientation)
+        selected |= detail::field_orientation;
+    if (buffers.angmom)
+        selected |= detail::field_angmom;
+    if (buffers.inertia)
+        selected |= detail::field_inertia;
+
+        {
+        ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::read);
+
+#ifdef ENABLE_MPI
+        if (m_decomposition)
+            {
+            plan.mpi_comm = m_exec_conf->getMPICommunicator();
+            plan.root = m_exec_conf->isRoot();
+            bcast(selected, 0, plan.mpi_comm);
+
+            unsigned int n_ranks = m_exec_conf->getNRanks();
+            int n_local = int(N);
+            if (plan.root)
+                {
+                plan.counts.resize(n_ranks);
+                plan.displs.resize(n_ranks);
+                }
+            MPI_Gather(&n_local, 1, MPI_INT, plan.counts.data(), 1, MPI_INT, 0, plan.mpi_comm);
+
+            if (plan.root)
+                {
+                int offset = 0;
+                for (unsigned int irank = 0; irank < n_ranks; irank++)
+                    {
+                    plan.displs[irank] = offset;
+                    offset += plan.counts[irank];
+                    }
+                plan.tag.resize(offset);
+                }
+
+            MPI_Gatherv(h_tag.data,
+                        n_local,
+                        MPI_UNSIGNED,
+                        plan.tag.data(),
+                        plan.counts.data(),
+                        plan.displs.data(),
+                        MPI_UNSIGNED,
+                        0,
+                        plan.mpi_comm);
+            }
+        else
+#endif
+            {
+            plan.tag.assign(h_tag.data, h_tag.data + N);
+            }
+        }
+
+    if (plan.root)
+        {
+        // sort the gathered particles by tag
+        std::vector<unsigned int> order(plan.tag.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(),
+                  order.end(),
+                  [&plan](unsigned int a, unsigned int b) { return plan.tag[a] < plan.tag[b]; });
+
+        if (order.size() != getNGlobal())
+            throw std::runtime_error("Error gathering ParticleData: Number of particles does not "
+                                     "match.");
+
+        plan.slot.resize(order.size());
+        for (unsigned int i = 0; i < order.size(); i++)
+            plan.slot[order[i]] = i;
+
+        if (selected & detail::field_tag)
+            for (unsigned int i = 0; i < order.size(); i++)
+                buffers.tag[i] = plan.tag[order[i]];
+        }
+
+    // shift and wrap the positions the same way as takeSnapshot
+    if (selected & (detail::field_pos | detail::field_image))
+        {
+        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image(m_image, access_location::host, access_mode::read);
+
+        std::vector<Real> pos(size_t(N) * 3);
+        std::vector<int> image(size_t(N) * 3);
+        for (unsigned int idx = 0; idx < N; idx++)
+            {
+            Scalar3 p
+                = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - m_origin;
+            int3 img = h_image.data[idx];
+            img.x -= m_o_image.x;
+            img.y -= m_o_image.y;
+            img.z -= m_o_image.z;
+            m_global_box.wrap(p, img);
+
+            pos[idx * 3 + 0] = Real(p.x);
+            pos[idx * 3 + 1] = Real(p.y);
+            pos[idx * 3 + 2] = Real(p.z);
+            image[idx * 3 + 0] = img.x;
+            image[idx * 3 + 1] = img.y;
+            image[idx * 3 + 2] = img.z;
+            }
+
+        if (selected & detail::field_pos)
+            detail::store_field_by_tag(pos, buffers.pos, 3, plan);
+        if (selected & detail::field_image)
+            detail::store_field_by_tag(image, buffers.image, 3, plan);
+        }
+
+    if (selected & (detail::field_vel | detail::field_mass))
+        {
+        ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::read);
+        std::vector<Real> vel(size_t(N) * 3);
+        std::vector<Real> mass(N);
+        for (unsigned int idx = 0; idx < N; idx++)
+            {
+            vel[idx * 3 + 0] = Real(h_vel.data[idx].x);
+            vel[idx * 3 + 1] = Real(h_vel.data[idx].y);
+            vel[idx * 3 + 2] = Real(h_vel.data[idx].z);
+            mass[idx] = Real(h_vel.data[idx].w);
+            }
+
+        if (selected & detail::field_vel)
+            detail::store_field_by_tag(vel, buffers.vel, 3, plan);
+        if (selected & detail::field_mass)
+            detail::store_field_by_tag(mass, buffers.mass, 1, plan);
+        }
+
+    if (selected & detail::field_accel)
+        {
+        ArrayHandle<Scalar3> h_accel(m_accel, access_location::host, access_mode::read);
+        std::vector<Real> accel(size_t(N) * 3);
+        for (unsigned int idx = 0; idx < N; idx++)
+            {
+            accel[idx * 3 + 0] = Real(h_accel.data[idx].x);
+            accel[idx * 3 + 1] = Real(h_accel.data[idx].y);
+            accel[idx * 3 + 2] = Real(h_accel.data[idx].z);
+            }
+        detail::store_field_by_tag(accel, buffers.accel, 3, plan);
+        }
+
+    if (selected & detail::field_type)
+        {
+        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::read);
+        std::vector<unsigned int> type(N);
+        for (unsigned int idx = 0; idx < N; idx++)
+            type[idx] = __scalar_as_int(h_pos.data[idx].w);
+        detail::store_field_by_tag(type, buffers.type, 1, plan);
+        }
+
+    if (selected & detail::field_charge)
+        {
+        ArrayHandle<Scalar> h_charge(m_charge, access_location::host, access_mode::read);
+        std::vector<Real> charge(h_charge.data, h_charge.data + N);
+        detail::store_field_by_tag(charge, buffers.charge, 1, plan);
+        }
+
+    if (selected & detail::field_diameter)
+        {
+        ArrayHandle<Scalar> h_diameter(m_diameter, access_location::host, access_mode::read);
+        std::vector<Real> diameter(h_diameter.data, h_diameter.data + N);
+        detail::store_field_by_tag(diameter, buffers.diameter, 1, plan);
+        }
+
+    if (selected & detail::field_body)
+        {
+        ArrayHandle<unsigned int> h_body(m_body, access_location::host, access_mode::read);
+        std::vector<unsigned int> body(h_body.data, h_body.data + N);
+        detail::store_field_by_tag(body, buffers.body, 1, plan);
+        }
+
+    if (selected & (detail::field_orientation | detail::field_angmom))
+        {
+        ArrayHandle<Scalar4> h_orientation(m_orientation, access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_angmom(m_angmom, access_location::host, access_mode::read);
+        std::vector<Real> values(size_t(N) * 4);
+
+        if (selected & detail::field_orientation)
+            {
+            for (unsigned int idx = 0; idx < N; idx++)
+                {
+                values[idx * 4 + 0] = Real(h_orientation.data[idx].x);
+                values[idx * 4 + 1] = Real(h_orientation.data[idx].y);
+                values[idx * 4 + 2] = Real(h_orientation.data[idx].z);
+                values[idx * 4 + 3] = Real(h_orientation.data[idx].w);
+                }
+            detail::store_field_by_tag(values, buffers.orientation, 4, plan);
+            }
+
+        if (selected & detail::field_angmom)
+            {
+            for (unsigned int idx = 0; idx < N; idx++)
+                {
+                values[idx * 4 + 0] = Real(h_angmom.data[idx].x);
+                values[idx * 4 + 1] = Real(h_angmom.data[idx].y);
+                values[idx * 4 + 2] = Real(h_angmom.data[idx].z);
+                values[idx * 4 + 3] = Real(h_angmom.data[idx].w);
+                }
+            detail::store_field_by_tag(values, buffers.angmom, 4, plan);
+            }
+        }
+
+    if (selected & detail::field_inertia)
+        {
+        ArrayHandle<Scalar3> h_inertia(m_inertia, access_location::host, access_mode::read);
+        std::vector<Real> inertia(size_t(N) * 3);
+        for (unsigned int idx = 0; idx < N; idx++)
+            {
+            inertia[idx * 3 + 0] = Real(h_inertia.data[idx].x);
+            inertia[idx * 3 + 1] = Real(h_inertia.data[idx].y);
+            inertia[idx * 3 + 2] = Real(h_inertia.data[idx].z);
+            }
+        detail::store_field_by_tag(inertia, buffers.inertia, 3, plan);
+        }
+    }
+
+namespace detail
+    {
+//! Copy the first n elements of one array to another
+/*! \param dst Destination array, with at least n elements
+    \param src Source array
+    \param n Number of elements to copy
+    \param use_device True to copy in device memory
+*/
+template<class T>
+static void copy_checkpoint_array(const GlobalArray<T>& dst,
+                                  const GlobalArray<T>& src,
+                                  unsigned int n,
+                                  bool use_device)
+    {
+    if (n == 0)
+        return;
+    assert(dst.getNumElements() >= n);
+
+#ifdef ENABLE_HIP
+    if (use_device)
+        {
+        ArrayHandle<T> d_dst(dst, access_location::device, access_mode::readwrite);
+        ArrayHandle<T> d_src(src, access_location::device, access_mode::read);
+        hipMemcpy(d_dst.data, d_src.data, sizeof(T) * n, hipMemcpyDeviceToDevice);
+        return;
+        }
+#endif
+
+    ArrayHandle<T> h_dst(dst, access_location::host, access_mode::readwrite);
+    ArrayHandle<T> h_src(src, access_location::host, access_mode::read);
+    memcpy(h_dst.data, h_src.data, sizeof(T) * n);
+    }
+
+//! Copy the first n elements of an array into a checkpoint array, growing it if necessary
+template<class T>
+static void save_checkpoint_array(GlobalArray<T>& dst,
+                                  const GlobalArray<T>& src,
+                                  unsigned int n,
+                                  std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    {
+    if (dst.getNumElements() < n)
+        {
+        GlobalArray<T> array(n, exec_conf);
+        dst.swap(array);
+        }
+    copy_checkpoint_array(dst, src, n, exec_conf->isCUDAEnabled());
+    }
+    } // end namespace detail
+
+/*! \param checkpoint Checkpoint to write
+
+    Only the local particles are saved, ghost particles are not.
+*/
+void ParticleData::saveCheckpoint(ParticleDataCheckpoint& checkpoint)
+    {
+    checkpoint.N = m_nparticles;
+    checkpoint.nglobal = m_nglobal;
+    checkpoint.global_box = m_global_box;
+    checkpoint.origin = m_origin;
+    checkpoint.o_image = m_o_image;
+
+    const unsigned int N = m_nparticles;
+    detail::save_checkpoint_array(checkpoint.pos, m_pos, N, m_exec_conf);
+    detail::save_checkpoint_array(checkpoint.vel, m_vel, N, m_exec_conf);
+    detail::save_checkpoint_array(checkpoint.accel, m_accel, N, m_exec_conf);
+    detail::save_checkpoint_array(checkpoint.charge, m_charge, N, m_exec_conf);
+    detail::save_checkpoint_array(checkpoint.diameter, m_diameter, N, m_exec_conf);
+    detail::save_checkpoint_array(checkpoint.image, m_image, N, m_exec_conf);
+    detail::save_checkpoint_array(checkpoint.tag, m_tag, N, m_exec_conf);
+    detail::save_checkpoint_array(checkpoint.body, m_body, N, m_exec_conf);
+    detail::save_checkpoint_array(checkpoint.orientation, m_orientation, N, m_exec_conf);
+    detail::save_checkpoint_array(checkpoint.angmom, m_angmom, N, m_exec_conf);
+    detail::save_checkpoint_array(checkpoint.inertia, m_inertia, N, m_exec_conf);
+    detail::save_checkpoint_array(checkpoint.rtag,
+                                  static_cast<const GlobalArray<unsigned int>&>(m_rtag),
+                                  (unsigned int)m_rtag.size(),
+                                  m_exec_conf);
+    }
+
+/*! \param checkpoint Checkpoint to read
+
+    The particles are restored on the rank that saved them, without communication. All ghost
+    particles are removed and subscribers are notified of the particle sort and of the box change.
+    The number of particles in the system must not have changed since the checkpoint was saved.
+*/
+void ParticleData::restoreCheckpoint(const ParticleDataCheckpoint& checkpoint)
+    {
+    if (checkpoint.nglobal != m_nglobal || checkpoint.rtag.getNumElements() < m_rtag.size())
+        {
+        throw std::runtime_error("Cannot restore a checkpoint after the number of particles "
+                                 "changed.");
+        }
+
+    removeAllGhostParticles();
+    resize(checkpoint.N);
+
+    const unsigned int N = checkpoint.N;
+    const bool use_device = m_exec_conf->isCUDAEnabled();
+    detail::copy_checkpoint_array(m_pos, checkpoint.pos, N, use_device);
+    detail::copy_checkpoint_array(m_vel, checkpoint.vel, N, use_device);
+    detail::copy_checkpoint_array(m_accel, checkpoint.accel, N, use_device);
+    detail::copy_checkpoint_array(m_charge, checkpoint.charge, N, use_device);
+    detail::copy_checkpoint_array(m_diameter, checkpoint.diameter, N, use_device);
+    detail::copy_checkpoint_array(m_image, checkpoint.image, N, use_device);
+    detail::copy_checkpoint_array(m_tag, checkpoint.tag, N, use_device);
+    detail::copy_checkpoint_array(m_body, checkpoint.body, N, use_device);
+    detail::copy_checkpoint_array(m_orientation, checkpoint.orientation, N, use_device);
+    detail::copy_checkpoint_array(m_angmom, checkpoint.angmom, N, use_device);
+    detail::copy_checkpoint_array(m_inertia, checkpoint.inertia, N, use_device);
+    detail::copy_checkpoint_array(static_cast<const GlobalArray<unsigned int>&>(m_rtag),
+                                  checkpoint.rtag,
+                                  (unsigned int)m_rtag.size(),
+                                  use_device);
+
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        // the saved reverse lookup table may refer to ghost particles that no longer exist
+        ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+        for (unsigned int i = 0; i < m_rtag.size(); i++)
+            {
+            if (h_rtag.data[i] >= N && h_rtag.data[i] != NOT_LOCAL)
+                h_rtag.data[i] = NOT_LOCAL;
+            }
+        }
+#endif
+
+    m_origin = checkpoint.origin;
+    m_o_image = checkpoint.o_image;
+    setGlobalBox(checkpoint.global_box);
+
+    notifyParticleSort();
+    }
+
 //! Add ghost particles at the end of the local particle data
 /*! Ghost ptls are appended at the end of the particle data.
   Ghost particles have only incomplete particle information (position, charge, diameter) and
@@ -1606,6 +2837,8 @@ void ParticleData::addGhostParticles(const unsigned int nghosts)
 
     m_nghosts += nghosts;
 
+    m_peak_nparticles = std::max(m_peak_nparticles, m_nparticles + m_nghosts);
+
     if (m_nparticles + m_nghosts > max_nparticles)
         {
         while (m_nparticles + m_nghosts > max_nparticles)
@@ -2100,6 +3333,7 @@ void ParticleData::setPosition(unsigned int tag, const Scalar3& pos, bool move)
         h_pos.data[idx].y = tmp_pos.y;
         h_pos.data[idx].z = tmp_pos.z;
         h_image.data[idx] = img;
+        notifyPositionsChanged();
         }
 
 #ifdef ENABLE_MPI
@@ -2424,7 +3658,7 @@ unsigned int ParticleData::addParticle(unsigned int type)
         }
 
     // add to set of active tags
-    m_tag_set.insert(tag);
+    insertActiveTag(tag);
 
     // invalidate the active tag cache
     m_invalid_cached_tags = true;
@@ -2623,7 +3857,7 @@ void ParticleData::removeParticle(unsigned int tag)
         }
 
     // remove from set of active tags
-    m_tag_set.erase(tag);
+    eraseActiveTag(tag);
 
     // maintain a stack of deleted group tags for future recycling
     m_recycled_tags.push(tag);
@@ -2650,7 +3884,7 @@ unsigned int ParticleData::getNthTag(unsigned int n)
         throw std::runtime_error(s.str());
         }
 
-    assert(m_tag_set.size() == getNGlobal());
+    assert(m_n_active_tags == getNGlobal());
 
     // maybe_rebuild_tag_cache only rebuilds if necessary
     maybe_rebuild_tag_cache();
@@ -2720,6 +3954,8 @@ ParticleData::initializeFromSnapshot<double>(const SnapshotParticleData<double>&
                                              bool ignore_bodies);
 template std::map<unsigned int, unsigned int>
 ParticleData::takeSnapshot<double>(SnapshotParticleData<double>& snapshot);
+template void
+ParticleData::gatherSnapshotFields<double>(const SnapshotFieldBuffers<double>& buffers);
 
 template ParticleData::ParticleData(const SnapshotParticleData<float>& snapshot,
                                     const BoxDim& global_box,
@@ -2730,6 +3966,8 @@ ParticleData::initializeFromSnapshot<float>(const SnapshotParticleData<float>& s
                                             bool ignore_bodies);
 template std::map<unsigned int, unsigned int>
 ParticleData::takeSnapshot<float>(SnapshotParticleData<float>& snapshot);
+template void
+ParticleData::gatherSnapshotFields<float>(const SnapshotFieldBuffers<float>& buffers);
 
 namespace detail
     {
@@ -2751,6 +3989,11 @@ void export_ParticleData(pybind11::module& m)
         .def("getNGlobal", &ParticleData::getNGlobal)
         .def("getNTypes", &ParticleData::getNTypes)
         .def("getMaxDiameter", &ParticleData::getMaxDiameter)
+        .def("getMaxN", &ParticleData::getMaxN)
+        .def("setResizeFactor", &ParticleData::setResizeFactor)
+        .def("getResizeFactor", &ParticleData::getResizeFactor)
+        .def("setShrinkThreshold", &ParticleData::setShrinkThreshold)
+        .def("getShrinkThreshold", &ParticleData::getShrinkThreshold)
         .def("getNameByType", &ParticleData::getNameByType)
         .def("getTypeByName", &ParticleData::getTypeByName)
         .def("setTypeName", &ParticleData::setTypeName)
@@ -2786,6 +4029,9 @@ void export_ParticleData(pybind11::module& m)
         .def("setPressureFlag", &ParticleData::setPressureFlag)
         .def("getMaximumTag", &ParticleData::getMaximumTag)
         .def("addParticle", &ParticleData::addParticle)
+        .def("reserveParticles", &ParticleData::reserveParticles)
+        .def("beginParticleNumberBatch", &ParticleData::beginParticleNumberBatch)
+        .def("endParticleNumberBatch", &ParticleData::endParticleNumberBatch)
         .def("removeParticle", &ParticleData::removeParticle)
         .def("getNthTag", &ParticleData::getNthTag)
 #ifdef ENABLE_MPI
@@ -3482,247 +4728,52 @@ void ParticleData::addParticlesGPU(const GlobalVector<detail::pdata_element>& in
 #endif // ENABLE_HIP
 #endif // ENABLE_MPI
 
+/*! Sets the preferred location of each GPU's particles when the arrays were reallocated, and
+    migrates the pages of the particles that each GPU owns to it on every call. Sorts reorder the
+    particles on one device, and without the migration the next kernels on the other GPUs fault
+    on every page they touch.
+*/
 void ParticleData::setGPUAdvice()
     {
 #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
-    if (m_exec_conf->isCUDAEnabled())
-        {
-        // only call CUDA API when necessary
-        if (m_memory_advice_last_Nmax == m_max_nparticles)
-            return;
-
-        m_memory_advice_last_Nmax = m_max_nparticles;
-
-        auto gpu_map = m_exec_conf->getGPUIds();
-
-        if (!m_exec_conf->allConcurrentManagedAccess())
-            return;
-
-        // split preferred location of particle data across GPUs
-        for (unsigned int idev = 0; idev < m_exec_conf->getNumActiveGPUs(); ++idev)
-            {
-            auto range = m_gpu_partition.getRange(idev);
-            unsigned int nelem = range.second - range.first;
-
-            if (!nelem)
-                continue;
-
-            cudaMemAdvise(m_pos.get() + range.first,
-                          sizeof(Scalar4) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_vel.get() + range.first,
-                          sizeof(Scalar4) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_accel.get() + range.first,
-                          sizeof(Scalar3) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_charge.get() + range.first,
-                          sizeof(Scalar) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_diameter.get() + range.first,
-                          sizeof(Scalar) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_image.get() + range.first,
-                          sizeof(int3) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_tag.get() + range.first,
-                          sizeof(unsigned int) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_body.get() + range.first,
-                          sizeof(unsigned int) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_orientation.get() + range.first,
-                          sizeof(Scalar4) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_angmom.get() + range.first,
-                          sizeof(Scalar4) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_inertia.get() + range.first,
-                          sizeof(Scalar3) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_net_force.get() + range.first,
-                          sizeof(Scalar4) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            for (unsigned int i = 0; i < 6; ++i)
-                cudaMemAdvise(m_net_virial.get() + i * m_net_virial.getPitch() + range.first,
-                              sizeof(Scalar) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-            cudaMemAdvise(m_net_torque.get() + range.first,
-                          sizeof(Scalar4) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-
-            // migrate data to preferred location
-            cudaMemPrefetchAsync(m_pos.get() + range.first, sizeof(Scalar4) * nelem, gpu_map[idev]);
-            cudaMemPrefetchAsync(m_vel.get() + range.first, sizeof(Scalar4) * nelem, gpu_map[idev]);
-            cudaMemPrefetchAsync(m_accel.get() + range.first,
-                                 sizeof(Scalar3) * nelem,
-                                 gpu_map[idev]);
-            cudaMemPrefetchAsync(m_charge.get() + range.first,
-                                 sizeof(Scalar) * nelem,
-                                 gpu_map[idev]);
-            cudaMemPrefetchAsync(m_diameter.get() + range.first,
-                                 sizeof(Scalar) * nelem,
-                                 gpu_map[idev]);
-            cudaMemPrefetchAsync(m_image.get() + range.first, sizeof(int3) * nelem, gpu_map[idev]);
-            cudaMemPrefetchAsync(m_tag.get() + range.first,
-                                 sizeof(unsigned int) * nelem,
-                                 gpu_map[idev]);
-            cudaMemPrefetchAsync(m_body.get() + range.first,
-                                 sizeof(unsigned int) * nelem,
-                                 gpu_map[idev]);
-            cudaMemPrefetchAsync(m_orientation.get() + range.first,
-                                 sizeof(Scalar4) * nelem,
-                                 gpu_map[idev]);
-            cudaMemPrefetchAsync(m_angmom.get() + range.first,
-                                 sizeof(Scalar4) * nelem,
-                                 gpu_map[idev]);
-            cudaMemPrefetchAsync(m_inertia.get() + range.first,
-                                 sizeof(Scalar3) * nelem,
-                                 gpu_map[idev]);
-            cudaMemPrefetchAsync(m_net_force.get() + range.first,
-                                 sizeof(Scalar4) * nelem,
-                                 gpu_map[idev]);
-            for (unsigned int i = 0; i < 6; ++i)
-                cudaMemPrefetchAsync(m_net_virial.get() + i * m_net_virial.getPitch() + range.first,
-                                     sizeof(Scalar) * nelem,
-                                     gpu_map[idev]);
-            cudaMemPrefetchAsync(m_net_torque.get() + range.first,
-                                 sizeof(Scalar4) * nelem,
-                                 gpu_map[idev]);
-            }
-        CHECK_CUDA_ERROR();
-
-        if (!m_pos_alt.isNull())
-            {
-            for (unsigned int idev = 0; idev < m_exec_conf->getNumActiveGPUs(); ++idev)
-                {
-                auto range = m_gpu_partition.getRange(idev);
-                unsigned int nelem = range.second - range.first;
-
-                if (!nelem)
-                    continue;
-
-                cudaMemAdvise(m_pos_alt.get() + range.first,
-                              sizeof(Scalar4) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_vel_alt.get() + range.first,
-                              sizeof(Scalar4) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_accel_alt.get() + range.first,
-                              sizeof(Scalar3) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_charge_alt.get() + range.first,
-                              sizeof(Scalar) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_diameter_alt.get() + range.first,
-                              sizeof(Scalar) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_image_alt.get() + range.first,
-                              sizeof(int3) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_tag_alt.get() + range.first,
-                              sizeof(unsigned int) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_body_alt.get() + range.first,
-                              sizeof(unsigned int) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_orientation_alt.get() + range.first,
-                              sizeof(Scalar4) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_angmom_alt.get() + range.first,
-                              sizeof(Scalar4) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_inertia_alt.get() + range.first,
-                              sizeof(Scalar3) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_net_force_alt.get() + range.first,
-                              sizeof(Scalar4) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                for (unsigned int i = 0; i < 6; ++i)
-                    cudaMemAdvise(m_net_virial_alt.get() + i * m_net_virial_alt.getPitch()
-                                      + range.first,
-                                  sizeof(Scalar) * nelem,
-                                  cudaMemAdviseSetPreferredLocation,
-                                  gpu_map[idev]);
-                cudaMemAdvise(m_net_torque_alt.get() + range.first,
-                              sizeof(Scalar4) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-
-                cudaMemPrefetchAsync(m_pos_alt.get() + range.first,
-                                     sizeof(Scalar4) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_vel_alt.get() + range.first,
-                                     sizeof(Scalar4) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_accel_alt.get() + range.first,
-                                     sizeof(Scalar3) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_charge_alt.get() + range.first,
-                                     sizeof(Scalar) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_diameter_alt.get() + range.first,
-                                     sizeof(Scalar) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_image_alt.get() + range.first,
-                                     sizeof(int3) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_tag_alt.get() + range.first,
-                                     sizeof(unsigned int) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_body_alt.get() + range.first,
-                                     sizeof(unsigned int) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_orientation_alt.get() + range.first,
-                                     sizeof(Scalar4) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_angmom_alt.get() + range.first,
-                                     sizeof(Scalar4) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_inertia_alt.get() + range.first,
-                                     sizeof(Scalar3) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_net_force_alt.get() + range.first,
-                                     sizeof(Scalar4) * nelem,
-                                     gpu_map[idev]);
-                for (unsigned int i = 0; i < 6; ++i)
-                    cudaMemPrefetchAsync(m_net_virial_alt.get() + i * m_net_virial_alt.getPitch()
-                                             + range.first,
-                                         sizeof(Scalar) * nelem,
-                                         gpu_map[idev]);
-                cudaMemPrefetchAsync(m_net_torque_alt.get() + range.first,
-                                     sizeof(Scalar4) * nelem,
-                                     gpu_map[idev]);
-                }
+    if (!m_exec_conf->isCUDAEnabled() || !m_exec_conf->allConcurrentManagedAccess())
+        return;
 
-            CHECK_CUDA_ERROR();
-            }
+    bool reallocated = m_memory_advice_last_Nmax != m_max_nparticles;
+    m_memory_advice_last_Nmax = m_max_nparticles;
+
+    m_pos.prefetchPartition(m_gpu_partition, reallocated);
+    m_vel.prefetchPartition(m_gpu_partition, reallocated);
+    m_accel.prefetchPartition(m_gpu_partition, reallocated);
+    m_charge.prefetchPartition(m_gpu_partition, reallocated);
+    m_diameter.prefetchPartition(m_gpu_partition, reallocated);
+    m_image.prefetchPartition(m_gpu_partition, reallocated);
+    m_tag.prefetchPartition(m_gpu_partition, reallocated);
+    m_body.prefetchPartition(m_gpu_partition, reallocated);
+    m_orientation.prefetchPartition(m_gpu_partition, reallocated);
+    m_angmom.prefetchPartition(m_gpu_partition, reallocated);
+    m_inertia.prefetchPartition(m_gpu_partition, reallocated);
+    m_net_force.prefetchPartition(m_gpu_partition, reallocated);
+    m_net_virial.prefetchPartition(m_gpu_partition, reallocated);
+    m_net_torque.prefetchPartition(m_gpu_partition, reallocated);
+
+    // the swap-in arrays are overwritten before they are read, they only need the advice
+    if (reallocated && !m_pos_alt.isNull())
+        {
+        m_pos_alt.prefetchPartition(m_gpu_partition, true);
+        m_vel_alt.prefetchPartition(m_gpu_partition, true);
+        m_accel_alt.prefetchPartition(m_gpu_partition, true);
+        m_charge_alt.prefetchPartition(m_gpu_partition, true);
+        m_diameter_alt.prefetchPartition(m_gpu_partition, true);
+        m_image_alt.prefetchPartition(m_gpu_partition, true);
+        m_tag_alt.prefetchPartition(m_gpu_partition, true);
+        m_body_alt.prefetchPartition(m_gpu_partition, true);
+        m_orientation_alt.prefetchPartition(m_gpu_partition, true);
+        m_angmom_alt.prefetchPartition(m_gpu_partition, true);
+        m_inertia_alt.prefetchPartition(m_gpu_partition, true);
+        m_net_force_alt.prefetchPartition(m_gpu_partition, true);
+        m_net_virial_alt.prefetchPartition(m_gpu_partition, true);
+        m_net_torque_alt.prefetchPartition(m_gpu_partition, true);
         }
 #endif
     }
@@ -494,3 +494,52 @@ void gpu_pdata_add_particles(const unsigned int old_nparticles,
     } // end namespace hoomd
 
 #endif // ENABLE_MPI
+
+namespace hoomd
+    {
+namespace kernel
+    {
+//! Kernel to gather the group membership masks by particle index
+__global__ void gpu_gather_group_membership_kernel(const unsigned int N,
+                                                   const unsigned int* d_tag,
+                                                   const uint64_t* d_group_membership_tag,
+                                                   uint64_t* d_group_membership)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    d_group_membership[idx] = d_group_membership_tag[d_tag[idx]];
+    }
+
+/*! \param N Number of local particles
+    \param d_tag Device array of particle tags
+    \param d_group_membership_tag Device array of group membership masks indexed by tag
+    \param d_group_membership Device array of group membership masks indexed by particle (output)
+*/
+void gpu_gather_group_membership(const unsigned int N,
+                                 const unsigned int* d_tag,
+                                 const uint64_t* d_group_membership_tag,
+                                 uint64_t* d_group_membership)
+    {
+    if (N == 0)
+        return;
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = N / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_gather_group_membership_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       N,
+                       d_tag,
+                       d_group_membership_tag,
+                       d_group_membership);
+    }
+
+    } // end namespace kernel
+
+    } // end namespace hoomd
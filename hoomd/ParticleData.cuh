@@ -121,6 +121,12 @@ void gpu_pdata_add_particles(const unsigned int old_nparticles,
                              unsigned int* d_rtag,
                              const detail::pdata_element* d_in,
                              unsigned int* d_comm_flags);
+
+//! Gather the group membership masks of the local particles from the masks by tag
+void gpu_gather_group_membership(const unsigned int N,
+                                 const unsigned int* d_tag,
+                                 const uint64_t* d_group_membership_tag,
+                                 uint64_t* d_group_membership);
     } // end namespace kernel
 
     } // end namespace hoomd
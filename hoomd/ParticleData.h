@@ -44,6 +44,7 @@
 #include "DomainDecomposition.h"
 
 #include <bitset>
+#include <functional>
 #include <map>
 #include <stack>
 #include <stdlib.h>
@@ -83,8 +84,9 @@ struct pdata_flag
         {
         pressure_tensor = 0,       //!< Bit id in PDataFlags for the full virial
         rotational_kinetic_energy, //!< Bit id in PDataFlags for the rotational kinetic energy
-        external_field_virial      //!< Bit id in PDataFlags for the external virial contribution of
+        external_field_virial,     //!< Bit id in PDataFlags for the external virial contribution of
                                    //!< volume change
+        potential_energy           //!< Bit id in PDataFlags for the per-particle potential energy
         };
     };
 
@@ -92,6 +94,31 @@ struct pdata_flag
 //! valid
 typedef std::bitset<32> PDataFlags;
 
+//! Caller-provided destinations of ParticleData::gatherSnapshotFields
+/*! Each non-null pointer selects a field to gather. Every selected buffer must hold the given
+    number of values for each of the N global particles, in tag order, just like the arrays in
+    SnapshotParticleData. Buffers are only written on the root rank and may be null elsewhere.
+
+    Positions are shifted and wrapped into the global box the same way as in takeSnapshot.
+    Orientations and angular momenta are stored as (s, v.x, v.y, v.z).
+*/
+template<class Real> struct SnapshotFieldBuffers
+    {
+    unsigned int* tag = nullptr;  //!< Tags (1 per particle)
+    Real* pos = nullptr;          //!< Positions (3 per particle)
+    Real* vel = nullptr;          //!< Velocities (3 per particle)
+    Real* accel = nullptr;        //!< Accelerations (3 per particle)
+    unsigned int* type = nullptr; //!< Type ids (1 per particle)
+    Real* mass = nullptr;         //!< Masses (1 per particle)
+    Real* charge = nullptr;       //!< Charges (1 per particle)
+    Real* diameter = nullptr;     //!< Diameters (1 per particle)
+    int* image = nullptr;         //!< Images (3 per particle)
+    unsigned int* body = nullptr; //!< Body ids (1 per particle)
+    Real* orientation = nullptr;  //!< Orientations (4 per particle)
+    Real* angmom = nullptr;       //!< Angular momenta (4 per particle)
+    Real* inertia = nullptr;      //!< Moments of inertia (3 per particle)
+    };
+
 //! Defines a simple structure to deal with complex numbers
 /*! This structure is useful to deal with complex numbers for such situations
     as Fourier transforms. Note that we do not need any to define any operations and the
@@ -285,6 +312,34 @@ struct pdata_element
 
     } // end namespace detail
 
+//! Rank-local copy of the particle data arrays
+/*! ParticleData::saveCheckpoint() copies the local particles into the arrays of a checkpoint and
+    ParticleData::restoreCheckpoint() copies them back. The arrays are allocated in the same memory
+    space as the particle data, so both operations are device (or host) memory copies without
+    communication.
+*/
+struct PYBIND11_EXPORT ParticleDataCheckpoint
+    {
+    unsigned int N = 0;       //!< Number of local particles
+    unsigned int nglobal = 0; //!< Global number of particles
+    BoxDim global_box;        //!< Global simulation box
+    Scalar3 origin;           //!< Origin of the coordinate system
+    int3 o_image;             //!< Image of the origin
+
+    GlobalArray<Scalar4> pos;         //!< Positions and types
+    GlobalArray<Scalar4> vel;         //!< Velocities and masses
+    GlobalArray<Scalar3> accel;       //!< Accelerations
+    GlobalArray<Scalar> charge;       //!< Charges
+    GlobalArray<Scalar> diameter;     //!< Diameters
+    GlobalArray<int3> image;          //!< Images
+    GlobalArray<unsigned int> tag;    //!< Tags
+    GlobalArray<unsigned int> rtag;   //!< Reverse lookup tags
+    GlobalArray<unsigned int> body;   //!< Rigid body ids
+    GlobalArray<Scalar4> orientation; //!< Orientations
+    GlobalArray<Scalar4> angmom;      //!< Angular momenta
+    GlobalArray<Scalar3> inertia;     //!< Principal moments of inertia
+    };
+
 //! Manages all of the data arrays for the particles
 /*! <h1> General </h1>
     ParticleData stores and manages particle coordinates, velocities, accelerations, type,
@@ -333,6 +388,7 @@ struct pdata_element
     These fields are:
      - pdata_flag::pressure_tensor - specify that the full virial tensor is valid
      - pdata_flag::external_field_virial - specify that an external virial contribution is valid
+     - pdata_flag::potential_energy - specify that the per-particle potential energy is valid
 
     If these flags are not set, these arrays can still be read but their values may be incorrect.
 
@@ -881,6 +937,24 @@ class PYBIND11_EXPORT ParticleData
     //! Notify listeners that the particles have been rearranged in memory
     void notifyParticleSort();
 
+    //! Get the version of the particle positions
+    /*! The version changes every time the positions, types, order, or number of the local and
+        ghost particles may have changed. Data structures built from the positions (such as the
+        SpatialIndex) may be reused as long as the version is unchanged.
+    */
+    uint64_t getPositionVersion() const
+        {
+        return m_position_version;
+        }
+
+    //! Notify that the positions of the local or ghost particles have changed
+    /*! Any class that writes to the positions must call this before the positions are used again.
+     */
+    void notifyPositionsChanged()
+        {
+        m_position_version++;
+        }
+
     //! Connects a function to be called every time the box size is changed
     Nano::Signal<void()>& getBoxChangeSignal()
         {
@@ -899,6 +973,91 @@ class PYBIND11_EXPORT ParticleData
         return m_max_particle_num_signal;
         }
 
+    //! Set the factor by which the particle data arrays grow
+    void setResizeFactor(float resize_factor);
+
+    //! Get the factor by which the particle data arrays grow
+    float getResizeFactor() const
+        {
+        return m_resize_factor;
+        }
+
+    //! Set the fraction of the capacity below which the particle data arrays are shrunk
+    void setShrinkThreshold(float shrink_threshold);
+
+    //! Get the fraction of the capacity below which the particle data arrays are shrunk
+    float getShrinkThreshold() const
+        {
+        return m_shrink_threshold;
+        }
+
+    //! Begin a batch of changes to the particle number
+    /*! Inside a batch, reallocations of the particle data arrays do not emit the maximum particle
+        number change signal. It is emitted once by the matching endCapacityBatch() if the capacity
+        has changed. Batches may be nested.
+    */
+    void beginCapacityBatch()
+        {
+        m_capacity_batch_depth++;
+        }
+
+    //! End a batch of changes to the particle number
+    void endCapacityBatch()
+        {
+        assert(m_capacity_batch_depth > 0);
+        m_capacity_batch_depth--;
+        if (m_capacity_batch_depth == 0 && m_capacity_change_pending)
+            {
+            m_capacity_change_pending = false;
+            m_max_particle_num_signal.emit();
+            }
+        }
+
+    //! Begin a batch of particle insertions and removals
+    /*! Inside a batch, addParticle(), removeParticle(), and setNGlobal() do not emit the global
+        particle number change signal. It is emitted once by the matching
+        endParticleNumberBatch() if the global number of particles has changed, so that groups and
+        neighbor list exclusions are rebuilt once. Subscribers to the signal must not be used
+        inside the batch. Batches may be nested.
+    */
+    void beginParticleNumberBatch()
+        {
+        m_particle_number_batch_depth++;
+        }
+
+    //! End a batch of particle insertions and removals
+    void endParticleNumberBatch();
+
+    //! Reserve memory for particles that are about to be added
+    void reserveParticles(unsigned int n);
+
+    //! Reserve a bit in the shared group membership masks
+    unsigned int acquireGroupMembershipBit();
+
+    //! Release a bit reserved with acquireGroupMembershipBit()
+    void releaseGroupMembershipBit(unsigned int bit);
+
+    //! Get the group membership masks indexed by tag
+    /*! Bit b of the mask of a tag is set when the particle is a member of the group that reserved
+        bit b. Groups that change their bit must call notifyGroupMembershipChange().
+    */
+    GlobalArray<uint64_t>& getGroupMembershipByTag();
+
+    //! Get the group membership masks indexed by particle
+    /*! The masks are gathered from the masks by tag the first time they are requested after the
+        particles are sorted or a group changes its members.
+    */
+    const GlobalArray<uint64_t>& getGroupMembership();
+
+    //! Notify that a group has changed its bit in the group membership masks
+    void notifyGroupMembershipChange()
+        {
+        m_group_membership_valid = false;
+        }
+
+    //! Returned by acquireGroupMembershipBit() when all bits are in use
+    static const unsigned int NO_GROUP_MEMBERSHIP_BIT = 0xffffffff;
+
     //! Connects a function to be called every time the ghost particles become invalid
     Nano::Signal<void()>& getGhostParticlesRemovedSignal()
         {
@@ -1043,8 +1202,7 @@ class PYBIND11_EXPORT ParticleData
     //! Return true if the tag is active
     bool isTagActive(unsigned int tag) const
         {
-        std::set<unsigned int>::const_iterator it = m_tag_set.find(tag);
-        return it != m_tag_set.end();
+        return tag < m_tag_active.size() && m_tag_active[tag];
         }
 
     /*! Return the maximum particle tag in the simulation
@@ -1052,10 +1210,10 @@ class PYBIND11_EXPORT ParticleData
      */
     unsigned int getMaximumTag() const
         {
-        if (m_tag_set.empty())
+        if (m_n_active_tags == 0)
             return UINT_MAX;
         else
-            return *m_tag_set.rbegin();
+            return m_max_active_tag;
         }
 
     //! Get the orientation of a particle with a given tag
@@ -1171,10 +1329,33 @@ class PYBIND11_EXPORT ParticleData
     void initializeFromSnapshot(const SnapshotParticleData<Real>& snapshot,
                                 bool ignore_bodies = false);
 
+    //! Initialize from snapshot windows read on the root rank
+    void initializeFromWindows(
+        unsigned int nglobal,
+        const std::vector<std::string>& type_mapping,
+        unsigned int window_size,
+        const std::function<void(unsigned int, SnapshotParticleData<float>&)>& read_window);
+
+    //! Initialize from particles generated on each rank
+    void initializeFromLocal(
+        unsigned int nglobal,
+        const std::vector<std::string>& type_mapping,
+        const std::function<void(SnapshotParticleData<Scalar>&, std::vector<unsigned int>&)>&
+            generate);
+
     //! Take a snapshot
     template<class Real>
     std::map<unsigned int, unsigned int> takeSnapshot(SnapshotParticleData<Real>& snapshot);
 
+    //! Gather selected fields of all particles on the root rank
+    template<class Real> void gatherSnapshotFields(const SnapshotFieldBuffers<Real>& buffers);
+
+    //! Copy the local particles into a checkpoint
+    void saveCheckpoint(ParticleDataCheckpoint& checkpoint);
+
+    //! Replace the local particles with the contents of a checkpoint
+    void restoreCheckpoint(const ParticleDataCheckpoint& checkpoint);
+
     //! Add ghost particles at the end of the local particle data
     void addGhostParticles(const unsigned int nghosts);
 
@@ -1183,6 +1364,7 @@ class PYBIND11_EXPORT ParticleData
         {
         // reset ghost particle number
         m_nghosts = 0;
+        notifyPositionsChanged();
 
         notifyGhostParticlesRemoved();
         }
@@ -1250,6 +1432,9 @@ class PYBIND11_EXPORT ParticleData
 #endif // ENABLE_MPI
 
     //! Add a single particle to the simulation
+    /*! To add many particles, call reserveParticles() first and add them inside a particle number
+        batch.
+    */
     unsigned int addParticle(unsigned int type);
 
     //! Remove a particle from the simulation
@@ -1320,11 +1505,12 @@ class PYBIND11_EXPORT ParticleData
         m_ptl_move_signal; //!< Signal when particle moves between domains
 #endif
 
-    unsigned int m_nparticles;     //!< number of particles
-    unsigned int m_nghosts;        //!< number of ghost particles
-    unsigned int m_max_nparticles; //!< maximum number of particles
-    unsigned int m_nglobal;        //!< global number of particles
-    bool m_accel_set;              //!< Flag to tell if acceleration data has been set
+    unsigned int m_nparticles;       //!< number of particles
+    unsigned int m_nghosts;          //!< number of ghost particles
+    uint64_t m_position_version = 0; //!< Version of the particle positions
+    unsigned int m_max_nparticles;   //!< maximum number of particles
+    unsigned int m_nglobal;          //!< global number of particles
+    bool m_accel_set;                //!< Flag to tell if acceleration data has been set
 
     // per-particle data
     GlobalArray<Scalar4> m_pos;        //!< particle positions and types
@@ -1343,7 +1529,9 @@ class PYBIND11_EXPORT ParticleData
     GlobalArray<unsigned int> m_comm_flags; //!< Array of communication flags
 
     std::stack<unsigned int> m_recycled_tags; //!< Global tags of removed particles
-    std::set<unsigned int> m_tag_set;         //!< Lookup table for tags by active index
+    std::vector<bool> m_tag_active;           //!< True for the tags of the particles
+    unsigned int m_n_active_tags = 0;         //!< Number of active tags
+    unsigned int m_max_active_tag = 0;        //!< Largest active tag, valid if there are any
     std::vector<unsigned int>
         m_cached_tag_set;       //!< Cached constant-time lookup table for tags by active index
     bool m_invalid_cached_tags; //!< true if m_cached_tag_set needs to be rebuilt
@@ -1382,9 +1570,25 @@ class PYBIND11_EXPORT ParticleData
 
     Scalar m_external_virial[6]; //!< External potential contribution to the virial
     Scalar m_external_energy;    //!< External potential energy
-    const float
-        m_resize_factor; //!< The numerical factor with which the particle data arrays are resized
-    PDataFlags m_flags;  //!< Flags identifying which optional fields are valid
+    float m_resize_factor;    //!< Factor by which the particle data arrays grow
+    float m_shrink_threshold; //!< Fraction of the capacity below which the arrays are shrunk
+    unsigned int m_peak_nparticles;      //!< Largest N + ghosts since the last capacity check
+    unsigned int m_num_resizes;          //!< Calls to resize() since the last capacity check
+    unsigned int m_capacity_batch_depth; //!< Nesting depth of capacity batches
+    bool m_capacity_change_pending;      //!< True if the capacity changed inside a batch
+
+    unsigned int m_particle_number_batch_depth; //!< Nesting depth of particle number batches
+    bool m_particle_number_change_pending;      //!< True if the global number changed in a batch
+
+    PDataFlags m_flags;                  //!< Flags identifying which optional fields are valid
+
+    //! Number of calls to resize() between checks for shrinking the arrays
+    static const unsigned int SHRINK_CHECK_PERIOD = 100;
+
+    GlobalArray<uint64_t> m_group_membership_tag; //!< Group membership masks indexed by tag
+    GlobalArray<uint64_t> m_group_membership;     //!< Group membership masks indexed by particle
+    uint64_t m_group_membership_bits;             //!< Bits reserved in the membership masks
+    bool m_group_membership_valid; //!< True if m_group_membership matches the current sort order
 
     Scalar3 m_origin; //!< Tracks the position of the origin of the coordinate system
     int3 m_o_image;   //!< Tracks the origin image
@@ -1411,12 +1615,29 @@ class PYBIND11_EXPORT ParticleData
     //! Helper function to rebuild the active tag cache if necessary
     void maybe_rebuild_tag_cache();
 
+    //! Mark a tag as active
+    void insertActiveTag(unsigned int tag);
+
+    //! Mark a tag as inactive
+    void eraseActiveTag(unsigned int tag);
+
+    //! Mark all tags as inactive
+    void clearActiveTags();
+
     //! Helper function to check that particles of a snapshot are in the box
     /*! \return true If and only if all particles are in the simulation box
      * \param Snapshot to check
      */
     template<class Real> bool inBox(const SnapshotParticleData<Real>& snap);
 
+#ifdef ENABLE_MPI
+    //! Find the rank that a snapshot particle is placed into
+    unsigned int placeSnapshotParticle(Scalar3& pos,
+                                       int3& img,
+                                       unsigned int snap_idx,
+                                       const unsigned int* cart_ranks);
+#endif
+
     //! Update the CUDA memory hints
     void setGPUAdvice();
     };
@@ -1446,6 +1667,8 @@ class PYBIND11_EXPORT LocalParticleData : public LocalDataAccess<Output, Particl
 
     Output getPosition(GhostDataFlag flag)
         {
+        // the caller may write to the buffer
+        this->m_data.notifyPositionsChanged();
         return this->template getBuffer<Scalar4, Scalar>(m_position_handle,
                                                          &ParticleData::getPositions,
                                                          flag,
@@ -1454,6 +1677,7 @@ class PYBIND11_EXPORT LocalParticleData : public LocalDataAccess<Output, Particl
 
     Output getTypes(GhostDataFlag flag)
         {
+        this->m_data.notifyPositionsChanged();
         return this->template getBuffer<Scalar4, int>(m_position_handle,
                                                       &ParticleData::getPositions,
                                                       flag,
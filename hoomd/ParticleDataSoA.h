@@ -0,0 +1,238 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ParticleDataSoA.h
+    \brief Defines the ParticleDataSoA class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "GlobalArray.h"
+#include "ParticleData.h"
+
+#include <memory>
+
+#ifndef __PARTICLE_DATA_SOA_H__
+#define __PARTICLE_DATA_SOA_H__
+
+namespace hoomd
+    {
+//! Structure of arrays mirror of the particle positions, velocities, and diameters
+/*! ParticleData stores positions and types packed in Scalar4, and velocities and masses packed in
+    Scalar4. That layout coalesces well on the GPU, but CPU kernels that vectorize over particles,
+    or only read the positions, load the whole Scalar4 for every particle.
+
+    ParticleDataSoA mirrors selected fields into separate contiguous arrays: x, y, z, and type from
+    the positions; vx, vy, vz, and mass from the velocities; and the diameters. The velocity and
+    diameter components are stored as \a VelocityReal and \a DiameterReal, so kernels that tolerate
+    single precision can read half the bytes.
+
+    The mirror is a cache, not the primary storage. Call updatePositions(), updateVelocities(), or
+    updateDiameters() after the corresponding ParticleData arrays change (typically once at the
+    start of a compute) and before reading the mirrored arrays. The mirror covers local and ghost
+    particles and follows changes of the maximum particle number. The arrays of a field are
+    allocated by its first update, so fields that are never mirrored cost no memory.
+
+    \tparam VelocityReal Floating point type used to store the velocities (float or Scalar)
+    \tparam DiameterReal Floating point type used to store the diameters (float or Scalar)
+
+    \ingroup data_structs
+*/
+template<class VelocityReal = Scalar, class DiameterReal = Scalar> class ParticleDataSoA
+    {
+    public:
+    //! Constructor
+    /*! \param pdata Particle data to mirror
+     */
+    ParticleDataSoA(std::shared_ptr<ParticleData> pdata)
+        : m_pdata(pdata), m_exec_conf(pdata->getExecConf())
+        {
+        m_pdata->getMaxParticleNumberChangeSignal()
+            .template connect<ParticleDataSoA, &ParticleDataSoA::reallocate>(this);
+        }
+
+    //! Destructor
+    ~ParticleDataSoA()
+        {
+        m_pdata->getMaxParticleNumberChangeSignal()
+            .template disconnect<ParticleDataSoA, &ParticleDataSoA::reallocate>(this);
+        }
+
+    //! Copy the positions and types of the local and ghost particles into the mirror
+    void updatePositions()
+        {
+        allocate(m_x);
+        allocate(m_y);
+        allocate(m_z);
+        allocate(m_type);
+
+        unsigned int n = m_pdata->getN() + m_pdata->getNGhosts();
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar> h_x(m_x, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_y(m_y, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_z(m_z, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_type(m_type, access_location::host, access_mode::overwrite);
+
+        for (unsigned int i = 0; i < n; i++)
+            {
+            Scalar4 postype = h_pos.data[i];
+            h_x.data[i] = postype.x;
+            h_y.data[i] = postype.y;
+            h_z.data[i] = postype.z;
+            h_type.data[i] = __scalar_as_int(postype.w);
+            }
+        }
+
+    //! Copy the velocities and masses of the local and ghost particles into the mirror
+    void updateVelocities()
+        {
+        allocate(m_vx);
+        allocate(m_vy);
+        allocate(m_vz);
+        allocate(m_mass);
+
+        unsigned int n = m_pdata->getN() + m_pdata->getNGhosts();
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<VelocityReal> h_vx(m_vx, access_location::host, access_mode::overwrite);
+        ArrayHandle<VelocityReal> h_vy(m_vy, access_location::host, access_mode::overwrite);
+        ArrayHandle<VelocityReal> h_vz(m_vz, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_mass(m_mass, access_location::host, access_mode::overwrite);
+
+        for (unsigned int i = 0; i < n; i++)
+            {
+            Scalar4 velmass = h_vel.data[i];
+            h_vx.data[i] = VelocityReal(velmass.x);
+            h_vy.data[i] = VelocityReal(velmass.y);
+            h_vz.data[i] = VelocityReal(velmass.z);
+            h_mass.data[i] = velmass.w;
+            }
+        }
+
+    //! Copy the diameters of the local and ghost particles into the mirror
+    void updateDiameters()
+        {
+        allocate(m_diameter);
+
+        unsigned int n = m_pdata->getN() + m_pdata->getNGhosts();
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<DiameterReal> h_d(m_diameter, access_location::host, access_mode::overwrite);
+
+        for (unsigned int i = 0; i < n; i++)
+            h_d.data[i] = DiameterReal(h_diameter.data[i]);
+        }
+
+    //! Get the x coordinates
+    const GlobalArray<Scalar>& getX() const
+        {
+        return m_x;
+        }
+
+    //! Get the y coordinates
+    const GlobalArray<Scalar>& getY() const
+        {
+        return m_y;
+        }
+
+    //! Get the z coordinates
+    const GlobalArray<Scalar>& getZ() const
+        {
+        return m_z;
+        }
+
+    //! Get the particle types
+    const GlobalArray<unsigned int>& getTypes() const
+        {
+        return m_type;
+        }
+
+    //! Get the x components of the velocities
+    const GlobalArray<VelocityReal>& getVelocityX() const
+        {
+        return m_vx;
+        }
+
+    //! Get the y components of the velocities
+    const GlobalArray<VelocityReal>& getVelocityY() const
+        {
+        return m_vy;
+        }
+
+    //! Get the z components of the velocities
+    const GlobalArray<VelocityReal>& getVelocityZ() const
+        {
+        return m_vz;
+        }
+
+    //! Get the masses
+    const GlobalArray<Scalar>& getMasses() const
+        {
+        return m_mass;
+        }
+
+    //! Get the diameters
+    const GlobalArray<DiameterReal>& getDiameters() const
+        {
+        return m_diameter;
+        }
+
+    private:
+    std::shared_ptr<ParticleData> m_pdata;                     //!< Mirrored particle data
+    std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
+
+    GlobalArray<Scalar> m_x;              //!< x coordinates
+    GlobalArray<Scalar> m_y;              //!< y coordinates
+    GlobalArray<Scalar> m_z;              //!< z coordinates
+    GlobalArray<unsigned int> m_type;     //!< Particle types
+    GlobalArray<VelocityReal> m_vx;       //!< x components of the velocities
+    GlobalArray<VelocityReal> m_vy;       //!< y components of the velocities
+    GlobalArray<VelocityReal> m_vz;       //!< z components of the velocities
+    GlobalArray<Scalar> m_mass;           //!< Masses
+    GlobalArray<DiameterReal> m_diameter; //!< Diameters
+
+    //! Resize the mirrored arrays to the maximum number of particles
+    /*! The mirrored data is invalid after a resize until the next update.
+     */
+    void reallocate()
+        {
+        unsigned int max_n = m_pdata->getMaxN();
+        resize(m_x, max_n);
+        resize(m_y, max_n);
+        resize(m_z, max_n);
+        resize(m_type, max_n);
+        resize(m_vx, max_n);
+        resize(m_vy, max_n);
+        resize(m_vz, max_n);
+        resize(m_mass, max_n);
+        resize(m_diameter, max_n);
+        }
+
+    //! Allocate an array on first use
+    template<class T> void allocate(GlobalArray<T>& array)
+        {
+        if (array.isNull())
+            {
+            GlobalArray<T> new_array(m_pdata->getMaxN(), m_exec_conf);
+            array.swap(new_array);
+            TAG_ALLOCATION(array);
+            }
+        }
+
+    //! Resize an array that is in use
+    template<class T> void resize(GlobalArray<T>& array, unsigned int max_n)
+        {
+        if (!array.isNull())
+            array.resize(max_n);
+        }
+    };
+
+    } // end namespace hoomd
+
+#endif // __PARTICLE_DATA_SOA_H__
@@ -58,6 +58,28 @@ ParticleFilterBody::getSelectedTags(std::shared_ptr<SystemDefinition> sysdef) co
     return member_tags;
     }
 
+#ifdef ENABLE_HIP
+/*! \param sysdef System definition to select particles from
+    \param d_flags Selection flags of the local particles (output)
+*/
+void ParticleFilterBody::selectGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                   unsigned int* d_flags) const
+    {
+    auto pdata = sysdef->getParticleData();
+    ArrayHandle<unsigned int> d_tag(pdata->getTags(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_body(pdata->getBodies(),
+                                     access_location::device,
+                                     access_mode::read);
+    const unsigned int body_classes
+        = m_body ? kernel::filter_body_center | kernel::filter_body_constituent
+                       | kernel::filter_body_floppy
+                 : kernel::filter_body_free;
+    kernel::gpu_filter_body(pdata->getN(), d_tag.data, d_body.data, body_classes, d_flags);
+    if (pdata->getExecConf()->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+#endif
+
 //////////////////////////////////////////////////////////////////////////////
 // ParticleFilterFloppy
 
@@ -98,6 +120,28 @@ ParticleFilterFloppy::getSelectedTags(std::shared_ptr<SystemDefinition> sysdef)
     return member_tags;
     }
 
+#ifdef ENABLE_HIP
+/*! \param sysdef System definition to select particles from
+    \param d_flags Selection flags of the local particles (output)
+*/
+void ParticleFilterFloppy::selectGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                     unsigned int* d_flags) const
+    {
+    auto pdata = sysdef->getParticleData();
+    ArrayHandle<unsigned int> d_tag(pdata->getTags(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_body(pdata->getBodies(),
+                                     access_location::device,
+                                     access_mode::read);
+    const unsigned int body_classes
+        = m_floppy ? kernel::filter_body_floppy
+                   : kernel::filter_body_center | kernel::filter_body_constituent
+                         | kernel::filter_body_free;
+    kernel::gpu_filter_body(pdata->getN(), d_tag.data, d_body.data, body_classes, d_flags);
+    if (pdata->getExecConf()->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+#endif
+
 ParticleFilterRigidCenter::ParticleFilterRigidCenter() : ParticleFilter() { }
 
 /*! \returns true if the type of particle \a tag is a center particle of a rigid body
@@ -124,6 +168,28 @@ ParticleFilterRigidCenter::getSelectedTags(std::shared_ptr<SystemDefinition> sys
     return member_tags;
     }
 
+#ifdef ENABLE_HIP
+/*! \param sysdef System definition to select particles from
+    \param d_flags Selection flags of the local particles (output)
+*/
+void ParticleFilterRigidCenter::selectGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                          unsigned int* d_flags) const
+    {
+    auto pdata = sysdef->getParticleData();
+    ArrayHandle<unsigned int> d_tag(pdata->getTags(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_body(pdata->getBodies(),
+                                     access_location::device,
+                                     access_mode::read);
+    kernel::gpu_filter_body(pdata->getN(),
+                            d_tag.data,
+                            d_body.data,
+                            kernel::filter_body_center,
+                            d_flags);
+    if (pdata->getExecConf()->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+#endif
+
 ParticleFilterCuboid::ParticleFilterCuboid(Scalar3 min, Scalar3 max)
     : ParticleFilter(), m_min(min), m_max(max)
     {
@@ -160,6 +226,23 @@ ParticleFilterCuboid::getSelectedTags(std::shared_ptr<SystemDefinition> sysdef)
     return member_tags;
     }
 
+#ifdef ENABLE_HIP
+/*! \param sysdef System definition to select particles from
+    \param d_flags Selection flags of the local particles (output)
+*/
+void ParticleFilterCuboid::selectGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                     unsigned int* d_flags) const
+    {
+    auto pdata = sysdef->getParticleData();
+    ArrayHandle<Scalar4> d_postype(pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::read);
+    kernel::gpu_filter_cuboid(pdata->getN(), d_postype.data, m_min, m_max, d_flags);
+    if (pdata->getExecConf()->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+#endif
+
 //////////////////////////////////////////////////////////////////////////////
 // ParticleGroup
 
@@ -175,8 +258,10 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
     : m_sysdef(sysdef), m_pdata(sysdef->getParticleData()), m_exec_conf(m_pdata->getExecConf()),
       m_num_local_members(0), m_particles_sorted(true), m_reallocated(false),
       m_global_ptl_num_change(false), m_selector(selector), m_update_tags(update_tags),
-      m_warning_printed(false)
+      m_warning_printed(false), m_membership_bit(ParticleData::NO_GROUP_MEMBERSHIP_BIT)
     {
+    acquireMembershipBit();
+
 #ifdef ENABLE_HIP
     if (m_pdata->getExecConf()->isCUDAEnabled())
         m_gpu_partition = GPUPartition(m_exec_conf->getGPUIds());
@@ -209,8 +294,11 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
                              const std::vector<unsigned int>& member_tags)
     : m_sysdef(sysdef), m_pdata(sysdef->getParticleData()), m_exec_conf(m_pdata->getExecConf()),
       m_num_local_members(0), m_particles_sorted(true), m_reallocated(false),
-      m_global_ptl_num_change(false), m_update_tags(false), m_warning_printed(false)
+      m_global_ptl_num_change(false), m_update_tags(false), m_warning_printed(false),
+      m_membership_bit(ParticleData::NO_GROUP_MEMBERSHIP_BIT)
     {
+    acquireMembershipBit();
+
     // check input
     unsigned int max_tag = m_pdata->getMaximumTag();
     for (std::vector<unsigned int>::const_iterator it = member_tags.begin();
@@ -263,9 +351,13 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
     m_is_member.swap(is_member);
     TAG_ALLOCATION(m_is_member);
 
-    GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(), m_pdata->getExecConf());
-    m_is_member_tag.swap(is_member_tag);
-    TAG_ALLOCATION(m_is_member_tag);
+    if (m_membership_bit == ParticleData::NO_GROUP_MEMBERSHIP_BIT)
+        {
+        GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(),
+                                                m_pdata->getExecConf());
+        m_is_member_tag.swap(is_member_tag);
+        TAG_ALLOCATION(m_is_member_tag);
+        }
 
     // build the reverse lookup table for tags
     buildTagHash();
@@ -313,6 +405,22 @@ ParticleGroup::~ParticleGroup()
         }
     }
 
+/*! Copies of the group share the bit, which is released when the last copy is destroyed.
+ */
+void ParticleGroup::acquireMembershipBit()
+    {
+    m_membership_bit = m_pdata->acquireGroupMembershipBit();
+
+    std::shared_ptr<ParticleData> pdata = m_pdata;
+    m_membership_bit_owner
+        = std::shared_ptr<const unsigned int>(new unsigned int(m_membership_bit),
+                                              [pdata](const unsigned int* bit)
+                                              {
+                                                  pdata->releaseGroupMembershipBit(*bit);
+                                                  delete bit;
+                                              });
+    }
+
 /*! \param force_update If true, always update member tags
  */
 void ParticleGroup::updateMemberTags(bool force_update) const
@@ -334,11 +442,39 @@ void ParticleGroup::updateMemberTags(bool force_update) const
 
         // assign all of the particles that belong to the group
         // for each particle in the (global) data
-        vector<unsigned int> member_tags = m_selector->getSelectedTags(m_sysdef);
+        vector<unsigned int> member_tags;
+#ifdef ENABLE_HIP
+        // evaluate the filter on the device when it supports it, which leaves the sorted member
+        // tags on the device
+        GlobalArray<unsigned int> member_tags_gpu;
+        bool member_tags_on_gpu = false;
+        if (m_exec_conf->isCUDAEnabled() && m_selector->hasGPUSelection())
+            {
+            selectMemberTagsGPU(member_tags_gpu);
+            member_tags_on_gpu = true;
+            }
+        else
+#endif
+            {
+            member_tags = m_selector->getSelectedTags(m_sysdef);
+            }
 
 #ifdef ENABLE_MPI
         if (m_pdata->getDomainDecomposition())
             {
+#ifdef ENABLE_HIP
+            if (member_tags_on_gpu)
+                {
+                // the local tags are needed on the host to combine them with the other ranks
+                ArrayHandle<unsigned int> h_member_tags_gpu(member_tags_gpu,
+                                                            access_location::host,
+                                                            access_mode::read);
+                member_tags.assign(h_member_tags_gpu.data,
+                                   h_member_tags_gpu.data + member_tags_gpu.getNumElements());
+                member_tags_on_gpu = false;
+                }
+#endif
+
             // combine lists from all processors
             std::vector<std::vector<unsigned int>> member_tags_proc(m_exec_conf->getNRanks());
             all_gather_v(member_tags, member_tags_proc, m_exec_conf->getMPICommunicator());
@@ -359,22 +495,32 @@ void ParticleGroup::updateMemberTags(bool force_update) const
             }
 #endif
 
-        // store member tags in GlobalArray
-        GlobalArray<unsigned int> member_tags_array(member_tags.size(), m_pdata->getExecConf());
-        m_member_tags.swap(member_tags_array);
-        TAG_ALLOCATION(m_member_tags);
+#ifdef ENABLE_HIP
+        if (member_tags_on_gpu)
+            {
+            m_member_tags.swap(member_tags_gpu);
+            TAG_ALLOCATION(m_member_tags);
+            }
+        else
+#endif
+            {
+            // store member tags in GlobalArray
+            GlobalArray<unsigned int> member_tags_array(member_tags.size(),
+                                                        m_pdata->getExecConf());
+            m_member_tags.swap(member_tags_array);
+            TAG_ALLOCATION(m_member_tags);
 
-        // sort member tags
-        std::sort(member_tags.begin(), member_tags.end());
+            // sort member tags
+            std::sort(member_tags.begin(), member_tags.end());
 
-            {
             ArrayHandle<unsigned int> h_member_tags(m_member_tags,
                                                     access_location::host,
                                                     access_mode::overwrite);
             std::copy(member_tags.begin(), member_tags.end(), h_member_tags.data);
             }
 
-        GlobalArray<unsigned int> member_idx(member_tags.size(), m_pdata->getExecConf());
+        GlobalArray<unsigned int> member_idx(m_member_tags.getNumElements(),
+                                             m_pdata->getExecConf());
         m_member_idx.swap(member_idx);
         TAG_ALLOCATION(m_member_idx);
         }
@@ -385,9 +531,13 @@ void ParticleGroup::updateMemberTags(bool force_update) const
     m_is_member.swap(is_member);
     TAG_ALLOCATION(m_is_member);
 
-    GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(), m_pdata->getExecConf());
-    m_is_member_tag.swap(is_member_tag);
-    TAG_ALLOCATION(m_is_member_tag);
+    if (m_membership_bit == ParticleData::NO_GROUP_MEMBERSHIP_BIT)
+        {
+        GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(),
+                                                m_pdata->getExecConf());
+        m_is_member_tag.swap(is_member_tag);
+        TAG_ALLOCATION(m_is_member_tag);
+        }
 
     // build the reverse lookup table for tags
     buildTagHash();
@@ -401,7 +551,8 @@ void ParticleGroup::reallocate() const
     {
     m_is_member.resize(m_pdata->getMaxN());
 
-    if (m_is_member_tag.getNumElements() != m_pdata->getRTags().size())
+    if (m_membership_bit == ParticleData::NO_GROUP_MEMBERSHIP_BIT
+        && m_is_member_tag.getNumElements() != m_pdata->getRTags().size())
         {
         // reallocate if necessary
         GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(), m_exec_conf);
@@ -617,6 +768,39 @@ std::shared_ptr<ParticleGroup> ParticleGroup::groupDifference(std::shared_ptr<Pa
  */
 void ParticleGroup::buildTagHash() const
     {
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        buildTagHashGPU();
+        return;
+        }
+#endif
+
+    if (m_membership_bit != ParticleData::NO_GROUP_MEMBERSHIP_BIT)
+        {
+        // set this group's bit in the shared masks
+        const uint64_t bit = uint64_t(1) << m_membership_bit;
+            {
+            ArrayHandle<uint64_t> h_group_membership_tag(m_pdata->getGroupMembershipByTag(),
+                                                         access_location::host,
+                                                         access_mode::readwrite);
+            ArrayHandle<unsigned int> h_member_tags(m_member_tags,
+                                                    access_location::host,
+                                                    access_mode::read);
+
+            size_t num_tags = m_pdata->getRTags().size();
+            for (size_t tag = 0; tag < num_tags; tag++)
+                h_group_membership_tag.data[tag] &= ~bit;
+
+            size_t num_members = m_member_tags.getNumElements();
+            for (size_t member = 0; member < num_members; member++)
+                h_group_membership_tag.data[h_member_tags.data[member]] |= bit;
+            }
+
+        m_pdata->notifyGroupMembershipChange();
+        return;
+        }
+
     ArrayHandle<unsigned int> h_is_member_tag(m_is_member_tag,
                                               access_location::host,
                                               access_mode::overwrite);
@@ -657,30 +841,54 @@ void ParticleGroup::rebuildIndexList() const
         ArrayHandle<unsigned int> h_is_member(m_is_member,
                                               access_location::host,
                                               access_mode::readwrite);
-        ArrayHandle<unsigned int> h_is_member_tag(m_is_member_tag,
-                                                  access_location::host,
-                                                  access_mode::read);
-        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
-                                        access_location::host,
-                                        access_mode::read);
         ArrayHandle<unsigned int> h_member_idx(m_member_idx,
                                                access_location::host,
                                                access_mode::readwrite);
         unsigned int nparticles = m_pdata->getN();
         unsigned int cur_member = 0;
-        for (unsigned int idx = 0; idx < nparticles; idx++)
+
+        if (m_membership_bit != ParticleData::NO_GROUP_MEMBERSHIP_BIT)
             {
-            assert(h_tag.data[idx] <= m_pdata->getMaximumTag());
-            unsigned int is_member = h_is_member_tag.data[h_tag.data[idx]];
-            h_is_member.data[idx] = is_member;
-            if (is_member)
+            // read this group's bit from the shared masks, gathered once for all groups
+            ArrayHandle<uint64_t> h_group_membership(m_pdata->getGroupMembership(),
+                                                     access_location::host,
+                                                     access_mode::read);
+            for (unsigned int idx = 0; idx < nparticles; idx++)
                 {
-                h_member_idx.data[cur_member] = idx;
-                cur_member++;
+                unsigned int is_member
+                    = (unsigned int)((h_group_membership.data[idx] >> m_membership_bit) & 1);
+                h_is_member.data[idx] = is_member;
+                if (is_member)
+                    {
+                    h_member_idx.data[cur_member] = idx;
+                    cur_member++;
+                    }
                 }
+
+            m_num_local_members = cur_member;
             }
+        else
+            {
+            ArrayHandle<unsigned int> h_is_member_tag(m_is_member_tag,
+                                                      access_location::host,
+                                                      access_mode::read);
+            ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                            access_location::host,
+                                            access_mode::read);
+            for (unsigned int idx = 0; idx < nparticles; idx++)
+                {
+                assert(h_tag.data[idx] <= m_pdata->getMaximumTag());
+                unsigned int is_member = h_is_member_tag.data[h_tag.data[idx]];
+                h_is_member.data[idx] = is_member;
+                if (is_member)
+                    {
+                    h_member_idx.data[cur_member] = idx;
+                    cur_member++;
+                    }
+                }
 
-        m_num_local_members = cur_member;
+            m_num_local_members = cur_member;
+            }
         assert(m_num_local_members <= m_member_tags.getNumElements());
         }
 
@@ -702,33 +910,8 @@ void ParticleGroup::updateGPUAdvice() const
     if (m_exec_conf->isCUDAEnabled() && m_exec_conf->allConcurrentManagedAccess())
         {
         // split preferred location of group indices across GPUs
-        auto gpu_map = m_exec_conf->getGPUIds();
-        for (unsigned int idev = 0; idev < m_exec_conf->getNumActiveGPUs(); ++idev)
-            {
-            auto range = m_gpu_partition.getRange(idev);
-            unsigned int nelem = range.second - range.first;
-
-            if (!nelem)
-                continue;
-
-            cudaMemAdvise(m_member_idx.get() + range.first,
-                          sizeof(unsigned int) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_is_member.get() + range.first,
-                          sizeof(unsigned int) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-
-            // migrate data to preferred location
-            cudaMemPrefetchAsync(m_member_idx.get() + range.first,
-                                 sizeof(unsigned int) * nelem,
-                                 gpu_map[idev]);
-            cudaMemPrefetchAsync(m_is_member.get() + range.first,
-                                 sizeof(unsigned int) * nelem,
-                                 gpu_map[idev]);
-            }
-        CHECK_CUDA_ERROR();
+        m_member_idx.prefetchPartition(m_gpu_partition, true);
+        m_is_member.prefetchPartition(m_gpu_partition, true);
         }
 #endif
     }
@@ -740,13 +923,9 @@ void ParticleGroup::rebuildIndexListGPU() const
     ArrayHandle<unsigned int> d_is_member(m_is_member,
                                           access_location::device,
                                           access_mode::overwrite);
-    ArrayHandle<unsigned int> d_is_member_tag(m_is_member_tag,
-                                              access_location::device,
-                                              access_mode::read);
     ArrayHandle<unsigned int> d_member_idx(m_member_idx,
                                            access_location::device,
                                            access_mode::overwrite);
-    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
 
     // get temporary buffer
     ScopedAllocation<unsigned int> d_tmp(m_pdata->getExecConf()->getCachedAllocator(),
@@ -755,10 +934,29 @@ void ParticleGroup::rebuildIndexListGPU() const
     // reset membership properties
     if (m_member_tags.getNumElements() > 0)
         {
-        kernel::gpu_rebuild_index_list(m_pdata->getN(),
-                                       d_is_member_tag.data,
-                                       d_is_member.data,
-                                       d_tag.data);
+        if (m_membership_bit != ParticleData::NO_GROUP_MEMBERSHIP_BIT)
+            {
+            ArrayHandle<uint64_t> d_group_membership(m_pdata->getGroupMembership(),
+                                                     access_location::device,
+                                                     access_mode::read);
+            kernel::gpu_rebuild_index_list_mask(m_pdata->getN(),
+                                                d_group_membership.data,
+                                                m_membership_bit,
+                                                d_is_member.data);
+            }
+        else
+            {
+            ArrayHandle<unsigned int> d_is_member_tag(m_is_member_tag,
+                                                      access_location::device,
+                                                      access_mode::read);
+            ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                            access_location::device,
+                                            access_mode::read);
+            kernel::gpu_rebuild_index_list(m_pdata->getN(),
+                                           d_is_member_tag.data,
+                                           d_is_member.data,
+                                           d_tag.data);
+            }
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
 
@@ -774,6 +972,96 @@ void ParticleGroup::rebuildIndexListGPU() const
     else
         m_num_local_members = 0;
     }
+
+/*! \param member_tags Sorted tags of the local particles selected by the filter (output)
+
+    The filter flags the local particles on the device, the flags are compacted into a list of
+    member indices and the tags of the members are gathered and sorted. Nothing is copied to the
+    host except the number of members.
+*/
+void ParticleGroup::selectMemberTagsGPU(GlobalArray<unsigned int>& member_tags) const
+    {
+    const unsigned int N = m_pdata->getN();
+    CachedAllocator& alloc = m_exec_conf->getCachedAllocator();
+
+    ScopedAllocation<unsigned int> d_flags(alloc, N);
+    ScopedAllocation<unsigned int> d_member_idx(alloc, N);
+    ScopedAllocation<unsigned int> d_tmp(alloc, N);
+
+    m_selector->selectGPU(m_sysdef, d_flags.data);
+
+    unsigned int num_members = 0;
+    if (N > 0)
+        {
+        kernel::gpu_compact_index_list(N,
+                                       d_flags.data,
+                                       d_member_idx.data,
+                                       num_members,
+                                       d_tmp.data,
+                                       alloc);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    GlobalArray<unsigned int> selected_tags(num_members, m_exec_conf);
+    member_tags.swap(selected_tags);
+
+    if (num_members > 0)
+        {
+        ArrayHandle<unsigned int> d_member_tags(member_tags,
+                                                access_location::device,
+                                                access_mode::overwrite);
+        ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                        access_location::device,
+                                        access_mode::read);
+        kernel::gpu_gather_member_tags(num_members,
+                                       d_member_idx.data,
+                                       d_tag.data,
+                                       d_member_tags.data,
+                                       alloc);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+    }
+
+//! Build the by-tag-lookup table for group membership on the GPU
+void ParticleGroup::buildTagHashGPU() const
+    {
+    const size_t num_tags = m_pdata->getRTags().size();
+    const unsigned int num_members = (unsigned int)m_member_tags.getNumElements();
+
+    if (m_membership_bit != ParticleData::NO_GROUP_MEMBERSHIP_BIT)
+        {
+            {
+            ArrayHandle<uint64_t> d_group_membership_tag(m_pdata->getGroupMembershipByTag(),
+                                                         access_location::device,
+                                                         access_mode::readwrite);
+            ArrayHandle<unsigned int> d_member_tags(m_member_tags,
+                                                    access_location::device,
+                                                    access_mode::read);
+            kernel::gpu_set_member_tags_mask(num_tags,
+                                             num_members,
+                                             d_member_tags.data,
+                                             m_membership_bit,
+                                             d_group_membership_tag.data);
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+
+        m_pdata->notifyGroupMembershipChange();
+        return;
+        }
+
+    ArrayHandle<unsigned int> d_is_member_tag(m_is_member_tag,
+                                              access_location::device,
+                                              access_mode::overwrite);
+    ArrayHandle<unsigned int> d_member_tags(m_member_tags,
+                                            access_location::device,
+                                            access_mode::read);
+    kernel::gpu_set_member_tags(num_tags, num_members, d_member_tags.data, d_is_member_tag.data);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
 #endif
 
 unsigned int ParticleGroup::intersectionSize(std::shared_ptr<ParticleGroup> other)
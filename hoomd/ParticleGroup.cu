@@ -12,6 +12,7 @@
 #include <thrust/device_ptr.h>
 #include <thrust/execution_policy.h>
 #include <thrust/reduce.h>
+#include <thrust/sort.h>
 #pragma GCC diagnostic pop
 
 /*! \file ParticleGroup.cu
@@ -38,6 +39,20 @@ __global__ void gpu_rebuild_index_list_kernel(unsigned int N,
     d_is_member[idx] = d_is_member_tag[tag];
     }
 
+//! GPU kernel to extract the membership flags of one group from the group membership masks
+__global__ void gpu_rebuild_index_list_mask_kernel(unsigned int N,
+                                                   const uint64_t* d_group_membership,
+                                                   unsigned int bit,
+                                                   unsigned int* d_is_member)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    d_is_member[idx] = (unsigned int)((d_group_membership[idx] >> bit) & 1);
+    }
+
 __global__ void gpu_scatter_member_indices(unsigned int N,
                                            const unsigned int* d_scan,
                                            const unsigned int* d_is_member,
@@ -84,6 +99,34 @@ hipError_t gpu_rebuild_index_list(unsigned int N,
     return hipSuccess;
     }
 
+/*! \param N number of local particles
+    \param d_group_membership Group membership masks of the local particles
+    \param bit Bit of the group in the masks
+    \param d_is_member Array of membership flags
+*/
+hipError_t gpu_rebuild_index_list_mask(unsigned int N,
+                                       const uint64_t* d_group_membership,
+                                       unsigned int bit,
+                                       unsigned int* d_is_member)
+    {
+    assert(d_group_membership);
+    assert(d_is_member);
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = N / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_rebuild_index_list_mask_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       N,
+                       d_group_membership,
+                       bit,
+                       d_is_member);
+    return hipSuccess;
+    }
+
 //! GPU method for compacting the group member indices
 /*! \param N number of local particles
     \param d_is_member_tag Global lookup table for tag -> group membership
@@ -139,6 +182,176 @@ hipError_t gpu_compact_index_list(unsigned int N,
     return hipSuccess;
     }
 
+//! GPU kernel to gather the tags of the group members
+__global__ void gpu_gather_member_tags_kernel(unsigned int num_members,
+                                              const unsigned int* d_member_idx,
+                                              const unsigned int* d_tag,
+                                              unsigned int* d_member_tags)
+    {
+    unsigned int member = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (member >= num_members)
+        return;
+
+    d_member_tags[member] = d_tag[d_member_idx[member]];
+    }
+
+//! GPU kernel to flag the group members in the membership lookup table
+__global__ void gpu_set_member_tags_kernel(unsigned int num_members,
+                                           const unsigned int* d_member_tags,
+                                           unsigned int* d_is_member_tag)
+    {
+    unsigned int member = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (member >= num_members)
+        return;
+
+    d_is_member_tag[d_member_tags[member]] = 1;
+    }
+
+//! GPU kernel to clear one group's bit in the group membership masks
+__global__ void gpu_clear_member_tags_mask_kernel(size_t num_tags,
+                                                  uint64_t mask,
+                                                  uint64_t* d_group_membership_tag)
+    {
+    size_t tag = size_t(blockIdx.x) * blockDim.x + threadIdx.x;
+
+    if (tag >= num_tags)
+        return;
+
+    d_group_membership_tag[tag] &= ~mask;
+    }
+
+//! GPU kernel to set one group's bit in the group membership masks of the members
+/*! Member tags are unique, so each thread owns the mask it modifies.
+ */
+__global__ void gpu_set_member_tags_mask_kernel(unsigned int num_members,
+                                                const unsigned int* d_member_tags,
+                                                uint64_t mask,
+                                                uint64_t* d_group_membership_tag)
+    {
+    unsigned int member = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (member >= num_members)
+        return;
+
+    d_group_membership_tag[d_member_tags[member]] |= mask;
+    }
+
+/*! \param num_members Number of local group members
+    \param d_member_idx Indices of the local group members
+    \param d_tag Particle tags by index
+    \param d_member_tags Tags of the group members, in sorted order (output)
+    \param alloc Caching allocator for the temporary storage of the sort
+*/
+hipError_t gpu_gather_member_tags(unsigned int num_members,
+                                  const unsigned int* d_member_idx,
+                                  const unsigned int* d_tag,
+                                  unsigned int* d_member_tags,
+                                  CachedAllocator& alloc)
+    {
+    if (num_members == 0)
+        return hipSuccess;
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = num_members / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_gather_member_tags_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       num_members,
+                       d_member_idx,
+                       d_tag,
+                       d_member_tags);
+
+    thrust::device_ptr<unsigned int> member_tags(d_member_tags);
+#ifdef __HIP_PLATFORM_HCC__
+    thrust::sort(thrust::hip::par(alloc),
+#else
+    thrust::sort(thrust::cuda::par(alloc),
+#endif
+                 member_tags,
+                 member_tags + num_members);
+
+    return hipSuccess;
+    }
+
+/*! \param num_tags Number of elements in the lookup table
+    \param num_members Number of group members
+    \param d_member_tags Tags of the group members
+    \param d_is_member_tag Lookup table for tag -> group membership (output)
+*/
+hipError_t gpu_set_member_tags(size_t num_tags,
+                               unsigned int num_members,
+                               const unsigned int* d_member_tags,
+                               unsigned int* d_is_member_tag)
+    {
+    if (num_tags == 0)
+        return hipSuccess;
+
+    hipMemsetAsync(d_is_member_tag, 0, sizeof(unsigned int) * num_tags);
+
+    if (num_members == 0)
+        return hipSuccess;
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = num_members / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_set_member_tags_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       num_members,
+                       d_member_tags,
+                       d_is_member_tag);
+    return hipSuccess;
+    }
+
+/*! \param num_tags Number of elements in the membership masks
+    \param num_members Number of group members
+    \param d_member_tags Tags of the group members
+    \param bit Bit of the group in the masks
+    \param d_group_membership_tag Group membership masks by tag
+*/
+hipError_t gpu_set_member_tags_mask(size_t num_tags,
+                                    unsigned int num_members,
+                                    const unsigned int* d_member_tags,
+                                    unsigned int bit,
+                                    uint64_t* d_group_membership_tag)
+    {
+    if (num_tags == 0)
+        return hipSuccess;
+
+    const uint64_t mask = uint64_t(1) << bit;
+    unsigned int block_size = 256;
+
+    hipLaunchKernelGGL(gpu_clear_member_tags_mask_kernel,
+                       dim3((unsigned int)(num_tags / block_size + 1)),
+                       dim3(block_size),
+                       0,
+                       0,
+                       num_tags,
+                       mask,
+                       d_group_membership_tag);
+
+    if (num_members == 0)
+        return hipSuccess;
+
+    hipLaunchKernelGGL(gpu_set_member_tags_mask_kernel,
+                       dim3(num_members / block_size + 1),
+                       dim3(block_size),
+                       0,
+                       0,
+                       num_members,
+                       d_member_tags,
+                       mask,
+                       d_group_membership_tag);
+    return hipSuccess;
+    }
+
     } // end namespace kernel
 
     } // end namespace hoomd
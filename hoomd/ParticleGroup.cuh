@@ -20,6 +20,12 @@ hipError_t gpu_rebuild_index_list(unsigned int N,
                                   unsigned int* d_is_member,
                                   unsigned int* d_tag);
 
+//! GPU method for rebuilding the index list of a ParticleGroup from the group membership masks
+hipError_t gpu_rebuild_index_list_mask(unsigned int N,
+                                       const uint64_t* d_group_membership,
+                                       unsigned int bit,
+                                       unsigned int* d_is_member);
+
 //! GPU method for compacting the group member indices
 /*! \param N number of local particles
     \param d_is_member_tag Global lookup table for tag -> group membership
@@ -35,6 +41,26 @@ hipError_t gpu_compact_index_list(unsigned int N,
                                   unsigned int* d_tmp,
                                   CachedAllocator& alloc);
 
+//! GPU method for gathering the sorted tags of the group members
+hipError_t gpu_gather_member_tags(unsigned int num_members,
+                                  const unsigned int* d_member_idx,
+                                  const unsigned int* d_tag,
+                                  unsigned int* d_member_tags,
+                                  CachedAllocator& alloc);
+
+//! GPU method for setting the group membership by tag
+hipError_t gpu_set_member_tags(size_t num_tags,
+                               unsigned int num_members,
+                               const unsigned int* d_member_tags,
+                               unsigned int* d_is_member_tag);
+
+//! GPU method for setting the group's bit in the group membership masks by tag
+hipError_t gpu_set_member_tags_mask(size_t num_tags,
+                                    unsigned int num_members,
+                                    const unsigned int* d_member_tags,
+                                    unsigned int bit,
+                                    uint64_t* d_group_membership_tag);
+
     } // namespace kernel
 
     } // end namespace hoomd
@@ -45,6 +45,17 @@ class PYBIND11_EXPORT ParticleFilterCuboid : public ParticleFilter
     virtual std::vector<unsigned int>
     getSelectedTags(std::shared_ptr<SystemDefinition> sysdef) const;
 
+#ifdef ENABLE_HIP
+    //! Test if the filter implements selectGPU()
+    virtual bool hasGPUSelection() const
+        {
+        return true;
+        }
+
+    //! Flag the local particles that meet the selection criteria
+    virtual void selectGPU(std::shared_ptr<SystemDefinition> sysdef, unsigned int* d_flags) const;
+#endif
+
     protected:
     Scalar3 m_min; //!< Minimum type to select (inclusive)
     Scalar3 m_max; //!< Maximum type to select (exclusive)
@@ -62,6 +73,17 @@ class PYBIND11_EXPORT ParticleFilterBody : public ParticleFilter
     virtual std::vector<unsigned int>
     getSelectedTags(std::shared_ptr<SystemDefinition> sysdef) const;
 
+#ifdef ENABLE_HIP
+    //! Test if the filter implements selectGPU()
+    virtual bool hasGPUSelection() const
+        {
+        return true;
+        }
+
+    //! Flag the local particles that meet the selection criteria
+    virtual void selectGPU(std::shared_ptr<SystemDefinition> sysdef, unsigned int* d_flags) const;
+#endif
+
     protected:
     bool m_body; //!< true if we should select particles in a body, false if we should select
                  //!< non-body particles
@@ -79,6 +101,17 @@ class PYBIND11_EXPORT ParticleFilterFloppy : public ParticleFilter
     virtual std::vector<unsigned int>
     getSelectedTags(std::shared_ptr<SystemDefinition> sysdef) const;
 
+#ifdef ENABLE_HIP
+    //! Test if the filter implements selectGPU()
+    virtual bool hasGPUSelection() const
+        {
+        return true;
+        }
+
+    //! Flag the local particles that meet the selection criteria
+    virtual void selectGPU(std::shared_ptr<SystemDefinition> sysdef, unsigned int* d_flags) const;
+#endif
+
     protected:
     bool m_floppy; //!< true if we should select particles in floppy bodies, false if we should
                    //!< select non-floppy particles
@@ -94,6 +127,17 @@ class PYBIND11_EXPORT ParticleFilterRigidCenter : public ParticleFilter
     //! Test if a particle meets the selection criteria
     virtual std::vector<unsigned int>
     getSelectedTags(std::shared_ptr<SystemDefinition> sysdef) const;
+
+#ifdef ENABLE_HIP
+    //! Test if the filter implements selectGPU()
+    virtual bool hasGPUSelection() const
+        {
+        return true;
+        }
+
+    //! Flag the local particles that meet the selection criteria
+    virtual void selectGPU(std::shared_ptr<SystemDefinition> sysdef, unsigned int* d_flags) const;
+#endif
     };
 
 //! Describes a group of particles
@@ -147,7 +191,8 @@ class PYBIND11_EXPORT ParticleGroup
     // @{
 
     //! Constructs an empty particle group
-    ParticleGroup() : m_num_local_members(0) {};
+    ParticleGroup()
+        : m_num_local_members(0), m_membership_bit(ParticleData::NO_GROUP_MEMBERSHIP_BIT) {};
 
     //! Constructs a particle group of all particles that meet the given selection
     ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
@@ -257,6 +302,32 @@ class PYBIND11_EXPORT ParticleGroup
         return m_member_idx;
         }
 
+    //! Direct access to the membership flags
+    /*! \returns A GlobalArray that holds 1 for each particle index that is a local member of the
+       group, intended for use in testing membership on the GPU \note The caller \b must \b not
+       write to or change the array.
+
+        \note This method CAN access the particle data tag array if the index is rebuilt.
+              Hence, the tag array may not be accessed in the same scope in which this method is
+       called.
+    */
+    const GlobalArray<unsigned int>& getIsMemberArray() const
+        {
+        checkRebuild();
+
+        return m_is_member;
+        }
+
+    /// Get the bit of this group in the group membership masks of the particle data
+    /*! \returns ParticleData::NO_GROUP_MEMBERSHIP_BIT when the group stores its membership only
+        in its own arrays. The bit is valid in ParticleData::getGroupMembership() once the group is
+        rebuilt, e.g. after getNumMembers().
+    */
+    unsigned int getMembershipBit() const
+        {
+        return m_membership_bit;
+        }
+
 #ifdef ENABLE_HIP
     //! Return the load balancing GPU partition
     const GPUPartition& getGPUPartition() const
@@ -368,6 +439,16 @@ class PYBIND11_EXPORT ParticleGroup
     bool m_update_tags; //!< True if tags should be updated when global number of particles changes
     mutable bool m_warning_printed; //!< True if warning about static groups has been printed
 
+    /// Bit of this group in the group membership masks of the particle data
+    /*! Groups store their membership in the masks shared by all groups of the particle data, so
+        that the masks need to be gathered only once per particle sort. When all bits are in use,
+        the group falls back to its own m_is_member_tag.
+    */
+    unsigned int m_membership_bit;
+
+    /// Releases m_membership_bit when the last copy of the group is destroyed
+    std::shared_ptr<const unsigned int> m_membership_bit_owner;
+
 #ifdef ENABLE_HIP
     mutable GPUPartition m_gpu_partition; //!< A handy struct to store load balancing info for this
                                           //!< group's local members
@@ -379,6 +460,9 @@ class PYBIND11_EXPORT ParticleGroup
     /// Number of rotational degrees of freedom in the group
     Scalar m_rotational_dof = 0;
 
+    /// Reserve a bit in the group membership masks of the particle data
+    void acquireMembershipBit();
+
     //! Helper function to resize array of member tags
     void reallocate() const;
 
@@ -439,6 +523,12 @@ class PYBIND11_EXPORT ParticleGroup
 #ifdef ENABLE_HIP
     //! Helper function to rebuild the index lists after the particles have been sorted
     void rebuildIndexListGPU() const;
+
+    //! Evaluate the filter on the GPU and compact the sorted tags of the local members
+    void selectMemberTagsGPU(GlobalArray<unsigned int>& member_tags) const;
+
+    //! Helper function to build the 1:1 hash for tag membership on the GPU
+    void buildTagHashGPU() const;
 #endif
     };
 
@@ -95,13 +95,14 @@ void ProfileDataElem::output(std::ostream& o,
     double perc = double(m_elapsed_time) / double(total_time) * 100.0;
     double flops = 0.0;
     double bytes = 0.0;
+    double gpu_sec = double(m_gpu_elapsed_time) / 1e9;
     if (m_children.size() == 0)
         {
         flops = double(getTotalFlopCount()) / sec;
         bytes = double(getTotalMemByteCount()) / sec;
         }
 
-    output_line(o, name, sec, perc, flops, bytes, name_width);
+    output_line(o, name, sec, perc, flops, bytes, gpu_sec, name_width);
 
     // start by determining the name width
     map<string, ProfileDataElem>::const_iterator i;
@@ -133,7 +134,7 @@ void ProfileDataElem::output(std::ostream& o,
         if (perc >= 0.1)
             {
             o << tabs << "        ";
-            output_line(o, "Self", sec, perc, flops, bytes, child_max_width);
+            output_line(o, "Self", sec, perc, flops, bytes, 0.0, child_max_width);
             }
         }
     }
@@ -144,6 +145,7 @@ void ProfileDataElem::output_line(std::ostream& o,
                                   double perc,
                                   double flops,
                                   double bytes,
+                                  double gpu_sec,
                                   unsigned int name_width) const
     {
     o << setiosflags(ios::fixed);
@@ -188,9 +190,37 @@ void ProfileDataElem::output_line(std::ostream& o,
             o << bytes / 1e9 << " GiB/s ";
         }
 
+    // output the time measured on the GPU with events
+    if (gpu_sec > 0)
+        {
+        o << "| GPU " << setw(7) << setprecision(4) << gpu_sec << "s";
+        }
+
     o << endl;
     }
 
+/*! \returns A dictionary with the keys ``time`` and ``gpu_time`` (seconds), ``count`` (number of
+    times the node was popped), ``flop_count``, ``byte_count``, and ``children`` (a dictionary that
+    maps the names of the child nodes to their dictionaries).
+*/
+pybind11::dict ProfileDataElem::toDict() const
+    {
+    pybind11::dict children;
+    for (auto i = m_children.begin(); i != m_children.end(); ++i)
+        {
+        children[pybind11::str((*i).first)] = (*i).second.toDict();
+        }
+
+    pybind11::dict result;
+    result["time"] = double(m_elapsed_time) / 1e9;
+    result["gpu_time"] = double(m_gpu_elapsed_time) / 1e9;
+    result["count"] = m_call_count;
+    result["flop_count"] = m_flop_count;
+    result["byte_count"] = m_mem_byte_count;
+    result["children"] = children;
+    return result;
+    }
+
 ////////////////////////////////////////////////////////////////////
 // Profiler
 
@@ -207,6 +237,77 @@ Profiler::Profiler(const std::string& name) : m_name(name)
 #endif
     }
 
+Profiler::~Profiler()
+    {
+#ifdef ENABLE_HIP
+    for (auto& pending : m_pending_events)
+        {
+        hipEventDestroy(pending.start);
+        hipEventDestroy(pending.stop);
+        }
+
+    for (auto event : m_event_pool)
+        hipEventDestroy(event);
+#endif
+    }
+
+#ifdef ENABLE_HIP
+hipEvent_t Profiler::getEvent()
+    {
+    if (m_event_pool.empty())
+        {
+        hipEvent_t event;
+        hipEventCreate(&event);
+        return event;
+        }
+
+    hipEvent_t event = m_event_pool.back();
+    m_event_pool.pop_back();
+    return event;
+    }
+#endif
+
+/*! \param block When true, wait for all recorded events to complete
+
+    Events on the default stream complete in the order they are recorded, so collection stops at
+    the first pair that is still pending when \a block is false.
+*/
+void Profiler::collectGPUTimings(bool block)
+    {
+#ifdef ENABLE_HIP
+    while (!m_pending_events.empty())
+        {
+        PendingEvents& pending = m_pending_events.front();
+        if (block)
+            hipEventSynchronize(pending.stop);
+        else if (hipEventQuery(pending.stop) != hipSuccess)
+            break;
+
+        float elapsed_ms = 0;
+        hipEventElapsedTime(&elapsed_ms, pending.start, pending.stop);
+        pending.elem->m_gpu_elapsed_time += int64_t(double(elapsed_ms) * 1e6);
+
+        m_event_pool.push_back(pending.start);
+        m_event_pool.push_back(pending.stop);
+        m_pending_events.pop_front();
+        }
+#endif
+    }
+
+/*! \returns A dictionary that maps the name of the profile to the dictionary of the root node (see
+    ProfileDataElem::toDict()). The time of the root node is the time since the profiler was
+    constructed.
+*/
+pybind11::dict Profiler::getTimings()
+    {
+    collectGPUTimings(true);
+    m_root.m_elapsed_time = m_clk.getTime() - m_root.m_start_time;
+
+    pybind11::dict result;
+    result[pybind11::str(m_name)] = m_root.toDict();
+    return result;
+    }
+
 void Profiler::output(std::ostream& o)
     {
     // perform a sanity check, but don't bail out
@@ -219,6 +320,9 @@ void Profiler::output(std::ostream& o)
     SCOREP_USER_REGION_END(m_root.m_scorep_region)
 #endif
 
+    // wait for the GPU timings of all regions
+    collectGPUTimings(true);
+
     // outputting a profile implicitly calls for a time sample
     m_root.m_elapsed_time = m_clk.getTime() - m_root.m_start_time;
 
@@ -252,8 +356,9 @@ namespace detail
     {
 void export_Profiler(pybind11::module& m)
     {
-    pybind11::class_<Profiler>(m, "Profiler")
+    pybind11::class_<Profiler, std::shared_ptr<Profiler>>(m, "Profiler")
         .def(pybind11::init<const std::string&>())
+        .def("getTimings", &Profiler::getTimings)
         .def("__str__", &print_profiler);
     }
 
@@ -22,11 +22,17 @@
 #include <nvToolsExt.h>
 #endif
 
+#if defined(ENABLE_ROCTRACER) && defined(__HIP_PLATFORM_HCC__)
+#include <roctracer/roctx.h>
+#endif
+
 #include <cassert>
+#include <deque>
 #include <iostream>
 #include <map>
 #include <stack>
 #include <string>
+#include <vector>
 
 #include <pybind11/pybind11.h>
 
@@ -65,7 +71,12 @@ class PYBIND11_EXPORT ProfileDataElem
     public:
     //! Constructs an element with zeroed counters
     ProfileDataElem()
-        : m_start_time(0), m_elapsed_time(0), m_flop_count(0), m_mem_byte_count(0)
+        : m_start_time(0), m_elapsed_time(0), m_gpu_elapsed_time(0), m_call_count(0),
+          m_flop_count(0), m_mem_byte_count(0)
+#ifdef ENABLE_HIP
+          ,
+          m_start_event(nullptr)
+#endif
 #ifdef SCOREP_USER_ENABLE
           ,
           m_scorep_region(SCOREP_USER_INVALID_REGION)
@@ -93,14 +104,24 @@ class PYBIND11_EXPORT ProfileDataElem
                      double perc,
                      double flops,
                      double bytes,
+                     double gpu_sec,
                      unsigned int name_width) const;
 
+    //! Convert this node and all sub nodes to a python dictionary
+    pybind11::dict toDict() const;
+
     std::map<std::string, ProfileDataElem> m_children; //!< Child nodes of this profile
 
     int64_t m_start_time;     //!< The start time of the most recent timed event
-    int64_t m_elapsed_time;   //!< A running total of elapsed running time
-    int64_t m_flop_count;     //!< A running total of floating point operations
-    int64_t m_mem_byte_count; //!< A running total of memory bytes transferred
+    int64_t m_elapsed_time;     //!< A running total of elapsed running time
+    int64_t m_gpu_elapsed_time; //!< A running total of GPU time measured with events
+    uint64_t m_call_count;      //!< Number of times this node has been popped
+    int64_t m_flop_count;       //!< A running total of floating point operations
+    int64_t m_mem_byte_count;   //!< A running total of memory bytes transferred
+
+#ifdef ENABLE_HIP
+    hipEvent_t m_start_event; //!< Event recorded by the most recent push, nullptr if none
+#endif
 
 #ifdef SCOREP_USER_ENABLE
     SCOREP_User_RegionHandle m_scorep_region; //!< ScoreP region identifier
@@ -120,10 +141,18 @@ class PYBIND11_EXPORT ProfileDataElem
     names on each pass will generate a jumbled mess.
 
     There are versions of push() and pop() that take in a reference to an ExecutionConfiguration.
-    These methods automatically synchronize with the asynchronous GPU execution stream in order
-    to provide accurate timing information.
-
-    These profiles can of course be output via normal ostream operators.
+    On the GPU, these methods record a pair of events in the default stream around the profiled
+    region instead of synchronizing with the device. The GPU time between the events accumulates
+    in the profile node once the events complete, so the host time of a GPU region measures only
+    the time to launch its kernels while the GPU time measures their execution. Pending events are
+    collected without blocking on every pop() and with blocking before the profile is output.
+
+    Every push() also opens a named NVTX (or roctx) range when HOOMD is built with ENABLE_NVTOOLS
+    (or ENABLE_ROCTRACER on AMD GPUs) so that timelines in Nsight Systems and rocprof show the
+    names of the profiled regions.
+
+    These profiles can of course be output via normal ostream operators or converted to a nested
+    python dictionary with getTimings().
     \ingroup utils
     */
 class PYBIND11_EXPORT Profiler
@@ -131,6 +160,10 @@ class PYBIND11_EXPORT Profiler
     public:
     //! Constructs an empty profiler and starts its timer ticking
     Profiler(const std::string& name = "Profile");
+
+    //! Destructor
+    ~Profiler();
+
     //! Pushes a new sub-category into the current category
     void push(const std::string& name);
     //! Pops back up to the next super-category
@@ -143,12 +176,34 @@ class PYBIND11_EXPORT Profiler
              uint64_t flop_count = 0,
              uint64_t byte_count = 0);
 
+    //! Accumulate the GPU time of completed event pairs
+    void collectGPUTimings(bool block);
+
+    //! Get the profile tree as a nested python dictionary
+    pybind11::dict getTimings();
+
     private:
     ClockSource m_clk;                    //!< Clock to provide timing information
     std::string m_name;                   //!< The name of this profile
     ProfileDataElem m_root;               //!< The root profile element
     std::stack<ProfileDataElem*> m_stack; //!< A stack of data elements for the push/pop structure
 
+#ifdef ENABLE_HIP
+    //! A pair of events recorded around a profiled GPU region that has not yet been collected
+    struct PendingEvents
+        {
+        ProfileDataElem* elem; //!< Node to add the GPU time to
+        hipEvent_t start;      //!< Event recorded in push()
+        hipEvent_t stop;       //!< Event recorded in pop()
+        };
+
+    std::deque<PendingEvents> m_pending_events; //!< Events in the order they were recorded
+    std::vector<hipEvent_t> m_event_pool;       //!< Created events available for reuse
+
+    //! Get an event from the pool or create a new one
+    hipEvent_t getEvent();
+#endif
+
     //! Output helper function
     void output(std::ostream& o);
 
@@ -174,15 +229,17 @@ PYBIND11_EXPORT std::ostream& operator<<(std::ostream& o, Profiler& prof);
 inline void Profiler::push(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                            const std::string& name)
     {
+    push(name);
+
 #if defined(ENABLE_HIP)
-    // nvtools profiling disables synchronization so that async CPU/GPU overlap can be seen
+    // time the GPU region with events so that the host does not wait for the device
     if (exec_conf->isCUDAEnabled())
         {
-        exec_conf->multiGPUBarrier();
-        hipDeviceSynchronize();
+        ProfileDataElem* cur = m_stack.top();
+        cur->m_start_event = getEvent();
+        hipEventRecord(cur->m_start_event, 0);
         }
 #endif
-    push(name);
     }
 
 inline void Profiler::pop(std::shared_ptr<const ExecutionConfiguration> exec_conf,
@@ -190,11 +247,16 @@ inline void Profiler::pop(std::shared_ptr<const ExecutionConfiguration> exec_con
                           uint64_t byte_count)
     {
 #if defined(ENABLE_HIP)
-    // nvtools profiling disables synchronization so that async CPU/GPU overlap can be seen
-    if (exec_conf->isCUDAEnabled())
+    ProfileDataElem* cur = m_stack.top();
+    if (exec_conf->isCUDAEnabled() && cur->m_start_event)
         {
-        exec_conf->multiGPUBarrier();
-        hipDeviceSynchronize();
+        hipEvent_t stop = getEvent();
+        hipEventRecord(stop, 0);
+        m_pending_events.push_back(PendingEvents {cur, cur->m_start_event, stop});
+        cur->m_start_event = nullptr;
+
+        // collect the time of regions that have already completed
+        collectGPUTimings(false);
         }
 #endif
     pop(flop_count, byte_count);
@@ -208,6 +270,9 @@ inline void Profiler::push(const std::string& name)
 #ifdef ENABLE_NVTOOLS
     nvtxRangePush(name.c_str());
 #endif
+#if defined(ENABLE_ROCTRACER) && defined(__HIP_PLATFORM_HCC__)
+    roctxRangePush(name.c_str());
+#endif
 
     // pushing a new record on to the stack involves taking a time sample
     int64_t t = m_clk.getTime();
@@ -237,6 +302,9 @@ inline void Profiler::pop(uint64_t flop_count, uint64_t byte_count)
 #ifdef ENABLE_NVTOOLS
     nvtxRangePop();
 #endif
+#if defined(ENABLE_ROCTRACER) && defined(__HIP_PLATFORM_HCC__)
+    roctxRangePop();
+#endif
 
     // popping up a level in the profile stack involves taking a time sample
     int64_t t = m_clk.getTime();
@@ -247,6 +315,16 @@ inline void Profiler::pop(uint64_t flop_count, uint64_t byte_count)
     SCOREP_USER_REGION_END(cur->m_scorep_region)
 #endif
     cur->m_elapsed_time += t - cur->m_start_time;
+    cur->m_call_count++;
+
+#ifdef ENABLE_HIP
+    // recycle the start event of a region pushed with an exec_conf but popped without one
+    if (cur->m_start_event)
+        {
+        m_event_pool.push_back(cur->m_start_event);
+        cur->m_start_event = nullptr;
+        }
+#endif
 
     // and increasing the flop and mem counters
     cur->m_flop_count += flop_count;
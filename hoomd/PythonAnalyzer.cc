@@ -14,18 +14,37 @@ PythonAnalyzer::PythonAnalyzer(std::shared_ptr<SystemDefinition> sysdef, pybind1
 void PythonAnalyzer::analyze(uint64_t timestep)
     {
     Analyzer::analyze(timestep);
-    m_analyzer.attr("act")(timestep);
+
+    // System may call this on a worker thread
+    pybind11::gil_scoped_acquire acquire;
+    m_act(timestep);
     }
 
 void PythonAnalyzer::setAnalyzer(pybind11::object analyzer)
     {
     m_analyzer = analyzer;
+    m_act = analyzer.attr("act");
     auto flags = PDataFlags();
     for (auto flag : analyzer.attr("flags"))
         {
         flags.set(flag.cast<size_t>());
         }
     m_flags = flags;
+
+    // None declares a dependency on all data
+    m_dependencies = DataDependencies();
+    if (!analyzer.attr("reads").is_none())
+        {
+        m_dependencies.read = data_dependency::none;
+        for (auto data : analyzer.attr("reads"))
+            m_dependencies.read |= 1u << data.cast<unsigned int>();
+        }
+    if (!analyzer.attr("writes").is_none())
+        {
+        m_dependencies.write = data_dependency::none;
+        for (auto data : analyzer.attr("writes"))
+            m_dependencies.write |= 1u << data.cast<unsigned int>();
+        }
     }
 
 PDataFlags PythonAnalyzer::getRequestedPDataFlags()
@@ -33,6 +52,11 @@ PDataFlags PythonAnalyzer::getRequestedPDataFlags()
     return m_flags;
     }
 
+DataDependencies PythonAnalyzer::getDataDependencies()
+    {
+    return m_dependencies;
+    }
+
 namespace detail
     {
 void export_PythonAnalyzer(pybind11::module& m)
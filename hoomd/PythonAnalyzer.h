@@ -15,6 +15,8 @@ class PYBIND11_EXPORT PythonAnalyzer : public Analyzer
 
     PDataFlags getRequestedPDataFlags();
 
+    DataDependencies getDataDependencies();
+
     void setAnalyzer(pybind11::object analyzer);
 
     pybind11::object getAnalyzer()
@@ -24,7 +26,9 @@ class PYBIND11_EXPORT PythonAnalyzer : public Analyzer
 
     protected:
     pybind11::object m_analyzer;
+    pybind11::object m_act;
     PDataFlags m_flags;
+    DataDependencies m_dependencies;
     };
 
 namespace detail
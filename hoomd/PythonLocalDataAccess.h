@@ -323,6 +323,46 @@ template<class Output, class Data> class LocalDataAccess
                             true);
         }
 
+    /// Convert Global/GPUArray into an Output object with a given shape
+    /** This function is for arrays that are not indexed by particle, such as
+     *  neighbor and cell lists. The caller determines the shape and strides
+     *  of the exposed array.
+     *
+     *  Template parameters:
+     *  T: the value stored in the by the internal array (i.e. the template
+     *  parameter of the ArrayHandle)
+     *  S: the exposed type of data to Python
+     *  U: the templated array class of the parameter array.
+     *
+     *  Arguments:
+     *  handle: a reference to the unique_ptr that holds the ArrayHandle.
+     *  array: the array to expose.
+     *  shape: the shape of the exposed array.
+     *  strides: the strides in bytes of the exposed array.
+     *  read_only: whether the array should be read only (defaults to True).
+     *  offset: the offset in bytes from the start of the array to the
+     *  start of the exposed array in Python (defaults to no offset).
+     */
+    template<class T, class S, template<class> class U = GlobalArray>
+    Output getArrayBuffer(std::unique_ptr<ArrayHandle<T>>& handle,
+                          const U<T>& array,
+                          std::vector<ssize_t> shape,
+                          std::vector<ssize_t> strides,
+                          bool read_only = true,
+                          ssize_t offset = 0)
+        {
+        checkManager();
+        if (!handle)
+            {
+            auto mode = read_only ? access_mode::read : access_mode::readwrite;
+            handle = std::move(std::unique_ptr<ArrayHandle<T>>(
+                new ArrayHandle<T>(array, Output::device, mode)));
+            }
+
+        S* data = (S*)(((char*)handle.get()->data) + offset);
+        return Output::make(data, shape, strides, read_only);
+        }
+
     // clear should remove any references to ArrayHandle objects so the
     // handle can be released for other objects.
     virtual void clear() = 0;
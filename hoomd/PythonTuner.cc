@@ -16,12 +16,13 @@ PythonTuner::PythonTuner(std::shared_ptr<SystemDefinition> sysdef,
 void PythonTuner::update(uint64_t timestep)
     {
     Updater::update(timestep);
-    m_tuner.attr("act")(timestep);
+    m_act(timestep);
     }
 
 void PythonTuner::setTuner(pybind11::object tuner)
     {
     m_tuner = tuner;
+    m_act = tuner.attr("act");
     auto flags = PDataFlags();
     for (auto flag : tuner.attr("flags"))
         {
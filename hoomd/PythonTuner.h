@@ -26,6 +26,7 @@ class PYBIND11_EXPORT PythonTuner : public Tuner
 
     protected:
     pybind11::object m_tuner;
+    pybind11::object m_act;
     PDataFlags m_flags;
     };
 
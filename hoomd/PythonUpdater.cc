@@ -14,18 +14,37 @@ PythonUpdater::PythonUpdater(std::shared_ptr<SystemDefinition> sysdef, pybind11:
 void PythonUpdater::update(uint64_t timestep)
     {
     Updater::update(timestep);
-    m_updater.attr("act")(timestep);
+
+    // System may call this on a worker thread
+    pybind11::gil_scoped_acquire acquire;
+    m_act(timestep);
     }
 
 void PythonUpdater::setUpdater(pybind11::object updater)
     {
     m_updater = updater;
+    m_act = updater.attr("act");
     auto flags = PDataFlags();
     for (auto flag : updater.attr("flags"))
         {
         flags.set(flag.cast<size_t>());
         }
     m_flags = flags;
+
+    // None declares a dependency on all data
+    m_dependencies = DataDependencies();
+    if (!updater.attr("reads").is_none())
+        {
+        m_dependencies.read = data_dependency::none;
+        for (auto data : updater.attr("reads"))
+            m_dependencies.read |= 1u << data.cast<unsigned int>();
+        }
+    if (!updater.attr("writes").is_none())
+        {
+        m_dependencies.write = data_dependency::none;
+        for (auto data : updater.attr("writes"))
+            m_dependencies.write |= 1u << data.cast<unsigned int>();
+        }
     }
 
 PDataFlags PythonUpdater::getRequestedPDataFlags()
@@ -33,6 +52,11 @@ PDataFlags PythonUpdater::getRequestedPDataFlags()
     return m_flags;
     }
 
+DataDependencies PythonUpdater::getDataDependencies()
+    {
+    return m_dependencies;
+    }
+
 namespace detail
     {
 void export_PythonUpdater(pybind11::module& m)
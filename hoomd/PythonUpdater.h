@@ -15,6 +15,8 @@ class PYBIND11_EXPORT PythonUpdater : public Updater
 
     PDataFlags getRequestedPDataFlags();
 
+    DataDependencies getDataDependencies();
+
     void setUpdater(pybind11::object updater);
 
     pybind11::object getUpdater()
@@ -24,7 +26,9 @@ class PYBIND11_EXPORT PythonUpdater : public Updater
 
     protected:
     pybind11::object m_updater;
+    pybind11::object m_act;
     PDataFlags m_flags;
+    DataDependencies m_dependencies;
     };
 
 namespace detail
@@ -64,6 +64,13 @@ struct RNGIdentifier
     static const uint8_t HPMCDepletantNumClusters = 38;
     static const uint8_t HPMCMonoPatch = 39;
     static const uint8_t UpdaterClusters2 = 40;
+    static const uint8_t HPMCMonoCheckerboard = 41;
+    static const uint8_t TriangleMeshGeometryFiller = 42;
+    static const uint8_t UpdaterReplicaExchange = 43;
+    static const uint8_t DynamicBondUpdater = 44;
+    static const uint8_t HPMCMonoChain = 45;
+    static const uint8_t HPMCExternalFieldAccept = 46;
+    static const uint8_t RandomSequentialInitializer = 47;
     };
 
     } // namespace hoomd
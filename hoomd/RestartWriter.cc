@@ -0,0 +1,542 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file RestartWriter.cc
+    \brief Defines the RestartWriter and RestartReader classes
+*/
+
+#include "RestartWriter.h"
+
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace detail
+    {
+//! Magic string at the start of each rank file
+static const char restart_magic[] = "HOOMDRST";
+
+//! Version of the file format
+static const uint32_t restart_version = 1;
+
+//! Append n values to the end of a byte buffer
+template<class T> static void append_values(std::vector<char>& buffer, const T* data, size_t n)
+    {
+    size_t offset = buffer.size();
+    buffer.resize(offset + n * sizeof(T));
+    memcpy(buffer.data() + offset, data, n * sizeof(T));
+    }
+
+//! Append one value to the end of a byte buffer
+template<class T> static void append_value(std::vector<char>& buffer, T value)
+    {
+    append_values(buffer, &value, 1);
+    }
+
+//! Append a string and its length to the end of a byte buffer
+static void append_string(std::vector<char>& buffer, const std::string& s)
+    {
+    append_value(buffer, uint32_t(s.size()));
+    append_values(buffer, s.data(), s.size());
+    }
+
+//! Read n values from a file
+template<class T> static void read_values(ifstream& file, T* data, size_t n)
+    {
+    file.read((char*)data, n * sizeof(T));
+    }
+
+//! Read one value from a file
+template<class T> static T read_value(ifstream& file)
+    {
+    T value;
+    read_values(file, &value, 1);
+    return value;
+    }
+
+//! Read a string and its length from a file
+static std::string read_string(ifstream& file)
+    {
+    uint32_t length = read_value<uint32_t>(file);
+    std::string s(length, ' ');
+    read_values(file, &s[0], length);
+    return s;
+    }
+
+//! Get the name of the file of one rank
+static std::string rank_filename(const std::string& fname, unsigned int rank)
+    {
+    return fname + "." + std::to_string(rank);
+    }
+    } // end namespace detail
+
+/*! \param sysdef SystemDefinition of the simulation
+    \param fname Base file name, each rank writes {fname}.{rank}
+*/
+RestartWriter::RestartWriter(std::shared_ptr<SystemDefinition> sysdef, const std::string& fname)
+    : Analyzer(sysdef), m_fname(fname)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing RestartWriter: " << fname << endl;
+    }
+
+RestartWriter::~RestartWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying RestartWriter" << endl;
+
+    try
+        {
+        wait();
+        }
+    catch (const std::exception& e)
+        {
+        m_exec_conf->msg->error() << e.what() << endl;
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void RestartWriter::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    if (m_prof)
+        m_prof->push("Restart");
+
+    // copy the state while the previous write may still be running
+    fillBuffer(timestep);
+
+    wait();
+    std::swap(m_buffer, m_spare);
+    m_thread = std::thread(&RestartWriter::writeBuffer, this);
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! Rethrows any error that occurred in the background thread.
+ */
+void RestartWriter::wait()
+    {
+    if (m_thread.joinable())
+        m_thread.join();
+
+    if (m_error)
+        {
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void RestartWriter::fillBuffer(uint64_t timestep)
+    {
+    const unsigned int N = m_pdata->getN();
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const Scalar3 origin = m_pdata->getOrigin();
+    const int3 origin_image = m_pdata->getOriginImage();
+
+    std::vector<char>& buf = m_spare;
+    buf.clear();
+
+    // header
+    detail::append_values(buf, detail::restart_magic, 8);
+    detail::append_value(buf, detail::restart_version);
+    detail::append_value(buf, timestep);
+    detail::append_value(buf, uint32_t(m_exec_conf->getRank()));
+    detail::append_value(buf, uint32_t(m_exec_conf->getNRanks()));
+    detail::append_value(buf, uint32_t(N));
+    detail::append_value(buf, uint32_t(m_pdata->getNGlobal()));
+    detail::append_value(buf, uint32_t(m_sysdef->getNDimensions()));
+
+    const Scalar3 L = global_box.getL();
+    double box[6] = {L.x,
+                     L.y,
+                     L.z,
+                     global_box.getTiltFactorXY(),
+                     global_box.getTiltFactorXZ(),
+                     global_box.getTiltFactorYZ()};
+    detail::append_values(buf, box, 6);
+
+    detail::append_value(buf, uint32_t(m_pdata->getNTypes()));
+    for (unsigned int i = 0; i < m_pdata->getNTypes(); i++)
+        detail::append_string(buf, m_pdata->getNameByType(i));
+
+    std::shared_ptr<IntegratorData> integrator_data = m_sysdef->getIntegratorData();
+    detail::append_value(buf, uint32_t(integrator_data->getNumIntegrators()));
+    for (unsigned int i = 0; i < integrator_data->getNumIntegrators(); i++)
+        {
+        const IntegratorVariables& v = integrator_data->getIntegratorVariables(i);
+        detail::append_string(buf, v.type);
+        detail::append_value(buf, uint32_t(v.variable.size()));
+        for (Scalar x : v.variable)
+            detail::append_value(buf, double(x));
+        }
+
+    const std::map<std::string, std::vector<unsigned int>>& hints = m_sysdef->getSizeHints();
+    detail::append_value(buf, uint32_t(hints.size()));
+    for (const auto& hint : hints)
+        {
+        detail::append_string(buf, hint.first);
+        detail::append_value(buf, uint32_t(hint.second.size()));
+        detail::append_values(buf, hint.second.data(), hint.second.size());
+        }
+
+    // per-particle arrays, each stored contiguously
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                  access_location::host,
+                                  access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                   access_location::host,
+                                   access_mode::read);
+
+    detail::append_values(buf, h_tag.data, N);
+
+    for (unsigned int i = 0; i < N; i++)
+        detail::append_value(buf, uint32_t(__scalar_as_int(h_pos.data[i].w)));
+
+    // shift and wrap the positions the same way as ParticleData::takeSnapshot
+    std::vector<int3> images(N);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        Scalar3 pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z) - origin;
+        int3 img = h_image.data[i];
+        img.x -= origin_image.x;
+        img.y -= origin_image.y;
+        img.z -= origin_image.z;
+        global_box.wrap(pos, img);
+
+        double p[3] = {pos.x, pos.y, pos.z};
+        detail::append_values(buf, p, 3);
+        images[i] = img;
+        }
+    detail::append_values(buf, images.data(), N);
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        double v[3] = {h_vel.data[i].x, h_vel.data[i].y, h_vel.data[i].z};
+        detail::append_values(buf, v, 3);
+        }
+    for (unsigned int i = 0; i < N; i++)
+        detail::append_value(buf, double(h_vel.data[i].w));
+    for (unsigned int i = 0; i < N; i++)
+        detail::append_value(buf, double(h_charge.data[i]));
+    for (unsigned int i = 0; i < N; i++)
+        detail::append_value(buf, double(h_diameter.data[i]));
+
+    detail::append_values(buf, h_body.data, N);
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        const Scalar4 q = h_orientation.data[i];
+        double v[4] = {q.x, q.y, q.z, q.w};
+        detail::append_values(buf, v, 4);
+        }
+    for (unsigned int i = 0; i < N; i++)
+        {
+        const Scalar4 q = h_angmom.data[i];
+        double v[4] = {q.x, q.y, q.z, q.w};
+        detail::append_values(buf, v, 4);
+        }
+    for (unsigned int i = 0; i < N; i++)
+        {
+        double v[3] = {h_inertia.data[i].x, h_inertia.data[i].y, h_inertia.data[i].z};
+        detail::append_values(buf, v, 3);
+        }
+    }
+
+/*! Runs in the background thread and must not access the system.
+ */
+void RestartWriter::writeBuffer()
+    {
+    try
+        {
+        const std::string fname = detail::rank_filename(m_fname, m_exec_conf->getRank());
+        const std::string tmp_fname = fname + ".tmp";
+
+            {
+            ofstream file(tmp_fname.c_str(), ios::trunc | ios::out | ios::binary);
+            file.write(m_buffer.data(), m_buffer.size());
+            file.close();
+            if (!file.good())
+                throw runtime_error("Restart: I/O error while writing " + tmp_fname);
+            }
+
+        if (std::rename(tmp_fname.c_str(), fname.c_str()) != 0)
+            throw runtime_error("Restart: Unable to rename " + tmp_fname + " to " + fname);
+        }
+    catch (...)
+        {
+        m_error = std::current_exception();
+        }
+    }
+
+/*! \param exec_conf Execution configuration
+    \param fname Base file name that was given to RestartWriter
+
+    The root rank reads all rank files, the other ranks do not perform file I/O.
+*/
+RestartReader::RestartReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                             const std::string& fname)
+    : m_exec_conf(exec_conf), m_fname(fname), m_timestep(0)
+    {
+    m_snapshot = std::shared_ptr<SnapshotSystemData<double>>(new SnapshotSystemData<double>);
+
+#ifdef ENABLE_MPI
+    // if we are not the root processor, do not perform file I/O
+    if (!m_exec_conf->isRoot())
+        {
+        return;
+        }
+#endif
+
+    unsigned int n_ranks = 0;
+    std::vector<bool> found;
+    readRankFile(0, n_ranks, found);
+    for (unsigned int rank = 1; rank < n_ranks; rank++)
+        readRankFile(rank, n_ranks, found);
+
+    for (bool f : found)
+        {
+        if (!f)
+            throw runtime_error("Restart: The files " + fname + ".* do not hold all particles");
+        }
+    }
+
+/*! \param rank Rank that wrote the file
+    \param n_ranks Number of ranks that wrote the files, set when reading rank 0
+    \param found Flags of the tags that have been read, allocated when reading rank 0
+*/
+void RestartReader::readRankFile(unsigned int rank,
+                                 unsigned int& n_ranks,
+                                 std::vector<bool>& found)
+    {
+    const std::string fname = detail::rank_filename(m_fname, rank);
+    m_exec_conf->msg->notice(3) << "Restart: read file " << fname << endl;
+    ifstream file(fname.c_str(), ios::in | ios::binary);
+    if (!file.good())
+        throw runtime_error("Restart: Unable to open " + fname);
+
+    char magic[8];
+    detail::read_values(file, magic, 8);
+    if (memcmp(magic, detail::restart_magic, 8) != 0)
+        throw runtime_error("Restart: " + fname + " is not a restart file");
+    if (detail::read_value<uint32_t>(file) != detail::restart_version)
+        throw runtime_error("Restart: Unsupported version in " + fname);
+
+    uint64_t timestep = detail::read_value<uint64_t>(file);
+    detail::read_value<uint32_t>(file);
+    unsigned int file_n_ranks = detail::read_value<uint32_t>(file);
+    unsigned int N = detail::read_value<uint32_t>(file);
+    unsigned int N_global = detail::read_value<uint32_t>(file);
+    unsigned int dimensions = detail::read_value<uint32_t>(file);
+    double box[6];
+    detail::read_values(file, box, 6);
+
+    std::vector<std::string> type_mapping(detail::read_value<uint32_t>(file));
+    for (auto& name : type_mapping)
+        name = detail::read_string(file);
+
+    std::vector<IntegratorVariables> integrator_variables(detail::read_value<uint32_t>(file));
+    for (auto& v : integrator_variables)
+        {
+        v.type = detail::read_string(file);
+        v.variable.resize(detail::read_value<uint32_t>(file));
+        for (Scalar& x : v.variable)
+            x = Scalar(detail::read_value<double>(file));
+        }
+
+    std::map<std::string, std::vector<unsigned int>> size_hints;
+    unsigned int n_hints = detail::read_value<uint32_t>(file);
+    for (unsigned int i = 0; i < n_hints && file.good(); i++)
+        {
+        std::string name = detail::read_string(file);
+        std::vector<unsigned int>& hint = size_hints[name];
+        hint.resize(detail::read_value<uint32_t>(file));
+        detail::read_values(file, hint.data(), hint.size());
+        }
+
+    if (!file.good())
+        throw runtime_error("Restart: I/O error while reading the header of " + fname);
+
+    SnapshotParticleData<double>& pdata = m_snapshot->particle_data;
+    if (rank == 0)
+        {
+        n_ranks = file_n_ranks;
+        m_timestep = timestep;
+        m_snapshot->dimensions = dimensions;
+        BoxDim global_box(make_scalar3(box[0], box[1], box[2]));
+        global_box.setTiltFactors(box[3], box[4], box[5]);
+        m_snapshot->global_box = global_box;
+        pdata.resize(N_global);
+        pdata.type_mapping = type_mapping;
+        m_integrator_variables = integrator_variables;
+        found.assign(N_global, false);
+        }
+    else if (timestep != m_timestep || file_n_ranks != n_ranks || N_global != pdata.size)
+        {
+        std::ostringstream s;
+        s << "Restart: " << fname << " is not from the same restart point as "
+          << detail::rank_filename(m_fname, 0);
+        throw runtime_error(s.str());
+        }
+
+    // keep the largest size that any rank needed
+    for (const auto& hint : size_hints)
+        {
+        std::vector<unsigned int>& merged = m_size_hints[hint.first];
+        if (merged.size() < hint.second.size())
+            merged.resize(hint.second.size(), 0);
+        for (size_t i = 0; i < hint.second.size(); i++)
+            merged[i] = std::max(merged[i], hint.second[i]);
+        }
+
+    std::vector<uint32_t> tag(N), type(N), body(N);
+    std::vector<double> pos(3 * N), vel(3 * N), mass(N), charge(N), diameter(N);
+    std::vector<double> orientation(4 * N), angmom(4 * N), inertia(3 * N);
+    std::vector<int3> image(N);
+    detail::read_values(file, tag.data(), N);
+    detail::read_values(file, type.data(), N);
+    detail::read_values(file, pos.data(), 3 * N);
+    detail::read_values(file, image.data(), N);
+    detail::read_values(file, vel.data(), 3 * N);
+    detail::read_values(file, mass.data(), N);
+    detail::read_values(file, charge.data(), N);
+    detail::read_values(file, diameter.data(), N);
+    detail::read_values(file, body.data(), N);
+    detail::read_values(file, orientation.data(), 4 * N);
+    detail::read_values(file, angmom.data(), 4 * N);
+    detail::read_values(file, inertia.data(), 3 * N);
+
+    if (!file.good())
+        throw runtime_error("Restart: I/O error while reading the particles of " + fname);
+
+    // place the particles in tag order
+    for (unsigned int i = 0; i < N; i++)
+        {
+        unsigned int t = tag[i];
+        if (t >= pdata.size || found[t])
+            throw runtime_error("Restart: Invalid particle tag in " + fname);
+        found[t] = true;
+
+        pdata.pos[t] = vec3<double>(pos[3 * i], pos[3 * i + 1], pos[3 * i + 2]);
+        pdata.vel[t] = vec3<double>(vel[3 * i], vel[3 * i + 1], vel[3 * i + 2]);
+        pdata.type[t] = type[i];
+        pdata.mass[t] = mass[i];
+        pdata.charge[t] = charge[i];
+        pdata.diameter[t] = diameter[i];
+        pdata.image[t] = image[i];
+        pdata.body[t] = body[i];
+        pdata.orientation[t] = quat<double>(orientation[4 * i + 3],
+                                            vec3<double>(orientation[4 * i],
+                                                         orientation[4 * i + 1],
+                                                         orientation[4 * i + 2]));
+        pdata.angmom[t] = quat<double>(
+            angmom[4 * i + 3],
+            vec3<double>(angmom[4 * i], angmom[4 * i + 1], angmom[4 * i + 2]));
+        pdata.inertia[t] = vec3<double>(inertia[3 * i], inertia[3 * i + 1], inertia[3 * i + 2]);
+        }
+    }
+
+/*! The timestep is read on the root rank and broadcast to the other ranks.
+ */
+uint64_t RestartReader::getTimeStep() const
+    {
+    uint64_t timestep = m_timestep;
+
+#ifdef ENABLE_MPI
+    bcast(timestep, 0, m_exec_conf->getMPICommunicator());
+#endif
+
+    return timestep;
+    }
+
+/*! \param sysdef System to load the integrator variables into
+
+    Call before the integration methods are created so that they find their saved state, and again
+    after they are created to replace the state they set. Integrators that have registered with a
+    different type keep their variables.
+*/
+void RestartReader::restoreIntegratorVariables(std::shared_ptr<SystemDefinition> sysdef) const
+    {
+    std::vector<IntegratorVariables> integrator_variables = m_integrator_variables;
+
+#ifdef ENABLE_MPI
+    bcast(integrator_variables, 0, m_exec_conf->getMPICommunicator());
+#endif
+
+    std::shared_ptr<IntegratorData> integrator_data = sysdef->getIntegratorData();
+    if (integrator_data->getNumIntegrators() < integrator_variables.size())
+        integrator_data->load((unsigned int)integrator_variables.size());
+
+    for (unsigned int i = 0; i < integrator_variables.size(); i++)
+        {
+        const std::string& type = integrator_data->getIntegratorVariables(i).type;
+        if (type.empty() || type == integrator_variables[i].type)
+            integrator_data->setIntegratorVariables(i, integrator_variables[i]);
+        }
+    }
+
+/*! \param sysdef System to load the size hints into
+
+    Call before the data structures are created so that they allocate enough memory on the first
+    step.
+*/
+void RestartReader::restoreSizeHints(std::shared_ptr<SystemDefinition> sysdef) const
+    {
+    std::map<std::string, std::vector<unsigned int>> size_hints = m_size_hints;
+
+#ifdef ENABLE_MPI
+    bcast(size_hints, 0, m_exec_conf->getMPICommunicator());
+#endif
+
+    for (const auto& hint : size_hints)
+        sysdef->raiseSizeHint(hint.first, hint.second);
+    }
+
+namespace detail
+    {
+void export_RestartWriter(pybind11::module& m)
+    {
+    pybind11::class_<RestartWriter, Analyzer, std::shared_ptr<RestartWriter>>(m, "RestartWriter")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>, std::string>())
+        .def("wait", &RestartWriter::wait)
+        .def_property_readonly("filename", &RestartWriter::getFilename);
+
+    pybind11::class_<RestartReader, std::shared_ptr<RestartReader>>(m, "RestartReader")
+        .def(pybind11::init<std::shared_ptr<const ExecutionConfiguration>, const std::string&>())
+        .def("getTimeStep", &RestartReader::getTimeStep)
+        .def("getSnapshot", &RestartReader::getSnapshot)
+        .def("restoreIntegratorVariables", &RestartReader::restoreIntegratorVariables)
+        .def("restoreSizeHints", &RestartReader::restoreSizeHints);
+    }
+
+    } // end namespace detail
+
+    } // end namespace hoomd
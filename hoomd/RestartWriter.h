@@ -0,0 +1,130 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __RESTART_WRITER_H__
+#define __RESTART_WRITER_H__
+
+#include "Analyzer.h"
+#include "IntegratorData.h"
+#include "SnapshotSystemData.h"
+
+#include <exception>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*! \file RestartWriter.h
+    \brief Declares the RestartWriter and RestartReader classes
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+/// Analyzer that writes restart files in the background
+/*! Each rank copies its local particles and the integrator variables into a host buffer and a
+    background thread writes the buffer to the file {fname}.{rank}. The simulation continues while
+    the thread writes, so the cost on the simulation ranks is the copy of the local particles. No
+    particles are gathered to the root rank.
+
+    The thread first writes {fname}.{rank}.tmp and then renames it, so each rank file always holds
+    a complete restart point. The next call to analyze() fills the spare buffer before it waits for
+    the previous write to complete. Errors in the background thread are raised by the next call to
+    analyze() or wait().
+
+    The positions and images are stored in the unshifted global frame, the same as in a snapshot.
+    The sizes that the neighbor and cell lists reserved (see SystemDefinition::getSizeHint()) are
+    stored so that a continued simulation can allocate enough memory on the first step. Bonded
+    groups are not stored.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT RestartWriter : public Analyzer
+    {
+    public:
+    /// Construct the writer
+    RestartWriter(std::shared_ptr<SystemDefinition> sysdef, const std::string& fname);
+
+    /// Destructor
+    ~RestartWriter();
+
+    /// Start writing the state at the current timestep
+    void analyze(uint64_t timestep);
+
+    /// Wait for the background write to complete
+    void wait();
+
+    std::string getFilename()
+        {
+        return m_fname;
+        }
+
+    private:
+    std::string m_fname;        //!< The base file name
+    std::vector<char> m_buffer; //!< Buffer that the background thread writes
+    std::vector<char> m_spare;  //!< Buffer that analyze() fills
+    std::thread m_thread;       //!< Thread that writes m_buffer
+    std::exception_ptr m_error; //!< Error raised by the background thread
+
+    /// Copy the local state into m_spare
+    void fillBuffer(uint64_t timestep);
+
+    /// Write m_buffer to the rank file (runs in the background thread)
+    void writeBuffer();
+    };
+
+/// Reads the rank files written by RestartWriter
+/*! The root rank reads the files of all ranks and assembles a snapshot in tag order. The files
+    may be read with a different number of ranks than they were written with.
+*/
+class PYBIND11_EXPORT RestartReader
+    {
+    public:
+    /// Read the files
+    RestartReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                  const std::string& fname);
+
+    /// Get the timestep of the restart point
+    uint64_t getTimeStep() const;
+
+    /// Get the snapshot of the particle data
+    std::shared_ptr<SnapshotSystemData<double>> getSnapshot() const
+        {
+        return m_snapshot;
+        }
+
+    /// Load the integrator variables into the system
+    void restoreIntegratorVariables(std::shared_ptr<SystemDefinition> sysdef) const;
+
+    /// Load the sizes reserved by the data structures into the system
+    void restoreSizeHints(std::shared_ptr<SystemDefinition> sysdef) const;
+
+    private:
+    std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
+    std::string m_fname;                                       //!< The base file name
+    uint64_t m_timestep;                                       //!< Timestep of the restart point
+    std::shared_ptr<SnapshotSystemData<double>> m_snapshot;    //!< The snapshot
+    std::vector<IntegratorVariables> m_integrator_variables;   //!< The integrator variables
+
+    //! Largest sizes that the data structures of any rank reserved
+    std::map<std::string, std::vector<unsigned int>> m_size_hints;
+
+    /// Read the file of one rank
+    void readRankFile(unsigned int rank, unsigned int& n_ranks, std::vector<bool>& found);
+    };
+
+namespace detail
+    {
+/// Exports the RestartWriter and RestartReader classes to python
+void export_RestartWriter(pybind11::module& m);
+    } // end namespace detail
+
+    } // end namespace hoomd
+
+#endif // __RESTART_WRITER_H__
@@ -0,0 +1,110 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __SFC_PACK_KEYS_H__
+#define __SFC_PACK_KEYS_H__
+
+#include "HOOMDMath.h"
+
+#include <stdint.h>
+
+/*! \file SFCPackKeys.h
+    \brief Defines the 64 bit Morton keys used by SFCPackTuner and SFCPackTunerGPU
+
+    The Morton (Z order) key of a grid cell interleaves the bits of the cell coordinates. Unlike
+    the Hilbert traversal order, the key is computed directly from the cell coordinates and needs
+    no lookup table, so the grid dimension is limited only by the width of the key: 2^21 cells
+    along each direction in 3D and 2^31 in 2D.
+*/
+
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+namespace hoomd
+    {
+namespace detail
+    {
+//! Largest Morton grid dimension in 3D
+const unsigned int SFC_MORTON_MAX_GRID_3D = 1u << 21;
+
+//! Largest Morton grid dimension in 2D
+const unsigned int SFC_MORTON_MAX_GRID_2D = 1u << 31;
+
+//! Spread the lower 21 bits of \a v so that two zero bits follow each bit
+HOSTDEVICE inline uint64_t sfc_spread_bits_3d(uint64_t v)
+    {
+    v &= 0x1fffffULL;
+    v = (v | v << 32) & 0x1f00000000ffffULL;
+    v = (v | v << 16) & 0x1f0000ff0000ffULL;
+    v = (v | v << 8) & 0x100f00f00f00f00fULL;
+    v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+    v = (v | v << 2) & 0x1249249249249249ULL;
+    return v;
+    }
+
+//! Spread the lower 32 bits of \a v so that one zero bit follows each bit
+HOSTDEVICE inline uint64_t sfc_spread_bits_2d(uint64_t v)
+    {
+    v &= 0xffffffffULL;
+    v = (v | v << 16) & 0x0000ffff0000ffffULL;
+    v = (v | v << 8) & 0x00ff00ff00ff00ffULL;
+    v = (v | v << 4) & 0x0f0f0f0f0f0f0f0fULL;
+    v = (v | v << 2) & 0x3333333333333333ULL;
+    v = (v | v << 1) & 0x5555555555555555ULL;
+    return v;
+    }
+
+//! Find the grid cell along one direction
+/*! \param f Fractional coordinate of the particle
+    \param n_grid Number of grid cells along the direction
+
+    Particles slightly outside the box are moved back into the grid.
+*/
+HOSTDEVICE inline unsigned int sfc_grid_cell(Scalar f, unsigned int n_grid)
+    {
+    Scalar x = f * Scalar(n_grid);
+    if (x < Scalar(0.0))
+        return 0;
+
+    unsigned int i = (unsigned int)x;
+    return i < n_grid ? i : n_grid - 1;
+    }
+
+//! Compute the Morton key of a particle
+/*! \param f Fractional coordinates of the particle in the box
+    \param n_grid Number of grid cells along each direction
+    \param twod If true, ignore the z direction
+*/
+HOSTDEVICE inline uint64_t sfc_morton_key(Scalar3 f, unsigned int n_grid, bool twod)
+    {
+    uint64_t i = sfc_grid_cell(f.x, n_grid);
+    uint64_t j = sfc_grid_cell(f.y, n_grid);
+
+    if (twod)
+        return sfc_spread_bits_2d(i) << 1 | sfc_spread_bits_2d(j);
+
+    uint64_t k = sfc_grid_cell(f.z, n_grid);
+    return sfc_spread_bits_3d(i) << 2 | sfc_spread_bits_3d(j) << 1 | sfc_spread_bits_3d(k);
+    }
+
+//! Number of significant bits in the Morton keys
+/*! \param n_grid Number of grid cells along each direction, a power of 2
+    \param twod If true, the keys are 2D
+*/
+HOSTDEVICE inline unsigned int sfc_morton_key_bits(unsigned int n_grid, bool twod)
+    {
+    unsigned int bits = 0;
+    while ((1ULL << bits) < n_grid)
+        bits++;
+    return bits * (twod ? 2 : 3);
+    }
+
+    } // end namespace detail
+    } // end namespace hoomd
+
+#endif // __SFC_PACK_KEYS_H__
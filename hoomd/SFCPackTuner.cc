@@ -9,11 +9,13 @@
 
 #include "SFCPackTuner.h"
 #include "Communicator.h"
+#include "SFCPackKeys.h"
 
 #include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <math.h>
+#include <sstream>
 #include <stdexcept>
 
 using namespace std;
@@ -33,6 +35,7 @@ SFCPackTuner::SFCPackTuner(std::shared_ptr<SystemDefinition> sysdef,
 
     m_sort_order.resize(m_pdata->getMaxN());
     m_particle_bins.resize(m_pdata->getMaxN());
+    m_particle_keys.resize(m_pdata->getMaxN());
 
     // set the default grid
     // Grid dimension must always be a power of 2 and determines the memory usage for
@@ -63,6 +66,7 @@ void SFCPackTuner::reallocate()
     {
     m_sort_order.resize(m_pdata->getMaxN());
     m_particle_bins.resize(m_pdata->getMaxN());
+    m_particle_keys.resize(m_pdata->getMaxN());
     }
 
 /*! Destructor
@@ -101,7 +105,19 @@ void SFCPackTuner::update(uint64_t timestep)
         m_prof->push(m_exec_conf, "SFCPack");
 
     // figure out the sort order we need to apply
-    if (m_sysdef->getNDimensions() == 2)
+    if (m_curve == Curve::morton)
+        {
+        unsigned int max_grid = m_sysdef->getNDimensions() == 2 ? detail::SFC_MORTON_MAX_GRID_2D
+                                                                : detail::SFC_MORTON_MAX_GRID_3D;
+        if (m_grid > max_grid)
+            {
+            std::ostringstream s;
+            s << "Sorter grid " << m_grid << " exceeds the Morton curve limit " << max_grid << ".";
+            throw std::runtime_error(s.str());
+            }
+        getSortedOrderMorton();
+        }
+    else if (m_sysdef->getNDimensions() == 2)
         getSortedOrder2D();
     else
         getSortedOrder3D();
@@ -657,6 +673,39 @@ void SFCPackTuner::getSortedOrder3D()
         }
     }
 
+void SFCPackTuner::getSortedOrderMorton()
+    {
+    assert(m_pdata);
+    assert(m_particle_keys.size() >= m_pdata->getN());
+
+    const BoxDim& box = m_pdata->getBox();
+    bool twod = m_sysdef->getNDimensions() == 2;
+
+        // compute the key of each particle
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+
+        for (unsigned int n = 0; n < m_pdata->getN(); n++)
+            {
+            Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
+            Scalar3 f = box.makeFraction(p, make_scalar3(0.0, 0.0, 0.0));
+            m_particle_keys[n]
+                = std::pair<uint64_t, unsigned int>(detail::sfc_morton_key(f, m_grid, twod), n);
+            }
+        }
+
+    // sort the tuples
+    sort(m_particle_keys.begin(), m_particle_keys.begin() + m_pdata->getN());
+
+    // translate the sorted order
+    for (unsigned int j = 0; j < m_pdata->getN(); j++)
+        {
+        m_sort_order[j] = m_particle_keys[j].second;
+        }
+    }
+
 void SFCPackTuner::writeTraversalOrder(const std::string& fname,
                                        const vector<unsigned int>& reverse_order)
     {
@@ -697,7 +746,8 @@ void export_SFCPackTuner(pybind11::module& m)
     {
     pybind11::class_<SFCPackTuner, Tuner, std::shared_ptr<SFCPackTuner>>(m, "SFCPackTuner")
         .def(pybind11::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<Trigger>>())
-        .def_property("grid", &SFCPackTuner::getGrid, &SFCPackTuner::setGridPython);
+        .def_property("grid", &SFCPackTuner::getGrid, &SFCPackTuner::setGridPython)
+        .def_property("curve", &SFCPackTuner::getCurvePython, &SFCPackTuner::setCurvePython);
     }
 
     } // end namespace detail
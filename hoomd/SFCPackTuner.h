@@ -16,6 +16,8 @@
 
 #include <memory>
 #include <pybind11/pybind11.h>
+#include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -45,11 +47,22 @@ namespace hoomd
    based on the order in which those bins appear along a hilbert curve. It is very efficient, even
    when the box size changes often as the grid dimension is kept constant.
 
+    The Morton curve is an alternative to the Hilbert curve. Morton keys are computed directly from
+    the grid cell of each particle (see SFCPackKeys.h), so they need no traversal order table and
+    order the particles along a space filling curve in 2D as well. Select them with setCurve().
+
     \ingroup updaters
 */
 class PYBIND11_EXPORT SFCPackTuner : public Tuner
     {
     public:
+    //! Space filling curves to order the particles along
+    enum class Curve
+        {
+        hilbert, //!< Hilbert curve traversal order (row major order in 2D)
+        morton   //!< Morton curve, ordered by 64 bit keys
+        };
+
     //! Constructor
     SFCPackTuner(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<Trigger> trigger);
 
@@ -82,8 +95,38 @@ class PYBIND11_EXPORT SFCPackTuner : public Tuner
         return m_grid;
         }
 
+    //! Set the space filling curve
+    void setCurve(Curve curve)
+        {
+        m_curve = curve;
+        }
+
+    //! Get the space filling curve
+    Curve getCurve()
+        {
+        return m_curve;
+        }
+
+    //! Set the space filling curve by name
+    void setCurvePython(const std::string& curve)
+        {
+        if (curve == "hilbert")
+            m_curve = Curve::hilbert;
+        else if (curve == "morton")
+            m_curve = Curve::morton;
+        else
+            throw std::invalid_argument("Invalid space filling curve: " + curve);
+        }
+
+    //! Get the name of the space filling curve
+    std::string getCurvePython()
+        {
+        return m_curve == Curve::morton ? "morton" : "hilbert";
+        }
+
     protected:
     unsigned int m_grid;                      //!< Grid dimension to use
+    Curve m_curve = Curve::hilbert;           //!< Space filling curve to sort along
     unsigned int m_last_grid;                 //!< The last value of MMax
     unsigned int m_last_dim;                  //!< Check the last dimension we ran at
     GPUArray<unsigned int> m_traversal_order; //!< Generated traversal order of bins
@@ -92,6 +135,8 @@ class PYBIND11_EXPORT SFCPackTuner : public Tuner
     virtual void getSortedOrder2D();
     //! Helper function that actually performs the sort
     virtual void getSortedOrder3D();
+    //! Helper function that performs the sort along the Morton curve
+    virtual void getSortedOrderMorton();
 
     //! Apply the sorted order to the particle data
     virtual void applySortOrder();
@@ -115,6 +160,7 @@ class PYBIND11_EXPORT SFCPackTuner : public Tuner
     private:
     std::vector<unsigned int> m_sort_order; //!< Generated sort order of the particles
     std::vector<std::pair<unsigned int, unsigned int>> m_particle_bins; //!< Binned particles
+    std::vector<std::pair<uint64_t, unsigned int>> m_particle_keys;     //!< Morton keys
     std::shared_ptr<Trigger> m_trigger;
 
 #ifdef ENABLE_MPI
@@ -149,6 +149,29 @@ void SFCPackTunerGPU::getSortedOrder3D()
         CHECK_CUDA_ERROR();
     }
 
+void SFCPackTunerGPU::getSortedOrderMorton()
+    {
+    assert(m_pdata);
+    assert(m_gpu_sort_order.getNumElements() >= m_pdata->getN());
+
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_gpu_sort_order(m_gpu_sort_order,
+                                               access_location::device,
+                                               access_mode::overwrite);
+
+    // compute the keys and radix sort them
+    kernel::gpu_generate_morton_sorted_order(m_pdata->getN(),
+                                             d_pos.data,
+                                             m_grid,
+                                             d_gpu_sort_order.data,
+                                             m_pdata->getBox(),
+                                             m_sysdef->getNDimensions() == 2,
+                                             m_exec_conf->getCachedAllocator());
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
 void SFCPackTunerGPU::applySortOrder()
     {
     assert(m_pdata);
@@ -17,6 +17,9 @@
 #include <thrust/sort.h>
 #pragma GCC diagnostic pop
 
+#include <hipcub/hipcub.hpp>
+
+#include "SFCPackKeys.h"
 #include "SFCPackTunerGPU.cuh"
 
 namespace hoomd
@@ -147,6 +150,114 @@ void gpu_generate_sorted_order(unsigned int N,
         }
     }
 
+//! Kernel to compute the Morton keys of the particles
+template<bool twod>
+__global__ void gpu_sfc_morton_keys_kernel(unsigned int N,
+                                           const Scalar4* d_pos,
+                                           unsigned int n_grid,
+                                           uint64_t* d_keys,
+                                           unsigned int* d_idx,
+                                           const BoxDim box)
+    {
+    unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    Scalar4 postype = d_pos[idx];
+    Scalar3 f = box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+
+    d_keys[idx] = detail::sfc_morton_key(f, n_grid, twod);
+    d_idx[idx] = idx;
+    }
+
+/*! \param N number of local particles
+    \param d_pos Device array of positions
+    \param n_grid Number of grid elements along one edge
+    \param d_sorted_order Sorted order of particles
+    \param box Box dimensions
+    \param twod If true, compute 2D keys
+    \param alloc Caching allocator for the temporary buffers
+
+    The keys and indices are radix sorted on only the significant bits of the keys, so coarse grids
+    need fewer passes.
+*/
+void gpu_generate_morton_sorted_order(unsigned int N,
+                                      const Scalar4* d_pos,
+                                      unsigned int n_grid,
+                                      unsigned int* d_sorted_order,
+                                      const BoxDim& box,
+                                      bool twod,
+                                      CachedAllocator& alloc)
+    {
+    if (N == 0)
+        return;
+
+    uint64_t* d_keys = alloc.getTemporaryBuffer<uint64_t>(N);
+    uint64_t* d_keys_sorted = alloc.getTemporaryBuffer<uint64_t>(N);
+    unsigned int* d_idx = alloc.getTemporaryBuffer<unsigned int>(N);
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = N / block_size + 1;
+
+    if (twod)
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_sfc_morton_keys_kernel<true>),
+                           dim3(n_blocks),
+                           dim3(block_size),
+                           0,
+                           0,
+                           N,
+                           d_pos,
+                           n_grid,
+                           d_keys,
+                           d_idx,
+                           box);
+    else
+        hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_sfc_morton_keys_kernel<false>),
+                           dim3(n_blocks),
+                           dim3(block_size),
+                           0,
+                           0,
+                           N,
+                           d_pos,
+                           n_grid,
+                           d_keys,
+                           d_idx,
+                           box);
+
+    int end_bit = detail::sfc_morton_key_bits(n_grid, twod);
+
+    // determine temporary device storage requirements
+    void* d_temp_storage = NULL;
+    size_t temp_storage_bytes = 0;
+    hipcub::DeviceRadixSort::SortPairs(d_temp_storage,
+                                       temp_storage_bytes,
+                                       d_keys,
+                                       d_keys_sorted,
+                                       d_idx,
+                                       d_sorted_order,
+                                       N,
+                                       0,
+                                       end_bit);
+    d_temp_storage = alloc.allocate(temp_storage_bytes);
+
+    // key-value sort
+    hipcub::DeviceRadixSort::SortPairs(d_temp_storage,
+                                       temp_storage_bytes,
+                                       d_keys,
+                                       d_keys_sorted,
+                                       d_idx,
+                                       d_sorted_order,
+                                       N,
+                                       0,
+                                       end_bit);
+    alloc.deallocate((char*)d_temp_storage);
+
+    alloc.deallocate((char*)d_idx);
+    alloc.deallocate((char*)d_keys_sorted);
+    alloc.deallocate((char*)d_keys);
+    }
+
 //! Kernel to apply sorted order
 __global__ void gpu_apply_sorted_order_kernel(unsigned int N,
                                               unsigned int n_ghost,
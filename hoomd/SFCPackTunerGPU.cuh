@@ -30,6 +30,15 @@ void gpu_generate_sorted_order(unsigned int N,
                                bool twod,
                                CachedAllocator& alloc);
 
+//! Generate the sorted order along the Morton curve on the GPU
+void gpu_generate_morton_sorted_order(unsigned int N,
+                                      const Scalar4* d_pos,
+                                      unsigned int n_grid,
+                                      unsigned int* d_sorted_order,
+                                      const BoxDim& box,
+                                      bool twod,
+                                      CachedAllocator& alloc);
+
 //! Reorder particle data (GPU driver function)
 void gpu_apply_sorted_order(unsigned int N,
                             unsigned int n_ghost,
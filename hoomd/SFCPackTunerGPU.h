@@ -57,6 +57,9 @@ class PYBIND11_EXPORT SFCPackTunerGPU : public SFCPackTuner
     //! Helper function that actually performs the sort
     virtual void getSortedOrder3D();
 
+    //! Helper function that performs the sort along the Morton curve
+    virtual void getSortedOrderMorton();
+
     //! Apply the sorted order to the particle data
     virtual void applySortOrder();
     };
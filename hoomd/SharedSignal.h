@@ -44,10 +44,18 @@ template<class SignalType> class SharedSignal : public Nano::Signal<SignalType>
         // references to the signal before it is freed.
         disconnect_signal.emit();
         }
+
+    //! Get the number of SharedSignalSlots connected to this signal
+    unsigned int getNumSlots() const
+        {
+        return m_num_slots;
+        }
+
     friend class SharedSignalSlot<SignalType>;
 
     private:
     Nano::Signal<void()> disconnect_signal; //!< Disconnect Signal
+    unsigned int m_num_slots = 0;           //!< Number of connected SharedSignalSlots
     };
 
 //! Manages signal lifetime and slot lifetime
@@ -129,6 +137,7 @@ template<typename R, typename... Args> class SharedSignalSlot<R(Args...)> : publ
         m_signal.disconnect_signal.template disconnect<SharedSignalSlot<R(Args...)>,
                                                        &SharedSignalSlot<R(Args...)>::disconnect>(
             this);
+        m_signal.m_num_slots--;
         m_connected = false;
         }
 
@@ -139,6 +148,7 @@ template<typename R, typename... Args> class SharedSignalSlot<R(Args...)> : publ
                                                     &SharedSignalSlot<R(Args...)>::disconnect>(
             this);
         m_signal.connect(m_func);
+        m_signal.m_num_slots++;
         m_connected = true;
         }
 
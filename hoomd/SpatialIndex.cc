@@ -0,0 +1,223 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file SpatialIndex.cc
+    \brief Defines the SpatialIndex class
+*/
+
+#include "SpatialIndex.h"
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+/*! \param pdata Particle data to index
+ */
+SpatialIndex::SpatialIndex(std::shared_ptr<ParticleData> pdata)
+    : m_pdata(pdata), m_exec_conf(pdata->getExecConf()), m_valid(false), m_version(0),
+      m_num_builds(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing SpatialIndex" << endl;
+    }
+
+/*! \param ghost_width Width of the ghost layer in each non-periodic direction
+    \returns The tree of each type
+
+    The trees are built only if the particles have changed since the last build. \a ghost_width is
+    used only to check that no local particle is out of bounds, and it does not change the trees.
+*/
+const std::vector<hoomd::detail::AABBTree>& SpatialIndex::getTypeTrees(const Scalar3& ghost_width)
+    {
+    if (!m_valid || m_version != m_pdata->getPositionVersion()
+        || m_trees.size() != m_pdata->getNTypes())
+        {
+        m_valid = false;
+        buildTrees(ghost_width);
+        m_version = m_pdata->getPositionVersion();
+        m_valid = true;
+        m_num_builds++;
+        }
+    return m_trees;
+    }
+
+/*!
+ * Efficiently "sorts" particles by type into trees by generating a map from the local particle id
+ * to the id within a flat array of AABBs sorted by type.
+ */
+void SpatialIndex::mapParticlesByType()
+    {
+    const unsigned int n_types = m_pdata->getNTypes();
+    std::fill(m_num_per_type.begin(), m_num_per_type.end(), 0);
+
+    // histogram all particles on this rank, and accumulate their positions within the tree
+    const unsigned int n_local = m_pdata->getN() + m_pdata->getNGhosts();
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+    for (unsigned int i = 0; i < n_local; ++i)
+        {
+        unsigned int my_type = __scalar_as_int(h_postype.data[i].w);
+        m_map_pid_tree[i] = m_num_per_type[my_type];
+        ++m_num_per_type[my_type];
+        }
+
+    // set the head for each type in m_aabbs by looping back over the types
+    unsigned int local_head = 0;
+    for (unsigned int i = 0; i < n_types; ++i)
+        {
+        m_type_head[i] = local_head;
+        local_head += m_num_per_type[i];
+        }
+    }
+
+/*! \param ghost_width Width of the ghost layer in each non-periodic direction
+
+    \note AABBTree implements its own build routine, so this is a wrapper to call this for multiple
+    tree types.
+*/
+void SpatialIndex::buildTrees(const Scalar3& ghost_width)
+    {
+    const unsigned int n_types = m_pdata->getNTypes();
+    const unsigned int n_local = m_pdata->getN() + m_pdata->getNGhosts();
+
+    if (m_trees.size() != n_types)
+        {
+        // double corruption happens if we just resize due to the way the AABBNodes are allocated
+        // so first destroy all of the trees from the vector and then resize
+        m_trees.clear();
+        m_trees.resize(n_types);
+        m_num_per_type.resize(n_types);
+        m_type_head.resize(n_types);
+        }
+
+    if (m_aabbs.size() < n_local)
+        {
+        m_aabbs.resize(n_local);
+        m_map_pid_tree.resize(n_local);
+        }
+
+    mapParticlesByType();
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<hoomd::detail::AABB> h_aabbs(m_aabbs,
+                                             access_location::host,
+                                             access_mode::overwrite);
+    const BoxDim& box = m_pdata->getBox();
+
+    // construct a point AABB for each particle owned by this rank, and push it into the right spot
+    // in the AABB list. Returns false if a local particle is out of bounds.
+    auto make_particle_aabb = [&](unsigned int i) -> bool
+    {
+        // make a point particle AABB
+        vec3<Scalar> my_pos(h_postype.data[i]);
+
+        /* check if the particle is inside the unit cell + ghost layer in all dimensions
+         *
+         * This is not strictly necessary for building the tree, but the tree traversal
+         * may get stuck when particles are far outside the box
+         */
+        Scalar3 f = box.makeFraction(vec_to_scalar3(my_pos), ghost_width);
+        if (((f.x < Scalar(-0.00001) || f.x >= Scalar(1.00001))
+             || (f.y < Scalar(-0.00001) || f.y >= Scalar(1.00001))
+             || (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)))
+            && i < m_pdata->getN())
+            {
+            return false;
+            }
+
+        unsigned int my_type = __scalar_as_int(h_postype.data[i].w);
+        unsigned int my_aabb_idx = m_type_head[my_type] + m_map_pid_tree[i];
+        h_aabbs.data[my_aabb_idx] = hoomd::detail::AABB(my_pos, i);
+        return true;
+    };
+
+    // index of the first particle found out of bounds
+    unsigned int out_of_bounds = n_local;
+
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                out_of_bounds = tbb::parallel_reduce(
+                    tbb::blocked_range<unsigned int>(0, n_local),
+                    n_local,
+                    [&](const tbb::blocked_range<unsigned int>& r, unsigned int first) -> unsigned int
+                    {
+                        for (unsigned int i = r.begin(); i != r.end(); ++i)
+                            if (!make_particle_aabb(i))
+                                return std::min(first, i);
+                        return first;
+                    },
+                    [](unsigned int a, unsigned int b) -> unsigned int { return std::min(a, b); });
+
+                // call the tree build routine, one tree per type
+                if (out_of_bounds == n_local)
+                    {
+                    tbb::parallel_for(
+                        tbb::blocked_range<unsigned int>(0, n_types),
+                        [&](const tbb::blocked_range<unsigned int>& r)
+                        {
+                            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                if (m_num_per_type[i] > 0)
+                                    m_trees[i].buildTree(&(h_aabbs.data[0]) + m_type_head[i],
+                                                         m_num_per_type[i]);
+                        },
+                        tbb::simple_partitioner());
+                    }
+            }); // end task arena execute()
+        }
+    else
+#endif
+        {
+        for (unsigned int i = 0; i < n_local; ++i)
+            {
+            if (!make_particle_aabb(i))
+                {
+                out_of_bounds = i;
+                break;
+                }
+            }
+
+        // call the tree build routine, one tree per type
+        if (out_of_bounds == n_local)
+            {
+            for (unsigned int i = 0; i < n_types; ++i)
+                {
+                if (m_num_per_type[i] > 0)
+                    {
+                    m_trees[i].buildTree(&(h_aabbs.data[0]) + m_type_head[i], m_num_per_type[i]);
+                    }
+                }
+            }
+        }
+
+    if (out_of_bounds != n_local)
+        {
+        const unsigned int i = out_of_bounds;
+        vec3<Scalar> my_pos(h_postype.data[i]);
+        Scalar3 f = box.makeFraction(vec_to_scalar3(my_pos), ghost_width);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        m_exec_conf->msg->errorAllRanks()
+            << "Particle " << h_tag.data[i] << " is out of bounds "
+            << "(x: " << my_pos.x << ", y: " << my_pos.y << ", z: " << my_pos.z
+            << ", fx: " << f.x << ", fy: " << f.y << ", fz:" << f.z << ")" << endl;
+        throw runtime_error("Error building the spatial index");
+        }
+    }
+
+    } // end namespace hoomd
@@ -0,0 +1,84 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file SpatialIndex.h
+    \brief Declares the SpatialIndex class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "AABBTree.h"
+#include "GPUVector.h"
+#include "ParticleData.h"
+
+#include <memory>
+#include <vector>
+
+#ifndef __SPATIAL_INDEX_H__
+#define __SPATIAL_INDEX_H__
+
+namespace hoomd
+    {
+//! Point AABB trees of the particles of each type, shared by all classes on a rank
+/*! Several classes search for the particles of a type near a point, such as every NeighborListTree
+    in the simulation. Each of them used to build its own trees from the same positions. The
+    SpatialIndex owned by the SystemDefinition builds one AABBTree of point AABBs for the local and
+    ghost particles of each type, and it reuses the trees until ParticleData::getPositionVersion()
+    changes. All classes that search on the same step therefore share a single build.
+
+    The version changes when particles are moved, sorted, migrated, retyped, or when the ghosts
+    are exchanged or updated, so the trees never need to be invalidated by hand. Classes that write
+    to the particle positions must call ParticleData::notifyPositionsChanged().
+
+    The leaves of the trees hold the local index of each particle.
+*/
+class PYBIND11_EXPORT SpatialIndex
+    {
+    public:
+    //! Constructor
+    SpatialIndex(std::shared_ptr<ParticleData> pdata);
+
+    //! Get the tree of each type, building the trees if the particles have changed
+    const std::vector<hoomd::detail::AABBTree>& getTypeTrees(const Scalar3& ghost_width);
+
+    //! Get the number of particles in the tree of each type
+    /*! \pre getTypeTrees() has been called for the current positions
+     */
+    const std::vector<unsigned int>& getNumPerType() const
+        {
+        return m_num_per_type;
+        }
+
+    //! Get the number of times the trees have been built
+    uint64_t getNumBuilds() const
+        {
+        return m_num_builds;
+        }
+
+    private:
+    std::shared_ptr<ParticleData> m_pdata;                     //!< The particle data
+    std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
+
+    // the trees are optimized for the CPU with SIMD support and are never accessed on the GPU
+    std::vector<hoomd::detail::AABBTree> m_trees; //!< Tree of each type
+    GPUVector<hoomd::detail::AABB> m_aabbs;       //!< Flat array of the AABBs of all types
+    std::vector<unsigned int> m_num_per_type;     //!< Number of particles of each type
+    std::vector<unsigned int> m_type_head;        //!< Index of the first AABB of each type
+    std::vector<unsigned int> m_map_pid_tree;     //!< Index of each particle within its type
+
+    bool m_valid;          //!< True if the trees have been built
+    uint64_t m_version;    //!< Position version the trees were built at
+    uint64_t m_num_builds; //!< Number of builds
+
+    //! Count the particles of each type and assign each its index within its type
+    void mapParticlesByType();
+
+    //! Build the trees
+    void buildTrees(const Scalar3& ghost_width);
+    };
+
+    } // end namespace hoomd
+
+#endif // __SPATIAL_INDEX_H__
@@ -8,6 +8,7 @@
 */
 
 #include "System.h"
+#include "AutotunerCache.h"
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
@@ -16,6 +17,9 @@
 // #include <pybind11/pybind11.h>
 #include <pybind11/cast.h>
 #include <pybind11/stl_bind.h>
+#include <algorithm>
+#include <functional>
+#include <future>
 #include <stdexcept>
 #include <time.h>
 
@@ -31,6 +35,70 @@ PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<hoomd::Tuner>>)
 
 namespace hoomd
     {
+namespace
+    {
+//! Executes operations in order on a worker thread
+/*! The calling thread releases the GIL while it waits for the worker, so Python operations on the
+    worker can acquire it. The destructor waits for the worker, also when an exception on the
+    calling thread unwinds the run loop.
+*/
+class ConcurrentOperations
+    {
+    public:
+    //! Wait for the worker
+    ~ConcurrentOperations()
+        {
+        if (m_future.valid())
+            {
+            std::unique_ptr<pybind11::gil_scoped_release> release;
+            if (PyGILState_Check())
+                release.reset(new pybind11::gil_scoped_release());
+            m_future.wait();
+            }
+        }
+
+    //! Add an operation to execute
+    void add(std::function<void()> operation)
+        {
+        m_operations.push_back(operation);
+        }
+
+    //! Start executing the added operations on the worker
+    void launch()
+        {
+        if (m_operations.empty())
+            return;
+
+        m_future = std::async(std::launch::async,
+                              [this]()
+                              {
+                                  for (auto& operation : m_operations)
+                                      operation();
+                              });
+        }
+
+    //! Wait for the worker and rethrow the exception of the first operation that failed
+    void join()
+        {
+        if (!m_future.valid())
+            return;
+
+            {
+            std::unique_ptr<pybind11::gil_scoped_release> release;
+            if (PyGILState_Check())
+                release.reset(new pybind11::gil_scoped_release());
+            m_future.wait();
+            }
+        m_operations.clear();
+        m_future.get();
+        }
+
+    private:
+    std::vector<std::function<void()>> m_operations; //!< Operations to execute
+    std::future<void> m_future;                      //!< Completion of the worker
+    };
+    } // end anonymous namespace
+
 /*! \param sysdef SystemDefinition for the system to be simulated
     \param initial_tstep Initial time step of the simulation
 
@@ -40,12 +108,15 @@ namespace hoomd
 */
 System::System(std::shared_ptr<SystemDefinition> sysdef, uint64_t initial_tstep)
     : m_sysdef(sysdef), m_start_tstep(initial_tstep), m_end_tstep(0), m_cur_tstep(initial_tstep),
-      m_profile(false)
+      m_profile(false), m_release_gil(false), m_max_batch_steps(1)
     {
     // sanity check
     assert(m_sysdef);
     m_exec_conf = m_sysdef->getParticleData()->getExecConf();
 
+    // compute energies on every step unless the user opts out
+    m_default_flags[pdata_flag::potential_energy] = 1;
+
 #ifdef ENABLE_MPI
     // the initial time step is defined on the root processor
     if (m_sysdef->getParticleData()->getDomainDecomposition())
@@ -98,6 +169,21 @@ void System::run(uint64_t nsteps, bool write_at_start)
 
     resetStats();
 
+#ifdef ENABLE_HIP
+    // report the managed memory page faults of this run when they are counted
+    std::map<std::string, uint64_t> managed_memory_counts;
+    if (m_exec_conf->isManagedMemoryCountingEnabled())
+        managed_memory_counts = m_exec_conf->getManagedMemoryCounts();
+#endif
+
+    // autotuners look up their cached parameters for systems of similar size and density
+        {
+        std::shared_ptr<ParticleData> pdata = m_sysdef->getParticleData();
+        unsigned int N = pdata->getNGlobal();
+        Scalar volume = pdata->getGlobalBox().getVolume(m_sysdef->getNDimensions() == 2);
+        m_exec_conf->getAutotunerCache().setSystem(N, Scalar(N) / volume);
+        }
+
 #ifdef ENABLE_MPI
     if (m_sysdef->isDomainDecomposed())
         {
@@ -115,30 +201,88 @@ void System::run(uint64_t nsteps, bool write_at_start)
         m_integrator->prepRun(m_cur_tstep);
         }
 
+    // independent operations execute on a worker thread, except when they could interleave
+    // profiler regions or MPI calls with the calling thread
+    bool concurrent = !m_profile;
+#ifdef ENABLE_MPI
+    concurrent = concurrent && !m_sysdef->isDomainDecomposed();
+#endif
+    DataDependencies integrator_dependencies;
+    if (m_integrator)
+        integrator_dependencies = m_integrator->getDataDependencies();
+
     // execute analyzers on initial step if requested
     if (write_at_start)
         {
         for (auto& analyzer_trigger_pair : m_analyzers)
             {
             if ((*analyzer_trigger_pair.second)(m_cur_tstep))
+                {
+                int64_t start_time = m_clk.getTime();
                 analyzer_trigger_pair.first->analyze(m_cur_tstep);
+                analyzer_trigger_pair.first->addExecutionTime(m_clk.getTime() - start_time);
+                }
             }
         }
 
     // run the steps
-    for (uint64_t count = 0; count < nsteps; count++)
+    while (m_cur_tstep < m_end_tstep)
         {
         for (auto& tuner : m_tuners)
             {
             if ((*tuner->getTrigger())(m_cur_tstep))
+                {
+                int64_t start_time = m_clk.getTime();
                 tuner->update(m_cur_tstep);
+                tuner->addExecutionTime(m_clk.getTime() - start_time);
+                }
             }
 
-        // execute updaters
+        std::vector<std::shared_ptr<Updater>> updaters;
         for (auto& updater_trigger_pair : m_updaters)
             {
             if ((*updater_trigger_pair.second)(m_cur_tstep))
-                updater_trigger_pair.first->update(m_cur_tstep);
+                updaters.push_back(updater_trigger_pair.first);
+            }
+
+        // updaters that depend on no data of the integrator and the later updaters execute on the
+        // worker during the integrator step, the others execute in order
+        std::vector<bool> updater_is_concurrent(updaters.size(), false);
+        if (concurrent)
+            {
+            DataDependencies later = integrator_dependencies;
+            for (size_t i = updaters.size(); i-- > 0;)
+                {
+                DataDependencies dependencies = updaters[i]->getDataDependencies();
+                if (!dependencies.conflictsWith(later))
+                    {
+                    updater_is_concurrent[i] = true;
+                    }
+                else
+                    {
+                    later.read |= dependencies.read;
+                    later.write |= dependencies.write;
+                    }
+                }
+            }
+
+        // execute updaters
+        ConcurrentOperations concurrent_updaters;
+        for (size_t i = 0; i < updaters.size(); i++)
+            {
+            std::shared_ptr<Updater> updater = updaters[i];
+            uint64_t timestep = m_cur_tstep;
+            auto execute = [this, updater, timestep]()
+            {
+                int64_t start_time = m_clk.getTime();
+                updater->update(timestep);
+                updater->addExecutionTime(m_clk.getTime() - start_time);
+            };
+
+            if (updater_is_concurrent[i])
+                concurrent_updaters.add(execute);
+            else
+                execute();
             }
 
         // look ahead to the next time step and see which analyzers and updaters will be executed
@@ -146,19 +290,107 @@ void System::run(uint64_t nsteps, bool write_at_start)
         // step
         m_sysdef->getParticleData()->setFlags(determineFlags(m_cur_tstep + 1));
 
+        // when no operation executes on the next steps, the integrator takes them in one batch
+        // with the same flags. The operations due on a step next > m_cur_tstep + 1 execute after
+        // the step before next, which takes the single step path below.
+        uint64_t batch = 1;
+        if (m_integrator && m_max_batch_steps > 1)
+            {
+            uint64_t next = nextOperationTimestep(m_cur_tstep + 1);
+            if (next > m_cur_tstep + 1)
+                {
+                batch = std::min(next - m_cur_tstep - 1, m_end_tstep - m_cur_tstep);
+                batch = std::max(std::min(batch, m_max_batch_steps), uint64_t(1));
+                }
+            }
+
         // execute the integrator
+        concurrent_updaters.launch();
         if (m_integrator)
-            m_integrator->update(m_cur_tstep);
+            {
+            int64_t start_time = m_clk.getTime();
+                {
+                // Python operations only run outside of this scope, so the GIL is reacquired
+                // once per step or batch
+                std::unique_ptr<pybind11::gil_scoped_release> release;
+                if (m_release_gil)
+                    release.reset(new pybind11::gil_scoped_release());
+                if (batch > 1)
+                    m_integrator->updateBatch(m_cur_tstep, batch);
+                else
+                    m_integrator->update(m_cur_tstep);
+                }
+            m_integrator->addExecutionTime(m_clk.getTime() - start_time);
+            }
+        concurrent_updaters.join();
 
-        m_cur_tstep++;
+        m_cur_tstep += batch;
 
-        // execute analyzers after incrementing the step counter
+        std::vector<std::shared_ptr<Analyzer>> analyzers;
         for (auto& analyzer_trigger_pair : m_analyzers)
             {
             if ((*analyzer_trigger_pair.second)(m_cur_tstep))
-                analyzer_trigger_pair.first->analyze(m_cur_tstep);
+                analyzers.push_back(analyzer_trigger_pair.first);
+            }
+
+        // analyzers that depend on no data of the integrator and the other analyzers execute on
+        // the worker, concurrently with the others
+        std::vector<bool> analyzer_is_concurrent(analyzers.size(), false);
+        if (concurrent)
+            {
+            for (size_t i = 0; i < analyzers.size(); i++)
+                {
+                DataDependencies dependencies = analyzers[i]->getDataDependencies();
+                bool independent = !dependencies.conflictsWith(integrator_dependencies);
+                for (size_t j = 0; j < analyzers.size() && independent; j++)
+                    {
+                    if (j != i)
+                        {
+                        independent
+                            = !dependencies.conflictsWith(analyzers[j]->getDataDependencies());
+                        }
+                    }
+                analyzer_is_concurrent[i] = independent;
+                }
+            }
+
+        ConcurrentOperations concurrent_analyzers;
+        for (size_t i = 0; i < analyzers.size(); i++)
+            {
+            if (!analyzer_is_concurrent[i])
+                continue;
+
+            std::shared_ptr<Analyzer> analyzer = analyzers[i];
+            uint64_t timestep = m_cur_tstep;
+            concurrent_analyzers.add(
+                [this, analyzer, timestep]()
+                {
+                    int64_t start_time = m_clk.getTime();
+                    analyzer->analyze(timestep);
+                    analyzer->addExecutionTime(m_clk.getTime() - start_time);
+                });
+            }
+        concurrent_analyzers.launch();
+
+        // queue the host copies of all analyzers before the first one synchronizes
+        for (size_t i = 0; i < analyzers.size(); i++)
+            {
+            if (!analyzer_is_concurrent[i])
+                analyzers[i]->prefetch(m_cur_tstep);
             }
 
+        // execute analyzers after incrementing the step counter
+        for (size_t i = 0; i < analyzers.size(); i++)
+            {
+            if (!analyzer_is_concurrent[i])
+                {
+                int64_t start_time = m_clk.getTime();
+                analyzers[i]->analyze(m_cur_tstep);
+                analyzers[i]->addExecutionTime(m_clk.getTime() - start_time);
+                }
+            }
+        concurrent_analyzers.join();
+
         updateTPS();
 
         // propagate Python exceptions related to signals
@@ -168,6 +400,24 @@ void System::run(uint64_t nsteps, bool write_at_start)
             }
         }
 
+    // report the counts of messages that repeat every step once per run
+    m_exec_conf->msg->flushRepeated();
+
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isManagedMemoryCountingEnabled() && nsteps > 0)
+        {
+        std::map<std::string, uint64_t> counts = m_exec_conf->getManagedMemoryCounts();
+        m_exec_conf->msg->notice(2)
+            << "Managed memory page faults per step: "
+            << double(counts["gpu_page_faults"] - managed_memory_counts["gpu_page_faults"])
+                   / double(nsteps)
+            << " (GPU), "
+            << double(counts["cpu_page_faults"] - managed_memory_counts["cpu_page_faults"])
+                   / double(nsteps)
+            << " (CPU)" << std::endl;
+        }
+#endif
+
 #ifdef ENABLE_MPI
     // make sure all ranks return the same TPS after the run completes
     if (m_sysdef->isDomainDecomposed())
@@ -279,6 +529,10 @@ void System::resetStats()
     // computes
     for (auto compute : m_computes)
         compute->resetStats();
+
+    // tuners
+    for (auto& tuner : m_tuners)
+        tuner->resetStats();
     }
 
 /*! \param tstep Time step for which to determine the flags
@@ -313,6 +567,25 @@ PDataFlags System::determineFlags(uint64_t tstep)
     return flags;
     }
 
+/*! \param tstep First time step to consider
+    \returns The earliest time step >= \a tstep on which a tuner, updater, or analyzer may execute
+*/
+uint64_t System::nextOperationTimestep(uint64_t tstep)
+    {
+    uint64_t next = UINT64_MAX;
+
+    for (auto& analyzer_trigger_pair : m_analyzers)
+        next = std::min(next, analyzer_trigger_pair.second->nextTimestep(tstep));
+
+    for (auto& updater_trigger_pair : m_updaters)
+        next = std::min(next, updater_trigger_pair.second->nextTimestep(tstep));
+
+    for (auto& tuner : m_tuners)
+        next = std::min(next, tuner->getTrigger()->nextTimestep(tstep));
+
+    return next;
+    }
+
 namespace detail
     {
 void export_System(pybind11::module& m)
@@ -336,12 +609,19 @@ void export_System(pybind11::module& m)
 
         .def("setAutotunerParams", &System::setAutotunerParams)
         .def("enableProfiler", &System::enableProfiler)
+        .def_property_readonly("profiler", &System::getProfiler)
         .def("run", &System::run)
 
         .def("getLastTPS", &System::getLastTPS)
         .def("getCurrentTimeStep", &System::getCurrentTimeStep)
         .def("setPressureFlag", &System::setPressureFlag)
         .def("getPressureFlag", &System::getPressureFlag)
+        .def("setEnergyFlag", &System::setEnergyFlag)
+        .def("getEnergyFlag", &System::getEnergyFlag)
+        .def("setReleaseGIL", &System::setReleaseGIL)
+        .def("getReleaseGIL", &System::getReleaseGIL)
+        .def("setMaxBatchSteps", &System::setMaxBatchSteps)
+        .def("getMaxBatchSteps", &System::getMaxBatchSteps)
         .def_property_readonly("walltime", &System::getCurrentWalltime)
         .def_property_readonly("final_timestep", &System::getEndStep)
         .def_property_readonly("analyzers", &System::getAnalyzers)
@@ -11,6 +11,7 @@
 #include "Updater.h"
 
 #include <map>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -87,7 +88,10 @@ class PYBIND11_EXPORT System
     /** Run the simulation for a number of time steps.
 
         During the run, Simulation applies all of the Tuners, Updaters, the integrator,
-        and Analyzers who's triggers evaluate true.
+        and Analyzers who's triggers evaluate true. Updaters and analyzers that declare no
+        dependency on the data of the integrator (see Updater::getDataDependencies()) execute on
+        a worker thread, concurrently with the GPU kernels of the step, except in profiled or
+        domain decomposed runs.
 
         @param nsteps Number of steps to advance the simulation
         @param write_at_start Set to true to evaluate writers before the
@@ -98,6 +102,12 @@ class PYBIND11_EXPORT System
     //! Configures profiling of runs
     void enableProfiler(bool enable);
 
+    /// Get the profiler of the most recent run, nullptr when the run was not profiled
+    std::shared_ptr<Profiler> getProfiler()
+        {
+        return m_profiler;
+        }
+
     //! Get the average TPS from the last run
     Scalar getLastTPS() const
         {
@@ -165,6 +175,52 @@ class PYBIND11_EXPORT System
         return m_default_flags[pdata_flag::pressure_tensor];
         }
 
+    /// Set potential energy computation particle data flag
+    void setEnergyFlag(bool flag)
+        {
+        m_default_flags[pdata_flag::potential_energy] = flag;
+        }
+
+    /// Get the potential energy computation particle data flag
+    bool getEnergyFlag()
+        {
+        return m_default_flags[pdata_flag::potential_energy];
+        }
+
+    /// Set whether to release the GIL while the integrator advances the system
+    /*! When enabled, other Python threads may run while the integrator executes. The Python
+        tuners, updaters, and analyzers of each step still execute with the GIL held in a single
+        contiguous block between the integrator steps.
+    */
+    void setReleaseGIL(bool release_gil)
+        {
+        m_release_gil = release_gil;
+        }
+
+    /// Get whether the GIL is released while the integrator advances the system
+    bool getReleaseGIL()
+        {
+        return m_release_gil;
+        }
+
+    /// Set the maximum number of steps the integrator takes without returning to run()
+    /*! When no tuner, updater, or analyzer is due for several steps, run() hands the integrator
+        the whole batch (see Trigger::nextTimestep() and Integrator::updateBatch()). The wall clock
+        time, TPS, and Python signals are updated once per batch. 1 disables batching.
+    */
+    void setMaxBatchSteps(uint64_t max_batch_steps)
+        {
+        if (max_batch_steps == 0)
+            throw std::invalid_argument("max_batch_steps must be at least 1");
+        m_max_batch_steps = max_batch_steps;
+        }
+
+    /// Get the maximum number of steps the integrator takes without returning to run()
+    uint64_t getMaxBatchSteps()
+        {
+        return m_max_batch_steps;
+        }
+
     private:
     std::vector<std::pair<std::shared_ptr<Analyzer>,
                           std::shared_ptr<Trigger>>>
@@ -195,6 +251,10 @@ class PYBIND11_EXPORT System
 
     bool m_profile; //!< True if runs should be profiled
 
+    bool m_release_gil; //!< True if the GIL is released during the integrator step
+
+    uint64_t m_max_batch_steps; //!< Largest number of steps to run in one integrator call
+
     /// Particle data flags to always set
     PDataFlags m_default_flags;
 
@@ -208,6 +268,9 @@ class PYBIND11_EXPORT System
     //! Get the flags needed for a particular step
     PDataFlags determineFlags(uint64_t tstep);
 
+    //! Find the first time step on which any tuner, updater, or analyzer may execute
+    uint64_t nextOperationTimestep(uint64_t tstep);
+
     /// Record the initial time of the last run
     int64_t m_initial_time = 0;
 
@@ -0,0 +1,90 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file SystemCheckpoint.cc
+    \brief Defines the SystemCheckpoint class
+*/
+
+#include "SystemCheckpoint.h"
+
+#ifdef ENABLE_MPI
+#include "Communicator.h"
+#endif
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+/*! \param sysdef System to save and restore
+ */
+SystemCheckpoint::SystemCheckpoint(std::shared_ptr<SystemDefinition> sysdef)
+    : m_sysdef(sysdef), m_saved(false)
+    {
+    }
+
+/*! Saving again reuses the memory of the previous save.
+ */
+void SystemCheckpoint::save()
+    {
+    if (m_sysdef->isDomainDecomposed()
+        && (m_sysdef->getBondData()->getNGlobal() > 0 || m_sysdef->getAngleData()->getNGlobal() > 0
+            || m_sysdef->getDihedralData()->getNGlobal() > 0
+            || m_sysdef->getImproperData()->getNGlobal() > 0
+            || m_sysdef->getConstraintData()->getNGlobal() > 0
+            || m_sysdef->getPairData()->getNGlobal() > 0))
+        {
+        throw runtime_error("Checkpoints of domain decomposed systems with bonded groups are not "
+                            "supported.");
+        }
+
+    m_sysdef->getParticleData()->saveCheckpoint(m_pdata_checkpoint);
+
+    std::shared_ptr<IntegratorData> integrator_data = m_sysdef->getIntegratorData();
+    m_integrator_variables.resize(integrator_data->getNumIntegrators());
+    for (unsigned int i = 0; i < m_integrator_variables.size(); i++)
+        m_integrator_variables[i] = integrator_data->getIntegratorVariables(i);
+
+    m_saved = true;
+    }
+
+/*! The state may be restored any number of times.
+ */
+void SystemCheckpoint::restore()
+    {
+    if (!m_saved)
+        throw runtime_error("Cannot restore a checkpoint that has not been saved.");
+
+    std::shared_ptr<IntegratorData> integrator_data = m_sysdef->getIntegratorData();
+    if (integrator_data->getNumIntegrators() != m_integrator_variables.size())
+        {
+        throw runtime_error("Cannot restore a checkpoint after the integration methods changed.");
+        }
+
+    m_sysdef->getParticleData()->restoreCheckpoint(m_pdata_checkpoint);
+
+    for (unsigned int i = 0; i < m_integrator_variables.size(); i++)
+        integrator_data->setIntegratorVariables(i, m_integrator_variables[i]);
+
+#ifdef ENABLE_MPI
+    // exchange the ghost particles on the next step
+    std::shared_ptr<Communicator> comm = m_sysdef->getCommunicator().lock();
+    if (comm)
+        comm->forceMigrate();
+#endif
+    }
+
+namespace detail
+    {
+void export_SystemCheckpoint(pybind11::module& m)
+    {
+    pybind11::class_<SystemCheckpoint, std::shared_ptr<SystemCheckpoint>>(m, "SystemCheckpoint")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>>())
+        .def("save", &SystemCheckpoint::save)
+        .def("restore", &SystemCheckpoint::restore);
+    }
+
+    } // end namespace detail
+
+    } // end namespace hoomd
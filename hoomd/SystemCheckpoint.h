@@ -0,0 +1,63 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file SystemCheckpoint.h
+    \brief Declares the SystemCheckpoint class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "IntegratorData.h"
+#include "ParticleData.h"
+#include "SystemDefinition.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+#include <vector>
+
+#ifndef __SYSTEM_CHECKPOINT_H__
+#define __SYSTEM_CHECKPOINT_H__
+
+namespace hoomd
+    {
+//! Rank-local copy of the system state for fast rollback
+/*! SystemCheckpoint saves the local particles of each rank and the integrator variables so that
+    the simulation can return to the saved configuration many times, as in forward flux or
+    transition path sampling. Unlike snapshots, a checkpoint is neither gathered nor scattered: each
+    rank keeps its own particles in the memory space of the particle data, and restore() copies
+    them back in place. The ghost particles are exchanged again on the next step.
+
+    The global number of particles must not change between save() and restore(). Bonded groups are
+    not saved, so a checkpoint of a domain decomposed system with bonded groups is not supported.
+*/
+class PYBIND11_EXPORT SystemCheckpoint
+    {
+    public:
+    //! Constructor
+    SystemCheckpoint(std::shared_ptr<SystemDefinition> sysdef);
+
+    //! Save the current state
+    void save();
+
+    //! Restore the saved state
+    void restore();
+
+    private:
+    std::shared_ptr<SystemDefinition> m_sysdef;              //!< System to save and restore
+    ParticleDataCheckpoint m_pdata_checkpoint;               //!< Saved particles
+    std::vector<IntegratorVariables> m_integrator_variables; //!< Saved integrator variables
+    bool m_saved;                                            //!< True after the first save()
+    };
+
+namespace detail
+    {
+//! Exports SystemCheckpoint to python
+void export_SystemCheckpoint(pybind11::module& m);
+
+    } // end namespace detail
+
+    } // end namespace hoomd
+
+#endif
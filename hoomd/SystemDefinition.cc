@@ -9,12 +9,17 @@
 
 #include "SystemDefinition.h"
 
+#include "GSDReader.h"
+#include "Initializers.h"
 #include "SnapshotSystemData.h"
+#include "SpatialIndex.h"
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
 #endif
 
+#include <pybind11/stl.h>
+
 using namespace std;
 
 namespace hoomd
@@ -23,6 +28,15 @@ namespace hoomd
  */
 SystemDefinition::SystemDefinition() { }
 
+/*! The index is created on first use, so systems without consumers never allocate the trees.
+ */
+std::shared_ptr<SpatialIndex> SystemDefinition::getSpatialIndex()
+    {
+    if (!m_spatial_index)
+        m_spatial_index = std::make_shared<SpatialIndex>(m_particle_data);
+    return m_spatial_index;
+    }
+
 /*! \param N Number of particles to allocate
     \param box Initial box particles are in
     \param n_types Number of particle types to set
@@ -78,6 +92,88 @@ SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<Real>> sna
     m_particle_data = std::shared_ptr<ParticleData>(
         new ParticleData(snapshot->particle_data, snapshot->global_box, exec_conf, decomposition));
 
+    initializeBondedData(snapshot, exec_conf);
+    }
+
+/*! \param snapshot Snapshot with the box, types, and bonded groups, but no particles
+    \param reader GSD file reader created with a nonzero stream window
+    \param exec_conf Execution configuration to run on
+    \param decomposition (optional) The domain decomposition layout
+
+    The particles are read from \a reader one window at a time and sent directly to the ranks that
+   own them, so the root rank never holds all particles in memory.
+*/
+SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<float>> snapshot,
+                                   std::shared_ptr<GSDReader> reader,
+                                   std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                   std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    setNDimensions(snapshot->dimensions);
+
+    // construct with the box and decomposition, then stream in the particles
+    m_particle_data = std::shared_ptr<ParticleData>(
+        new ParticleData(snapshot->particle_data, snapshot->global_box, exec_conf, decomposition));
+    m_particle_data->initializeFromWindows(
+        reader->getNParticles(),
+        snapshot->particle_data.type_mapping,
+        reader->getStreamWindow(),
+        [reader](unsigned int first, SnapshotParticleData<float>& window)
+        { reader->readParticleWindow(first, window); });
+
+    initializeBondedData(snapshot, exec_conf);
+    }
+
+/*! \param snapshot Snapshot with the box, particle types, and bonded topology, but no particles
+    \param initializer Generates the particles of the local domain
+    \param exec_conf The ExecutionConfiguration HOOMD is to be run on
+    \param decomposition (optional) The domain decomposition layout
+
+    No rank ever holds all of the particles, see DistributedInitializer.
+*/
+SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<double>> snapshot,
+                                   std::shared_ptr<DistributedInitializer> initializer,
+                                   std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                   std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    setNDimensions(snapshot->dimensions);
+
+#ifdef ENABLE_MPI
+    // the initializer needs the dimensionality on every rank
+    if (decomposition)
+        bcast(m_n_dimensions, 0, exec_conf->getMPICommunicator());
+#endif
+
+    // construct with the box and decomposition, then generate the particles on each rank
+    m_particle_data = std::shared_ptr<ParticleData>(
+        new ParticleData(snapshot->particle_data, snapshot->global_box, exec_conf, decomposition));
+    std::shared_ptr<ParticleData> pdata = m_particle_data;
+    unsigned int n_dimensions = m_n_dimensions;
+    m_particle_data->initializeFromLocal(
+        initializer->getNGlobal(),
+        snapshot->particle_data.type_mapping,
+        [initializer, pdata, exec_conf, n_dimensions](SnapshotParticleData<Scalar>& local,
+                                                      std::vector<unsigned int>& tag)
+        {
+            initializer->generate(pdata->getGlobalBox(),
+                                  pdata->getDomainDecomposition(),
+                                  exec_conf,
+                                  n_dimensions,
+                                  local,
+                                  tag);
+        });
+
+    initializeBondedData(snapshot, exec_conf);
+    }
+
+/*! \param snapshot Snapshot to use
+    \param exec_conf Execution configuration to run on
+
+    \pre m_particle_data is initialized
+*/
+template<class Real>
+void SystemDefinition::initializeBondedData(std::shared_ptr<SnapshotSystemData<Real>> snapshot,
+                                            std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
 #ifdef ENABLE_MPI
     // in MPI simulations, broadcast dimensionality from rank zero
     if (m_particle_data->getDomainDecomposition())
@@ -168,6 +264,75 @@ void SystemDefinition::initializeFromSnapshot(std::shared_ptr<SnapshotSystemData
     m_pair_data->initializeFromSnapshot(snapshot->pair_data);
     }
 
+/*! \param snapshot Snapshot of one copy of the system, only read on the root rank
+    \param nx Number of copies along the first box vector
+    \param ny Number of copies along the second box vector
+    \param nz Number of copies along the third box vector
+
+    The result is the same as initializeFromSnapshot() with a snapshot replicated by
+    SnapshotSystemData::replicate(), but the snapshot of one copy is broadcast to all ranks once
+    and each rank constructs only the copies of the particles in its own domain.
+*/
+void SystemDefinition::replicate(std::shared_ptr<SnapshotSystemData<double>> snapshot,
+                                 unsigned int nx,
+                                 unsigned int ny,
+                                 unsigned int nz)
+    {
+    std::shared_ptr<const ExecutionConfiguration> exec_conf = m_particle_data->getExecConf();
+
+    m_n_dimensions = snapshot->dimensions;
+    BoxDim unit_box = snapshot->global_box;
+
+#ifdef ENABLE_MPI
+    // in MPI simulations, broadcast the unit cell from rank zero
+    if (m_particle_data->getDomainDecomposition())
+        {
+        bcast(m_n_dimensions, 0, exec_conf->getMPICommunicator());
+        bcast(unit_box, 0, exec_conf->getMPICommunicator());
+        snapshot->particle_data.bcast(0, exec_conf->getMPICommunicator());
+        }
+#endif
+
+    if (m_n_dimensions == 2 && nz != 1)
+        {
+        throw std::runtime_error("Cannot replicate a 2D system along the third box vector.");
+        }
+
+    BoxDim global_box = unit_box;
+    Scalar3 L = unit_box.getL();
+    global_box.setL(make_scalar3(L.x * Scalar(nx), L.y * Scalar(ny), L.z * Scalar(nz)));
+    m_particle_data->setGlobalBox(global_box);
+
+    // the initializer shares the particles of the unit cell with the snapshot
+    std::shared_ptr<const SnapshotParticleData<double>> unit(snapshot, &snapshot->particle_data);
+    std::shared_ptr<ReplicateInitializer> initializer(
+        new ReplicateInitializer(unit, unit_box, make_uint3(nx, ny, nz)));
+    std::shared_ptr<ParticleData> pdata = m_particle_data;
+    unsigned int n_dimensions = m_n_dimensions;
+    m_particle_data->initializeFromLocal(
+        initializer->getNGlobal(),
+        snapshot->particle_data.type_mapping,
+        [initializer, pdata, n_dimensions](SnapshotParticleData<Scalar>& local,
+                                           std::vector<unsigned int>& tag)
+        {
+            initializer->generate(pdata->getGlobalBox(),
+                                  pdata->getDomainDecomposition(),
+                                  pdata->getExecConf(),
+                                  n_dimensions,
+                                  local,
+                                  tag);
+        });
+
+    unsigned int n = nx * ny * nz;
+    unsigned int n_unit = unit->size;
+    m_bond_data->initializeReplicated(snapshot->bond_data, n, n_unit);
+    m_angle_data->initializeReplicated(snapshot->angle_data, n, n_unit);
+    m_dihedral_data->initializeReplicated(snapshot->dihedral_data, n, n_unit);
+    m_improper_data->initializeReplicated(snapshot->improper_data, n, n_unit);
+    m_constraint_data->initializeReplicated(snapshot->constraint_data, n, n_unit);
+    m_pair_data->initializeReplicated(snapshot->pair_data, n, n_unit);
+    }
+
 // instantiate both float and double methods
 template SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<float>> snapshot,
                                             std::shared_ptr<ExecutionConfiguration> exec_conf,
@@ -216,8 +381,23 @@ void export_SystemDefinition(pybind11::module& m)
                             std::shared_ptr<DomainDecomposition>>())
         .def(pybind11::init<std::shared_ptr<SnapshotSystemData<double>>,
                             std::shared_ptr<ExecutionConfiguration>>())
+        .def(pybind11::init<std::shared_ptr<SnapshotSystemData<float>>,
+                            std::shared_ptr<GSDReader>,
+                            std::shared_ptr<ExecutionConfiguration>,
+                            std::shared_ptr<DomainDecomposition>>())
+        .def(pybind11::init<std::shared_ptr<SnapshotSystemData<float>>,
+                            std::shared_ptr<GSDReader>,
+                            std::shared_ptr<ExecutionConfiguration>>())
+        .def(pybind11::init<std::shared_ptr<SnapshotSystemData<double>>,
+                            std::shared_ptr<DistributedInitializer>,
+                            std::shared_ptr<ExecutionConfiguration>,
+                            std::shared_ptr<DomainDecomposition>>())
+        .def(pybind11::init<std::shared_ptr<SnapshotSystemData<double>>,
+                            std::shared_ptr<DistributedInitializer>,
+                            std::shared_ptr<ExecutionConfiguration>>())
         .def("setNDimensions", &SystemDefinition::setNDimensions)
         .def("getNDimensions", &SystemDefinition::getNDimensions)
+        .def("replicate", &SystemDefinition::replicate)
         .def("getParticleData", &SystemDefinition::getParticleData)
         .def("getBondData", &SystemDefinition::getBondData)
         .def("getAngleData", &SystemDefinition::getAngleData)
@@ -232,6 +412,7 @@ void export_SystemDefinition(pybind11::module& m)
         .def("initializeFromSnapshot", &SystemDefinition::initializeFromSnapshot<double>)
         .def("getSeed", &SystemDefinition::getSeed)
         .def("setSeed", &SystemDefinition::setSeed)
+        .def("getSizeHint", &SystemDefinition::getSizeHint)
 #ifdef ENABLE_MPI
         .def("setCommunicator", &SystemDefinition::setCommunicator)
 #endif
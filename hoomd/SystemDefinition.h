@@ -15,8 +15,12 @@
 #include "IntegratorData.h"
 #include "ParticleData.h"
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <pybind11/pybind11.h>
+#include <string>
+#include <vector>
 
 #ifndef __SYSTEM_DEFINITION_H__
 #define __SYSTEM_DEFINITION_H__
@@ -31,6 +35,15 @@ class Communicator;
 //! Forward declaration of SnapshotSystemData
 template<class Real> struct SnapshotSystemData;
 
+//! Forward declaration of GSDReader
+class GSDReader;
+
+//! Forward declaration of DistributedInitializer
+class DistributedInitializer;
+
+//! Forward declaration of SpatialIndex
+class SpatialIndex;
+
 //! Container class for all data needed to define the MD system
 /*! SystemDefinition is a big bucket where all of the data defining the MD system goes.
     Everything is stored as a shared pointer for quick and easy access from within C++
@@ -96,6 +109,20 @@ class PYBIND11_EXPORT SystemDefinition
                      std::shared_ptr<DomainDecomposition> decomposition
                      = std::shared_ptr<DomainDecomposition>());
 
+    //! Construct from a snapshot whose particles are streamed from a GSD file
+    SystemDefinition(std::shared_ptr<SnapshotSystemData<float>> snapshot,
+                     std::shared_ptr<GSDReader> reader,
+                     std::shared_ptr<ExecutionConfiguration> exec_conf,
+                     std::shared_ptr<DomainDecomposition> decomposition
+                     = std::shared_ptr<DomainDecomposition>());
+
+    //! Construct from a snapshot whose particles are generated on each rank
+    SystemDefinition(std::shared_ptr<SnapshotSystemData<double>> snapshot,
+                     std::shared_ptr<DistributedInitializer> initializer,
+                     std::shared_ptr<ExecutionConfiguration> exec_conf,
+                     std::shared_ptr<DomainDecomposition> decomposition
+                     = std::shared_ptr<DomainDecomposition>());
+
     //! Set the dimensionality of the system
     void setNDimensions(unsigned int);
 
@@ -194,6 +221,46 @@ class PYBIND11_EXPORT SystemDefinition
         return m_pair_data;
         }
 
+    //! Get the point AABB trees of the particles, shared by all classes on this rank
+    std::shared_ptr<SpatialIndex> getSpatialIndex();
+
+    //! Get the sizes that a data structure reserved, or an empty vector
+    /*! \param name Name of the data structure
+
+        Data structures that grow on overflow (such as the neighbor list) record their sizes with
+        raiseSizeHint(). The hints are stored in restart files so that a continued simulation can
+        allocate enough memory on the first step.
+    */
+    std::vector<unsigned int> getSizeHint(const std::string& name) const
+        {
+        auto it = m_size_hints.find(name);
+        if (it == m_size_hints.end())
+            return std::vector<unsigned int>();
+        return it->second;
+        }
+
+    //! Raise the sizes recorded for a data structure to at least the given values
+    void raiseSizeHint(const std::string& name, const std::vector<unsigned int>& sizes)
+        {
+        std::vector<unsigned int>& hint = m_size_hints[name];
+        if (hint.size() < sizes.size())
+            hint.resize(sizes.size(), 0);
+        for (size_t i = 0; i < sizes.size(); i++)
+            hint[i] = std::max(hint[i], sizes[i]);
+        }
+
+    //! Get the sizes recorded for all data structures
+    const std::map<std::string, std::vector<unsigned int>>& getSizeHints() const
+        {
+        return m_size_hints;
+        }
+
+    //! Replace the sizes recorded for all data structures
+    void setSizeHints(const std::map<std::string, std::vector<unsigned int>>& hints)
+        {
+        m_size_hints = hints;
+        }
+
     //! Return a snapshot of the current system data
     template<class Real> std::shared_ptr<SnapshotSystemData<Real>> takeSnapshot();
 
@@ -201,6 +268,12 @@ class PYBIND11_EXPORT SystemDefinition
     template<class Real>
     void initializeFromSnapshot(std::shared_ptr<SnapshotSystemData<Real>> snapshot);
 
+    //! Re-initialize the system with copies of a snapshot
+    void replicate(std::shared_ptr<SnapshotSystemData<double>> snapshot,
+                   unsigned int nx,
+                   unsigned int ny,
+                   unsigned int nz);
+
     private:
     unsigned int m_n_dimensions;                       //!< Dimensionality of the system
     uint16_t m_seed = 0;                               //!< Random number seed
@@ -212,6 +285,15 @@ class PYBIND11_EXPORT SystemDefinition
     std::shared_ptr<ConstraintData> m_constraint_data; //!< Improper data for the system
     std::shared_ptr<IntegratorData> m_integrator_data; //!< Integrator data for the system
     std::shared_ptr<PairData> m_pair_data;             //!< Special pairs data for the system
+    std::shared_ptr<SpatialIndex> m_spatial_index;     //!< Trees of the particles (created on use)
+
+    //! Sizes reserved by data structures, by name
+    std::map<std::string, std::vector<unsigned int>> m_size_hints;
+
+    //! Initialize the bonded group and integrator data after the particle data
+    template<class Real>
+    void initializeBondedData(std::shared_ptr<SnapshotSystemData<Real>> snapshot,
+                              std::shared_ptr<ExecutionConfiguration> exec_conf);
 
 #ifdef ENABLE_MPI
     /// The system communicator
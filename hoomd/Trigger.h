@@ -50,6 +50,21 @@ class PYBIND11_EXPORT Trigger
 
     virtual bool compute(uint64_t timestep) = 0;
 
+    /** Find the first time step on which the trigger may be active
+     *
+     *  @param timestep First time step to consider
+     *  @returns The earliest time step >= `timestep` on which the trigger may be active, or
+     *           `UINT64_MAX` if it is never active again
+     *
+     *  The trigger is guaranteed to be inactive on the time steps before the returned one.
+     *  System uses this to run batches of time steps on which no operation executes. The default
+     *  returns `timestep`, which is always correct but prevents batching.
+     */
+    virtual uint64_t nextTimestep(uint64_t timestep)
+        {
+        return timestep;
+        }
+
     private:
     /// Caches the last time step at which the trigger was computed
     uint64_t m_last_timestep;
@@ -83,6 +98,16 @@ class PYBIND11_EXPORT PeriodicTrigger : public Trigger
         return (timestep - m_phase) % m_period == 0;
         }
 
+    uint64_t nextTimestep(uint64_t timestep)
+        {
+        // compute() uses unsigned arithmetic, so steps before the phase are also periodic
+        uint64_t remainder = (timestep - m_phase) % m_period;
+        if (remainder == 0)
+            return timestep;
+        uint64_t next = timestep + (m_period - remainder);
+        return next < timestep ? UINT64_MAX : next;
+        }
+
     /// Set the period
     void setPeriod(uint64_t period)
         {
@@ -128,6 +153,11 @@ class PYBIND11_EXPORT BeforeTrigger : public Trigger
         return timestep < m_timestep;
         }
 
+    uint64_t nextTimestep(uint64_t timestep)
+        {
+        return timestep < m_timestep ? timestep : UINT64_MAX;
+        }
+
     /// Get the timestep before which the trigger is active.
     uint64_t getTimestep() const
         {
@@ -160,6 +190,11 @@ class PYBIND11_EXPORT OnTrigger : public Trigger
         return timestep == m_timestep;
         }
 
+    uint64_t nextTimestep(uint64_t timestep)
+        {
+        return timestep <= m_timestep ? m_timestep : UINT64_MAX;
+        }
+
     /// Get the timestep when the trigger is active.
     uint64_t getTimestep() const
         {
@@ -192,6 +227,11 @@ class PYBIND11_EXPORT AfterTrigger : public Trigger
         return timestep > m_timestep;
         }
 
+    uint64_t nextTimestep(uint64_t timestep)
+        {
+        return timestep > m_timestep ? timestep : m_timestep + 1;
+        }
+
     /// Get the timestep after which the trigger is active.
     uint64_t getTimestep() const
         {
@@ -266,6 +306,15 @@ class PYBIND11_EXPORT AndTrigger : public Trigger
                            { return t->operator()(timestep); });
         }
 
+    /// All triggers must be active, so none is active before the latest of their next steps
+    uint64_t nextTimestep(uint64_t timestep)
+        {
+        uint64_t next = timestep;
+        for (auto& t : m_triggers)
+            next = std::max(next, t->nextTimestep(timestep));
+        return next;
+        }
+
     const std::vector<std::shared_ptr<Trigger>>& getTriggers() const
         {
         return m_triggers;
@@ -302,6 +351,15 @@ class PYBIND11_EXPORT OrTrigger : public Trigger
                            { return t->operator()(timestep); });
         }
 
+    /// Any trigger may be active, so the earliest of their next steps
+    uint64_t nextTimestep(uint64_t timestep)
+        {
+        uint64_t next = UINT64_MAX;
+        for (auto& t : m_triggers)
+            next = std::min(next, t->nextTimestep(timestep));
+        return next;
+        }
+
     const std::vector<std::shared_ptr<Trigger>>& getTriggers() const
         {
         return m_triggers;
@@ -43,7 +43,8 @@ void export_Updater(pybind11::module& m)
         .def(pybind11::init<std::shared_ptr<SystemDefinition>>())
         .def("update", &Updater::update)
         .def("setProfiler", &Updater::setProfiler)
-        .def("notifyDetach", &Updater::notifyDetach);
+        .def("notifyDetach", &Updater::notifyDetach)
+        .def_property_readonly("execution_time", &Updater::getExecutionTime);
     }
 
     } // end namespace detail
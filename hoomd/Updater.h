@@ -4,6 +4,7 @@
 // Maintainer: joaander
 
 #include "Communicator.h"
+#include "DataDependencies.h"
 #include "HOOMDMath.h"
 #include "Profiler.h"
 #include "SharedSignal.h"
@@ -96,6 +97,16 @@ class PYBIND11_EXPORT Updater
         return PDataFlags(0);
         }
 
+    //! Get the data that update() reads and writes
+    /*! System executes updaters that depend on none of the data the integrator accesses
+        concurrently with the integrator. Derived classes should override this when they access
+        only a subset of the simulation data.
+    */
+    virtual DataDependencies getDataDependencies()
+        {
+        return DataDependencies();
+        }
+
     std::shared_ptr<const ExecutionConfiguration> getExecConf()
         {
         return m_exec_conf;
@@ -126,6 +137,18 @@ class PYBIND11_EXPORT Updater
     /// Python will notify C++ objects when they are detached from Simulation
     virtual void notifyDetach() {};
 
+    /// Get the total wall clock time spent executing this updater [s]
+    double getExecutionTime() const
+        {
+        return double(m_execution_time) / 1e9;
+        }
+
+    /// Add to the total execution time (System calls this after each update()) [ns]
+    void addExecutionTime(int64_t t)
+        {
+        m_execution_time += t;
+        }
+
     protected:
     const std::shared_ptr<SystemDefinition>
         m_sysdef; //!< The system definition this compute is associated with
@@ -136,6 +159,9 @@ class PYBIND11_EXPORT Updater
         m_exec_conf; //!< Stored shared ptr to the execution configuration
     std::vector<std::shared_ptr<hoomd::detail::SignalSlot>>
         m_slots; //!< Stored shared ptr to the system signals
+
+    /// Total wall clock time spent in update() [ns]
+    int64_t m_execution_time = 0;
     };
 
 namespace detail
@@ -36,7 +36,7 @@ class UpdaterRemoveDrift : public Updater
         }
 
     //! Set reference positions from a (N_particles, 3) numpy array
-    void setReferencePositions(const pybind11::array_t<double> ref_pos)
+    virtual void setReferencePositions(const pybind11::array_t<double> ref_pos)
         {
         if (ref_pos.ndim() != 2)
             {
@@ -0,0 +1,199 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file UpdaterRemoveDriftGPU.cu
+    \brief Defines the GPU functions used by UpdaterRemoveDriftGPU
+*/
+
+#include "UpdaterRemoveDriftGPU.cuh"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include <hipcub/hipcub.hpp>
+#pragma GCC diagnostic pop
+
+namespace hoomd
+    {
+namespace kernel
+    {
+//! Compute the minimum image displacement of each particle from its reference position
+/*! \param N Number of local particles
+    \param d_pos Particle positions
+    \param d_tag Particle tags
+    \param d_ref_pos Reference positions indexed by tag
+    \param box Global box
+    \param origin Origin of the global box
+    \param d_dr Displacement of each particle (output)
+
+    One thread per particle.
+*/
+__global__ void gpu_remove_drift_displacement_kernel(const unsigned int N,
+                                                     const Scalar4* d_pos,
+                                                     const unsigned int* d_tag,
+                                                     const Scalar3* d_ref_pos,
+                                                     const BoxDim box,
+                                                     const Scalar3 origin,
+                                                     Scalar3* d_dr)
+    {
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    const Scalar4 postype = d_pos[idx];
+    Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z) - origin;
+    int3 image = make_int3(0, 0, 0);
+    box.wrap(pos, image);
+    d_dr[idx] = box.minImage(pos - d_ref_pos[d_tag[idx]]);
+    }
+
+//! Subtract the drift from each particle and wrap it into the box
+/*! \param N Number of local particles
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param box Global box
+    \param drift Mean displacement of all particles
+
+    One thread per particle.
+*/
+__global__ void gpu_remove_drift_subtract_kernel(const unsigned int N,
+                                                 Scalar4* d_pos,
+                                                 int3* d_image,
+                                                 const BoxDim box,
+                                                 const Scalar3 drift)
+    {
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    Scalar4 postype = d_pos[idx];
+    postype.x -= drift.x;
+    postype.y -= drift.y;
+    postype.z -= drift.z;
+    int3 image = d_image[idx];
+    box.wrap(postype, image);
+    d_pos[idx] = postype;
+    d_image[idx] = image;
+    }
+
+//! Binary operator that sums Scalar3 values
+struct Scalar3Sum
+    {
+    __device__ Scalar3 operator()(const Scalar3& a, const Scalar3& b) const
+        {
+        return a + b;
+        }
+    };
+
+/*! \param N Number of local particles
+    \param d_pos Particle positions
+    \param d_tag Particle tags
+    \param d_ref_pos Reference positions indexed by tag
+    \param box Global box
+    \param origin Origin of the global box
+    \param d_sum Sum of the displacements (output, one element)
+    \param alloc Caching allocator for temporary storage
+    \param block_size Kernel launch block size
+*/
+hipError_t gpu_remove_drift_sum(const unsigned int N,
+                                const Scalar4* d_pos,
+                                const unsigned int* d_tag,
+                                const Scalar3* d_ref_pos,
+                                const BoxDim& box,
+                                const Scalar3 origin,
+                                Scalar3* d_sum,
+                                CachedAllocator& alloc,
+                                const unsigned int block_size)
+    {
+    if (N == 0)
+        {
+        hipMemset(d_sum, 0, sizeof(Scalar3));
+        return hipSuccess;
+        }
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_remove_drift_displacement_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    unsigned int n_blocks = N / run_block_size + 1;
+
+    Scalar3* d_dr = alloc.getTemporaryBuffer<Scalar3>(N);
+    hipLaunchKernelGGL(gpu_remove_drift_displacement_kernel,
+                       dim3(n_blocks),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       N,
+                       d_pos,
+                       d_tag,
+                       d_ref_pos,
+                       box,
+                       origin,
+                       d_dr);
+
+    void* d_temp_storage = NULL;
+    size_t temp_storage_bytes = 0;
+    const Scalar3 zero = make_scalar3(0, 0, 0);
+    hipcub::DeviceReduce::Reduce(d_temp_storage,
+                                 temp_storage_bytes,
+                                 d_dr,
+                                 d_sum,
+                                 N,
+                                 Scalar3Sum(),
+                                 zero);
+    d_temp_storage = alloc.allocate(temp_storage_bytes);
+    hipcub::DeviceReduce::Reduce(d_temp_storage,
+                                 temp_storage_bytes,
+                                 d_dr,
+                                 d_sum,
+                                 N,
+                                 Scalar3Sum(),
+                                 zero);
+    alloc.deallocate((char*)d_temp_storage);
+    alloc.deallocate((char*)d_dr);
+
+    return hipSuccess;
+    }
+
+/*! \param N Number of local particles
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param box Global box
+    \param drift Mean displacement of all particles
+    \param block_size Kernel launch block size
+*/
+hipError_t gpu_remove_drift_subtract(const unsigned int N,
+                                     Scalar4* d_pos,
+                                     int3* d_image,
+                                     const BoxDim& box,
+                                     const Scalar3 drift,
+                                     const unsigned int block_size)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_remove_drift_subtract_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    unsigned int n_blocks = N / run_block_size + 1;
+
+    hipLaunchKernelGGL(gpu_remove_drift_subtract_kernel,
+                       dim3(n_blocks),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       N,
+                       d_pos,
+                       d_image,
+                       box,
+                       drift);
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace hoomd
@@ -0,0 +1,40 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file UpdaterRemoveDriftGPU.cuh
+    \brief Declares the GPU functions used by UpdaterRemoveDriftGPU
+*/
+
+#pragma once
+
+#include "BoxDim.h"
+#include "CachedAllocator.h"
+#include "HOOMDMath.h"
+
+#include <hip/hip_runtime.h>
+
+namespace hoomd
+    {
+namespace kernel
+    {
+//! Sum the displacements of the local particles from their reference positions
+hipError_t gpu_remove_drift_sum(const unsigned int N,
+                                const Scalar4* d_pos,
+                                const unsigned int* d_tag,
+                                const Scalar3* d_ref_pos,
+                                const BoxDim& box,
+                                const Scalar3 origin,
+                                Scalar3* d_sum,
+                                CachedAllocator& alloc,
+                                const unsigned int block_size);
+
+//! Subtract the drift from the local particles and wrap them into the box
+hipError_t gpu_remove_drift_subtract(const unsigned int N,
+                                     Scalar4* d_pos,
+                                     int3* d_image,
+                                     const BoxDim& box,
+                                     const Scalar3 drift,
+                                     const unsigned int block_size);
+
+    } // end namespace kernel
+    } // end namespace hoomd
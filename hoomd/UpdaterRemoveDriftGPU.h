@@ -0,0 +1,195 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file UpdaterRemoveDriftGPU.h
+    \brief Declares an updater that removes the average drift from the particles on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifdef ENABLE_HIP
+
+#ifndef _REMOVE_DRIFT_UPDATER_GPU_H_
+#define _REMOVE_DRIFT_UPDATER_GPU_H_
+
+#include "hoomd/Autotuner.h"
+#include "hoomd/GlobalArray.h"
+#include "hoomd/UpdaterRemoveDrift.h"
+#include "hoomd/UpdaterRemoveDriftGPU.cuh"
+
+namespace hoomd
+    {
+/** GPU implementation of UpdaterRemoveDrift.
+ *
+ * The displacements are summed on the device and only the total drift is copied to the host for
+ * the MPI reduction, so the positions and images stay on the device.
+ */
+class UpdaterRemoveDriftGPU : public UpdaterRemoveDrift
+    {
+    public:
+    //! Constructor
+    UpdaterRemoveDriftGPU(std::shared_ptr<SystemDefinition> sysdef,
+                          pybind11::array_t<double> ref_positions)
+        : UpdaterRemoveDrift(sysdef, ref_positions), m_sum(1, m_exec_conf)
+        {
+        if (!m_exec_conf->isCUDAEnabled())
+            {
+            throw std::runtime_error("Cannot initialize UpdaterRemoveDriftGPU on a CPU device.");
+            }
+
+        copyReferencePositions();
+
+        unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+        m_tuner_sum.reset(new Autotuner(warp_size,
+                                        1024,
+                                        warp_size,
+                                        5,
+                                        100000,
+                                        "remove_drift_sum",
+                                        this->m_exec_conf));
+        m_tuner_subtract.reset(new Autotuner(warp_size,
+                                             1024,
+                                             warp_size,
+                                             5,
+                                             100000,
+                                             "remove_drift_subtract",
+                                             this->m_exec_conf));
+        }
+
+    //! Set reference positions from a (N_particles, 3) numpy array
+    virtual void setReferencePositions(const pybind11::array_t<double> ref_pos)
+        {
+        UpdaterRemoveDrift::setReferencePositions(ref_pos);
+        copyReferencePositions();
+        }
+
+    //! Set autotuner parameters
+    /*! \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        UpdaterRemoveDrift::setAutotunerParams(enable, period);
+        m_tuner_sum->setPeriod(period);
+        m_tuner_sum->setEnabled(enable);
+        m_tuner_subtract->setPeriod(period);
+        m_tuner_subtract->setEnabled(enable);
+        }
+
+    //! Take one timestep forward
+    virtual void update(uint64_t timestep)
+        {
+        const BoxDim& box = this->m_pdata->getGlobalBox();
+
+            {
+            ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(),
+                                           access_location::device,
+                                           access_mode::read);
+            ArrayHandle<unsigned int> d_tag(this->m_pdata->getTags(),
+                                            access_location::device,
+                                            access_mode::read);
+            ArrayHandle<Scalar3> d_ref_positions(m_ref_positions_gpu,
+                                                 access_location::device,
+                                                 access_mode::read);
+            ArrayHandle<Scalar3> d_sum(m_sum, access_location::device, access_mode::overwrite);
+
+            m_tuner_sum->begin();
+            kernel::gpu_remove_drift_sum(this->m_pdata->getN(),
+                                         d_postype.data,
+                                         d_tag.data,
+                                         d_ref_positions.data,
+                                         box,
+                                         this->m_pdata->getOrigin(),
+                                         d_sum.data,
+                                         this->m_exec_conf->getCachedAllocator(),
+                                         m_tuner_sum->getParam());
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            m_tuner_sum->end();
+            }
+
+        Scalar3 rshift;
+            {
+            ArrayHandle<Scalar3> h_sum(m_sum, access_location::host, access_mode::read);
+            rshift = h_sum.data[0];
+            }
+
+#ifdef ENABLE_MPI
+        if (this->m_pdata->getDomainDecomposition())
+            {
+            Scalar r[3] = {rshift.x, rshift.y, rshift.z};
+            MPI_Allreduce(MPI_IN_PLACE,
+                          &r[0],
+                          3,
+                          MPI_HOOMD_SCALAR,
+                          MPI_SUM,
+                          m_exec_conf->getMPICommunicator());
+            rshift.x = r[0];
+            rshift.y = r[1];
+            rshift.z = r[2];
+            }
+#endif
+
+        rshift /= Scalar(this->m_pdata->getNGlobal());
+
+        ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(),
+                                       access_location::device,
+                                       access_mode::readwrite);
+        ArrayHandle<int3> d_image(this->m_pdata->getImages(),
+                                  access_location::device,
+                                  access_mode::readwrite);
+
+        m_tuner_subtract->begin();
+        kernel::gpu_remove_drift_subtract(this->m_pdata->getN(),
+                                          d_postype.data,
+                                          d_image.data,
+                                          box,
+                                          rshift,
+                                          m_tuner_subtract->getParam());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_subtract->end();
+        }
+
+    protected:
+    GlobalArray<Scalar3> m_ref_positions_gpu;    //!< Reference positions indexed by tag
+    GlobalArray<Scalar3> m_sum;                  //!< Sum of the local displacements
+    std::unique_ptr<Autotuner> m_tuner_sum;      //!< Autotuner for the displacement sum
+    std::unique_ptr<Autotuner> m_tuner_subtract; //!< Autotuner for the drift subtraction
+
+    //! Copy the reference positions to the device array
+    void copyReferencePositions()
+        {
+        if (m_ref_positions_gpu.getNumElements() != m_ref_positions.size())
+            {
+            GlobalArray<Scalar3> ref_positions(m_ref_positions.size(), m_exec_conf);
+            m_ref_positions_gpu.swap(ref_positions);
+            }
+
+        ArrayHandle<Scalar3> h_ref_positions(m_ref_positions_gpu,
+                                             access_location::host,
+                                             access_mode::overwrite);
+        for (size_t i = 0; i < m_ref_positions.size(); i++)
+            h_ref_positions.data[i] = vec_to_scalar3(m_ref_positions[i]);
+        }
+    };
+
+namespace detail
+    {
+/// Export the UpdaterRemoveDriftGPU to python
+void export_UpdaterRemoveDriftGPU(pybind11::module& m)
+    {
+    pybind11::class_<UpdaterRemoveDriftGPU,
+                     UpdaterRemoveDrift,
+                     std::shared_ptr<UpdaterRemoveDriftGPU>>(m, "UpdaterRemoveDriftGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>, pybind11::array_t<double>>());
+    }
+
+    } // end namespace detail
+
+    } // end namespace hoomd
+
+#endif // _REMOVE_DRIFT_UPDATER_GPU_H_
+#endif // ENABLE_HIP
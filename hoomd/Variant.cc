@@ -3,24 +3,31 @@
 
 #include "Variant.h"
 
+#include <pybind11/stl.h>
+
 namespace hoomd
     {
 //* Trampoline for classes inherited in python
+/* Variants are functions of the time step, and integrators and updaters may evaluate the same
+   variant many times in one step. The trampoline caches the value of the last time step so that
+   each step costs at most one call into the Python interpreter.
+*/
 class VariantPy : public Variant
     {
     public:
     // Inherit the constructors
     using Variant::Variant;
 
-    // trampoline method
+    // trampoline method, cached for the current time step
     Scalar operator()(uint64_t timestep) override
         {
-        PYBIND11_OVERLOAD_NAME(Scalar,     // Return type
-                               Variant,    // Parent class
-                               "__call__", // name of function in python
-                               operator(), // Name of function in C++
-                               timestep    // Argument(s)
-        );
+        if (!m_cache_valid || timestep != m_cache_timestep)
+            {
+            m_cache_value = evaluatePython(timestep);
+            m_cache_timestep = timestep;
+            m_cache_valid = true;
+            }
+        return m_cache_value;
         }
 
     Scalar min() override
@@ -40,6 +47,67 @@ class VariantPy : public Variant
                                     max      // name of function
         );
         }
+
+    private:
+    // call the python method
+    Scalar evaluatePython(uint64_t timestep)
+        {
+        PYBIND11_OVERLOAD_NAME(Scalar,     // Return type
+                               Variant,    // Parent class
+                               "__call__", // name of function in python
+                               operator(), // Name of function in C++
+                               timestep    // Argument(s)
+        );
+        }
+
+    bool m_cache_valid = false; //!< True when m_cache_value holds a value
+    uint64_t m_cache_timestep;  //!< Time step of the cached value
+    Scalar m_cache_value;       //!< Cached value
+    };
+
+//* Trampoline for vector variants inherited in python
+class VectorVariantPy : public VectorVariant
+    {
+    public:
+    // Inherit the constructors
+    using VectorVariant::VectorVariant;
+
+    // trampoline method, cached for the current time step
+    std::vector<Scalar> operator()(uint64_t timestep) override
+        {
+        if (!m_cache_valid || timestep != m_cache_timestep)
+            {
+            m_cache_values = evaluatePython(timestep);
+            m_cache_timestep = timestep;
+            m_cache_valid = true;
+            }
+        return m_cache_values;
+        }
+
+    size_t size() override
+        {
+        PYBIND11_OVERLOAD_PURE_NAME(size_t,        // Return type
+                                    VectorVariant, // Parent class
+                                    "__len__",     // name of function in python
+                                    size           // name of function
+        );
+        }
+
+    private:
+    // call the python method
+    std::vector<Scalar> evaluatePython(uint64_t timestep)
+        {
+        PYBIND11_OVERLOAD_NAME(std::vector<Scalar>, // Return type
+                               VectorVariant,       // Parent class
+                               "__call__",          // name of function in python
+                               operator(),          // Name of function in C++
+                               timestep             // Argument(s)
+        );
+        }
+
+    bool m_cache_valid = false;         //!< True when m_cache_values holds the values
+    uint64_t m_cache_timestep;          //!< Time step of the cached values
+    std::vector<Scalar> m_cache_values; //!< Cached values
     };
 
 namespace detail
@@ -66,6 +134,14 @@ Scalar testVariantMax(std::shared_ptr<Variant> t)
     return t->max();
     }
 
+/// Method to enable unit testing of C++ vector variant evaluation from pytest
+std::vector<Scalar> testVectorVariantEvaluate(std::shared_ptr<VectorVariant> t, uint64_t step)
+    {
+    std::vector<Scalar> values(t->size());
+    t->evaluate(step, values.data());
+    return values;
+    }
+
 void export_Variant(pybind11::module& m)
     {
     pybind11::class_<Variant, VariantPy, std::shared_ptr<Variant>>(m, "Variant")
@@ -178,9 +254,31 @@ void export_Variant(pybind11::module& m)
                                     params[4].cast<uint64_t>());
             }));
 
+    pybind11::class_<VectorVariant, VectorVariantPy, std::shared_ptr<VectorVariant>>(
+        m,
+        "VectorVariant")
+        .def(pybind11::init<>())
+        .def("__call__", &VectorVariant::operator())
+        .def("__len__", &VectorVariant::size);
+
+    pybind11::class_<VectorVariantList, VectorVariant, std::shared_ptr<VectorVariantList>>(
+        m,
+        "VectorVariantList")
+        .def(pybind11::init<std::vector<std::shared_ptr<Variant>>>(), pybind11::arg("variants"))
+        .def_property("variants", &VectorVariantList::getVariants, &VectorVariantList::setVariants)
+        .def(pybind11::pickle(
+            [](const VectorVariantList& variant)
+            { return pybind11::make_tuple(variant.getVariants()); },
+            [](pybind11::tuple params)
+            {
+                return VectorVariantList(
+                    params[0].cast<std::vector<std::shared_ptr<Variant>>>());
+            }));
+
     m.def("_test_variant_call", &testVariantCall);
     m.def("_test_variant_min", &testVariantMin);
     m.def("_test_variant_max", &testVariantMax);
+    m.def("_test_vector_variant_evaluate", &testVectorVariantEvaluate);
     }
 
     } // end namespace detail
@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <pybind11/pybind11.h>
 #include <utility>
+#include <vector>
 
 #include "HOOMDMath.h"
 
@@ -593,6 +596,100 @@ class PYBIND11_EXPORT VariantPower : public Variant
     double m_inv_end;
     };
 
+/** Defines vectors of quantities that vary with time steps.
+
+    VectorVariant evaluates several values (such as one value per particle type) in one call. This
+    replaces one virtual call per value with one per time step, and one round trip through the
+    Python interpreter per value with one per time step for variants defined in Python. Use
+    evaluate() to write the values directly into a parameter array (e.g. through a host
+    ArrayHandle) before the kernels read it on the device.
+*/
+class PYBIND11_EXPORT VectorVariant
+    {
+    public:
+    /// Construct a VectorVariant.
+    VectorVariant() { }
+
+    virtual ~VectorVariant() { }
+
+    /** Return the values of the VectorVariant at the given time step.
+
+        @param timestep Time step to query.
+        @returns The values of the variant.
+    */
+    virtual std::vector<Scalar> operator()(uint64_t timestep)
+        {
+        return std::vector<Scalar>();
+        }
+
+    /** Write the values of the VectorVariant at the given time step.
+
+        @param timestep Time step to query.
+        @param values Array to write size() values to.
+    */
+    virtual void evaluate(uint64_t timestep, Scalar* values)
+        {
+        const std::vector<Scalar> result = (*this)(timestep);
+        std::copy(result.begin(), result.end(), values);
+        }
+
+    /// Returns the number of values
+    virtual size_t size() = 0;
+    };
+
+/** List of variants
+
+    VectorVariant that evaluates a list of scalar variants.
+*/
+class PYBIND11_EXPORT VectorVariantList : public VectorVariant
+    {
+    public:
+    /** Construct a VectorVariantList.
+
+        @param variants The variants to evaluate.
+    */
+    VectorVariantList(const std::vector<std::shared_ptr<Variant>>& variants) : m_variants(variants)
+        {
+        }
+
+    /// Return the values.
+    std::vector<Scalar> operator()(uint64_t timestep) override
+        {
+        std::vector<Scalar> values(m_variants.size());
+        evaluate(timestep, values.data());
+        return values;
+        }
+
+    /// Write the values.
+    void evaluate(uint64_t timestep, Scalar* values) override
+        {
+        for (size_t i = 0; i < m_variants.size(); i++)
+            values[i] = (*m_variants[i])(timestep);
+        }
+
+    /// Returns the number of variants.
+    size_t size() override
+        {
+        return m_variants.size();
+        }
+
+    /// Set the variants.
+    void setVariants(const std::vector<std::shared_ptr<Variant>>& variants)
+        {
+        m_variants = variants;
+        }
+
+    /// Get the variants.
+    const std::vector<std::shared_ptr<Variant>>& getVariants() const
+        {
+        return m_variants;
+        }
+
+    protected:
+    /// The variants.
+    std::vector<std::shared_ptr<Variant>> m_variants;
+    };
+
 namespace detail
     {
 /// Export Variant classes to Python
@@ -6,10 +6,18 @@
 
 :py:mod:`hoomd` provides a high level user interface for defining and executing
 simulations using HOOMD.
+
+The subpackages `hoomd.md`, `hoomd.hpmc`, and `hoomd.dem` load large compiled
+extension modules. ``import hoomd`` does not import them: each loads the first
+time a script accesses it (e.g. ``hoomd.md.pair.LJ`` or ``from hoomd import
+md``). This shortens the start up time, especially on parallel file systems
+where every MPI rank reads the extension modules. Set the environment variable
+``HOOMD_EAGER_IMPORT=1`` to import all built subpackages with ``hoomd``.
 """
 import sys
 import pathlib
 import os
+import importlib
 
 if ((pathlib.Path(__file__).parent / 'CMakeLists.txt').exists()
         and 'SPHINX' not in os.environ):
@@ -40,19 +48,41 @@ from hoomd import communicator
 from hoomd import util
 from hoomd import write
 from hoomd import _hoomd
+
+# Subpackages that load compiled extension modules on first access.
+_lazy_subpackages = set()
 if version.md_built:
-    from hoomd import md
+    _lazy_subpackages.add('md')
 if version.hpmc_built:
-    from hoomd import hpmc
+    _lazy_subpackages.add('hpmc')
 if version.dem_built and version.md_built:
-    from hoomd import dem
+    _lazy_subpackages.add('dem')
+
+
+def __getattr__(name):
+    """Import lazily loaded subpackages on first access."""
+    if name in _lazy_subpackages:
+        # import_module sets the attribute on this module, so later accesses
+        # do not call __getattr__
+        return importlib.import_module('hoomd.' + name)
+    raise AttributeError(f"module 'hoomd' has no attribute '{name}'")
+
+
+def __dir__():
+    """List the attributes of the module including the lazy subpackages."""
+    return sorted(set(globals()) | _lazy_subpackages)
+
+
+if os.environ.get('HOOMD_EAGER_IMPORT', '0') not in ('', '0'):
+    for _name in sorted(_lazy_subpackages):
+        importlib.import_module('hoomd.' + _name)
 # if version.metal_built:
 #     from hoomd import metal
 # if version.mpcd_built:
 #     from hoomd import mpcd
 
 from hoomd.simulation import Simulation
-from hoomd.state import State
+from hoomd.state import State, Checkpoint
 from hoomd.operations import Operations
 from hoomd.snapshot import Snapshot
 from hoomd import tune
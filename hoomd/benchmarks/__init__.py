@@ -0,0 +1,37 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Standard benchmarks.
+
+Each benchmark sets up a standard workload, runs it, and reports the
+performance in a dictionary. Run the benchmarks from the command line to
+print the results as JSON::
+
+    python3 -m hoomd.benchmarks --device GPU --N 4096 32768 --output tps.json
+
+Use ``python3 -m hoomd.benchmarks --help`` to list the options. Compare the
+results of different builds and devices to track performance regressions.
+
+Use `hoomd.benchmarks.scaling` to measure the strong and weak scaling of the
+benchmarks with MPI.
+
+To isolate a regression in a single kernel, build the C++ microbenchmarks with
+``make microbenchmarks`` and run ``hoomd/md/test/bench_pair_evaluators`` and
+``hoomd/hpmc/test/bench_overlap`` in the build directory. They report the pair
+force evaluations and shape overlap checks per second on the CPU and GPU.
+
+Note:
+    Run the benchmarks with MPI to benchmark domain decomposition. Only the
+    root rank writes the results.
+"""
+
+from hoomd.benchmarks.common import Benchmark, make_lattice_snapshot
+from hoomd.benchmarks.md import LJLiquid, WCALangevin, PPPMMelt, RigidBodies
+from hoomd.benchmarks.hpmc import HardSpheres, HardCubes
+
+#: dict[str, type]: All benchmarks, by name.
+benchmarks = {
+    cls.name: cls for cls in (LJLiquid, WCALangevin, PPPMMelt, RigidBodies,
+                              HardSpheres, HardCubes)
+}
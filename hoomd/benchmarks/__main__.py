@@ -0,0 +1,73 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Run the standard benchmarks and print the results as JSON."""
+
+import argparse
+import json
+import sys
+
+import hoomd
+from hoomd.benchmarks import benchmarks
+
+
+def main(args):
+    """Run the benchmarks selected by the command line arguments."""
+    parser = argparse.ArgumentParser(
+        prog='python3 -m hoomd.benchmarks',
+        description='Run the standard HOOMD-blue benchmarks.')
+    parser.add_argument('--device',
+                        choices=['CPU', 'GPU'],
+                        default='CPU',
+                        help='device to execute on')
+    parser.add_argument('--benchmarks',
+                        nargs='+',
+                        choices=sorted(benchmarks),
+                        default=list(benchmarks),
+                        help='benchmarks to run (default: all)')
+    parser.add_argument('--N',
+                        nargs='+',
+                        type=int,
+                        default=[4096, 32768],
+                        help='approximate numbers of particles')
+    parser.add_argument('--warmup-steps', type=int, default=1000)
+    parser.add_argument('--benchmark-steps', type=int, default=1000)
+    parser.add_argument('--repeat', type=int, default=3)
+    parser.add_argument('--profile',
+                        action='store_true',
+                        help='report the per-operation time breakdown')
+    parser.add_argument('--output',
+                        help='file to write the results to (default: stdout)')
+    options = parser.parse_args(args)
+
+    if options.device == 'GPU':
+        device = hoomd.device.GPU(notice_level=1)
+    else:
+        device = hoomd.device.CPU(notice_level=1)
+
+    results = []
+    for name in options.benchmarks:
+        for N in options.N:
+            benchmark = benchmarks[name](
+                device,
+                N,
+                warmup_steps=options.warmup_steps,
+                benchmark_steps=options.benchmark_steps,
+                repeat=options.repeat,
+                profile=options.profile)
+            results.append(benchmark.run())
+
+    if device.communicator.rank == 0:
+        text = json.dumps(dict(hoomd_version=hoomd.version.version,
+                               results=results),
+                          indent=2)
+        if options.output is None:
+            print(text)
+        else:
+            with open(options.output, 'w') as f:
+                f.write(text + '\n')
+
+
+if __name__ == '__main__':
+    main(sys.argv[1:])
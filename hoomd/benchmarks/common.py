@@ -0,0 +1,158 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Benchmark base class and helpers."""
+
+import math
+import statistics
+
+import numpy
+
+import hoomd
+
+
+def make_lattice_snapshot(device, N, spacing, types=('A',)):
+    """Make a snapshot with particles on a simple cubic lattice.
+
+    Args:
+        device (hoomd.device.Device): Device to make the snapshot on.
+        N (int): Approximate number of particles. The snapshot has
+            ``n**3`` particles, where ``n`` is the smallest integer with
+            ``n**3 >= N``.
+        spacing (float): Lattice spacing :math:`[\\mathrm{length}]`.
+        types (tuple[str]): Particle types. Particles cycle through the types
+            in tag order.
+
+    Returns:
+        hoomd.Snapshot: The snapshot.
+    """
+    n = math.ceil(round(N**(1 / 3), 6))
+    L = n * spacing
+
+    snapshot = hoomd.Snapshot(device.communicator)
+    if snapshot.communicator.rank == 0:
+        snapshot.configuration.box = [L, L, L, 0, 0, 0]
+        snapshot.particles.N = n**3
+        snapshot.particles.types = list(types)
+
+        x = (numpy.arange(n) + 0.5) * spacing - L / 2
+        position = numpy.array(numpy.meshgrid(x, x, x)).reshape(3, -1).T
+        snapshot.particles.position[:] = position
+        snapshot.particles.typeid[:] = numpy.arange(n**3) % len(types)
+
+    return snapshot
+
+
+class Benchmark:
+    """Base class for benchmarks.
+
+    Args:
+        device (hoomd.device.Device): Device to execute on.
+        N (int): Approximate number of particles.
+        warmup_steps (int): Number of steps to run before the timed runs.
+        benchmark_steps (int): Number of steps in each timed run.
+        repeat (int): Number of timed runs.
+        profile (bool): When `True`, run `benchmark_steps` more steps with
+            `hoomd.Simulation.profiling` enabled and report the per-operation
+            time breakdown.
+
+    Subclasses set `name` and implement `make_simulation`. MD benchmarks also
+    set `dt`.
+
+    The warmup steps let the autotuners and neighbor list buffers settle before
+    the timed runs. Profiling adds synchronization, so the profiled run is
+    separate from the timed runs.
+    """
+
+    #: str: Name of the benchmark.
+    name = None
+
+    #: float: Time step of MD benchmarks :math:`[\\mathrm{time}]`, `None` for
+    #: HPMC benchmarks.
+    dt = None
+
+    def __init__(self,
+                 device,
+                 N,
+                 warmup_steps=1000,
+                 benchmark_steps=1000,
+                 repeat=3,
+                 profile=False):
+        self.device = device
+        self.N = N
+        self.warmup_steps = warmup_steps
+        self.benchmark_steps = benchmark_steps
+        self.repeat = repeat
+        self.profile = profile
+
+    def make_simulation(self):
+        """Make the simulation to benchmark.
+
+        Returns:
+            hoomd.Simulation: A simulation with its state and operations set.
+        """
+        raise NotImplementedError
+
+    def get_extra_results(self, simulation):
+        """Get results specific to the benchmark.
+
+        Args:
+            simulation (hoomd.Simulation): The benchmarked simulation.
+
+        Returns:
+            dict: Additional entries for the results.
+        """
+        return {}
+
+    def run(self):
+        """Run the benchmark.
+
+        Returns:
+            dict: The results, with the keys:
+
+            * ``name`` (str): Name of the benchmark.
+            * ``device`` (str): Name of the device class.
+            * ``num_ranks`` (int): Number of MPI ranks.
+            * ``N`` (int): Number of particles.
+            * ``steps`` (int): Number of steps in each timed run.
+            * ``tps`` (float): Median time steps per second of the timed runs.
+            * ``tps_samples`` (list[float]): Time steps per second of each
+              timed run.
+            * ``time_per_day`` (float): Simulation time per day of wall clock
+              time at the median TPS :math:`[\\mathrm{time}]`. This is ns/day
+              when the unit of time is 1 ns. `None` for HPMC benchmarks.
+            * ``profile`` (dict): `hoomd.Simulation.profile` of the profiled
+              run, `None` when `profile` is `False`.
+
+            and the entries from `get_extra_results`.
+        """
+        simulation = self.make_simulation()
+        simulation.run(self.warmup_steps)
+
+        tps_samples = []
+        for i in range(self.repeat):
+            simulation.run(self.benchmark_steps)
+            tps_samples.append(simulation.tps)
+        tps = statistics.median(tps_samples)
+
+        results = dict(name=self.name,
+                       device=type(self.device).__name__,
+                       num_ranks=self.device.communicator.num_ranks,
+                       N=simulation.state.N_particles,
+                       steps=self.benchmark_steps,
+                       tps=tps,
+                       tps_samples=tps_samples,
+                       time_per_day=None,
+                       profile=None)
+        if self.dt is not None:
+            results['time_per_day'] = tps * 86400 * self.dt
+        results.update(self.get_extra_results(simulation))
+
+        if self.profile:
+            simulation.profiling = True
+            simulation.run(self.benchmark_steps)
+            results['profile'] = simulation.profile
+            simulation.profiling = False
+
+        return results
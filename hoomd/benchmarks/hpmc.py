@@ -0,0 +1,61 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Hard particle Monte Carlo benchmarks."""
+
+import hoomd
+from hoomd import hpmc
+from hoomd.benchmarks.common import Benchmark, make_lattice_snapshot
+
+
+class _HPMCBenchmark(Benchmark):
+    """Report the trial moves per second of HPMC benchmarks."""
+
+    def get_extra_results(self, simulation):
+        """Get the trial moves per second."""
+        return dict(mps=simulation.operations.integrator.mps)
+
+
+class HardSpheres(_HPMCBenchmark):
+    """Hard sphere fluid.
+
+    Unit diameter spheres at the packing fraction :math:`0.3`.
+    """
+
+    name = 'hard_spheres'
+
+    def make_simulation(self):
+        """Make the simulation to benchmark."""
+        simulation = hoomd.Simulation(device=self.device, seed=1)
+        simulation.create_state_from_snapshot(
+            make_lattice_snapshot(self.device, self.N, 1.2))
+
+        mc = hpmc.integrate.Sphere(default_d=0.2)
+        mc.shape['A'] = dict(diameter=1.0)
+        simulation.operations.integrator = mc
+        return simulation
+
+
+class HardCubes(_HPMCBenchmark):
+    """Hard cube fluid.
+
+    Unit cubes, treated as general convex polyhedra, at the packing fraction
+    :math:`0.3`.
+    """
+
+    name = 'hard_cubes'
+
+    def make_simulation(self):
+        """Make the simulation to benchmark."""
+        simulation = hoomd.Simulation(device=self.device, seed=1)
+        simulation.create_state_from_snapshot(
+            make_lattice_snapshot(self.device, self.N, 0.3**(-1 / 3)))
+
+        mc = hpmc.integrate.ConvexPolyhedron(default_d=0.2, default_a=0.1)
+        mc.shape['A'] = dict(vertices=[(x, y, z)
+                                       for x in (-0.5, 0.5)
+                                       for y in (-0.5, 0.5)
+                                       for z in (-0.5, 0.5)])
+        simulation.operations.integrator = mc
+        return simulation
@@ -0,0 +1,175 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Molecular dynamics benchmarks."""
+
+import math
+
+import numpy
+
+import hoomd
+from hoomd import md
+from hoomd.md.long_range import pppm
+from hoomd.benchmarks.common import Benchmark, make_lattice_snapshot
+
+
+class LJLiquid(Benchmark):
+    """Lennard-Jones liquid in the NVT ensemble.
+
+    The particles interact with the Lennard-Jones potential cut at
+    :math:`r_\\mathrm{cut} = 2.5` at the number density :math:`0.84` and
+    :math:`kT = 1.2`.
+    """
+
+    name = 'lj_liquid'
+    dt = 0.005
+
+    def make_simulation(self):
+        """Make the simulation to benchmark."""
+        simulation = hoomd.Simulation(device=self.device, seed=1)
+        simulation.create_state_from_snapshot(
+            make_lattice_snapshot(self.device, self.N, 0.84**(-1 / 3)))
+        simulation.state.thermalize_particle_momenta(filter=hoomd.filter.All(),
+                                                     kT=1.2)
+
+        lj = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4), default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        nvt = md.methods.NVT(filter=hoomd.filter.All(), kT=1.2, tau=0.5)
+        simulation.operations.integrator = md.Integrator(dt=self.dt,
+                                                         forces=[lj],
+                                                         methods=[nvt])
+        return simulation
+
+
+class WCALangevin(Benchmark):
+    """WCA fluid integrated with Langevin dynamics.
+
+    The particles interact with the Lennard-Jones potential cut and shifted at
+    :math:`r_\\mathrm{cut} = 2^{1/6}` at the number density :math:`0.84` and
+    :math:`kT = 1.0`.
+    """
+
+    name = 'wca_langevin'
+    dt = 0.005
+
+    def make_simulation(self):
+        """Make the simulation to benchmark."""
+        simulation = hoomd.Simulation(device=self.device, seed=1)
+        simulation.create_state_from_snapshot(
+            make_lattice_snapshot(self.device, self.N, 0.84**(-1 / 3)))
+        simulation.state.thermalize_particle_momenta(filter=hoomd.filter.All(),
+                                                     kT=1.0)
+
+        wca = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4),
+                         default_r_cut=2**(1 / 6),
+                         mode='shift')
+        wca.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        langevin = md.methods.Langevin(filter=hoomd.filter.All(), kT=1.0)
+        simulation.operations.integrator = md.Integrator(dt=self.dt,
+                                                         forces=[wca],
+                                                         methods=[langevin])
+        return simulation
+
+
+class PPPMMelt(Benchmark):
+    """Charged Lennard-Jones melt with PPPM electrostatics.
+
+    Neighboring lattice sites have charges :math:`+1` and :math:`-1`. The
+    particles interact with the Lennard-Jones potential cut at
+    :math:`r_\\mathrm{cut} = 2.5` and the Coulomb potential, split at
+    :math:`r_\\mathrm{cut} = 2.5` into the real space and PPPM terms. The
+    PPPM mesh has a spacing of about 0.5.
+    """
+
+    name = 'pppm_melt'
+    dt = 0.005
+
+    def make_simulation(self):
+        """Make the simulation to benchmark."""
+        snapshot = make_lattice_snapshot(self.device, self.N, 0.84**(-1 / 3))
+        if snapshot.communicator.rank == 0:
+            # rock salt arrangement of the charges on the n x n x n lattice
+            n = round(snapshot.particles.N**(1 / 3))
+            i = numpy.arange(snapshot.particles.N)
+            parity = (i % n + i // n % n + i // n**2) % 2
+            charge = 1.0 - 2.0 * parity
+            # neutralize the system when n is odd
+            charge[0] -= numpy.sum(charge)
+            snapshot.particles.charge[:] = charge
+
+        simulation = hoomd.Simulation(device=self.device, seed=1)
+        simulation.create_state_from_snapshot(snapshot)
+        simulation.state.thermalize_particle_momenta(filter=hoomd.filter.All(),
+                                                     kT=1.5)
+        L = simulation.state.box.Lx
+
+        nlist = md.nlist.Cell(buffer=0.4)
+        lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+
+        # the smallest power of two grid with a spacing of at most 0.5
+        resolution = max(8, 2**math.ceil(math.log2(L / 0.5)))
+        real_space, reciprocal_space = pppm.make_pppm_coulomb_forces(
+            nlist=nlist,
+            resolution=(resolution, resolution, resolution),
+            order=5,
+            r_cut=2.5)
+
+        nvt = md.methods.NVT(filter=hoomd.filter.All(), kT=1.5, tau=0.5)
+        simulation.operations.integrator = md.Integrator(
+            dt=self.dt,
+            forces=[lj, real_space, reciprocal_space],
+            methods=[nvt])
+        return simulation
+
+
+class RigidBodies(Benchmark):
+    """Rigid dimers integrated with Langevin dynamics.
+
+    Each body has two constituent particles at :math:`\\pm 0.5` along z from
+    its center that interact with the WCA potential. `N` counts the
+    constituent particles.
+    """
+
+    name = 'rigid_bodies'
+    dt = 0.005
+
+    def make_simulation(self):
+        """Make the simulation to benchmark."""
+        snapshot = make_lattice_snapshot(self.device, self.N // 2, 2.0)
+        if snapshot.communicator.rank == 0:
+            snapshot.particles.types = ['A', 'B']
+            snapshot.particles.moment_inertia[:] = (0.5, 0.5, 0)
+
+        simulation = hoomd.Simulation(device=self.device, seed=1)
+        simulation.create_state_from_snapshot(snapshot)
+
+        rigid = md.constrain.Rigid()
+        rigid.body['A'] = {
+            "constituent_types": ['B', 'B'],
+            "positions": [(0, 0, 0.5), (0, 0, -0.5)],
+            "orientations": [(1, 0, 0, 0), (1, 0, 0, 0)],
+            "charges": [0, 0],
+            "diameters": [1, 1]
+        }
+        rigid.create_bodies(simulation.state)
+
+        centers = hoomd.filter.Rigid(("center", "free"))
+        simulation.state.thermalize_particle_momenta(filter=centers, kT=1.0)
+
+        wca = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4,
+                                             exclusions=('body',)),
+                         default_r_cut=2**(1 / 6),
+                         mode='shift')
+        wca.params[('A', ['A', 'B'])] = dict(epsilon=0, sigma=1)
+        wca.r_cut[('A', ['A', 'B'])] = 0
+        wca.params[('B', 'B')] = dict(epsilon=1, sigma=1)
+        langevin = md.methods.Langevin(filter=centers, kT=1.0)
+        simulation.operations.integrator = md.Integrator(
+            dt=self.dt,
+            integrate_rotational_dof=True,
+            forces=[wca],
+            methods=[langevin],
+            rigid=rigid)
+        return simulation
@@ -0,0 +1,252 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""MPI scaling benchmarks.
+
+Run the standard benchmarks over a list of MPI rank counts and report the
+parallel efficiency and the time spent in communication::
+
+    python3 -m hoomd.benchmarks.scaling --ranks 1 2 4 8 --mode strong \\
+        --N 262144 --benchmarks lj_liquid pppm_melt --output scaling.json
+
+The driver itself runs without MPI. For each rank count, it launches the
+benchmarks with ``--launcher`` (``mpirun -n {ranks}`` by default) and collects
+the results that each rank writes. In ``strong`` mode, every run simulates
+``N`` particles. In ``weak`` mode, every run simulates ``N`` particles per
+rank.
+"""
+
+import argparse
+import json
+import os
+import shlex
+import subprocess
+import sys
+import tempfile
+
+import hoomd
+from hoomd.benchmarks import benchmarks
+
+#: dict[str, str]: Communication categories reported by `run_scaling`, and the
+#: names of the `hoomd.Simulation.profile` nodes that they sum.
+communication_regions = {
+    'migrate_particles': 'comm_migrate',
+    'exchange_ghosts': 'comm_ghost_exch',
+    'update_ghosts': 'comm_ghost_update',
+    'update_net_force': 'comm_ghost_net_force',
+    'grid': 'ghost cell update',
+}
+
+
+def _sum_node_time(node, name):
+    """Sum the time of all nodes with the given name in a profile subtree."""
+    total = 0.0
+    for child_name, child in node['children'].items():
+        if child_name == name:
+            total += child['time']
+        else:
+            total += _sum_node_time(child, name)
+    return total
+
+
+def communication_breakdown(profile):
+    """Get the communication times from a profile.
+
+    Args:
+        profile (dict): `hoomd.Simulation.profile` of a profiled run.
+
+    Returns:
+        dict[str, float]: Total time spent in each category of
+        `communication_regions` :math:`[\\mathrm{s}]`, and the ``total`` time
+        of the run.
+
+    ``update_ghosts`` includes both the
+    ``Communicator::beginUpdateGhosts`` and ``finishUpdateGhosts`` phases.
+    ``grid`` is the ghost cell communication of the ``md.long_range.pppm``
+    mesh.
+    """
+    root = profile['Simulation']
+    breakdown = {
+        category: _sum_node_time(root, name)
+        for category, name in communication_regions.items()
+    }
+    breakdown['total'] = root['time']
+    return breakdown
+
+
+def _run_worker(options):
+    """Run one benchmark on all ranks and write the results of each rank."""
+    if options.device == 'GPU':
+        device = hoomd.device.GPU(notice_level=1)
+    else:
+        device = hoomd.device.CPU(notice_level=1)
+
+    benchmark = benchmarks[options.benchmarks[0]](
+        device,
+        options.N[0],
+        warmup_steps=options.warmup_steps,
+        benchmark_steps=options.benchmark_steps,
+        repeat=options.repeat,
+        profile=True)
+    results = benchmark.run()
+    results['communication'] = communication_breakdown(results.pop('profile'))
+
+    filename = os.path.join(options.worker,
+                            f'rank{device.communicator.rank}.json')
+    with open(filename, 'w') as f:
+        json.dump(results, f)
+
+
+def _aggregate(rank_results, steps):
+    """Combine the results of all ranks of one run."""
+    results = dict(rank_results[0])
+    communication = {}
+    for category in rank_results[0]['communication']:
+        times = [r['communication'][category] / steps for r in rank_results]
+        communication[category] = dict(max=max(times),
+                                       mean=sum(times) / len(times))
+    results['communication'] = communication
+    return results
+
+
+def run_scaling(name,
+                ranks,
+                N,
+                mode='strong',
+                device='CPU',
+                launcher='mpirun -n {ranks}',
+                warmup_steps=1000,
+                benchmark_steps=1000,
+                repeat=3):
+    """Run a benchmark over a list of MPI rank counts.
+
+    Args:
+        name (str): Name of the benchmark in `hoomd.benchmarks.benchmarks`.
+        ranks (list[int]): Numbers of MPI ranks.
+        N (int): Approximate number of particles (``strong``) or number of
+            particles per rank (``weak``).
+        mode (str): ``'strong'`` or ``'weak'``.
+        device (str): ``'CPU'`` or ``'GPU'``.
+        launcher (str): Command that launches an MPI program on ``{ranks}``
+            ranks.
+        warmup_steps (int): Number of steps to run before the timed runs.
+        benchmark_steps (int): Number of steps in each timed run.
+        repeat (int): Number of timed runs.
+
+    Returns:
+        list[dict]: The results of each rank count. Each entry has the keys of
+        `Benchmark.run` (without ``profile``) and:
+
+        * ``mode`` (str): The scaling mode.
+        * ``efficiency`` (float): Parallel efficiency relative to the first
+          rank count.
+        * ``communication`` (dict): For each category of
+          `communication_regions` and ``total``, the ``max`` and ``mean`` over
+          the ranks of the time per step :math:`[\\mathrm{s}]`.
+    """
+    if mode not in ('strong', 'weak'):
+        raise ValueError(f"mode must be 'strong' or 'weak', got {mode}")
+
+    scaling_results = []
+    for num_ranks in ranks:
+        run_N = N * num_ranks if mode == 'weak' else N
+        with tempfile.TemporaryDirectory() as directory:
+            command = shlex.split(launcher.format(ranks=num_ranks))
+            command += [
+                sys.executable, '-m', 'hoomd.benchmarks.scaling', '--worker',
+                directory, '--device', device, '--benchmarks', name, '--N',
+                str(run_N), '--warmup-steps',
+                str(warmup_steps), '--benchmark-steps',
+                str(benchmark_steps), '--repeat',
+                str(repeat)
+            ]
+            subprocess.run(command, check=True)
+
+            rank_results = []
+            for rank in range(num_ranks):
+                filename = os.path.join(directory, f'rank{rank}.json')
+                with open(filename) as f:
+                    rank_results.append(json.load(f))
+
+        results = _aggregate(rank_results, benchmark_steps)
+        results['mode'] = mode
+        scaling_results.append(results)
+
+    reference = scaling_results[0]
+    for results in scaling_results:
+        speedup = results['tps'] / reference['tps']
+        if mode == 'strong':
+            speedup *= reference['num_ranks'] / results['num_ranks']
+        results['efficiency'] = speedup
+
+    return scaling_results
+
+
+def main(args):
+    """Run the scaling benchmarks selected by the command line arguments."""
+    parser = argparse.ArgumentParser(
+        prog='python3 -m hoomd.benchmarks.scaling',
+        description='Run the HOOMD-blue benchmarks over MPI rank counts.')
+    parser.add_argument('--ranks',
+                        nargs='+',
+                        type=int,
+                        default=[1, 2, 4, 8],
+                        help='numbers of MPI ranks')
+    parser.add_argument('--mode', choices=['strong', 'weak'], default='strong')
+    parser.add_argument('--launcher',
+                        default='mpirun -n {ranks}',
+                        help='MPI launch command (default: mpirun -n {ranks})')
+    parser.add_argument('--device',
+                        choices=['CPU', 'GPU'],
+                        default='CPU',
+                        help='device to execute on')
+    parser.add_argument('--benchmarks',
+                        nargs='+',
+                        choices=sorted(benchmarks),
+                        default=['lj_liquid', 'pppm_melt'],
+                        help='benchmarks to run')
+    parser.add_argument('--N',
+                        nargs='+',
+                        type=int,
+                        default=[32768],
+                        help='numbers of particles (strong) or numbers of '
+                        'particles per rank (weak)')
+    parser.add_argument('--warmup-steps', type=int, default=1000)
+    parser.add_argument('--benchmark-steps', type=int, default=1000)
+    parser.add_argument('--repeat', type=int, default=3)
+    parser.add_argument('--output',
+                        help='file to write the results to (default: stdout)')
+    parser.add_argument('--worker', help=argparse.SUPPRESS)
+    options = parser.parse_args(args)
+
+    if options.worker is not None:
+        _run_worker(options)
+        return
+
+    results = []
+    for name in options.benchmarks:
+        for N in options.N:
+            results.extend(
+                run_scaling(name,
+                            options.ranks,
+                            N,
+                            mode=options.mode,
+                            device=options.device,
+                            launcher=options.launcher,
+                            warmup_steps=options.warmup_steps,
+                            benchmark_steps=options.benchmark_steps,
+                            repeat=options.repeat))
+
+    text = json.dumps(dict(hoomd_version=hoomd.version.version,
+                           results=results),
+                      indent=2)
+    if options.output is None:
+        print(text)
+    else:
+        with open(options.output, 'w') as f:
+            f.write(text + '\n')
+
+
+if __name__ == '__main__':
+    main(sys.argv[1:])
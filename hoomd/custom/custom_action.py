@@ -53,6 +53,26 @@ class Action(metaclass=_AbstractLoggable):
             def act(self, timestep):
                 pass
 
+    Actions in `hoomd.update.CustomUpdater` and `hoomd.write.CustomWriter`
+    may declare the simulation data that `act` reads and writes with the
+    ``reads`` and ``writes`` attributes. `hoomd.Simulation.run` executes actions
+    that access none of the data (e.g. that report progress or write data
+    gathered by other operations) in a worker thread, concurrently with the
+    integrator and the other writers. The default, `None`, declares that the
+    action accesses all data.
+
+    .. code-block:: python
+
+        from hoomd.custom import Action
+
+
+        class ExampleIndependentAction(Action):
+            reads = []
+            writes = []
+
+            def act(self, timestep):
+                print(timestep)
+
     Use the `hoomd.logging.log` decorator to define loggable properties.
 
     .. code-block:: python
@@ -74,6 +94,10 @@ class Action(metaclass=_AbstractLoggable):
         flags (list[hoomd.custom.Action.Flags]): List of flags from the
             `hoomd.custom.Action.Flags`. Used to tell the integrator if
             specific quantities are needed for the action.
+        reads (list[hoomd.custom.Action.Data]): Simulation data that `act`
+            reads, `None` for all data.
+        writes (list[hoomd.custom.Action.Data]): Simulation data that `act`
+            writes, `None` for all data.
     """
 
     class Flags(IntEnum):
@@ -82,12 +106,31 @@ class Action(metaclass=_AbstractLoggable):
         * PRESSURE_TENSOR = 0
         * ROTATIONAL_KINETIC_ENERGY = 1
         * EXTERNAL_FIELD_VIRIAL = 2
+        * POTENTIAL_ENERGY = 3
         """
         PRESSURE_TENSOR = 0
         ROTATIONAL_KINETIC_ENERGY = 1
         EXTERNAL_FIELD_VIRIAL = 2
+        POTENTIAL_ENERGY = 3
+
+    class Data(IntEnum):
+        """Simulation data that actions read or write.
+
+        * PARTICLES = 0
+        * BONDED = 1
+        * BOX = 2
+        * FORCES = 3
+        * PARAMETERS = 4
+        """
+        PARTICLES = 0
+        BONDED = 1
+        BOX = 2
+        FORCES = 3
+        PARAMETERS = 4
 
     flags = []
+    reads = None
+    writes = None
     log_quantities = {}
 
     def __init__(self):
@@ -387,13 +387,15 @@ class AttachedTypeParameterDict(_ValidatedDefaultDict):
         self._default = type_param_dict._default
         self._type_converter = type_param_dict._type_converter
         # add all types to c++
+        parameters = {}
         for key in self:
             parameter = type_param_dict._single_getitem(key)
             try:
                 _raise_if_required_arg(parameter)
             except IncompleteSpecificationError as err:
                 raise IncompleteSpecificationError(f"for key {key} {str(err)}")
-            self._single_setitem(key, parameter)
+            parameters[key] = parameter
+        self._multi_setitem(parameters)
 
     def to_detached(self):
         """Convert to a detached parameter dict."""
@@ -416,6 +418,29 @@ class AttachedTypeParameterDict(_ValidatedDefaultDict):
         """Set parameter by key."""
         getattr(self._cpp_obj, self._setter)(key, item)
 
+    def _multi_setitem(self, items):
+        """Set parameters for several keys with one call when possible.
+
+        C++ classes may provide a batch setter (e.g. ``setRCutBatch``) that
+        takes a dict of all keys and values. Pair potentials use it to notify
+        the neighbor list once.
+        """
+        batch_setter = getattr(self._cpp_obj, self._setter + "Batch", None)
+        if batch_setter is None or len(items) == 1:
+            for key, item in items.items():
+                self._single_setitem(key, item)
+        else:
+            batch_setter(items)
+
+    def __setitem__(self, keys, item):
+        """Set parameter by key."""
+        keys = list(self._yield_keys(keys))
+        try:
+            validated_value = self._validate_values(item)
+        except ValueError as err:
+            raise err.__class__(f"For types {keys} {str(err)}.") from err
+        self._multi_setitem({key: validated_value for key in keys})
+
     def _yield_keys(self, key):
         """Includes key check for existing simulation keys.
 
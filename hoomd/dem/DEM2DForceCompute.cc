@@ -39,7 +39,8 @@ DEM2DForceCompute<Real, Real4, Potential>::DEM2DForceCompute(
     std::shared_ptr<md::NeighborList> nlist,
     Real r_cut,
     Potential potential)
-    : ForceCompute(sysdef), m_nlist(nlist), m_r_cut(r_cut), m_evaluator(potential), m_shapes()
+    : ForceCompute(sysdef), m_nlist(nlist), m_r_cut(r_cut), m_evaluator(potential), m_shapes(),
+      m_boundRadius()
     {
     m_exec_conf->msg->notice(5) << "Constructing DEM2DForceCompute" << endl;
 
@@ -184,6 +185,12 @@ void DEM2DForceCompute<Real, Real4, Potential>::setParams(unsigned int type,
         }
 
     m_shapes[type] = points;
+
+    Real radiusSq(0);
+    for (size_t i(0); i < points.size(); ++i)
+        radiusSq = max(radiusSq, dot(points[i], points[i]));
+    m_boundRadius.resize(m_shapes.size(), Real(0));
+    m_boundRadius[type] = sqrt(radiusSq);
     }
 
 /*! \post The DEM2D forces are computed for the given timestep. The neighborlist's
@@ -342,6 +349,11 @@ void DEM2DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                 vec2<Real> forceij, forceji;
                 Real torqueij(0), torqueji(0), potentialij(0);
 
+                // reach of each polygon, used to skip the vertices that cannot touch the other one
+                const Real rcut_feature(m_evaluator.getFeatureRcut());
+                const Real bound_i(m_boundRadius[typei] + rcut_feature);
+                const Real bound_j(m_boundRadius[typej] + rcut_feature);
+
                 // Make a local copy for the rotated vertices for particle j
                 vector<vec2<Real>> vertices_j(m_shapes[typej]);
                 for (typename vector<vec2<Real>>::iterator vertIter(vertices_j.begin());
@@ -356,6 +368,11 @@ void DEM2DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                          viIter != vertices_i.end();
                          ++viIter)
                         {
+                        // skip the vertex if it cannot reach particle j
+                        const vec2<Real> rj(*viIter - dx);
+                        if (dot(rj, rj) > bound_j * bound_j)
+                            continue;
+
                         // iterate over each edge of particle j
                         for (typename vector<vec2<Real>>::const_iterator vjIter(vertices_j.begin());
                              vjIter + 1 != vertices_j.end();
@@ -393,6 +410,11 @@ void DEM2DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                          vjIter != vertices_j.end();
                          ++vjIter)
                         {
+                        // skip the vertex if it cannot reach particle i
+                        const vec2<Real> ri(*vjIter + dx);
+                        if (dot(ri, ri) > bound_i * bound_i)
+                            continue;
+
                         // iterate over each edge of particle i
                         for (typename vector<vec2<Real>>::const_iterator viIter(vertices_i.begin());
                              viIter + 1 != vertices_i.end();
@@ -40,6 +40,9 @@ namespace dem
   Forces can be computed directly by calling compute() and then retrieved with a call to acquire(),
   but a more typical usage will be to add the force compute to NVEUpdater or NVTUpdater.
 
+  Vertices that are farther than the feature cutoff of the potential from the bounding circle of the
+  other polygon are skipped before their vertex/edge pairs are evaluated.
+
   \ingroup computes
 */
 template<typename Real, typename Real4, typename Potential>
@@ -102,6 +105,7 @@ class DEM2DForceCompute : public ForceCompute
     DEMEvaluator<Real, Real4, Potential>
         m_evaluator; //!< Object holding parameters and computation method for the potential
     std::vector<std::vector<vec2<Real>>> m_shapes; //!< Vertices for each type
+    std::vector<Real> m_boundRadius;               //!< Radius of the bounding circle of each type
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
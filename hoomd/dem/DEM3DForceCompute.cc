@@ -30,6 +30,22 @@ namespace hoomd
     {
 namespace dem
     {
+namespace detail
+    {
+//! Test if a point is within \a r_cut of a bounding sphere
+/*! \param point Point to test
+  \param bounds Center (xyz) and radius (w) of the bounding sphere
+  \param r_cut Distance beyond which features do not interact
+*/
+template<typename Real, typename Real4>
+inline bool withinBounds(const vec3<Real>& point, const Real4& bounds, const Real r_cut)
+    {
+    const vec3<Real> delta(point - vec3<Real>(bounds.x, bounds.y, bounds.z));
+    const Real reach(bounds.w + r_cut);
+    return dot(delta, delta) <= reach * reach;
+    }
+    } // end namespace detail
+
 /*! \param sysdef System to compute forces on
   \param nlist Neighborlist to use for computing the forces
   \param r_cut Cutoff radius beyond which the force is 0
@@ -49,7 +65,9 @@ DEM3DForceCompute<Real, Real4, Potential>::DEM3DForceCompute(
       m_firstTypeEdge(0, this->m_exec_conf), m_numTypeEdges(0, this->m_exec_conf),
       m_numTypeFaces(0, this->m_exec_conf), m_vertexConnectivity(0, this->m_exec_conf),
       m_edges(0, this->m_exec_conf), m_faceRcutSq(0, this->m_exec_conf),
-      m_edgeRcutSq(0, this->m_exec_conf), m_verts(0, this->m_exec_conf), m_shapes(), m_facesVec()
+      m_edgeRcutSq(0, this->m_exec_conf), m_verts(0, this->m_exec_conf),
+      m_faceBounds(0, this->m_exec_conf), m_edgeBounds(0, this->m_exec_conf),
+      m_typeBoundRadius(0, this->m_exec_conf), m_shapes(), m_facesVec()
     {
     m_exec_conf->msg->notice(5) << "Constructing DEM3DForceCompute" << endl;
 
@@ -284,6 +302,15 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
     if (m_edges.getNumElements() != 2 * nEdges)
         m_edges.resize(2 * nEdges);
 
+    if (m_faceBounds.getNumElements() != nFaces)
+        m_faceBounds.resize(nFaces);
+
+    if (m_edgeBounds.getNumElements() != nEdges)
+        m_edgeBounds.resize(nEdges);
+
+    if (m_typeBoundRadius.getNumElements() != nTypes)
+        m_typeBoundRadius.resize(nTypes);
+
     ArrayHandle<Real4> h_verts(m_verts, access_location::host, access_mode::overwrite);
     ArrayHandle<Real> h_faceRcutSq(m_faceRcutSq, access_location::host, access_mode::overwrite);
     ArrayHandle<Real> h_edgeRcutSq(m_edgeRcutSq, access_location::host, access_mode::overwrite);
@@ -316,6 +343,11 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
                                                    access_location::host,
                                                    access_mode::overwrite);
     ArrayHandle<unsigned int> h_edges(m_edges, access_location::host, access_mode::overwrite);
+    ArrayHandle<Real4> h_faceBounds(m_faceBounds, access_location::host, access_mode::overwrite);
+    ArrayHandle<Real4> h_edgeBounds(m_edgeBounds, access_location::host, access_mode::overwrite);
+    ArrayHandle<Real> h_typeBoundRadius(m_typeBoundRadius,
+                                        access_location::host,
+                                        access_mode::overwrite);
 
     // iterate over shapes to build GPU Arrays m_verts,
     // m_firstTypeVert, and m_numTypeVerts
@@ -436,6 +468,13 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
             h_edges.data[2 * edgeCount] = (unsigned int)edgeIter->first;
             h_edges.data[2 * edgeCount + 1] = (unsigned int)edgeIter->second;
 
+            // the bounding sphere of the edge is centered on its midpoint
+            const vec3<Real> p0(h_verts.data[edgeIter->first]);
+            const vec3<Real> p1(h_verts.data[edgeIter->second]);
+            const vec3<Real> center(Real(0.5) * (p0 + p1));
+            const vec3<Real> half(Real(0.5) * (p1 - p0));
+            h_edgeBounds.data[edgeCount] = vec_to_scalar4(center, sqrt(dot(half, half)));
+
             ++h_vertexConnectivity.data[edgeIter->first];
             ++h_vertexConnectivity.data[edgeIter->second];
             }
@@ -449,6 +488,37 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
         size_t faceSize = m_facesVec[shapeIdx].size();
         h_numTypeFaces.data[shapeIdx] = (unsigned int)faceSize;
         }
+
+    // build m_typeBoundRadius and m_faceBounds
+    for (size_t shapeIdx(0); shapeIdx < m_facesVec.size(); ++shapeIdx)
+        {
+        const vector<vec3<Real>>& points = m_shapes[shapeIdx];
+
+        Real radiusSq(0);
+        for (size_t vertIdx(0); vertIdx < points.size(); ++vertIdx)
+            radiusSq = max(radiusSq, dot(points[vertIdx], points[vertIdx]));
+        h_typeBoundRadius.data[shapeIdx] = sqrt(radiusSq);
+
+        // the bounding sphere of a face is centered on the mean of its vertices
+        for (size_t faceIdx(shapeIdx), vecIdx(0); vecIdx < m_facesVec[shapeIdx].size();
+             faceIdx = h_nextFace.data[faceIdx], ++vecIdx)
+            {
+            const vector<unsigned int>& face = m_facesVec[shapeIdx][vecIdx];
+
+            vec3<Real> center;
+            for (size_t vertIdx(0); vertIdx < face.size(); ++vertIdx)
+                center += points[face[vertIdx]];
+            center /= Real(face.size());
+
+            Real faceRadiusSq(0);
+            for (size_t vertIdx(0); vertIdx < face.size(); ++vertIdx)
+                {
+                const vec3<Real> delta(points[face[vertIdx]] - center);
+                faceRadiusSq = max(faceRadiusSq, dot(delta, delta));
+                }
+            h_faceBounds.data[faceIdx] = vec_to_scalar4(center, sqrt(faceRadiusSq));
+            }
+        }
     }
 
 /*!
@@ -664,6 +734,11 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                                                    access_location::host,
                                                    access_mode::read);
     ArrayHandle<unsigned int> h_edges(m_edges, access_location::host, access_mode::read);
+    ArrayHandle<Real4> h_faceBounds(m_faceBounds, access_location::host, access_mode::read);
+    ArrayHandle<Real4> h_edgeBounds(m_edgeBounds, access_location::host, access_mode::read);
+    ArrayHandle<Real> h_typeBoundRadius(m_typeBoundRadius,
+                                        access_location::host,
+                                        access_mode::read);
 
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
@@ -756,6 +831,14 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                 vec3<Real> torqueij, torqueji;
                 Real potentialij(0);
 
+                // features are culled in the body frame of the other particle, where their
+                // bounding spheres are stored
+                const quat<Real> quati_conj(conj(quat<Real>(quati)));
+                const quat<Real> quatj_conj(conj(quat<Real>(quatj)));
+                const Real rcut_feature(m_evaluator.getFeatureRcut());
+                const Real bound_i(h_typeBoundRadius.data[typei] + rcut_feature);
+                const Real bound_j(h_typeBoundRadius.data[typej] + rcut_feature);
+
                 // iterate over each vertex in particle i
                 for (size_t vertIndex(0); vertIndex < h_numTypeVerts.data[typei]; ++vertIndex)
                     {
@@ -763,24 +846,34 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                         rotate(quati,
                                vec3<Real>(h_verts.data[h_firstTypeVert.data[typei] + vertIndex])));
 
+                    // skip the vertex if it cannot reach particle j
+                    const vec3<Real> vertex0j(rotate(quatj_conj, vertex0 - dx));
+                    if (dot(vertex0j, vertex0j) > bound_j * bound_j)
+                        continue;
+
                     // iterate over each face in particle j
                     size_t faceIndex(typej);
                     if (h_numTypeFaces.data[typej] > 0)
                         {
                         do
                             {
-                            m_evaluator.vertexFace(dx,
-                                                   vertex0,
-                                                   quatj,
-                                                   h_verts.data,
-                                                   h_realVertIndex.data,
-                                                   h_nextFaceVert.data,
-                                                   h_firstFaceVert.data[faceIndex],
-                                                   potentialij,
-                                                   forceij,
-                                                   torqueij,
-                                                   forceji,
-                                                   torqueji);
+                            if (detail::withinBounds(vertex0j,
+                                                     h_faceBounds.data[faceIndex],
+                                                     rcut_feature))
+                                {
+                                m_evaluator.vertexFace(dx,
+                                                       vertex0,
+                                                       quatj,
+                                                       h_verts.data,
+                                                       h_realVertIndex.data,
+                                                       h_nextFaceVert.data,
+                                                       h_firstFaceVert.data[faceIndex],
+                                                       potentialij,
+                                                       forceij,
+                                                       torqueij,
+                                                       forceji,
+                                                       torqueji);
+                                }
                             faceIndex = h_nextFace.data[faceIndex];
                             } while (faceIndex != typej);
                         }
@@ -790,12 +883,14 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                         // iterate over all edges of j
                         for (size_t edgej(0); edgej < h_numTypeEdges.data[typej]; ++edgej)
                             {
-                            vec3<Real> p10(
-                                h_verts
-                                    .data[h_edges.data[2 * (edgej + h_firstTypeEdge.data[typej])]]);
-                            vec3<Real> p11(
-                                h_verts.data[h_edges.data[2 * (edgej + h_firstTypeEdge.data[typej])
-                                                          + 1]]);
+                            const size_t edgeIndex(edgej + h_firstTypeEdge.data[typej]);
+                            if (!detail::withinBounds(vertex0j,
+                                                      h_edgeBounds.data[edgeIndex],
+                                                      rcut_feature))
+                                continue;
+
+                            vec3<Real> p10(h_verts.data[h_edges.data[2 * edgeIndex]]);
+                            vec3<Real> p11(h_verts.data[h_edges.data[2 * edgeIndex + 1]]);
                             p10 = rotate(quatj, p10);
                             p11 = rotate(quatj, p11);
 
@@ -838,24 +933,34 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                         rotate(quatj,
                                vec3<Real>(h_verts.data[h_firstTypeVert.data[typej] + vertIndex])));
 
+                    // skip the vertex if it cannot reach particle i
+                    const vec3<Real> vertex0i(rotate(quati_conj, vertex0 + dx));
+                    if (dot(vertex0i, vertex0i) > bound_i * bound_i)
+                        continue;
+
                     // iterate over each face in particle i
                     size_t faceIndex(typei);
                     if (h_numTypeFaces.data[typei] > 0)
                         {
                         do
                             {
-                            m_evaluator.vertexFace(-dx,
-                                                   vertex0,
-                                                   quati,
-                                                   h_verts.data,
-                                                   h_realVertIndex.data,
-                                                   h_nextFaceVert.data,
-                                                   h_firstFaceVert.data[faceIndex],
-                                                   potentialij,
-                                                   forceji,
-                                                   torqueji,
-                                                   forceij,
-                                                   torqueij);
+                            if (detail::withinBounds(vertex0i,
+                                                     h_faceBounds.data[faceIndex],
+                                                     rcut_feature))
+                                {
+                                m_evaluator.vertexFace(-dx,
+                                                       vertex0,
+                                                       quati,
+                                                       h_verts.data,
+                                                       h_realVertIndex.data,
+                                                       h_nextFaceVert.data,
+                                                       h_firstFaceVert.data[faceIndex],
+                                                       potentialij,
+                                                       forceji,
+                                                       torqueji,
+                                                       forceij,
+                                                       torqueij);
+                                }
                             faceIndex = h_nextFace.data[faceIndex];
                             } while (faceIndex != typei);
                         }
@@ -865,12 +970,14 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                         // iterate over all edges of i
                         for (size_t edgei(0); edgei < h_numTypeEdges.data[typei]; ++edgei)
                             {
-                            vec3<Real> p10(
-                                h_verts
-                                    .data[h_edges.data[2 * (edgei + h_firstTypeEdge.data[typei])]]);
-                            vec3<Real> p11(
-                                h_verts.data[h_edges.data[2 * (edgei + h_firstTypeEdge.data[typei])
-                                                          + 1]]);
+                            const size_t edgeIndex(edgei + h_firstTypeEdge.data[typei]);
+                            if (!detail::withinBounds(vertex0i,
+                                                      h_edgeBounds.data[edgeIndex],
+                                                      rcut_feature))
+                                continue;
+
+                            vec3<Real> p10(h_verts.data[h_edges.data[2 * edgeIndex]]);
+                            vec3<Real> p11(h_verts.data[h_edges.data[2 * edgeIndex + 1]]);
                             p10 = rotate(quati, p10);
                             p11 = rotate(quati, p11);
 
@@ -893,21 +1000,29 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                 // iterate over all pairs of edges
                 for (size_t edgei(0); edgei < h_numTypeEdges.data[typei]; ++edgei)
                     {
-                    vec3<Real> p00(
-                        h_verts.data[h_edges.data[2 * (edgei + h_firstTypeEdge.data[typei])]]);
-                    vec3<Real> p01(
-                        h_verts.data[h_edges.data[2 * (edgei + h_firstTypeEdge.data[typei]) + 1]]);
+                    const size_t edgeIndexi(edgei + h_firstTypeEdge.data[typei]);
+                    vec3<Real> p00(h_verts.data[h_edges.data[2 * edgeIndexi]]);
+                    vec3<Real> p01(h_verts.data[h_edges.data[2 * edgeIndexi + 1]]);
                     p00 = rotate(quati, p00);
                     p01 = rotate(quati, p01);
 
+                    // skip the edge if it cannot reach particle j
+                    const Real edgeRadiusi(h_edgeBounds.data[edgeIndexi].w);
+                    const vec3<Real> centeri(rotate(quatj_conj, Real(0.5) * (p00 + p01) - dx));
+                    if (dot(centeri, centeri) > (bound_j + edgeRadiusi) * (bound_j + edgeRadiusi))
+                        continue;
+
                     // iterate over all edges of j
                     for (size_t edgej(0); edgej < h_numTypeEdges.data[typej]; ++edgej)
                         {
-                        vec3<Real> p10(
-                            h_verts.data[h_edges.data[2 * (edgej + h_firstTypeEdge.data[typej])]]);
-                        vec3<Real> p11(
-                            h_verts
-                                .data[h_edges.data[2 * (edgej + h_firstTypeEdge.data[typej]) + 1]]);
+                        const size_t edgeIndexj(edgej + h_firstTypeEdge.data[typej]);
+                        if (!detail::withinBounds(centeri,
+                                                  h_edgeBounds.data[edgeIndexj],
+                                                  rcut_feature + edgeRadiusi))
+                            continue;
+
+                        vec3<Real> p10(h_verts.data[h_edges.data[2 * edgeIndexj]]);
+                        vec3<Real> p11(h_verts.data[h_edges.data[2 * edgeIndexj + 1]]);
                         p10 = rotate(quatj, p10);
                         p11 = rotate(quatj, p11);
 
@@ -54,6 +54,9 @@ namespace dem
   - type index->number of edges in type
   - (2*edge index)->first real vertex index in edge, (2*edge index + 1)->second real vertex in edge
   - real vertex index->vertex (3D point)
+  - face index->bounding sphere of the face in the body frame
+  - edge index->bounding sphere of the edge in the body frame
+  - type index->radius of the bounding sphere of the shape
 
   Implementation details:
   - The first face of the type with type index i is stored at index i within the face->next face
@@ -61,6 +64,9 @@ namespace dem
   - Faces in a shape and vertices in a face use a circularly linked index structure
   - Vertices (3D points) are stored consecutively for a shape
   - Edges (pairs of vertex indices) are stored consecutively for a shape
+  - Vertex/face, vertex/edge, and edge/edge pairs are only evaluated when their bounding spheres
+  are within the feature cutoff of the potential, so that faceted shapes do not evaluate every pair
+  of features for every pair of particles
 
   \ingroup computes
 */
@@ -154,6 +160,9 @@ class DEM3DForceCompute : public ForceCompute
     GPUArray<Real> m_faceRcutSq;    //!< face index->rcut*rcut
     GPUArray<Real> m_edgeRcutSq;    //!< edge index->rcut*rcut
     GPUArray<Real4> m_verts;        //! Vertices for each real index
+    GPUArray<Real4> m_faceBounds;   //!< face index->bounding sphere center (xyz) and radius (w)
+    GPUArray<Real4> m_edgeBounds;   //!< edge index->bounding sphere center (xyz) and radius (w)
+    GPUArray<Real> m_typeBoundRadius;                               //!< type->bounding sphere radius
     std::vector<std::vector<vec3<Real>>> m_shapes;                  //!< Vertices for each type
     std::vector<std::vector<std::vector<unsigned int>>> m_facesVec; //!< Faces for each type
 
@@ -147,6 +147,13 @@ template<typename Real, typename Real4, typename Potential> class DEMEvaluator
         return m_potential.withinCutoff(rsq, r_cut_sq);
         }
 
+    /*! Largest distance between a pair of vertices, edges, or faces that interact
+     */
+    DEVICE inline Real getFeatureRcut() const
+        {
+        return m_potential.getFeatureRcut();
+        }
+
     DEVICE static bool needsDiameter()
         {
         return Potential::needsDiameter();
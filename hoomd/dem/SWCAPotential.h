@@ -85,6 +85,12 @@ template<typename Real, typename Real4, typename FrictionModel> class SWCAPotent
         return rmd * rmd < r_cut_sq;
         }
 
+    /*! Largest distance between two features that interact, for the current diameters */
+    DEVICE inline Real getFeatureRcut() const
+        {
+        return sqrt(m_rcutsq) + m_delta;
+        }
+
     //! Test if potential needs the diameter
     DEVICE static bool needsDiameter()
         {
@@ -96,6 +96,12 @@ template<typename Real, typename Real4, typename FrictionModel> class WCAPotenti
         return rsq < r_cutsq;
         }
 
+    /*! Largest distance between two features that interact */
+    DEVICE inline Real getFeatureRcut() const
+        {
+        return sqrt(m_rcutsq);
+        }
+
     /*! Test if potential needs the diameter (It doesn't) */
     DEVICE static bool needsDiameter()
         {
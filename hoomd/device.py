@@ -122,6 +122,81 @@ class Device:
         else:
             self._cpp_exec_conf.setNumThreads(int(num_cpu_threads))
 
+    @property
+    def jit_cache(self):
+        """str: Directory that stores compiled JIT code between runs.
+
+        Set `jit_cache` to the name of a directory (the default is `None`) to
+        store the LLVM bitcode of the C++ code compiled by
+        `hoomd.hpmc.pair.user`, `hoomd.hpmc.external.user`, and
+        `hoomd.md.pair.user`. Later runs with the same code, compiler
+        arguments, HOOMD-blue version, and LLVM version load the bitcode
+        instead of compiling the code again. Many jobs can
+        share one directory. Set `jit_cache` before adding the JIT compiled
+        objects to the simulation.
+
+        Note:
+            Only the CPU code is cached. GPU code is compiled at every run.
+        """
+        jit_cache_dir = self._cpp_exec_conf.getJITCacheDir()
+        return jit_cache_dir if jit_cache_dir != "" else None
+
+    @property
+    def memory_usage(self):
+        """dict[str, int]: Bytes allocated by each array on the local rank.
+
+        The keys have the form ``'Subsystem::m_array'``, where ``Subsystem``
+        names the class that owns the array, such as ``ParticleData``,
+        ``NeighborList``, ``CellList``, ``ForceCompute``, or
+        ``CommunicatorGPU``. Arrays of the same name in several objects, such
+        as the forces of different `hoomd.md.force.Force` objects, share one
+        entry. Arrays without a name are counted under the key ``''``.
+
+        The counts include the arrays of all simulations on the device and
+        exclude the temporary buffers in the GPU memory pool (see
+        `hoomd.device.GPU.memory_pool_statistics`).
+
+        Tip:
+            Use `hoomd.Simulation.memory_usage` to log the totals per
+            subsystem.
+        """
+        return self._cpp_exec_conf.getMemoryUsage()
+
+    @jit_cache.setter
+    def jit_cache(self, jit_cache_dir):
+        if jit_cache_dir is None:
+            jit_cache_dir = ""
+        self._cpp_exec_conf.setJITCacheDir(str(jit_cache_dir))
+
+    @property
+    def memory_placement(self):
+        """str: Placement of new host arrays on the NUMA nodes of the CPU \
+        threads.
+
+        Linux places each page of memory on the NUMA node of the thread that
+        first writes to it. With more than one CPU thread, all threads clear
+        large new host arrays, such as the particle data, neighbor lists, and
+        forces:
+
+        * ``'interleave'`` (the default): The threads clear the pages round
+          robin, spreading each array evenly over the NUMA nodes.
+        * ``'partition'``: Each thread clears the contiguous block of
+          particles that it processes in the parallel force and neighbor list
+          loops, which then split the particles statically in the same way.
+
+        Set `memory_placement` before creating the simulation state. Has no
+        effect in builds without TBB.
+        """
+        return self._cpp_exec_conf.getMemoryPlacement().name
+
+    @memory_placement.setter
+    def memory_placement(self, memory_placement):
+        placements = _hoomd.ExecutionConfiguration.MemoryPlacement.__members__
+        if memory_placement not in placements:
+            raise ValueError(f"memory_placement must be one of "
+                             f"{list(placements)}, got {memory_placement}.")
+        self._cpp_exec_conf.setMemoryPlacement(placements[memory_placement])
+
 
 def _create_messenger(mpi_config, notice_level, msg_file):
     msg = _hoomd.Messenger(mpi_config)
@@ -245,6 +320,45 @@ class GPU(Device):
     def gpu_error_checking(self, new_bool):
         self._cpp_exec_conf.setCUDAErrorChecking(new_bool)
 
+    @property
+    def tuning_cache(self):
+        """str: File that stores optimal autotuner parameters between runs.
+
+        Set `tuning_cache` to the name of a file (the default is `None`) to
+        skip most of the autotuning in jobs that simulate similar systems on the
+        same GPU model. The first complete parameter scan of each autotuner
+        stores the optimal parameter in the file. Later runs first sample the
+        stored parameter and scan all parameters only when its kernel time
+        exceeds the stored time by more than `tuning_drift_tolerance`.
+
+        Entries are keyed by the kernel, the GPU model, the number of particles
+        rounded down to a power of 2, the number density, and the largest
+        neighbor list cutoff. Many jobs can share one file. Set `tuning_cache`
+        before calling `hoomd.Simulation.run`.
+        """
+        filename = self._cpp_exec_conf.getAutotunerCache().filename
+        return filename if filename != "" else None
+
+    @tuning_cache.setter
+    def tuning_cache(self, filename):
+        if filename is None:
+            filename = ""
+        self._cpp_exec_conf.getAutotunerCache().filename = str(filename)
+
+    @property
+    def tuning_drift_tolerance(self):
+        """float: Relative increase in kernel time that triggers a new scan.
+
+        When the kernel time of a cached parameter exceeds the stored time by
+        more than this fraction (the default is 0.2), the autotuner scans all
+        parameters and stores the new optimum in `tuning_cache`.
+        """
+        return self._cpp_exec_conf.getAutotunerCache().drift_tolerance
+
+    @tuning_drift_tolerance.setter
+    def tuning_drift_tolerance(self, value):
+        self._cpp_exec_conf.getAutotunerCache().drift_tolerance = float(value)
+
     @property
     def compute_capability(self):
         """tuple(int, int): Compute capability of the device.
@@ -254,6 +368,65 @@ class GPU(Device):
         """
         return self._cpp_exec_conf.getComputeCapability(0)
 
+    @property
+    def memory_pool_statistics(self):
+        """dict: Statistics of the GPU memory pool.
+
+        Particle data and other persistent arrays, as well as temporary
+        buffers, take their memory from a pool. Blocks released by resized
+        arrays stay in the pool and are reused by later allocations of a
+        similar size, which avoids the cost of allocating GPU memory during
+        the simulation.
+
+        The dictionary has the keys:
+
+        * ``bytes_reserved`` - bytes the pool holds from the GPU.
+        * ``bytes_in_use`` - bytes in allocated arrays and buffers.
+        * ``peak_bytes_reserved`` - largest value of ``bytes_reserved``.
+        * ``peak_bytes_in_use`` - largest value of ``bytes_in_use``.
+        * ``num_allocations`` - number of blocks allocated from the GPU.
+        * ``num_cache_hits`` - number of allocations served from the pool.
+        """
+        return self._cpp_exec_conf.getMemoryPoolStatistics()
+
+    def release_memory_pool(self):
+        """Return the unused blocks in the memory pool to the GPU."""
+        self._cpp_exec_conf.releaseMemoryPool()
+
+    @property
+    def managed_memory_counting(self):
+        """bool: Whether to count managed memory page faults.
+
+        Set to `True` to count the page faults and page migrations of the
+        managed memory that HOOMD-blue uses when executing on multiple GPUs.
+        While counting, `hoomd.Simulation.run` reports the page faults per
+        step at notice level 2.
+
+        Counting requires a build of HOOMD-blue with ``ENABLE_CUPTI=on`` and
+        slows down the simulation.
+        """
+        return self._cpp_exec_conf.isManagedMemoryCountingEnabled()
+
+    @managed_memory_counting.setter
+    def managed_memory_counting(self, enable):
+        self._cpp_exec_conf.setManagedMemoryCounting(bool(enable))
+
+    @property
+    def managed_memory_counts(self):
+        """dict: Managed memory page faults since counting started.
+
+        The dictionary has the keys:
+
+        * ``gpu_page_faults`` - number of GPU page fault groups.
+        * ``cpu_page_faults`` - number of CPU page faults.
+        * ``bytes_htod`` - bytes migrated from the host to the GPUs.
+        * ``bytes_dtoh`` - bytes migrated from the GPUs to the host.
+        * ``bytes_dtod`` - bytes migrated between GPUs.
+
+        Requires `managed_memory_counting` to be `True`.
+        """
+        return self._cpp_exec_conf.getManagedMemoryCounts()
+
     @staticmethod
     def is_available():
         """Test if the GPU device is available.
@@ -2,7 +2,11 @@
 # find_package(ACML QUIET)
 
 option(ENABLE_HOST "CPU FFT support" ON)
-if (MKL_LIBRARIES AND MKL_INCLUDE_DIR)
+if (ENABLE_FFTW)
+    # FFTW3 (or MKL through its FFTW3 interface) is found by hoomd
+    set(LOCAL_FFT_LIB LOCAL_LIB_FFTW)
+    set(LOCAL_FFT_LIBRARIES FFTW::fftw3f)
+elseif (MKL_LIBRARIES AND MKL_INCLUDE_DIR)
     set(LOCAL_FFT_LIB LOCAL_LIB_MKL)
     set(LOCAL_FFT_LIBRARIES "${MKL_LIBRARIES}")
     include_directories(${MKL_INCLUDE_DIR})
@@ -15,6 +15,10 @@
 /* ACML, single precision */
 #include "acml_single_interface.h"
 
+#elif (LOCAL_FFT_LIB == LOCAL_LIB_FFTW)
+/* FFTW3 or the FFTW3 interface of MKL, single precision */
+#include "fftw_single_interface.h"
+
 #elif (LOCAL_FFT_LIB == LOCAL_LIB_BARE)
 /* fall back on bare FFT */
 #include "bare_fft_interface.h"
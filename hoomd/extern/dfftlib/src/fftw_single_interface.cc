@@ -0,0 +1,79 @@
+/* FFTW3 (single precision) backend for distributed FFT, implementation
+ */
+
+#include "fftw_single_interface.h"
+
+/* Initialize the library
+ */
+int dfft_init_local_fft()
+    {
+    return 0;
+    }
+
+/* De-initialize the library
+ */
+void dfft_teardown_local_fft()
+    {
+    }
+
+/* Create a FFTW plan
+ *
+ * sign = 0 (forward) or 1 (inverse)
+ */
+int dfft_create_1d_plan(
+    plan_t *plan,
+    int dim,
+    int howmany,
+    int istride,
+    int idist,
+    int ostride,
+    int odist,
+    int dir)
+    {
+    /* FFTW_ESTIMATE does not touch the arrays, but FFTW needs them to plan.
+     * dfft executes plans on arrays with arbitrary offsets, so plan for unaligned data */
+    size_t isize = (size_t)(howmany-1)*idist + (size_t)(dim-1)*istride + 1;
+    size_t osize = (size_t)(howmany-1)*odist + (size_t)(dim-1)*ostride + 1;
+    fftwf_complex *in = (fftwf_complex *) fftwf_malloc(sizeof(fftwf_complex)*isize);
+    fftwf_complex *out = (fftwf_complex *) fftwf_malloc(sizeof(fftwf_complex)*osize);
+
+    int n[1];
+    n[0] = dim;
+    *plan = fftwf_plan_many_dft(1, n, howmany,
+        in, NULL, istride, idist,
+        out, NULL, ostride, odist,
+        dir ? FFTW_BACKWARD : FFTW_FORWARD,
+        FFTW_ESTIMATE | FFTW_UNALIGNED);
+
+    fftwf_free(in);
+    fftwf_free(out);
+    return (*plan == NULL) ? 1 : 0;
+    }
+
+int dfft_allocate_aligned_memory(cpx_t **ptr, size_t size)
+    {
+    *ptr = (cpx_t *) fftwf_malloc(size);
+    return 0;
+    }
+
+void dfft_free_aligned_memory(cpx_t *ptr)
+    {
+    fftwf_free(ptr);
+    }
+
+/* Destroy a 1d plan */
+void dfft_destroy_1d_plan(plan_t *p)
+    {
+    fftwf_destroy_plan(*p);
+    }
+
+/* Excecute a local 1D FFT
+ */
+void dfft_local_1dfft(
+    cpx_t *in,
+    cpx_t *out,
+    plan_t p,
+    int dir)
+    {
+    fftwf_execute_dft(p, (fftwf_complex *) in, (fftwf_complex *) out);
+    }
@@ -2,6 +2,12 @@
 
 #include "../SystemDefinition.h"
 #include <memory>
+
+#ifdef ENABLE_HIP
+#include "../CachedAllocator.h"
+#include "ParticleFilterGPU.cuh"
+#endif
+
 #include <pybind11/pybind11.h>
 #include <vector>
 
@@ -28,6 +34,13 @@ namespace hoomd
     rank.
 
     The base class getSelectedTags() method returns an empty vector.
+
+    <b>GPU evaluation</b> Filters that return true from hasGPUSelection() also
+    implement selectGPU(), which flags the selected local particles in a device
+    array indexed by particle index. ParticleGroup compacts the flags into the
+    member list on the device, so that rebuilding a group does not copy the
+    particle data to the host. Filters without a GPU implementation (e.g.
+    custom filters written in Python) are evaluated with getSelectedTags().
 */
 class PYBIND11_EXPORT ParticleFilter
     {
@@ -44,6 +57,50 @@ class PYBIND11_EXPORT ParticleFilter
         {
         return std::vector<unsigned int>();
         }
+
+#ifdef ENABLE_HIP
+    /// Test if the filter implements selectGPU()
+    virtual bool hasGPUSelection() const
+        {
+        return false;
+        }
+
+    /** Flag the rank local particles that meet the selection criteria.
+     *  sysdef: system definition to select particles from
+     *  d_flags: device array with one element per local particle, set to 1
+     *  for selected particles and 0 otherwise
+     *
+     *  The base class selects no particles.
+     */
+    virtual void selectGPU(std::shared_ptr<SystemDefinition> sysdef, unsigned int* d_flags) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        kernel::gpu_filter_fill(pdata->getN(), d_flags, 0);
+        }
+
+    protected:
+    /** Flag the particles in a combination of two filters.
+     *  f: first filter
+     *  g: second filter
+     *  op: operation that combines the selections
+     */
+    static void selectCombinedGPU(const ParticleFilter& f,
+                                  const ParticleFilter& g,
+                                  std::shared_ptr<SystemDefinition> sysdef,
+                                  unsigned int* d_flags,
+                                  kernel::filter_combine_op op)
+        {
+        const auto pdata = sysdef->getParticleData();
+        const auto exec_conf = pdata->getExecConf();
+        f.selectGPU(sysdef, d_flags);
+
+        ScopedAllocation<unsigned int> d_flags_g(exec_conf->getCachedAllocator(), pdata->getN());
+        g.selectGPU(sysdef, d_flags_g.data);
+        kernel::gpu_filter_combine(pdata->getN(), d_flags, d_flags_g.data, op);
+        if (exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+#endif
     };
 
     } // end namespace hoomd
@@ -35,6 +35,23 @@ class PYBIND11_EXPORT ParticleFilterAll : public ParticleFilter
         std::copy_n(h_tag.data, N, member_tags.begin());
         return member_tags;
         }
+
+#ifdef ENABLE_HIP
+    /// Test if the filter implements selectGPU()
+    virtual bool hasGPUSelection() const
+        {
+        return true;
+        }
+
+    /// Flag all local particles
+    virtual void selectGPU(std::shared_ptr<SystemDefinition> sysdef, unsigned int* d_flags) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        kernel::gpu_filter_fill(pdata->getN(), d_flags, 1);
+        if (pdata->getExecConf()->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+#endif
     };
 
     } // end namespace hoomd
@@ -0,0 +1,299 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ParticleFilterGPU.cu
+    \brief Defines the GPU functions that evaluate the built-in particle filters
+*/
+
+#include "ParticleFilterGPU.cuh"
+#include "hoomd/ParticleData.cuh"
+
+namespace hoomd
+    {
+namespace kernel
+    {
+//! Block size of the filter kernels
+const unsigned int filter_block_size = 256;
+
+//! Set all flags to a value
+__global__ void gpu_filter_fill_kernel(const unsigned int N,
+                                       unsigned int* d_flags,
+                                       const unsigned int value)
+    {
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    d_flags[idx] = value;
+    }
+
+//! Select the particles with the given types
+__global__ void gpu_filter_type_kernel(const unsigned int N,
+                                       const Scalar4* d_postype,
+                                       const unsigned int* d_type_selected,
+                                       const unsigned int n_types,
+                                       unsigned int* d_flags)
+    {
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    const unsigned int type = __scalar_as_int(d_postype[idx].w);
+    d_flags[idx] = type < n_types ? d_type_selected[type] : 0;
+    }
+
+//! Select the local particles with the given tags
+/*! One thread per selected tag.
+ */
+__global__ void gpu_filter_tags_kernel(const unsigned int N,
+                                       const unsigned int n_tags,
+                                       const unsigned int* d_tags,
+                                       const unsigned int* d_rtag,
+                                       const size_t n_rtags,
+                                       unsigned int* d_flags)
+    {
+    const unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= n_tags)
+        return;
+
+    const unsigned int tag = d_tags[i];
+    if (tag >= n_rtags)
+        return;
+
+    const unsigned int idx = d_rtag[tag];
+    if (idx < N)
+        d_flags[idx] = 1;
+    }
+
+//! Select the particles by rigid body membership
+__global__ void gpu_filter_body_kernel(const unsigned int N,
+                                       const unsigned int* d_tag,
+                                       const unsigned int* d_body,
+                                       const unsigned int body_classes,
+                                       unsigned int* d_flags)
+    {
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    const unsigned int body = d_body[idx];
+    unsigned int body_class;
+    if (body == NO_BODY)
+        body_class = filter_body_free;
+    else if (body >= MIN_FLOPPY)
+        body_class = filter_body_floppy;
+    else if (body == d_tag[idx])
+        body_class = filter_body_center;
+    else
+        body_class = filter_body_constituent;
+
+    d_flags[idx] = (body_classes & body_class) ? 1 : 0;
+    }
+
+//! Select the particles in a cuboid
+/*! The cuboid includes the lower bound and excludes the upper bound, matching
+    ParticleFilterCuboid::getSelectedTags().
+*/
+__global__ void gpu_filter_cuboid_kernel(const unsigned int N,
+                                         const Scalar4* d_postype,
+                                         const Scalar3 min,
+                                         const Scalar3 max,
+                                         unsigned int* d_flags)
+    {
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    const Scalar4 postype = d_postype[idx];
+    d_flags[idx] = (min.x <= postype.x && postype.x < max.x && min.y <= postype.y
+                    && postype.y < max.y && min.z <= postype.z && postype.z < max.z)
+                       ? 1
+                       : 0;
+    }
+
+//! Combine two selections in place
+__global__ void gpu_filter_combine_kernel(const unsigned int N,
+                                          unsigned int* d_flags,
+                                          const unsigned int* d_flags_g,
+                                          const filter_combine_op op)
+    {
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    const unsigned int f = d_flags[idx];
+    const unsigned int g = d_flags_g[idx];
+    if (op == filter_union)
+        d_flags[idx] = f | g;
+    else if (op == filter_intersection)
+        d_flags[idx] = f & g;
+    else
+        d_flags[idx] = f & !g;
+    }
+
+/*! \param N Number of local particles
+    \param d_flags Selection flags (output)
+    \param value Value to set
+*/
+hipError_t gpu_filter_fill(const unsigned int N, unsigned int* d_flags, const unsigned int value)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    hipLaunchKernelGGL(gpu_filter_fill_kernel,
+                       dim3(N / filter_block_size + 1),
+                       dim3(filter_block_size),
+                       0,
+                       0,
+                       N,
+                       d_flags,
+                       value);
+    return hipSuccess;
+    }
+
+/*! \param N Number of local particles
+    \param d_postype Particle positions and types
+    \param d_type_selected 1 for each selected type, 0 otherwise
+    \param n_types Number of types
+    \param d_flags Selection flags (output)
+*/
+hipError_t gpu_filter_type(const unsigned int N,
+                           const Scalar4* d_postype,
+                           const unsigned int* d_type_selected,
+                           const unsigned int n_types,
+                           unsigned int* d_flags)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    hipLaunchKernelGGL(gpu_filter_type_kernel,
+                       dim3(N / filter_block_size + 1),
+                       dim3(filter_block_size),
+                       0,
+                       0,
+                       N,
+                       d_postype,
+                       d_type_selected,
+                       n_types,
+                       d_flags);
+    return hipSuccess;
+    }
+
+/*! \param N Number of local particles
+    \param n_tags Number of selected tags
+    \param d_tags Selected tags
+    \param d_rtag Reverse lookup table from tag to local index
+    \param n_rtags Number of elements in \a d_rtag
+    \param d_flags Selection flags (output)
+*/
+hipError_t gpu_filter_tags(const unsigned int N,
+                           const unsigned int n_tags,
+                           const unsigned int* d_tags,
+                           const unsigned int* d_rtag,
+                           const size_t n_rtags,
+                           unsigned int* d_flags)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    hipMemsetAsync(d_flags, 0, sizeof(unsigned int) * N);
+    if (n_tags == 0)
+        return hipSuccess;
+
+    hipLaunchKernelGGL(gpu_filter_tags_kernel,
+                       dim3(n_tags / filter_block_size + 1),
+                       dim3(filter_block_size),
+                       0,
+                       0,
+                       N,
+                       n_tags,
+                       d_tags,
+                       d_rtag,
+                       n_rtags,
+                       d_flags);
+    return hipSuccess;
+    }
+
+/*! \param N Number of local particles
+    \param d_tag Particle tags
+    \param d_body Particle body ids
+    \param body_classes Bitwise or of the filter_body_class values to select
+    \param d_flags Selection flags (output)
+*/
+hipError_t gpu_filter_body(const unsigned int N,
+                           const unsigned int* d_tag,
+                           const unsigned int* d_body,
+                           const unsigned int body_classes,
+                           unsigned int* d_flags)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    hipLaunchKernelGGL(gpu_filter_body_kernel,
+                       dim3(N / filter_block_size + 1),
+                       dim3(filter_block_size),
+                       0,
+                       0,
+                       N,
+                       d_tag,
+                       d_body,
+                       body_classes,
+                       d_flags);
+    return hipSuccess;
+    }
+
+/*! \param N Number of local particles
+    \param d_postype Particle positions and types
+    \param min Lower corner of the cuboid (inclusive)
+    \param max Upper corner of the cuboid (exclusive)
+    \param d_flags Selection flags (output)
+*/
+hipError_t gpu_filter_cuboid(const unsigned int N,
+                             const Scalar4* d_postype,
+                             const Scalar3 min,
+                             const Scalar3 max,
+                             unsigned int* d_flags)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    hipLaunchKernelGGL(gpu_filter_cuboid_kernel,
+                       dim3(N / filter_block_size + 1),
+                       dim3(filter_block_size),
+                       0,
+                       0,
+                       N,
+                       d_postype,
+                       min,
+                       max,
+                       d_flags);
+    return hipSuccess;
+    }
+
+/*! \param N Number of local particles
+    \param d_flags Selection flags of the first filter, replaced by the combined flags
+    \param d_flags_g Selection flags of the second filter
+    \param op Operation that combines the selections
+*/
+hipError_t gpu_filter_combine(const unsigned int N,
+                              unsigned int* d_flags,
+                              const unsigned int* d_flags_g,
+                              const filter_combine_op op)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    hipLaunchKernelGGL(gpu_filter_combine_kernel,
+                       dim3(N / filter_block_size + 1),
+                       dim3(filter_block_size),
+                       0,
+                       0,
+                       N,
+                       d_flags,
+                       d_flags_g,
+                       op);
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace hoomd
@@ -0,0 +1,76 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ParticleFilterGPU.cuh
+    \brief Declares the GPU functions that evaluate the built-in particle filters
+*/
+
+#pragma once
+
+#include "hoomd/HOOMDMath.h"
+
+#include <hip/hip_runtime.h>
+
+namespace hoomd
+    {
+namespace kernel
+    {
+//! Rigid body membership classes selected by gpu_filter_body
+/*! Every particle belongs to exactly one class.
+ */
+enum filter_body_class
+    {
+    filter_body_center = 1,      //!< Central particle of a rigid body (body == tag)
+    filter_body_constituent = 2, //!< Constituent particle of a rigid body
+    filter_body_free = 4,        //!< Particle not in a body (body == NO_BODY)
+    filter_body_floppy = 8       //!< Particle in a floppy body
+    };
+
+//! Operations that combine two selections in gpu_filter_combine
+enum filter_combine_op
+    {
+    filter_union,
+    filter_intersection,
+    filter_set_difference
+    };
+
+//! Set the selection flags of all local particles to the same value
+hipError_t gpu_filter_fill(const unsigned int N, unsigned int* d_flags, const unsigned int value);
+
+//! Select the particles with the given types
+hipError_t gpu_filter_type(const unsigned int N,
+                           const Scalar4* d_postype,
+                           const unsigned int* d_type_selected,
+                           const unsigned int n_types,
+                           unsigned int* d_flags);
+
+//! Select the local particles with the given tags
+hipError_t gpu_filter_tags(const unsigned int N,
+                           const unsigned int n_tags,
+                           const unsigned int* d_tags,
+                           const unsigned int* d_rtag,
+                           const size_t n_rtags,
+                           unsigned int* d_flags);
+
+//! Select the particles by rigid body membership
+hipError_t gpu_filter_body(const unsigned int N,
+                           const unsigned int* d_tag,
+                           const unsigned int* d_body,
+                           const unsigned int body_classes,
+                           unsigned int* d_flags);
+
+//! Select the particles in a cuboid
+hipError_t gpu_filter_cuboid(const unsigned int N,
+                             const Scalar4* d_postype,
+                             const Scalar3 min,
+                             const Scalar3 max,
+                             unsigned int* d_flags);
+
+//! Combine two selections in place
+hipError_t gpu_filter_combine(const unsigned int N,
+                              unsigned int* d_flags,
+                              const unsigned int* d_flags_g,
+                              const filter_combine_op op);
+
+    } // end namespace kernel
+    } // end namespace hoomd
@@ -24,6 +24,23 @@ class PYBIND11_EXPORT ParticleFilterNull : public ParticleFilter
         std::vector<unsigned int> member_tags;
         return member_tags;
         }
+
+#ifdef ENABLE_HIP
+    /// Test if the filter implements selectGPU()
+    virtual bool hasGPUSelection() const
+        {
+        return true;
+        }
+
+    /// Flag no particles
+    virtual void selectGPU(std::shared_ptr<SystemDefinition> sysdef, unsigned int* d_flags) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        kernel::gpu_filter_fill(pdata->getN(), d_flags, 0);
+        if (pdata->getExecConf()->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+#endif
     };
 
     } // end namespace hoomd
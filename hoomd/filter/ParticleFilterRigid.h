@@ -114,6 +114,35 @@ class PYBIND11_EXPORT ParticleFilterRigid : public ParticleFilter
         return member_tags;
         }
 
+#ifdef ENABLE_HIP
+    /// Test if the filter implements selectGPU()
+    virtual bool hasGPUSelection() const
+        {
+        return true;
+        }
+
+    /// Flag the local particles in the selected rigid body classes
+    virtual void selectGPU(std::shared_ptr<SystemDefinition> sysdef, unsigned int* d_flags) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        const ArrayHandle<unsigned int> d_tag(pdata->getTags(),
+                                              access_location::device,
+                                              access_mode::read);
+        const ArrayHandle<unsigned int> d_body(pdata->getBodies(),
+                                               access_location::device,
+                                               access_mode::read);
+
+        // RigidBodySelection uses the same bits as kernel::filter_body_class
+        kernel::gpu_filter_body(pdata->getN(),
+                                d_tag.data,
+                                d_body.data,
+                                static_cast<unsigned int>(m_current_selection),
+                                d_flags);
+        if (pdata->getExecConf()->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+#endif
+
     private:
     /// Current selection of particles to chose from rigid body center, constituent particles,
     /// and free bodies.
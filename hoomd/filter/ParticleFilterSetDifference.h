@@ -48,6 +48,20 @@ class PYBIND11_EXPORT ParticleFilterSetDifference : public ParticleFilter
         return tags;
         }
 
+#ifdef ENABLE_HIP
+    /// Test if the filter implements selectGPU()
+    virtual bool hasGPUSelection() const
+        {
+        return m_f->hasGPUSelection() && m_g->hasGPUSelection();
+        }
+
+    /// Flag the local particles in m_f but not in m_g
+    virtual void selectGPU(std::shared_ptr<SystemDefinition> sysdef, unsigned int* d_flags) const
+        {
+        selectCombinedGPU(*m_f, *m_g, sysdef, d_flags, kernel::filter_set_difference);
+        }
+#endif
+
     protected:
     std::shared_ptr<ParticleFilter> m_f;
     std::shared_ptr<ParticleFilter> m_g;
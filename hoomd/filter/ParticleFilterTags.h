@@ -40,6 +40,40 @@ class PYBIND11_EXPORT ParticleFilterTags : public ParticleFilter
         return m_tags;
         }
 
+#ifdef ENABLE_HIP
+    /// Test if the filter implements selectGPU()
+    virtual bool hasGPUSelection() const
+        {
+        return true;
+        }
+
+    /// Flag the local particles with tags in m_tags
+    virtual void selectGPU(std::shared_ptr<SystemDefinition> sysdef, unsigned int* d_flags) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        const auto exec_conf = pdata->getExecConf();
+        const unsigned int n_tags = (unsigned int)m_tags.size();
+
+        ScopedAllocation<unsigned int> d_tags(exec_conf->getCachedAllocator(), n_tags);
+        hipMemcpy(d_tags.data,
+                  m_tags.data(),
+                  sizeof(unsigned int) * n_tags,
+                  hipMemcpyHostToDevice);
+
+        const ArrayHandle<unsigned int> d_rtag(pdata->getRTags(),
+                                               access_location::device,
+                                               access_mode::read);
+        kernel::gpu_filter_tags(pdata->getN(),
+                                n_tags,
+                                d_tags.data,
+                                d_rtag.data,
+                                pdata->getRTags().size(),
+                                d_flags);
+        if (exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+#endif
+
     protected:
     std::vector<unsigned int> m_tags; //< Tags to use for filter
     };
@@ -66,6 +66,46 @@ class PYBIND11_EXPORT ParticleFilterType : public ParticleFilter
         return member_tags;
         }
 
+#ifdef ENABLE_HIP
+    /// Test if the filter implements selectGPU()
+    virtual bool hasGPUSelection() const
+        {
+        return true;
+        }
+
+    /// Flag the local particles of the types in m_types
+    virtual void selectGPU(std::shared_ptr<SystemDefinition> sysdef, unsigned int* d_flags) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        const auto exec_conf = pdata->getExecConf();
+
+        // flag the selected types
+        const unsigned int n_types = pdata->getNTypes();
+        std::vector<unsigned int> type_selected(n_types, 0);
+        for (auto type_str : m_types)
+            {
+            type_selected[pdata->getTypeByName(type_str)] = 1;
+            }
+
+        ScopedAllocation<unsigned int> d_type_selected(exec_conf->getCachedAllocator(), n_types);
+        hipMemcpy(d_type_selected.data,
+                  type_selected.data(),
+                  sizeof(unsigned int) * n_types,
+                  hipMemcpyHostToDevice);
+
+        const ArrayHandle<Scalar4> d_postype(pdata->getPositions(),
+                                             access_location::device,
+                                             access_mode::read);
+        kernel::gpu_filter_type(pdata->getN(),
+                                d_postype.data,
+                                d_type_selected.data,
+                                n_types,
+                                d_flags);
+        if (exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+#endif
+
     protected:
     std::unordered_set<std::string> m_types; ///< Set of types to select
     };
@@ -45,6 +45,20 @@ class PYBIND11_EXPORT ParticleFilterUnion : public ParticleFilter
         return tags;
         }
 
+#ifdef ENABLE_HIP
+    /// Test if the filter implements selectGPU()
+    virtual bool hasGPUSelection() const
+        {
+        return m_f->hasGPUSelection() && m_g->hasGPUSelection();
+        }
+
+    /// Flag the local particles in either m_f or m_g
+    virtual void selectGPU(std::shared_ptr<SystemDefinition> sysdef, unsigned int* d_flags) const
+        {
+        selectCombinedGPU(*m_f, *m_g, sysdef, d_flags, kernel::filter_union);
+        }
+#endif
+
     protected:
     std::shared_ptr<ParticleFilter> m_f;
     std::shared_ptr<ParticleFilter> m_g;
@@ -1,4 +1,5 @@
 #include "ClangCompiler.h"
+#include "hoomd/HOOMDVersion.h"
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
@@ -14,17 +15,25 @@
 #include <clang/Lex/HeaderSearch.h>
 #include <clang/Lex/PreprocessorOptions.h>
 #include <clang/Tooling/Tooling.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/InitializePasses.h>
 #include <llvm/PassRegistry.h>
+#include <llvm/Support/FileSystem.h>
 #include <llvm/Support/Host.h>
 #include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/Process.h>
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/raw_os_ostream.h>
+#include <llvm/Support/xxhash.h>
 
 #pragma GCC diagnostic pop
 
+#include <cstdio>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
 
@@ -69,14 +78,28 @@ ClangCompiler::ClangCompiler()
 
 /** @param code The C++ code to compile.
     @param user_args The arguments to pass to the compiler.
+    @param cache_dir Directory that caches compiled modules. Set to an empty string to always
+           compile the code.
 
     @returns The LLVM module with the code compiled.
 */
 std::unique_ptr<llvm::Module> ClangCompiler::compileCode(const std::string& code,
                                                          const std::vector<std::string>& user_args,
                                                          llvm::LLVMContext& context,
-                                                         std::ostringstream& out)
+                                                         std::ostringstream& out,
+                                                         const std::string& cache_dir)
     {
+    std::string cache_filename;
+    if (!cache_dir.empty())
+        {
+        cache_filename = getCacheFilename(code, user_args, cache_dir);
+        std::unique_ptr<llvm::Module> module = loadCachedModule(cache_filename, context, out);
+        if (module)
+            {
+            return module;
+            }
+        }
+
     // initialize the diagnostics engine to write compilation warnings/errors to stdout/stderr
     clang::IntrusiveRefCntPtr<clang::DiagnosticOptions> diagnostic_options
         = new clang::DiagnosticOptions();
@@ -207,8 +230,116 @@ std::unique_ptr<llvm::Module> ClangCompiler::compileCode(const std::string& code
     //     passBuilder.buildPerModuleDefaultPipeline(llvm::PassBuilder::OptimizationLevel::O3);
     //     modulePassManager.run(*module, moduleAnalysisManager);
 
+    if (!cache_filename.empty())
+        {
+        storeCachedModule(*module, cache_filename, out);
+        }
+
     return module;
     }
 
+/** @param code The C++ code to compile.
+    @param user_args The arguments to pass to the compiler.
+    @param cache_dir Directory that caches compiled modules.
+
+    The code includes HOOMD headers, so the versions of HOOMD and LLVM are part of the hash along
+    with the code, the arguments, and the target.
+
+    @returns The name of the file that holds the bitcode of this module.
+*/
+std::string ClangCompiler::getCacheFilename(const std::string& code,
+                                            const std::vector<std::string>& user_args,
+                                            const std::string& cache_dir)
+    {
+    std::string key = std::string(HOOMD_VERSION) + '\0' + CLANG_VERSION_STRING + '\0'
+                      + llvm::sys::getDefaultTargetTriple() + '\0' + code;
+    for (auto& arg : user_args)
+        {
+        key += '\0' + arg;
+        }
+
+    std::ostringstream filename;
+    filename << cache_dir << "/hoomd-jit-" << std::hex << std::setw(16) << std::setfill('0')
+             << llvm::xxHash64(key) << ".bc";
+    return filename.str();
+    }
+
+/** @param filename Name of the cache file.
+    @param context LLVM context to load the module into.
+    @param out Stream for diagnostic messages.
+
+    @returns The cached module or nullptr if there is no valid cache file.
+*/
+std::unique_ptr<llvm::Module> ClangCompiler::loadCachedModule(const std::string& filename,
+                                                              llvm::LLVMContext& context,
+                                                              std::ostringstream& out)
+    {
+    auto buffer = llvm::MemoryBuffer::getFile(filename);
+    if (!buffer)
+        {
+        return nullptr;
+        }
+
+    auto module = llvm::parseBitcodeFile((*buffer)->getMemBufferRef(), context);
+    if (!module)
+        {
+        // fall back to compiling the code when the file is unreadable
+        out << "Ignoring invalid JIT cache file " << filename << ": "
+            << llvm::toString(module.takeError()) << std::endl;
+        return nullptr;
+        }
+
+    out << "Loaded JIT module from " << filename << std::endl;
+    return std::move(*module);
+    }
+
+/** @param module Module to store.
+    @param filename Name of the cache file.
+    @param out Stream for diagnostic messages.
+
+    Failing to write the cache is not an error, the code is compiled again next time.
+*/
+void ClangCompiler::storeCachedModule(const llvm::Module& module,
+                                      const std::string& filename,
+                                      std::ostringstream& out)
+    {
+    auto parent = llvm::sys::path::parent_path(filename);
+    if (std::error_code ec = llvm::sys::fs::create_directories(parent))
+        {
+        out << "Could not create JIT cache directory " << parent.str() << ": " << ec.message()
+            << std::endl;
+        return;
+        }
+
+    // write to a file unique to this process and rename it into place
+    std::string tmp_filename
+        = filename + ".tmp" + std::to_string(llvm::sys::Process::getProcessId());
+        {
+        std::error_code ec;
+        llvm::raw_fd_ostream stream(tmp_filename, ec, llvm::sys::fs::OF_None);
+        if (ec)
+            {
+            out << "Could not write JIT cache file " << tmp_filename << ": " << ec.message()
+                << std::endl;
+            return;
+            }
+        llvm::WriteBitcodeToFile(module, stream);
+        stream.close();
+        if (stream.has_error())
+            {
+            stream.clear_error();
+            std::remove(tmp_filename.c_str());
+            out << "Could not write JIT cache file " << tmp_filename << std::endl;
+            return;
+            }
+        }
+
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+        {
+        std::remove(tmp_filename.c_str());
+        out << "Could not write JIT cache file " << filename << std::endl;
+        }
+    }
+
     } // end namespace hpmc
     } // end namespace hoomd
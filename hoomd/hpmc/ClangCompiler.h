@@ -24,6 +24,12 @@ namespace hpmc
 
     There are several one time LLVM initialization functions. This class uses the singleton pattern
     to call these only once.
+
+    Parsing the code and the HOOMD headers it includes takes most of the compile time. When given a
+    cache directory, compileCode() stores the LLVM bitcode of each module in a file named after a
+    hash of the code, the compiler arguments, and the HOOMD and LLVM versions. Later calls with the
+    same inputs load the bitcode instead of running clang. New files are written to a temporary name
+    and renamed into place, so many processes may share one directory.
 */
 class ClangCompiler
     {
@@ -41,11 +47,27 @@ class ClangCompiler
     std::unique_ptr<llvm::Module> compileCode(const std::string& code,
                                               const std::vector<std::string>& user_args,
                                               llvm::LLVMContext& context,
-                                              std::ostringstream& out);
+                                              std::ostringstream& out,
+                                              const std::string& cache_dir = "");
 
     protected:
     ClangCompiler();
 
+    /// Get the name of the cache file for the given code and arguments
+    std::string getCacheFilename(const std::string& code,
+                                 const std::vector<std::string>& user_args,
+                                 const std::string& cache_dir);
+
+    /// Load a module from the cache, returns nullptr when it is not present
+    std::unique_ptr<llvm::Module> loadCachedModule(const std::string& filename,
+                                                   llvm::LLVMContext& context,
+                                                   std::ostringstream& out);
+
+    /// Store a module in the cache
+    void storeCachedModule(const llvm::Module& module,
+                           const std::string& filename,
+                           std::ostringstream& out);
+
     static std::shared_ptr<ClangCompiler> m_clang_compiler;
     };
 
@@ -12,6 +12,12 @@
 #include "IntegratorHPMCMono.h"
 #include "hoomd/RNGIdentifiers.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 /*! \file ComputeFreeVolume.h
     \brief Defines the template class for an approximate free volume integration
     \note This header cannot be compiled by nvcc
@@ -28,7 +34,16 @@ namespace hoomd
 namespace hpmc
     {
 //! Template class for a free volume integration analyzer
-/*!
+/*! ComputeFreeVolume places test particles at random positions and orientations and counts the
+    ones that overlap a particle. The test particles are checked in parallel with TBB.
+
+    With persistent samples enabled, the test particles are kept between calls. When only some of
+    the particles have moved since the last call, only the test particles whose AABBs overlap the
+    old or new AABB of a moved particle are checked again. All samples are regenerated when the
+    box, the number of particles, the shape parameters, the interaction matrix, the number of
+    samples, or the test particle type change. Persistent samples are not used with domain
+    decomposition or on the GPU.
+
     \ingroup hpmc_integrators
 */
 template<class Shape> class ComputeFreeVolume : public Compute
@@ -69,6 +84,20 @@ template<class Shape> class ComputeFreeVolume : public Compute
         m_type = type_int;
         }
 
+    //! Get whether the samples are kept between calls
+    bool getPersistentSamples()
+        {
+        return m_persistent_samples;
+        }
+
+    //! Set whether the samples are kept between calls
+    //! \param persistent_samples true to keep the samples between calls
+    void setPersistentSamples(bool persistent_samples)
+        {
+        m_persistent_samples = persistent_samples;
+        m_samples_valid = false;
+        }
+
     //! Analyze the current configuration
     virtual void compute(uint64_t timestep);
 
@@ -84,6 +113,20 @@ template<class Shape> class ComputeFreeVolume : public Compute
 
     GPUArray<unsigned int> m_n_overlap_all; //!< Number of overlap volume particles in box
 
+    bool m_persistent_samples; //!< True when the samples are kept between calls
+    bool m_samples_valid;      //!< True when the stored samples may be updated incrementally
+
+    std::vector<vec3<Scalar>> m_sample_pos;         //!< Positions of the samples
+    std::vector<quat<Scalar>> m_sample_orientation; //!< Orientations of the samples
+    std::vector<unsigned int> m_sample_overlap;     //!< 1 when the sample overlaps a particle
+
+    std::vector<Scalar4> m_last_postype;     //!< Particle positions at the last call, by tag
+    std::vector<Scalar4> m_last_orientation; //!< Particle orientations at the last call, by tag
+    unsigned int m_last_N;                   //!< Number of particles at the last call
+    BoxDim m_last_box;                       //!< Box at the last call
+    unsigned int m_last_type;                //!< Test particle type at the last call
+    uint64_t m_last_param_version;           //!< Integrator parameter version at the last call
+
     //! Return an estimate of the overlap volume
     virtual void computeFreeVolume(uint64_t timestep);
     };
@@ -92,7 +135,8 @@ template<class Shape>
 ComputeFreeVolume<Shape>::ComputeFreeVolume(std::shared_ptr<SystemDefinition> sysdef,
                                             std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
                                             std::shared_ptr<CellList> cl)
-    : Compute(sysdef), m_mc(mc), m_cl(cl), m_type(0), m_n_sample(0)
+    : Compute(sysdef), m_mc(mc), m_cl(cl), m_type(0), m_n_sample(0), m_persistent_samples(false),
+      m_samples_valid(false), m_last_N(0), m_last_type(0), m_last_param_version(0)
     {
     this->m_exec_conf->msg->notice(5) << "Constructing ComputeFreeVolume" << std::endl;
 
@@ -123,7 +167,6 @@ template<class Shape> void ComputeFreeVolume<Shape>::compute(uint64_t timestep)
 template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t timestep)
     {
     unsigned int overlap_count = 0;
-    unsigned int err_count = 0;
     unsigned int ndim = this->m_sysdef->getNDimensions();
 
     this->m_exec_conf->msg->notice(5) << "HPMC computing free volume " << timestep << std::endl;
@@ -149,6 +192,9 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
         ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
                                            access_location::host,
                                            access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
         const BoxDim& box = m_pdata->getBox();
 
         // access parameters and interaction matrix
@@ -168,27 +214,125 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
         n_sample /= this->m_exec_conf->getNRanks();
 #endif
 
-        for (unsigned int i = 0; i < n_sample; i++)
+        // check whether the stored samples can be updated incrementally
+        bool persistent = m_persistent_samples && !m_sysdef->isDomainDecomposed();
+        unsigned int n_tags = m_pdata->getMaximumTag() + 1;
+        bool incremental = persistent && m_samples_valid && m_sample_pos.size() == n_sample
+                           && m_last_N == m_pdata->getN() && m_last_postype.size() == n_tags
+                           && m_last_type == m_type
+                           && m_last_param_version == m_mc->getParamVersion() && m_last_box == box;
+
+        // the samples to check in this call
+        std::vector<unsigned int> test_samples;
+
+        if (incremental)
             {
-            // select a random particle coordinate in the box
-            hoomd::RandomGenerator rng_i(
-                hoomd::Seed(hoomd::RNGIdentifier::ComputeFreeVolume, timestep, seed),
-                hoomd::Counter(m_exec_conf->getRank(), i));
+            // collect the old and new AABBs of the particles that moved
+            std::vector<hoomd::detail::AABB> moved_aabbs;
+            for (unsigned int j = 0; j < m_pdata->getN(); j++)
+                {
+                unsigned int tag = h_tag.data[j];
+                Scalar4 postype_old = m_last_postype[tag];
+                Scalar4 orientation_old = m_last_orientation[tag];
+                Scalar4 postype_new = h_postype.data[j];
+                Scalar4 orientation_new = h_orientation.data[j];
+                if (postype_old.x == postype_new.x && postype_old.y == postype_new.y
+                    && postype_old.z == postype_new.z && postype_old.w == postype_new.w
+                    && orientation_old.x == orientation_new.x
+                    && orientation_old.y == orientation_new.y
+                    && orientation_old.z == orientation_new.z
+                    && orientation_old.w == orientation_new.w)
+                    continue;
+
+                Shape shape_old(quat<Scalar>(orientation_old),
+                                params[__scalar_as_int(postype_old.w)]);
+                Shape shape_new(quat<Scalar>(orientation_new),
+                                params[__scalar_as_int(postype_new.w)]);
+                moved_aabbs.push_back(shape_old.getAABB(vec3<Scalar>(postype_old)));
+                moved_aabbs.push_back(shape_new.getAABB(vec3<Scalar>(postype_new)));
+                }
 
-            Scalar xrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
-            Scalar yrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
-            Scalar zrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
+            if (moved_aabbs.size())
+                {
+                hoomd::detail::AABBTree moved_tree;
+                moved_tree.buildTree(moved_aabbs.data(), (unsigned int)moved_aabbs.size());
 
-            Scalar3 f = make_scalar3(xrand, yrand, zrand);
-            vec3<Scalar> pos_i = vec3<Scalar>(box.makeCoordinates(f));
+                // check again the samples that may touch a moved particle in any image
+                for (unsigned int i = 0; i < n_sample; i++)
+                    {
+                    Shape shape_i(m_sample_orientation[i], params[m_type]);
+                    hoomd::detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0, 0, 0));
+                    bool near_moved = false;
+                    for (unsigned int cur_image = 0; cur_image < image_list.size() && !near_moved;
+                         cur_image++)
+                        {
+                        hoomd::detail::AABB aabb = aabb_i_local;
+                        aabb.translate(m_sample_pos[i] + image_list[cur_image]);
 
-            Shape shape_i(quat<Scalar>(), params[m_type]);
-            if (shape_i.hasOrientation())
+                        // stackless search
+                        for (unsigned int cur_node_idx = 0;
+                             cur_node_idx < moved_tree.getNumNodes();
+                             cur_node_idx++)
+                            {
+                            if (detail::overlap(moved_tree.getNodeAABB(cur_node_idx), aabb))
+                                {
+                                if (moved_tree.isNodeLeaf(cur_node_idx))
+                                    {
+                                    near_moved = true;
+                                    break;
+                                    }
+                                }
+                            else
+                                {
+                                // skip ahead
+                                cur_node_idx += moved_tree.getNodeSkip(cur_node_idx);
+                                }
+                            }
+                        }
+
+                    if (near_moved)
+                        test_samples.push_back(i);
+                    }
+                }
+            }
+        else
+            {
+            // generate new samples
+            m_sample_pos.resize(n_sample);
+            m_sample_orientation.resize(n_sample);
+            m_sample_overlap.resize(n_sample);
+            test_samples.resize(n_sample);
+
+            for (unsigned int i = 0; i < n_sample; i++)
                 {
-                shape_i.orientation = generateRandomOrientation(rng_i, ndim);
+                // select a random particle coordinate in the box
+                hoomd::RandomGenerator rng_i(
+                    hoomd::Seed(hoomd::RNGIdentifier::ComputeFreeVolume, timestep, seed),
+                    hoomd::Counter(m_exec_conf->getRank(), i));
+
+                Scalar xrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
+                Scalar yrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
+                Scalar zrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
+
+                Scalar3 f = make_scalar3(xrand, yrand, zrand);
+                m_sample_pos[i] = vec3<Scalar>(box.makeCoordinates(f));
+
+                Shape shape_i(quat<Scalar>(), params[m_type]);
+                if (shape_i.hasOrientation())
+                    {
+                    shape_i.orientation = generateRandomOrientation(rng_i, ndim);
+                    }
+                m_sample_orientation[i] = shape_i.orientation;
+                test_samples[i] = i;
                 }
+            }
+
+        // check one sample for overlaps with neighboring particle's positions
+        auto test_sample = [&](unsigned int i, unsigned int& err_count)
+        {
+            vec3<Scalar> pos_i = m_sample_pos[i];
+            Shape shape_i(m_sample_orientation[i], params[m_type]);
 
-            // check for overlaps with neighboring particle's positions
             bool overlap = false;
             hoomd::detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0, 0, 0));
 
@@ -252,12 +396,46 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
                     break;
                 } // end loop over images
 
-            if (overlap)
+            m_sample_overlap[i] = overlap;
+        };
+
+#ifdef ENABLE_TBB
+        tbb::enumerable_thread_specific<unsigned int> thread_err_count(0);
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<size_t>(0, test_samples.size()),
+                                  [&](const tbb::blocked_range<size_t>& r)
+                                  {
+                                      for (size_t k = r.begin(); k != r.end(); ++k)
+                                          test_sample(test_samples[k], thread_err_count.local());
+                                  });
+            });
+#else
+        unsigned int err_count = 0;
+        for (size_t k = 0; k < test_samples.size(); k++)
+            test_sample(test_samples[k], err_count);
+#endif
+
+        for (unsigned int i = 0; i < n_sample; i++)
+            overlap_count += m_sample_overlap[i];
+
+        // record the state that the samples were checked against
+        m_samples_valid = persistent;
+        if (persistent)
+            {
+            m_last_postype.resize(n_tags);
+            m_last_orientation.resize(n_tags);
+            for (unsigned int j = 0; j < m_pdata->getN(); j++)
                 {
-                overlap_count++;
+                m_last_postype[h_tag.data[j]] = h_postype.data[j];
+                m_last_orientation[h_tag.data[j]] = h_orientation.data[j];
                 }
-            } // end loop through all particles
-
+            m_last_N = m_pdata->getN();
+            m_last_box = box;
+            m_last_type = m_type;
+            m_last_param_version = m_mc->getParamVersion();
+            }
         } // end lexical scope
 
 #ifdef ENABLE_MPI
@@ -326,6 +504,9 @@ template<class Shape> void export_ComputeFreeVolume(pybind11::module& m, const s
         .def_property("test_particle_type",
                       &ComputeFreeVolume<Shape>::getTestParticleType,
                       &ComputeFreeVolume<Shape>::setTestParticleType)
+        .def_property("persistent_samples",
+                      &ComputeFreeVolume<Shape>::getPersistentSamples,
+                      &ComputeFreeVolume<Shape>::setPersistentSamples)
         .def_property_readonly("free_volume", &ComputeFreeVolume<Shape>::getFreeVolume);
     }
 
@@ -8,10 +8,17 @@
 #include "hoomd/CellList.h"
 #include "hoomd/Compute.h"
 
+#include "ContactScale.h"
 #include "HPMCPrecisionSetup.h"
 #include "IntegratorHPMCMono.h"
 #include "hoomd/RNGIdentifiers.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 #ifdef ENABLE_MPI
 #include "hoomd/HOOMDMPI.h"
 #endif
@@ -31,31 +38,6 @@ namespace hoomd
     {
 namespace hpmc
     {
-namespace detail
-    {
-//! Local helper function to test overlap of two particles with scale
-template<class Shape>
-bool test_scaled_overlap(const vec3<Scalar>& r_ij,
-                         const quat<Scalar>& orientation_i,
-                         const quat<Scalar>& orientation_j,
-                         const typename Shape::param_type& params_i,
-                         const typename Shape::param_type& params_j,
-                         Scalar lambda)
-    {
-    // need a dummy error counter
-    unsigned int dummy = 0;
-
-    // instantiate the shapes
-    Shape shape_i(orientation_i, params_i);
-    Shape shape_j(orientation_j, params_j);
-
-    vec3<Scalar> r_ij_scaled = r_ij * (Scalar(1.0) - lambda);
-    return check_circumsphere_overlap(r_ij_scaled, shape_i, shape_j)
-           && test_overlap(r_ij_scaled, shape_i, shape_j, dummy);
-    }
-
-    } // namespace detail
-
 //! SDF analysis
 /*! **Overview** <br>
 
@@ -76,14 +58,14 @@ bool test_scaled_overlap(const vec3<Scalar>& r_ij,
 
     \b Computing \f$ \lambda \f$ <br>
 
-    In the initial version of the code, a completely general way of computing *\f$ \lambda \f$* is
-    implemented. It uses a binary search tree and the existing test_overlap code to find which bin a
-    given pair of particles sits in. Future versions of the code may use shape specific data to
-    compute *\f$ \lambda \f$* directly.
+    Shapes that specialize detail::sdf_contact_scale (spheres) compute *\f$ \lambda \f$* in closed
+    form. All other shapes use a binary search and the existing test_overlap code to find which bin
+    a given pair of particles sits in. The search for each pair is bounded by the smallest bin found
+    so far for particle *i*, so most neighbors cost a single overlap test.
 
-    Outside of that ComputeSDF is a pretty basic histogramming code. The only other notable feature
-    in the design is the full use of the MPI domain decomposition to compute the SDF fast in large
-    jobs.
+    Outside of that ComputeSDF is a pretty basic histogramming code. The only other notable features
+    in the design are the full use of the MPI domain decomposition to compute the SDF fast in large
+    jobs, and the TBB parallel loop over the local particles.
 
     \b Storage <br>
 
@@ -165,12 +147,22 @@ template<class Shape> class ComputeSDF : public Compute
     //! Add to histogram counts
     void countHistogram(uint64_t timestep);
 
+    //! Add the counts of a range of particles to a histogram
+    void countParticles(unsigned int first,
+                        unsigned int last,
+                        const hoomd::detail::AABBTree& aabb_tree,
+                        const std::vector<vec3<Scalar>>& image_list,
+                        const Scalar4* postype,
+                        const Scalar4* orientation,
+                        std::vector<unsigned int>& hist);
+
     //! Determine the s bin of a given particle pair
     size_t computeBin(const vec3<Scalar>& r_ij,
                       const quat<Scalar>& orientation_i,
                       const quat<Scalar>& orientation_j,
                       const typename Shape::param_type& params_i,
-                      const typename Shape::param_type& params_j);
+                      const typename Shape::param_type& params_j,
+                      size_t max_bin);
 
     //! Return the sdf
     virtual void computeSDF(uint64_t timestep);
@@ -282,6 +274,9 @@ template<class Shape> void ComputeSDF<Shape>::zeroHistogram()
     communication.
       - The integrator performs the ghost exchange (with the ghost width extra that we add)
       - Only on writeOutput() do we need to sum the per-rank histograms into a global histogram
+
+    With TBB, each thread counts a range of particles into its own histogram and the histograms are
+    summed at the end.
 */
 template<class Shape> void ComputeSDF<Shape>::countHistogram(uint64_t timestep)
     {
@@ -290,8 +285,6 @@ template<class Shape> void ComputeSDF<Shape>::countHistogram(uint64_t timestep)
     // update the image list
     const std::vector<vec3<Scalar>>& image_list = m_mc->updateImageList();
 
-    Scalar extra_width = m_xmax / (1 - m_xmax) * m_mc->getMaxCoreDiameter();
-
     // access particle data and system box
     ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
                                    access_location::host,
@@ -300,17 +293,75 @@ template<class Shape> void ComputeSDF<Shape>::countHistogram(uint64_t timestep)
                                        access_location::host,
                                        access_mode::read);
 
+#ifdef ENABLE_TBB
+    tbb::enumerable_thread_specific<std::vector<unsigned int>> thread_hist(
+        std::vector<unsigned int>(m_hist.size(), 0));
+
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              {
+                                  countParticles(r.begin(),
+                                                 r.end(),
+                                                 aabb_tree,
+                                                 image_list,
+                                                 h_postype.data,
+                                                 h_orientation.data,
+                                                 thread_hist.local());
+                              });
+        });
+
+    // reduce the per-thread histograms
+    for (auto it = thread_hist.begin(); it != thread_hist.end(); ++it)
+        {
+        for (size_t bin = 0; bin < m_hist.size(); bin++)
+            m_hist[bin] += (*it)[bin];
+        }
+#else
+    countParticles(0,
+                   m_pdata->getN(),
+                   aabb_tree,
+                   image_list,
+                   h_postype.data,
+                   h_orientation.data,
+                   m_hist);
+#endif
+    }
+
+/*! \param first Index of the first particle to count
+    \param last One past the index of the last particle to count
+    \param aabb_tree AABB tree of the local and ghost particles
+    \param image_list Periodic images to search
+    \param postype Particle positions and types
+    \param orientation Particle orientations
+    \param hist Histogram to add the counts to
+
+    Each particle *i* adds 1 to the bin of the neighbor it touches first.
+*/
+template<class Shape>
+void ComputeSDF<Shape>::countParticles(unsigned int first,
+                                       unsigned int last,
+                                       const hoomd::detail::AABBTree& aabb_tree,
+                                       const std::vector<vec3<Scalar>>& image_list,
+                                       const Scalar4* postype,
+                                       const Scalar4* orientation,
+                                       std::vector<unsigned int>& hist)
+    {
+    Scalar extra_width = m_xmax / (1 - m_xmax) * m_mc->getMaxCoreDiameter();
+
     const std::vector<param_type, hoomd::detail::managed_allocator<param_type>>& params
         = m_mc->getParams();
 
-    // loop through N particles
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+    // loop through the particles in the range
+    for (unsigned int i = first; i < last; i++)
         {
-        size_t min_bin = m_hist.size();
+        size_t min_bin = hist.size();
 
         // read in the current position and orientation
-        Scalar4 postype_i = h_postype.data[i];
-        Scalar4 orientation_i = h_orientation.data[i];
+        Scalar4 postype_i = postype[i];
+        Scalar4 orientation_i = orientation[i];
         Shape shape_i(quat<Scalar>(orientation_i), params[__scalar_as_int(postype_i.w)]);
         vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
 
@@ -346,20 +397,21 @@ template<class Shape> void ComputeSDF<Shape>::countHistogram(uint64_t timestep)
                             if (cur_image == 0 && i == j)
                                 continue;
 
-                            Scalar4 postype_j = h_postype.data[j];
-                            Scalar4 orientation_j = h_orientation.data[j];
+                            Scalar4 postype_j = postype[j];
+                            Scalar4 orientation_j = orientation[j];
 
                             // put particles in coordinate system of particle i
                             vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
 
+                            // only bins below the current minimum can change the result
                             size_t bin = computeBin(r_ij,
                                                     quat<Scalar>(orientation_i),
                                                     quat<Scalar>(orientation_j),
                                                     params[__scalar_as_int(postype_i.w)],
-                                                    params[__scalar_as_int(postype_j.w)]);
+                                                    params[__scalar_as_int(postype_j.w)],
+                                                    min_bin);
 
-                            if (bin >= 0)
-                                min_bin = std::min(min_bin, bin);
+                            min_bin = std::min(min_bin, bin);
                             }
                         }
                     }
@@ -372,8 +424,8 @@ template<class Shape> void ComputeSDF<Shape>::countHistogram(uint64_t timestep)
             }     // end loop over images
 
         // record the minimum bin
-        if ((unsigned int)min_bin < m_hist.size())
-            m_hist[min_bin]++;
+        if (min_bin < hist.size())
+            hist[min_bin]++;
 
         } // end loop over all particles
     }
@@ -383,34 +435,45 @@ template<class Shape> void ComputeSDF<Shape>::countHistogram(uint64_t timestep)
     \param orientation_j Orientation of particle j
     \param params_i Parameters for particle i
     \param params_j Parameters for particle j
+    \param max_bin Upper bound of the search (at most the number of bins)
 
-    \returns s bin index
+    \returns s bin index, -1 when the particles already overlap, or \a max_bin when the particles
+             do not overlap at the left edge of bin \a max_bin
 
-    In the first general version, computeBin uses a binary search tree to determine
-    the bin. In this way, only a test_overlap method is needed, no extra math. The
-    binary search works by first ensuring that the particle does not overlap at the
-    left boundary and does overlap a the right. Then it picks a new point halfway between
-    the left and right, ensuring that the same assumption holds. Once right=left+1, the
-    correct bin has been found.
+    Shapes with a closed form contact scale factor (see detail::sdf_contact_scale) compute the bin
+    directly. Otherwise, computeBin uses a binary search to determine the bin. In this way, only a
+    test_overlap method is needed, no extra math. The binary search works by first ensuring that the
+    particle does not overlap at the left boundary and does overlap a the right. Then it picks a new
+    point halfway between the left and right, ensuring that the same assumption holds. Once
+    right=left+1, the correct bin has been found.
+
+    Callers pass the smallest bin found so far for particle *i* as \a max_bin, so the typical
+    neighbor that does not touch first costs a single overlap test.
 */
 template<class Shape>
 size_t ComputeSDF<Shape>::computeBin(const vec3<Scalar>& r_ij,
                                      const quat<Scalar>& orientation_i,
                                      const quat<Scalar>& orientation_j,
                                      const typename Shape::param_type& params_i,
-                                     const typename Shape::param_type& params_j)
+                                     const typename Shape::param_type& params_j,
+                                     size_t max_bin)
     {
     size_t L = 0;
-    size_t R = m_hist.size();
+    size_t R = max_bin;
 
-    // if the particles already overlap a the left boundary, return an out of range value
-    if (detail::test_scaled_overlap<Shape>(r_ij,
-                                           orientation_i,
-                                           orientation_j,
-                                           params_i,
-                                           params_j,
-                                           double(L) * m_dx))
-        return -1;
+    Scalar lambda;
+    if (detail::sdf_contact_scale<Shape>(r_ij,
+                                         Shape(orientation_i, params_i),
+                                         Shape(orientation_j, params_j),
+                                         lambda))
+        {
+        // the particles overlap at scale factors larger than lambda
+        if (lambda < Scalar(0.0))
+            return -1;
+        if (lambda >= double(R) * m_dx)
+            return R;
+        return std::min(size_t(lambda / m_dx), R);
+        }
 
     // if the particles do not overlap a the right boundary, return an out of range value
     if (!detail::test_scaled_overlap<Shape>(r_ij,
@@ -419,10 +482,19 @@ size_t ComputeSDF<Shape>::computeBin(const vec3<Scalar>& r_ij,
                                             params_i,
                                             params_j,
                                             double(R) * m_dx))
-        return m_hist.size();
+        return R;
+
+    // if the particles already overlap a the left boundary, return an out of range value
+    if (detail::test_scaled_overlap<Shape>(r_ij,
+                                           orientation_i,
+                                           orientation_j,
+                                           params_i,
+                                           params_j,
+                                           double(L) * m_dx))
+        return -1;
 
     // progressively narrow the search window by halves
-    do
+    while ((R - L) > 1)
         {
         size_t m = (L + R) / 2;
 
@@ -435,7 +507,7 @@ size_t ComputeSDF<Shape>::computeBin(const vec3<Scalar>& r_ij,
             R = m;
         else
             L = m;
-        } while ((R - L) > 1);
+        }
 
     return L;
     }
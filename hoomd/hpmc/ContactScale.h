@@ -0,0 +1,79 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "HPMCPrecisionSetup.h"
+#include "ShapeSphere.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+
+/*! \file ContactScale.h
+    \brief Scale factors at which pairs of particles first touch, shared by ComputeSDF and the
+    integrator
+*/
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+namespace detail
+    {
+//! Local helper function to test overlap of two particles with scale
+template<class Shape>
+bool test_scaled_overlap(const vec3<Scalar>& r_ij,
+                         const quat<Scalar>& orientation_i,
+                         const quat<Scalar>& orientation_j,
+                         const typename Shape::param_type& params_i,
+                         const typename Shape::param_type& params_j,
+                         Scalar lambda)
+    {
+    // need a dummy error counter
+    unsigned int dummy = 0;
+
+    // instantiate the shapes
+    Shape shape_i(orientation_i, params_i);
+    Shape shape_j(orientation_j, params_j);
+
+    vec3<Scalar> r_ij_scaled = r_ij * (Scalar(1.0) - lambda);
+    return check_circumsphere_overlap(r_ij_scaled, shape_i, shape_j)
+           && test_overlap(r_ij_scaled, shape_i, shape_j, dummy);
+    }
+
+//! Compute the scale factor at which two particles first touch
+/*! \param r_ij Vector pointing from particle i to j
+    \param shape_i Shape of particle i
+    \param shape_j Shape of particle j
+    \param lambda Output scale factor: the particles overlap when r_ij is scaled by (1 - l) for any
+                  l > lambda
+    \returns true when \a lambda was computed, false when the shape has no closed form and
+             the caller must bisect with test_scaled_overlap
+*/
+template<class Shape>
+inline bool sdf_contact_scale(const vec3<Scalar>& r_ij,
+                              const Shape& shape_i,
+                              const Shape& shape_j,
+                              Scalar& lambda)
+    {
+    return false;
+    }
+
+//! Sphere-sphere contact scale factor
+template<>
+inline bool sdf_contact_scale<ShapeSphere>(const vec3<Scalar>& r_ij,
+                                           const ShapeSphere& shape_i,
+                                           const ShapeSphere& shape_j,
+                                           Scalar& lambda)
+    {
+    Scalar r = sqrt(dot(r_ij, r_ij));
+    Scalar sigma = Scalar(shape_i.params.radius) + Scalar(shape_j.params.radius);
+    if (r <= Scalar(0.0))
+        lambda = Scalar(-1.0);
+    else
+        lambda = Scalar(1.0) - sigma / r;
+    return true;
+    }
+
+    } // namespace detail
+    } // end namespace hpmc
+    } // end namespace hoomd
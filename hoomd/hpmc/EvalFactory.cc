@@ -26,7 +26,8 @@ namespace hpmc
 //! C'tor
 EvalFactory::EvalFactory(const std::string& cpp_code,
                          const std::vector<std::string>& compiler_args,
-                         bool is_union)
+                         bool is_union,
+                         const std::string& cache_dir)
     {
     std::ostringstream sstream;
     m_eval = nullptr;
@@ -46,7 +47,7 @@ EvalFactory::EvalFactory(const std::string& cpp_code,
     llvm::LLVMContext Context;
 
     // compile the module
-    auto module = clang_compiler->compileCode(cpp_code, compiler_args, Context, sstream);
+    auto module = clang_compiler->compileCode(cpp_code, compiler_args, Context, sstream, cache_dir);
 
     if (!module)
         {
@@ -27,7 +27,8 @@ class EvalFactory
     //! Constructor
     EvalFactory(const std::string& cpp_code,
                 const std::vector<std::string>& compiler_args,
-                bool is_union);
+                bool is_union,
+                const std::string& cache_dir = "");
 
     //! Return the evaluator
     EvalFnPtr getEval()
@@ -14,6 +14,10 @@
 
 #include "HPMCCounters.h" // do we need this to keep track of the statistics?
 
+#ifdef ENABLE_HIP
+#include "ExternalFieldGPUTypes.cuh"
+#endif
+
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
 #endif
@@ -25,6 +29,11 @@ namespace hpmc
 class ExternalField : public Compute
     {
     public:
+#ifdef ENABLE_HIP
+    //! A struct that contains the kernel arguments
+    typedef detail::hpmc_external_args_t gpu_args_t;
+#endif
+
     ExternalField(std::shared_ptr<SystemDefinition> sysdef) : Compute(sysdef) { }
     /*! calculateBoltzmannWeight(uint64_t timestep)
         method used to calculate the boltzmann weight contribution for the
@@ -59,6 +68,20 @@ class ExternalField : public Compute
         {
         return 0;
         }
+
+#ifdef ENABLE_HIP
+    //! Reject trial moves on the GPU with the Metropolis criterion for the field energy
+    /*! \param args Kernel arguments
+
+        Sets args.d_reject_out_of_cell for the rejected moves of the local particles. The field
+        energy depends only on the moved particle, so the acceptance factorizes from the pair
+        acceptance and is applied before the overlap checks.
+    */
+    virtual void rejectTrialMovesGPU(const gpu_args_t& args)
+        {
+        throw std::runtime_error("This external field does not support the GPU.");
+        }
+#endif
     };
 //! Compute that accepts or rejects moves according to some external field
 /*! **Overview** <br>
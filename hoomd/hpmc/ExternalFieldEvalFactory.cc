@@ -25,7 +25,8 @@ namespace hpmc
     {
 //! C'tor
 ExternalFieldEvalFactory::ExternalFieldEvalFactory(const std::string& cpp_code,
-                                                   const std::vector<std::string>& compiler_args)
+                                                   const std::vector<std::string>& compiler_args,
+                                                   const std::string& cache_dir)
     {
     std::ostringstream sstream;
     m_eval = nullptr;
@@ -43,7 +44,7 @@ ExternalFieldEvalFactory::ExternalFieldEvalFactory(const std::string& cpp_code,
     llvm::LLVMContext Context;
 
     // compile the module
-    auto module = clang_compiler->compileCode(cpp_code, compiler_args, Context, sstream);
+    auto module = clang_compiler->compileCode(cpp_code, compiler_args, Context, sstream, cache_dir);
 
     if (!module)
         {
@@ -26,7 +26,8 @@ class ExternalFieldEvalFactory
 
     //! Constructor
     ExternalFieldEvalFactory(const std::string& cpp_code,
-                             const std::vector<std::string>& compiler_args);
+                             const std::vector<std::string>& compiler_args,
+                             const std::string& cache_dir = "");
 
     //! Return the evaluator
     ExternalFieldEvalFnPtr getEval()
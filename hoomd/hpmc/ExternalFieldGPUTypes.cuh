@@ -0,0 +1,60 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "hoomd/GPUPartition.cuh"
+#include "hoomd/HOOMDMath.h"
+
+#include <cstdint>
+
+/*! \file ExternalFieldGPUTypes.cuh
+    \brief Declaration of the kernel arguments of the external field acceptance
+*/
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+namespace detail
+    {
+//! Wraps arguments to the external field acceptance kernels
+struct hpmc_external_args_t
+    {
+    //! Construct a hpmc_external_args_t
+    hpmc_external_args_t(const Scalar4* _d_postype,
+                         const Scalar4* _d_orientation,
+                         const Scalar4* _d_trial_postype,
+                         const Scalar4* _d_trial_orientation,
+                         const unsigned int* _d_trial_move_type,
+                         const unsigned int _N,
+                         const uint16_t _seed,
+                         const unsigned int _rank,
+                         const uint64_t _timestep,
+                         const unsigned int _select,
+                         unsigned int* _d_reject_out_of_cell,
+                         const GPUPartition& _gpu_partition)
+        : d_postype(_d_postype), d_orientation(_d_orientation), d_trial_postype(_d_trial_postype),
+          d_trial_orientation(_d_trial_orientation), d_trial_move_type(_d_trial_move_type), N(_N),
+          seed(_seed), rank(_rank), timestep(_timestep), select(_select),
+          d_reject_out_of_cell(_d_reject_out_of_cell), gpu_partition(_gpu_partition)
+        {
+        }
+
+    const Scalar4* d_postype;              //!< postype array
+    const Scalar4* d_orientation;          //!< orientation array
+    const Scalar4* d_trial_postype;        //!< New positions (and type) of particles
+    const Scalar4* d_trial_orientation;    //!< New orientations of particles
+    const unsigned int* d_trial_move_type; //!< 0=no move, 1/2 = translate/rotate
+    const unsigned int N;                  //!< Number of particles
+    const uint16_t seed;                   //!< RNG seed
+    const unsigned int rank;               //!< MPI Rank
+    const uint64_t timestep;               //!< Current timestep
+    const unsigned int select;             //!< Current selection
+    unsigned int* d_reject_out_of_cell;    //!< Set to one to reject particle move
+    const GPUPartition& gpu_partition;     //!< split particles among GPUs
+    };
+
+    } // end namespace detail
+    } // end namespace hpmc
+    } // end namespace hoomd
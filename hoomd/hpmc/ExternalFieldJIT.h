@@ -45,7 +45,8 @@ template<class Shape> class ExternalFieldJIT : public hpmc::ExternalFieldMono<Sh
         : hpmc::ExternalFieldMono<Shape>(sysdef)
         {
         // build the JIT.
-        ExternalFieldEvalFactory* factory = new ExternalFieldEvalFactory(cpu_code, compiler_args);
+        ExternalFieldEvalFactory* factory
+            = new ExternalFieldEvalFactory(cpu_code, compiler_args, exec_conf->getJITCacheDir());
 
         // get the evaluator
         m_eval = factory->getEval();
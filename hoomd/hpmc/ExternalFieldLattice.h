@@ -13,6 +13,11 @@
 #include "hoomd/VectorMath.h"
 
 #include "ExternalField.h"
+#include "ExternalFieldLatticeGPU.cuh"
+
+#ifdef ENABLE_HIP
+#include "hoomd/Autotuner.h"
+#endif
 
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
@@ -216,6 +221,28 @@ template<class Shape> class ExternalFieldLattice : public ExternalFieldMono<Shap
             m_symmetry.push_back(identity);
             }
         reset(0); // initializes all of the energy parameters.
+
+#ifdef ENABLE_HIP
+        if (m_exec_conf->isCUDAEnabled())
+            {
+            GPUArray<Scalar4> symmetry(m_symmetry.size(), m_exec_conf);
+            m_symmetry_gpu.swap(symmetry);
+            ArrayHandle<Scalar4> h_symmetry(m_symmetry_gpu,
+                                            access_location::host,
+                                            access_mode::overwrite);
+            for (size_t i = 0; i < m_symmetry.size(); i++)
+                h_symmetry.data[i] = quat_to_scalar4(m_symmetry[i]);
+
+            unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+            m_tuner_reject.reset(new Autotuner(warp_size,
+                                               1024,
+                                               warp_size,
+                                               5,
+                                               100000,
+                                               "hpmc_lattice_field_reject",
+                                               m_exec_conf));
+            }
+#endif
         }
 
     ~ExternalFieldLattice()
@@ -295,18 +322,54 @@ template<class Shape> class ExternalFieldLattice : public ExternalFieldMono<Shap
             return;
             }
         m_Energy = Scalar(0.0);
-        // access particle data and system box
-        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
-                                       access_location::host,
-                                       access_mode::read);
-        ArrayHandle<Scalar4> h_orient(m_pdata->getOrientationArray(),
-                                      access_location::host,
+#ifdef ENABLE_HIP
+        if (m_exec_conf->isCUDAEnabled())
+            {
+            // sum the energy in a single pass on the device
+            ArrayHandle<Scalar4> d_postype(m_pdata->getPositions(),
+                                           access_location::device,
+                                           access_mode::read);
+            ArrayHandle<Scalar4> d_orient(m_pdata->getOrientationArray(),
+                                          access_location::device,
+                                          access_mode::read);
+            ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                            access_location::device,
+                                            access_mode::read);
+            ArrayHandle<Scalar3> d_r0(m_latticePositions.getReferenceArray(),
+                                      access_location::device,
                                       access_mode::read);
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            ArrayHandle<Scalar4> d_q0(m_latticeOrientations.getReferenceArray(),
+                                      access_location::device,
+                                      access_mode::read);
+            ArrayHandle<Scalar4> d_symmetry(m_symmetry_gpu,
+                                            access_location::device,
+                                            access_mode::read);
+
+            m_Energy = gpu::hpmc_lattice_field_energy(
+                d_postype.data,
+                d_orient.data,
+                m_pdata->getN(),
+                getGPUParams(d_tag.data, d_r0.data, d_q0.data, d_symmetry.data),
+                m_exec_conf->getCachedAllocator());
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+        else
+#endif
             {
-            vec3<Scalar> position(h_postype.data[i]);
-            quat<Scalar> orientation(h_orient.data[i]);
-            m_Energy += calcE(i, position, orientation);
+            // access particle data and system box
+            ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
+                                           access_location::host,
+                                           access_mode::read);
+            ArrayHandle<Scalar4> h_orient(m_pdata->getOrientationArray(),
+                                          access_location::host,
+                                          access_mode::read);
+            for (unsigned int i = 0; i < m_pdata->getN(); i++)
+                {
+                vec3<Scalar> position(h_postype.data[i]);
+                quat<Scalar> orientation(h_orient.data[i]);
+                m_Energy += calcE(i, position, orientation);
+                }
             }
 
 #ifdef ENABLE_MPI
@@ -341,10 +404,86 @@ template<class Shape> class ExternalFieldLattice : public ExternalFieldMono<Shap
                       const vec3<Scalar>& position_new,
                       const Shape& shape_new)
         {
-        double old_U = calcE(index, position_old, shape_old),
-               new_U = calcE(index, position_new, shape_new);
-        return new_U - old_U;
+        // a trial move either translates or rotates the particle, evaluate only the terms that
+        // change
+        ArrayHandle<unsigned int> h_tags(m_pdata->getTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        unsigned int tag = h_tags.data[index];
+        double dU = 0.0;
+        if (m_latticePositions.isValid() && position_old != position_new)
+            {
+            vec3<Scalar> r0(m_latticePositions.getReference(tag));
+            vec3<Scalar> origin(m_pdata->getOrigin());
+            const BoxDim& box = m_pdata->getGlobalBox();
+            dU += detail::lattice_energy_translation(r0, position_new, origin, box, m_k)
+                  - detail::lattice_energy_translation(r0, position_old, origin, box, m_k);
+            }
+        if (m_latticeOrientations.isValid()
+            && (shape_old.orientation.s != shape_new.orientation.s
+                || shape_old.orientation.v != shape_new.orientation.v))
+            {
+            quat<Scalar> q0(m_latticeOrientations.getReference(tag));
+            unsigned int n_symmetry = (unsigned int)m_symmetry.size();
+            dU += detail::lattice_energy_rotation(q0,
+                                                  quat<Scalar>(shape_new.orientation),
+                                                  m_symmetry.data(),
+                                                  n_symmetry,
+                                                  m_q)
+                  - detail::lattice_energy_rotation(q0,
+                                                    quat<Scalar>(shape_old.orientation),
+                                                    m_symmetry.data(),
+                                                    n_symmetry,
+                                                    m_q);
+            }
+        return dU;
+        }
+
+#ifdef ENABLE_HIP
+    //! Reject trial moves on the GPU with the Metropolis criterion for the lattice energy
+    void rejectTrialMovesGPU(const detail::hpmc_external_args_t& args)
+        {
+        if (!m_latticePositions.isValid() && !m_latticeOrientations.isValid())
+            return;
+
+        ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                        access_location::device,
+                                        access_mode::read);
+        ArrayHandle<Scalar3> d_r0(m_latticePositions.getReferenceArray(),
+                                  access_location::device,
+                                  access_mode::read);
+        ArrayHandle<Scalar4> d_q0(m_latticeOrientations.getReferenceArray(),
+                                  access_location::device,
+                                  access_mode::read);
+        ArrayHandle<Scalar4> d_symmetry(m_symmetry_gpu,
+                                        access_location::device,
+                                        access_mode::read);
+
+        m_exec_conf->beginMultiGPU();
+        m_tuner_reject->begin();
+        gpu::hpmc_lattice_field_reject(
+            args,
+            getGPUParams(d_tag.data, d_r0.data, d_q0.data, d_symmetry.data),
+            m_tuner_reject->getParam());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_reject->end();
+        m_exec_conf->endMultiGPU();
+        }
+
+    //! Set autotuner parameters
+    /*! \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        if (m_tuner_reject)
+            {
+            m_tuner_reject->setPeriod(period);
+            m_tuner_reject->setEnabled(enable);
+            }
         }
+#endif
 
     void setReferences(const pybind11::list& r0, const pybind11::list& q0)
         {
@@ -526,16 +665,11 @@ template<class Shape> class ExternalFieldLattice : public ExternalFieldMono<Shap
         ArrayHandle<unsigned int> h_tags(m_pdata->getTags(),
                                          access_location::host,
                                          access_mode::read);
-        int3 dummy = make_int3(0, 0, 0);
         vec3<Scalar> origin(m_pdata->getOrigin());
         const BoxDim& box = this->m_pdata->getGlobalBox();
         vec3<Scalar> r0(m_latticePositions.getReference(h_tags.data[index]));
         r0 *= scale;
-        Scalar3 t = vec_to_scalar3(position - origin);
-        box.wrap(t, dummy);
-        vec3<Scalar> shifted_pos(t);
-        vec3<Scalar> dr = vec3<Scalar>(box.minImage(vec_to_scalar3(r0 - position + origin)));
-        return m_k * dot(dr, dr);
+        return detail::lattice_energy_translation(r0, position, origin, box, m_k);
         }
 
     Scalar calcE_rot(const unsigned int& index, const quat<Scalar>& orientation)
@@ -545,14 +679,11 @@ template<class Shape> class ExternalFieldLattice : public ExternalFieldMono<Shap
                                          access_location::host,
                                          access_mode::read);
         quat<Scalar> q0(m_latticeOrientations.getReference(h_tags.data[index]));
-        Scalar dqmin = 0.0;
-        for (size_t i = 0; i < m_symmetry.size(); i++)
-            {
-            quat<Scalar> equiv_orientation = orientation * m_symmetry[i];
-            quat<Scalar> dq = q0 - equiv_orientation;
-            dqmin = (i == 0) ? norm2(dq) : fmin(dqmin, norm2(dq));
-            }
-        return m_q * dqmin;
+        return detail::lattice_energy_rotation(q0,
+                                               orientation,
+                                               m_symmetry.data(),
+                                               (unsigned int)m_symmetry.size(),
+                                               m_q);
         }
     Scalar calcE_rot(const unsigned int& index, const Shape& shape)
         {
@@ -585,6 +716,27 @@ template<class Shape> class ExternalFieldLattice : public ExternalFieldMono<Shap
         return calcE(index, position, shape.orientation, scale);
         }
 
+#ifdef ENABLE_HIP
+    //! Collect the lattice field parameters for the GPU kernels
+    detail::lattice_field_params_t getGPUParams(const unsigned int* d_tag,
+                                                const Scalar3* d_r0,
+                                                const Scalar4* d_q0,
+                                                const Scalar4* d_symmetry)
+        {
+        detail::lattice_field_params_t params;
+        params.d_tag = d_tag;
+        params.d_r0 = m_latticePositions.isValid() ? d_r0 : NULL;
+        params.d_q0 = m_latticeOrientations.isValid() ? d_q0 : NULL;
+        params.d_symmetry = d_symmetry;
+        params.n_symmetry = (unsigned int)m_symmetry.size();
+        params.k = m_k;
+        params.q = m_q;
+        params.origin = vec3<Scalar>(m_pdata->getOrigin());
+        params.box = m_pdata->getGlobalBox();
+        return params;
+        }
+#endif
+
     private:
     LatticeReferenceList<Scalar3> m_latticePositions; // positions of the lattice.
     Scalar m_k;                                       // spring constant
@@ -611,6 +763,11 @@ template<class Shape> class ExternalFieldLattice : public ExternalFieldMono<Shap
 
     std::vector<std::string> m_ProvidedQuantities;
     BoxDim m_box; //!< Save the last known box;
+
+#ifdef ENABLE_HIP
+    GPUArray<Scalar4> m_symmetry_gpu;          //!< m_symmetry on the device
+    std::unique_ptr<Autotuner> m_tuner_reject; //!< Autotuner for the acceptance kernel
+#endif
     };
 
 namespace detail
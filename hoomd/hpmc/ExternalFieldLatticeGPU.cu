@@ -0,0 +1,223 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ExternalFieldLatticeGPU.cuh"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+#include <thrust/execution_policy.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/transform_reduce.h>
+
+/*! \file ExternalFieldLatticeGPU.cu
+    \brief Definition of the lattice field kernel drivers
+*/
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+namespace gpu
+    {
+namespace kernel
+    {
+//! Reject trial moves with the Metropolis criterion for the lattice energy
+/*! \param d_postype Particle positions and types
+    \param d_orientation Particle orientations
+    \param d_trial_postype New positions (and type) of particles
+    \param d_trial_orientation New orientations of particles
+    \param d_trial_move_type 0=no move, 1/2 = translate/rotate
+    \param d_reject_out_of_cell Set to one to reject particle move
+    \param params Lattice field parameters
+    \param seed RNG seed
+    \param timestep Current timestep
+    \param select Current selection
+    \param rank MPI rank
+    \param N Number of particles handled by this GPU
+    \param work_offset First particle handled by this GPU
+
+    One thread per particle. A translation only changes the translational energy and a rotation
+    only changes the rotational energy, so each move evaluates a single term.
+*/
+__global__ void hpmc_lattice_field_reject(const Scalar4* d_postype,
+                                          const Scalar4* d_orientation,
+                                          const Scalar4* d_trial_postype,
+                                          const Scalar4* d_trial_orientation,
+                                          const unsigned int* d_trial_move_type,
+                                          unsigned int* d_reject_out_of_cell,
+                                          const detail::lattice_field_params_t params,
+                                          const uint16_t seed,
+                                          const uint64_t timestep,
+                                          const unsigned int select,
+                                          const unsigned int rank,
+                                          const unsigned int N,
+                                          const unsigned int work_offset)
+    {
+    unsigned int offset = blockIdx.x * blockDim.x + threadIdx.x;
+    if (offset >= N)
+        return;
+    unsigned int idx = offset + work_offset;
+
+    unsigned int move_type = d_trial_move_type[idx];
+    if (!move_type || d_reject_out_of_cell[idx])
+        return;
+
+    unsigned int tag = params.d_tag[idx];
+    Scalar delta_U(0.0);
+    if (move_type == 1 && params.d_r0)
+        {
+        vec3<Scalar> r0(params.d_r0[tag]);
+        delta_U = detail::lattice_energy_translation(r0,
+                                                     vec3<Scalar>(d_trial_postype[idx]),
+                                                     params.origin,
+                                                     params.box,
+                                                     params.k)
+                  - detail::lattice_energy_translation(r0,
+                                                       vec3<Scalar>(d_postype[idx]),
+                                                       params.origin,
+                                                       params.box,
+                                                       params.k);
+        }
+    else if (move_type == 2 && params.d_q0)
+        {
+        quat<Scalar> q0(params.d_q0[tag]);
+        delta_U = detail::lattice_energy_rotation(q0,
+                                                  quat<Scalar>(d_trial_orientation[idx]),
+                                                  params.d_symmetry,
+                                                  params.n_symmetry,
+                                                  params.q)
+                  - detail::lattice_energy_rotation(q0,
+                                                    quat<Scalar>(d_orientation[idx]),
+                                                    params.d_symmetry,
+                                                    params.n_symmetry,
+                                                    params.q);
+        }
+
+    if (delta_U <= Scalar(0.0))
+        return;
+
+    hoomd::RandomGenerator rng(
+        hoomd::Seed(hoomd::RNGIdentifier::HPMCExternalFieldAccept, timestep, seed),
+        hoomd::Counter(idx, select, rank));
+    if (!(hoomd::detail::generate_canonical<double>(rng) < slow::exp(-delta_U)))
+        d_reject_out_of_cell[idx] = 1;
+    }
+
+//! Evaluates the lattice energy of one particle
+struct lattice_field_energy
+    {
+    lattice_field_energy(const Scalar4* _d_postype,
+                         const Scalar4* _d_orientation,
+                         const detail::lattice_field_params_t& _params)
+        : d_postype(_d_postype), d_orientation(_d_orientation), params(_params)
+        {
+        }
+
+    __device__ Scalar operator()(const unsigned int idx) const
+        {
+        unsigned int tag = params.d_tag[idx];
+        Scalar energy(0.0);
+        if (params.d_r0)
+            energy += detail::lattice_energy_translation(vec3<Scalar>(params.d_r0[tag]),
+                                                         vec3<Scalar>(d_postype[idx]),
+                                                         params.origin,
+                                                         params.box,
+                                                         params.k);
+        if (params.d_q0)
+            energy += detail::lattice_energy_rotation(quat<Scalar>(params.d_q0[tag]),
+                                                      quat<Scalar>(d_orientation[idx]),
+                                                      params.d_symmetry,
+                                                      params.n_symmetry,
+                                                      params.q);
+        return energy;
+        }
+
+    const Scalar4* d_postype;              //!< Particle positions
+    const Scalar4* d_orientation;          //!< Particle orientations
+    detail::lattice_field_params_t params; //!< Lattice field parameters
+    };
+
+    } // end namespace kernel
+
+/*! \param args Kernel arguments
+    \param params Lattice field parameters
+    \param block_size Block size to launch with
+
+    \note This is just a kernel driver. See kernel::hpmc_lattice_field_reject for full
+    documentation.
+*/
+void hpmc_lattice_field_reject(const detail::hpmc_external_args_t& args,
+                               const detail::lattice_field_params_t& params,
+                               const unsigned int block_size)
+    {
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel::hpmc_lattice_field_reject));
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    for (int idev = args.gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = args.gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+        if (nwork == 0)
+            continue;
+
+        hipLaunchKernelGGL(kernel::hpmc_lattice_field_reject,
+                           dim3(nwork / run_block_size + 1),
+                           dim3(run_block_size),
+                           0,
+                           0,
+                           args.d_postype,
+                           args.d_orientation,
+                           args.d_trial_postype,
+                           args.d_trial_orientation,
+                           args.d_trial_move_type,
+                           args.d_reject_out_of_cell,
+                           params,
+                           args.seed,
+                           args.timestep,
+                           args.select,
+                           args.rank,
+                           nwork,
+                           range.first);
+        }
+    }
+
+/*! \param d_postype Particle positions and types
+    \param d_orientation Particle orientations
+    \param N Number of local particles
+    \param params Lattice field parameters
+    \param alloc Caching allocator for temporary storage
+    \returns The lattice energy of the local particles
+
+    The per-particle energies are evaluated inside the reduction and never stored.
+*/
+Scalar hpmc_lattice_field_energy(const Scalar4* d_postype,
+                                 const Scalar4* d_orientation,
+                                 const unsigned int N,
+                                 const detail::lattice_field_params_t& params,
+                                 CachedAllocator& alloc)
+    {
+    if (N == 0)
+        return Scalar(0.0);
+
+    thrust::counting_iterator<unsigned int> first(0);
+    return thrust::transform_reduce(
+#ifdef __HIP_PLATFORM_HCC__
+        thrust::hip::par(alloc),
+#else
+        thrust::cuda::par(alloc),
+#endif
+        first,
+        first + N,
+        kernel::lattice_field_energy(d_postype, d_orientation, params),
+        Scalar(0.0),
+        thrust::plus<Scalar>());
+    }
+
+    } // end namespace gpu
+    } // end namespace hpmc
+    } // end namespace hoomd
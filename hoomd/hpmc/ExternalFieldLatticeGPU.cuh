@@ -0,0 +1,114 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+
+#ifdef ENABLE_HIP
+#include "ExternalFieldGPUTypes.cuh"
+#include "hoomd/CachedAllocator.h"
+#include <hip/hip_runtime.h>
+#endif
+
+/*! \file ExternalFieldLatticeGPU.cuh
+    \brief Declaration of the lattice field energy and its GPU kernel drivers
+*/
+
+// need to declare these functions with __host__ __device__ qualifiers when building in nvcc
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+namespace detail
+    {
+//! Harmonic energy of a particle displaced from its lattice site
+/*! \param r0 Lattice site of the particle
+    \param position Position of the particle
+    \param origin Origin of the particle data
+    \param box Global simulation box
+    \param k Spring constant
+    \returns The translational lattice energy
+*/
+HOSTDEVICE inline Scalar lattice_energy_translation(const vec3<Scalar>& r0,
+                                                    const vec3<Scalar>& position,
+                                                    const vec3<Scalar>& origin,
+                                                    const BoxDim& box,
+                                                    const Scalar k)
+    {
+    vec3<Scalar> dr = vec3<Scalar>(box.minImage(vec_to_scalar3(r0 - position + origin)));
+    return k * dot(dr, dr);
+    }
+
+//! Harmonic energy of a particle rotated from its lattice orientation
+/*! \param q0 Lattice orientation of the particle
+    \param orientation Orientation of the particle
+    \param symmetry Quaternions in the symmetry group of the shape
+    \param n_symmetry Number of elements in \a symmetry
+    \param q Spring constant
+    \returns The rotational lattice energy, minimized over the symmetry group
+*/
+template<class SymmetryType>
+HOSTDEVICE inline Scalar lattice_energy_rotation(const quat<Scalar>& q0,
+                                                 const quat<Scalar>& orientation,
+                                                 const SymmetryType* symmetry,
+                                                 const unsigned int n_symmetry,
+                                                 const Scalar q)
+    {
+    Scalar dqmin = 0.0;
+    for (unsigned int i = 0; i < n_symmetry; i++)
+        {
+        quat<Scalar> equiv_orientation = orientation * quat<Scalar>(symmetry[i]);
+        quat<Scalar> dq = q0 - equiv_orientation;
+        dqmin = (i == 0) ? norm2(dq) : fmin(dqmin, norm2(dq));
+        }
+    return q * dqmin;
+    }
+
+#ifdef ENABLE_HIP
+//! Parameters of the lattice field on the device
+struct lattice_field_params_t
+    {
+    const unsigned int* d_tag; //!< Particle tags
+    const Scalar3* d_r0;       //!< Lattice sites by tag (NULL when not set)
+    const Scalar4* d_q0;       //!< Lattice orientations by tag (NULL when not set)
+    const Scalar4* d_symmetry; //!< Quaternions in the symmetry group of the shape
+    unsigned int n_symmetry;   //!< Number of elements in d_symmetry
+    Scalar k;                  //!< Translational spring constant
+    Scalar q;                  //!< Rotational spring constant
+    vec3<Scalar> origin;       //!< Origin of the particle data
+    BoxDim box;                //!< Global simulation box
+    };
+#endif
+
+    } // end namespace detail
+
+#ifdef ENABLE_HIP
+namespace gpu
+    {
+//! Reject trial moves with the Metropolis criterion for the lattice energy
+void hpmc_lattice_field_reject(const detail::hpmc_external_args_t& args,
+                               const detail::lattice_field_params_t& params,
+                               const unsigned int block_size);
+
+//! Sum the lattice energy of the local particles
+Scalar hpmc_lattice_field_energy(const Scalar4* d_postype,
+                                 const Scalar4* d_orientation,
+                                 const unsigned int N,
+                                 const detail::lattice_field_params_t& params,
+                                 CachedAllocator& alloc);
+    } // end namespace gpu
+#endif
+
+    } // end namespace hpmc
+    } // end namespace hoomd
+
+#undef HOSTDEVICE
@@ -8,13 +8,16 @@
     \brief Declaration of ExternalField base class
 */
 #include "hoomd/Compute.h"
+#include "hoomd/Index1D.h"
 #include "hoomd/VectorMath.h"
 
 #include "ExternalField.h"
 #include "IntegratorHPMCMono.h"
 
+#include <algorithm>
 #include <limits>
 #include <tuple>
+#include <vector>
 
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
@@ -512,6 +515,14 @@ DEVICE inline bool test_confined(const PlaneWall& wall,
     return accept;
     }
 
+//! Confines particles with sphere, cylinder, and plane walls
+/*! A sphere wall with inside == false only rejects particles within its radius plus the particle
+    circumsphere radius of its origin. To model patterned substrates with many such walls,
+    ExternalFieldWall bins them in a periodic cell grid over the global box and tests only the walls
+    binned in the cell of the trial position. The remaining walls are tested for every move. The
+    index is rebuilt when the sphere walls or the box change, or when a particle is larger than the
+    margin the index was built with.
+*/
 template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
     {
     using Compute::m_pdata;
@@ -519,7 +530,8 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
     public:
     ExternalFieldWall(std::shared_ptr<SystemDefinition> sysdef,
                       std::shared_ptr<IntegratorHPMCMono<Shape>> mc)
-        : ExternalFieldMono<Shape>(sysdef), m_mc(mc)
+        : ExternalFieldMono<Shape>(sysdef), m_mc(mc), m_sphere_index_valid(false),
+          m_sphere_index_margin(0)
         {
         m_box = m_pdata->getGlobalBox();
         //! scale the container walls every time the box changes
@@ -543,9 +555,32 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
         const BoxDim& box = this->m_pdata->getGlobalBox();
         vec3<Scalar> origin(m_pdata->getOrigin());
 
-        for (size_t i = 0; i < m_Spheres.size(); i++)
+        Scalar r_circ = Scalar(shape_new.getCircumsphereDiameter()) / Scalar(2.0);
+        if (!m_sphere_index_valid || r_circ > m_sphere_index_margin)
             {
-            if (!test_confined(m_Spheres[i], shape_new, position_new, origin, box))
+            buildSphereWallIndex(r_circ);
+            }
+
+        for (size_t i = 0; i < m_unindexed_spheres.size(); i++)
+            {
+            if (!test_confined(m_Spheres[m_unindexed_spheres[i]],
+                               shape_new,
+                               position_new,
+                               origin,
+                               box))
+                {
+                return INFINITY;
+                }
+            }
+
+        unsigned int cell = getSphereWallCell(position_new - origin, box);
+        for (unsigned int k = m_sphere_cell_head[cell]; k < m_sphere_cell_head[cell + 1]; k++)
+            {
+            if (!test_confined(m_Spheres[m_sphere_cell_walls[k]],
+                               shape_new,
+                               position_new,
+                               origin,
+                               box))
                 {
                 return INFINITY;
                 }
@@ -612,6 +647,7 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
             {
             m_Spheres[i].scale(alpha);
             }
+        m_sphere_index_valid = false;
 
         for (size_t i = 0; i < m_Cylinders.size(); i++)
             {
@@ -735,6 +771,7 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
         if (index >= m_Spheres.size())
             throw std::runtime_error("Out of bounds of sphere walls.");
         m_Spheres[index] = wall;
+        m_sphere_index_valid = false;
         }
 
     void SetCylinderWallParameter(size_t index, const CylinderWall& wall)
@@ -754,6 +791,7 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
     void SetSphereWalls(const std::vector<SphereWall>& Spheres)
         {
         m_Spheres = Spheres;
+        m_sphere_index_valid = false;
         }
 
     void SetCylinderWalls(const std::vector<CylinderWall>& Cylinders)
@@ -769,6 +807,7 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
     void AddSphereWall(const SphereWall& wall)
         {
         m_Spheres.push_back(wall);
+        m_sphere_index_valid = false;
         }
 
     void AddCylinderWall(const CylinderWall& wall)
@@ -785,6 +824,7 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
     void RemoveSphereWall(size_t index)
         {
         m_Spheres.erase(m_Spheres.begin() + index);
+        m_sphere_index_valid = false;
         }
 
     void RemoveCylinderWall(size_t index)
@@ -933,6 +973,126 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
         wall.verts->diameter
             = OverlapReal(2.0 * (shape.getCircumsphereDiameter() + wall.verts->sweep_radius));
         }
+
+    //! Bin the sphere walls with inside == false in a periodic cell grid
+    /*! \param r_circ Circumsphere radius of the particle being tested
+
+        Each wall is binned in every cell within its radius plus the largest particle circumsphere
+        radius of its origin, so the walls binned in the cell of a particle include every wall
+        that can reject it.
+    */
+    void buildSphereWallIndex(Scalar r_circ)
+        {
+        m_sphere_index_margin = r_circ;
+        const std::vector<typename Shape::param_type,
+                          hoomd::detail::managed_allocator<typename Shape::param_type>>& params
+            = m_mc->getParams();
+        for (unsigned int typ = 0; typ < m_pdata->getNTypes(); typ++)
+            {
+            Shape shape(quat<Scalar>(), params[typ]);
+            m_sphere_index_margin
+                = std::max(m_sphere_index_margin,
+                           Scalar(shape.getCircumsphereDiameter()) / Scalar(2.0));
+            }
+
+        m_unindexed_spheres.clear();
+        std::vector<unsigned int> indexed_spheres;
+        Scalar max_reach = Scalar(0.0);
+        for (unsigned int i = 0; i < m_Spheres.size(); i++)
+            {
+            if (m_Spheres[i].inside)
+                {
+                m_unindexed_spheres.push_back(i);
+                }
+            else
+                {
+                indexed_spheres.push_back(i);
+                max_reach = std::max(max_reach, sqrt(m_Spheres[i].rsq) + m_sphere_index_margin);
+                }
+            }
+
+        // cells are at least as wide as the reach of the largest indexed wall
+        const BoxDim& box = m_pdata->getGlobalBox();
+        Scalar3 plane_dist = box.getNearestPlaneDistance();
+        Scalar L[3] = {plane_dist.x, plane_dist.y, plane_dist.z};
+        unsigned int dim[3];
+        for (unsigned int d = 0; d < 3; d++)
+            {
+            dim[d] = 1;
+            if (max_reach > Scalar(0.0))
+                {
+                Scalar n = floor(L[d] / max_reach);
+                dim[d] = (unsigned int)std::max(Scalar(1.0), std::min(Scalar(32.0), n));
+                }
+            }
+        m_sphere_cell_indexer = Index3D(dim[0], dim[1], dim[2]);
+
+        // collect (cell, wall) pairs and sort them into CSR form
+        auto wrap = [](int i, unsigned int n)
+        { return (unsigned int)((i % int(n) + int(n)) % int(n)); };
+        std::vector<std::pair<unsigned int, unsigned int>> cell_walls;
+        for (unsigned int i : indexed_spheres)
+            {
+            const SphereWall& wall = m_Spheres[i];
+            Scalar3 f = box.makeFraction(vec_to_scalar3(wall.origin));
+            Scalar fc[3] = {f.x, f.y, f.z};
+            Scalar reach = sqrt(wall.rsq) + m_sphere_index_margin;
+            int lo[3], hi[3];
+            for (unsigned int d = 0; d < 3; d++)
+                {
+                Scalar h = reach / L[d];
+                lo[d] = int(floor((fc[d] - h) * Scalar(dim[d])));
+                hi[d] = int(floor((fc[d] + h) * Scalar(dim[d])));
+                if (hi[d] - lo[d] + 1 >= int(dim[d]))
+                    {
+                    lo[d] = 0;
+                    hi[d] = int(dim[d]) - 1;
+                    }
+                }
+
+            for (int k = lo[2]; k <= hi[2]; k++)
+                for (int j = lo[1]; j <= hi[1]; j++)
+                    for (int i_cell = lo[0]; i_cell <= hi[0]; i_cell++)
+                        {
+                        unsigned int cell = m_sphere_cell_indexer(wrap(i_cell, dim[0]),
+                                                                  wrap(j, dim[1]),
+                                                                  wrap(k, dim[2]));
+                        cell_walls.push_back(std::make_pair(cell, i));
+                        }
+            }
+        std::sort(cell_walls.begin(), cell_walls.end());
+
+        unsigned int n_cells = m_sphere_cell_indexer.getNumElements();
+        m_sphere_cell_head.assign(n_cells + 1, 0);
+        m_sphere_cell_walls.resize(cell_walls.size());
+        for (unsigned int k = 0; k < cell_walls.size(); k++)
+            {
+            m_sphere_cell_head[cell_walls[k].first + 1]++;
+            m_sphere_cell_walls[k] = cell_walls[k].second;
+            }
+        for (unsigned int cell = 0; cell < n_cells; cell++)
+            {
+            m_sphere_cell_head[cell + 1] += m_sphere_cell_head[cell];
+            }
+
+        m_sphere_index_valid = true;
+        }
+
+    //! Find the cell of the sphere wall index that holds a position relative to the box origin
+    unsigned int getSphereWallCell(const vec3<Scalar>& pos, const BoxDim& box) const
+        {
+        Scalar3 f = box.makeFraction(vec_to_scalar3(pos));
+        f.x -= floor(f.x);
+        f.y -= floor(f.y);
+        f.z -= floor(f.z);
+        unsigned int w = m_sphere_cell_indexer.getW();
+        unsigned int h = m_sphere_cell_indexer.getH();
+        unsigned int d = m_sphere_cell_indexer.getD();
+        return m_sphere_cell_indexer(std::min((unsigned int)(f.x * Scalar(w)), w - 1),
+                                     std::min((unsigned int)(f.y * Scalar(h)), h - 1),
+                                     std::min((unsigned int)(f.z * Scalar(d)), d - 1));
+        }
+
     std::string getSphWallParamName(size_t i)
         {
         std::stringstream ss;
@@ -959,6 +1119,13 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
     private:
     std::shared_ptr<IntegratorHPMCMono<Shape>> m_mc; //!< integrator
     BoxDim m_box;                                    //!< the current box
+
+    bool m_sphere_index_valid;                     //!< True when the sphere wall index is current
+    Scalar m_sphere_index_margin;                  //!< Particle radius the index was built with
+    Index3D m_sphere_cell_indexer;                 //!< Indexes the cells of the sphere wall index
+    std::vector<unsigned int> m_sphere_cell_head;  //!< Start of the walls of each cell
+    std::vector<unsigned int> m_sphere_cell_walls; //!< Indexed sphere walls, grouped by cell
+    std::vector<unsigned int> m_unindexed_spheres; //!< Sphere walls tested for every move
     };
 
 namespace detail
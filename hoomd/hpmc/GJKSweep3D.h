@@ -0,0 +1,322 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "HPMCPrecisionSetup.h"
+#include "MinkowskiMath.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+
+#ifndef __GJK_SWEEP_3D_H__
+#define __GJK_SWEEP_3D_H__
+
+/*! \file GJKSweep3D.h
+    \brief Implements a GJK ray cast that finds where two convex shapes first touch
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __device__ when included in nvcc and blank when included into the host compiler
+#ifdef __HIPCC__
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+namespace detail
+    {
+const unsigned int GJK_SWEEP_3D_MAX_ITERATIONS = 128;
+
+//! Find the point of a triangle closest to the origin
+/*! \param a First vertex
+    \param b Second vertex
+    \param c Third vertex
+    \param mask Output bit mask of the vertices that support the closest point
+    \returns The point of triangle abc closest to the origin
+
+    Hand-written from the description of ClosestPtPointTriangle in _Real-Time Collision
+    Detection_ (Christer Ericson), section 5.1.5.
+*/
+DEVICE inline vec3<OverlapReal> gjk_sweep_closest_triangle(const vec3<OverlapReal>& a,
+                                                           const vec3<OverlapReal>& b,
+                                                           const vec3<OverlapReal>& c,
+                                                           unsigned int& mask)
+    {
+    const vec3<OverlapReal> ab = b - a;
+    const vec3<OverlapReal> ac = c - a;
+
+    // vertex region a
+    OverlapReal d1 = -dot(ab, a);
+    OverlapReal d2 = -dot(ac, a);
+    if (d1 <= OverlapReal(0.0) && d2 <= OverlapReal(0.0))
+        {
+        mask = 1;
+        return a;
+        }
+
+    // vertex region b
+    OverlapReal d3 = -dot(ab, b);
+    OverlapReal d4 = -dot(ac, b);
+    if (d3 >= OverlapReal(0.0) && d4 <= d3)
+        {
+        mask = 2;
+        return b;
+        }
+
+    // edge region ab
+    OverlapReal vc = d1 * d4 - d3 * d2;
+    if (vc <= OverlapReal(0.0) && d1 >= OverlapReal(0.0) && d3 <= OverlapReal(0.0))
+        {
+        mask = 3;
+        return a + (d1 / (d1 - d3)) * ab;
+        }
+
+    // vertex region c
+    OverlapReal d5 = -dot(ab, c);
+    OverlapReal d6 = -dot(ac, c);
+    if (d6 >= OverlapReal(0.0) && d5 <= d6)
+        {
+        mask = 4;
+        return c;
+        }
+
+    // edge region ac
+    OverlapReal vb = d5 * d2 - d1 * d6;
+    if (vb <= OverlapReal(0.0) && d2 >= OverlapReal(0.0) && d6 <= OverlapReal(0.0))
+        {
+        mask = 5;
+        return a + (d2 / (d2 - d6)) * ac;
+        }
+
+    // edge region bc
+    OverlapReal va = d3 * d6 - d5 * d4;
+    if (va <= OverlapReal(0.0) && (d4 - d3) >= OverlapReal(0.0) && (d5 - d6) >= OverlapReal(0.0))
+        {
+        mask = 6;
+        return b + ((d4 - d3) / ((d4 - d3) + (d5 - d6))) * (c - b);
+        }
+
+    // face region
+    OverlapReal denom = OverlapReal(1.0) / (va + vb + vc);
+    mask = 7;
+    return a + (vb * denom) * ab + (vc * denom) * ac;
+    }
+
+//! Find the point of a simplex closest to the origin
+/*! \param y Vertices of the simplex
+    \param p Support points that correspond to the vertices
+    \param n Number of vertices (1 to 4)
+    \returns The point of the simplex closest to the origin
+
+    On return, \a y, \a p, and \a n hold only the vertices that support the closest point. A
+    tetrahedron that contains the origin is left unchanged and the origin is returned.
+*/
+DEVICE inline vec3<OverlapReal>
+gjk_sweep_closest_simplex(vec3<OverlapReal>* y, vec3<OverlapReal>* p, unsigned int& n)
+    {
+    vec3<OverlapReal> v;
+    unsigned int mask = 1;
+
+    if (n == 1)
+        {
+        return y[0];
+        }
+    else if (n == 2)
+        {
+        vec3<OverlapReal> ab = y[1] - y[0];
+        OverlapReal t = -dot(y[0], ab);
+        OverlapReal ab_sq = dot(ab, ab);
+        if (t <= OverlapReal(0.0))
+            {
+            v = y[0];
+            mask = 1;
+            }
+        else if (t >= ab_sq)
+            {
+            v = y[1];
+            mask = 2;
+            }
+        else
+            {
+            v = y[0] + (t / ab_sq) * ab;
+            mask = 3;
+            }
+        }
+    else if (n == 3)
+        {
+        v = gjk_sweep_closest_triangle(y[0], y[1], y[2], mask);
+        }
+    else
+        {
+        // test each face of the tetrahedron that has the origin on its outside, and keep the
+        // closest point found
+        const unsigned int face[4][3] = {{0, 1, 2}, {0, 3, 1}, {0, 2, 3}, {1, 3, 2}};
+        const unsigned int opposite[4] = {3, 2, 1, 0};
+        OverlapReal best_sq = OverlapReal(-1.0);
+        bool inside = true;
+
+        for (unsigned int f = 0; f < 4; f++)
+            {
+            const vec3<OverlapReal>& a = y[face[f][0]];
+            const vec3<OverlapReal>& b = y[face[f][1]];
+            const vec3<OverlapReal>& c = y[face[f][2]];
+            vec3<OverlapReal> normal = cross(b - a, c - a);
+            OverlapReal side_origin = -dot(normal, a);
+            OverlapReal side_opposite = dot(normal, y[opposite[f]] - a);
+
+            // faces of a degenerate tetrahedron are always tested
+            if (side_origin * side_opposite < OverlapReal(0.0) || side_opposite == OverlapReal(0.0))
+                {
+                inside = false;
+                unsigned int face_mask;
+                vec3<OverlapReal> q = gjk_sweep_closest_triangle(a, b, c, face_mask);
+                OverlapReal q_sq = dot(q, q);
+                if (best_sq < OverlapReal(0.0) || q_sq < best_sq)
+                    {
+                    best_sq = q_sq;
+                    v = q;
+                    mask = 0;
+                    for (unsigned int k = 0; k < 3; k++)
+                        {
+                        if (face_mask & (1 << k))
+                            mask |= 1 << face[f][k];
+                        }
+                    }
+                }
+            }
+
+        if (inside)
+            return vec3<OverlapReal>(0, 0, 0);
+        }
+
+    // keep only the supporting vertices
+    unsigned int m = 0;
+    for (unsigned int k = 0; k < n; k++)
+        {
+        if (mask & (1 << k))
+            {
+            y[m] = y[k];
+            p[m] = p[k];
+            m++;
+            }
+        }
+    n = m;
+
+    return v;
+    }
+
+//! Find the distance that shape A can move before it touches shape B
+/*! \tparam SupportFuncA Support function class type for shape A
+    \tparam SupportFuncB Support function class type for shape B
+    \param sa Support function for shape A
+    \param sb Support function for shape B
+    \param ab_t Vector pointing from a's center to b's center, in frame A
+    \param q Orientation of shape B in frame A
+    \param direction Unit vector that A moves along, in frame A
+    \param sweep_radius Sum of the radii of the spheres that sweep the two shapes
+    \param max_distance Largest distance of interest
+    \param R Approximate radius of Minkowski difference for scaling tolerance value
+    \param err_count Error counter to increment whenever an infinite loop is encountered
+    \returns The distance that A can move along \a direction before the shapes touch, or
+             \a max_distance when they do not touch within \a max_distance. Overlapping shapes
+             return 0.
+
+    A moved by \a lambda along \a direction touches B when lambda * direction is in the Minkowski
+    difference B - A (grown by \a sweep_radius). This is the GJK ray cast of _Ray Casting against
+    General Convex Objects with Application to Continuous Collision Detection_ (G. van den Bergen,
+    2004), with the sweep radius applied as a margin so that GJK converges in a finite number of
+    iterations on the polyhedral cores. The returned distance never exceeds the exact one, and is
+    within a small tolerance of it, so shapes moved by the returned distance never overlap.
+*/
+template<class SupportFuncA, class SupportFuncB>
+DEVICE inline OverlapReal gjk_sweep_3d(const SupportFuncA& sa,
+                                       const SupportFuncB& sb,
+                                       const vec3<OverlapReal>& ab_t,
+                                       const quat<OverlapReal>& q,
+                                       const vec3<OverlapReal>& direction,
+                                       const OverlapReal sweep_radius,
+                                       const OverlapReal max_distance,
+                                       const OverlapReal R,
+                                       unsigned int& err_count)
+    {
+    CompositeSupportFunc3D<SupportFuncA, SupportFuncB> S(sa, sb, ab_t, q);
+
+    // distance tolerance
+#if defined(SINGLE_PRECISION) || defined(ENABLE_HPMC_MIXED_PRECISION)
+    // square root of the single precision machine epsilon
+    const OverlapReal tol = OverlapReal(3e-4) * R;
+#else
+    const OverlapReal tol = OverlapReal(1e-6) * R;
+#endif
+
+    // the centers are interior points of the shapes, so ab_t is an interior point of B - A
+    vec3<OverlapReal> v = -ab_t;
+    if (dot(v, v) <= tol * tol)
+        return OverlapReal(0.0);
+
+    OverlapReal lambda(0.0);
+    vec3<OverlapReal> x(0, 0, 0);
+    vec3<OverlapReal> y[4];
+    vec3<OverlapReal> p[4];
+    unsigned int n = 0;
+
+    for (unsigned int iteration = 0; iteration < GJK_SWEEP_3D_MAX_ITERATIONS; iteration++)
+        {
+        OverlapReal v_len = fast::sqrt(dot(v, v));
+        if (v_len <= sweep_radius + tol)
+            return lambda;
+
+        vec3<OverlapReal> s = S(v);
+        OverlapReal vw = dot(v, x - s);
+
+        if (vw > sweep_radius * v_len)
+            {
+            // the support plane of s (moved out by the sweep radius) separates x from B - A:
+            // advance x along the ray to the plane
+            OverlapReal vr = dot(v, direction);
+            if (vr >= OverlapReal(0.0))
+                return max_distance;
+
+            lambda -= (vw - sweep_radius * v_len) / vr;
+            if (lambda >= max_distance)
+                return max_distance;
+
+            x = lambda * direction;
+            }
+        else if (v_len - vw / v_len <= tol)
+            {
+            // no progress is possible: x is within the tolerance of the grown B - A
+            return lambda;
+            }
+
+        // add the support point, dropping it when it is already in the simplex
+        bool duplicate = false;
+        for (unsigned int k = 0; k < n; k++)
+            {
+            if (p[k] == s)
+                duplicate = true;
+            }
+        if (!duplicate)
+            {
+            p[n] = s;
+            n++;
+            }
+
+        for (unsigned int k = 0; k < n; k++)
+            y[k] = x - p[k];
+
+        v = gjk_sweep_closest_simplex(y, p, n);
+        }
+
+    // the distance found so far never exceeds the exact one
+    err_count++;
+    return lambda;
+    }
+
+    } // end namespace detail
+    } // end namespace hpmc
+    } // end namespace hoomd
+
+#endif // __GJK_SWEEP_3D_H__
@@ -6,6 +6,17 @@
 #include <string>
 #include <vector>
 
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
 #include "GPUEvalFactory.h"
 
 // pybind11 vector bindings
@@ -23,6 +34,145 @@ namespace hoomd
     {
 namespace hpmc
     {
+#if __HIP_PLATFORM_NVCC__
+namespace
+    {
+//! Hold an exclusive POSIX lock on a file while in scope
+/*! fcntl locks work across nodes on most network file systems, unlike flock.
+ */
+class FileLock
+    {
+    public:
+    //! Open the file and wait for the lock
+    /*! \param filename Name of the lock file (created when it does not exist)
+     */
+    FileLock(const std::string& filename)
+        {
+        m_fd = open(filename.c_str(), O_RDWR | O_CREAT, 0666);
+        if (m_fd < 0)
+            throw std::runtime_error("Unable to open JIT cache lock file " + filename);
+
+        struct flock lock = {};
+        lock.l_type = F_WRLCK;
+        lock.l_whence = SEEK_SET;
+        while (fcntl(m_fd, F_SETLKW, &lock) == -1)
+            {
+            if (errno != EINTR)
+                {
+                close(m_fd);
+                throw std::runtime_error("Unable to lock JIT cache file " + filename);
+                }
+            }
+        }
+
+    //! Release the lock
+    ~FileLock()
+        {
+        struct flock lock = {};
+        lock.l_type = F_UNLCK;
+        lock.l_whence = SEEK_SET;
+        fcntl(m_fd, F_SETLK, &lock);
+        close(m_fd);
+        }
+
+    private:
+    int m_fd; //!< File descriptor of the lock file
+    };
+
+//! Name of a kernel instantiation in the cache
+std::string getInstantiationName(unsigned int eval_threads, unsigned int launch_bounds)
+    {
+    return std::to_string(eval_threads) + "," + std::to_string(launch_bounds);
+    }
+
+    } // end anonymous namespace
+
+/*! \param code Source code of the program
+    \param options Compiler options
+    \returns The serialized kernel instantiations, by name
+
+    Compile all instantiations of the kernel for the (eval_threads, launch_bounds) template
+    parameters. When HOOMD_JIT_CACHE_DIR is set, first look for the kernels in the cache, and
+    store them there after compiling them.
+*/
+std::map<std::string, std::string>
+GPUEvalFactory::compileKernels(const std::string& code, const std::vector<std::string>& options)
+    {
+    cudaSetDevice(m_exec_conf->getGPUIds()[0]);
+
+    // loading the program reads the source of all headers, but does not compile it
+    jitify::experimental::Program program(code, {}, options);
+
+    auto compile = [&]()
+    {
+        std::map<std::string, std::string> kernels;
+        for (auto e : m_eval_threads)
+            {
+            for (auto l : m_launch_bounds)
+                {
+                m_exec_conf->msg->notice(3) << "Compiling nvrtc kernel " << m_kernel_name << "<"
+                                            << e << ", " << l << ">" << std::endl;
+                kernels[getInstantiationName(e, l)]
+                    = program.kernel(m_kernel_name).instantiate(e, l).serialize();
+                }
+            }
+        return kernels;
+    };
+
+    const char* cache_dir = std::getenv("HOOMD_JIT_CACHE_DIR");
+    if (cache_dir == nullptr || std::string(cache_dir).empty())
+        return compile();
+
+    // the key identifies the complete source, the compiler options (including the architecture),
+    // the compiler version, and the kernel
+    std::string key = program.serialize() + "\n" + m_kernel_name + "\n"
+                      + std::to_string(CUDA_VERSION);
+    std::ostringstream hash;
+    hash << std::hex << std::hash<std::string>()(key);
+    std::string path = std::string(cache_dir) + "/hoomd-jit-" + hash.str();
+
+    // one process compiles a given program, the others wait and load the result
+    FileLock lock(path + ".lock");
+
+    std::map<std::string, std::string> kernels;
+    std::ifstream in(path, std::ios::binary);
+    if (in)
+        {
+        std::string contents((std::istreambuf_iterator<char>(in)),
+                             std::istreambuf_iterator<char>());
+        std::string cached_key;
+        bool found = jitify::experimental::serialization::deserialize(contents,
+                                                                      &cached_key,
+                                                                      &kernels)
+                     && cached_key == key;
+        for (auto e : m_eval_threads)
+            for (auto l : m_launch_bounds)
+                found = found && kernels.count(getInstantiationName(e, l));
+
+        if (found)
+            {
+            m_exec_conf->msg->notice(3) << "Loaded nvrtc kernels from " << path << std::endl;
+            return kernels;
+            }
+        }
+
+    kernels = compile();
+
+    // write to a temporary file first so that no process reads a partial cache entry
+    std::string temp_path = path + ".tmp" + std::to_string(getpid());
+        {
+        std::ofstream out(temp_path, std::ios::binary);
+        out << jitify::experimental::serialization::serialize(key, kernels);
+        }
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0)
+        m_exec_conf->msg->warning() << "Unable to write JIT cache file " << path << std::endl;
+    else
+        m_exec_conf->msg->notice(3) << "Wrote nvrtc kernels to " << path << std::endl;
+
+    return kernels;
+    }
+#endif
+
 void GPUEvalFactory::compileGPU(const std::string& code,
                                 const std::string& kernel_name,
                                 const std::vector<std::string>& options,
@@ -64,14 +214,24 @@ void GPUEvalFactory::compileGPU(const std::string& code,
         }
     m_exec_conf->msg->notice(5) << code << std::endl;
 
-    // compile on each GPU, substituting common headers with fake headers
+    // compile once, substituting common headers with fake headers
+    std::map<std::string, std::string> kernels = compileKernels(code, compile_options);
+
+    // load the compiled kernels on each GPU
     auto gpu_map = m_exec_conf->getGPUIds();
-    m_program.clear();
     for (int idev = m_exec_conf->getNumActiveGPUs() - 1; idev >= 0; idev--)
         {
-        m_exec_conf->msg->notice(3) << "Compiling nvrtc code on GPU " << idev << std::endl;
         cudaSetDevice(gpu_map[idev]);
-        m_program.push_back(m_cache[idev].program(code, 0, compile_options));
+        m_kernels[idev].clear();
+        for (auto e : m_eval_threads)
+            {
+            for (auto l : m_launch_bounds)
+                {
+                m_kernels[idev].emplace(kernel_key_t(e, l),
+                                        jitify::experimental::KernelInstantiation::deserialize(
+                                            kernels[getInstantiationName(e, l)]));
+                }
+            }
         }
 
 #endif
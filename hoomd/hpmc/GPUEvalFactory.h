@@ -44,6 +44,13 @@ namespace hpmc
 
     Additionally, it allows access to pointers param_array and alpha_union
     defined at global scope.
+
+    The constructor compiles all template instantiations of the kernel once and loads the
+    result on every active GPU. When the environment variable HOOMD_JIT_CACHE_DIR names a
+    directory, the compiled kernels are also stored there, keyed by the complete program source
+    (including all headers) and the compiler options. The first process to need a given program
+    compiles it while holding a lock on the cache entry; other processes (e.g. the other MPI
+    ranks on the node, or later jobs) wait for the lock and load the stored kernels.
  */
 class GPUEvalFactory
     {
@@ -64,9 +71,8 @@ class GPUEvalFactory
              i *= 2)
             m_launch_bounds.push_back(i);
 
-// instantiate jitify cache
 #ifdef __HIP_PLATFORM_NVCC__
-        m_cache.resize(this->m_exec_conf->getNumActiveGPUs());
+        m_kernels.resize(this->m_exec_conf->getNumActiveGPUs());
 #endif
 
         compileGPU(code, kernel_name, options, cuda_devrt_library_path, compute_arch);
@@ -97,7 +103,7 @@ class GPUEvalFactory
         CUresult custatus = cuFuncGetAttribute(
             &max_threads,
             CU_FUNC_ATTRIBUTE_MAX_THREADS_PER_BLOCK,
-            m_program[idev].kernel(m_kernel_name).instantiate(eval_threads, launch_bounds));
+            getKernel(idev, eval_threads, launch_bounds));
         char* error;
         if (custatus != CUDA_SUCCESS)
             {
@@ -123,7 +129,7 @@ class GPUEvalFactory
         CUresult custatus = cuFuncGetAttribute(
             &shared_size,
             CU_FUNC_ATTRIBUTE_SHARED_SIZE_BYTES,
-            m_program[idev].kernel(m_kernel_name).instantiate(eval_threads, launch_bounds));
+            getKernel(idev, eval_threads, launch_bounds));
         char* error;
         if (custatus != CUDA_SUCCESS)
             {
@@ -145,7 +151,7 @@ class GPUEvalFactory
     \param launch_bounds template parameter
     */
 #ifdef __HIP_PLATFORM_NVCC__
-    jitify::KernelLauncher configureKernel(unsigned int idev,
+    jitify::experimental::KernelLauncher configureKernel(unsigned int idev,
                                            dim3 grid,
                                            dim3 threads,
                                            size_t sharedMemBytes,
@@ -155,9 +161,7 @@ class GPUEvalFactory
         {
         cudaSetDevice(m_exec_conf->getGPUIds()[idev]);
 
-        return m_program[idev]
-            .kernel(m_kernel_name)
-            .instantiate(eval_threads, launch_bounds)
+        return getKernel(idev, eval_threads, launch_bounds)
             .configure(grid, threads, static_cast<unsigned int>(sharedMemBytes), hStream);
         }
 #endif
@@ -179,10 +183,8 @@ class GPUEvalFactory
                 {
                 for (auto l : m_launch_bounds)
                     {
-                    CUdeviceptr ptr = m_program[idev]
-                                          .kernel(m_kernel_name)
-                                          .instantiate(e, l)
-                                          .get_global_ptr(param_array_name.c_str());
+                    CUdeviceptr ptr
+                        = getKernel(idev, e, l).get_global_ptr(param_array_name.c_str());
 
                     // copy the array pointer to the device
                     char* error;
@@ -210,10 +212,8 @@ class GPUEvalFactory
                 {
                 for (auto l : m_launch_bounds)
                     {
-                    CUdeviceptr ptr = m_program[idev]
-                                          .kernel(m_kernel_name)
-                                          .instantiate(e, l)
-                                          .get_global_ptr("param_array_constituent");
+                    CUdeviceptr ptr
+                        = getKernel(idev, e, l).get_global_ptr("param_array_constituent");
 
                     // copy the array pointer to the device
                     char* error;
@@ -241,10 +241,8 @@ class GPUEvalFactory
                 {
                 for (auto l : m_launch_bounds)
                     {
-                    CUdeviceptr ptr = m_program[idev]
-                                          .kernel(m_kernel_name)
-                                          .instantiate(e, l)
-                                          .get_global_ptr("hoomd::hpmc::jit::d_r_cut_constituent");
+                    CUdeviceptr ptr = getKernel(idev, e, l).get_global_ptr(
+                        "hoomd::hpmc::jit::d_r_cut_constituent");
 
                     // copy the array pointer to the device
                     char* error;
@@ -272,10 +270,8 @@ class GPUEvalFactory
                 {
                 for (auto l : m_launch_bounds)
                     {
-                    CUdeviceptr ptr = m_program[idev]
-                                          .kernel(m_kernel_name)
-                                          .instantiate(e, l)
-                                          .get_global_ptr("hoomd::hpmc::jit::d_union_params");
+                    CUdeviceptr ptr
+                        = getKernel(idev, e, l).get_global_ptr("hoomd::hpmc::jit::d_union_params");
 
                     // copy the array pointer to the device
                     char* error;
@@ -305,8 +301,29 @@ class GPUEvalFactory
                     unsigned int compute_arch);
 
 #ifdef __HIP_PLATFORM_NVCC__
-    std::vector<jitify::JitCache> m_cache;  //!< jitify kernel cache, one per GPU
-    std::vector<jitify::Program> m_program; //!< The kernel object, one per GPU
+    //! Key of a kernel instantiation
+    typedef std::pair<unsigned int, unsigned int> kernel_key_t;
+
+    //! Compiled kernel instantiations, one map per GPU
+    std::vector<std::map<kernel_key_t, jitify::experimental::KernelInstantiation>> m_kernels;
+
+    //! Get a compiled kernel instantiation
+    /*! \param idev the logical GPU id
+        \param eval_threads template parameter
+        \param launch_bounds template parameter
+    */
+    const jitify::experimental::KernelInstantiation&
+    getKernel(unsigned int idev, unsigned int eval_threads, unsigned int launch_bounds) const
+        {
+        auto it = m_kernels[idev].find(kernel_key_t(eval_threads, launch_bounds));
+        if (it == m_kernels[idev].end())
+            throw std::runtime_error("JIT kernel instantiation not found.");
+        return it->second;
+        }
+
+    //! Compile all kernel instantiations, or load them from the cache
+    std::map<std::string, std::string> compileKernels(const std::string& code,
+                                                      const std::vector<std::string>& options);
 #endif
     };
 
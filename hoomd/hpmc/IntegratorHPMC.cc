@@ -18,13 +18,17 @@ namespace hpmc
     {
 IntegratorHPMC::IntegratorHPMC(std::shared_ptr<SystemDefinition> sysdef)
     : Integrator(sysdef, 0.005), m_translation_move_probability(32768), m_nselect(4),
-      m_nominal_width(1.0), m_extra_ghost_width(0), m_external_base(NULL), m_past_first_run(false)
+      m_checkerboard(false), m_nominal_width(1.0), m_extra_ghost_width(0), m_external_base(NULL),
+      m_past_first_run(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing IntegratorHPMC" << endl;
 
     GlobalArray<hpmc_counters_t> counters(1, this->m_exec_conf);
     m_count_total.swap(counters);
 
+    GlobalArray<hpmc_counters_t> count_step_start(1, this->m_exec_conf);
+    m_count_step_start.swap(count_step_start);
+
     GPUVector<Scalar> d(this->m_pdata->getNTypes(), this->m_exec_conf);
     m_d.swap(d);
 
@@ -114,6 +118,8 @@ bool IntegratorHPMC::checkParticleOrientations()
     and check for overlaps
 
     \param newBox new box dimensions
+    \param check_overlaps Set to false to skip the overlap check when the caller has already shown
+           that the scaling cannot create overlaps
 
     \note The particle positions and the box dimensions are updated in any case, even if the
     new box dimensions result in overlaps. To restore old particle positions,
@@ -121,43 +127,75 @@ bool IntegratorHPMC::checkParticleOrientations()
 
     \returns false if resize results in overlaps
 */
-bool IntegratorHPMC::attemptBoxResize(uint64_t timestep, const BoxDim& new_box)
+bool IntegratorHPMC::attemptBoxResize(uint64_t timestep,
+                                      const BoxDim& new_box,
+                                      bool check_overlaps)
     {
-    unsigned int N = m_pdata->getN();
+    // move the particles to be inside the new box
+    scaleParticles(m_pdata->getGlobalBox(), new_box);
+
+    m_pdata->setGlobalBox(new_box);
+
+    // we have moved particles, communicate those changes
+    this->communicate(false);
+
+    if (!check_overlaps)
+        return true;
+
+    // check overlaps
+    return !this->countOverlaps(true);
+    }
 
-    // Get old and new boxes;
-    BoxDim curBox = m_pdata->getGlobalBox();
+/*! \param old_box Global box the particles are currently in
+    \param new_box Global box to scale the particles to
+*/
+void IntegratorHPMC::scaleParticles(const BoxDim& old_box, const BoxDim& new_box)
+    {
+    unsigned int N = m_pdata->getN();
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                               access_location::host,
+                               access_mode::readwrite);
 
-        // Use lexical scope block to make sure ArrayHandles get cleaned up
+    for (unsigned int i = 0; i < N; i++)
         {
-        // Get particle positions
-        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::readwrite);
+        Scalar3 old_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
 
-        // move the particles to be inside the new box
-        for (unsigned int i = 0; i < N; i++)
-            {
-            Scalar3 old_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        // obtain scaled coordinates in the old global box
+        Scalar3 f = old_box.makeFraction(old_pos);
 
-            // obtain scaled coordinates in the old global box
-            Scalar3 f = curBox.makeFraction(old_pos);
+        // scale particles
+        Scalar3 scaled_pos = new_box.makeCoordinates(f);
+        h_pos.data[i].x = scaled_pos.x;
+        h_pos.data[i].y = scaled_pos.y;
+        h_pos.data[i].z = scaled_pos.z;
+        }
+    }
 
-            // scale particles
-            Scalar3 scaled_pos = new_box.makeCoordinates(f);
-            h_pos.data[i].x = scaled_pos.x;
-            h_pos.data[i].y = scaled_pos.y;
-            h_pos.data[i].z = scaled_pos.z;
-            }
-        } // end lexical scope
+/*! \param overlap_count Number of overlaps found on this rank
+    \param early_exit True when the caller only needs to know whether there is any overlap
+    \returns The number of overlaps on all ranks, or 1 when early_exit is set and any rank has one
 
-    m_pdata->setGlobalBox(new_box);
+    With early_exit, the ranks reduce a single flag with MPI_MAX. The local count may be partial in
+    that case, so the sum over the ranks would not be meaningful anyway.
+*/
+unsigned int IntegratorHPMC::reduceOverlapCount(unsigned int overlap_count, bool early_exit)
+    {
+    if (early_exit)
+        overlap_count = overlap_count > 0;
 
-    // we have moved particles, communicate those changes
-    this->communicate(false);
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &overlap_count,
+                      1,
+                      MPI_UNSIGNED,
+                      early_exit ? MPI_MAX : MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
 
-    // check overlaps
-    return !this->countOverlaps(true);
+    return overlap_count;
     }
 
 /*! \param mode 0 -> Absolute count, 1 -> relative to the start of the run, 2 -> relative to the
@@ -176,11 +214,20 @@ hpmc_counters_t IntegratorHPMC::getCounters(unsigned int mode)
     hpmc_counters_t result;
 
     if (mode == 0)
+        {
         result = h_counters.data[0];
+        }
     else if (mode == 1)
+        {
         result = h_counters.data[0] - m_count_run_start;
+        }
     else
-        result = h_counters.data[0] - m_count_step_start;
+        {
+        ArrayHandle<hpmc_counters_t> h_count_step_start(m_count_step_start,
+                                                        access_location::host,
+                                                        access_mode::read);
+        result = h_counters.data[0] - h_count_step_start.data[0];
+        }
 
 #ifdef ENABLE_MPI
     if (m_sysdef->isDomainDecomposed())
@@ -249,6 +296,9 @@ void export_IntegratorHPMC(pybind11::module& m)
         .def("getCounters", &IntegratorHPMC::getCounters)
         .def("communicate", &IntegratorHPMC::communicate)
         .def_property("nselect", &IntegratorHPMC::getNSelect, &IntegratorHPMC::setNSelect)
+        .def_property("checkerboard",
+                      &IntegratorHPMC::getCheckerboard,
+                      &IntegratorHPMC::setCheckerboard)
         .def_property("translation_move_probability",
                       &IntegratorHPMC::getTranslationMoveProbability,
                       &IntegratorHPMC::setTranslationMoveProbability);
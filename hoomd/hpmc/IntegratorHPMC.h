@@ -25,6 +25,7 @@
 #endif
 
 #ifdef ENABLE_HIP
+#include "PatchEnergyGPUTypes.cuh"
 #include "hoomd/Autotuner.h"
 #include "hoomd/GPUPartition.cuh"
 #endif
@@ -33,85 +34,6 @@ namespace hoomd
     {
 namespace hpmc
     {
-namespace detail
-    {
-#ifdef ENABLE_HIP
-//! Wraps arguments to kernel::narow_phase_patch functions
-struct hpmc_patch_args_t
-    {
-    //! Construct a hpmc_patch_args_t
-    hpmc_patch_args_t(const Scalar4* _d_postype,
-                      const Scalar4* _d_orientation,
-                      const Scalar4* _d_trial_postype,
-                      const Scalar4* _d_trial_orientation,
-                      const unsigned int* _d_trial_move_type,
-                      const Index3D& _ci,
-                      const uint3& _cell_dim,
-                      const Scalar3& _ghost_width,
-                      const unsigned int _N,
-                      const uint16_t _seed,
-                      const unsigned int _rank,
-                      const uint64_t _timestep,
-                      const unsigned int _select,
-                      const unsigned int _num_types,
-                      const BoxDim& _box,
-                      const unsigned int* _d_excell_idx,
-                      const unsigned int* _d_excell_size,
-                      const Index2D& _excli,
-                      const Scalar _r_cut_patch,
-                      const Scalar* _d_additive_cutoff,
-                      const unsigned int* _d_update_order_by_ptl,
-                      const unsigned int* _d_reject_in,
-                      unsigned int* _d_reject_out,
-                      const Scalar* _d_charge,
-                      const Scalar* _d_diameter,
-                      const unsigned int* _d_reject_out_of_cell,
-                      const GPUPartition& _gpu_partition)
-        : d_postype(_d_postype), d_orientation(_d_orientation), d_trial_postype(_d_trial_postype),
-          d_trial_orientation(_d_trial_orientation), d_trial_move_type(_d_trial_move_type), ci(_ci),
-          cell_dim(_cell_dim), ghost_width(_ghost_width), N(_N), seed(_seed), rank(_rank),
-          timestep(_timestep), select(_select), num_types(_num_types), box(_box),
-          d_excell_idx(_d_excell_idx), d_excell_size(_d_excell_size), excli(_excli),
-          r_cut_patch(_r_cut_patch), d_additive_cutoff(_d_additive_cutoff),
-          d_update_order_by_ptl(_d_update_order_by_ptl), d_reject_in(_d_reject_in),
-          d_reject_out(_d_reject_out), d_charge(_d_charge), d_diameter(_d_diameter),
-          d_reject_out_of_cell(_d_reject_out_of_cell), gpu_partition(_gpu_partition)
-        {
-        }
-
-    const Scalar4* d_postype;              //!< postype array
-    const Scalar4* d_orientation;          //!< orientation array
-    const Scalar4* d_trial_postype;        //!< New positions (and type) of particles
-    const Scalar4* d_trial_orientation;    //!< New orientations of particles
-    const unsigned int* d_trial_move_type; //!< 0=no move, 1/2 = translate/rotate
-    const Index3D& ci;                     //!< Cell indexer
-    const uint3& cell_dim;                 //!< Cell dimensions
-    const Scalar3& ghost_width;            //!< Width of the ghost layer
-    const unsigned int N;                  //!< Number of particles
-    const uint16_t seed;                   //!< RNG seed
-    const unsigned int rank;               //!< MPI Rank
-    const uint64_t timestep;               //!< Current timestep
-    const unsigned int select;
-    const unsigned int num_types;              //!< Number of particle types
-    const BoxDim& box;                         //!< Current simulation box
-    const unsigned int* d_excell_idx;          //!< Expanded cell list
-    const unsigned int* d_excell_size;         //!< Size of expanded cells
-    const Index2D& excli;                      //!< Excell indexer
-    const Scalar r_cut_patch;                  //!< Global cutoff radius
-    const Scalar* d_additive_cutoff;           //!< Additive contribution to cutoff per type
-    const unsigned int* d_update_order_by_ptl; //!< Order of the update sequence
-    const unsigned int* d_reject_in;           //!< Previous reject flags
-    unsigned int* d_reject_out;                //!< New reject flags
-    const Scalar* d_charge;                    //!< Particle charges
-    const Scalar* d_diameter;                  //!< Particle diameters
-    const unsigned int*
-        d_reject_out_of_cell;          //!< Flag if a particle move has been rejected a priori
-    const GPUPartition& gpu_partition; //!< split particles among GPUs
-    };
-#endif
-
-    } // end namespace detail
-
 //! Functor that computes patch interactions between particles
 /*! PatchEnergy allows cutoff energetic interactions to be included in an HPMC simulation. This
     abstract base class defines the API for the patch energy object, consisting of cutoff radius
@@ -218,7 +140,10 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         ArrayHandle<hpmc_counters_t> h_counters(m_count_total,
                                                 access_location::host,
                                                 access_mode::read);
-        m_count_step_start = h_counters.data[0];
+        ArrayHandle<hpmc_counters_t> h_count_step_start(m_count_step_start,
+                                                        access_location::host,
+                                                        access_mode::overwrite);
+        h_count_step_start.data[0] = h_counters.data[0];
         }
 
     //! Change maximum displacement
@@ -339,10 +264,29 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         return m_nselect;
         }
 
+    //! Set whether to sweep the CPU trial moves in parallel over a checkerboard of cells
+    void setCheckerboard(bool checkerboard)
+        {
+        m_checkerboard = checkerboard;
+        }
+
+    //! Get whether to sweep the CPU trial moves in parallel over a checkerboard of cells
+    bool getCheckerboard()
+        {
+        return m_checkerboard;
+        }
+
     //! Get performance in moves per second
+    /*! The counters are read only when this is called, so integrators need not synchronize with
+        the GPU at the end of every step.
+    */
     virtual double getMPS()
         {
-        return m_mps;
+        if (m_last_step_time == 0)
+            return 0;
+
+        hpmc_counters_t run_counters = getCounters(1);
+        return double(run_counters.getNMoves()) / (double(m_last_step_time) / Scalar(1e9));
         }
 
     //! Reset statistics counters
@@ -353,6 +297,7 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
                                                 access_mode::read);
         m_count_run_start = h_counters.data[0];
         m_clock = ClockSource();
+        m_last_step_time = 0;
         }
 
     //! Get the diameter of the largest circumscribing sphere for objects handled by this integrator
@@ -410,7 +355,31 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         updateCellWidth();
         }
     //! Method to scale the box
-    virtual bool attemptBoxResize(uint64_t timestep, const BoxDim& new_box);
+    virtual bool
+    attemptBoxResize(uint64_t timestep, const BoxDim& new_box, bool check_overlaps = true);
+
+    //! Test whether a linear transformation of the box can create overlaps
+    /*! \param sigma_min Smallest singular value of the linear map from the current to the new box
+        \returns true when every pair of particle circumspheres is guaranteed to remain disjoint
+                 after all pair separations are scaled by at least \a sigma_min
+
+        The base class cannot give this guarantee and returns false.
+    */
+    virtual bool testCircumspheresAfterScaling(Scalar sigma_min)
+        {
+        return false;
+        }
+
+    //! Compute the largest uniform compression that creates no overlaps
+    /*! \param max_lambda Largest scale factor of interest, in the range [0,1)
+        \returns lambda such that scaling every pair separation by (1 - lambda) creates no overlaps
+
+        The base class cannot compute this and returns 0.
+    */
+    virtual Scalar computeContactScale(Scalar max_lambda)
+        {
+        return 0;
+        }
 
     ExternalField* getExternalField()
         {
@@ -449,18 +418,20 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
     protected:
     unsigned int m_translation_move_probability; //!< Fraction of moves that are translation moves.
     unsigned int m_nselect;                      //!< Number of particles to select for trial moves
+    bool m_checkerboard;                         //!< True to sweep CPU moves over a checkerboard
 
     GPUVector<Scalar> m_d; //!< Maximum move displacement by type
     GPUVector<Scalar> m_a; //!< Maximum angular displacement by type
 
-    GlobalArray<hpmc_counters_t> m_count_total; //!< Accept/reject total count
+    GlobalArray<hpmc_counters_t> m_count_total;      //!< Accept/reject total count
+    GlobalArray<hpmc_counters_t> m_count_step_start; //!< Count saved at the start of the last step
 
     Scalar m_nominal_width;     //!< nominal cell width
     Scalar m_extra_ghost_width; //!< extra ghost width to add
     ClockSource m_clock;        //!< Timer for self-benchmarking
 
-    /// Moves-per-second value last recorded
-    double m_mps = 0;
+    /// Time on m_clock at the end of the last step, in nanoseconds
+    int64_t m_last_step_time = 0;
 
     ExternalField* m_external_base; //! This is a cast of the derived class's m_external that can be
                                     //! used in a more general setting.
@@ -480,6 +451,12 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         return Scalar(0.0);
         }
 
+    //! Scale the local particle positions from one global box to another
+    virtual void scaleParticles(const BoxDim& old_box, const BoxDim& new_box);
+
+    //! Combine the overlap counts of all ranks
+    unsigned int reduceOverlapCount(unsigned int overlap_count, bool early_exit);
+
 #ifdef ENABLE_MPI
     //! Return the requested communication flags for ghost particles
     virtual CommFlags getCommFlags(uint64_t timestep)
@@ -490,8 +467,7 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
 #endif
 
     private:
-    hpmc_counters_t m_count_run_start;  //!< Count saved at run() start
-    hpmc_counters_t m_count_step_start; //!< Count saved at the start of the last step
+    hpmc_counters_t m_count_run_start; //!< Count saved at run() start
     };
 
 namespace detail
@@ -25,6 +25,7 @@
 #include "hoomd/managed_allocator.h"
 #include "hoomd/GSDShapeSpecWriter.h"
 #include "ShapeSpheropolyhedron.h"
+#include "ContactScale.h"
 
 #ifdef ENABLE_TBB
 #include <thread>
@@ -230,7 +231,13 @@ class IntegratorHPMCMono : public IntegratorHPMC
         virtual std::vector<hpmc_implicit_counters_t> getImplicitCounters(unsigned int mode=0);
 
         //! Method to scale the box
-        virtual bool attemptBoxResize(uint64_t timestep, const BoxDim& new_box);
+        virtual bool attemptBoxResize(uint64_t timestep, const BoxDim& new_box, bool check_overlaps=true);
+
+        //! Test whether a linear transformation of the box can create overlaps
+        virtual bool testCircumspheresAfterScaling(Scalar sigma_min);
+
+        //! Compute the largest uniform compression that creates no overlaps
+        virtual Scalar computeContactScale(Scalar max_lambda);
 
         /*
          * Common HPMC API
@@ -277,6 +284,14 @@ class IntegratorHPMCMono : public IntegratorHPMC
             return m_overlaps;
             }
 
+        //! Get the version of the shape parameters and interaction matrix
+        /*! The version changes every time setParam() or setInteractionMatrix() is called.
+        */
+        uint64_t getParamVersion() const
+            {
+            return m_param_version;
+            }
+
         //! Get the indexer for the interaction matrix
         virtual const Index2D& getOverlapIndexer()
             {
@@ -431,7 +446,12 @@ class IntegratorHPMCMono : public IntegratorHPMC
             return m_image_hkl;
             }
 
-        void invalidateAABBTree(){ m_aabb_tree_invalid = true; }
+        //! Invalidate the AABB tree after moving particles
+        void invalidateAABBTree()
+            {
+            m_aabb_tree_invalid = true;
+            m_pdata->notifyPositionsChanged();
+            }
 
         //! Method that is called whenever the GSD file is written if connected to a GSD file.
         int slotWriteGSDState(gsd_handle&, std::string name) const;
@@ -478,15 +498,21 @@ class IntegratorHPMCMono : public IntegratorHPMC
         std::vector<vec3<Scalar> > m_image_list;             //!< List of potentially interacting simulation box images
         std::vector<int3> m_image_hkl;               //!< List of potentially interacting simulation box images (integer shifts)
         unsigned int m_image_list_rebuilds;                  //!< Number of times the image list has been rebuilt
+        Scalar m_image_list_range;                           //!< Interaction range covered by the image list
         bool m_image_list_warning_issued;                    //!< True if the image list warning has been issued
         bool m_hkl_max_warning_issued;                       //!< True if the image list size warning has been issued
         bool m_hasOrientation;                               //!< true if there are any orientable particles in the system
 
         std::shared_ptr< ExternalFieldMono<Shape> > m_external;//!< External Field
         hoomd::detail::AABBTree m_aabb_tree;               //!< Bounding volume hierarchy for overlap checks
-        hoomd::detail::AABB* m_aabbs;                      //!< list of AABBs, one per particle
+        hoomd::detail::AABB* m_aabbs;                      //!< list of world-space AABBs, one per particle, kept in sync with the tree
         unsigned int m_aabbs_capacity;              //!< Capacity of m_aabbs list
         bool m_aabb_tree_invalid;                   //!< Flag if the aabb tree has been invalidated
+        uint64_t m_aabb_tree_version;               //!< Position version the aabb tree was built at
+        uint64_t m_param_version;                   //!< Version of the parameters and interaction matrix
+
+        //! Index of the neighbor that each particle last overlapped, and the witness of that overlap
+        std::vector<uint3> m_overlap_witness;
 
         Scalar m_extra_image_width;                 //! Extra width to extend the image list
 
@@ -515,9 +541,26 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Grow the m_aabbs list
         virtual void growAABBList(unsigned int N);
 
+        //! Compute the bounding box of a particle that is stored in m_aabbs
+        inline hoomd::detail::AABB computeParticleAABB(const Shape& shape, const vec3<Scalar>& pos, unsigned int typ);
+
         //! Limit the maximum move distances
         virtual void limitMoveDistances();
 
+        std::vector<unsigned int> m_checkerboard_cell;           //!< Checkerboard cell of each particle
+        std::vector<unsigned int> m_checkerboard_cell_start;     //!< First entry of each cell in m_checkerboard_cell_particles
+        std::vector<unsigned int> m_checkerboard_cell_particles; //!< Particles ordered by cell
+        std::vector<unsigned int> m_checkerboard_color_start;    //!< First entry of each color in m_checkerboard_cells
+        std::vector<unsigned int> m_checkerboard_cells;          //!< Cells ordered by color
+        std::vector<char> m_checkerboard_moved;                  //!< Flags the particles moved in the current color
+
+        //! Get the number of checkerboard cells along each box vector
+        uint3 getCheckerboardDim(const BoxDim& box);
+
+        //! Sweep trial moves in parallel over a checkerboard of cells
+        void checkerboardSweep(uint64_t timestep, unsigned int i_nselect, uint3 dim,
+            const unsigned int *h_overlaps, hpmc_counters_t& counters);
+
         //! callback so that the box change signal can invalidate the image list
         virtual void slotBoxChanged()
             {
@@ -566,12 +609,15 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
     m_pdata->getParticleSortSignal().template connect<IntegratorHPMCMono<Shape>, &IntegratorHPMCMono<Shape>::slotSorted>(this);
 
     m_image_list_rebuilds = 0;
+    m_image_list_range = 0.0;
     m_image_list_warning_issued = false;
     m_hkl_max_warning_issued = false;
 
     m_aabbs = NULL;
     m_aabbs_capacity = 0;
     m_aabb_tree_invalid = true;
+    m_aabb_tree_version = 0;
+    m_param_version = 0;
 
     m_depletant_idx = Index2D(this->m_pdata->getNTypes());
     m_fugacity.resize(m_depletant_idx.getNumElements(), 0.0);
@@ -666,6 +712,10 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     m_update_order.resize(m_pdata->getN());
     m_update_order.shuffle(timestep, m_sysdef->getSeed(), m_exec_conf->getRank());
 
+    // the witnesses are only hints, reset them when the number of particles changes
+    if (m_overlap_witness.size() != m_pdata->getN())
+        m_overlap_witness.assign(m_pdata->getN(), make_uint3(UINT_MAX, UINT_MAX, UINT_MAX));
+
     // update the AABB Tree
     buildAABBTree();
     // limit m_d entries so that particles cannot possibly wander more than one box image in one time step
@@ -701,9 +751,20 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     // access interaction matrix
     ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
 
+    // sweep over a checkerboard of cells when requested and the system only has hard interactions
+    uint3 checkerboard_dim = make_uint3(0,0,0);
+    if (m_checkerboard && !has_depletants && !m_patch && !m_external)
+        checkerboard_dim = getCheckerboardDim(box);
+
     // loop over local particles nselect times
     for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
         {
+        if (checkerboard_dim.x > 0)
+            {
+            checkerboardSweep(timestep, i_nselect, checkerboard_dim, h_overlaps.data, counters);
+            continue;
+            }
+
         // access particle data and system box
         ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
         ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
@@ -799,6 +860,9 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                 r_cut_patch-getMinCoreDiameter()/(OverlapReal)2.0);
             hoomd::detail::AABB aabb_i_local = hoomd::detail::AABB(vec3<Scalar>(0,0,0),R_query);
 
+            // tight bounding box of the trial configuration to test against the cached neighbor boxes
+            hoomd::detail::AABB aabb_i_shape_local = shape_i.getAABB(vec3<Scalar>(0,0,0));
+
             // patch + field interaction deltaU
             double patch_field_energy_diff = 0;
 
@@ -810,6 +874,8 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                 vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
                 hoomd::detail::AABB aabb = aabb_i_local;
                 aabb.translate(pos_i_image);
+                hoomd::detail::AABB aabb_i_shape = aabb_i_shape_local;
+                aabb_i_shape.translate(pos_i_image);
 
                 // stackless search
                 for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
@@ -826,12 +892,16 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                                 Scalar4 postype_j;
                                 Scalar4 orientation_j;
 
+                                // the cached box of particle j, not valid for the trial configuration of i
+                                bool bounds_overlap = true;
+
                                 // handle j==i situations
                                 if ( j != i )
                                     {
                                     // load the position and orientation of the j particle
                                     postype_j = h_postype.data[j];
                                     orientation_j = h_orientation.data[j];
+                                    bounds_overlap = detail::overlap(m_aabbs[j], aabb_i_shape);
                                     }
                                 else
                                     {
@@ -859,11 +929,18 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                                     rcut = r_cut_patch + 0.5 *
                                         static_cast<OverlapReal>(m_patch->getAdditiveCutoff(typ_j));
 
+                                // start from the witness of the last overlap with j
+                                uint2 witness = make_uint2(UINT_MAX, UINT_MAX);
+                                if (m_overlap_witness[i].x == j)
+                                    witness = make_uint2(m_overlap_witness[i].y, m_overlap_witness[i].z);
+
                                 counters.overlap_checks++;
                                 if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
+                                    && bounds_overlap
                                     && check_circumsphere_overlap(r_ij, shape_i, shape_j)
-                                    && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                                    && test_overlap_witness(r_ij, shape_i, shape_j, counters.overlap_err_count, witness))
                                     {
+                                    m_overlap_witness[i] = make_uint3(j, witness.x, witness.y);
                                     overlap = true;
                                     break;
                                     }
@@ -1009,6 +1086,7 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                 hoomd::detail::AABB aabb = aabb_i_local;
                 aabb.translate(pos_i);
                 m_aabb_tree.update(i, aabb);
+                m_aabbs[i] = computeParticleAABB(shape_i, pos_i, typ_i);
 
                 // update position of particle
                 h_postype.data[i] = make_scalar4(pos_i.x,pos_i.y,pos_i.z,postype_i.w);
@@ -1084,11 +1162,436 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
 
     // all particle have been moved, the aabb tree is now invalid
     m_aabb_tree_invalid = true;
+    m_pdata->notifyPositionsChanged();
+
+    // getMPS() evaluates the moves per second up to this time
+    m_last_step_time = m_clock.getTime();
+    }
+
+/*! \param box Local simulation box
+    \returns The number of cells along each box vector, or 0 if the box is too small
+
+    Cells are at least m_nominal_width wide. Periodic directions need an even number of cells so that
+    the cells on both sides of the boundary have different colors.
+*/
+template <class Shape>
+uint3 IntegratorHPMCMono<Shape>::getCheckerboardDim(const BoxDim& box)
+    {
+    // limit the memory used by empty cells when the particles are small
+    const Scalar max_dim = 128;
 
-    // set current MPS value
-    hpmc_counters_t run_counters = getCounters(1);
-    double cur_time = double(m_clock.getTime()) / Scalar(1e9);
-    m_mps = double(run_counters.getNMoves()) / cur_time;
+    Scalar3 npd = box.getNearestPlaneDistance();
+    uchar3 periodic = box.getPeriodic();
+    Scalar width = m_nominal_width > Scalar(0.0) ? m_nominal_width : Scalar(1.0);
+
+    unsigned int dim[3];
+    Scalar npd_i[3] = {npd.x, npd.y, npd.z};
+    bool periodic_i[3] = {periodic.x != 0, periodic.y != 0, periodic.z != 0};
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+    for (unsigned int d = 0; d < 3; d++)
+        {
+        if (d == 2 && ndim == 2)
+            {
+            dim[d] = 1;
+            continue;
+            }
+
+        dim[d] = (unsigned int)(std::min(slow::floor(npd_i[d] / width), max_dim));
+        if (periodic_i[d])
+            {
+            dim[d] -= dim[d] % 2;
+            if (dim[d] < 2)
+                return make_uint3(0,0,0);
+            }
+        else if (dim[d] < 1)
+            {
+            dim[d] = 1;
+            }
+        }
+
+    return make_uint3(dim[0], dim[1], dim[2]);
+    }
+
+/*! \param timestep Current time step
+    \param i_nselect Index of the sweep in the time step
+    \param dim Number of cells along each box vector, from getCheckerboardDim()
+    \param h_overlaps Interaction matrix
+    \param counters Counters to add the trial moves to
+
+    The cells are divided into 2^d colors by the parity of their indices, so cells of one color are
+    separated by at least one cell of another color. Colors are processed one at a time in a random
+    order, and the cells of a color in parallel. Trial moves that would leave the cell are rejected,
+    as in IntegratorHPMCMonoGPU, so particles of different cells of the same color can never
+    interact and the moves in each cell are independent, which preserves detailed balance. The grid
+    is shifted randomly in the periodic directions every sweep so that all moves are possible.
+
+    Particles in the neighboring cells are fixed while a color is processed. Overlaps with them are
+    found with the AABB tree, which is updated with the accepted moves after each color. Overlaps
+    with the particles in the same cell are checked directly because these move during the color.
+
+    Only hard particle interactions are supported: no depletants, patch energies, or external fields.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::checkerboardSweep(uint64_t timestep, unsigned int i_nselect, uint3 dim,
+    const unsigned int *h_overlaps, hpmc_counters_t& counters)
+    {
+    const BoxDim& box = m_pdata->getBox();
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+    unsigned int N = m_pdata->getN();
+    uint16_t seed = m_sysdef->getSeed();
+    Index3D cell_indexer(dim.x, dim.y, dim.z);
+    unsigned int n_cells = cell_indexer.getNumElements();
+    unsigned int n_colors = ndim == 3 ? 8 : 4;
+
+    #ifdef ENABLE_MPI
+    // compute the width of the active region
+    Scalar3 ghost_fraction = m_nominal_width / box.getNearestPlaneDistance();
+    #endif
+
+    // shift the grid and shuffle the order of the colors
+    hoomd::RandomGenerator rng(hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoCheckerboard, timestep, seed),
+                               hoomd::Counter(m_exec_conf->getRank(), i_nselect));
+    uchar3 periodic = box.getPeriodic();
+    hoomd::UniformDistribution<Scalar> uniform(Scalar(0.0), Scalar(1.0));
+    Scalar3 grid_shift = make_scalar3(0,0,0);
+    if (periodic.x)
+        grid_shift.x = uniform(rng) / Scalar(dim.x);
+    if (periodic.y)
+        grid_shift.y = uniform(rng) / Scalar(dim.y);
+    if (periodic.z && ndim == 3)
+        grid_shift.z = uniform(rng) / Scalar(dim.z);
+
+    unsigned int color_order[8];
+    for (unsigned int c = 0; c < n_colors; c++)
+        color_order[c] = c;
+    for (unsigned int c = n_colors - 1; c > 0; c--)
+        std::swap(color_order[c], color_order[hoomd::UniformIntDistribution(c)(rng)]);
+
+    // find the cell of a position, the grid wraps around in periodic directions
+    auto get_cell = [&](const vec3<Scalar>& pos)
+        {
+        Scalar3 f = box.makeFraction(vec_to_scalar3(pos)) + grid_shift;
+        int c[3] = {int(slow::floor(f.x * Scalar(dim.x))),
+                    int(slow::floor(f.y * Scalar(dim.y))),
+                    int(slow::floor(f.z * Scalar(dim.z)))};
+        int n[3] = {int(dim.x), int(dim.y), int(dim.z)};
+        bool p[3] = {periodic.x != 0, periodic.y != 0, periodic.z != 0};
+        for (unsigned int d = 0; d < 3; d++)
+            {
+            if (p[d])
+                c[d] = ((c[d] % n[d]) + n[d]) % n[d];
+            else
+                c[d] = std::max(0, std::min(c[d], n[d] - 1));
+            }
+        return cell_indexer((unsigned int)c[0], (unsigned int)c[1], (unsigned int)c[2]);
+        };
+
+    auto get_color = [&](unsigned int cell)
+        {
+        unsigned int x = cell % dim.x;
+        unsigned int y = (cell / dim.x) % dim.y;
+        unsigned int z = cell / (dim.x * dim.y);
+        return (x & 1) | ((y & 1) << 1) | ((z & 1) << 2);
+        };
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::read);
+
+    // sort the particles into the cells in the shuffled order
+    m_checkerboard_cell.resize(N);
+    m_checkerboard_cell_start.assign(n_cells + 1, 0);
+    m_checkerboard_cell_particles.resize(N);
+    m_checkerboard_moved.assign(N, 0);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        m_checkerboard_cell[i] = get_cell(vec3<Scalar>(h_postype.data[i]));
+        m_checkerboard_cell_start[m_checkerboard_cell[i] + 1]++;
+        }
+    for (unsigned int cell = 0; cell < n_cells; cell++)
+        m_checkerboard_cell_start[cell + 1] += m_checkerboard_cell_start[cell];
+
+    std::vector<unsigned int> cell_size(n_cells, 0);
+    for (unsigned int cur_particle = 0; cur_particle < N; cur_particle++)
+        {
+        unsigned int i = m_update_order[cur_particle];
+        unsigned int cell = m_checkerboard_cell[i];
+        m_checkerboard_cell_particles[m_checkerboard_cell_start[cell] + cell_size[cell]++] = i;
+        }
+
+    // sort the cells by color
+    m_checkerboard_color_start.assign(n_colors + 1, 0);
+    m_checkerboard_cells.resize(n_cells);
+    for (unsigned int cell = 0; cell < n_cells; cell++)
+        m_checkerboard_color_start[get_color(cell) + 1]++;
+    for (unsigned int c = 0; c < n_colors; c++)
+        m_checkerboard_color_start[c + 1] += m_checkerboard_color_start[c];
+
+    unsigned int color_size[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for (unsigned int cell = 0; cell < n_cells; cell++)
+        {
+        unsigned int c = get_color(cell);
+        m_checkerboard_cells[m_checkerboard_color_start[c] + color_size[c]++] = cell;
+        }
+
+    // attempt trial moves for all particles in the cells [begin, end) of one color
+    auto sweep_cells = [&](unsigned int color, unsigned int begin, unsigned int end,
+                           hpmc_counters_t& cell_counters)
+        {
+        for (unsigned int cur_cell = begin; cur_cell < end; cur_cell++)
+            {
+            unsigned int cell = m_checkerboard_cells[cur_cell];
+            unsigned int cell_begin = m_checkerboard_cell_start[cell];
+            unsigned int cell_end = m_checkerboard_cell_start[cell + 1];
+
+            for (unsigned int cur_particle = cell_begin; cur_particle < cell_end; cur_particle++)
+                {
+                unsigned int i = m_checkerboard_cell_particles[cur_particle];
+
+                // read in the current position and orientation
+                Scalar4 postype_i = h_postype.data[i];
+                Scalar4 orientation_i = h_orientation.data[i];
+                vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+                #ifdef ENABLE_MPI
+                if (m_sysdef->isDomainDecomposed())
+                    {
+                    // only move particle if active
+                    if (!isActive(make_scalar3(postype_i.x, postype_i.y, postype_i.z), box, ghost_fraction))
+                        continue;
+                    }
+                #endif
+
+                // make a trial move for i
+                hoomd::RandomGenerator rng_i(hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoTrialMove, timestep, seed),
+                                             hoomd::Counter(i, m_exec_conf->getRank(), i_nselect));
+                int typ_i = __scalar_as_int(postype_i.w);
+                Shape shape_i(quat<Scalar>(orientation_i), m_params[typ_i]);
+                unsigned int move_type_select = hoomd::UniformIntDistribution(0xffff)(rng_i);
+                bool move_type_translate = !shape_i.hasOrientation() || (move_type_select < m_translation_move_probability);
+
+                if (move_type_translate)
+                    {
+                    // skip if no overlap check is required
+                    if (h_d.data[typ_i] == 0.0)
+                        {
+                        if (!shape_i.ignoreStatistics())
+                            cell_counters.translate_accept_count++;
+                        continue;
+                        }
+
+                    move_translate(pos_i, rng_i, h_d.data[typ_i], ndim);
+
+                    #ifdef ENABLE_MPI
+                    if (m_sysdef->isDomainDecomposed())
+                        {
+                        // check if particle has moved into the ghost layer, and skip if it is
+                        if (!isActive(vec_to_scalar3(pos_i), box, ghost_fraction))
+                            continue;
+                        }
+                    #endif
+
+                    // reject moves out of the cell
+                    if (get_cell(pos_i) != cell)
+                        {
+                        if (!shape_i.ignoreStatistics())
+                            cell_counters.translate_reject_count++;
+                        continue;
+                        }
+                    }
+                else
+                    {
+                    if (h_a.data[typ_i] == 0.0)
+                        {
+                        if (!shape_i.ignoreStatistics())
+                            cell_counters.rotate_accept_count++;
+                        continue;
+                        }
+
+                    if (ndim == 2)
+                        move_rotate<2>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+                    else
+                        move_rotate<3>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+                    }
+
+                // test the overlap of the trial configuration with particle j
+                bool overlap = false;
+                auto test_pair = [&](unsigned int j, const vec3<Scalar>& pos_i_image,
+                                     const Scalar4& postype_j, const Scalar4& orientation_j,
+                                     bool bounds_overlap)
+                    {
+                    vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                    unsigned int typ_j = __scalar_as_int(postype_j.w);
+                    Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+
+                    // start from the witness of the last overlap with j
+                    uint2 witness = make_uint2(UINT_MAX, UINT_MAX);
+                    if (m_overlap_witness[i].x == j)
+                        witness = make_uint2(m_overlap_witness[i].y, m_overlap_witness[i].z);
+
+                    cell_counters.overlap_checks++;
+                    if (h_overlaps[m_overlap_idx(typ_i, typ_j)]
+                        && bounds_overlap
+                        && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                        && test_overlap_witness(r_ij, shape_i, shape_j, cell_counters.overlap_err_count, witness))
+                        {
+                        m_overlap_witness[i] = make_uint3(j, witness.x, witness.y);
+                        return true;
+                        }
+                    return false;
+                    };
+
+                OverlapReal R_query = shape_i.getCircumsphereDiameter()/OverlapReal(2.0);
+                hoomd::detail::AABB aabb_i_local = hoomd::detail::AABB(vec3<Scalar>(0,0,0),R_query);
+                hoomd::detail::AABB aabb_i_shape_local = shape_i.getAABB(vec3<Scalar>(0,0,0));
+
+                // All image boxes (including the primary)
+                const unsigned int n_images = (unsigned int)m_image_list.size();
+                for (unsigned int cur_image = 0; cur_image < n_images && !overlap; cur_image++)
+                    {
+                    vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
+                    hoomd::detail::AABB aabb_i_shape = aabb_i_shape_local;
+                    aabb_i_shape.translate(pos_i_image);
+
+                    // particles in the same cell, which may have moved since the tree was updated
+                    for (unsigned int cur_j = cell_begin; cur_j < cell_end && !overlap; cur_j++)
+                        {
+                        unsigned int j = m_checkerboard_cell_particles[cur_j];
+                        if (j != i)
+                            {
+                            overlap = test_pair(j, pos_i_image, h_postype.data[j], h_orientation.data[j],
+                                                detail::overlap(m_aabbs[j], aabb_i_shape));
+                            }
+                        else if (cur_image != 0)
+                            {
+                            // use the trial configuration of i in outside images
+                            overlap = test_pair(i, pos_i_image,
+                                                make_scalar4(pos_i.x, pos_i.y, pos_i.z, postype_i.w),
+                                                quat_to_scalar4(shape_i.orientation),
+                                                true);
+                            }
+                        }
+
+                    hoomd::detail::AABB aabb = aabb_i_local;
+                    aabb.translate(pos_i_image);
+
+                    // stackless search over the fixed particles in the cells of other colors
+                    for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes() && !overlap; cur_node_idx++)
+                        {
+                        if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                            {
+                            if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                                {
+                                for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                                    {
+                                    unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                                    // skip the particles in cells of the current color, these are
+                                    // either in the same cell or out of range
+                                    if (j < N && get_color(m_checkerboard_cell[j]) == color)
+                                        continue;
+
+                                    if (test_pair(j, pos_i_image, h_postype.data[j], h_orientation.data[j],
+                                                  detail::overlap(m_aabbs[j], aabb_i_shape)))
+                                        {
+                                        overlap = true;
+                                        break;
+                                        }
+                                    }
+                                }
+                            }
+                        else
+                            {
+                            // skip ahead
+                            cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                            }
+                        }  // end loop over AABB nodes
+                    } // end loop over images
+
+                if (!overlap)
+                    {
+                    // increment accept counter and assign new position
+                    if (!shape_i.ignoreStatistics())
+                        {
+                        if (move_type_translate)
+                            cell_counters.translate_accept_count++;
+                        else
+                            cell_counters.rotate_accept_count++;
+                        }
+
+                    h_postype.data[i] = make_scalar4(pos_i.x,pos_i.y,pos_i.z,postype_i.w);
+
+                    if (shape_i.hasOrientation())
+                        {
+                        h_orientation.data[i] = quat_to_scalar4(shape_i.orientation);
+                        }
+
+                    // particles in the same cell read the new box, the tree is updated after the color
+                    m_aabbs[i] = computeParticleAABB(shape_i, pos_i, typ_i);
+                    m_checkerboard_moved[i] = 1;
+                    }
+                else
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        {
+                        // increment reject counter
+                        if (move_type_translate)
+                            cell_counters.translate_reject_count++;
+                        else
+                            cell_counters.rotate_reject_count++;
+                        }
+                    }
+                } // end loop over particles in the cell
+            } // end loop over cells
+        };
+
+    #ifdef ENABLE_TBB
+    tbb::enumerable_thread_specific<hpmc_counters_t> thread_counters;
+    #endif
+
+    for (unsigned int cur_color = 0; cur_color < n_colors; cur_color++)
+        {
+        unsigned int color = color_order[cur_color];
+        unsigned int first = m_checkerboard_color_start[color];
+        unsigned int last = m_checkerboard_color_start[color + 1];
+
+        #ifdef ENABLE_TBB
+        m_exec_conf->getTaskArena()->execute([&]{
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(first, last),
+            [&](const tbb::blocked_range<unsigned int>& r)
+                {
+                sweep_cells(color, r.begin(), r.end(), thread_counters.local());
+                });
+        });
+        #else
+        sweep_cells(color, first, last, counters);
+        #endif
+
+        // update the AABB tree with the particles moved in this color
+        for (unsigned int cur_cell = first; cur_cell < last; cur_cell++)
+            {
+            unsigned int cell = m_checkerboard_cells[cur_cell];
+            for (unsigned int cur_particle = m_checkerboard_cell_start[cell];
+                 cur_particle < m_checkerboard_cell_start[cell + 1]; cur_particle++)
+                {
+                unsigned int i = m_checkerboard_cell_particles[cur_particle];
+                if (!m_checkerboard_moved[i])
+                    continue;
+
+                m_aabb_tree.update(i, m_aabbs[i]);
+                m_checkerboard_moved[i] = 0;
+                }
+            }
+        }
+
+    #ifdef ENABLE_TBB
+    // reduce counters
+    for (auto i = thread_counters.begin(); i != thread_counters.end(); ++i)
+        {
+        counters = counters + *i;
+        }
+    #endif
     }
 
 /*! \param timestep current step
@@ -1163,6 +1666,7 @@ unsigned int IntegratorHPMCMono<Shape>::countOverlaps(bool early_exit)
 
                             if (h_tag.data[i] <= h_tag.data[j]
                                 && h_overlaps.data[m_overlap_idx(typ_i,typ_j)]
+                                && detail::overlap(m_aabbs[j], aabb)
                                 && check_circumsphere_overlap(r_ij, shape_i, shape_j)
                                 && test_overlap(r_ij, shape_i, shape_j, err_count)
                                 && test_overlap(-r_ij, shape_j, shape_i, err_count))
@@ -1203,16 +1707,254 @@ unsigned int IntegratorHPMCMono<Shape>::countOverlaps(bool early_exit)
 
     if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
 
+    return this->reduceOverlapCount(overlap_count, early_exit);
+    }
+
+/*! \param sigma_min Smallest singular value of the linear map from the current to the new box
+
+    A linear map M scales every pair separation r_ij to a length of at least sigma_min |r_ij|. When
+    sigma_min |r_ij| is no smaller than the sum of the circumsphere radii for every interacting
+    pair, no pair of shapes can overlap in the new box regardless of their orientations, and the
+    caller may skip the full overlap check. Only the circumspheres are tested here, so this is much
+    cheaper than countOverlaps() for shapes with an expensive overlap test.
+
+    \returns true when no overlaps can be created by the transformation
+*/
+template<class Shape>
+bool IntegratorHPMCMono<Shape>::testCircumspheresAfterScaling(Scalar sigma_min)
+    {
+    if (sigma_min <= Scalar(0.0))
+        return false;
+
+    // build an up to date AABB tree
+    buildAABBTree();
+    // update the image list
+    updateImageList();
+
+    // every pair closer than the scaled query range must be reachable through the image list
+    const Scalar max_d = getMaxCoreDiameter();
+    unsigned int safe = (max_d / sigma_min <= m_image_list_range) ? 1 : 0;
+
+    if (this->m_prof) this->m_prof->push(this->m_exec_conf, "HPMC circumsphere scaling");
+
+    // circumsphere diameters do not depend on the orientation
+    std::vector<OverlapReal> circumsphere_d(m_pdata->getNTypes());
+    for (unsigned int typ = 0; typ < m_pdata->getNTypes(); typ++)
+        {
+        Shape temp(quat<Scalar>(), m_params[typ]);
+        circumsphere_d[typ] = temp.getCircumsphereDiameter();
+        }
+
+    // access particle data and the interaction matrix
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
+
+    const unsigned int n_images = (unsigned int)m_image_list.size();
+    for (unsigned int i = 0; i < m_pdata->getN() && safe; i++)
+        {
+        Scalar4 postype_i = h_postype.data[i];
+        unsigned int typ_i = __scalar_as_int(postype_i.w);
+        vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+        // find all neighbors that could come within contact after the scaling
+        Scalar R_query = Scalar(0.5)*(circumsphere_d[typ_i] + max_d) / sigma_min;
+
+        for (unsigned int cur_image = 0; cur_image < n_images && safe; cur_image++)
+            {
+            vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
+            hoomd::detail::AABB aabb(pos_i_image, R_query);
+
+            // stackless search
+            for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes() && safe; cur_node_idx++)
+                {
+                if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                    {
+                    if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                        {
+                        for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                            {
+                            unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                            // skip i==j in the 0 image
+                            if (cur_image == 0 && i == j)
+                                continue;
+
+                            Scalar4 postype_j = h_postype.data[j];
+                            unsigned int typ_j = __scalar_as_int(postype_j.w);
+                            if (!h_overlaps.data[m_overlap_idx(typ_i,typ_j)])
+                                continue;
+
+                            vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                            Scalar r_contact = Scalar(0.5)*(circumsphere_d[typ_i] + circumsphere_d[typ_j]);
+                            if (sigma_min*sigma_min*dot(r_ij,r_ij) < r_contact*r_contact)
+                                {
+                                safe = 0;
+                                break;
+                                }
+                            }
+                        }
+                    }
+                else
+                    {
+                    // skip ahead
+                    cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                    }
+                } // end loop over AABB nodes
+            } // end loop over images
+        } // end loop over particles
+
+    if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
+
+    #ifdef ENABLE_MPI
+    if (this->m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &safe, 1, MPI_UNSIGNED, MPI_MIN, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    return safe;
+    }
+
+/*! \param max_lambda Largest scale factor of interest, in the range [0,1)
+
+    Finds the contact scale factor of every interacting pair in the same way as ComputeSDF: in
+    closed form for shapes that specialize detail::sdf_contact_scale, otherwise by bisecting with
+    detail::test_scaled_overlap. The bisection of each pair is bounded by the smallest value found
+    so far, so most pairs cost a single overlap test, and it keeps the lower end of the final
+    interval so that the result never exceeds the true contact scale factor by more than the
+    tolerance of the overlap test.
+
+    \a max_lambda is reduced so that every pair that could touch is within the image list range
+    (and the ghost layer, with domain decomposition).
+
+    \returns The smallest contact scale factor over all pairs, at most \a max_lambda, and 0 when
+             particles already overlap
+*/
+template<class Shape>
+Scalar IntegratorHPMCMono<Shape>::computeContactScale(Scalar max_lambda)
+    {
+    // relative precision of the bisection
+    const unsigned int n_bisect = 20;
+
+    // build an up to date AABB tree
+    buildAABBTree();
+    // update the image list
+    updateImageList();
+
+    // pairs that touch after the scaling are closer than max_d / (1 - max_lambda)
+    const Scalar max_d = getMaxCoreDiameter();
+    Scalar range = m_image_list_range;
+    #ifdef ENABLE_MPI
+    if (this->m_pdata->getDomainDecomposition())
+        range = std::min(range, m_nominal_width + m_extra_ghost_width);
+    #endif
+    if (range > max_d)
+        max_lambda = std::min(max_lambda, Scalar(1.0) - max_d / range);
+    else
+        max_lambda = Scalar(0.0);
+
+    if (this->m_prof) this->m_prof->push(this->m_exec_conf, "HPMC contact scale");
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
+
+    Scalar lambda_min = std::max(max_lambda, Scalar(0.0));
+
+    const unsigned int n_images = (unsigned int)m_image_list.size();
+    for (unsigned int i = 0; i < m_pdata->getN() && lambda_min > Scalar(0.0); i++)
+        {
+        Scalar4 postype_i = h_postype.data[i];
+        quat<Scalar> orientation_i(h_orientation.data[i]);
+        unsigned int typ_i = __scalar_as_int(postype_i.w);
+        Shape shape_i(orientation_i, m_params[typ_i]);
+        vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+        // find all neighbors that could touch i before the current minimum
+        Scalar R_query = Scalar(0.5)*(shape_i.getCircumsphereDiameter() + max_d) / (Scalar(1.0) - lambda_min);
+
+        for (unsigned int cur_image = 0; cur_image < n_images && lambda_min > Scalar(0.0); cur_image++)
+            {
+            vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
+            hoomd::detail::AABB aabb(pos_i_image, R_query);
+
+            // stackless search
+            for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes() && lambda_min > Scalar(0.0); cur_node_idx++)
+                {
+                if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                    {
+                    if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                        {
+                        for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                            {
+                            unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                            // skip i==j in the 0 image
+                            if (cur_image == 0 && i == j)
+                                continue;
+
+                            Scalar4 postype_j = h_postype.data[j];
+                            quat<Scalar> orientation_j(h_orientation.data[j]);
+                            unsigned int typ_j = __scalar_as_int(postype_j.w);
+                            if (!h_overlaps.data[m_overlap_idx(typ_i,typ_j)])
+                                continue;
+
+                            vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+
+                            Scalar lambda;
+                            if (detail::sdf_contact_scale<Shape>(r_ij, shape_i, Shape(orientation_j, m_params[typ_j]), lambda))
+                                {
+                                lambda_min = std::min(lambda_min, std::max(lambda, Scalar(0.0)));
+                                continue;
+                                }
+
+                            // only pairs that touch before the current minimum change the result
+                            if (!detail::test_scaled_overlap<Shape>(r_ij, orientation_i, orientation_j,
+                                    m_params[typ_i], m_params[typ_j], lambda_min))
+                                continue;
+
+                            if (detail::test_scaled_overlap<Shape>(r_ij, orientation_i, orientation_j,
+                                    m_params[typ_i], m_params[typ_j], Scalar(0.0)))
+                                {
+                                // the particles already overlap
+                                lambda_min = Scalar(0.0);
+                                break;
+                                }
+
+                            Scalar L = Scalar(0.0);
+                            Scalar R = lambda_min;
+                            for (unsigned int k = 0; k < n_bisect; k++)
+                                {
+                                Scalar m = Scalar(0.5)*(L + R);
+                                if (detail::test_scaled_overlap<Shape>(r_ij, orientation_i, orientation_j,
+                                        m_params[typ_i], m_params[typ_j], m))
+                                    R = m;
+                                else
+                                    L = m;
+                                }
+                            lambda_min = L;
+                            }
+                        }
+                    }
+                else
+                    {
+                    // skip ahead
+                    cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                    }
+                } // end loop over AABB nodes
+            } // end loop over images
+        } // end loop over particles
+
+    if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
+
     #ifdef ENABLE_MPI
     if (this->m_pdata->getDomainDecomposition())
         {
-        MPI_Allreduce(MPI_IN_PLACE, &overlap_count, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
-        if (early_exit && overlap_count > 1)
-            overlap_count = 1;
+        MPI_Allreduce(MPI_IN_PLACE, &lambda_min, 1, MPI_HOOMD_SCALAR, MPI_MIN, m_exec_conf->getMPICommunicator());
         }
     #endif
 
-    return overlap_count;
+    return lambda_min;
     }
 
 template<class Shape>
@@ -1429,6 +2171,7 @@ void IntegratorHPMCMono<Shape>::setParam(unsigned int typ,  const param_type& pa
         m_params[typ] = param;
         }
 
+    m_param_version++;
     updateCellWidth();
     }
 
@@ -1444,6 +2187,7 @@ void IntegratorHPMCMono<Shape>::setInteractionMatrix(std::pair<std::string, std:
     h_overlaps.data[m_overlap_idx(typi,typj)] = check_overlaps;
     h_overlaps.data[m_overlap_idx(typj,typi)] = check_overlaps;
 
+    m_param_version++;
     m_image_list_valid = false;
     }
 
@@ -1537,6 +2281,7 @@ inline const std::vector<vec3<Scalar> >& IntegratorHPMCMono<Shape>::updateImageL
 
     // add any extra requested width
     range += m_extra_image_width;
+    m_image_list_range = range;
 
     m_exec_conf->msg->notice(6) << "Image list: range = " << range << std::endl;
 
@@ -1739,12 +2484,35 @@ void IntegratorHPMCMono<Shape>::growAABBList(unsigned int N)
     Subclasses that override update() or other methods must be user to set m_aabb_tree_invalid appropriately, or
     erroneous simulations will result.
 
+    The per particle boxes in m_aabbs are kept up to date with the tree. Sweeps that move a particle
+    store its new box in m_aabbs, so that overlap checks can reject neighbors with disjoint boxes
+    without evaluating Shape::getAABB() again.
+
     \returns A reference to the tree.
 */
+/*! \param shape Shape of the particle
+    \param pos Position of the particle
+    \param typ Type of the particle
+
+    \returns The bounding box of the shape, or of the patch interaction range when there is a patch
+    energy.
+*/
+template <class Shape>
+inline hoomd::detail::AABB IntegratorHPMCMono<Shape>::computeParticleAABB(const Shape& shape, const vec3<Scalar>& pos, unsigned int typ)
+    {
+    if (!this->m_patch)
+        return shape.getAABB(pos);
+
+    Scalar radius = std::max(0.5*shape.getCircumsphereDiameter(),
+        0.5*this->m_patch->getAdditiveCutoff(typ));
+    return hoomd::detail::AABB(pos, radius);
+    }
+
 template <class Shape>
 const hoomd::detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
     {
-    if (m_aabb_tree_invalid)
+    // the tree is also rebuilt when another class moved, sorted, or migrated the particles
+    if (m_aabb_tree_invalid || m_aabb_tree_version != m_pdata->getPositionVersion())
         {
         m_exec_conf->msg->notice(8) << "Building AABB tree: " << m_pdata->getN() << " ptls " << m_pdata->getNGhosts() << " ghosts" << std::endl;
         if (this->m_prof) this->m_prof->push(this->m_exec_conf, "AABB tree build");
@@ -1764,14 +2532,7 @@ const hoomd::detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
                     unsigned int typ_i = __scalar_as_int(h_postype.data[i].w);
                     Shape shape(quat<Scalar>(h_orientation.data[i]), m_params[typ_i]);
 
-                    if (!this->m_patch)
-                        m_aabbs[i] = shape.getAABB(vec3<Scalar>(h_postype.data[i]));
-                    else
-                        {
-                        Scalar radius = std::max(0.5*shape.getCircumsphereDiameter(),
-                            0.5*this->m_patch->getAdditiveCutoff(typ_i));
-                        m_aabbs[i] = hoomd::detail::AABB(vec3<Scalar>(h_postype.data[i]), radius);
-                        }
+                    m_aabbs[i] = computeParticleAABB(shape, vec3<Scalar>(h_postype.data[i]), typ_i);
                     }
                 m_aabb_tree.buildTree(m_aabbs, n_aabb);
                 }
@@ -1781,6 +2542,7 @@ const hoomd::detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
         }
 
     m_aabb_tree_invalid = false;
+    m_aabb_tree_version = m_pdata->getPositionVersion();
     return m_aabb_tree;
     }
 
@@ -1896,6 +2658,7 @@ std::vector<std::pair<unsigned int, unsigned int> > IntegratorHPMCMono<Shape>::m
                             Shape shape_j(quat<Scalar>(orientation_j), m_params[__scalar_as_int(postype_j.w)]);
 
                             if (h_tag.data[i] <= h_tag.data[j]
+                                && detail::overlap(m_aabbs[j], aabb)
                                 && check_circumsphere_overlap(r_ij, shape_i, shape_j)
                                 && test_overlap(r_ij, shape_i, shape_j, err_count)
                                 && test_overlap(-r_ij, shape_j, shape_i, err_count))
@@ -2051,7 +2814,7 @@ bool IntegratorHPMCMono<Shape>::py_test_overlap(unsigned int type_i, unsigned in
         }
 
     if (err)
-        m_exec_conf->msg->warning() << "test_overlap() reports an error due to finite numerical precision." << std::endl;
+        m_exec_conf->msg->warningRepeated("test_overlap() reports an error due to finite numerical precision.");
 
     return overlap;
     }
@@ -3045,10 +3808,10 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
     }
 
 template<class Shape>
-bool IntegratorHPMCMono<Shape>::attemptBoxResize(uint64_t timestep, const BoxDim& new_box)
+bool IntegratorHPMCMono<Shape>::attemptBoxResize(uint64_t timestep, const BoxDim& new_box, bool check_overlaps)
     {
     // call parent class method
-    bool result = IntegratorHPMC::attemptBoxResize(timestep, new_box);
+    bool result = IntegratorHPMC::attemptBoxResize(timestep, new_box, check_overlaps);
 
     if (result)
         {
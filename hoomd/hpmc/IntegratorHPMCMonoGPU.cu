@@ -111,6 +111,33 @@ __global__ void hpmc_shift(Scalar4* d_postype,
     d_image[my_pidx] = image;
     }
 
+//! Kernel to scale particle positions to a new box
+/*! \param d_postype postype of each particle
+    \param N number of particles
+    \param old_box Global box the positions are currently in
+    \param new_box Global box to scale the positions to
+
+    Map every position to the same fractional coordinates in the new box.
+
+    \ingroup hpmc_kernels
+*/
+__global__ void hpmc_scale(Scalar4* d_postype,
+                           const unsigned int N,
+                           const BoxDim old_box,
+                           const BoxDim new_box)
+    {
+    unsigned int my_pidx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (my_pidx >= N)
+        return;
+
+    Scalar4 postype = d_postype[my_pidx];
+    Scalar3 f = old_box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+    Scalar3 pos = new_box.makeCoordinates(f);
+
+    d_postype[my_pidx] = make_scalar4(pos.x, pos.y, pos.z, postype.w);
+    }
+
 //!< Kernel to evaluate convergence
 __global__ void hpmc_check_convergence(const unsigned int* d_trial_move_type,
                                        const unsigned int* d_reject_out_of_cell,
@@ -225,6 +252,29 @@ void hpmc_shift(Scalar4* d_postype,
     hipDeviceSynchronize();
     }
 
+//! Kernel driver for kernel::hpmc_scale()
+void hpmc_scale(Scalar4* d_postype,
+                const unsigned int N,
+                const BoxDim& old_box,
+                const BoxDim& new_box,
+                const unsigned int block_size)
+    {
+    assert(d_postype);
+
+    dim3 threads(block_size, 1, 1);
+    dim3 grid(N / block_size + 1, 1, 1);
+
+    hipLaunchKernelGGL(kernel::hpmc_scale,
+                       dim3(grid),
+                       dim3(threads),
+                       0,
+                       0,
+                       d_postype,
+                       N,
+                       old_box,
+                       new_box);
+    }
+
 void hpmc_check_convergence(const unsigned int* d_trial_move_type,
                             const unsigned int* d_reject_out_of_cell,
                             unsigned int* d_reject_in,
@@ -233,11 +283,15 @@ void hpmc_check_convergence(const unsigned int* d_trial_move_type,
                             const GPUPartition& gpu_partition,
                             const unsigned int block_size)
     {
-    // determine the maximum block size and clamp the input block size down
-    int max_block_size;
-    hipFuncAttributes attr;
-    hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel::hpmc_check_convergence));
-    max_block_size = attr.maxThreadsPerBlock;
+    // determine the maximum block size and clamp the input block size down, this driver runs
+    // several times per sweep so query the kernel attributes only once
+    static const hipFuncAttributes attr = []()
+        {
+        hipFuncAttributes a;
+        hipFuncGetAttributes(&a, reinterpret_cast<const void*>(kernel::hpmc_check_convergence));
+        return a;
+        }();
+    int max_block_size = attr.maxThreadsPerBlock;
 
     // setup the grid to run the kernel
     unsigned int run_block_size = min(block_size, (unsigned int)max_block_size);
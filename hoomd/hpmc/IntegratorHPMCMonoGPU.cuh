@@ -68,6 +68,7 @@ __launch_bounds__(max_threads)
                                       const unsigned int* d_reject_in,
                                       unsigned int* d_reject_out,
                                       const unsigned int* d_reject_out_of_cell,
+                                      const unsigned int* d_param_order,
                                       const unsigned int max_extra_bytes,
                                       const unsigned int max_queue_size,
                                       const unsigned int work_offset,
@@ -127,9 +128,10 @@ __launch_bounds__(max_threads)
     // initialize extra shared mem
     char* s_extra = (char*)(s_reject_group + n_groups);
 
+    // load the most frequent types first, the others stay in global memory when space runs out
     unsigned int available_bytes = max_extra_bytes;
-    for (unsigned int cur_type = 0; cur_type < num_types; ++cur_type)
-        s_params[cur_type].load_shared(s_extra, available_bytes);
+    for (unsigned int i = 0; i < num_types; ++i)
+        s_params[d_param_order[i]].load_shared(s_extra, available_bytes);
     __syncthreads();
 
     if (master && group == 0)
@@ -240,9 +242,11 @@ __launch_bounds__(max_threads)
 
                 // has j been updated? ghost particles are not updated
 
-                // these multiple gmem loads present a minor optimization opportunity for the future
-                bool j_has_been_updated = j < N_local && d_update_order_by_ptl[j] < update_order_i
-                                          && !d_reject_in[j] && d_trial_move_type[j];
+                // neighbors are scattered in memory when the particles are not sorted, load them
+                // through the read-only data cache
+                bool j_has_been_updated
+                    = j < N_local && __ldg(d_update_order_by_ptl + j) < update_order_i
+                      && !__ldg(d_reject_in + j) && __ldg(d_trial_move_type + j);
 
                 // true if particle j is in the old configuration
                 bool old = !j_has_been_updated;
@@ -250,7 +254,8 @@ __launch_bounds__(max_threads)
                 // check particle circumspheres
 
                 // load particle j (always load ghosts from particle data)
-                const Scalar4 postype_j = (old || j >= N_local) ? d_postype[j] : d_trial_postype[j];
+                const Scalar4 postype_j
+                    = (old || j >= N_local) ? __ldg(d_postype + j) : __ldg(d_trial_postype + j);
                 unsigned int type_j = __scalar_as_int(postype_j.w);
                 vec3<Scalar> pos_j(postype_j);
                 Shape shape_j(quat<Scalar>(), s_params[type_j]);
@@ -310,13 +315,14 @@ __launch_bounds__(max_threads)
             Shape shape_i(quat<Scalar>(s_orientation_group[check_group]), s_params[type_i]);
 
             // build shape j from global memory
-            postype_j = check_old ? d_postype[check_j] : d_trial_postype[check_j];
+            postype_j = check_old ? __ldg(d_postype + check_j) : __ldg(d_trial_postype + check_j);
             orientation_j = make_scalar4(1, 0, 0, 0);
             unsigned int type_j = __scalar_as_int(postype_j.w);
             Shape shape_j(quat<Scalar>(orientation_j), s_params[type_j]);
             if (shape_j.hasOrientation())
-                shape_j.orientation = check_old ? quat<Scalar>(d_orientation[check_j])
-                                                : quat<Scalar>(d_trial_orientation[check_j]);
+                shape_j.orientation = check_old
+                                          ? quat<Scalar>(__ldg(d_orientation + check_j))
+                                          : quat<Scalar>(__ldg(d_trial_orientation + check_j));
 
             // put particle j into the coordinate system of particle i
             r_ij = vec3<Scalar>(postype_j) - vec3<Scalar>(pos_i);
@@ -379,16 +385,20 @@ void narrow_phase_launcher(const hpmc_args_t& args,
 
     if (max_threads == cur_launch_bounds * MIN_BLOCK_SIZE)
         {
-        // determine the maximum block size and clamp the input block size down
-        int max_block_size;
-        hipFuncAttributes attr;
+        // determine the maximum block size and clamp the input block size down, the narrow
+        // phase runs once per convergence iteration so query the kernel attributes only once
         constexpr unsigned int launch_bounds_nonzero
             = cur_launch_bounds > 0 ? cur_launch_bounds : 1;
-        hipFuncGetAttributes(
-            &attr,
-            reinterpret_cast<const void*>(
-                kernel::hpmc_narrow_phase<Shape, launch_bounds_nonzero * MIN_BLOCK_SIZE>));
-        max_block_size = attr.maxThreadsPerBlock;
+        static const hipFuncAttributes attr = []()
+            {
+            hipFuncAttributes a;
+            hipFuncGetAttributes(
+                &a,
+                reinterpret_cast<const void*>(
+                    kernel::hpmc_narrow_phase<Shape, launch_bounds_nonzero * MIN_BLOCK_SIZE>));
+            return a;
+            }();
+        int max_block_size = attr.maxThreadsPerBlock;
 
         // choose a block size based on the max block size by regs (max_block_size) and include
         // dynamic shared memory usage
@@ -449,7 +459,7 @@ void narrow_phase_launcher(const hpmc_args_t& args,
         unsigned int available_bytes = max_extra_bytes;
         for (unsigned int i = 0; i < args.num_types; ++i)
             {
-            params[i].allocate_shared(ptr, available_bytes);
+            params[args.d_param_order[i]].allocate_shared(ptr, available_bytes);
             }
         unsigned int extra_bytes = max_extra_bytes - available_bytes;
         shared_bytes += extra_bytes;
@@ -504,6 +514,7 @@ void narrow_phase_launcher(const hpmc_args_t& args,
                                args.d_reject_in,
                                args.d_reject_out,
                                args.d_reject_out_of_cell,
+                               args.d_param_order,
                                max_extra_bytes,
                                max_queue_size,
                                range.first,
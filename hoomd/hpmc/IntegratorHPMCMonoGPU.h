@@ -19,6 +19,7 @@
 #include "hoomd/GPUPartition.cuh"
 
 #include <hip/hip_runtime.h>
+#include <numeric>
 
 #ifdef ENABLE_MPI
 #include "hoomd/MPIConfiguration.h"
@@ -176,18 +177,32 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
             this->m_patch->setAutotunerParams(enable, chain_length * period * this->m_nselect);
             }
 
+        if (this->m_external)
+            {
+            this->m_external->setAutotunerParams(enable, period * this->m_nselect);
+            }
+
         m_tuner_depletants->setPeriod(chain_length * period * this->m_nselect);
         m_tuner_depletants->setEnabled(enable);
 
         m_tuner_excell_block_size->setPeriod(period);
         m_tuner_excell_block_size->setEnabled(enable);
 
+        m_tuner_count_overlaps->setPeriod(period);
+        m_tuner_count_overlaps->setEnabled(enable);
+
+        m_tuner_scale->setPeriod(period);
+        m_tuner_scale->setEnabled(enable);
+
         m_tuner_convergence->setPeriod(chain_length * period * this->m_nselect);
         m_tuner_convergence->setEnabled(enable);
 
         m_tuner_num_depletants->setPeriod(chain_length * period * this->m_nselect);
         m_tuner_num_depletants->setEnabled(enable);
 
+        m_tuner_depletant_candidates->setPeriod(chain_length * period * this->m_nselect);
+        m_tuner_depletant_candidates->setEnabled(enable);
+
         m_tuner_num_depletants_ntrial->setPeriod(chain_length * period * this->m_nselect);
         m_tuner_num_depletants_ntrial->setEnabled(enable);
 
@@ -204,6 +219,9 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
     //! Take one timestep forward
     virtual void update(uint64_t timestep);
 
+    //! Count the number of particle overlaps on the GPU
+    virtual unsigned int countOverlaps(bool early_exit);
+
 #ifdef ENABLE_MPI
     void setNtrialCommunicator(std::shared_ptr<MPIConfiguration> mpi_conf)
         {
@@ -238,12 +256,16 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
         m_tuner_num_depletants; //!< Autotuner for calculating number of depletants
     std::unique_ptr<Autotuner> m_tuner_num_depletants_ntrial; //!< Autotuner for calculating number
                                                               //!< of depletants with ntrial
+    std::unique_ptr<Autotuner>
+        m_tuner_depletant_candidates; //!< Autotuner for flagging candidate depletants
     std::unique_ptr<Autotuner>
         m_tuner_depletants_phase1; //!< Tuner for depletants with ntrial, phase 1 kernel
     std::unique_ptr<Autotuner>
         m_tuner_depletants_phase2; //!< Tuner for depletants with ntrial, phase 2 kernel
     std::unique_ptr<Autotuner>
         m_tuner_depletants_accept; //!< Tuner for depletants with ntrial, acceptance kernel
+    std::unique_ptr<Autotuner> m_tuner_count_overlaps; //!< Autotuner for counting overlaps
+    std::unique_ptr<Autotuner> m_tuner_scale;          //!< Autotuner for scaling to a new box
 
     GlobalArray<Scalar4> m_trial_postype;           //!< New positions (and type) of particles
     GlobalArray<Scalar4> m_trial_orientation;       //!< New orientations
@@ -256,6 +278,10 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
         m_reject_out; //!< Flags to reject particle moves, per particle (temporary)
 
     GlobalArray<unsigned int> m_n_depletants; //!< List of number of depletants, per particle
+    GlobalArray<unsigned int>
+        m_depletant_offset; //!< Index of the first depletant of every particle, per type pair
+    GlobalArray<unsigned int>
+        m_depletant_candidate_offset; //!< Index of the first candidate of every particle, per pair
     GlobalArray<unsigned int>
         m_n_depletants_ntrial; //!< List of number of depletants, per particle, trial insertion and
                                //!< configuration:w
@@ -265,7 +291,8 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
     GlobalArray<unsigned int> m_req_len; //!< Requested length of shared mem per group
 
     detail::UpdateOrderGPU m_update_order; //!< Particle update order
-    GlobalArray<unsigned int> m_condition; //!< Condition of convergence check
+    GlobalArray<unsigned int> m_condition;     //!< Condition of convergence check
+    GlobalArray<unsigned int> m_overlap_count; //!< Number of overlaps found by countOverlaps()
 
     //! For energy evaluation
     GlobalArray<Scalar> m_additive_cutoff; //!< Per-type additive cutoffs from patch potential
@@ -295,6 +322,12 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
     //!< Variables for implicit depletants
     GlobalArray<Scalar> m_lambda; //!< Poisson means, per type pair
 
+    //! Types in the order their shape parameters are loaded into shared memory
+    std::vector<unsigned int, hoomd::detail::managed_allocator<unsigned int>> m_param_order;
+    bool m_param_order_changed;         //!< True if the parameter order needs to be updated
+    unsigned int m_param_order_nglobal; //!< Global number of particles at the last order update
+    unsigned int m_n_params_global;     //!< Number of types with parameters in global memory
+
     //! Set up excell_list
     virtual void initializeExcellMem();
 
@@ -303,12 +336,19 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
 
     //! Update GPU memory hints
     virtual void updateGPUAdvice();
+
+    //! Scale the local particle positions from one global box to another on the GPU
+    virtual void scaleParticles(const BoxDim& old_box, const BoxDim& new_box);
+
+    //! Order the shape parameters by the number of local particles of each type
+    void updateParamOrder();
     };
 
 template<class Shape>
 IntegratorHPMCMonoGPU<Shape>::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefinition> sysdef,
                                                     std::shared_ptr<CellList> cl)
-    : IntegratorHPMCMono<Shape>(sysdef), m_cl(cl), m_update_order(this->m_exec_conf)
+    : IntegratorHPMCMono<Shape>(sysdef), m_cl(cl), m_update_order(this->m_exec_conf),
+      m_param_order_changed(true), m_param_order_nglobal(0), m_n_params_global(0)
     {
     this->m_cl->setRadius(1);
     this->m_cl->setComputeTDB(false);
@@ -351,6 +391,13 @@ IntegratorHPMCMonoGPU<Shape>::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefini
                                                1000000,
                                                "hpmc_num_depletants",
                                                this->m_exec_conf));
+    m_tuner_depletant_candidates.reset(new Autotuner(dev_prop.warpSize,
+                                                     dev_prop.maxThreadsPerBlock,
+                                                     dev_prop.warpSize,
+                                                     5,
+                                                     1000000,
+                                                     "hpmc_depletant_candidates",
+                                                     this->m_exec_conf));
     m_tuner_num_depletants_ntrial.reset(new Autotuner(dev_prop.warpSize,
                                                       dev_prop.maxThreadsPerBlock,
                                                       dev_prop.warpSize,
@@ -428,6 +475,32 @@ IntegratorHPMCMonoGPU<Shape>::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefini
                                                   "hpmc_depletants_phase2",
                                                   this->m_exec_conf));
 
+    // tuning parameters for counting overlaps: block size and threads per particle
+    std::vector<unsigned int> valid_params_count_overlaps;
+    for (unsigned int block_size = warp_size;
+         block_size <= (unsigned int)dev_prop.maxThreadsPerBlock;
+         block_size += warp_size)
+        {
+        for (auto t : Autotuner::getTppListPow2(warp_size))
+            {
+            if ((block_size % t) == 0)
+                valid_params_count_overlaps.push_back(block_size * 100 + t);
+            }
+        }
+
+    m_tuner_count_overlaps.reset(new Autotuner(valid_params_count_overlaps,
+                                               5,
+                                               100000,
+                                               "hpmc_count_overlaps",
+                                               this->m_exec_conf));
+    m_tuner_scale.reset(new Autotuner(dev_prop.warpSize,
+                                      dev_prop.maxThreadsPerBlock,
+                                      dev_prop.warpSize,
+                                      5,
+                                      100000,
+                                      "hpmc_scale",
+                                      this->m_exec_conf));
+
     // initialize memory
     GlobalArray<Scalar4>(1, this->m_exec_conf).swap(m_trial_postype);
     TAG_ALLOCATION(m_trial_postype);
@@ -453,6 +526,9 @@ IntegratorHPMCMonoGPU<Shape>::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefini
     GlobalArray<unsigned int>(1, this->m_exec_conf).swap(m_condition);
     TAG_ALLOCATION(m_condition);
 
+    GlobalArray<unsigned int>(1, this->m_exec_conf).swap(m_overlap_count);
+    TAG_ALLOCATION(m_overlap_count);
+
     GlobalArray<unsigned int>(1, this->m_exec_conf).swap(m_req_len);
     TAG_ALLOCATION(m_req_len);
 
@@ -499,6 +575,12 @@ IntegratorHPMCMonoGPU<Shape>::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefini
     GlobalArray<unsigned int>(1, this->m_exec_conf).swap(m_n_depletants);
     TAG_ALLOCATION(m_n_depletants);
 
+    GlobalArray<unsigned int>(1, this->m_exec_conf).swap(m_depletant_offset);
+    TAG_ALLOCATION(m_depletant_offset);
+
+    GlobalArray<unsigned int>(1, this->m_exec_conf).swap(m_depletant_candidate_offset);
+    TAG_ALLOCATION(m_depletant_candidate_offset);
+
     GlobalArray<unsigned int>(1, this->m_exec_conf).swap(m_n_depletants_ntrial);
     TAG_ALLOCATION(m_n_depletants_ntrial);
 
@@ -572,6 +654,12 @@ IntegratorHPMCMonoGPU<Shape>::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefini
     m_lambda.swap(lambda);
     TAG_ALLOCATION(m_lambda);
 
+    m_param_order = std::vector<unsigned int, hoomd::detail::managed_allocator<unsigned int>>(
+        ntypes,
+        0,
+        hoomd::detail::managed_allocator<unsigned int>(this->m_exec_conf->isCUDAEnabled()));
+    std::iota(m_param_order.begin(), m_param_order.end(), 0);
+
     m_depletant_streams.resize(this->m_depletant_idx.getNumElements());
     m_depletant_streams_phase1.resize(this->m_depletant_idx.getNumElements());
     m_depletant_streams_phase2.resize(this->m_depletant_idx.getNumElements());
@@ -837,7 +925,20 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::updateGPUAdvice()
 
 template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timestep)
     {
-    IntegratorHPMC::update(timestep);
+        {
+        // save the counters at the start of the step on the device, without waiting for the
+        // previous step to complete
+        ArrayHandle<hpmc_counters_t> d_count_total(this->m_count_total,
+                                                   access_location::device,
+                                                   access_mode::read);
+        ArrayHandle<hpmc_counters_t> d_count_step_start(this->m_count_step_start,
+                                                        access_location::device,
+                                                        access_mode::overwrite);
+        hipMemcpyAsync(d_count_step_start.data,
+                       d_count_total.data,
+                       sizeof(hpmc_counters_t),
+                       hipMemcpyDeviceToDevice);
+        }
 
     if (this->m_patch)
         {
@@ -850,6 +951,9 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
             }
         }
 
+    if (m_param_order_changed || m_param_order_nglobal != this->m_pdata->getNGlobal())
+        updateParamOrder();
+
     // rng for shuffle and grid shift
     hoomd::RandomGenerator rng(
         hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoShift, timestep, this->m_sysdef->getSeed()),
@@ -938,6 +1042,15 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
             update_gpu_advice = true;
             }
 
+        if (m_depletant_offset.getNumElements()
+            < (this->m_pdata->getMaxN() + 1) * this->m_depletant_idx.getNumElements())
+            {
+            m_depletant_offset.resize((this->m_pdata->getMaxN() + 1)
+                                      * this->m_depletant_idx.getNumElements());
+            m_depletant_candidate_offset.resize((this->m_pdata->getMaxN() + 1)
+                                                * this->m_depletant_idx.getNumElements());
+            }
+
         // resize data structures for depletants with ntrial > 0
         bool have_auxilliary_variables = false;
         bool have_depletants = false;
@@ -1190,6 +1303,7 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                                       m_excell_list_indexer,
                                       0, // d_reject_in
                                       0, // d_reject_out
+                                      m_param_order.data(),
                                       this->m_exec_conf->dev_prop,
                                       this->m_pdata->getGPUPartition(),
                                       0);
@@ -1197,12 +1311,33 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                 // propose trial moves, \sa gpu::kernel::hpmc_moves
 
                 // reset acceptance results and move types
+                this->m_exec_conf->beginMultiGPU();
                 m_tuner_moves->begin();
                 args.block_size = m_tuner_moves->getParam();
                 gpu::hpmc_gen_moves<Shape>(args, params.data());
                 if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
                     CHECK_CUDA_ERROR();
                 m_tuner_moves->end();
+                this->m_exec_conf->endMultiGPU();
+
+                // the external field energy depends only on the moved particle, apply its
+                // Metropolis criterion before the overlap checks
+                if (this->m_external)
+                    {
+                    ExternalField::gpu_args_t external_args(d_postype.data,
+                                                            d_orientation.data,
+                                                            d_trial_postype.data,
+                                                            d_trial_orientation.data,
+                                                            d_trial_move_type.data,
+                                                            this->m_pdata->getN(),
+                                                            this->m_sysdef->getSeed(),
+                                                            this->m_exec_conf->getRank(),
+                                                            timestep,
+                                                            i,
+                                                            d_reject_out_of_cell.data,
+                                                            this->m_pdata->getGPUPartition());
+                    this->m_external->rejectTrialMovesGPU(external_args);
+                    }
                 }
 
             bool converged = false;
@@ -1373,6 +1508,13 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                     ArrayHandle<unsigned int> d_n_depletants(m_n_depletants,
                                                              access_location::device,
                                                              access_mode::overwrite);
+                    ArrayHandle<unsigned int> d_depletant_offset(m_depletant_offset,
+                                                                 access_location::device,
+                                                                 access_mode::overwrite);
+                    ArrayHandle<unsigned int> d_depletant_candidate_offset(
+                        m_depletant_candidate_offset,
+                        access_location::device,
+                        access_mode::overwrite);
                     ArrayHandle<unsigned int> d_n_depletants_ntrial(m_n_depletants_ntrial,
                                                                     access_location::device,
                                                                     access_mode::overwrite);
@@ -1416,6 +1558,7 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                                           m_excell_list_indexer,
                                           d_reject.data,
                                           d_reject_out.data,
+                                          m_param_order.data(),
                                           this->m_exec_conf->dev_prop,
                                           this->m_pdata->getGPUPartition(),
                                           &m_narrow_phase_streams.front());
@@ -1443,6 +1586,9 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
 
                     unsigned int ntrial_offset = 0;
 
+                    // temporary candidate lists, and the streams that use them
+                    std::vector<std::pair<unsigned int*, hipStream_t>> candidate_buffers;
+
                     // allow concurrency between depletant types in multi GPU block
                     for (unsigned int itype = 0; itype < this->m_pdata->getNTypes(); ++itype)
                         {
@@ -1480,18 +1626,100 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                                     CHECK_CUDA_ERROR();
                                 m_tuner_num_depletants->end();
 
-                                // max reduce over result
                                 unsigned int
                                     max_n_depletants[this->m_exec_conf->getNumActiveGPUs()];
-                                gpu::get_max_num_depletants(
+                                unsigned int* d_offset = nullptr;
+                                unsigned int* d_candidates = nullptr;
+                                unsigned int* d_candidate_offset = nullptr;
+                                unsigned int n_depletants_total = 0;
+                                hipStream_t stream
+                                    = m_depletant_streams[this->m_depletant_idx(itype, jtype)]
+                                          .front();
+
+                                if (ngpu == 1)
+                                    {
+                                    // flag the depletants that change their overlap with the
+                                    // particle that inserts them and compact the list, so that the
+                                    // insertion kernel is sized by the number of candidates
+                                    d_offset = d_depletant_offset.data
+                                               + this->m_depletant_idx(itype, jtype)
+                                                     * (this->m_pdata->getMaxN() + 1);
+                                    d_candidate_offset = d_depletant_candidate_offset.data
+                                                         + this->m_depletant_idx(itype, jtype)
+                                                               * (this->m_pdata->getMaxN() + 1);
+                                    n_depletants_total = gpu::get_depletant_offsets(
+                                        d_n_depletants.data
+                                            + this->m_depletant_idx(itype, jtype)
+                                                  * this->m_pdata->getMaxN(),
+                                        d_offset,
+                                        this->m_pdata->getN(),
+                                        stream,
+                                        this->m_exec_conf->getCachedAllocator());
+
+                                    // released after the insertion kernels have completed
+                                    d_candidates = this->m_exec_conf->getCachedAllocator()
+                                                       .getTemporaryBuffer<unsigned int>(
+                                                           std::max(n_depletants_total, 1u));
+                                    candidate_buffers.push_back(std::make_pair(d_candidates,
+                                                                               stream));
+                                    }
+
+                                gpu::hpmc_implicit_args_t implicit_args(
+                                    itype,
+                                    jtype,
+                                    this->m_depletant_idx,
+                                    ngpu > 1 ? d_implicit_counters_per_device.data
+                                             : d_implicit_count.data,
+                                    (unsigned int)m_implicit_counters.getPitch(),
+                                    h_fugacity.data[this->m_depletant_idx(itype, jtype)] < 0,
                                     d_n_depletants.data
                                         + this->m_depletant_idx(itype, jtype)
                                               * this->m_pdata->getMaxN(),
                                     &max_n_depletants[0],
+                                    1,
                                     &m_depletant_streams[this->m_depletant_idx(itype, jtype)]
                                          .front(),
-                                    this->m_pdata->getGPUPartition(),
-                                    this->m_exec_conf->getCachedAllocatorManaged());
+                                    d_offset,
+                                    d_candidates,
+                                    d_candidate_offset);
+
+                                if (ngpu == 1)
+                                    {
+                                    m_tuner_depletant_candidates->begin();
+                                    gpu::hpmc_depletant_candidates<Shape>(
+                                        args,
+                                        implicit_args,
+                                        params.data(),
+                                        d_candidates,
+                                        n_depletants_total,
+                                        m_tuner_depletant_candidates->getParam());
+                                    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                                        CHECK_CUDA_ERROR();
+                                    m_tuner_depletant_candidates->end();
+
+                                    // the largest number of candidates of any particle
+                                    max_n_depletants[0] = gpu::compact_depletant_candidates(
+                                        d_candidates,
+                                        n_depletants_total,
+                                        d_offset,
+                                        d_candidate_offset,
+                                        this->m_pdata->getN(),
+                                        stream,
+                                        this->m_exec_conf->getCachedAllocator());
+                                    }
+                                else
+                                    {
+                                    // max reduce over result
+                                    gpu::get_max_num_depletants(
+                                        d_n_depletants.data
+                                            + this->m_depletant_idx(itype, jtype)
+                                                  * this->m_pdata->getMaxN(),
+                                        &max_n_depletants[0],
+                                        &m_depletant_streams[this->m_depletant_idx(itype, jtype)]
+                                             .front(),
+                                        this->m_pdata->getGPUPartition(),
+                                        this->m_exec_conf->getCachedAllocatorManaged());
+                                    }
                                 if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
                                     CHECK_CUDA_ERROR();
 
@@ -1499,24 +1727,9 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                                 m_tuner_depletants->begin();
                                 unsigned int param = m_tuner_depletants->getParam();
                                 args.block_size = param / 1000000;
-                                unsigned int depletants_per_thread = (param % 1000000) / 10000;
+                                implicit_args.depletants_per_thread = (param % 1000000) / 10000;
                                 args.tpp = param % 10000;
 
-                                gpu::hpmc_implicit_args_t implicit_args(
-                                    itype,
-                                    jtype,
-                                    this->m_depletant_idx,
-                                    ngpu > 1 ? d_implicit_counters_per_device.data
-                                             : d_implicit_count.data,
-                                    (unsigned int)m_implicit_counters.getPitch(),
-                                    h_fugacity.data[this->m_depletant_idx(itype, jtype)] < 0,
-                                    d_n_depletants.data
-                                        + this->m_depletant_idx(itype, jtype)
-                                              * this->m_pdata->getMaxN(),
-                                    &max_n_depletants[0],
-                                    depletants_per_thread,
-                                    &m_depletant_streams[this->m_depletant_idx(itype, jtype)]
-                                         .front());
                                 gpu::hpmc_insert_depletants<Shape>(args,
                                                                    implicit_args,
                                                                    params.data());
@@ -1728,6 +1941,12 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
 
                     this->m_exec_conf->endMultiGPU();
 
+                    for (auto& buffer : candidate_buffers)
+                        {
+                        hipStreamSynchronize(buffer.second);
+                        this->m_exec_conf->getCachedAllocator().deallocate((char*)buffer.first);
+                        }
+
                     // did the dynamically allocated shared memory overflow during kernel execution?
                     ArrayHandle<unsigned int> h_req_len(m_req_len,
                                                         access_location::host,
@@ -2113,11 +2332,184 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
 
     // all particle have been moved, the aabb tree is now invalid
     this->m_aabb_tree_invalid = true;
+    this->m_pdata->notifyPositionsChanged();
 
-    // set current MPS value
-    hpmc_counters_t run_counters = this->getCounters(1);
-    double cur_time = double(this->m_clock.getTime()) / Scalar(1e9);
-    this->m_mps = double(run_counters.getNMoves()) / cur_time;
+    // getMPS() evaluates the moves per second up to this time, reading the counters back only when
+    // queried
+    this->m_last_step_time = this->m_clock.getTime();
+    }
+
+/*! \param early_exit exit at first overlap found if true
+    \returns number of overlaps if early_exit=false, 1 if early_exit=true
+
+    Bin the particles at their current positions and count the overlaps on the GPU, so that box
+    moves do not need to copy the particle data to the host. Fall back to the CPU implementation
+    when the box is too small for the cell list.
+*/
+template<class Shape> unsigned int IntegratorHPMCMonoGPU<Shape>::countOverlaps(bool early_exit)
+    {
+    const BoxDim& global_box = this->m_pdata->getGlobalBox();
+    Scalar3 nearest_plane_distance = global_box.getNearestPlaneDistance();
+    if ((global_box.getPeriodic().x && nearest_plane_distance.x <= this->m_nominal_width * 2)
+        || (global_box.getPeriodic().y && nearest_plane_distance.y <= this->m_nominal_width * 2)
+        || (this->m_sysdef->getNDimensions() == 3 && global_box.getPeriodic().z
+            && nearest_plane_distance.z <= this->m_nominal_width * 2))
+        {
+        return IntegratorHPMCMono<Shape>::countOverlaps(early_exit);
+        }
+
+    unsigned int overlap_count = 0;
+
+    if (this->m_pdata->getN() > 0)
+        {
+        // the positions may have changed without advancing the timestep, rebin them. A forced
+        // compute leaves the step of the last regular compute unchanged.
+        this->m_cl->forceCompute(0);
+
+        if (this->m_prof)
+            this->m_prof->push(this->m_exec_conf, "HPMC count overlaps");
+
+        uint3 cur_dim = this->m_cl->getDim();
+        if (m_last_dim.x != cur_dim.x || m_last_dim.y != cur_dim.y || m_last_dim.z != cur_dim.z
+            || m_last_nmax != this->m_cl->getNmax())
+            {
+            initializeExcellMem();
+
+            m_last_dim = cur_dim;
+            m_last_nmax = this->m_cl->getNmax();
+            }
+
+            {
+            ArrayHandle<unsigned int> d_cell_size(this->m_cl->getCellSizeArray(),
+                                                  access_location::device,
+                                                  access_mode::read);
+            ArrayHandle<unsigned int> d_cell_idx(this->m_cl->getIndexArray(),
+                                                 access_location::device,
+                                                 access_mode::read);
+            ArrayHandle<unsigned int> d_cell_adj(this->m_cl->getCellAdjArray(),
+                                                 access_location::device,
+                                                 access_mode::read);
+            const ArrayHandle<unsigned int>& d_cell_size_per_device
+                = m_cl->getPerDevice()
+                      ? ArrayHandle<unsigned int>(m_cl->getCellSizeArrayPerDevice(),
+                                                  access_location::device,
+                                                  access_mode::read)
+                      : ArrayHandle<unsigned int>(GlobalArray<unsigned int>(),
+                                                  access_location::device,
+                                                  access_mode::read);
+            const ArrayHandle<unsigned int>& d_cell_idx_per_device
+                = m_cl->getPerDevice()
+                      ? ArrayHandle<unsigned int>(m_cl->getIndexArrayPerDevice(),
+                                                  access_location::device,
+                                                  access_mode::read)
+                      : ArrayHandle<unsigned int>(GlobalArray<unsigned int>(),
+                                                  access_location::device,
+                                                  access_mode::read);
+
+            ArrayHandle<unsigned int> d_excell_idx(m_excell_idx,
+                                                   access_location::device,
+                                                   access_mode::overwrite);
+            ArrayHandle<unsigned int> d_excell_size(m_excell_size,
+                                                    access_location::device,
+                                                    access_mode::overwrite);
+
+            this->m_tuner_excell_block_size->begin();
+            gpu::hpmc_excell(d_excell_idx.data,
+                             d_excell_size.data,
+                             m_excell_list_indexer,
+                             m_cl->getPerDevice() ? d_cell_idx_per_device.data : d_cell_idx.data,
+                             m_cl->getPerDevice() ? d_cell_size_per_device.data
+                                                  : d_cell_size.data,
+                             d_cell_adj.data,
+                             this->m_cl->getCellIndexer(),
+                             this->m_cl->getCellListIndexer(),
+                             this->m_cl->getCellAdjIndexer(),
+                             this->m_exec_conf->getNumActiveGPUs(),
+                             this->m_tuner_excell_block_size->getParam());
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            this->m_tuner_excell_block_size->end();
+
+            ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(),
+                                           access_location::device,
+                                           access_mode::read);
+            ArrayHandle<Scalar4> d_orientation(this->m_pdata->getOrientationArray(),
+                                               access_location::device,
+                                               access_mode::read);
+            ArrayHandle<unsigned int> d_tag(this->m_pdata->getTags(),
+                                            access_location::device,
+                                            access_mode::read);
+            ArrayHandle<unsigned int> d_overlaps(this->m_overlaps,
+                                                 access_location::device,
+                                                 access_mode::read);
+            ArrayHandle<unsigned int> d_overlap_count(m_overlap_count,
+                                                      access_location::device,
+                                                      access_mode::overwrite);
+
+            const BoxDim box = this->m_pdata->getBox();
+            const Index3D ci = this->m_cl->getCellIndexer();
+            const uint3 cell_dim = this->m_cl->getDim();
+            const Scalar3 ghost_width = this->m_cl->getGhostWidth();
+            auto& params = this->getParams();
+
+            m_tuner_count_overlaps->begin();
+            unsigned int param = m_tuner_count_overlaps->getParam();
+            gpu::hpmc_count_overlaps_args_t args(d_postype.data,
+                                                 d_orientation.data,
+                                                 d_tag.data,
+                                                 this->m_pdata->getN(),
+                                                 ci,
+                                                 cell_dim,
+                                                 ghost_width,
+                                                 d_excell_idx.data,
+                                                 d_excell_size.data,
+                                                 m_excell_list_indexer,
+                                                 this->m_pdata->getNTypes(),
+                                                 box,
+                                                 d_overlaps.data,
+                                                 this->m_overlap_idx,
+                                                 early_exit,
+                                                 d_overlap_count.data,
+                                                 param / 100,
+                                                 param % 100,
+                                                 this->m_exec_conf->dev_prop);
+            gpu::hpmc_count_overlaps<Shape>(args, params.data());
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            m_tuner_count_overlaps->end();
+            }
+
+        ArrayHandle<unsigned int> h_overlap_count(m_overlap_count,
+                                                  access_location::host,
+                                                  access_mode::read);
+        overlap_count = h_overlap_count.data[0];
+
+        if (this->m_prof)
+            this->m_prof->pop(this->m_exec_conf);
+        }
+
+    return this->reduceOverlapCount(overlap_count, early_exit);
+    }
+
+/*! \param old_box Global box the particles are currently in
+    \param new_box Global box to scale the particles to
+*/
+template<class Shape>
+void IntegratorHPMCMonoGPU<Shape>::scaleParticles(const BoxDim& old_box, const BoxDim& new_box)
+    {
+    ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+
+    m_tuner_scale->begin();
+    gpu::hpmc_scale(d_postype.data,
+                    this->m_pdata->getN(),
+                    old_box,
+                    new_box,
+                    m_tuner_scale->getParam());
+    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner_scale->end();
     }
 
 template<class Shape> void IntegratorHPMCMonoGPU<Shape>::initializeExcellMem()
@@ -2187,6 +2579,9 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::updateCellWidth()
         CHECK_CUDA_ERROR();
         }
 
+    // the sizes of the shape parameters may have changed
+    m_param_order_changed = true;
+
     // reinitialize poisson means array
     ArrayHandle<Scalar> h_lambda(m_lambda, access_location::host, access_mode::overwrite);
 
@@ -2227,6 +2622,69 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::updateCellWidth()
         }
     }
 
+/*! The narrow phase loads the shape parameters into shared memory in the order of m_param_order
+    until it runs out of space, later types read their parameters from global memory. Loading the
+    types with the most local particles first keeps the most frequently used parameters in shared
+    memory when the parameters of all types do not fit.
+*/
+template<class Shape> void IntegratorHPMCMonoGPU<Shape>::updateParamOrder()
+    {
+    const unsigned int ntypes = this->m_pdata->getNTypes();
+    std::vector<unsigned int> type_count(ntypes, 0);
+        {
+        ArrayHandle<Scalar4> h_postype(this->m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::read);
+        for (unsigned int i = 0; i < this->m_pdata->getN(); ++i)
+            type_count[__scalar_as_int(h_postype.data[i].w)]++;
+        }
+
+    // sync up so we can write to the managed order array
+    hipDeviceSynchronize();
+    std::iota(m_param_order.begin(), m_param_order.end(), 0);
+    std::stable_sort(m_param_order.begin(),
+                     m_param_order.end(),
+                     [&type_count](unsigned int a, unsigned int b)
+                     { return type_count[a] > type_count[b]; });
+
+    // count the types whose parameters do not fit in the shared memory left over by the
+    // narrow phase at the smallest block size
+    const size_t min_shared_bytes = ntypes * sizeof(typename Shape::param_type)
+                                    + this->m_overlap_idx.getNumElements() * sizeof(unsigned int);
+    const size_t max_shared_bytes = this->m_exec_conf->dev_prop.sharedMemPerBlock;
+    size_t available_bytes = max_shared_bytes > min_shared_bytes
+                                 ? max_shared_bytes - min_shared_bytes
+                                 : 0;
+    unsigned int n_params_global = 0;
+    for (unsigned int i = 0; i < ntypes; ++i)
+        {
+        char* ptr = (char*)nullptr;
+        unsigned int param_bytes = UINT_MAX;
+        this->m_params[m_param_order[i]].allocate_shared(ptr, param_bytes);
+        param_bytes = UINT_MAX - param_bytes;
+
+        if (param_bytes > available_bytes)
+            {
+            n_params_global++;
+            available_bytes = 0;
+            }
+        else
+            available_bytes -= param_bytes;
+        }
+
+    if (n_params_global > 0 && n_params_global != m_n_params_global)
+        {
+        this->m_exec_conf->msg->notice(2)
+            << "HPMC: The shape parameters of " << n_params_global << " of " << ntypes
+            << " types do not fit in shared memory, the narrow phase reads them from global memory."
+            << std::endl;
+        }
+
+    m_n_params_global = n_params_global;
+    m_param_order_nglobal = this->m_pdata->getNGlobal();
+    m_param_order_changed = false;
+    }
+
 namespace detail
     {
 //! Export this hpmc integrator to python
@@ -7,9 +7,13 @@
 #include "hoomd/RNGIdentifiers.h"
 #include "hoomd/RandomNumbers.h"
 
+#include <thrust/binary_search.h>
 #include <thrust/device_ptr.h>
 #include <thrust/execution_policy.h>
+#include <thrust/inner_product.h>
 #include <thrust/reduce.h>
+#include <thrust/remove.h>
+#include <thrust/scan.h>
 
 namespace hoomd
     {
@@ -300,6 +304,99 @@ void get_max_num_depletants(unsigned int* d_n_depletants,
         }
     }
 
+//! Compute the index of the first depletant of every particle
+/*! \param d_n_depletants Number of depletants per particle
+    \param d_depletant_offset Output exclusive prefix sum of \a d_n_depletants (N+1 elements)
+    \param N Number of particles
+    \param stream Stream to execute on
+    \param alloc Caching allocator for temporary storage
+    \returns The total number of depletants
+*/
+unsigned int get_depletant_offsets(const unsigned int* d_n_depletants,
+                                   unsigned int* d_depletant_offset,
+                                   const unsigned int N,
+                                   const hipStream_t stream,
+                                   CachedAllocator& alloc)
+    {
+    assert(d_n_depletants);
+    assert(d_depletant_offset);
+    thrust::device_ptr<const unsigned int> n_depletants(d_n_depletants);
+    thrust::device_ptr<unsigned int> depletant_offset(d_depletant_offset);
+
+    hipMemsetAsync(d_depletant_offset, 0, sizeof(unsigned int), stream);
+#ifdef __HIP_PLATFORM_HCC__
+    thrust::inclusive_scan(thrust::hip::par(alloc).on(stream),
+#else
+    thrust::inclusive_scan(thrust::cuda::par(alloc).on(stream),
+#endif
+                           n_depletants,
+                           n_depletants + N,
+                           depletant_offset + 1);
+
+    unsigned int n_depletants_total;
+    hipMemcpyAsync(&n_depletants_total,
+                   d_depletant_offset + N,
+                   sizeof(unsigned int),
+                   hipMemcpyDeviceToHost,
+                   stream);
+    hipStreamSynchronize(stream);
+    return n_depletants_total;
+    }
+
+//! Compact the candidate depletants and find the first candidate of every particle
+/*! \param d_candidates Flattened depletant indices of the candidates, 0xffffffff for the others.
+           Compacted in place.
+    \param n_depletants_total Number of elements in \a d_candidates
+    \param d_depletant_offset Index of the first depletant of every particle (N+1 elements)
+    \param d_candidate_offset Output index of the first candidate of every particle (N+1 elements)
+    \param N Number of particles
+    \param stream Stream to execute on
+    \param alloc Caching allocator for temporary storage
+    \returns The maximum number of candidates of any particle
+
+    The flattened depletant indices increase with the particle index, so the compacted list is
+    sorted and the candidates of every particle are contiguous.
+*/
+unsigned int compact_depletant_candidates(unsigned int* d_candidates,
+                                          const unsigned int n_depletants_total,
+                                          const unsigned int* d_depletant_offset,
+                                          unsigned int* d_candidate_offset,
+                                          const unsigned int N,
+                                          const hipStream_t stream,
+                                          CachedAllocator& alloc)
+    {
+    assert(d_candidates);
+    assert(d_depletant_offset);
+    assert(d_candidate_offset);
+    thrust::device_ptr<unsigned int> candidates(d_candidates);
+    thrust::device_ptr<const unsigned int> depletant_offset(d_depletant_offset);
+    thrust::device_ptr<unsigned int> candidate_offset(d_candidate_offset);
+
+#ifdef __HIP_PLATFORM_HCC__
+    auto policy = thrust::hip::par(alloc).on(stream);
+#else
+    auto policy = thrust::cuda::par(alloc).on(stream);
+#endif
+
+    auto candidates_end
+        = thrust::remove(policy, candidates, candidates + n_depletants_total, 0xffffffff);
+
+    thrust::lower_bound(policy,
+                        candidates,
+                        candidates_end,
+                        depletant_offset,
+                        depletant_offset + N + 1,
+                        candidate_offset);
+
+    return thrust::inner_product(policy,
+                                 candidate_offset + 1,
+                                 candidate_offset + N + 1,
+                                 candidate_offset,
+                                 0u,
+                                 thrust::maximum<unsigned int>(),
+                                 thrust::minus<unsigned int>());
+    }
+
 //! Compute the max # of depletants per particle, trial insertion, and configuration
 void get_max_num_depletants_ntrial(const unsigned int ntrial,
                                    unsigned int* d_n_depletants,
@@ -41,6 +41,286 @@ namespace gpu
 #ifdef __HIPCC__
 namespace kernel
     {
+//! Compute the box that the depletants of particle i are inserted into
+/*! \param shape_i Shape of particle i
+    \param pos_i Position of particle i
+    \param param_a Shape parameters of the first depletant type
+    \param param_b Shape parameters of the second depletant type
+    \param dim Dimensionality of the system
+
+    \returns The OBB of shape i, extended by the circumsphere radius of the larger depletant
+*/
+template<class Shape>
+__device__ inline detail::OBB get_depletant_obb(const Shape& shape_i,
+                                                const vec3<Scalar>& pos_i,
+                                                const typename Shape::param_type& param_a,
+                                                const typename Shape::param_type& param_b,
+                                                const unsigned int dim)
+    {
+    detail::OBB obb_i = shape_i.getOBB(pos_i);
+
+    // extend by depletant radius
+    Shape shape_test_a(quat<Scalar>(), param_a);
+    Shape shape_test_b(quat<Scalar>(), param_b);
+
+    Scalar r = 0.5
+               * detail::max(shape_test_a.getCircumsphereDiameter(),
+                             shape_test_b.getCircumsphereDiameter());
+    obb_i.lengths.x += r;
+    obb_i.lengths.y += r;
+
+    if (dim == 3)
+        obb_i.lengths.z += r;
+    else
+        obb_i.lengths.z = OverlapReal(0.5);
+
+    return obb_i;
+    }
+
+//! Test if a depletant changes its overlap with particle i in the trial move
+/*! \returns true if the depletant overlaps the old but not the new configuration of i (the new
+    but not the old one if \a repulsive), and needs to be checked against the other particles
+*/
+template<class Shape, bool pairwise>
+__device__ inline bool is_depletant_candidate(const vec3<Scalar>& pos_test,
+                                              const Shape& shape_test_a,
+                                              const Shape& shape_test_b,
+                                              const Scalar3& pos_i_old,
+                                              const Scalar4& orientation_i_old,
+                                              const Scalar3& pos_i_new,
+                                              const Scalar4& orientation_i_new,
+                                              const typename Shape::param_type& param_i,
+                                              const unsigned int type_i,
+                                              const unsigned int* check_overlaps,
+                                              const Index2D& overlap_idx,
+                                              const unsigned int depletant_type_a,
+                                              const unsigned int depletant_type_b,
+                                              const bool repulsive,
+                                              unsigned int& err_count,
+                                              unsigned int& overlap_checks)
+    {
+    overlap_checks += 2;
+
+    Shape shape_i(quat<Scalar>(), param_i);
+    if (shape_i.hasOrientation())
+        shape_i.orientation = quat<Scalar>(orientation_i_old);
+    vec3<Scalar> r_ij = vec3<Scalar>(pos_i_old) - pos_test;
+    bool overlap_old_a = (check_overlaps[overlap_idx(type_i, depletant_type_a)]
+                          && check_circumsphere_overlap(r_ij, shape_test_a, shape_i)
+                          && test_overlap(r_ij, shape_test_a, shape_i, err_count));
+
+    bool overlap_old_b = overlap_old_a;
+    if (pairwise)
+        {
+        overlap_checks++;
+        overlap_old_b = (check_overlaps[overlap_idx(type_i, depletant_type_b)]
+                         && check_circumsphere_overlap(r_ij, shape_test_b, shape_i)
+                         && test_overlap(r_ij, shape_test_b, shape_i, err_count));
+        }
+
+    if (shape_i.hasOrientation())
+        shape_i.orientation = quat<Scalar>(orientation_i_new);
+    r_ij = vec3<Scalar>(pos_i_new) - pos_test;
+    bool overlap_new_a = (check_overlaps[overlap_idx(type_i, depletant_type_a)]
+                          && check_circumsphere_overlap(r_ij, shape_test_a, shape_i)
+                          && test_overlap(r_ij, shape_test_a, shape_i, err_count));
+
+    bool overlap_new_b = overlap_new_a;
+
+    if (pairwise)
+        {
+        overlap_checks++;
+        overlap_new_b = (check_overlaps[overlap_idx(type_i, depletant_type_b)]
+                         && check_circumsphere_overlap(r_ij, shape_test_b, shape_i)
+                         && test_overlap(r_ij, shape_test_b, shape_i, err_count));
+        }
+
+    return (!repulsive && ((overlap_old_a && !overlap_new_a) || (overlap_old_b && !overlap_new_b)))
+           || (repulsive
+               && ((overlap_new_a && !overlap_old_a) || (overlap_new_b && !overlap_old_b)));
+    }
+
+//! Kernel to flag the depletants that need to be checked against the other particles
+/*! One thread per depletant. Depletant \a idx belongs to the particle i with
+    d_depletant_offset[i] <= idx < d_depletant_offset[i+1], and is generated exactly as in
+    hpmc_insert_depletants. d_candidates[idx] is set to \a idx if the depletant is a candidate
+    (see is_depletant_candidate()), and to 0xffffffff otherwise.
+*/
+template<class Shape, bool pairwise>
+__global__ void hpmc_depletant_candidates(const Scalar4* d_trial_postype,
+                                          const Scalar4* d_trial_orientation,
+                                          const Scalar4* d_postype,
+                                          const Scalar4* d_orientation,
+                                          hpmc_counters_t* d_counters,
+                                          const unsigned int N,
+                                          const unsigned int num_types,
+                                          const uint16_t seed,
+                                          const unsigned int* d_check_overlaps,
+                                          const Index2D overlap_idx,
+                                          const uint64_t timestep,
+                                          const unsigned int dim,
+                                          const unsigned int select,
+                                          const unsigned int* d_reject_out_of_cell,
+                                          const typename Shape::param_type* d_params,
+                                          unsigned int max_extra_bytes,
+                                          unsigned int depletant_type_a,
+                                          unsigned int depletant_type_b,
+                                          const Index2D depletant_idx,
+                                          bool repulsive,
+                                          const unsigned int* d_depletant_offset,
+                                          const unsigned int n_depletants_total,
+                                          unsigned int* d_candidates)
+    {
+    __shared__ unsigned int s_overlap_checks;
+    __shared__ unsigned int s_overlap_err_count;
+
+    HIP_DYNAMIC_SHARED(char, s_data)
+    typename Shape::param_type* s_params = (typename Shape::param_type*)(&s_data[0]);
+    unsigned int* s_check_overlaps = (unsigned int*)(s_params + num_types);
+
+        // copy over parameters one int per thread for fast loads
+        {
+        unsigned int tidx = threadIdx.x;
+        unsigned int block_size = blockDim.x;
+        unsigned int param_size = num_types * sizeof(typename Shape::param_type) / sizeof(int);
+
+        for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += block_size)
+            {
+            if (cur_offset + tidx < param_size)
+                {
+                ((int*)s_params)[cur_offset + tidx] = ((int*)d_params)[cur_offset + tidx];
+                }
+            }
+
+        unsigned int ntyppairs = overlap_idx.getNumElements();
+
+        for (unsigned int cur_offset = 0; cur_offset < ntyppairs; cur_offset += block_size)
+            {
+            if (cur_offset + tidx < ntyppairs)
+                {
+                s_check_overlaps[cur_offset + tidx] = d_check_overlaps[cur_offset + tidx];
+                }
+            }
+        }
+
+    __syncthreads();
+
+    // initialize extra shared mem
+    char* s_extra = (char*)(s_check_overlaps + overlap_idx.getNumElements());
+
+    unsigned int available_bytes = max_extra_bytes;
+    for (unsigned int cur_type = 0; cur_type < num_types; ++cur_type)
+        s_params[cur_type].load_shared(s_extra, available_bytes);
+
+    if (threadIdx.x == 0)
+        {
+        s_overlap_checks = 0;
+        s_overlap_err_count = 0;
+        }
+
+    __syncthreads();
+
+    unsigned int err_count = 0;
+    unsigned int overlap_checks = 0;
+
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx < n_depletants_total)
+        {
+        // find the particle this depletant belongs to
+        unsigned int first = 0;
+        unsigned int last = N;
+        while (last - first > 1)
+            {
+            unsigned int mid = (first + last) / 2;
+            if (d_depletant_offset[mid] <= idx)
+                first = mid;
+            else
+                last = mid;
+            }
+        unsigned int i = first;
+        unsigned int i_dep = idx - d_depletant_offset[i];
+
+        bool candidate = false;
+
+        // particles that have left the cell are rejected a priori
+        if (!d_reject_out_of_cell[i])
+            {
+            Scalar4 postype_i_new = d_trial_postype[i];
+            Scalar4 postype_i_old = d_postype[i];
+            Scalar3 pos_i_new = make_scalar3(postype_i_new.x, postype_i_new.y, postype_i_new.z);
+            Scalar3 pos_i_old = make_scalar3(postype_i_old.x, postype_i_old.y, postype_i_old.z);
+            unsigned int type_i = __scalar_as_int(postype_i_new.w);
+            Scalar4 orientation_i_new = d_trial_orientation[i];
+            Scalar4 orientation_i_old = d_orientation[i];
+
+            Shape shape_i(quat<Scalar>(repulsive ? orientation_i_new : orientation_i_old),
+                          s_params[type_i]);
+            detail::OBB obb_i
+                = get_depletant_obb(shape_i,
+                                    repulsive ? vec3<Scalar>(pos_i_new) : vec3<Scalar>(pos_i_old),
+                                    s_params[depletant_type_a],
+                                    s_params[depletant_type_b],
+                                    dim);
+
+            // one RNG per depletant
+            hoomd::RandomGenerator rng(
+                hoomd::Seed(hoomd::RNGIdentifier::HPMCDepletants, timestep, seed),
+                hoomd::Counter(i,
+                               i_dep,
+                               depletant_idx(depletant_type_a, depletant_type_b),
+                               static_cast<uint16_t>(select)));
+
+            // test depletant position and orientation
+            vec3<Scalar> pos_test = vec3<Scalar>(generatePositionInOBB(rng, obb_i, dim));
+
+            Shape shape_test_a(quat<Scalar>(), s_params[depletant_type_a]);
+            Shape shape_test_b(quat<Scalar>(), s_params[depletant_type_b]);
+            quat<Scalar> o;
+            if (shape_test_a.hasOrientation() || shape_test_b.hasOrientation())
+                {
+                o = generateRandomOrientation(rng, dim);
+                }
+            if (shape_test_a.hasOrientation())
+                shape_test_a.orientation = o;
+            if (shape_test_b.hasOrientation())
+                shape_test_b.orientation = o;
+
+            candidate = is_depletant_candidate<Shape, pairwise>(pos_test,
+                                                                shape_test_a,
+                                                                shape_test_b,
+                                                                pos_i_old,
+                                                                orientation_i_old,
+                                                                pos_i_new,
+                                                                orientation_i_new,
+                                                                s_params[type_i],
+                                                                type_i,
+                                                                s_check_overlaps,
+                                                                overlap_idx,
+                                                                depletant_type_a,
+                                                                depletant_type_b,
+                                                                repulsive,
+                                                                err_count,
+                                                                overlap_checks);
+            }
+
+        d_candidates[idx] = candidate ? idx : 0xffffffff;
+        }
+
+    if (err_count > 0)
+        atomicAdd(&s_overlap_err_count, err_count);
+    if (overlap_checks > 0)
+        atomicAdd(&s_overlap_checks, overlap_checks);
+
+    __syncthreads();
+
+    if (threadIdx.x == 0)
+        {
+        atomicAdd(&d_counters->overlap_err_count, s_overlap_err_count);
+        atomicAdd(&d_counters->overlap_checks, s_overlap_checks);
+        }
+    }
+
 //! Kernel to insert depletants on-the-fly
 template<class Shape, unsigned int max_threads, bool pairwise>
 #ifdef __HIP_PLATFORM_NVCC__
@@ -81,7 +361,10 @@ __launch_bounds__(max_threads)
                                            bool repulsive,
                                            unsigned int work_offset,
                                            unsigned int max_depletant_queue_size,
-                                           const unsigned int* d_n_depletants)
+                                           const unsigned int* d_n_depletants,
+                                           const unsigned int* d_depletant_offset,
+                                           const unsigned int* d_candidates,
+                                           const unsigned int* d_candidate_offset)
     {
     // variables to tell what type of thread we are
     unsigned int group = threadIdx.z;
@@ -200,6 +483,15 @@ __launch_bounds__(max_threads)
     // generate random number of depletants from Poisson distribution
     unsigned int n_depletants = d_n_depletants[i];
 
+    // with a candidate list, loop only over the depletants that were flagged for particle i
+    unsigned int n_work = n_depletants;
+    unsigned int candidate_begin = 0;
+    if (d_candidates)
+        {
+        candidate_begin = d_candidate_offset[i];
+        n_work = d_candidate_offset[i + 1] - candidate_begin;
+        }
+
     unsigned int overlap_checks = 0;
 
     // find the cell this particle should be in
@@ -213,22 +505,11 @@ __launch_bounds__(max_threads)
         // get shape OBB
         Shape shape_i(quat<Scalar>(!repulsive ? d_orientation[i] : d_trial_orientation[i]),
                       s_params[s_type_i]);
-        obb_i = shape_i.getOBB(repulsive ? vec3<Scalar>(s_pos_i_new) : vec3<Scalar>(s_pos_i_old));
-
-        // extend by depletant radius
-        Shape shape_test_a(quat<Scalar>(), s_params[depletant_type_a]);
-        Shape shape_test_b(quat<Scalar>(), s_params[depletant_type_b]);
-
-        Scalar r = 0.5
-                   * detail::max(shape_test_a.getCircumsphereDiameter(),
-                                 shape_test_b.getCircumsphereDiameter());
-        obb_i.lengths.x += r;
-        obb_i.lengths.y += r;
-
-        if (dim == 3)
-            obb_i.lengths.z += r;
-        else
-            obb_i.lengths.z = OverlapReal(0.5);
+        obb_i = get_depletant_obb(shape_i,
+                                  repulsive ? vec3<Scalar>(s_pos_i_new) : vec3<Scalar>(s_pos_i_old),
+                                  s_params[depletant_type_a],
+                                  s_params[depletant_type_b],
+                                  dim);
         }
 
     if (master && group == 0)
@@ -241,78 +522,63 @@ __launch_bounds__(max_threads)
 
     unsigned int gidx = gridDim.y * blockIdx.z + blockIdx.y;
     unsigned int blocks_per_particle = gridDim.y * gridDim.z;
-    unsigned int i_dep = group_size * group + offset + gidx * group_size * n_groups;
+    unsigned int i_work = group_size * group + offset + gidx * group_size * n_groups;
 
     while (s_adding_depletants)
         {
-        while (s_depletant_queue_size < max_depletant_queue_size && i_dep < n_depletants
-               && !s_reject)
+        while (s_depletant_queue_size < max_depletant_queue_size && i_work < n_work && !s_reject)
             {
-            // one RNG per depletant
-            hoomd::RandomGenerator rng(
-                hoomd::Seed(hoomd::RNGIdentifier::HPMCDepletants, timestep, seed),
-                hoomd::Counter(i,
-                               i_dep,
-                               depletant_idx(depletant_type_a, depletant_type_b),
-                               static_cast<uint16_t>(select)));
+            unsigned int i_dep = i_work;
+            bool add_to_queue = true;
 
-            overlap_checks += 2;
-
-            // test depletant position and orientation
-            vec3<Scalar> pos_test = vec3<Scalar>(generatePositionInOBB(rng, obb_i, dim));
-
-            Shape shape_test_a(quat<Scalar>(), s_params[depletant_type_a]);
-            Shape shape_test_b(quat<Scalar>(), s_params[depletant_type_b]);
-            quat<Scalar> o;
-            if (shape_test_a.hasOrientation() || shape_test_b.hasOrientation())
+            if (d_candidates)
                 {
-                o = generateRandomOrientation(rng, dim);
+                // the candidate has already been tested against particle i
+                i_dep = d_candidates[candidate_begin + i_work] - d_depletant_offset[i];
                 }
-            if (shape_test_a.hasOrientation())
-                shape_test_a.orientation = o;
-            if (shape_test_b.hasOrientation())
-                shape_test_b.orientation = o;
-
-            Shape shape_i(quat<Scalar>(), s_params[s_type_i]);
-            if (shape_i.hasOrientation())
-                shape_i.orientation = quat<Scalar>(s_orientation_i_old);
-            vec3<Scalar> r_ij = vec3<Scalar>(s_pos_i_old) - pos_test;
-            bool overlap_old_a = (s_check_overlaps[overlap_idx(s_type_i, depletant_type_a)]
-                                  && check_circumsphere_overlap(r_ij, shape_test_a, shape_i)
-                                  && test_overlap(r_ij, shape_test_a, shape_i, err_count));
-
-            bool overlap_old_b = overlap_old_a;
-            if (pairwise)
-                {
-                overlap_checks++;
-                overlap_old_b = (s_check_overlaps[overlap_idx(s_type_i, depletant_type_b)]
-                                 && check_circumsphere_overlap(r_ij, shape_test_b, shape_i)
-                                 && test_overlap(r_ij, shape_test_b, shape_i, err_count));
-                }
-
-            if (shape_i.hasOrientation())
-                shape_i.orientation = quat<Scalar>(s_orientation_i_new);
-            r_ij = vec3<Scalar>(s_pos_i_new) - pos_test;
-            bool overlap_new_a = (s_check_overlaps[overlap_idx(s_type_i, depletant_type_a)]
-                                  && check_circumsphere_overlap(r_ij, shape_test_a, shape_i)
-                                  && test_overlap(r_ij, shape_test_a, shape_i, err_count));
-
-            bool overlap_new_b = overlap_new_a;
-
-            if (pairwise)
+            else
                 {
-                overlap_checks++;
-                overlap_new_b = (s_check_overlaps[overlap_idx(s_type_i, depletant_type_b)]
-                                 && check_circumsphere_overlap(r_ij, shape_test_b, shape_i)
-                                 && test_overlap(r_ij, shape_test_b, shape_i, err_count));
+                // one RNG per depletant
+                hoomd::RandomGenerator rng(
+                    hoomd::Seed(hoomd::RNGIdentifier::HPMCDepletants, timestep, seed),
+                    hoomd::Counter(i,
+                                   i_dep,
+                                   depletant_idx(depletant_type_a, depletant_type_b),
+                                   static_cast<uint16_t>(select)));
+
+                // test depletant position and orientation
+                vec3<Scalar> pos_test = vec3<Scalar>(generatePositionInOBB(rng, obb_i, dim));
+
+                Shape shape_test_a(quat<Scalar>(), s_params[depletant_type_a]);
+                Shape shape_test_b(quat<Scalar>(), s_params[depletant_type_b]);
+                quat<Scalar> o;
+                if (shape_test_a.hasOrientation() || shape_test_b.hasOrientation())
+                    {
+                    o = generateRandomOrientation(rng, dim);
+                    }
+                if (shape_test_a.hasOrientation())
+                    shape_test_a.orientation = o;
+                if (shape_test_b.hasOrientation())
+                    shape_test_b.orientation = o;
+
+                add_to_queue = is_depletant_candidate<Shape, pairwise>(pos_test,
+                                                                       shape_test_a,
+                                                                       shape_test_b,
+                                                                       s_pos_i_old,
+                                                                       s_orientation_i_old,
+                                                                       s_pos_i_new,
+                                                                       s_orientation_i_new,
+                                                                       s_params[s_type_i],
+                                                                       s_type_i,
+                                                                       s_check_overlaps,
+                                                                       overlap_idx,
+                                                                       depletant_type_a,
+                                                                       depletant_type_b,
+                                                                       repulsive,
+                                                                       err_count,
+                                                                       overlap_checks);
                 }
 
-            bool add_to_queue
-                = (!repulsive
-                   && ((overlap_old_a && !overlap_new_a) || (overlap_old_b && !overlap_new_b)))
-                  || (repulsive
-                      && ((overlap_new_a && !overlap_old_a) || (overlap_new_b && !overlap_old_b)));
-
             if (add_to_queue)
                 {
                 // add this particle to the queue
@@ -330,9 +596,8 @@ __launch_bounds__(max_threads)
                 } // end if add_to_queue
 
             // advance depletant idx
-            i_dep += group_size * n_groups * blocks_per_particle;
-            } // end while (s_depletant_queue_size < max_depletant_queue_size && i_dep <
-              // n_depletants)
+            i_work += group_size * n_groups * blocks_per_particle;
+            } // end while (s_depletant_queue_size < max_depletant_queue_size && i_work < n_work)
 
         __syncthreads();
 
@@ -617,7 +882,7 @@ __launch_bounds__(max_threads)
         __syncthreads();
         if (master && group == 0)
             s_depletant_queue_size = 0;
-        if (i_dep < n_depletants && !s_reject)
+        if (i_work < n_work && !s_reject)
             atomicAdd(&s_adding_depletants, 1);
         __syncthreads();
         } // end loop over depletants
@@ -828,7 +1093,10 @@ void depletants_launcher(const hpmc_args_t& args,
                 implicit_args.repulsive,
                 range.first,
                 max_depletant_queue_size,
-                implicit_args.d_n_depletants);
+                implicit_args.d_n_depletants,
+                implicit_args.d_depletant_offset,
+                implicit_args.d_candidates,
+                implicit_args.d_candidate_offset);
             }
         }
     else
@@ -843,6 +1111,133 @@ void depletants_launcher(const hpmc_args_t& args,
 
     } // end namespace kernel
 
+//! Kernel driver for kernel::hpmc_depletant_candidates()
+/*! \param args Bundled arguments
+    \param implicit_args Bundled arguments related to depletants
+    \param d_params Per-type shape parameters
+    \param d_candidates Output flattened depletant index of each candidate, or 0xffffffff
+    \param n_depletants_total Total number of depletants
+    \param block_size Block size to execute
+
+    Requires a single active GPU. implicit_args.d_depletant_offset must hold the index of the
+    first depletant of every particle, see get_depletant_offsets().
+
+    \ingroup hpmc_kernels
+*/
+template<class Shape>
+void hpmc_depletant_candidates(const hpmc_args_t& args,
+                               const hpmc_implicit_args_t& implicit_args,
+                               const typename Shape::param_type* params,
+                               unsigned int* d_candidates,
+                               const unsigned int n_depletants_total,
+                               const unsigned int block_size)
+    {
+    if (n_depletants_total == 0)
+        return;
+
+    assert(args.gpu_partition.getNumActiveGPUs() == 1);
+    assert(implicit_args.d_depletant_offset);
+    assert(d_candidates);
+
+    bool pairwise = implicit_args.depletant_type_a != implicit_args.depletant_type_b;
+    const void* kernel_func
+        = pairwise ? reinterpret_cast<const void*>(kernel::hpmc_depletant_candidates<Shape, true>)
+                   : reinterpret_cast<const void*>(kernel::hpmc_depletant_candidates<Shape, false>);
+
+    // determine the maximum block size and clamp the input block size down
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, kernel_func);
+    unsigned int run_block_size = min(block_size, (unsigned int)attr.maxThreadsPerBlock);
+
+    size_t shared_bytes = args.num_types * sizeof(typename Shape::param_type)
+                          + args.overlap_idx.getNumElements() * sizeof(unsigned int);
+
+    if (shared_bytes + attr.sharedSizeBytes >= args.devprop.sharedMemPerBlock)
+        throw std::runtime_error("Insufficient shared memory for HPMC kernel: reduce number of "
+                                 "particle types or size of shape parameters");
+
+    // determine dynamically requested shared memory
+    unsigned int max_extra_bytes = static_cast<unsigned int>(args.devprop.sharedMemPerBlock
+                                                             - attr.sharedSizeBytes - shared_bytes);
+    char* ptr = (char*)nullptr;
+    unsigned int available_bytes = max_extra_bytes;
+    for (unsigned int i = 0; i < args.num_types; ++i)
+        {
+        params[i].allocate_shared(ptr, available_bytes);
+        }
+    shared_bytes += max_extra_bytes - available_bytes;
+
+    auto range = args.gpu_partition.getRangeAndSetGPU(0);
+    unsigned int N = range.second - range.first;
+    hipStream_t stream = implicit_args.streams[0];
+
+    dim3 grid(n_depletants_total / run_block_size + 1, 1, 1);
+    dim3 threads(run_block_size, 1, 1);
+
+    if (pairwise)
+        {
+        hipLaunchKernelGGL((kernel::hpmc_depletant_candidates<Shape, true>),
+                           grid,
+                           threads,
+                           shared_bytes,
+                           stream,
+                           args.d_trial_postype,
+                           args.d_trial_orientation,
+                           args.d_postype,
+                           args.d_orientation,
+                           args.d_counters,
+                           N,
+                           args.num_types,
+                           args.seed,
+                           args.d_check_overlaps,
+                           args.overlap_idx,
+                           args.timestep,
+                           args.dim,
+                           args.select,
+                           args.d_reject_out_of_cell,
+                           params,
+                           max_extra_bytes,
+                           implicit_args.depletant_type_a,
+                           implicit_args.depletant_type_b,
+                           implicit_args.depletant_idx,
+                           implicit_args.repulsive,
+                           implicit_args.d_depletant_offset,
+                           n_depletants_total,
+                           d_candidates);
+        }
+    else
+        {
+        hipLaunchKernelGGL((kernel::hpmc_depletant_candidates<Shape, false>),
+                           grid,
+                           threads,
+                           shared_bytes,
+                           stream,
+                           args.d_trial_postype,
+                           args.d_trial_orientation,
+                           args.d_postype,
+                           args.d_orientation,
+                           args.d_counters,
+                           N,
+                           args.num_types,
+                           args.seed,
+                           args.d_check_overlaps,
+                           args.overlap_idx,
+                           args.timestep,
+                           args.dim,
+                           args.select,
+                           args.d_reject_out_of_cell,
+                           params,
+                           max_extra_bytes,
+                           implicit_args.depletant_type_a,
+                           implicit_args.depletant_type_b,
+                           implicit_args.depletant_idx,
+                           implicit_args.repulsive,
+                           implicit_args.d_depletant_offset,
+                           n_depletants_total,
+                           d_candidates);
+        }
+    }
+
 //! Kernel driver for kernel::insert_depletants()
 /*! \param args Bundled arguments
     \param implicit_args Bundled arguments related to depletants
@@ -35,12 +35,17 @@ struct hpmc_implicit_args_t
                          const unsigned int* _d_n_depletants,
                          const unsigned int* _max_n_depletants,
                          const unsigned int _depletants_per_thread,
-                         const hipStream_t* _streams)
+                         const hipStream_t* _streams,
+                         const unsigned int* _d_depletant_offset = nullptr,
+                         const unsigned int* _d_candidates = nullptr,
+                         const unsigned int* _d_candidate_offset = nullptr)
         : depletant_type_a(_depletant_type_a), depletant_type_b(_depletant_type_b),
           depletant_idx(_depletant_idx), d_implicit_count(_d_implicit_count),
           implicit_counters_pitch(_implicit_counters_pitch), repulsive(_repulsive),
           d_n_depletants(_d_n_depletants), max_n_depletants(_max_n_depletants),
-          depletants_per_thread(_depletants_per_thread), streams(_streams) {};
+          depletants_per_thread(_depletants_per_thread), streams(_streams),
+          d_depletant_offset(_d_depletant_offset), d_candidates(_d_candidates),
+          d_candidate_offset(_d_candidate_offset) {};
 
     const unsigned int depletant_type_a;        //!< Particle type of first depletant
     const unsigned int depletant_type_b;        //!< Particle type of second depletant
@@ -51,9 +56,12 @@ struct hpmc_implicit_args_t
     const unsigned int* d_n_depletants;         //!< Number of depletants per particle
     const unsigned int*
         max_n_depletants; //!< Maximum number of depletants inserted per particle, per device
-    unsigned int depletants_per_thread; //!< Controls parallelism (number of depletant loop
-                                        //!< iterations per group)
-    const hipStream_t* streams;         //!< Stream for this depletant type
+    unsigned int depletants_per_thread;     //!< Controls parallelism (number of depletant loop
+                                            //!< iterations per group)
+    const hipStream_t* streams;             //!< Stream for this depletant type
+    const unsigned int* d_depletant_offset; //!< Index of the first depletant of each particle
+    const unsigned int* d_candidates;       //!< Compacted candidate depletants (or NULL)
+    const unsigned int* d_candidate_offset; //!< Index of the first candidate of each particle
     };
 
 //! Driver for kernel::hpmc_insert_depletants()
@@ -82,6 +90,29 @@ void get_max_num_depletants(unsigned int* d_n_depletants,
                             const GPUPartition& gpu_partition,
                             CachedAllocator& alloc);
 
+//! Driver for kernel::hpmc_depletant_candidates()
+template<class Shape>
+void hpmc_depletant_candidates(const hpmc_args_t& args,
+                               const hpmc_implicit_args_t& implicit_args,
+                               const typename Shape::param_type* params,
+                               unsigned int* d_candidates,
+                               const unsigned int n_depletants_total,
+                               const unsigned int block_size);
+
+unsigned int get_depletant_offsets(const unsigned int* d_n_depletants,
+                                   unsigned int* d_depletant_offset,
+                                   const unsigned int N,
+                                   const hipStream_t stream,
+                                   CachedAllocator& alloc);
+
+unsigned int compact_depletant_candidates(unsigned int* d_candidates,
+                                          const unsigned int n_depletants_total,
+                                          const unsigned int* d_depletant_offset,
+                                          unsigned int* d_candidate_offset,
+                                          const unsigned int N,
+                                          const hipStream_t stream,
+                                          CachedAllocator& alloc);
+
 void reduce_counters(const unsigned int ngpu,
                      const unsigned int pitch,
                      const hpmc_counters_t* d_per_device_counters,
@@ -33,7 +33,8 @@ template<class Shape, unsigned int dim>
 __global__ void hpmc_gen_moves(const Scalar4* d_postype,
                                const Scalar4* d_orientation,
                                const Scalar4* d_vel,
-                               const unsigned int N,
+                               const unsigned int nwork,
+                               const unsigned int offset,
                                const Index3D ci,
                                const uint3 cell_dim,
                                const Scalar3 ghost_width,
@@ -94,9 +95,11 @@ __global__ void hpmc_gen_moves(const Scalar4* d_postype,
     unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
 
     // return early if we are not handling a particle
-    if (idx >= N)
+    if (idx >= nwork)
         return;
 
+    idx += offset;
+
     // read in the position and orientation of our particle.
     Scalar4 postype_i = d_postype[idx];
     Scalar4 orientation_i = make_scalar4(1, 0, 0, 0);
@@ -271,48 +274,49 @@ __global__ void hpmc_update_pdata(Scalar4* d_postype,
 #endif
         }
     }
-    } // end namespace kernel
 
-//! Kernel driver for kernel::hpmc_gen_moves
-template<class Shape>
-void hpmc_gen_moves(const hpmc_args_t& args, const typename Shape::param_type* params)
+//! Launch kernel::hpmc_gen_moves on every GPU in the partition
+template<class Shape, unsigned int dim>
+void gen_moves_launcher(const hpmc_args_t& args, const typename Shape::param_type* params)
     {
-    assert(args.d_postype);
-    assert(args.d_orientation);
-    assert(args.d_d);
-    assert(args.d_a);
+    // determine the maximum block size and clamp the input block size down, query the kernel
+    // attributes only once because this launcher runs every sweep
+    static const hipFuncAttributes attr = []()
+        {
+        hipFuncAttributes a;
+        hipFuncGetAttributes(&a, reinterpret_cast<const void*>(hpmc_gen_moves<Shape, dim>));
+        return a;
+        }();
+    int max_block_size = attr.maxThreadsPerBlock;
+
+    // choose a block size based on the max block size by regs (max_block_size) and include
+    // dynamic shared memory usage
+    unsigned int block_size = min(args.block_size, (unsigned int)max_block_size);
+    size_t shared_bytes
+        = args.num_types * (sizeof(typename Shape::param_type) + 2 * sizeof(Scalar));
 
-    if (args.dim == 2)
+    if (shared_bytes + attr.sharedSizeBytes >= args.devprop.sharedMemPerBlock)
+        throw std::runtime_error("hpmc::kernel::gen_moves() exceeds shared memory limits");
+
+    // every GPU proposes the moves of its own particles, the trial arrays are managed memory with
+    // the preferred location of each range on the GPU that owns it
+    for (int idev = args.gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
         {
-        // determine the maximum block size and clamp the input block size down
-        int max_block_size;
-        hipFuncAttributes attr;
-        hipFuncGetAttributes(&attr,
-                             reinterpret_cast<const void*>(kernel::hpmc_gen_moves<Shape, 2>));
-        max_block_size = attr.maxThreadsPerBlock;
-
-        // choose a block size based on the max block size by regs (max_block_size) and include
-        // dynamic shared memory usage
-        unsigned int block_size = min(args.block_size, (unsigned int)max_block_size);
-        size_t shared_bytes
-            = args.num_types * (sizeof(typename Shape::param_type) + 2 * sizeof(Scalar));
-
-        if (shared_bytes + attr.sharedSizeBytes >= args.devprop.sharedMemPerBlock)
-            throw std::runtime_error("hpmc::kernel::gen_moves() exceeds shared memory limits");
-
-        // setup the grid to run the kernel
-        dim3 threads(block_size, 1, 1);
-        dim3 grid(args.N / block_size + 1, 1, 1);
-
-        hipLaunchKernelGGL((kernel::hpmc_gen_moves<Shape, 2>),
-                           grid,
-                           threads,
+        auto range = args.gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+        const unsigned int num_blocks = nwork / block_size + 1;
+
+        hipLaunchKernelGGL((hpmc_gen_moves<Shape, dim>),
+                           dim3(num_blocks),
+                           dim3(block_size),
                            shared_bytes,
                            0,
                            args.d_postype,
                            args.d_orientation,
                            args.d_vel,
-                           args.N,
+                           nwork,
+                           range.first,
                            args.ci,
                            args.cell_dim,
                            args.ghost_width,
@@ -335,58 +339,25 @@ void hpmc_gen_moves(const hpmc_args_t& args, const typename Shape::param_type* p
                            args.d_reject_out_of_cell,
                            params);
         }
+    }
+    } // end namespace kernel
+
+//! Kernel driver for kernel::hpmc_gen_moves
+template<class Shape>
+void hpmc_gen_moves(const hpmc_args_t& args, const typename Shape::param_type* params)
+    {
+    assert(args.d_postype);
+    assert(args.d_orientation);
+    assert(args.d_d);
+    assert(args.d_a);
+
+    if (args.dim == 2)
+        {
+        kernel::gen_moves_launcher<Shape, 2>(args, params);
+        }
     else
         {
-        // determine the maximum block size and clamp the input block size down
-        int max_block_size;
-        hipFuncAttributes attr;
-        hipFuncGetAttributes(&attr,
-                             reinterpret_cast<const void*>(kernel::hpmc_gen_moves<Shape, 3>));
-        max_block_size = attr.maxThreadsPerBlock;
-
-        // choose a block size based on the max block size by regs (max_block_size) and include
-        // dynamic shared memory usage
-        unsigned int block_size = min(args.block_size, (unsigned int)max_block_size);
-        size_t shared_bytes
-            = args.num_types * (sizeof(typename Shape::param_type) + 2 * sizeof(Scalar));
-
-        if (shared_bytes + attr.sharedSizeBytes >= args.devprop.sharedMemPerBlock)
-            throw std::runtime_error("hpmc::kernel::gen_moves() exceeds shared memory limits");
-
-        // setup the grid to run the kernel
-        dim3 threads(block_size, 1, 1);
-        dim3 grid(args.N / block_size + 1, 1, 1);
-
-        hipLaunchKernelGGL((kernel::hpmc_gen_moves<Shape, 3>),
-                           grid,
-                           threads,
-                           shared_bytes,
-                           0,
-                           args.d_postype,
-                           args.d_orientation,
-                           args.d_vel,
-                           args.N,
-                           args.ci,
-                           args.cell_dim,
-                           args.ghost_width,
-                           args.num_types,
-                           args.seed,
-                           args.rank,
-                           args.d_d,
-                           args.d_a,
-                           args.move_ratio,
-                           args.timestep,
-                           args.box,
-                           args.select,
-                           args.ghost_fraction,
-                           args.domain_decomposition,
-                           args.have_auxilliary_variable,
-                           args.d_trial_postype,
-                           args.d_trial_orientation,
-                           args.d_trial_vel,
-                           args.d_trial_move_type,
-                           args.d_reject_out_of_cell,
-                           params);
+        kernel::gen_moves_launcher<Shape, 3>(args, params);
         }
     }
 
@@ -394,11 +365,16 @@ void hpmc_gen_moves(const hpmc_args_t& args, const typename Shape::param_type* p
 template<class Shape>
 void hpmc_update_pdata(const hpmc_update_args_t& args, const typename Shape::param_type* params)
     {
-    // determine the maximum block size and clamp the input block size down
-    int max_block_size;
-    hipFuncAttributes attr;
-    hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel::hpmc_update_pdata<Shape>));
-    max_block_size = attr.maxThreadsPerBlock;
+    // determine the maximum block size and clamp the input block size down, query the kernel
+    // attributes only once because this driver runs every sweep
+    static const hipFuncAttributes attr = []()
+        {
+        hipFuncAttributes a;
+        hipFuncGetAttributes(&a,
+                             reinterpret_cast<const void*>(kernel::hpmc_update_pdata<Shape>));
+        return a;
+        }();
+    int max_block_size = attr.maxThreadsPerBlock;
 
     unsigned int block_size = min(args.block_size, (unsigned int)max_block_size);
     for (int idev = args.gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
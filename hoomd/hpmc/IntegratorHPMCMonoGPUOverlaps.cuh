@@ -0,0 +1,245 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/Index1D.h"
+#include "hoomd/VectorMath.h"
+#include <hip/hip_runtime.h>
+
+#include "GPUHelpers.cuh"
+#include "HPMCPrecisionSetup.h"
+
+// base data types
+#include "IntegratorHPMCMonoGPUTypes.cuh"
+
+/*! \file IntegratorHPMCMonoGPUOverlaps.cuh
+    \brief Declaration of the kernel that counts overlaps between the current particle positions
+*/
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+namespace gpu
+    {
+#ifdef __HIPCC__
+namespace kernel
+    {
+//! Count the overlapping pairs of particles
+/*! Each group of threads handles one particle i. The threads of a group loop over the particles
+    in the expanded cell of particle i and count the pairs that overlap, like
+    IntegratorHPMCMono::countOverlaps(). A pair is counted only by the particle with the smaller
+    tag. With early_exit, all threads stop as soon as any overlap has been found and blocks that
+    start after that return without loading the shape parameters.
+*/
+template<class Shape>
+__global__ void hpmc_count_overlaps(const Scalar4* d_postype,
+                                    const Scalar4* d_orientation,
+                                    const unsigned int* d_tag,
+                                    const unsigned int N,
+                                    const Index3D ci,
+                                    const uint3 cell_dim,
+                                    const Scalar3 ghost_width,
+                                    const unsigned int* d_excell_idx,
+                                    const unsigned int* d_excell_size,
+                                    const Index2D excli,
+                                    const unsigned int num_types,
+                                    const BoxDim box,
+                                    const unsigned int* d_check_overlaps,
+                                    const Index2D overlap_idx,
+                                    const bool early_exit,
+                                    unsigned int* d_overlap_count,
+                                    const typename Shape::param_type* d_params,
+                                    unsigned int max_extra_bytes)
+    {
+    unsigned int offset = threadIdx.x;
+    unsigned int tpp = blockDim.x;
+    unsigned int group = threadIdx.y;
+    unsigned int n_groups = blockDim.y;
+
+    unsigned int i = blockIdx.x * n_groups + group;
+
+    // skip the whole block when another block already found an overlap, one thread reads the
+    // counter so that all threads of the block agree
+    __shared__ unsigned int s_done;
+    if (threadIdx.x == 0 && threadIdx.y == 0)
+        s_done = early_exit && *((volatile unsigned int*)d_overlap_count);
+    __syncthreads();
+    if (s_done)
+        return;
+
+    // load the per type pair parameters into shared memory
+    HIP_DYNAMIC_SHARED(char, s_data)
+    typename Shape::param_type* s_params = (typename Shape::param_type*)(&s_data[0]);
+    unsigned int* s_check_overlaps = (unsigned int*)(s_params + num_types);
+    unsigned int ntyppairs = overlap_idx.getNumElements();
+
+        // copy over parameters one int per thread for fast loads
+        {
+        unsigned int tidx = threadIdx.x + blockDim.x * threadIdx.y;
+        unsigned int block_size = blockDim.x * blockDim.y;
+        unsigned int param_size = num_types * sizeof(typename Shape::param_type) / sizeof(int);
+
+        for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += block_size)
+            {
+            if (cur_offset + tidx < param_size)
+                {
+                ((int*)s_params)[cur_offset + tidx] = ((int*)d_params)[cur_offset + tidx];
+                }
+            }
+
+        for (unsigned int cur_offset = 0; cur_offset < ntyppairs; cur_offset += block_size)
+            {
+            if (cur_offset + tidx < ntyppairs)
+                {
+                s_check_overlaps[cur_offset + tidx] = d_check_overlaps[cur_offset + tidx];
+                }
+            }
+        }
+
+    __syncthreads();
+
+    // initialize extra shared mem
+    char* s_extra = (char*)(s_check_overlaps + ntyppairs);
+
+    unsigned int available_bytes = max_extra_bytes;
+    for (unsigned int cur_type = 0; cur_type < num_types; ++cur_type)
+        s_params[cur_type].load_shared(s_extra, available_bytes);
+
+    __syncthreads();
+
+    if (i >= N)
+        return;
+
+    Scalar4 postype_i = d_postype[i];
+    vec3<Scalar> pos_i(postype_i);
+    unsigned int typ_i = __scalar_as_int(postype_i.w);
+    unsigned int tag_i = d_tag[i];
+    Shape shape_i(quat<Scalar>(), s_params[typ_i]);
+    if (shape_i.hasOrientation())
+        shape_i.orientation = quat<Scalar>(d_orientation[i]);
+
+    unsigned int my_cell
+        = computeParticleCell(vec_to_scalar3(pos_i), box, ghost_width, cell_dim, ci, false);
+    unsigned int excell_size = d_excell_size[my_cell];
+
+    unsigned int n_overlaps = 0;
+    for (unsigned int k = offset; k < excell_size; k += tpp)
+        {
+        // another thread already found an overlap
+        if (early_exit && *((volatile unsigned int*)d_overlap_count))
+            break;
+
+        unsigned int j = __ldg(&d_excell_idx[excli(k, my_cell)]);
+        if (j == i || tag_i > __ldg(d_tag + j))
+            continue;
+
+        Scalar4 postype_j = __ldg(d_postype + j);
+        unsigned int typ_j = __scalar_as_int(postype_j.w);
+        if (!s_check_overlaps[overlap_idx(typ_i, typ_j)])
+            continue;
+
+        Shape shape_j(quat<Scalar>(), s_params[typ_j]);
+        if (shape_j.hasOrientation())
+            shape_j.orientation = quat<Scalar>(__ldg(d_orientation + j));
+
+        // put particle j into the coordinate system of particle i
+        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i;
+        r_ij = vec3<Scalar>(box.minImage(vec_to_scalar3(r_ij)));
+
+        OverlapReal rsq = dot(r_ij, r_ij);
+        OverlapReal DaDb = shape_i.getCircumsphereDiameter() + shape_j.getCircumsphereDiameter();
+
+        unsigned int err_count = 0;
+        if (rsq * OverlapReal(4.0) <= DaDb * DaDb && test_overlap(r_ij, shape_i, shape_j, err_count)
+            && test_overlap(-r_ij, shape_j, shape_i, err_count))
+            {
+            n_overlaps++;
+            if (early_exit)
+                {
+                atomicAdd(d_overlap_count, 1);
+                break;
+                }
+            }
+        }
+
+    if (!early_exit && n_overlaps)
+        atomicAdd(d_overlap_count, n_overlaps);
+    }
+
+    } // end namespace kernel
+
+//! Driver for kernel::hpmc_count_overlaps()
+/*! \param args Bundled arguments
+    \param params Per-type shape parameters
+
+    The count is reset before the kernel runs. The caller reads it back from args.d_overlap_count.
+*/
+template<class Shape>
+void hpmc_count_overlaps(const hpmc_count_overlaps_args_t& args,
+                         const typename Shape::param_type* params)
+    {
+    assert(args.d_postype);
+    assert(args.d_overlap_count);
+
+    hipMemsetAsync(args.d_overlap_count, 0, sizeof(unsigned int));
+
+    // determine the maximum block size and clamp the input block size down
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel::hpmc_count_overlaps<Shape>));
+    unsigned int max_block_size = attr.maxThreadsPerBlock;
+    unsigned int block_size = min(args.block_size, max_block_size);
+
+    unsigned int tpp = min(args.tpp, block_size);
+    unsigned int n_groups = block_size / tpp;
+
+    dim3 threads(tpp, n_groups, 1);
+    dim3 grid(args.N / n_groups + 1, 1, 1);
+
+    size_t shared_bytes = args.num_types * sizeof(typename Shape::param_type)
+                          + args.overlap_idx.getNumElements() * sizeof(unsigned int);
+
+    unsigned int max_extra_bytes = static_cast<unsigned int>(args.devprop.sharedMemPerBlock
+                                                             - attr.sharedSizeBytes - shared_bytes);
+
+    // determine dynamically requested shared memory
+    char* ptr = (char*)nullptr;
+    unsigned int available_bytes = max_extra_bytes;
+    for (unsigned int i = 0; i < args.num_types; ++i)
+        {
+        params[i].allocate_shared(ptr, available_bytes);
+        }
+    shared_bytes += max_extra_bytes - available_bytes;
+
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(kernel::hpmc_count_overlaps<Shape>),
+                       grid,
+                       threads,
+                       shared_bytes,
+                       0,
+                       args.d_postype,
+                       args.d_orientation,
+                       args.d_tag,
+                       args.N,
+                       args.ci,
+                       args.cell_dim,
+                       args.ghost_width,
+                       args.d_excell_idx,
+                       args.d_excell_size,
+                       args.excli,
+                       args.num_types,
+                       args.box,
+                       args.d_check_overlaps,
+                       args.overlap_idx,
+                       args.early_exit,
+                       args.d_overlap_count,
+                       params,
+                       max_extra_bytes);
+    }
+#endif
+
+    } // end namespace gpu
+    } // end namespace hpmc
+    } // end namespace hoomd
@@ -60,6 +60,7 @@ struct hpmc_args_t
                 const Index2D& _excli,
                 const unsigned int* _d_reject_in,
                 unsigned int* _d_reject_out,
+                const unsigned int* _d_param_order,
                 const hipDeviceProp_t& _devprop,
                 const GPUPartition& _gpu_partition,
                 const hipStream_t* _streams)
@@ -75,8 +76,8 @@ struct hpmc_args_t
           d_trial_orientation(_d_trial_orientation), d_trial_vel(_d_trial_vel),
           d_trial_move_type(_d_trial_move_type), d_update_order_by_ptl(_d_update_order_by_ptl),
           d_excell_idx(_d_excell_idx), d_excell_size(_d_excell_size), excli(_excli),
-          d_reject_in(_d_reject_in), d_reject_out(_d_reject_out), devprop(_devprop),
-          gpu_partition(_gpu_partition), streams(_streams) {};
+          d_reject_in(_d_reject_in), d_reject_out(_d_reject_out), d_param_order(_d_param_order),
+          devprop(_devprop), gpu_partition(_gpu_partition), streams(_streams) {};
 
     const Scalar4* d_postype;             //!< postype array
     const Scalar4* d_orientation;         //!< orientation array
@@ -118,6 +119,7 @@ struct hpmc_args_t
     const Index2D& excli;                      //!< Excell indexer
     const unsigned int* d_reject_in;           //!< Reject flags per particle (in)
     unsigned int* d_reject_out;                //!< Reject flags per particle (out)
+    const unsigned int* d_param_order;         //!< Order of loading parameters into shared memory
     const hipDeviceProp_t& devprop;            //!< CUDA device properties
     const GPUPartition& gpu_partition;         //!< Multi-GPU partition
     const hipStream_t* streams;                //!< kernel streams
@@ -164,6 +166,59 @@ struct hpmc_update_args_t
     const unsigned int block_size;
     };
 
+//! Wraps arguments to hpmc_count_overlaps
+/*! \ingroup hpmc_data_structs */
+struct hpmc_count_overlaps_args_t
+    {
+    //! Construct an hpmc_count_overlaps_args_t
+    hpmc_count_overlaps_args_t(const Scalar4* _d_postype,
+                               const Scalar4* _d_orientation,
+                               const unsigned int* _d_tag,
+                               const unsigned int _N,
+                               const Index3D& _ci,
+                               const uint3& _cell_dim,
+                               const Scalar3& _ghost_width,
+                               const unsigned int* _d_excell_idx,
+                               const unsigned int* _d_excell_size,
+                               const Index2D& _excli,
+                               const unsigned int _num_types,
+                               const BoxDim& _box,
+                               const unsigned int* _d_check_overlaps,
+                               const Index2D& _overlap_idx,
+                               const bool _early_exit,
+                               unsigned int* _d_overlap_count,
+                               const unsigned int _block_size,
+                               const unsigned int _tpp,
+                               const hipDeviceProp_t& _devprop)
+        : d_postype(_d_postype), d_orientation(_d_orientation), d_tag(_d_tag), N(_N), ci(_ci),
+          cell_dim(_cell_dim), ghost_width(_ghost_width), d_excell_idx(_d_excell_idx),
+          d_excell_size(_d_excell_size), excli(_excli), num_types(_num_types), box(_box),
+          d_check_overlaps(_d_check_overlaps), overlap_idx(_overlap_idx), early_exit(_early_exit),
+          d_overlap_count(_d_overlap_count), block_size(_block_size), tpp(_tpp), devprop(_devprop)
+        {
+        }
+
+    const Scalar4* d_postype;             //!< postype array
+    const Scalar4* d_orientation;         //!< orientation array
+    const unsigned int* d_tag;            //!< Particle tags
+    const unsigned int N;                 //!< Number of local particles
+    const Index3D& ci;                    //!< Cell indexer
+    const uint3& cell_dim;                //!< Cell dimensions
+    const Scalar3& ghost_width;           //!< Width of the ghost layer
+    const unsigned int* d_excell_idx;     //!< Expanded cell neighbors
+    const unsigned int* d_excell_size;    //!< Size of expanded cell list per cell
+    const Index2D& excli;                 //!< Expanded cell indexer
+    const unsigned int num_types;         //!< Number of particle types
+    const BoxDim& box;                    //!< Current local box
+    const unsigned int* d_check_overlaps; //!< Interaction matrix
+    const Index2D& overlap_idx;           //!< Interaction matrix indexer
+    const bool early_exit;                //!< Stop counting after the first overlap
+    unsigned int* d_overlap_count;        //!< Number of overlapping pairs (output)
+    const unsigned int block_size;        //!< Block size to execute
+    const unsigned int tpp;               //!< Threads per particle
+    const hipDeviceProp_t& devprop;       //!< CUDA device properties
+    };
+
 //! Driver for kernel::hpmc_narrow_phase()
 template<class Shape>
 void hpmc_narrow_phase(const hpmc_args_t& args, const typename Shape::param_type* params);
@@ -176,6 +231,11 @@ void hpmc_gen_moves(const hpmc_args_t& args, const typename Shape::param_type* p
 template<class Shape>
 void hpmc_update_pdata(const hpmc_update_args_t& args, const typename Shape::param_type* params);
 
+//! Driver for kernel::hpmc_count_overlaps()
+template<class Shape>
+void hpmc_count_overlaps(const hpmc_count_overlaps_args_t& args,
+                         const typename Shape::param_type* params);
+
 //! Driver for kernel::hpmc_excell()
 void hpmc_excell(unsigned int* d_excell_idx,
                  unsigned int* d_excell_size,
@@ -197,6 +257,13 @@ void hpmc_shift(Scalar4* d_postype,
                 const Scalar3 shift,
                 const unsigned int block_size);
 
+//! Kernel driver for kernel::hpmc_scale()
+void hpmc_scale(Scalar4* d_postype,
+                const unsigned int N,
+                const BoxDim& old_box,
+                const BoxDim& new_box,
+                const unsigned int block_size);
+
 //! Kernel to evaluate convergence
 void hpmc_check_convergence(const unsigned int* d_trial_move_type,
                             const unsigned int* d_reject_out_of_cell,
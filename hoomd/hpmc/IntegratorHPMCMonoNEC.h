@@ -0,0 +1,546 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "IntegratorHPMCMono.h"
+
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+/*! \file IntegratorHPMCMonoNEC.h
+    \brief Declaration of the event-chain HPMC integrator
+    \note This header cannot be compiled by nvcc
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+//! Event-chain Monte Carlo of hard shapes
+/*! IntegratorHPMCMonoNEC replaces the translation trial moves of IntegratorHPMCMono with straight
+    event chains (Bernard, Krauth, and Wilson, 2009). A chain starts at a particle and picks a
+    random direction. The active particle moves along that direction until it touches another
+    particle, which becomes the active particle and continues the chain in the same direction. The
+    chain ends when the displacements of all its particles add up to the chain length. Every move
+    in a chain is accepted, so the chains never create overlaps and never reject.
+
+    The distance to the first contact is found with sweep_distance(), which the shape must
+    specialize. Each query is limited to the translation move size of the active particle type,
+    which keeps the swept bounding box within the range of the image list, and the particle is
+    wrapped back into the box after each move. The AABB tree is rebuilt before every sweep so that
+    the nodes grown by the chains stay tight.
+
+    Shapes with orientations perform Metropolis rotation moves with probability
+    1 - translation_move_probability, and chains otherwise. Event chains apply only to hard
+    particles: IntegratorHPMCMonoNEC does not support depletants, patch energies, external fields,
+    or domain decomposition.
+
+    Each move of a chain counts as an accepted translation move.
+
+    \ingroup hpmc_integrators
+*/
+template<class Shape> class IntegratorHPMCMonoNEC : public IntegratorHPMCMono<Shape>
+    {
+    public:
+    //! Construct the integrator
+    IntegratorHPMCMonoNEC(std::shared_ptr<SystemDefinition> sysdef)
+        : IntegratorHPMCMono<Shape>(sysdef), m_chain_length(1.0)
+        {
+        }
+
+    virtual ~IntegratorHPMCMonoNEC() { }
+
+    //! Take one timestep forward
+    virtual void update(uint64_t timestep);
+
+    //! Set the total displacement of each chain
+    void setChainLength(Scalar chain_length)
+        {
+        if (chain_length < Scalar(0.0))
+            throw std::domain_error("chain_length must be non-negative");
+        m_chain_length = chain_length;
+        }
+
+    //! Get the total displacement of each chain
+    Scalar getChainLength()
+        {
+        return m_chain_length;
+        }
+
+    protected:
+    Scalar m_chain_length; //!< Total displacement of each chain
+
+    //! Move the particles of a chain until their displacements add up to the chain length
+    void runChain(unsigned int i,
+                  const vec3<Scalar>& direction,
+                  const BoxDim& box,
+                  const unsigned int* h_overlaps,
+                  Scalar4* h_postype,
+                  const Scalar4* h_orientation,
+                  int3* h_image,
+                  const Scalar* h_d,
+                  hpmc_counters_t& counters);
+
+    //! Find the first particle that particle k touches when it moves along a direction
+    OverlapReal sweepParticle(unsigned int k,
+                              const vec3<Scalar>& direction,
+                              OverlapReal max_distance,
+                              const unsigned int* h_overlaps,
+                              const Scalar4* h_postype,
+                              const Scalar4* h_orientation,
+                              unsigned int& k_hit,
+                              hpmc_counters_t& counters);
+
+    //! Test whether the trial configuration of particle i overlaps any other particle
+    bool checkOverlap(unsigned int i,
+                      const vec3<Scalar>& pos_i,
+                      const Shape& shape_i,
+                      const unsigned int* h_overlaps,
+                      const Scalar4* h_postype,
+                      const Scalar4* h_orientation,
+                      hpmc_counters_t& counters);
+    };
+
+/*! \param timestep Current time step
+ */
+template<class Shape> void IntegratorHPMCMonoNEC<Shape>::update(uint64_t timestep)
+    {
+    Integrator::update(timestep);
+    this->m_exec_conf->msg->notice(10) << "HPMCMonoNEC update: " << timestep << std::endl;
+    IntegratorHPMC::update(timestep);
+
+    // event chains require hard particles
+    bool has_depletants = false;
+    for (unsigned int i = 0; i < this->m_depletant_idx.getNumElements(); ++i)
+        {
+        if (this->m_fugacity[i] != 0.0)
+            has_depletants = true;
+        }
+    if (has_depletants || this->m_patch || this->m_external)
+        {
+        throw std::runtime_error(
+            "Event chains do not support depletants, pair potentials, or external potentials.");
+        }
+    if (this->m_sysdef->isDomainDecomposed())
+        {
+        throw std::runtime_error("Event chains do not support domain decomposition.");
+        }
+
+    ArrayHandle<hpmc_counters_t> h_counters(this->m_count_total,
+                                            access_location::host,
+                                            access_mode::readwrite);
+    hpmc_counters_t& counters = h_counters.data[0];
+
+    const BoxDim& box = this->m_pdata->getBox();
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+    uint16_t seed = this->m_sysdef->getSeed();
+
+    // Shuffle the order of particles for this step
+    this->m_update_order.resize(this->m_pdata->getN());
+    this->m_update_order.shuffle(timestep, seed, this->m_exec_conf->getRank());
+
+    // limit m_d entries so that the swept boxes stay within the range of the image list
+    this->limitMoveDistances();
+    // update the image list
+    this->updateImageList();
+
+    if (this->m_prof)
+        this->m_prof->push(this->m_exec_conf, "HPMC update");
+
+    // access interaction matrix
+    ArrayHandle<unsigned int> h_overlaps(this->m_overlaps,
+                                         access_location::host,
+                                         access_mode::read);
+
+    for (unsigned int i_nselect = 0; i_nselect < this->m_nselect; i_nselect++)
+        {
+        // rebuild the tree to undo the node growth caused by the previous sweep
+        this->m_aabb_tree_invalid = true;
+        this->buildAABBTree();
+
+        ArrayHandle<Scalar4> h_postype(this->m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(this->m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::readwrite);
+        ArrayHandle<int3> h_image(this->m_pdata->getImages(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+        ArrayHandle<Scalar> h_d(this->m_d, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_a(this->m_a, access_location::host, access_mode::read);
+
+        // loop through N particles in a shuffled order
+        unsigned int N = this->m_pdata->getN();
+        for (unsigned int cur_particle = 0; cur_particle < N; cur_particle++)
+            {
+            unsigned int i = this->m_update_order[cur_particle];
+
+            hoomd::RandomGenerator rng_i(
+                hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoChain, timestep, seed),
+                hoomd::Counter(i, this->m_exec_conf->getRank(), i_nselect));
+
+            Scalar4 postype_i = h_postype.data[i];
+            vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+            int typ_i = __scalar_as_int(postype_i.w);
+            Shape shape_i(quat<Scalar>(h_orientation.data[i]), this->m_params[typ_i]);
+            unsigned int move_type_select = hoomd::UniformIntDistribution(0xffff)(rng_i);
+            bool move_type_translate = !shape_i.hasOrientation()
+                                       || (move_type_select < this->m_translation_move_probability);
+
+            if (move_type_translate)
+                {
+                // start a chain at i in a random direction
+                vec3<Scalar> direction;
+                if (ndim == 2)
+                    {
+                    Scalar theta = hoomd::UniformDistribution<Scalar>(Scalar(0.0),
+                                                                      Scalar(2.0 * M_PI))(rng_i);
+                    direction = vec3<Scalar>(slow::cos(theta), slow::sin(theta), Scalar(0.0));
+                    }
+                else
+                    {
+                    hoomd::SpherePointGenerator<Scalar>()(rng_i, direction);
+                    }
+
+                runChain(i,
+                         direction,
+                         box,
+                         h_overlaps.data,
+                         h_postype.data,
+                         h_orientation.data,
+                         h_image.data,
+                         h_d.data,
+                         counters);
+                }
+            else
+                {
+                if (h_a.data[typ_i] == 0.0)
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        counters.rotate_accept_count++;
+                    continue;
+                    }
+
+                if (ndim == 2)
+                    move_rotate<2>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+                else
+                    move_rotate<3>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+
+                bool overlap = checkOverlap(i,
+                                            pos_i,
+                                            shape_i,
+                                            h_overlaps.data,
+                                            h_postype.data,
+                                            h_orientation.data,
+                                            counters);
+
+                if (!overlap)
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        counters.rotate_accept_count++;
+
+                    h_orientation.data[i] = quat_to_scalar4(shape_i.orientation);
+                    this->m_aabbs[i] = this->computeParticleAABB(shape_i, pos_i, typ_i);
+                    this->m_aabb_tree.update(i, this->m_aabbs[i]);
+                    }
+                else
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        counters.rotate_reject_count++;
+                    }
+                }
+            } // end loop over all particles
+        }     // end loop over nselect
+
+    if (this->m_prof)
+        this->m_prof->pop(this->m_exec_conf);
+
+    // all particle have been moved, the aabb tree is now invalid
+    this->m_aabb_tree_invalid = true;
+    this->m_pdata->notifyPositionsChanged();
+
+    // getMPS() evaluates the moves per second up to this time
+    this->m_last_step_time = this->m_clock.getTime();
+    }
+
+/*! \param i Particle that starts the chain
+    \param direction Unit vector that the particles move along
+    \param box Local simulation box
+    \param h_overlaps Interaction matrix
+    \param h_postype Particle positions and types
+    \param h_orientation Particle orientations
+    \param h_image Particle images
+    \param h_d Translation move sizes, per type
+    \param counters Move counters
+
+    Each move is at most the translation move size of the active particle type. A chain where
+    every particle is in contact with the next one along the direction cannot move, so the chain
+    ends after N consecutive moves of zero length.
+*/
+template<class Shape>
+void IntegratorHPMCMonoNEC<Shape>::runChain(unsigned int i,
+                                            const vec3<Scalar>& direction,
+                                            const BoxDim& box,
+                                            const unsigned int* h_overlaps,
+                                            Scalar4* h_postype,
+                                            const Scalar4* h_orientation,
+                                            int3* h_image,
+                                            const Scalar* h_d,
+                                            hpmc_counters_t& counters)
+    {
+    unsigned int k = i;
+    Scalar remaining = m_chain_length;
+    unsigned int n_stuck = 0;
+
+    while (remaining > Scalar(0.0) && n_stuck <= this->m_pdata->getN())
+        {
+        Scalar4 postype_k = h_postype[k];
+        unsigned int typ_k = __scalar_as_int(postype_k.w);
+        Shape shape_k(quat<Scalar>(h_orientation[k]), this->m_params[typ_k]);
+
+        Scalar max_step = std::min(remaining, h_d[typ_k]);
+        if (max_step <= Scalar(0.0))
+            break;
+
+        unsigned int k_hit = k;
+        OverlapReal distance = sweepParticle(k,
+                                             direction,
+                                             OverlapReal(max_step),
+                                             h_overlaps,
+                                             h_postype,
+                                             h_orientation,
+                                             k_hit,
+                                             counters);
+
+        // move k and wrap it back into the box
+        vec3<Scalar> pos_k = vec3<Scalar>(postype_k) + Scalar(distance) * direction;
+        h_postype[k] = vec_to_scalar4(pos_k, postype_k.w);
+        box.wrap(h_postype[k], h_image[k]);
+        pos_k = vec3<Scalar>(h_postype[k]);
+
+        this->m_aabbs[k] = this->computeParticleAABB(shape_k, pos_k, typ_k);
+        this->m_aabb_tree.update(k, this->m_aabbs[k]);
+
+        if (!shape_k.ignoreStatistics())
+            counters.translate_accept_count++;
+
+        remaining -= Scalar(distance);
+        n_stuck = distance > OverlapReal(0.0) ? 0 : n_stuck + 1;
+
+        // pass the chain to the particle that k hit
+        k = k_hit;
+        }
+    }
+
+/*! \param k Particle to move
+    \param direction Unit vector that the particle moves along
+    \param max_distance Largest distance to move
+    \param h_overlaps Interaction matrix
+    \param h_postype Particle positions and types
+    \param h_orientation Particle orientations
+    \param k_hit Output particle that k touches first, or k when k moves \a max_distance freely
+    \param counters Move counters
+    \returns The distance that k moves
+
+    The query searches the AABB tree with the box swept by k, in all images.
+*/
+template<class Shape>
+OverlapReal IntegratorHPMCMonoNEC<Shape>::sweepParticle(unsigned int k,
+                                                        const vec3<Scalar>& direction,
+                                                        OverlapReal max_distance,
+                                                        const unsigned int* h_overlaps,
+                                                        const Scalar4* h_postype,
+                                                        const Scalar4* h_orientation,
+                                                        unsigned int& k_hit,
+                                                        hpmc_counters_t& counters)
+    {
+    Scalar4 postype_k = h_postype[k];
+    vec3<Scalar> pos_k = vec3<Scalar>(postype_k);
+    unsigned int typ_k = __scalar_as_int(postype_k.w);
+    Shape shape_k(quat<Scalar>(h_orientation[k]), this->m_params[typ_k]);
+
+    // box swept by k, relative to its position
+    hoomd::detail::AABB aabb_k_local
+        = hoomd::detail::merge(shape_k.getAABB(vec3<Scalar>(0, 0, 0)),
+                               shape_k.getAABB(Scalar(max_distance) * direction));
+
+    OverlapReal distance = max_distance;
+    k_hit = k;
+
+    // All image boxes (including the primary)
+    const unsigned int n_images = (unsigned int)this->m_image_list.size();
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_k_image = pos_k + this->m_image_list[cur_image];
+        hoomd::detail::AABB aabb = aabb_k_local;
+        aabb.translate(pos_k_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes();
+             cur_node_idx++)
+            {
+            if (detail::overlap(this->m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                {
+                if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0;
+                         cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx);
+                         cur_p++)
+                        {
+                        unsigned int j = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                        // the images of k move with it
+                        if (j == k || !detail::overlap(this->m_aabbs[j], aabb))
+                            continue;
+
+                        Scalar4 postype_j = h_postype[j];
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        if (!h_overlaps[this->m_overlap_idx(typ_k, typ_j)])
+                            continue;
+
+                        Shape shape_j(quat<Scalar>(h_orientation[j]), this->m_params[typ_j]);
+                        vec3<Scalar> r_kj = vec3<Scalar>(postype_j) - pos_k_image;
+
+                        counters.overlap_checks++;
+                        OverlapReal distance_j = sweep_distance(r_kj,
+                                                                shape_k,
+                                                                shape_j,
+                                                                direction,
+                                                                distance,
+                                                                counters.overlap_err_count);
+                        if (distance_j < distance)
+                            {
+                            distance = distance_j;
+                            k_hit = j;
+                            }
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
+                }
+            } // end loop over AABB nodes
+        }     // end loop over images
+
+    return distance;
+    }
+
+/*! \param i Particle to test
+    \param pos_i Trial position of particle i
+    \param shape_i Trial shape of particle i
+    \param h_overlaps Interaction matrix
+    \param h_postype Particle positions and types
+    \param h_orientation Particle orientations
+    \param counters Move counters
+    \returns true when the trial configuration overlaps another particle or an image of i
+*/
+template<class Shape>
+bool IntegratorHPMCMonoNEC<Shape>::checkOverlap(unsigned int i,
+                                                const vec3<Scalar>& pos_i,
+                                                const Shape& shape_i,
+                                                const unsigned int* h_overlaps,
+                                                const Scalar4* h_postype,
+                                                const Scalar4* h_orientation,
+                                                hpmc_counters_t& counters)
+    {
+    unsigned int typ_i = __scalar_as_int(h_postype[i].w);
+    hoomd::detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0, 0, 0));
+
+    // All image boxes (including the primary)
+    const unsigned int n_images = (unsigned int)this->m_image_list.size();
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_i_image = pos_i + this->m_image_list[cur_image];
+        hoomd::detail::AABB aabb = aabb_i_local;
+        aabb.translate(pos_i_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes();
+             cur_node_idx++)
+            {
+            if (detail::overlap(this->m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                {
+                if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0;
+                         cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx);
+                         cur_p++)
+                        {
+                        unsigned int j = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                        Scalar4 postype_j;
+                        quat<Scalar> orientation_j;
+                        if (j != i)
+                            {
+                            if (!detail::overlap(this->m_aabbs[j], aabb))
+                                continue;
+                            postype_j = h_postype[j];
+                            orientation_j = quat<Scalar>(h_orientation[j]);
+                            }
+                        else
+                            {
+                            // in the first image, skip i == j
+                            if (cur_image == 0)
+                                continue;
+
+                            // use the trial configuration of i in outside images
+                            postype_j = vec_to_scalar4(pos_i, h_postype[i].w);
+                            orientation_j = shape_i.orientation;
+                            }
+
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        Shape shape_j(orientation_j, this->m_params[typ_j]);
+                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+
+                        counters.overlap_checks++;
+                        if (h_overlaps[this->m_overlap_idx(typ_i, typ_j)]
+                            && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                            && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                            {
+                            return true;
+                            }
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
+                }
+            } // end loop over AABB nodes
+        }     // end loop over images
+
+    return false;
+    }
+
+namespace detail
+    {
+//! Export the IntegratorHPMCMonoNEC class to python
+/*! \param name Name of the class in the exported python module
+    \tparam Shape An instantiation of IntegratorHPMCMonoNEC<Shape> will be exported
+*/
+template<class Shape>
+void export_IntegratorHPMCMonoNEC(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_<IntegratorHPMCMonoNEC<Shape>,
+                     IntegratorHPMCMono<Shape>,
+                     std::shared_ptr<IntegratorHPMCMonoNEC<Shape>>>(m, name.c_str())
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>>())
+        .def_property("chain_length",
+                      &IntegratorHPMCMonoNEC<Shape>::getChainLength,
+                      &IntegratorHPMCMonoNEC<Shape>::setChainLength);
+    }
+
+    } // end namespace detail
+    } // end namespace hpmc
+    } // end namespace hoomd
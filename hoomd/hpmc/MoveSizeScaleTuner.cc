@@ -0,0 +1,176 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "MoveSizeScaleTuner.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+MoveSizeScaleTuner::MoveSizeScaleTuner(std::shared_ptr<SystemDefinition> sysdef,
+                                       std::shared_ptr<Trigger> trigger,
+                                       std::shared_ptr<IntegratorHPMC> mc,
+                                       const std::vector<std::string>& moves,
+                                       const std::vector<std::string>& types,
+                                       Scalar target)
+    : Tuner(sysdef, trigger), m_mc(mc), m_types(types)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing MoveSizeScaleTuner" << std::endl;
+    setMoves(moves);
+    setTarget(target);
+    }
+
+MoveSizeScaleTuner::~MoveSizeScaleTuner()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying MoveSizeScaleTuner" << std::endl;
+    }
+
+void MoveSizeScaleTuner::setMoves(const std::vector<std::string>& moves)
+    {
+    for (const auto& move : moves)
+        {
+        if (move != "a" && move != "d")
+            throw std::invalid_argument("moves must be 'a' or 'd'.");
+        }
+    m_moves = moves;
+    m_n_tuned = 0;
+    }
+
+void MoveSizeScaleTuner::setTarget(Scalar target)
+    {
+    if (target <= Scalar(0.0) || target >= Scalar(1.0))
+        throw std::invalid_argument("target must be between 0 and 1.");
+    m_target = target;
+    m_n_tuned = 0;
+    }
+
+void MoveSizeScaleTuner::setMaxScale(Scalar max_scale)
+    {
+    if (max_scale <= Scalar(1.0))
+        throw std::invalid_argument("max_scale must be greater than 1.");
+    m_max_scale = max_scale;
+    }
+
+void MoveSizeScaleTuner::setGamma(Scalar gamma)
+    {
+    if (gamma < Scalar(0.0))
+        throw std::invalid_argument("gamma must not be negative.");
+    m_gamma = gamma;
+    }
+
+void MoveSizeScaleTuner::setTol(Scalar tol)
+    {
+    if (tol <= Scalar(0.0))
+        throw std::invalid_argument("tol must be positive.");
+    m_tol = tol;
+    }
+
+Scalar MoveSizeScaleTuner::computeScale(unsigned long long int accept,
+                                        unsigned long long int reject,
+                                        bool& tuned)
+    {
+    if (accept + reject == 0)
+        return Scalar(1.0);
+
+    Scalar acceptance = Scalar(accept) / Scalar(accept + reject);
+    if (std::abs(acceptance - m_target) <= m_tol)
+        return Scalar(1.0);
+
+    tuned = false;
+
+    // larger moves are accepted less often, try an order of magnitude smaller when no moves
+    // were accepted and there is no damping
+    Scalar scale = (acceptance + m_gamma) / (m_target + m_gamma);
+    if (scale == Scalar(0.0))
+        scale = Scalar(0.1);
+    return std::min(scale, m_max_scale);
+    }
+
+void MoveSizeScaleTuner::update(uint64_t timestep)
+    {
+    Updater::update(timestep);
+
+    // getCounters sums the counters over all ranks, so every rank sets the same move sizes
+    hpmc_counters_t counters = m_mc->getCounters(0);
+
+    // the first update has no previous counters to compare to
+    if (!m_has_last_counters || counters.getNMoves() < m_last_counters.getNMoves())
+        {
+        m_has_last_counters = true;
+        m_last_counters = counters;
+        return;
+        }
+
+    hpmc_counters_t delta = counters - m_last_counters;
+    m_last_counters = counters;
+
+    bool tuned = true;
+    for (const auto& move : m_moves)
+        {
+        if (move == "d")
+            {
+            Scalar scale
+                = computeScale(delta.translate_accept_count, delta.translate_reject_count, tuned);
+            if (scale == Scalar(1.0))
+                continue;
+
+            for (const auto& type : m_types)
+                {
+                Scalar d = scale * m_mc->getD(type);
+                m_mc->setD(type, std::min(std::max(d, m_min_move_size), m_max_translation_move));
+                }
+            }
+        else
+            {
+            Scalar scale
+                = computeScale(delta.rotate_accept_count, delta.rotate_reject_count, tuned);
+            if (scale == Scalar(1.0))
+                continue;
+
+            for (const auto& type : m_types)
+                {
+                Scalar a = scale * m_mc->getA(type);
+                m_mc->setA(type, std::min(std::max(a, m_min_move_size), m_max_rotation_move));
+                }
+            }
+        }
+
+    m_n_tuned = tuned ? m_n_tuned + 1 : 0;
+    }
+
+namespace detail
+    {
+void export_MoveSizeScaleTuner(pybind11::module& m)
+    {
+    pybind11::class_<MoveSizeScaleTuner, Tuner, std::shared_ptr<MoveSizeScaleTuner>>(
+        m,
+        "MoveSizeScaleTuner")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::shared_ptr<IntegratorHPMC>,
+                            const std::vector<std::string>&,
+                            const std::vector<std::string>&,
+                            Scalar>())
+        .def_property("moves", &MoveSizeScaleTuner::getMoves, &MoveSizeScaleTuner::setMoves)
+        .def_property("types", &MoveSizeScaleTuner::getTypes, &MoveSizeScaleTuner::setTypes)
+        .def_property("target", &MoveSizeScaleTuner::getTarget, &MoveSizeScaleTuner::setTarget)
+        .def_property("max_translation_move",
+                      &MoveSizeScaleTuner::getMaxTranslationMove,
+                      &MoveSizeScaleTuner::setMaxTranslationMove)
+        .def_property("max_rotation_move",
+                      &MoveSizeScaleTuner::getMaxRotationMove,
+                      &MoveSizeScaleTuner::setMaxRotationMove)
+        .def_property("max_scale",
+                      &MoveSizeScaleTuner::getMaxScale,
+                      &MoveSizeScaleTuner::setMaxScale)
+        .def_property("gamma", &MoveSizeScaleTuner::getGamma, &MoveSizeScaleTuner::setGamma)
+        .def_property("tol", &MoveSizeScaleTuner::getTol, &MoveSizeScaleTuner::setTol)
+        .def_property_readonly("tuned", &MoveSizeScaleTuner::isTuned);
+    }
+
+    } // end namespace detail
+    } // end namespace hpmc
+    } // end namespace hoomd
@@ -0,0 +1,212 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "IntegratorHPMC.h"
+#include "hoomd/Tuner.h"
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+/** Tune HPMC move sizes to a target acceptance ratio
+
+    Each call to update() computes the acceptance ratio of the translation and rotation moves made
+    since the previous call from the integrator counters, which are summed over all MPI ranks, and
+    scales the move sizes of the selected types by
+
+        (acceptance + gamma) / (target + gamma)
+
+    limited to max_scale and clamped between a small positive value and the maximum move size.
+    This is the same update that hoomd.hpmc.tune.MoveSize performs with hoomd.tune.ScaleSolver, but
+    without evaluating the solver in Python. Every rank computes the same move sizes.
+
+    The tuner is tuned once the acceptance ratios of all selected moves are within tol of the
+    target in two consecutive calls.
+*/
+class PYBIND11_EXPORT MoveSizeScaleTuner : public Tuner
+    {
+    public:
+    /** Constructor
+
+        @param sysdef System definition
+        @param trigger Select the time steps at which to adjust the move sizes
+        @param mc HPMC integrator to tune
+        @param moves Moves to tune, a subset of "a" and "d"
+        @param types Names of the particle types to tune
+        @param target Target acceptance ratio
+    */
+    MoveSizeScaleTuner(std::shared_ptr<SystemDefinition> sysdef,
+                       std::shared_ptr<Trigger> trigger,
+                       std::shared_ptr<IntegratorHPMC> mc,
+                       const std::vector<std::string>& moves,
+                       const std::vector<std::string>& types,
+                       Scalar target);
+
+    /// Destructor
+    virtual ~MoveSizeScaleTuner();
+
+    /** Adjust the move sizes
+
+        @param timestep Current time step of the simulation
+    */
+    virtual void update(uint64_t timestep);
+
+    /// Get the moves to tune
+    std::vector<std::string> getMoves()
+        {
+        return m_moves;
+        }
+
+    /// Set the moves to tune
+    void setMoves(const std::vector<std::string>& moves);
+
+    /// Get the names of the types to tune
+    std::vector<std::string> getTypes()
+        {
+        return m_types;
+        }
+
+    /// Set the names of the types to tune
+    void setTypes(const std::vector<std::string>& types)
+        {
+        m_types = types;
+        m_n_tuned = 0;
+        }
+
+    /// Get the target acceptance ratio
+    Scalar getTarget()
+        {
+        return m_target;
+        }
+
+    /// Set the target acceptance ratio
+    void setTarget(Scalar target);
+
+    /// Get the largest translation move size
+    Scalar getMaxTranslationMove()
+        {
+        return m_max_translation_move;
+        }
+
+    /// Set the largest translation move size
+    void setMaxTranslationMove(Scalar max_translation_move)
+        {
+        m_max_translation_move = max_translation_move;
+        }
+
+    /// Get the largest rotation move size
+    Scalar getMaxRotationMove()
+        {
+        return m_max_rotation_move;
+        }
+
+    /// Set the largest rotation move size
+    void setMaxRotationMove(Scalar max_rotation_move)
+        {
+        m_max_rotation_move = max_rotation_move;
+        }
+
+    /// Get the largest factor applied to a move size in one update
+    Scalar getMaxScale()
+        {
+        return m_max_scale;
+        }
+
+    /// Set the largest factor applied to a move size in one update
+    void setMaxScale(Scalar max_scale);
+
+    /// Get the damping of the scale factor
+    Scalar getGamma()
+        {
+        return m_gamma;
+        }
+
+    /// Set the damping of the scale factor
+    void setGamma(Scalar gamma);
+
+    /// Get the tolerance of the acceptance ratio
+    Scalar getTol()
+        {
+        return m_tol;
+        }
+
+    /// Set the tolerance of the acceptance ratio
+    void setTol(Scalar tol);
+
+    /// Test if the acceptance ratios are within the tolerance of the target
+    bool isTuned()
+        {
+        return m_n_tuned >= 2;
+        }
+
+    protected:
+    /// HPMC integrator to tune
+    std::shared_ptr<IntegratorHPMC> m_mc;
+
+    /// Moves to tune
+    std::vector<std::string> m_moves;
+
+    /// Names of the types to tune
+    std::vector<std::string> m_types;
+
+    /// Target acceptance ratio
+    Scalar m_target;
+
+    /// Largest translation move size
+    Scalar m_max_translation_move = std::numeric_limits<Scalar>::infinity();
+
+    /// Largest rotation move size
+    Scalar m_max_rotation_move = std::numeric_limits<Scalar>::infinity();
+
+    /// Largest factor applied to a move size in one update
+    Scalar m_max_scale = Scalar(2.0);
+
+    /// Damping of the scale factor
+    Scalar m_gamma = Scalar(1.0);
+
+    /// Tolerance of the acceptance ratio
+    Scalar m_tol = Scalar(0.01);
+
+    /// True when m_last_counters holds the counters of the previous update
+    bool m_has_last_counters = false;
+
+    /// Counters at the previous update
+    hpmc_counters_t m_last_counters;
+
+    /// Number of consecutive updates with all moves within the tolerance
+    unsigned int m_n_tuned = 0;
+
+    /// Smallest move size the tuner sets
+    static constexpr Scalar m_min_move_size = Scalar(1e-7);
+
+    /** Compute the factor to scale a move size by
+
+        @param accept Number of accepted moves
+        @param reject Number of rejected moves
+        @param tuned Set to false when the acceptance ratio is not within the tolerance
+        @returns The scale factor, 1 when there were no moves
+    */
+    Scalar computeScale(unsigned long long int accept, unsigned long long int reject, bool& tuned);
+    };
+
+namespace detail
+    {
+/// Export the MoveSizeScaleTuner to python
+void export_MoveSizeScaleTuner(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace hpmc
+    } // end namespace hoomd
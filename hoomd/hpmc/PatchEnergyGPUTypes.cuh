@@ -0,0 +1,98 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/GPUPartition.cuh"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/Index1D.h"
+
+#include <cstdint>
+
+/*! \file PatchEnergyGPUTypes.cuh
+    \brief Declaration of the kernel arguments of the patch energy narrow phase
+*/
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+namespace detail
+    {
+//! Wraps arguments to kernel::narow_phase_patch functions
+struct hpmc_patch_args_t
+    {
+    //! Construct a hpmc_patch_args_t
+    hpmc_patch_args_t(const Scalar4* _d_postype,
+                      const Scalar4* _d_orientation,
+                      const Scalar4* _d_trial_postype,
+                      const Scalar4* _d_trial_orientation,
+                      const unsigned int* _d_trial_move_type,
+                      const Index3D& _ci,
+                      const uint3& _cell_dim,
+                      const Scalar3& _ghost_width,
+                      const unsigned int _N,
+                      const uint16_t _seed,
+                      const unsigned int _rank,
+                      const uint64_t _timestep,
+                      const unsigned int _select,
+                      const unsigned int _num_types,
+                      const BoxDim& _box,
+                      const unsigned int* _d_excell_idx,
+                      const unsigned int* _d_excell_size,
+                      const Index2D& _excli,
+                      const Scalar _r_cut_patch,
+                      const Scalar* _d_additive_cutoff,
+                      const unsigned int* _d_update_order_by_ptl,
+                      const unsigned int* _d_reject_in,
+                      unsigned int* _d_reject_out,
+                      const Scalar* _d_charge,
+                      const Scalar* _d_diameter,
+                      const unsigned int* _d_reject_out_of_cell,
+                      const GPUPartition& _gpu_partition)
+        : d_postype(_d_postype), d_orientation(_d_orientation), d_trial_postype(_d_trial_postype),
+          d_trial_orientation(_d_trial_orientation), d_trial_move_type(_d_trial_move_type), ci(_ci),
+          cell_dim(_cell_dim), ghost_width(_ghost_width), N(_N), seed(_seed), rank(_rank),
+          timestep(_timestep), select(_select), num_types(_num_types), box(_box),
+          d_excell_idx(_d_excell_idx), d_excell_size(_d_excell_size), excli(_excli),
+          r_cut_patch(_r_cut_patch), d_additive_cutoff(_d_additive_cutoff),
+          d_update_order_by_ptl(_d_update_order_by_ptl), d_reject_in(_d_reject_in),
+          d_reject_out(_d_reject_out), d_charge(_d_charge), d_diameter(_d_diameter),
+          d_reject_out_of_cell(_d_reject_out_of_cell), gpu_partition(_gpu_partition)
+        {
+        }
+
+    const Scalar4* d_postype;              //!< postype array
+    const Scalar4* d_orientation;          //!< orientation array
+    const Scalar4* d_trial_postype;        //!< New positions (and type) of particles
+    const Scalar4* d_trial_orientation;    //!< New orientations of particles
+    const unsigned int* d_trial_move_type; //!< 0=no move, 1/2 = translate/rotate
+    const Index3D& ci;                     //!< Cell indexer
+    const uint3& cell_dim;                 //!< Cell dimensions
+    const Scalar3& ghost_width;            //!< Width of the ghost layer
+    const unsigned int N;                  //!< Number of particles
+    const uint16_t seed;                   //!< RNG seed
+    const unsigned int rank;               //!< MPI Rank
+    const uint64_t timestep;               //!< Current timestep
+    const unsigned int select;
+    const unsigned int num_types;              //!< Number of particle types
+    const BoxDim& box;                         //!< Current simulation box
+    const unsigned int* d_excell_idx;          //!< Expanded cell list
+    const unsigned int* d_excell_size;         //!< Size of expanded cells
+    const Index2D& excli;                      //!< Excell indexer
+    const Scalar r_cut_patch;                  //!< Global cutoff radius
+    const Scalar* d_additive_cutoff;           //!< Additive contribution to cutoff per type
+    const unsigned int* d_update_order_by_ptl; //!< Order of the update sequence
+    const unsigned int* d_reject_in;           //!< Previous reject flags
+    unsigned int* d_reject_out;                //!< New reject flags
+    const Scalar* d_charge;                    //!< Particle charges
+    const Scalar* d_diameter;                  //!< Particle diameters
+    const unsigned int*
+        d_reject_out_of_cell;          //!< Flag if a particle move has been rejected a priori
+    const GPUPartition& gpu_partition; //!< split particles among GPUs
+    };
+
+    } // end namespace detail
+    } // end namespace hpmc
+    } // end namespace hoomd
@@ -30,7 +30,10 @@ PatchEnergyJIT::PatchEnergyJIT(std::shared_ptr<SystemDefinition> sysdef,
       m_is_union(is_union)
     {
     // build the JIT.
-    EvalFactory* factory = new EvalFactory(cpu_code, compiler_args, this->m_is_union);
+    EvalFactory* factory = new EvalFactory(cpu_code,
+                                           compiler_args,
+                                           this->m_is_union,
+                                           m_exec_conf->getJITCacheDir());
 
     // get the evaluator
     m_eval = factory->getEval();
@@ -52,8 +55,6 @@ namespace detail
     {
 void export_PatchEnergyJIT(pybind11::module& m)
     {
-    pybind11::class_<hpmc::PatchEnergy, std::shared_ptr<hpmc::PatchEnergy>>(m, "PatchEnergy")
-        .def(pybind11::init<std::shared_ptr<SystemDefinition>>());
     pybind11::class_<PatchEnergyJIT, hpmc::PatchEnergy, std::shared_ptr<PatchEnergyJIT>>(
         m,
         "PatchEnergyJIT")
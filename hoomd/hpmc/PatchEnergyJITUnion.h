@@ -41,8 +41,10 @@ class PatchEnergyJITUnion : public PatchEnergyJIT
               hoomd::detail::managed_allocator<float>(m_exec_conf->isCUDAEnabled()))
         {
         // build the JIT.
-        EvalFactory* factory_constituent
-            = new EvalFactory(cpu_code_constituent, compiler_args, this->m_is_union);
+        EvalFactory* factory_constituent = new EvalFactory(cpu_code_constituent,
+                                                           compiler_args,
+                                                           this->m_is_union,
+                                                           m_exec_conf->getJITCacheDir());
 
         // get the evaluator and check for errors
         m_eval_constituent = factory_constituent->getEval();
@@ -113,36 +113,36 @@ void PatchEnergyJITUnionGPU::computePatchEnergyGPU(const gpu_args_t& args, hipSt
                                                       eval_threads,
                                                       block_size);
 
-        CUresult res = launcher(args.d_postype,
-                                args.d_orientation,
-                                args.d_trial_postype,
-                                args.d_trial_orientation,
-                                args.d_trial_move_type,
-                                args.d_charge,
-                                args.d_diameter,
-                                args.d_excell_idx,
-                                args.d_excell_size,
-                                args.excli,
-                                args.d_update_order_by_ptl,
-                                args.d_reject_in,
-                                args.d_reject_out,
-                                args.seed,
-                                args.timestep,
-                                args.select,
-                                args.rank,
-                                args.num_types,
-                                args.box,
-                                args.ghost_width,
-                                args.cell_dim,
-                                args.ci,
-                                args.N,
-                                args.r_cut_patch,
-                                args.d_additive_cutoff,
-                                args.d_reject_out_of_cell,
-                                max_queue_size,
-                                range.first,
-                                nwork,
-                                max_extra_bytes);
+        CUresult res = launcher.launch(args.d_postype,
+                                       args.d_orientation,
+                                       args.d_trial_postype,
+                                       args.d_trial_orientation,
+                                       args.d_trial_move_type,
+                                       args.d_charge,
+                                       args.d_diameter,
+                                       args.d_excell_idx,
+                                       args.d_excell_size,
+                                       args.excli,
+                                       args.d_update_order_by_ptl,
+                                       args.d_reject_in,
+                                       args.d_reject_out,
+                                       args.seed,
+                                       args.timestep,
+                                       args.select,
+                                       args.rank,
+                                       args.num_types,
+                                       args.box,
+                                       args.ghost_width,
+                                       args.cell_dim,
+                                       args.ci,
+                                       args.N,
+                                       args.r_cut_patch,
+                                       args.d_additive_cutoff,
+                                       args.d_reject_out_of_cell,
+                                       max_queue_size,
+                                       range.first,
+                                       nwork,
+                                       max_extra_bytes);
 
         if (res != CUDA_SUCCESS)
             {
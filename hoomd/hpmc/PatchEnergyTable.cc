@@ -0,0 +1,77 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "PatchEnergyTable.h"
+
+/*! \file PatchEnergyTable.cc
+    \brief Definition of PatchEnergyTable
+*/
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+PatchEnergyTable::PatchEnergyTable(std::shared_ptr<SystemDefinition> sysdef, Scalar r_cut)
+    : PatchEnergy(sysdef), m_exec_conf(sysdef->getParticleData()->getExecConf()), m_r_cut(r_cut),
+      m_type_pair_idx(sysdef->getParticleData()->getNTypes())
+    {
+    // allocate the parameter storage, setting the managed flag
+    m_params = std::vector<detail::patch_table_params_t,
+                           hoomd::detail::managed_allocator<detail::patch_table_params_t>>(
+        m_type_pair_idx.getNumElements(),
+        detail::patch_table_params_t(),
+        hoomd::detail::managed_allocator<detail::patch_table_params_t>(
+            m_exec_conf->isCUDAEnabled()));
+    }
+
+/*! \param typ Pair of type names
+    \param params Dictionary with the keys r_min and U
+
+    The table applies to both orderings of the types.
+*/
+void PatchEnergyTable::setParamsPython(pybind11::tuple typ, pybind11::dict params)
+    {
+    auto pdata = m_sysdef->getParticleData();
+    unsigned int typ_i = pdata->getTypeByName(typ[0].cast<std::string>());
+    unsigned int typ_j = pdata->getTypeByName(typ[1].cast<std::string>());
+
+    detail::patch_table_params_t table(params, m_exec_conf->isCUDAEnabled());
+    m_params[m_type_pair_idx(typ_i, typ_j)] = table;
+    m_params[m_type_pair_idx(typ_j, typ_i)] = table;
+
+#ifdef ENABLE_HIP
+    m_params[m_type_pair_idx(typ_i, typ_j)].set_memory_hint();
+    m_params[m_type_pair_idx(typ_j, typ_i)].set_memory_hint();
+#endif
+    }
+
+/*! \param typ Pair of type names
+    \returns Dictionary with the keys r_min and U
+*/
+pybind11::dict PatchEnergyTable::getParamsPython(pybind11::tuple typ)
+    {
+    auto pdata = m_sysdef->getParticleData();
+    unsigned int typ_i = pdata->getTypeByName(typ[0].cast<std::string>());
+    unsigned int typ_j = pdata->getTypeByName(typ[1].cast<std::string>());
+    return m_params[m_type_pair_idx(typ_i, typ_j)].asDict();
+    }
+
+namespace detail
+    {
+void export_PatchEnergyTable(pybind11::module& m)
+    {
+    pybind11::class_<PatchEnergy, std::shared_ptr<PatchEnergy>>(m, "PatchEnergy")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>>());
+
+    pybind11::class_<PatchEnergyTable, PatchEnergy, std::shared_ptr<PatchEnergyTable>>(
+        m,
+        "PatchEnergyTable")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>, Scalar>())
+        .def_property("r_cut", &PatchEnergyTable::getRCut, &PatchEnergyTable::setRCut)
+        .def("setParams", &PatchEnergyTable::setParamsPython)
+        .def("getParams", &PatchEnergyTable::getParamsPython);
+    }
+    } // end namespace detail
+
+    } // end namespace hpmc
+    } // end namespace hoomd
@@ -0,0 +1,137 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/ManagedArray.h"
+
+#ifdef ENABLE_HIP
+#include "PatchEnergyGPUTypes.cuh"
+#include <hip/hip_runtime.h>
+#endif
+
+#ifndef __HIPCC__
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#endif
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+#ifdef __HIPCC__
+#define DEVICE __device__
+#define HOSTDEVICE __host__ __device__
+#else
+#define DEVICE
+#define HOSTDEVICE
+#endif
+
+/*! \file PatchEnergyTable.cuh
+    \brief Declaration of the tabulated patch energy parameters and evaluation function
+*/
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+namespace detail
+    {
+//! Tabulated isotropic patch energy for one pair of particle types
+/*! U holds N energies at the distances r_i = r_min + dr * i, where dr = (r_cut - r_min) / N.
+    Energies between two points are interpolated linearly, and the point after the last table entry
+    (r = r_cut) has U = 0. The energy for r < r_min and r >= r_cut is 0.
+*/
+struct patch_table_params_t
+    {
+    float r_min;           //!< Distance of the first table entry
+    ManagedArray<float> U; //!< Tabulated energies
+
+#ifdef ENABLE_HIP
+    //! Attach managed memory to CUDA stream
+    void set_memory_hint() const
+        {
+        U.set_memory_hint();
+        }
+#endif
+
+#ifndef __HIPCC__
+    patch_table_params_t() : r_min(0.0) { }
+
+    patch_table_params_t(pybind11::dict v, bool managed = false)
+        {
+        const auto U_py = v["U"].cast<pybind11::array_t<float>>().unchecked<1>();
+        if (U_py.size() == 0)
+            {
+            throw std::runtime_error("The length of U must not be zero.");
+            }
+
+        size_t width = U_py.size();
+        r_min = v["r_min"].cast<float>();
+        U = ManagedArray<float>(static_cast<unsigned int>(width), managed);
+        std::copy(U_py.data(0), U_py.data(0) + width, U.get());
+        }
+
+    pybind11::dict asDict() const
+        {
+        pybind11::dict v;
+        v["r_min"] = r_min;
+        v["U"] = pybind11::array_t<float>(U.size(), U.get());
+        return v;
+        }
+#endif
+    };
+
+//! Evaluate a tabulated patch energy
+/*! \param params Table of the type pair
+    \param rsq Squared distance between the particles
+    \param r_cut Distance at which the energy goes to 0
+    \returns The interpolated energy
+*/
+HOSTDEVICE inline float
+eval_patch_table(const patch_table_params_t& params, float rsq, float r_cut)
+    {
+    const unsigned int width = params.U.size();
+    if (width == 0 || rsq >= r_cut * r_cut)
+        {
+        return 0.0f;
+        }
+
+    const float r = fast::sqrt(rsq);
+    if (r < params.r_min)
+        {
+        return 0.0f;
+        }
+
+    const float delta_r = (r_cut - params.r_min) / float(width);
+    const float value_f = (r - params.r_min) / delta_r;
+
+    // compute index into the table and read in values
+    unsigned int value_i = static_cast<unsigned int>(value_f);
+    if (value_i >= width)
+        value_i = width - 1;
+    const float U0 = params.U[value_i];
+    const float U1 = (value_i + 1 < width) ? params.U[value_i + 1] : 0.0f;
+
+    // linear interpolation
+    const float f = value_f - float(value_i);
+    return U0 + f * (U1 - U0);
+    }
+
+    } // end namespace detail
+
+namespace gpu
+    {
+#ifdef ENABLE_HIP
+//! Kernel driver for the tabulated patch energy narrow phase
+void hpmc_narrow_phase_patch_table(const detail::hpmc_patch_args_t& args,
+                                   const detail::patch_table_params_t* d_params,
+                                   float r_cut,
+                                   unsigned int block_size,
+                                   unsigned int tpp,
+                                   const hipDeviceProp_t& devprop,
+                                   hipStream_t stream);
+#endif
+    } // end namespace gpu
+
+    } // end namespace hpmc
+    } // end namespace hoomd
+
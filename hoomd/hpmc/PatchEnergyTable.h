@@ -0,0 +1,96 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "IntegratorHPMC.h"
+#include "PatchEnergyTable.cuh"
+
+#include "hoomd/Index1D.h"
+#include "hoomd/managed_allocator.h"
+
+#include <vector>
+
+#ifndef __HIPCC__
+#include <pybind11/pybind11.h>
+#endif
+
+/*! \file PatchEnergyTable.h
+    \brief Declaration of PatchEnergyTable
+*/
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+//! Tabulated isotropic patch energy
+/*! PatchEnergyTable evaluates patch energies that depend only on the distance between the
+    particles from a table for each pair of particle types, see detail::patch_table_params_t. It
+    needs no runtime compilation, and the GPU kernel is compiled with HOOMD-blue.
+
+    The tables are stored in managed memory so that the GPU kernel can read them directly.
+*/
+class PYBIND11_EXPORT PatchEnergyTable : public PatchEnergy
+    {
+    public:
+    //! Constructor
+    /*! \param sysdef System definition
+        \param r_cut Center to center distance beyond which the patch energy is 0
+    */
+    PatchEnergyTable(std::shared_ptr<SystemDefinition> sysdef, Scalar r_cut);
+
+    virtual ~PatchEnergyTable() { }
+
+    //! Get the cutoff distance
+    virtual Scalar getRCut()
+        {
+        return m_r_cut;
+        }
+
+    //! Set the cutoff distance
+    void setRCut(Scalar r_cut)
+        {
+        m_r_cut = r_cut;
+        }
+
+    //! Evaluate the energy of the patch interaction
+    virtual float energy(const vec3<float>& r_ij,
+                         unsigned int type_i,
+                         const quat<float>& q_i,
+                         float d_i,
+                         float charge_i,
+                         unsigned int type_j,
+                         const quat<float>& q_j,
+                         float d_j,
+                         float charge_j)
+        {
+        return detail::eval_patch_table(m_params[m_type_pair_idx(type_i, type_j)],
+                                        dot(r_ij, r_ij),
+                                        float(m_r_cut));
+        }
+
+    //! Set the table of a type pair
+    void setParamsPython(pybind11::tuple typ, pybind11::dict params);
+
+    //! Get the table of a type pair
+    pybind11::dict getParamsPython(pybind11::tuple typ);
+
+    protected:
+    std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
+    Scalar m_r_cut;                                            //!< Cutoff distance
+    Index2D m_type_pair_idx;                                   //!< Indexer for the type pairs
+
+    //! Tables for each type pair
+    std::vector<detail::patch_table_params_t,
+                hoomd::detail::managed_allocator<detail::patch_table_params_t>>
+        m_params;
+    };
+
+namespace detail
+    {
+//! Export PatchEnergy and PatchEnergyTable to python
+void export_PatchEnergyTable(pybind11::module& m);
+    } // end namespace detail
+
+    } // end namespace hpmc
+    } // end namespace hoomd
@@ -0,0 +1,71 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifdef ENABLE_HIP
+
+#include "PatchEnergyTableGPU.h"
+
+/*! \file PatchEnergyTableGPU.cc
+    \brief Definition of PatchEnergyTableGPU
+*/
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+PatchEnergyTableGPU::PatchEnergyTableGPU(std::shared_ptr<SystemDefinition> sysdef, Scalar r_cut)
+    : PatchEnergyTable(sysdef, r_cut)
+    {
+    // the energy is evaluated by a single thread, tune the block size and threads per particle
+    std::vector<unsigned int> valid_params;
+    for (unsigned int block_size = m_exec_conf->dev_prop.warpSize;
+         block_size <= (unsigned int)m_exec_conf->dev_prop.maxThreadsPerBlock;
+         block_size += m_exec_conf->dev_prop.warpSize)
+        {
+        for (unsigned int group_size = 1; group_size <= block_size; group_size *= 2)
+            {
+            if ((block_size % group_size) == 0)
+                valid_params.push_back(block_size * 1000000 + group_size * 100 + 1);
+            }
+        }
+
+    m_tuner_narrow_patch.reset(
+        new Autotuner(valid_params, 5, 100000, "hpmc_narrow_patch_table", m_exec_conf));
+    }
+
+void PatchEnergyTableGPU::computePatchEnergyGPU(const gpu_args_t& args, hipStream_t hStream)
+    {
+    unsigned int param = m_tuner_narrow_patch->getParam();
+    unsigned int block_size = param / 1000000;
+    unsigned int tpp = (param % 1000000) / 100;
+
+    m_exec_conf->beginMultiGPU();
+    m_tuner_narrow_patch->begin();
+    gpu::hpmc_narrow_phase_patch_table(args,
+                                       m_params.data(),
+                                       float(m_r_cut),
+                                       block_size,
+                                       tpp,
+                                       m_exec_conf->dev_prop,
+                                       hStream);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner_narrow_patch->end();
+    m_exec_conf->endMultiGPU();
+    }
+
+namespace detail
+    {
+void export_PatchEnergyTableGPU(pybind11::module& m)
+    {
+    pybind11::class_<PatchEnergyTableGPU, PatchEnergyTable, std::shared_ptr<PatchEnergyTableGPU>>(
+        m,
+        "PatchEnergyTableGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>, Scalar>());
+    }
+    } // end namespace detail
+
+    } // end namespace hpmc
+    } // end namespace hoomd
+
+#endif
@@ -0,0 +1,275 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "HPMCMiscFunctions.h"
+#include "PatchEnergyTable.cuh"
+
+#include "hoomd/GPUPartition.cuh"
+#include "hoomd/Index1D.h"
+#include "hoomd/VectorMath.h"
+
+#include <hip/hip_runtime.h>
+
+/*! \file PatchEnergyTableGPU.cu
+    \brief Definition of the tabulated patch energy narrow phase kernel driver
+
+    The tabulated energy takes the place of the runtime compiled evaluator in the patch narrow phase
+    kernel, which is compiled ahead of time here.
+*/
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+namespace gpu
+    {
+namespace kernel
+    {
+//! Table parameters of all type pairs
+__device__ const detail::patch_table_params_t* d_patch_table_params;
+
+//! Number of particle types
+__device__ unsigned int d_patch_table_num_types;
+
+//! Cutoff distance
+__device__ float d_patch_table_r_cut;
+    } // end namespace kernel
+    } // end namespace gpu
+    } // end namespace hpmc
+    } // end namespace hoomd
+
+//! Evaluate the tabulated patch energy in the narrow phase kernel
+__device__ float eval(const hoomd::vec3<float>& r_ij,
+                      unsigned int type_i,
+                      const hoomd::quat<float>& q_i,
+                      float d_i,
+                      float charge_i,
+                      unsigned int type_j,
+                      const hoomd::quat<float>& q_j,
+                      float d_j,
+                      float charge_j)
+    {
+    using namespace hoomd::hpmc::gpu::kernel;
+    const hoomd::Index2D type_pair_idx(d_patch_table_num_types);
+    const unsigned int pair = type_pair_idx(type_i, type_j);
+    return hoomd::hpmc::detail::eval_patch_table(d_patch_table_params[pair],
+                                                 dot(r_ij, r_ij),
+                                                 d_patch_table_r_cut);
+    }
+
+#include "IntegratorHPMCMonoGPUJIT.inc"
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+namespace gpu
+    {
+#ifdef __HIP_PLATFORM_NVCC__
+#define MAX_BLOCK_SIZE 1024
+#define MIN_BLOCK_SIZE 32
+#else
+#define MAX_BLOCK_SIZE 1024
+#define MIN_BLOCK_SIZE 1024 // on AMD, we do not use __launch_bounds__
+#endif
+
+namespace kernel
+    {
+//! Launcher for the tabulated patch narrow phase kernel with templated launch bounds
+template<unsigned int cur_launch_bounds>
+void narrow_phase_patch_table_launcher(const detail::hpmc_patch_args_t& args,
+                                       const detail::patch_table_params_t* d_params,
+                                       float r_cut,
+                                       unsigned int max_threads,
+                                       unsigned int block_size,
+                                       unsigned int req_tpp,
+                                       const hipDeviceProp_t& devprop,
+                                       hipStream_t stream,
+                                       detail::int2type<cur_launch_bounds>)
+    {
+    if (max_threads == cur_launch_bounds * MIN_BLOCK_SIZE)
+        {
+        constexpr unsigned int launch_bounds_nonzero
+            = cur_launch_bounds > 0 ? cur_launch_bounds : 1;
+        constexpr unsigned int eval_threads = 1;
+
+        // determine the maximum block size and clamp the input block size down
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(
+            &attr,
+            reinterpret_cast<const void*>(
+                hpmc_narrow_phase_patch<eval_threads, launch_bounds_nonzero * MIN_BLOCK_SIZE>));
+        unsigned int run_block_size = min(block_size, (unsigned int)attr.maxThreadsPerBlock);
+
+        unsigned int tpp = min(req_tpp, run_block_size);
+        while (eval_threads * tpp > run_block_size || run_block_size % (eval_threads * tpp) != 0)
+            {
+            tpp--;
+            }
+        tpp = std::min((unsigned int)devprop.maxThreadsDim[2], tpp); // clamp blockDim.z
+
+        unsigned int n_groups = run_block_size / (tpp * eval_threads);
+        unsigned int max_queue_size = n_groups * tpp;
+
+        const size_t min_shared_bytes = args.num_types * sizeof(Scalar);
+
+        size_t shared_bytes = n_groups
+                                  * (sizeof(unsigned int) + 2 * sizeof(Scalar4)
+                                     + 2 * sizeof(Scalar3) + 2 * sizeof(Scalar) + 2 * sizeof(float))
+                              + max_queue_size * 2 * sizeof(unsigned int) + min_shared_bytes;
+
+        if (min_shared_bytes >= devprop.sharedMemPerBlock)
+            throw std::runtime_error("Insufficient shared memory for HPMC kernel: reduce number of "
+                                     "particle types");
+
+        while (shared_bytes + attr.sharedSizeBytes >= devprop.sharedMemPerBlock)
+            {
+            run_block_size -= devprop.warpSize;
+            if (run_block_size == 0)
+                throw std::runtime_error("Insufficient shared memory for HPMC kernel");
+
+            tpp = min(req_tpp, run_block_size);
+            while (eval_threads * tpp > run_block_size
+                   || run_block_size % (eval_threads * tpp) != 0)
+                {
+                tpp--;
+                }
+            tpp = std::min((unsigned int)devprop.maxThreadsDim[2], tpp); // clamp blockDim.z
+
+            n_groups = run_block_size / (tpp * eval_threads);
+            max_queue_size = n_groups * tpp;
+
+            shared_bytes = n_groups
+                               * (sizeof(unsigned int) + 2 * sizeof(Scalar4) + 2 * sizeof(Scalar3)
+                                  + 2 * sizeof(Scalar) + 2 * sizeof(float))
+                           + max_queue_size * 2 * sizeof(unsigned int) + min_shared_bytes;
+            }
+
+        dim3 thread(eval_threads, n_groups, tpp);
+
+        for (int idev = args.gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+            {
+            auto range = args.gpu_partition.getRangeAndSetGPU(idev);
+
+            // the evaluator reads the tables through device globals, set them on each GPU
+            hipMemcpyToSymbolAsync(HIP_SYMBOL(d_patch_table_params),
+                                   &d_params,
+                                   sizeof(const detail::patch_table_params_t*),
+                                   0,
+                                   hipMemcpyHostToDevice,
+                                   stream);
+            hipMemcpyToSymbolAsync(HIP_SYMBOL(d_patch_table_num_types),
+                                   &args.num_types,
+                                   sizeof(unsigned int),
+                                   0,
+                                   hipMemcpyHostToDevice,
+                                   stream);
+            hipMemcpyToSymbolAsync(HIP_SYMBOL(d_patch_table_r_cut),
+                                   &r_cut,
+                                   sizeof(float),
+                                   0,
+                                   hipMemcpyHostToDevice,
+                                   stream);
+
+            unsigned int nwork = range.second - range.first;
+            const unsigned int num_blocks = (nwork + n_groups - 1) / n_groups;
+
+            dim3 grid(num_blocks, 1, 1);
+
+            unsigned int max_extra_bytes = 0;
+
+            hipLaunchKernelGGL(
+                (hpmc_narrow_phase_patch<eval_threads, launch_bounds_nonzero * MIN_BLOCK_SIZE>),
+                grid,
+                thread,
+                shared_bytes,
+                stream,
+                args.d_postype,
+                args.d_orientation,
+                args.d_trial_postype,
+                args.d_trial_orientation,
+                args.d_trial_move_type,
+                args.d_charge,
+                args.d_diameter,
+                args.d_excell_idx,
+                args.d_excell_size,
+                args.excli,
+                args.d_update_order_by_ptl,
+                args.d_reject_in,
+                args.d_reject_out,
+                args.seed,
+                args.timestep,
+                args.select,
+                args.rank,
+                args.num_types,
+                args.box,
+                args.ghost_width,
+                args.cell_dim,
+                args.ci,
+                args.N,
+                args.r_cut_patch,
+                args.d_additive_cutoff,
+                args.d_reject_out_of_cell,
+                max_queue_size,
+                range.first,
+                nwork,
+                max_extra_bytes);
+            }
+        }
+    else
+        {
+        narrow_phase_patch_table_launcher(args,
+                                          d_params,
+                                          r_cut,
+                                          max_threads,
+                                          block_size,
+                                          req_tpp,
+                                          devprop,
+                                          stream,
+                                          detail::int2type<cur_launch_bounds / 2>());
+        }
+    }
+    } // end namespace kernel
+
+/*! \param args Kernel arguments
+    \param d_params Table parameters of all type pairs, in managed memory
+    \param r_cut Cutoff distance of the tables
+    \param block_size Requested block size
+    \param tpp Requested number of threads per particle
+    \param devprop Device properties
+    \param stream Stream to execute on
+*/
+void hpmc_narrow_phase_patch_table(const detail::hpmc_patch_args_t& args,
+                                   const detail::patch_table_params_t* d_params,
+                                   float r_cut,
+                                   unsigned int block_size,
+                                   unsigned int tpp,
+                                   const hipDeviceProp_t& devprop,
+                                   hipStream_t stream)
+    {
+    assert(args.d_postype);
+    assert(args.d_orientation);
+
+    // select the kernel template according to the next power of two of the block size
+    unsigned int launch_bounds = MIN_BLOCK_SIZE;
+    while (launch_bounds < block_size)
+        launch_bounds *= 2;
+
+    kernel::narrow_phase_patch_table_launcher(
+        args,
+        d_params,
+        r_cut,
+        launch_bounds,
+        block_size,
+        tpp,
+        devprop,
+        stream,
+        detail::int2type<MAX_BLOCK_SIZE / MIN_BLOCK_SIZE>());
+    }
+
+#undef MAX_BLOCK_SIZE
+#undef MIN_BLOCK_SIZE
+
+    } // end namespace gpu
+    } // end namespace hpmc
+    } // end namespace hoomd
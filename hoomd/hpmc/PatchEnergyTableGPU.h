@@ -0,0 +1,64 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#ifdef ENABLE_HIP
+
+#include "PatchEnergyTable.h"
+
+#include "hoomd/Autotuner.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file PatchEnergyTableGPU.h
+    \brief Declaration of PatchEnergyTableGPU
+*/
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+//! Tabulated isotropic patch energy, GPU version
+class PYBIND11_EXPORT PatchEnergyTableGPU : public PatchEnergyTable
+    {
+    public:
+    //! Constructor
+    /*! \param sysdef System definition
+        \param r_cut Center to center distance beyond which the patch energy is 0
+    */
+    PatchEnergyTableGPU(std::shared_ptr<SystemDefinition> sysdef, Scalar r_cut);
+
+    virtual ~PatchEnergyTableGPU() { }
+
+    //! Asynchronously launch the narrow phase kernel
+    /*! \param args Kernel arguments
+        \param hStream stream to execute on
+        */
+    virtual void computePatchEnergyGPU(const gpu_args_t& args, hipStream_t hStream);
+
+    //! Set autotuner parameters
+    /*! \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        m_tuner_narrow_patch->setPeriod(period);
+        m_tuner_narrow_patch->setEnabled(enable);
+        }
+
+    protected:
+    std::unique_ptr<Autotuner> m_tuner_narrow_patch; //!< Autotuner for the narrow phase
+    };
+
+namespace detail
+    {
+//! Export PatchEnergyTableGPU to python
+void export_PatchEnergyTableGPU(pybind11::module& m);
+    } // end namespace detail
+
+    } // end namespace hpmc
+    } // end namespace hoomd
+
+#endif
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "GJKSweep3D.h"
 #include "ShapeSphere.h" //< For the base template of test_overlap
 #include "XenoCollide3D.h"
 #include "hoomd/BoxDim.h"
@@ -266,8 +267,8 @@ class SupportFuncConvexPolyhedron
 
         @param _verts Polyhedron vertices
 
-        Note that for performance it is assumed that unused vertices (beyond N) have already
-        been set to zero.
+        The vertex arrays are padded to a multiple of 8 for aligned vector loads. The vertices
+        past N are ignored.
     */
     DEVICE SupportFuncConvexPolyhedron(const PolyhedronVertices& _verts,
                                        OverlapReal extra_sweep_radius = OverlapReal(0.0))
@@ -287,7 +288,98 @@ class SupportFuncConvexPolyhedron
 
         if (verts.N > 0)
             {
-#if !defined(__HIPCC__) && defined(__AVX__) \
+#if !defined(__HIPCC__) && defined(__AVX512F__) \
+    && (defined(SINGLE_PRECISION) || defined(ENABLE_HPMC_MIXED_PRECISION))
+            // process dot products with AVX-512 16 at a time on the CPU, masking the lanes past the
+            // last vertex
+            const __m512 nx_v = _mm512_set1_ps(n.x);
+            const __m512 ny_v = _mm512_set1_ps(n.y);
+            const __m512 nz_v = _mm512_set1_ps(n.z);
+            __m512 max_dot_v = _mm512_set1_ps(max_dot);
+            float d_s[verts.x.size()] __attribute__((aligned(64)));
+
+            for (unsigned int i = 0; i < verts.N; i += 16)
+                {
+                const __mmask16 mask = verts.N - i >= 16 ? __mmask16(0xffff)
+                                                         : __mmask16((1u << (verts.N - i)) - 1);
+                __m512 x_v = _mm512_maskz_loadu_ps(mask, verts.x.get() + i);
+                __m512 y_v = _mm512_maskz_loadu_ps(mask, verts.y.get() + i);
+                __m512 z_v = _mm512_maskz_loadu_ps(mask, verts.z.get() + i);
+
+                __m512 d_v = _mm512_fmadd_ps(nx_v,
+                                             x_v,
+                                             _mm512_fmadd_ps(ny_v, y_v, _mm512_mul_ps(nz_v, z_v)));
+
+                // determine a maximum in each of the 16 channels as we go
+                max_dot_v = _mm512_mask_max_ps(max_dot_v, mask, max_dot_v, d_v);
+
+                _mm512_mask_storeu_ps(d_s + i, mask, d_v);
+                }
+
+            // find the maximum of the 16 channels
+            max_dot_v = _mm512_set1_ps(_mm512_reduce_max_ps(max_dot_v));
+
+            // loop again and find the first index of the max element
+            for (unsigned int i = 0; i < verts.N; i += 16)
+                {
+                const __mmask16 mask = verts.N - i >= 16 ? __mmask16(0xffff)
+                                                         : __mmask16((1u << (verts.N - i)) - 1);
+                __m512 d_v = _mm512_maskz_loadu_ps(mask, d_s + i);
+
+                int id = __builtin_ffs(_mm512_mask_cmp_ps_mask(mask, max_dot_v, d_v, _CMP_EQ_OQ));
+
+                if (id)
+                    {
+                    max_idx = i + id - 1;
+                    break;
+                    }
+                }
+#elif !defined(__HIPCC__) && defined(__AVX512F__)
+            // process dot products with AVX-512 8 at a time on the CPU in double precision, masking
+            // the lanes past the last vertex
+            const __m512d nx_v = _mm512_set1_pd(n.x);
+            const __m512d ny_v = _mm512_set1_pd(n.y);
+            const __m512d nz_v = _mm512_set1_pd(n.z);
+            __m512d max_dot_v = _mm512_set1_pd(max_dot);
+            double d_s[verts.x.size()] __attribute__((aligned(64)));
+
+            for (unsigned int i = 0; i < verts.N; i += 8)
+                {
+                const __mmask8 mask
+                    = verts.N - i >= 8 ? __mmask8(0xff) : __mmask8((1u << (verts.N - i)) - 1);
+                __m512d x_v = _mm512_maskz_loadu_pd(mask, verts.x.get() + i);
+                __m512d y_v = _mm512_maskz_loadu_pd(mask, verts.y.get() + i);
+                __m512d z_v = _mm512_maskz_loadu_pd(mask, verts.z.get() + i);
+
+                __m512d d_v = _mm512_fmadd_pd(nx_v,
+                                              x_v,
+                                              _mm512_fmadd_pd(ny_v, y_v, _mm512_mul_pd(nz_v, z_v)));
+
+                // determine a maximum in each of the 8 channels as we go
+                max_dot_v = _mm512_mask_max_pd(max_dot_v, mask, max_dot_v, d_v);
+
+                _mm512_mask_storeu_pd(d_s + i, mask, d_v);
+                }
+
+            // find the maximum of the 8 channels
+            max_dot_v = _mm512_set1_pd(_mm512_reduce_max_pd(max_dot_v));
+
+            // loop again and find the first index of the max element
+            for (unsigned int i = 0; i < verts.N; i += 8)
+                {
+                const __mmask8 mask
+                    = verts.N - i >= 8 ? __mmask8(0xff) : __mmask8((1u << (verts.N - i)) - 1);
+                __m512d d_v = _mm512_maskz_loadu_pd(mask, d_s + i);
+
+                int id = __builtin_ffs(_mm512_mask_cmp_pd_mask(mask, max_dot_v, d_v, _CMP_EQ_OQ));
+
+                if (id)
+                    {
+                    max_idx = i + id - 1;
+                    break;
+                    }
+                }
+#elif !defined(__HIPCC__) && defined(__AVX__) \
     && (defined(SINGLE_PRECISION) || defined(ENABLE_HPMC_MIXED_PRECISION))
             // process dot products with AVX 8 at a time on the CPU when working with more than
             // 4 verts
@@ -295,6 +387,8 @@ class SupportFuncConvexPolyhedron
             __m256 ny_v = _mm256_broadcast_ss(&n.y);
             __m256 nz_v = _mm256_broadcast_ss(&n.z);
             __m256 max_dot_v = _mm256_broadcast_ss(&max_dot);
+            const __m256 lane_v = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+            const __m256 lowest_v = _mm256_set1_ps(-FLT_MAX);
             float d_s[verts.x.size()] __attribute__((aligned(32)));
 
             for (unsigned int i = 0; i < verts.N; i += 8)
@@ -307,6 +401,14 @@ class SupportFuncConvexPolyhedron
                     _mm256_mul_ps(nx_v, x_v),
                     _mm256_add_ps(_mm256_mul_ps(ny_v, y_v), _mm256_mul_ps(nz_v, z_v)));
 
+                // mask the padding past the last vertex
+                if (verts.N - i < 8)
+                    {
+                    __m256 valid_v
+                        = _mm256_cmp_ps(lane_v, _mm256_set1_ps(float(verts.N - i)), _CMP_LT_OQ);
+                    d_v = _mm256_blendv_ps(lowest_v, d_v, valid_v);
+                    }
+
                 // determine a maximum in each of the 8 channels as we go
                 max_dot_v = _mm256_max_ps(max_dot_v, d_v);
 
@@ -335,6 +437,58 @@ class SupportFuncConvexPolyhedron
 
                 int id = __builtin_ffs(_mm256_movemask_ps(_mm256_cmp_ps(max_dot_v, d_v, 0)));
 
+                if (id)
+                    {
+                    max_idx = i + id - 1;
+                    break;
+                    }
+                }
+#elif !defined(__HIPCC__) && defined(__AVX__)
+            // process dot products with AVX 4 at a time on the CPU in double precision. The vertex
+            // arrays are padded to a multiple of 8, and the lanes past the last vertex are masked.
+            const __m256d nx_v = _mm256_set1_pd(n.x);
+            const __m256d ny_v = _mm256_set1_pd(n.y);
+            const __m256d nz_v = _mm256_set1_pd(n.z);
+            const __m256d lane_v = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+            const __m256d lowest_v = _mm256_set1_pd(-DBL_MAX);
+            __m256d max_dot_v = _mm256_set1_pd(max_dot);
+            double d_s[verts.x.size()] __attribute__((aligned(32)));
+
+            for (unsigned int i = 0; i < verts.N; i += 4)
+                {
+                __m256d x_v = _mm256_load_pd(verts.x.get() + i);
+                __m256d y_v = _mm256_load_pd(verts.y.get() + i);
+                __m256d z_v = _mm256_load_pd(verts.z.get() + i);
+
+                __m256d d_v = _mm256_add_pd(
+                    _mm256_mul_pd(nx_v, x_v),
+                    _mm256_add_pd(_mm256_mul_pd(ny_v, y_v), _mm256_mul_pd(nz_v, z_v)));
+
+                if (verts.N - i < 4)
+                    {
+                    __m256d valid_v
+                        = _mm256_cmp_pd(lane_v, _mm256_set1_pd(double(verts.N - i)), _CMP_LT_OQ);
+                    d_v = _mm256_blendv_pd(lowest_v, d_v, valid_v);
+                    }
+
+                // determine a maximum in each of the 4 channels as we go
+                max_dot_v = _mm256_max_pd(max_dot_v, d_v);
+
+                _mm256_store_pd(d_s + i, d_v);
+                }
+
+            // find the maximum of the 4 channels: swap the 128b halves, then the elements within
+            max_dot_v = _mm256_max_pd(max_dot_v, _mm256_permute2f128_pd(max_dot_v, max_dot_v, 1));
+            max_dot_v = _mm256_max_pd(max_dot_v, _mm256_shuffle_pd(max_dot_v, max_dot_v, 0x5));
+
+            // loop again and find the first index of the max element
+            for (unsigned int i = 0; i < verts.N; i += 4)
+                {
+                __m256d d_v = _mm256_load_pd(d_s + i);
+
+                int id
+                    = __builtin_ffs(_mm256_movemask_pd(_mm256_cmp_pd(max_dot_v, d_v, _CMP_EQ_OQ)));
+
                 if (id)
                     {
                     max_idx = i + id - 1;
@@ -348,6 +502,8 @@ class SupportFuncConvexPolyhedron
             __m128 ny_v = _mm_load_ps1(&n.y);
             __m128 nz_v = _mm_load_ps1(&n.z);
             __m128 max_dot_v = _mm_load_ps1(&max_dot);
+            const __m128 lane_v = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+            const __m128 lowest_v = _mm_set1_ps(-FLT_MAX);
             float d_s[verts.x.size()] __attribute__((aligned(16)));
 
             for (unsigned int i = 0; i < verts.N; i += 4)
@@ -359,6 +515,13 @@ class SupportFuncConvexPolyhedron
                 __m128 d_v = _mm_add_ps(_mm_mul_ps(nx_v, x_v),
                                         _mm_add_ps(_mm_mul_ps(ny_v, y_v), _mm_mul_ps(nz_v, z_v)));
 
+                // mask the padding past the last vertex
+                if (verts.N - i < 4)
+                    {
+                    __m128 valid_v = _mm_cmplt_ps(lane_v, _mm_set1_ps(float(verts.N - i)));
+                    d_v = _mm_or_ps(_mm_and_ps(valid_v, d_v), _mm_andnot_ps(valid_v, lowest_v));
+                    }
+
                 // determine a maximum in each of the 4 channels as we go
                 max_dot_v = _mm_max_ps(max_dot_v, d_v);
 
@@ -390,19 +553,27 @@ class SupportFuncConvexPolyhedron
                 }
 #else
 
-            // if no AVX or SSE, or running in double precision, fall back on serial computation
-            // this code path also triggers on the GPU
+            // if no AVX or SSE, or running in double precision without AVX, fall back on serial
+            // computation this code path also triggers on the GPU
 
-            OverlapReal max_dot0 = dot(n, vec3<OverlapReal>(verts.x[0], verts.y[0], verts.z[0]));
+            // start the channels past the last vertex from the first vertex to skip the padding
             unsigned int max_idx0 = 0;
-            OverlapReal max_dot1 = dot(n, vec3<OverlapReal>(verts.x[1], verts.y[1], verts.z[1]));
-            unsigned int max_idx1 = 1;
-            OverlapReal max_dot2 = dot(n, vec3<OverlapReal>(verts.x[2], verts.y[2], verts.z[2]));
-            unsigned int max_idx2 = 2;
-            OverlapReal max_dot3 = dot(n, vec3<OverlapReal>(verts.x[3], verts.y[3], verts.z[3]));
-            unsigned int max_idx3 = 3;
-
-            for (unsigned int i = 4; i < verts.N; i += 4)
+            OverlapReal max_dot0 = dot(n, vec3<OverlapReal>(verts.x[0], verts.y[0], verts.z[0]));
+            unsigned int max_idx1 = verts.N > 1 ? 1 : 0;
+            OverlapReal max_dot1 = dot(
+                n,
+                vec3<OverlapReal>(verts.x[max_idx1], verts.y[max_idx1], verts.z[max_idx1]));
+            unsigned int max_idx2 = verts.N > 2 ? 2 : 0;
+            OverlapReal max_dot2 = dot(
+                n,
+                vec3<OverlapReal>(verts.x[max_idx2], verts.y[max_idx2], verts.z[max_idx2]));
+            unsigned int max_idx3 = verts.N > 3 ? 3 : 0;
+            OverlapReal max_dot3 = dot(
+                n,
+                vec3<OverlapReal>(verts.x[max_idx3], verts.y[max_idx3], verts.z[max_idx3]));
+
+            unsigned int i = 4;
+            for (; i + 4 <= verts.N; i += 4)
                 {
                 const OverlapReal* verts_x = verts.x.get() + i;
                 const OverlapReal* verts_y = verts.y.get() + i;
@@ -434,6 +605,17 @@ class SupportFuncConvexPolyhedron
                     }
                 }
 
+            // remaining vertices
+            for (; i < verts.N; i++)
+                {
+                OverlapReal d = dot(n, vec3<OverlapReal>(verts.x[i], verts.y[i], verts.z[i]));
+                if (d > max_dot0)
+                    {
+                    max_dot0 = d;
+                    max_idx0 = i;
+                    }
+                }
+
             max_dot = max_dot0;
             max_idx = max_idx0;
 
@@ -841,6 +1023,41 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     */
     }
 
+/** Convex polyhedron sweep distance
+
+    @param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    @param a first shape
+    @param b second shape
+    @param direction Unit vector that shape a moves along
+    @param max_distance Largest distance of interest
+    @param err in/out variable incremented when error conditions occur in the sweep
+    @returns The distance that *a* can move along *direction* before it touches *b*, or
+             *max_distance* when they do not touch within *max_distance*
+*/
+template<>
+DEVICE inline OverlapReal sweep_distance(const vec3<Scalar>& r_ab,
+                                         const ShapeConvexPolyhedron& a,
+                                         const ShapeConvexPolyhedron& b,
+                                         const vec3<Scalar>& direction,
+                                         OverlapReal max_distance,
+                                         unsigned int& err)
+    {
+    vec3<OverlapReal> dr(r_ab);
+    quat<OverlapReal> conj_q_a = conj(quat<OverlapReal>(a.orientation));
+
+    OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
+
+    return detail::gjk_sweep_3d(detail::SupportFuncConvexPolyhedron(a.verts),
+                                detail::SupportFuncConvexPolyhedron(b.verts),
+                                rotate(conj_q_a, dr),
+                                conj_q_a * quat<OverlapReal>(b.orientation),
+                                rotate(conj_q_a, vec3<OverlapReal>(direction)),
+                                OverlapReal(0.0),
+                                max_distance,
+                                DaDb / OverlapReal(2.0),
+                                err);
+    }
+
 #ifndef __HIPCC__
 template<> inline std::string getShapeSpec(const ShapeConvexPolyhedron& poly)
     {
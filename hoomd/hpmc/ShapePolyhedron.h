@@ -900,6 +900,8 @@ DEVICE inline bool IntersectRayTriangle(const vec3<OverlapReal>& p,
 
 #ifndef __HIPCC__
 //! Traverse the bounding volume test tree recursively
+/*! On overlap, \a witness is set to the pair of leaf nodes whose faces intersect.
+ */
 inline bool BVHCollision(const ShapePolyhedron& a,
                          const ShapePolyhedron& b,
                          unsigned int cur_node_a,
@@ -907,7 +909,8 @@ inline bool BVHCollision(const ShapePolyhedron& a,
                          const quat<OverlapReal>& q,
                          const vec3<OverlapReal>& dr,
                          unsigned int& err,
-                         OverlapReal abs_tol)
+                         OverlapReal abs_tol,
+                         uint2& witness)
     {
     detail::OBB obb_a = a.tree.getOBB(cur_node_a);
     obb_a.affineTransform(q, dr);
@@ -918,14 +921,19 @@ inline bool BVHCollision(const ShapePolyhedron& a,
         {
         if (b.tree.isLeaf(cur_node_b))
             {
-            return test_narrow_phase_overlap(dr, a, b, cur_node_a, cur_node_b, err, abs_tol);
+            if (test_narrow_phase_overlap(dr, a, b, cur_node_a, cur_node_b, err, abs_tol))
+                {
+                witness = make_uint2(cur_node_a, cur_node_b);
+                return true;
+                }
+            return false;
             }
         else
             {
             unsigned int left_b = b.tree.getLeftChild(cur_node_b);
             unsigned int right_b = b.tree.getEscapeIndex(left_b);
-            return BVHCollision(a, b, cur_node_a, left_b, q, dr, err, abs_tol)
-                   || BVHCollision(a, b, cur_node_a, right_b, q, dr, err, abs_tol);
+            return BVHCollision(a, b, cur_node_a, left_b, q, dr, err, abs_tol, witness)
+                   || BVHCollision(a, b, cur_node_a, right_b, q, dr, err, abs_tol, witness);
             }
         }
     else
@@ -934,8 +942,8 @@ inline bool BVHCollision(const ShapePolyhedron& a,
             {
             unsigned int left_a = a.tree.getLeftChild(cur_node_a);
             unsigned int right_a = a.tree.getEscapeIndex(left_a);
-            return BVHCollision(a, b, left_a, cur_node_b, q, dr, err, abs_tol)
-                   || BVHCollision(a, b, right_a, cur_node_b, q, dr, err, abs_tol);
+            return BVHCollision(a, b, left_a, cur_node_b, q, dr, err, abs_tol, witness)
+                   || BVHCollision(a, b, right_a, cur_node_b, q, dr, err, abs_tol, witness);
             }
         else
             {
@@ -943,10 +951,10 @@ inline bool BVHCollision(const ShapePolyhedron& a,
             unsigned int right_a = a.tree.getEscapeIndex(left_a);
             unsigned int left_b = b.tree.getLeftChild(cur_node_b);
             unsigned int right_b = b.tree.getEscapeIndex(left_b);
-            return BVHCollision(a, b, left_a, left_b, q, dr, err, abs_tol)
-                   || BVHCollision(a, b, left_a, right_b, q, dr, err, abs_tol)
-                   || BVHCollision(a, b, right_a, left_b, q, dr, err, abs_tol)
-                   || BVHCollision(a, b, right_a, right_b, q, dr, err, abs_tol);
+            return BVHCollision(a, b, left_a, left_b, q, dr, err, abs_tol, witness)
+                   || BVHCollision(a, b, left_a, right_b, q, dr, err, abs_tol, witness)
+                   || BVHCollision(a, b, right_a, left_b, q, dr, err, abs_tol, witness)
+                   || BVHCollision(a, b, right_a, right_b, q, dr, err, abs_tol, witness);
             }
         }
     }
@@ -957,19 +965,40 @@ inline bool BVHCollision(const ShapePolyhedron& a,
     @param a first shape
     @param b second shape
     @param err in/out variable incremented when error conditions occur in the overlap test
-    @param sweep_radius Additional sphere radius to sweep the shapes by
+    @param witness in/out pair of leaf nodes (in a's and b's trees) that intersected in the last
+                   overlap of this pair, or UINT_MAX
     @returns true when *a* and *b* overlap, and false when they are disjoint
+
+    Trial moves of a particle in a dense packing are often rejected by the same pair of faces as
+    the previous trial. The leaf pair in @a witness is tested before the traversal from the roots,
+    and the traversal stores the leaf pair of a new overlap in @a witness. The witness is only a
+    hint: a stale witness costs one OBB test and never changes the result. The GPU ignores it.
 */
-template<>
-DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
-                                const ShapePolyhedron& a,
-                                const ShapePolyhedron& b,
-                                unsigned int& err)
+DEVICE inline bool test_overlap_polyhedron(const vec3<Scalar>& r_ab,
+                                           const ShapePolyhedron& a,
+                                           const ShapePolyhedron& b,
+                                           unsigned int& err,
+                                           uint2& witness)
     {
     OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
     const OverlapReal abs_tol(OverlapReal(DaDb * 1e-12));
     vec3<OverlapReal> dr = r_ab;
 
+#ifndef __HIPCC__
+    // test the faces that intersected in the last overlap first
+    if (witness.x < a.tree.getNumNodes() && witness.y < b.tree.getNumNodes()
+        && a.tree.isLeaf(witness.x) && b.tree.isLeaf(witness.y))
+        {
+        vec3<OverlapReal> dr_witness(rotate(conj(b.orientation), -r_ab));
+        quat<OverlapReal> q_witness(conj(b.orientation) * a.orientation);
+        detail::OBB obb_a = a.tree.getOBB(witness.x);
+        obb_a.affineTransform(q_witness, dr_witness);
+        if (overlap(obb_a, b.tree.getOBB(witness.y))
+            && test_narrow_phase_overlap(dr_witness, a, b, witness.x, witness.y, err, abs_tol))
+            return true;
+        }
+#endif
+
 /*
  * This overlap test checks if an edge of one polyhedron is overlapping with a face of the other
  */
@@ -1049,7 +1078,7 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     quat<OverlapReal> q(conj(b.orientation) * a.orientation);
 
 #ifndef __HIPCC__
-    if (BVHCollision(a, b, 0, 0, q, dr_rot, err, abs_tol))
+    if (BVHCollision(a, b, 0, 0, q, dr_rot, err, abs_tol, witness))
         return true;
 #else
 
@@ -1161,6 +1190,41 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     return false;
     }
 
+/** Polyhedron overlap test
+    @param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    @param a first shape
+    @param b second shape
+    @param err in/out variable incremented when error conditions occur in the overlap test
+    @returns true when *a* and *b* overlap, and false when they are disjoint
+*/
+template<>
+DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
+                                const ShapePolyhedron& a,
+                                const ShapePolyhedron& b,
+                                unsigned int& err)
+    {
+    uint2 witness = make_uint2(UINT_MAX, UINT_MAX);
+    return test_overlap_polyhedron(r_ab, a, b, err, witness);
+    }
+
+/** Polyhedron overlap test that reuses the witness of the last overlap
+    @param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    @param a first shape
+    @param b second shape
+    @param err in/out variable incremented when error conditions occur in the overlap test
+    @param witness in/out leaf pair of the last overlap, see test_overlap_polyhedron()
+    @returns true when *a* and *b* overlap, and false when they are disjoint
+*/
+template<>
+DEVICE inline bool test_overlap_witness(const vec3<Scalar>& r_ab,
+                                        const ShapePolyhedron& a,
+                                        const ShapePolyhedron& b,
+                                        unsigned int& err,
+                                        uint2& witness)
+    {
+    return test_overlap_polyhedron(r_ab, a, b, err, witness);
+    }
+
 #ifndef __HIPCC__
 /// Return the shape parameters in the `type_shape` format
 template<> inline std::string getShapeSpec(const ShapePolyhedron& s)
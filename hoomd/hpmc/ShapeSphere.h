@@ -272,6 +272,27 @@ test_overlap(const vec3<Scalar>& r_ab, const ShapeA& a, const ShapeB& b, unsigne
     return true;
     }
 
+//! Define the general overlap function that reuses a witness of a previous overlap
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param err Incremented if there is an error condition. Left unchanged otherwise.
+    \param witness in/out shape specific hint. Shapes that support it test the witness of the last
+                   overlap of this pair first, and store the witness of a new overlap.
+    \returns true when *a* and *b* overlap, and false when they are disjoint
+
+    The default implementation ignores the witness and calls test_overlap.
+*/
+template<class ShapeA, class ShapeB>
+DEVICE inline bool test_overlap_witness(const vec3<Scalar>& r_ab,
+                                        const ShapeA& a,
+                                        const ShapeB& b,
+                                        unsigned int& err,
+                                        uint2& witness)
+    {
+    return test_overlap(r_ab, a, b, err);
+    }
+
 //! Sphere-Sphere overlap
 /*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
     \param a first shape
@@ -302,6 +323,68 @@ DEVICE inline bool test_overlap<ShapeSphere, ShapeSphere>(const vec3<Scalar>& r_
         }
     }
 
+//! Define the general sweep distance function
+/*! This is just a convenient spot to put this to make sure it is defined early
+    \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param direction Unit vector that shape a moves along
+    \param max_distance Largest distance of interest
+    \param err Incremented if there is an error condition. Left unchanged otherwise.
+    \returns The distance that *a* can move along *direction* before it touches *b*, or
+             *max_distance* when they do not touch within *max_distance*
+*/
+template<class ShapeA, class ShapeB>
+DEVICE inline OverlapReal sweep_distance(const vec3<Scalar>& r_ab,
+                                         const ShapeA& a,
+                                         const ShapeB& b,
+                                         const vec3<Scalar>& direction,
+                                         OverlapReal max_distance,
+                                         unsigned int& err)
+    {
+    // default implementation never moves, will make it obvious if something calls this
+    return OverlapReal(0.0);
+    }
+
+//! Sphere-Sphere sweep distance
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param direction Unit vector that shape a moves along
+    \param max_distance Largest distance of interest
+    \param err in/out variable incremented when error conditions occur
+    \returns The distance that *a* can move along *direction* before it touches *b*, or
+             *max_distance* when they do not touch within *max_distance*
+
+    \ingroup shape
+*/
+template<>
+DEVICE inline OverlapReal sweep_distance<ShapeSphere, ShapeSphere>(const vec3<Scalar>& r_ab,
+                                                                   const ShapeSphere& a,
+                                                                   const ShapeSphere& b,
+                                                                   const vec3<Scalar>& direction,
+                                                                   OverlapReal max_distance,
+                                                                   unsigned int& err)
+    {
+    vec3<OverlapReal> dr(r_ab);
+    vec3<OverlapReal> d(direction);
+
+    OverlapReal RaRb = a.params.radius + b.params.radius;
+    OverlapReal c = dot(dr, dr) - RaRb * RaRb;
+    if (c <= OverlapReal(0.0))
+        return OverlapReal(0.0);
+
+    // a moves away from b or misses it
+    OverlapReal dr_d = dot(dr, d);
+    OverlapReal disc = dr_d * dr_d - c;
+    if (dr_d <= OverlapReal(0.0) || disc < OverlapReal(0.0))
+        return max_distance;
+
+    // smaller root of |dr - distance * d| = RaRb, in a form that avoids cancellation
+    OverlapReal distance = c / (dr_d + fast::sqrt(disc));
+    return distance < max_distance ? distance : max_distance;
+    }
+
 namespace detail
     {
 //! APIs for depletant sampling
@@ -195,6 +195,44 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     */
     }
 
+//! Convex spheropolyhedron sweep distance
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param direction Unit vector that shape a moves along
+    \param max_distance Largest distance of interest
+    \param err in/out variable incremented when error conditions occur in the sweep
+    \returns The distance that *a* can move along *direction* before it touches *b*, or
+             *max_distance* when they do not touch within *max_distance*
+
+    The sweep radii are applied as a margin around the polyhedral cores.
+
+    \ingroup shape
+*/
+template<>
+DEVICE inline OverlapReal sweep_distance(const vec3<Scalar>& r_ab,
+                                         const ShapeSpheropolyhedron& a,
+                                         const ShapeSpheropolyhedron& b,
+                                         const vec3<Scalar>& direction,
+                                         OverlapReal max_distance,
+                                         unsigned int& err)
+    {
+    vec3<OverlapReal> dr(r_ab);
+    quat<OverlapReal> conj_q_a = conj(quat<OverlapReal>(a.orientation));
+
+    OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
+
+    return detail::gjk_sweep_3d(detail::SupportFuncConvexPolyhedron(a.verts),
+                                detail::SupportFuncConvexPolyhedron(b.verts),
+                                rotate(conj_q_a, dr),
+                                conj_q_a * quat<OverlapReal>(b.orientation),
+                                rotate(conj_q_a, vec3<OverlapReal>(direction)),
+                                a.verts.sweep_radius + b.verts.sweep_radius,
+                                max_distance,
+                                DaDb / OverlapReal(2.0),
+                                err);
+    }
+
 #ifndef __HIPCC__
 template<> inline std::string getShapeSpec(const ShapeSpheropolyhedron& spoly)
     {
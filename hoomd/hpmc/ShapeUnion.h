@@ -526,6 +526,76 @@ DEVICE inline bool test_narrow_phase_overlap(vec3<OverlapReal> dr,
     return false;
     }
 
+/** Test the member spheres in two leaf nodes for overlap
+
+    Unions of spheres are the common way to build large colloid models, with many members per leaf
+    node. The relative rotation is converted to a matrix once per leaf pair instead of once per
+    member pair, and member pairs are compared by squared distance without constructing member
+    shapes. On the CPU, the member of a is transformed once for all members of b.
+*/
+template<>
+DEVICE inline bool test_narrow_phase_overlap<ShapeSphere>(vec3<OverlapReal> dr,
+                                                          const ShapeUnion<ShapeSphere>& a,
+                                                          const ShapeUnion<ShapeSphere>& b,
+                                                          unsigned int cur_node_a,
+                                                          unsigned int cur_node_b,
+                                                          unsigned int& err)
+    {
+    // transform the members of a into the body frame of b
+    quat<OverlapReal> q_b_conj = conj(quat<OverlapReal>(b.orientation));
+    rotmat3<OverlapReal> R(q_b_conj * quat<OverlapReal>(a.orientation));
+    vec3<OverlapReal> r_ab = rotate(q_b_conj, dr);
+
+    unsigned int ptl_i = a.members.tree.getLeafNodePtrByNode(cur_node_a);
+    unsigned int ptl_j = b.members.tree.getLeafNodePtrByNode(cur_node_b);
+
+    unsigned int ptls_i_end = a.members.tree.getLeafNodePtrByNode(cur_node_a + 1);
+    unsigned int ptls_j_end = b.members.tree.getLeafNodePtrByNode(cur_node_b + 1);
+
+#if defined(__HIP_DEVICE_COMPILE__)
+    // parallel loop over the (a,b) pairs in row major
+    unsigned int nb = ptls_j_end - ptl_j;
+    unsigned int len = (ptls_i_end - ptl_i) * nb;
+
+    for (unsigned int n = threadIdx.x; n < len; n += blockDim.x)
+        {
+        unsigned int ishape = a.members.tree.getParticleByIndex(ptl_i + n / nb);
+        unsigned int jshape = b.members.tree.getParticleByIndex(ptl_j + n % nb);
+
+        if (!(a.members.moverlap[ishape] & b.members.moverlap[jshape]))
+            continue;
+
+        vec3<OverlapReal> r_ij = b.members.mpos[jshape] - (R * a.members.mpos[ishape] - r_ab);
+        OverlapReal RaRb = a.members.mparams[ishape].radius + b.members.mparams[jshape].radius;
+        if (dot(r_ij, r_ij) < RaRb * RaRb)
+            return true;
+        }
+#else
+    for (unsigned int ptl = ptl_i; ptl < ptls_i_end; ++ptl)
+        {
+        unsigned int ishape = a.members.tree.getParticleByIndex(ptl);
+        unsigned int overlap_i = a.members.moverlap[ishape];
+        OverlapReal radius_i = a.members.mparams[ishape].radius;
+        vec3<OverlapReal> pos_i = R * a.members.mpos[ishape] - r_ab;
+
+        for (unsigned int ptl_b = ptl_j; ptl_b < ptls_j_end; ++ptl_b)
+            {
+            unsigned int jshape = b.members.tree.getParticleByIndex(ptl_b);
+
+            if (!(overlap_i & b.members.moverlap[jshape]))
+                continue;
+
+            vec3<OverlapReal> r_ij = b.members.mpos[jshape] - pos_i;
+            OverlapReal RaRb = radius_i + b.members.mparams[jshape].radius;
+            if (dot(r_ij, r_ij) < RaRb * RaRb)
+                return true;
+            }
+        }
+#endif
+
+    return false;
+    }
+
 template<class Shape>
 DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
                                 const ShapeUnion<Shape>& a,
@@ -254,7 +254,15 @@ inline bool UpdaterBoxMC::box_resize_trial(Scalar Lx,
     newBox.setL(make_scalar3(Lx, Ly, Lz));
     newBox.setTiltFactors(xy, xz, yz);
 
-    bool allowed = m_mc->attemptBoxResize(timestep, newBox);
+    // A trial box that keeps every pair of circumspheres apart cannot create overlaps, so the
+    // particles only need to be scaled.
+    bool check_overlaps = true;
+    if (m_safe_scaling)
+        {
+        check_overlaps = !m_mc->testCircumspheresAfterScaling(min_scale_factor(curBox, newBox));
+        }
+
+    bool allowed = m_mc->attemptBoxResize(timestep, newBox, check_overlaps);
 
     if (allowed && m_mc->getPatchEnergy())
         {
@@ -327,6 +335,72 @@ inline bool UpdaterBoxMC::safe_box(const Scalar newL[3], const unsigned int& Ndi
     return true;
     }
 
+/*! \param curBox Current box
+    \param newBox Trial box
+
+    Scaling the particle positions from curBox to newBox applies the linear map M = h' h^-1 to
+    every pair separation, where h and h' are the matrices of lattice vectors. The returned smallest
+    singular value of M is the smallest factor by which any separation can shrink. It is the square
+    root of the smallest eigenvalue of M^T M, computed in closed form. Only the x and y directions
+    are considered in 2D.
+
+    \returns The smallest singular value of the map from curBox to newBox
+*/
+inline Scalar UpdaterBoxMC::min_scale_factor(const BoxDim& curBox, const BoxDim& newBox)
+    {
+    // columns of M are the images of the unit vectors
+    const Scalar3 origin = newBox.makeCoordinates(curBox.makeFraction(make_scalar3(0, 0, 0)));
+    const Scalar3 e[3] = {make_scalar3(1, 0, 0), make_scalar3(0, 1, 0), make_scalar3(0, 0, 1)};
+    Scalar3 m[3];
+    for (unsigned int k = 0; k < 3; k++)
+        {
+        m[k] = newBox.makeCoordinates(curBox.makeFraction(e[k])) - origin;
+        }
+
+    // A = M^T M
+    Scalar a00 = dot(m[0], m[0]);
+    Scalar a11 = dot(m[1], m[1]);
+    Scalar a01 = dot(m[0], m[1]);
+
+    Scalar lambda_min;
+    if (m_sysdef->getNDimensions() == 2)
+        {
+        Scalar half_diff = Scalar(0.5) * (a00 - a11);
+        lambda_min = Scalar(0.5) * (a00 + a11) - sqrt(half_diff * half_diff + a01 * a01);
+        }
+    else
+        {
+        Scalar a22 = dot(m[2], m[2]);
+        Scalar a02 = dot(m[0], m[2]);
+        Scalar a12 = dot(m[1], m[2]);
+
+        // eigenvalues of a symmetric 3x3 matrix
+        Scalar q = (a00 + a11 + a22) / Scalar(3.0);
+        Scalar p1 = a01 * a01 + a02 * a02 + a12 * a12;
+        Scalar p2 = (a00 - q) * (a00 - q) + (a11 - q) * (a11 - q) + (a22 - q) * (a22 - q)
+                    + Scalar(2.0) * p1;
+        Scalar p = sqrt(p2 / Scalar(6.0));
+        if (p == Scalar(0.0))
+            {
+            lambda_min = q;
+            }
+        else
+            {
+            // B = (A - q I) / p, r = det(B) / 2
+            Scalar b00 = (a00 - q) / p, b11 = (a11 - q) / p, b22 = (a22 - q) / p;
+            Scalar b01 = a01 / p, b02 = a02 / p, b12 = a12 / p;
+            Scalar r = Scalar(0.5)
+                       * (b00 * (b11 * b22 - b12 * b12) - b01 * (b01 * b22 - b12 * b02)
+                          + b02 * (b01 * b12 - b11 * b02));
+            r = std::max(Scalar(-1.0), std::min(Scalar(1.0), r));
+            Scalar phi = acos(r) / Scalar(3.0);
+            lambda_min = q + Scalar(2.0) * p * cos(phi + Scalar(2.0 * M_PI / 3.0));
+            }
+        }
+
+    return sqrt(std::max(lambda_min, Scalar(0.0)));
+    }
+
 /*! Perform Metropolis Monte Carlo box resizes and shearing
     \param timestep Current time step of the simulation
 */
@@ -850,7 +924,8 @@ void export_UpdaterBoxMC(pybind11::module& m)
         .def_property("aspect", &UpdaterBoxMC::getAspectParams, &UpdaterBoxMC::setAspectParams)
         .def_property("betaP", &UpdaterBoxMC::getBetaP, &UpdaterBoxMC::setBetaP)
         .def("getCounters", &UpdaterBoxMC::getCounters)
-        .def_property("instance", &UpdaterBoxMC::getInstance, &UpdaterBoxMC::setInstance);
+        .def_property("instance", &UpdaterBoxMC::getInstance, &UpdaterBoxMC::setInstance)
+        .def_property("safe_scaling", &UpdaterBoxMC::getSafeScaling, &UpdaterBoxMC::setSafeScaling);
 
     pybind11::class_<hpmc_boxmc_counters_t>(m, "hpmc_boxmc_counters_t")
         .def_property_readonly("volume",
@@ -279,12 +279,27 @@ class UpdaterBoxMC : public Updater
         return m_instance;
         }
 
+    /// Set whether trial boxes are screened with the circumsphere scaling bound
+    void setSafeScaling(bool safe_scaling)
+        {
+        m_safe_scaling = safe_scaling;
+        }
+
+    /// Get whether trial boxes are screened with the circumsphere scaling bound
+    bool getSafeScaling()
+        {
+        return m_safe_scaling;
+        }
+
     private:
     std::shared_ptr<IntegratorHPMC> m_mc; //!< HPMC integrator object
     std::shared_ptr<Variant> m_beta_P;    //!< Reduced pressure in isobaric ensembles
 
     unsigned int m_instance = 0; //!< Unique ID for RNG seeding
 
+    /// Skip the overlap check for trial boxes that cannot bring any circumspheres into contact
+    bool m_safe_scaling = false;
+
     Scalar m_volume_delta;     //!< Amount by which to change volume during box-change
     Scalar m_volume_weight;    //!< relative weight of volume moves
     Scalar m_ln_volume_delta;  //!< Amount by which to log volume parameter during box-change
@@ -327,6 +342,8 @@ class UpdaterBoxMC : public Updater
     //!< attempt specified box change and undo if overlaps generated
     inline bool safe_box(const Scalar newL[3], const unsigned int& Ndim);
     //!< Perform appropriate checks for box validity
+    inline Scalar min_scale_factor(const BoxDim& curBox, const BoxDim& newBox);
+    //!< Smallest factor by which the map from curBox to newBox scales any pair separation
 
     //! Update the internal vector of partial sums of weights
     void updateChangedWeights();
@@ -10,8 +10,8 @@
 #include "hoomd/RandomNumbers.h"
 #include "hoomd/RNGIdentifiers.h"
 
-#include <set>
 #include <list>
+#include <map>
 
 #include "Moves.h"
 #include "HPMCCounters.h"
@@ -19,16 +19,14 @@
 
 #ifdef ENABLE_TBB
 #include <tbb/concurrent_unordered_map.h>
-#include <tbb/concurrent_unordered_set.h>
-#include <tbb/concurrent_vector.h>
 #include <tbb/parallel_for.h>
-#include <tbb/task.h>
-#include <atomic>
-
-#if TBB_VERSION_MAJOR < 2021
-#define ENABLE_TBB_TASK
 #endif
 
+#include <atomic>
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#include <unordered_map>
 #endif
 
 namespace hoomd {
@@ -39,49 +37,20 @@ namespace hpmc
 namespace detail
 {
 
-#ifdef ENABLE_TBB_TASK
-//! Wrapper around std::atomic_flag to allow use in a std::vector
-class my_atomic_flag
+#ifdef ENABLE_TBB
+//! Hash function for particle pairs, oneTBB does not provide one for std::pair
+struct PairHash
     {
-    public:
-        //! Default constructor
-        my_atomic_flag()
-            {
-            f.clear();
-            }
-
-        //! Copy constructor
-        /*! \note this constructor doesn't really copy the value of its argument,
-            it just reset's the flag to zero
-         */
-        my_atomic_flag(const my_atomic_flag& other)
-            {
-            f.clear();
-            }
-
-        //! Assignment operator (non-atomic)
-        /*! \note this assignment operator doesn't really copy the value of its argument,
-            it just reset's the flag to zero
-         */
-        my_atomic_flag& operator =( const my_atomic_flag& other)
-            {
-            f.clear();
-            return *this;
-            }
-
-        //! Sets flag and returns old value
-        bool test_and_set()
-            {
-            return f.test_and_set();
-            }
-
-    private:
-        std::atomic_flag f;
+    size_t operator()(const std::pair<unsigned int, unsigned int>& p) const
+        {
+        return std::hash<uint64_t>()((uint64_t(p.first) << 32) | p.second);
+        }
     };
 #endif
 
-// Graph class represents a undirected graph
-// using adjacency list representation
+// Graph class represents an undirected graph by the connected components of its edges, using a
+// concurrent union-find (disjoint set forest). Edges are merged into the forest when they are
+// added, so the adjacency list is never stored.
 class Graph
     {
     public:
@@ -93,15 +62,12 @@ class Graph
 
         inline void resize(unsigned int V);
 
+        //! Add an undirected edge, may be called from several threads
         inline void addEdge(unsigned int v, unsigned int w);
 
-        #ifdef ENABLE_TBB_TASK
-        inline void connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc);
-        #else
         inline void connectedComponents(std::vector<std::vector<unsigned int> >& cc);
-        #endif
 
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
         void setTaskArena(std::shared_ptr<tbb::task_arena> task_arena)
             {
             m_task_arena = task_arena;
@@ -109,162 +75,243 @@ class Graph
         #endif
 
     private:
-        #ifndef ENABLE_TBB_TASK
-        std::multimap<unsigned int,unsigned int> adj;
-        #else
-        tbb::concurrent_unordered_multimap<unsigned int, unsigned int> adj;
-        #endif
-
-        #ifndef ENABLE_TBB_TASK
-        std::vector<unsigned int> visited;
-        #else
-        std::vector<my_atomic_flag> visited;
-        #endif
+        //! Parent of each vertex in the forest, roots are their own parents
+        /*! A root is always linked below a root with a smaller index, so the root of each tree is
+            the smallest vertex in its component.
+        */
+        std::vector<std::atomic<unsigned int> > parent;
 
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
         /// The TBB task arena
         std::shared_ptr<tbb::task_arena> m_task_arena;
         #endif
 
-        #ifndef ENABLE_TBB_TASK
-        // A function used by DFS
-        inline void DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc);
-        #endif
-
-        #ifdef ENABLE_TBB_TASK
-        class DFSTask : public tbb::task
-            {
-            public:
-                DFSTask(unsigned int _root, std::vector<my_atomic_flag>& _visited,
-                    tbb::concurrent_vector<unsigned int>& _cc,
-                    const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& _adj)
-                    : root(_root), visited(_visited), cc(_cc), adj(_adj)
-                    { }
-
-                tbb::task* execute()
-                    {
-                    cc.push_back(root);
-
-                    unsigned int count = 0;
-                    tbb::task_list list;
-
-                    auto begin = adj.equal_range(root).first;
-                    auto end = adj.equal_range(root).second;
-
-                    for (auto it = begin; it != end; ++it)
-                        {
-                        unsigned int neighbor = it->second;
-                        if (!visited[neighbor].test_and_set())
-                            {
-                            if (count++ == 0)
-                                {
-                                root = neighbor; // for task recycling
-                                continue;
-                                }
-                            list.push_back(*new(allocate_child()) DFSTask(neighbor, visited, cc, adj));
-                            }
-                        }
-
-                    if (count)
-                        {
-                        set_ref_count(count);
-                        spawn(list);
-
-                        recycle_as_safe_continuation();
-                        }
-
-                    return NULL;
-                    }
-
-            private:
-                unsigned int root;
-                std::vector<my_atomic_flag> & visited;
-                tbb::concurrent_vector<unsigned int>& cc;
-                const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& adj;
-            };
-        #endif // ENABLE_TBB_TASK
-
+        //! Find the root of a vertex, halving the path on the way
+        inline unsigned int find(unsigned int v);
     };
 
+unsigned int Graph::find(unsigned int v)
+    {
+    while (true)
+        {
+        unsigned int p = parent[v].load(std::memory_order_relaxed);
+        if (p == v)
+            return v;
+
+        // link v to its grandparent, failing is fine if another thread changed it
+        unsigned int gp = parent[p].load(std::memory_order_relaxed);
+        if (gp != p)
+            parent[v].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+        v = gp;
+        }
+    }
+
 // Gather connected components in an undirected graph
-#ifdef ENABLE_TBB_TASK
-void Graph::connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc)
-#else
+/*! Components are ordered by their smallest vertex, which is also their first element, and the
+    vertices in each component are in ascending order.
+*/
 void Graph::connectedComponents(std::vector<std::vector<unsigned int> >& cc)
-#endif
     {
-    #ifdef ENABLE_TBB_TASK
+    unsigned int V = (unsigned int)parent.size();
+
+    // point every vertex directly at its root
+    #ifdef ENABLE_TBB
     this->m_task_arena->execute([&]{
-    for (unsigned int v = 0; v < visited.size(); ++v)
+    tbb::parallel_for((unsigned int)0, V, [&](unsigned int v)
+    #else
+    for (unsigned int v = 0; v < V; ++v)
+    #endif
         {
-        if (! visited[v].test_and_set())
-            {
-            tbb::concurrent_vector<unsigned int> component;
-            DFSTask& a = *new(tbb::task::allocate_root()) DFSTask(v, visited, component, adj);
-            tbb::task::spawn_root_and_wait(a);
-            cc.push_back(component);
-            }
+        parent[v].store(find(v), std::memory_order_relaxed);
         }
+    #ifdef ENABLE_TBB
+        );
     }); // end task arena execute()
-    #else
-    std::fill(visited.begin(), visited.end(), 0);
+    #endif
 
-    // Depth first search
-    for (unsigned int v=0; v<visited.size(); v++)
+    // roots precede the other vertices of their component
+    std::vector<unsigned int> component(V);
+    for (unsigned int v = 0; v < V; ++v)
         {
-        if (visited[v] == false)
+        unsigned int root = parent[v].load(std::memory_order_relaxed);
+        if (root == v)
+            {
+            component[v] = (unsigned int)cc.size();
+            cc.push_back(std::vector<unsigned int>(1, v));
+            }
+        else
             {
-            std::vector<unsigned int> cur_cc;
-            DFSUtil(v, visited, cur_cc);
-            cc.push_back(cur_cc);
+            cc[component[root]].push_back(v);
             }
         }
-    #endif
     }
 
-#ifndef ENABLE_TBB_TASK
-void Graph::DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc)
-    {
-    visited[v] = 1;
-    cur_cc.push_back(v);
-
-    // Recur for all the vertices
-    // adjacent to this vertex
-    auto begin = adj.equal_range(v).first;
-    auto end = adj.equal_range(v).second;
-    for(auto i = begin; i != end; ++i)
-        {
-        if(!visited[i->second])
-            DFSUtil(i->second, visited, cur_cc);
-        }
-    }
-#endif
 Graph::Graph(unsigned int V)
     {
-    #ifndef ENABLE_TBB_TASK
-    visited.resize(V, 0);
-    #else
-    visited.resize(V);
-    #endif
+    resize(V);
     }
 
 void Graph::resize(unsigned int V)
     {
-    #ifndef ENABLE_TBB_TASK
-    visited.resize(V, 0);
-    #else
-    visited.clear();
-    visited.resize(V);
-    #endif
+    if (parent.size() != V)
+        {
+        std::vector<std::atomic<unsigned int> > new_parent(V);
+        parent.swap(new_parent);
+        }
 
-    adj.clear();
+    // every vertex starts in its own component
+    for (unsigned int v = 0; v < V; ++v)
+        parent[v].store(v, std::memory_order_relaxed);
     }
 
-// method to add a directed edge
+// method to add an undirected edge
 void Graph::addEdge(unsigned int v, unsigned int w)
     {
-    adj.insert(std::make_pair(v,w));
+    while (true)
+        {
+        v = find(v);
+        w = find(w);
+        if (v == w)
+            return;
+
+        // link the larger root below the smaller one, retry if it is no longer a root
+        if (v < w)
+            std::swap(v, w);
+        unsigned int expected = v;
+        if (parent[v].compare_exchange_strong(expected, w, std::memory_order_relaxed))
+            return;
+        }
+    }
+
+#ifdef ENABLE_MPI
+//! A transformed particle, sent to the rank that owns its new position
+struct cluster_element
+    {
+    Scalar4 postype;     //!< Transformed position and type
+    Scalar4 orientation; //!< Transformed orientation
+    unsigned int tag;    //!< Particle tag
+    };
+
+//! Label the connected components of a graph whose edges are found on different ranks
+/*! \param G Graph to join the edges found on this rank
+    \param edges Edges between particle tags found on this rank
+    \param tags Tags of the local particles
+    \param labels Output: the smallest tag in the component of each local particle
+    \param max_tag Largest particle tag in the system
+    \param mpi_comm MPI communicator
+
+    The label of each tag is stored on its home rank (the tag modulo the number of ranks) and
+    starts as the tag itself. In every round, each rank sends the smallest label of each of its
+    local components to the home ranks of all tags in the component, and the home ranks reply with
+    the smallest label they received so far. Components that share a tag on different ranks merge
+    their labels this way, and the exchange stops when no label changes.
+*/
+inline void connectedComponentsDistributed(Graph& G,
+                                           const std::vector<uint2>& edges,
+                                           const std::vector<unsigned int>& tags,
+                                           std::vector<unsigned int>& labels,
+                                           unsigned int max_tag,
+                                           const MPI_Comm mpi_comm)
+    {
+    int size;
+    int rank;
+    MPI_Comm_size(mpi_comm, &size);
+    MPI_Comm_rank(mpi_comm, &rank);
+
+    // labels of the tags at home on this rank
+    std::vector<unsigned int> home_label;
+    for (unsigned int tag = rank; tag <= max_tag; tag += size)
+        home_label.push_back(tag);
+
+    // join the edges into components of the tags seen on this rank
+    std::unordered_map<unsigned int, unsigned int> vertex;
+    std::vector<unsigned int> vertex_tag;
+    for (const uint2& e : edges)
+        {
+        if (vertex.insert(std::make_pair(e.x, (unsigned int)vertex_tag.size())).second)
+            vertex_tag.push_back(e.x);
+        if (vertex.insert(std::make_pair(e.y, (unsigned int)vertex_tag.size())).second)
+            vertex_tag.push_back(e.y);
+        }
+
+    G.resize((unsigned int)vertex_tag.size());
+    for (const uint2& e : edges)
+        G.addEdge(vertex[e.x], vertex[e.y]);
+
+    std::vector<std::vector<unsigned int> > cc;
+    G.connectedComponents(cc);
+
+    std::vector<unsigned int> vertex_label(vertex_tag);
+    while (true)
+        {
+        // send the smallest label of each component to the home ranks of its tags
+        std::vector<std::vector<uint2> > send(size);
+        for (const std::vector<unsigned int>& component : cc)
+            {
+            unsigned int min_label = UINT_MAX;
+            for (unsigned int v : component)
+                min_label = std::min(min_label, vertex_label[v]);
+            for (unsigned int v : component)
+                send[vertex_tag[v] % size].push_back(make_uint2(vertex_tag[v], min_label));
+            }
+
+        std::vector<std::vector<uint2> > recv;
+        all_to_all_v(send, recv, mpi_comm);
+
+        // keep the smallest label of each tag and reply with it
+        int changed = 0;
+        for (const std::vector<uint2>& recv_rank : recv)
+            {
+            for (const uint2& p : recv_rank)
+                {
+                unsigned int& label = home_label[p.x / size];
+                if (p.y < label)
+                    {
+                    label = p.y;
+                    changed = 1;
+                    }
+                }
+            }
+
+        std::vector<std::vector<unsigned int> > reply(size);
+        for (int i = 0; i < size; ++i)
+            for (const uint2& p : recv[i])
+                reply[i].push_back(home_label[p.x / size]);
+
+        std::vector<std::vector<unsigned int> > recv_reply;
+        all_to_all_v(reply, recv_reply, mpi_comm);
+        for (int i = 0; i < size; ++i)
+            for (unsigned int k = 0; k < send[i].size(); ++k)
+                vertex_label[vertex[send[i][k].x]] = recv_reply[i][k];
+
+        MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_MAX, mpi_comm);
+        if (!changed)
+            break;
+        }
+
+    // fetch the labels of the local particles
+    std::vector<std::vector<unsigned int> > request(size);
+    for (unsigned int tag : tags)
+        request[tag % size].push_back(tag);
+
+    std::vector<std::vector<unsigned int> > recv_request;
+    all_to_all_v(request, recv_request, mpi_comm);
+    for (int i = 0; i < size; ++i)
+        for (unsigned int& tag : recv_request[i])
+            tag = home_label[tag / size];
+
+    std::vector<std::vector<unsigned int> > recv_label;
+    all_to_all_v(recv_request, recv_label, mpi_comm);
+
+    std::vector<unsigned int> offset(size, 0);
+    labels.resize(tags.size());
+    for (unsigned int i = 0; i < tags.size(); ++i)
+        {
+        unsigned int home = tags[i] % size;
+        labels[i] = recv_label[home][offset[home]++];
+        }
     }
+#endif
 } // end namespace detail
 
 /*! A generic cluster move for attractive interactions.
@@ -362,13 +409,9 @@ class UpdaterClusters : public Updater
 
         unsigned int m_instance=0;                  //!< Unique ID for RNG seeding
 
-        #ifdef ENABLE_TBB_TASK
-        std::vector<tbb::concurrent_vector<unsigned int> > m_clusters; //!< Cluster components
-        #else
         std::vector<std::vector<unsigned int> > m_clusters; //!< Cluster components
-        #endif
 
-        detail::Graph m_G; //!< The graph
+        detail::Graph m_G; //!< Connected components of the interaction graph
 
         hoomd::detail::AABBTree m_aabb_tree_old;              //!< Locality lookup for old configuration
 
@@ -376,14 +419,12 @@ class UpdaterClusters : public Updater
         GlobalVector<Scalar4> m_orientation_backup;    //!< Old local orientations
         GlobalVector<int3> m_image_backup;             //!< Old local images
 
-        #ifndef ENABLE_TBB_TASK
-        std::set<std::pair<unsigned int, unsigned int> > m_overlap;   //!< A local vector of particle pairs due to overlap
+        #ifndef ENABLE_TBB
         std::map<std::pair<unsigned int, unsigned int>,float > m_energy_old_old;    //!< Energy of interaction old-old
         std::map<std::pair<unsigned int, unsigned int>,float > m_energy_new_old;    //!< Energy of interaction old-old
         #else
-        tbb::concurrent_unordered_set<std::pair<unsigned int, unsigned int> > m_overlap;
-        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,float > m_energy_old_old;
-        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,float > m_energy_new_old;
+        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,float,detail::PairHash > m_energy_old_old;
+        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,float,detail::PairHash > m_energy_new_old;
         #endif
 
         hpmc_clusters_counters_t m_count_total;                 //!< Total count since initialization
@@ -410,6 +451,16 @@ class UpdaterClusters : public Updater
         // Transform particles using an self-inverse, isometric operation
         virtual void transform(const quat<Scalar>& q, const vec3<Scalar>& pivot, bool line);
 
+        //! Transform a single particle and wrap it back into the box
+        inline void transformParticle(Scalar4& postype, Scalar4& orientation, int3& image,
+            const quat<Scalar>& q, const vec3<Scalar>& pivot, bool line, const BoxDim& box);
+
+        #ifdef ENABLE_MPI
+        //! Perform a cluster move with domain decomposition
+        void updateDomainDecomposition(uint64_t timestep, const quat<Scalar>& q,
+            const vec3<Scalar>& pivot, bool line);
+        #endif
+
         //! Flip clusters randomly
         virtual void flip(uint64_t timestep);
     };
@@ -422,7 +473,7 @@ UpdaterClusters<Shape>::UpdaterClusters(std::shared_ptr<SystemDefinition> sysdef
     {
     m_exec_conf->msg->notice(5) << "Constructing UpdaterClusters" << std::endl;
 
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     m_G.setTaskArena(sysdef->getParticleData()->getExecConf()->getTaskArena());
     #endif
 
@@ -490,7 +541,7 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
         }
     img_i = box.getImage(pos_i_transf);
 
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     this->m_exec_conf->getTaskArena()->execute([&]{
     tbb::parallel_for(tbb::blocked_range<unsigned int>(0, this->m_pdata->getNTypes()),
         [=, &shape_i](const tbb::blocked_range<unsigned int>& x) {
@@ -499,7 +550,7 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
     for (unsigned int type_a = 0; type_a < this->m_pdata->getNTypes(); ++type_a)
     #endif
         {
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
         tbb::parallel_for(tbb::blocked_range<unsigned int>(type_a, this->m_pdata->getNTypes()),
             [=, &shape_i](const tbb::blocked_range<unsigned int>& w) {
         for (unsigned int type_b = w.begin(); type_b != w.end(); ++type_b)
@@ -649,7 +700,7 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
                 }
 
             // for every depletant
-            #ifdef ENABLE_TBB_TASK
+            #ifdef ENABLE_TBB
             tbb::parallel_for(tbb::blocked_range<unsigned int>(0, (unsigned int)n),
                 [=, &shape_i,
                     &pos_j, &orientation_j, &type_j, &V_all,
@@ -1037,23 +1088,20 @@ inline void UpdaterClusters<Shape>::checkDepletantOverlap(unsigned int i, vec3<S
                         if ((overlap_i_a && !overlap_transf_a && overlap_j_b) || (overlap_i_b && !overlap_transf_b & overlap_j_a))
                             {
                             // add bond
-                            this->m_overlap.insert(std::make_pair(i,idx_j[m]));
-
-                            // since i<=j by construction, make matrix symmetric explicitly
-                            this->m_overlap.insert(std::make_pair(idx_j[m],i));
+                            this->m_G.addEdge(i,idx_j[m]);
                             }
                         }
                     } // end loop over intersections
                 } // end loop over depletants
-            #ifdef ENABLE_TBB_TASK
+            #ifdef ENABLE_TBB
                 });
             #endif
             } // end loop over type_b
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
             });
         #endif
         } // end loop over type_a
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
         });
     }); // end task arena execute()
     #endif
@@ -1074,37 +1122,40 @@ void UpdaterClusters<Shape>::transform(const quat<Scalar>& q, const vec3<Scalar>
         ArrayHandle<Scalar4> h_orientation(this->m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
         ArrayHandle<int3> h_image(this->m_pdata->getImages(), access_location::host, access_mode::readwrite);
 
-        // access parameters
-        auto params = m_mc->getParams();
         unsigned int nptl = this->m_pdata->getN();
 
         for (unsigned int i = 0; i < nptl; ++i)
-            {
-            vec3<Scalar> new_pos(h_pos.data[i]);
-            if (!line)
-                {
-                // point reflection
-                new_pos = pivot-(new_pos-pivot);
-                }
-            else
-                {
-                // line reflection
-                new_pos = lineReflection(new_pos, pivot, q);
-                Shape shape_i(quat<Scalar>(h_orientation.data[i]), params[__scalar_as_int(h_pos.data[i].w)]);
-                if (shape_i.hasOrientation())
-                    h_orientation.data[i] = quat_to_scalar4(q*quat<Scalar>(h_orientation.data[i]));
-                }
-            // wrap particle back into box, incrementing image flags
-            int3 img = box.getImage(new_pos);
-            new_pos = box.shift(new_pos,-img);
-            h_pos.data[i] = make_scalar4(new_pos.x, new_pos.y, new_pos.z, h_pos.data[i].w);
-            h_image.data[i] = h_image.data[i] + img;
-            }
+            transformParticle(h_pos.data[i], h_orientation.data[i], h_image.data[i], q, pivot, line, box);
         }
 
     if (m_prof) m_prof->pop(m_exec_conf);
     }
 
+template< class Shape >
+void UpdaterClusters<Shape>::transformParticle(Scalar4& postype, Scalar4& orientation, int3& image,
+    const quat<Scalar>& q, const vec3<Scalar>& pivot, bool line, const BoxDim& box)
+    {
+    vec3<Scalar> new_pos(postype);
+    if (!line)
+        {
+        // point reflection
+        new_pos = pivot-(new_pos-pivot);
+        }
+    else
+        {
+        // line reflection
+        new_pos = lineReflection(new_pos, pivot, q);
+        Shape shape_i(quat<Scalar>(orientation), m_mc->getParams()[__scalar_as_int(postype.w)]);
+        if (shape_i.hasOrientation())
+            orientation = quat_to_scalar4(q*quat<Scalar>(orientation));
+        }
+    // wrap particle back into box, incrementing image flags
+    int3 img = box.getImage(new_pos);
+    new_pos = box.shift(new_pos,-img);
+    postype = make_scalar4(new_pos.x, new_pos.y, new_pos.z, postype.w);
+    image = image + img;
+    }
+
 template< class Shape >
 void UpdaterClusters<Shape>::flip(uint64_t timestep)
     {
@@ -1171,9 +1222,6 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
     Index2D overlap_idx = m_mc->getOverlapIndexer();
     ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(), access_location::host, access_mode::read);
 
-    // clear the local bond and rejection lists
-    m_overlap.clear();
-
     auto patch = m_mc->getPatchEnergy();
 
     Scalar r_cut_patch(0.0);
@@ -1200,7 +1248,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
     if (patch)
         {
         // test old configuration against itself
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
         this->m_exec_conf->getTaskArena()->execute([&]{
         tbb::parallel_for((unsigned int)0,this->m_pdata->getN(), [&](unsigned int i)
         #else
@@ -1293,14 +1341,14 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
                 } // end loop over images
 
             } // end loop over old configuration
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
             );
         }); // end task arena execute()
         #endif
         }
 
     // loop over new configuration
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     this->m_exec_conf->getTaskArena()->execute([&]{
     tbb::parallel_for((unsigned int)0,nptl, [&](unsigned int i)
     #else
@@ -1363,7 +1411,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
                                     && test_overlap(r_ij, shape_i, shape_j, err))
                                     {
                                     // add connection
-                                    m_overlap.insert(std::make_pair(i,j));
+                                    m_G.addEdge(i,j);
                                     } // end if overlap
                                 }
 
@@ -1458,7 +1506,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
                 } // end loop over images
             } // end if patch
         } // end loop over local particles
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
         );
     }); // end task arena execute()
     #endif
@@ -1485,7 +1533,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
         return;
 
     // test old configuration against itself
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     this->m_exec_conf->getTaskArena()->execute([&]{
     tbb::parallel_for((unsigned int)0,this->m_pdata->getN(), [&](unsigned int i) {
     #else
@@ -1503,7 +1551,7 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
             h_overlaps.data, h_fugacity.data,
             timestep, q, pivot, line);
         }
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
         });
     }); // end task arena execute()
     #endif
@@ -1552,6 +1600,226 @@ void UpdaterClusters<Shape>::connectedComponents()
     if (this->m_prof) this->m_prof->pop();
     }
 
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step of the simulation
+    \param q Rotation of the line reflection
+    \param pivot Pivot point of the move
+    \param line True for a line reflection, false for a point reflection
+
+    Each rank sends the transformed copies of its particles to the rank that owns their new
+    positions, which tests them against the old configuration of its local and ghost particles.
+    The overlapping pairs of tags are merged into clusters across ranks, and every rank flips the
+    clusters of its particles with the same random numbers, seeded by the smallest tag in the
+    cluster. Flipped particles that leave the domain are sent directly to their new rank.
+*/
+template< class Shape >
+void UpdaterClusters<Shape>::updateDomainDecomposition(uint64_t timestep, const quat<Scalar>& q,
+    const vec3<Scalar>& pivot, bool line)
+    {
+    if (m_mc->getPatchEnergy())
+        throw std::runtime_error("UpdaterClusters does not support patch energies with domain decomposition.");
+    for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
+        for (unsigned int j = 0; j < m_pdata->getNTypes(); ++j)
+            if (m_mc->getDepletantFugacity(i,j) != 0.0)
+                throw std::runtime_error("UpdaterClusters does not support depletants with domain decomposition.");
+
+    // the ghost layer holds the old configuration around the local domain
+    m_mc->communicate(true);
+    m_aabb_tree_old = m_mc->buildAABBTree();
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    std::shared_ptr<DomainDecomposition> decomposition = m_pdata->getDomainDecomposition();
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    const unsigned int n_ranks = m_exec_conf->getNRanks();
+    const unsigned int my_rank = m_exec_conf->getRank();
+    const unsigned int nptl = m_pdata->getN();
+    auto& params = m_mc->getParams();
+
+    if (this->m_prof)
+        m_prof->push(m_exec_conf, "Transform");
+
+    // send the transformed particles to the ranks of their new positions
+    std::vector<unsigned int> dest(nptl);
+    std::vector<unsigned int> tags(nptl);
+    std::vector<std::vector<detail::cluster_element> > send(n_ranks);
+        {
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_cart_ranks(decomposition->getCartRanks(), access_location::host, access_mode::read);
+
+        for (unsigned int i = 0; i < nptl; ++i)
+            {
+            detail::cluster_element p;
+            p.postype = h_postype.data[i];
+            p.orientation = h_orientation.data[i];
+            p.tag = h_tag.data[i];
+            int3 img = make_int3(0,0,0);
+            transformParticle(p.postype, p.orientation, img, q, pivot, line, box);
+
+            dest[i] = decomposition->placeParticle(box, make_scalar3(p.postype.x, p.postype.y, p.postype.z), h_cart_ranks.data);
+            tags[i] = p.tag;
+            send[dest[i]].push_back(p);
+            }
+        }
+
+    std::vector<std::vector<detail::cluster_element> > recv;
+    all_to_all_v(send, recv, mpi_comm);
+
+    if (m_prof) m_prof->pop(m_exec_conf);
+
+    if (m_prof)
+        m_prof->push(m_exec_conf,"Interactions");
+
+    // find the overlaps of the transformed particles with the old configuration
+    std::vector<uint2> edges;
+        {
+        auto& image_list = m_mc->updateImageList();
+        Index2D overlap_idx = m_mc->getOverlapIndexer();
+        ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(), access_location::host, access_mode::read);
+
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+        for (const std::vector<detail::cluster_element>& recv_rank : recv)
+            {
+            for (const detail::cluster_element& p : recv_rank)
+                {
+                unsigned int typ_i = __scalar_as_int(p.postype.w);
+                vec3<Scalar> pos_i_new(p.postype);
+                Shape shape_i(quat<Scalar>(p.orientation), params[typ_i]);
+                Scalar r_excl_i = shape_i.getCircumsphereDiameter()/Scalar(2.0);
+                hoomd::detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0,0,0));
+
+                const unsigned int n_images = (unsigned int) image_list.size();
+                for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+                    {
+                    vec3<Scalar> pos_i_image = pos_i_new + image_list[cur_image];
+
+                    hoomd::detail::AABB aabb_i_image = aabb_i_local;
+                    aabb_i_image.translate(pos_i_image);
+
+                    // stackless search
+                    for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree_old.getNumNodes(); cur_node_idx++)
+                        {
+                        if (detail::overlap(m_aabb_tree_old.getNodeAABB(cur_node_idx), aabb_i_image))
+                            {
+                            if (m_aabb_tree_old.isNodeLeaf(cur_node_idx))
+                                {
+                                for (unsigned int cur_p = 0; cur_p < m_aabb_tree_old.getNodeNumParticles(cur_node_idx); cur_p++)
+                                    {
+                                    unsigned int j = m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
+                                    unsigned int tag_j = h_tag.data[j];
+
+                                    if (p.tag == tag_j && cur_image == 0) continue;
+
+                                    vec3<Scalar> pos_j = vec3<Scalar>(h_postype.data[j]);
+                                    unsigned int typ_j = __scalar_as_int(h_postype.data[j].w);
+                                    Shape shape_j(quat<Scalar>(h_orientation.data[j]), params[typ_j]);
+
+                                    // put particles in coordinate system of particle i
+                                    vec3<Scalar> r_ij = pos_j - pos_i_image;
+
+                                    // check for circumsphere overlap
+                                    Scalar r_excl_j = shape_j.getCircumsphereDiameter()/Scalar(2.0);
+                                    Scalar RaRb = r_excl_i + r_excl_j;
+                                    Scalar rsq_ij = dot(r_ij, r_ij);
+
+                                    unsigned int err = 0;
+                                    if (rsq_ij <= RaRb*RaRb
+                                        && h_overlaps.data[overlap_idx(typ_i,typ_j)]
+                                        && test_overlap(r_ij, shape_i, shape_j, err))
+                                        {
+                                        edges.push_back(make_uint2(p.tag, tag_j));
+                                        }
+                                    } // end loop over AABB tree leaf
+                                } // end is leaf
+                            } // end if overlap
+                        else
+                            {
+                            // skip ahead
+                            cur_node_idx += m_aabb_tree_old.getNodeSkip(cur_node_idx);
+                            }
+                        } // end loop over nodes
+                    } // end loop over images
+                } // end loop over transformed particles
+            }
+        }
+
+    if (m_prof) m_prof->pop(m_exec_conf);
+
+    if (this->m_prof) this->m_prof->push("connected components");
+
+    // merge the overlapping pairs into clusters across ranks
+    std::vector<unsigned int> labels;
+    detail::connectedComponentsDistributed(m_G, edges, tags, labels, m_pdata->getMaximumTag(), mpi_comm);
+
+    if (this->m_prof) this->m_prof->pop();
+
+    if (this->m_prof) this->m_prof->push("flip");
+
+    // every cluster is counted by the rank that owns its smallest tag
+    unsigned long long int counts[2] = {0, nptl};
+    for (unsigned int i = 0; i < nptl; ++i)
+        if (labels[i] == tags[i])
+            counts[0]++;
+    MPI_Allreduce(MPI_IN_PLACE, counts, 2, MPI_UNSIGNED_LONG_LONG, MPI_SUM, mpi_comm);
+    m_count_total.n_clusters += counts[0];
+    m_count_total.n_particles_in_clusters += counts[1];
+
+    // flip the clusters, particles that leave the domain are removed and sent to their new rank
+    m_pdata->removeAllGhostParticles();
+        {
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_comm_flags(m_pdata->getCommFlags(), access_location::host, access_mode::overwrite);
+
+        uint16_t seed = this->m_sysdef->getSeed();
+
+        for (unsigned int i = 0; i < nptl; ++i)
+            {
+            hoomd::RandomGenerator rng_i(hoomd::Seed(hoomd::RNGIdentifier::UpdaterClusters2, timestep, seed),
+                                         hoomd::Counter(labels[i]));
+
+            bool flip = hoomd::detail::generate_canonical<float>(rng_i) <= m_flip_probability;
+
+            h_comm_flags.data[i] = 0;
+            if (flip)
+                {
+                transformParticle(h_postype.data[i], h_orientation.data[i], h_image.data[i], q, pivot, line, box);
+                h_comm_flags.data[i] = dest[i] != my_rank;
+                }
+            }
+        }
+
+    std::vector<detail::pdata_element> out;
+    std::vector<unsigned int> out_flags;
+    m_pdata->removeParticles(out, out_flags);
+
+    std::vector<std::vector<detail::pdata_element> > send_ptls(n_ranks);
+        {
+        ArrayHandle<unsigned int> h_cart_ranks(decomposition->getCartRanks(), access_location::host, access_mode::read);
+        for (const detail::pdata_element& p : out)
+            send_ptls[decomposition->placeParticle(box, make_scalar3(p.pos.x, p.pos.y, p.pos.z), h_cart_ranks.data)].push_back(p);
+        }
+
+    std::vector<std::vector<detail::pdata_element> > recv_ptls;
+    all_to_all_v(send_ptls, recv_ptls, mpi_comm);
+
+    std::vector<detail::pdata_element> in;
+    for (const std::vector<detail::pdata_element>& recv_rank : recv_ptls)
+        in.insert(in.end(), recv_rank.begin(), recv_rank.end());
+    m_pdata->addParticles(in);
+
+    // rebuild the ghost layer around the new configuration
+    m_mc->communicate(false);
+
+    if (this->m_prof) this->m_prof->pop();
+    }
+#endif
+
 /*! Perform a cluster move
     \param timestep Current time step of the simulation
 */
@@ -1559,10 +1827,6 @@ template< class Shape >
 void UpdaterClusters<Shape>::update(uint64_t timestep)
     {
     Updater::update(timestep);
-    #ifdef ENABLE_MPI
-    if (this->m_pdata->getDomainDecomposition())
-        throw std::runtime_error("UpdaterClusters does not work with spatial domain decomposition.");
-    #endif
 
     m_exec_conf->msg->notice(10) << timestep << " UpdaterClusters" << std::endl;
 
@@ -1631,6 +1895,15 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
         pivot.z = 0.0;
         }
 
+    #ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        updateDomainDecomposition(timestep, q, pivot, line);
+        if (m_prof) m_prof->pop(m_exec_conf);
+        return;
+        }
+    #endif
+
     // store backup of particle data
     backupState();
 
@@ -1640,7 +1913,10 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
     // signal that AABB tree is invalid
     m_mc->invalidateAABBTree();
 
-    // determine which particles interact
+    // reset the graph, every particle starts in its own cluster
+    m_G.resize(this->m_pdata->getN());
+
+    // determine which particles interact, overlapping pairs are added to the graph directly
     findInteractions(timestep, q, pivot, line);
 
     if (this->m_prof)
@@ -1648,49 +1924,11 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
 
     // fill in the cluster bonds, using bond formation probability defined in Liu and Luijten
 
-    if (m_prof)
-        m_prof->push("realloc");
-
-    // resize the number of graph nodes in place
-    m_G.resize(this->m_pdata->getN());
-
-    if (m_prof)
-        m_prof->pop();
-
-    if (m_prof)
-        m_prof->push("overlap");
-
-    #ifdef ENABLE_TBB_TASK
-    this->m_exec_conf->getTaskArena()->execute([&]{
-    tbb::parallel_for(m_overlap.range(), [&] (decltype(m_overlap.range()) r)
-    #else
-    auto &r = m_overlap;
-    #endif
-        {
-        for (auto it = r.begin(); it != r.end(); ++it)
-            {
-            unsigned int i = it->first;
-            unsigned int j = it->second;
-
-            // we're adding a directed edge, but the actual graph will be undirected
-            // if the symmetry operation is self-inverse
-            m_G.addEdge(i,j);
-            }
-        }
-    #ifdef ENABLE_TBB_TASK
-        );
-    }); // end task arena execute()
-    #endif
-
-    if (m_prof)
-        m_prof->pop();
-
-
     if (m_mc->getPatchEnergy())
         {
         // sum up interaction energies
-        #ifdef ENABLE_TBB_TASK
-        tbb::concurrent_unordered_map< std::pair<unsigned int, unsigned int>, float> delta_U;
+        #ifdef ENABLE_TBB
+        tbb::concurrent_unordered_map< std::pair<unsigned int, unsigned int>, float, detail::PairHash> delta_U;
         #else
         std::map< std::pair<unsigned int, unsigned int>, float> delta_U;
         #endif
@@ -1729,7 +1967,7 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
             delta_U[p] = delU;
             }
 
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
         this->m_exec_conf->getTaskArena()->execute([&]{
         tbb::parallel_for(delta_U.range(), [&] (decltype(delta_U.range()) r)
         #else
@@ -1754,7 +1992,7 @@ void UpdaterClusters<Shape>::update(uint64_t timestep)
                     }
                 }
             }
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
             );
         }); // end task arena execute()
         #endif
@@ -13,6 +13,7 @@
 #include <thrust/iterator/counting_iterator.h>
 #include <thrust/iterator/discard_iterator.h>
 #include <thrust/iterator/transform_iterator.h>
+#include <thrust/sequence.h>
 #include <thrust/unique.h>
 
 #ifdef __HIP_PLATFORM_NVCC__
@@ -177,8 +178,118 @@ __global__ void flip_clusters(Scalar4* d_postype,
         }
     }
 
+//! Point every vertex directly at the root of its tree
+/*! \param d_parent Union-find parents
+    \param N Number of vertices
+
+    Must run after all merges have completed.
+*/
+__global__ void flatten_union_find(int* d_parent, const unsigned int N)
+    {
+    unsigned int i = threadIdx.x + blockIdx.x * blockDim.x;
+
+    if (i >= N)
+        return;
+
+    d_parent[i] = union_find_root(d_parent, i);
+    }
+
     } // end namespace kernel
 
+//! Relabel the components with contiguous indices in [0, num_components)
+/*! \param d_components Component label (an arbitrary vertex index) of every vertex
+    \param d_work Temporary storage of N ints
+    \param N Number of vertices
+    \param num_components Number of distinct components (output)
+    \param alloc Caching allocator for temporary storage
+*/
+static void relabel_components(int* d_components,
+                               int* d_work,
+                               const unsigned int N,
+                               unsigned int& num_components,
+                               CachedAllocator& alloc)
+    {
+    thrust::device_ptr<int> components(d_components);
+    thrust::device_ptr<int> work(d_work);
+
+#ifdef __HIP_PLATFORM_HCC__
+    thrust::copy(thrust::hip::par(alloc), components, components + N, work);
+    thrust::sort(thrust::hip::par(alloc), work, work + N);
+#else
+    thrust::copy(thrust::cuda::par(alloc), components, components + N, work);
+    thrust::sort(thrust::cuda::par(alloc), work, work + N);
+#endif
+
+    int* d_unique = alloc.getTemporaryBuffer<int>(N);
+    thrust::device_ptr<int> unique(d_unique);
+
+#ifdef __HIP_PLATFORM_HCC__
+    auto it = thrust::reduce_by_key(thrust::hip::par(alloc),
+#else
+    auto it = thrust::reduce_by_key(thrust::cuda::par(alloc),
+#endif
+                                    work,
+                                    work + N,
+                                    thrust::constant_iterator<int>(1),
+                                    unique,
+                                    thrust::discard_iterator<int>());
+
+    num_components = static_cast<unsigned int>(it.first - unique);
+
+    // make contiguous
+#ifdef __HIP_PLATFORM_HCC__
+    thrust::lower_bound(thrust::hip::par(alloc),
+#else
+    thrust::lower_bound(thrust::cuda::par(alloc),
+#endif
+                        unique,
+                        unique + num_components,
+                        components,
+                        components + N,
+                        components);
+
+    alloc.deallocate((char*)d_unique);
+    }
+
+/*! \param d_parent Union-find parents (output)
+    \param N Number of vertices
+
+    Every vertex starts as the root of its own tree.
+*/
+void init_union_find(int* d_parent, const unsigned int N)
+    {
+    thrust::device_ptr<int> parent(d_parent);
+    thrust::sequence(parent, parent + N);
+    }
+
+/*! \param d_parent Union-find parents on input, contiguous component labels on output
+    \param N Number of vertices
+    \param num_components Number of connected components (output)
+    \param alloc Caching allocator for temporary storage
+*/
+void finalize_union_find(int* d_parent,
+                         const unsigned int N,
+                         unsigned int& num_components,
+                         CachedAllocator& alloc)
+    {
+    num_components = 0;
+    if (N == 0)
+        return;
+
+    const unsigned int block_size = 256;
+    hipLaunchKernelGGL(kernel::flatten_union_find,
+                       dim3(N / block_size + 1),
+                       dim3(block_size),
+                       0,
+                       0,
+                       d_parent,
+                       N);
+
+    int* d_work = alloc.getTemporaryBuffer<int>(N);
+    relabel_components(d_parent, d_work, N, num_components, alloc);
+    alloc.deallocate((char*)d_work);
+    }
+
 void concatenate_adjacency_list(const unsigned int* d_adjacency,
                                 const unsigned int* d_nneigh,
                                 const unsigned int* d_nneigh_scan,
@@ -327,38 +438,13 @@ void connected_components(uint2* d_adj,
     ecl_connected_components(nverts, nnz, d_csr_rowptr, d_colidx, d_components, d_work, dev_prop);
 
     // reuse work array
-    thrust::device_ptr<int> components(d_components);
-    thrust::device_ptr<int> work(d_work);
-
-    thrust::copy(thrust::cuda::par(alloc), components, components + nverts, work);
-    thrust::sort(thrust::cuda::par(alloc), work, work + nverts);
-
-    int* d_unique = alloc.getTemporaryBuffer<int>(nverts);
-    thrust::device_ptr<int> unique(d_unique);
-
-    auto it = thrust::reduce_by_key(thrust::cuda::par(alloc),
-                                    work,
-                                    work + nverts,
-                                    thrust::constant_iterator<int>(1),
-                                    unique,
-                                    thrust::discard_iterator<int>());
-
-    num_components = static_cast<unsigned int>(it.first - unique);
-
-    // make contiguous
-    thrust::lower_bound(thrust::cuda::par(alloc),
-                        unique,
-                        unique + num_components,
-                        components,
-                        components + nverts,
-                        components);
+    relabel_components(d_components, d_work, nverts, num_components, alloc);
 
     // free temporary storage
     alloc.deallocate((char*)d_rowidx);
     alloc.deallocate((char*)d_colidx);
     alloc.deallocate((char*)d_csr_rowptr);
     alloc.deallocate((char*)d_work);
-    alloc.deallocate((char*)d_unique);
 
     // clean cusparse
     cusparseDestroy(handle);
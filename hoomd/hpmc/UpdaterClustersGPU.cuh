@@ -72,7 +72,8 @@ struct cluster_args_t
                    const bool _update_shape_param,
                    const hipDeviceProp_t& _devprop,
                    const GPUPartition& _gpu_partition,
-                   const hipStream_t* _streams)
+                   const hipStream_t* _streams,
+                   int* _d_parent = nullptr)
         : d_postype(_d_postype), d_orientation(_d_orientation), ci(_ci), cell_dim(_cell_dim),
           ghost_width(_ghost_width), N(_N), num_types(_num_types), seed(_seed),
           d_check_overlaps(_check_overlaps), overlap_idx(_overlap_idx), timestep(_timestep),
@@ -81,7 +82,8 @@ struct cluster_args_t
           d_excell_idx(_d_excell_idx), d_excell_size(_d_excell_size), excli(_excli),
           d_adjacency(_d_adjacency), d_nneigh(_d_nneigh), maxn(_maxn), d_overflow(_d_overflow),
           dim(_dim), line(_line), pivot(_pivot), q(_q), update_shape_param(_update_shape_param),
-          devprop(_devprop), gpu_partition(_gpu_partition), streams(_streams) {};
+          devprop(_devprop), gpu_partition(_gpu_partition), streams(_streams),
+          d_parent(_d_parent) {};
 
     const Scalar4* d_postype;             //!< postype array
     const Scalar4* d_orientation;         //!< orientation array
@@ -115,6 +117,7 @@ struct cluster_args_t
     const hipDeviceProp_t& devprop;       //!< CUDA device properties
     const GPUPartition& gpu_partition;    //!< Multi-GPU partition
     const hipStream_t* streams;           //!< kernel streams
+    int* d_parent;                        //!< Union-find parents, or NULL to fill d_adjacency
     };
 
 void connected_components(uint2* d_adj,
@@ -125,6 +128,13 @@ void connected_components(uint2* d_adj,
                           const hipDeviceProp_t& dev_prop,
                           CachedAllocator& alloc);
 
+void init_union_find(int* d_parent, const unsigned int N);
+
+void finalize_union_find(int* d_parent,
+                         const unsigned int N,
+                         unsigned int& num_components,
+                         CachedAllocator& alloc);
+
 void get_num_neighbors(const unsigned int* d_nneigh,
                        unsigned int* d_nneigh_scan,
                        unsigned int& nneigh_total,
@@ -196,6 +206,61 @@ void hpmc_cluster_overlaps(const cluster_args_t& args, const typename Shape::par
 #ifdef __HIPCC__
 namespace kernel
     {
+//! Find the root of the tree that contains v
+/*! \param d_parent Union-find parents, with d_parent[v] <= v
+    \param v Vertex to look up
+
+    Compresses the path by pointing every vertex visited at its grandparent, as in ECL-CC.
+    Concurrent calls are safe because parents only ever decrease.
+*/
+__device__ inline int union_find_root(int* d_parent, int v)
+    {
+    int curr = d_parent[v];
+    if (curr != v)
+        {
+        int next;
+        int prev = v;
+        while (curr > (next = d_parent[curr]))
+            {
+            d_parent[prev] = next;
+            prev = curr;
+            curr = next;
+            }
+        }
+    return curr;
+    }
+
+//! Merge the trees that contain u and v
+/*! \param d_parent Union-find parents, with d_parent[v] <= v
+    \param u First vertex
+    \param v Second vertex
+
+    Hooks the larger root under the smaller one with an atomic compare and swap, and retries
+    from the new parent when another thread hooked the root first.
+*/
+__device__ inline void union_find_merge(int* d_parent, int u, int v)
+    {
+    int u_root = union_find_root(d_parent, u);
+    int v_root = union_find_root(d_parent, v);
+    while (u_root != v_root)
+        {
+        if (u_root < v_root)
+            {
+            int ret = atomicCAS(&d_parent[v_root], v_root, u_root);
+            if (ret == v_root)
+                break;
+            v_root = ret;
+            }
+        else
+            {
+            int ret = atomicCAS(&d_parent[u_root], u_root, v_root);
+            if (ret == u_root)
+                break;
+            u_root = ret;
+            }
+        }
+    }
+
 //! Check narrow-phase overlaps
 template<class Shape, unsigned int max_threads>
 #ifdef __HIP_PLATFORM_NVCC__
@@ -212,6 +277,7 @@ __launch_bounds__(max_threads)
                                           unsigned int* d_nneigh,
                                           const unsigned int maxn,
                                           unsigned int* d_overflow,
+                                          int* d_parent,
                                           const unsigned int num_types,
                                           const BoxDim box,
                                           const Scalar3 ghost_width,
@@ -441,11 +507,19 @@ __launch_bounds__(max_threads)
             if (s_check_overlaps[overlap_idx(type_i, type_j)]
                 && test_overlap(r_ij, shape_i, shape_j, overlap_err_count))
                 {
-                // write out to global memory
-                unsigned int n = atomicAdd(&d_nneigh[s_idx_group[check_group]], 1);
-                if (n < maxn)
+                if (d_parent)
+                    {
+                    // join the clusters without storing the edge
+                    union_find_merge(d_parent, s_idx_group[check_group], check_j);
+                    }
+                else
                     {
-                    d_adjacency[n + s_idx_group[check_group] * maxn] = check_j;
+                    // write out to global memory
+                    unsigned int n = atomicAdd(&d_nneigh[s_idx_group[check_group]], 1);
+                    if (n < maxn)
+                        {
+                        d_adjacency[n + s_idx_group[check_group] * maxn] = check_j;
+                        }
                     }
                 }
             }
@@ -461,7 +535,7 @@ __launch_bounds__(max_threads)
         __syncthreads();
         } // end while (s_still_searching)
 
-    if (active && master)
+    if (active && master && !d_parent)
         {
         // overflowed?
         unsigned int nneigh = d_nneigh[idx];
@@ -594,6 +668,7 @@ void cluster_overlaps_launcher(const cluster_args_t& args,
                 args.d_nneigh,
                 args.maxn,
                 args.d_overflow,
+                args.d_parent,
                 args.num_types,
                 args.box,
                 args.ghost_width,
@@ -135,6 +135,14 @@ template<class Shape> class UpdaterClustersGPU : public UpdaterClusters<Shape>
 
     //! Check if memory reallocation for the adjacency list is necessary
     virtual bool checkReallocate();
+
+    //! Return true if overlaps are merged into the clusters without an adjacency list
+    /*! The union-find merges use device atomics, which are only used on a single GPU.
+     */
+    bool useUnionFind()
+        {
+        return this->m_exec_conf->getNumActiveGPUs() == 1;
+        }
     };
 
 template<class Shape>
@@ -430,6 +438,27 @@ template<class Shape> void UpdaterClustersGPU<Shape>::connectedComponents()
     // this will contain the number of strongly connected components
     unsigned int num_components = 0;
 
+    if (useUnionFind())
+        {
+        // the overlap kernels already merged the clusters
+        ArrayHandle<int> d_components(m_components,
+                                      access_location::device,
+                                      access_mode::readwrite);
+        gpu::finalize_union_find(d_components.data,
+                                 this->m_pdata->getN(),
+                                 num_components,
+                                 this->m_exec_conf->getCachedAllocator());
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+
+        this->m_count_total.n_particles_in_clusters += this->m_pdata->getN();
+        this->m_count_total.n_clusters += num_components;
+
+        if (this->m_prof)
+            this->m_prof->pop(this->m_exec_conf);
+        return;
+        }
+
     m_components.resize(this->m_pdata->getN());
 
     // access edges of adajacency matrix
@@ -802,6 +831,10 @@ void UpdaterClustersGPU<Shape>::findInteractions(uint64_t timestep,
 
         bool reallocate = false;
 
+        // merge overlapping pairs directly into the clusters, instead of storing them
+        bool union_find = useUnionFind();
+        m_components.resize(this->m_pdata->getN());
+
         // allocate memory for number of neighbors
         size_t old_size = m_nneigh.size();
         m_nneigh.resize(this->m_pdata->getN());
@@ -858,6 +891,16 @@ void UpdaterClustersGPU<Shape>::findInteractions(uint64_t timestep,
                                                      access_location::device,
                                                      access_mode::readwrite);
 
+                ArrayHandle<int> d_components(m_components,
+                                              access_location::device,
+                                              access_mode::overwrite);
+                if (union_find)
+                    {
+                    gpu::init_union_find(d_components.data, this->m_pdata->getN());
+                    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                        CHECK_CUDA_ERROR();
+                    }
+
                 // fill the parameter structure for the GPU kernel
                 gpu::cluster_args_t args(d_postype_backup.data,
                                          d_orientation_backup.data,
@@ -890,7 +933,8 @@ void UpdaterClustersGPU<Shape>::findInteractions(uint64_t timestep,
                                          true,
                                          this->m_exec_conf->dev_prop,
                                          m_old_gpu_partition,
-                                         &m_overlaps_streams.front());
+                                         &m_overlaps_streams.front(),
+                                         union_find ? d_components.data : nullptr);
 
                 this->m_exec_conf->beginMultiGPU();
 
@@ -1004,7 +1048,7 @@ void UpdaterClustersGPU<Shape>::findInteractions(uint64_t timestep,
                 this->m_exec_conf->endMultiGPU();
                 } // end ArrayHandle scope
 
-            reallocate = checkReallocate();
+            reallocate = !union_find && checkReallocate();
             } while (reallocate);
         }
 
@@ -76,6 +76,7 @@ __launch_bounds__(max_threads)
                                                unsigned int* d_adjacency,
                                                const unsigned int maxn,
                                                unsigned int* d_overflow,
+                                               int* d_parent,
                                                unsigned int work_offset,
                                                unsigned int max_depletant_queue_size,
                                                const unsigned int* d_n_depletants)
@@ -752,11 +753,19 @@ __launch_bounds__(max_threads)
                 if (s_check_overlaps[overlap_idx(depletant_type, type_j)]
                     && test_overlap(r_jk, shape_test, shape_j, err_count))
                     {
-                    // write out to global memory
-                    unsigned int n = atomicAdd(&d_nneigh[i], 1);
-                    if (n < maxn)
+                    if (d_parent)
                         {
-                        d_adjacency[n + i * maxn] = check_j;
+                        // join the clusters without storing the edge
+                        union_find_merge(d_parent, i, check_j);
+                        }
+                    else
+                        {
+                        // write out to global memory
+                        unsigned int n = atomicAdd(&d_nneigh[i], 1);
+                        if (n < maxn)
+                            {
+                            d_adjacency[n + i * maxn] = check_j;
+                            }
                         }
                     }
                 } // end if (processing neighbor)
@@ -779,7 +788,7 @@ __launch_bounds__(max_threads)
         __syncthreads();
         } // end loop over depletants
 
-    if (master && group == 0)
+    if (master && group == 0 && !d_parent)
         {
         // overflowed?
         unsigned int nneigh = d_nneigh[i];
@@ -931,6 +940,7 @@ void clusters_depletants_launcher(const cluster_args_t& args,
                 args.d_adjacency,
                 args.maxn,
                 args.d_overflow,
+                args.d_parent,
                 range.first,
                 max_depletant_queue_size,
                 implicit_args.d_n_depletants);
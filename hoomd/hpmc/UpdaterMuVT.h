@@ -10,6 +10,13 @@
 #include "Moves.h"
 #include "hoomd/RandomNumbers.h"
 
+#include <limits>
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -143,6 +150,22 @@ template<class Shape> class UpdaterMuVT : public Updater
         return m_n_trial;
         }
 
+    //! Set the number of trial positions per particle insertion or removal
+    void setNTrialInsert(unsigned int n_trial_insert)
+        {
+        if (n_trial_insert == 0)
+            {
+            throw std::runtime_error("ntrial_insert must be at least 1.");
+            }
+        m_n_trial_insert = n_trial_insert;
+        }
+
+    //! Get the number of trial positions per particle insertion or removal
+    unsigned int getNTrialInsert()
+        {
+        return m_n_trial_insert;
+        }
+
     //! Get the current counter values
     hpmc_muvt_counters_t getCounters(unsigned int mode = 0);
 
@@ -174,6 +197,7 @@ template<class Shape> class UpdaterMuVT : public Updater
     GPUVector<Scalar> m_diameter_backup;     //!< Backup of particle diameters for volume move
 
     unsigned int m_n_trial;
+    unsigned int m_n_trial_insert; //!< Number of trial positions per insertion or removal
 
     /*! Check for overlaps of a fictitious particle
      * \param timestep Current time step
@@ -197,6 +221,67 @@ template<class Shape> class UpdaterMuVT : public Updater
      */
     virtual bool tryRemoveParticle(uint64_t timestep, unsigned int tag, Scalar& lnboltzmann);
 
+    /*! Compute the Boltzmann weights of several trial insertions in one pass
+        \param timestep Current time step
+        \param type Type of particle to test
+        \param pos Positions of the trial particles
+        \param orientation Orientations of the trial particles
+        \param ignore_tag Tag of a particle to leave out of the checks (UINT_MAX for none)
+        \param lnboltzmann Log of Boltzmann weight of every trial (return value)
+        \param overlap Nonzero for trials with an overlap (return value)
+
+        The trials are evaluated in parallel with TBB and combined in one MPI reduction.
+        Depletants are not included.
+     */
+    virtual void tryInsertParticles(uint64_t timestep,
+                                    unsigned int type,
+                                    const std::vector<vec3<Scalar>>& pos,
+                                    const std::vector<quat<Scalar>>& orientation,
+                                    unsigned int ignore_tag,
+                                    std::vector<Scalar>& lnboltzmann,
+                                    std::vector<unsigned int>& overlap);
+
+    /*! Check a fictitious particle for overlaps with the local particles
+        \param type Type of particle to test
+        \param pos Position of fictitious particle
+        \param orientation Orientation of particle
+        \param ignore_tag Tag of a particle to leave out of the checks (UINT_MAX for none)
+        \param aabb_tree AABB tree of the particles, nullptr if there are no particles
+        \param image_list List of periodic images
+        \param lnboltzmann Log of Boltzmann weight is decremented by the patch energy
+        \returns True if the particle overlaps
+
+        The particle data arrays are passed in by the caller, so this method can be called
+        concurrently.
+     */
+    bool checkInsertionOverlaps(unsigned int type,
+                                const vec3<Scalar>& pos,
+                                const quat<Scalar>& orientation,
+                                unsigned int ignore_tag,
+                                const hoomd::detail::AABBTree* aabb_tree,
+                                const std::vector<vec3<Scalar>>& image_list,
+                                const Scalar4* h_postype,
+                                const Scalar4* h_orientation,
+                                const Scalar* h_diameter,
+                                const Scalar* h_charge,
+                                const unsigned int* h_tag,
+                                const unsigned int* h_overlaps,
+                                Scalar& lnboltzmann);
+
+    /*! Log of the summed Boltzmann weights of a set of trials (the Rosenbluth weight)
+        \param lnboltzmann Log of the Boltzmann weight of every trial
+        \param overlap Nonzero for trials with zero weight
+        \returns The log of the sum, -infinity if all weights are zero
+     */
+    Scalar computeRosenbluthWeight(const std::vector<Scalar>& lnboltzmann,
+                                   const std::vector<unsigned int>& overlap);
+
+    //! Propose a uniformly distributed position and orientation for an inserted particle
+    void generateTrialInsertion(hoomd::RandomGenerator& rng,
+                                unsigned int type,
+                                vec3<Scalar>& pos,
+                                quat<Scalar>& orientation);
+
     /*! Rescale box to new dimensions and scale particles
      * \param timestep current timestep
      * \param new_box the old BoxDim
@@ -329,7 +414,8 @@ UpdaterMuVT<Shape>::UpdaterMuVT(std::shared_ptr<SystemDefinition> sysdef,
                                 std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
                                 unsigned int npartition)
     : Updater(sysdef), m_mc(mc), m_npartition(npartition), m_gibbs(false), m_max_vol_rescale(0.1),
-      m_volume_move_probability(0.5), m_gibbs_other(0), m_n_trial(1)
+      m_volume_move_probability(0.5), m_gibbs_other(0), m_n_trial(1),
+      m_n_trial_insert(1)
     {
     m_fugacity.resize(m_pdata->getNTypes(), std::shared_ptr<Variant>(new VariantConstant(0.0)));
     m_type_map.resize(m_pdata->getNTypes());
@@ -874,13 +960,26 @@ template<class Shape> void UpdaterMuVT<Shape>::update(uint64_t timestep)
     {
     Updater::update(timestep);
     m_count_step_start = m_count_total;
-    unsigned int ndim = this->m_sysdef->getNDimensions();
 
     if (m_prof)
         m_prof->push("update muVT");
 
     m_exec_conf->msg->notice(10) << "UpdaterMuVT update: " << timestep << std::endl;
 
+    if (m_n_trial_insert > 1)
+        {
+        if (m_gibbs)
+            {
+            throw std::runtime_error("ntrial_insert > 1 is not supported in Gibbs ensembles.");
+            }
+
+        for (unsigned int type_d = 0; type_d < m_pdata->getNTypes(); ++type_d)
+            {
+            if (m_mc->getDepletantFugacity(type_d, type_d) != 0.0)
+                throw std::runtime_error("ntrial_insert > 1 is not supported with depletants.");
+            }
+        }
+
     // initialize random number generator
     unsigned int group = (m_exec_conf->getPartition() / m_npartition);
 
@@ -1061,26 +1160,11 @@ template<class Shape> void UpdaterMuVT<Shape>::update(uint64_t timestep)
                     = m_mc->getParams();
                 const typename Shape::param_type& param = params[type];
 
-                // Propose a random position uniformly in the box
-                Scalar3 f;
-                f.x = hoomd::detail::generate_canonical<Scalar>(rng);
-                f.y = hoomd::detail::generate_canonical<Scalar>(rng);
-                if (m_sysdef->getNDimensions() == 2)
-                    {
-                    f.z = Scalar(0.5);
-                    }
-                else
-                    {
-                    f.z = hoomd::detail::generate_canonical<Scalar>(rng);
-                    }
-                vec3<Scalar> pos_test = vec3<Scalar>(m_pdata->getGlobalBox().makeCoordinates(f));
-
-                Shape shape_test(quat<Scalar>(), param);
-                if (shape_test.hasOrientation())
-                    {
-                    // set particle orientation
-                    shape_test.orientation = generateRandomOrientation(rng, ndim);
-                    }
+                // Propose a random position and orientation
+                vec3<Scalar> pos_test;
+                quat<Scalar> orientation_test;
+                generateTrialInsertion(rng, type, pos_test, orientation_test);
+                Shape shape_test(orientation_test, param);
 
                 if (m_gibbs)
                     {
@@ -1106,8 +1190,59 @@ template<class Shape> void UpdaterMuVT<Shape>::update(uint64_t timestep)
 
                 // check if particle can be inserted without overlaps
                 Scalar lnb(0.0);
-                unsigned int nonzero
-                    = tryInsertParticle(timestep, type, pos_test, shape_test.orientation, lnb);
+                unsigned int nonzero;
+                if (m_n_trial_insert > 1)
+                    {
+                    // configurational bias: weigh all trial positions and pick one of them
+                    std::vector<vec3<Scalar>> pos_trial(m_n_trial_insert);
+                    std::vector<quat<Scalar>> orientation_trial(m_n_trial_insert);
+                    pos_trial[0] = pos_test;
+                    orientation_trial[0] = orientation_test;
+                    for (unsigned int i = 1; i < m_n_trial_insert; ++i)
+                        {
+                        generateTrialInsertion(rng, type, pos_trial[i], orientation_trial[i]);
+                        }
+
+                    std::vector<Scalar> lnb_trial;
+                    std::vector<unsigned int> overlap_trial;
+                    tryInsertParticles(timestep,
+                                       type,
+                                       pos_trial,
+                                       orientation_trial,
+                                       UINT_MAX,
+                                       lnb_trial,
+                                       overlap_trial);
+
+                    Scalar lnb_sum = computeRosenbluthWeight(lnb_trial, overlap_trial);
+                    nonzero = lnb_sum > -std::numeric_limits<Scalar>::infinity();
+                    if (nonzero)
+                        {
+                        // choose a trial with probability proportional to its Boltzmann weight
+                        Scalar u = hoomd::detail::generate_canonical<Scalar>(rng);
+                        Scalar cumulative(0.0);
+                        unsigned int chosen = 0;
+                        for (unsigned int i = 0; i < m_n_trial_insert; ++i)
+                            {
+                            if (overlap_trial[i])
+                                continue;
+
+                            chosen = i;
+                            cumulative += exp(lnb_trial[i] - lnb_sum);
+                            if (u < cumulative)
+                                break;
+                            }
+                        pos_test = pos_trial[chosen];
+                        shape_test.orientation = orientation_trial[chosen];
+
+                        // the acceptance probability includes the mean weight of the trials
+                        lnb = lnb_sum - log(Scalar(m_n_trial_insert));
+                        }
+                    }
+                else
+                    {
+                    nonzero
+                        = tryInsertParticle(timestep, type, pos_test, shape_test.orientation, lnb);
+                    }
 
                 if (nonzero)
                     {
@@ -1179,6 +1314,9 @@ template<class Shape> void UpdaterMuVT<Shape>::update(uint64_t timestep)
                     {
                     // insertion was successful
 
+                    // rebuild groups and exclusions once the particle is fully placed
+                    m_pdata->beginParticleNumberBatch();
+
                     // create a new particle with given type
                     unsigned int tag;
 
@@ -1195,6 +1333,8 @@ template<class Shape> void UpdaterMuVT<Shape>::update(uint64_t timestep)
                         {
                         m_pdata->setOrientation(tag, quat_to_scalar4(shape_test.orientation));
                         }
+
+                    m_pdata->endParticleNumberBatch();
                     m_count_total.insert_accept_count++;
                     }
                 else
@@ -1292,6 +1432,34 @@ template<class Shape> void UpdaterMuVT<Shape>::update(uint64_t timestep)
             Scalar lnb(0.0);
             if (tryRemoveParticle(timestep, tag, lnb))
                 {
+                if (m_n_trial_insert > 1)
+                    {
+                    // configurational bias: the Rosenbluth weight of the old configuration
+                    // combines the removed particle with trial insertions into the system
+                    // without it
+                    std::vector<vec3<Scalar>> pos_trial(m_n_trial_insert - 1);
+                    std::vector<quat<Scalar>> orientation_trial(m_n_trial_insert - 1);
+                    for (unsigned int i = 0; i < m_n_trial_insert - 1; ++i)
+                        {
+                        generateTrialInsertion(rng_local, type, pos_trial[i], orientation_trial[i]);
+                        }
+
+                    std::vector<Scalar> lnb_trial;
+                    std::vector<unsigned int> overlap_trial;
+                    tryInsertParticles(timestep,
+                                       type,
+                                       pos_trial,
+                                       orientation_trial,
+                                       tag,
+                                       lnb_trial,
+                                       overlap_trial);
+
+                    // the Boltzmann weight of the removed particle is exp(-lnb)
+                    lnb_trial.push_back(-lnb);
+                    overlap_trial.push_back(0);
+                    lnb = log(Scalar(m_n_trial_insert))
+                          - computeRosenbluthWeight(lnb_trial, overlap_trial);
+                    }
                 lnboltzmann += lnb;
                 }
             else
@@ -1930,9 +2098,6 @@ bool UpdaterMuVT<Shape>::tryInsertParticle(uint64_t timestep,
                                            quat<Scalar> orientation,
                                            Scalar& lnboltzmann)
     {
-    // do we have to compute energetic contribution?
-    auto patch = m_mc->getPatchEnergy();
-
     lnboltzmann = Scalar(0.0);
 
     unsigned int overlap = 0;
@@ -1958,183 +2123,46 @@ bool UpdaterMuVT<Shape>::tryInsertParticle(uint64_t timestep,
     if (is_local)
         {
         // get some data structures from the integrator
-        auto& image_list = m_mc->updateImageList();
-        const unsigned int n_images = (unsigned int)image_list.size();
-        auto& params = m_mc->getParams();
-
-        const Index2D& overlap_idx = m_mc->getOverlapIndexer();
-
-        OverlapReal r_cut_patch(0.0);
-        Scalar r_cut_self(0.0);
-
-        if (patch)
-            {
-            r_cut_patch = OverlapReal(patch->getRCut() + 0.5 * patch->getAdditiveCutoff(type));
-            r_cut_self = r_cut_patch + 0.5 * patch->getAdditiveCutoff(type);
-            }
-
-        unsigned int err_count = 0;
-
-            {
-            // check for overlaps
-            ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
-                                           access_location::host,
-                                           access_mode::read);
-            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                               access_location::host,
-                                               access_mode::read);
-            ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
-                                           access_location::host,
-                                           access_mode::read);
-            ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
-                                         access_location::host,
-                                         access_mode::read);
-
-            ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(),
-                                                 access_location::host,
-                                                 access_mode::read);
-
-            // read in the current position and orientation
-            Shape shape(orientation, params[type]);
-
-            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
-                {
-                vec3<Scalar> pos_image = pos + image_list[cur_image];
-
-                if (cur_image != 0)
-                    {
-                    // check for self-overlap with all images except the original
-                    vec3<Scalar> r_ij = pos - pos_image;
-                    if (h_overlaps.data[overlap_idx(type, type)]
-                        && check_circumsphere_overlap(r_ij, shape, shape)
-                        && test_overlap(r_ij, shape, shape, err_count))
-                        {
-                        overlap = 1;
-                        break;
-                        }
-
-                    // self-energy
-                    if (patch && dot(r_ij, r_ij) <= r_cut_self * r_cut_self)
-                        {
-                        lnboltzmann -= patch->energy(r_ij,
-                                                     type,
-                                                     quat<float>(orientation),
-                                                     1.0, // diameter i
-                                                     0.0, // charge i
-                                                     type,
-                                                     quat<float>(orientation),
-                                                     1.0, // diameter i
-                                                     0.0  // charge i
-                        );
-                        }
-                    }
-                }
-            }
+        const std::vector<vec3<Scalar>>& image_list = m_mc->updateImageList();
 
         // we cannot rely on a valid AABB tree when there are 0 particles
-        if (!overlap && nptl_local > 0)
-            {
-            // Check particle against AABB tree for neighbors
-            const hoomd::detail::AABBTree& aabb_tree = m_mc->buildAABBTree();
+        const hoomd::detail::AABBTree* aabb_tree = nullptr;
+        if (nptl_local > 0)
+            aabb_tree = &m_mc->buildAABBTree();
 
-            ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
-                                           access_location::host,
-                                           access_mode::read);
-            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                               access_location::host,
-                                               access_mode::read);
-            ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
                                            access_location::host,
                                            access_mode::read);
-            ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
-                                         access_location::host,
-                                         access_mode::read);
-            ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(),
-                                                 access_location::host,
-                                                 access_mode::read);
-
-            Shape shape(orientation, params[type]);
-            OverlapReal R_query
-                = std::max(shape.getCircumsphereDiameter() / OverlapReal(2.0),
-                           r_cut_patch - m_mc->getMinCoreDiameter() / (OverlapReal)2.0);
-            hoomd::detail::AABB aabb_local = hoomd::detail::AABB(vec3<Scalar>(0, 0, 0), R_query);
-
-            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
-                {
-                vec3<Scalar> pos_image = pos + image_list[cur_image];
-
-                hoomd::detail::AABB aabb = aabb_local;
-                aabb.translate(pos_image);
-
-                // stackless search
-                for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree.getNumNodes();
-                     cur_node_idx++)
-                    {
-                    if (detail::overlap(aabb_tree.getNodeAABB(cur_node_idx), aabb))
-                        {
-                        if (aabb_tree.isNodeLeaf(cur_node_idx))
-                            {
-                            for (unsigned int cur_p = 0;
-                                 cur_p < aabb_tree.getNodeNumParticles(cur_node_idx);
-                                 cur_p++)
-                                {
-                                // read in its position and orientation
-                                unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
-
-                                Scalar4 postype_j = h_postype.data[j];
-                                Scalar4 orientation_j = h_orientation.data[j];
-
-                                // put particles in coordinate system of particle i
-                                vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_image;
-
-                                unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                Shape shape_j(quat<Scalar>(orientation_j), params[typ_j]);
-
-                                Scalar r_cut_ij(0.0);
-                                if (patch)
-                                    r_cut_ij = r_cut_patch + 0.5 * patch->getAdditiveCutoff(typ_j);
-
-                                if (h_overlaps.data[overlap_idx(type, typ_j)]
-                                    && check_circumsphere_overlap(r_ij, shape, shape_j)
-                                    && test_overlap(r_ij, shape, shape_j, err_count))
-                                    {
-                                    overlap = 1;
-                                    break;
-                                    }
-                                else if (patch && dot(r_ij, r_ij) <= r_cut_ij * r_cut_ij)
-                                    {
-                                    lnboltzmann -= patch->energy(r_ij,
-                                                                 type,
-                                                                 quat<float>(orientation),
-                                                                 float(1.0), // diameter i
-                                                                 float(0.0), // charge i
-                                                                 typ_j,
-                                                                 quat<float>(orientation_j),
-                                                                 float(h_diameter.data[j]),
-                                                                 float(h_charge.data[j]));
-                                    }
-                                }
-                            }
-                        }
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
-                        }
-
-                    if (overlap)
-                        {
-                        break;
-                        }
-                    } // end loop over AABB nodes
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(),
+                                             access_location::host,
+                                             access_mode::read);
 
-                if (overlap)
-                    {
-                    break;
-                    }
-                } // end loop over images
-            }     // end if nptl_local > 0
-        }         // end if local
+        overlap = checkInsertionOverlaps(type,
+                                         pos,
+                                         orientation,
+                                         UINT_MAX,
+                                         aabb_tree,
+                                         image_list,
+                                         h_postype.data,
+                                         h_orientation.data,
+                                         h_diameter.data,
+                                         h_charge.data,
+                                         h_tag.data,
+                                         h_overlaps.data,
+                                         lnboltzmann);
+        } // end if local
 
 #ifdef ENABLE_MPI
     if (m_sysdef->isDomainDecomposed())
@@ -2294,6 +2322,318 @@ bool UpdaterMuVT<Shape>::tryInsertParticle(uint64_t timestep,
     return nonzero;
     }
 
+template<class Shape>
+bool UpdaterMuVT<Shape>::checkInsertionOverlaps(unsigned int type,
+                                                const vec3<Scalar>& pos,
+                                                const quat<Scalar>& orientation,
+                                                unsigned int ignore_tag,
+                                                const hoomd::detail::AABBTree* aabb_tree,
+                                                const std::vector<vec3<Scalar>>& image_list,
+                                                const Scalar4* h_postype,
+                                                const Scalar4* h_orientation,
+                                                const Scalar* h_diameter,
+                                                const Scalar* h_charge,
+                                                const unsigned int* h_tag,
+                                                const unsigned int* h_overlaps,
+                                                Scalar& lnboltzmann)
+    {
+    // do we have to compute energetic contribution?
+    auto patch = m_mc->getPatchEnergy();
+
+    auto& params = m_mc->getParams();
+    const Index2D& overlap_idx = m_mc->getOverlapIndexer();
+    const unsigned int n_images = (unsigned int)image_list.size();
+
+    OverlapReal r_cut_patch(0.0);
+    Scalar r_cut_self(0.0);
+
+    if (patch)
+        {
+        r_cut_patch = OverlapReal(patch->getRCut() + 0.5 * patch->getAdditiveCutoff(type));
+        r_cut_self = r_cut_patch + 0.5 * patch->getAdditiveCutoff(type);
+        }
+
+    unsigned int err_count = 0;
+
+    Shape shape(orientation, params[type]);
+
+    for (unsigned int cur_image = 1; cur_image < n_images; cur_image++)
+        {
+        // check for self-overlap with all images except the original
+        vec3<Scalar> r_ij = -image_list[cur_image];
+        if (h_overlaps[overlap_idx(type, type)] && check_circumsphere_overlap(r_ij, shape, shape)
+            && test_overlap(r_ij, shape, shape, err_count))
+            {
+            return true;
+            }
+
+        // self-energy
+        if (patch && dot(r_ij, r_ij) <= r_cut_self * r_cut_self)
+            {
+            lnboltzmann -= patch->energy(r_ij,
+                                         type,
+                                         quat<float>(orientation),
+                                         1.0, // diameter i
+                                         0.0, // charge i
+                                         type,
+                                         quat<float>(orientation),
+                                         1.0, // diameter i
+                                         0.0  // charge i
+            );
+            }
+        }
+
+    if (!aabb_tree)
+        return false;
+
+    // Check particle against AABB tree for neighbors
+    OverlapReal R_query = std::max(shape.getCircumsphereDiameter() / OverlapReal(2.0),
+                                   r_cut_patch - m_mc->getMinCoreDiameter() / (OverlapReal)2.0);
+    hoomd::detail::AABB aabb_local = hoomd::detail::AABB(vec3<Scalar>(0, 0, 0), R_query);
+
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_image = pos + image_list[cur_image];
+
+        hoomd::detail::AABB aabb = aabb_local;
+        aabb.translate(pos_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree->getNumNodes();
+             cur_node_idx++)
+            {
+            if (detail::overlap(aabb_tree->getNodeAABB(cur_node_idx), aabb))
+                {
+                if (aabb_tree->isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0;
+                         cur_p < aabb_tree->getNodeNumParticles(cur_node_idx);
+                         cur_p++)
+                        {
+                        // read in its position and orientation
+                        unsigned int j = aabb_tree->getNodeParticle(cur_node_idx, cur_p);
+
+                        // skip the particle that is being removed
+                        if (h_tag[j] == ignore_tag)
+                            continue;
+
+                        Scalar4 postype_j = h_postype[j];
+                        Scalar4 orientation_j = h_orientation[j];
+
+                        // put particles in coordinate system of particle i
+                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_image;
+
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        Shape shape_j(quat<Scalar>(orientation_j), params[typ_j]);
+
+                        Scalar r_cut_ij(0.0);
+                        if (patch)
+                            r_cut_ij = r_cut_patch + 0.5 * patch->getAdditiveCutoff(typ_j);
+
+                        if (h_overlaps[overlap_idx(type, typ_j)]
+                            && check_circumsphere_overlap(r_ij, shape, shape_j)
+                            && test_overlap(r_ij, shape, shape_j, err_count))
+                            {
+                            return true;
+                            }
+                        else if (patch && dot(r_ij, r_ij) <= r_cut_ij * r_cut_ij)
+                            {
+                            lnboltzmann -= patch->energy(r_ij,
+                                                         type,
+                                                         quat<float>(orientation),
+                                                         float(1.0), // diameter i
+                                                         float(0.0), // charge i
+                                                         typ_j,
+                                                         quat<float>(orientation_j),
+                                                         float(h_diameter[j]),
+                                                         float(h_charge[j]));
+                            }
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += aabb_tree->getNodeSkip(cur_node_idx);
+                }
+            } // end loop over AABB nodes
+        }     // end loop over images
+
+    return false;
+    }
+
+template<class Shape>
+void UpdaterMuVT<Shape>::tryInsertParticles(uint64_t timestep,
+                                            unsigned int type,
+                                            const std::vector<vec3<Scalar>>& pos,
+                                            const std::vector<quat<Scalar>>& orientation,
+                                            unsigned int ignore_tag,
+                                            std::vector<Scalar>& lnboltzmann,
+                                            std::vector<unsigned int>& overlap)
+    {
+    const unsigned int n_trial = (unsigned int)pos.size();
+    lnboltzmann.assign(n_trial, Scalar(0.0));
+    overlap.assign(n_trial, 0);
+
+    // the rank owning the position of each trial computes its weight
+    std::vector<unsigned int> is_local(n_trial, 1);
+#ifdef ENABLE_MPI
+    if (this->m_pdata->getDomainDecomposition())
+        {
+        const BoxDim& global_box = this->m_pdata->getGlobalBox();
+        ArrayHandle<unsigned int> h_cart_ranks(
+            this->m_pdata->getDomainDecomposition()->getCartRanks(),
+            access_location::host,
+            access_mode::read);
+        for (unsigned int i = 0; i < n_trial; ++i)
+            {
+            is_local[i] = this->m_exec_conf->getRank()
+                          == this->m_pdata->getDomainDecomposition()->placeParticle(
+                              global_box,
+                              vec_to_scalar3(pos[i]),
+                              h_cart_ranks.data);
+            }
+        }
+#endif
+
+    unsigned int nptl_local = m_pdata->getN() + m_pdata->getNGhosts();
+
+    // build the shared data structures once, before evaluating the trials in parallel
+    const std::vector<vec3<Scalar>>& image_list = m_mc->updateImageList();
+    const hoomd::detail::AABBTree* aabb_tree = nullptr;
+    if (nptl_local > 0)
+        {
+        aabb_tree = &m_mc->buildAABBTree();
+        }
+
+        {
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+        ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(),
+                                             access_location::host,
+                                             access_mode::read);
+
+        auto check_trial = [&](unsigned int i)
+        {
+            if (!is_local[i])
+                return;
+
+            overlap[i] = checkInsertionOverlaps(type,
+                                                pos[i],
+                                                orientation[i],
+                                                ignore_tag,
+                                                aabb_tree,
+                                                image_list,
+                                                h_postype.data,
+                                                h_orientation.data,
+                                                h_diameter.data,
+                                                h_charge.data,
+                                                h_tag.data,
+                                                h_overlaps.data,
+                                                lnboltzmann[i]);
+        };
+
+#ifdef ENABLE_TBB
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_trial),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                          check_trial(i);
+                                  });
+            });
+#else
+        for (unsigned int i = 0; i < n_trial; ++i)
+            check_trial(i);
+#endif
+        }
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      lnboltzmann.data(),
+                      n_trial,
+                      MPI_HOOMD_SCALAR,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE,
+                      overlap.data(),
+                      n_trial,
+                      MPI_UNSIGNED,
+                      MPI_MAX,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+    }
+
+template<class Shape>
+Scalar UpdaterMuVT<Shape>::computeRosenbluthWeight(const std::vector<Scalar>& lnboltzmann,
+                                                   const std::vector<unsigned int>& overlap)
+    {
+    // shift the exponents by their maximum to avoid overflow
+    Scalar lnb_max(-std::numeric_limits<Scalar>::infinity());
+    for (unsigned int i = 0; i < lnboltzmann.size(); ++i)
+        {
+        if (!overlap[i])
+            lnb_max = std::max(lnb_max, lnboltzmann[i]);
+        }
+
+    if (lnb_max == -std::numeric_limits<Scalar>::infinity())
+        return lnb_max;
+
+    Scalar sum(0.0);
+    for (unsigned int i = 0; i < lnboltzmann.size(); ++i)
+        {
+        if (!overlap[i])
+            sum += exp(lnboltzmann[i] - lnb_max);
+        }
+    return lnb_max + log(sum);
+    }
+
+template<class Shape>
+void UpdaterMuVT<Shape>::generateTrialInsertion(hoomd::RandomGenerator& rng,
+                                                unsigned int type,
+                                                vec3<Scalar>& pos,
+                                                quat<Scalar>& orientation)
+    {
+    // Propose a random position uniformly in the box
+    Scalar3 f;
+    f.x = hoomd::detail::generate_canonical<Scalar>(rng);
+    f.y = hoomd::detail::generate_canonical<Scalar>(rng);
+    if (m_sysdef->getNDimensions() == 2)
+        {
+        f.z = Scalar(0.5);
+        }
+    else
+        {
+        f.z = hoomd::detail::generate_canonical<Scalar>(rng);
+        }
+    pos = vec3<Scalar>(m_pdata->getGlobalBox().makeCoordinates(f));
+
+    orientation = quat<Scalar>();
+    Shape shape_test(orientation, m_mc->getParams()[type]);
+    if (shape_test.hasOrientation())
+        {
+        orientation = generateRandomOrientation(rng, m_sysdef->getNDimensions());
+        }
+    }
+
 /*! \param mode 0 -> Absolute count, 1 -> relative to the start of the run, 2 -> relative to the
    last executed step \return The current state of the acceptance counters
 
@@ -3125,6 +3465,9 @@ template<class Shape> void export_UpdaterMuVT(pybind11::module& m, const std::st
                       &UpdaterMuVT<Shape>::getTransferTypes,
                       &UpdaterMuVT<Shape>::setTransferTypes)
         .def_property("ntrial", &UpdaterMuVT<Shape>::getNTrial, &UpdaterMuVT<Shape>::setNTrial)
+        .def_property("ntrial_insert",
+                      &UpdaterMuVT<Shape>::getNTrialInsert,
+                      &UpdaterMuVT<Shape>::setNTrialInsert)
         .def_property_readonly("N", &UpdaterMuVT<Shape>::getN)
         .def("getCounters", &UpdaterMuVT<Shape>::getCounters);
     }
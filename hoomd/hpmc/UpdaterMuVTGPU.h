@@ -0,0 +1,509 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __UPDATER_MUVT_GPU_H__
+#define __UPDATER_MUVT_GPU_H__
+
+#ifdef ENABLE_HIP
+
+#include "hoomd/Autotuner.h"
+#include "hoomd/CellList.h"
+
+#include "IntegratorHPMCMonoGPU.cuh"
+#include "UpdaterMuVT.h"
+#include "UpdaterMuVTGPU.cuh"
+
+/*! \file UpdaterMuVTGPU.h
+    \brief Declaration of UpdaterMuVTGPU
+    \note This header cannot be compiled by nvcc
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+//! Insert and remove particles in the muVT ensemble, checking overlaps on the GPU
+/*! UpdaterMuVTGPU checks the trial insertions of UpdaterMuVT for overlaps on the device against a
+    cell list, instead of reading the particle data on the host and traversing the AABB tree of the
+    integrator. All trials of a configurational bias move are checked in one kernel launch.
+
+    Hard particle insertions and removals never copy the particle data to the host. With a patch
+    energy, the Boltzmann weights are computed on the CPU by UpdaterMuVT. Depletants are also
+    handled by UpdaterMuVT.
+
+    \ingroup hpmc_integrators
+*/
+template<class Shape> class UpdaterMuVTGPU : public UpdaterMuVT<Shape>
+    {
+    public:
+    //! Constructor
+    /*! \param sysdef The system definition
+        \param mc The HPMC integrator
+        \param npartition How many partitions to use in parallel for Gibbs ensemble
+        \param cl Cell list
+    */
+    UpdaterMuVTGPU(std::shared_ptr<SystemDefinition> sysdef,
+                   std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
+                   unsigned int npartition,
+                   std::shared_ptr<CellList> cl);
+
+    //! Destructor
+    virtual ~UpdaterMuVTGPU();
+
+    //! Set autotuner parameters
+    /*! \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        m_tuner_overlaps->setPeriod(period);
+        m_tuner_overlaps->setEnabled(enable);
+
+        m_tuner_excell_block_size->setPeriod(period);
+        m_tuner_excell_block_size->setEnabled(enable);
+        }
+
+    protected:
+    std::shared_ptr<CellList> m_cl; //!< Cell list
+
+    uint3 m_last_dim;         //!< Dimensions of the cell list on the last call to update
+    unsigned int m_last_nmax; //!< Last cell list NMax value allocated in excell
+
+    GPUArray<unsigned int> m_excell_idx;  //!< Particle indices in expanded cells
+    GPUArray<unsigned int> m_excell_size; //!< Number of particles in each expanded cell
+    Index2D m_excell_list_indexer;        //!< Indexer to access elements of the excell_idx list
+
+    GPUArray<Scalar4> m_trial_postype;     //!< Positions of the trial insertions
+    GPUArray<Scalar4> m_trial_orientation; //!< Orientations of the trial insertions
+    GPUArray<unsigned int> m_trial_overlap; //!< Overlap flags of the trial insertions
+
+    std::unique_ptr<Autotuner> m_tuner_overlaps;          //!< Autotuner for the overlap checks
+    std::unique_ptr<Autotuner> m_tuner_excell_block_size; //!< Autotuner for excell block_size
+
+    //! Try inserting a particle, checking overlaps on the GPU
+    virtual bool tryInsertParticle(uint64_t timestep,
+                                   unsigned int type,
+                                   vec3<Scalar> pos,
+                                   quat<Scalar> orientation,
+                                   Scalar& lnboltzmann);
+
+    //! Check several trial insertions for overlaps on the GPU in one kernel launch
+    virtual void tryInsertParticles(uint64_t timestep,
+                                    unsigned int type,
+                                    const std::vector<vec3<Scalar>>& pos,
+                                    const std::vector<quat<Scalar>>& orientation,
+                                    unsigned int ignore_tag,
+                                    std::vector<Scalar>& lnboltzmann,
+                                    std::vector<unsigned int>& overlap);
+
+    //! Test whether the overlap checks can run on the GPU
+    bool useDevice();
+
+    //! Set up excell_list
+    void initializeExcellMem();
+    };
+
+template<class Shape>
+UpdaterMuVTGPU<Shape>::UpdaterMuVTGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                      std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
+                                      unsigned int npartition,
+                                      std::shared_ptr<CellList> cl)
+    : UpdaterMuVT<Shape>(sysdef, mc, npartition), m_cl(cl)
+    {
+    this->m_exec_conf->msg->notice(5) << "Constructing UpdaterMuVTGPU" << std::endl;
+
+    this->m_cl->setRadius(1);
+    this->m_cl->setComputeTDB(false);
+    this->m_cl->setFlagType();
+    this->m_cl->setComputeIdx(true);
+
+    // set last dim to a bogus value so that it will re-init on the first call
+    m_last_dim = make_uint3(0xffffffff, 0xffffffff, 0xffffffff);
+    m_last_nmax = 0xffffffff;
+
+    // the full block size, stride and group size matrix is searched,
+    // encoded as block_size*1000000 + stride*100 + group_size.
+    std::vector<unsigned int> valid_params;
+    unsigned int warp_size = this->m_exec_conf->dev_prop.warpSize;
+    for (unsigned int block_size = warp_size;
+         block_size <= (unsigned int)this->m_exec_conf->dev_prop.maxThreadsPerBlock;
+         block_size += warp_size)
+        {
+        for (auto s : Autotuner::getTppListPow2(warp_size))
+            {
+            unsigned int stride = 1;
+            while (stride <= this->m_exec_conf->dev_prop.warpSize / s)
+                {
+                // only widen the parallelism if the shape supports it
+                if (stride == 1 || Shape::isParallel())
+                    {
+                    // blockDim.z is limited to 64
+                    if ((block_size % (stride * s)) == 0 && block_size / s / stride <= 64)
+                        valid_params.push_back(block_size * 1000000 + stride * 100 + s);
+                    }
+                stride *= 2;
+                }
+            }
+        }
+    m_tuner_overlaps.reset(
+        new Autotuner(valid_params, 5, 1000000, "hpmc_muvt_overlaps", this->m_exec_conf));
+
+    m_tuner_excell_block_size.reset(new Autotuner(warp_size,
+                                                  this->m_exec_conf->dev_prop.maxThreadsPerBlock,
+                                                  warp_size,
+                                                  5,
+                                                  1000000,
+                                                  "hpmc_muvt_excell_block_size",
+                                                  this->m_exec_conf));
+
+    GPUArray<unsigned int> excell_size(0, this->m_exec_conf);
+    m_excell_size.swap(excell_size);
+
+    GPUArray<unsigned int> excell_idx(0, this->m_exec_conf);
+    m_excell_idx.swap(excell_idx);
+
+    GPUArray<Scalar4> trial_postype(1, this->m_exec_conf);
+    m_trial_postype.swap(trial_postype);
+
+    GPUArray<Scalar4> trial_orientation(1, this->m_exec_conf);
+    m_trial_orientation.swap(trial_orientation);
+
+    GPUArray<unsigned int> trial_overlap(1, this->m_exec_conf);
+    m_trial_overlap.swap(trial_overlap);
+    }
+
+template<class Shape> UpdaterMuVTGPU<Shape>::~UpdaterMuVTGPU()
+    {
+    this->m_exec_conf->msg->notice(5) << "Destroying UpdaterMuVTGPU" << std::endl;
+    }
+
+/*! The GPU kernel checks hard particle overlaps only. Patch energies and depletants need the CPU
+    code path of UpdaterMuVT.
+*/
+template<class Shape> bool UpdaterMuVTGPU<Shape>::useDevice()
+    {
+    if (this->m_mc->getPatchEnergy())
+        return false;
+
+    for (unsigned int type_d = 0; type_d < this->m_pdata->getNTypes(); ++type_d)
+        {
+        if (this->m_mc->getDepletantFugacity(type_d, type_d) != 0.0)
+            return false;
+        }
+
+    return true;
+    }
+
+template<class Shape>
+bool UpdaterMuVTGPU<Shape>::tryInsertParticle(uint64_t timestep,
+                                              unsigned int type,
+                                              vec3<Scalar> pos,
+                                              quat<Scalar> orientation,
+                                              Scalar& lnboltzmann)
+    {
+    if (!useDevice())
+        return UpdaterMuVT<Shape>::tryInsertParticle(timestep, type, pos, orientation, lnboltzmann);
+
+    std::vector<Scalar> lnb;
+    std::vector<unsigned int> overlap;
+    tryInsertParticles(timestep,
+                       type,
+                       std::vector<vec3<Scalar>>(1, pos),
+                       std::vector<quat<Scalar>>(1, orientation),
+                       UINT_MAX,
+                       lnb,
+                       overlap);
+
+    lnboltzmann = lnb[0];
+    return !overlap[0];
+    }
+
+template<class Shape>
+void UpdaterMuVTGPU<Shape>::tryInsertParticles(uint64_t timestep,
+                                               unsigned int type,
+                                               const std::vector<vec3<Scalar>>& pos,
+                                               const std::vector<quat<Scalar>>& orientation,
+                                               unsigned int ignore_tag,
+                                               std::vector<Scalar>& lnboltzmann,
+                                               std::vector<unsigned int>& overlap)
+    {
+    if (!useDevice())
+        {
+        UpdaterMuVT<Shape>::tryInsertParticles(timestep,
+                                               type,
+                                               pos,
+                                               orientation,
+                                               ignore_tag,
+                                               lnboltzmann,
+                                               overlap);
+        return;
+        }
+
+    const unsigned int n_trial = (unsigned int)pos.size();
+    lnboltzmann.assign(n_trial, Scalar(0.0));
+    overlap.assign(n_trial, 0);
+
+    // the rank owning the position of each trial checks it
+    std::vector<unsigned int> local_trials;
+    local_trials.reserve(n_trial);
+#ifdef ENABLE_MPI
+    if (this->m_pdata->getDomainDecomposition())
+        {
+        const BoxDim& global_box = this->m_pdata->getGlobalBox();
+        ArrayHandle<unsigned int> h_cart_ranks(
+            this->m_pdata->getDomainDecomposition()->getCartRanks(),
+            access_location::host,
+            access_mode::read);
+        for (unsigned int i = 0; i < n_trial; ++i)
+            {
+            if (this->m_exec_conf->getRank()
+                == this->m_pdata->getDomainDecomposition()->placeParticle(global_box,
+                                                                          vec_to_scalar3(pos[i]),
+                                                                          h_cart_ranks.data))
+                {
+                local_trials.push_back(i);
+                }
+            }
+        }
+    else
+#endif
+        {
+        for (unsigned int i = 0; i < n_trial; ++i)
+            local_trials.push_back(i);
+        }
+
+    const unsigned int n_local = (unsigned int)local_trials.size();
+
+    if (n_local > 0 && this->m_pdata->getN() + this->m_pdata->getNGhosts() > 0)
+        {
+        if (this->m_prof)
+            this->m_prof->push(this->m_exec_conf, "muVT overlaps");
+
+        // the cell width must cover the largest pair of circumspheres
+        Scalar nominal_width = this->m_mc->getMaxCoreDiameter();
+        if (this->m_cl->getNominalWidth() != nominal_width)
+            this->m_cl->setNominalWidth(nominal_width);
+
+        // check if we are below a minimum image convention box size
+        // the minimum image convention comes from the global box, not the local one
+        BoxDim global_box = this->m_pdata->getGlobalBox();
+        Scalar3 nearest_plane_distance = global_box.getNearestPlaneDistance();
+
+        if ((global_box.getPeriodic().x && nearest_plane_distance.x <= nominal_width * 2)
+            || (global_box.getPeriodic().y && nearest_plane_distance.y <= nominal_width * 2)
+            || (this->m_sysdef->getNDimensions() == 3 && global_box.getPeriodic().z
+                && nearest_plane_distance.z <= nominal_width * 2))
+            {
+            this->m_exec_conf->msg->error()
+                << "Simulation box too small for GPU accelerated HPMC execution - increase it so "
+                   "the minimum image convention works"
+                << std::endl;
+            throw std::runtime_error("Error performing HPMC update");
+            }
+
+        // compute cell list
+        this->m_cl->compute(timestep);
+
+        // if the cell list is a different size than last time, reinitialize expanded cell list
+        uint3 cur_dim = this->m_cl->getDim();
+        if (m_last_dim.x != cur_dim.x || m_last_dim.y != cur_dim.y || m_last_dim.z != cur_dim.z
+            || m_last_nmax != this->m_cl->getNmax())
+            {
+            initializeExcellMem();
+            m_last_dim = cur_dim;
+            m_last_nmax = this->m_cl->getNmax();
+            }
+
+        // copy the trials to the device
+        if (m_trial_postype.getNumElements() < n_local)
+            {
+            m_trial_postype.resize(n_local);
+            m_trial_orientation.resize(n_local);
+            m_trial_overlap.resize(n_local);
+            }
+
+            {
+            ArrayHandle<Scalar4> h_trial_postype(m_trial_postype,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+            ArrayHandle<Scalar4> h_trial_orientation(m_trial_orientation,
+                                                     access_location::host,
+                                                     access_mode::overwrite);
+            for (unsigned int k = 0; k < n_local; ++k)
+                {
+                unsigned int i = local_trials[k];
+                h_trial_postype.data[k] = make_scalar4(pos[i].x, pos[i].y, pos[i].z, 0);
+                h_trial_orientation.data[k] = quat_to_scalar4(orientation[i]);
+                }
+            }
+
+            {
+            // access the cell list data
+            ArrayHandle<unsigned int> d_cell_size(this->m_cl->getCellSizeArray(),
+                                                  access_location::device,
+                                                  access_mode::read);
+            ArrayHandle<unsigned int> d_cell_idx(this->m_cl->getIndexArray(),
+                                                 access_location::device,
+                                                 access_mode::read);
+            ArrayHandle<unsigned int> d_cell_adj(this->m_cl->getCellAdjArray(),
+                                                 access_location::device,
+                                                 access_mode::read);
+
+            ArrayHandle<unsigned int> d_excell_idx(m_excell_idx,
+                                                   access_location::device,
+                                                   access_mode::readwrite);
+            ArrayHandle<unsigned int> d_excell_size(m_excell_size,
+                                                    access_location::device,
+                                                    access_mode::readwrite);
+
+            // update the expanded cells
+            m_tuner_excell_block_size->begin();
+            gpu::hpmc_excell(d_excell_idx.data,
+                             d_excell_size.data,
+                             m_excell_list_indexer,
+                             d_cell_idx.data,
+                             d_cell_size.data,
+                             d_cell_adj.data,
+                             this->m_cl->getCellIndexer(),
+                             this->m_cl->getCellListIndexer(),
+                             this->m_cl->getCellAdjIndexer(),
+                             1,
+                             m_tuner_excell_block_size->getParam());
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            m_tuner_excell_block_size->end();
+
+            // access the particle data
+            ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(),
+                                           access_location::device,
+                                           access_mode::read);
+            ArrayHandle<Scalar4> d_orientation(this->m_pdata->getOrientationArray(),
+                                               access_location::device,
+                                               access_mode::read);
+            ArrayHandle<unsigned int> d_tag(this->m_pdata->getTags(),
+                                            access_location::device,
+                                            access_mode::read);
+            ArrayHandle<unsigned int> d_overlaps(this->m_mc->getInteractionMatrix(),
+                                                 access_location::device,
+                                                 access_mode::read);
+
+            ArrayHandle<Scalar4> d_trial_postype(m_trial_postype,
+                                                 access_location::device,
+                                                 access_mode::read);
+            ArrayHandle<Scalar4> d_trial_orientation(m_trial_orientation,
+                                                     access_location::device,
+                                                     access_mode::read);
+            ArrayHandle<unsigned int> d_trial_overlap(m_trial_overlap,
+                                                      access_location::device,
+                                                      access_mode::overwrite);
+
+            const BoxDim box = this->m_pdata->getBox();
+            auto& params = this->m_mc->getParams();
+
+            m_tuner_overlaps->begin();
+            unsigned int param = m_tuner_overlaps->getParam();
+            unsigned int block_size = param / 1000000;
+            unsigned int stride = (param % 1000000) / 100;
+            unsigned int group_size = param % 100;
+
+            detail::hpmc_muvt_overlaps_args_t args(n_local,
+                                                   type,
+                                                   d_trial_postype.data,
+                                                   d_trial_orientation.data,
+                                                   d_trial_overlap.data,
+                                                   d_postype.data,
+                                                   d_orientation.data,
+                                                   d_tag.data,
+                                                   ignore_tag,
+                                                   this->m_cl->getCellIndexer(),
+                                                   d_excell_idx.data,
+                                                   d_excell_size.data,
+                                                   m_excell_list_indexer,
+                                                   this->m_cl->getDim(),
+                                                   this->m_cl->getGhostWidth(),
+                                                   this->m_pdata->getNTypes(),
+                                                   box,
+                                                   block_size,
+                                                   stride,
+                                                   group_size,
+                                                   d_overlaps.data,
+                                                   this->m_mc->getOverlapIndexer(),
+                                                   this->m_exec_conf->dev_prop);
+
+            detail::gpu_hpmc_muvt_overlaps<Shape>(args, params.data());
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            m_tuner_overlaps->end();
+            }
+
+        // copy the overlap flags of the local trials back
+        ArrayHandle<unsigned int> h_trial_overlap(m_trial_overlap,
+                                                  access_location::host,
+                                                  access_mode::read);
+        for (unsigned int k = 0; k < n_local; ++k)
+            overlap[local_trials[k]] = h_trial_overlap.data[k];
+
+        if (this->m_prof)
+            this->m_prof->pop(this->m_exec_conf);
+        }
+
+#ifdef ENABLE_MPI
+    if (this->m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      overlap.data(),
+                      n_trial,
+                      MPI_UNSIGNED,
+                      MPI_MAX,
+                      this->m_exec_conf->getMPICommunicator());
+        }
+#endif
+    }
+
+template<class Shape> void UpdaterMuVTGPU<Shape>::initializeExcellMem()
+    {
+    this->m_exec_conf->msg->notice(4) << "hpmc resizing expanded cells" << std::endl;
+
+    // get the current cell dimensions
+    unsigned int num_cells = this->m_cl->getCellIndexer().getNumElements();
+    unsigned int num_adj = this->m_cl->getCellAdjIndexer().getW();
+    unsigned int num_max = this->m_cl->getNmax();
+
+    // make the excell dimensions the same, but with room for Nmax*Nadj in each cell
+    m_excell_list_indexer = Index2D(num_max * num_adj, num_cells);
+
+    // reallocate memory
+    m_excell_idx.resize(m_excell_list_indexer.getNumElements());
+    m_excell_size.resize(num_cells);
+    }
+
+namespace detail
+    {
+//! Export the UpdaterMuVTGPU class to python
+/*! \param name Name of the class in the exported python module
+    \tparam Shape An instantiation of UpdaterMuVTGPU<Shape> will be exported
+*/
+template<class Shape> void export_UpdaterMuVTGPU(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_<UpdaterMuVTGPU<Shape>,
+                     UpdaterMuVT<Shape>,
+                     std::shared_ptr<UpdaterMuVTGPU<Shape>>>(m, name.c_str())
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<IntegratorHPMCMono<Shape>>,
+                            unsigned int,
+                            std::shared_ptr<CellList>>());
+    }
+
+    } // end namespace detail
+    } // end namespace hpmc
+    } // end namespace hoomd
+
+#endif // ENABLE_HIP
+
+#endif // __UPDATER_MUVT_GPU_H__
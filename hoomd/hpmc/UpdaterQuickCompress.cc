@@ -159,6 +159,15 @@ BoxDim UpdaterQuickCompress::getNewBox(uint64_t timestep)
     hoomd::UniformDistribution<double> uniform(min_scale, 1.0);
     double scale = uniform(rng);
 
+    // When the particles are far apart, take the largest step that creates no overlaps. Compress by
+    // at most a factor of 2 per step, and leave 1% of the gap to the closest pair so that round-off
+    // does not create overlaps at contact.
+    if (m_gap_scaling)
+        {
+        double lambda = m_mc->computeContactScale(0.5);
+        scale = std::min(scale, 1.0 - 0.99 * lambda);
+        }
+
     // TODO: This slow. We will implement a general reusable fix later in #705
     BoxDim target_box = m_target_box.attr("_cpp_obj").cast<BoxDim>();
 
@@ -212,6 +221,9 @@ void export_UpdaterQuickCompress(pybind11::module& m)
         .def_property("min_scale",
                       &UpdaterQuickCompress::getMinScale,
                       &UpdaterQuickCompress::setMinScale)
+        .def_property("gap_scaling",
+                      &UpdaterQuickCompress::getGapScaling,
+                      &UpdaterQuickCompress::setGapScaling)
         .def_property("target_box",
                       &UpdaterQuickCompress::getTargetBox,
                       &UpdaterQuickCompress::setTargetBox)
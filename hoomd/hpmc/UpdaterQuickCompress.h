@@ -87,6 +87,18 @@ class UpdaterQuickCompress : public Updater
         m_min_scale = min_scale;
         }
 
+    /// Get whether the scale factor is chosen from the gaps between particles
+    bool getGapScaling()
+        {
+        return m_gap_scaling;
+        }
+
+    /// Set whether the scale factor is chosen from the gaps between particles
+    void setGapScaling(bool gap_scaling)
+        {
+        m_gap_scaling = gap_scaling;
+        }
+
     /// Get the target box
     pybind11::object getTargetBox()
         {
@@ -130,6 +142,9 @@ class UpdaterQuickCompress : public Updater
     /// The target box dimensions
     pybind11::object m_target_box;
 
+    /// When true, scale the box by up to the factor at which the closest pair touches
+    bool m_gap_scaling = false;
+
     /// Unique ID for RNG seeding
     unsigned int m_instance = 0;
 
@@ -22,6 +22,8 @@ class FreeVolume(Compute):
     Args:
         test_particle_type (str): Test particle type.
         num_samples (int): Number of samples to evaluate.
+        persistent_samples (bool): Keep the test particle placements between
+            evaluations.
 
     `FreeVolume` computes the free volume in the simulation state available to a
     given test particle using Monte Carlo integration. It must be used in
@@ -53,6 +55,15 @@ class FreeVolume(Compute):
         `FreeVolume` respects the ``interaction_matrix`` set in the HPMC
         integrator.
 
+    When `persistent_samples` is `True`, `FreeVolume` keeps the test particle
+    placements between evaluations and checks again only the placements near
+    particles that moved since the last evaluation. This makes repeated
+    evaluations much cheaper when few particles move between them, at the cost
+    of reusing the same placements. `FreeVolume` generates new placements when
+    the box, the number of particles, the shape parameters, the interaction
+    matrix, `num_samples`, or `test_particle_type` change. Persistent samples
+    are ignored on the GPU and with domain decomposition.
+
     Examples::
 
         fv = hoomd.hpmc.compute.FreeVolume(test_particle_type='B',
@@ -64,14 +75,23 @@ class FreeVolume(Compute):
 
         num_samples (int): Number of samples to evaluate.
 
+        persistent_samples (bool): Keep the test particle placements between
+            evaluations.
+
     """
 
-    def __init__(self, test_particle_type, num_samples):
+    def __init__(self,
+                 test_particle_type,
+                 num_samples,
+                 persistent_samples=False):
         # store metadata
-        param_dict = ParameterDict(test_particle_type=str, num_samples=int)
+        param_dict = ParameterDict(test_particle_type=str,
+                                   num_samples=int,
+                                   persistent_samples=bool)
         param_dict.update(
             dict(test_particle_type=test_particle_type,
-                 num_samples=num_samples))
+                 num_samples=num_samples,
+                 persistent_samples=persistent_samples))
         self._param_dict.update(param_dict)
 
     def _attach(self):
@@ -115,6 +115,26 @@ class HPMCIntegrator(BaseIntegrator):
         nselect (int): Number of trial moves to perform per particle per
             timestep.
 
+        checkerboard (bool): Set to `True` to perform the trial moves on the
+            CPU in parallel over a checkerboard of cells (**default:**
+            `False`).
+
+    .. rubric:: Checkerboard sweeps
+
+    When `checkerboard` is `True`, the CPU integrators divide the box into
+    cells at least as wide as the largest particle and color the cells like a
+    checkerboard so that no two cells of the same color are adjacent. Each
+    sweep of trial moves processes the colors one after another in a random
+    order, and the cells of the current color in parallel on the threads of
+    the `hoomd.device.CPU`. Trial moves that would take a particle out of its
+    cell are rejected, which keeps the cells independent and preserves detailed
+    balance. The cell grid is shifted randomly every sweep.
+
+    Checkerboard sweeps apply only to hard particle systems. The integrator
+    performs serial sweeps when there are depletants, pair or external
+    potentials, or when the box is less than two cells wide. GPU integrators
+    ignore `checkerboard`.
+
     .. rubric:: Attributes
     """
     _remove_for_pickling = BaseIntegrator._remove_for_pickling + ('_cpp_cell',)
@@ -128,7 +148,8 @@ class HPMCIntegrator(BaseIntegrator):
         # Set base parameter dict for hpmc integrators
         param_dict = ParameterDict(
             translation_move_probability=float(translation_move_probability),
-            nselect=int(nselect))
+            nselect=int(nselect),
+            checkerboard=False)
         self._param_dict.update(param_dict)
         self._pair_potential = None
         self._external_potential = None
@@ -351,9 +372,11 @@ class HPMCIntegrator(BaseIntegrator):
 
     @pair_potential.setter
     def pair_potential(self, new_potential):
-        if not isinstance(new_potential, hoomd.hpmc.pair.user.CPPPotentialBase):
-            raise TypeError(
-                "Pair potentials should be an instance of CPPPotentialBase")
+        pair_types = (hoomd.hpmc.pair.user.CPPPotentialBase,
+                      hoomd.hpmc.pair.Table)
+        if not isinstance(new_potential, pair_types):
+            raise TypeError("Pair potentials should be an instance of "
+                            "CPPPotentialBase or Table")
         if self._added:
             new_potential._add(self._simulation)
         if self._attached:
@@ -1847,3 +1870,162 @@ class FacetedEllipsoidUnion(HPMCIntegrator):
                                              'overlap': None
                                          }))
         self._add_typeparam(typeparam_shape)
+
+
+class SphereEventChain(Sphere):
+    """Hard sphere event-chain Monte Carlo.
+
+    Args:
+        default_d (float): Default maximum length of each event of a chain
+            :math:`[\\mathrm{length}]`.
+        default_a (float): Default maximum size of rotation trial moves
+            :math:`[\\mathrm{dimensionless}]`.
+        translation_move_probability (float): Fraction of moves that start
+            event chains.
+        nselect (int): Number of moves to perform per particle per timestep.
+        chain_length (float): Total displacement of the particles in each
+            chain :math:`[\\mathrm{length}]`.
+
+    `SphereEventChain` replaces the translation trial moves of `Sphere` with
+    straight event chains (`Bernard et al. 2009
+    <https://doi.org/10.1103/PhysRevE.80.056704>`_). Each chain starts at a
+    particle and picks a random direction. The active particle moves along
+    that direction until it touches another particle, which becomes the active
+    particle and continues the chain in the same direction. The chain ends
+    when the displacements of all its particles add up to `chain_length`.
+    Event chains never create overlaps, so every move is accepted.
+
+    Each sweep starts one chain per particle in a random order. Orientable
+    particles perform Metropolis rotation moves with probability
+    ``1 - translation_move_probability`` instead. The integrator counts each
+    event of a chain as an accepted translation move. ``d`` limits the length
+    of each event, not of the chain; a chain of length `chain_length` takes at
+    least ``chain_length / d`` events.
+
+    Event chains apply only to hard particles. They do not support
+    depletants, pair potentials, external potentials, or domain
+    decomposition, and they run on the CPU.
+
+    Example::
+
+        mc = hoomd.hpmc.integrate.SphereEventChain(default_d=0.5,
+                                                   chain_length=2.0)
+        mc.shape["A"] = dict(diameter=1.0)
+
+    Attributes:
+        chain_length (float): Total displacement of the particles in each
+            chain :math:`[\\mathrm{length}]`.
+    """
+    _cpp_cls = 'IntegratorHPMCMonoNECSphere'
+
+    def __init__(self,
+                 default_d=0.1,
+                 default_a=0.1,
+                 translation_move_probability=0.5,
+                 nselect=1,
+                 chain_length=1.0):
+
+        # initialize base class
+        super().__init__(default_d, default_a, translation_move_probability,
+                         nselect)
+
+        self._param_dict.update(
+            ParameterDict(chain_length=float(chain_length)))
+
+
+class ConvexPolyhedronEventChain(ConvexPolyhedron):
+    """Hard convex polyhedron event-chain Monte Carlo.
+
+    Args:
+        default_d (float): Default maximum length of each event of a chain
+            :math:`[\\mathrm{length}]`.
+        default_a (float): Default maximum size of rotation trial moves
+            :math:`[\\mathrm{dimensionless}]`.
+        translation_move_probability (float): Fraction of moves that start
+            event chains.
+        nselect (int): Number of moves to perform per particle per timestep.
+        chain_length (float): Total displacement of the particles in each
+            chain :math:`[\\mathrm{length}]`.
+
+    `ConvexPolyhedronEventChain` replaces the translation trial moves of
+    `ConvexPolyhedron` with straight event chains and keeps the Metropolis
+    rotation moves. See `SphereEventChain` for details.
+
+    Example::
+
+        mc = hoomd.hpmc.integrate.ConvexPolyhedronEventChain(default_d=0.5,
+                                                             default_a=0.1,
+                                                             chain_length=2.0)
+        mc.shape["A"] = dict(vertices=[(0.5, 0.5, 0.5),
+                                       (0.5, -0.5, -0.5),
+                                       (-0.5, 0.5, -0.5),
+                                       (-0.5, -0.5, 0.5)])
+
+    Attributes:
+        chain_length (float): Total displacement of the particles in each
+            chain :math:`[\\mathrm{length}]`.
+    """
+    _cpp_cls = 'IntegratorHPMCMonoNECConvexPolyhedron'
+
+    def __init__(self,
+                 default_d=0.1,
+                 default_a=0.1,
+                 translation_move_probability=0.5,
+                 nselect=1,
+                 chain_length=1.0):
+
+        # initialize base class
+        super().__init__(default_d, default_a, translation_move_probability,
+                         nselect)
+
+        self._param_dict.update(
+            ParameterDict(chain_length=float(chain_length)))
+
+
+class ConvexSpheropolyhedronEventChain(ConvexSpheropolyhedron):
+    """Hard convex spheropolyhedron event-chain Monte Carlo.
+
+    Args:
+        default_d (float): Default maximum length of each event of a chain
+            :math:`[\\mathrm{length}]`.
+        default_a (float): Default maximum size of rotation trial moves
+            :math:`[\\mathrm{dimensionless}]`.
+        translation_move_probability (float): Fraction of moves that start
+            event chains.
+        nselect (int): Number of moves to perform per particle per timestep.
+        chain_length (float): Total displacement of the particles in each
+            chain :math:`[\\mathrm{length}]`.
+
+    `ConvexSpheropolyhedronEventChain` replaces the translation trial moves of
+    `ConvexSpheropolyhedron` with straight event chains and keeps the
+    Metropolis rotation moves. See `SphereEventChain` for details.
+
+    Example::
+
+        mc = hoomd.hpmc.integrate.ConvexSpheropolyhedronEventChain(
+            default_d=0.5, default_a=0.1, chain_length=2.0)
+        mc.shape["A"] = dict(vertices=[(0.5, 0.5, 0.5),
+                                       (0.5, -0.5, -0.5),
+                                       (-0.5, 0.5, -0.5),
+                                       (-0.5, -0.5, 0.5)],
+                             sweep_radius=0.1)
+
+    Attributes:
+        chain_length (float): Total displacement of the particles in each
+            chain :math:`[\\mathrm{length}]`.
+    """
+    _cpp_cls = 'IntegratorHPMCMonoNECSpheropolyhedron'
+
+    def __init__(self,
+                 default_d=0.1,
+                 default_a=0.1,
+                 translation_move_probability=0.5,
+                 nselect=1,
+                 chain_length=1.0):
+
+        # initialize base class
+        super().__init__(default_d, default_a, translation_move_probability,
+                         nselect)
+
+        self._param_dict.update(
+            ParameterDict(chain_length=float(chain_length)))
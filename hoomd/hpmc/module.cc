@@ -4,6 +4,8 @@
 // Include the defined classes that are to be exported to python
 #include "IntegratorHPMC.h"
 #include "IntegratorHPMCMono.h"
+#include "MoveSizeScaleTuner.h"
+#include "PatchEnergyTable.h"
 
 #include "ComputeSDF.h"
 #include "ShapeConvexPolygon.h"
@@ -26,6 +28,7 @@
 
 #ifdef ENABLE_HIP
 #include "IntegratorHPMCMonoGPU.h"
+#include "PatchEnergyTableGPU.h"
 #endif
 
 #include "modules.h"
@@ -41,9 +44,14 @@ using namespace std;
 PYBIND11_MODULE(_hpmc, m)
     {
     export_IntegratorHPMC(m);
+    export_PatchEnergyTable(m);
+#ifdef ENABLE_HIP
+    export_PatchEnergyTableGPU(m);
+#endif
 
     export_UpdaterBoxMC(m);
     export_UpdaterQuickCompress(m);
+    export_MoveSizeScaleTuner(m);
     export_external_fields(m);
 
     export_sphere(m);
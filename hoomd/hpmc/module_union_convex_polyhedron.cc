@@ -23,6 +23,7 @@
 #include "ComputeFreeVolumeGPU.h"
 #include "IntegratorHPMCMonoGPU.h"
 #include "UpdaterClustersGPU.h"
+#include "UpdaterMuVTGPU.h"
 #endif
 
 namespace hoomd
@@ -73,6 +74,9 @@ void export_union_convex_polyhedron(pybind11::module& m)
     export_UpdaterClustersGPU<ShapeUnion<ShapeSpheropolyhedron>>(
         m,
         "UpdaterClustersConvexSpheropolyhedronUnionGPU");
+    export_UpdaterMuVTGPU<ShapeUnion<ShapeSpheropolyhedron>>(
+        m,
+        "UpdaterMuVTConvexSpheropolyhedronUnionGPU");
 
 #endif
     }
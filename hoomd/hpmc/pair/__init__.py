@@ -1,3 +1,4 @@
 """Pair Potentials for Monte Carlo."""
 
 from . import user
+from .table import Table
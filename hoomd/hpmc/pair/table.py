@@ -0,0 +1,109 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Tabulated pair potentials for HPMC simulations."""
+
+import hoomd
+from hoomd.hpmc import _hpmc
+from hoomd.hpmc import integrate
+from hoomd.operation import _HOOMDBaseObject
+from hoomd.data.parameterdicts import TypeParameterDict, ParameterDict
+from hoomd.data.typeparam import TypeParameter
+from hoomd.data.typeconverter import NDArrayValidator
+from hoomd.logging import log
+import numpy as np
+
+
+class Table(_HOOMDBaseObject):
+    r"""Tabulated isotropic pair potential.
+
+    Args:
+        r_cut (float): Particle center to center distance cutoff beyond which
+            all pair interactions are 0.
+
+    `Table` defines an energetic interaction between pairs of particles that
+    depends only on the distance :math:`r` between the particle centers:
+
+    .. math::
+        :nowrap:
+
+        \begin{eqnarray*}
+        U(r) = & 0; & r < r_{\mathrm{min}} \\
+             = & U(r); & r_{\mathrm{min}} \le r < r_{\mathrm{cut}} \\
+             = & 0; & r \ge r_{\mathrm{cut}} \\
+        \end{eqnarray*}
+
+    Provide :math:`U(r)` on an evenly spaced set of grid points between
+    :math:`r_{\mathrm{min}}` and :math:`r_{\mathrm{cut}}`. `Table` linearly
+    interpolates values when :math:`r` lies between grid points and between the
+    last grid point and :math:`U(r_{\mathrm{cut}}) = 0`.
+
+    Unlike `hoomd.hpmc.pair.user.CPPPotential`, `Table` needs no runtime
+    compilation and is available in builds without LLVM.
+
+    Attributes:
+        r_cut (float): Particle center to center distance cutoff beyond which
+            all pair interactions are 0.
+
+        params (`TypeParameter` [\
+          `tuple` [``particle_type``, ``particle_type``],\
+          `dict`]):
+          The potential parameters. The dictionary has the following keys:
+
+          * ``r_min`` (`float`, **required**) - the distance of the first
+            element of ``U``.
+
+          * ``U`` ((*N*,) `numpy.ndarray` of `float`, **required**) -
+            the tabulated energy values.
+
+    Note:
+        The implicitly defined :math:`r` values are those that would be returned
+        by ``numpy.linspace(r_min, r_cut, len(U), endpoint=False)``.
+
+    Example::
+
+        r = numpy.linspace(0.9, 2.5, 200, endpoint=False)
+        table = hoomd.hpmc.pair.Table(r_cut=2.5)
+        table.params[('A', 'A')] = dict(r_min=0.9, U=-numpy.exp(-r))
+        mc.pair_potential = table
+    """
+
+    def __init__(self, r_cut):
+        param_dict = ParameterDict(r_cut=float)
+        param_dict['r_cut'] = r_cut
+        self._param_dict.update(param_dict)
+
+        params = TypeParameter(
+            'params', 'particle_types',
+            TypeParameterDict(r_min=float,
+                              U=NDArrayValidator(np.float32),
+                              len_keys=2))
+        self._add_typeparam(params)
+
+    @log(requires_run=True)
+    def energy(self):
+        """float: Total interaction energy of the system in the current state.
+
+        Returns `None` when the patch object and integrator are not
+        attached.
+        """
+        integrator = self._simulation.operations.integrator
+        timestep = self._simulation.timestep
+        return integrator._cpp_obj.computePatchEnergy(timestep)
+
+    def _attach(self):
+        integrator = self._simulation.operations.integrator
+        if not isinstance(integrator, integrate.HPMCIntegrator):
+            raise RuntimeError("The integrator must be a HPMC integrator.")
+
+        if not integrator._attached:
+            raise RuntimeError("Integrator is not attached yet.")
+
+        cpp_sys_def = self._simulation.state._cpp_sys_def
+        if isinstance(self._simulation.device, hoomd.device.GPU):
+            self._cpp_obj = _hpmc.PatchEnergyTableGPU(cpp_sys_def, self.r_cut)
+        else:
+            self._cpp_obj = _hpmc.PatchEnergyTable(cpp_sys_def, self.r_cut)
+
+        super()._attach()
@@ -73,6 +73,15 @@ class CPPPotentialBase(_HOOMDBaseObject):
     Note:
         Your code *must* return a value.
 
+    .. rubric:: GPU kernel cache
+
+    On the GPU, every MPI rank compiles the kernels at attach time. Set the
+    environment variable ``HOOMD_JIT_CACHE_DIR`` to a directory shared by all
+    ranks to compile each distinct program once: the first rank compiles it and
+    stores the result in the directory, while the other ranks wait and load the
+    stored kernels. Later jobs with the same code, HOOMD-blue build, and GPU
+    architecture also load the stored kernels.
+
     """
 
     @log(requires_run=True)
@@ -42,7 +42,7 @@ valid_attrs = [('betaP', hoomd.variant.Constant(10)),
                    'weight': 0.7,
                    'delta': [0.3] * 3,
                    'reduce': 0.1
-               })]
+               }), ('safe_scaling', True)]
 
 box_moves_attrs = [{
     'move': 'volume',
@@ -239,6 +239,44 @@ def test_disk_compression(betaP, box_move, simulation_factory,
     assert sim.state.box != initial_box
 
 
+_cube_vertices = [(-0.5, -0.5, -0.5), (-0.5, -0.5, 0.5), (-0.5, 0.5, -0.5),
+                  (-0.5, 0.5, 0.5), (0.5, -0.5, -0.5), (0.5, -0.5, 0.5),
+                  (0.5, 0.5, -0.5), (0.5, 0.5, 0.5)]
+
+
+@pytest.mark.parametrize("shape", ['sphere', 'cube'])
+@pytest.mark.parametrize("box_move", box_moves_attrs)
+def test_safe_scaling(shape, box_move, simulation_factory,
+                      lattice_snapshot_factory):
+    """Test that safe_scaling does not change the sampled boxes."""
+    boxes = []
+    for safe_scaling in [False, True]:
+        snap = lattice_snapshot_factory(dimensions=3, n=5, a=1.8)
+        sim = simulation_factory(snap)
+
+        boxmc = hoomd.hpmc.update.BoxMC(betaP=hoomd.variant.Constant(3))
+        boxmc.safe_scaling = safe_scaling
+        setattr(boxmc, box_move['move'], box_move['params'])
+        sim.operations.updaters.append(boxmc)
+
+        if shape == 'sphere':
+            mc = hoomd.hpmc.integrate.Sphere(default_d=0.05)
+            mc.shape['A'] = dict(diameter=1)
+        else:
+            mc = hoomd.hpmc.integrate.ConvexPolyhedron(default_d=0.05,
+                                                       default_a=0.05)
+            mc.shape['A'] = dict(vertices=_cube_vertices)
+        sim.operations.integrator = mc
+
+        sim.run(50)
+        assert mc.overlaps == 0
+        assert boxmc.safe_scaling == safe_scaling
+        boxes.append(sim.state.box)
+
+    # the test only skips overlap checks that cannot fail
+    assert boxes[0] == boxes[1]
+
+
 @pytest.mark.parametrize("box_move", box_moves_attrs)
 def test_counters(box_move, simulation_factory, lattice_snapshot_factory,
                   counter_attrs):
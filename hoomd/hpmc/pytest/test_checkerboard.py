@@ -0,0 +1,84 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Test checkerboard sweeps of HPMC trial moves."""
+
+import hoomd
+import pytest
+
+_cube_vertices = [
+    (-0.5, -0.5, -0.5),
+    (-0.5, -0.5, 0.5),
+    (-0.5, 0.5, -0.5),
+    (-0.5, 0.5, 0.5),
+    (0.5, -0.5, -0.5),
+    (0.5, -0.5, 0.5),
+    (0.5, 0.5, -0.5),
+    (0.5, 0.5, 0.5),
+]
+
+
+def test_checkerboard_default(simulation_factory, lattice_snapshot_factory):
+    mc = hoomd.hpmc.integrate.Sphere()
+    mc.shape['A'] = dict(diameter=1)
+    assert not mc.checkerboard
+
+    mc.checkerboard = True
+    sim = simulation_factory(lattice_snapshot_factory())
+    sim.operations.integrator = mc
+    sim.run(0)
+    assert mc.checkerboard
+
+    mc.checkerboard = False
+    assert not mc.checkerboard
+
+
+@pytest.mark.parametrize("dimensions", [2, 3])
+def test_checkerboard_spheres(simulation_factory, lattice_snapshot_factory,
+                              dimensions):
+    """Checkerboard sweeps move particles without creating overlaps."""
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.2)
+    mc.shape['A'] = dict(diameter=1)
+    mc.checkerboard = True
+
+    snap = lattice_snapshot_factory(dimensions=dimensions, n=10, a=1.2)
+    sim = simulation_factory(snap)
+    sim.operations.integrator = mc
+    sim.run(20)
+
+    accepted, rejected = mc.translate_moves
+    assert accepted > 0
+    assert rejected > 0
+    assert mc.overlaps == 0
+
+
+def test_checkerboard_cubes(simulation_factory, lattice_snapshot_factory):
+    """Checkerboard sweeps translate and rotate anisotropic particles."""
+    mc = hoomd.hpmc.integrate.ConvexPolyhedron(default_d=0.1, default_a=0.1)
+    mc.shape['A'] = dict(vertices=_cube_vertices)
+    mc.checkerboard = True
+
+    snap = lattice_snapshot_factory(n=8, a=1.8)
+    sim = simulation_factory(snap)
+    sim.operations.integrator = mc
+    sim.run(20)
+
+    assert sum(mc.translate_moves) > 0
+    assert sum(mc.rotate_moves) > 0
+    assert mc.overlaps == 0
+
+
+def test_checkerboard_small_box(simulation_factory, lattice_snapshot_factory):
+    """Boxes less than two cells wide fall back to serial sweeps."""
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.1)
+    mc.shape['A'] = dict(diameter=1)
+    mc.checkerboard = True
+
+    snap = lattice_snapshot_factory(n=1, a=1.5)
+    sim = simulation_factory(snap)
+    sim.operations.integrator = mc
+    sim.run(10)
+
+    assert sum(mc.translate_moves) > 0
+    assert mc.overlaps == 0
@@ -155,6 +155,34 @@ def test_pivot_moves(device, simulation_factory, lattice_snapshot_factory):
     assert avg > 0
 
 
+def test_pivot_moves_no_overlaps(device, simulation_factory,
+                                 lattice_snapshot_factory):
+    """Test that Clusters keeps hard particles free of overlaps."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                    dimensions=3,
+                                    a=1.5,
+                                    n=8,
+                                    r=0.1)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[::2] = 1
+    sim = simulation_factory(snap)
+
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.1, default_a=0.1)
+    mc.shape['A'] = dict(diameter=1.0)
+    mc.shape['B'] = dict(diameter=1.2)
+    sim.operations.integrator = mc
+
+    cl = hoomd.hpmc.update.Clusters(trigger=hoomd.trigger.Periodic(5),
+                                    pivot_move_probability=0.5)
+    sim.operations.updaters.append(cl)
+
+    sim.run(50)
+
+    assert mc.overlaps == 0
+    assert sim.state.N_particles == 8**3
+    assert cl.avg_cluster_size > 0
+
+
 def test_pickling(simulation_factory, two_particle_snapshot_factory):
     """Test that Cluster objects are picklable."""
     sim = simulation_factory(two_particle_snapshot_factory())
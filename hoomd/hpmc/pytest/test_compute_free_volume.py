@@ -74,6 +74,45 @@ def test_validation_systems(simulation_factory, two_particle_snapshot_factory,
                                rtol=2e-2)
 
 
+def test_persistent_samples(simulation_factory, lattice_snapshot_factory):
+    n = 7
+    radius1, radius2 = 0.25, 0.05
+    excluded_volume = (4 / 3) * np.pi * (radius1 + radius2)**3
+    sim = simulation_factory(
+        lattice_snapshot_factory(particle_types=['A', 'B'],
+                                 n=n,
+                                 a=1,
+                                 dimensions=3,
+                                 r=0))
+
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0, default_a=0)
+    mc.shape["A"] = {'diameter': radius1 * 2}
+    mc.shape["B"] = {'diameter': radius2 * 2}
+    sim.operations.add(mc)
+
+    free_volume_compute = hoomd.hpmc.compute.FreeVolume(
+        test_particle_type='B', num_samples=10000, persistent_samples=True)
+    sim.operations.add(free_volume_compute)
+    sim.run(0)
+
+    assert free_volume_compute.persistent_samples
+    np.testing.assert_allclose(n**3 * (1 - excluded_volume),
+                               free_volume_compute.free_volume,
+                               rtol=2e-2)
+
+    # place the second half of the particles on top of the first half
+    snap = sim.state.get_snapshot()
+    n_moved = snap.particles.N // 2
+    if snap.communicator.rank == 0:
+        snap.particles.position[-n_moved:] = snap.particles.position[:n_moved]
+    sim.state.set_snapshot(snap)
+    sim.run(1)
+
+    np.testing.assert_allclose(n**3 - (n**3 - n_moved) * excluded_volume,
+                               free_volume_compute.free_volume,
+                               rtol=2e-2)
+
+
 def test_logging():
     logging_check(
         hoomd.hpmc.compute.FreeVolume, ('hpmc', 'compute'),
@@ -0,0 +1,71 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Test event-chain HPMC integrators."""
+
+import hoomd
+import pytest
+
+_cube_vertices = [
+    (-0.5, -0.5, -0.5),
+    (-0.5, -0.5, 0.5),
+    (-0.5, 0.5, -0.5),
+    (-0.5, 0.5, 0.5),
+    (0.5, -0.5, -0.5),
+    (0.5, -0.5, 0.5),
+    (0.5, 0.5, -0.5),
+    (0.5, 0.5, 0.5),
+]
+
+
+def test_chain_length(simulation_factory, lattice_snapshot_factory):
+    mc = hoomd.hpmc.integrate.SphereEventChain(chain_length=2.0)
+    mc.shape['A'] = dict(diameter=1)
+    assert mc.chain_length == 2.0
+
+    sim = simulation_factory(lattice_snapshot_factory())
+    sim.operations.integrator = mc
+    sim.run(0)
+    assert mc.chain_length == 2.0
+
+    mc.chain_length = 0.5
+    assert mc.chain_length == 0.5
+
+
+@pytest.mark.parametrize("dimensions", [2, 3])
+def test_event_chain_spheres(simulation_factory, lattice_snapshot_factory,
+                             dimensions):
+    """Event chains move spheres without creating overlaps."""
+    mc = hoomd.hpmc.integrate.SphereEventChain(default_d=0.3,
+                                               chain_length=1.0)
+    mc.shape['A'] = dict(diameter=1)
+
+    snap = lattice_snapshot_factory(dimensions=dimensions, n=6, a=1.1)
+    sim = simulation_factory(snap)
+    sim.operations.integrator = mc
+    sim.run(10)
+
+    accepted, rejected = mc.translate_moves
+    assert accepted > 0
+    assert rejected == 0
+    assert mc.overlaps == 0
+
+
+@pytest.mark.parametrize("cls", [
+    hoomd.hpmc.integrate.ConvexPolyhedronEventChain,
+    hoomd.hpmc.integrate.ConvexSpheropolyhedronEventChain
+])
+def test_event_chain_cubes(simulation_factory, lattice_snapshot_factory, cls):
+    """Event chains translate and rotate anisotropic particles."""
+    mc = cls(default_d=0.3, default_a=0.1, chain_length=1.0)
+    mc.shape['A'] = dict(vertices=_cube_vertices, sweep_radius=0.05)
+
+    snap = lattice_snapshot_factory(n=4, a=1.8)
+    sim = simulation_factory(snap)
+    sim.operations.integrator = mc
+    sim.run(10)
+
+    assert sum(mc.translate_moves) > 0
+    assert sum(mc.rotate_moves) > 0
+    assert mc.overlaps == 0
@@ -1,6 +1,7 @@
 from math import isclose
 import pytest
 
+import hoomd
 from hoomd import hpmc
 from hoomd.conftest import operation_pickling_check
 from hoomd.hpmc.tune.move_size import (_MoveSizeTuneDefinition, MoveSize)
@@ -201,3 +202,38 @@ class TestMoveSize:
 
     def test_pickling(self, move_size_tuner, simulation):
         operation_pickling_check(move_size_tuner, simulation)
+
+
+class TestMoveSizeScale:
+
+    def test_attach(self, simulation):
+        tuner = hpmc.tune.MoveSizeScale(trigger=hoomd.trigger.Periodic(10),
+                                        moves=['d'],
+                                        target=0.5)
+        simulation.operations.tuners.append(tuner)
+        simulation.run(0)
+        assert tuner._attached
+        assert tuner.types == ['A']
+        assert isinstance(tuner.tuned, bool)
+
+        with pytest.raises(ValueError):
+            tuner.moves = ['f']
+
+    def test_act(self, simulation):
+        # the initial move size is too small, the acceptance rate is near 1
+        tuner = hpmc.tune.MoveSizeScale(trigger=hoomd.trigger.Periodic(10),
+                                        moves=['d'],
+                                        target=0.5,
+                                        max_translation_move=0.05)
+        simulation.operations.tuners.append(tuner)
+        d = simulation.operations.integrator.d['A']
+        simulation.run(100)
+        new_d = simulation.operations.integrator.d['A']
+        assert new_d > d
+        assert new_d <= 0.05
+
+    def test_pickling(self, simulation):
+        tuner = hpmc.tune.MoveSizeScale(trigger=hoomd.trigger.Periodic(10),
+                                        moves=['a', 'd'],
+                                        target=0.2)
+        operation_pickling_check(tuner, simulation)
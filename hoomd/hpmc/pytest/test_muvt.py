@@ -23,7 +23,7 @@ valid_attrs = [('trigger', hoomd.trigger.Periodic(10000)),
                ('trigger', hoomd.trigger.Before(12345)),
                ('volume_move_probability', 0.2), ('max_volume_rescale', 0.42),
                ('transfer_types', ['A']), ('transfer_types', ['B']),
-               ('transfer_types', ['A', 'B'])]
+               ('transfer_types', ['A', 'B']), ('ntrial_insert', 4)]
 
 
 @pytest.mark.serial
@@ -160,3 +160,32 @@ def test_insertion_removal(device, simulation_factory,
 
     # make a wild guess: there be B particles
     assert (muvt.N['B'] > 0)
+
+
+def test_insertion_removal_configurational_bias(device, simulation_factory,
+                                                lattice_snapshot_factory):
+    """Test MuVT insertions and removals with multiple trial positions."""
+    sim = simulation_factory(
+        lattice_snapshot_factory(particle_types=['A', 'B'],
+                                 dimensions=3,
+                                 a=2,
+                                 n=7,
+                                 r=0.1))
+
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.1, default_a=0.1)
+    mc.shape['A'] = dict(diameter=1.1)
+    mc.shape['B'] = dict(diameter=1.3)
+    sim.operations.integrator = mc
+
+    muvt = hoomd.hpmc.update.MuVT(trigger=hoomd.trigger.Periodic(5),
+                                  transfer_types=['B'])
+    muvt.ntrial_insert = 8
+    muvt.fugacity['B'] = 1
+    sim.operations.updaters.append(muvt)
+
+    sim.run(100)
+    assert muvt.ntrial_insert == 8
+    assert sum(muvt.insert_moves) > 0
+    assert sum(muvt.remove_moves) > 0
+    assert muvt.N['B'] > 0
+    assert mc.overlaps == 0
@@ -0,0 +1,72 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Test hoomd.hpmc.pair.Table."""
+
+import hoomd
+import pytest
+import numpy as np
+
+r_min = 0.8
+r_cut = 2.5
+N_table = 100
+
+
+def linear_energy(r):
+    """A potential that linear interpolation reproduces exactly."""
+    return -3.0 * (r_cut - r)
+
+
+def make_table():
+    r = np.linspace(r_min, r_cut, N_table, endpoint=False)
+    table = hoomd.hpmc.pair.Table(r_cut=r_cut)
+    table.params[('A', 'A')] = dict(r_min=r_min, U=linear_energy(r))
+    return table
+
+
+def test_before_attaching():
+    table = make_table()
+    assert table.r_cut == r_cut
+    assert table.params[('A', 'A')]['r_min'] == r_min
+    assert len(table.params[('A', 'A')]['U']) == N_table
+
+
+def test_after_attaching(simulation_factory, two_particle_snapshot_factory):
+    table = make_table()
+    mc = hoomd.hpmc.integrate.Sphere()
+    mc.shape['A'] = dict(diameter=0)
+    mc.pair_potential = table
+
+    sim = simulation_factory(two_particle_snapshot_factory(d=1, L=20))
+    sim.operations.integrator = mc
+    sim.run(0)
+    assert table._attached
+
+    params = table.params[('A', 'A')]
+    assert params['r_min'] == pytest.approx(r_min)
+    np.testing.assert_allclose(
+        params['U'],
+        linear_energy(np.linspace(r_min, r_cut, N_table, endpoint=False)),
+        rtol=1e-6)
+
+    table.r_cut = 3.0
+    assert table.r_cut == 3.0
+
+
+@pytest.mark.validate
+@pytest.mark.parametrize("d,result", [(0.5, 0), (1.0, linear_energy(1.0)),
+                                      (1.7, linear_energy(1.7)),
+                                      (2.49, linear_energy(2.49)), (2.6, 0)])
+def test_energy(simulation_factory, two_particle_snapshot_factory, d, result):
+    """Test that Table interpolates the tabulated energy."""
+    table = make_table()
+    mc = hoomd.hpmc.integrate.Sphere()
+    mc.shape['A'] = dict(diameter=0)
+    mc.pair_potential = table
+
+    sim = simulation_factory(two_particle_snapshot_factory(d=d, L=20))
+    sim.operations.integrator = mc
+    sim.run(0)
+
+    assert table.energy == pytest.approx(result, abs=1e-5)
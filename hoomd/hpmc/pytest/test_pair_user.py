@@ -351,3 +351,34 @@ def test_cpp_potential_sticky_spheres(device, simulation_factory,
             dist = np.linalg.norm(snap.particles.position[0]
                                   - snap.particles.position[1])
             assert dist > max_r_interact
+
+
+@pytest.mark.validate
+@pytest.mark.skipif(llvm_disabled, reason='LLVM not enabled')
+def test_jit_cache(device, simulation_factory, two_particle_snapshot_factory,
+                   tmp_path):
+    """Test that compiled code is stored in and loaded from the cache."""
+    assert device.jit_cache is None
+    device.jit_cache = tmp_path
+    assert device.jit_cache == str(tmp_path)
+
+    energies = []
+    for i in range(2):
+        patch = hoomd.hpmc.pair.user.CPPPotential(r_cut=3,
+                                                  param_array=[],
+                                                  code='return -1;')
+        mc = hoomd.hpmc.integrate.Sphere()
+        mc.shape['A'] = dict(diameter=1)
+        mc.pair_potential = patch
+        sim = simulation_factory(two_particle_snapshot_factory(d=2))
+        sim.operations.integrator = mc
+        sim.run(0)
+        energies.append(patch.energy)
+
+        # the first attach compiles the code and stores it
+        assert len(list(tmp_path.glob('hoomd-jit-*.bc'))) == 1
+
+    assert energies[0] == energies[1] == -1
+
+    device.jit_cache = None
+    assert device.jit_cache is None
@@ -24,6 +24,9 @@ valid_constructor_args = [
          target_box=hoomd.Box.from_box([80, 50, 40, 0.2, 0.4, 0.5]),
          max_overlaps_per_particle=0.2,
          min_scale=0.999),
+    dict(trigger=hoomd.trigger.Periodic(10),
+         target_box=hoomd.Box.from_box([10, 10, 10]),
+         gap_scaling=True),
 ]
 
 valid_attrs = [
@@ -38,6 +41,8 @@ valid_attrs = [
     ('min_scale', 0.1),
     ('min_scale', 0.5),
     ('min_scale', 0.9999),
+    ('gap_scaling', True),
+    ('gap_scaling', False),
 ]
 
 
@@ -173,6 +178,35 @@ def test_disk_compression(phi, simulation_factory, lattice_snapshot_factory):
     assert sim.state.box == target_box
 
 
+@pytest.mark.parametrize("phi", [0.2, 0.5])
+@pytest.mark.validate
+def test_sphere_compression_gap_scaling(phi, simulation_factory,
+                                        lattice_snapshot_factory):
+    """Test that QuickCompress can compress with gap_scaling."""
+    n = 7
+    snap = lattice_snapshot_factory(n=n, a=3.0)
+    v_particle = 4 / 3 * math.pi * (0.5)**3
+    target_box = hoomd.Box.cube((n * n * n * v_particle / phi)**(1 / 3))
+
+    qc = hoomd.hpmc.update.QuickCompress(trigger=hoomd.trigger.Periodic(10),
+                                         target_box=target_box,
+                                         gap_scaling=True)
+
+    sim = simulation_factory(snap)
+    sim.operations.updaters.append(qc)
+
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.05)
+    mc.shape['A'] = dict(diameter=1)
+    sim.operations.integrator = mc
+
+    while not qc.complete and sim.timestep < 1e5:
+        sim.run(100)
+
+    assert qc.complete
+    assert mc.overlaps == 0
+    assert sim.state.box == target_box
+
+
 def test_pickling(simulation_factory, two_particle_snapshot_factory):
     """Test that QuickCompress objects are picklable."""
     qc = hoomd.hpmc.update.QuickCompress(trigger=hoomd.trigger.Periodic(10),
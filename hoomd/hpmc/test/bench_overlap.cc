@@ -0,0 +1,276 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file bench_overlap.cc
+    \brief Measures the throughput of the shape overlap checks
+
+    Each benchmark checks a fixed set of random pairs of shapes for overlaps. The separations
+    range from zero to the circumsphere diameter, so the set mixes overlapping pairs, pairs
+    that the early exits reject, and pairs that need the full check. Run the executable after
+    changes to the shapes, VectorMath.h, or HOOMDMath.h and compare the overlap checks per
+    second (items/s) with the previous build.
+*/
+
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/GlobalArray.h"
+#include "hoomd/managed_allocator.h"
+#include "hoomd/test/microbenchmark.h"
+
+#include "hoomd/hpmc/ShapeConvexPolygon.h"
+#include "hoomd/hpmc/ShapeConvexPolyhedron.h"
+#include "hoomd/hpmc/ShapeEllipsoid.h"
+#include "hoomd/hpmc/ShapeSimplePolygon.h"
+#include "hoomd/hpmc/ShapeSphere.h"
+#include "hoomd/hpmc/ShapeSpheropolygon.h"
+#include "hoomd/hpmc/ShapeSpheropolyhedron.h"
+
+#ifdef ENABLE_HIP
+#include "bench_overlap.cuh"
+#endif
+
+#include <pybind11/embed.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace hoomd;
+using namespace hoomd::hpmc;
+using namespace hoomd::hpmc::detail;
+using namespace hoomd::test;
+using namespace pybind11::literals;
+
+//! Number of pairs of shapes checked in one iteration
+const unsigned int n_samples = 4096;
+
+//! Random separations and orientations of pairs of shapes
+struct OverlapSamples
+    {
+    //! Generate the samples
+    /*! \param max_distance Largest separation
+        \param dim Dimensionality of the shapes. 2D shapes are in the xy plane and rotate about z.
+    */
+    OverlapSamples(Scalar max_distance, unsigned int dim)
+        {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<Scalar> uniform(0.0, 1.0);
+        std::normal_distribution<Scalar> normal(0.0, 1.0);
+
+        auto random_orientation = [&]()
+        {
+            if (dim == 2)
+                return quat<Scalar>::fromAxisAngle(vec3<Scalar>(0, 0, 1),
+                                                   Scalar(2.0 * M_PI) * uniform(rng));
+
+            quat<Scalar> q(normal(rng), vec3<Scalar>(normal(rng), normal(rng), normal(rng)));
+            return q * fast::rsqrt(norm2(q));
+        };
+
+        for (unsigned int i = 0; i < n_samples; i++)
+            {
+            vec3<Scalar> direction(normal(rng), normal(rng), dim == 2 ? 0 : normal(rng));
+            direction = direction * fast::rsqrt(dot(direction, direction));
+            r.push_back(direction * (max_distance * uniform(rng)));
+            orientation_a.push_back(random_orientation());
+            orientation_b.push_back(random_orientation());
+            }
+        }
+
+    std::vector<vec3<Scalar>> r;             //!< Vector from the first to the second shape
+    std::vector<quat<Scalar>> orientation_a; //!< Orientation of the first shape
+    std::vector<quat<Scalar>> orientation_b; //!< Orientation of the second shape
+    };
+
+//! Register the CPU and GPU benchmarks of one shape
+/*! \param registry Registry to add the benchmarks to
+    \param name Name of the benchmark
+    \param params Shape parameters as the Python API sets them
+    \param dim Dimensionality of the shape
+    \param gpu_exec_conf Execution configuration of the GPU benchmarks, null to skip them
+*/
+template<class Shape>
+void add_overlap_benchmarks(MicroBenchmarkRegistry& registry,
+                            const std::string& name,
+                            pybind11::dict params,
+                            unsigned int dim,
+                            std::shared_ptr<ExecutionConfiguration> gpu_exec_conf)
+    {
+    auto param = std::make_shared<typename Shape::param_type>(params, false);
+    Scalar max_distance = Shape(quat<Scalar>(), *param).getCircumsphereDiameter();
+    auto samples = std::make_shared<const OverlapSamples>(max_distance, dim);
+
+    registry.add("overlap/" + name + "/cpu",
+                 [param, samples](MicroBenchmarkState& state)
+                 {
+                     for (uint64_t iteration = 0; iteration < state.iterations(); iteration++)
+                         {
+                         for (unsigned int i = 0; i < n_samples; i++)
+                             {
+                             Shape a(samples->orientation_a[i], *param);
+                             Shape b(samples->orientation_b[i], *param);
+                             unsigned int err = 0;
+                             bool overlap = test_overlap(samples->r[i], a, b, err);
+                             do_not_optimize(overlap);
+                             }
+                         }
+                     state.setItemsPerIteration(n_samples);
+                 });
+
+#ifdef ENABLE_HIP
+    if (!gpu_exec_conf)
+        return;
+
+    // the shape parameters may point to variable length arrays, which must be in managed memory
+    typedef std::vector<typename Shape::param_type,
+                        hoomd::detail::managed_allocator<typename Shape::param_type>>
+        param_vector;
+    auto gpu_params = std::make_shared<param_vector>(
+        1,
+        typename Shape::param_type(params, true),
+        hoomd::detail::managed_allocator<typename Shape::param_type>(true));
+
+    registry.add(
+        "overlap/" + name + "/gpu",
+        [gpu_params, samples, gpu_exec_conf](MicroBenchmarkState& state)
+        {
+            GlobalArray<Scalar3> r(n_samples, gpu_exec_conf);
+            GlobalArray<Scalar4> orientation_a(n_samples, gpu_exec_conf);
+            GlobalArray<Scalar4> orientation_b(n_samples, gpu_exec_conf);
+            GlobalArray<unsigned int> overlap(n_samples, gpu_exec_conf);
+                {
+                ArrayHandle<Scalar3> h_r(r, access_location::host, access_mode::overwrite);
+                ArrayHandle<Scalar4> h_orientation_a(orientation_a,
+                                                     access_location::host,
+                                                     access_mode::overwrite);
+                ArrayHandle<Scalar4> h_orientation_b(orientation_b,
+                                                     access_location::host,
+                                                     access_mode::overwrite);
+                for (unsigned int i = 0; i < n_samples; i++)
+                    {
+                    h_r.data[i] = vec_to_scalar3(samples->r[i]);
+                    h_orientation_a.data[i] = quat_to_scalar4(samples->orientation_a[i]);
+                    h_orientation_b.data[i] = quat_to_scalar4(samples->orientation_b[i]);
+                    }
+                }
+
+            ArrayHandle<Scalar3> d_r(r, access_location::device, access_mode::read);
+            ArrayHandle<Scalar4> d_orientation_a(orientation_a,
+                                                 access_location::device,
+                                                 access_mode::read);
+            ArrayHandle<Scalar4> d_orientation_b(orientation_b,
+                                                 access_location::device,
+                                                 access_mode::read);
+            ArrayHandle<unsigned int> d_overlap(overlap,
+                                                access_location::device,
+                                                access_mode::overwrite);
+
+            double elapsed_time = 0.0;
+            hipError_t error = gpu_bench_overlap<Shape>(d_overlap.data,
+                                                        d_r.data,
+                                                        d_orientation_a.data,
+                                                        d_orientation_b.data,
+                                                        n_samples,
+                                                        gpu_params->data(),
+                                                        state.iterations(),
+                                                        elapsed_time);
+            if (error != hipSuccess)
+                throw std::runtime_error(std::string("Error running benchmark: ")
+                                         + hipGetErrorString(error));
+
+            state.setManualTime(elapsed_time);
+            state.setItemsPerIteration(n_samples);
+        });
+#endif
+    }
+
+//! Make a Python list of vertices
+/*! \param vertices Coordinates of each vertex
+ */
+pybind11::list make_vertices(const std::vector<std::vector<Scalar>>& vertices)
+    {
+    pybind11::list result;
+    for (const auto& vertex : vertices)
+        {
+        pybind11::list v;
+        for (Scalar x : vertex)
+            v.append(x);
+        result.append(v);
+        }
+    return result;
+    }
+
+int main(int argc, char** argv)
+    {
+    // the param_type constructors take Python dictionaries
+    pybind11::scoped_interpreter guard {};
+
+    MicroBenchmarkRegistry registry;
+
+    std::shared_ptr<ExecutionConfiguration> gpu_exec_conf;
+#ifdef ENABLE_HIP
+    if (ExecutionConfiguration::getCapableDevices().size() > 0)
+        gpu_exec_conf = std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::GPU));
+#endif
+
+    std::vector<std::vector<Scalar>> cube;
+    for (Scalar x : {-0.5, 0.5})
+        for (Scalar y : {-0.5, 0.5})
+            for (Scalar z : {-0.5, 0.5})
+                cube.push_back({x, y, z});
+    std::vector<std::vector<Scalar>> square = {{-0.5, -0.5}, {0.5, -0.5}, {0.5, 0.5}, {-0.5, 0.5}};
+
+    auto polyhedron = [&](Scalar sweep_radius)
+    {
+        return pybind11::dict("vertices"_a = make_vertices(cube),
+                              "sweep_radius"_a = sweep_radius,
+                              "ignore_statistics"_a = false);
+    };
+    auto polygon = [&](Scalar sweep_radius)
+    {
+        return pybind11::dict("vertices"_a = make_vertices(square),
+                              "sweep_radius"_a = sweep_radius,
+                              "ignore_statistics"_a = false);
+    };
+
+    add_overlap_benchmarks<ShapeSphere>(
+        registry,
+        "Sphere",
+        pybind11::dict("diameter"_a = 1.0, "orientable"_a = false, "ignore_statistics"_a = false),
+        3,
+        gpu_exec_conf);
+    add_overlap_benchmarks<ShapeEllipsoid>(
+        registry,
+        "Ellipsoid",
+        pybind11::dict("a"_a = 0.5, "b"_a = 0.25, "c"_a = 0.125, "ignore_statistics"_a = false),
+        3,
+        gpu_exec_conf);
+    add_overlap_benchmarks<ShapeConvexPolyhedron>(registry,
+                                                  "ConvexPolyhedron",
+                                                  polyhedron(0.0),
+                                                  3,
+                                                  gpu_exec_conf);
+    add_overlap_benchmarks<ShapeSpheropolyhedron>(registry,
+                                                  "Spheropolyhedron",
+                                                  polyhedron(0.1),
+                                                  3,
+                                                  gpu_exec_conf);
+    add_overlap_benchmarks<ShapeConvexPolygon>(registry,
+                                               "ConvexPolygon",
+                                               polygon(0.0),
+                                               2,
+                                               gpu_exec_conf);
+    add_overlap_benchmarks<ShapeSpheropolygon>(registry,
+                                               "Spheropolygon",
+                                               polygon(0.1),
+                                               2,
+                                               gpu_exec_conf);
+    add_overlap_benchmarks<ShapeSimplePolygon>(registry,
+                                               "SimplePolygon",
+                                               polygon(0.0),
+                                               2,
+                                               gpu_exec_conf);
+
+    return registry.run(argc, argv);
+    }
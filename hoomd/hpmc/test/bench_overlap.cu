@@ -0,0 +1,113 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "bench_overlap.cuh"
+
+#include "hoomd/hpmc/ShapeConvexPolygon.h"
+#include "hoomd/hpmc/ShapeConvexPolyhedron.h"
+#include "hoomd/hpmc/ShapeEllipsoid.h"
+#include "hoomd/hpmc/ShapeSimplePolygon.h"
+#include "hoomd/hpmc/ShapeSphere.h"
+#include "hoomd/hpmc/ShapeSpheropolygon.h"
+#include "hoomd/hpmc/ShapeSpheropolyhedron.h"
+
+/*! \file bench_overlap.cu
+    \brief GPU kernels of bench_overlap.cc
+*/
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+namespace test
+    {
+namespace kernel
+    {
+//! Check one sample pair of shapes for overlaps per thread
+template<class Shape>
+__global__ void bench_overlap(unsigned int* d_overlap,
+                              const Scalar3* d_r,
+                              const Scalar4* d_orientation_a,
+                              const Scalar4* d_orientation_b,
+                              const unsigned int n,
+                              const typename Shape::param_type* d_params)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= n)
+        return;
+
+    Shape a(quat<Scalar>(d_orientation_a[idx]), d_params[0]);
+    Shape b(quat<Scalar>(d_orientation_b[idx]), d_params[0]);
+    unsigned int err = 0;
+    d_overlap[idx] = test_overlap(vec3<Scalar>(d_r[idx]), a, b, err);
+    }
+
+    } // end namespace kernel
+
+template<class Shape>
+hipError_t gpu_bench_overlap(unsigned int* d_overlap,
+                             const Scalar3* d_r,
+                             const Scalar4* d_orientation_a,
+                             const Scalar4* d_orientation_b,
+                             unsigned int n,
+                             const typename Shape::param_type* d_params,
+                             uint64_t iterations,
+                             double& elapsed_time)
+    {
+    const unsigned int block_size = 128;
+
+    hipEvent_t start, stop;
+    hipEventCreate(&start);
+    hipEventCreate(&stop);
+
+    hipEventRecord(start, 0);
+    for (uint64_t i = 0; i < iterations; i++)
+        {
+        hipLaunchKernelGGL((kernel::bench_overlap<Shape>),
+                           dim3(n / block_size + 1),
+                           dim3(block_size),
+                           0,
+                           0,
+                           d_overlap,
+                           d_r,
+                           d_orientation_a,
+                           d_orientation_b,
+                           n,
+                           d_params);
+        }
+    hipEventRecord(stop, 0);
+    hipEventSynchronize(stop);
+
+    float elapsed_ms;
+    hipEventElapsedTime(&elapsed_ms, start, stop);
+    elapsed_time = double(elapsed_ms) * 1e-3;
+
+    hipEventDestroy(start);
+    hipEventDestroy(stop);
+    return hipGetLastError();
+    }
+
+//! Explicit template instantiations
+#define INSTANTIATE_BENCH_OVERLAP(Shape)                                                     \
+    template hipError_t gpu_bench_overlap<Shape>(unsigned int* d_overlap,                    \
+                                                 const Scalar3* d_r,                         \
+                                                 const Scalar4* d_orientation_a,             \
+                                                 const Scalar4* d_orientation_b,             \
+                                                 unsigned int n,                             \
+                                                 const typename Shape::param_type* d_params, \
+                                                 uint64_t iterations,                        \
+                                                 double& elapsed_time);
+
+INSTANTIATE_BENCH_OVERLAP(ShapeSphere)
+INSTANTIATE_BENCH_OVERLAP(ShapeEllipsoid)
+INSTANTIATE_BENCH_OVERLAP(ShapeConvexPolyhedron)
+INSTANTIATE_BENCH_OVERLAP(ShapeSpheropolyhedron)
+INSTANTIATE_BENCH_OVERLAP(ShapeConvexPolygon)
+INSTANTIATE_BENCH_OVERLAP(ShapeSpheropolygon)
+INSTANTIATE_BENCH_OVERLAP(ShapeSimplePolygon)
+
+#undef INSTANTIATE_BENCH_OVERLAP
+
+    } // end namespace test
+    } // end namespace hpmc
+    } // end namespace hoomd
@@ -0,0 +1,41 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file bench_overlap.cuh
+    \brief Declares the GPU kernel drivers of bench_overlap.cc
+*/
+
+#pragma once
+
+#include "hoomd/HOOMDMath.h"
+#include <hip/hip_runtime.h>
+
+namespace hoomd
+    {
+namespace hpmc
+    {
+namespace test
+    {
+//! Check every sample pair of shapes for overlaps, repeatedly
+/*! \param d_overlap Set to 1 when the pair overlaps and 0 otherwise
+    \param d_r Vector from the first to the second shape of each sample
+    \param d_orientation_a Orientation of the first shape of each sample
+    \param d_orientation_b Orientation of the second shape of each sample
+    \param n Number of samples
+    \param d_params Shape parameters (in managed memory)
+    \param iterations Number of times to check all samples
+    \param elapsed_time Set to the time of all kernel launches (in seconds)
+*/
+template<class Shape>
+hipError_t gpu_bench_overlap(unsigned int* d_overlap,
+                             const Scalar3* d_r,
+                             const Scalar4* d_orientation_a,
+                             const Scalar4* d_orientation_b,
+                             unsigned int n,
+                             const typename Shape::param_type* d_params,
+                             uint64_t iterations,
+                             double& elapsed_time);
+
+    } // end namespace test
+    } // end namespace hpmc
+    } // end namespace hoomd
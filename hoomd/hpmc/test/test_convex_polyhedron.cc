@@ -83,6 +83,43 @@ UP_TEST(support)
     UP_ASSERT(v1 == v2);
     }
 
+UP_TEST(support_many_vertices)
+    {
+    // Compare the vectorized support function to a brute force search. The vertices are offset
+    // from the origin so that the zero padding of the vertex arrays is never the support.
+    for (unsigned int N = 1; N <= 40; N++)
+        {
+        vector<vec3<OverlapReal>> vlist;
+        for (unsigned int i = 0; i < N; i++)
+            {
+            // points on a Fibonacci sphere
+            OverlapReal z = OverlapReal(1.0) - OverlapReal(2 * i + 1) / OverlapReal(N);
+            OverlapReal r = sqrt(OverlapReal(1.0) - z * z);
+            OverlapReal phi = OverlapReal(2.399963229728653) * OverlapReal(i);
+            vlist.push_back(vec3<OverlapReal>(r * cos(phi) + OverlapReal(2.0), r * sin(phi), z));
+            }
+        PolyhedronVertices verts(vlist, 0, 0);
+        SupportFuncConvexPolyhedron sa = SupportFuncConvexPolyhedron(verts);
+
+        for (unsigned int k = 0; k < 50; k++)
+            {
+            OverlapReal theta = OverlapReal(0.37) + OverlapReal(0.71) * OverlapReal(k);
+            OverlapReal cos_phi = OverlapReal(1.0) - OverlapReal(2 * k + 1) / OverlapReal(50);
+            OverlapReal sin_phi = sqrt(OverlapReal(1.0) - cos_phi * cos_phi);
+            vec3<OverlapReal> n(sin_phi * cos(theta), sin_phi * sin(theta), cos_phi);
+
+            unsigned int max_idx = 0;
+            for (unsigned int i = 1; i < N; i++)
+                {
+                if (dot(n, vlist[i]) > dot(n, vlist[max_idx]))
+                    max_idx = i;
+                }
+
+            UP_ASSERT(sa(n) == vlist[max_idx]);
+            }
+        }
+    }
+
 /*! Not sure how best to test this because not sure what a valid support has to be...
 UP_TEST( composite_support )
     {
@@ -1,3 +1,3 @@
 """Tuners for HPMC."""
 
-from hoomd.hpmc.tune.move_size import MoveSize
+from hoomd.hpmc.tune.move_size import MoveSize, MoveSizeScale
@@ -5,6 +5,10 @@
 """Implement MoveSize."""
 
 from hoomd.custom import _InternalAction
+from hoomd.hpmc import _hpmc
+from hoomd.operation import Tuner
+from hoomd.trigger import Trigger
+from hoomd.logging import log
 from hoomd.data.parameterdicts import ParameterDict, TypeParameterDict
 from hoomd.data.typeparam import TypeParameter
 from hoomd.data.typeconverter import (OnlyFrom, OnlyTypes, OnlyIf,
@@ -421,3 +425,135 @@ class MoveSize(_InternalCustomTuner):
         solver = SecantSolver(gamma, tol)
         return cls(trigger, moves, target, solver, types, max_translation_move,
                    max_rotation_move)
+
+
+class MoveSizeScale(Tuner):
+    """Tune HPMCIntegrator move sizes to a target acceptance rate in C++.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps at which to
+            adjust the move sizes.
+        moves (list[str]): A list of types of moves to tune. Available options
+            are ``'a'`` and ``'d'``.
+        target (float): The acceptance rate for trial moves that is desired. The
+            value should be between 0 and 1.
+        types (list[str]): A list of string particle types to tune the move
+            size for, defaults to None which upon attaching will tune all types
+            in the system currently.
+        max_translation_move (float): The maximum value of a translational move
+            size to attempt :math:`[\\mathrm{length}]`, defaults to no maximum.
+        max_rotation_move (float): The maximum value of a rotational move size
+            to attempt, defaults to no maximum.
+        max_scale (float): Maximum scale factor.
+        gamma (float): Controls the size of corrections to the move size
+            (larger values increase stability while increasing convergence
+            time).
+        tol (float): The absolute tolerance to allow between the current
+            acceptance rate and the target before the move sizes are considered
+            tuned.
+
+    `MoveSizeScale` applies the same update as `MoveSize.scale_solver`, but
+    computes it in C++ from the acceptance counters of the moves made since the
+    previous triggered timestep. It does not call back into Python while the
+    simulation runs. With MPI domain decomposition, the counters are summed
+    over all ranks and all ranks set the same move sizes.
+
+    Each time it is triggered, `MoveSizeScale` multiplies the move sizes of
+    *types* by
+
+    .. math::
+
+        \\min \\left( \\frac{r + \\gamma}{r_\\mathrm{target} + \\gamma},
+        s_\\mathrm{max} \\right)
+
+    where :math:`r` is the acceptance rate and :math:`s_\\mathrm{max}` is
+    *max_scale*, unless :math:`r` is within *tol* of the target.
+
+    Note:
+        Like `MoveSize`, `MoveSizeScale` tunes the move sizes of all *types*
+        with the *global* acceptance rate. Set ``ignore_statistics`` in the
+        shape parameters of the types that should not contribute.
+
+    Example::
+
+        tuner = hoomd.hpmc.tune.MoveSizeScale(
+            trigger=hoomd.trigger.Periodic(100),
+            moves=['a', 'd'],
+            target=0.2)
+        sim.operations.tuners.append(tuner)
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps at which to
+            adjust the move sizes.
+        moves (list[str]): A list of types of moves to tune. Available options
+            are ``'a'`` and ``'d'``.
+        target (float): The acceptance rate for trial moves that is desired. The
+            value should be between 0 and 1.
+        types (list[str]): A list of string particle types to tune the move
+            size for.
+        max_translation_move (float): The maximum value of a translational move
+            size to attempt :math:`[\\mathrm{length}]`.
+        max_rotation_move (float): The maximum value of a rotational move size
+            to attempt.
+        max_scale (float): Maximum scale factor.
+        gamma (float): Controls the size of corrections to the move size.
+        tol (float): The absolute tolerance to allow between the current
+            acceptance rate and the target before the move sizes are considered
+            tuned.
+    """
+
+    def __init__(self,
+                 trigger,
+                 moves,
+                 target,
+                 types=None,
+                 max_translation_move=float('inf'),
+                 max_rotation_move=float('inf'),
+                 max_scale=2.,
+                 gamma=1.,
+                 tol=1e-2):
+        param_dict = ParameterDict(
+            trigger=Trigger,
+            moves=OnlyIf(to_type_converter([OnlyFrom(['a', 'd'])])),
+            types=OnlyIf(to_type_converter([str]), allow_none=True),
+            target=float,
+            max_translation_move=float,
+            max_rotation_move=float,
+            max_scale=float,
+            gamma=float,
+            tol=float)
+        param_dict.update(
+            dict(trigger=trigger,
+                 moves=moves,
+                 target=target,
+                 types=types,
+                 max_translation_move=max_translation_move,
+                 max_rotation_move=max_rotation_move,
+                 max_scale=max_scale,
+                 gamma=gamma,
+                 tol=tol))
+        self._param_dict.update(param_dict)
+
+    def _attach(self):
+        integrator = self._simulation.operations.integrator
+        if not isinstance(integrator, HPMCIntegrator):
+            raise RuntimeError("MoveSizeScale can only be used in HPMC "
+                               "simulations.")
+
+        particle_types = self._simulation.state.particle_types
+        if self.types is None:
+            self.types = particle_types
+        if not all(t in particle_types for t in self.types):
+            raise RuntimeError(
+                "Invalid particle type found specified types for tuning.")
+
+        self._cpp_obj = _hpmc.MoveSizeScaleTuner(
+            self._simulation.state._cpp_sys_def, self.trigger,
+            integrator._cpp_obj, self.moves, self.types, self.target)
+        super()._attach()
+
+    @log(requires_run=True)
+    def tuned(self):
+        """bool: True when the acceptance rates have been within the tolerance \
+        of the target for two consecutive updates."""
+        return self._cpp_obj.tuned
@@ -80,6 +80,13 @@ class BoxMC(Updater):
             When using multiple `BoxMC` updaters in a single simulation,
             give each a unique value for `instance` so they generate
             different streams of random numbers.
+
+        safe_scaling (bool):
+            When `True`, first test whether a trial box can bring any two
+            particle circumspheres into contact. Trial boxes that keep all
+            circumspheres apart skip the full overlap check. This is exact and
+            saves time on small box moves of shapes with expensive overlap
+            checks. Defaults to `False`.
     """
 
     def __init__(self, betaP, trigger=1):
@@ -97,12 +104,14 @@ class BoxMC(Updater):
                                               reduce=0.0),
                                    betaP=hoomd.variant.Variant,
                                    instance=int,
+                                   safe_scaling=bool,
                                    _defaults={'volume': {
                                        'mode': 'standard'
                                    }})
         self._param_dict.update(param_dict)
         self.betaP = betaP
         self.instance = 0
+        self.safe_scaling = False
 
     def _add(self, simulation):
         """Add the operation to a simulation.
@@ -374,6 +383,20 @@ class MuVT(Updater):
           (applies to Gibbs ensemble)
         ntrial (float): (**default**: 1) Number of configurational bias attempts
           to swap depletants
+        ntrial_insert (int): (**default**: 1) Number of trial positions for
+          configurational bias insertion and removal moves
+
+    When `ntrial_insert` is larger than 1, every insertion move proposes
+    `ntrial_insert` random positions and orientations, evaluates them all in
+    one pass, and picks one of them with a probability proportional to its
+    Boltzmann weight. Removal moves weigh the removed particle together with
+    ``ntrial_insert - 1`` trial insertions. This Rosenbluth scheme raises the
+    acceptance rate of insertions in dense systems. It is not supported in
+    Gibbs ensembles or with depletants.
+
+    On the GPU, `MuVT` checks the trial insertions for overlaps on the device.
+    Simulations with a patch energy or depletants compute the insertion and
+    removal weights on the CPU.
     """
 
     def __init__(self,
@@ -386,7 +409,7 @@ class MuVT(Updater):
 
         self.ngibbs = int(ngibbs)
 
-        _default_dict = dict(ntrial=1)
+        _default_dict = dict(ntrial=1, ntrial_insert=1)
         param_dict = ParameterDict(
             transfer_types=list(transfer_types),
             max_volume_rescale=float(max_volume_rescale),
@@ -409,10 +432,21 @@ class MuVT(Updater):
 
         cpp_cls_name = "UpdaterMuVT"
         cpp_cls_name += integrator.__class__.__name__
+        use_gpu = (isinstance(self._simulation.device, hoomd.device.GPU)
+                   and (cpp_cls_name + 'GPU') in _hpmc.__dict__)
+        if use_gpu:
+            cpp_cls_name += "GPU"
         cpp_cls = getattr(_hpmc, cpp_cls_name)
 
-        self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
-                                integrator._cpp_obj, self.ngibbs)
+        if use_gpu:
+            sys_def = self._simulation.state._cpp_sys_def
+            self._cpp_cell = _hoomd.CellListGPU(sys_def)
+            self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
+                                    integrator._cpp_obj, self.ngibbs,
+                                    self._cpp_cell)
+        else:
+            self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
+                                    integrator._cpp_obj, self.ngibbs)
         super()._attach()
 
     @log(category='sequence', requires_run=True)
@@ -502,6 +536,14 @@ class Clusters(Updater):
 
     The `Clusters` updater support threaded execution on multiple CPU cores.
 
+    .. rubric:: MPI
+
+    With domain decomposition, each rank tests the transformed particles that
+    land in its domain against its old configuration, and the clusters are
+    merged across ranks by exchanging cluster labels, so clusters may span any
+    number of domains. Patch energies and depletants are not supported with
+    domain decomposition.
+
     Attributes:
         pivot_move_probability (float): Set the probability for attempting a
                                         pivot move.
@@ -588,6 +630,9 @@ class QuickCompress(Updater):
 
         min_scale (float): The minimum scale factor to apply to box dimensions.
 
+        gap_scaling (bool): When `True`, also allow box moves as large as the
+            gaps between particles permit.
+
     Use `QuickCompress` in conjunction with an HPMC integrator to scale the
     system to a target box size. `QuickCompress` can typically compress dilute
     systems to near random close packing densities in tens of thousands of time
@@ -615,6 +660,13 @@ class QuickCompress(Updater):
     by the acceptance ratio and ``max_diameter`` is the circumsphere diameter
     of the largest particle type.
 
+    When `gap_scaling` is `True`, `QuickCompress` also computes the largest
+    ``lambda`` such that scaling every pair separation by ``1 - lambda``
+    creates no overlaps (the contact scale factor used by
+    `hoomd.hpmc.compute.SDF`) and uses ``scale = min(scale, 1 - 0.99 *
+    lambda)``. Dilute systems then reach high densities in a few large steps.
+    ``lambda`` is at most 0.5.
+
     Tip:
         Use the `hoomd.hpmc.tune.MoveSize` in conjunction with
         `QuickCompress` to adjust the move sizes to maintain a constant
@@ -636,6 +688,9 @@ class QuickCompress(Updater):
 
         min_scale (float): The minimum scale factor to apply to box dimensions.
 
+        gap_scaling (bool): When `True`, also allow box moves as large as the
+            gaps between particles permit.
+
         instance (int):
             When using multiple `QuickCompress` updaters in a single simulation,
             give each a unique value for `instance` so that they generate
@@ -646,18 +701,21 @@ class QuickCompress(Updater):
                  trigger,
                  target_box,
                  max_overlaps_per_particle=0.25,
-                 min_scale=0.99):
+                 min_scale=0.99,
+                 gap_scaling=False):
         super().__init__(trigger)
 
         param_dict = ParameterDict(
             max_overlaps_per_particle=float,
             min_scale=float,
+            gap_scaling=bool,
             target_box=hoomd.data.typeconverter.OnlyTypes(
                 hoomd.Box,
                 preprocess=hoomd.data.typeconverter.box_preprocessing),
             instance=int)
         param_dict['max_overlaps_per_particle'] = max_overlaps_per_particle
         param_dict['min_scale'] = min_scale
+        param_dict['gap_scaling'] = gap_scaling
         param_dict['target_box'] = target_box
 
         self._param_dict.update(param_dict)
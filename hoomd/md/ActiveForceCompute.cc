@@ -22,7 +22,8 @@ namespace md
 ActiveForceCompute::ActiveForceCompute(std::shared_ptr<SystemDefinition> sysdef,
                                        std::shared_ptr<ParticleGroup> group)
 
-    : ForceCompute(sysdef), m_group(group)
+    : ForceCompute(sysdef), m_group(group), m_diffusion_pending(false),
+      m_pending_rotational_diffusion(0), m_pending_diffusion_timestep(0)
     {
     // allocate memory for the per-type active_force storage and initialize them to (1.0,0,0)
     GlobalVector<Scalar4> tmp_f_activeVec(m_pdata->getNTypes(), m_exec_conf);
@@ -301,6 +302,24 @@ void ActiveForceCompute::rotationalDiffusion(Scalar rotational_diffusion, uint64
         }
     }
 
+/*! \param rotational_diffusion Rotational diffusion constant
+    \param timestep Timestep that seeds the random numbers
+
+    The step is applied by the next call to computeForces(), so that the GPU implementations can
+    rotate the orientations in the same kernel that sets the forces. A step that is still pending
+    is applied first.
+*/
+void ActiveForceCompute::scheduleRotationalDiffusion(Scalar rotational_diffusion,
+                                                     uint64_t timestep)
+    {
+    if (m_diffusion_pending)
+        rotationalDiffusion(m_pending_rotational_diffusion, m_pending_diffusion_timestep);
+
+    m_diffusion_pending = true;
+    m_pending_rotational_diffusion = rotational_diffusion;
+    m_pending_diffusion_timestep = timestep;
+    }
+
 /*! This function applies rotational diffusion and sets forces for all active particles
     \param timestep Current timestep
 */
@@ -309,6 +328,12 @@ void ActiveForceCompute::computeForces(uint64_t timestep)
     if (m_prof)
         m_prof->push(m_exec_conf, "ActiveForceCompute");
 
+    if (m_diffusion_pending)
+        {
+        rotationalDiffusion(m_pending_rotational_diffusion, m_pending_diffusion_timestep);
+        m_diffusion_pending = false;
+        }
+
     setForces(); // set forces for particles
 
 #ifdef ENABLE_HIP
@@ -77,6 +77,9 @@ class PYBIND11_EXPORT ActiveForceCompute : public ForceCompute
     //! Orientational diffusion for spherical particles
     virtual void rotationalDiffusion(Scalar rotational_diffusion, uint64_t timestep);
 
+    //! Schedule a rotational diffusion step for the next force computation
+    void scheduleRotationalDiffusion(Scalar rotational_diffusion, uint64_t timestep);
+
     std::shared_ptr<ParticleGroup> m_group; //!< Group of particles on which this force is applied
     GlobalVector<Scalar4>
         m_f_activeVec; //! active force unit vectors and magnitudes for each particle type
@@ -84,10 +87,14 @@ class PYBIND11_EXPORT ActiveForceCompute : public ForceCompute
     GlobalVector<Scalar4>
         m_t_activeVec; //! active torque unit vectors and magnitudes for each particle type
 
+    bool m_diffusion_pending;              //!< True when a rotational diffusion step is scheduled
+    Scalar m_pending_rotational_diffusion; //!< Rotational diffusion of the scheduled step
+    uint64_t m_pending_diffusion_timestep; //!< Timestep of the scheduled step
+
     private:
     // Allow ActiveRotationalDiffusionUpdater to access internal methods and members of
     // ActiveForceCompute classes/subclasses. This is necessary to allow
-    // ActiveRotationalDiffusionUpdater to call rotationalDiffusion.
+    // ActiveRotationalDiffusionUpdater to call scheduleRotationalDiffusion.
     friend class ActiveRotationalDiffusionUpdater;
     };
 
@@ -74,7 +74,21 @@ ActiveForceComputeGPU::ActiveForceComputeGPU(std::shared_ptr<SystemDefinition> s
     m_t_activeVec.swap(tmp_t_activeVec);
     }
 
-/*! This function sets appropriate active forces and torques on all active particles.
+/*! \param timestep Current timestep
+ */
+void ActiveForceComputeGPU::computeForces(uint64_t timestep)
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "ActiveForceCompute");
+
+    setForces(); // also applies the scheduled rotational diffusion
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+/*! This function sets appropriate active forces and torques on all active particles. A scheduled
+    rotational diffusion step is applied in the same kernel.
  */
 void ActiveForceComputeGPU::setForces()
     {
@@ -88,10 +102,12 @@ void ActiveForceComputeGPU::setForces()
     ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
     ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
                                        access_location::device,
-                                       access_mode::read);
+                                       m_diffusion_pending ? access_mode::readwrite
+                                                           : access_mode::read);
     ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
                                             access_location::device,
                                             access_mode::read);
+    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
 
     // sanity check
     assert(d_force.data != NULL);
@@ -102,6 +118,8 @@ void ActiveForceComputeGPU::setForces()
     assert(d_index_array.data != NULL);
     unsigned int group_size = m_group->getNumMembers();
     unsigned int N = m_pdata->getN();
+    bool is2D = (m_sysdef->getNDimensions() == 2);
+    Scalar rotation_constant = slow::sqrt(2.0 * m_pending_rotational_diffusion * m_deltaT);
 
     // compute the forces on the GPU
     m_tuner_force->begin();
@@ -114,6 +132,12 @@ void ActiveForceComputeGPU::setForces()
                                                 d_orientation.data,
                                                 d_f_actVec.data,
                                                 d_t_actVec.data,
+                                                d_tag.data,
+                                                m_diffusion_pending,
+                                                is2D,
+                                                rotation_constant,
+                                                m_pending_diffusion_timestep,
+                                                m_sysdef->getSeed(),
                                                 N,
                                                 m_tuner_force->getParam());
 
@@ -121,6 +145,7 @@ void ActiveForceComputeGPU::setForces()
         CHECK_CUDA_ERROR();
 
     m_tuner_force->end();
+    m_diffusion_pending = false;
     }
 
 /*! This function applies rotational diffusion to all active particles. The angle between the torque
@@ -21,25 +21,90 @@ namespace md
     {
 namespace kernel
     {
+//! Rotate an orientation by one rotational diffusion step
+/*! \param quati Orientation to rotate
+    \param fact Active force unit vector and magnitude of the particle type
+    \param ptag Particle tag
+    \param is2D check if simulation is 2D or 3D
+    \param rotationConst particle rotational diffusion constant
+    \param timestep Timestep that seeds the random numbers
+    \param seed seed for random number generator
+*/
+__device__ inline void active_force_rotational_diffusion(quat<Scalar>& quati,
+                                                         const Scalar4& fact,
+                                                         unsigned int ptag,
+                                                         bool is2D,
+                                                         const Scalar rotationConst,
+                                                         const uint64_t timestep,
+                                                         const uint16_t seed)
+    {
+    hoomd::RandomGenerator rng(
+        hoomd::Seed(hoomd::RNGIdentifier::ActiveForceCompute, timestep, seed),
+        hoomd::Counter(ptag));
+
+    if (is2D) // 2D
+        {
+        Scalar delta_theta = hoomd::NormalDistribution<Scalar>(rotationConst)(rng);
+
+        vec3<Scalar> b(0, 0, 1.0);
+        quat<Scalar> rot_quat = quat<Scalar>::fromAxisAngle(b, delta_theta);
+
+        quati = rot_quat * quati;
+        // in 2D there is only one meaningful direction for torque
+        }
+    else // 3D: Following Stenhammar, Soft Matter, 2014
+        {
+        hoomd::SpherePointGenerator<Scalar> unit_vec;
+        vec3<Scalar> rand_vec;
+        unit_vec(rng, rand_vec);
+
+        vec3<Scalar> f(fact.x, fact.y, fact.z);
+        vec3<Scalar> fi = rotate(quati, f);
+
+        vec3<Scalar> aux_vec = cross(fi, rand_vec); // rotation axis
+        Scalar aux_vec_mag = slow::rsqrt(dot(aux_vec, aux_vec));
+        aux_vec *= aux_vec_mag;
+
+        Scalar delta_theta = hoomd::NormalDistribution<Scalar>(rotationConst)(rng);
+        quat<Scalar> rot_quat = quat<Scalar>::fromAxisAngle(aux_vec, delta_theta);
+
+        quati = rot_quat * quati;
+        }
+    }
+
 //! Kernel for setting active force vectors on the GPU
 /*! \param group_size number of particles
     \param d_index_array stores list to convert group index to global tag
     \param d_force particle force on device
     \param d_torque particle torque on device
+    \param d_pos particle positions on device
     \param d_orientation particle orientation on device
     \param d_f_act particle active force unit vector
     \param d_t_act particle active torque unit vector
-    \param orientationLink check if particle orientation is linked to active force vector
+    \param d_tag particle tags on device
+    \param diffuse True to apply a rotational diffusion step before setting the forces
+    \param is2D check if simulation is 2D or 3D
+    \param rotationConst particle rotational diffusion constant
+    \param timestep Timestep that seeds the random numbers
+    \param seed seed for random number generator
+
+    When \a diffuse is set, the rotated orientation is written back and the forces are computed
+    from it, so rotational diffusion costs no extra pass over the particles.
 */
 __global__ void gpu_compute_active_force_set_forces_kernel(const unsigned int group_size,
                                                            unsigned int* d_index_array,
                                                            Scalar4* d_force,
                                                            Scalar4* d_torque,
                                                            const Scalar4* d_pos,
-                                                           const Scalar4* d_orientation,
+                                                           Scalar4* d_orientation,
                                                            const Scalar4* d_f_act,
                                                            const Scalar4* d_t_act,
-                                                           const unsigned int N)
+                                                           const unsigned int* d_tag,
+                                                           const bool diffuse,
+                                                           const bool is2D,
+                                                           const Scalar rotationConst,
+                                                           const uint64_t timestep,
+                                                           const uint16_t seed)
     {
     unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
     if (group_idx >= group_size)
@@ -50,9 +115,21 @@ __global__ void gpu_compute_active_force_set_forces_kernel(const unsigned int gr
     unsigned int type = __scalar_as_int(posidx.w);
 
     Scalar4 fact = __ldg(d_f_act + type);
+    quat<Scalar> quati(d_orientation[idx]);
+
+    if (diffuse && fact.w != 0)
+        {
+        active_force_rotational_diffusion(quati,
+                                          fact,
+                                          d_tag[idx],
+                                          is2D,
+                                          rotationConst,
+                                          timestep,
+                                          seed);
+        d_orientation[idx] = quat_to_scalar4(quati);
+        }
 
     vec3<Scalar> f(fact.w * fact.x, fact.w * fact.y, fact.w * fact.z);
-    quat<Scalar> quati(__ldg(d_orientation + idx));
     vec3<Scalar> fi = rotate(quati, f);
     d_force[idx] = vec_to_scalar4(fi, 0);
 
@@ -65,11 +142,14 @@ __global__ void gpu_compute_active_force_set_forces_kernel(const unsigned int gr
 
 //! Kernel for applying rotational diffusion to active force vectors on the GPU
 /*! \param group_size number of particles
+    \param d_tag particle tags on device
     \param d_index_array stores list to convert group index to global tag
     \param d_pos particle positions on device
+    \param d_orientation particle orientation on device
     \param d_f_act particle active force unit vector
     \param is2D check if simulation is 2D or 3D
     \param rotationConst particle rotational diffusion constant
+    \param timestep Timestep that seeds the random numbers
     \param seed seed for random number generator
 */
 __global__ void gpu_compute_active_force_rotational_diffusion_kernel(const unsigned int group_size,
@@ -95,44 +175,15 @@ __global__ void gpu_compute_active_force_rotational_diffusion_kernel(const unsig
 
     if (fact.w != 0)
         {
-        unsigned int ptag = d_tag[group_idx];
-
         quat<Scalar> quati(__ldg(d_orientation + idx));
-
-        hoomd::RandomGenerator rng(
-            hoomd::Seed(hoomd::RNGIdentifier::ActiveForceCompute, timestep, seed),
-            hoomd::Counter(ptag));
-
-        if (is2D) // 2D
-            {
-            Scalar delta_theta = hoomd::NormalDistribution<Scalar>(rotationConst)(rng);
-
-            vec3<Scalar> b(0, 0, 1.0);
-            quat<Scalar> rot_quat = quat<Scalar>::fromAxisAngle(b, delta_theta);
-
-            quati = rot_quat * quati;
-            d_orientation[idx] = quat_to_scalar4(quati);
-            // in 2D there is only one meaningful direction for torque
-            }
-        else // 3D: Following Stenhammar, Soft Matter, 2014
-            {
-            hoomd::SpherePointGenerator<Scalar> unit_vec;
-            vec3<Scalar> rand_vec;
-            unit_vec(rng, rand_vec);
-
-            vec3<Scalar> f(fact.x, fact.y, fact.z);
-            vec3<Scalar> fi = rotate(quati, f);
-
-            vec3<Scalar> aux_vec = cross(fi, rand_vec); // rotation axis
-            Scalar aux_vec_mag = slow::rsqrt(dot(aux_vec, aux_vec));
-            aux_vec *= aux_vec_mag;
-
-            Scalar delta_theta = hoomd::NormalDistribution<Scalar>(rotationConst)(rng);
-            quat<Scalar> rot_quat = quat<Scalar>::fromAxisAngle(aux_vec, delta_theta);
-
-            quati = rot_quat * quati;
-            d_orientation[idx] = quat_to_scalar4(quati);
-            }
+        active_force_rotational_diffusion(quati,
+                                          fact,
+                                          d_tag[idx],
+                                          is2D,
+                                          rotationConst,
+                                          timestep,
+                                          seed);
+        d_orientation[idx] = quat_to_scalar4(quati);
         }
     }
 
@@ -141,9 +192,15 @@ hipError_t gpu_compute_active_force_set_forces(const unsigned int group_size,
                                                Scalar4* d_force,
                                                Scalar4* d_torque,
                                                const Scalar4* d_pos,
-                                               const Scalar4* d_orientation,
+                                               Scalar4* d_orientation,
                                                const Scalar4* d_f_act,
                                                const Scalar4* d_t_act,
+                                               const unsigned int* d_tag,
+                                               const bool diffuse,
+                                               const bool is2D,
+                                               const Scalar rotationConst,
+                                               const uint64_t timestep,
+                                               const uint16_t seed,
                                                const unsigned int N,
                                                unsigned int block_size)
     {
@@ -153,6 +210,7 @@ hipError_t gpu_compute_active_force_set_forces(const unsigned int group_size,
 
     // run the kernel
     hipMemset(d_force, 0, sizeof(Scalar4) * N);
+    hipMemset(d_torque, 0, sizeof(Scalar4) * N);
     hipLaunchKernelGGL((gpu_compute_active_force_set_forces_kernel),
                        dim3(grid),
                        dim3(threads),
@@ -166,7 +224,12 @@ hipError_t gpu_compute_active_force_set_forces(const unsigned int group_size,
                        d_orientation,
                        d_f_act,
                        d_t_act,
-                       N);
+                       d_tag,
+                       diffuse,
+                       is2D,
+                       rotationConst,
+                       timestep,
+                       seed);
     return hipSuccess;
     }
 
@@ -26,9 +26,15 @@ hipError_t gpu_compute_active_force_set_forces(const unsigned int group_size,
                                                Scalar4* d_force,
                                                Scalar4* d_torque,
                                                const Scalar4* d_pos,
-                                               const Scalar4* d_orientation,
+                                               Scalar4* d_orientation,
                                                const Scalar4* d_f_act,
                                                const Scalar4* d_t_act,
+                                               const unsigned int* d_tag,
+                                               const bool diffuse,
+                                               const bool is2D,
+                                               const Scalar rotationConst,
+                                               const uint64_t timestep,
+                                               const uint16_t seed,
                                                const unsigned int N,
                                                unsigned int block_size);
 
@@ -50,6 +50,9 @@ class PYBIND11_EXPORT ActiveForceComputeGPU : public ActiveForceCompute
     std::unique_ptr<Autotuner> m_tuner_force;     //!< Autotuner for block size (force kernel)
     std::unique_ptr<Autotuner> m_tuner_diffusion; //!< Autotuner for block size (diff kernel)
 
+    //! Apply the scheduled rotational diffusion and set the forces
+    virtual void computeForces(uint64_t timestep);
+
     //! Set forces for particles
     virtual void setForces();
 
@@ -49,6 +49,9 @@ class PYBIND11_EXPORT ActiveForceConstraintCompute : public ActiveForceCompute
     //! Set constraints if particles confined to a surface
     virtual void setConstraint();
 
+    //! Check that the manifold fits inside the box after the box changes
+    void checkManifold();
+
     //! Helper function to be called when box changes
     void setBoxChange()
         {
@@ -185,6 +188,18 @@ template<class Manifold> void ActiveForceConstraintCompute<Manifold>::setConstra
         }
     }
 
+template<class Manifold> void ActiveForceConstraintCompute<Manifold>::checkManifold()
+    {
+    if (m_box_changed)
+        {
+        if (!m_manifold.fitsInsideBox(m_pdata->getGlobalBox()))
+            {
+            throw std::runtime_error("Parts of the manifold are outside the box");
+            }
+        m_box_changed = false;
+        }
+    }
+
 /*! This function applies constraints, rotational diffusion, and sets forces for all active
    particles \param timestep Current timestep
 */
@@ -194,13 +209,12 @@ void ActiveForceConstraintCompute<Manifold>::computeForces(uint64_t timestep)
     if (m_prof)
         m_prof->push(m_exec_conf, "ActiveForceConstraintCompute");
 
-    if (m_box_changed)
+    checkManifold();
+
+    if (m_diffusion_pending)
         {
-        if (!m_manifold.fitsInsideBox(m_pdata->getGlobalBox()))
-            {
-            throw std::runtime_error("Parts of the manifold are outside the box");
-            }
-        m_box_changed = false;
+        rotationalDiffusion(m_pending_rotational_diffusion, m_pending_diffusion_timestep);
+        m_diffusion_pending = false;
         }
 
     setConstraint(); // apply manifold constraints to active particles active force vectors
@@ -10,9 +10,9 @@
 #include "hoomd/RandomNumbers.h"
 #include "hoomd/TextureTools.h"
 
-/*! \file ActiveForceComputeGPU.cuh
-    \brief Declares GPU kernel code for calculating active forces forces on the GPU. Used by
-   ActiveForceComputeGPU.
+/*! \file ActiveForceConstraintComputeGPU.cuh
+    \brief Declares GPU kernel code for calculating active forces on manifolds on the GPU. Used by
+   ActiveForceConstraintComputeGPU.
 */
 
 #ifndef __ACTIVE_FORCE_CONSTRAINT_COMPUTE_GPU_CUH__
@@ -25,13 +25,22 @@ namespace md
 namespace kernel
     {
 template<class Manifold>
-hipError_t gpu_compute_active_force_set_constraints(const unsigned int group_size,
-                                                    unsigned int* d_index_array,
-                                                    const Scalar4* d_pos,
-                                                    Scalar4* d_orientation,
-                                                    const Scalar4* d_f_act,
-                                                    Manifold manifold,
-                                                    unsigned int block_size);
+hipError_t gpu_compute_active_force_constraint_set_forces(const unsigned int group_size,
+                                                          unsigned int* d_index_array,
+                                                          Scalar4* d_force,
+                                                          Scalar4* d_torque,
+                                                          const Scalar4* d_pos,
+                                                          Scalar4* d_orientation,
+                                                          const Scalar4* d_f_act,
+                                                          const Scalar4* d_t_act,
+                                                          const unsigned int* d_tag,
+                                                          Manifold manifold,
+                                                          const bool diffuse,
+                                                          const Scalar rotationConst,
+                                                          const uint64_t timestep,
+                                                          const uint16_t seed,
+                                                          const unsigned int N,
+                                                          unsigned int block_size);
 
 template<class Manifold>
 hipError_t gpu_compute_active_force_constraint_rotational_diffusion(const unsigned int group_size,
@@ -48,21 +57,101 @@ hipError_t gpu_compute_active_force_constraint_rotational_diffusion(const unsign
 
 #ifdef __HIPCC__
 
-//! Kernel for adjusting active force vectors to align parallel to an
-//  manifold surface constraint on the GPU
+//! Rotate an orientation by one rotational diffusion step about the manifold normal
+/*! \param quati Orientation to rotate
+    \param norm Unit normal of the manifold at the particle position
+    \param ptag Particle tag
+    \param rotationConst particle rotational diffusion constant
+    \param timestep Timestep that seeds the random numbers
+    \param seed seed for random number generator
+*/
+__device__ inline void active_force_constraint_rotational_diffusion(quat<Scalar>& quati,
+                                                                    const vec3<Scalar>& norm,
+                                                                    unsigned int ptag,
+                                                                    const Scalar rotationConst,
+                                                                    const uint64_t timestep,
+                                                                    const uint16_t seed)
+    {
+    hoomd::RandomGenerator rng(
+        hoomd::Seed(hoomd::RNGIdentifier::ActiveForceCompute, timestep, seed),
+        hoomd::Counter(ptag));
+
+    Scalar delta_theta = hoomd::NormalDistribution<Scalar>(rotationConst)(rng);
+
+    quat<Scalar> rot_quat = quat<Scalar>::fromAxisAngle(norm, delta_theta);
+
+    quati = rot_quat * quati;
+    }
+
+//! Rotate an orientation so that the active force lies in the tangent plane of the manifold
+/*! \param quati Orientation to rotate
+    \param fact Active force unit vector and magnitude of the particle type
+    \param norm Unit normal of the manifold at the particle position
+*/
+__device__ inline void active_force_constraint_project(quat<Scalar>& quati,
+                                                       const Scalar4& fact,
+                                                       const vec3<Scalar>& norm)
+    {
+    vec3<Scalar> f(fact.x, fact.y, fact.z);
+    vec3<Scalar> fi = rotate(quati, f);
+
+    Scalar dot_prod = fi.x * norm.x + fi.y * norm.y + fi.z * norm.z;
+
+    Scalar dot_perp_prod = slow::rsqrt(1 - dot_prod * dot_prod);
+
+    Scalar phi = slow::atan(dot_prod * dot_perp_prod);
+
+    fi.x -= norm.x * dot_prod;
+    fi.y -= norm.y * dot_prod;
+    fi.z -= norm.z * dot_prod;
+
+    Scalar new_norm = slow::rsqrt(fi.x * fi.x + fi.y * fi.y + fi.z * fi.z);
+
+    fi *= new_norm;
+
+    vec3<Scalar> rot_vec = cross(norm, fi);
+
+    quat<Scalar> rot_quat = quat<Scalar>::fromAxisAngle(rot_vec, phi);
+
+    quati = rot_quat * quati;
+    }
+
+//! Kernel for setting active force vectors of particles confined to a manifold on the GPU
 /*! \param group_size number of particles
     \param d_index_array stores list to convert group index to global tag
+    \param d_force particle force on device
+    \param d_torque particle torque on device
     \param d_pos particle positions on device
+    \param d_orientation particle orientation on device
     \param d_f_act particle active force unit vector
+    \param d_t_act particle active torque unit vector
+    \param d_tag particle tags on device
     \param manifold constraint
+    \param diffuse True to apply a rotational diffusion step before setting the forces
+    \param rotationConst particle rotational diffusion constant
+    \param timestep Timestep that seeds the random numbers
+    \param seed seed for random number generator
+
+    Each thread applies the rotational diffusion step (when \a diffuse is set), rotates the active
+    force into the tangent plane of the manifold, writes the orientation once, and sets the force
+    and torque from it.
 */
 template<class Manifold>
-__global__ void gpu_compute_active_force_set_constraints_kernel(const unsigned int group_size,
-                                                                unsigned int* d_index_array,
-                                                                const Scalar4* d_pos,
-                                                                Scalar4* d_orientation,
-                                                                const Scalar4* d_f_act,
-                                                                Manifold manifold)
+__global__ void
+gpu_compute_active_force_constraint_set_forces_kernel(const unsigned int group_size,
+                                                      unsigned int* d_index_array,
+                                                      Scalar4* d_force,
+                                                      Scalar4* d_torque,
+                                                      const Scalar4* d_pos,
+                                                      Scalar4* d_orientation,
+                                                      const Scalar4* d_f_act,
+                                                      const Scalar4* d_t_act,
+                                                      const unsigned int* d_tag,
+                                                      Manifold manifold,
+                                                      const bool diffuse,
+                                                      const Scalar rotationConst,
+                                                      const uint64_t timestep,
+                                                      const uint16_t seed)
     {
     unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
     if (group_idx >= group_size)
@@ -73,48 +162,48 @@ __global__ void gpu_compute_active_force_set_constraints_kernel(const unsigned i
     unsigned int type = __scalar_as_int(posidx.w);
 
     Scalar4 fact = __ldg(d_f_act + type);
+    quat<Scalar> quati(d_orientation[idx]);
 
-    if (fact.w != 0)
+    if (diffuse || fact.w != 0)
         {
         Scalar3 current_pos = make_scalar3(posidx.x, posidx.y, posidx.z);
-
         vec3<Scalar> norm = normalize(vec3<Scalar>(manifold.derivative(current_pos)));
 
-        vec3<Scalar> f(fact.x, fact.y, fact.z);
-        quat<Scalar> quati(__ldg(d_orientation + idx));
-        vec3<Scalar> fi = rotate(quati, f);
-
-        Scalar dot_prod = fi.x * norm.x + fi.y * norm.y + fi.z * norm.z;
+        if (diffuse)
+            active_force_constraint_rotational_diffusion(quati,
+                                                         norm,
+                                                         d_tag[idx],
+                                                         rotationConst,
+                                                         timestep,
+                                                         seed);
 
-        Scalar dot_perp_prod = slow::rsqrt(1 - dot_prod * dot_prod);
+        if (fact.w != 0)
+            active_force_constraint_project(quati, fact, norm);
 
-        Scalar phi = slow::atan(dot_prod * dot_perp_prod);
-
-        fi.x -= norm.x * dot_prod;
-        fi.y -= norm.y * dot_prod;
-        fi.z -= norm.z * dot_prod;
-
-        Scalar new_norm = slow::rsqrt(fi.x * fi.x + fi.y * fi.y + fi.z * fi.z);
-
-        fi *= new_norm;
-
-        vec3<Scalar> rot_vec = cross(norm, fi);
+        d_orientation[idx] = quat_to_scalar4(quati);
+        }
 
-        quat<Scalar> rot_quat = quat<Scalar>::fromAxisAngle(rot_vec, phi);
+    vec3<Scalar> f(fact.w * fact.x, fact.w * fact.y, fact.w * fact.z);
+    vec3<Scalar> fi = rotate(quati, f);
+    d_force[idx] = vec_to_scalar4(fi, 0);
 
-        quati = rot_quat * quati;
+    Scalar4 tact = __ldg(d_t_act + type);
 
-        d_orientation[idx] = quat_to_scalar4(quati);
-        }
+    vec3<Scalar> t(tact.w * tact.x, tact.w * tact.y, tact.w * tact.z);
+    vec3<Scalar> ti = rotate(quati, t);
+    d_torque[idx] = vec_to_scalar4(ti, 0);
     }
 
 //! Kernel for applying rotational diffusion to active force vectors on the GPU
 /*! \param group_size number of particles
+    \param d_tag particle tags on device
     \param d_index_array stores list to convert group index to global tag
     \param d_pos particle positions on device
+    \param d_orientation particle orientation on device
     \param manifold constraint
     \param is2D check if simulation is 2D or 3D
     \param rotationConst particle rotational diffusion constant
+    \param timestep Timestep that seeds the random numbers
     \param seed seed for random number generator
 */
 template<class Manifold>
@@ -136,51 +225,65 @@ gpu_compute_active_force_constraint_rotational_diffusion_kernel(const unsigned i
 
     unsigned int idx = d_index_array[group_idx];
     Scalar4 posidx = __ldg(d_pos + idx);
-    unsigned int type = __scalar_as_int(posidx.w);
-    unsigned int ptag = d_tag[group_idx];
 
     quat<Scalar> quati(__ldg(d_orientation + idx));
 
-    hoomd::RandomGenerator rng(
-        hoomd::Seed(hoomd::RNGIdentifier::ActiveForceCompute, timestep, seed),
-        hoomd::Counter(ptag));
-
     Scalar3 current_pos = make_scalar3(posidx.x, posidx.y, posidx.z);
     vec3<Scalar> norm = normalize(vec3<Scalar>(manifold.derivative(current_pos)));
 
-    Scalar delta_theta = hoomd::NormalDistribution<Scalar>(rotationConst)(rng);
-
-    quat<Scalar> rot_quat = quat<Scalar>::fromAxisAngle(norm, delta_theta);
-
-    quati = rot_quat * quati;
+    active_force_constraint_rotational_diffusion(quati,
+                                                 norm,
+                                                 d_tag[idx],
+                                                 rotationConst,
+                                                 timestep,
+                                                 seed);
     d_orientation[idx] = quat_to_scalar4(quati);
     }
 
 template<class Manifold>
-hipError_t gpu_compute_active_force_set_constraints(const unsigned int group_size,
-                                                    unsigned int* d_index_array,
-                                                    const Scalar4* d_pos,
-                                                    Scalar4* d_orientation,
-                                                    const Scalar4* d_f_act,
-                                                    Manifold manifold,
-                                                    unsigned int block_size)
+hipError_t gpu_compute_active_force_constraint_set_forces(const unsigned int group_size,
+                                                          unsigned int* d_index_array,
+                                                          Scalar4* d_force,
+                                                          Scalar4* d_torque,
+                                                          const Scalar4* d_pos,
+                                                          Scalar4* d_orientation,
+                                                          const Scalar4* d_f_act,
+                                                          const Scalar4* d_t_act,
+                                                          const unsigned int* d_tag,
+                                                          Manifold manifold,
+                                                          const bool diffuse,
+                                                          const Scalar rotationConst,
+                                                          const uint64_t timestep,
+                                                          const uint16_t seed,
+                                                          const unsigned int N,
+                                                          unsigned int block_size)
     {
     // setup the grid to run the kernel
     dim3 grid(group_size / block_size + 1, 1, 1);
     dim3 threads(block_size, 1, 1);
 
     // run the kernel
-    hipLaunchKernelGGL((gpu_compute_active_force_set_constraints_kernel<Manifold>),
+    hipMemset(d_force, 0, sizeof(Scalar4) * N);
+    hipMemset(d_torque, 0, sizeof(Scalar4) * N);
+    hipLaunchKernelGGL((gpu_compute_active_force_constraint_set_forces_kernel<Manifold>),
                        dim3(grid),
                        dim3(threads),
                        0,
                        0,
                        group_size,
                        d_index_array,
+                       d_force,
+                       d_torque,
                        d_pos,
                        d_orientation,
                        d_f_act,
-                       manifold);
+                       d_t_act,
+                       d_tag,
+                       manifold,
+                       diffuse,
+                       rotationConst,
+                       timestep,
+                       seed);
     return hipSuccess;
     }
 
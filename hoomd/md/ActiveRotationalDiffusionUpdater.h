@@ -24,7 +24,8 @@ namespace md
     {
 /// Updates particle's orientations based on a given diffusion constant.
 /** The updater accepts a variant rotational diffusion and updates the particle orientations of the
- * associated ActiveForceCompute's group (by calling m_active_force.rotationalDiffusion).
+ * associated ActiveForceCompute's group (by calling m_active_force.scheduleRotationalDiffusion).
+ * The orientations are rotated when the active force is next computed.
  *
  * Note: This was originally part of the ActiveForceCompute, and is separated to obey the idea that
  * force computes do not update the system directly, but updaters do. See GitHub issue (898). The
@@ -10,6 +10,7 @@
 
 #include "EvaluatorPairDipole.h"
 #include "EvaluatorPairGB.h"
+#include "EvaluatorPairRigidSites.h"
 
 #ifdef ENABLE_HIP
 #include "AllDriverAnisoPotentialPairGPU.cuh"
@@ -29,6 +30,8 @@ namespace md
 typedef AnisoPotentialPair<EvaluatorPairGB> AnisoPotentialPairGB;
 //! Pair potential force compute for dipole forces and torques
 typedef AnisoPotentialPair<EvaluatorPairDipole> AnisoPotentialPairDipole;
+//! Pair potential force compute for site interactions between rigid bodies
+typedef AnisoPotentialPair<EvaluatorPairRigidSites> AnisoPotentialPairRigidSites;
 
 #ifdef ENABLE_HIP
 //! Pair potential force compute for Gay-Berne forces and torques on the GPU
@@ -37,6 +40,10 @@ typedef AnisoPotentialPairGPU<EvaluatorPairGB, kernel::gpu_compute_pair_aniso_fo
 //! Pair potential force compute for dipole forces and torques on the GPU
 typedef AnisoPotentialPairGPU<EvaluatorPairDipole, kernel::gpu_compute_pair_aniso_forces_dipole>
     AnisoPotentialPairDipoleGPU;
+//! Pair potential force compute for site interactions between rigid bodies on the GPU
+typedef AnisoPotentialPairGPU<EvaluatorPairRigidSites,
+                              kernel::gpu_compute_pair_aniso_forces_rigid_sites>
+    AnisoPotentialPairRigidSitesGPU;
 #endif
 
     } // end namespace md
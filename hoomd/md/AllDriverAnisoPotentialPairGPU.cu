@@ -31,6 +31,16 @@ gpu_compute_pair_aniso_forces_dipole(const a_pair_args_t& pair_args,
     return gpu_compute_pair_aniso_forces<EvaluatorPairDipole>(pair_args, d_param, d_shape_param);
     }
 
+hipError_t
+gpu_compute_pair_aniso_forces_rigid_sites(const a_pair_args_t& pair_args,
+                                          const EvaluatorPairRigidSites::param_type* d_param,
+                                          const EvaluatorPairRigidSites::shape_type* d_shape_param)
+    {
+    return gpu_compute_pair_aniso_forces<EvaluatorPairRigidSites>(pair_args,
+                                                                  d_param,
+                                                                  d_shape_param);
+    }
+
     } // end namespace kernel
     } // end namespace md
     } // end namespace hoomd
@@ -14,6 +14,7 @@
 #include "AnisoPotentialPairGPU.cuh"
 #include "EvaluatorPairDipole.h"
 #include "EvaluatorPairGB.h"
+#include "EvaluatorPairRigidSites.h"
 
 //! Compute dipole forces and torques on the GPU with EvaluatorPairDipole
 
@@ -33,6 +34,11 @@ gpu_compute_pair_aniso_forces_dipole(const a_pair_args_t&,
                                      const EvaluatorPairDipole::param_type*,
                                      const EvaluatorPairDipole::shape_type*);
 
+hipError_t __attribute__((visibility("default")))
+gpu_compute_pair_aniso_forces_rigid_sites(const a_pair_args_t&,
+                                          const EvaluatorPairRigidSites::param_type*,
+                                          const EvaluatorPairRigidSites::shape_type*);
+
     } // end namespace kernel
     } // end namespace md
     } // end namespace hoomd
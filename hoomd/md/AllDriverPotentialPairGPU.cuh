@@ -11,6 +11,7 @@
 #define __ALL_DRIVER_POTENTIAL_PAIR_GPU_CUH__
 
 #include "EvaluatorPairBuckingham.h"
+#include "EvaluatorPairComposite.h"
 #include "EvaluatorPairDLVO.h"
 #include "EvaluatorPairDPDLJThermo.h"
 #include "EvaluatorPairDPDThermo.h"
@@ -30,6 +31,7 @@
 #include "EvaluatorPairSLJ.h"
 #include "EvaluatorPairTWF.h"
 #include "EvaluatorPairTable.h"
+#include "EvaluatorPairTableSpline.h"
 #include "EvaluatorPairYukawa.h"
 #include "EvaluatorPairZBL.h"
 #include "PotentialPairDPDThermoGPU.cuh"
@@ -151,10 +153,20 @@ hipError_t __attribute__((visibility("default")))
 gpu_compute_table_forces(const pair_args_t& pair_args,
                          const EvaluatorPairTable::param_type* d_params);
 
+//! Compute tabulated pair potential forces on the GPU with EvaluatorPairTableSpline
+hipError_t __attribute__((visibility("default")))
+gpu_compute_table_spline_forces(const pair_args_t& pair_args,
+                                const EvaluatorPairTableSpline::param_type* d_params);
+
 //! Compute oscillating pair potential forces on the GPU with EvaluatorPairOPP
 hipError_t __attribute__((visibility("default")))
 gpu_compute_twf_forces(const pair_args_t& pair_args, const EvaluatorPairTWF::param_type* d_params);
 
+//! Compute the sum of LJ and Yukawa pair forces on the GPU in a single neighbor list pass
+hipError_t __attribute__((visibility("default"))) gpu_compute_lj_yukawa_forces(
+    const pair_args_t& pair_args,
+    const EvaluatorPairComposite<EvaluatorPairLJ, EvaluatorPairYukawa>::param_type* d_params);
+
     } // end namespace kernel
     } // end namespace md
     } // end namespace hoomd
@@ -7,6 +7,7 @@
 #define __PAIR_POTENTIALS__H__
 
 #include "EvaluatorPairBuckingham.h"
+#include "EvaluatorPairComposite.h"
 #include "EvaluatorPairDLVO.h"
 #include "EvaluatorPairDPDLJThermo.h"
 #include "EvaluatorPairDPDThermo.h"
@@ -26,6 +27,7 @@
 #include "EvaluatorPairSLJ.h"
 #include "EvaluatorPairTWF.h"
 #include "EvaluatorPairTable.h"
+#include "EvaluatorPairTableSpline.h"
 #include "EvaluatorPairYukawa.h"
 #include "EvaluatorPairZBL.h"
 #include "PotentialPair.h"
@@ -99,6 +101,11 @@ typedef PotentialPair<EvaluatorPairOPP> PotentialPairOPP;
 typedef PotentialPair<EvaluatorPairTWF> PotentialPairTWF;
 /// Tabulateed pair potential
 typedef PotentialPair<EvaluatorPairTable> PotentialPairTable;
+/// Tabulated pair potential with cubic spline interpolation
+typedef PotentialPair<EvaluatorPairTableSpline> PotentialPairTableSpline;
+/// Sum of LJ and Yukawa pair potentials computed in a single neighbor list pass
+typedef PotentialPair<EvaluatorPairComposite<EvaluatorPairLJ, EvaluatorPairYukawa>>
+    PotentialPairLJYukawa;
 
 #ifdef ENABLE_HIP
 //! Pair potential force compute for lj forces on the GPU
@@ -165,9 +172,16 @@ typedef PotentialPairGPU<EvaluatorPairOPP, kernel::gpu_compute_opp_forces> Poten
 //! Pair potential force compute for Table pair potential on the GPU
 typedef PotentialPairGPU<EvaluatorPairTable, kernel::gpu_compute_table_forces>
     PotentialPairTableGPU;
+//! Pair potential force compute for TableSpline pair potential on the GPU
+typedef PotentialPairGPU<EvaluatorPairTableSpline, kernel::gpu_compute_table_spline_forces>
+    PotentialPairTableSplineGPU;
 /// Pair potential force compute for Ten wolde and Frenkels globular protein
 /// model
 typedef PotentialPairGPU<EvaluatorPairTWF, kernel::gpu_compute_twf_forces> PotentialPairTWFGPU;
+/// Sum of LJ and Yukawa pair potentials computed in a single neighbor list pass on the GPU
+typedef PotentialPairGPU<EvaluatorPairComposite<EvaluatorPairLJ, EvaluatorPairYukawa>,
+                         kernel::gpu_compute_lj_yukawa_forces>
+    PotentialPairLJYukawaGPU;
 
 #endif
 
@@ -6,6 +6,7 @@
 
 #include "EvaluatorRevCross.h"
 #include "EvaluatorSquareDensity.h"
+#include "EvaluatorStillingerWeber.h"
 #include "EvaluatorTersoff.h"
 #include "PotentialPair.h"
 #include "PotentialTersoff.h"
@@ -36,6 +37,9 @@ typedef PotentialTersoff<EvaluatorSquareDensity> PotentialTripletSquareDensity;
 //! Three-body potential force compute forces for reversible crosslinkers
 typedef PotentialTersoff<EvaluatorRevCross> PotentialTripletRevCross;
 
+//! Three-body potential force compute for Stillinger-Weber forces
+typedef PotentialTersoff<EvaluatorStillingerWeber> PotentialTripletStillingerWeber;
+
 #ifdef ENABLE_HIP
 //! Three-body potential force compute for Tersoff forces on the GPU
 typedef PotentialTersoffGPU<EvaluatorTersoff, kernel::gpu_compute_tersoff_forces>
@@ -46,6 +50,9 @@ typedef PotentialTersoffGPU<EvaluatorSquareDensity, kernel::gpu_compute_sq_densi
 //! Three-body potential force compute for RevCross forces on the GPU
 typedef PotentialTersoffGPU<EvaluatorRevCross, kernel::gpu_compute_revcross_forces>
     PotentialTripletRevCrossGPU;
+//! Three-body potential force compute for Stillinger-Weber forces on the GPU
+typedef PotentialTersoffGPU<EvaluatorStillingerWeber, kernel::gpu_compute_stillinger_weber_forces>
+    PotentialTripletStillingerWeberGPU;
 #endif // ENABLE_HIP
 
     } // end namespace md
@@ -408,7 +408,7 @@ void AnisoPotentialPair<aniso_evaluator>::setShapePython(std::string typ,
                                                          pybind11::object shape_param)
     {
     auto typ_ = m_pdata->getTypeByName(typ);
-    setShape(typ_, shape_type(shape_param));
+    setShape(typ_, shape_type(shape_param, m_exec_conf->isCUDAEnabled()));
     }
 
 /*! \param typ The type index.
@@ -440,6 +440,15 @@ template<class aniso_evaluator>
 void AnisoPotentialPair<aniso_evaluator>::setRcut(unsigned int typ1, unsigned int typ2, Scalar rcut)
     {
     validateTypes(typ1, typ2, "setting r_cut");
+    Scalar old_rcut;
+        {
+        ArrayHandle<Scalar> h_r_cut_nlist(*m_r_cut_nlist, access_location::host, access_mode::read);
+        old_rcut = h_r_cut_nlist.data[m_typpair_idx(typ1, typ2)];
+        }
+
+    if (rcut == old_rcut)
+        return;
+
         {
         // store r_cut**2 for use internally
         ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::readwrite);
@@ -454,8 +463,12 @@ void AnisoPotentialPair<aniso_evaluator>::setRcut(unsigned int typ1, unsigned in
         h_r_cut_nlist.data[m_typpair_idx(typ2, typ1)] = rcut;
         }
 
-    // notify the neighbor list that we have changed r_cut values
-    m_nlist->notifyRCutMatrixChange();
+    // notify the neighbor list that we have changed r_cut values, the current list remains valid
+    // when the cutoff shrinks
+    if (rcut > old_rcut)
+        m_nlist->notifyRCutMatrixChange();
+    else
+        m_nlist->notifyRCutMatrixShrink();
     }
 
 template<class aniso_evaluator>
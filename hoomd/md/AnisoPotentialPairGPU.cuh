@@ -63,14 +63,21 @@ struct a_pair_args_t
                   const unsigned int _threads_per_particle,
                   const GPUPartition& _gpu_partition,
                   const hipDeviceProp_t& _devprop,
-                  bool _update_shape_param)
+                  bool _update_shape_param,
+                  const unsigned int _cluster_size = 0,
+                  const unsigned int* _d_cluster_n_neigh = nullptr,
+                  const unsigned int* _d_cluster_nlist = nullptr,
+                  const unsigned long long* _d_cluster_mask = nullptr,
+                  const unsigned int _cluster_nmax = 0)
         : d_force(_d_force), d_torque(_d_torque), d_virial(_d_virial), virial_pitch(_virial_pitch),
           N(_N), n_max(_n_max), d_pos(_d_pos), d_diameter(_d_diameter), d_charge(_d_charge),
           d_orientation(_d_orientation), d_tag(_d_tag), box(_box), d_n_neigh(_d_n_neigh),
           d_nlist(_d_nlist), d_head_list(_d_head_list), d_rcutsq(_d_rcutsq), ntypes(_ntypes),
           block_size(_block_size), shift_mode(_shift_mode), compute_virial(_compute_virial),
           threads_per_particle(_threads_per_particle), gpu_partition(_gpu_partition),
-          devprop(_devprop), update_shape_param(_update_shape_param) {};
+          devprop(_devprop), update_shape_param(_update_shape_param), cluster_size(_cluster_size),
+          d_cluster_n_neigh(_d_cluster_n_neigh), d_cluster_nlist(_d_cluster_nlist),
+          d_cluster_mask(_d_cluster_mask), cluster_nmax(_cluster_nmax) {};
 
     Scalar4* d_force;             //!< Force to write out
     Scalar4* d_torque;            //!< Torque to write out
@@ -98,10 +105,97 @@ struct a_pair_args_t
     const hipDeviceProp_t& devprop;    //!< CUDA device properties
     bool update_shape_param; //!< If true, update size of shape param and synchronize GPU execution
                              //!< stream
+    const unsigned int cluster_size; //!< Particles per cluster, 0 for a per-particle list
+    const unsigned int* d_cluster_n_neigh;    //!< Number of j-clusters of each i-cluster
+    const unsigned int* d_cluster_nlist;      //!< j-clusters of each i-cluster
+    const unsigned long long* d_cluster_mask; //!< Interaction mask of each cluster pair
+    const unsigned int cluster_nmax;          //!< Maximum number of j-clusters per i-cluster
+    };
+
+//! Particle of a j-cluster staged in shared memory by gpu_compute_pair_aniso_forces_cluster_kernel
+struct aniso_cluster_particle
+    {
+    Scalar4 postype;     //!< Position and type
+    Scalar4 orientation; //!< Orientation quaternion
+    Scalar diameter;     //!< Diameter, only loaded when the evaluator needs it
+    Scalar charge;       //!< Charge, only loaded when the evaluator needs it
+    unsigned int tag;    //!< Tag, only loaded when the evaluator needs it
     };
 
 #ifdef __HIPCC__
 
+//! Load the per type pair parameters of an anisotropic pair potential into shared memory
+/*! \param s_data Shared memory to hold the parameters
+    \param d_params Parameters for the potential, stored per type pair
+    \param d_shape_params Shape parameters for the potential, stored per type
+    \param d_rcutsq rcut squared, stored per type pair
+    \param ntypes Number of types in the simulation
+    \param max_extra_bytes Shared memory available to the nested managed arrays of the parameters
+    \param s_params Set to the parameters in shared memory
+    \param s_rcutsq Set to rcut squared in shared memory
+    \param s_shape_params Set to the shape parameters in shared memory
+
+    All threads of the block must call this function.
+*/
+template<class evaluator>
+__device__ inline void load_aniso_pair_params(char* s_data,
+                                              const typename evaluator::param_type* d_params,
+                                              const typename evaluator::shape_type* d_shape_params,
+                                              const Scalar* d_rcutsq,
+                                              const unsigned int ntypes,
+                                              unsigned int max_extra_bytes,
+                                              typename evaluator::param_type*& s_params,
+                                              Scalar*& s_rcutsq,
+                                              typename evaluator::shape_type*& s_shape_params)
+    {
+    Index2D typpair_idx(ntypes);
+    const unsigned int num_typ_parameters = typpair_idx.getNumElements();
+
+    s_params = (typename evaluator::param_type*)(&s_data[0]);
+    s_rcutsq = (Scalar*)(&s_data[num_typ_parameters * sizeof(typename evaluator::param_type)]);
+    s_shape_params = (typename evaluator::shape_type*)(&s_rcutsq[num_typ_parameters]);
+
+    // load in the per type pair parameters
+    for (unsigned int cur_offset = 0; cur_offset < num_typ_parameters; cur_offset += blockDim.x)
+        {
+        if (cur_offset + threadIdx.x < num_typ_parameters)
+            {
+            s_rcutsq[cur_offset + threadIdx.x] = d_rcutsq[cur_offset + threadIdx.x];
+            }
+        }
+
+    unsigned int param_size
+        = num_typ_parameters * sizeof(typename evaluator::param_type) / sizeof(int);
+    for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += blockDim.x)
+        {
+        if (cur_offset + threadIdx.x < param_size)
+            {
+            ((int*)s_params)[cur_offset + threadIdx.x] = ((int*)d_params)[cur_offset + threadIdx.x];
+            }
+        }
+
+    unsigned int shape_param_size = sizeof(typename evaluator::shape_type) * ntypes / sizeof(int);
+    for (unsigned int cur_offset = 0; cur_offset < shape_param_size; cur_offset += blockDim.x)
+        {
+        if (cur_offset + threadIdx.x < shape_param_size)
+            {
+            ((int*)s_shape_params)[cur_offset + threadIdx.x]
+                = ((int*)d_shape_params)[cur_offset + threadIdx.x];
+            }
+        }
+    __syncthreads();
+
+    // initialize extra shared mem
+    char* s_extra = (char*)(s_shape_params + ntypes);
+
+    unsigned int available_bytes = max_extra_bytes;
+    for (unsigned int cur_pair = 0; cur_pair < typpair_idx.getNumElements(); ++cur_pair)
+        s_params[cur_pair].load_shared(s_extra, available_bytes);
+
+    for (unsigned int cur_type = 0; cur_type < ntypes; ++cur_type)
+        s_shape_params[cur_type].load_shared(s_extra, available_bytes);
+    }
+
 //! Kernel for calculating pair forces
 /*! This kernel is called to calculate the pair forces on all N particles. Actual evaluation of the
    potentials and forces for each pair is handled via the template class \a evaluator.
@@ -166,55 +260,21 @@ gpu_compute_pair_aniso_forces_kernel(Scalar4* d_force,
                                      unsigned int max_extra_bytes)
     {
     Index2D typpair_idx(ntypes);
-    const unsigned int num_typ_parameters = typpair_idx.getNumElements();
 
     // shared arrays for per type pair parameters
     HIP_DYNAMIC_SHARED(char, s_data)
-    typename evaluator::param_type* s_params = (typename evaluator::param_type*)(&s_data[0]);
-    Scalar* s_rcutsq
-        = (Scalar*)(&s_data[num_typ_parameters * sizeof(typename evaluator::param_type)]);
-    typename evaluator::shape_type* s_shape_params
-        = (typename evaluator::shape_type*)(&s_rcutsq[num_typ_parameters]);
-
-    // load in the per type pair parameters
-    for (unsigned int cur_offset = 0; cur_offset < num_typ_parameters; cur_offset += blockDim.x)
-        {
-        if (cur_offset + threadIdx.x < num_typ_parameters)
-            {
-            s_rcutsq[cur_offset + threadIdx.x] = d_rcutsq[cur_offset + threadIdx.x];
-            }
-        }
-
-    unsigned int param_size
-        = num_typ_parameters * sizeof(typename evaluator::param_type) / sizeof(int);
-    for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += blockDim.x)
-        {
-        if (cur_offset + threadIdx.x < param_size)
-            {
-            ((int*)s_params)[cur_offset + threadIdx.x] = ((int*)d_params)[cur_offset + threadIdx.x];
-            }
-        }
-
-    unsigned int shape_param_size = sizeof(typename evaluator::shape_type) * ntypes / sizeof(int);
-    for (unsigned int cur_offset = 0; cur_offset < shape_param_size; cur_offset += blockDim.x)
-        {
-        if (cur_offset + threadIdx.x < shape_param_size)
-            {
-            ((int*)s_shape_params)[cur_offset + threadIdx.x]
-                = ((int*)d_shape_params)[cur_offset + threadIdx.x];
-            }
-        }
-    __syncthreads();
-
-    // initialize extra shared mem
-    char* s_extra = (char*)(s_shape_params + ntypes);
-
-    unsigned int available_bytes = max_extra_bytes;
-    for (unsigned int cur_pair = 0; cur_pair < typpair_idx.getNumElements(); ++cur_pair)
-        s_params[cur_pair].load_shared(s_extra, available_bytes);
-
-    for (unsigned int cur_type = 0; cur_type < ntypes; ++cur_type)
-        s_shape_params[cur_type].load_shared(s_extra, available_bytes);
+    typename evaluator::param_type* s_params;
+    Scalar* s_rcutsq;
+    typename evaluator::shape_type* s_shape_params;
+    load_aniso_pair_params<evaluator>(s_data,
+                                      d_params,
+                                      d_shape_params,
+                                      d_rcutsq,
+                                      ntypes,
+                                      max_extra_bytes,
+                                      s_params,
+                                      s_rcutsq,
+                                      s_shape_params);
 
     // start by identifying which particle we are to handle
     unsigned int idx;
@@ -398,6 +458,251 @@ gpu_compute_pair_aniso_forces_kernel(Scalar4* d_force,
         }
     }
 
+//! Kernel for calculating pair forces with a cluster pair list
+/*! This kernel computes the same forces and torques as gpu_compute_pair_aniso_forces_kernel(),
+    walking the cluster pair list of NeighborListGPUCluster instead of the per-particle neighbor
+    list. The parameters in common are documented there.
+
+    \param first Index of the first particle to compute
+    \param last One past the index of the last particle to compute
+    \param n_max Size of the particle data arrays
+    \param d_cluster_n_neigh Number of j-clusters of each i-cluster
+    \param d_cluster_nlist j-clusters of each i-cluster, \a cluster_nmax per i-cluster
+    \param d_cluster_mask Interaction mask of each cluster pair
+    \param cluster_nmax Maximum number of j-clusters per i-cluster
+
+    \tparam cluster_size Number of particles per cluster
+
+    <b>Implementation details</b>
+    Each thread computes the force and torque on one particle and each group of \a cluster_size
+    consecutive threads handles one i-cluster. The threads of an i-cluster walk the same list of
+    j-clusters. For each j-cluster, every thread stages one particle (position, orientation, and
+    the optional per-particle data of the evaluator) in shared memory, and all threads of the
+    i-cluster then read the tile instead of loading the orientations of their neighbors from global
+    memory. The evaluators are expensive, so reusing each load \a cluster_size times outweighs the
+    block wide synchronization.
+
+    The neighbor list is full, so the torque on particle j is discarded and no atomic operations
+    are needed.
+
+    The dynamic shared memory starts with the tile of blockDim.x aniso_cluster_particle entries,
+    followed by the per type pair parameters.
+*/
+template<class evaluator,
+         unsigned int shift_mode,
+         unsigned int compute_virial,
+         unsigned int cluster_size>
+__global__ void
+gpu_compute_pair_aniso_forces_cluster_kernel(Scalar4* d_force,
+                                             Scalar4* d_torque,
+                                             Scalar* d_virial,
+                                             const size_t virial_pitch,
+                                             const unsigned int first,
+                                             const unsigned int last,
+                                             const unsigned int n_max,
+                                             const Scalar4* d_pos,
+                                             const Scalar* d_diameter,
+                                             const Scalar* d_charge,
+                                             const Scalar4* d_orientation,
+                                             const unsigned int* d_tag,
+                                             const BoxDim box,
+                                             const unsigned int* d_cluster_n_neigh,
+                                             const unsigned int* d_cluster_nlist,
+                                             const unsigned long long* d_cluster_mask,
+                                             const unsigned int cluster_nmax,
+                                             const typename evaluator::param_type* d_params,
+                                             const typename evaluator::shape_type* d_shape_params,
+                                             const Scalar* d_rcutsq,
+                                             const unsigned int ntypes,
+                                             unsigned int max_extra_bytes)
+    {
+    Index2D typpair_idx(ntypes);
+
+    // the tile of j-cluster particles, followed by the per type pair parameters
+    HIP_DYNAMIC_SHARED(char, s_data)
+    aniso_cluster_particle* s_tile = (aniso_cluster_particle*)(&s_data[0]);
+    typename evaluator::param_type* s_params;
+    Scalar* s_rcutsq;
+    typename evaluator::shape_type* s_shape_params;
+    load_aniso_pair_params<evaluator>(&s_data[blockDim.x * sizeof(aniso_cluster_particle)],
+                                      d_params,
+                                      d_shape_params,
+                                      d_rcutsq,
+                                      ntypes,
+                                      max_extra_bytes,
+                                      s_params,
+                                      s_rcutsq,
+                                      s_shape_params);
+
+    __shared__ unsigned int s_n_cj_max;
+    if (threadIdx.x == 0)
+        s_n_cj_max = 0;
+
+    // threads are assigned to particles starting at the i-cluster that holds the first particle,
+    // so that the threads of an i-cluster are consecutive. Threads outside of [first, last) still
+    // stage the particles of the j-clusters of their i-cluster.
+    unsigned int idx
+        = (first / cluster_size) * cluster_size + blockIdx.x * blockDim.x + threadIdx.x;
+    bool active = idx >= first && idx < last;
+
+    const unsigned int ci = idx / cluster_size;
+    const unsigned int i_sub = idx % cluster_size;
+    const unsigned int tile_head = threadIdx.x - i_sub;
+    const unsigned int row_shift = i_sub * cluster_size;
+    const unsigned long long row_mask = (1ull << cluster_size) - 1;
+    const unsigned int n_cj = ci * cluster_size < last ? d_cluster_n_neigh[ci] : 0;
+    const size_t head = size_t(ci) * cluster_nmax;
+
+    // all threads of the block take part in the staging of every tile
+    __syncthreads();
+    atomicMax(&s_n_cj_max, n_cj);
+    __syncthreads();
+    const unsigned int n_cj_max = s_n_cj_max;
+
+    // initialize the force to 0
+    Scalar4 force = make_scalar4(Scalar(0), Scalar(0), Scalar(0), Scalar(0));
+    Scalar4 torque = make_scalar4(Scalar(0), Scalar(0), Scalar(0), Scalar(0));
+    Scalar virialxx = Scalar(0);
+    Scalar virialxy = Scalar(0);
+    Scalar virialxz = Scalar(0);
+    Scalar virialyy = Scalar(0);
+    Scalar virialyz = Scalar(0);
+    Scalar virialzz = Scalar(0);
+
+    // read in the data of our particle
+    Scalar4 postypei = make_scalar4(Scalar(0), Scalar(0), Scalar(0), Scalar(0));
+    Scalar4 quati = make_scalar4(Scalar(1), Scalar(0), Scalar(0), Scalar(0));
+    Scalar di = Scalar(0);
+    Scalar qi = Scalar(0);
+    unsigned int tagi = 0;
+    if (active)
+        {
+        postypei = __ldg(d_pos + idx);
+        quati = __ldg(d_orientation + idx);
+        if (evaluator::needsDiameter())
+            di = __ldg(d_diameter + idx);
+        if (evaluator::needsCharge())
+            qi = __ldg(d_charge + idx);
+        if (evaluator::needsTags())
+            tagi = __ldg(d_tag + idx);
+        }
+    Scalar3 posi = make_scalar3(postypei.x, postypei.y, postypei.z);
+    unsigned int typei = __scalar_as_int(postypei.w);
+
+    // design specifies that energies are shifted if
+    // 1) shift mode is set to shift
+    bool energy_shift = false;
+    if (shift_mode == 1)
+        energy_shift = true;
+
+    // loop over j-clusters
+    for (unsigned int k = 0; k < n_cj_max; ++k)
+        {
+        // stage the particles of the k-th j-cluster of each i-cluster
+        unsigned int row = 0;
+        if (k < n_cj)
+            {
+            unsigned int cur_j = __ldg(d_cluster_nlist + head + k) * cluster_size + i_sub;
+            if (cur_j < n_max)
+                {
+                aniso_cluster_particle pj;
+                pj.postype = __ldg(d_pos + cur_j);
+                pj.orientation = __ldg(d_orientation + cur_j);
+                pj.diameter = evaluator::needsDiameter() ? __ldg(d_diameter + cur_j) : Scalar(0);
+                pj.charge = evaluator::needsCharge() ? __ldg(d_charge + cur_j) : Scalar(0);
+                pj.tag = evaluator::needsTags() ? __ldg(d_tag + cur_j) : 0;
+                s_tile[threadIdx.x] = pj;
+                }
+
+            if (active)
+                {
+                row = static_cast<unsigned int>((__ldg(d_cluster_mask + head + k) >> row_shift)
+                                                & row_mask);
+                }
+            }
+        __syncthreads();
+
+        for (unsigned int j_sub = 0; j_sub < cluster_size; ++j_sub)
+            {
+            if (!(row & (1u << j_sub)))
+                continue;
+
+            const aniso_cluster_particle& pj = s_tile[tile_head + j_sub];
+
+            // calculate dr (with periodic boundary conditions)
+            Scalar3 dx = posi - make_scalar3(pj.postype.x, pj.postype.y, pj.postype.z);
+            dx = box.minImage(dx);
+
+            // access the per type pair parameters
+            unsigned int typej = __scalar_as_int(pj.postype.w);
+            unsigned int typpair = typpair_idx(typei, typej);
+            Scalar rcutsq = s_rcutsq[typpair];
+            typename evaluator::param_type param = s_params[typpair];
+
+            // evaluate the potential
+            Scalar3 jforce = {Scalar(0), Scalar(0), Scalar(0)};
+            Scalar3 torquei = {Scalar(0), Scalar(0), Scalar(0)};
+            Scalar3 torquej = {Scalar(0), Scalar(0), Scalar(0)};
+            Scalar pair_eng = Scalar(0);
+
+            evaluator eval(dx, quati, pj.orientation, rcutsq, param);
+            if (evaluator::needsDiameter())
+                eval.setDiameter(di, pj.diameter);
+            if (evaluator::needsCharge())
+                eval.setCharge(qi, pj.charge);
+            if (evaluator::needsShape())
+                eval.setShape(&(s_shape_params[typei]), &(s_shape_params[typej]));
+            if (evaluator::needsTags())
+                eval.setTags(tagi, pj.tag);
+
+            eval.evaluate(jforce, pair_eng, energy_shift, torquei, torquej);
+
+            // calculate the virial
+            if (compute_virial)
+                {
+                Scalar3 jforce2 = Scalar(0.5) * jforce;
+                virialxx += dx.x * jforce2.x;
+                virialxy += dx.y * jforce2.x;
+                virialxz += dx.z * jforce2.x;
+                virialyy += dx.y * jforce2.y;
+                virialyz += dx.z * jforce2.y;
+                virialzz += dx.z * jforce2.z;
+                }
+
+            // add up the force vector components
+            force.x += jforce.x;
+            force.y += jforce.y;
+            force.z += jforce.z;
+            torque.x += torquei.x;
+            torque.y += torquei.y;
+            torque.z += torquei.z;
+
+            force.w += pair_eng;
+            }
+
+        // the tile is overwritten in the next iteration
+        __syncthreads();
+        }
+
+    if (!active)
+        return;
+
+    // potential energy per particle must be halved
+    force.w *= Scalar(0.5);
+    d_force[idx] = force;
+    d_torque[idx] = torque;
+
+    if (compute_virial)
+        {
+        d_virial[0 * virial_pitch + idx] = virialxx;
+        d_virial[1 * virial_pitch + idx] = virialxy;
+        d_virial[2 * virial_pitch + idx] = virialxz;
+        d_virial[3 * virial_pitch + idx] = virialyy;
+        d_virial[4 * virial_pitch + idx] = virialyz;
+        d_virial[5 * virial_pitch + idx] = virialzz;
+        }
+    }
+
 //! Aniso pair force compute kernel launcher
 /*!
  * \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r
@@ -524,6 +829,162 @@ struct AnisoPairForceComputeKernel<evaluator, shift_mode, compute_virial, 0>
         }
     };
 
+//! Cluster aniso pair force compute kernel launcher
+/*!
+ * \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r
+ * \tparam shift_mode 0: No energy shifting is done. 1: V(r) is shifted to be 0 at rcut.
+ * \tparam compute_virial When non-zero, the virial tensor is computed.
+ * \tparam cluster_size Number of particles per cluster
+ *
+ * Launches gpu_compute_pair_aniso_forces_cluster_kernel() instantiated for the cluster size of the
+ * neighbor list, trying cluster sizes of 8 and 4.
+ */
+template<class evaluator,
+         unsigned int shift_mode,
+         unsigned int compute_virial,
+         unsigned int cluster_size>
+struct AnisoPairForceClusterKernel
+    {
+    //! Launcher for the cluster aniso pair force kernel
+    /*!
+     * \param pair_args Other arguments to pass onto the kernel
+     * \param range Range of particle indices this GPU operates on
+     * \param params Parameters for the potential, stored per type pair
+     * \param shape_params Parameters for the potential, stored per type pair
+     */
+    static void launch(const a_pair_args_t& pair_args,
+                       std::pair<unsigned int, unsigned int> range,
+                       const typename evaluator::param_type* params,
+                       const typename evaluator::shape_type* shape_params)
+        {
+        if (cluster_size == pair_args.cluster_size)
+            {
+            unsigned int block_size = pair_args.block_size;
+
+            Index2D typpair_idx(pair_args.ntypes);
+            size_t shared_bytes = (2 * sizeof(Scalar) + sizeof(typename evaluator::param_type))
+                                      * typpair_idx.getNumElements()
+                                  + sizeof(typename evaluator::shape_type) * pair_args.ntypes;
+
+            auto kernel_func = &gpu_compute_pair_aniso_forces_cluster_kernel<evaluator,
+                                                                             shift_mode,
+                                                                             compute_virial,
+                                                                             cluster_size>;
+            hipFuncAttributes attr;
+            hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel_func));
+            int max_threads = attr.maxThreadsPerBlock;
+            // number of threads has to be multiple of warp size
+            unsigned int max_block_size = max_threads - max_threads % gpu_aniso_pair_force_max_tpp;
+            block_size = block_size < max_block_size ? block_size : max_block_size;
+
+            // the tile of j-cluster particles precedes the parameters
+            size_t tile_bytes = block_size * sizeof(aniso_cluster_particle);
+            shared_bytes += tile_bytes;
+
+            unsigned int max_extra_bytes = (unsigned int)(pair_args.devprop.sharedMemPerBlock
+                                                          - shared_bytes - attr.sharedSizeBytes);
+
+            // determine dynamically requested shared memory
+            char* ptr = (char*)nullptr;
+            unsigned int available_bytes = max_extra_bytes;
+            for (unsigned int i = 0; i < typpair_idx.getNumElements(); ++i)
+                {
+                params[i].load_shared(ptr, available_bytes);
+                }
+            for (unsigned int i = 0; i < pair_args.ntypes; ++i)
+                {
+                shape_params[i].load_shared(ptr, available_bytes);
+                }
+            shared_bytes += max_extra_bytes - available_bytes;
+
+            // the threads start at the i-cluster that holds the first particle
+            unsigned int n_threads = range.second - (range.first / cluster_size) * cluster_size;
+            dim3 grid(n_threads / block_size + 1, 1, 1);
+
+            hipLaunchKernelGGL((gpu_compute_pair_aniso_forces_cluster_kernel<evaluator,
+                                                                             shift_mode,
+                                                                             compute_virial,
+                                                                             cluster_size>),
+                               dim3(grid),
+                               dim3(block_size),
+                               shared_bytes,
+                               0,
+                               pair_args.d_force,
+                               pair_args.d_torque,
+                               pair_args.d_virial,
+                               pair_args.virial_pitch,
+                               range.first,
+                               range.second,
+                               pair_args.n_max,
+                               pair_args.d_pos,
+                               pair_args.d_diameter,
+                               pair_args.d_charge,
+                               pair_args.d_orientation,
+                               pair_args.d_tag,
+                               pair_args.box,
+                               pair_args.d_cluster_n_neigh,
+                               pair_args.d_cluster_nlist,
+                               pair_args.d_cluster_mask,
+                               pair_args.cluster_nmax,
+                               params,
+                               shape_params,
+                               pair_args.d_rcutsq,
+                               pair_args.ntypes,
+                               max_extra_bytes);
+            }
+        else
+            {
+            AnisoPairForceClusterKernel<evaluator, shift_mode, compute_virial, cluster_size / 2>::
+                launch(pair_args, range, params, shape_params);
+            }
+        }
+    };
+
+//! Template specialization to do nothing for clusters smaller than 4 particles
+template<class evaluator, unsigned int shift_mode, unsigned int compute_virial>
+struct AnisoPairForceClusterKernel<evaluator, shift_mode, compute_virial, 2>
+    {
+    static void launch(const a_pair_args_t& pair_args,
+                       std::pair<unsigned int, unsigned int> range,
+                       const typename evaluator::param_type* d_params,
+                       const typename evaluator::shape_type* shape_params)
+        {
+        // do nothing
+        }
+    };
+
+//! Launch the aniso pair force kernel that matches the neighbor list
+/*! \param pair_args Other arguments to pass onto the kernel
+    \param range Range of particle indices this GPU operates on
+    \param d_params Parameters for the potential, stored per type pair
+    \param d_shape_params Shape parameters for the potential, stored per type
+*/
+template<class evaluator, unsigned int shift_mode, unsigned int compute_virial>
+void launch_aniso_pair_force_kernel(const a_pair_args_t& pair_args,
+                                    std::pair<unsigned int, unsigned int> range,
+                                    const typename evaluator::param_type* d_params,
+                                    const typename evaluator::shape_type* d_shape_params)
+    {
+    if (pair_args.cluster_size != 0)
+        {
+        AnisoPairForceClusterKernel<evaluator, shift_mode, compute_virial, 8>::launch(
+            pair_args,
+            range,
+            d_params,
+            d_shape_params);
+        }
+    else
+        {
+        AnisoPairForceComputeKernel<evaluator,
+                                    shift_mode,
+                                    compute_virial,
+                                    gpu_aniso_pair_force_max_tpp>::launch(pair_args,
+                                                                          range,
+                                                                          d_params,
+                                                                          d_shape_params);
+        }
+    }
+
 //! Kernel driver that computes lj forces on the GPU for AnisoPotentialPairGPU
 /*! \param pair_args Other arguments to pass onto the kernel
     \param d_params Parameters for the potential, stored per type pair
@@ -551,20 +1012,18 @@ hipError_t gpu_compute_pair_aniso_forces(const a_pair_args_t& pair_args,
                 {
             case 0:
                 {
-                AnisoPairForceComputeKernel<evaluator, 0, 1, gpu_aniso_pair_force_max_tpp>::launch(
-                    pair_args,
-                    range,
-                    d_params,
-                    d_shape_params);
+                launch_aniso_pair_force_kernel<evaluator, 0, 1>(pair_args,
+                                                                 range,
+                                                                 d_params,
+                                                                 d_shape_params);
                 break;
                 }
             case 1:
                 {
-                AnisoPairForceComputeKernel<evaluator, 1, 1, gpu_aniso_pair_force_max_tpp>::launch(
-                    pair_args,
-                    range,
-                    d_params,
-                    d_shape_params);
+                launch_aniso_pair_force_kernel<evaluator, 1, 1>(pair_args,
+                                                                 range,
+                                                                 d_params,
+                                                                 d_shape_params);
                 break;
                 }
             default:
@@ -577,20 +1036,18 @@ hipError_t gpu_compute_pair_aniso_forces(const a_pair_args_t& pair_args,
                 {
             case 0:
                 {
-                AnisoPairForceComputeKernel<evaluator, 0, 0, gpu_aniso_pair_force_max_tpp>::launch(
-                    pair_args,
-                    range,
-                    d_params,
-                    d_shape_params);
+                launch_aniso_pair_force_kernel<evaluator, 0, 0>(pair_args,
+                                                                 range,
+                                                                 d_params,
+                                                                 d_shape_params);
                 break;
                 }
             case 1:
                 {
-                AnisoPairForceComputeKernel<evaluator, 1, 0, gpu_aniso_pair_force_max_tpp>::launch(
-                    pair_args,
-                    range,
-                    d_params,
-                    d_shape_params);
+                launch_aniso_pair_force_kernel<evaluator, 1, 0>(pair_args,
+                                                                 range,
+                                                                 d_params,
+                                                                 d_shape_params);
                 break;
                 }
             default:
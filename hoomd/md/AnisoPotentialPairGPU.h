@@ -10,6 +10,7 @@
 
 #include "AnisoPotentialPair.h"
 #include "AnisoPotentialPairGPU.cuh"
+#include "NeighborListGPUCluster.h"
 #include "hoomd/Autotuner.h"
 
 /*! \file AnisoPotentialPairGPU.h
@@ -70,11 +71,14 @@ class AnisoPotentialPairGPU : public AnisoPotentialPair<evaluator>
         AnisoPotentialPair<evaluator>::setAutotunerParams(enable, period);
         m_tuner->setPeriod(period);
         m_tuner->setEnabled(enable);
+        m_tuner_cluster->setPeriod(period);
+        m_tuner_cluster->setEnabled(enable);
         }
 
     protected:
     std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size and threads per particle
-    unsigned int m_param;               //!< Kernel tuning parameter
+    std::unique_ptr<Autotuner> m_tuner_cluster; //!< Autotuner for block size with cluster lists
+    unsigned int m_param;                       //!< Kernel tuning parameter
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
@@ -118,9 +122,19 @@ AnisoPotentialPairGPU<evaluator, gpu_cgpf>::AnisoPotentialPairGPU(
                                 100000,
                                 "aniso_pair_" + evaluator::getName(),
                                 this->m_exec_conf));
+
+    // the cluster kernel uses one thread per particle
+    m_tuner_cluster.reset(new Autotuner(warp_size,
+                                        1024,
+                                        warp_size,
+                                        5,
+                                        100000,
+                                        "aniso_pair_" + evaluator::getName() + "_cluster",
+                                        this->m_exec_conf));
 #ifdef ENABLE_MPI
     // synchronize autotuner results across ranks
     m_tuner->setSync(bool(this->m_pdata->getDomainDecomposition()));
+    m_tuner_cluster->setSync(bool(this->m_pdata->getDomainDecomposition()));
 #endif
     }
 
@@ -158,6 +172,35 @@ void AnisoPotentialPairGPU<evaluator, gpu_cgpf>::computeForces(uint64_t timestep
                                     access_location::device,
                                     access_mode::read);
 
+    // cluster pair lists are walked with one thread per particle
+    unsigned int cluster_size = this->m_nlist->getClusterSize();
+    std::shared_ptr<NeighborListGPUCluster> cluster_nlist;
+    if (cluster_size)
+        cluster_nlist = std::static_pointer_cast<NeighborListGPUCluster>(this->m_nlist);
+
+    // access the cluster pair list
+    const ArrayHandle<unsigned int>& d_cluster_n_neigh = cluster_nlist
+        ? ArrayHandle<unsigned int>(cluster_nlist->getClusterNNeighArray(),
+                                    access_location::device,
+                                    access_mode::read)
+        : ArrayHandle<unsigned int>(GlobalArray<unsigned int>(),
+                                    access_location::device,
+                                    access_mode::read);
+    const ArrayHandle<unsigned int>& d_cluster_nlist = cluster_nlist
+        ? ArrayHandle<unsigned int>(cluster_nlist->getClusterNListArray(),
+                                    access_location::device,
+                                    access_mode::read)
+        : ArrayHandle<unsigned int>(GlobalArray<unsigned int>(),
+                                    access_location::device,
+                                    access_mode::read);
+    const ArrayHandle<unsigned long long>& d_cluster_mask = cluster_nlist
+        ? ArrayHandle<unsigned long long>(cluster_nlist->getClusterMaskArray(),
+                                          access_location::device,
+                                          access_mode::read)
+        : ArrayHandle<unsigned long long>(GlobalArray<unsigned long long>(),
+                                          access_location::device,
+                                          access_mode::read);
+
     // access the particle data
     ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(),
                                access_location::device,
@@ -195,11 +238,22 @@ void AnisoPotentialPairGPU<evaluator, gpu_cgpf>::computeForces(uint64_t timestep
 
     this->m_exec_conf->beginMultiGPU();
 
-    if (!m_param)
+    // m_param overrides the autotuner, encoded as block_size*10000 + threads_per_particle
+    unsigned int block_size = m_param / 10000;
+    unsigned int threads_per_particle = m_param % 10000;
+    if (!m_param && cluster_size)
+        {
+        this->m_tuner_cluster->begin();
+        block_size = this->m_tuner_cluster->getParam();
+        threads_per_particle = 1;
+        }
+    else if (!m_param)
+        {
         this->m_tuner->begin();
-    unsigned int param = !m_param ? this->m_tuner->getParam() : m_param;
-    unsigned int block_size = param / 10000;
-    unsigned int threads_per_particle = param % 10000;
+        unsigned int param = this->m_tuner->getParam();
+        block_size = param / 10000;
+        threads_per_particle = param % 10000;
+        }
 
     // On the first iteration, shape parameters are updated. For optimization,
     // could track this between calls to avoid extra copying.
@@ -228,10 +282,17 @@ void AnisoPotentialPairGPU<evaluator, gpu_cgpf>::computeForces(uint64_t timestep
                                    threads_per_particle,
                                    this->m_pdata->getGPUPartition(),
                                    this->m_exec_conf->dev_prop,
-                                   first),
+                                   first,
+                                   cluster_size,
+                                   d_cluster_n_neigh.data,
+                                   d_cluster_nlist.data,
+                                   d_cluster_mask.data,
+                                   cluster_nlist ? cluster_nlist->getClusterNmax() : 0),
              d_params.data,
              d_shape_params.data);
-    if (!m_param)
+    if (!m_param && cluster_size)
+        this->m_tuner_cluster->end();
+    else if (!m_param)
         this->m_tuner->end();
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -23,7 +23,7 @@ namespace md
 */
 BondTablePotential::BondTablePotential(std::shared_ptr<SystemDefinition> sysdef,
                                        unsigned int table_width)
-    : ForceCompute(sysdef), m_table_width(table_width)
+    : ForceCompute(sysdef), m_table_width(table_width), m_use_spline(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondTablePotential" << endl;
 
@@ -40,6 +40,8 @@ BondTablePotential::BondTablePotential(std::shared_ptr<SystemDefinition> sysdef,
     // allocate storage for the tables and parameters
     GPUArray<Scalar2> tables(m_table_width, m_bond_data->getNTypes(), m_exec_conf);
     m_tables.swap(tables);
+    GPUArray<Scalar4> spline(m_table_width, m_bond_data->getNTypes(), m_exec_conf);
+    m_spline.swap(spline);
     GPUArray<Scalar4> params(m_bond_data->getNTypes(), m_exec_conf);
     m_params.swap(params);
     assert(!m_tables.isNull());
@@ -76,6 +78,7 @@ void BondTablePotential::setTable(unsigned int type,
 
     // access the arrays
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_spline(m_spline, access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::readwrite);
 
     // range check on the parameters
@@ -95,6 +98,7 @@ void BondTablePotential::setTable(unsigned int type,
     h_params.data[type].x = rmin;
     h_params.data[type].y = rmax;
     h_params.data[type].z = (rmax - rmin) / Scalar(m_table_width - 1);
+    h_params.data[type].w = Scalar(m_table_width - 1) / (rmax - rmin);
 
     // fill out the table
     for (unsigned int i = 0; i < m_table_width; i++)
@@ -102,6 +106,13 @@ void BondTablePotential::setTable(unsigned int type,
         h_tables.data[m_table_value(i, type)].x = V[i];
         h_tables.data[m_table_value(i, type)].y = F[i];
         }
+
+    // precompute the spline coefficients of each interval
+    for (unsigned int i = 0; i + 1 < m_table_width; i++)
+        {
+        h_spline.data[m_table_value(i, type)]
+            = detail::table_spline_coeff(V[i], V[i + 1], F[i], F[i + 1], h_params.data[type].z);
+        }
     }
 
 /*! \post The table based forces are computed for the given timestep.
@@ -173,7 +184,7 @@ void BondTablePotential::computeForces(uint64_t timestep)
         Scalar4 params = h_params.data[type];
         Scalar rmin = params.x;
         Scalar rmax = params.y;
-        Scalar delta_r = params.z;
+        Scalar inv_delta_r = params.w;
 
         // start computing the force
         Scalar rsq = dot(dx, dx);
@@ -184,26 +195,39 @@ void BondTablePotential::computeForces(uint64_t timestep)
         if (r < rmax && r >= rmin)
             {
             // precomputed term
-            Scalar value_f = (r - rmin) / delta_r;
+            Scalar value_f = (r - rmin) * inv_delta_r;
 
             // compute index into the table and read in values
 
             /// Here we use the table!!
             unsigned int value_i = (unsigned int)floor(value_f);
-            Scalar2 VF0 = h_tables.data[m_table_value(value_i, type)];
-            Scalar2 VF1 = h_tables.data[m_table_value(value_i + 1, type)];
-            // unpack the data
-            Scalar V0 = VF0.x;
-            Scalar V1 = VF1.x;
-            Scalar F0 = VF0.y;
-            Scalar F1 = VF1.y;
-
-            // compute the linear interpolation coefficient
+
+            // compute the interpolation coefficient
             Scalar f = value_f - Scalar(value_i);
 
-            // interpolate to get V and F;
-            Scalar V = V0 + f * (V1 - V0);
-            Scalar F = F0 + f * (F1 - F0);
+            Scalar V, F;
+            if (m_use_spline)
+                {
+                detail::table_spline_eval(h_spline.data[m_table_value(value_i, type)],
+                                          f,
+                                          inv_delta_r,
+                                          V,
+                                          F);
+                }
+            else
+                {
+                Scalar2 VF0 = h_tables.data[m_table_value(value_i, type)];
+                Scalar2 VF1 = h_tables.data[m_table_value(value_i + 1, type)];
+                // unpack the data
+                Scalar V0 = VF0.x;
+                Scalar V1 = VF1.x;
+                Scalar F0 = VF0.y;
+                Scalar F1 = VF1.y;
+
+                // interpolate to get V and F;
+                V = V0 + f * (V1 - V0);
+                F = F0 + f * (F1 - F0);
+                }
 
             // convert to standard variables used by the other pair computes in HOOMD-blue
             Scalar force_divr = Scalar(0.0);
@@ -256,7 +280,8 @@ void export_BondTablePotential(pybind11::module& m)
         m,
         "BondTablePotential")
         .def(pybind11::init<std::shared_ptr<SystemDefinition>, unsigned int>())
-        .def("setTable", &BondTablePotential::setTable);
+        .def("setTable", &BondTablePotential::setTable)
+        .def_property("spline", &BondTablePotential::getSpline, &BondTablePotential::setSpline);
     }
 
     } // end namespace detail
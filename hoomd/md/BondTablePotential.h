@@ -7,6 +7,8 @@
 #include "hoomd/GPUArray.h"
 #include "hoomd/Index1D.h"
 
+#include "TableSpline.h"
+
 #include <memory>
 
 /*! \file BondTablePotential.h
@@ -40,7 +42,7 @@ namespace md
 
     Three parameters need to be stored for each bond potential: rmin, rmax, and dr, the minimum r,
    maximum r, and spacing between r values in the table respectively. For simple access on the GPU,
-   these will be stored in a float4 where x is rmin, y is rmax, and z is dr.
+   these will be stored in a float4 where x is rmin, y is rmax, z is dr, and w is 1/dr.
 
     V(0) is the value of V at r=rmin. V(i) is the value of V at r=rmin + dr * i where i is chosen
    such that r >= rmin and r <= rmax. V(r) for r < rmin and > rmax is 0. The same goes for F. Thus V
@@ -52,7 +54,14 @@ namespace md
     Values are interpolated linearly between two points straddling the given r. For a given r, the
    first point needed, i can be calculated via i = floorf((r - rmin) / dr). The fraction between ri
    and ri+1 can be calculated via f = (r - rmin) / dr - float(i). And the linear interpolation can
-   then be performed via V(r) ~= Vi + f * (Vi+1 - Vi) \ingroup computes
+   then be performed via V(r) ~= Vi + f * (Vi+1 - Vi)
+
+    \b Spline interpolation
+    When spline interpolation is enabled, each interval of the table is interpolated with the cubic
+    spline described in TableSpline.h. The spline coefficients are computed in setTable() and
+    stored in \a m_spline with the same layout as \a m_tables.
+
+    \ingroup computes
 */
 class PYBIND11_EXPORT BondTablePotential : public ForceCompute
     {
@@ -70,6 +79,18 @@ class PYBIND11_EXPORT BondTablePotential : public ForceCompute
                           Scalar rmin,
                           Scalar rmax);
 
+    //! Set whether to interpolate the tables with cubic splines
+    void setSpline(bool spline)
+        {
+        m_use_spline = spline;
+        }
+
+    //! Get whether to interpolate the tables with cubic splines
+    bool getSpline() const
+        {
+        return m_use_spline;
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     /*! \param timestep Current time step
@@ -87,8 +108,10 @@ class PYBIND11_EXPORT BondTablePotential : public ForceCompute
     std::shared_ptr<BondData> m_bond_data; //!< Bond data to use in computing bonds
     unsigned int m_table_width;            //!< Width of the tables in memory
     GPUArray<Scalar2> m_tables;            //!< Stored V and F tables
+    GPUArray<Scalar4> m_spline;            //!< Spline coefficients of each table interval
     GPUArray<Scalar4> m_params;            //!< Parameters stored for each table
     Index2D m_table_value;                 //!< Index table helper
+    bool m_use_spline;                     //!< True to interpolate with cubic splines
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
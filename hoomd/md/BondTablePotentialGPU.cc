@@ -67,6 +67,7 @@ void BondTablePotentialGPU::computeForces(uint64_t timestep)
 
     // access the table data
     ArrayHandle<Scalar2> d_tables(m_tables, access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_spline(m_spline, access_location::device, access_mode::read);
     ArrayHandle<Scalar4> d_params(m_params, access_location::device, access_mode::read);
 
     ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::overwrite);
@@ -96,6 +97,8 @@ void BondTablePotentialGPU::computeForces(uint64_t timestep)
                                              d_gpu_n_bonds.data,
                                              m_bond_data->getNTypes(),
                                              d_tables.data,
+                                             d_spline.data,
+                                             m_use_spline,
                                              d_params.data,
                                              m_table_width,
                                              m_table_value,
@@ -32,6 +32,9 @@ namespace kernel
     \param pitch Pitch of 2D bond list
     \param n_bonds_list List of numbers of bonds stored on the GPU
     \param n_bond_type number of bond types
+    \param d_tables Tables of the potential and force
+    \param d_spline Spline coefficients of each table interval
+    \param use_spline True to interpolate with cubic splines
     \param d_params Parameters for each table associated with a type pair
     \param table_value index helper function
     \param d_flags Flag allocated on the device for use in checking for bonds that cannot be
@@ -50,6 +53,8 @@ __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
                                                     const unsigned int* n_bonds_list,
                                                     const unsigned int n_bond_type,
                                                     const Scalar2* d_tables,
+                                                    const Scalar4* d_spline,
+                                                    const bool use_spline,
                                                     const Scalar4* d_params,
                                                     const Index2D table_value,
                                                     unsigned int* d_flags)
@@ -106,7 +111,7 @@ __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
         Scalar4 params = s_params[cur_bond_type];
         Scalar rmin = params.x;
         Scalar rmax = params.y;
-        Scalar delta_r = params.z;
+        Scalar inv_delta_r = params.w;
 
         // calculate r
         Scalar rsq = dot(dx, dx);
@@ -115,25 +120,37 @@ __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
         if (r < rmax && r >= rmin)
             {
             // precomputed term
-            Scalar value_f = (r - rmin) / delta_r;
+            Scalar value_f = (r - rmin) * inv_delta_r;
 
             // compute index into the table and read in values
             unsigned int value_i = floor(value_f);
 
-            Scalar2 VF0 = __ldg(d_tables + table_value(value_i, cur_bond_type));
-            Scalar2 VF1 = __ldg(d_tables + table_value(value_i + 1, cur_bond_type));
-            // unpack the data
-            Scalar V0 = VF0.x;
-            Scalar V1 = VF1.x;
-            Scalar F0 = VF0.y;
-            Scalar F1 = VF1.y;
-
-            // compute the linear interpolation coefficient
+            // compute the interpolation coefficient
             Scalar f = value_f - Scalar(value_i);
 
-            // interpolate to get V and F;
-            Scalar V = V0 + f * (V1 - V0);
-            Scalar F = F0 + f * (F1 - F0);
+            Scalar V, F;
+            if (use_spline)
+                {
+                detail::table_spline_eval(__ldg(d_spline + table_value(value_i, cur_bond_type)),
+                                          f,
+                                          inv_delta_r,
+                                          V,
+                                          F);
+                }
+            else
+                {
+                Scalar2 VF0 = __ldg(d_tables + table_value(value_i, cur_bond_type));
+                Scalar2 VF1 = __ldg(d_tables + table_value(value_i + 1, cur_bond_type));
+                // unpack the data
+                Scalar V0 = VF0.x;
+                Scalar V1 = VF1.x;
+                Scalar F0 = VF0.y;
+                Scalar F1 = VF1.y;
+
+                // interpolate to get V and F;
+                V = V0 + f * (V1 - V0);
+                F = F0 + f * (F1 - F0);
+                }
 
             // convert to standard variables used by the other pair computes in HOOMD-blue
             Scalar forcemag_divr = 0.0f;
@@ -178,6 +195,8 @@ __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
     \param n_bonds_list List of numbers of bonds stored on the GPU
     \param n_bond_type number of bond types
     \param d_tables Tables of the potential and force
+    \param d_spline Spline coefficients of each table interval
+    \param use_spline True to interpolate with cubic splines
     \param d_params Parameters for each table associated with a type pair
     \param table_width Number of entries in the table
     \param table_value indexer helper
@@ -199,6 +218,8 @@ hipError_t gpu_compute_bondtable_forces(Scalar4* d_force,
                                         const unsigned int* n_bonds_list,
                                         const unsigned int n_bond_type,
                                         const Scalar2* d_tables,
+                                        const Scalar4* d_spline,
+                                        const bool use_spline,
                                         const Scalar4* d_params,
                                         const unsigned int table_width,
                                         const Index2D& table_value,
@@ -237,6 +258,8 @@ hipError_t gpu_compute_bondtable_forces(Scalar4* d_force,
                        n_bonds_list,
                        n_bond_type,
                        d_tables,
+                       d_spline,
+                       use_spline,
                        d_params,
                        table_value,
                        d_flags);
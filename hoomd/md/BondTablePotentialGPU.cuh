@@ -13,6 +13,8 @@
 #include "hoomd/Index1D.h"
 #include "hoomd/ParticleData.cuh"
 
+#include "TableSpline.h"
+
 #ifndef __BONDTABLEPOTENTIALGPU_CUH__
 #define __BONDTABLEPOTENTIALGPU_CUH__
 
@@ -34,6 +36,8 @@ hipError_t gpu_compute_bondtable_forces(Scalar4* d_force,
                                         const unsigned int* n_bonds_list,
                                         const unsigned int n_bond_type,
                                         const Scalar2* d_tables,
+                                        const Scalar4* d_spline,
+                                        const bool use_spline,
                                         const Scalar4* d_params,
                                         const unsigned int table_width,
                                         const Index2D& table_value,
@@ -27,7 +27,7 @@ namespace md
 */
 ComputeThermo::ComputeThermo(std::shared_ptr<SystemDefinition> sysdef,
                              std::shared_ptr<ParticleGroup> group)
-    : Compute(sysdef), m_group(group)
+    : Compute(sysdef), m_group(group), m_requested(thermo_request::all)
     {
     m_exec_conf->msg->notice(5) << "Constructing ComputeThermo" << endl;
 
@@ -68,8 +68,10 @@ void ComputeThermo::compute(uint64_t timestep)
     Compute::compute(timestep);
     if (shouldCompute(timestep))
         {
+        int64_t start_time = m_execution_clock.getTime();
         computeProperties();
-        m_computed_flags = m_pdata->getFlags();
+        m_execution_time += m_execution_clock.getTime() - start_time;
+        m_computed_flags = getRequestedFlags();
         }
     }
 
@@ -104,7 +106,7 @@ void ComputeThermo::computeProperties()
     // total kinetic energy
     double ke_trans_total = 0.0;
 
-    PDataFlags flags = m_pdata->getFlags();
+    PDataFlags flags = getRequestedFlags();
 
     double pressure_kinetic_xx = 0.0;
     double pressure_kinetic_xy = 0.0;
@@ -203,18 +205,21 @@ void ComputeThermo::computeProperties()
 
     // total potential energy
     double pe_total = 0.0;
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    if (m_requested & thermo_request::potential_energy)
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-
-        // ignore rigid body constituent particles in the sum
-        if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
             {
-            pe_total += (double)h_net_force.data[j].w;
+            unsigned int j = m_group->getMemberIndex(group_idx);
+
+            // ignore rigid body constituent particles in the sum
+            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
+                {
+                pe_total += (double)h_net_force.data[j].w;
+                }
             }
-        }
 
-    pe_total += m_pdata->getExternalEnergy();
+        pe_total += m_pdata->getExternalEnergy();
+        }
 
     double W = 0.0;
     double virial_xx = m_pdata->getExternalVirial(0);
@@ -305,15 +310,34 @@ void ComputeThermo::reduceProperties()
     if (m_properties_reduced)
         return;
 
-    // reduce properties
+    // gather the computed quantities so that they are reduced together in one call
+    unsigned int reduce_idx[thermo_index::num_quantities];
+    unsigned int n_reduce = 0;
+    reduce_idx[n_reduce++] = thermo_index::translational_kinetic_energy;
+    reduce_idx[n_reduce++] = thermo_index::rotational_kinetic_energy;
+    if (m_requested & thermo_request::potential_energy)
+        reduce_idx[n_reduce++] = thermo_index::potential_energy;
+    if (m_computed_flags[pdata_flag::pressure_tensor])
+        {
+        for (unsigned int i = thermo_index::pressure; i <= thermo_index::pressure_zz; ++i)
+            reduce_idx[n_reduce++] = i;
+        }
+
     ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::readwrite);
+    Scalar buf[thermo_index::num_quantities];
+    for (unsigned int i = 0; i < n_reduce; ++i)
+        buf[i] = h_properties.data[reduce_idx[i]];
+
     MPI_Allreduce(MPI_IN_PLACE,
-                  h_properties.data,
-                  thermo_index::num_quantities,
+                  buf,
+                  n_reduce,
                   MPI_HOOMD_SCALAR,
                   MPI_SUM,
                   m_exec_conf->getMPICommunicator());
 
+    for (unsigned int i = 0; i < n_reduce; ++i)
+        h_properties.data[reduce_idx[i]] = buf[i];
+
     m_properties_reduced = true;
     }
 #endif
@@ -48,6 +48,11 @@ namespace md
      - number of degrees of freedom (ndof)
      - number of particles in the group
 
+    Consumers that read only some of the quantities, like the thermostats in integration methods,
+   select them with setRequestedQuantities(). Quantities that are not requested are neither computed
+   nor reduced over MPI, and their getters return NaN. The requested quantities are reduced together
+   in a single MPI_Allreduce when the first of them is read.
+
     ndof is utilized in calculating the temperature from the kinetic energy. setNDOF() changes it to
    any value the user desires (the default is one!). In standard usage, the python interface queries
    the number of degrees of freedom from the integrators and sets that value for each ComputeThermo
@@ -228,6 +233,9 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
      */
     Scalar getPotentialEnergy()
         {
+        if (!(m_requested & thermo_request::potential_energy))
+            return std::numeric_limits<Scalar>::quiet_NaN();
+
 #ifdef ENABLE_MPI
         if (!m_properties_reduced)
             reduceProperties();
@@ -324,6 +332,18 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
         return m_properties;
         }
 
+    /// Select the optional quantities to compute (a combination of thermo_request flags)
+    void setRequestedQuantities(unsigned int requested)
+        {
+        m_requested = requested;
+        }
+
+    /// Get the optional quantities to compute
+    unsigned int getRequestedQuantities()
+        {
+        return m_requested;
+        }
+
     /// Get the box volume (or area in 2D)
     const Scalar getVolume()
         {
@@ -338,6 +358,18 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
     /// Store the particle data flags used during the last computation
     PDataFlags m_computed_flags;
 
+    /// Optional quantities to compute, a combination of thermo_request flags
+    unsigned int m_requested;
+
+    /// Get the particle data flags, excluding the quantities that are not requested
+    PDataFlags getRequestedFlags()
+        {
+        PDataFlags flags = m_pdata->getFlags();
+        if (!(m_requested & thermo_request::pressure_tensor))
+            flags[pdata_flag::pressure_tensor] = false;
+        return flags;
+        }
+
     //! Does the actual computation
     virtual void computeProperties();
 
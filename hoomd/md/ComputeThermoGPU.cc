@@ -128,7 +128,7 @@ void ComputeThermoGPU::computeProperties()
     ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
     BoxDim box = m_pdata->getGlobalBox();
 
-    PDataFlags flags = m_pdata->getFlags();
+    PDataFlags flags = getRequestedFlags();
 
         { // scope these array handles so they are released before the additional terms are added
         // access the net force, pe, and virial
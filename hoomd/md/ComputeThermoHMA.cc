@@ -92,10 +92,16 @@ void ComputeThermoHMA::compute(uint64_t timestep)
     if (!shouldCompute(timestep))
         return;
 
+    int64_t start_time = m_execution_clock.getTime();
     computeProperties();
+    m_execution_time += m_execution_clock.getTime() - start_time;
     }
 
 /*! Computes all thermodynamic properties of the system in one fell swoop.
+
+    Each rank sums the contributions of its local group members in one pass. The terms that do not
+    depend on the particles are added only on the root rank so that the single MPI_Allreduce in
+    reduceProperties() produces the global values.
  */
 void ComputeThermoHMA::computeProperties()
     {
@@ -104,6 +110,13 @@ void ComputeThermoHMA::computeProperties()
         return;
 
     unsigned int group_size = m_group->getNumMembers();
+    double N = double(m_group->getNumMembersGlobal());
+
+    bool root = true;
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        root = m_exec_conf->isRoot();
+#endif
 
     if (m_prof)
         m_prof->push("ThermoHMA");
@@ -135,35 +148,37 @@ void ComputeThermoHMA::computeProperties()
         {
         volume = L.x * L.y * L.z;
         }
-    double pe_total = 0.0, p_HMA = 0.0;
-    double fV = (m_harmonicPressure / m_temperature - group_size / box.getVolume())
-                / (D * (group_size - 1));
+    double pe_total = 0.0, fdr_total = 0.0;
+    double fV = (m_harmonicPressure / m_temperature - N / volume) / (D * (N - 1));
     double W = 0;
     size_t virial_pitch = net_virial.getPitch();
     for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
         {
         unsigned int j = m_group->getMemberIndex(group_idx);
-        unsigned int tag = h_tag.data[group_idx];
-        pe_total += (double)h_net_force.data[j].w;
+        unsigned int tag = h_tag.data[j];
+        Scalar4 net_force = h_net_force.data[j];
+        pe_total += (double)net_force.w;
         W += Scalar(1. / D)
              * ((double)h_net_virial.data[j + 0 * virial_pitch]
                 + (double)h_net_virial.data[j + 3 * virial_pitch]
                 + (double)h_net_virial.data[j + 5 * virial_pitch]);
 
-        Scalar4 pos4 = h_pos.data[group_idx];
+        // displacement from the cached lattice site
+        Scalar4 pos4 = h_pos.data[j];
         Scalar3 pos3 = make_scalar3(pos4.x, pos4.y, pos4.z);
-        Scalar3 dr = box.shift(pos3, h_image.data[group_idx]) - h_lattice_site.data[tag];
-        double fdr = 0;
-        fdr += (double)h_net_force.data[group_idx].x * dr.x;
-        fdr += (double)h_net_force.data[group_idx].y * dr.y;
-        fdr += (double)h_net_force.data[group_idx].z * dr.z;
-        pe_total += 0.5 * fdr;
-        p_HMA += fV * fdr;
+        Scalar3 dr = box.shift(pos3, h_image.data[j]) - h_lattice_site.data[tag];
+        fdr_total += (double)net_force.x * dr.x + (double)net_force.y * dr.y
+                     + (double)net_force.z * dr.z;
         }
-    pe_total += 1.5 * (group_size - 1) * m_temperature;
+    pe_total += 0.5 * fdr_total;
     pe_total += m_pdata->getExternalEnergy();
 
-    Scalar p_total = m_harmonicPressure + W / volume + p_HMA;
+    Scalar p_total = W / volume + fV * fdr_total;
+    if (root)
+        {
+        pe_total += 1.5 * (N - 1) * m_temperature;
+        p_total += m_harmonicPressure;
+        }
     ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::overwrite);
     h_properties.data[thermoHMA_index::potential_energyHMA] = Scalar(pe_total);
     h_properties.data[thermoHMA_index::pressureHMA] = p_total;
@@ -137,9 +137,6 @@ class PYBIND11_EXPORT ComputeThermoHMA : public Compute
         return m_harmonicPressure;
         }
 
-    //! Method to be called when particles are added/removed/sorted
-    void slotParticleSort();
-
     protected:
     std::shared_ptr<ParticleGroup> m_group; //!< Group to compute properties for
     GPUArray<Scalar> m_properties;          //!< Stores the computed properties
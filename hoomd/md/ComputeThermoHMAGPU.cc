@@ -165,6 +165,11 @@ void ComputeThermoHMAGPU::computeProperties()
         args.external_energy = m_pdata->getExternalEnergy();
         args.temperature = m_temperature;
         args.harmonicPressure = m_harmonicPressure;
+        args.root = true;
+#ifdef ENABLE_MPI
+        if (m_pdata->getDomainDecomposition())
+            args.root = m_exec_conf->isRoot();
+#endif
 
         // perform the computation on the GPU(s)
         gpu_compute_thermo_hma_partial(d_pos.data,
@@ -189,7 +194,7 @@ void ComputeThermoHMAGPU::computeProperties()
                                      d_body.data,
                                      d_tag.data,
                                      d_index_array.data,
-                                     group_size,
+                                     m_group->getNumMembersGlobal(),
                                      box,
                                      args);
 
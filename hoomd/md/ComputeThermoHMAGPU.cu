@@ -140,12 +140,13 @@ __global__ void gpu_compute_thermo_hma_partial_sums(Scalar3* d_scratch,
     \param d_scratch Partial sums
     \param box Box the particles are in
     \param D Dimensionality of the system
-    \param group_size Number of particles in the group
+    \param N Number of particles in the group on all ranks
     \param num_partial_sums Number of partial sums in \a d_scratch
     \param temperature The temperature that governs sampling of the integrator
     \param harmonicPressure The contribution to the pressure from harmonic fluctuations
     \param external_virial External contribution to virial (1/3 trace)
     \param external_energy External contribution to potential energy
+    \param root True when the terms that do not depend on the particles are added on this rank
 
 
     Only one block is executed. In that block, the partial sums are read in and reduced to final
@@ -158,12 +159,13 @@ __global__ void gpu_compute_thermo_hma_final_sums(Scalar* d_properties,
                                                   Scalar3* d_scratch,
                                                   BoxDim box,
                                                   unsigned int D,
-                                                  unsigned int group_size,
+                                                  unsigned int N,
                                                   unsigned int num_partial_sums,
                                                   Scalar temperature,
                                                   Scalar harmonicPressure,
                                                   Scalar external_virial,
-                                                  Scalar external_energy)
+                                                  Scalar external_energy,
+                                                  bool root)
     {
     Scalar3 final_sum = make_scalar3(Scalar(0.0), Scalar(0.0), Scalar(0.0));
 
@@ -234,12 +236,19 @@ __global__ void gpu_compute_thermo_hma_final_sums(Scalar* d_properties,
             }
 
         // pressure: P = (N * K_B * T + W)/V
-        Scalar fV = (harmonicPressure / temperature - group_size / volume) / (D * (group_size - 1));
-        Scalar pressure = harmonicPressure + W / volume + fV * fdr;
+        Scalar fV = (harmonicPressure / temperature - Scalar(N) / volume) / (D * (Scalar(N) - 1));
+        Scalar pressure = W / volume + fV * fdr;
+        pe_total += Scalar(0.5) * fdr;
+
+        // with MPI, only the root rank adds the terms that do not depend on the particles
+        if (root)
+            {
+            pressure += harmonicPressure;
+            pe_total += Scalar(1.5) * (Scalar(N) - 1) * temperature;
+            }
 
         // fill out the GPUArray
-        d_properties[thermoHMA_index::potential_energyHMA]
-            = pe_total + 1.5 * (group_size - 1) * temperature + 0.5 * fdr;
+        d_properties[thermoHMA_index::potential_energyHMA] = pe_total;
         d_properties[thermoHMA_index::pressureHMA] = pressure;
         }
     }
@@ -319,10 +328,9 @@ hipError_t gpu_compute_thermo_hma_partial(Scalar4* d_pos,
     \param d_body Particle body id
     \param d_tag Particle tag
     \param d_group_members List of group members
-    \param group_size Number of group members
+    \param N Number of group members on all ranks
     \param box Box the particles are in
     \param args Additional arguments
-    \param num_blocks Number of partial sums to reduce
 
     This function drives gpu_compute_thermo_partial_sums and gpu_compute_thermo_final_sums, see them
    for details.
@@ -332,7 +340,7 @@ hipError_t gpu_compute_thermo_hma_final(Scalar* d_properties,
                                         unsigned int* d_body,
                                         unsigned int* d_tag,
                                         unsigned int* d_group_members,
-                                        unsigned int group_size,
+                                        unsigned int N,
                                         const BoxDim& box,
                                         const compute_thermo_hma_args& args)
     {
@@ -358,12 +366,13 @@ hipError_t gpu_compute_thermo_hma_final(Scalar* d_properties,
                                                                        args.d_scratch,
                                                                        box,
                                                                        args.D,
-                                                                       group_size,
+                                                                       N,
                                                                        args.n_blocks,
                                                                        args.temperature,
                                                                        args.harmonicPressure,
                                                                        external_virial,
-                                                                       args.external_energy);
+                                                                       args.external_energy,
+                                                                       args.root);
 
     return hipSuccess;
     }
@@ -39,6 +39,7 @@ struct compute_thermo_hma_args
     Scalar external_energy;    //!< External potential energy
     Scalar temperature;        //!< Simulation temperature
     Scalar harmonicPressure;   //!< Harmonic pressure
+    bool root;                 //!< True if this rank adds the particle-independent terms
     };
 
 //! Computes the partial sums of thermodynamic properties for ComputeThermo
@@ -58,7 +59,7 @@ hipError_t gpu_compute_thermo_hma_final(Scalar* d_properties,
                                         unsigned int* d_body,
                                         unsigned int* d_tag,
                                         unsigned int* d_group_members,
-                                        unsigned int group_size,
+                                        unsigned int N,
                                         const BoxDim& box,
                                         const compute_thermo_hma_args& args);
 
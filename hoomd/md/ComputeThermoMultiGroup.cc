@@ -0,0 +1,433 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ComputeThermoMultiGroup.cc
+    \brief Contains code for the ComputeThermoMultiGroup class
+*/
+
+#include "ComputeThermoMultiGroup.h"
+#include "hoomd/VectorMath.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/Communicator.h"
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#include <pybind11/stl.h>
+
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System for which to compute thermodynamic properties
+    \param groups Subsets of the system over which properties are calculated
+*/
+ComputeThermoMultiGroup::ComputeThermoMultiGroup(
+    std::shared_ptr<SystemDefinition> sysdef,
+    std::vector<std::shared_ptr<ParticleGroup>> groups)
+    : Compute(sysdef), m_groups(groups)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing ComputeThermoMultiGroup" << endl;
+
+    if (m_groups.size() == 0 || m_groups.size() > max_groups)
+        {
+        throw std::invalid_argument("ComputeThermoMultiGroup supports 1 to "
+                                    + std::to_string(max_groups) + " groups, got "
+                                    + std::to_string(m_groups.size()) + ".");
+        }
+
+    GlobalArray<Scalar> sums(m_groups.size() * thermo_group_sum::num_sums, m_exec_conf);
+    m_sums.swap(sums);
+    TAG_ALLOCATION(m_sums);
+
+    ArrayHandle<Scalar> h_sums(m_sums, access_location::host, access_mode::overwrite);
+    for (unsigned int i = 0; i < m_sums.getNumElements(); i++)
+        h_sums.data[i] = Scalar(0.0);
+
+    m_computed_flags.reset();
+
+#ifdef ENABLE_MPI
+    m_sums_reduced = true;
+#endif
+    }
+
+ComputeThermoMultiGroup::~ComputeThermoMultiGroup()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying ComputeThermoMultiGroup" << endl;
+    }
+
+/*! Calls computeSums if the properties need updating
+    \param timestep Current time step of the simulation
+*/
+void ComputeThermoMultiGroup::compute(uint64_t timestep)
+    {
+    Compute::compute(timestep);
+    if (shouldCompute(timestep))
+        {
+        int64_t start_time = m_execution_clock.getTime();
+        computeSums();
+        m_execution_time += m_execution_clock.getTime() - start_time;
+        m_computed_flags = m_pdata->getFlags();
+
+#ifdef ENABLE_MPI
+        // in MPI, reduce the sums only when they're needed
+        m_sums_reduced = !m_pdata->getDomainDecomposition();
+#endif
+        }
+    }
+
+/*! \param group Index of the group
+ */
+std::shared_ptr<ParticleGroup> ComputeThermoMultiGroup::getGroup(unsigned int group)
+    {
+    if (group >= m_groups.size())
+        throw std::out_of_range("Group index out of range.");
+    return m_groups[group];
+    }
+
+/*! \param group Index of the group
+    \param sum Index of the sum (a thermo_group_sum value)
+*/
+Scalar ComputeThermoMultiGroup::getSum(unsigned int group, unsigned int sum)
+    {
+    getGroup(group);
+
+#ifdef ENABLE_MPI
+    if (!m_sums_reduced)
+        reduceSums();
+#endif
+
+    ArrayHandle<Scalar> h_sums(m_sums, access_location::host, access_mode::read);
+    return h_sums.data[group * thermo_group_sum::num_sums + sum];
+    }
+
+Scalar ComputeThermoMultiGroup::getVolume()
+    {
+    bool two_d = m_sysdef->getNDimensions() == 2;
+    return m_pdata->getGlobalBox().getVolume(two_d);
+    }
+
+/*! \param group Index of the group
+ */
+Scalar ComputeThermoMultiGroup::getTemperature(unsigned int group)
+    {
+    double ndof = getNDOF(group);
+    if (ndof > 0)
+        return Scalar(2.0) / ndof * getKineticEnergy(group);
+    else
+        return 0.0;
+    }
+
+/*! \param group Index of the group
+ */
+Scalar ComputeThermoMultiGroup::getTranslationalTemperature(unsigned int group)
+    {
+    double ndof = getTranslationalDOF(group);
+    if (ndof > 0)
+        return Scalar(2.0) / ndof * getTranslationalKineticEnergy(group);
+    else
+        return 0.0;
+    }
+
+/*! \param group Index of the group
+ */
+Scalar ComputeThermoMultiGroup::getRotationalTemperature(unsigned int group)
+    {
+    double ndof = getRotationalDOF(group);
+    if (ndof > 0)
+        return Scalar(2.0) / ndof * getRotationalKineticEnergy(group);
+    else
+        return 0.0;
+    }
+
+/*! \param group Index of the group
+
+    The trace of the pressure tensor sum is twice the translational kinetic energy plus the trace
+    of the virial, so P = trace / (D * V).
+*/
+Scalar ComputeThermoMultiGroup::getPressure(unsigned int group)
+    {
+    if (!m_computed_flags[pdata_flag::pressure_tensor])
+        {
+        getGroup(group);
+        return std::numeric_limits<Scalar>::quiet_NaN();
+        }
+
+    Scalar trace = getSum(group, thermo_group_sum::pressure_xx)
+                   + getSum(group, thermo_group_sum::pressure_yy)
+                   + getSum(group, thermo_group_sum::pressure_zz);
+    return trace / (Scalar(m_sysdef->getNDimensions()) * getVolume());
+    }
+
+/*! \param group Index of the group
+ */
+PressureTensor ComputeThermoMultiGroup::getPressureTensor(unsigned int group)
+    {
+    PressureTensor p;
+    if (m_computed_flags[pdata_flag::pressure_tensor])
+        {
+        Scalar volume = getVolume();
+        p.xx = getSum(group, thermo_group_sum::pressure_xx) / volume;
+        p.xy = getSum(group, thermo_group_sum::pressure_xy) / volume;
+        p.xz = getSum(group, thermo_group_sum::pressure_xz) / volume;
+        p.yy = getSum(group, thermo_group_sum::pressure_yy) / volume;
+        p.yz = getSum(group, thermo_group_sum::pressure_yz) / volume;
+        p.zz = getSum(group, thermo_group_sum::pressure_zz) / volume;
+        }
+    else
+        {
+        getGroup(group);
+        p.xx = std::numeric_limits<Scalar>::quiet_NaN();
+        p.xy = std::numeric_limits<Scalar>::quiet_NaN();
+        p.xz = std::numeric_limits<Scalar>::quiet_NaN();
+        p.yy = std::numeric_limits<Scalar>::quiet_NaN();
+        p.yz = std::numeric_limits<Scalar>::quiet_NaN();
+        p.zz = std::numeric_limits<Scalar>::quiet_NaN();
+        }
+    return p;
+    }
+
+/*! \param group Index of the group
+ */
+pybind11::list ComputeThermoMultiGroup::getPressureTensorPython(unsigned int group)
+    {
+    pybind11::list toReturn;
+    PressureTensor p = getPressureTensor(group);
+    toReturn.append(p.xx);
+    toReturn.append(p.xy);
+    toReturn.append(p.xz);
+    toReturn.append(p.yy);
+    toReturn.append(p.yz);
+    toReturn.append(p.zz);
+    return toReturn;
+    }
+
+/*! \param group Index of the group
+ */
+Scalar ComputeThermoMultiGroup::getTranslationalKineticEnergy(unsigned int group)
+    {
+    return getSum(group, thermo_group_sum::translational_kinetic_energy);
+    }
+
+/*! \param group Index of the group
+ */
+Scalar ComputeThermoMultiGroup::getRotationalKineticEnergy(unsigned int group)
+    {
+    // return 0.0 if the flags are not valid
+    if (!m_computed_flags[pdata_flag::rotational_kinetic_energy])
+        {
+        getGroup(group);
+        return 0.0;
+        }
+
+    return getSum(group, thermo_group_sum::rotational_kinetic_energy);
+    }
+
+/*! \param group Index of the group
+ */
+Scalar ComputeThermoMultiGroup::getPotentialEnergy(unsigned int group)
+    {
+    return getSum(group, thermo_group_sum::potential_energy);
+    }
+
+/*! Sums the contributions of all local particles to the groups they belong to in one loop.
+ */
+void ComputeThermoMultiGroup::computeSums()
+    {
+    if (m_prof)
+        m_prof->push("Thermo");
+
+    unsigned int n_groups = (unsigned int)m_groups.size();
+    PDataFlags flags = m_pdata->getFlags();
+    bool compute_pressure_tensor = flags[pdata_flag::pressure_tensor];
+    bool compute_rotational_energy = flags[pdata_flag::rotational_kinetic_energy];
+
+    // access the membership flags first, rebuilding the groups may access the tags. Groups with a
+    // bit in the membership masks shared by all groups are read from one mask per particle, the
+    // others from their own membership flags.
+    std::vector<unsigned int> bits(n_groups);
+    std::vector<std::unique_ptr<ArrayHandle<unsigned int>>> h_is_member(n_groups);
+    for (unsigned int g = 0; g < n_groups; g++)
+        {
+        m_groups[g]->getNumMembers();
+        bits[g] = m_groups[g]->getMembershipBit();
+        if (bits[g] == ParticleData::NO_GROUP_MEMBERSHIP_BIT)
+            h_is_member[g].reset(new ArrayHandle<unsigned int>(m_groups[g]->getIsMemberArray(),
+                                                               access_location::host,
+                                                               access_mode::read));
+        }
+    ArrayHandle<uint64_t> h_group_membership(m_pdata->getGroupMembership(),
+                                             access_location::host,
+                                             access_mode::read);
+
+    // access the particle data
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                  access_location::host,
+                                  access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                   access_location::host,
+                                   access_mode::read);
+
+    // access the net force, pe, and virial
+    const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
+    ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::read);
+    size_t virial_pitch = net_virial.getPitch();
+
+    std::vector<double> sums(n_groups * thermo_group_sum::num_sums, 0.0);
+
+    for (unsigned int j = 0; j < m_pdata->getN(); j++)
+        {
+        // ignore rigid body constituent particles in the sum
+        if (h_body.data[j] < MIN_FLOPPY && h_body.data[j] != h_tag.data[j])
+            continue;
+
+        unsigned int mask = 0;
+        for (unsigned int g = 0; g < n_groups; g++)
+            {
+            bool is_member = bits[g] != ParticleData::NO_GROUP_MEMBERSHIP_BIT
+                                 ? (h_group_membership.data[j] >> bits[g]) & 1
+                                 : h_is_member[g]->data[j] != 0;
+            if (is_member)
+                mask |= 1u << g;
+            }
+
+        if (mask == 0)
+            continue;
+
+        // contributions of this particle
+        double c[thermo_group_sum::num_sums];
+        double mass = h_vel.data[j].w;
+        double vx = h_vel.data[j].x;
+        double vy = h_vel.data[j].y;
+        double vz = h_vel.data[j].z;
+        c[thermo_group_sum::pressure_xx] = mass * vx * vx;
+        c[thermo_group_sum::pressure_xy] = mass * vx * vy;
+        c[thermo_group_sum::pressure_xz] = mass * vx * vz;
+        c[thermo_group_sum::pressure_yy] = mass * vy * vy;
+        c[thermo_group_sum::pressure_yz] = mass * vy * vz;
+        c[thermo_group_sum::pressure_zz] = mass * vz * vz;
+        c[thermo_group_sum::translational_kinetic_energy]
+            = 0.5
+              * (c[thermo_group_sum::pressure_xx] + c[thermo_group_sum::pressure_yy]
+                 + c[thermo_group_sum::pressure_zz]);
+
+        if (compute_pressure_tensor)
+            {
+            for (unsigned int i = 0; i < 6; i++)
+                c[thermo_group_sum::pressure_xx + i] += h_net_virial.data[j + i * virial_pitch];
+            }
+
+        c[thermo_group_sum::rotational_kinetic_energy] = 0.0;
+        if (compute_rotational_energy)
+            {
+            Scalar3 I = h_inertia.data[j];
+            quat<Scalar> q(h_orientation.data[j]);
+            quat<Scalar> p(h_angmom.data[j]);
+            quat<Scalar> s(Scalar(0.5) * conj(q) * p);
+
+            // only if the moment of inertia along one principal axis is non-zero, that axis
+            // carries angular momentum
+            double ke_rot = 0.0;
+            if (I.x > 0)
+                ke_rot += s.v.x * s.v.x / I.x;
+            if (I.y > 0)
+                ke_rot += s.v.y * s.v.y / I.y;
+            if (I.z > 0)
+                ke_rot += s.v.z * s.v.z / I.z;
+            c[thermo_group_sum::rotational_kinetic_energy] = 0.5 * ke_rot;
+            }
+
+        c[thermo_group_sum::potential_energy] = h_net_force.data[j].w;
+
+        for (unsigned int g = 0; g < n_groups; g++)
+            {
+            if (mask & (1u << g))
+                {
+                for (unsigned int i = 0; i < thermo_group_sum::num_sums; i++)
+                    sums[g * thermo_group_sum::num_sums + i] += c[i];
+                }
+            }
+        }
+
+    // add the external contributions to every group, like ComputeThermo
+    ArrayHandle<Scalar> h_sums(m_sums, access_location::host, access_mode::overwrite);
+    for (unsigned int g = 0; g < n_groups; g++)
+        {
+        double* group_sums = &sums[g * thermo_group_sum::num_sums];
+        group_sums[thermo_group_sum::potential_energy] += m_pdata->getExternalEnergy();
+        if (compute_pressure_tensor)
+            {
+            for (unsigned int i = 0; i < 6; i++)
+                group_sums[thermo_group_sum::pressure_xx + i] += m_pdata->getExternalVirial(i);
+            }
+
+        for (unsigned int i = 0; i < thermo_group_sum::num_sums; i++)
+            h_sums.data[g * thermo_group_sum::num_sums + i] = Scalar(group_sums[i]);
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+#ifdef ENABLE_MPI
+void ComputeThermoMultiGroup::reduceSums()
+    {
+    if (m_sums_reduced)
+        return;
+
+    // all sums are extensive, reduce the sums of all groups in one call
+    ArrayHandle<Scalar> h_sums(m_sums, access_location::host, access_mode::readwrite);
+    MPI_Allreduce(MPI_IN_PLACE,
+                  h_sums.data,
+                  (int)m_sums.getNumElements(),
+                  MPI_HOOMD_SCALAR,
+                  MPI_SUM,
+                  m_exec_conf->getMPICommunicator());
+
+    m_sums_reduced = true;
+    }
+#endif
+
+namespace detail
+    {
+void export_ComputeThermoMultiGroup(pybind11::module& m)
+    {
+    pybind11::class_<ComputeThermoMultiGroup, Compute, std::shared_ptr<ComputeThermoMultiGroup>>(
+        m,
+        "ComputeThermoMultiGroup")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::vector<std::shared_ptr<ParticleGroup>>>())
+        .def_property_readonly("num_groups", &ComputeThermoMultiGroup::getNumGroups)
+        .def("getKineticTemperature", &ComputeThermoMultiGroup::getTemperature)
+        .def("getPressure", &ComputeThermoMultiGroup::getPressure)
+        .def("getPressureTensor", &ComputeThermoMultiGroup::getPressureTensorPython)
+        .def("getDegreesOfFreedom", &ComputeThermoMultiGroup::getNDOF)
+        .def("getTranslationalDegreesOfFreedom", &ComputeThermoMultiGroup::getTranslationalDOF)
+        .def("getRotationalDegreesOfFreedom", &ComputeThermoMultiGroup::getRotationalDOF)
+        .def("getNumParticles", &ComputeThermoMultiGroup::getNumParticles)
+        .def("getKineticEnergy", &ComputeThermoMultiGroup::getKineticEnergy)
+        .def("getTranslationalKineticEnergy",
+             &ComputeThermoMultiGroup::getTranslationalKineticEnergy)
+        .def("getRotationalKineticEnergy", &ComputeThermoMultiGroup::getRotationalKineticEnergy)
+        .def("getPotentialEnergy", &ComputeThermoMultiGroup::getPotentialEnergy);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
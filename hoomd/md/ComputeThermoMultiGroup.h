@@ -0,0 +1,166 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ComputeThermoTypes.h"
+#include "hoomd/Compute.h"
+#include "hoomd/GlobalArray.h"
+#include "hoomd/ParticleGroup.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file ComputeThermoMultiGroup.h
+    \brief Declares a class for computing thermodynamic quantities of many groups at once
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __COMPUTE_THERMO_MULTI_GROUP_H__
+#define __COMPUTE_THERMO_MULTI_GROUP_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Computes thermodynamic properties of several groups of particles in one pass
+/*! Separate ComputeThermo instances each loop over their group members and reduce their
+    properties over MPI on their own. ComputeThermoMultiGroup instead loops over the local
+    particles once. For each particle it builds a bit mask of the groups that the particle belongs
+    to and adds the particle's contributions to the sums of those groups. The sums of all groups
+    (see thermo_group_sum) are reduced over MPI in a single MPI_Allreduce when the first quantity
+    is read.
+
+    The membership of the groups may change between calls (e.g. with dynamic filters), so the bit
+    masks are built in every pass. They are read from the membership masks that the particle data
+    shares among all groups (see ParticleData::getGroupMembership()), with one load per particle.
+    Only groups without a bit in those masks are read from their own membership flags. At most
+    max_groups groups are supported.
+
+    The quantities match those of ComputeThermo for the same group.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT ComputeThermoMultiGroup : public Compute
+    {
+    public:
+    //! Maximum number of groups, the number of bits in the group masks
+    static const unsigned int max_groups = 32;
+
+    //! Constructs the compute
+    ComputeThermoMultiGroup(std::shared_ptr<SystemDefinition> sysdef,
+                            std::vector<std::shared_ptr<ParticleGroup>> groups);
+
+    //! Destructor
+    virtual ~ComputeThermoMultiGroup();
+
+    //! Compute the properties
+    virtual void compute(uint64_t timestep);
+
+    //! Get the number of groups
+    unsigned int getNumGroups()
+        {
+        return (unsigned int)m_groups.size();
+        }
+
+    //! Returns the temperature of a group
+    Scalar getTemperature(unsigned int group);
+
+    //! Returns the translational temperature of a group
+    Scalar getTranslationalTemperature(unsigned int group);
+
+    //! Returns the rotational temperature of a group
+    Scalar getRotationalTemperature(unsigned int group);
+
+    //! Returns the pressure of a group, or NaN if the pressure is not available
+    Scalar getPressure(unsigned int group);
+
+    //! Returns the pressure tensor of a group, with NaN entries if it is not available
+    PressureTensor getPressureTensor(unsigned int group);
+
+    //! Returns the pressure tensor of a group as a python list to be used for logging
+    pybind11::list getPressureTensorPython(unsigned int group);
+
+    //! Returns the translational kinetic energy of a group
+    Scalar getTranslationalKineticEnergy(unsigned int group);
+
+    //! Returns the rotational kinetic energy of a group
+    Scalar getRotationalKineticEnergy(unsigned int group);
+
+    //! Returns the total kinetic energy of a group
+    Scalar getKineticEnergy(unsigned int group)
+        {
+        return getTranslationalKineticEnergy(group) + getRotationalKineticEnergy(group);
+        }
+
+    //! Returns the potential energy of a group
+    Scalar getPotentialEnergy(unsigned int group);
+
+    //! Returns the number of degrees of freedom of a group
+    double getNDOF(unsigned int group)
+        {
+        return getGroup(group)->getTranslationalDOF() + getGroup(group)->getRotationalDOF();
+        }
+
+    //! Returns the number of translational degrees of freedom of a group
+    double getTranslationalDOF(unsigned int group)
+        {
+        return getGroup(group)->getTranslationalDOF();
+        }
+
+    //! Returns the number of rotational degrees of freedom of a group
+    double getRotationalDOF(unsigned int group)
+        {
+        return getGroup(group)->getRotationalDOF();
+        }
+
+    //! Returns the number of particles in a group
+    unsigned int getNumParticles(unsigned int group)
+        {
+        return getGroup(group)->getNumMembersGlobal();
+        }
+
+    protected:
+    std::vector<std::shared_ptr<ParticleGroup>> m_groups; //!< Groups to compute properties for
+
+    /// Sums of the groups, thermo_group_sum::num_sums values per group
+    GlobalArray<Scalar> m_sums;
+
+    /// Store the particle data flags used during the last computation
+    PDataFlags m_computed_flags;
+
+    //! Get a group, checking the index
+    std::shared_ptr<ParticleGroup> getGroup(unsigned int group);
+
+    //! Get a sum of a group, reducing the sums first if needed
+    Scalar getSum(unsigned int group, unsigned int sum);
+
+    //! Get the box volume (or area in 2D)
+    Scalar getVolume();
+
+    //! Computes the local sums of all groups
+    virtual void computeSums();
+
+#ifdef ENABLE_MPI
+    bool m_sums_reduced; //!< True if the sums have been reduced across MPI
+
+    //! Reduce the sums of all groups over MPI
+    void reduceSums();
+#endif
+    };
+
+namespace detail
+    {
+//! Exports the ComputeThermoMultiGroup class to python
+#ifndef __HIPCC__
+void export_ComputeThermoMultiGroup(pybind11::module& m);
+#endif
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -0,0 +1,149 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ComputeThermoMultiGroupGPU.cc
+    \brief Contains code for the ComputeThermoMultiGroupGPU class
+*/
+
+#include "ComputeThermoMultiGroupGPU.h"
+#include "ComputeThermoMultiGroupGPU.cuh"
+
+#include <pybind11/stl.h>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System for which to compute thermodynamic properties
+    \param groups Subsets of the system over which properties are calculated
+*/
+ComputeThermoMultiGroupGPU::ComputeThermoMultiGroupGPU(
+    std::shared_ptr<SystemDefinition> sysdef,
+    std::vector<std::shared_ptr<ParticleGroup>> groups)
+    : ComputeThermoMultiGroup(sysdef, groups), m_scratch(m_exec_conf)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error()
+            << "Creating a ComputeThermoMultiGroupGPU with no GPU in the execution configuration"
+            << endl;
+        throw std::runtime_error("Error initializing ComputeThermoMultiGroupGPU");
+        }
+
+    m_block_size = 256;
+    }
+
+ComputeThermoMultiGroupGPU::~ComputeThermoMultiGroupGPU() { }
+
+/*! Sums the contributions of all local particles to the groups they belong to in one kernel.
+ */
+void ComputeThermoMultiGroupGPU::computeSums()
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "Thermo");
+
+    unsigned int n_groups = (unsigned int)m_groups.size();
+    PDataFlags flags = m_pdata->getFlags();
+
+    // number of blocks in the reduction
+    unsigned int num_blocks = m_pdata->getN() / m_block_size + 1;
+    m_scratch.resize(n_groups * thermo_group_sum::num_sums * num_blocks);
+
+    // access the membership flags first, rebuilding the groups may access the tags
+    std::vector<std::unique_ptr<ArrayHandle<unsigned int>>> d_is_member(n_groups);
+    kernel::thermo_group_membership membership;
+    membership.n_groups = n_groups;
+    for (unsigned int g = 0; g < n_groups; g++)
+        {
+        m_groups[g]->getNumMembers();
+        membership.bit[g] = m_groups[g]->getMembershipBit();
+        membership.d_is_member[g] = nullptr;
+        if (membership.bit[g] == ParticleData::NO_GROUP_MEMBERSHIP_BIT)
+            {
+            d_is_member[g].reset(new ArrayHandle<unsigned int>(m_groups[g]->getIsMemberArray(),
+                                                               access_location::device,
+                                                               access_mode::read));
+            membership.d_is_member[g] = d_is_member[g]->data;
+            }
+        }
+    ArrayHandle<uint64_t> d_group_membership(m_pdata->getGroupMembership(),
+                                             access_location::device,
+                                             access_mode::read);
+    membership.d_group_membership = d_group_membership.data;
+
+    // access the particle data
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                               access_location::device,
+                               access_mode::read);
+    ArrayHandle<unsigned int> d_body(m_pdata->getBodies(),
+                                     access_location::device,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
+                                       access_location::device,
+                                       access_mode::read);
+    ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(),
+                                  access_location::device,
+                                  access_mode::read);
+    ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                   access_location::device,
+                                   access_mode::read);
+
+    // access the net force, pe, and virial
+    const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
+    ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(),
+                                     access_location::device,
+                                     access_mode::read);
+    ArrayHandle<Scalar> d_net_virial(net_virial, access_location::device, access_mode::read);
+
+    ArrayHandle<Scalar> d_scratch(m_scratch, access_location::device, access_mode::overwrite);
+    ArrayHandle<Scalar> d_sums(m_sums, access_location::device, access_mode::overwrite);
+
+    // build up args list
+    kernel::compute_thermo_multi_group_args args;
+    args.d_vel = d_vel.data;
+    args.d_body = d_body.data;
+    args.d_tag = d_tag.data;
+    args.d_net_force = d_net_force.data;
+    args.d_net_virial = d_net_virial.data;
+    args.virial_pitch = net_virial.getPitch();
+    args.d_orientation = d_orientation.data;
+    args.d_angmom = d_angmom.data;
+    args.d_inertia = d_inertia.data;
+    args.N = m_pdata->getN();
+    args.d_scratch = d_scratch.data;
+    args.block_size = m_block_size;
+    args.n_blocks = num_blocks;
+    for (unsigned int i = 0; i < 6; i++)
+        args.external_virial[i] = m_pdata->getExternalVirial(i);
+    args.external_energy = m_pdata->getExternalEnergy();
+
+    kernel::gpu_compute_thermo_multi_group(d_sums.data,
+                                           membership,
+                                           args,
+                                           flags[pdata_flag::pressure_tensor],
+                                           flags[pdata_flag::rotational_kinetic_energy]);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+namespace detail
+    {
+void export_ComputeThermoMultiGroupGPU(pybind11::module& m)
+    {
+    pybind11::class_<ComputeThermoMultiGroupGPU,
+                     ComputeThermoMultiGroup,
+                     std::shared_ptr<ComputeThermoMultiGroupGPU>>(m, "ComputeThermoMultiGroupGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::vector<std::shared_ptr<ParticleGroup>>>());
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,265 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ComputeThermoMultiGroupGPU.cuh"
+#include "hoomd/VectorMath.h"
+#include <hip/hip_runtime.h>
+
+#include <assert.h>
+
+/*! \file ComputeThermoMultiGroupGPU.cu
+    \brief Defines GPU kernel code for computing thermodynamic properties of many groups on the
+   GPU. Used by ComputeThermoMultiGroupGPU.
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Perform partial sums of the thermo properties of all groups on the GPU
+/*! \param d_scratch Scratch space to hold partial sums. One element per group, sum, and block
+    \param membership Membership flags of the groups
+    \param args Particle data and execution parameters
+    \param compute_pressure_tensor Add the virial to the pressure tensor sums
+    \param compute_rotational_energy Sum the rotational kinetic energy
+
+    One thread is executed per local particle. That thread builds the bit mask of the groups its
+   particle belongs to and computes the thermo_group_sum::num_sums contributions of the particle.
+   The block then performs one parallel reduction per group, skipping the groups that have no
+   members in the block. The partial sum of sum i of group g is written to
+   d_scratch[(g*num_sums + i)*gridDim.x + blockIdx.x]. For this kernel to run,
+   num_sums*sizeof(Scalar)*block_size of dynamic shared memory are needed.
+*/
+__global__ void
+gpu_compute_thermo_multi_group_partial_sums(Scalar* d_scratch,
+                                            const thermo_group_membership membership,
+                                            const compute_thermo_multi_group_args args,
+                                            bool compute_pressure_tensor,
+                                            bool compute_rotational_energy)
+    {
+    extern __shared__ Scalar compute_thermo_multi_group_sdata[];
+
+    // determine which particle this thread works on
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    // non-participating threads: belong to no group and contribute 0 to the sums
+    unsigned int mask = 0;
+    Scalar my_element[thermo_group_sum::num_sums];
+    for (unsigned int i = 0; i < thermo_group_sum::num_sums; i++)
+        my_element[i] = Scalar(0.0);
+
+    // ignore rigid body constituent particles in the sum
+    if (idx < args.N && (args.d_body[idx] >= MIN_FLOPPY || args.d_body[idx] == args.d_tag[idx]))
+        {
+        uint64_t group_membership = membership.d_group_membership[idx];
+        for (unsigned int g = 0; g < membership.n_groups; g++)
+            {
+            bool is_member = membership.d_is_member[g]
+                                 ? membership.d_is_member[g][idx] != 0
+                                 : (group_membership >> membership.bit[g]) & 1;
+            if (is_member)
+                mask |= 1u << g;
+            }
+        }
+
+    if (mask)
+        {
+        Scalar4 vel = args.d_vel[idx];
+        Scalar mass = vel.w;
+        my_element[thermo_group_sum::pressure_xx] = mass * vel.x * vel.x;
+        my_element[thermo_group_sum::pressure_xy] = mass * vel.x * vel.y;
+        my_element[thermo_group_sum::pressure_xz] = mass * vel.x * vel.z;
+        my_element[thermo_group_sum::pressure_yy] = mass * vel.y * vel.y;
+        my_element[thermo_group_sum::pressure_yz] = mass * vel.y * vel.z;
+        my_element[thermo_group_sum::pressure_zz] = mass * vel.z * vel.z;
+        my_element[thermo_group_sum::translational_kinetic_energy]
+            = Scalar(0.5) * mass * (vel.x * vel.x + vel.y * vel.y + vel.z * vel.z);
+
+        if (compute_pressure_tensor)
+            {
+            for (unsigned int i = 0; i < 6; i++)
+                my_element[thermo_group_sum::pressure_xx + i]
+                    += args.d_net_virial[i * args.virial_pitch + idx];
+            }
+
+        if (compute_rotational_energy)
+            {
+            Scalar3 I = args.d_inertia[idx];
+            quat<Scalar> q(args.d_orientation[idx]);
+            quat<Scalar> p(args.d_angmom[idx]);
+            quat<Scalar> s(Scalar(0.5) * conj(q) * p);
+
+            // only if the moment of inertia along one principal axis is non-zero, that axis
+            // carries angular momentum
+            Scalar ke_rot(0.0);
+            if (I.x > 0)
+                ke_rot += s.v.x * s.v.x / I.x;
+            if (I.y > 0)
+                ke_rot += s.v.y * s.v.y / I.y;
+            if (I.z > 0)
+                ke_rot += s.v.z * s.v.z / I.z;
+            my_element[thermo_group_sum::rotational_kinetic_energy] = Scalar(0.5) * ke_rot;
+            }
+
+        my_element[thermo_group_sum::potential_energy] = args.d_net_force[idx].w;
+        }
+
+    for (unsigned int g = 0; g < membership.n_groups; g++)
+        {
+        bool member = mask & (1u << g);
+
+        // skip the reduction when no particle in this block belongs to the group
+        if (!__syncthreads_or(member))
+            {
+            if (threadIdx.x < thermo_group_sum::num_sums)
+                d_scratch[(g * thermo_group_sum::num_sums + threadIdx.x) * gridDim.x + blockIdx.x]
+                    = Scalar(0.0);
+            continue;
+            }
+
+        for (unsigned int i = 0; i < thermo_group_sum::num_sums; i++)
+            compute_thermo_multi_group_sdata[i * blockDim.x + threadIdx.x]
+                = member ? my_element[i] : Scalar(0.0);
+
+        __syncthreads();
+
+        // reduce the sum in parallel
+        int offs = blockDim.x >> 1;
+        while (offs > 0)
+            {
+            if (threadIdx.x < offs)
+                {
+                for (unsigned int i = 0; i < thermo_group_sum::num_sums; i++)
+                    compute_thermo_multi_group_sdata[i * blockDim.x + threadIdx.x]
+                        += compute_thermo_multi_group_sdata[i * blockDim.x + threadIdx.x + offs];
+                }
+            offs >>= 1;
+            __syncthreads();
+            }
+
+        // write out our partial sums
+        if (threadIdx.x < thermo_group_sum::num_sums)
+            d_scratch[(g * thermo_group_sum::num_sums + threadIdx.x) * gridDim.x + blockIdx.x]
+                = compute_thermo_multi_group_sdata[threadIdx.x * blockDim.x];
+        }
+    }
+
+//! Complete the sums of the thermo properties of all groups on the GPU
+/*! \param d_sums Array to write the sums of all groups to
+    \param d_scratch Partial sums from gpu_compute_thermo_multi_group_partial_sums
+    \param num_partial_sums Number of partial sums per group and sum
+    \param args External contributions
+    \param compute_pressure_tensor Add the external virial to the pressure tensor sums
+
+    One block is executed per group and sum, it writes d_sums[blockIdx.x]. For this kernel to run,
+   sizeof(Scalar)*block_size of dynamic shared memory are needed.
+*/
+__global__ void
+gpu_compute_thermo_multi_group_final_sums(Scalar* d_sums,
+                                          Scalar* d_scratch,
+                                          unsigned int num_partial_sums,
+                                          const compute_thermo_multi_group_args args,
+                                          bool compute_pressure_tensor)
+    {
+    extern __shared__ Scalar compute_thermo_multi_group_final_sdata[];
+
+    Scalar final_sum(0.0);
+
+    // sum up the values in the partial sum via a sliding window
+    for (unsigned int start = 0; start < num_partial_sums; start += blockDim.x)
+        {
+        __syncthreads();
+        if (start + threadIdx.x < num_partial_sums)
+            compute_thermo_multi_group_final_sdata[threadIdx.x]
+                = d_scratch[blockIdx.x * num_partial_sums + start + threadIdx.x];
+        else
+            compute_thermo_multi_group_final_sdata[threadIdx.x] = Scalar(0.0);
+        __syncthreads();
+
+        // reduce the sum in parallel
+        int offs = blockDim.x >> 1;
+        while (offs > 0)
+            {
+            if (threadIdx.x < offs)
+                compute_thermo_multi_group_final_sdata[threadIdx.x]
+                    += compute_thermo_multi_group_final_sdata[threadIdx.x + offs];
+            offs >>= 1;
+            __syncthreads();
+            }
+
+        // everybody sums up final_sum
+        final_sum += compute_thermo_multi_group_final_sdata[0];
+        }
+
+    if (threadIdx.x == 0)
+        {
+        // add the external contributions to every group, like ComputeThermo
+        unsigned int sum = blockIdx.x % thermo_group_sum::num_sums;
+        if (sum == thermo_group_sum::potential_energy)
+            final_sum += args.external_energy;
+        else if (compute_pressure_tensor && sum < 6)
+            final_sum += args.external_virial[sum];
+
+        d_sums[blockIdx.x] = final_sum;
+        }
+    }
+
+/*! \param d_sums Array to write the sums of all groups to
+    \param membership Membership flags of the groups
+    \param args Particle data and execution parameters
+    \param compute_pressure_tensor Add the virial to the pressure tensor sums
+    \param compute_rotational_energy Sum the rotational kinetic energy
+
+    This function drives gpu_compute_thermo_multi_group_partial_sums and
+   gpu_compute_thermo_multi_group_final_sums, see them for details.
+*/
+hipError_t gpu_compute_thermo_multi_group(Scalar* d_sums,
+                                          const thermo_group_membership& membership,
+                                          const compute_thermo_multi_group_args& args,
+                                          bool compute_pressure_tensor,
+                                          bool compute_rotational_energy)
+    {
+    assert(d_sums);
+    assert(args.d_scratch);
+    assert(membership.n_groups <= 32);
+
+    dim3 grid(args.n_blocks, 1, 1);
+    dim3 threads(args.block_size, 1, 1);
+    size_t shared_bytes = thermo_group_sum::num_sums * sizeof(Scalar) * args.block_size;
+
+    hipLaunchKernelGGL(gpu_compute_thermo_multi_group_partial_sums,
+                       dim3(grid),
+                       dim3(threads),
+                       shared_bytes,
+                       0,
+                       args.d_scratch,
+                       membership,
+                       args,
+                       compute_pressure_tensor,
+                       compute_rotational_energy);
+
+    // one block per group and sum
+    int final_block_size = 256;
+    grid = dim3(membership.n_groups * thermo_group_sum::num_sums, 1, 1);
+    threads = dim3(final_block_size, 1, 1);
+    shared_bytes = sizeof(Scalar) * final_block_size;
+
+    hipLaunchKernelGGL(gpu_compute_thermo_multi_group_final_sums,
+                       dim3(grid),
+                       dim3(threads),
+                       shared_bytes,
+                       0,
+                       d_sums,
+                       args.d_scratch,
+                       args.n_blocks,
+                       args,
+                       compute_pressure_tensor);
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
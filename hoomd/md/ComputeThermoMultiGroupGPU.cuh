@@ -0,0 +1,61 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _COMPUTE_THERMO_MULTI_GROUP_GPU_CUH_
+#define _COMPUTE_THERMO_MULTI_GROUP_GPU_CUH_
+
+#include "ComputeThermoTypes.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/ParticleData.cuh"
+
+/*! \file ComputeThermoMultiGroupGPU.cuh
+    \brief Kernel driver function declarations for ComputeThermoMultiGroupGPU
+    */
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Membership flags of the groups, passed to the kernel by value
+struct thermo_group_membership
+    {
+    const uint64_t* d_group_membership;  //!< Membership masks shared by all groups of the pdata
+    unsigned int bit[32];                //!< Bit of each group in the shared membership masks
+    const unsigned int* d_is_member[32]; //!< Membership flags of groups without a bit
+    unsigned int n_groups;               //!< Number of groups
+    };
+
+//! Holder for arguments to gpu_compute_thermo_multi_group
+struct compute_thermo_multi_group_args
+    {
+    Scalar4* d_vel;            //!< Particle velocities and masses
+    unsigned int* d_body;      //!< Particle body ids
+    unsigned int* d_tag;       //!< Particle tags
+    Scalar4* d_net_force;      //!< Net force / pe array to sum
+    Scalar* d_net_virial;      //!< Net virial array to sum
+    size_t virial_pitch;       //!< Pitch of 2D net_virial array
+    Scalar4* d_orientation;    //!< Particle orientations
+    Scalar4* d_angmom;         //!< Particle conjugate quaternions
+    Scalar3* d_inertia;        //!< Particle moments of inertia
+    unsigned int N;            //!< Number of local particles
+    Scalar* d_scratch;         //!< n_groups*num_sums*n_blocks elements of scratch space
+    unsigned int block_size;   //!< Block size to execute on the GPU
+    unsigned int n_blocks;     //!< Number of blocks / n_blocks * block_size >= N
+    Scalar external_virial[6]; //!< Components of the external virial
+    Scalar external_energy;    //!< External potential energy
+    };
+
+//! Computes the sums of all groups for ComputeThermoMultiGroup
+hipError_t gpu_compute_thermo_multi_group(Scalar* d_sums,
+                                          const thermo_group_membership& membership,
+                                          const compute_thermo_multi_group_args& args,
+                                          bool compute_pressure_tensor,
+                                          bool compute_rotational_energy);
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
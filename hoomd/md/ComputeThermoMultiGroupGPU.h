@@ -0,0 +1,54 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ComputeThermoMultiGroup.h"
+
+/*! \file ComputeThermoMultiGroupGPU.h
+    \brief Declares a class for computing thermodynamic quantities of many groups on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __COMPUTE_THERMO_MULTI_GROUP_GPU_H__
+#define __COMPUTE_THERMO_MULTI_GROUP_GPU_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Computes thermodynamic properties of several groups of particles on the GPU
+/*! ComputeThermoMultiGroupGPU is a GPU accelerated implementation of ComputeThermoMultiGroup.
+    One kernel reads the particle data once and writes partial sums of all groups, a second
+    kernel completes the sums. The computation executes on the first GPU.
+    \ingroup computes
+*/
+class PYBIND11_EXPORT ComputeThermoMultiGroupGPU : public ComputeThermoMultiGroup
+    {
+    public:
+    //! Constructs the compute
+    ComputeThermoMultiGroupGPU(std::shared_ptr<SystemDefinition> sysdef,
+                               std::vector<std::shared_ptr<ParticleGroup>> groups);
+    virtual ~ComputeThermoMultiGroupGPU();
+
+    protected:
+    GlobalVector<Scalar> m_scratch; //!< Scratch space for partial sums
+    unsigned int m_block_size;      //!< Block size executed
+
+    //! Computes the local sums of all groups
+    virtual void computeSums();
+    };
+
+namespace detail
+    {
+//! Exports the ComputeThermoMultiGroupGPU class to python
+void export_ComputeThermoMultiGroupGPU(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -35,6 +35,43 @@ struct thermo_index
         };
     };
 
+//! Bit flags selecting the optional quantities that ComputeThermo computes and reduces
+/*! The kinetic energies are always computed.
+ */
+struct thermo_request
+    {
+    //! The enum
+    enum Enum
+        {
+        kinetic = 0,               //!< Only the kinetic energies
+        potential_energy = 1 << 0, //!< The potential energy
+        pressure_tensor = 1 << 1,  //!< The pressure and pressure tensor (when the flags are set)
+        all = potential_energy | pressure_tensor
+        };
+    };
+
+//! Enum for indexing the per group sums of ComputeThermoMultiGroup
+/*! The pressure tensor sums combine the kinetic part and the virial, before dividing by the
+    volume.
+*/
+struct thermo_group_sum
+    {
+    //! The enum
+    enum Enum
+        {
+        pressure_xx = 0,              //!< xx component of the pressure tensor times the volume
+        pressure_xy,                  //!< xy component of the pressure tensor times the volume
+        pressure_xz,                  //!< xz component of the pressure tensor times the volume
+        pressure_yy,                  //!< yy component of the pressure tensor times the volume
+        pressure_yz,                  //!< yz component of the pressure tensor times the volume
+        pressure_zz,                  //!< zz component of the pressure tensor times the volume
+        translational_kinetic_energy, //!< Translational kinetic energy
+        rotational_kinetic_energy,    //!< Rotational kinetic energy
+        potential_energy,             //!< Potential energy
+        num_sums                      // final element to count number of sums
+        };
+    };
+
 //! structure for storing the components of the pressure tensor
 struct PressureTensor
     {
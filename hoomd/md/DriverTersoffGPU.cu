@@ -8,6 +8,7 @@
 #include "DriverTersoffGPU.cuh"
 #include "EvaluatorRevCross.h"
 #include "EvaluatorSquareDensity.h"
+#include "EvaluatorStillingerWeber.h"
 #include "EvaluatorTersoff.h"
 
 namespace hoomd
@@ -34,6 +35,13 @@ hipError_t gpu_compute_revcross_forces(const tersoff_args_t& pair_args,
     return gpu_compute_triplet_forces<EvaluatorRevCross>(pair_args, d_params);
     }
 
+hipError_t
+gpu_compute_stillinger_weber_forces(const tersoff_args_t& pair_args,
+                                    const EvaluatorStillingerWeber::param_type* d_params)
+    {
+    return gpu_compute_triplet_forces<EvaluatorStillingerWeber>(pair_args, d_params);
+    }
+
     } // end namespace kernel
     } // end namespace md
     } // end namespace hoomd
@@ -10,6 +10,7 @@
 
 #include "EvaluatorRevCross.h"
 #include "EvaluatorSquareDensity.h"
+#include "EvaluatorStillingerWeber.h"
 #include "EvaluatorTersoff.h"
 #include "PotentialTersoffGPU.cuh"
 
@@ -31,6 +32,11 @@ hipError_t gpu_compute_sq_density_forces(const tersoff_args_t& pair_args,
 hipError_t gpu_compute_revcross_forces(const tersoff_args_t& pair_args,
                                        const EvaluatorRevCross::param_type* d_params);
 
+//! Compute Stillinger-Weber forces on the GPU with EvaluatorStillingerWeber
+hipError_t
+gpu_compute_stillinger_weber_forces(const tersoff_args_t& pair_args,
+                                    const EvaluatorStillingerWeber::param_type* d_params);
+
     } // end namespace kernel
     } // end namespace md
     } // end namespace hoomd
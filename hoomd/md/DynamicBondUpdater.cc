@@ -0,0 +1,311 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file DynamicBondUpdater.cc
+    \brief Defines the DynamicBondUpdater class
+*/
+
+#include "DynamicBondUpdater.h"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System to update
+    \param nlist Neighbor list that holds the candidate pairs
+    \param group Particles that can form bonds
+    \param bond_type Type of the bonds to form and break
+*/
+DynamicBondUpdater::DynamicBondUpdater(std::shared_ptr<SystemDefinition> sysdef,
+                                       std::shared_ptr<NeighborList> nlist,
+                                       std::shared_ptr<ParticleGroup> group,
+                                       unsigned int bond_type)
+    : Updater(sysdef), m_nlist(nlist), m_group(group), m_bond_type(bond_type),
+      m_r_form(Scalar(0.0)), m_p_form(Scalar(1.0)), m_r_break(Scalar(0.0)),
+      m_p_break(Scalar(0.0)), m_max_bonds(1), m_n_formed(0), m_n_broken(0),
+      m_typpair_idx(m_pdata->getNTypes())
+    {
+    m_exec_conf->msg->notice(5) << "Constructing DynamicBondUpdater" << endl;
+
+    m_bond_data = m_sysdef->getBondData();
+    if (m_bond_type >= m_bond_data->getNTypes())
+        {
+        throw invalid_argument("DynamicBond: Invalid bond type");
+        }
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        throw runtime_error("DynamicBond does not support domain decomposition");
+        }
+#endif
+
+    m_r_cut_nlist
+        = std::make_shared<GlobalArray<Scalar>>(m_typpair_idx.getNumElements(), m_exec_conf);
+    m_nlist->addRCutMatrix(m_r_cut_nlist);
+    }
+
+DynamicBondUpdater::~DynamicBondUpdater()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying DynamicBondUpdater" << endl;
+
+    m_nlist->removeRCutMatrix(m_r_cut_nlist);
+    }
+
+/*! \param r_form Distance below which bonds can form
+
+    The neighbor list includes all pairs within \a r_form.
+*/
+void DynamicBondUpdater::setRForm(Scalar r_form)
+    {
+    if (r_form < Scalar(0.0))
+        {
+        throw invalid_argument("DynamicBond: r_form must not be negative");
+        }
+    m_r_form = r_form;
+
+        {
+        ArrayHandle<Scalar> h_r_cut_nlist(*m_r_cut_nlist,
+                                          access_location::host,
+                                          access_mode::overwrite);
+        for (unsigned int i = 0; i < m_typpair_idx.getNumElements(); i++)
+            h_r_cut_nlist.data[i] = m_r_form;
+        }
+
+    m_nlist->notifyRCutMatrixChange();
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void DynamicBondUpdater::update(uint64_t timestep)
+    {
+    Updater::update(timestep);
+    if (m_prof)
+        m_prof->push("DynamicBond");
+
+    findBreakCandidates(timestep);
+
+    if (m_p_form > Scalar(0.0) && m_r_form > Scalar(0.0) && m_max_bonds > 0)
+        {
+        m_nlist->compute(timestep);
+        findFormCandidates(timestep);
+        }
+    else
+        {
+        m_form_candidates.clear();
+        }
+
+    applyChanges(timestep);
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param timestep Current time step of the simulation
+    \post m_break_tags holds the tags of the bonds to break
+*/
+void DynamicBondUpdater::findBreakCandidates(uint64_t timestep)
+    {
+    m_break_tags.clear();
+    if (!(m_p_break > Scalar(0.0)))
+        return;
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_bond_tags(m_bond_data->getTags(),
+                                          access_location::host,
+                                          access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+    const Scalar r_break_sq = m_r_break * m_r_break;
+    const uint16_t seed = m_sysdef->getSeed();
+
+    for (unsigned int i = 0; i < m_bond_data->getN(); i++)
+        {
+        if (m_bond_data->getTypeByIndex(i) != m_bond_type)
+            continue;
+
+        const BondData::members_t bond = m_bond_data->getMembersByIndex(i);
+        unsigned int idx_a = h_rtag.data[bond.tag[0]];
+        unsigned int idx_b = h_rtag.data[bond.tag[1]];
+
+        Scalar3 dx = make_scalar3(h_pos.data[idx_b].x - h_pos.data[idx_a].x,
+                                  h_pos.data[idx_b].y - h_pos.data[idx_a].y,
+                                  h_pos.data[idx_b].z - h_pos.data[idx_a].z);
+        dx = box.minImage(dx);
+        if (dot(dx, dx) <= r_break_sq)
+            continue;
+
+        unsigned int tag_lo = std::min(bond.tag[0], bond.tag[1]);
+        unsigned int tag_hi = std::max(bond.tag[0], bond.tag[1]);
+        RandomGenerator rng(hoomd::Seed(RNGIdentifier::DynamicBondUpdater, timestep, seed),
+                            hoomd::Counter(tag_lo, tag_hi, 1));
+        if (UniformDistribution<Scalar>()(rng) < m_p_break)
+            m_break_tags.push_back(h_bond_tags.data[i]);
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+    \post m_form_candidates holds each selected pair once, with the lower tag first
+*/
+void DynamicBondUpdater::findFormCandidates(uint64_t timestep)
+    {
+    m_form_candidates.clear();
+
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
+                                    access_location::host,
+                                    access_mode::read);
+    ArrayHandle<unsigned int> h_is_member(m_group->getIsMemberArray(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<unsigned int> h_member_idx(m_group->getIndexArray(),
+                                           access_location::host,
+                                           access_mode::read);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+    const Scalar r_form_sq = m_r_form * m_r_form;
+    const uint16_t seed = m_sysdef->getSeed();
+    const bool full = m_nlist->getStorageMode() == NeighborList::full;
+
+    for (unsigned int group_idx = 0; group_idx < m_group->getNumMembers(); group_idx++)
+        {
+        unsigned int i = h_member_idx.data[group_idx];
+        unsigned int tag_i = h_tag.data[i];
+        Scalar3 pos_i = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        size_t head = h_head_list.data[i];
+
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+            {
+            unsigned int j = h_nlist.data[head + k];
+            unsigned int tag_j = h_tag.data[j];
+
+            // a full list holds each pair twice
+            if (!h_is_member.data[j] || (full && tag_j < tag_i))
+                continue;
+
+            Scalar3 dx = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z) - pos_i;
+            dx = box.minImage(dx);
+            if (dot(dx, dx) >= r_form_sq)
+                continue;
+
+            unsigned int tag_lo = std::min(tag_i, tag_j);
+            unsigned int tag_hi = std::max(tag_i, tag_j);
+            RandomGenerator rng(hoomd::Seed(RNGIdentifier::DynamicBondUpdater, timestep, seed),
+                                hoomd::Counter(tag_lo, tag_hi, 0));
+            if (UniformDistribution<Scalar>()(rng) < m_p_form)
+                m_form_candidates.push_back(make_uint2(tag_lo, tag_hi));
+            }
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    The candidate pairs are considered in a random order so that the limit on the number of bonds
+    per particle does not favor low tags.
+*/
+void DynamicBondUpdater::applyChanges(uint64_t timestep)
+    {
+    m_n_broken = (unsigned int)m_break_tags.size();
+    m_bond_data->removeBondedGroups(m_break_tags);
+
+    m_n_formed = 0;
+    if (m_form_candidates.size() == 0)
+        return;
+
+    // count the bonds of the type on each particle and record the bonded pairs
+    std::vector<unsigned int> n_bonds(m_pdata->getMaximumTag() + 1, 0);
+    std::unordered_set<uint64_t> bonded;
+    for (unsigned int i = 0; i < m_bond_data->getN(); i++)
+        {
+        const BondData::members_t bond = m_bond_data->getMembersByIndex(i);
+        unsigned int tag_lo = std::min(bond.tag[0], bond.tag[1]);
+        unsigned int tag_hi = std::max(bond.tag[0], bond.tag[1]);
+        bonded.insert(uint64_t(tag_lo) << 32 | tag_hi);
+
+        if (m_bond_data->getTypeByIndex(i) == m_bond_type)
+            {
+            n_bonds[bond.tag[0]]++;
+            n_bonds[bond.tag[1]]++;
+            }
+        }
+
+    // order the candidates randomly
+    const uint16_t seed = m_sysdef->getSeed();
+    std::vector<std::pair<Scalar, uint2>> order;
+    order.reserve(m_form_candidates.size());
+    for (const uint2& pair : m_form_candidates)
+        {
+        RandomGenerator rng(hoomd::Seed(RNGIdentifier::DynamicBondUpdater, timestep, seed),
+                            hoomd::Counter(pair.x, pair.y, 2));
+        order.push_back(std::make_pair(UniformDistribution<Scalar>()(rng), pair));
+        }
+    std::sort(order.begin(),
+              order.end(),
+              [](const std::pair<Scalar, uint2>& a, const std::pair<Scalar, uint2>& b)
+              {
+                  if (a.first != b.first)
+                      return a.first < b.first;
+                  return a.second.x < b.second.x
+                         || (a.second.x == b.second.x && a.second.y < b.second.y);
+              });
+
+    std::vector<Bond> new_bonds;
+    for (const auto& entry : order)
+        {
+        const uint2& pair = entry.second;
+        uint64_t key = uint64_t(pair.x) << 32 | pair.y;
+        if (n_bonds[pair.x] >= m_max_bonds || n_bonds[pair.y] >= m_max_bonds
+            || bonded.count(key))
+            continue;
+
+        n_bonds[pair.x]++;
+        n_bonds[pair.y]++;
+        bonded.insert(key);
+        new_bonds.push_back(Bond(m_bond_type, pair.x, pair.y));
+        }
+
+    m_bond_data->addBondedGroups(new_bonds);
+    m_n_formed = (unsigned int)new_bonds.size();
+    }
+
+namespace detail
+    {
+void export_DynamicBondUpdater(pybind11::module& m)
+    {
+    pybind11::class_<DynamicBondUpdater, Updater, std::shared_ptr<DynamicBondUpdater>>(
+        m,
+        "DynamicBondUpdater")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<NeighborList>,
+                            std::shared_ptr<ParticleGroup>,
+                            unsigned int>())
+        .def_property("r_form", &DynamicBondUpdater::getRForm, &DynamicBondUpdater::setRForm)
+        .def_property("p_form", &DynamicBondUpdater::getPForm, &DynamicBondUpdater::setPForm)
+        .def_property("r_break", &DynamicBondUpdater::getRBreak, &DynamicBondUpdater::setRBreak)
+        .def_property("p_break", &DynamicBondUpdater::getPBreak, &DynamicBondUpdater::setPBreak)
+        .def_property("max_bonds",
+                      &DynamicBondUpdater::getMaxBonds,
+                      &DynamicBondUpdater::setMaxBonds)
+        .def_property_readonly("num_formed", &DynamicBondUpdater::getNumFormed)
+        .def_property_readonly("num_broken", &DynamicBondUpdater::getNumBroken);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,171 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file DynamicBondUpdater.h
+    \brief Declares an updater that forms and breaks bonds during a simulation
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "NeighborList.h"
+#include "hoomd/BondedGroupData.h"
+#include "hoomd/Index1D.h"
+#include "hoomd/ParticleGroup.h"
+#include "hoomd/Updater.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+#include <vector>
+
+#ifndef __DYNAMIC_BOND_UPDATER_H__
+#define __DYNAMIC_BOND_UPDATER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Forms and breaks bonds of one type by distance and probability criteria
+/*! On each update, DynamicBondUpdater:
+
+     1. Breaks each bond of type \a bond_type that is longer than \a r_break with probability
+        \a p_break.
+     2. Finds the pairs of group members in the neighbor list that are closer than \a r_form and
+        selects each with probability \a p_form.
+     3. Forms bonds between the selected pairs, in a random order, skipping pairs that are already
+        bonded (by a bond of any type) and pairs where either particle already has \a max_bonds
+        bonds of type \a bond_type.
+
+    The random numbers depend only on the seed, the timestep, and the tags of the pair, so the CPU
+    and GPU implementations make the same decisions. The bonds are removed and added in batches
+    with BondedGroupData::removeBondedGroups() and BondedGroupData::addBondedGroups(), so the
+    GPU bond table and the neighbor list exclusions are updated once per update.
+
+    DynamicBondUpdater adds an r_cut matrix of \a r_form to the neighbor list. It does not support
+    domain decomposition.
+
+    \ingroup updaters
+*/
+class PYBIND11_EXPORT DynamicBondUpdater : public Updater
+    {
+    public:
+    //! Constructor
+    DynamicBondUpdater(std::shared_ptr<SystemDefinition> sysdef,
+                       std::shared_ptr<NeighborList> nlist,
+                       std::shared_ptr<ParticleGroup> group,
+                       unsigned int bond_type);
+    virtual ~DynamicBondUpdater();
+
+    //! Break and form bonds
+    virtual void update(uint64_t timestep);
+
+    //! Set the distance below which bonds can form
+    void setRForm(Scalar r_form);
+
+    //! Get the distance below which bonds can form
+    Scalar getRForm()
+        {
+        return m_r_form;
+        }
+
+    //! Set the probability to form a bond between a pair closer than r_form
+    void setPForm(Scalar p_form)
+        {
+        m_p_form = p_form;
+        }
+
+    //! Get the probability to form a bond between a pair closer than r_form
+    Scalar getPForm()
+        {
+        return m_p_form;
+        }
+
+    //! Set the distance above which bonds can break
+    void setRBreak(Scalar r_break)
+        {
+        m_r_break = r_break;
+        }
+
+    //! Get the distance above which bonds can break
+    Scalar getRBreak()
+        {
+        return m_r_break;
+        }
+
+    //! Set the probability to break a bond longer than r_break
+    void setPBreak(Scalar p_break)
+        {
+        m_p_break = p_break;
+        }
+
+    //! Get the probability to break a bond longer than r_break
+    Scalar getPBreak()
+        {
+        return m_p_break;
+        }
+
+    //! Set the maximum number of bonds of the type per particle
+    void setMaxBonds(unsigned int max_bonds)
+        {
+        m_max_bonds = max_bonds;
+        }
+
+    //! Get the maximum number of bonds of the type per particle
+    unsigned int getMaxBonds()
+        {
+        return m_max_bonds;
+        }
+
+    //! Get the number of bonds formed in the last update
+    unsigned int getNumFormed()
+        {
+        return m_n_formed;
+        }
+
+    //! Get the number of bonds broken in the last update
+    unsigned int getNumBroken()
+        {
+        return m_n_broken;
+        }
+
+    protected:
+    std::shared_ptr<NeighborList> m_nlist;  //!< Neighbor list that holds the candidate pairs
+    std::shared_ptr<ParticleGroup> m_group; //!< Particles that can form bonds
+    std::shared_ptr<BondData> m_bond_data;  //!< Bonds to modify
+    unsigned int m_bond_type;               //!< Type of the bonds to form and break
+    Scalar m_r_form;                        //!< Distance below which bonds can form
+    Scalar m_p_form;                        //!< Probability to form a bond
+    Scalar m_r_break;                       //!< Distance above which bonds can break
+    Scalar m_p_break;                       //!< Probability to break a bond
+    unsigned int m_max_bonds;               //!< Maximum bonds of the type per particle
+    unsigned int m_n_formed;                //!< Number of bonds formed in the last update
+    unsigned int m_n_broken;                //!< Number of bonds broken in the last update
+    Index2D m_typpair_idx;                  //!< Indexes the r_cut matrix
+
+    //! r_cut matrix given to the neighbor list
+    std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;
+
+    std::vector<uint2> m_form_candidates;   //!< Tags of the selected pairs, lower tag first
+    std::vector<unsigned int> m_break_tags; //!< Tags of the selected bonds
+
+    //! Select the bonds to break
+    virtual void findBreakCandidates(uint64_t timestep);
+
+    //! Select the pairs to bond
+    virtual void findFormCandidates(uint64_t timestep);
+
+    //! Remove the selected bonds and add the bonds between the selected pairs
+    void applyChanges(uint64_t timestep);
+    };
+
+namespace detail
+    {
+//! Export the DynamicBondUpdater to python
+void export_DynamicBondUpdater(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -0,0 +1,215 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file DynamicBondUpdaterGPU.cc
+    \brief Defines the DynamicBondUpdaterGPU class
+*/
+
+#ifdef ENABLE_HIP
+#include "DynamicBondUpdaterGPU.h"
+#include "DynamicBondUpdaterGPU.cuh"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System to update
+    \param nlist Neighbor list that holds the candidate pairs
+    \param group Particles that can form bonds
+    \param bond_type Type of the bonds to form and break
+*/
+DynamicBondUpdaterGPU::DynamicBondUpdaterGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                             std::shared_ptr<NeighborList> nlist,
+                                             std::shared_ptr<ParticleGroup> group,
+                                             unsigned int bond_type)
+    : DynamicBondUpdater(sysdef, nlist, group, bond_type), m_n_selected(m_exec_conf)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing DynamicBondUpdaterGPU" << endl;
+
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error()
+            << "Creating a DynamicBondUpdaterGPU with no GPU in the execution configuration"
+            << endl;
+        throw std::runtime_error("Error initializing DynamicBondUpdaterGPU");
+        }
+
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner_break.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "dynamic_bond_break", m_exec_conf));
+    m_tuner_form.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "dynamic_bond_form", m_exec_conf));
+
+    GlobalArray<unsigned int> break_buf(1, m_exec_conf);
+    m_break_buf.swap(break_buf);
+    GlobalArray<uint2> form_buf(1, m_exec_conf);
+    m_form_buf.swap(form_buf);
+    }
+
+DynamicBondUpdaterGPU::~DynamicBondUpdaterGPU()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying DynamicBondUpdaterGPU" << endl;
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    The kernel counts all selected bonds, but only writes as many as fit in the buffer. When the
+    buffer overflows, it is resized to the count and the kernel runs again.
+*/
+void DynamicBondUpdaterGPU::findBreakCandidates(uint64_t timestep)
+    {
+    m_break_tags.clear();
+    if (!(m_p_break > Scalar(0.0)))
+        return;
+
+    unsigned int n_selected = 0;
+    bool overflowed = false;
+    do
+        {
+        ArrayHandle<unsigned int> d_break_buf(m_break_buf,
+                                              access_location::device,
+                                              access_mode::overwrite);
+        ArrayHandle<group_storage<2>> d_bonds(m_bond_data->getMembersArray(),
+                                              access_location::device,
+                                              access_mode::read);
+        ArrayHandle<typeval_t> d_bond_typeval(m_bond_data->getTypeValArray(),
+                                              access_location::device,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> d_bond_tags(m_bond_data->getTags(),
+                                              access_location::device,
+                                              access_mode::read);
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(),
+                                         access_location::device,
+                                         access_mode::read);
+
+        m_n_selected.resetFlags(0);
+
+        m_tuner_break->begin();
+        kernel::gpu_find_bond_break_candidates(d_break_buf.data,
+                                               m_n_selected.getDeviceFlags(),
+                                               (unsigned int)m_break_buf.getNumElements(),
+                                               d_bonds.data,
+                                               d_bond_typeval.data,
+                                               d_bond_tags.data,
+                                               m_bond_data->getN(),
+                                               m_bond_type,
+                                               d_pos.data,
+                                               d_rtag.data,
+                                               m_pdata->getBox(),
+                                               m_r_break * m_r_break,
+                                               m_p_break,
+                                               timestep,
+                                               m_sysdef->getSeed(),
+                                               m_tuner_break->getParam());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_break->end();
+
+        n_selected = m_n_selected.readFlags();
+        overflowed = n_selected > m_break_buf.getNumElements();
+        if (overflowed)
+            m_break_buf.resize(n_selected);
+        } while (overflowed);
+
+    ArrayHandle<unsigned int> h_break_buf(m_break_buf, access_location::host, access_mode::read);
+    m_break_tags.assign(h_break_buf.data, h_break_buf.data + n_selected);
+
+    // the selection order depends on the thread scheduling
+    std::sort(m_break_tags.begin(), m_break_tags.end());
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    See findBreakCandidates() for the handling of buffer overflows.
+*/
+void DynamicBondUpdaterGPU::findFormCandidates(uint64_t timestep)
+    {
+    m_form_candidates.clear();
+
+    unsigned int n_selected = 0;
+    bool overflowed = false;
+    do
+        {
+        ArrayHandle<uint2> d_form_buf(m_form_buf, access_location::device, access_mode::overwrite);
+        ArrayHandle<unsigned int> d_member_idx(m_group->getIndexArray(),
+                                               access_location::device,
+                                               access_mode::read);
+        ArrayHandle<unsigned int> d_is_member(m_group->getIsMemberArray(),
+                                              access_location::device,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> d_n_neigh(m_nlist->getNNeighArray(),
+                                            access_location::device,
+                                            access_mode::read);
+        ArrayHandle<unsigned int> d_nlist(m_nlist->getNListArray(),
+                                          access_location::device,
+                                          access_mode::read);
+        ArrayHandle<size_t> d_head_list(m_nlist->getHeadList(),
+                                        access_location::device,
+                                        access_mode::read);
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                        access_location::device,
+                                        access_mode::read);
+
+        m_n_selected.resetFlags(0);
+
+        m_tuner_form->begin();
+        kernel::gpu_find_bond_form_candidates(d_form_buf.data,
+                                              m_n_selected.getDeviceFlags(),
+                                              (unsigned int)m_form_buf.getNumElements(),
+                                              d_member_idx.data,
+                                              m_group->getNumMembers(),
+                                              d_is_member.data,
+                                              d_n_neigh.data,
+                                              d_nlist.data,
+                                              d_head_list.data,
+                                              m_nlist->getStorageMode() == NeighborList::full,
+                                              d_pos.data,
+                                              d_tag.data,
+                                              m_pdata->getBox(),
+                                              m_r_form * m_r_form,
+                                              m_p_form,
+                                              timestep,
+                                              m_sysdef->getSeed(),
+                                              m_tuner_form->getParam());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_form->end();
+
+        n_selected = m_n_selected.readFlags();
+        overflowed = n_selected > m_form_buf.getNumElements();
+        if (overflowed)
+            m_form_buf.resize(n_selected);
+        } while (overflowed);
+
+    ArrayHandle<uint2> h_form_buf(m_form_buf, access_location::host, access_mode::read);
+    m_form_candidates.assign(h_form_buf.data, h_form_buf.data + n_selected);
+    }
+
+namespace detail
+    {
+void export_DynamicBondUpdaterGPU(pybind11::module& m)
+    {
+    pybind11::class_<DynamicBondUpdaterGPU,
+                     DynamicBondUpdater,
+                     std::shared_ptr<DynamicBondUpdaterGPU>>(m, "DynamicBondUpdaterGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<NeighborList>,
+                            std::shared_ptr<ParticleGroup>,
+                            unsigned int>());
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // ENABLE_HIP
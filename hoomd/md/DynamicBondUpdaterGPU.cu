@@ -0,0 +1,274 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "DynamicBondUpdaterGPU.cuh"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+#include <assert.h>
+
+/*! \file DynamicBondUpdaterGPU.cu
+    \brief Defines GPU kernel code for selecting the bonds to form and break. Used by
+   DynamicBondUpdaterGPU.
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+/*! \param d_break_tags Output tags of the selected bonds
+    \param d_n_break Output number of selected bonds (may exceed \a max_break)
+    \param max_break Capacity of \a d_break_tags
+    \param d_bonds Member tags of the local bonds
+    \param d_bond_typeval Types of the local bonds
+    \param d_bond_tags Tags of the local bonds
+    \param n_bonds Number of local bonds
+    \param bond_type Type of the bonds to break
+    \param d_pos Particle positions
+    \param d_rtag Particle reverse tags
+    \param box Simulation box
+    \param r_break_sq Square of the distance above which bonds can break
+    \param p_break Probability to break a bond
+    \param timestep Current time step
+    \param seed Simulation seed
+
+    One thread per bond. See DynamicBondUpdater::findBreakCandidates().
+*/
+__global__ void gpu_find_bond_break_candidates_kernel(unsigned int* d_break_tags,
+                                                      unsigned int* d_n_break,
+                                                      const unsigned int max_break,
+                                                      const group_storage<2>* d_bonds,
+                                                      const typeval_union* d_bond_typeval,
+                                                      const unsigned int* d_bond_tags,
+                                                      const unsigned int n_bonds,
+                                                      const unsigned int bond_type,
+                                                      const Scalar4* d_pos,
+                                                      const unsigned int* d_rtag,
+                                                      const BoxDim box,
+                                                      const Scalar r_break_sq,
+                                                      const Scalar p_break,
+                                                      const uint64_t timestep,
+                                                      const uint16_t seed)
+    {
+    unsigned int bond_idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (bond_idx >= n_bonds || d_bond_typeval[bond_idx].type != bond_type)
+        return;
+
+    group_storage<2> bond = d_bonds[bond_idx];
+    Scalar4 postype_a = d_pos[d_rtag[bond.tag[0]]];
+    Scalar4 postype_b = d_pos[d_rtag[bond.tag[1]]];
+    Scalar3 dx = make_scalar3(postype_b.x - postype_a.x,
+                              postype_b.y - postype_a.y,
+                              postype_b.z - postype_a.z);
+    dx = box.minImage(dx);
+    if (dot(dx, dx) <= r_break_sq)
+        return;
+
+    unsigned int tag_lo = min(bond.tag[0], bond.tag[1]);
+    unsigned int tag_hi = max(bond.tag[0], bond.tag[1]);
+    RandomGenerator rng(hoomd::Seed(RNGIdentifier::DynamicBondUpdater, timestep, seed),
+                        hoomd::Counter(tag_lo, tag_hi, 1));
+    if (!(UniformDistribution<Scalar>()(rng) < p_break))
+        return;
+
+    unsigned int slot = atomicAdd(d_n_break, 1);
+    if (slot < max_break)
+        d_break_tags[slot] = d_bond_tags[bond_idx];
+    }
+
+/*! \param d_form_pairs Output tags of the selected pairs, lower tag first
+    \param d_n_form Output number of selected pairs (may exceed \a max_form)
+    \param max_form Capacity of \a d_form_pairs
+    \param d_member_idx Particle indices of the group members
+    \param group_size Number of group members
+    \param d_is_member Group membership flag of each particle index
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_nlist Neighbor list
+    \param d_head_list Start of the neighbors of each particle
+    \param full_list True when the neighbor list holds each pair twice
+    \param d_pos Particle positions
+    \param d_tag Particle tags
+    \param box Simulation box
+    \param r_form_sq Square of the distance below which bonds can form
+    \param p_form Probability to form a bond
+    \param timestep Current time step
+    \param seed Simulation seed
+
+    One thread per group member. See DynamicBondUpdater::findFormCandidates().
+*/
+__global__ void gpu_find_bond_form_candidates_kernel(uint2* d_form_pairs,
+                                                     unsigned int* d_n_form,
+                                                     const unsigned int max_form,
+                                                     const unsigned int* d_member_idx,
+                                                     const unsigned int group_size,
+                                                     const unsigned int* d_is_member,
+                                                     const unsigned int* d_n_neigh,
+                                                     const unsigned int* d_nlist,
+                                                     const size_t* d_head_list,
+                                                     const bool full_list,
+                                                     const Scalar4* d_pos,
+                                                     const unsigned int* d_tag,
+                                                     const BoxDim box,
+                                                     const Scalar r_form_sq,
+                                                     const Scalar p_form,
+                                                     const uint64_t timestep,
+                                                     const uint16_t seed)
+    {
+    unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (group_idx >= group_size)
+        return;
+
+    unsigned int i = d_member_idx[group_idx];
+    unsigned int tag_i = d_tag[i];
+    Scalar4 postype_i = d_pos[i];
+    Scalar3 pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
+    size_t head = d_head_list[i];
+    unsigned int n_neigh = d_n_neigh[i];
+
+    for (unsigned int k = 0; k < n_neigh; k++)
+        {
+        unsigned int j = d_nlist[head + k];
+        unsigned int tag_j = d_tag[j];
+
+        // a full list holds each pair twice
+        if (!d_is_member[j] || (full_list && tag_j < tag_i))
+            continue;
+
+        Scalar4 postype_j = d_pos[j];
+        Scalar3 dx = make_scalar3(postype_j.x, postype_j.y, postype_j.z) - pos_i;
+        dx = box.minImage(dx);
+        if (dot(dx, dx) >= r_form_sq)
+            continue;
+
+        unsigned int tag_lo = min(tag_i, tag_j);
+        unsigned int tag_hi = max(tag_i, tag_j);
+        RandomGenerator rng(hoomd::Seed(RNGIdentifier::DynamicBondUpdater, timestep, seed),
+                            hoomd::Counter(tag_lo, tag_hi, 0));
+        if (!(UniformDistribution<Scalar>()(rng) < p_form))
+            continue;
+
+        unsigned int slot = atomicAdd(d_n_form, 1);
+        if (slot < max_form)
+            d_form_pairs[slot] = make_uint2(tag_lo, tag_hi);
+        }
+    }
+
+/*! \note This is just a kernel driver. See gpu_find_bond_break_candidates_kernel for full
+    documentation. The caller must zero \a d_n_break.
+*/
+hipError_t gpu_find_bond_break_candidates(unsigned int* d_break_tags,
+                                          unsigned int* d_n_break,
+                                          const unsigned int max_break,
+                                          const group_storage<2>* d_bonds,
+                                          const typeval_union* d_bond_typeval,
+                                          const unsigned int* d_bond_tags,
+                                          const unsigned int n_bonds,
+                                          const unsigned int bond_type,
+                                          const Scalar4* d_pos,
+                                          const unsigned int* d_rtag,
+                                          const BoxDim& box,
+                                          const Scalar r_break_sq,
+                                          const Scalar p_break,
+                                          const uint64_t timestep,
+                                          const uint16_t seed,
+                                          const unsigned int block_size)
+    {
+    if (n_bonds == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_find_bond_break_candidates_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipLaunchKernelGGL((gpu_find_bond_break_candidates_kernel),
+                       dim3(n_bonds / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_break_tags,
+                       d_n_break,
+                       max_break,
+                       d_bonds,
+                       d_bond_typeval,
+                       d_bond_tags,
+                       n_bonds,
+                       bond_type,
+                       d_pos,
+                       d_rtag,
+                       box,
+                       r_break_sq,
+                       p_break,
+                       timestep,
+                       seed);
+
+    return hipSuccess;
+    }
+
+/*! \note This is just a kernel driver. See gpu_find_bond_form_candidates_kernel for full
+    documentation. The caller must zero \a d_n_form.
+*/
+hipError_t gpu_find_bond_form_candidates(uint2* d_form_pairs,
+                                         unsigned int* d_n_form,
+                                         const unsigned int max_form,
+                                         const unsigned int* d_member_idx,
+                                         const unsigned int group_size,
+                                         const unsigned int* d_is_member,
+                                         const unsigned int* d_n_neigh,
+                                         const unsigned int* d_nlist,
+                                         const size_t* d_head_list,
+                                         const bool full_list,
+                                         const Scalar4* d_pos,
+                                         const unsigned int* d_tag,
+                                         const BoxDim& box,
+                                         const Scalar r_form_sq,
+                                         const Scalar p_form,
+                                         const uint64_t timestep,
+                                         const uint16_t seed,
+                                         const unsigned int block_size)
+    {
+    if (group_size == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_find_bond_form_candidates_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipLaunchKernelGGL((gpu_find_bond_form_candidates_kernel),
+                       dim3(group_size / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_form_pairs,
+                       d_n_form,
+                       max_form,
+                       d_member_idx,
+                       group_size,
+                       d_is_member,
+                       d_n_neigh,
+                       d_nlist,
+                       d_head_list,
+                       full_list,
+                       d_pos,
+                       d_tag,
+                       box,
+                       r_form_sq,
+                       p_form,
+                       timestep,
+                       seed);
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
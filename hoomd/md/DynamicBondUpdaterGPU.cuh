@@ -0,0 +1,63 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/BondedGroupData.cuh"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/ParticleData.cuh"
+
+/*! \file DynamicBondUpdaterGPU.cuh
+    \brief Declares GPU kernel code for selecting the bonds to form and break
+*/
+
+#ifndef __DYNAMIC_BOND_UPDATER_GPU_CUH__
+#define __DYNAMIC_BOND_UPDATER_GPU_CUH__
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Select the bonds of one type that are longer than r_break with probability p_break
+hipError_t gpu_find_bond_break_candidates(unsigned int* d_break_tags,
+                                          unsigned int* d_n_break,
+                                          const unsigned int max_break,
+                                          const group_storage<2>* d_bonds,
+                                          const typeval_union* d_bond_typeval,
+                                          const unsigned int* d_bond_tags,
+                                          const unsigned int n_bonds,
+                                          const unsigned int bond_type,
+                                          const Scalar4* d_pos,
+                                          const unsigned int* d_rtag,
+                                          const BoxDim& box,
+                                          const Scalar r_break_sq,
+                                          const Scalar p_break,
+                                          const uint64_t timestep,
+                                          const uint16_t seed,
+                                          const unsigned int block_size);
+
+//! Select the pairs of group members closer than r_form with probability p_form
+hipError_t gpu_find_bond_form_candidates(uint2* d_form_pairs,
+                                         unsigned int* d_n_form,
+                                         const unsigned int max_form,
+                                         const unsigned int* d_member_idx,
+                                         const unsigned int group_size,
+                                         const unsigned int* d_is_member,
+                                         const unsigned int* d_n_neigh,
+                                         const unsigned int* d_nlist,
+                                         const size_t* d_head_list,
+                                         const bool full_list,
+                                         const Scalar4* d_pos,
+                                         const unsigned int* d_tag,
+                                         const BoxDim& box,
+                                         const Scalar r_form_sq,
+                                         const Scalar p_form,
+                                         const uint64_t timestep,
+                                         const uint16_t seed,
+                                         const unsigned int block_size);
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __DYNAMIC_BOND_UPDATER_GPU_CUH__
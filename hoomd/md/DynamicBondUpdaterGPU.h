@@ -0,0 +1,80 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file DynamicBondUpdaterGPU.h
+    \brief Declares the GPU accelerated version of DynamicBondUpdater
+*/
+
+#ifdef ENABLE_HIP
+#ifndef __HIPCC__
+#include "DynamicBondUpdater.h"
+#include "hoomd/Autotuner.h"
+#include "hoomd/GPUFlags.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+
+#ifndef __DYNAMIC_BOND_UPDATER_GPU_H__
+#define __DYNAMIC_BOND_UPDATER_GPU_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Forms and breaks bonds of one type on the GPU
+/*! The break and form candidates are selected on the GPU, one thread per bond and one thread per
+    group member, and appended to device buffers. The selected candidates are copied to the host,
+    where DynamicBondUpdater::applyChanges() enforces the per particle limit and modifies the bonds.
+
+    \ingroup updaters
+*/
+class PYBIND11_EXPORT DynamicBondUpdaterGPU : public DynamicBondUpdater
+    {
+    public:
+    //! Constructor
+    DynamicBondUpdaterGPU(std::shared_ptr<SystemDefinition> sysdef,
+                          std::shared_ptr<NeighborList> nlist,
+                          std::shared_ptr<ParticleGroup> group,
+                          unsigned int bond_type);
+    virtual ~DynamicBondUpdaterGPU();
+
+    //! Set autotuner parameters
+    /*! \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        DynamicBondUpdater::setAutotunerParams(enable, period);
+        m_tuner_break->setPeriod(period);
+        m_tuner_break->setEnabled(enable);
+        m_tuner_form->setPeriod(period);
+        m_tuner_form->setEnabled(enable);
+        }
+
+    protected:
+    std::unique_ptr<Autotuner> m_tuner_break; //!< Autotuner for the break kernel block size
+    std::unique_ptr<Autotuner> m_tuner_form;  //!< Autotuner for the form kernel block size
+
+    GlobalArray<unsigned int> m_break_buf; //!< Device buffer of the selected bond tags
+    GlobalArray<uint2> m_form_buf;         //!< Device buffer of the selected pairs
+    GPUFlags<unsigned int> m_n_selected;   //!< Number of candidates the kernel selected
+
+    //! Select the bonds to break on the GPU
+    virtual void findBreakCandidates(uint64_t timestep);
+
+    //! Select the pairs to bond on the GPU
+    virtual void findFormCandidates(uint64_t timestep);
+    };
+
+namespace detail
+    {
+//! Export the DynamicBondUpdaterGPU to python
+void export_DynamicBondUpdaterGPU(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __DYNAMIC_BOND_UPDATER_GPU_H__
+#endif // __HIPCC__
+#endif // ENABLE_HIP
@@ -0,0 +1,330 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_EVALUATOR_COMPOSITE_H__
+#define __PAIR_EVALUATOR_COMPOSITE_H__
+
+#ifndef __HIPCC__
+#include <pybind11/pybind11.h>
+#include <string>
+#endif
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file EvaluatorPairComposite.h
+    \brief Defines the pair evaluator class that sums several pair potentials
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define DEVICE __device__
+#define HOSTDEVICE __host__ __device__
+#else
+#define DEVICE
+#define HOSTDEVICE
+#endif
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace detail
+    {
+//! Parameters of the evaluators summed by EvaluatorPairComposite
+/*! The parameters of each evaluator are stored in a nested structure, so the composite parameters
+    are a single trivially copyable type that PotentialPairGPU caches in shared memory.
+
+    In python, the parameters are a dictionary that maps each evaluator's getName() to the
+    dictionary of that evaluator's parameters.
+*/
+template<class... evaluators> struct composite_param_type;
+
+//! Parameters of the last evaluator summed by EvaluatorPairComposite
+template<class evaluator> struct composite_param_type<evaluator>
+    {
+    typename evaluator::param_type first; //!< Parameters of \a evaluator
+
+    DEVICE void load_shared(char*& ptr, unsigned int& available_bytes)
+        {
+        first.load_shared(ptr, available_bytes);
+        }
+
+    HOSTDEVICE void allocate_shared(char*& ptr, unsigned int& available_bytes) const
+        {
+        first.allocate_shared(ptr, available_bytes);
+        }
+
+#ifdef ENABLE_HIP
+    //! Set CUDA memory hints
+    void set_memory_hint() const
+        {
+        first.set_memory_hint();
+        }
+#endif
+
+#ifndef __HIPCC__
+    composite_param_type() { }
+
+    composite_param_type(pybind11::dict v, bool managed = false)
+        : first(v[evaluator::getName().c_str()].template cast<pybind11::dict>(), managed)
+        {
+        }
+
+    //! Add the parameters to the dictionary \a v
+    void addToDict(pybind11::dict& v)
+        {
+        v[evaluator::getName().c_str()] = first.asDict();
+        }
+
+    pybind11::dict asDict()
+        {
+        pybind11::dict v;
+        addToDict(v);
+        return v;
+        }
+#endif
+    };
+
+//! Parameters of two or more evaluators summed by EvaluatorPairComposite
+template<class First, class Second, class... Rest>
+struct composite_param_type<First, Second, Rest...>
+    {
+    composite_param_type<First> first;          //!< Parameters of \a First
+    composite_param_type<Second, Rest...> rest; //!< Parameters of the remaining evaluators
+
+    DEVICE void load_shared(char*& ptr, unsigned int& available_bytes)
+        {
+        first.load_shared(ptr, available_bytes);
+        rest.load_shared(ptr, available_bytes);
+        }
+
+    HOSTDEVICE void allocate_shared(char*& ptr, unsigned int& available_bytes) const
+        {
+        first.allocate_shared(ptr, available_bytes);
+        rest.allocate_shared(ptr, available_bytes);
+        }
+
+#ifdef ENABLE_HIP
+    //! Set CUDA memory hints
+    void set_memory_hint() const
+        {
+        first.set_memory_hint();
+        rest.set_memory_hint();
+        }
+#endif
+
+#ifndef __HIPCC__
+    composite_param_type() { }
+
+    composite_param_type(pybind11::dict v, bool managed = false)
+        : first(v, managed), rest(v, managed)
+        {
+        }
+
+    //! Add the parameters to the dictionary \a v
+    void addToDict(pybind11::dict& v)
+        {
+        first.addToDict(v);
+        rest.addToDict(v);
+        }
+
+    pybind11::dict asDict()
+        {
+        pybind11::dict v;
+        addToDict(v);
+        return v;
+        }
+#endif
+    };
+
+    } // end namespace detail
+
+//! Sum of several pair potentials evaluated in a single neighbor list pass
+/*! EvaluatorPairComposite<E1, E2, ...> evaluates each of the evaluators \a E1, \a E2, ... for the
+    same particle pair and sums their forces and energies. A PotentialPair of the composite
+    computes the combined potential with one traversal of the neighbor list, loading the positions,
+    diameters, and charges of each pair once instead of once per potential.
+
+    All evaluators share the per type pair r_cut, r_on, and energy shift mode of the PotentialPair.
+    The parameters of each evaluator are keyed by its getName(), so each evaluator may appear only
+    once in the list.
+
+    \tparam evaluators Two or more pair evaluator classes
+*/
+template<class... evaluators> class EvaluatorPairComposite;
+
+//! EvaluatorPairComposite of a single evaluator
+/*! Forwards all calls to \a evaluator and terminates the recursion in the general case.
+ */
+template<class evaluator> class EvaluatorPairComposite<evaluator>
+    {
+    public:
+    typedef detail::composite_param_type<evaluator> param_type;
+
+    /*! \param _rsq Squared distance between the particles
+        \param _rcutsq Squared distance at which the potential goes to 0
+        \param _params Per type pair parameters of this potential
+    */
+    DEVICE EvaluatorPairComposite(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
+        : eval(_rsq, _rcutsq, _params.first)
+        {
+        }
+
+    DEVICE static bool needsDiameter()
+        {
+        return evaluator::needsDiameter();
+        }
+
+    /*! \param di Diameter of particle i
+        \param dj Diameter of particle j
+    */
+    DEVICE void setDiameter(Scalar di, Scalar dj)
+        {
+        if (evaluator::needsDiameter())
+            eval.setDiameter(di, dj);
+        }
+
+    DEVICE static bool needsCharge()
+        {
+        return evaluator::needsCharge();
+        }
+
+    /*! \param qi Charge of particle i
+        \param qj Charge of particle j
+    */
+    DEVICE void setCharge(Scalar qi, Scalar qj)
+        {
+        if (evaluator::needsCharge())
+            eval.setCharge(qi, qj);
+        }
+
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift If true, the potential must be shifted so that
+        V(r) is continuous at the cutoff
+        \return True if they are evaluated or false if they are not because
+        we are beyond the cutoff
+    */
+    DEVICE bool evalForceAndEnergy(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        return eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+        }
+
+#ifndef __HIPCC__
+    /*! \returns The potential name.
+     */
+    static std::string getName()
+        {
+        return evaluator::getName();
+        }
+
+    std::string getShapeSpec() const
+        {
+        throw std::runtime_error("Shape definition not supported for this pair potential.");
+        }
+#endif
+
+    protected:
+    evaluator eval; //!< The wrapped evaluator
+    };
+
+//! EvaluatorPairComposite of two or more evaluators
+template<class First, class Second, class... Rest>
+class EvaluatorPairComposite<First, Second, Rest...>
+    {
+    public:
+    typedef detail::composite_param_type<First, Second, Rest...> param_type;
+
+    /*! \param _rsq Squared distance between the particles
+        \param _rcutsq Squared distance at which the potential goes to 0
+        \param _params Per type pair parameters of this potential
+    */
+    DEVICE EvaluatorPairComposite(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
+        : first(_rsq, _rcutsq, _params.first), rest(_rsq, _rcutsq, _params.rest)
+        {
+        }
+
+    DEVICE static bool needsDiameter()
+        {
+        return EvaluatorPairComposite<First>::needsDiameter()
+               || EvaluatorPairComposite<Second, Rest...>::needsDiameter();
+        }
+
+    /*! \param di Diameter of particle i
+        \param dj Diameter of particle j
+    */
+    DEVICE void setDiameter(Scalar di, Scalar dj)
+        {
+        first.setDiameter(di, dj);
+        rest.setDiameter(di, dj);
+        }
+
+    DEVICE static bool needsCharge()
+        {
+        return EvaluatorPairComposite<First>::needsCharge()
+               || EvaluatorPairComposite<Second, Rest...>::needsCharge();
+        }
+
+    /*! \param qi Charge of particle i
+        \param qj Charge of particle j
+    */
+    DEVICE void setCharge(Scalar qi, Scalar qj)
+        {
+        first.setCharge(qi, qj);
+        rest.setCharge(qi, qj);
+        }
+
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift If true, the potential must be shifted so that
+        V(r) is continuous at the cutoff
+        \return True if any of the evaluators is evaluated
+
+        Each evaluator is evaluated independently, an evaluator that returns false contributes no
+        force or energy.
+    */
+    DEVICE bool evalForceAndEnergy(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        Scalar force_divr_first = Scalar(0.0);
+        Scalar pair_eng_first = Scalar(0.0);
+        bool evaluated_first
+            = first.evalForceAndEnergy(force_divr_first, pair_eng_first, energy_shift);
+
+        Scalar force_divr_rest = Scalar(0.0);
+        Scalar pair_eng_rest = Scalar(0.0);
+        bool evaluated_rest = rest.evalForceAndEnergy(force_divr_rest, pair_eng_rest, energy_shift);
+
+        if (!evaluated_first && !evaluated_rest)
+            return false;
+
+        force_divr = force_divr_first + force_divr_rest;
+        pair_eng = pair_eng_first + pair_eng_rest;
+        return true;
+        }
+
+#ifndef __HIPCC__
+    /*! \returns The potential name.
+     */
+    static std::string getName()
+        {
+        return EvaluatorPairComposite<First>::getName() + "_"
+               + EvaluatorPairComposite<Second, Rest...>::getName();
+        }
+
+    std::string getShapeSpec() const
+        {
+        throw std::runtime_error("Shape definition not supported for this pair potential.");
+        }
+#endif
+
+    protected:
+    EvaluatorPairComposite<First> first;          //!< Evaluator of the first potential
+    EvaluatorPairComposite<Second, Rest...> rest; //!< Evaluator of the remaining potentials
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __PAIR_EVALUATOR_COMPOSITE_H__
@@ -263,7 +263,7 @@ class EvaluatorPairDPDLJThermo
                 m_oj = m_j;
                 }
 
-            hoomd::RandomGenerator rng(
+            hoomd::RandomGeneratorR<7> rng(
                 hoomd::Seed(hoomd::RNGIdentifier::EvaluatorPairDPDThermo, m_timestep, m_seed),
                 hoomd::Counter(m_oi, m_oj));
 
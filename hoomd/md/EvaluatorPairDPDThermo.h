@@ -220,6 +220,32 @@ class EvaluatorPairDPDThermo
             return false;
         }
 
+    //! Evaluate the force and energy without branches
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift If true, the potential must be shifted so that V(r) is continuous at
+        the cutoff
+
+        Computes the same quantities as evalForceAndEnergy(), and zero force and energy for pairs
+        that evalForceAndEnergy() skips, so PotentialPair can evaluate batches of neighbors with
+        SIMD instructions, see PairSIMD.h.
+    */
+    DEVICE void evalForceAndEnergyMasked(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        bool active = rsq < rcutsq;
+        Scalar rsq_active = active ? rsq : Scalar(1.0);
+        Scalar rcutsq_active = active ? rcutsq : Scalar(1.0);
+        Scalar rinv = fast::rsqrt(rsq_active);
+        Scalar r = Scalar(1.0) / rinv;
+        Scalar rcutinv = fast::rsqrt(rcutsq_active);
+        Scalar rcut = Scalar(1.0) / rcutinv;
+
+        Scalar f = a * (rinv - rcutinv);
+        Scalar e = a * (rcut - r) - Scalar(1.0 / 2.0) * a * rcutinv * (rcutsq_active - rsq_active);
+        force_divr = active ? f : Scalar(0.0);
+        pair_eng = active ? e : Scalar(0.0);
+        }
+
     //! Evaluate the force and energy using the thermostat
     /*! \param force_divr Output parameter to write the computed force divided by r.
         \param force_divr_cons Output parameter to write the computed conservative force divided by
@@ -260,26 +286,24 @@ class EvaluatorPairDPDThermo
                 m_oj = m_j;
                 }
 
-            hoomd::RandomGenerator rng(
+            // a single value per pair, so the reduced round generator suffices
+            hoomd::RandomGeneratorR<7> rng(
                 hoomd::Seed(hoomd::RNGIdentifier::EvaluatorPairDPDThermo, m_timestep, m_seed),
                 hoomd::Counter(m_oi, m_oj));
 
             // Generate a single random number
             Scalar alpha = hoomd::UniformDistribution<Scalar>(-1, 1)(rng);
 
-            // conservative dpd
-            // force_divr = FDIV(a,r)*(Scalar(1.0) - r*rcutinv);
-            force_divr = a * (rinv - rcutinv);
+            // the conservative, drag, and random terms share the weight w(r) / r
+            Scalar w_divr = rinv - rcutinv;
 
             //  conservative force only
-            force_divr_cons = force_divr;
-
-            //  Drag Term
-            force_divr -= gamma * m_dot * (rinv - rcutinv) * (rinv - rcutinv);
+            force_divr_cons = a * w_divr;
 
-            //  Random Force
-            force_divr
-                += fast::rsqrt(m_deltaT / (m_T * gamma * Scalar(6.0))) * (rinv - rcutinv) * alpha;
+            //  conservative, drag, and random force in one expression
+            force_divr = w_divr
+                         * (a - gamma * m_dot * w_divr
+                            + fast::rsqrt(m_deltaT / (m_T * gamma * Scalar(6.0))) * alpha);
 
             // conservative energy only
             pair_eng = a * (rcut - r) - Scalar(1.0 / 2.0) * a * rcutinv * (rcutsq - rsq);
@@ -100,7 +100,7 @@ class EvaluatorPairDipole
 
         shape_type(vec3<Scalar> mu_) : mu(mu_) { }
 
-        shape_type(pybind11::object mu_obj)
+        shape_type(pybind11::object mu_obj, bool managed)
             {
             auto mu_ = (pybind11::tuple)mu_obj;
             mu = vec3<Scalar>(mu_[0].cast<Scalar>(), mu_[1].cast<Scalar>(), mu_[2].cast<Scalar>());
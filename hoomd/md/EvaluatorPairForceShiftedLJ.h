@@ -137,6 +137,39 @@ class EvaluatorPairForceShiftedLJ
             return false;
         }
 
+    //! Evaluate the force and energy without branches
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift If true, the potential must be shifted so that V(r) is continuous at
+        the cutoff
+
+        Computes the same quantities as evalForceAndEnergy(), and zero force and energy for pairs
+        that evalForceAndEnergy() skips, so PotentialPair can evaluate batches of neighbors with
+        SIMD instructions, see PairSIMD.h.
+    */
+    DEVICE void evalForceAndEnergyMasked(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        bool active = rsq < rcutsq && lj1 != 0;
+        Scalar rsq_active = active ? rsq : Scalar(1.0);
+        Scalar rcutsq_active = active ? rcutsq : Scalar(1.0);
+        Scalar r2inv = Scalar(1.0) / rsq_active;
+        Scalar r6inv = r2inv * r2inv * r2inv;
+        Scalar rcut2inv = Scalar(1.0) / rcutsq_active;
+        Scalar rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+        Scalar shift = energy_shift ? rcut6inv * (lj1 * rcut6inv - lj2) : Scalar(0.0);
+
+        // shift force and add linear term to potential
+        Scalar rcut_r_inv = fast::rsqrt(rsq_active * rcutsq_active);
+        Scalar force_rcut_at_rcut = rcut6inv * (Scalar(12.0) * lj1 * rcut6inv - Scalar(6.0) * lj2);
+
+        Scalar f = r2inv * r6inv * (Scalar(12.0) * lj1 * r6inv - Scalar(6.0) * lj2)
+                   - rcut_r_inv * force_rcut_at_rcut;
+        Scalar e = r6inv * (lj1 * r6inv - lj2) - shift
+                   + (rsq_active * rcut_r_inv - Scalar(1.0)) * force_rcut_at_rcut;
+        force_divr = active ? f : Scalar(0.0);
+        pair_eng = active ? e : Scalar(0.0);
+        }
+
 #ifndef __HIPCC__
     //! Get the name of this potential
     /*! \returns The potential name.
@@ -111,7 +111,7 @@ class EvaluatorPairGB
 
 #ifndef __HIPCC__
 
-        shape_type(pybind11::object shape_params) { }
+        shape_type(pybind11::object shape_params, bool managed) { }
 
         pybind11::object toPython()
             {
@@ -165,6 +165,62 @@ class EvaluatorPairGauss
             return false;
         }
 
+    //! Evaluate the force and energy without branches
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift If true, the potential must be shifted so that V(r) is continuous at
+        the cutoff
+
+        Computes the same quantities as evalForceAndEnergy(), and zero force and energy for pairs
+        that evalForceAndEnergy() skips, so PotentialPair can evaluate batches of neighbors with
+        SIMD instructions, see PairSIMD.h.
+    */
+    DEVICE void evalForceAndEnergyMasked(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        bool active = rsq < rcutsq;
+        Scalar sigma_sq = active ? sigma * sigma : Scalar(1.0);
+        Scalar r_over_sigma_sq = rsq / sigma_sq;
+        Scalar exp_val = fast::exp(-Scalar(1.0) / Scalar(2.0) * r_over_sigma_sq);
+        Scalar shift = energy_shift
+                           ? epsilon * fast::exp(-Scalar(1.0) / Scalar(2.0) * rcutsq / sigma_sq)
+                           : Scalar(0.0);
+
+        Scalar f = epsilon / sigma_sq * exp_val;
+        Scalar e = epsilon * exp_val - shift;
+        force_divr = active ? f : Scalar(0.0);
+        pair_eng = active ? e : Scalar(0.0);
+        }
+
+    //! Evaluate the force and energy in single precision
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift If true, the potential must be shifted so that V(r) is continuous at
+        the cutoff
+
+        Computes the same quantities as evalForceAndEnergy(), see PairMixedPrecision.h.
+    */
+    DEVICE bool evalForceAndEnergyFloat(float& force_divr, float& pair_eng, bool energy_shift)
+        {
+        if (rsq < rcutsq)
+            {
+            float epsilonf = float(epsilon);
+            float sigma_sq = float(sigma) * float(sigma);
+            float r_over_sigma_sq = float(rsq) / sigma_sq;
+            float exp_val = fast::exp(-0.5f * r_over_sigma_sq);
+
+            force_divr = epsilonf / sigma_sq * exp_val;
+            pair_eng = epsilonf * exp_val;
+
+            if (energy_shift)
+                {
+                pair_eng -= epsilonf * fast::exp(-0.5f * float(rcutsq) / sigma_sq);
+                }
+            return true;
+            }
+        else
+            return false;
+        }
+
 #ifndef __HIPCC__
     //! Get the name of this potential
     /*! \returns The potential name.
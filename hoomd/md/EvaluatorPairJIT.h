@@ -0,0 +1,164 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_EVALUATOR_JIT_H__
+#define __PAIR_EVALUATOR_JIT_H__
+
+#ifndef __HIPCC__
+#include <string>
+#endif
+
+#include "PairJITABI.h"
+#include "hoomd/HOOMDMath.h"
+
+/*! \file EvaluatorPairJIT.h
+    \brief Defines the pair evaluator class for run time compiled potentials
+*/
+
+#ifdef __HIPCC__
+#define DEVICE __device__
+#define HOSTDEVICE __host__ __device__
+#else
+#define DEVICE
+#define HOSTDEVICE
+#endif
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Class for evaluating pair potentials compiled at run time
+/*! EvaluatorPairJIT calls a function compiled at run time by PotentialPairJIT, see PairJITABI.h
+    for its signature. The parameters of each type pair hold the function pointer and the types
+    of the pair, so PotentialPair evaluates the compiled function with the same loop, cutoffs,
+    and energy shifting modes as the built-in potentials. The function is host code, so this
+    evaluator is only used on the CPU.
+*/
+class EvaluatorPairJIT
+    {
+    public:
+    struct param_type
+        {
+        PairJITEvalFn eval;  //!< Compiled evaluator function
+        unsigned int type_i; //!< Type of particle i
+        unsigned int type_j; //!< Type of particle j
+
+        DEVICE void load_shared(char*& ptr, unsigned int& available_bytes) { }
+
+        HOSTDEVICE void allocate_shared(char*& ptr, unsigned int& available_bytes) const { }
+
+#ifdef ENABLE_HIP
+        void set_memory_hint() const { }
+#endif
+
+#ifndef __HIPCC__
+        param_type() : eval(nullptr), type_i(0), type_j(0) { }
+
+        param_type(PairJITEvalFn _eval, unsigned int _type_i, unsigned int _type_j)
+            : eval(_eval), type_i(_type_i), type_j(_type_j)
+            {
+            }
+
+        //! The compiled code defines the potential, there are no parameters to set from python
+        param_type(pybind11::dict v, bool managed = false) : param_type() { }
+
+        pybind11::dict asDict()
+            {
+            return pybind11::dict();
+            }
+#endif
+        };
+
+    /*! \param _rsq Squared distance between the particles
+        \param _rcutsq Squared distance at which the potential goes to 0
+        \param _params Per type pair parameters of this potential
+    */
+    DEVICE EvaluatorPairJIT(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
+        : rsq(_rsq), rcutsq(_rcutsq), qi(0), qj(0), params(_params)
+        {
+        }
+
+    //! JIT doesn't use diameter
+    DEVICE static bool needsDiameter()
+        {
+        return false;
+        }
+    //! Accept the optional diameter values
+    /*! \param di Diameter of particle i
+        \param dj Diameter of particle j
+    */
+    DEVICE void setDiameter(Scalar di, Scalar dj) { }
+
+    //! The compiled code may use the charges
+    DEVICE static bool needsCharge()
+        {
+        return true;
+        }
+    //! Accept the optional charge values
+    /*! \param _qi Charge of particle i
+        \param _qj Charge of particle j
+    */
+    DEVICE void setCharge(Scalar _qi, Scalar _qj)
+        {
+        qi = _qi;
+        qj = _qj;
+        }
+
+    //! Evaluate the force and energy
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift If true, the potential must be shifted so that
+        V(r) is continuous at the cutoff
+
+        \return True if they are evaluated or false if they are not because
+        we are beyond the cutoff
+    */
+    bool evalForceAndEnergy(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        if (rsq < rcutsq && params.eval)
+            {
+            pair_eng = params.eval(rsq, params.type_i, params.type_j, qi, qj, force_divr);
+
+            if (energy_shift)
+                {
+                Scalar force_divr_cut;
+                pair_eng -= params.eval(rcutsq,
+                                        params.type_i,
+                                        params.type_j,
+                                        qi,
+                                        qj,
+                                        force_divr_cut);
+                }
+            return true;
+            }
+        else
+            return false;
+        }
+
+#ifndef __HIPCC__
+    //! Get the name of this potential
+    /*! \returns The potential name.
+     */
+    static std::string getName()
+        {
+        return std::string("jit");
+        }
+
+    std::string getShapeSpec() const
+        {
+        throw std::runtime_error("Shape definition not supported for this pair potential.");
+        }
+#endif
+
+    protected:
+    Scalar rsq;        //!< Stored rsq from the constructor
+    Scalar rcutsq;     //!< Stored rcutsq from the constructor
+    Scalar qi;         //!< Charge of particle i
+    Scalar qj;         //!< Charge of particle j
+    param_type params; //!< Compiled function and pair types
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __PAIR_EVALUATOR_JIT_H__
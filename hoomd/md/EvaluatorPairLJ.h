@@ -233,6 +233,64 @@ class EvaluatorPairLJ
             return false;
         }
 
+    //! Evaluate the force and energy without branches
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift If true, the potential must be shifted so that V(r) is continuous at
+        the cutoff
+
+        Computes the same quantities as evalForceAndEnergy(), and zero force and energy for pairs
+        that evalForceAndEnergy() skips, so PotentialPair can evaluate batches of neighbors with
+        SIMD instructions, see PairSIMD.h.
+    */
+    DEVICE void evalForceAndEnergyMasked(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        bool active = rsq < rcutsq && lj1 != 0;
+        Scalar r2inv = Scalar(1.0) / (active ? rsq : Scalar(1.0));
+        Scalar r6inv = r2inv * r2inv * r2inv;
+        Scalar rcut2inv = Scalar(1.0) / (active ? rcutsq : Scalar(1.0));
+        Scalar rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+        Scalar shift = energy_shift ? rcut6inv * (lj1 * rcut6inv - lj2) : Scalar(0.0);
+
+        Scalar f = r2inv * r6inv * (Scalar(12.0) * lj1 * r6inv - Scalar(6.0) * lj2);
+        Scalar e = r6inv * (lj1 * r6inv - lj2) - shift;
+        force_divr = active ? f : Scalar(0.0);
+        pair_eng = active ? e : Scalar(0.0);
+        }
+
+    //! Evaluate the force and energy in single precision
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift If true, the potential must be shifted so that
+        V(r) is continuous at the cutoff
+
+        Computes the same quantities as evalForceAndEnergy(). PotentialPair calls this method when
+        mixed precision is enabled, see PairMixedPrecision.h.
+    */
+    DEVICE bool evalForceAndEnergyFloat(float& force_divr, float& pair_eng, bool energy_shift)
+        {
+        if (rsq < rcutsq && lj1 != 0)
+            {
+            float lj1f = float(lj1);
+            float lj2f = float(lj2);
+            float r2inv = 1.0f / float(rsq);
+            float r6inv = r2inv * r2inv * r2inv;
+            force_divr = r2inv * r6inv * (12.0f * lj1f * r6inv - 6.0f * lj2f);
+
+            pair_eng = r6inv * (lj1f * r6inv - lj2f);
+
+            if (energy_shift)
+                {
+                float rcut2inv = 1.0f / float(rcutsq);
+                float rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+                pair_eng -= rcut6inv * (lj1f * rcut6inv - lj2f);
+                }
+            return true;
+            }
+        else
+            return false;
+        }
+
 #ifndef __HIPCC__
     //! Get the name of this potential
     /*! \returns The potential name.
@@ -0,0 +1,353 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_EVALUATOR_RIGID_SITES_H__
+#define __PAIR_EVALUATOR_RIGID_SITES_H__
+
+#ifndef __HIPCC__
+#include <pybind11/pybind11.h>
+#include <string>
+#endif
+
+#ifdef ENABLE_HIP
+#include <hip/hip_runtime.h>
+#endif
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/ManagedArray.h"
+#include "hoomd/VectorMath.h"
+
+/*! \file EvaluatorPairRigidSites.h
+    \brief Defines the pair evaluator for rigid bodies with interaction sites in the body frame
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Class for evaluating the interaction between the sites of two rigid bodies
+/*! Each particle type carries a list of interaction sites, given in the body frame of the particle.
+    The sites of two bodies interact with a Lennard-Jones potential that is cut off at \a r_cut_site,
+    and the site forces are summed into the force and torques on the two bodies.
+
+    The sites are never stored as particles, so they need no memory, communication, or neighbor
+    list entries of their own. The neighbor list is built between the bodies, and its cutoff must be
+    large enough to contain every pair of interacting sites: r_cut >= r_cut_site + the largest site
+    distance from the center of each body.
+
+    To avoid rotating the sites of body j for every site of body i, the site separations are
+    computed in the body frame of j. Each site of i is rotated into that frame once, and the forces
+    and torques are rotated back once per site of i and once per body, respectively.
+*/
+class EvaluatorPairRigidSites
+    {
+    public:
+    //! Parameters of the site-site interaction between two body types
+    struct param_type
+        {
+        Scalar epsilon;    //!< Energy scale of the site interaction
+        Scalar sigma;      //!< Length scale of the site interaction
+        Scalar r_cut_site; //!< Cutoff of the site interaction
+
+#ifdef ENABLE_HIP
+        //! Set CUDA memory hints
+        void set_memory_hint() const
+            {
+            // default implementation does nothing
+            }
+#endif
+
+        //! Load dynamic data members into shared memory and increase pointer
+        /*! \param ptr Pointer to load data to (will be incremented)
+            \param available_bytes Size of remaining shared memory
+            allocation
+        */
+        HOSTDEVICE void load_shared(char*& ptr, unsigned int& available_bytes) const { }
+
+        HOSTDEVICE param_type() : epsilon(0), sigma(0), r_cut_site(0) { }
+
+#ifndef __HIPCC__
+
+        param_type(pybind11::dict v)
+            {
+            epsilon = v["epsilon"].cast<Scalar>();
+            sigma = v["sigma"].cast<Scalar>();
+            r_cut_site = v["r_cut_site"].cast<Scalar>();
+            }
+
+        pybind11::object toPython()
+            {
+            pybind11::dict v;
+            v["epsilon"] = epsilon;
+            v["sigma"] = sigma;
+            v["r_cut_site"] = r_cut_site;
+            return std::move(v);
+            }
+
+#endif
+        }
+#ifdef SINGLE_PRECISION
+        __attribute__((aligned(8)));
+#else
+        __attribute__((aligned(16)));
+#endif
+
+    //! Interaction sites of a body type
+    struct shape_type
+        {
+        ManagedArray<vec3<Scalar>> positions; //!< Site positions in the body frame
+
+        //! Load dynamic data members into shared memory and increase pointer
+        /*! The sites are read from global memory.
+
+            \param ptr Pointer to load data to (will be incremented)
+            \param available_bytes Size of remaining shared memory allocation
+        */
+        HOSTDEVICE void load_shared(char*& ptr, unsigned int& available_bytes) const { }
+
+        HOSTDEVICE shape_type() { }
+
+#ifndef __HIPCC__
+
+        shape_type(pybind11::object shape_params, bool managed)
+            {
+            pybind11::list positions_py = shape_params["positions"];
+            const unsigned int N = (unsigned int)pybind11::len(positions_py);
+            positions = ManagedArray<vec3<Scalar>>(N, managed);
+            for (unsigned int i = 0; i < N; ++i)
+                {
+                pybind11::tuple r = positions_py[i];
+                positions[i]
+                    = vec3<Scalar>(r[0].cast<Scalar>(), r[1].cast<Scalar>(), r[2].cast<Scalar>());
+                }
+            }
+
+        pybind11::object toPython()
+            {
+            pybind11::list positions_py;
+            for (unsigned int i = 0; i < positions.size(); ++i)
+                {
+                positions_py.append(
+                    pybind11::make_tuple(positions[i].x, positions[i].y, positions[i].z));
+                }
+            pybind11::dict v;
+            v["positions"] = positions_py;
+            return std::move(v);
+            }
+#endif // __HIPCC__
+
+#ifdef ENABLE_HIP
+        //! Attach managed memory to CUDA stream
+        void attach_to_stream(hipStream_t stream) const { }
+
+        //! Set CUDA memory hints
+        void set_memory_hint() const
+            {
+            positions.set_memory_hint();
+            }
+#endif
+        };
+
+    //! Constructs the pair potential evaluator
+    /*! \param _dr Displacement vector between the body centers
+        \param _quat_i Quaternion of i^{th} body
+        \param _quat_j Quaternion of j^{th} body
+        \param _rcutsq Squared distance between the body centers beyond which there is no interaction
+        \param _params Per type pair parameters of this potential
+    */
+    HOSTDEVICE EvaluatorPairRigidSites(Scalar3& _dr,
+                                       Scalar4& _quat_i,
+                                       Scalar4& _quat_j,
+                                       Scalar _rcutsq,
+                                       const param_type& _params)
+        : dr(_dr), rcutsq(_rcutsq), quat_i(_quat_i), quat_j(_quat_j), shape_i(nullptr),
+          shape_j(nullptr), epsilon(_params.epsilon), sigma(_params.sigma),
+          r_cut_site(_params.r_cut_site)
+        {
+        }
+
+    //! uses diameter
+    HOSTDEVICE static bool needsDiameter()
+        {
+        return false;
+        }
+
+    //! Whether the pair potential uses shape.
+    HOSTDEVICE static bool needsShape()
+        {
+        return true;
+        }
+
+    //! Whether the pair potential needs particle tags.
+    HOSTDEVICE static bool needsTags()
+        {
+        return false;
+        }
+
+    //! whether pair potential requires charges
+    HOSTDEVICE static bool needsCharge()
+        {
+        return false;
+        }
+
+    //! Accept the optional diameter values
+    /*! \param di Diameter of particle i
+        \param dj Diameter of particle j
+    */
+    HOSTDEVICE void setDiameter(Scalar di, Scalar dj) { }
+
+    //! Accept the optional shape values
+    /*! \param shape_i Shape of particle i
+        \param shape_j Shape of particle j
+    */
+    HOSTDEVICE void setShape(const shape_type* shapei, const shape_type* shapej)
+        {
+        shape_i = shapei;
+        shape_j = shapej;
+        }
+
+    //! Accept the optional tags
+    /*! \param tag_i Tag of particle i
+        \param tag_j Tag of particle j
+    */
+    HOSTDEVICE void setTags(unsigned int tagi, unsigned int tagj) { }
+
+    //! Accept the optional charge values
+    /*! \param qi Charge of particle i
+        \param qj Charge of particle j
+    */
+    HOSTDEVICE void setCharge(Scalar qi, Scalar qj) { }
+
+    //! Evaluate the force and energy
+    /*! \param force Output parameter to write the computed force.
+        \param pair_eng Output parameter to write the computed pair energy.
+        \param energy_shift If true, the site potential is shifted so that it is continuous at
+            r_cut_site.
+        \param torque_i The torque exerted on the i^th particle.
+        \param torque_j The torque exerted on the j^th particle.
+        \return True if they are evaluated or false if they are not because
+            we are beyond the cutoff.
+    */
+    HOSTDEVICE bool evaluate(Scalar3& force,
+                             Scalar& pair_eng,
+                             bool energy_shift,
+                             Scalar3& torque_i,
+                             Scalar3& torque_j)
+        {
+        vec3<Scalar> rvec(dr);
+        if (dot(rvec, rvec) > rcutsq || epsilon == Scalar(0.0))
+            return false;
+
+        const Scalar sigma2 = sigma * sigma;
+        const Scalar sigma6 = sigma2 * sigma2 * sigma2;
+        const Scalar lj1 = Scalar(4.0) * epsilon * sigma6 * sigma6;
+        const Scalar lj2 = Scalar(4.0) * epsilon * sigma6;
+        const Scalar rcutsq_site = r_cut_site * r_cut_site;
+
+        Scalar shift = Scalar(0.0);
+        if (energy_shift)
+            {
+            const Scalar rcut2inv = Scalar(1.0) / rcutsq_site;
+            const Scalar rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+            shift = rcut6inv * (lj1 * rcut6inv - lj2);
+            }
+
+        const quat<Scalar> q_i(quat_i);
+        const quat<Scalar> q_j(quat_j);
+        const quat<Scalar> q_j_conj = conj(q_j);
+
+        // separation of the body centers in the frame of j
+        const vec3<Scalar> dr_j = rotate(q_j_conj, rvec);
+        // orientation of i relative to j
+        const quat<Scalar> q_ij = q_j_conj * q_i;
+
+        vec3<Scalar> f;
+        vec3<Scalar> t_i;
+        vec3<Scalar> t_j_body;
+        Scalar e = Scalar(0.0);
+        bool evaluated = false;
+
+        const unsigned int n_i = shape_i->positions.size();
+        const unsigned int n_j = shape_j->positions.size();
+        for (unsigned int a = 0; a < n_i; ++a)
+            {
+            // site of i relative to the center of j, in the frame of j
+            const vec3<Scalar> r_a = rotate(q_ij, shape_i->positions[a]);
+            const vec3<Scalar> c_a = dr_j + r_a;
+
+            vec3<Scalar> f_a;
+            for (unsigned int b = 0; b < n_j; ++b)
+                {
+                const vec3<Scalar> s_b = shape_j->positions[b];
+                const vec3<Scalar> d = c_a - s_b;
+                const Scalar rsq = dot(d, d);
+                if (rsq >= rcutsq_site)
+                    continue;
+
+                const Scalar r2inv = Scalar(1.0) / rsq;
+                const Scalar r6inv = r2inv * r2inv * r2inv;
+                const Scalar force_divr
+                    = r2inv * r6inv * (Scalar(12.0) * lj1 * r6inv - Scalar(6.0) * lj2);
+                const vec3<Scalar> f_ab = force_divr * d;
+
+                f_a += f_ab;
+                t_j_body -= cross(s_b, f_ab);
+                e += r6inv * (lj1 * r6inv - lj2) - shift;
+                evaluated = true;
+                }
+
+            // torque = r x f, with the lever arm of the site about the center of i
+            f += f_a;
+            t_i += cross(r_a, f_a);
+            }
+
+        if (!evaluated)
+            return false;
+
+        // rotate back into the space frame
+        force = vec_to_scalar3(rotate(q_j, f));
+        torque_i = vec_to_scalar3(rotate(q_j, t_i));
+        torque_j = vec_to_scalar3(rotate(q_j, t_j_body));
+        pair_eng = e;
+        return true;
+        }
+
+#ifndef __HIPCC__
+    //! Get the name of the potential
+    /*! \returns The potential name.
+     */
+    static std::string getName()
+        {
+        return "rigid_sites";
+        }
+
+    std::string getShapeSpec() const
+        {
+        throw std::runtime_error("Shape definition not supported for this pair potential.");
+        }
+#endif
+
+    protected:
+    Scalar3 dr;                //!< Stored vector pointing between body centers
+    Scalar rcutsq;             //!< Stored rcutsq from the constructor
+    Scalar4 quat_i, quat_j;    //!< Stored quaternion of ith and jth body from constructor
+    const shape_type* shape_i; //!< Sites of the ith body
+    const shape_type* shape_j; //!< Sites of the jth body
+    Scalar epsilon;            //!< Energy scale of the site interaction
+    Scalar sigma;              //!< Length scale of the site interaction
+    Scalar r_cut_site;         //!< Cutoff of the site interaction
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __PAIR_EVALUATOR_RIGID_SITES_H__
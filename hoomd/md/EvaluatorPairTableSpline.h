@@ -0,0 +1,152 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "EvaluatorPairTable.h"
+
+#ifndef __TABLE_SPLINE_POTENTIAL_H__
+#define __TABLE_SPLINE_POTENTIAL_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Computes the result of a tabulated pair potential with cubic spline interpolation
+/*! The tables have the same layout as EvaluatorPairTable: V(r) and F(r) are given at N_table
+    points r_i = r_min + dr * i, where dr = (rcut - rmin) / N_table. Both \a rmin and N_table are
+    set per type pair. V(r) and F(r) for r < rmin and r >= rcut are 0, and the point after the
+    last table entry (r = rcut) has V = F = 0.
+
+    Between two table points, V(r) is the cubic Hermite spline through the energies V_i with
+    slopes -F_i. The force is the exact derivative of the interpolated energy, and the error in V
+    is O(dr^4) instead of the O(dr^2) of linear interpolation. Tables can be much smaller than for
+    EvaluatorPairTable at the same accuracy, which helps them fit in shared memory on the GPU.
+*/
+class EvaluatorPairTableSpline
+    {
+    public:
+    //! The parameters are the same as those of EvaluatorPairTable
+    typedef EvaluatorPairTable::param_type param_type;
+
+    //! Constructs the pair potential evaluator
+    /*! \param _rsq Squared distance between the particles
+        \param _rcutsq Squared distance at which the potential goes to 0
+        \param _params Per type pair parameters of this potential
+    */
+    DEVICE EvaluatorPairTableSpline(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
+        : rsq(_rsq), rcutsq(_rcutsq), rmin(_params.rmin), V_table(_params.V_table),
+          F_table(_params.F_table)
+        {
+        }
+
+    //! Table doesn't use diameter
+    DEVICE static bool needsDiameter()
+        {
+        return false;
+        }
+
+    //! Accept the optional diameter values
+    /*! \param di Diameter of particle i
+        \param dj Diameter of particle j
+    */
+    DEVICE void setDiameter(Scalar di, Scalar dj) { }
+
+    //! Table doesn't use charge
+    DEVICE static bool needsCharge()
+        {
+        return false;
+        }
+
+    //! Accept the optional charge values
+    /*! \param qi Charge of particle i
+        \param qj Charge of particle j
+    */
+    DEVICE void setCharge(Scalar qi, Scalar qj) { }
+
+    //! Evaluate the force and energy
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy.
+        \param energy_shift Table potentials do not support energy shifting.
+
+        \return True if the force and energy are evaluated or false if r is outside the valid
+        range.
+    */
+    DEVICE bool
+    evalForceAndEnergy(Scalar& force_divr, Scalar& pair_eng, const bool energy_shift) const
+        {
+        unsigned int width = V_table.size();
+
+        const Scalar r = fast::sqrt(rsq);
+        if (rsq >= rcutsq || r < rmin)
+            {
+            return false;
+            }
+        const Scalar rcut = fast::sqrt(rcutsq);
+        const Scalar delta_r = (rcut - rmin) / static_cast<Scalar>(width);
+        const Scalar value_f = (r - rmin) / delta_r;
+
+        // compute index into the table and read in values
+        unsigned int value_i = static_cast<unsigned int>(slow::floor(value_f));
+        if (value_i >= width)
+            value_i = width - 1;
+        const Scalar V0 = V_table[value_i];
+        const Scalar F0 = F_table[value_i];
+        Scalar V1 = 0;
+        Scalar F1 = 0;
+        if (value_i + 1 < width)
+            {
+            V1 = V_table[value_i + 1];
+            F1 = F_table[value_i + 1];
+            }
+
+        // evaluate the Hermite basis functions and their derivatives at t in [0, 1)
+        const Scalar t = value_f - Scalar(value_i);
+        const Scalar t2 = t * t;
+        const Scalar t3 = t2 * t;
+        const Scalar h00 = Scalar(2.0) * t3 - Scalar(3.0) * t2 + Scalar(1.0);
+        const Scalar h10 = t3 - Scalar(2.0) * t2 + t;
+        const Scalar h01 = Scalar(1.0) - h00;
+        const Scalar h11 = t3 - t2;
+        const Scalar dh00 = Scalar(6.0) * (t2 - t);
+        const Scalar dh10 = Scalar(3.0) * t2 - Scalar(4.0) * t + Scalar(1.0);
+        const Scalar dh11 = Scalar(3.0) * t2 - Scalar(2.0) * t;
+
+        // the slopes of V are -F
+        const Scalar V = h00 * V0 + h01 * V1 - delta_r * (h10 * F0 + h11 * F1);
+        const Scalar F = -(dh00 * (V0 - V1)) / delta_r + dh10 * F0 + dh11 * F1;
+
+        // return the force divided by r
+        if (rsq > Scalar(0.0))
+            {
+            force_divr = F / r;
+            }
+        pair_eng = V;
+        return true;
+        }
+
+#ifndef __HIPCC__
+    //! Get the name of this potential
+    /*! \returns The potential name.
+     */
+    static std::string getName()
+        {
+        return std::string("table_spline");
+        }
+
+    std::string getShapeSpec() const
+        {
+        throw std::runtime_error("Shape definition not supported for this pair potential.");
+        }
+#endif
+
+    protected:
+    Scalar rsq;                   //!< distance squared
+    Scalar rcutsq;                //!< the potential cutoff distance squared
+    Scalar rmin;                  //!< the distance of the first index of the table potential
+    ManagedArray<Scalar> V_table; //!< the tabulated energy
+    ManagedArray<Scalar> F_table; //!< the tabulated force specifically - (dV / dr)
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
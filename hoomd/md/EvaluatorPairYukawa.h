@@ -172,6 +172,70 @@ class EvaluatorPairYukawa
             return false;
         }
 
+    //! Evaluate the force and energy without branches
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift If true, the potential must be shifted so that V(r) is continuous at
+        the cutoff
+
+        Computes the same quantities as evalForceAndEnergy(), and zero force and energy for pairs
+        that evalForceAndEnergy() skips, so PotentialPair can evaluate batches of neighbors with
+        SIMD instructions, see PairSIMD.h.
+    */
+    DEVICE void evalForceAndEnergyMasked(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        bool active = rsq < rcutsq && epsilon != 0;
+        Scalar rsq_active = active ? rsq : Scalar(1.0);
+        Scalar rinv = fast::rsqrt(rsq_active);
+        Scalar r = Scalar(1.0) / rinv;
+        Scalar r2inv = Scalar(1.0) / rsq_active;
+        Scalar exp_val = fast::exp(-kappa * r);
+
+        Scalar rcutinv = fast::rsqrt(active ? rcutsq : Scalar(1.0));
+        Scalar rcut = Scalar(1.0) / rcutinv;
+        Scalar shift = energy_shift ? epsilon * fast::exp(-kappa * rcut) * rcutinv : Scalar(0.0);
+
+        Scalar f = epsilon * exp_val * r2inv * (rinv + kappa);
+        Scalar e = epsilon * exp_val * rinv - shift;
+        force_divr = active ? f : Scalar(0.0);
+        pair_eng = active ? e : Scalar(0.0);
+        }
+
+    //! Evaluate the force and energy in single precision
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift If true, the potential must be shifted so that V(r) is continuous at
+        the cutoff
+
+        Computes the same quantities as evalForceAndEnergy(), see PairMixedPrecision.h.
+    */
+    DEVICE bool evalForceAndEnergyFloat(float& force_divr, float& pair_eng, bool energy_shift)
+        {
+        if (rsq < rcutsq && epsilon != 0)
+            {
+            float epsilonf = float(epsilon);
+            float kappaf = float(kappa);
+            float rinv = fast::rsqrt(float(rsq));
+            float r = 1.0f / rinv;
+            float r2inv = rinv * rinv;
+
+            float exp_val = fast::exp(-kappaf * r);
+
+            force_divr = epsilonf * exp_val * r2inv * (rinv + kappaf);
+            pair_eng = epsilonf * exp_val * rinv;
+
+            if (energy_shift)
+                {
+                float rcutinv = fast::rsqrt(float(rcutsq));
+                float rcut = 1.0f / rcutinv;
+                pair_eng -= epsilonf * fast::exp(-kappaf * rcut) * rcutinv;
+                }
+            return true;
+            }
+        else
+            return false;
+        }
+
 #ifndef __HIPCC__
     //! Get the name of this potential
     /*! \returns The potential name.
@@ -0,0 +1,316 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __EVALUATOR_STILLINGER_WEBER__
+#define __EVALUATOR_STILLINGER_WEBER__
+
+#ifndef __HIPCC__
+#include <string>
+#endif
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file EvaluatorStillingerWeber.h
+    \brief Defines the evaluator class for the three-body Stillinger-Weber potential
+*/
+
+#ifdef __HIPCC__
+#define DEVICE __device__
+#define HOSTDEVICE __host__ __device__
+#else
+#define DEVICE
+#define HOSTDEVICE
+#endif
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Class for evaluating the Stillinger-Weber three-body potential
+/*! The potential is
+
+    \f[ V = \sum_{i<j} \phi_2(r_{ij}) + \sum_i \sum_{j<k} \phi_3(r_{ij}, r_{ik}, \theta_{jik}) \f]
+
+    with
+
+    \f[ \phi_2(r) = A \varepsilon \left[ B \left(\frac{\sigma}{r}\right)^p
+        - \left(\frac{\sigma}{r}\right)^q \right] \exp\left(\frac{\sigma}{r - r_{cut}}\right) \f]
+
+    \f[ \phi_3 = \lambda \varepsilon (\cos\theta_{jik} - \cos\theta_0)^2
+        \exp\left(\frac{\gamma \sigma}{r_{ij} - r_{cut}}\right)
+        \exp\left(\frac{\gamma \sigma}{r_{ik} - r_{cut}}\right) \f]
+
+    where \f$ r_{cut} = a \sigma \f$ is the cutoff of the type pair.
+
+    PotentialTersoff visits every triplet once for each ordering of j and k. The sum of the
+    three-body terms of i and j is passed as chi to evalForceij, which assigns half of it to the
+    energy of the ij pair, and evalForceik returns half of the three-body forces. As in
+    EvaluatorTersoff, the three-body term of the triplet uses the parameters of the ij type pair.
+*/
+class EvaluatorStillingerWeber
+    {
+    public:
+    //! Parameter type for this potential
+    struct param_type
+        {
+        Scalar epsilon;    //!< Energy scale
+        Scalar sigma;      //!< Length scale
+        Scalar A;          //!< Magnitude of the pair term
+        Scalar B;          //!< Magnitude of the repulsive part of the pair term
+        Scalar p;          //!< Exponent of the repulsive part of the pair term
+        Scalar q;          //!< Exponent of the attractive part of the pair term
+        Scalar lambda3;    //!< Magnitude of the three-body term
+        Scalar gamma;      //!< Range of the three-body term
+        Scalar cos_theta0; //!< Cosine of the equilibrium bond angle
+
+#ifdef ENABLE_HIP
+        //! Set CUDA memory hints
+        void set_memory_hint() const
+            {
+            // default implementation does nothing
+            }
+#endif
+
+#ifndef __HIPCC__
+        param_type()
+            : epsilon(0), sigma(0), A(0), B(0), p(0), q(0), lambda3(0), gamma(0), cos_theta0(0)
+            {
+            }
+
+        param_type(pybind11::dict v)
+            {
+            epsilon = v["epsilon"].cast<Scalar>();
+            sigma = v["sigma"].cast<Scalar>();
+            A = v["A"].cast<Scalar>();
+            B = v["B"].cast<Scalar>();
+            p = v["p"].cast<Scalar>();
+            q = v["q"].cast<Scalar>();
+            lambda3 = v["lambda3"].cast<Scalar>();
+            gamma = v["gamma"].cast<Scalar>();
+            cos_theta0 = v["cos_theta0"].cast<Scalar>();
+            }
+
+        pybind11::dict asDict()
+            {
+            pybind11::dict v;
+            v["epsilon"] = epsilon;
+            v["sigma"] = sigma;
+            v["A"] = A;
+            v["B"] = B;
+            v["p"] = p;
+            v["q"] = q;
+            v["lambda3"] = lambda3;
+            v["gamma"] = gamma;
+            v["cos_theta0"] = cos_theta0;
+            return v;
+            }
+#endif
+
+        } __attribute__((aligned(16)));
+
+    //! Constructs the evaluator
+    /*! \param _rij_sq Squared distance between particles i and j
+        \param _rcutsq Squared distance at which the potential goes to zero
+        \param _params Per type-pair parameters for this potential
+    */
+    DEVICE EvaluatorStillingerWeber(Scalar _rij_sq, Scalar _rcutsq, const param_type& _params)
+        : rij_sq(_rij_sq), rcutsq(_rcutsq), epsilon(_params.epsilon), sigma(_params.sigma),
+          A(_params.A), B(_params.B), p(_params.p), q(_params.q), lambda3(_params.lambda3),
+          gamma(_params.gamma), cos_theta0(_params.cos_theta0)
+        {
+        }
+
+    //! Set the square distance between particles i and j
+    DEVICE void setRij(Scalar rsq)
+        {
+        rij_sq = rsq;
+        }
+
+    //! Set the square distance between particles i and k
+    DEVICE void setRik(Scalar rsq)
+        {
+        rik_sq = rsq;
+        }
+
+    //! This is a pure pair potential
+    DEVICE static bool hasPerParticleEnergy()
+        {
+        return false;
+        }
+
+    //! We need chi to sum the three-body energy
+    DEVICE static bool needsChi()
+        {
+        return true;
+        }
+
+    //! We have ik-forces
+    DEVICE static bool hasIkForce()
+        {
+        return true;
+        }
+
+    //! The Stillinger-Weber potential needs the bond angle
+    DEVICE static bool needsAngle()
+        {
+        return true;
+        }
+
+    //! Set the bond angle value
+    //! \param _cos_th Cosine of the angle between ij and ik
+    DEVICE void setAngle(Scalar _cos_th)
+        {
+        cos_th = _cos_th;
+        }
+
+    //! Check whether a pair of particles is interactive
+    DEVICE bool areInteractive()
+        {
+        return epsilon != Scalar(0.0);
+        }
+
+    //! Evaluate the pair term
+    /*! \param fR Output parameter to write the pair energy
+        \param fA Output parameter to write the derivative of the pair energy
+        \returns True when the pair is inside the cutoff
+    */
+    DEVICE bool evalRepulsiveAndAttractive(Scalar& fR, Scalar& fA)
+        {
+        if (rij_sq < rcutsq && epsilon != Scalar(0.0))
+            {
+            Scalar rij = fast::sqrt(rij_sq);
+            Scalar rcut = fast::sqrt(rcutsq);
+            Scalar inv_dr = Scalar(1.0) / (rij - rcut);
+
+            Scalar rep = B * fast::pow(sigma / rij, p);
+            Scalar att = fast::pow(sigma / rij, q);
+            Scalar cutoff = fast::exp(sigma * inv_dr);
+
+            fR = A * epsilon * (rep - att) * cutoff;
+            fA = A * epsilon * cutoff
+                 * ((q * att - p * rep) / rij - (rep - att) * sigma * inv_dr * inv_dr);
+            return true;
+            }
+        else
+            return false;
+        }
+
+    //! Evaluate the three-body energy of this triplet and add it to chi
+    DEVICE void evalChi(Scalar& chi)
+        {
+        if (rik_sq < rcutsq && lambda3 != Scalar(0.0))
+            {
+            Scalar rij = fast::sqrt(rij_sq);
+            Scalar rik = fast::sqrt(rik_sq);
+            Scalar rcut = fast::sqrt(rcutsq);
+
+            Scalar ang_diff = cos_th - cos_theta0;
+            chi += lambda3 * epsilon * ang_diff * ang_diff
+                   * fast::exp(gamma * sigma / (rij - rcut) + gamma * sigma / (rik - rcut));
+            }
+        }
+
+    //! We don't have a scalar ij contribution
+    DEVICE void evalPhi(Scalar& chi) { }
+
+    //! Evaluate the force and potential energy due to ij interactions
+    DEVICE void evalForceij(Scalar fR,
+                            Scalar fA,
+                            Scalar chi,
+                            Scalar phi,
+                            Scalar& bij,
+                            Scalar& force_divr,
+                            Scalar& potential_eng)
+        {
+        Scalar rij = fast::sqrt(rij_sq);
+
+        // each pair is visited from both particles
+        force_divr = Scalar(-0.5) * fA / rij;
+
+        // each triplet is visited for both orderings of j and k
+        potential_eng = Scalar(0.5) * (fR + chi);
+        }
+
+    DEVICE void evalSelfEnergy(Scalar& energy, Scalar phi) { }
+
+    //! Evaluate the forces due to ijk interactions
+    DEVICE bool evalForceik(Scalar fR,
+                            Scalar fA,
+                            Scalar chi,
+                            Scalar bij,
+                            Scalar3& force_divr_ij,
+                            Scalar3& force_divr_ik)
+        {
+        if (rik_sq < rcutsq && lambda3 != Scalar(0.0))
+            {
+            Scalar rij = fast::sqrt(rij_sq);
+            Scalar rik = fast::sqrt(rik_sq);
+            Scalar rcut = fast::sqrt(rcutsq);
+            Scalar inv_drij = Scalar(1.0) / (rij - rcut);
+            Scalar inv_drik = Scalar(1.0) / (rik - rcut);
+
+            Scalar ang_diff = cos_th - cos_theta0;
+            Scalar h = Scalar(0.5) * lambda3 * epsilon
+                       * fast::exp(gamma * sigma * inv_drij + gamma * sigma * inv_drik);
+
+            // derivatives of the three-body energy with respect to the separation vectors
+            // dx_ij and dx_ik, written in terms of components along dx_ij and dx_ik
+            Scalar g = Scalar(2.0) * h * ang_diff;
+            Scalar d_cross = g / (rij * rik);
+            Scalar d_ij = -g * cos_th / rij_sq
+                          - h * ang_diff * ang_diff * gamma * sigma * inv_drij * inv_drij / rij;
+            Scalar d_ik = -g * cos_th / rik_sq
+                          - h * ang_diff * ang_diff * gamma * sigma * inv_drik * inv_drik / rik;
+
+            // assign the ij forces
+            force_divr_ij.x = -(d_ij + d_cross);
+            force_divr_ij.y = d_ij;
+            force_divr_ij.z = d_cross;
+            // assign the ik forces
+            force_divr_ik.x = -(d_cross + d_ik);
+            force_divr_ik.y = d_cross;
+            force_divr_ik.z = d_ik;
+
+            return true;
+            }
+        else
+            return false;
+        }
+
+#ifndef __HIPCC__
+    //! Get the name of this potential
+    /*! \returns The potential name.
+     */
+    static std::string getName()
+        {
+        return std::string("stillinger_weber");
+        }
+
+    std::string getShapeSpec() const
+        {
+        throw std::runtime_error("Shape definition not supported for this pair potential.");
+        }
+#endif
+
+    static const bool flag_for_RevCross = false;
+
+    protected:
+    Scalar rij_sq;     //!< Stored rij_sq from the constructor
+    Scalar rik_sq;     //!< Stored rik_sq
+    Scalar rcutsq;     //!< Stored rcutsq from the constructor
+    Scalar cos_th;     //!< Cosine of the angle between rij and rik
+    Scalar epsilon;    //!< Energy scale
+    Scalar sigma;      //!< Length scale
+    Scalar A;          //!< Magnitude of the pair term
+    Scalar B;          //!< Magnitude of the repulsive part of the pair term
+    Scalar p;          //!< Exponent of the repulsive part of the pair term
+    Scalar q;          //!< Exponent of the attractive part of the pair term
+    Scalar lambda3;    //!< Magnitude of the three-body term
+    Scalar gamma;      //!< Range of the three-body term
+    Scalar cos_theta0; //!< Cosine of the equilibrium bond angle
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -21,10 +21,9 @@ namespace md
     \post The method is constructed with the given particle data and a NULL profiler.
 */
 FIREEnergyMinimizer::FIREEnergyMinimizer(std::shared_ptr<SystemDefinition> sysdef, Scalar dt)
-    : IntegratorTwoStep(sysdef, dt), m_nmin(5), m_finc(Scalar(1.1)), m_fdec(Scalar(0.5)),
-      m_alpha_start(Scalar(0.1)), m_falpha(Scalar(0.99)), m_ftol(Scalar(1e-1)),
-      m_wtol(Scalar(1e-1)), m_etol(Scalar(1e-3)), m_energy_total(Scalar(0.0)),
-      m_old_energy(Scalar(0.0)), m_deltaT_max(dt), m_deltaT_set(dt / Scalar(10.0)),
+    : IntegratorTwoStep(sysdef, dt), m_nmin(5), m_fdec(Scalar(0.5)), m_alpha_start(Scalar(0.1)),
+      m_falpha(Scalar(0.99)), m_ftol(Scalar(1e-1)), m_wtol(Scalar(1e-1)), m_etol(Scalar(1e-3)),
+      m_energy_total(Scalar(0.0)), m_old_energy(Scalar(0.0)), m_deltaT_set(dt / Scalar(10.0)),
       m_run_minsteps(10)
     {
     m_exec_conf->msg->notice(5) << "Constructing FIREEnergyMinimizer" << endl;
@@ -485,7 +484,7 @@ void export_FIREEnergyMinimizer(pybind11::module& m)
         .def_property("min_steps_adapt",
                       &FIREEnergyMinimizer::getNmin,
                       &FIREEnergyMinimizer::setNmin)
-        .def_property("finc_dt", &FIREEnergyMinimizer::getFinc, &FIREEnergyMinimizer::setFinc)
+        .def_property("finc_dt", &IntegratorTwoStep::getFinc, &FIREEnergyMinimizer::setFinc)
         .def_property("fdec_dt", &FIREEnergyMinimizer::getFdec, &FIREEnergyMinimizer::setFdec)
         .def_property("alpha_start",
                       &FIREEnergyMinimizer::getAlphaStart,
@@ -42,6 +42,16 @@ class PYBIND11_EXPORT FIREEnergyMinimizer : public IntegratorTwoStep
     //! Perform one minimization iteration
     virtual void update(uint64_t timestep);
 
+    //! Get needed pdata flags
+    /*! FIREEnergyMinimizer needs the potential energy on every step
+     */
+    virtual PDataFlags getRequestedPDataFlags()
+        {
+        PDataFlags flags = IntegratorTwoStep::getRequestedPDataFlags();
+        flags[pdata_flag::potential_energy] = 1;
+        return flags;
+        }
+
     //! Return whether or not the minimization has converged
     bool hasConverged() const
         {
@@ -78,14 +88,11 @@ class PYBIND11_EXPORT FIREEnergyMinimizer : public IntegratorTwoStep
         }
 
     //! Set the fractional increase in the timestep upon a valid search direction
+    /*! The increase and the maximum timestep are shared with the adaptive timestep of
+        IntegratorTwoStep.
+    */
     void setFinc(Scalar finc);
 
-    //! get the fractional increase in the timestep upon a valid search direction
-    Scalar getFinc()
-        {
-        return m_finc;
-        }
-
     //! Set the fractional decrease in the timestep upon system energy increasing
     void setFdec(Scalar fdec);
 
@@ -176,7 +183,6 @@ class PYBIND11_EXPORT FIREEnergyMinimizer : public IntegratorTwoStep
     unsigned int
         m_n_since_negative;       //!< counts the number of consecutive successful search directions
     unsigned int m_n_since_start; //!< counts the number of consecutive search attempts
-    Scalar m_finc;                //!< fractional increase in timestep upon successful search
     Scalar m_fdec;                //!< fractional decrease in timestep upon unsuccessful search
     Scalar m_alpha;               //!< relative coupling strength between alpha
     Scalar m_alpha_start;         //!< starting value of alpha
@@ -187,7 +193,6 @@ class PYBIND11_EXPORT FIREEnergyMinimizer : public IntegratorTwoStep
     Scalar m_energy_total;        //!< Total energy of all integrator groups
     Scalar m_old_energy;          //!< energy from the previous iteration
     bool m_converged;             //!< whether the minimization has converged
-    Scalar m_deltaT_max;          //!< maximum timesteps after rescaling (set by user)
     Scalar m_deltaT_set;          //!< the initial timestep
     unsigned int m_run_minsteps;  //!< A minimum number of search attempts the search will use
     bool m_was_reset;             //!< whether or not the minimizer was reset
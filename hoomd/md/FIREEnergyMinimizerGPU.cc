@@ -29,16 +29,12 @@ FIREEnergyMinimizerGPU::FIREEnergyMinimizerGPU(std::shared_ptr<SystemDefinition>
         throw std::runtime_error("FIREEnergyMinimizerGPU requires a GPU device.");
         }
 
-    // allocate the sum arrays
-    GPUArray<Scalar> sum(1, m_exec_conf);
+    // allocate the sum array
+    GPUArray<Scalar> sum(kernel::fire_sum::num_sums, m_exec_conf);
     m_sum.swap(sum);
-    GPUArray<Scalar> sum3(3, m_exec_conf);
-    m_sum3.swap(sum3);
 
-    // initialize the partial sum arrays
-    m_partial_sum1 = GPUVector<Scalar>(m_exec_conf);
-    m_partial_sum2 = GPUVector<Scalar>(m_exec_conf);
-    m_partial_sum3 = GPUVector<Scalar>(m_exec_conf);
+    // initialize the partial sum array
+    m_partial_sum = GPUVector<Scalar>(m_exec_conf);
 
     reset();
     }
@@ -60,11 +56,9 @@ void FIREEnergyMinimizerGPU::resizePartialSumArrays()
 
     num_blocks = num_blocks / m_block_size + 1;
 
-    if (num_blocks != m_partial_sum1.size())
+    if (num_blocks * kernel::fire_sum::num_sums != m_partial_sum.size())
         {
-        m_partial_sum1.resize(num_blocks);
-        m_partial_sum2.resize(num_blocks);
-        m_partial_sum3.resize(num_blocks);
+        m_partial_sum.resize(num_blocks * kernel::fire_sum::num_sums);
         }
     }
 
@@ -78,253 +72,111 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
 
     IntegratorTwoStep::update(timestep);
 
-    Scalar Pt(0.0); // translational power
-    Scalar Pr(0.0); // rotational power
-    Scalar vnorm(0.0);
-    Scalar fnorm(0.0);
-    Scalar energy(0.0);
-    Scalar tnorm(0.0);
-    Scalar wnorm(0.0);
-
     // update partial sum memory space if needed
     resizePartialSumArrays();
 
-    // compute the total energy on the GPU
-    // CPU version is Scalar energy = computePotentialEnergy(timesteps)/Scalar(group_size);
-
+    // compute the energy, power, and norms of all groups on the GPU and read them back once
     if (m_prof)
-        m_prof->push(m_exec_conf, "FIRE compute total energy");
+        m_prof->push(m_exec_conf, "FIRE sums");
 
     unsigned int total_group_size = 0;
 
+        {
+        ArrayHandle<Scalar> d_sum(m_sum, access_location::device, access_mode::overwrite);
+        hipMemset(d_sum.data, 0, sizeof(Scalar) * kernel::fire_sum::num_sums);
+        }
+
     for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
         {
         std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
 
         unsigned int group_size = current_group->getNumMembers();
-        total_group_size += group_size;
+        total_group_size += current_group->getNumMembersGlobal();
 
         ArrayHandle<unsigned int> d_index_array(current_group->getIndexArray(),
                                                 access_location::device,
                                                 access_mode::read);
+        ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(),
+                                         access_location::device,
+                                         access_mode::read);
+        ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                                   access_location::device,
+                                   access_mode::read);
+        ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
+                                     access_location::device,
+                                     access_mode::read);
+        ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
+                                           access_location::device,
+                                           access_mode::read);
+        ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                       access_location::device,
+                                       access_mode::read);
+        ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(),
+                                      access_location::device,
+                                      access_mode::read);
+        ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(),
+                                          access_location::device,
+                                          access_mode::read);
+        ArrayHandle<Scalar> d_partial_sum(m_partial_sum,
+                                          access_location::device,
+                                          access_mode::overwrite);
+        ArrayHandle<Scalar> d_sum(m_sum, access_location::device, access_mode::readwrite);
+
+        unsigned int num_blocks = group_size / m_block_size + 1;
+        kernel::gpu_fire_compute_sums(d_net_force.data,
+                                      d_vel.data,
+                                      d_accel.data,
+                                      d_orientation.data,
+                                      d_inertia.data,
+                                      d_angmom.data,
+                                      d_net_torque.data,
+                                      d_index_array.data,
+                                      group_size,
+                                      (*method)->getAnisotropic(),
+                                      d_sum.data,
+                                      d_partial_sum.data,
+                                      m_block_size,
+                                      num_blocks);
 
-            {
-            ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(),
-                                             access_location::device,
-                                             access_mode::read);
-            ArrayHandle<Scalar> d_partial_sumE(m_partial_sum1,
-                                               access_location::device,
-                                               access_mode::overwrite);
-            ArrayHandle<Scalar> d_sumE(m_sum, access_location::device, access_mode::overwrite);
-
-            unsigned int num_blocks = group_size / m_block_size + 1;
-            kernel::gpu_fire_compute_sum_pe(d_index_array.data,
-                                            group_size,
-                                            d_net_force.data,
-                                            d_sumE.data,
-                                            d_partial_sumE.data,
-                                            m_block_size,
-                                            num_blocks);
-
-            if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                CHECK_CUDA_ERROR();
-            }
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
 
-        ArrayHandle<Scalar> h_sumE(m_sum, access_location::host, access_mode::read);
-        energy += h_sumE.data[0];
+    Scalar sums[kernel::fire_sum::num_sums];
+        {
+        ArrayHandle<Scalar> h_sum(m_sum, access_location::host, access_mode::read);
+        std::copy(h_sum.data, h_sum.data + kernel::fire_sum::num_sums, sums);
         }
 
 #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
         MPI_Allreduce(MPI_IN_PLACE,
-                      &energy,
-                      1,
+                      sums,
+                      kernel::fire_sum::num_sums,
                       MPI_HOOMD_SCALAR,
                       MPI_SUM,
                       m_exec_conf->getMPICommunicator());
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &total_group_size,
-                      1,
-                      MPI_INT,
-                      MPI_SUM,
-                      m_exec_conf->getMPICommunicator());
         }
 #endif
 
+    Scalar energy = sums[kernel::fire_sum::pe];
+    Scalar Pt = sums[kernel::fire_sum::P];  // translational power
+    Scalar Pr = sums[kernel::fire_sum::Pr]; // rotational power
+    Scalar vnorm = sums[kernel::fire_sum::vsq];
+    Scalar fnorm = sums[kernel::fire_sum::asq];
+    Scalar wnorm = sums[kernel::fire_sum::wsq];
+    Scalar tnorm = sums[kernel::fire_sum::tsq];
+
     m_energy_total = energy;
     energy /= (Scalar)total_group_size;
 
-    if (m_prof)
-        m_prof->pop(m_exec_conf);
-
     if (m_was_reset)
         {
         m_was_reset = false;
         m_old_energy = energy + Scalar(100000) * m_etol;
         }
 
-    // sum P, vnorm, fnorm
-
-    if (m_prof)
-        m_prof->push(m_exec_conf, "FIRE P, vnorm, fnorm");
-
-#ifdef ENABLE_MPI
-    bool aniso = false;
-#endif
-
-    for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
-        {
-        std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
-
-        unsigned int group_size = current_group->getNumMembers();
-        ArrayHandle<unsigned int> d_index_array(current_group->getIndexArray(),
-                                                access_location::device,
-                                                access_mode::read);
-
-            {
-            ArrayHandle<Scalar> d_partial_sum_P(m_partial_sum1,
-                                                access_location::device,
-                                                access_mode::overwrite);
-            ArrayHandle<Scalar> d_partial_sum_vsq(m_partial_sum2,
-                                                  access_location::device,
-                                                  access_mode::overwrite);
-            ArrayHandle<Scalar> d_partial_sum_fsq(m_partial_sum3,
-                                                  access_location::device,
-                                                  access_mode::overwrite);
-            ArrayHandle<Scalar> d_sum(m_sum3, access_location::device, access_mode::overwrite);
-            ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
-                                       access_location::device,
-                                       access_mode::read);
-            ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
-                                         access_location::device,
-                                         access_mode::read);
-
-            unsigned int num_blocks = group_size / m_block_size + 1;
-
-            kernel::gpu_fire_compute_sum_all(m_pdata->getN(),
-                                             d_vel.data,
-                                             d_accel.data,
-                                             d_index_array.data,
-                                             group_size,
-                                             d_sum.data,
-                                             d_partial_sum_P.data,
-                                             d_partial_sum_vsq.data,
-                                             d_partial_sum_fsq.data,
-                                             m_block_size,
-                                             num_blocks);
-
-            if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                CHECK_CUDA_ERROR();
-            }
-
-        ArrayHandle<Scalar> h_sum(m_sum3, access_location::host, access_mode::read);
-        Pt += h_sum.data[0];
-        vnorm += h_sum.data[1];
-        fnorm += h_sum.data[2];
-
-        if ((*method)->getAnisotropic())
-            {
-#ifdef ENABLE_MPI
-            aniso = true;
-#endif
-
-                {
-                ArrayHandle<Scalar> d_partial_sum_Pr(m_partial_sum1,
-                                                     access_location::device,
-                                                     access_mode::overwrite);
-                ArrayHandle<Scalar> d_partial_sum_wnorm(m_partial_sum2,
-                                                        access_location::device,
-                                                        access_mode::overwrite);
-                ArrayHandle<Scalar> d_partial_sum_tsq(m_partial_sum3,
-                                                      access_location::device,
-                                                      access_mode::overwrite);
-                ArrayHandle<Scalar> d_sum(m_sum3, access_location::device, access_mode::overwrite);
-                ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
-                                                   access_location::device,
-                                                   access_mode::read);
-                ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(),
-                                              access_location::device,
-                                              access_mode::read);
-                ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(),
-                                                  access_location::device,
-                                                  access_mode::read);
-                ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(),
-                                               access_location::device,
-                                               access_mode::read);
-
-                unsigned int num_blocks = group_size / m_block_size + 1;
-
-                kernel::gpu_fire_compute_sum_all_angular(m_pdata->getN(),
-                                                         d_orientation.data,
-                                                         d_inertia.data,
-                                                         d_angmom.data,
-                                                         d_net_torque.data,
-                                                         d_index_array.data,
-                                                         group_size,
-                                                         d_sum.data,
-                                                         d_partial_sum_Pr.data,
-                                                         d_partial_sum_wnorm.data,
-                                                         d_partial_sum_tsq.data,
-                                                         m_block_size,
-                                                         num_blocks);
-
-                if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                    CHECK_CUDA_ERROR();
-                }
-            ArrayHandle<Scalar> h_sum(m_sum3, access_location::host, access_mode::read);
-            Pr += h_sum.data[0];
-            wnorm += h_sum.data[1];
-            tnorm += h_sum.data[2];
-            }
-        }
-
-#ifdef ENABLE_MPI
-    if (m_pdata->getDomainDecomposition())
-        {
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &fnorm,
-                      1,
-                      MPI_HOOMD_SCALAR,
-                      MPI_SUM,
-                      m_exec_conf->getMPICommunicator());
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &vnorm,
-                      1,
-                      MPI_HOOMD_SCALAR,
-                      MPI_SUM,
-                      m_exec_conf->getMPICommunicator());
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &Pt,
-                      1,
-                      MPI_HOOMD_SCALAR,
-                      MPI_SUM,
-                      m_exec_conf->getMPICommunicator());
-
-        if (aniso)
-            {
-            MPI_Allreduce(MPI_IN_PLACE,
-                          &tnorm,
-                          1,
-                          MPI_HOOMD_SCALAR,
-                          MPI_SUM,
-                          m_exec_conf->getMPICommunicator());
-            MPI_Allreduce(MPI_IN_PLACE,
-                          &wnorm,
-                          1,
-                          MPI_HOOMD_SCALAR,
-                          MPI_SUM,
-                          m_exec_conf->getMPICommunicator());
-            MPI_Allreduce(MPI_IN_PLACE,
-                          &Pr,
-                          1,
-                          MPI_HOOMD_SCALAR,
-                          MPI_SUM,
-                          m_exec_conf->getMPICommunicator());
-            }
-        }
-#endif
-
     vnorm = sqrt(vnorm);
     fnorm = sqrt(fnorm);
     wnorm = sqrt(wnorm);
@@ -348,7 +200,8 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
         return;
         }
 
-    // update velocities
+    // update velocities: mix them with the forces while the power is positive, otherwise zero them
+    Scalar P = Pt + Pr;
 
     if (m_prof)
         m_prof->push(m_exec_conf, "FIRE update velocities");
@@ -366,6 +219,9 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
     else
         factor_r = 1.0;
 
+    if (P <= Scalar(0.0))
+        m_exec_conf->msg->notice(6) << "FIRE zero velocities" << std::endl;
+
     for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
         {
         std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
@@ -378,43 +234,59 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
         ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
                                    access_location::device,
                                    access_mode::readwrite);
-        ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
-                                     access_location::device,
-                                     access_mode::read);
 
-        kernel::gpu_fire_update_v(d_vel.data,
-                                  d_accel.data,
-                                  d_index_array.data,
-                                  group_size,
-                                  m_alpha,
-                                  factor_t);
+        if (P > Scalar(0.0))
+            {
+            ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
+                                         access_location::device,
+                                         access_mode::read);
+
+            kernel::gpu_fire_update_v(d_vel.data,
+                                      d_accel.data,
+                                      d_index_array.data,
+                                      group_size,
+                                      m_alpha,
+                                      factor_t);
+            }
+        else
+            {
+            kernel::gpu_fire_zero_v(d_vel.data, d_index_array.data, group_size);
+            }
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
 
         if ((*method)->getAnisotropic())
             {
-            ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
-                                               access_location::device,
-                                               access_mode::read);
-            ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(),
-                                              access_location::device,
-                                              access_mode::read);
             ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(),
                                           access_location::device,
                                           access_mode::readwrite);
-            ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(),
-                                           access_location::device,
-                                           access_mode::read);
 
-            kernel::gpu_fire_update_angmom(d_net_torque.data,
-                                           d_orientation.data,
-                                           d_inertia.data,
-                                           d_angmom.data,
-                                           d_index_array.data,
-                                           group_size,
-                                           m_alpha,
-                                           factor_r);
+            if (P > Scalar(0.0))
+                {
+                ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
+                                                   access_location::device,
+                                                   access_mode::read);
+                ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(),
+                                                  access_location::device,
+                                                  access_mode::read);
+                ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                               access_location::device,
+                                               access_mode::read);
+
+                kernel::gpu_fire_update_angmom(d_net_torque.data,
+                                               d_orientation.data,
+                                               d_inertia.data,
+                                               d_angmom.data,
+                                               d_index_array.data,
+                                               group_size,
+                                               m_alpha,
+                                               factor_r);
+                }
+            else
+                {
+                kernel::gpu_fire_zero_angmom(d_angmom.data, d_index_array.data, group_size);
+                }
 
             if (m_exec_conf->isCUDAErrorCheckingEnabled())
                 CHECK_CUDA_ERROR();
@@ -424,8 +296,6 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
     if (m_prof)
         m_prof->pop(m_exec_conf);
 
-    Scalar P = Pt + Pr;
-
     if (P > Scalar(0.0))
         {
         m_n_since_negative++;
@@ -435,45 +305,11 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
             m_alpha *= m_falpha;
             }
         }
-    else if (P <= Scalar(0.0))
+    else
         {
         IntegratorTwoStep::setDeltaT(m_deltaT * m_fdec);
         m_alpha = m_alpha_start;
         m_n_since_negative = 0;
-        if (m_prof)
-            m_prof->push(m_exec_conf, "FIRE zero velocities");
-
-        m_exec_conf->msg->notice(6) << "FIRE zero velocities" << std::endl;
-
-        for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
-            {
-            std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
-            unsigned int group_size = current_group->getNumMembers();
-            ArrayHandle<unsigned int> d_index_array(current_group->getIndexArray(),
-                                                    access_location::device,
-                                                    access_mode::read);
-
-            ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
-                                       access_location::device,
-                                       access_mode::readwrite);
-
-            kernel::gpu_fire_zero_v(d_vel.data, d_index_array.data, group_size);
-            if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                CHECK_CUDA_ERROR();
-
-            if ((*method)->getAnisotropic())
-                {
-                ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(),
-                                              access_location::device,
-                                              access_mode::readwrite);
-                kernel::gpu_fire_zero_angmom(d_angmom.data, d_index_array.data, group_size);
-                if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                    CHECK_CUDA_ERROR();
-                }
-            }
-
-        if (m_prof)
-            m_prof->pop(m_exec_conf);
         }
 
     m_n_since_start++;
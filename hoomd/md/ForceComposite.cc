@@ -10,6 +10,12 @@
 #include <sstream>
 #include <string.h>
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#endif
+
 /*! \file ForceComposite.cc
     \brief Contains code for the ForceComposite class
 */
@@ -749,9 +755,10 @@ void ForceComposite::computeForces(uint64_t timestep)
         compute_virial = true;
         }
 
-    // loop over all molecules, also incomplete ones
-    for (unsigned int ibody = 0; ibody < nmol; ibody++)
-        {
+    // sum the forces onto a single body, returning false if a local body is incomplete
+    // each body only writes to its own central and constituent particles, so bodies are independent
+    auto sum_body = [&](unsigned int ibody) -> bool
+    {
         // get central particle tag from first particle in molecule
         assert(h_molecule_length.data[ibody] > 0);
         unsigned int first_idx = h_molecule_list.data[molecule_indexer(0, ibody)];
@@ -763,7 +770,7 @@ void ForceComposite::computeForces(uint64_t timestep)
         unsigned int central_idx = h_rtag.data[central_tag];
 
         if (central_idx >= n_particles_local)
-            continue;
+            return true;
 
         // the central particle must be present
         assert(central_tag == h_tag.data[first_idx]);
@@ -802,11 +809,7 @@ void ForceComposite::computeForces(uint64_t timestep)
                 // if the central particle is local, the molecule should be complete
                 if (h_molecule_length.data[ibody] != h_body_len.data[type] + 1)
                     {
-                    m_exec_conf->msg->errorAllRanks()
-                        << "constrain.rigid(): Composite particle with body tag " << central_tag
-                        << " incomplete" << std::endl
-                        << std::endl;
-                    throw std::runtime_error("Error computing composite particle forces.\n");
+                    return false;
                     }
 
                 // sum up center of mass force
@@ -865,6 +868,54 @@ void ForceComposite::computeForces(uint64_t timestep)
             h_net_virial.data[4 * net_virial_pitch + idxj] = 0.0;
             h_net_virial.data[5 * net_virial_pitch + idxj] = 0.0;
             }
+        return true;
+    };
+
+    // index of the first incomplete body found
+    unsigned int incomplete = nmol;
+
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                incomplete = tbb::parallel_reduce(
+                    tbb::blocked_range<unsigned int>(0, nmol),
+                    nmol,
+                    [&](const tbb::blocked_range<unsigned int>& r, unsigned int first) -> unsigned int
+                    {
+                        for (unsigned int ibody = r.begin(); ibody != r.end(); ++ibody)
+                            if (!sum_body(ibody))
+                                return std::min(first, ibody);
+                        return first;
+                    },
+                    [](unsigned int a, unsigned int b) -> unsigned int { return std::min(a, b); });
+            }); // end task arena execute()
+        }
+    else
+#endif
+        {
+        // loop over all molecules, also incomplete ones
+        for (unsigned int ibody = 0; ibody < nmol; ibody++)
+            {
+            if (!sum_body(ibody))
+                {
+                incomplete = ibody;
+                break;
+                }
+            }
+        }
+
+    if (incomplete != nmol)
+        {
+        unsigned int central_tag
+            = h_body.data[h_molecule_list.data[molecule_indexer(0, incomplete)]];
+        m_exec_conf->msg->errorAllRanks()
+            << "constrain.rigid(): Composite particle with body tag " << central_tag
+            << " incomplete" << std::endl
+            << std::endl;
+        throw std::runtime_error("Error computing composite particle forces.\n");
         }
     }
 
@@ -919,17 +970,16 @@ void ForceComposite::updateCompositeParticles(uint64_t timestep)
     const BoxDim& box = m_pdata->getBox();
     const BoxDim& global_box = m_pdata->getGlobalBox();
 
-    // we need to update both local and ghost particles
-    unsigned int n_particles_local = m_pdata->getN() + m_pdata->getNGhosts();
-    for (unsigned int particle_index = 0; particle_index < n_particles_local; particle_index++)
-        {
+    // update a single constituent particle from its central particle, which is only read
+    auto update_particle = [&](unsigned int particle_index)
+    {
         unsigned int central_tag = h_body.data[particle_index];
 
         // Do nothing with floppy bodies, since we don't need to update their positions or
         // orientations here.
         if (central_tag >= MIN_FLOPPY)
             {
-            continue;
+            return;
             }
 
         // body tag equals tag for central particle
@@ -940,14 +990,14 @@ void ForceComposite::updateCompositeParticles(uint64_t timestep)
         // orientation (the integrator methods do this).
         if (particle_index == central_idx)
             {
-            continue;
+            return;
             }
 
-        // Continue if central particle is on another rank and current index is a ghost particle
+        // Skip if central particle is on another rank and current index is a ghost particle
         // since there is no updating to do.
         if (central_idx == NOT_LOCAL && particle_index >= m_pdata->getN())
             {
-            continue;
+            return;
             }
 
         if (central_idx == NOT_LOCAL)
@@ -986,7 +1036,7 @@ void ForceComposite::updateCompositeParticles(uint64_t timestep)
                 }
 
             // otherwise we must ignore it
-            continue;
+            return;
             }
 
         int3 img = h_image.data[central_idx];
@@ -1017,6 +1067,36 @@ void ForceComposite::updateCompositeParticles(uint64_t timestep)
                                                       h_postype.data[particle_index].w);
         h_orientation.data[particle_index] = quat_to_scalar4(updated_orientation);
         h_image.data[particle_index] = img + imgi;
+    };
+
+    // we need to update both local and ghost particles
+    unsigned int n_particles_local = m_pdata->getN() + m_pdata->getNGhosts();
+
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                m_exec_conf->parallelFor(
+                    0,
+                    n_particles_local,
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                        for (unsigned int particle_index = r.begin();
+                             particle_index != r.end();
+                             ++particle_index)
+                            update_particle(particle_index);
+                    });
+            }); // end task arena execute()
+        }
+    else
+#endif
+        {
+        for (unsigned int particle_index = 0; particle_index < n_particles_local; particle_index++)
+            {
+            update_particle(particle_index);
+            }
         }
     }
 
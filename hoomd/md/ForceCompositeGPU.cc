@@ -40,8 +40,17 @@ ForceCompositeGPU::ForceCompositeGPU(std::shared_ptr<SystemDefinition> sysdef)
             }
         }
 
+    // the force sum can also use a segmented reduction, signaled by zero bodies per block
+    std::vector<unsigned int> valid_params_force(valid_params);
+    for (unsigned int cur_block_size = dev_prop.warpSize;
+         cur_block_size <= static_cast<unsigned int>(dev_prop.maxThreadsPerBlock);
+         cur_block_size *= 2)
+        {
+        valid_params_force.push_back(cur_block_size);
+        }
+
     m_tuner_force.reset(
-        new Autotuner(valid_params, 5, 100000, "force_composite", this->m_exec_conf));
+        new Autotuner(valid_params_force, 5, 100000, "force_composite", this->m_exec_conf));
     m_tuner_virial.reset(
         new Autotuner(valid_params, 5, 100000, "virial_composite", this->m_exec_conf));
 
@@ -204,31 +213,59 @@ void ForceCompositeGPU::computeForces(uint64_t timestep)
         unsigned int n_bodies_per_block = param / 10000;
 
         // launch GPU kernel
-        kernel::gpu_rigid_force(d_force.data,
-                                d_torque.data,
-                                d_molecule_length.data,
-                                d_molecule_list.data,
-                                d_molecule_idx.data,
-                                d_rigid_center.data,
-                                molecule_indexer,
-                                d_postype.data,
-                                d_orientation.data,
-                                m_body_idx,
-                                d_body_pos.data,
-                                d_body_orientation.data,
-                                d_body_len.data,
-                                d_body.data,
-                                d_tag.data,
-                                d_flag.data,
-                                d_net_force.data,
-                                d_net_torque.data,
-                                nmol,
-                                m_pdata->getN(),
-                                n_bodies_per_block,
-                                block_size,
-                                m_exec_conf->dev_prop,
-                                !compute_virial,
-                                m_gpu_partition);
+        if (n_bodies_per_block == 0)
+            {
+            kernel::gpu_rigid_force_segmented(d_force.data,
+                                              d_torque.data,
+                                              d_molecule_length.data,
+                                              d_molecule_list.data,
+                                              d_molecule_idx.data,
+                                              d_rigid_center.data,
+                                              molecule_indexer,
+                                              d_postype.data,
+                                              d_orientation.data,
+                                              m_body_idx,
+                                              d_body_pos.data,
+                                              d_body_len.data,
+                                              d_body.data,
+                                              d_tag.data,
+                                              d_flag.data,
+                                              d_net_force.data,
+                                              d_net_torque.data,
+                                              m_pdata->getN(),
+                                              block_size,
+                                              !compute_virial,
+                                              m_gpu_partition,
+                                              m_exec_conf->getCachedAllocator());
+            }
+        else
+            {
+            kernel::gpu_rigid_force(d_force.data,
+                                    d_torque.data,
+                                    d_molecule_length.data,
+                                    d_molecule_list.data,
+                                    d_molecule_idx.data,
+                                    d_rigid_center.data,
+                                    molecule_indexer,
+                                    d_postype.data,
+                                    d_orientation.data,
+                                    m_body_idx,
+                                    d_body_pos.data,
+                                    d_body_orientation.data,
+                                    d_body_len.data,
+                                    d_body.data,
+                                    d_tag.data,
+                                    d_flag.data,
+                                    d_net_force.data,
+                                    d_net_torque.data,
+                                    nmol,
+                                    m_pdata->getN(),
+                                    n_bodies_per_block,
+                                    block_size,
+                                    m_exec_conf->dev_prop,
+                                    !compute_virial,
+                                    m_gpu_partition);
+            }
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
@@ -10,6 +10,7 @@
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
+#include <hipcub/hipcub.hpp>
 #include <thrust/copy.h>
 #include <thrust/device_ptr.h>
 #include <thrust/iterator/counting_iterator.h>
@@ -17,6 +18,8 @@
 #include <thrust/transform.h>
 #pragma GCC diagnostic pop
 
+#include <vector>
+
 // Maintainer: jglaser
 
 /*! \file ForceComposite.cu
@@ -442,6 +445,174 @@ __global__ void gpu_rigid_virial_sliding_kernel(Scalar* d_virial,
         }
     }
 
+//! Force and torque of a constituent particle on its body
+struct rigid_force_torque
+    {
+    Scalar4 force;
+    Scalar3 torque;
+    };
+
+//! Sums the force and torque on a body
+struct rigid_force_torque_sum
+    {
+    __device__ __forceinline__ rigid_force_torque operator()(const rigid_force_torque& a,
+                                                             const rigid_force_torque& b) const
+        {
+        rigid_force_torque sum;
+        sum.force = make_scalar4(a.force.x + b.force.x,
+                                 a.force.y + b.force.y,
+                                 a.force.z + b.force.z,
+                                 a.force.w + b.force.w);
+        sum.torque = make_scalar3(a.torque.x + b.torque.x,
+                                  a.torque.y + b.torque.y,
+                                  a.torque.z + b.torque.z);
+        return sum;
+        }
+    };
+
+//! Maps a slot in the molecule list of the bodies to the body it belongs to
+struct rigid_slot_body
+    {
+    rigid_slot_body(unsigned int _width) : width(_width) { }
+
+    __device__ __forceinline__ unsigned int operator()(unsigned int slot) const
+        {
+        return slot / width;
+        }
+
+    unsigned int width; //!< Number of slots per body
+    };
+
+//! Computes the force and torque of the particle in a slot of the molecule list on its body
+/*! The molecule list stores the particles of a body contiguously, so the constituents are already
+    sorted by body. Slot \a k of body \a i is flattened to i * W + k, where W is the width of the
+    molecule list. Empty slots, the central particle, and ghost or incomplete bodies contribute
+    nothing.
+*/
+struct rigid_slot_force_torque
+    {
+    __device__ rigid_force_torque operator()(unsigned int slot) const
+        {
+        rigid_force_torque ft;
+        ft.force = make_scalar4(0, 0, 0, 0);
+        ft.torque = make_scalar3(0, 0, 0);
+
+        const unsigned int group_idx = slot / molecule_indexer.getW();
+        const unsigned int k = slot % molecule_indexer.getW();
+
+        const unsigned int central_idx = d_rigid_center[group_idx];
+        if (central_idx >= N || d_tag[central_idx] != d_body[central_idx])
+            return ft;
+
+        const unsigned int mol_idx = d_molecule_idx[central_idx];
+        const unsigned int mol_len = d_molecule_len[mol_idx];
+        const Scalar4 postype = d_postype[central_idx];
+        const unsigned int type = __scalar_as_int(postype.w);
+        if (k >= mol_len || mol_len != d_body_len[type] + 1)
+            return ft;
+
+        const unsigned int pidx = d_molecule_list[molecule_indexer(k, mol_idx)];
+        if (pidx == central_idx)
+            return ft;
+
+        const Scalar4 fi = d_net_force[pidx];
+        const vec3<Scalar> ti(d_net_torque[pidx]);
+        const vec3<Scalar> particle_pos(d_body_pos[body_indexer(type, k - 1)]);
+        const vec3<Scalar> ri = rotate(quat<Scalar>(d_orientation[central_idx]), particle_pos);
+
+        // torque = r x f
+        const vec3<Scalar> del_torque(cross(ri, vec3<Scalar>(fi)));
+
+        ft.force = fi;
+        ft.torque = make_scalar3(ti.x + del_torque.x, ti.y + del_torque.y, ti.z + del_torque.z);
+        return ft;
+        }
+
+    const unsigned int* d_rigid_center;
+    const unsigned int* d_molecule_len;
+    const unsigned int* d_molecule_list;
+    const unsigned int* d_molecule_idx;
+    Index2D molecule_indexer;
+    const Scalar4* d_postype;
+    const Scalar4* d_orientation;
+    Index2D body_indexer;
+    const Scalar3* d_body_pos;
+    const unsigned int* d_body_len;
+    const unsigned int* d_body;
+    const unsigned int* d_tag;
+    const Scalar4* d_net_force;
+    const Scalar4* d_net_torque;
+    unsigned int N;
+    };
+
+//! Writes the reduced body forces and zeroes the net force and torque of the constituents
+/*! One thread is used per slot of the molecule list, flattened the same way as for the reduction.
+    Constituents are only zeroed after the reduction has consumed their forces.
+*/
+__global__ void gpu_rigid_force_finalize_kernel(Scalar4* d_force,
+                                                Scalar4* d_torque,
+                                                const rigid_force_torque* d_sum,
+                                                const unsigned int* d_molecule_len,
+                                                const unsigned int* d_molecule_list,
+                                                const unsigned int* d_molecule_idx,
+                                                const unsigned int* d_rigid_center,
+                                                Index2D molecule_indexer,
+                                                const Scalar4* d_postype,
+                                                const unsigned int* d_body_len,
+                                                const unsigned int* d_body,
+                                                const unsigned int* d_tag,
+                                                uint2* d_flag,
+                                                Scalar4* d_net_force,
+                                                Scalar4* d_net_torque,
+                                                unsigned int N,
+                                                bool zero_force,
+                                                unsigned int nwork)
+    {
+    const unsigned int slot = blockIdx.x * blockDim.x + threadIdx.x;
+    if (slot >= nwork * molecule_indexer.getW())
+        return;
+
+    const unsigned int group_idx = slot / molecule_indexer.getW();
+    const unsigned int k = slot % molecule_indexer.getW();
+    const unsigned int central_idx = d_rigid_center[group_idx];
+
+    if (k == 0 && central_idx < N)
+        {
+        const rigid_force_torque ft = d_sum[group_idx];
+        d_force[central_idx] = ft.force;
+        d_torque[central_idx] = make_scalar4(ft.torque.x, ft.torque.y, ft.torque.z, 0.0);
+        }
+
+    // this is not the central ptl, molecule is incomplete
+    if (d_tag[central_idx] != d_body[central_idx])
+        return;
+
+    const unsigned int mol_idx = d_molecule_idx[central_idx];
+    const unsigned int mol_len = d_molecule_len[mol_idx];
+    if (k >= mol_len)
+        return;
+
+    const unsigned int pidx = d_molecule_list[molecule_indexer(k, mol_idx)];
+    if (pidx == central_idx)
+        return;
+
+    // zero net torque on constituent particles
+    d_net_torque[pidx] = make_scalar4(0.0, 0.0, 0.0, 0.0);
+
+    // zero force only if we don't need it later
+    if (zero_force)
+        {
+        d_net_force[pidx] = make_scalar4(0.0, 0.0, 0.0, 0.0);
+        }
+
+    // at this point, the molecule needs to be complete
+    if (central_idx < N
+        && mol_len != d_body_len[__scalar_as_int(d_postype[central_idx].w)] + 1)
+        {
+        atomicMax(&(d_flag->x), d_body[central_idx] + 1);
+        }
+    }
+
 /*!
  */
 hipError_t gpu_rigid_force(Scalar4* d_force,
@@ -546,6 +717,141 @@ hipError_t gpu_rigid_force(Scalar4* d_force,
     return hipSuccess;
     }
 
+/*! The constituent forces and torques are summed with a segmented reduction keyed by the body
+    that each slot of the molecule list belongs to, followed by a kernel that writes the body forces
+    and zeroes the constituents.
+ */
+hipError_t gpu_rigid_force_segmented(Scalar4* d_force,
+                                     Scalar4* d_torque,
+                                     const unsigned int* d_molecule_len,
+                                     const unsigned int* d_molecule_list,
+                                     const unsigned int* d_molecule_idx,
+                                     const unsigned int* d_rigid_center,
+                                     Index2D molecule_indexer,
+                                     const Scalar4* d_postype,
+                                     const Scalar4* d_orientation,
+                                     Index2D body_indexer,
+                                     Scalar3* d_body_pos,
+                                     const unsigned int* d_body_len,
+                                     const unsigned int* d_body,
+                                     const unsigned int* d_tag,
+                                     uint2* d_flag,
+                                     Scalar4* d_net_force,
+                                     Scalar4* d_net_torque,
+                                     unsigned int N,
+                                     unsigned int block_size,
+                                     bool zero_force,
+                                     const GPUPartition& gpu_partition,
+                                     CachedAllocator& alloc)
+    {
+    // temporary storage is held until all GPUs have been launched
+    std::vector<char*> temp_alloc;
+
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+        if (nwork == 0)
+            continue;
+
+        const unsigned int num_items = nwork * molecule_indexer.getW();
+
+        rigid_slot_force_torque slot_force_torque;
+        slot_force_torque.d_rigid_center = d_rigid_center + range.first;
+        slot_force_torque.d_molecule_len = d_molecule_len;
+        slot_force_torque.d_molecule_list = d_molecule_list;
+        slot_force_torque.d_molecule_idx = d_molecule_idx;
+        slot_force_torque.molecule_indexer = molecule_indexer;
+        slot_force_torque.d_postype = d_postype;
+        slot_force_torque.d_orientation = d_orientation;
+        slot_force_torque.body_indexer = body_indexer;
+        slot_force_torque.d_body_pos = d_body_pos;
+        slot_force_torque.d_body_len = d_body_len;
+        slot_force_torque.d_body = d_body;
+        slot_force_torque.d_tag = d_tag;
+        slot_force_torque.d_net_force = d_net_force;
+        slot_force_torque.d_net_torque = d_net_torque;
+        slot_force_torque.N = N;
+
+        hipcub::CountingInputIterator<unsigned int> slots(0);
+        hipcub::TransformInputIterator<unsigned int,
+                                       rigid_slot_body,
+                                       hipcub::CountingInputIterator<unsigned int>>
+            keys(slots, rigid_slot_body(molecule_indexer.getW()));
+        hipcub::TransformInputIterator<rigid_force_torque,
+                                       rigid_slot_force_torque,
+                                       hipcub::CountingInputIterator<unsigned int>>
+            values(slots, slot_force_torque);
+
+        rigid_force_torque* d_sum = alloc.getTemporaryBuffer<rigid_force_torque>(nwork);
+        unsigned int* d_unique_body = alloc.getTemporaryBuffer<unsigned int>(nwork);
+        unsigned int* d_num_bodies = alloc.getTemporaryBuffer<unsigned int>(1);
+        temp_alloc.push_back((char*)d_sum);
+        temp_alloc.push_back((char*)d_unique_body);
+        temp_alloc.push_back((char*)d_num_bodies);
+
+        void* d_temp_storage = NULL;
+        size_t temp_storage_bytes = 0;
+        hipcub::DeviceReduce::ReduceByKey(d_temp_storage,
+                                          temp_storage_bytes,
+                                          keys,
+                                          d_unique_body,
+                                          values,
+                                          d_sum,
+                                          d_num_bodies,
+                                          rigid_force_torque_sum(),
+                                          num_items);
+        d_temp_storage = alloc.allocate(temp_storage_bytes);
+        temp_alloc.push_back((char*)d_temp_storage);
+        hipcub::DeviceReduce::ReduceByKey(d_temp_storage,
+                                          temp_storage_bytes,
+                                          keys,
+                                          d_unique_body,
+                                          values,
+                                          d_sum,
+                                          d_num_bodies,
+                                          rigid_force_torque_sum(),
+                                          num_items);
+
+        unsigned int max_block_size;
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, (const void*)gpu_rigid_force_finalize_kernel);
+        max_block_size = attr.maxThreadsPerBlock;
+
+        unsigned int run_block_size = max_block_size < block_size ? max_block_size : block_size;
+
+        hipLaunchKernelGGL((gpu_rigid_force_finalize_kernel),
+                           dim3(num_items / run_block_size + 1),
+                           dim3(run_block_size),
+                           0,
+                           0,
+                           d_force,
+                           d_torque,
+                           d_sum,
+                           d_molecule_len,
+                           d_molecule_list,
+                           d_molecule_idx,
+                           d_rigid_center + range.first,
+                           molecule_indexer,
+                           d_postype,
+                           d_body_len,
+                           d_body,
+                           d_tag,
+                           d_flag,
+                           d_net_force,
+                           d_net_torque,
+                           N,
+                           zero_force,
+                           nwork);
+        }
+
+    for (auto ptr : temp_alloc)
+        alloc.deallocate(ptr);
+
+    return hipSuccess;
+    }
+
 hipError_t gpu_rigid_virial(Scalar* d_virial,
                             const unsigned int* d_molecule_len,
                             const unsigned int* d_molecule_list,
@@ -1,6 +1,7 @@
 // Copyright (c) 2009-2021 The Regents of the University of Michigan
 // This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
 
+#include "hoomd/CachedAllocator.h"
 #include "hoomd/GPUPartition.cuh"
 #include "hoomd/HOOMDMath.h"
 
@@ -42,6 +43,29 @@ hipError_t gpu_rigid_force(Scalar4* d_force,
                            bool zero_force,
                            const GPUPartition& gpu_partition);
 
+hipError_t gpu_rigid_force_segmented(Scalar4* d_force,
+                                     Scalar4* d_torque,
+                                     const unsigned int* d_molecule_len,
+                                     const unsigned int* d_molecule_list,
+                                     const unsigned int* d_molecule_idx,
+                                     const unsigned int* d_rigid_center,
+                                     Index2D molecule_indexer,
+                                     const Scalar4* d_postype,
+                                     const Scalar4* d_orientation,
+                                     Index2D body_indexer,
+                                     Scalar3* d_body_pos,
+                                     const unsigned int* d_body_len,
+                                     const unsigned int* d_body,
+                                     const unsigned int* d_tag,
+                                     uint2* d_flag,
+                                     Scalar4* d_net_force,
+                                     Scalar4* d_net_torque,
+                                     unsigned int N,
+                                     unsigned int block_size,
+                                     bool zero_force,
+                                     const GPUPartition& gpu_partition,
+                                     CachedAllocator& alloc);
+
 hipError_t gpu_rigid_virial(Scalar* d_virial,
                             const unsigned int* d_molecule_len,
                             const unsigned int* d_molecule_list,
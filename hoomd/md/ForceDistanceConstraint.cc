@@ -22,6 +22,7 @@ ForceDistanceConstraint::ForceDistanceConstraint(std::shared_ptr<SystemDefinitio
     : MolecularForceCompute(sysdef), m_cdata(m_sysdef->getConstraintData()), m_cmatrix(m_exec_conf),
       m_cvec(m_exec_conf), m_lagrange(m_exec_conf), m_rel_tol(1e-3),
       m_constraint_violated(m_exec_conf), m_condition(m_exec_conf), m_sparse_idxlookup(m_exec_conf),
+      m_iterative(false), m_solver_tol(1e-8), m_pattern_analyzed(false), m_warm_start(false),
       m_constraint_reorder(true), m_constraints_added_removed(true), m_d_max(0.0)
     {
     m_constraint_violated.resetFlags(0);
@@ -354,6 +355,10 @@ void ForceDistanceConstraint::solveConstraints(uint64_t timestep)
     if (m_prof)
         m_prof->push("solve");
 
+    // the previous multipliers are only a useful guess for the same constraints
+    if (m_lagrange.size() != n_constraint)
+        m_warm_start = false;
+
     // reallocate array of constraint forces
     m_lagrange.resize(n_constraint);
 
@@ -415,8 +420,8 @@ void ForceDistanceConstraint::solveConstraints(uint64_t timestep)
                 }
             }
 
-        // Compute the ordering permutation vector from the structural pattern of A
-        m_sparse_solver.analyzePattern(m_sparse);
+        // the ordering is computed lazily, the iterative solver does not need it
+        m_pattern_analyzed = false;
 
         if (m_prof)
             m_prof->pop();
@@ -425,22 +430,57 @@ void ForceDistanceConstraint::solveConstraints(uint64_t timestep)
     if (m_prof)
         m_prof->push("refactor/solve");
 
-    // Compute the numerical factorization
-    m_sparse_solver.factorize(m_sparse);
-
-    if (m_sparse_solver.info())
-        {
-        throw std::runtime_error("Could not solve linear system of constraint equations.");
-        }
-
     // access RHS and solution vector
     ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::read);
-    ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::overwrite);
+    ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::readwrite);
     vec_map_t map_vec(h_cvec.data, n_constraint, 1);
     vec_map_t map_lagrange(h_lagrange.data, n_constraint, 1);
 
-    // Use the factors to solve the linear system
-    map_lagrange = m_sparse_solver.solve(map_vec);
+    bool solved = false;
+    if (m_iterative)
+        {
+        // the multipliers change little between steps, so the previous solution is a good guess
+        if (!m_warm_start)
+            map_lagrange.setZero();
+
+        m_iterative_solver.setTolerance(m_solver_tol);
+        m_iterative_solver.compute(m_sparse);
+        vec_t guess = map_lagrange;
+        map_lagrange = m_iterative_solver.solveWithGuess(map_vec, guess);
+
+        solved = m_iterative_solver.info() == Eigen::Success;
+        if (!solved)
+            {
+            m_exec_conf->msg->notice(6)
+                << "ForceDistanceConstraint: iterative solver did not converge after "
+                << m_iterative_solver.iterations() << " iterations, falling back to LU"
+                << std::endl;
+            }
+        }
+
+    if (!solved)
+        {
+        // Compute the ordering permutation vector from the structural pattern of A
+        if (!m_pattern_analyzed)
+            {
+            m_sparse_solver.analyzePattern(m_sparse);
+            m_pattern_analyzed = true;
+            }
+
+        // Compute the numerical factorization
+        m_sparse_solver.factorize(m_sparse);
+
+        if (m_sparse_solver.info())
+            {
+            m_warm_start = false;
+            throw std::runtime_error("Could not solve linear system of constraint equations.");
+            }
+
+        // Use the factors to solve the linear system
+        map_lagrange = m_sparse_solver.solve(map_vec);
+        }
+
+    m_warm_start = true;
 
     if (m_prof)
         m_prof->pop();
@@ -684,7 +724,13 @@ void export_ForceDistanceConstraint(pybind11::module& m)
         .def(pybind11::init<std::shared_ptr<SystemDefinition>>())
         .def_property("tolerance",
                       &ForceDistanceConstraint::getRelativeTolerance,
-                      &ForceDistanceConstraint::setRelativeTolerance);
+                      &ForceDistanceConstraint::setRelativeTolerance)
+        .def_property("solver",
+                      &ForceDistanceConstraint::getSolverPython,
+                      &ForceDistanceConstraint::setSolverPython)
+        .def_property("solver_tolerance",
+                      &ForceDistanceConstraint::getSolverTolerance,
+                      &ForceDistanceConstraint::setSolverTolerance);
     }
 
     } // end namespace detail
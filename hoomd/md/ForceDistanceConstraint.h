@@ -22,6 +22,7 @@
 #include "hoomd/GPUVector.h"
 
 #include <Eigen/Dense>
+#include <Eigen/IterativeLinearSolvers>
 #include <Eigen/SparseLU>
 
 namespace hoomd
@@ -65,6 +66,38 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
         return m_rel_tol;
         }
 
+    /// Set the linear solver ("direct" or "iterative")
+    void setSolverPython(const std::string& solver)
+        {
+        if (solver == "direct")
+            m_iterative = false;
+        else if (solver == "iterative")
+            m_iterative = true;
+        else
+            throw std::invalid_argument("Invalid constraint solver " + solver);
+
+        // the solvers keep different sparse matrix representations
+        m_condition.resetFlags(1);
+        }
+
+    /// Get the linear solver
+    std::string getSolverPython()
+        {
+        return m_iterative ? "iterative" : "direct";
+        }
+
+    /// Set the relative residual at which the iterative solver stops
+    void setSolverTolerance(Scalar solver_tol)
+        {
+        m_solver_tol = solver_tol;
+        }
+
+    /// Get the relative residual at which the iterative solver stops
+    Scalar getSolverTolerance()
+        {
+        return m_solver_tol;
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
@@ -92,6 +125,14 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     GPUVector<int>
         m_sparse_idxlookup; //!< Reverse lookup from column-major to sparse matrix element
 
+    Eigen::BiCGSTAB<Eigen::SparseMatrix<double, Eigen::ColMajor>,
+                    Eigen::DiagonalPreconditioner<double>>
+        m_iterative_solver;  //!< Iterative solver, warm started from the previous multipliers
+    bool m_iterative;        //!< True if the iterative solver is used
+    Scalar m_solver_tol;     //!< Relative residual at which the iterative solver stops
+    bool m_pattern_analyzed; //!< True if the LU solver has analyzed the current pattern
+    bool m_warm_start;       //!< True if m_lagrange holds multipliers for the current constraints
+
     bool m_constraint_reorder;        //!< True if groups have changed
     bool m_constraints_added_removed; //!< True if global constraint topology has changed
 
@@ -116,12 +157,14 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     virtual void slotConstraintReorder()
         {
         m_constraint_reorder = true;
+        m_warm_start = false;
         }
 
     //! Method called when constraint order changes
     virtual void slotConstraintsAddedRemoved()
         {
         m_constraints_added_removed = true;
+        m_warm_start = false;
         }
 
     //! Returns the requested ghost layer width for all types
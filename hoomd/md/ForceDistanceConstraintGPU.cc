@@ -218,23 +218,32 @@ void ForceDistanceConstraintGPU::solveConstraints(uint64_t timestep)
     // ==1 if the sparsity pattern of the matrix changes (in particular if connectivity changes)
     unsigned int sparsity_pattern_changed = m_condition.readFlags();
 
-#ifndef CUSOLVER_AVAILABLE
-    if (!sparsity_pattern_changed)
+    // the iterative solver runs on the CPU, warm started from the previous multipliers
+#ifdef CUSOLVER_AVAILABLE
+    if (m_iterative)
+#endif
         {
-        // copy new sparse values to host sparse matrix
-        ArrayHandle<double> h_sparse_val(m_sparse_val, access_location::device, access_mode::read);
-        hipMemcpy(m_sparse.valuePtr(),
-                  h_sparse_val.data,
-                  sizeof(double) * m_sparse.data().size(),
-                  hipMemcpyDeviceToHost);
-        }
+        if (!sparsity_pattern_changed)
+            {
+            // copy new sparse values to host sparse matrix
+            ArrayHandle<double> h_sparse_val(m_sparse_val,
+                                             access_location::device,
+                                             access_mode::read);
+            hipMemcpy(m_sparse.valuePtr(),
+                      h_sparse_val.data,
+                      sizeof(double) * m_sparse.data().size(),
+                      hipMemcpyDeviceToHost);
+            }
 
-    // solve on CPU
-    ForceDistanceConstraint::solveConstraints(timestep);
+        // solve on CPU
+        ForceDistanceConstraint::solveConstraints(timestep);
 
-    // a sparse matrix should have been constructed, resize values array
-    m_sparse_val.resize(m_sparse.data().size());
-#else
+        // a sparse matrix should have been constructed, resize values array
+        m_sparse_val.resize(m_sparse.data().size());
+        return;
+        }
+
+#ifdef CUSOLVER_AVAILABLE
 
     unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
 
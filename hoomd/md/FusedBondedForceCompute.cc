@@ -0,0 +1,123 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file FusedBondedForceCompute.cc
+    \brief Contains code for the FusedBondedForceCompute class
+*/
+
+#include "FusedBondedForceCompute.h"
+
+#include <string.h>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System to compute forces on
+    \param bond Bond force compute (may be null)
+    \param angle Angle force compute (may be null)
+    \param dihedral Dihedral force compute (may be null)
+*/
+FusedBondedForceCompute::FusedBondedForceCompute(std::shared_ptr<SystemDefinition> sysdef,
+                                                 std::shared_ptr<ForceCompute> bond,
+                                                 std::shared_ptr<ForceCompute> angle,
+                                                 std::shared_ptr<ForceCompute> dihedral)
+    : ForceCompute(sysdef), m_bond(bond), m_angle(angle), m_dihedral(dihedral), m_per_group(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing FusedBondedForceCompute" << endl;
+    }
+
+FusedBondedForceCompute::~FusedBondedForceCompute()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying FusedBondedForceCompute" << endl;
+    }
+
+/*! Computes each component and sums the forces, energies, and virials.
+
+    \param timestep Current time step of the simulation
+*/
+void FusedBondedForceCompute::computeForces(uint64_t timestep)
+    {
+    if (m_prof)
+        m_prof->push("Fused bonded");
+
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+    memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+
+    const unsigned int N = m_pdata->getN();
+    const size_t virial_pitch = m_virial.getPitch();
+
+    for (auto& component : {m_bond, m_angle, m_dihedral})
+        {
+        if (!component)
+            continue;
+
+        component->compute(timestep);
+
+        ArrayHandle<Scalar4> h_component_force(component->getForceArray(),
+                                               access_location::host,
+                                               access_mode::read);
+        ArrayHandle<Scalar> h_component_virial(component->getVirialArray(),
+                                               access_location::host,
+                                               access_mode::read);
+        const size_t component_pitch = component->getVirialArray().getPitch();
+
+        for (unsigned int i = 0; i < N; i++)
+            {
+            h_force.data[i].x += h_component_force.data[i].x;
+            h_force.data[i].y += h_component_force.data[i].y;
+            h_force.data[i].z += h_component_force.data[i].z;
+            h_force.data[i].w += h_component_force.data[i].w;
+
+            for (unsigned int j = 0; j < 6; j++)
+                h_virial.data[j * virial_pitch + i]
+                    += h_component_virial.data[j * component_pitch + i];
+            }
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+    \returns The union of the fields requested by the components
+*/
+CommFlags FusedBondedForceCompute::getRequestedCommFlags(uint64_t timestep)
+    {
+    CommFlags flags = CommFlags(0);
+
+    for (auto& component : {m_bond, m_angle, m_dihedral})
+        {
+        if (component)
+            flags |= component->getRequestedCommFlags(timestep);
+        }
+
+    flags |= ForceCompute::getRequestedCommFlags(timestep);
+    return flags;
+    }
+#endif
+
+namespace detail
+    {
+void export_FusedBondedForceCompute(pybind11::module& m)
+    {
+    pybind11::class_<FusedBondedForceCompute,
+                     ForceCompute,
+                     std::shared_ptr<FusedBondedForceCompute>>(m, "FusedBondedForceCompute")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<ForceCompute>,
+                            std::shared_ptr<ForceCompute>,
+                            std::shared_ptr<ForceCompute>>())
+        .def_property("per_group",
+                      &FusedBondedForceCompute::getPerGroup,
+                      &FusedBondedForceCompute::setPerGroup);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
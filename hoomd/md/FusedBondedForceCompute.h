@@ -0,0 +1,84 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/ForceCompute.h"
+
+#include <memory>
+
+/*! \file FusedBondedForceCompute.h
+    \brief Declares a class that evaluates bond, angle, and dihedral forces as one force
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __FUSEDBONDEDFORCECOMPUTE_H__
+#define __FUSEDBONDEDFORCECOMPUTE_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Evaluates bond, angle, and dihedral forces as one force
+/*! FusedBondedForceCompute owns up to three bonded force computes (one each for bonds, angles, and
+    dihedrals) that are not added to the integrator themselves. The components hold the per-type
+    parameters. On the CPU, FusedBondedForceCompute computes each component and sums their forces,
+    energies, and virials. FusedBondedForceComputeGPU replaces the separate kernels with a single
+    kernel that walks all bonded groups of each particle.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT FusedBondedForceCompute : public ForceCompute
+    {
+    public:
+    //! Constructs the compute
+    FusedBondedForceCompute(std::shared_ptr<SystemDefinition> sysdef,
+                            std::shared_ptr<ForceCompute> bond,
+                            std::shared_ptr<ForceCompute> angle,
+                            std::shared_ptr<ForceCompute> dihedral);
+
+    //! Destructor
+    virtual ~FusedBondedForceCompute();
+
+    //! Set whether to evaluate each group once instead of once per member
+    /*! The components evaluate each group once on the CPU. This setting selects the GPU kernel.
+     */
+    void setPerGroup(bool per_group)
+        {
+        m_per_group = per_group;
+        }
+
+    //! Get whether to evaluate each group once instead of once per member
+    bool getPerGroup() const
+        {
+        return m_per_group;
+        }
+
+#ifdef ENABLE_MPI
+    //! Get ghost particle fields requested by the components
+    virtual CommFlags getRequestedCommFlags(uint64_t timestep);
+#endif
+
+    protected:
+    std::shared_ptr<ForceCompute> m_bond;     //!< Bond force (may be null)
+    std::shared_ptr<ForceCompute> m_angle;    //!< Angle force (may be null)
+    std::shared_ptr<ForceCompute> m_dihedral; //!< Dihedral force (may be null)
+    bool m_per_group;                         //!< True to evaluate each group once
+
+    //! Actually compute the forces
+    virtual void computeForces(uint64_t timestep);
+    };
+
+namespace detail
+    {
+//! Exports the FusedBondedForceCompute class to python
+void export_FusedBondedForceCompute(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -0,0 +1,310 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file FusedBondedForceComputeGPU.cc
+    \brief Defines FusedBondedForceComputeGPU
+*/
+
+#include "FusedBondedForceComputeGPU.h"
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System to compute forces on
+    \param bond Harmonic bond force compute (may be null)
+    \param angle Harmonic angle force compute (may be null)
+    \param dihedral Harmonic or OPLS dihedral force compute (may be null)
+*/
+FusedBondedForceComputeGPU::FusedBondedForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                                       std::shared_ptr<ForceCompute> bond,
+                                                       std::shared_ptr<ForceCompute> angle,
+                                                       std::shared_ptr<ForceCompute> dihedral)
+    : FusedBondedForceCompute(sysdef, bond, angle, dihedral)
+    {
+    // can't run on the GPU if there aren't any GPUs in the execution configuration
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        throw std::runtime_error("Cannot create FusedBondedForceComputeGPU on the CPU.");
+        }
+
+    m_harmonic_bond = std::dynamic_pointer_cast<PotentialBondHarmonic>(bond);
+    if (bond && !m_harmonic_bond)
+        throw std::runtime_error("The fused bonded kernel evaluates only harmonic bonds.");
+
+    m_harmonic_angle = std::dynamic_pointer_cast<HarmonicAngleForceComputeGPU>(angle);
+    if (angle && !m_harmonic_angle)
+        throw std::runtime_error("The fused bonded kernel evaluates only harmonic angles.");
+
+    m_harmonic_dihedral = std::dynamic_pointer_cast<HarmonicDihedralForceComputeGPU>(dihedral);
+    m_opls_dihedral = std::dynamic_pointer_cast<OPLSDihedralForceCompute>(dihedral);
+    if (dihedral && !m_harmonic_dihedral && !m_opls_dihedral)
+        throw std::runtime_error(
+            "The fused bonded kernel evaluates only harmonic and OPLS dihedrals.");
+
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "fused_bonded", this->m_exec_conf));
+    m_tuner_group.reset(new Autotuner(warp_size,
+                                      1024,
+                                      warp_size,
+                                      5,
+                                      100000,
+                                      "fused_bonded_group",
+                                      this->m_exec_conf));
+    }
+
+FusedBondedForceComputeGPU::~FusedBondedForceComputeGPU() { }
+
+/*! \param timestep Current time step of the simulation
+ */
+void FusedBondedForceComputeGPU::computeForces(uint64_t timestep)
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "Fused bonded");
+
+    if (m_per_group)
+        computeGroupForces();
+    else
+        computeParticleForces();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+/*! Calls gpu_compute_fused_bonded_forces to do the dirty work.
+ */
+void FusedBondedForceComputeGPU::computeParticleForces()
+    {
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::overwrite);
+    ArrayHandle<Scalar> d_virial(m_virial, access_location::device, access_mode::overwrite);
+
+    kernel::fused_bonded_args_t args;
+    args.d_force = d_force.data;
+    args.d_virial = d_virial.data;
+    args.virial_pitch = m_virial.getPitch();
+    args.N = m_pdata->getN();
+    args.d_pos = d_pos.data;
+    args.box = m_pdata->getGlobalBox();
+
+    // null arrays skip a kind of group in the kernel
+    std::unique_ptr<ArrayHandle<BondData::members_t>> d_bonds;
+    std::unique_ptr<ArrayHandle<unsigned int>> d_n_bonds;
+    std::unique_ptr<ArrayHandle<harmonic_params>> d_bond_params;
+    args.d_bonds = nullptr;
+    args.d_n_bonds = nullptr;
+    args.bond_pitch = 0;
+    args.d_bond_params = nullptr;
+    if (m_harmonic_bond)
+        {
+        std::shared_ptr<BondData> bond_data = m_sysdef->getBondData();
+        d_bonds.reset(new ArrayHandle<BondData::members_t>(bond_data->getGPUTable(),
+                                                           access_location::device,
+                                                           access_mode::read));
+        d_n_bonds.reset(new ArrayHandle<unsigned int>(bond_data->getNGroupsArray(),
+                                                      access_location::device,
+                                                      access_mode::read));
+        d_bond_params.reset(
+            new ArrayHandle<harmonic_params>(m_harmonic_bond->getParamArray(),
+                                             access_location::device,
+                                             access_mode::read));
+        args.d_bonds = d_bonds->data;
+        args.d_n_bonds = d_n_bonds->data;
+        args.bond_pitch = bond_data->getGPUTableIndexer().getW();
+        args.d_bond_params = d_bond_params->data;
+        }
+
+    std::unique_ptr<ArrayHandle<AngleData::members_t>> d_angles;
+    std::unique_ptr<ArrayHandle<unsigned int>> d_angle_pos;
+    std::unique_ptr<ArrayHandle<unsigned int>> d_n_angles;
+    std::unique_ptr<ArrayHandle<Scalar2>> d_angle_params;
+    args.d_angles = nullptr;
+    args.d_angle_pos = nullptr;
+    args.d_n_angles = nullptr;
+    args.angle_pitch = 0;
+    args.d_angle_params = nullptr;
+    if (m_harmonic_angle)
+        {
+        std::shared_ptr<AngleData> angle_data = m_sysdef->getAngleData();
+        d_angles.reset(new ArrayHandle<AngleData::members_t>(angle_data->getGPUTable(),
+                                                             access_location::device,
+                                                             access_mode::read));
+        d_angle_pos.reset(new ArrayHandle<unsigned int>(angle_data->getGPUPosTable(),
+                                                        access_location::device,
+                                                        access_mode::read));
+        d_n_angles.reset(new ArrayHandle<unsigned int>(angle_data->getNGroupsArray(),
+                                                       access_location::device,
+                                                       access_mode::read));
+        d_angle_params.reset(new ArrayHandle<Scalar2>(m_harmonic_angle->getParamArray(),
+                                                      access_location::device,
+                                                      access_mode::read));
+        args.d_angles = d_angles->data;
+        args.d_angle_pos = d_angle_pos->data;
+        args.d_n_angles = d_n_angles->data;
+        args.angle_pitch = angle_data->getGPUTableIndexer().getW();
+        args.d_angle_params = d_angle_params->data;
+        }
+
+    std::unique_ptr<ArrayHandle<DihedralData::members_t>> d_dihedrals;
+    std::unique_ptr<ArrayHandle<unsigned int>> d_dihedral_pos;
+    std::unique_ptr<ArrayHandle<unsigned int>> d_n_dihedrals;
+    std::unique_ptr<ArrayHandle<Scalar4>> d_dihedral_params;
+    args.d_dihedrals = nullptr;
+    args.d_dihedral_pos = nullptr;
+    args.d_n_dihedrals = nullptr;
+    args.dihedral_pitch = 0;
+    args.d_dihedral_params = nullptr;
+    args.dihedral_kind = kernel::fused_dihedral_kind::none;
+    if (m_harmonic_dihedral || m_opls_dihedral)
+        {
+        std::shared_ptr<DihedralData> dihedral_data = m_sysdef->getDihedralData();
+        d_dihedrals.reset(new ArrayHandle<DihedralData::members_t>(dihedral_data->getGPUTable(),
+                                                                   access_location::device,
+                                                                   access_mode::read));
+        d_dihedral_pos.reset(new ArrayHandle<unsigned int>(dihedral_data->getGPUPosTable(),
+                                                           access_location::device,
+                                                           access_mode::read));
+        d_n_dihedrals.reset(new ArrayHandle<unsigned int>(dihedral_data->getNGroupsArray(),
+                                                          access_location::device,
+                                                          access_mode::read));
+        const GPUArray<Scalar4>& params = m_harmonic_dihedral
+                                              ? m_harmonic_dihedral->getParamArray()
+                                              : m_opls_dihedral->getParamArray();
+        d_dihedral_params.reset(
+            new ArrayHandle<Scalar4>(params, access_location::device, access_mode::read));
+        args.d_dihedrals = d_dihedrals->data;
+        args.d_dihedral_pos = d_dihedral_pos->data;
+        args.d_n_dihedrals = d_n_dihedrals->data;
+        args.dihedral_pitch = dihedral_data->getGPUTableIndexer().getW();
+        args.d_dihedral_params = d_dihedral_params->data;
+        args.dihedral_kind = m_harmonic_dihedral ? kernel::fused_dihedral_kind::harmonic
+                                                 : kernel::fused_dihedral_kind::opls;
+        }
+
+    m_tuner->begin();
+    kernel::gpu_compute_fused_bonded_forces(args, m_tuner->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner->end();
+    }
+
+/*! Calls gpu_compute_fused_bonded_group_forces to do the dirty work.
+ */
+void FusedBondedForceComputeGPU::computeGroupForces()
+    {
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(),
+                                     access_location::device,
+                                     access_mode::read);
+    ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::overwrite);
+    ArrayHandle<Scalar> d_virial(m_virial, access_location::device, access_mode::overwrite);
+
+    // the kernel adds the contributions of each group to the members
+    hipMemset(d_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+    hipMemset(d_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+
+    kernel::fused_bonded_group_args_t args;
+    args.d_force = d_force.data;
+    args.d_virial = d_virial.data;
+    args.virial_pitch = m_virial.getPitch();
+    args.N = m_pdata->getN();
+    args.d_pos = d_pos.data;
+    args.d_rtag = d_rtag.data;
+    args.box = m_pdata->getGlobalBox();
+
+    std::shared_ptr<BondData> bond_data = m_sysdef->getBondData();
+    std::shared_ptr<AngleData> angle_data = m_sysdef->getAngleData();
+    std::shared_ptr<DihedralData> dihedral_data = m_sysdef->getDihedralData();
+
+    ArrayHandle<BondData::members_t> d_bonds(bond_data->getMembersArray(),
+                                             access_location::device,
+                                             access_mode::read);
+    ArrayHandle<typeval_t> d_bond_typeval(bond_data->getTypeValArray(),
+                                          access_location::device,
+                                          access_mode::read);
+    ArrayHandle<AngleData::members_t> d_angles(angle_data->getMembersArray(),
+                                               access_location::device,
+                                               access_mode::read);
+    ArrayHandle<typeval_t> d_angle_typeval(angle_data->getTypeValArray(),
+                                           access_location::device,
+                                           access_mode::read);
+    ArrayHandle<DihedralData::members_t> d_dihedrals(dihedral_data->getMembersArray(),
+                                                     access_location::device,
+                                                     access_mode::read);
+    ArrayHandle<typeval_t> d_dihedral_typeval(dihedral_data->getTypeValArray(),
+                                              access_location::device,
+                                              access_mode::read);
+
+    args.d_bonds = d_bonds.data;
+    args.d_bond_typeval = d_bond_typeval.data;
+    args.n_bonds = m_harmonic_bond ? bond_data->getN() : 0;
+    args.d_angles = d_angles.data;
+    args.d_angle_typeval = d_angle_typeval.data;
+    args.n_angles = m_harmonic_angle ? angle_data->getN() : 0;
+    args.d_dihedrals = d_dihedrals.data;
+    args.d_dihedral_typeval = d_dihedral_typeval.data;
+    args.n_dihedrals = (m_harmonic_dihedral || m_opls_dihedral) ? dihedral_data->getN() : 0;
+
+    // null parameters belong to kinds with no groups to evaluate
+    std::unique_ptr<ArrayHandle<harmonic_params>> d_bond_params;
+    args.d_bond_params = nullptr;
+    if (m_harmonic_bond)
+        {
+        d_bond_params.reset(
+            new ArrayHandle<harmonic_params>(m_harmonic_bond->getParamArray(),
+                                             access_location::device,
+                                             access_mode::read));
+        args.d_bond_params = d_bond_params->data;
+        }
+
+    std::unique_ptr<ArrayHandle<Scalar2>> d_angle_params;
+    args.d_angle_params = nullptr;
+    if (m_harmonic_angle)
+        {
+        d_angle_params.reset(new ArrayHandle<Scalar2>(m_harmonic_angle->getParamArray(),
+                                                      access_location::device,
+                                                      access_mode::read));
+        args.d_angle_params = d_angle_params->data;
+        }
+
+    std::unique_ptr<ArrayHandle<Scalar4>> d_dihedral_params;
+    args.d_dihedral_params = nullptr;
+    args.dihedral_kind = kernel::fused_dihedral_kind::none;
+    if (m_harmonic_dihedral || m_opls_dihedral)
+        {
+        const GPUArray<Scalar4>& params = m_harmonic_dihedral
+                                              ? m_harmonic_dihedral->getParamArray()
+                                              : m_opls_dihedral->getParamArray();
+        d_dihedral_params.reset(
+            new ArrayHandle<Scalar4>(params, access_location::device, access_mode::read));
+        args.d_dihedral_params = d_dihedral_params->data;
+        args.dihedral_kind = m_harmonic_dihedral ? kernel::fused_dihedral_kind::harmonic
+                                                 : kernel::fused_dihedral_kind::opls;
+        }
+
+    m_tuner_group->begin();
+    kernel::gpu_compute_fused_bonded_group_forces(args, m_tuner_group->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner_group->end();
+    }
+
+namespace detail
+    {
+void export_FusedBondedForceComputeGPU(pybind11::module& m)
+    {
+    pybind11::class_<FusedBondedForceComputeGPU,
+                     FusedBondedForceCompute,
+                     std::shared_ptr<FusedBondedForceComputeGPU>>(m, "FusedBondedForceComputeGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<ForceCompute>,
+                            std::shared_ptr<ForceCompute>,
+                            std::shared_ptr<ForceCompute>>());
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
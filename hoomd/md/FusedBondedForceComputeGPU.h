@@ -0,0 +1,99 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "AllBondPotentials.h"
+#include "FusedBondedForceCompute.h"
+#include "FusedBondedForceGPU.cuh"
+#include "HarmonicAngleForceComputeGPU.h"
+#include "HarmonicDihedralForceComputeGPU.h"
+#include "OPLSDihedralForceComputeGPU.h"
+#include "hoomd/Autotuner.h"
+
+#include <memory>
+
+/*! \file FusedBondedForceComputeGPU.h
+    \brief Declares the FusedBondedForceComputeGPU class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __FUSEDBONDEDFORCECOMPUTEGPU_H__
+#define __FUSEDBONDEDFORCECOMPUTEGPU_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Evaluates bond, angle, and dihedral forces in one kernel on the GPU
+/*! Each thread of the kernel handles one particle. It reads the particle position once, walks the
+    bond, angle, and dihedral tables of that particle, and writes the net force and virial once.
+    The kernel reads the per-type parameters from the component computes, so parameter changes on
+    the components take effect on the next step.
+
+    With per_group set, a second kernel instead evaluates each group once from the group member
+    arrays and adds the forces on the members with atomic operations. This does 1/2, 1/3, and 1/4
+    of the bond, angle, and dihedral evaluations of the per-particle kernel and does not need the
+    per-particle GPU tables, at the cost of atomic contention and a summation order that varies
+    from run to run.
+
+    The kernels evaluate harmonic bonds, harmonic angles, and harmonic or OPLS dihedrals. The
+    constructor throws for any other component.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT FusedBondedForceComputeGPU : public FusedBondedForceCompute
+    {
+    public:
+    //! Constructs the compute
+    FusedBondedForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef,
+                               std::shared_ptr<ForceCompute> bond,
+                               std::shared_ptr<ForceCompute> angle,
+                               std::shared_ptr<ForceCompute> dihedral);
+
+    //! Destructor
+    virtual ~FusedBondedForceComputeGPU();
+
+    //! Set autotuner parameters
+    /*! \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        FusedBondedForceCompute::setAutotunerParams(enable, period);
+        m_tuner->setPeriod(period);
+        m_tuner->setEnabled(enable);
+        m_tuner_group->setPeriod(period);
+        m_tuner_group->setEnabled(enable);
+        }
+
+    protected:
+    std::unique_ptr<Autotuner> m_tuner;       //!< Autotuner for the per-particle kernel
+    std::unique_ptr<Autotuner> m_tuner_group; //!< Autotuner for the per-group kernel
+
+    std::shared_ptr<PotentialBondHarmonic> m_harmonic_bond;               //!< Harmonic bonds
+    std::shared_ptr<HarmonicAngleForceComputeGPU> m_harmonic_angle;       //!< Harmonic angles
+    std::shared_ptr<HarmonicDihedralForceComputeGPU> m_harmonic_dihedral; //!< Harmonic dihedrals
+    std::shared_ptr<OPLSDihedralForceCompute> m_opls_dihedral;            //!< OPLS dihedrals
+
+    //! Actually compute the forces
+    virtual void computeForces(uint64_t timestep);
+
+    //! Evaluate the groups of each particle in one thread
+    void computeParticleForces();
+
+    //! Evaluate each group once
+    void computeGroupForces();
+    };
+
+namespace detail
+    {
+//! Exports the FusedBondedForceComputeGPU class to python
+void export_FusedBondedForceComputeGPU(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -0,0 +1,704 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "FusedBondedForceGPU.cuh"
+#include "hoomd/TextureTools.h"
+
+#include <assert.h>
+
+// SMALL a relatively small number
+#define SMALL Scalar(0.001)
+
+/*! \file FusedBondedForceGPU.cu
+    \brief Defines GPU kernel code for evaluating bond, angle, and dihedral forces in one pass.
+   Used by FusedBondedForceComputeGPU.
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Add the upper triangle of the outer product r f to a virial
+__device__ inline void
+add_virial(Scalar* virial, const Scalar scale, const Scalar3& r, const Scalar3& f)
+    {
+    virial[0] += scale * r.x * f.x;
+    virial[1] += scale * r.y * f.x;
+    virial[2] += scale * r.z * f.x;
+    virial[3] += scale * r.y * f.y;
+    virial[4] += scale * r.z * f.y;
+    virial[5] += scale * r.z * f.z;
+    }
+
+#if !defined(SINGLE_PRECISION) && (__CUDA_ARCH__ < 600)
+//! atomicAdd function for double-precision floating point numbers
+/*! \param address Address to write the double to
+    \param val Value to add to address
+*/
+__device__ inline double fusedAtomicAdd(double* address, double val)
+    {
+    unsigned long long int* address_as_ull = (unsigned long long int*)address;
+    unsigned long long int old = *address_as_ull, assumed;
+
+    do
+        {
+        assumed = old;
+        old = atomicCAS(address_as_ull,
+                        assumed,
+                        __double_as_longlong(val + __longlong_as_double(assumed)));
+        } while (assumed != old);
+
+    return __longlong_as_double(old);
+    }
+#else
+//! atomicAdd function for floating point numbers
+__device__ inline Scalar fusedAtomicAdd(Scalar* address, Scalar val)
+    {
+    return atomicAdd(address, val);
+    }
+#endif
+
+//! Add the force, energy, and virial of one group member to a particle
+/*! \param d_force Force array
+    \param d_virial Virial array
+    \param virial_pitch Pitch of the virial array
+    \param N Number of local particles
+    \param idx Particle index of the member
+    \param f Force on the member
+    \param energy Energy share of the member
+    \param virial Virial share of the member
+
+    Ghost members are skipped: the rank that owns them evaluates the group as well.
+*/
+__device__ inline void accumulate_member(Scalar4* d_force,
+                                         Scalar* d_virial,
+                                         const size_t virial_pitch,
+                                         const unsigned int N,
+                                         const unsigned int idx,
+                                         const Scalar3& f,
+                                         const Scalar energy,
+                                         const Scalar* virial)
+    {
+    if (idx >= N)
+        return;
+
+    fusedAtomicAdd(&d_force[idx].x, f.x);
+    fusedAtomicAdd(&d_force[idx].y, f.y);
+    fusedAtomicAdd(&d_force[idx].z, f.z);
+    fusedAtomicAdd(&d_force[idx].w, energy);
+    for (unsigned int i = 0; i < 6; i++)
+        fusedAtomicAdd(&d_virial[i * virial_pitch + idx], virial[i]);
+    }
+
+//! Evaluate one harmonic angle
+/*! \param dab Minimum image of a - b
+    \param dcb Minimum image of c - b
+    \param params K and t_0
+    \param fab Force on particle a
+    \param fcb Force on particle c
+    \returns The energy of the angle
+
+    Implements the same potential as HarmonicAngleForceGPU.cu.
+*/
+__device__ inline Scalar eval_harmonic_angle(const Scalar3& dab,
+                                             const Scalar3& dcb,
+                                             const Scalar2& params,
+                                             Scalar3& fab,
+                                             Scalar3& fcb)
+    {
+    Scalar rsqab = dot(dab, dab);
+    Scalar rab = fast::sqrt(rsqab);
+    Scalar rsqcb = dot(dcb, dcb);
+    Scalar rcb = fast::sqrt(rsqcb);
+
+    Scalar c_abbc = dot(dab, dcb) / (rab * rcb);
+    if (c_abbc > Scalar(1.0))
+        c_abbc = Scalar(1.0);
+    if (c_abbc < -Scalar(1.0))
+        c_abbc = -Scalar(1.0);
+
+    Scalar s_abbc = fast::sqrt(Scalar(1.0) - c_abbc * c_abbc);
+    if (s_abbc < SMALL)
+        s_abbc = SMALL;
+    s_abbc = Scalar(1.0) / s_abbc;
+
+    Scalar dth = fast::acos(c_abbc) - params.y;
+    Scalar tk = params.x * dth;
+
+    Scalar a = -tk * s_abbc;
+    Scalar a11 = a * c_abbc / rsqab;
+    Scalar a12 = -a / (rab * rcb);
+    Scalar a22 = a * c_abbc / rsqcb;
+
+    fab = a11 * dab + a12 * dcb;
+    fcb = a22 * dcb + a12 * dab;
+
+    return Scalar(0.5) * tk * dth;
+    }
+
+//! Evaluate the torsion term of a harmonic dihedral
+/*! \param c Cosine of the dihedral angle
+    \param s Sine of the dihedral angle
+    \param params K, sign, multiplicity, and phi_0
+    \param df Derivative of the energy with respect to the dihedral angle
+    \returns The energy of the dihedral
+
+    Implements the same potential as HarmonicDihedralForceGPU.cu.
+*/
+__device__ inline Scalar
+eval_harmonic_torsion(const Scalar c, const Scalar s, const Scalar4& params, Scalar& df)
+    {
+    Scalar K = params.x;
+    Scalar sign = params.y;
+    Scalar multi = params.z;
+    Scalar phi_0 = params.w;
+
+    Scalar p = Scalar(1.0);
+    Scalar ddfab = Scalar(0.0);
+    Scalar dfab = Scalar(0.0);
+    int m = __scalar2int_rn(multi);
+
+    for (int jj = 0; jj < m; jj++)
+        {
+        ddfab = p * c - dfab * s;
+        dfab = p * s + dfab * c;
+        p = ddfab;
+        }
+
+    Scalar sin_phi_0 = fast::sin(phi_0);
+    Scalar cos_phi_0 = fast::cos(phi_0);
+    p = p * cos_phi_0 + dfab * sin_phi_0;
+    p *= sign;
+    dfab = dfab * cos_phi_0 - ddfab * sin_phi_0;
+    dfab *= sign;
+    dfab *= -multi;
+    p += Scalar(1.0);
+
+    if (multi < Scalar(1.0))
+        {
+        p = Scalar(1.0) + sign;
+        dfab = Scalar(0.0);
+        }
+
+    df = -K * dfab * Scalar(0.5);
+    return Scalar(0.5) * K * p;
+    }
+
+//! Evaluate the torsion term of an OPLS dihedral
+/*! \param c Cosine of the dihedral angle
+    \param s Sine of the dihedral angle
+    \param params k1/2, k2/2, k3/2, and k4/2
+    \param df Derivative of the energy with respect to the dihedral angle
+    \returns The energy of the dihedral
+
+    Implements the same potential as OPLSDihedralForceGPU.cu.
+*/
+__device__ inline Scalar
+eval_opls_torsion(const Scalar c, const Scalar s, const Scalar4& params, Scalar& df)
+    {
+    // cos(phi) term
+    Scalar ddf1 = c;
+    Scalar df1 = s;
+    Scalar cos_term = ddf1;
+
+    Scalar p = params.x * (Scalar(1.0) + cos_term);
+    df = params.x * df1;
+
+    // cos(2*phi) term
+    ddf1 = cos_term * c - df1 * s;
+    df1 = cos_term * s + df1 * c;
+    cos_term = ddf1;
+
+    p += params.y * (Scalar(1.0) - cos_term);
+    df += Scalar(-2.0) * params.y * df1;
+
+    // cos(3*phi) term
+    ddf1 = cos_term * c - df1 * s;
+    df1 = cos_term * s + df1 * c;
+    cos_term = ddf1;
+
+    p += params.z * (Scalar(1.0) + cos_term);
+    df += Scalar(3.0) * params.z * df1;
+
+    // cos(4*phi) term
+    ddf1 = cos_term * c - df1 * s;
+    df1 = cos_term * s + df1 * c;
+    cos_term = ddf1;
+
+    p += params.w * (Scalar(1.0) - cos_term);
+    df += Scalar(-4.0) * params.w * df1;
+
+    return p;
+    }
+
+//! Evaluate one dihedral
+/*! \param dab Minimum image of a - b
+    \param dcb Minimum image of c - b
+    \param ddc Minimum image of d - c
+    \param params Parameters of the dihedral type
+    \param fa Force on particle a
+    \param fb Force on particle b
+    \param fc Force on particle c
+    \param fd Force on particle d
+    \returns The energy of the dihedral
+
+    \tparam dihedral_kind Torsion potential to evaluate
+*/
+template<fused_dihedral_kind dihedral_kind>
+__device__ inline Scalar eval_dihedral(const Scalar3& dab,
+                                       const Scalar3& dcb,
+                                       const Scalar3& ddc,
+                                       const Scalar4& params,
+                                       Scalar3& fa,
+                                       Scalar3& fb,
+                                       Scalar3& fc,
+                                       Scalar3& fd)
+    {
+    Scalar3 dcbm = -dcb;
+
+    Scalar3 aa = make_scalar3(dab.y * dcbm.z - dab.z * dcbm.y,
+                              dab.z * dcbm.x - dab.x * dcbm.z,
+                              dab.x * dcbm.y - dab.y * dcbm.x);
+    Scalar3 bb = make_scalar3(ddc.y * dcbm.z - ddc.z * dcbm.y,
+                              ddc.z * dcbm.x - ddc.x * dcbm.z,
+                              ddc.x * dcbm.y - ddc.y * dcbm.x);
+
+    Scalar raasq = dot(aa, aa);
+    Scalar rbbsq = dot(bb, bb);
+    Scalar rg = fast::sqrt(dot(dcbm, dcbm));
+
+    Scalar rginv, raa2inv, rbb2inv;
+    rginv = raa2inv = rbb2inv = Scalar(0.0);
+    if (rg > Scalar(0.0))
+        rginv = Scalar(1.0) / rg;
+    if (raasq > Scalar(0.0))
+        raa2inv = Scalar(1.0) / raasq;
+    if (rbbsq > Scalar(0.0))
+        rbb2inv = Scalar(1.0) / rbbsq;
+    Scalar rabinv = fast::sqrt(raa2inv * rbb2inv);
+
+    Scalar c = dot(aa, bb) * rabinv;
+    Scalar s = rg * rabinv * dot(aa, ddc);
+
+    if (c > Scalar(1.0))
+        c = Scalar(1.0);
+    if (c < -Scalar(1.0))
+        c = -Scalar(1.0);
+
+    Scalar df;
+    Scalar eng;
+    if (dihedral_kind == fused_dihedral_kind::harmonic)
+        eng = eval_harmonic_torsion(c, s, params, df);
+    else
+        eng = eval_opls_torsion(c, s, params, df);
+
+    Scalar fga = dot(dab, dcbm) * raa2inv * rginv;
+    Scalar hgb = dot(ddc, dcbm) * rbb2inv * rginv;
+    Scalar gaa = -raa2inv * rg;
+    Scalar gbb = rbb2inv * rg;
+
+    Scalar3 dtf = gaa * aa;
+    Scalar3 dtg = fga * aa - hgb * bb;
+    Scalar3 dth = gbb * bb;
+
+    Scalar3 s2 = df * dtg;
+    fa = df * dtf;
+    fb = s2 - fa;
+    fd = df * dth;
+    fc = -s2 - fd;
+
+    return eng;
+    }
+
+//! Kernel for calculating bond, angle, and dihedral forces on the GPU
+/*! \param args Kernel arguments
+
+    Each thread handles one particle. It reads the particle's position once, loops over the bonds,
+    angles, and dihedrals it belongs to, and writes its net force and virial once. The energy and
+    virial of each group are split evenly among its members, as in the separate kernels.
+
+    \tparam dihedral_kind Torsion potential to evaluate
+*/
+template<fused_dihedral_kind dihedral_kind>
+__global__ void gpu_compute_fused_bonded_forces_kernel(const fused_bonded_args_t args)
+    {
+    // start by identifying which particle we are to handle
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= args.N)
+        return;
+
+    Scalar4 idx_postype = __ldg(args.d_pos + idx);
+    Scalar3 idx_pos = make_scalar3(idx_postype.x, idx_postype.y, idx_postype.z);
+
+    // initialize the force and virial to 0
+    Scalar4 force_idx = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+    Scalar virial[6];
+    for (unsigned int i = 0; i < 6; i++)
+        virial[i] = Scalar(0.0);
+
+    // bonds
+    unsigned int n_bonds = args.d_n_bonds ? args.d_n_bonds[idx] : 0;
+    for (unsigned int bond_idx = 0; bond_idx < n_bonds; bond_idx++)
+        {
+        group_storage<2> cur_bond = args.d_bonds[args.bond_pitch * bond_idx + idx];
+
+        Scalar4 neigh_postype = __ldg(args.d_pos + cur_bond.idx[0]);
+        Scalar3 dx = idx_pos - make_scalar3(neigh_postype.x, neigh_postype.y, neigh_postype.z);
+        dx = args.box.minImage(dx);
+
+        Scalar force_divr = Scalar(0.0);
+        Scalar bond_eng = Scalar(0.0);
+        EvaluatorBondHarmonic eval(dot(dx, dx), args.d_bond_params[cur_bond.idx[1]]);
+        eval.evalForceAndEnergy(force_divr, bond_eng);
+
+        // each bond is visited from both ends, which take half of the energy and virial
+        Scalar3 f = force_divr * dx;
+        force_idx.x += f.x;
+        force_idx.y += f.y;
+        force_idx.z += f.z;
+        force_idx.w += bond_eng * Scalar(0.5);
+        add_virial(virial, Scalar(0.5), dx, f);
+        }
+
+    // angles
+    unsigned int n_angles = args.d_n_angles ? args.d_n_angles[idx] : 0;
+    for (unsigned int angle_idx = 0; angle_idx < n_angles; angle_idx++)
+        {
+        group_storage<3> cur_angle = args.d_angles[args.angle_pitch * angle_idx + idx];
+        unsigned int cur_abc = args.d_angle_pos[args.angle_pitch * angle_idx + idx];
+
+        Scalar4 x_postype = __ldg(args.d_pos + cur_angle.idx[0]);
+        Scalar3 x_pos = make_scalar3(x_postype.x, x_postype.y, x_postype.z);
+        Scalar4 y_postype = __ldg(args.d_pos + cur_angle.idx[1]);
+        Scalar3 y_pos = make_scalar3(y_postype.x, y_postype.y, y_postype.z);
+
+        Scalar3 a_pos = cur_abc == 0 ? idx_pos : x_pos;
+        Scalar3 b_pos = cur_abc == 1 ? idx_pos : (cur_abc == 0 ? x_pos : y_pos);
+        Scalar3 c_pos = cur_abc == 2 ? idx_pos : y_pos;
+
+        Scalar3 dab = args.box.minImage(a_pos - b_pos);
+        Scalar3 dcb = args.box.minImage(c_pos - b_pos);
+
+        Scalar3 fab, fcb;
+        Scalar angle_eng = eval_harmonic_angle(dab,
+                                               dcb,
+                                               __ldg(args.d_angle_params + cur_angle.idx[2]),
+                                               fab,
+                                               fcb);
+
+        Scalar3 f = cur_abc == 0 ? fab : (cur_abc == 1 ? -(fab + fcb) : fcb);
+        force_idx.x += f.x;
+        force_idx.y += f.y;
+        force_idx.z += f.z;
+        force_idx.w += angle_eng * Scalar(1.0 / 3.0);
+        add_virial(virial, Scalar(1.0 / 3.0), dab, fab);
+        add_virial(virial, Scalar(1.0 / 3.0), dcb, fcb);
+        }
+
+    // dihedrals
+    unsigned int n_dihedrals = (dihedral_kind != fused_dihedral_kind::none && args.d_n_dihedrals)
+                                   ? args.d_n_dihedrals[idx]
+                                   : 0;
+    for (unsigned int dihedral_idx = 0; dihedral_idx < n_dihedrals; dihedral_idx++)
+        {
+        group_storage<4> cur_dihedral = args.d_dihedrals[args.dihedral_pitch * dihedral_idx + idx];
+        unsigned int cur_abcd = args.d_dihedral_pos[args.dihedral_pitch * dihedral_idx + idx];
+
+        Scalar4 x_postype = __ldg(args.d_pos + cur_dihedral.idx[0]);
+        Scalar3 x_pos = make_scalar3(x_postype.x, x_postype.y, x_postype.z);
+        Scalar4 y_postype = __ldg(args.d_pos + cur_dihedral.idx[1]);
+        Scalar3 y_pos = make_scalar3(y_postype.x, y_postype.y, y_postype.z);
+        Scalar4 z_postype = __ldg(args.d_pos + cur_dihedral.idx[2]);
+        Scalar3 z_pos = make_scalar3(z_postype.x, z_postype.y, z_postype.z);
+
+        Scalar3 pos_a = cur_abcd == 0 ? idx_pos : x_pos;
+        Scalar3 pos_b = cur_abcd == 1 ? idx_pos : (cur_abcd == 0 ? x_pos : y_pos);
+        Scalar3 pos_c = cur_abcd == 2 ? idx_pos : (cur_abcd == 3 ? z_pos : y_pos);
+        Scalar3 pos_d = cur_abcd == 3 ? idx_pos : z_pos;
+
+        Scalar3 dab = args.box.minImage(pos_a - pos_b);
+        Scalar3 dcb = args.box.minImage(pos_c - pos_b);
+        Scalar3 ddc = args.box.minImage(pos_d - pos_c);
+
+        Scalar3 fa, fb, fc, fd;
+        Scalar dihedral_eng
+            = eval_dihedral<dihedral_kind>(dab,
+                                           dcb,
+                                           ddc,
+                                           __ldg(args.d_dihedral_params + cur_dihedral.idx[3]),
+                                           fa,
+                                           fb,
+                                           fc,
+                                           fd);
+
+        Scalar3 f = cur_abcd == 0 ? fa : (cur_abcd == 1 ? fb : (cur_abcd == 2 ? fc : fd));
+        force_idx.x += f.x;
+        force_idx.y += f.y;
+        force_idx.z += f.z;
+        force_idx.w += dihedral_eng * Scalar(0.25);
+        add_virial(virial, Scalar(0.25), dab, fa);
+        add_virial(virial, Scalar(0.25), dcb, fc);
+        add_virial(virial, Scalar(0.25), ddc + dcb, fd);
+        }
+
+    // now that the force calculation is complete, write out the result
+    args.d_force[idx] = force_idx;
+    for (unsigned int i = 0; i < 6; i++)
+        args.d_virial[i * args.virial_pitch + idx] = virial[i];
+    }
+
+//! Launch the fused bonded kernel for one dihedral potential
+template<fused_dihedral_kind dihedral_kind>
+hipError_t launch_fused_bonded_forces(const fused_bonded_args_t& args, unsigned int block_size)
+    {
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr,
+                         (const void*)gpu_compute_fused_bonded_forces_kernel<dihedral_kind>);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    // setup the grid to run the kernel
+    dim3 grid(args.N / run_block_size + 1, 1, 1);
+    dim3 threads(run_block_size, 1, 1);
+
+    hipLaunchKernelGGL((gpu_compute_fused_bonded_forces_kernel<dihedral_kind>),
+                       dim3(grid),
+                       dim3(threads),
+                       0,
+                       0,
+                       args);
+
+    return hipSuccess;
+    }
+
+/*! \param args Kernel arguments
+    \param block_size Block size to use when performing calculations
+
+    \returns Any error code resulting from the kernel launch
+    \note Always returns hipSuccess in release builds to avoid the hipDeviceSynchronize()
+*/
+hipError_t gpu_compute_fused_bonded_forces(const fused_bonded_args_t& args,
+                                           unsigned int block_size)
+    {
+    assert(args.d_pos);
+
+    switch (args.dihedral_kind)
+        {
+    case fused_dihedral_kind::harmonic:
+        return launch_fused_bonded_forces<fused_dihedral_kind::harmonic>(args, block_size);
+    case fused_dihedral_kind::opls:
+        return launch_fused_bonded_forces<fused_dihedral_kind::opls>(args, block_size);
+    default:
+        return launch_fused_bonded_forces<fused_dihedral_kind::none>(args, block_size);
+        }
+    }
+
+//! Kernel for evaluating each bond, angle, and dihedral once on the GPU
+/*! \param args Kernel arguments
+
+    Each thread handles one group: the bonds come first, then the angles, then the dihedrals. The
+    thread evaluates the group once and adds the force on each local member with atomic operations.
+    The energy and virial of the group are split evenly among its members, as in
+    gpu_compute_fused_bonded_forces_kernel. The order of the additions is not deterministic.
+
+    \tparam dihedral_kind Torsion potential to evaluate
+*/
+template<fused_dihedral_kind dihedral_kind>
+__global__ void gpu_compute_fused_bonded_group_forces_kernel(const fused_bonded_group_args_t args)
+    {
+    unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (group_idx < args.n_bonds)
+        {
+        group_storage<2> cur_bond = args.d_bonds[group_idx];
+        unsigned int idx_a = args.d_rtag[cur_bond.tag[0]];
+        unsigned int idx_b = args.d_rtag[cur_bond.tag[1]];
+
+        Scalar4 postype_a = __ldg(args.d_pos + idx_a);
+        Scalar4 postype_b = __ldg(args.d_pos + idx_b);
+        Scalar3 dx = make_scalar3(postype_a.x, postype_a.y, postype_a.z)
+                     - make_scalar3(postype_b.x, postype_b.y, postype_b.z);
+        dx = args.box.minImage(dx);
+
+        Scalar force_divr = Scalar(0.0);
+        Scalar bond_eng = Scalar(0.0);
+        EvaluatorBondHarmonic eval(dot(dx, dx),
+                                   args.d_bond_params[args.d_bond_typeval[group_idx].type]);
+        eval.evalForceAndEnergy(force_divr, bond_eng);
+
+        Scalar3 f = force_divr * dx;
+        Scalar virial[6] = {0, 0, 0, 0, 0, 0};
+        add_virial(virial, Scalar(0.5), dx, f);
+
+        accumulate_member(args.d_force,
+                          args.d_virial,
+                          args.virial_pitch,
+                          args.N,
+                          idx_a,
+                          f,
+                          bond_eng * Scalar(0.5),
+                          virial);
+        accumulate_member(args.d_force,
+                          args.d_virial,
+                          args.virial_pitch,
+                          args.N,
+                          idx_b,
+                          -f,
+                          bond_eng * Scalar(0.5),
+                          virial);
+        return;
+        }
+    group_idx -= args.n_bonds;
+
+    if (group_idx < args.n_angles)
+        {
+        group_storage<3> cur_angle = args.d_angles[group_idx];
+        unsigned int idx[3];
+        Scalar3 pos[3];
+        for (unsigned int i = 0; i < 3; i++)
+            {
+            idx[i] = args.d_rtag[cur_angle.tag[i]];
+            Scalar4 postype = __ldg(args.d_pos + idx[i]);
+            pos[i] = make_scalar3(postype.x, postype.y, postype.z);
+            }
+
+        Scalar3 dab = args.box.minImage(pos[0] - pos[1]);
+        Scalar3 dcb = args.box.minImage(pos[2] - pos[1]);
+
+        Scalar3 fab, fcb;
+        Scalar angle_eng
+            = eval_harmonic_angle(dab,
+                                  dcb,
+                                  __ldg(args.d_angle_params + args.d_angle_typeval[group_idx].type),
+                                  fab,
+                                  fcb);
+
+        Scalar virial[6] = {0, 0, 0, 0, 0, 0};
+        add_virial(virial, Scalar(1.0 / 3.0), dab, fab);
+        add_virial(virial, Scalar(1.0 / 3.0), dcb, fcb);
+
+        Scalar3 f[3] = {fab, -(fab + fcb), fcb};
+        for (unsigned int i = 0; i < 3; i++)
+            accumulate_member(args.d_force,
+                              args.d_virial,
+                              args.virial_pitch,
+                              args.N,
+                              idx[i],
+                              f[i],
+                              angle_eng * Scalar(1.0 / 3.0),
+                              virial);
+        return;
+        }
+    group_idx -= args.n_angles;
+
+    if (dihedral_kind != fused_dihedral_kind::none && group_idx < args.n_dihedrals)
+        {
+        group_storage<4> cur_dihedral = args.d_dihedrals[group_idx];
+        unsigned int idx[4];
+        Scalar3 pos[4];
+        for (unsigned int i = 0; i < 4; i++)
+            {
+            idx[i] = args.d_rtag[cur_dihedral.tag[i]];
+            Scalar4 postype = __ldg(args.d_pos + idx[i]);
+            pos[i] = make_scalar3(postype.x, postype.y, postype.z);
+            }
+
+        Scalar3 dab = args.box.minImage(pos[0] - pos[1]);
+        Scalar3 dcb = args.box.minImage(pos[2] - pos[1]);
+        Scalar3 ddc = args.box.minImage(pos[3] - pos[2]);
+
+        Scalar3 f[4];
+        Scalar dihedral_eng = eval_dihedral<dihedral_kind>(
+            dab,
+            dcb,
+            ddc,
+            __ldg(args.d_dihedral_params + args.d_dihedral_typeval[group_idx].type),
+            f[0],
+            f[1],
+            f[2],
+            f[3]);
+
+        Scalar virial[6] = {0, 0, 0, 0, 0, 0};
+        add_virial(virial, Scalar(0.25), dab, f[0]);
+        add_virial(virial, Scalar(0.25), dcb, f[2]);
+        add_virial(virial, Scalar(0.25), ddc + dcb, f[3]);
+
+        for (unsigned int i = 0; i < 4; i++)
+            accumulate_member(args.d_force,
+                              args.d_virial,
+                              args.virial_pitch,
+                              args.N,
+                              idx[i],
+                              f[i],
+                              dihedral_eng * Scalar(0.25),
+                              virial);
+        }
+    }
+
+//! Launch the per-group fused bonded kernel for one dihedral potential
+template<fused_dihedral_kind dihedral_kind>
+hipError_t launch_fused_bonded_group_forces(const fused_bonded_group_args_t& args,
+                                            unsigned int block_size)
+    {
+    unsigned int n_groups = args.n_bonds + args.n_angles;
+    if (dihedral_kind != fused_dihedral_kind::none)
+        n_groups += args.n_dihedrals;
+    if (n_groups == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr,
+                         (const void*)gpu_compute_fused_bonded_group_forces_kernel<dihedral_kind>);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    // setup the grid to run the kernel
+    dim3 grid(n_groups / run_block_size + 1, 1, 1);
+    dim3 threads(run_block_size, 1, 1);
+
+    hipLaunchKernelGGL((gpu_compute_fused_bonded_group_forces_kernel<dihedral_kind>),
+                       dim3(grid),
+                       dim3(threads),
+                       0,
+                       0,
+                       args);
+
+    return hipSuccess;
+    }
+
+/*! \param args Kernel arguments
+    \param block_size Block size to use when performing calculations
+
+    \returns Any error code resulting from the kernel launch
+    \note Always returns hipSuccess in release builds to avoid the hipDeviceSynchronize()
+
+    The caller must zero the force and virial arrays before the call.
+*/
+hipError_t gpu_compute_fused_bonded_group_forces(const fused_bonded_group_args_t& args,
+                                                 unsigned int block_size)
+    {
+    assert(args.d_pos);
+    assert(args.d_rtag);
+
+    switch (args.dihedral_kind)
+        {
+    case fused_dihedral_kind::harmonic:
+        return launch_fused_bonded_group_forces<fused_dihedral_kind::harmonic>(args, block_size);
+    case fused_dihedral_kind::opls:
+        return launch_fused_bonded_group_forces<fused_dihedral_kind::opls>(args, block_size);
+    default:
+        return launch_fused_bonded_group_forces<fused_dihedral_kind::none>(args, block_size);
+        }
+    }
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,100 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "EvaluatorBondHarmonic.h"
+#include "hoomd/BondedGroupData.cuh"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/ParticleData.cuh"
+
+/*! \file FusedBondedForceGPU.cuh
+    \brief Declares GPU kernel code for evaluating bond, angle, and dihedral forces in one pass.
+   Used by FusedBondedForceComputeGPU.
+*/
+
+#ifndef __FUSEDBONDEDFORCEGPU_CUH__
+#define __FUSEDBONDEDFORCEGPU_CUH__
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Dihedral potentials the fused bonded kernel evaluates
+enum class fused_dihedral_kind
+    {
+    none,
+    harmonic,
+    opls
+    };
+
+//! Wraps arguments to gpu_compute_fused_bonded_forces
+/*! Each kind of bonded group is skipped when its per-particle count array is null.
+ */
+struct fused_bonded_args_t
+    {
+    Scalar4* d_force;     //!< Force to write out
+    Scalar* d_virial;     //!< Virial to write out
+    size_t virial_pitch;  //!< Pitch of 2D array of virial matrix elements
+    unsigned int N;       //!< Number of local particles
+    const Scalar4* d_pos; //!< Particle positions
+    BoxDim box;           //!< Simulation box
+
+    const group_storage<2>* d_bonds;      //!< Bond table
+    const unsigned int* d_n_bonds;        //!< Number of bonds per particle
+    unsigned int bond_pitch;              //!< Pitch of the bond table
+    const harmonic_params* d_bond_params; //!< Harmonic bond parameters per type
+    const group_storage<3>* d_angles;     //!< Angle table
+    const unsigned int* d_angle_pos;      //!< Position of each particle in its angles
+    const unsigned int* d_n_angles;       //!< Number of angles per particle
+    unsigned int angle_pitch;             //!< Pitch of the angle table
+    const Scalar2* d_angle_params;        //!< Harmonic angle parameters (K, t_0) per type
+    const group_storage<4>* d_dihedrals;  //!< Dihedral table
+    const unsigned int* d_dihedral_pos;   //!< Position of each particle in its dihedrals
+    const unsigned int* d_n_dihedrals;    //!< Number of dihedrals per particle
+    unsigned int dihedral_pitch;          //!< Pitch of the dihedral table
+    const Scalar4* d_dihedral_params;     //!< Dihedral parameters per type
+    fused_dihedral_kind dihedral_kind;    //!< Dihedral potential to evaluate
+    };
+
+//! Wraps arguments to gpu_compute_fused_bonded_group_forces
+/*! The group arrays hold member tags. Each kind of bonded group is skipped when it has no groups.
+ */
+struct fused_bonded_group_args_t
+    {
+    Scalar4* d_force;           //!< Force to write out
+    Scalar* d_virial;           //!< Virial to write out
+    size_t virial_pitch;        //!< Pitch of 2D array of virial matrix elements
+    unsigned int N;             //!< Number of local particles
+    const Scalar4* d_pos;       //!< Particle positions
+    const unsigned int* d_rtag; //!< Particle index of each tag
+    BoxDim box;                 //!< Simulation box
+
+    const group_storage<2>* d_bonds;         //!< Bond members
+    const typeval_union* d_bond_typeval;     //!< Bond types
+    unsigned int n_bonds;                    //!< Number of bonds
+    const harmonic_params* d_bond_params;    //!< Harmonic bond parameters per type
+    const group_storage<3>* d_angles;        //!< Angle members
+    const typeval_union* d_angle_typeval;    //!< Angle types
+    unsigned int n_angles;                   //!< Number of angles
+    const Scalar2* d_angle_params;           //!< Harmonic angle parameters (K, t_0) per type
+    const group_storage<4>* d_dihedrals;     //!< Dihedral members
+    const typeval_union* d_dihedral_typeval; //!< Dihedral types
+    unsigned int n_dihedrals;                //!< Number of dihedrals
+    const Scalar4* d_dihedral_params;        //!< Dihedral parameters per type
+    fused_dihedral_kind dihedral_kind;       //!< Dihedral potential to evaluate
+    };
+
+//! Kernel driver that computes bond, angle, and dihedral forces in one kernel
+hipError_t gpu_compute_fused_bonded_forces(const fused_bonded_args_t& args,
+                                           unsigned int block_size);
+
+//! Kernel driver that evaluates each bond, angle, and dihedral once
+hipError_t gpu_compute_fused_bonded_group_forces(const fused_bonded_group_args_t& args,
+                                                 unsigned int block_size);
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
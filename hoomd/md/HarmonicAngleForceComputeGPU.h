@@ -58,6 +58,12 @@ class PYBIND11_EXPORT HarmonicAngleForceComputeGPU : public HarmonicAngleForceCo
     //! Set the parameters
     virtual void setParams(unsigned int type, Scalar K, Scalar t_0);
 
+    //! Get the per-type parameters stored on the GPU
+    const GPUArray<Scalar2>& getParamArray() const
+        {
+        return m_params;
+        }
+
     protected:
     std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
     GPUArray<Scalar2> m_params;         //!< Parameters stored on the GPU
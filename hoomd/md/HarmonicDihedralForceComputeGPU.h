@@ -55,6 +55,12 @@ class PYBIND11_EXPORT HarmonicDihedralForceComputeGPU : public HarmonicDihedralF
     virtual void
     setParams(unsigned int type, Scalar K, Scalar sign, int multiplicity, Scalar phi_0);
 
+    //! Get the per-type parameters stored on the GPU
+    const GPUArray<Scalar4>& getParamArray() const
+        {
+        return m_params;
+        }
+
     protected:
     std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
     GPUArray<Scalar4> m_params;         //!< Parameters stored on the GPU (k,sign,m)
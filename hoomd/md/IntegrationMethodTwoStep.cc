@@ -38,8 +38,52 @@ IntegrationMethodTwoStep::IntegrationMethodTwoStep(std::shared_ptr<SystemDefinit
     assert(m_group);
 
     m_integrator_id = m_sysdef->getIntegratorData()->registerIntegrator();
+
+#ifdef ENABLE_MPI
+    m_broadcast_pending = false;
+#endif
+    }
+
+IntegrationMethodTwoStep::~IntegrationMethodTwoStep()
+    {
+#ifdef ENABLE_MPI
+    // the receive buffer must outlive the request
+    if (m_broadcast_pending)
+        MPI_Wait(&m_broadcast_request, MPI_STATUS_IGNORE);
+#endif
     }
 
+#ifdef ENABLE_MPI
+/*! Every rank computes the thermostat and barostat variables from the same globally reduced
+    quantities, so the broadcast only keeps them bitwise identical. It is started with MPI_Ibcast
+    and completed the next time the variables are accessed, which lets it overlap with the force
+    computation between the two integration steps.
+
+    All ranks must call this method at the same point.
+*/
+void IntegrationMethodTwoStep::startBroadcastIntegratorVariables()
+    {
+    m_broadcast_variables = getIntegratorVariables();
+    MPI_Ibcast(&m_broadcast_variables.variable.front(),
+               (int)m_broadcast_variables.variable.size(),
+               MPI_HOOMD_SCALAR,
+               0,
+               m_exec_conf->getMPICommunicator(),
+               &m_broadcast_request);
+    m_broadcast_pending = true;
+    }
+
+void IntegrationMethodTwoStep::finishBroadcastIntegratorVariables()
+    {
+    if (!m_broadcast_pending)
+        return;
+
+    MPI_Wait(&m_broadcast_request, MPI_STATUS_IGNORE);
+    m_broadcast_pending = false;
+    m_sysdef->getIntegratorData()->setIntegratorVariables(m_integrator_id, m_broadcast_variables);
+    }
+#endif
+
 /*! It is useful for the user to know where computation time is spent, so all integration methods
     should profile themselves. This method sets the profiler for them to use.
     This method does not need to be called, as Computes will not profile themselves
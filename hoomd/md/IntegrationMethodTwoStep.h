@@ -108,7 +108,7 @@ class PYBIND11_EXPORT IntegrationMethodTwoStep
     //! Constructs the integration method and associates it with the system
     IntegrationMethodTwoStep(std::shared_ptr<SystemDefinition> sysdef,
                              std::shared_ptr<ParticleGroup> group);
-    virtual ~IntegrationMethodTwoStep() { }
+    virtual ~IntegrationMethodTwoStep();
 
     //! Abstract method that performs the first step of the integration
     /*! \param timestep Current time step
@@ -211,15 +211,29 @@ class PYBIND11_EXPORT IntegrationMethodTwoStep
     //! helper function to get the integrator variables from the particle data
     const IntegratorVariables& getIntegratorVariables()
         {
+#ifdef ENABLE_MPI
+        finishBroadcastIntegratorVariables();
+#endif
         return m_sysdef->getIntegratorData()->getIntegratorVariables(m_integrator_id);
         }
 
     //! helper function to store the integrator variables in the particle data
     void setIntegratorVariables(const IntegratorVariables& variables)
         {
+#ifdef ENABLE_MPI
+        finishBroadcastIntegratorVariables();
+#endif
         m_sysdef->getIntegratorData()->setIntegratorVariables(m_integrator_id, variables);
         }
 
+#ifdef ENABLE_MPI
+    //! Start broadcasting the integrator variables from rank 0 to the other ranks
+    void startBroadcastIntegratorVariables();
+
+    //! Wait for a pending broadcast of the integrator variables and store the result
+    void finishBroadcastIntegratorVariables();
+#endif
+
     //! helper function to check if the restart information (if applicable) is usable
     bool
     restartInfoTestValid(const IntegratorVariables& v, std::string type, unsigned int nvariables);
@@ -233,6 +247,12 @@ class PYBIND11_EXPORT IntegrationMethodTwoStep
     private:
     unsigned int m_integrator_id; //!< Registered integrator id to access the state variables
     bool m_valid_restart;         //!< True if the restart info was valid when loading
+
+#ifdef ENABLE_MPI
+    IntegratorVariables m_broadcast_variables; //!< Receive buffer of the pending broadcast
+    MPI_Request m_broadcast_request;           //!< Request of the pending broadcast
+    bool m_broadcast_pending;                  //!< True if a broadcast has not completed
+#endif
     };
 
 namespace detail
@@ -7,6 +7,10 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_HIP
+#include "IntegratorTwoStepGPU.cuh"
+#endif
+
 #include <pybind11/stl_bind.h>
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<hoomd::md::IntegrationMethodTwoStep>>);
 
@@ -17,10 +21,18 @@ namespace hoomd
 namespace md
     {
 IntegratorTwoStep::IntegratorTwoStep(std::shared_ptr<SystemDefinition> sysdef, Scalar deltaT)
-    : Integrator(sysdef, deltaT), m_prepared(false), m_gave_warning(false)
+    : Integrator(sysdef, deltaT), m_prepared(false), m_gave_warning(false), m_deltaT_max(deltaT)
     {
     m_exec_conf->msg->notice(5) << "Constructing IntegratorTwoStep" << endl;
 
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        GPUArray<Scalar2> max_vsq_asq(1, m_exec_conf);
+        m_max_vsq_asq.swap(max_vsq_asq);
+        }
+#endif
+
 #ifdef ENABLE_MPI
     if (m_sysdef->isDomainDecomposed())
         {
@@ -98,7 +110,8 @@ void IntegratorTwoStep::update(uint64_t timestep)
         // step
 
         // also updates rigid bodies after ghost updating
-        m_comm->communicate(timestep + 1);
+        // computeNetForce() completes a ghost update left pending for overlap with the forces
+        m_comm->communicate(timestep + 1, m_overlap_ghost_update);
         }
     else
 #endif
@@ -106,6 +119,9 @@ void IntegratorTwoStep::update(uint64_t timestep)
         updateRigidBodies(timestep + 1);
         }
 
+    // the particles have moved
+    m_pdata->notifyPositionsChanged();
+
     // compute the net force on all particles
 #ifdef ENABLE_HIP
     if (m_exec_conf->isCUDAEnabled())
@@ -115,10 +131,7 @@ void IntegratorTwoStep::update(uint64_t timestep)
         computeNetForce(timestep + 1);
 
     // Call HalfStep hook
-    if (m_half_step_hook)
-        {
-        m_half_step_hook->update(timestep + 1);
-        }
+    callHalfStepHook(timestep + 1);
 
     if (m_prof)
         m_prof->push("Integrate");
@@ -141,6 +154,9 @@ void IntegratorTwoStep::update(uint64_t timestep)
 
     if (m_prof)
         m_prof->pop();
+
+    if (m_adaptive_dt)
+        updateAdaptiveDeltaT();
     }
 
 /*! \param deltaT new deltaT to set
@@ -311,9 +327,179 @@ void IntegratorTwoStep::prepRun(uint64_t timestep)
     for (auto& method : m_methods)
         method->includeRATTLEForce(timestep);
 
+    if (m_adaptive_dt)
+        updateAdaptiveDeltaT();
+
     m_prepared = true;
     }
 
+/*! The displacement of a particle in the next step is v deltaT + a deltaT^2 / 2. Bounding it with
+    the largest speed and acceleration of all particles (not necessarily the same particle), the
+    new deltaT is the largest that keeps the bound below m_max_displacement. It is limited to
+    m_finc times the current deltaT, so it recovers gradually after a violent event, and clamped
+    to [m_deltaT_min, m_deltaT_max].
+
+    setDeltaT() passes the new time step to the integration methods and rigid bodies. Thermostat
+    and barostat variables are rates integrated with the deltaT of each step, so they need no
+    rescaling.
+*/
+void IntegratorTwoStep::updateAdaptiveDeltaT()
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "Adaptive dt");
+
+    const unsigned int N = m_pdata->getN();
+    Scalar2 max_vsq_asq = make_scalar2(Scalar(0.0), Scalar(0.0));
+
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        const unsigned int block_size = 256;
+        unsigned int num_blocks = N / block_size + 1;
+        if (m_partial_max_vsq_asq.getNumElements() < num_blocks)
+            {
+            GPUArray<Scalar2> partial_max_vsq_asq(num_blocks, m_exec_conf);
+            m_partial_max_vsq_asq.swap(partial_max_vsq_asq);
+            }
+
+            {
+            ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                                       access_location::device,
+                                       access_mode::read);
+            ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
+                                         access_location::device,
+                                         access_mode::read);
+            ArrayHandle<Scalar2> d_partial_max(m_partial_max_vsq_asq,
+                                               access_location::device,
+                                               access_mode::overwrite);
+            ArrayHandle<Scalar2> d_max(m_max_vsq_asq,
+                                       access_location::device,
+                                       access_mode::overwrite);
+
+            kernel::gpu_integrator_max_vsq_asq(N,
+                                               d_vel.data,
+                                               d_accel.data,
+                                               d_max.data,
+                                               d_partial_max.data,
+                                               block_size,
+                                               num_blocks);
+
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+
+        ArrayHandle<Scalar2> h_max(m_max_vsq_asq, access_location::host, access_mode::read);
+        max_vsq_asq = h_max.data[0];
+        }
+    else
+#endif
+        {
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(),
+                                     access_location::host,
+                                     access_mode::read);
+
+        for (unsigned int i = 0; i < N; i++)
+            {
+            Scalar4 v = h_vel.data[i];
+            Scalar3 a = h_accel.data[i];
+            max_vsq_asq.x = std::max(max_vsq_asq.x, v.x * v.x + v.y * v.y + v.z * v.z);
+            max_vsq_asq.y = std::max(max_vsq_asq.y, a.x * a.x + a.y * a.y + a.z * a.z);
+            }
+        }
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &max_vsq_asq.x,
+                      2,
+                      MPI_HOOMD_SCALAR,
+                      MPI_MAX,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    // solve v dt + a dt^2 / 2 = max_displacement in a form that is stable when a is small
+    Scalar v = slow::sqrt(max_vsq_asq.x);
+    Scalar a = slow::sqrt(max_vsq_asq.y);
+    Scalar deltaT = std::min(m_deltaT_max, m_deltaT * m_finc);
+    Scalar denominator = v + slow::sqrt(v * v + Scalar(2.0) * a * m_max_displacement);
+    if (denominator > Scalar(0.0))
+        deltaT = std::min(deltaT, Scalar(2.0) * m_max_displacement / denominator);
+    deltaT = std::max(deltaT, m_deltaT_min);
+
+    if (deltaT != m_deltaT)
+        setDeltaT(deltaT);
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+pybind11::object IntegratorTwoStep::getMaxDisplacement()
+    {
+    pybind11::object result;
+    if (m_adaptive_dt)
+        {
+        result = pybind11::cast(m_max_displacement);
+        }
+    else
+        {
+        result = pybind11::none();
+        }
+    return result;
+    }
+
+/*! \param max_displacement Largest displacement of any particle in one step, or None to keep
+    deltaT fixed
+*/
+void IntegratorTwoStep::setMaxDisplacement(pybind11::object max_displacement)
+    {
+    if (max_displacement.is_none())
+        {
+        m_adaptive_dt = false;
+        }
+    else
+        {
+        Scalar value = pybind11::cast<Scalar>(max_displacement);
+        if (!(value > Scalar(0.0)))
+            {
+            throw std::invalid_argument("max_displacement must be positive.");
+            }
+        m_adaptive_dt = true;
+        m_max_displacement = value;
+        }
+    }
+
+void IntegratorTwoStep::setDeltaTMin(Scalar deltaT_min)
+    {
+    if (!(deltaT_min >= Scalar(0.0)))
+        {
+        throw std::invalid_argument("dt_min must be non-negative.");
+        }
+    m_deltaT_min = deltaT_min;
+    }
+
+void IntegratorTwoStep::setDeltaTMax(Scalar deltaT_max)
+    {
+    if (!(deltaT_max > Scalar(0.0)))
+        {
+        throw std::invalid_argument("dt_max must be positive.");
+        }
+    m_deltaT_max = deltaT_max;
+    }
+
+void IntegratorTwoStep::setFinc(Scalar finc)
+    {
+    if (!(finc >= Scalar(1.0)))
+        {
+        throw std::invalid_argument("finc_dt must be greater than or equal to 1.");
+        }
+    m_finc = finc;
+    }
+
 /*! Return the combined flags of all integration methods.
  */
 PDataFlags IntegratorTwoStep::getRequestedPDataFlags()
@@ -423,7 +609,13 @@ void export_IntegratorTwoStep(pybind11::module& m)
         .def_property("rigid", &IntegratorTwoStep::getRigid, &IntegratorTwoStep::setRigid)
         .def_property("integrate_rotational_dof",
                       &IntegratorTwoStep::getIntegrateRotationalDOF,
-                      &IntegratorTwoStep::setIntegrateRotationalDOF);
+                      &IntegratorTwoStep::setIntegrateRotationalDOF)
+        .def_property("max_displacement",
+                      &IntegratorTwoStep::getMaxDisplacement,
+                      &IntegratorTwoStep::setMaxDisplacement)
+        .def_property("dt_min", &IntegratorTwoStep::getDeltaTMin, &IntegratorTwoStep::setDeltaTMin)
+        .def_property("dt_max", &IntegratorTwoStep::getDeltaTMax, &IntegratorTwoStep::setDeltaTMax)
+        .def_property("finc_dt", &IntegratorTwoStep::getFinc, &IntegratorTwoStep::setFinc);
     }
 
     } // end namespace detail
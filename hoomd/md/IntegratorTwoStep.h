@@ -25,6 +25,8 @@ namespace md
     Notable design elements:
     - setDeltaT results in deltaT being set on all current integration methods
     - to interface with the python script, the m_methods vectors is exposed with a list like API.
+    - when a maximum displacement is set, deltaT adapts after every step (see
+      updateAdaptiveDeltaT())
 
    TODO: ensure that the user does not make a mistake and specify more than one method operating on
    a single particle
@@ -113,10 +115,46 @@ class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
         m_rigid_bodies = new_rigid;
         }
 
+    /// Get the maximum displacement per step of the adaptive time step (None when disabled)
+    pybind11::object getMaxDisplacement();
+
+    /// Set the maximum displacement per step of the adaptive time step (None to disable)
+    void setMaxDisplacement(pybind11::object max_displacement);
+
+    /// Get the smallest adaptive time step
+    Scalar getDeltaTMin()
+        {
+        return m_deltaT_min;
+        }
+
+    /// Set the smallest adaptive time step
+    void setDeltaTMin(Scalar deltaT_min);
+
+    /// Get the largest adaptive time step
+    Scalar getDeltaTMax()
+        {
+        return m_deltaT_max;
+        }
+
+    /// Set the largest adaptive time step
+    void setDeltaTMax(Scalar deltaT_max);
+
+    /// Get the largest fractional increase of the adaptive time step per step
+    Scalar getFinc()
+        {
+        return m_finc;
+        }
+
+    /// Set the largest fractional increase of the adaptive time step per step
+    void setFinc(Scalar finc);
+
     protected:
     /// Helper method to test if all added methods have valid restart information
     bool isValidRestart();
 
+    /// Choose the time step of the next step from the maximum displacement
+    void updateAdaptiveDeltaT();
+
     std::vector<std::shared_ptr<IntegrationMethodTwoStep>>
         m_methods; //!< List of all the integration methods
 
@@ -127,6 +165,17 @@ class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
 
     /// True when orientation degrees of freedom should be integrated
     bool m_integrate_rotational_dof = false;
+
+    bool m_adaptive_dt = false;    //!< True when deltaT adapts to the maximum displacement
+    Scalar m_max_displacement = 0; //!< Target largest displacement per step
+    Scalar m_deltaT_min = 0;       //!< Smallest adaptive time step
+    Scalar m_deltaT_max;           //!< Largest adaptive time step
+    Scalar m_finc = Scalar(1.1);   //!< Largest fractional increase of deltaT per step
+
+#ifdef ENABLE_HIP
+    GPUArray<Scalar2> m_partial_max_vsq_asq; //!< Per block maxima of the squared vel and accel
+    GPUArray<Scalar2> m_max_vsq_asq;         //!< Maxima of the squared vel and accel
+#endif
     };
 
 namespace detail
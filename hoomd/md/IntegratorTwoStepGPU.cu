@@ -0,0 +1,164 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "IntegratorTwoStepGPU.cuh"
+
+#include <assert.h>
+
+/*! \file IntegratorTwoStepGPU.cu
+    \brief Defines GPU kernel code for the adaptive time step of IntegratorTwoStep
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Kernel function for reducing the squared velocities and accelerations to partial maxima
+/*! \param N Number of particles
+    \param d_vel Particle velocities
+    \param d_accel Particle accelerations
+    \param d_partial_max Placeholder for the partial maxima (x: vsq, y: asq)
+*/
+__global__ void gpu_integrator_max_vsq_asq_partial_kernel(const unsigned int N,
+                                                          const Scalar4* d_vel,
+                                                          const Scalar3* d_accel,
+                                                          Scalar2* d_partial_max)
+    {
+    extern __shared__ Scalar2 integrator_sdata[];
+
+    // determine which particle this thread works on
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    Scalar2 vsq_asq = make_scalar2(Scalar(0.0), Scalar(0.0));
+
+    if (idx < N)
+        {
+        Scalar4 vel = d_vel[idx];
+        Scalar3 accel = d_accel[idx];
+        vsq_asq.x = vel.x * vel.x + vel.y * vel.y + vel.z * vel.z;
+        vsq_asq.y = accel.x * accel.x + accel.y * accel.y + accel.z * accel.z;
+        }
+
+    integrator_sdata[threadIdx.x] = vsq_asq;
+    __syncthreads();
+
+    // reduce the maximum in parallel
+    int offs = blockDim.x >> 1;
+    while (offs > 0)
+        {
+        if (threadIdx.x < offs)
+            {
+            integrator_sdata[threadIdx.x].x
+                = max(integrator_sdata[threadIdx.x].x, integrator_sdata[threadIdx.x + offs].x);
+            integrator_sdata[threadIdx.x].y
+                = max(integrator_sdata[threadIdx.x].y, integrator_sdata[threadIdx.x + offs].y);
+            }
+        offs >>= 1;
+        __syncthreads();
+        }
+
+    // write out our partial maximum
+    if (threadIdx.x == 0)
+        {
+        d_partial_max[blockIdx.x] = integrator_sdata[0];
+        }
+    }
+
+//! Kernel function for reducing the partial maxima to the full maximum
+/*! \param d_max Placeholder for the maximum
+    \param d_partial_max Array containing the partial maxima
+    \param num_blocks Number of partial maxima
+*/
+__global__ void gpu_integrator_reduce_partial_max_kernel(Scalar2* d_max,
+                                                         const Scalar2* d_partial_max,
+                                                         unsigned int num_blocks)
+    {
+    extern __shared__ Scalar2 integrator_sdata[];
+
+    Scalar2 result = make_scalar2(Scalar(0.0), Scalar(0.0));
+
+    // reduce the values in the partial maxima via a sliding window
+    for (int start = 0; start < num_blocks; start += blockDim.x)
+        {
+        __syncthreads();
+        if (start + threadIdx.x < num_blocks)
+            integrator_sdata[threadIdx.x] = d_partial_max[start + threadIdx.x];
+        else
+            integrator_sdata[threadIdx.x] = make_scalar2(Scalar(0.0), Scalar(0.0));
+        __syncthreads();
+
+        // reduce the maximum in parallel
+        int offs = blockDim.x >> 1;
+        while (offs > 0)
+            {
+            if (threadIdx.x < offs)
+                {
+                integrator_sdata[threadIdx.x].x
+                    = max(integrator_sdata[threadIdx.x].x, integrator_sdata[threadIdx.x + offs].x);
+                integrator_sdata[threadIdx.x].y
+                    = max(integrator_sdata[threadIdx.x].y, integrator_sdata[threadIdx.x + offs].y);
+                }
+            offs >>= 1;
+            __syncthreads();
+            }
+
+        result.x = max(result.x, integrator_sdata[0].x);
+        result.y = max(result.y, integrator_sdata[0].y);
+        }
+
+    if (threadIdx.x == 0)
+        *d_max = result;
+    }
+
+/*! \param N Number of particles
+    \param d_vel Particle velocities
+    \param d_accel Particle accelerations
+    \param d_max Placeholder for the maxima of the squared velocity (x) and acceleration (y)
+    \param d_partial_max Array of \a num_blocks partial maxima
+    \param block_size The size of one block, a power of two
+    \param num_blocks Number of blocks to execute
+
+    This is a driver for gpu_integrator_max_vsq_asq_partial_kernel() and
+    gpu_integrator_reduce_partial_max_kernel(), see them for details.
+*/
+hipError_t gpu_integrator_max_vsq_asq(const unsigned int N,
+                                      const Scalar4* d_vel,
+                                      const Scalar3* d_accel,
+                                      Scalar2* d_max,
+                                      Scalar2* d_partial_max,
+                                      unsigned int block_size,
+                                      unsigned int num_blocks)
+    {
+    assert(d_vel);
+    assert(d_accel);
+    assert(d_max);
+    assert(d_partial_max);
+
+    hipLaunchKernelGGL((gpu_integrator_max_vsq_asq_partial_kernel),
+                       dim3(num_blocks),
+                       dim3(block_size),
+                       block_size * sizeof(Scalar2),
+                       0,
+                       N,
+                       d_vel,
+                       d_accel,
+                       d_partial_max);
+
+    hipLaunchKernelGGL((gpu_integrator_reduce_partial_max_kernel),
+                       dim3(1),
+                       dim3(block_size),
+                       block_size * sizeof(Scalar2),
+                       0,
+                       d_max,
+                       d_partial_max,
+                       num_blocks);
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,32 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/HOOMDMath.h"
+
+#ifndef __INTEGRATOR_TWO_STEP_GPU_CUH__
+#define __INTEGRATOR_TWO_STEP_GPU_CUH__
+
+/*! \file IntegratorTwoStepGPU.cuh
+    \brief Declares GPU kernel drivers used by IntegratorTwoStep
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Kernel driver for the maximum squared velocity and acceleration called by IntegratorTwoStep
+hipError_t gpu_integrator_max_vsq_asq(const unsigned int N,
+                                      const Scalar4* d_vel,
+                                      const Scalar3* d_accel,
+                                      Scalar2* d_max,
+                                      Scalar2* d_partial_max,
+                                      unsigned int block_size,
+                                      unsigned int num_blocks);
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __INTEGRATOR_TWO_STEP_GPU_CUH__
@@ -0,0 +1,303 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file MLPotential.cc
+    \brief Contains code for the MLPotential class
+*/
+
+#include "MLPotential.h"
+
+#ifdef ENABLE_TORCH
+
+#include "NeighborListCompression.h"
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System to compute forces on
+    \param nlist Neighbor list to build the graph from
+    \param filename TorchScript file to load the model from
+    \param r_cut Cutoff radius of the graph
+*/
+MLPotential::MLPotential(std::shared_ptr<SystemDefinition> sysdef,
+                         std::shared_ptr<NeighborList> nlist,
+                         const std::string& filename,
+                         Scalar r_cut)
+    : ForceCompute(sysdef), m_nlist(nlist), m_filename(filename), m_r_cut(r_cut),
+      m_device(torch::kCPU), m_type(m_exec_conf), m_edge_index(m_exec_conf),
+      m_edge_vec(m_exec_conf), m_n_edges(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing MLPotential" << endl;
+
+    if (!(r_cut > Scalar(0.0)))
+        throw std::invalid_argument("r_cut must be positive.");
+
+    try
+        {
+        m_model = torch::jit::load(filename, m_device);
+        }
+    catch (const c10::Error& e)
+        {
+        m_exec_conf->msg->error() << "Cannot load the TorchScript model " << filename << ": "
+                                  << e.what() << endl;
+        throw std::runtime_error("Error initializing MLPotential");
+        }
+    m_model.eval();
+
+    TAG_ALLOCATION(m_type);
+    TAG_ALLOCATION(m_edge_index);
+    TAG_ALLOCATION(m_edge_vec);
+
+    // request neighbors up to r_cut between all types from the neighbor list
+    unsigned int n_types = m_pdata->getNTypes();
+    m_r_cut_nlist = std::make_shared<GlobalArray<Scalar>>(n_types * n_types, m_exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut_nlist(*m_r_cut_nlist,
+                                          access_location::host,
+                                          access_mode::overwrite);
+        for (unsigned int i = 0; i < n_types * n_types; i++)
+            h_r_cut_nlist.data[i] = m_r_cut;
+        }
+    m_nlist->addRCutMatrix(m_r_cut_nlist);
+    }
+
+MLPotential::~MLPotential()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying MLPotential" << endl;
+
+    if (m_attached)
+        {
+        m_nlist->removeRCutMatrix(m_r_cut_nlist);
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void MLPotential::computeForces(uint64_t timestep)
+    {
+    m_nlist->compute(timestep);
+
+    if (m_prof)
+        m_prof->push(m_exec_conf, "ML potential");
+
+    // the gradient of an edge only reaches the force on j in a full neighbor list
+    if (m_nlist->getStorageMode() == NeighborList::half)
+        {
+        m_exec_conf->msg->error() << "MLPotential cannot handle a half neighborlist" << endl;
+        throw std::runtime_error("Error computing forces in MLPotential");
+        }
+
+    buildGraph();
+    evaluateModel();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+void MLPotential::buildGraph()
+    {
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_all = N + m_pdata->getNGhosts();
+    const BoxDim box = m_pdata->getBox();
+    const bool compress = m_nlist->getCompress();
+    const Scalar r_cut_sq = m_r_cut * m_r_cut;
+
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getCompressedNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<unsigned int> h_n_outliers(m_nlist->getNOutliersArray(),
+                                           access_location::host,
+                                           access_mode::read);
+    ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
+                                    access_location::host,
+                                    access_mode::read);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+
+    // count the edges within r_cut, the neighbor list includes the buffer
+    unsigned int n_edges = 0;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        const unsigned int* nlist_i = h_nlist.data + h_head_list.data[i];
+        const unsigned int size = h_n_neigh.data[i];
+        const unsigned int n_outliers = compress ? h_n_outliers.data[i] : size;
+
+        for (unsigned int k = 0; k < size; k++)
+            {
+            unsigned int j = detail::nlist_get_neighbor(nlist_i, i, n_outliers, k);
+            Scalar3 dx = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z) - pi;
+            dx = box.minImage(dx);
+            if (dot(dx, dx) < r_cut_sq)
+                n_edges++;
+            }
+        }
+
+    m_type.resize(n_all);
+    m_edge_index.resize(2 * n_edges);
+    m_edge_vec.resize(3 * n_edges);
+    m_n_edges = n_edges;
+
+    ArrayHandle<int64_t> h_type(m_type, access_location::host, access_mode::overwrite);
+    ArrayHandle<int64_t> h_edge_index(m_edge_index, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_edge_vec(m_edge_vec, access_location::host, access_mode::overwrite);
+
+    for (unsigned int i = 0; i < n_all; i++)
+        h_type.data[i] = __scalar_as_int(h_pos.data[i].w);
+
+    unsigned int e = 0;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        const unsigned int* nlist_i = h_nlist.data + h_head_list.data[i];
+        const unsigned int size = h_n_neigh.data[i];
+        const unsigned int n_outliers = compress ? h_n_outliers.data[i] : size;
+
+        for (unsigned int k = 0; k < size; k++)
+            {
+            unsigned int j = detail::nlist_get_neighbor(nlist_i, i, n_outliers, k);
+            Scalar3 dx = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z) - pi;
+            dx = box.minImage(dx);
+            if (dot(dx, dx) >= r_cut_sq)
+                continue;
+
+            h_edge_index.data[e] = i;
+            h_edge_index.data[n_edges + e] = j;
+            h_edge_vec.data[3 * e] = dx.x;
+            h_edge_vec.data[3 * e + 1] = dx.y;
+            h_edge_vec.data[3 * e + 2] = dx.z;
+            e++;
+            }
+        }
+    }
+
+/*! The graph, the forces, and the virials are accessed where m_device resides and wrapped in
+    tensors without copies.
+*/
+void MLPotential::evaluateModel()
+    {
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_all = N + m_pdata->getNGhosts();
+    const int64_t n_edges = m_n_edges;
+    const access_location::Enum location
+        = m_device.is_cuda() ? access_location::device : access_location::host;
+    const auto scalar_type = sizeof(Scalar) == sizeof(double) ? torch::kFloat64 : torch::kFloat32;
+    const auto scalar_options = torch::TensorOptions().dtype(scalar_type).device(m_device);
+    const auto index_options = torch::TensorOptions().dtype(torch::kInt64).device(m_device);
+
+    PDataFlags flags = m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor];
+
+    ArrayHandle<int64_t> d_type(m_type, location, access_mode::read);
+    ArrayHandle<int64_t> d_edge_index(m_edge_index, location, access_mode::read);
+    ArrayHandle<Scalar> d_edge_vec(m_edge_vec, location, access_mode::read);
+    ArrayHandle<Scalar4> d_force(m_force, location, access_mode::overwrite);
+    ArrayHandle<Scalar> d_virial(m_virial, location, access_mode::overwrite);
+
+    torch::Tensor types = torch::from_blob(d_type.data, {n_all}, index_options);
+    torch::Tensor edge_index = torch::from_blob(d_edge_index.data, {2, n_edges}, index_options);
+    torch::Tensor edge_vec = torch::from_blob(d_edge_vec.data, {n_edges, 3}, scalar_options)
+                                 .detach()
+                                 .requires_grad_(true);
+
+    torch::Tensor energies
+        = m_model.forward({types, edge_index, edge_vec}).toTensor().to(scalar_type).flatten();
+    if (energies.size(0) != n_all && energies.size(0) != N)
+        {
+        m_exec_conf->msg->error() << "The model returned " << energies.size(0)
+                                  << " energies, expected " << N << " or " << n_all << endl;
+        throw std::runtime_error("Error computing forces in MLPotential");
+        }
+    energies = energies.slice(0, 0, N);
+
+    torch::Tensor force = torch::zeros({n_all, 3}, scalar_options);
+    torch::Tensor virial;
+    if (n_edges > 0)
+        {
+        // an edge without a path to the energy has no gradient
+        torch::Tensor grad = torch::autograd::grad({energies.sum()},
+                                                   {edge_vec},
+                                                   /*grad_outputs=*/ {},
+                                                   /*retain_graph=*/false,
+                                                   /*create_graph=*/false,
+                                                   /*allow_unused=*/true)[0];
+        if (grad.defined())
+            {
+            grad = grad.detach();
+            force.index_add_(0, edge_index[0], grad);
+            force.index_add_(0, edge_index[1], -grad);
+
+            if (compute_virial)
+                {
+                torch::Tensor r = edge_vec.detach();
+                torch::Tensor w = torch::stack({r.select(1, 0) * grad.select(1, 0),
+                                                r.select(1, 0) * grad.select(1, 1),
+                                                r.select(1, 0) * grad.select(1, 2),
+                                                r.select(1, 1) * grad.select(1, 1),
+                                                r.select(1, 1) * grad.select(1, 2),
+                                                r.select(1, 2) * grad.select(1, 2)},
+                                               1);
+                virial = torch::zeros({n_all, 6}, scalar_options);
+                virial.index_add_(0, edge_index[0], -w);
+                }
+            }
+        }
+
+    // write the results in place, forces on ghosts are reverse communicated
+    torch::Tensor force_out = torch::from_blob(d_force.data, {n_all, 4}, scalar_options);
+    force_out.zero_();
+    force_out.slice(1, 0, 3).copy_(force);
+    force_out.slice(0, 0, N).select(1, 3).copy_(energies.detach());
+
+    torch::Tensor virial_out = torch::from_blob(d_virial.data,
+                                                {6, (int64_t)m_virial_pitch},
+                                                scalar_options);
+    virial_out.zero_();
+    if (virial.defined())
+        virial_out.slice(1, 0, n_all).copy_(virial.t());
+    }
+
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+ */
+CommFlags MLPotential::getRequestedCommFlags(uint64_t timestep)
+    {
+    CommFlags flags = CommFlags(0);
+
+    flags |= ForceCompute::getRequestedCommFlags(timestep);
+
+    // enable reverse communication of forces
+    flags[comm_flag::reverse_net_force] = 1;
+
+    // reverse net force requires tags
+    flags[comm_flag::tag] = 1;
+
+    return flags;
+    }
+#endif
+
+namespace detail
+    {
+void export_MLPotential(pybind11::module& m)
+    {
+    pybind11::class_<MLPotential, ForceCompute, std::shared_ptr<MLPotential>>(m, "MLPotential")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<NeighborList>,
+                            const std::string&,
+                            Scalar>())
+        .def_property_readonly("r_cut", &MLPotential::getRCut)
+        .def_property_readonly("filename", &MLPotential::getFilename);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // ENABLE_TORCH
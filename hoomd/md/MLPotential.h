@@ -0,0 +1,134 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __ML_POTENTIAL_H__
+#define __ML_POTENTIAL_H__
+
+#ifdef ENABLE_TORCH
+
+#include "NeighborList.h"
+#include "hoomd/ForceCompute.h"
+#include "hoomd/GlobalArray.h"
+
+#include <torch/script.h>
+
+#include <memory>
+#include <string>
+
+/*! \file MLPotential.h
+    \brief Declares a force compute that evaluates a TorchScript model
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Computes forces with a machine-learned potential given as a TorchScript model
+/*! MLPotential hands the model the local particle graph: the type of every local and ghost
+    particle, and one directed edge i -> j for each local particle i and each neighbor j closer
+    than r_cut. The model is called as
+
+        energies = model(types, edge_index, edge_vec)
+
+    with types an int64 tensor of shape (N + N_ghost,), edge_index an int64 tensor of shape (2, E)
+    holding the source i and destination j of each edge, and edge_vec a tensor of shape (E, 3)
+    holding r_j - r_i (minimum image) in the precision of Scalar. The model returns the energy of
+    each particle, shape (N + N_ghost,) or (N,). The energies of the local particles are summed and
+    differentiated with autograd with respect to edge_vec; the gradient g of each edge adds g to
+    the force on i and -g to the force on j, and -edge_vec (x) g to the virial of i. The energy of
+    a particle must depend only on the edges leaving it.
+
+    The graph arrays are GlobalVectors that the model reads in place through torch::from_blob,
+    and the forces are copied to m_force by torch on the same device. Forces on ghost particles
+    are sent to their owners by the Communicator with the reverse net force communication, so the
+    ghost layer only needs to be r_cut wide, which the neighbor list already provides.
+
+    The CPU implementation runs the model on the CPU. MLPotentialGPU builds the graph in device
+    memory and runs the model on the GPU.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT MLPotential : public ForceCompute
+    {
+    public:
+    //! Constructs the compute
+    MLPotential(std::shared_ptr<SystemDefinition> sysdef,
+                std::shared_ptr<NeighborList> nlist,
+                const std::string& filename,
+                Scalar r_cut);
+
+    //! Destructor
+    virtual ~MLPotential();
+
+    //! Get the cutoff radius of the graph
+    Scalar getRCut()
+        {
+        return m_r_cut;
+        }
+
+    //! Get the file name of the model
+    std::string getFilename()
+        {
+        return m_filename;
+        }
+
+    /// Remove the r_cut matrix from the neighbor list
+    virtual void notifyDetach()
+        {
+        if (m_attached)
+            {
+            m_nlist->removeRCutMatrix(m_r_cut_nlist);
+            }
+        m_attached = false;
+        }
+
+#ifdef ENABLE_MPI
+    //! Get ghost particle fields requested by this potential
+    virtual CommFlags getRequestedCommFlags(uint64_t timestep);
+#endif
+
+    protected:
+    std::shared_ptr<NeighborList> m_nlist; //!< Neighbor list to build the graph from
+    std::string m_filename;                //!< File the model was loaded from
+    Scalar m_r_cut;                        //!< Cutoff radius of the graph
+    torch::jit::script::Module m_model;    //!< The TorchScript model
+    torch::Device m_device;                //!< Device the model and the graph reside on
+
+    GlobalVector<int64_t> m_type;       //!< Type of every local and ghost particle
+    GlobalVector<int64_t> m_edge_index; //!< Sources (first E) and destinations (last E) of edges
+    GlobalVector<Scalar> m_edge_vec;    //!< r_j - r_i of the edges, 3 per edge
+    unsigned int m_n_edges;             //!< Number of edges in the graph
+
+    /// Track whether we have attached to the Simulation object
+    bool m_attached = true;
+
+    /// r_cut (not squared) given to the neighbor list
+    std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;
+
+    //! Actually compute the forces
+    virtual void computeForces(uint64_t timestep);
+
+    //! Fill m_type, m_edge_index, and m_edge_vec from the neighbor list
+    virtual void buildGraph();
+
+    //! Evaluate the model on the graph and write the forces, energies, and virials
+    void evaluateModel();
+    };
+
+namespace detail
+    {
+//! Exports the MLPotential class to python
+void export_MLPotential(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // ENABLE_TORCH
+#endif // __ML_POTENTIAL_H__
@@ -0,0 +1,168 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file MLPotentialGPU.cc
+    \brief Contains code for the MLPotentialGPU class
+*/
+
+#include "MLPotentialGPU.h"
+
+#ifdef ENABLE_TORCH
+
+#include "MLPotentialGPU.cuh"
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System to compute forces on
+    \param nlist Neighbor list to build the graph from
+    \param filename TorchScript file to load the model from
+    \param r_cut Cutoff radius of the graph
+*/
+MLPotentialGPU::MLPotentialGPU(std::shared_ptr<SystemDefinition> sysdef,
+                               std::shared_ptr<NeighborList> nlist,
+                               const std::string& filename,
+                               Scalar r_cut)
+    : MLPotential(sysdef, nlist, filename, r_cut), m_edge_count(m_exec_conf),
+      m_edge_offset(m_exec_conf)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "Creating a MLPotentialGPU with no GPU in the execution "
+                                     "configuration"
+                                  << endl;
+        throw std::runtime_error("Error initializing MLPotentialGPU");
+        }
+
+    if (!torch::cuda::is_available())
+        {
+        m_exec_conf->msg->error() << "The linked LibTorch does not support GPUs" << endl;
+        throw std::runtime_error("Error initializing MLPotentialGPU");
+        }
+
+    m_device = torch::Device(torch::kCUDA, (int8_t)m_exec_conf->getGPUIds()[0]);
+    m_model.to(m_device);
+
+    TAG_ALLOCATION(m_edge_count);
+    TAG_ALLOCATION(m_edge_offset);
+
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner_count.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "ml_count_edges", m_exec_conf));
+    m_tuner_fill.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "ml_fill_edges", m_exec_conf));
+    }
+
+MLPotentialGPU::~MLPotentialGPU() { }
+
+void MLPotentialGPU::buildGraph()
+    {
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_all = N + m_pdata->getNGhosts();
+
+    m_type.resize(n_all);
+    m_edge_count.resize(N);
+    m_edge_offset.resize(N);
+
+    ArrayHandle<unsigned int> d_n_neigh(m_nlist->getNNeighArray(),
+                                        access_location::device,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> d_nlist(m_nlist->getCompressedNListArray(),
+                                      access_location::device,
+                                      access_mode::read);
+    ArrayHandle<unsigned int> d_n_outliers(m_nlist->getNOutliersArray(),
+                                           access_location::device,
+                                           access_mode::read);
+    ArrayHandle<size_t> d_head_list(m_nlist->getHeadList(),
+                                    access_location::device,
+                                    access_mode::read);
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    const unsigned int* n_outliers = m_nlist->getCompress() ? d_n_outliers.data : nullptr;
+
+    unsigned int n_edges;
+        {
+        ArrayHandle<unsigned int> d_edge_count(m_edge_count,
+                                               access_location::device,
+                                               access_mode::overwrite);
+        ArrayHandle<unsigned int> d_edge_offset(m_edge_offset,
+                                                access_location::device,
+                                                access_mode::overwrite);
+        ArrayHandle<int64_t> d_type(m_type, access_location::device, access_mode::overwrite);
+
+        m_tuner_count->begin();
+        kernel::gpu_ml_count_edges(d_edge_count.data,
+                                   d_type.data,
+                                   d_pos.data,
+                                   d_n_neigh.data,
+                                   d_nlist.data,
+                                   n_outliers,
+                                   d_head_list.data,
+                                   m_pdata->getBox(),
+                                   N,
+                                   n_all,
+                                   m_r_cut,
+                                   m_tuner_count->getParam());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_count->end();
+
+        n_edges = kernel::gpu_ml_scan_edges(d_edge_offset.data,
+                                            d_edge_count.data,
+                                            N,
+                                            m_exec_conf->getCachedAllocator());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    m_edge_index.resize(2 * n_edges);
+    m_edge_vec.resize(3 * n_edges);
+    m_n_edges = n_edges;
+
+    ArrayHandle<unsigned int> d_edge_offset(m_edge_offset,
+                                            access_location::device,
+                                            access_mode::read);
+    ArrayHandle<int64_t> d_edge_index(m_edge_index,
+                                      access_location::device,
+                                      access_mode::overwrite);
+    ArrayHandle<Scalar> d_edge_vec(m_edge_vec, access_location::device, access_mode::overwrite);
+
+    m_tuner_fill->begin();
+    kernel::gpu_ml_fill_edges(d_edge_index.data,
+                              d_edge_vec.data,
+                              d_edge_offset.data,
+                              d_pos.data,
+                              d_n_neigh.data,
+                              d_nlist.data,
+                              n_outliers,
+                              d_head_list.data,
+                              m_pdata->getBox(),
+                              N,
+                              n_edges,
+                              m_r_cut,
+                              m_tuner_fill->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner_fill->end();
+    }
+
+namespace detail
+    {
+void export_MLPotentialGPU(pybind11::module& m)
+    {
+    pybind11::class_<MLPotentialGPU, MLPotential, std::shared_ptr<MLPotentialGPU>>(
+        m,
+        "MLPotentialGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<NeighborList>,
+                            const std::string&,
+                            Scalar>());
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // ENABLE_TORCH
@@ -0,0 +1,312 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "MLPotentialGPU.cuh"
+
+#include <hipcub/hipcub.hpp>
+
+#include <assert.h>
+
+/*! \file MLPotentialGPU.cu
+    \brief Defines GPU kernel code for building the particle graph of MLPotentialGPU.
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Get neighbor k of particle i from a possibly compressed neighbor list
+/*! \param nlist_i Neighbors of particle i
+    \param i Index of the particle
+    \param n_outliers Number of outliers of particle i, the size of the list if uncompressed
+    \param k Index of the neighbor
+*/
+__device__ inline unsigned int ml_get_neighbor(const unsigned int* nlist_i,
+                                               unsigned int i,
+                                               unsigned int n_outliers,
+                                               unsigned int k)
+    {
+    return k < n_outliers ? nlist_i[k]
+                          : i + reinterpret_cast<const short*>(nlist_i)[n_outliers + k];
+    }
+
+//! Count the edges of each local particle and extract the particle types
+/*! \param d_edge_count Number of edges of each local particle (output)
+    \param d_type Type of each local and ghost particle (output)
+    \param d_pos Particle positions, including ghosts
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_nlist Neighbor list
+    \param d_n_outliers Outliers in a compressed d_nlist, nullptr if uncompressed
+    \param d_head_list Head of the neighbors of each particle in d_nlist
+    \param box Local simulation box
+    \param N Number of local particles
+    \param n_all Number of local and ghost particles
+    \param r_cut_sq Squared cutoff radius of the graph
+
+    One thread is executed per local or ghost particle.
+*/
+__global__ void gpu_ml_count_edges_kernel(unsigned int* d_edge_count,
+                                          int64_t* d_type,
+                                          const Scalar4* d_pos,
+                                          const unsigned int* d_n_neigh,
+                                          const unsigned int* d_nlist,
+                                          const unsigned int* d_n_outliers,
+                                          const size_t* d_head_list,
+                                          const BoxDim box,
+                                          unsigned int N,
+                                          unsigned int n_all,
+                                          Scalar r_cut_sq)
+    {
+    unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (i >= n_all)
+        return;
+
+    Scalar4 postype_i = d_pos[i];
+    d_type[i] = __scalar_as_int(postype_i.w);
+
+    if (i >= N)
+        return;
+
+    Scalar3 pi = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
+    const unsigned int* nlist_i = d_nlist + d_head_list[i];
+    unsigned int size = d_n_neigh[i];
+    unsigned int n_outliers = d_n_outliers ? d_n_outliers[i] : size;
+
+    unsigned int count = 0;
+    for (unsigned int k = 0; k < size; k++)
+        {
+        Scalar4 postype_j = d_pos[ml_get_neighbor(nlist_i, i, n_outliers, k)];
+        Scalar3 dx = make_scalar3(postype_j.x, postype_j.y, postype_j.z) - pi;
+        dx = box.minImage(dx);
+
+        // the neighbor list includes the buffer
+        if (dot(dx, dx) < r_cut_sq)
+            count++;
+        }
+
+    d_edge_count[i] = count;
+    }
+
+//! Write the edges of the local particles
+/*! \param d_edge_index Sources (first n_edges) and destinations (last n_edges) of the edges
+    \param d_edge_vec r_j - r_i of the edges, 3 per edge
+    \param d_edge_offset Index of the first edge of each local particle
+    \param d_pos Particle positions, including ghosts
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_nlist Neighbor list
+    \param d_n_outliers Outliers in a compressed d_nlist, nullptr if uncompressed
+    \param d_head_list Head of the neighbors of each particle in d_nlist
+    \param box Local simulation box
+    \param N Number of local particles
+    \param n_edges Number of edges
+    \param r_cut_sq Squared cutoff radius of the graph
+
+    One thread is executed per local particle. The edges of a particle are written in neighbor list
+   order, matching the CPU implementation.
+*/
+__global__ void gpu_ml_fill_edges_kernel(int64_t* d_edge_index,
+                                         Scalar* d_edge_vec,
+                                         const unsigned int* d_edge_offset,
+                                         const Scalar4* d_pos,
+                                         const unsigned int* d_n_neigh,
+                                         const unsigned int* d_nlist,
+                                         const unsigned int* d_n_outliers,
+                                         const size_t* d_head_list,
+                                         const BoxDim box,
+                                         unsigned int N,
+                                         unsigned int n_edges,
+                                         Scalar r_cut_sq)
+    {
+    unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (i >= N)
+        return;
+
+    Scalar4 postype_i = d_pos[i];
+    Scalar3 pi = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
+    const unsigned int* nlist_i = d_nlist + d_head_list[i];
+    unsigned int size = d_n_neigh[i];
+    unsigned int n_outliers = d_n_outliers ? d_n_outliers[i] : size;
+
+    unsigned int e = d_edge_offset[i];
+    for (unsigned int k = 0; k < size; k++)
+        {
+        unsigned int j = ml_get_neighbor(nlist_i, i, n_outliers, k);
+        Scalar4 postype_j = d_pos[j];
+        Scalar3 dx = make_scalar3(postype_j.x, postype_j.y, postype_j.z) - pi;
+        dx = box.minImage(dx);
+
+        if (dot(dx, dx) >= r_cut_sq)
+            continue;
+
+        d_edge_index[e] = i;
+        d_edge_index[n_edges + e] = j;
+        d_edge_vec[3 * e] = dx.x;
+        d_edge_vec[3 * e + 1] = dx.y;
+        d_edge_vec[3 * e + 2] = dx.z;
+        e++;
+        }
+    }
+
+/*! \param d_edge_count Number of edges of each local particle (output)
+    \param d_type Type of each local and ghost particle (output)
+    \param d_pos Particle positions, including ghosts
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_nlist Neighbor list
+    \param d_n_outliers Outliers in a compressed d_nlist, nullptr if uncompressed
+    \param d_head_list Head of the neighbors of each particle in d_nlist
+    \param box Local simulation box
+    \param N Number of local particles
+    \param n_all Number of local and ghost particles
+    \param r_cut Cutoff radius of the graph
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_ml_count_edges(unsigned int* d_edge_count,
+                              int64_t* d_type,
+                              const Scalar4* d_pos,
+                              const unsigned int* d_n_neigh,
+                              const unsigned int* d_nlist,
+                              const unsigned int* d_n_outliers,
+                              const size_t* d_head_list,
+                              const BoxDim& box,
+                              unsigned int N,
+                              unsigned int n_all,
+                              Scalar r_cut,
+                              unsigned int block_size)
+    {
+    assert(d_type);
+
+    if (n_all == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_ml_count_edges_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipLaunchKernelGGL(gpu_ml_count_edges_kernel,
+                       dim3(n_all / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_edge_count,
+                       d_type,
+                       d_pos,
+                       d_n_neigh,
+                       d_nlist,
+                       d_n_outliers,
+                       d_head_list,
+                       box,
+                       N,
+                       n_all,
+                       r_cut * r_cut);
+
+    return hipSuccess;
+    }
+
+/*! \param d_edge_offset Index of the first edge of each local particle (output)
+    \param d_edge_count Number of edges of each local particle
+    \param N Number of local particles
+    \param alloc Caching allocator for the temporary storage of the scan
+    \returns The total number of edges
+*/
+unsigned int gpu_ml_scan_edges(unsigned int* d_edge_offset,
+                               const unsigned int* d_edge_count,
+                               unsigned int N,
+                               CachedAllocator& alloc)
+    {
+    if (N == 0)
+        return 0;
+
+    void* d_temp_storage = NULL;
+    size_t temp_storage_bytes = 0;
+
+    // determine size of temporary storage
+    hipcub::DeviceScan::ExclusiveSum(d_temp_storage,
+                                     temp_storage_bytes,
+                                     d_edge_count,
+                                     d_edge_offset,
+                                     N);
+
+    d_temp_storage = alloc.getTemporaryBuffer<char>(temp_storage_bytes);
+    hipcub::DeviceScan::ExclusiveSum(d_temp_storage,
+                                     temp_storage_bytes,
+                                     d_edge_count,
+                                     d_edge_offset,
+                                     N);
+    alloc.deallocate((char*)d_temp_storage);
+
+    // the edges end after the last particle's edges
+    unsigned int last_offset, last_count;
+    hipMemcpy(&last_offset, d_edge_offset + N - 1, sizeof(unsigned int), hipMemcpyDeviceToHost);
+    hipMemcpy(&last_count, d_edge_count + N - 1, sizeof(unsigned int), hipMemcpyDeviceToHost);
+    return last_offset + last_count;
+    }
+
+/*! \param d_edge_index Sources (first n_edges) and destinations (last n_edges) of the edges
+    \param d_edge_vec r_j - r_i of the edges, 3 per edge
+    \param d_edge_offset Index of the first edge of each local particle
+    \param d_pos Particle positions, including ghosts
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_nlist Neighbor list
+    \param d_n_outliers Outliers in a compressed d_nlist, nullptr if uncompressed
+    \param d_head_list Head of the neighbors of each particle in d_nlist
+    \param box Local simulation box
+    \param N Number of local particles
+    \param n_edges Number of edges
+    \param r_cut Cutoff radius of the graph
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_ml_fill_edges(int64_t* d_edge_index,
+                             Scalar* d_edge_vec,
+                             const unsigned int* d_edge_offset,
+                             const Scalar4* d_pos,
+                             const unsigned int* d_n_neigh,
+                             const unsigned int* d_nlist,
+                             const unsigned int* d_n_outliers,
+                             const size_t* d_head_list,
+                             const BoxDim& box,
+                             unsigned int N,
+                             unsigned int n_edges,
+                             Scalar r_cut,
+                             unsigned int block_size)
+    {
+    if (N == 0 || n_edges == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_ml_fill_edges_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipLaunchKernelGGL(gpu_ml_fill_edges_kernel,
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_edge_index,
+                       d_edge_vec,
+                       d_edge_offset,
+                       d_pos,
+                       d_n_neigh,
+                       d_nlist,
+                       d_n_outliers,
+                       d_head_list,
+                       box,
+                       N,
+                       n_edges,
+                       r_cut * r_cut);
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
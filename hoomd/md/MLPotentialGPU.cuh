@@ -0,0 +1,63 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _ML_POTENTIAL_GPU_CUH_
+#define _ML_POTENTIAL_GPU_CUH_
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/CachedAllocator.h"
+#include "hoomd/HOOMDMath.h"
+
+#include <hip/hip_runtime.h>
+#include <stdint.h>
+
+/*! \file MLPotentialGPU.cuh
+    \brief Kernel driver function declarations for MLPotentialGPU
+    */
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Counts the edges of each local particle and extracts the particle types
+hipError_t gpu_ml_count_edges(unsigned int* d_edge_count,
+                              int64_t* d_type,
+                              const Scalar4* d_pos,
+                              const unsigned int* d_n_neigh,
+                              const unsigned int* d_nlist,
+                              const unsigned int* d_n_outliers,
+                              const size_t* d_head_list,
+                              const BoxDim& box,
+                              unsigned int N,
+                              unsigned int n_all,
+                              Scalar r_cut,
+                              unsigned int block_size);
+
+//! Computes the offsets of the edges of each local particle and returns the number of edges
+unsigned int gpu_ml_scan_edges(unsigned int* d_edge_offset,
+                               const unsigned int* d_edge_count,
+                               unsigned int N,
+                               CachedAllocator& alloc);
+
+//! Writes the edges of the local particles
+hipError_t gpu_ml_fill_edges(int64_t* d_edge_index,
+                             Scalar* d_edge_vec,
+                             const unsigned int* d_edge_offset,
+                             const Scalar4* d_pos,
+                             const unsigned int* d_n_neigh,
+                             const unsigned int* d_nlist,
+                             const unsigned int* d_n_outliers,
+                             const size_t* d_head_list,
+                             const BoxDim& box,
+                             unsigned int N,
+                             unsigned int n_edges,
+                             Scalar r_cut,
+                             unsigned int block_size);
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
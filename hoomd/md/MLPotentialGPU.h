@@ -0,0 +1,76 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __ML_POTENTIAL_GPU_H__
+#define __ML_POTENTIAL_GPU_H__
+
+#ifdef ENABLE_TORCH
+
+#include "MLPotential.h"
+#include "hoomd/Autotuner.h"
+
+/*! \file MLPotentialGPU.h
+    \brief Declares a force compute that evaluates a TorchScript model on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Computes forces with a machine-learned potential on the GPU
+/*! MLPotentialGPU counts the edges of each particle, offsets them with a device scan, and fills
+    the graph arrays directly from the device neighbor list. The model runs on the GPU of the
+    execution configuration on the default stream, which orders it after the graph kernels and
+    before the integrator reads the net force. Only the number of edges is copied to the host.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT MLPotentialGPU : public MLPotential
+    {
+    public:
+    //! Constructs the compute
+    MLPotentialGPU(std::shared_ptr<SystemDefinition> sysdef,
+                   std::shared_ptr<NeighborList> nlist,
+                   const std::string& filename,
+                   Scalar r_cut);
+
+    //! Destructor
+    virtual ~MLPotentialGPU();
+
+    //! Set autotuner parameters
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        MLPotential::setAutotunerParams(enable, period);
+        m_tuner_count->setPeriod(period);
+        m_tuner_count->setEnabled(enable);
+        m_tuner_fill->setPeriod(period);
+        m_tuner_fill->setEnabled(enable);
+        }
+
+    protected:
+    GlobalVector<unsigned int> m_edge_count;  //!< Number of edges of each local particle
+    GlobalVector<unsigned int> m_edge_offset; //!< Index of the first edge of each local particle
+    std::unique_ptr<Autotuner> m_tuner_count; //!< Autotuner for the edge count block size
+    std::unique_ptr<Autotuner> m_tuner_fill;  //!< Autotuner for the edge fill block size
+
+    //! Fill m_type, m_edge_index, and m_edge_vec on the device
+    virtual void buildGraph();
+    };
+
+namespace detail
+    {
+//! Exports the MLPotentialGPU class to python
+void export_MLPotentialGPU(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // ENABLE_TORCH
+#endif // __ML_POTENTIAL_GPU_H__
@@ -92,6 +92,16 @@ class ManifoldDiamond
                             -Lz * (cx * cy * sz + sx * sy * cz));
         }
 
+    //! Intersect a line with the surface
+    /*! The surface has no closed form line intersection, so the caller finds it iteratively.
+
+        \return false
+    */
+    DEVICE bool intersectLine(const Scalar3& point, const Scalar3& direction, Scalar& t)
+        {
+        return false;
+        }
+
     DEVICE bool fitsInsideBox(const BoxDim& box)
         {
         Scalar3 box_length = box.getHi() - box.getLo();
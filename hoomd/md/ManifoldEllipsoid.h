@@ -6,6 +6,7 @@
 #ifndef __MANIFOLD_CLASS_ELLIPSOID_H__
 #define __MANIFOLD_CLASS_ELLIPSOID_H__
 
+#include "ManifoldIntersect.h"
 #include "hoomd/BoxDim.h"
 #include "hoomd/HOOMDMath.h"
 #include <pybind11/pybind11.h>
@@ -90,6 +91,25 @@ class ManifoldEllipsoid
                             2 * inv_c2 * (point.z - Pz));
         }
 
+    //! Intersect a line with the surface
+    /*! \param point Point on the line
+        \param direction Direction of the line
+        \param t Output line parameter of the intersection nearest to \a point
+
+        \return false when the line does not intersect the surface
+    */
+
+    DEVICE bool intersectLine(const Scalar3& point, const Scalar3& direction, Scalar& t)
+        {
+        Scalar3 delta = make_scalar3(point.x - Px, point.y - Py, point.z - Pz);
+        Scalar3 w_direction
+            = make_scalar3(inv_a2 * direction.x, inv_b2 * direction.y, inv_c2 * direction.z);
+        return detail::manifold_nearest_quadratic_root(dot(w_direction, direction),
+                                                       2 * dot(w_direction, delta),
+                                                       implicitFunction(point),
+                                                       t);
+        }
+
     DEVICE bool fitsInsideBox(const BoxDim& box)
         {
         Scalar3 lo = box.getLo();
@@ -94,6 +94,16 @@ class ManifoldGyroid
                             Lz * (cz * cx - sy * sz));
         }
 
+    //! Intersect a line with the surface
+    /*! The surface has no closed form line intersection, so the caller finds it iteratively.
+
+        \return false
+    */
+    DEVICE bool intersectLine(const Scalar3& point, const Scalar3& direction, Scalar& t)
+        {
+        return false;
+        }
+
     DEVICE bool fitsInsideBox(const BoxDim& box)
         {
         Scalar3 box_length = box.getHi() - box.getLo();
@@ -0,0 +1,68 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/HOOMDMath.h"
+
+#ifndef __MANIFOLD_INTERSECT_H__
+#define __MANIFOLD_INTERSECT_H__
+
+/*! \file ManifoldIntersect.h
+    \brief Defines the line intersection helper shared by the quadric manifold classes
+
+    The RATTLE integrators project each particle back onto the manifold along a fixed direction
+    \a n: they solve g(r + t n) = 0 for the root \a t nearest to zero. For the quadric manifolds
+    (sphere, cylinder, ellipsoid), g(r + t n) = a t^2 + b t + c is a quadratic polynomial in \a t
+    and the root has a closed form, so the projection needs no Newton iteration.
+*/
+
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace detail
+    {
+//! Find the root of a t^2 + b t + c nearest to zero
+/*! \param a Quadratic coefficient
+    \param b Linear coefficient
+    \param c Constant coefficient
+    \param t Output root
+
+    Uses the cancellation free form of the roots, q / a and c / q with
+    q = -(b + sign(b) sqrt(b^2 - 4 a c)) / 2.
+
+    \returns false when there is no real root or \a a is zero
+*/
+HOSTDEVICE inline bool manifold_nearest_quadratic_root(Scalar a, Scalar b, Scalar c, Scalar& t)
+    {
+    Scalar disc = b * b - Scalar(4.0) * a * c;
+    if (a == Scalar(0.0) || disc < Scalar(0.0))
+        return false;
+
+    Scalar sqrt_disc = slow::sqrt(disc);
+    Scalar q = Scalar(-0.5) * (b < Scalar(0.0) ? b - sqrt_disc : b + sqrt_disc);
+    if (q == Scalar(0.0))
+        {
+        // b = c = 0: the point is on the manifold
+        t = Scalar(0.0);
+        return true;
+        }
+
+    Scalar t1 = q / a;
+    Scalar t2 = c / q;
+    t = fabs(t1) < fabs(t2) ? t1 : t2;
+    return true;
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __MANIFOLD_INTERSECT_H__
@@ -6,6 +6,7 @@
 #ifndef __MANIFOLD_CLASS_SPHERE_H__
 #define __MANIFOLD_CLASS_SPHERE_H__
 
+#include "ManifoldIntersect.h"
 #include "hoomd/BoxDim.h"
 #include "hoomd/HOOMDMath.h"
 #include <pybind11/pybind11.h>
@@ -83,6 +84,23 @@ class ManifoldSphere
         return make_scalar3(2 * (point.x - Px), 2 * (point.y - Py), 2 * (point.z - Pz));
         }
 
+    //! Intersect a line with the surface
+    /*! \param point Point on the line
+        \param direction Direction of the line
+        \param t Output line parameter of the intersection nearest to \a point
+
+        \return false when the line does not intersect the surface
+    */
+
+    DEVICE bool intersectLine(const Scalar3& point, const Scalar3& direction, Scalar& t)
+        {
+        Scalar3 delta = make_scalar3(point.x - Px, point.y - Py, point.z - Pz);
+        return detail::manifold_nearest_quadratic_root(dot(direction, direction),
+                                                       2 * dot(delta, direction),
+                                                       dot(delta, delta) - R_sq,
+                                                       t);
+        }
+
     DEVICE bool fitsInsideBox(const BoxDim& box)
         {
         Scalar3 lo = box.getLo();
@@ -73,6 +73,22 @@ class ManifoldXYPlane
         return make_scalar3(0, 0, 1);
         }
 
+    //! Intersect a line with the surface
+    /*! \param point Point on the line
+        \param direction Direction of the line
+        \param t Output line parameter of the intersection nearest to \a point
+
+        \return false when the line is parallel to the surface
+    */
+
+    DEVICE bool intersectLine(const Scalar3& point, const Scalar3& direction, Scalar& t)
+        {
+        if (direction.z == 0)
+            return false;
+        t = (shift - point.z) / direction.z;
+        return true;
+        }
+
     DEVICE bool fitsInsideBox(const BoxDim& box)
         {
         Scalar3 lo = box.getLo();
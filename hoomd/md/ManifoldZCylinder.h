@@ -6,6 +6,7 @@
 #ifndef __MANIFOLD_CLASS_Z_CYLINDER_H__
 #define __MANIFOLD_CLASS_Z_CYLINDER_H__
 
+#include "ManifoldIntersect.h"
 #include "hoomd/BoxDim.h"
 #include "hoomd/HOOMDMath.h"
 #include <pybind11/pybind11.h>
@@ -80,6 +81,25 @@ class ManifoldZCylinder
         return make_scalar3(2 * (point.x - Px), 2 * (point.y - Py), 0);
         }
 
+    //! Intersect a line with the surface
+    /*! \param point Point on the line
+        \param direction Direction of the line
+        \param t Output line parameter of the intersection nearest to \a point
+
+        \return false when the line does not intersect the surface
+    */
+
+    DEVICE bool intersectLine(const Scalar3& point, const Scalar3& direction, Scalar& t)
+        {
+        Scalar dx = point.x - Px;
+        Scalar dy = point.y - Py;
+        return detail::manifold_nearest_quadratic_root(
+            direction.x * direction.x + direction.y * direction.y,
+            2 * (dx * direction.x + dy * direction.y),
+            dx * dx + dy * dy - R_sq,
+            t);
+        }
+
     DEVICE bool fitsInsideBox(const BoxDim& box)
         {
         Scalar3 lo = box.getLo();
@@ -0,0 +1,178 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file MeanSquaredDisplacement.cc
+    \brief Contains code for the MeanSquaredDisplacement class
+*/
+
+#include "MeanSquaredDisplacement.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#include <pybind11/stl.h>
+
+#include <string.h>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System to compute the mean squared displacement of
+    \param group Group of particles to compute the mean squared displacement of
+*/
+MeanSquaredDisplacement::MeanSquaredDisplacement(std::shared_ptr<SystemDefinition> sysdef,
+                                                 std::shared_ptr<ParticleGroup> group)
+    : Analyzer(sysdef), m_group(group), m_has_reference(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing MeanSquaredDisplacement" << endl;
+    }
+
+MeanSquaredDisplacement::~MeanSquaredDisplacement()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying MeanSquaredDisplacement" << endl;
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void MeanSquaredDisplacement::analyze(uint64_t timestep)
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "MSD");
+
+    if (!m_has_reference)
+        {
+        // size the reference by tag, tags of removed particles leave unused entries
+        unsigned int n_tags = m_pdata->getMaximumTag() + 1;
+        if (m_reference_pos.getNumElements() != n_tags)
+            {
+            GlobalArray<Scalar3> reference_pos(n_tags, m_exec_conf);
+            m_reference_pos.swap(reference_pos);
+            TAG_ALLOCATION(m_reference_pos);
+            }
+
+            {
+            ArrayHandle<Scalar3> h_reference_pos(m_reference_pos,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+            memset(h_reference_pos.data, 0, sizeof(Scalar3) * n_tags);
+            }
+
+        setReference();
+
+#ifdef ENABLE_MPI
+        // every rank needs the reference of every particle that may migrate to it
+        if (m_pdata->getDomainDecomposition())
+            {
+            ArrayHandle<Scalar3> h_reference_pos(m_reference_pos,
+                                                 access_location::host,
+                                                 access_mode::readwrite);
+            MPI_Allreduce(MPI_IN_PLACE,
+                          h_reference_pos.data,
+                          3 * n_tags,
+                          MPI_HOOMD_SCALAR,
+                          MPI_SUM,
+                          m_exec_conf->getMPICommunicator());
+            }
+#endif
+        m_has_reference = true;
+        }
+
+    Scalar sum = sumSquaredDisplacements();
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &sum,
+                      1,
+                      MPI_HOOMD_SCALAR,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    unsigned int n_members = m_group->getNumMembersGlobal();
+    m_timesteps.push_back(timestep);
+    m_msd.push_back(n_members > 0 ? sum / Scalar(n_members) : Scalar(0.0));
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+void MeanSquaredDisplacement::setReference()
+    {
+    // access the group first, rebuilding the group may access the tags
+    ArrayHandle<unsigned int> h_index_array(m_group->getIndexArray(),
+                                            access_location::host,
+                                            access_mode::read);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_reference_pos(m_reference_pos,
+                                         access_location::host,
+                                         access_mode::readwrite);
+
+    const BoxDim box = m_pdata->getGlobalBox();
+    unsigned int n_members = m_group->getNumMembers();
+    for (unsigned int group_idx = 0; group_idx < n_members; group_idx++)
+        {
+        unsigned int j = h_index_array.data[group_idx];
+        Scalar3 pos = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+        h_reference_pos.data[h_tag.data[j]] = box.shift(pos, h_image.data[j]);
+        }
+    }
+
+Scalar MeanSquaredDisplacement::sumSquaredDisplacements()
+    {
+    // access the group first, rebuilding the group may access the tags
+    ArrayHandle<unsigned int> h_index_array(m_group->getIndexArray(),
+                                            access_location::host,
+                                            access_mode::read);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_reference_pos(m_reference_pos,
+                                         access_location::host,
+                                         access_mode::read);
+
+    const BoxDim box = m_pdata->getGlobalBox();
+    unsigned int n_members = m_group->getNumMembers();
+    unsigned int n_tags = (unsigned int)m_reference_pos.getNumElements();
+    double sum = 0.0;
+    for (unsigned int group_idx = 0; group_idx < n_members; group_idx++)
+        {
+        unsigned int j = h_index_array.data[group_idx];
+        unsigned int tag = h_tag.data[j];
+
+        // particles added after the reference was taken have no reference
+        if (tag >= n_tags)
+            continue;
+
+        Scalar3 pos = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+        Scalar3 dr = box.shift(pos, h_image.data[j]) - h_reference_pos.data[tag];
+        sum += dot(dr, dr);
+        }
+
+    return Scalar(sum);
+    }
+
+namespace detail
+    {
+void export_MeanSquaredDisplacement(pybind11::module& m)
+    {
+    pybind11::class_<MeanSquaredDisplacement, Analyzer, std::shared_ptr<MeanSquaredDisplacement>>(
+        m,
+        "MeanSquaredDisplacement")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<ParticleGroup>>())
+        .def("getTimesteps", &MeanSquaredDisplacement::getTimesteps)
+        .def("getMSD", &MeanSquaredDisplacement::getMSD)
+        .def("reset", &MeanSquaredDisplacement::reset);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
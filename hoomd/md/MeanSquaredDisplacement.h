@@ -0,0 +1,97 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/Analyzer.h"
+#include "hoomd/GlobalArray.h"
+#include "hoomd/ParticleGroup.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file MeanSquaredDisplacement.h
+    \brief Declares a class that records the mean squared displacement during a run
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __MEAN_SQUARED_DISPLACEMENT_H__
+#define __MEAN_SQUARED_DISPLACEMENT_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Records the mean squared displacement of a group of particles during a run
+/*! The first call to analyze() (and the first after reset()) stores the unwrapped positions of the
+    group members by tag as the reference. Every call appends the mean squared displacement of the
+    unwrapped positions from the reference to a time series, which is only copied to python when
+    requested.
+
+    Positions are unwrapped with the image flags in the current global box. The reference array
+    holds one entry per tag on every rank so that particles can migrate between ranks; it is
+    assembled with a single MPI_Allreduce when the reference is taken. Every later frame reduces
+    only the sum of the squared displacements.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT MeanSquaredDisplacement : public Analyzer
+    {
+    public:
+    //! Constructs the analyzer
+    MeanSquaredDisplacement(std::shared_ptr<SystemDefinition> sysdef,
+                            std::shared_ptr<ParticleGroup> group);
+
+    //! Destructor
+    virtual ~MeanSquaredDisplacement();
+
+    //! Append the mean squared displacement of the current configuration to the time series
+    virtual void analyze(uint64_t timestep);
+
+    //! Get the time steps of the recorded frames
+    std::vector<uint64_t> getTimesteps()
+        {
+        return m_timesteps;
+        }
+
+    //! Get the mean squared displacement of the recorded frames
+    std::vector<Scalar> getMSD()
+        {
+        return m_msd;
+        }
+
+    //! Discard the recorded frames and take a new reference on the next call to analyze()
+    void reset()
+        {
+        m_has_reference = false;
+        m_timesteps.clear();
+        m_msd.clear();
+        }
+
+    protected:
+    std::shared_ptr<ParticleGroup> m_group; //!< Group to compute the displacements of
+    GlobalArray<Scalar3> m_reference_pos;   //!< Unwrapped reference positions, indexed by tag
+    bool m_has_reference;                   //!< True when m_reference_pos is set
+    std::vector<uint64_t> m_timesteps;      //!< Time steps of the recorded frames
+    std::vector<Scalar> m_msd;              //!< Mean squared displacement of the recorded frames
+
+    //! Store the unwrapped positions of the local group members in m_reference_pos
+    virtual void setReference();
+
+    //! Sum the squared displacements of the local group members
+    virtual Scalar sumSquaredDisplacements();
+    };
+
+namespace detail
+    {
+//! Exports the MeanSquaredDisplacement class to python
+void export_MeanSquaredDisplacement(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
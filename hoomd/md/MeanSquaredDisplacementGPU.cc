@@ -0,0 +1,130 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file MeanSquaredDisplacementGPU.cc
+    \brief Contains code for the MeanSquaredDisplacementGPU class
+*/
+
+#include "MeanSquaredDisplacementGPU.h"
+#include "MeanSquaredDisplacementGPU.cuh"
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System to compute the mean squared displacement of
+    \param group Group of particles to compute the mean squared displacement of
+*/
+MeanSquaredDisplacementGPU::MeanSquaredDisplacementGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                                       std::shared_ptr<ParticleGroup> group)
+    : MeanSquaredDisplacement(sysdef, group), m_scratch(m_exec_conf)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error()
+            << "Creating a MeanSquaredDisplacementGPU with no GPU in the execution configuration"
+            << endl;
+        throw std::runtime_error("Error initializing MeanSquaredDisplacementGPU");
+        }
+
+    GlobalArray<Scalar> sum(1, m_exec_conf);
+    m_sum.swap(sum);
+    TAG_ALLOCATION(m_sum);
+
+    // the partial sums reduce in a tree, they need power of two block sizes
+    std::vector<unsigned int> valid_params;
+    for (unsigned int block_size = m_exec_conf->dev_prop.warpSize; block_size <= 1024;
+         block_size *= 2)
+        valid_params.push_back(block_size);
+
+    m_tuner.reset(new Autotuner(valid_params, 5, 100000, "msd", m_exec_conf));
+    }
+
+MeanSquaredDisplacementGPU::~MeanSquaredDisplacementGPU() { }
+
+void MeanSquaredDisplacementGPU::setReference()
+    {
+    // access the group first, rebuilding the group may access the tags
+    ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
+                                            access_location::device,
+                                            access_mode::read);
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<int3> d_image(m_pdata->getImages(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar3> d_reference_pos(m_reference_pos,
+                                         access_location::device,
+                                         access_mode::readwrite);
+
+    kernel::gpu_msd_set_reference(d_reference_pos.data,
+                                  d_pos.data,
+                                  d_image.data,
+                                  d_tag.data,
+                                  d_index_array.data,
+                                  m_group->getNumMembers(),
+                                  m_pdata->getGlobalBox(),
+                                  256);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+Scalar MeanSquaredDisplacementGPU::sumSquaredDisplacements()
+    {
+        {
+        // access the group first, rebuilding the group may access the tags
+        ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
+                                                access_location::device,
+                                                access_mode::read);
+        unsigned int n_members = m_group->getNumMembers();
+
+        // the largest block size needs the most scratch space
+        m_scratch.resize(n_members / m_exec_conf->dev_prop.warpSize + 1);
+
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::read);
+        ArrayHandle<int3> d_image(m_pdata->getImages(), access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                        access_location::device,
+                                        access_mode::read);
+        ArrayHandle<Scalar3> d_reference_pos(m_reference_pos,
+                                             access_location::device,
+                                             access_mode::read);
+        ArrayHandle<Scalar> d_scratch(m_scratch, access_location::device, access_mode::overwrite);
+        ArrayHandle<Scalar> d_sum(m_sum, access_location::device, access_mode::overwrite);
+
+        m_tuner->begin();
+        kernel::gpu_msd_sum(d_sum.data,
+                            d_scratch.data,
+                            d_reference_pos.data,
+                            (unsigned int)m_reference_pos.getNumElements(),
+                            d_pos.data,
+                            d_image.data,
+                            d_tag.data,
+                            d_index_array.data,
+                            n_members,
+                            m_pdata->getGlobalBox(),
+                            m_tuner->getParam());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner->end();
+        }
+
+    ArrayHandle<Scalar> h_sum(m_sum, access_location::host, access_mode::read);
+    return h_sum.data[0];
+    }
+
+namespace detail
+    {
+void export_MeanSquaredDisplacementGPU(pybind11::module& m)
+    {
+    pybind11::class_<MeanSquaredDisplacementGPU,
+                     MeanSquaredDisplacement,
+                     std::shared_ptr<MeanSquaredDisplacementGPU>>(m, "MeanSquaredDisplacementGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<ParticleGroup>>());
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
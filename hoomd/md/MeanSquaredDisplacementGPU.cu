@@ -0,0 +1,251 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "MeanSquaredDisplacementGPU.cuh"
+
+#include <assert.h>
+
+/*! \file MeanSquaredDisplacementGPU.cu
+    \brief Defines GPU kernel code for computing the mean squared displacement on the GPU. Used by
+   MeanSquaredDisplacementGPU.
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Store the unwrapped positions of the group members by tag
+/*! \param d_reference_pos Reference positions to write, indexed by tag
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param d_tag Particle tags
+    \param d_index_array Indices of the group members
+    \param n_members Number of local group members
+    \param box Global simulation box
+*/
+__global__ void gpu_msd_set_reference_kernel(Scalar3* d_reference_pos,
+                                             const Scalar4* d_pos,
+                                             const int3* d_image,
+                                             const unsigned int* d_tag,
+                                             const unsigned int* d_index_array,
+                                             unsigned int n_members,
+                                             const BoxDim box)
+    {
+    unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (group_idx >= n_members)
+        return;
+
+    unsigned int j = d_index_array[group_idx];
+    Scalar4 postype = d_pos[j];
+    Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+    d_reference_pos[d_tag[j]] = box.shift(pos, d_image[j]);
+    }
+
+//! Perform partial sums of the squared displacements of the group members
+/*! \param d_scratch Partial sums, one per block
+    \param d_reference_pos Unwrapped reference positions, indexed by tag
+    \param n_tags Number of reference positions
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param d_tag Particle tags
+    \param d_index_array Indices of the group members
+    \param n_members Number of local group members
+    \param box Global simulation box
+
+    One thread is executed per group member. For this kernel to run, sizeof(Scalar)*block_size of
+   dynamic shared memory are needed.
+*/
+__global__ void gpu_msd_partial_sums_kernel(Scalar* d_scratch,
+                                            const Scalar3* d_reference_pos,
+                                            unsigned int n_tags,
+                                            const Scalar4* d_pos,
+                                            const int3* d_image,
+                                            const unsigned int* d_tag,
+                                            const unsigned int* d_index_array,
+                                            unsigned int n_members,
+                                            const BoxDim box)
+    {
+    extern __shared__ Scalar msd_sdata[];
+
+    unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    Scalar my_element(0.0);
+    if (group_idx < n_members)
+        {
+        unsigned int j = d_index_array[group_idx];
+        unsigned int tag = d_tag[j];
+
+        // particles added after the reference was taken have no reference
+        if (tag < n_tags)
+            {
+            Scalar4 postype = d_pos[j];
+            Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+            Scalar3 dr = box.shift(pos, d_image[j]) - d_reference_pos[tag];
+            my_element = dot(dr, dr);
+            }
+        }
+
+    msd_sdata[threadIdx.x] = my_element;
+    __syncthreads();
+
+    // reduce the sum in parallel
+    int offs = blockDim.x >> 1;
+    while (offs > 0)
+        {
+        if (threadIdx.x < offs)
+            msd_sdata[threadIdx.x] += msd_sdata[threadIdx.x + offs];
+        offs >>= 1;
+        __syncthreads();
+        }
+
+    if (threadIdx.x == 0)
+        d_scratch[blockIdx.x] = msd_sdata[0];
+    }
+
+//! Complete the sum of the squared displacements
+/*! \param d_sum Sum to write
+    \param d_scratch Partial sums from gpu_msd_partial_sums_kernel
+    \param num_partial_sums Number of partial sums
+
+    Executed in a single block. For this kernel to run, sizeof(Scalar)*block_size of dynamic shared
+   memory are needed.
+*/
+__global__ void
+gpu_msd_final_sum_kernel(Scalar* d_sum, const Scalar* d_scratch, unsigned int num_partial_sums)
+    {
+    extern __shared__ Scalar msd_final_sdata[];
+
+    Scalar final_sum(0.0);
+
+    // sum up the values in the partial sum via a sliding window
+    for (unsigned int start = 0; start < num_partial_sums; start += blockDim.x)
+        {
+        __syncthreads();
+        if (start + threadIdx.x < num_partial_sums)
+            msd_final_sdata[threadIdx.x] = d_scratch[start + threadIdx.x];
+        else
+            msd_final_sdata[threadIdx.x] = Scalar(0.0);
+        __syncthreads();
+
+        // reduce the sum in parallel
+        int offs = blockDim.x >> 1;
+        while (offs > 0)
+            {
+            if (threadIdx.x < offs)
+                msd_final_sdata[threadIdx.x] += msd_final_sdata[threadIdx.x + offs];
+            offs >>= 1;
+            __syncthreads();
+            }
+
+        // everybody sums up final_sum
+        final_sum += msd_final_sdata[0];
+        }
+
+    if (threadIdx.x == 0)
+        *d_sum = final_sum;
+    }
+
+/*! \param d_reference_pos Reference positions to write, indexed by tag
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param d_tag Particle tags
+    \param d_index_array Indices of the group members
+    \param n_members Number of local group members
+    \param box Global simulation box
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_msd_set_reference(Scalar3* d_reference_pos,
+                                 const Scalar4* d_pos,
+                                 const int3* d_image,
+                                 const unsigned int* d_tag,
+                                 const unsigned int* d_index_array,
+                                 unsigned int n_members,
+                                 const BoxDim& box,
+                                 unsigned int block_size)
+    {
+    assert(d_reference_pos);
+
+    if (n_members == 0)
+        return hipSuccess;
+
+    hipLaunchKernelGGL(gpu_msd_set_reference_kernel,
+                       dim3(n_members / block_size + 1),
+                       dim3(block_size),
+                       0,
+                       0,
+                       d_reference_pos,
+                       d_pos,
+                       d_image,
+                       d_tag,
+                       d_index_array,
+                       n_members,
+                       box);
+
+    return hipSuccess;
+    }
+
+/*! \param d_sum Sum to write
+    \param d_scratch Scratch space for the partial sums, n_members / block_size + 1 elements
+    \param d_reference_pos Unwrapped reference positions, indexed by tag
+    \param n_tags Number of reference positions
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param d_tag Particle tags
+    \param d_index_array Indices of the group members
+    \param n_members Number of local group members
+    \param box Global simulation box
+    \param block_size Number of threads per block, a power of two
+
+    This function drives gpu_msd_partial_sums_kernel and gpu_msd_final_sum_kernel, see them for
+   details.
+*/
+hipError_t gpu_msd_sum(Scalar* d_sum,
+                       Scalar* d_scratch,
+                       const Scalar3* d_reference_pos,
+                       unsigned int n_tags,
+                       const Scalar4* d_pos,
+                       const int3* d_image,
+                       const unsigned int* d_tag,
+                       const unsigned int* d_index_array,
+                       unsigned int n_members,
+                       const BoxDim& box,
+                       unsigned int block_size)
+    {
+    assert(d_sum);
+    assert(d_scratch);
+
+    unsigned int num_blocks = n_members / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_msd_partial_sums_kernel,
+                       dim3(num_blocks),
+                       dim3(block_size),
+                       sizeof(Scalar) * block_size,
+                       0,
+                       d_scratch,
+                       d_reference_pos,
+                       n_tags,
+                       d_pos,
+                       d_image,
+                       d_tag,
+                       d_index_array,
+                       n_members,
+                       box);
+
+    unsigned int final_block_size = 512;
+    hipLaunchKernelGGL(gpu_msd_final_sum_kernel,
+                       dim3(1),
+                       dim3(final_block_size),
+                       sizeof(Scalar) * final_block_size,
+                       0,
+                       d_sum,
+                       d_scratch,
+                       num_blocks);
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,49 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _MEAN_SQUARED_DISPLACEMENT_GPU_CUH_
+#define _MEAN_SQUARED_DISPLACEMENT_GPU_CUH_
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+
+#include <hip/hip_runtime.h>
+
+/*! \file MeanSquaredDisplacementGPU.cuh
+    \brief Kernel driver function declarations for MeanSquaredDisplacementGPU
+    */
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Stores the unwrapped positions of the group members by tag on the GPU
+hipError_t gpu_msd_set_reference(Scalar3* d_reference_pos,
+                                 const Scalar4* d_pos,
+                                 const int3* d_image,
+                                 const unsigned int* d_tag,
+                                 const unsigned int* d_index_array,
+                                 unsigned int n_members,
+                                 const BoxDim& box,
+                                 unsigned int block_size);
+
+//! Sums the squared displacements of the group members on the GPU
+hipError_t gpu_msd_sum(Scalar* d_sum,
+                       Scalar* d_scratch,
+                       const Scalar3* d_reference_pos,
+                       unsigned int n_tags,
+                       const Scalar4* d_pos,
+                       const int3* d_image,
+                       const unsigned int* d_tag,
+                       const unsigned int* d_index_array,
+                       unsigned int n_members,
+                       const BoxDim& box,
+                       unsigned int block_size);
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -0,0 +1,70 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "MeanSquaredDisplacement.h"
+#include "hoomd/Autotuner.h"
+#include "hoomd/GlobalArray.h"
+
+/*! \file MeanSquaredDisplacementGPU.h
+    \brief Declares a class that records the mean squared displacement on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __MEAN_SQUARED_DISPLACEMENT_GPU_H__
+#define __MEAN_SQUARED_DISPLACEMENT_GPU_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Records the mean squared displacement of a group of particles on the GPU
+/*! The reference positions stay on the device. Each frame reduces the squared displacements in
+    two kernels and copies back a single value.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT MeanSquaredDisplacementGPU : public MeanSquaredDisplacement
+    {
+    public:
+    //! Constructs the analyzer
+    MeanSquaredDisplacementGPU(std::shared_ptr<SystemDefinition> sysdef,
+                               std::shared_ptr<ParticleGroup> group);
+
+    //! Destructor
+    virtual ~MeanSquaredDisplacementGPU();
+
+    //! Set autotuner parameters
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        MeanSquaredDisplacement::setAutotunerParams(enable, period);
+        m_tuner->setPeriod(period);
+        m_tuner->setEnabled(enable);
+        }
+
+    protected:
+    GlobalVector<Scalar> m_scratch;     //!< Scratch space for partial sums
+    GlobalArray<Scalar> m_sum;          //!< Sum of the squared displacements
+    std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
+
+    //! Store the unwrapped positions of the local group members in m_reference_pos
+    virtual void setReference();
+
+    //! Sum the squared displacements of the local group members
+    virtual Scalar sumSquaredDisplacements();
+    };
+
+namespace detail
+    {
+//! Exports the MeanSquaredDisplacementGPU class to python
+void export_MeanSquaredDisplacementGPU(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -16,6 +16,41 @@ namespace md
 const unsigned int INVALID_TAG = UINT_MAX;
 const Scalar INVALID_VEL = FLT_MAX; // should be ok, even for double.
 
+#ifdef ENABLE_MPI
+namespace
+    {
+//! Combine the extrema of two ranks
+/*! Each element holds the max extremum followed by the min extremum (momentum, mass, tag). The
+    larger max and the smaller min momentum win, ties resolve to the smaller tag so that all ranks
+    agree on the result.
+*/
+void reduceExtrema(void* invec, void* inoutvec, int* len, MPI_Datatype* datatype)
+    {
+    const Scalar3* in = static_cast<const Scalar3*>(invec);
+    Scalar3* inout = static_cast<Scalar3*>(inoutvec);
+    for (int i = 0; i < *len; i++)
+        {
+        const Scalar3& in_max = in[2 * i];
+        const Scalar3& in_min = in[2 * i + 1];
+        Scalar3& inout_max = inout[2 * i];
+        Scalar3& inout_min = inout[2 * i + 1];
+
+        if (in_max.x > inout_max.x
+            || (in_max.x == inout_max.x
+                && (unsigned int)__scalar_as_int(in_max.z)
+                       < (unsigned int)__scalar_as_int(inout_max.z)))
+            inout_max = in_max;
+
+        if (in_min.x < inout_min.x
+            || (in_min.x == inout_min.x
+                && (unsigned int)__scalar_as_int(in_min.z)
+                       < (unsigned int)__scalar_as_int(inout_min.z)))
+            inout_min = in_min;
+        }
+    }
+    } // end anonymous namespace
+#endif // ENABLE_MPI
+
 MuellerPlatheFlow::MuellerPlatheFlow(std::shared_ptr<SystemDefinition> sysdef,
                                      std::shared_ptr<ParticleGroup> group,
                                      std::shared_ptr<Variant> flow_target,
@@ -52,9 +87,14 @@ MuellerPlatheFlow::MuellerPlatheFlow(std::shared_ptr<SystemDefinition> sysdef,
     m_last_min_vel.z = __int_as_scalar(INVALID_TAG);
 
     m_exec_conf->msg->notice(5) << "Constructing MuellerPlatheFlow " << endl;
+
+#ifdef ENABLE_MPI
+    MPI_Type_contiguous(6, MPI_HOOMD_SCALAR, &m_extrema_type);
+    MPI_Type_commit(&m_extrema_type);
+    MPI_Op_create(reduceExtrema, 1, &m_extrema_op);
+#endif // ENABLE_MPI
+
     this->updateDomainDecomposition();
-    // m_exec_conf->msg->notice(0)<<m_exec_conf->getRank()<<": "<< m_max_swap.gbl_rank<<"
-    // "<<m_min_swap.gbl_rank<<endl;
 
     // Check min max slab.
     this->setMinSlab(m_min_slab);
@@ -66,6 +106,10 @@ MuellerPlatheFlow::~MuellerPlatheFlow(void)
     m_exec_conf->msg->notice(5) << "Destroying MuellerPlatheFlow " << endl;
     m_pdata->getBoxChangeSignal()
         .disconnect<MuellerPlatheFlow, &MuellerPlatheFlow::forceOrthorhombicBoxCheck>(this);
+#ifdef ENABLE_MPI
+    MPI_Op_free(&m_extrema_op);
+    MPI_Type_free(&m_extrema_type);
+#endif // ENABLE_MPI
     }
 
 void MuellerPlatheFlow::update(uint64_t timestep)
@@ -161,9 +205,6 @@ void MuellerPlatheFlow::swapMinMaxSlab(void)
 
     std::swap(m_has_max_slab, m_has_min_slab);
 
-#ifdef ENABLE_MPI
-    std::swap(m_max_swap, m_min_swap);
-#endif // ENABLE_MPI
     m_exec_conf->msg->notice(4) << "MuellerPlatheUpdater swapped min/max slab: "
                                 << this->getMinSlab() << " " << this->getMaxSlab() << endl;
     }
@@ -228,13 +269,6 @@ void MuellerPlatheFlow::updateDomainDecomposition(void)
         m_has_max_slab = false;
         if (my_pos == this->getMaxSlab() / (m_N_slabs / my_grid))
             m_has_max_slab = true;
-
-        // Create the communicator.
-        const int min_color = this->hasMinSlab() ? 0 : MPI_UNDEFINED;
-        initMPISwap(&m_min_swap, min_color);
-
-        const int max_color = this->hasMaxSlab() ? 0 : MPI_UNDEFINED;
-        initMPISwap(&m_max_swap, max_color);
         }
 #endif // ENABLE_MPI
     }
@@ -302,7 +336,7 @@ void MuellerPlatheFlow::searchMinMaxVelocity(void)
                 if (index == this->getMinSlab() && m_last_min_vel.x > vel && this->hasMinSlab())
                     {
                     m_last_min_vel.x = vel;
-                    m_last_max_vel.y = mass;
+                    m_last_min_vel.y = mass;
                     m_last_min_vel.z = __int_as_scalar(h_tag.data[j]);
                     }
                 }
@@ -383,88 +417,24 @@ void MuellerPlatheFlow::verifyOrthorhombicBox(void)
     }
 #ifdef ENABLE_MPI
 
-// Not performance optimized: could be slow. It is meant for init.
-void MuellerPlatheFlow::initMPISwap(struct MPI_SWAP* ms, const int color)
-    {
-    if (ms->initialized && ms->rank != MPI_UNDEFINED)
-        MPI_Comm_free(&(ms->comm));
-
-    MPI_Comm_split(m_exec_conf->getMPICommunicator(), color, m_exec_conf->getRank(), &(ms->comm));
-    if (color != MPI_UNDEFINED)
-        {
-        MPI_Comm_rank(ms->comm, &(ms->rank));
-        MPI_Comm_size(ms->comm, &(ms->size));
-        }
-    else
-        {
-        ms->rank = MPI_UNDEFINED;
-        ms->size = MPI_UNDEFINED;
-        }
-    int send = 0;
-    if (ms->rank == 0)
-        {
-        send = 1;
-        }
-    vector<int> recv;
-    all_gather_v(send, recv, m_exec_conf->getMPICommunicator());
-
-    // ARG_MAX;
-    ms->gbl_rank = -1;
-    for (unsigned int i = 0; i < recv.size(); i++)
-        {
-        if (recv[i] == 1)
-            {
-            assert(ms->gbl_rank == -1);
-            ms->gbl_rank = i;
-            }
-        }
-    assert(ms->gbl_rank > -1);
-    ms->initialized = true;
-    }
-
-void MuellerPlatheFlow::bcastVelToAll(struct MPI_SWAP* ms, Scalar3* vel, const MPI_Op op)
-    {
-    if (ms->rank != MPI_UNDEFINED)
-        {
-        Scalar_Int tmp;
-        tmp.s = vel->x;
-        tmp.i = ms->rank;
-        MPI_Allreduce(MPI_IN_PLACE, &tmp, 1, MPI_HOOMD_SCALAR_INT, op, ms->comm);
-        // Send to subset local rank
-        if (tmp.i != 0)
-            {
-            if (ms->rank == 0)
-                {
-                recv(vel->x, tmp.i, ms->comm);
-                recv(vel->y, tmp.i, ms->comm);
-                recv(vel->z, tmp.i, ms->comm);
-                }
-            if (ms->rank == tmp.i)
-                {
-                send(vel->x, 0, ms->comm);
-                send(vel->y, 0, ms->comm);
-                send(vel->z, 0, ms->comm);
-                }
-            }
-        // ms->rank == 0 has the definite answer
-        }
-    // Broadcast the result to every rank.
-    // This way, each rank can check, whether
-    // it needs to update and can determine the exchanged momentum.
-    bcast(vel->x, ms->gbl_rank, m_exec_conf->getMPICommunicator());
-    bcast(vel->y, ms->gbl_rank, m_exec_conf->getMPICommunicator());
-    bcast(vel->z, ms->gbl_rank, m_exec_conf->getMPICommunicator());
-    }
-
+/*! Every rank needs the extrema: the ranks that own or have ghosts of the particles update their
+    velocities, and all ranks accumulate the exchanged momentum. Ranks without particles in a slab
+    contribute the invalid values, which never win the reduction.
+*/
 void MuellerPlatheFlow::mpiExchangeVelocity(void)
     {
-#ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
-        bcastVelToAll(&m_min_swap, &m_last_min_vel, MPI_MINLOC);
-        bcastVelToAll(&m_max_swap, &m_last_max_vel, MPI_MAXLOC);
+        Scalar3 extrema[2] = {m_last_max_vel, m_last_min_vel};
+        MPI_Allreduce(MPI_IN_PLACE,
+                      extrema,
+                      1,
+                      m_extrema_type,
+                      m_extrema_op,
+                      m_exec_conf->getMPICommunicator());
+        m_last_max_vel = extrema[0];
+        m_last_min_vel = extrema[1];
         }
-#endif // ENABLE_MPI
     }
 
 #endif // ENABLE_MPI
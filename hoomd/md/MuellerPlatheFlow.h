@@ -205,23 +205,11 @@ class PYBIND11_EXPORT MuellerPlatheFlow : public Updater
     //! Returns if box is orthorhombic, but throws a runtime_error, if the box is not orthorhombic.
     void verifyOrthorhombicBox(void);
 #ifdef ENABLE_MPI
-    struct MPI_SWAP
-        {
-        MPI_Comm comm;
-        int rank;
-        int size;
-        int gbl_rank;     //!< global rank of zero in the comm.
-        bool initialized; //!< initialized struct, manually set.
-        MPI_SWAP()
-            : comm(MPI_COMM_NULL), rank(MPI_UNDEFINED), size(MPI_UNDEFINED),
-              gbl_rank(MPI_UNDEFINED), initialized(false)
-            {
-            }
-        };
-    struct MPI_SWAP m_min_swap;
-    struct MPI_SWAP m_max_swap;
-    void initMPISwap(struct MPI_SWAP* ms, const int color);
-    void bcastVelToAll(struct MPI_SWAP* ms, Scalar3* vel, const MPI_Op op);
+    //! MPI datatype of the max and min extrema (two Scalar3)
+    MPI_Datatype m_extrema_type;
+    //! MPI operation that combines the extrema of two ranks
+    MPI_Op m_extrema_op;
+    //! Reduce the extrema found on all ranks in a single MPI_Allreduce
     void mpiExchangeVelocity(void);
 #endif // ENABLE_MPI
     };
@@ -42,14 +42,21 @@ MuellerPlatheFlowGPU::MuellerPlatheFlowGPU(std::shared_ptr<SystemDefinition> sys
         throw std::runtime_error("Error initializing MuellerPlatheFlowGPU");
         }
 
-    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
-    m_tuner.reset(new Autotuner(warp_size,
-                                1024,
-                                warp_size,
-                                5,
-                                100000,
-                                "muellerplatheflow",
-                                this->m_exec_conf));
+    // the search reduces the keys in a tree, it needs power of two block sizes
+    std::vector<unsigned int> valid_params;
+    for (unsigned int block_size = m_exec_conf->dev_prop.warpSize; block_size <= 1024;
+         block_size *= 2)
+        valid_params.push_back(block_size);
+
+    m_tuner.reset(new Autotuner(valid_params, 5, 100000, "muellerplatheflow", this->m_exec_conf));
+
+    GlobalArray<unsigned long long> keys(2, m_exec_conf);
+    m_keys.swap(keys);
+    TAG_ALLOCATION(m_keys);
+
+    GlobalArray<Scalar3> extrema(2, m_exec_conf);
+    m_extrema.swap(extrema);
+    TAG_ALLOCATION(m_extrema);
     }
 
 MuellerPlatheFlowGPU::~MuellerPlatheFlowGPU(void)
@@ -66,46 +73,61 @@ void MuellerPlatheFlowGPU::searchMinMaxVelocity(void)
         return;
     if (m_prof)
         m_prof->push("MuellerPlatheFlowGPU::search");
-    const ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
-                                     access_location::device,
-                                     access_mode::read);
-    const ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
-                                     access_location::device,
-                                     access_mode::read);
-    const ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
-                                          access_location::device,
-                                          access_mode::read);
-    const ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(),
-                                           access_location::device,
-                                           access_mode::read);
-    const GlobalArray<unsigned int>& group_members = m_group->getIndexArray();
-    const ArrayHandle<unsigned int> d_group_members(group_members,
-                                                    access_location::device,
-                                                    access_mode::read);
 
-    const BoxDim& gl_box = m_pdata->getGlobalBox();
+        { // scope the handles so that the extrema can be read on the host
+        const ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                                         access_location::device,
+                                         access_mode::read);
+        const ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                         access_location::device,
+                                         access_mode::read);
+        const ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                              access_location::device,
+                                              access_mode::read);
+        const ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(),
+                                               access_location::device,
+                                               access_mode::read);
+        const GlobalArray<unsigned int>& group_members = m_group->getIndexArray();
+        const ArrayHandle<unsigned int> d_group_members(group_members,
+                                                        access_location::device,
+                                                        access_mode::read);
+
+        ArrayHandle<unsigned long long> d_keys(m_keys,
+                                               access_location::device,
+                                               access_mode::overwrite);
+        ArrayHandle<Scalar3> d_extrema(m_extrema, access_location::device, access_mode::overwrite);
+
+        const BoxDim& gl_box = m_pdata->getGlobalBox();
+
+        m_tuner->begin();
+        kernel::gpu_search_min_max_velocity(group_size,
+                                            d_vel.data,
+                                            d_pos.data,
+                                            d_tag.data,
+                                            d_rtag.data,
+                                            d_group_members.data,
+                                            gl_box,
+                                            this->getNSlabs(),
+                                            this->getMaxSlab(),
+                                            this->getMinSlab(),
+                                            d_keys.data,
+                                            d_extrema.data,
+                                            m_last_max_vel,
+                                            m_last_min_vel,
+                                            this->hasMaxSlab(),
+                                            this->hasMinSlab(),
+                                            m_tuner->getParam(),
+                                            m_flow_direction,
+                                            m_slab_direction);
+        m_tuner->end();
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
 
-    m_tuner->begin();
-    kernel::gpu_search_min_max_velocity(group_size,
-                                        d_vel.data,
-                                        d_pos.data,
-                                        d_tag.data,
-                                        d_rtag.data,
-                                        d_group_members.data,
-                                        gl_box,
-                                        this->getNSlabs(),
-                                        this->getMaxSlab(),
-                                        this->getMinSlab(),
-                                        &m_last_max_vel,
-                                        &m_last_min_vel,
-                                        this->hasMaxSlab(),
-                                        this->hasMinSlab(),
-                                        m_tuner->getParam(),
-                                        m_flow_direction,
-                                        m_slab_direction);
-    m_tuner->end();
-    if (m_exec_conf->isCUDAErrorCheckingEnabled())
-        CHECK_CUDA_ERROR();
+    // read back both extrema at once
+    ArrayHandle<Scalar3> h_extrema(m_extrema, access_location::host, access_mode::read);
+    m_last_max_vel = h_extrema.data[0];
+    m_last_min_vel = h_extrema.data[1];
 
     if (m_prof)
         m_prof->pop();
@@ -7,129 +7,169 @@
 #include "hoomd/HOOMDMath.h"
 #include <assert.h>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
-#include <thrust/device_ptr.h>
-#include <thrust/functional.h>
-#include <thrust/transform_reduce.h>
-#pragma GCC diagnostic pop
-
 namespace hoomd
     {
 namespace md
     {
 namespace kernel
     {
-struct vel_search_un_opt : public thrust::unary_function<const unsigned int, Scalar3>
+//! Map a float to an unsigned int with the same ordering
+__device__ inline unsigned int float_as_orderable_uint(float f)
     {
-    vel_search_un_opt(const Scalar4* const d_vel,
-                      const unsigned int* const d_tag,
-                      flow_enum::Direction flow_direction)
-        : m_vel(d_vel), m_tag(d_tag), m_flow_direction(flow_direction)
-        {
-        }
-    const Scalar4* const m_vel;
-    const unsigned int* const m_tag;
-    const flow_enum::Direction m_flow_direction;
-    __host__ __device__ Scalar3 operator()(const unsigned int idx) const
-        {
-        const unsigned int tag = m_tag[idx];
-        Scalar vel;
-        switch (m_flow_direction)
-            {
-        case flow_enum::X:
-            vel = m_vel[idx].x;
-            break;
-        case flow_enum::Y:
-            vel = m_vel[idx].y;
-            break;
-        case flow_enum::Z:
-            vel = m_vel[idx].z;
-            break;
-            }
-        const Scalar mass = m_vel[idx].w;
-        vel *= mass;
-        Scalar3 result;
-        result.x = vel;
-        result.y = mass;
-        result.z = __int_as_scalar(tag);
-        return result;
-        }
-    };
-template<typename CMP>
-struct vel_search_binary_opt : public thrust::binary_function<Scalar3, Scalar3, Scalar3>
+    unsigned int u = __float_as_uint(f);
+    return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+    }
+
+//! Search the max and min momentum particles in the slabs
+/*! One thread is executed per group member. Each thread packs the momentum of its particle,
+    rounded to single precision and mapped to an ordered unsigned int, into the high 32 bits of a
+    64-bit key and the tag into the low 32 bits. The max key stores the inverted tag, so that ties
+    resolve to the smallest tag in both slabs. The block reduces the keys in shared memory and one
+    thread combines them with d_keys[0] (max) and d_keys[1] (min) with 64-bit atomics.
+
+    2*sizeof(unsigned long long)*block_size of dynamic shared memory are needed. The block size
+    must be a power of two.
+*/
+__global__ void gpu_search_min_max_velocity_kernel(const unsigned int group_size,
+                                                   const Scalar4* const d_vel,
+                                                   const Scalar4* const d_pos,
+                                                   const unsigned int* const d_tag,
+                                                   const unsigned int* const d_group_members,
+                                                   const BoxDim gl_box,
+                                                   const unsigned int Nslabs,
+                                                   const unsigned int max_slab,
+                                                   const unsigned int min_slab,
+                                                   unsigned long long* const d_keys,
+                                                   const bool has_max_slab,
+                                                   const bool has_min_slab,
+                                                   const flow_enum::Direction flow_direction,
+                                                   const flow_enum::Direction slab_direction)
     {
-    vel_search_binary_opt(const unsigned int* const d_rtag,
-                          const Scalar4* const d_pos,
-                          const BoxDim gl_box,
-                          const unsigned int Nslabs,
-                          const unsigned int slab_index,
-                          const Scalar3 invalid,
-                          const flow_enum::Direction slab_direction)
-        : m_rtag(d_rtag), m_pos(d_pos), m_gl_box(gl_box), m_Nslabs(Nslabs),
-          m_slab_index(slab_index), m_invalid(invalid), m_slab_direction(slab_direction)
-        {
-        }
-    const unsigned int* const m_rtag;
-    const Scalar4* const m_pos;
-    const BoxDim m_gl_box;
-    const unsigned int m_Nslabs;
-    const unsigned int m_slab_index;
-    const Scalar3 m_invalid;
-    const flow_enum::Direction m_slab_direction;
+    extern __shared__ unsigned long long mueller_plathe_sdata[];
 
-    __host__ __device__ Scalar3 operator()(const Scalar3& a, const Scalar3& b) const
-        {
-        Scalar3 result = m_invalid;
-        // Early exit, if invalid args involved.
-        if (a.z == m_invalid.z)
-            return b;
-        if (b.z == m_invalid.z)
-            return a;
+    unsigned long long max_key = 0;
+    unsigned long long min_key = ~0ull;
 
-        const unsigned int idx_a = m_rtag[__scalar_as_int(a.z)];
-        const unsigned int idx_b = m_rtag[__scalar_as_int(b.z)];
+    unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (group_idx < group_size)
+        {
+        const unsigned int idx = d_group_members[group_idx];
+        const Scalar4 pos = d_pos[idx];
+        const Scalar3 L = gl_box.getL();
 
-        unsigned int index_a, index_b;
-        switch (m_slab_direction)
+        Scalar frac;
+        switch (slab_direction)
             {
         case flow_enum::X:
-            index_a = (m_pos[idx_a].x / m_gl_box.getL().x + .5) * m_Nslabs;
-            index_b = (m_pos[idx_b].x / m_gl_box.getL().x + .5) * m_Nslabs;
+            frac = pos.x / L.x;
             break;
         case flow_enum::Y:
-            index_a = (m_pos[idx_a].y / m_gl_box.getL().y + .5) * m_Nslabs;
-            index_b = (m_pos[idx_b].y / m_gl_box.getL().y + .5) * m_Nslabs;
+            frac = pos.y / L.y;
             break;
         case flow_enum::Z:
-            index_a = (m_pos[idx_a].z / m_gl_box.getL().z + .5) * m_Nslabs;
-            index_b = (m_pos[idx_b].z / m_gl_box.getL().z + .5) * m_Nslabs;
+            frac = pos.z / L.z;
             break;
             }
-        index_a %= m_Nslabs;
-        index_b %= m_Nslabs;
+        // border cases: wrap periodic box
+        const unsigned int index = ((unsigned int)((frac + Scalar(.5)) * Nslabs)) % Nslabs;
 
-        if (index_a == index_b)
+        const bool in_max_slab = has_max_slab && index == max_slab;
+        const bool in_min_slab = has_min_slab && index == min_slab;
+        if (in_max_slab || in_min_slab)
             {
-            if (index_a == m_slab_index)
+            const Scalar4 vel = d_vel[idx];
+            Scalar momentum;
+            switch (flow_direction)
                 {
-                CMP cmp;
-                if (cmp(a.x, b.x))
-                    result = a;
-                else
-                    result = b;
+            case flow_enum::X:
+                momentum = vel.x * vel.w;
+                break;
+            case flow_enum::Y:
+                momentum = vel.y * vel.w;
+                break;
+            case flow_enum::Z:
+                momentum = vel.z * vel.w;
+                break;
                 }
+
+            const unsigned long long order = float_as_orderable_uint(float(momentum));
+            const unsigned int tag = d_tag[idx];
+            if (in_max_slab)
+                max_key = (order << 32) | (unsigned long long)(~tag);
+            if (in_min_slab)
+                min_key = (order << 32) | (unsigned long long)tag;
             }
-        else
+        }
+
+    mueller_plathe_sdata[threadIdx.x] = max_key;
+    mueller_plathe_sdata[blockDim.x + threadIdx.x] = min_key;
+    __syncthreads();
+
+    // reduce the keys in parallel
+    int offs = blockDim.x >> 1;
+    while (offs > 0)
+        {
+        if (threadIdx.x < offs)
             {
-            if (index_a == m_slab_index)
-                result = a;
-            if (index_b == m_slab_index)
-                result = b;
+            mueller_plathe_sdata[threadIdx.x]
+                = max(mueller_plathe_sdata[threadIdx.x], mueller_plathe_sdata[threadIdx.x + offs]);
+            mueller_plathe_sdata[blockDim.x + threadIdx.x]
+                = min(mueller_plathe_sdata[blockDim.x + threadIdx.x],
+                      mueller_plathe_sdata[blockDim.x + threadIdx.x + offs]);
             }
-        return result;
+        offs >>= 1;
+        __syncthreads();
+        }
+
+    if (threadIdx.x == 0)
+        {
+        if (mueller_plathe_sdata[0] != 0)
+            atomicMax(&d_keys[0], mueller_plathe_sdata[0]);
+        if (mueller_plathe_sdata[blockDim.x] != ~0ull)
+            atomicMin(&d_keys[1], mueller_plathe_sdata[blockDim.x]);
+        }
+    }
+
+//! Look up the exact momentum and mass of the particles selected by the keys
+/*! Thread 0 writes the max extremum to d_extrema[0], thread 1 the min extremum to d_extrema[1].
+ */
+__global__ void gpu_finalize_min_max_velocity_kernel(const unsigned long long* const d_keys,
+                                                     const unsigned int* const d_rtag,
+                                                     const Scalar4* const d_vel,
+                                                     Scalar3* const d_extrema,
+                                                     const Scalar3 invalid_max_vel,
+                                                     const Scalar3 invalid_min_vel,
+                                                     const flow_enum::Direction flow_direction)
+    {
+    unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i >= 2)
+        return;
+
+    const unsigned long long key = d_keys[i];
+    if ((i == 0 && key == 0) || (i == 1 && key == ~0ull))
+        {
+        d_extrema[i] = i == 0 ? invalid_max_vel : invalid_min_vel;
+        return;
         }
-    };
+
+    const unsigned int low = (unsigned int)(key & 0xffffffffull);
+    const unsigned int tag = i == 0 ? ~low : low;
+    const Scalar4 vel = d_vel[d_rtag[tag]];
+    Scalar momentum;
+    switch (flow_direction)
+        {
+    case flow_enum::X:
+        momentum = vel.x * vel.w;
+        break;
+    case flow_enum::Y:
+        momentum = vel.y * vel.w;
+        break;
+    case flow_enum::Z:
+        momentum = vel.z * vel.w;
+        break;
+        }
+    d_extrema[i] = make_scalar3(momentum, vel.w, __int_as_scalar(tag));
+    }
 
 hipError_t gpu_search_min_max_velocity(const unsigned int group_size,
                                        const Scalar4* const d_vel,
@@ -141,41 +181,57 @@ hipError_t gpu_search_min_max_velocity(const unsigned int group_size,
                                        const unsigned int Nslabs,
                                        const unsigned int max_slab,
                                        const unsigned int min_slab,
-                                       Scalar3* const last_max_vel,
-                                       Scalar3* const last_min_vel,
+                                       unsigned long long* const d_keys,
+                                       Scalar3* const d_extrema,
+                                       const Scalar3 invalid_max_vel,
+                                       const Scalar3 invalid_min_vel,
                                        const bool has_max_slab,
                                        const bool has_min_slab,
                                        const unsigned int blocksize,
                                        const flow_enum::Direction flow_direction,
                                        const flow_enum::Direction slab_direction)
     {
-    thrust::device_ptr<const unsigned int> member_ptr(d_group_members);
-
-    vel_search_un_opt un_opt(d_vel, d_tag, flow_direction);
+    // reset the keys: 0 is below and ~0 above all valid keys
+    hipMemset(d_keys, 0, sizeof(unsigned long long));
+    hipMemset(d_keys + 1, 0xff, sizeof(unsigned long long));
 
-    if (has_max_slab)
+    if (group_size > 0)
         {
-        vel_search_binary_opt<thrust::greater<const Scalar>>
-            max_bin_opt(d_rtag, d_pos, gl_box, Nslabs, max_slab, *last_max_vel, slab_direction);
-        Scalar3 init = *last_max_vel;
-        *last_max_vel = thrust::transform_reduce(member_ptr,
-                                                 member_ptr + group_size,
-                                                 un_opt,
-                                                 init,
-                                                 max_bin_opt);
+        dim3 grid(group_size / blocksize + 1, 1, 1);
+        dim3 threads(blocksize, 1, 1);
+        hipLaunchKernelGGL((gpu_search_min_max_velocity_kernel),
+                           dim3(grid),
+                           dim3(threads),
+                           2 * sizeof(unsigned long long) * blocksize,
+                           0,
+                           group_size,
+                           d_vel,
+                           d_pos,
+                           d_tag,
+                           d_group_members,
+                           gl_box,
+                           Nslabs,
+                           max_slab,
+                           min_slab,
+                           d_keys,
+                           has_max_slab,
+                           has_min_slab,
+                           flow_direction,
+                           slab_direction);
         }
 
-    if (has_min_slab)
-        {
-        vel_search_binary_opt<thrust::less<const Scalar>>
-            min_bin_opt(d_rtag, d_pos, gl_box, Nslabs, min_slab, *last_min_vel, slab_direction);
-        Scalar3 init = *last_min_vel;
-        *last_min_vel = thrust::transform_reduce(member_ptr,
-                                                 member_ptr + group_size,
-                                                 un_opt,
-                                                 init,
-                                                 min_bin_opt);
-        }
+    hipLaunchKernelGGL((gpu_finalize_min_max_velocity_kernel),
+                       dim3(1),
+                       dim3(2),
+                       0,
+                       0,
+                       d_keys,
+                       d_rtag,
+                       d_vel,
+                       d_extrema,
+                       invalid_max_vel,
+                       invalid_min_vel,
+                       flow_direction);
 
     return hipPeekAtLastError();
     }
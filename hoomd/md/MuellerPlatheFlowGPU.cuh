@@ -18,6 +18,10 @@ namespace md
     {
 namespace kernel
     {
+//! Search the max and min momentum particles in the slabs in one pass
+/*! Writes the extrema (momentum, mass, tag as Scalar) to d_extrema[0] (max) and d_extrema[1]
+    (min) on the device, or the invalid values when a slab has no particles.
+*/
 hipError_t gpu_search_min_max_velocity(const unsigned int group_size,
                                        const Scalar4* const d_vel,
                                        const Scalar4* const d_pos,
@@ -28,8 +32,10 @@ hipError_t gpu_search_min_max_velocity(const unsigned int group_size,
                                        const unsigned int Nslabs,
                                        const unsigned int max_slab,
                                        const unsigned int min_slab,
-                                       Scalar3* const last_max_vel,
-                                       Scalar3* const last_min_vel,
+                                       unsigned long long* const d_keys,
+                                       Scalar3* const d_extrema,
+                                       const Scalar3 invalid_max_vel,
+                                       const Scalar3 invalid_min_vel,
                                        const bool has_max_slab,
                                        const bool has_min_slab,
                                        const unsigned int blocksize,
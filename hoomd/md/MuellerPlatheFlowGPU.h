@@ -69,6 +69,12 @@ class MuellerPlatheFlowGPU : public MuellerPlatheFlow
     protected:
     std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
 
+    /// Packed (momentum, tag) keys of the max and min momentum particles
+    GlobalArray<unsigned long long> m_keys;
+
+    /// Extrema found in the last search, the max followed by the min
+    GlobalArray<Scalar3> m_extrema;
+
     virtual void searchMinMaxVelocity(void);
     virtual void updateMinMaxVelocity(void);
     };
@@ -8,8 +8,11 @@
 #endif
 
 #include "NeighborList.h"
+#include "NeighborListCompression.h"
+#include "hoomd/AutotunerCache.h"
 #include "hoomd/BondedGroupData.h"
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 
@@ -113,6 +116,11 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar r_bu
     m_n_neigh.swap(n_neigh);
     TAG_ALLOCATION(m_n_neigh);
 
+    // allocate the number of outliers in the compressed list (per particle)
+    GlobalArray<unsigned int> n_outliers(m_pdata->getMaxN(), m_exec_conf);
+    m_n_outliers.swap(n_outliers);
+    TAG_ALLOCATION(m_n_outliers);
+
     // default allocation of 4 neighbors per particle for the neighborlist
     GlobalArray<unsigned int> nlist(4 * m_pdata->getMaxN(), m_exec_conf);
     m_nlist.swap(nlist);
@@ -128,12 +136,16 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar r_bu
     m_Nmax.swap(Nmax);
     TAG_ALLOCATION(m_Nmax);
 
-        // flood Nmax with 4s initially
+        // flood Nmax with 4s initially, or start from the sizes saved in a restart file
         {
+        std::vector<unsigned int> hint = m_sysdef->getSizeHint("nlist/Nmax");
+        if (hint.size() != m_pdata->getNTypes())
+            hint.clear();
+
         ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::overwrite);
         for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
             {
-            h_Nmax.data[i] = 4;
+            h_Nmax.data[i] = hint.empty() ? 4 : std::max(hint[i], 4u);
             }
         }
 
@@ -178,6 +190,11 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar r_bu
     m_last_pos.swap(last_pos);
     TAG_ALLOCATION(m_last_pos);
 
+    // allocate the flags of incremental updates
+    GlobalArray<unsigned int> moved(m_pdata->getMaxN(), m_exec_conf);
+    m_moved.swap(moved);
+    TAG_ALLOCATION(m_moved);
+
     // allocate initial memory allowing 4 exclusions per particle (will grow to match specified
     // exclusions)
 
@@ -190,6 +207,10 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar r_bu
     m_ex_list_tag.swap(ex_list_tag);
     TAG_ALLOCATION(m_ex_list_tag);
 
+    GlobalArray<unsigned int> ex_count_tag(m_pdata->getRTags().size(), 1, m_exec_conf);
+    m_ex_count_tag.swap(ex_count_tag);
+    TAG_ALLOCATION(m_ex_count_tag);
+
     GlobalArray<unsigned int> n_ex_idx(m_pdata->getMaxN(), m_exec_conf);
     m_n_ex_idx.swap(n_ex_idx);
     TAG_ALLOCATION(m_n_ex_idx);
@@ -198,6 +219,19 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar r_bu
     m_ex_list_idx.swap(ex_list_idx);
     TAG_ALLOCATION(m_ex_list_idx);
 
+    // the compact exclusions are sized in updateExListCompact()
+    GlobalArray<uint64_t> ex_mask_tag(1, m_exec_conf);
+    m_ex_mask_tag.swap(ex_mask_tag);
+    TAG_ALLOCATION(m_ex_mask_tag);
+
+    GlobalArray<unsigned int> ex_head_tag(2, m_exec_conf);
+    m_ex_head_tag.swap(ex_head_tag);
+    TAG_ALLOCATION(m_ex_head_tag);
+
+    GlobalArray<unsigned int> ex_tags(1, m_exec_conf);
+    m_ex_tags.swap(ex_tags);
+    TAG_ALLOCATION(m_ex_tags);
+
     // reset exclusions
     resizeAndClearExclusions();
 
@@ -214,9 +248,14 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar r_bu
     m_pdata->getGlobalParticleNumberChangeSignal()
         .connect<NeighborList, &NeighborList::slotGlobalParticleNumberChange>(this);
 
+    // single bond changes update the exclusions in place
+    m_sysdef->getBondData()
+        ->getGroupChangeSignal()
+        .connect<NeighborList, &NeighborList::slotBondChange>(this);
+
     m_sysdef->getBondData()
         ->getGroupNumChangeSignal()
-        .connect<NeighborList, &NeighborList::slotGlobalTopologyNumberChange>(this);
+        .connect<NeighborList, &NeighborList::slotBondNumberChange>(this);
 
     m_sysdef->getAngleData()
         ->getGroupNumChangeSignal()
@@ -271,6 +310,7 @@ void NeighborList::reallocate()
     {
     // resize the exclusions
     m_last_pos.resize(m_pdata->getMaxN());
+    m_moved.resize(m_pdata->getMaxN());
     size_t old_n_ex = m_n_ex_idx.getNumElements();
     m_n_ex_idx.resize(m_pdata->getMaxN());
 
@@ -290,6 +330,7 @@ void NeighborList::reallocate()
     // resize the head list and number of neighbors per particle
     m_head_list.resize(m_pdata->getMaxN());
     m_n_neigh.resize(m_pdata->getMaxN());
+    m_n_outliers.resize(m_pdata->getMaxN());
 
     // force a rebuild
     forceUpdate();
@@ -305,9 +346,13 @@ NeighborList::~NeighborList()
     m_pdata->getGlobalParticleNumberChangeSignal()
         .disconnect<NeighborList, &NeighborList::slotGlobalParticleNumberChange>(this);
 
+    m_sysdef->getBondData()
+        ->getGroupChangeSignal()
+        .disconnect<NeighborList, &NeighborList::slotBondChange>(this);
+
     m_sysdef->getBondData()
         ->getGroupNumChangeSignal()
-        .disconnect<NeighborList, &NeighborList::slotGlobalTopologyNumberChange>(this);
+        .disconnect<NeighborList, &NeighborList::slotBondNumberChange>(this);
 
     m_sysdef->getAngleData()
         ->getGroupNumChangeSignal()
@@ -359,6 +404,7 @@ void NeighborList::compute(uint64_t timestep)
     if (!shouldCompute(timestep) && !m_force_update)
         return;
 
+    int64_t start_time = m_execution_clock.getTime();
     if (m_prof)
         m_prof->push("Neighbor");
 
@@ -383,11 +429,20 @@ void NeighborList::compute(uint64_t timestep)
 
         if (m_exclusions_set)
             updateExListIdx();
+
+        if (m_exclusions_set && checksExclusionsInBuild())
+            updateExListCompact();
         }
 
     // check if the list needs to be updated and update it
     if (needsUpdating(timestep))
         {
+#ifdef ENABLE_MPI
+        // the build reads ghost particle positions
+        if (m_comm)
+            m_comm->finishUpdateGhosts(timestep);
+#endif
+
         // check simulation box size is OK
         checkBoxSize();
 
@@ -401,22 +456,30 @@ void NeighborList::compute(uint64_t timestep)
             // if we overflowed, need to reallocate memory and reset the conditions
             if (overflowed)
                 {
-                // always rebuild the head list after an overflow
+                // always rebuild the head list after an overflow, which moves the lists of all
+                // particles
                 buildHeadList();
+                m_partial_build = false;
 
                 // zero out the conditions for the next build
                 resetConditions();
                 }
             } while (overflowed);
 
-        if (m_exclusions_set)
+        // builds that check the compact exclusions leave no excluded pairs to filter
+        if (m_exclusions_set && !checksExclusionsInBuild())
             filterNlist();
 
+        if (m_compress)
+            compressNlist();
+
         setLastUpdatedPos();
         m_has_been_updated_once = true;
         }
     if (m_prof)
         m_prof->pop();
+
+    m_execution_time += m_execution_clock.getTime() - start_time;
     }
 
 /*! \param num_iters Number of iterations to average for the benchmark
@@ -527,6 +590,7 @@ void NeighborList::updateRList()
             r_cut_max = r_cut_max_i;
         }
     m_rcut_max_max = r_cut_max;
+    m_exec_conf->getAutotunerCache().addCutoff(m_rcut_max_max);
 
     // loop back through and compute the minimum
     // this extra loop guards against some weird case where all of the cutoffs are turned off
@@ -545,6 +609,101 @@ void NeighborList::updateRList()
     m_rcut_changed = false;
     }
 
+/*! \returns The types that have a positive r_cut to at least one type, or an empty list when all
+    types do. Particles of the other types have no neighbors, so cell lists need not bin them.
+*/
+std::vector<unsigned int> NeighborList::getInteractingTypes()
+    {
+    if (m_rcut_changed)
+        updateRList();
+
+    ArrayHandle<Scalar> h_rcut_max(m_rcut_max, access_location::host, access_mode::read);
+    std::vector<unsigned int> types;
+    for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
+        {
+        if (h_rcut_max.data[cur_type] > Scalar(0.0))
+            types.push_back(cur_type);
+        }
+
+    if (types.size() == m_pdata->getNTypes() || types.empty())
+        types.clear();
+    return types;
+    }
+
+/*! \param type_classes Names of the types in each size class
+
+    Every type must be in exactly one class.
+*/
+std::vector<std::vector<unsigned int>>
+NeighborList::getTypeClassIds(const std::vector<std::vector<std::string>>& type_classes)
+    {
+    std::vector<std::vector<unsigned int>> type_class_ids(type_classes.size());
+    std::vector<unsigned int> n_classes(m_pdata->getNTypes(), 0);
+    for (unsigned int cur_class = 0; cur_class < type_classes.size(); ++cur_class)
+        {
+        for (const std::string& name : type_classes[cur_class])
+            {
+            unsigned int type = m_pdata->getTypeByName(name);
+            type_class_ids[cur_class].push_back(type);
+            n_classes[type]++;
+            }
+        }
+
+    if (!type_classes.empty())
+        {
+        for (unsigned int type = 0; type < m_pdata->getNTypes(); ++type)
+            {
+            if (n_classes[type] != 1)
+                {
+                throw std::invalid_argument("Type " + m_pdata->getNameByType(type)
+                                            + " must be in exactly one type class.");
+                }
+            }
+        }
+
+    return type_class_ids;
+    }
+
+/*! \param types Types in the size class
+    \param rstencil Set to the radius that particles of each type search for neighbors in the class
+    \returns The cell width for the class
+
+    The cell width is the smallest list radius of any pair with a neighbor in the class, so that
+    particles of a small class are binned finely even when the other classes have large cutoffs.
+    Types that do not interact with the class have a negative stencil radius (no stencil).
+*/
+Scalar NeighborList::getTypeClassStencil(const std::vector<unsigned int>& types,
+                                         std::vector<Scalar>& rstencil)
+    {
+    if (m_rcut_changed)
+        updateRList();
+
+    Scalar shift = m_diameter_shift ? m_d_max - Scalar(1.0) : Scalar(0.0);
+
+    ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
+    rstencil.assign(m_pdata->getNTypes(), Scalar(-1.0));
+    Scalar r_cut_min = Scalar(0.0);
+    for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
+        {
+        for (unsigned int j : types)
+            {
+            const Scalar r_cut_ij = h_r_cut.data[m_typpair_idx(i, j)];
+            if (r_cut_ij <= Scalar(0.0))
+                continue;
+
+            rstencil[i] = std::max(rstencil[i], r_cut_ij + m_r_buff + shift);
+            if (r_cut_min == Scalar(0.0) || r_cut_ij < r_cut_min)
+                r_cut_min = r_cut_ij;
+            }
+        }
+
+    // a class without interactions keeps the default width
+    if (r_cut_min == Scalar(0.0))
+        return getMinRList();
+
+    return r_cut_min + m_r_buff + shift;
+    }
+
 /*!
  * Check that the largest neighbor search radius is not bigger than twice the shortest box size.
  * Raises an error if this condition is not met. Otherwise, nothing happens.
@@ -616,7 +775,8 @@ Scalar NeighborList::estimateNNeigh()
     \param tag2 TAG (not index) of the second particle in the pair
     \post The pair \a tag1, \a tag2 will not appear in the neighborlist
     \note This only takes effect on the next call to compute() that updates the list
-    \note Duplicates are checked for and not added.
+    \note Duplicates are not added again, but increase the number of sources of the exclusion that
+          removeExclusion() must release before the pair interacts again.
 */
 void NeighborList::addExclusion(unsigned int tag1, unsigned int tag2)
     {
@@ -626,10 +786,33 @@ void NeighborList::addExclusion(unsigned int tag1, unsigned int tag2)
     assert(!m_n_particles_changed);
 
     m_exclusions_set = true;
+    m_ex_compact_changed = true;
 
-    // don't add an exclusion twice
+    // don't add an exclusion twice, count the additional source instead
     if (isExcluded(tag1, tag2))
+        {
+        ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag,
+                                                access_location::host,
+                                                access_mode::read);
+        ArrayHandle<unsigned int> h_ex_count_tag(m_ex_count_tag,
+                                                 access_location::host,
+                                                 access_mode::readwrite);
+
+        for (unsigned int tag : {tag1, tag2})
+            {
+            unsigned int other = (tag == tag1) ? tag2 : tag1;
+            for (unsigned int i = 0; i < h_n_ex_tag.data[tag]; i++)
+                {
+                if (h_ex_list_tag.data[m_ex_list_indexer_tag(tag, i)] == other)
+                    {
+                    h_ex_count_tag.data[m_ex_list_indexer_tag(tag, i)]++;
+                    break;
+                    }
+                }
+            }
         return;
+        }
 
     // this is clunky, but needed due to the fact that we cannot have an array handle in scope when
     // calling grow exclusion list
@@ -661,23 +844,75 @@ void NeighborList::addExclusion(unsigned int tag1, unsigned int tag2)
         ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag,
                                              access_location::host,
                                              access_mode::readwrite);
+        ArrayHandle<unsigned int> h_ex_count_tag(m_ex_count_tag,
+                                                 access_location::host,
+                                                 access_mode::readwrite);
 
         // add tag2 to tag1's exclusion list
         unsigned int pos1 = h_n_ex_tag.data[tag1];
         assert(pos1 < m_ex_list_indexer.getH());
         h_ex_list_tag.data[m_ex_list_indexer_tag(tag1, pos1)] = tag2;
+        h_ex_count_tag.data[m_ex_list_indexer_tag(tag1, pos1)] = 1;
         h_n_ex_tag.data[tag1]++;
 
         // add tag1 to tag2's exclusion list
         unsigned int pos2 = h_n_ex_tag.data[tag2];
         assert(pos2 < m_ex_list_indexer.getH());
         h_ex_list_tag.data[m_ex_list_indexer_tag(tag2, pos2)] = tag1;
+        h_ex_count_tag.data[m_ex_list_indexer_tag(tag2, pos2)] = 1;
         h_n_ex_tag.data[tag2]++;
         }
 
     forceUpdate();
     }
 
+/*! \param tag1 TAG (not index) of the first particle in the pair
+    \param tag2 TAG (not index) of the second particle in the pair
+    \post The pair \a tag1, \a tag2 may appear in the neighborlist again once every source that
+          added the exclusion has released it
+    \note This only takes effect on the next call to compute() that updates the list
+*/
+void NeighborList::removeExclusion(unsigned int tag1, unsigned int tag2)
+    {
+    assert(tag1 <= m_pdata->getMaximumTag());
+    assert(tag2 <= m_pdata->getMaximumTag());
+
+    assert(!m_n_particles_changed);
+
+    ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag,
+                                            access_location::host,
+                                            access_mode::readwrite);
+    ArrayHandle<unsigned int> h_ex_count_tag(m_ex_count_tag,
+                                             access_location::host,
+                                             access_mode::readwrite);
+
+    for (unsigned int tag : {tag1, tag2})
+        {
+        unsigned int other = (tag == tag1) ? tag2 : tag1;
+        unsigned int n = h_n_ex_tag.data[tag];
+        for (unsigned int i = 0; i < n; i++)
+            {
+            unsigned int pos = m_ex_list_indexer_tag(tag, i);
+            if (h_ex_list_tag.data[pos] != other)
+                continue;
+
+            // drop the entry with its last source, moving the last entry into its place
+            if (--h_ex_count_tag.data[pos] == 0)
+                {
+                unsigned int last = m_ex_list_indexer_tag(tag, n - 1);
+                h_ex_list_tag.data[pos] = h_ex_list_tag.data[last];
+                h_ex_count_tag.data[pos] = h_ex_count_tag.data[last];
+                h_n_ex_tag.data[tag]--;
+                }
+            break;
+            }
+        }
+
+    m_ex_compact_changed = true;
+    forceUpdate();
+    }
+
 /*! \post No particles are excluded from the neighbor list
  */
 void NeighborList::resizeAndClearExclusions()
@@ -692,6 +927,7 @@ void NeighborList::resizeAndClearExclusions()
         if (m_ex_list_tag.getPitch() != m_n_ex_tag.getNumElements())
             {
             m_ex_list_tag.resize(m_n_ex_tag.getNumElements(), m_ex_list_tag.getHeight());
+            m_ex_count_tag.resize(m_n_ex_tag.getNumElements(), m_ex_count_tag.getHeight());
             m_ex_list_indexer_tag = Index2D((unsigned int)m_ex_list_tag.getPitch(),
                                             (unsigned int)m_ex_list_tag.getHeight());
             }
@@ -703,6 +939,10 @@ void NeighborList::resizeAndClearExclusions()
     memset(h_n_ex_tag.data, 0, sizeof(unsigned int) * m_n_ex_tag.getNumElements());
     memset(h_n_ex_idx.data, 0, sizeof(unsigned int) * m_n_ex_idx.getNumElements());
     m_exclusions_set = false;
+    m_ex_compact_changed = true;
+
+    // the bonded partners are collected again when the 1-3 or 1-4 exclusions are set
+    m_bond_partners_valid = false;
 
     forceUpdate();
     }
@@ -1062,18 +1302,11 @@ bool NeighborList::isExcluded(unsigned int tag1, unsigned int tag2)
  * This excludes all non-bonded interactions between all pairs particles
  * that are bonded to the same atom.
  * To make the process quasi-linear scaling with system size we first
- * create a 1-d array the collects the number and index of bond partners.
+ * collect the bond partners of each atom, see buildBondPartners().
  */
 void NeighborList::addOneThreeExclusionsFromTopology()
     {
-    std::shared_ptr<BondData> bond_data = m_sysdef->getBondData();
-    const unsigned int myNAtoms = (unsigned int)m_pdata->getRTags().size();
-    const unsigned int MAXNBONDS
-        = 7
-          + 1; //! assumed maximum number of bonds per atom plus one entry for the number of bonds.
-    const unsigned int nBonds = bond_data->getNGlobal();
-
-    if (nBonds == 0)
+    if (m_sysdef->getBondData()->getNGlobal() == 0)
         {
         m_exec_conf->msg->warning()
             << "nlist: No bonds defined while trying to add topology derived 1-3 exclusions"
@@ -1081,62 +1314,22 @@ void NeighborList::addOneThreeExclusionsFromTopology()
         return;
         }
 
-    // build a per atom list with all bonding partners from the list of bonds.
-    unsigned int* localBondList = new unsigned int[MAXNBONDS * myNAtoms];
-    memset((void*)localBondList, 0, sizeof(unsigned int) * MAXNBONDS * myNAtoms);
-
-    for (unsigned int i = 0; i < nBonds; i++)
-        {
-        // loop over all bonds and make a 1D exclusion map
-
-        // FIXME: this will not work when the group tags are not contiguous
-        Bond bondi = bond_data->getGroupByTag(i);
-
-        const unsigned int tagA = bondi.a;
-        const unsigned int tagB = bondi.b;
-
-        // next, increment the number of bonds, and update the tags
-        const unsigned int nBondsA = ++localBondList[tagA * MAXNBONDS];
-        const unsigned int nBondsB = ++localBondList[tagB * MAXNBONDS];
-
-        if (nBondsA >= MAXNBONDS)
-            {
-            std::ostringstream s;
-            s << "Too many bonds to process exclusions for particle with tag: " << tagA << ".";
-            s << "Compile time maximum set to: " << MAXNBONDS - 1 << endl;
-            throw runtime_error(s.str());
-            }
-
-        if (nBondsB >= MAXNBONDS)
-            {
-            std::ostringstream s;
-            s << "Too many bonds to process exclusions for particle with tag: " << tagB << ".";
-            throw runtime_error(s.str());
-            }
-
-        localBondList[tagA * MAXNBONDS + nBondsA] = tagB;
-        localBondList[tagB * MAXNBONDS + nBondsB] = tagA;
-        }
+    if (!m_bond_partners_valid)
+        buildBondPartners();
 
     // now loop over the atoms and build exclusions if we have more than
     // one bonding partner, i.e. we are in the center of an angle.
-    for (unsigned int i = 0; i < myNAtoms; i++)
+    for (const std::vector<unsigned int>& partners : m_bond_partners)
         {
-        // now, loop over all atoms, and find those in the middle of an angle
-        const unsigned int iAtom = i * MAXNBONDS;
-        const unsigned int nBonds = localBondList[iAtom];
-
-        if (nBonds > 1) // need at least two bonds
+        for (unsigned int j = 0; j < partners.size(); ++j)
             {
-            for (unsigned int j = 1; j < nBonds; ++j)
+            for (unsigned int k = j + 1; k < partners.size(); ++k)
                 {
-                for (unsigned int k = j + 1; k <= nBonds; ++k)
-                    addExclusion(localBondList[iAtom + j], localBondList[iAtom + k]);
+                if (partners[j] != partners[k])
+                    addExclusion(partners[j], partners[k]);
                 }
             }
         }
-    // free temp memory
-    delete[] localBondList;
     }
 
 /*! Add topologically derived exclusions for dihedrals
@@ -1145,19 +1338,12 @@ void NeighborList::addOneThreeExclusionsFromTopology()
  * that are connected to a common bond.
  *
  * To make the process quasi-linear scaling with system size we first
- * create a 1-d array the collects the number and index of bond partners.
+ * collect the bond partners of each atom, see buildBondPartners(),
  * and then loop over bonded partners.
  */
 void NeighborList::addOneFourExclusionsFromTopology()
     {
-    std::shared_ptr<BondData> bond_data = m_sysdef->getBondData();
-    const unsigned int myNAtoms = (unsigned int)m_pdata->getRTags().size();
-    const unsigned int MAXNBONDS
-        = 7
-          + 1; //! assumed maximum number of bonds per atom plus one entry for the number of bonds.
-    const unsigned int nBonds = bond_data->getNGlobal();
-
-    if (nBonds == 0)
+    if (m_sysdef->getBondData()->getNGlobal() == 0)
         {
         m_exec_conf->msg->warning()
             << "nlist: No bonds defined while trying to add topology derived 1-4 exclusions"
@@ -1165,68 +1351,176 @@ void NeighborList::addOneFourExclusionsFromTopology()
         return;
         }
 
-    // allocate and clear data.
-    unsigned int* localBondList = new unsigned int[MAXNBONDS * myNAtoms];
-    memset((void*)localBondList, 0, sizeof(unsigned int) * MAXNBONDS * myNAtoms);
+    if (!m_bond_partners_valid)
+        buildBondPartners();
 
-    for (unsigned int i = 0; i < nBonds; i++)
+    // loop over all bonds, visiting each bond from its lower tag
+    for (unsigned int tagA = 0; tagA < m_bond_partners.size(); tagA++)
         {
-        // loop over all bonds and make a 1D exclusion map
-        Bond bondi = bond_data->getGroupByTag(i);
-        const unsigned int tagA = bondi.a;
-        const unsigned int tagB = bondi.b;
+        for (unsigned int tagB : m_bond_partners[tagA])
+            {
+            if (tagB < tagA)
+                continue;
 
-        // next, increment the number of bonds, and update the tags
-        const unsigned int nBondsA = ++localBondList[tagA * MAXNBONDS];
-        const unsigned int nBondsB = ++localBondList[tagB * MAXNBONDS];
+            for (unsigned int tagJ : m_bond_partners[tagA])
+                {
+                if (tagJ == tagB) // skip the bond in the middle of the dihedral
+                    continue;
 
-        if (nBondsA >= MAXNBONDS)
-            {
-            std::ostringstream s;
-            s << "Too many bonds to process exclusions for particle with tag: " << tagA << ".";
-            throw runtime_error(s.str());
-            }
+                for (unsigned int tagK : m_bond_partners[tagB])
+                    {
+                    // skip the bond in the middle of the dihedral and closed triangles
+                    if (tagK == tagA || tagK == tagJ)
+                        continue;
 
-        if (nBondsB >= MAXNBONDS)
-            {
-            std::ostringstream s;
-            s << "Too many bonds to process exclusions for particle with tag: " << tagB << ".";
-            throw runtime_error(s.str());
+                    addExclusion(tagJ, tagK);
+                    }
+                }
             }
+        }
+    }
+
+/*! Collects the bonded partners of every tag in m_bond_partners. A tag bonded twice to the same
+    partner lists it twice.
+*/
+void NeighborList::buildBondPartners()
+    {
+    std::shared_ptr<BondData> bond_data = m_sysdef->getBondData();
+
+    // access bond data by snapshot
+    BondData::Snapshot snapshot;
+    bond_data->takeSnapshot(snapshot);
+
+    // broadcast global bond list
+    std::vector<BondData::members_t> bonds;
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        if (m_exec_conf->getRank() == 0)
+            bonds = snapshot.groups;
 
-        localBondList[tagA * MAXNBONDS + nBondsA] = tagB;
-        localBondList[tagB * MAXNBONDS + nBondsB] = tagA;
+        bcast(bonds, 0, m_exec_conf->getMPICommunicator());
+        }
+    else
+#endif
+        {
+        bonds = snapshot.groups;
         }
 
-    //  loop over all bonds
-    for (unsigned int i = 0; i < nBonds; i++)
+    m_bond_partners.clear();
+    m_bond_partners.resize(m_pdata->getRTags().size());
+    for (const BondData::members_t& bond : bonds)
         {
-        // FIXME: this will not work when the group tags are not contiguous
-        Bond bondi = bond_data->getGroupByTag(i);
-        const unsigned int tagA = bondi.a;
-        const unsigned int tagB = bondi.b;
+        m_bond_partners[bond.tag[0]].push_back(bond.tag[1]);
+        m_bond_partners[bond.tag[1]].push_back(bond.tag[0]);
+        }
 
-        const unsigned int nBondsA = localBondList[tagA * MAXNBONDS];
-        const unsigned int nBondsB = localBondList[tagB * MAXNBONDS];
+    m_bond_partners_valid = true;
+    }
 
-        for (unsigned int j = 1; j <= nBondsA; j++)
-            {
-            const unsigned int tagJ = localBondList[tagA * MAXNBONDS + j];
-            if (tagJ == tagB) // skip the bond in the middle of the dihedral
-                continue;
+/*! \param tag_a Tag of the first particle in the bond
+    \param tag_b Tag of the second particle in the bond
+    \param added True when the bond was added, false when it was removed
 
-            for (unsigned int k = 1; k <= nBondsB; k++)
-                {
-                const unsigned int tagK = localBondList[tagB * MAXNBONDS + k];
-                if (tagK == tagA) // skip the bond in the middle of the dihedral
-                    continue;
+    Adds or removes exactly the exclusions that addExclusionsFromBonds(),
+    addOneThreeExclusionsFromTopology(), and addOneFourExclusionsFromTopology() derive from the
+    bond, so the result matches regenerating all exclusions. The cost depends only on the number of
+    bonds near the changed bond.
+*/
+void NeighborList::updateBondExclusions(unsigned int tag_a, unsigned int tag_b, bool added)
+    {
+    bool one_three = m_exclusions.count("1-3") > 0;
+    bool one_four = m_exclusions.count("1-4") > 0;
 
-                addExclusion(tagJ, tagK);
-                }
+    auto update = [this, added](unsigned int tag1, unsigned int tag2)
+    {
+        if (tag1 == tag2)
+            return;
+
+        if (added)
+            addExclusion(tag1, tag2);
+        else
+            removeExclusion(tag1, tag2);
+    };
+
+    // the partner lists below exclude the changed bond itself
+    auto remove_partner = [this](unsigned int tag, unsigned int partner)
+    {
+        std::vector<unsigned int>& partners = m_bond_partners[tag];
+        partners.erase(std::find(partners.begin(), partners.end(), partner));
+    };
+
+    if (m_bond_partners_valid && !added)
+        {
+        remove_partner(tag_a, tag_b);
+        remove_partner(tag_b, tag_a);
+        }
+
+    if (m_exclusions.count("bond"))
+        update(tag_a, tag_b);
+
+    if (one_three || one_four)
+        {
+        const std::vector<unsigned int>& partners_a = m_bond_partners[tag_a];
+        const std::vector<unsigned int>& partners_b = m_bond_partners[tag_b];
+
+        // the bond forms an angle with every other bond of tag_a and tag_b
+        if (one_three)
+            {
+            for (unsigned int tag_c : partners_a)
+                update(tag_b, tag_c);
+            for (unsigned int tag_c : partners_b)
+                update(tag_a, tag_c);
+            }
+
+        if (one_four)
+            {
+            // the bond is the middle bond of a dihedral
+            for (unsigned int tag_j : partners_a)
+                for (unsigned int tag_k : partners_b)
+                    update(tag_j, tag_k);
+
+            // the bond is an outer bond of a dihedral around the middle bond (tag_a, tag_c)
+            for (unsigned int tag_c : partners_a)
+                for (unsigned int tag_k : m_bond_partners[tag_c])
+                    if (tag_k != tag_a)
+                        update(tag_b, tag_k);
+
+            // the bond is an outer bond of a dihedral around the middle bond (tag_b, tag_c)
+            for (unsigned int tag_c : partners_b)
+                for (unsigned int tag_k : m_bond_partners[tag_c])
+                    if (tag_k != tag_b)
+                        update(tag_a, tag_k);
             }
         }
-    // free temp memory
-    delete[] localBondList;
+
+    if (m_bond_partners_valid && added)
+        {
+        m_bond_partners[tag_a].push_back(tag_b);
+        m_bond_partners[tag_b].push_back(tag_a);
+        }
+    }
+
+/*! \param members Tags of the bond members
+    \param added True when the bond was added, false when it was removed
+
+    Updates the exclusions derived from a single added or removed bond. Other changes to the
+    exclusions regenerate all of them on the next call to compute().
+*/
+void NeighborList::slotBondChange(const BondData::members_t& members, bool added)
+    {
+    // a pending regeneration covers this change as well
+    if (m_n_particles_changed || m_topology_changed)
+        return;
+
+    // the 1-3 and 1-4 exclusions need the bonded partners of the neighboring particles
+    bool needs_partners = m_exclusions.count("1-3") || m_exclusions.count("1-4");
+    if (needs_partners && !m_bond_partners_valid)
+        return;
+
+    updateBondExclusions(members.tag[0], members.tag[1], added);
+    m_bond_change_applied = true;
     }
 
 /*! \returns true If any of the particles have been moved more than 1/2 of the buffer distance since
@@ -1264,6 +1558,14 @@ bool NeighborList::distanceCheck(uint64_t timestep)
     ArrayHandle<Scalar4> h_last_pos(m_last_pos, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_rcut_max(m_rcut_max, access_location::host, access_mode::read);
 
+    // an incremental update flags the particles that moved more than a quarter of the buffer
+    // since their reference position was last reset. Only flagged particles reset their reference
+    // (see setLastUpdatedPos()), so every particle moves less than half the buffer between any
+    // two times since its reference was reset, and two particles approach each other by less than
+    // r_buff after the list that omits the pair was built.
+    bool incremental = m_incremental && supportsIncrementalBuild();
+    ArrayHandle<unsigned int> h_moved(m_moved, access_location::host, access_mode::overwrite);
+
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
         const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
@@ -1277,6 +1579,8 @@ bool NeighborList::distanceCheck(uint64_t timestep)
         // max displacement for each particle (after subtraction of homogeneous dilations)
         const Scalar delta_max = (rmax * lambda_min - old_rmin) / Scalar(2.0);
         Scalar maxsq = (delta_max > 0) ? delta_max * delta_max : 0;
+        if (incremental)
+            maxsq *= Scalar(0.25);
 
         Scalar3 dx = make_scalar3(h_pos.data[i].x - lambda.x * h_last_pos.data[i].x,
                                   h_pos.data[i].y - lambda.y * h_last_pos.data[i].y,
@@ -1284,13 +1588,28 @@ bool NeighborList::distanceCheck(uint64_t timestep)
 
         dx = box.minImage(dx);
 
-        if (dot(dx, dx) >= maxsq)
+        if (incremental)
+            {
+            // flag every particle that moved for the partial build
+            h_moved.data[i] = dot(dx, dx) >= maxsq;
+            result = result || h_moved.data[i];
+            }
+        else if (dot(dx, dx) >= maxsq)
             {
             result = true;
             break;
             }
         }
 
+    // a deforming box moves all particles, and the communicator exchanges all ghost particles
+    // at each update
+    m_partial_build = incremental && result && !m_compress && lambda.x == Scalar(1.0)
+                      && lambda.y == Scalar(1.0) && lambda.z == Scalar(1.0);
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        m_partial_build = false;
+#endif
+
 #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
@@ -1331,10 +1650,18 @@ void NeighborList::setLastUpdatedPos()
     if (m_prof)
         m_prof->push("Dist check");
 
-    // update the last position arrays
-    ArrayHandle<Scalar4> h_last_pos(m_last_pos, access_location::host, access_mode::overwrite);
+    // update the last position arrays, a partial build only resets the reference positions of
+    // the flagged particles. Resetting the other rebuilt particles would let an unflagged
+    // neighbor in a kept list drift further than the buffer allows.
+    ArrayHandle<Scalar4> h_last_pos(m_last_pos,
+                                    access_location::host,
+                                    m_partial_build ? access_mode::readwrite
+                                                    : access_mode::overwrite);
+    ArrayHandle<unsigned int> h_moved(m_moved, access_location::host, access_mode::read);
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
+        if (m_partial_build && !h_moved.data[i])
+            continue;
         h_last_pos.data[i]
             = make_scalar4(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z, Scalar(0.0));
         }
@@ -1373,6 +1700,7 @@ bool NeighborList::needsUpdating(uint64_t timestep)
         }
 
     m_last_checked_tstep = timestep;
+    m_partial_build = false;
 
     if (!m_force_update && !shouldCheckDistance(timestep))
         {
@@ -1442,11 +1770,11 @@ bool NeighborList::needsUpdating(uint64_t timestep)
     // warn the user if this is a dangerous build
     if (result && dangerous)
         {
-        m_exec_conf->msg->notice(2)
-            << "nlist: Dangerous neighborlist build occurred. Continuing this simulation may "
-               "produce incorrect results and/or program crashes. Decrease the neighborlist "
-               "check_period and rerun."
-            << endl;
+        m_exec_conf->msg->noticeRepeated(
+            2,
+            "nlist: Dangerous neighborlist build occurred. Continuing this simulation may produce "
+            "incorrect results and/or program crashes. Decrease the neighborlist check_period and "
+            "rerun.");
         m_dangerous_updates += 1;
         }
 
@@ -1527,6 +1855,92 @@ void NeighborList::updateExListIdx()
         m_prof->pop();
     }
 
+/*! Builds the compact exclusions (see NeighborListExclusions.h) from \c m_n_ex_tag and
+    \c m_ex_list_tag. The compact exclusions are indexed by tag, so they are only rebuilt when the
+    exclusions change.
+*/
+void NeighborList::updateExListCompact()
+    {
+    if (!m_ex_compact_changed)
+        return;
+
+    if (m_prof)
+        m_prof->push("update-ex-compact");
+
+    const unsigned int n_tags = (unsigned int)m_n_ex_tag.getNumElements();
+    if (m_ex_mask_tag.getNumElements() < n_tags)
+        {
+        m_ex_mask_tag.resize(n_tags);
+        m_ex_head_tag.resize(n_tags + 1);
+        }
+
+    // count the exclusions outside of the mask range while filling the masks
+    unsigned int n_remaining = 0;
+        {
+        ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag,
+                                                access_location::host,
+                                                access_mode::read);
+        ArrayHandle<uint64_t> h_ex_mask_tag(m_ex_mask_tag,
+                                            access_location::host,
+                                            access_mode::overwrite);
+        ArrayHandle<unsigned int> h_ex_head_tag(m_ex_head_tag,
+                                                access_location::host,
+                                                access_mode::overwrite);
+
+        for (unsigned int tag = 0; tag < n_tags; tag++)
+            {
+            uint64_t mask = 0;
+            h_ex_head_tag.data[tag] = n_remaining;
+            for (unsigned int offset = 0; offset < h_n_ex_tag.data[tag]; offset++)
+                {
+                unsigned int ex_tag = h_ex_list_tag.data[m_ex_list_indexer_tag(tag, offset)];
+                unsigned int bit;
+                if (detail::nlist_ex_mask_bit(tag, ex_tag, bit))
+                    mask |= uint64_t(1) << bit;
+                else
+                    n_remaining++;
+                }
+            h_ex_mask_tag.data[tag] = mask;
+            }
+        h_ex_head_tag.data[n_tags] = n_remaining;
+        }
+
+    if (m_ex_tags.getNumElements() < n_remaining)
+        m_ex_tags.resize(n_remaining);
+
+    if (n_remaining > 0)
+        {
+        ArrayHandle<unsigned int> h_n_ex_tag(m_n_ex_tag, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_ex_list_tag(m_ex_list_tag,
+                                                access_location::host,
+                                                access_mode::read);
+        ArrayHandle<unsigned int> h_ex_head_tag(m_ex_head_tag,
+                                                access_location::host,
+                                                access_mode::read);
+        ArrayHandle<unsigned int> h_ex_tags(m_ex_tags,
+                                            access_location::host,
+                                            access_mode::overwrite);
+
+        for (unsigned int tag = 0; tag < n_tags; tag++)
+            {
+            unsigned int k = h_ex_head_tag.data[tag];
+            for (unsigned int offset = 0; offset < h_n_ex_tag.data[tag]; offset++)
+                {
+                unsigned int ex_tag = h_ex_list_tag.data[m_ex_list_indexer_tag(tag, offset)];
+                unsigned int bit;
+                if (!detail::nlist_ex_mask_bit(tag, ex_tag, bit))
+                    h_ex_tags.data[k++] = ex_tag;
+                }
+            }
+        }
+
+    m_ex_compact_changed = false;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 /*! Loops through the neighbor list and filters out any excluded pairs
  */
 void NeighborList::filterNlist()
@@ -1584,6 +1998,31 @@ void NeighborList::filterNlist()
         m_prof->pop();
     }
 
+/*! Compresses the list of every particle in place, see NeighborListCompression.h
+ */
+void NeighborList::compressNlist()
+    {
+    if (m_prof)
+        m_prof->push("compress");
+
+    ArrayHandle<size_t> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_n_outliers(m_n_outliers,
+                                           access_location::host,
+                                           access_mode::overwrite);
+
+    for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
+        {
+        h_n_outliers.data[idx] = detail::nlist_compress(h_nlist.data + h_head_list.data[idx],
+                                                        idx,
+                                                        h_n_neigh.data[idx]);
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 /*!
  * Iterates through each particle, and calculates a running sum of the starting index for that
  * particle in the flat array of neighbors.
@@ -1668,6 +2107,13 @@ bool NeighborList::checkConditions()
             }
         }
 
+    if (result)
+        {
+        m_sysdef->raiseSizeHint(
+            "nlist/Nmax",
+            std::vector<unsigned int>(h_Nmax.data, h_Nmax.data + m_pdata->getNTypes()));
+        }
+
     return result;
     }
 
@@ -1684,6 +2130,7 @@ void NeighborList::growExclusionList()
     unsigned int new_height = m_ex_list_indexer.getH() + 1;
 
     m_ex_list_tag.resize(m_pdata->getRTags().size(), new_height);
+    m_ex_count_tag.resize(m_pdata->getRTags().size(), new_height);
     m_ex_list_idx.resize(m_pdata->getMaxN(), new_height);
 
     // update the indexers
@@ -1801,6 +2248,9 @@ void export_NeighborList(pybind11::module& m)
                       &NeighborList::setRebuildCheckDelay)
         .def_property("check_dist", &NeighborList::getDistCheck, &NeighborList::setDistCheck)
         .def("setStorageMode", &NeighborList::setStorageMode)
+        .def("getStorageMode", &NeighborList::getStorageMode)
+        .def_property("compress", &NeighborList::getCompress, &NeighborList::setCompress)
+        .def_property("incremental", &NeighborList::getIncremental, &NeighborList::setIncremental)
         .def_property("exclusions", &NeighborList::getExclusions, &NeighborList::setExclusions)
         .def_property("diameter_shift",
                       &NeighborList::getDiameterShift,
@@ -1816,6 +2266,7 @@ void export_NeighborList(pybind11::module& m)
         .def("estimateNNeigh", &NeighborList::estimateNNeigh)
         .def("getSmallestRebuild", &NeighborList::getSmallestRebuild)
         .def("getNumUpdates", &NeighborList::getNumUpdates)
+        .def("getNumDangerousUpdates", &NeighborList::getNumDangerousUpdates)
         .def("getNumExclusions", &NeighborList::getNumExclusions);
 
     pybind11::enum_<NeighborList::storageMode>(nlist, "storageMode")
@@ -9,9 +9,12 @@
 #include "hoomd/GlobalArray.h"
 #include "hoomd/Index1D.h"
 
+#include "NeighborListExclusions.h"
+
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
 #include <set>
+#include <string>
 #include <vector>
 
 /*! \file NeighborList.h
@@ -108,6 +111,11 @@ namespace md
    removes any particles that are excluded. This allows an arbitrary number of exclusions to be
    processed without slowing the performance of the buildNlist() step itself.
 
+    Builds that return true from checksExclusionsInBuild() instead skip excluded pairs as they
+   build the list, using the compact exclusions of NeighborListExclusions.h (a bit mask of nearby
+   tags plus a CSR list of the rest), and filterNlist() is not called. updateExListCompact() builds
+   the compact exclusions by tag whenever the exclusions change.
+
     <b>Overflow handling:</b>
     For easy support of derived GPU classes to implement overflow detection the overflow condition
    is stored in the GlobalArray \a d_conditions.
@@ -170,6 +178,18 @@ class PYBIND11_EXPORT NeighborList : public Compute
         forceUpdate();
         }
 
+    /** Notify NeighborList that r_cut matrix values have decreased
+
+        The current neighbor list is a superset of the neighbors within the smaller cutoffs, so it
+        remains valid and no update is forced. The r_list values shrink immediately and the next
+        regular update builds the list with them. Consumers must call notifyRCutMatrixChange()
+        when any r_cut value grows.
+    */
+    virtual void notifyRCutMatrixShrink()
+        {
+        m_rcut_signal.emit();
+        }
+
     /** Remove a r_cut matrix
 
     @param r_cut_matrix Matrix to remove
@@ -230,6 +250,34 @@ class PYBIND11_EXPORT NeighborList : public Compute
         forceUpdate();
         }
 
+    //! Set whether the neighbor list is stored in the compressed format
+    /*! \param compress true to compress the list after every build
+
+        See NeighborListCompression.h for the format. Only consumers that read the list with
+        getCompressedNListArray() support compressed lists. The list is compressed in place, so
+        compression reduces the bytes read by the consumers but not the size of m_nlist.
+    */
+    void setCompress(bool compress)
+        {
+        m_compress = compress;
+        forceUpdate();
+        }
+
+    //! Set whether the neighbor list is updated incrementally
+    /*! \param incremental true to rebuild only the lists of particles near moved particles
+
+        When the distance check triggers an update, particles that moved more than a quarter of the
+        buffer distance are flagged and only the lists of particles near them are rebuilt. All
+        other updates rebuild the whole list. Incremental updates are used only by builders that
+        support them, see supportsIncrementalBuild(), and never on compressed lists, in a
+        deforming box, or with domain decomposition.
+    */
+    void setIncremental(bool incremental)
+        {
+        m_incremental = incremental;
+        forceUpdate();
+        }
+
     // @}
     //! \name Get properties
     // @{
@@ -240,6 +288,18 @@ class PYBIND11_EXPORT NeighborList : public Compute
         return m_storage_mode;
         }
 
+    //! Get whether the neighbor list is stored in the compressed format
+    bool getCompress()
+        {
+        return m_compress;
+        }
+
+    //! Get whether the neighbor list is updated incrementally
+    bool getIncremental()
+        {
+        return m_incremental;
+        }
+
     //! Get the maximum of all rcut
     Scalar getMaxRCut()
         {
@@ -301,11 +361,33 @@ class PYBIND11_EXPORT NeighborList : public Compute
         }
 
     //! Get the neighbor list
+    /*! \note Consumers that support compressed lists must use getCompressedNListArray()
+     */
     const GlobalArray<unsigned int>& getNListArray()
+        {
+        if (m_compress)
+            {
+            throw std::runtime_error("This force does not support compressed neighbor lists, "
+                                     "set compress=False.");
+            }
+        return m_nlist;
+        }
+
+    //! Get the neighbor list in either the compressed or the uncompressed format
+    /*! Read neighbors with detail::nlist_get_neighbor() and the number of outliers from
+        getNOutliersArray() when getCompress() is true.
+    */
+    const GlobalArray<unsigned int>& getCompressedNListArray()
         {
         return m_nlist;
         }
 
+    //! Get the number of outliers of each particle in the compressed neighbor list
+    const GlobalArray<unsigned int>& getNOutliersArray()
+        {
+        return m_n_outliers;
+        }
+
     //! Get the head list
     const GlobalArray<size_t>& getHeadList()
         {
@@ -350,6 +432,9 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Exclude a pair of particles from being added to the neighbor list
     void addExclusion(unsigned int tag1, unsigned int tag2);
 
+    //! Release one reference to the exclusion of a pair of particles
+    void removeExclusion(unsigned int tag1, unsigned int tag2);
+
     //! Enable/disable body filtering
     virtual void setFilterBody(bool filter_body)
         {
@@ -464,6 +549,21 @@ class PYBIND11_EXPORT NeighborList : public Compute
         return m_updates + m_forced_updates;
         }
 
+    //! Get the number of dangerous builds since the last call to resetStats()
+    uint64_t getNumDangerousUpdates()
+        {
+        return m_dangerous_updates;
+        }
+
+    //! Get the number of particles per cluster
+    /*! \returns 0 for per-particle neighbor lists. Cluster pair lists (NeighborListGPUCluster)
+        return the number of particles per cluster.
+    */
+    virtual unsigned int getClusterSize()
+        {
+        return 0;
+        }
+
 #ifdef ENABLE_MPI
     //! Returns true if the particle migration criterion is fulfilled
     /*! \param timestep The current timestep
@@ -508,12 +608,16 @@ class PYBIND11_EXPORT NeighborList : public Compute
     bool m_filter_body;    //!< Set to true if particles in the same body are to be filtered
     bool m_diameter_shift; //!< Set to true if the neighborlist rcut(i,j) should be diameter shifted
     storageMode m_storage_mode; //!< The storage mode
+    bool m_compress = false;    //!< True when the list is stored in the compressed format
+    bool m_incremental = false; //!< True when the list may be updated incrementally
 
-    GlobalArray<unsigned int> m_nlist;   //!< Neighbor list data
-    GlobalArray<unsigned int> m_n_neigh; //!< Number of neighbors for each particle
-    GlobalArray<Scalar4> m_last_pos;     //!< coordinates of last updated particle positions
-    Scalar3 m_last_L;                    //!< Box lengths at last update
-    Scalar3 m_last_L_local;              //!< Local Box lengths at last update
+    GlobalArray<unsigned int> m_nlist;      //!< Neighbor list data
+    GlobalArray<unsigned int> m_n_neigh;    //!< Number of neighbors for each particle
+    GlobalArray<unsigned int> m_n_outliers; //!< Number of outliers in the compressed list
+    GlobalArray<Scalar4> m_last_pos;        //!< coordinates of last updated particle positions
+    GlobalArray<unsigned int> m_moved;      //!< Particles flagged by the incremental distance check
+    Scalar3 m_last_L;                       //!< Box lengths at last update
+    Scalar3 m_last_L_local;                 //!< Local Box lengths at last update
 
     GlobalArray<size_t> m_head_list; //!< Indexes for particles to read from the neighbor list
     GlobalArray<unsigned int>
@@ -521,13 +625,22 @@ class PYBIND11_EXPORT NeighborList : public Compute
     GlobalArray<unsigned int>
         m_conditions; //!< Holds the max number of computed particles by type for resizing
 
-    GlobalArray<unsigned int> m_ex_list_tag; //!< List of excluded particles referenced by tag
-    GlobalArray<unsigned int> m_ex_list_idx; //!< List of excluded particles referenced by index
-    GlobalVector<unsigned int> m_n_ex_tag;   //!< Number of exclusions for a given particle tag
-    GlobalArray<unsigned int> m_n_ex_idx;    //!< Number of exclusions for a given particle index
-    Index2D m_ex_list_indexer;               //!< Indexer for accessing the exclusion list
-    Index2D m_ex_list_indexer_tag;           //!< Indexer for accessing the by-tag exclusion list
-    bool m_exclusions_set;                   //!< True if any exclusions have been set
+    GlobalArray<unsigned int> m_ex_list_tag;  //!< List of excluded particles referenced by tag
+    GlobalArray<unsigned int> m_ex_count_tag; //!< Number of sources of each exclusion
+    GlobalArray<unsigned int> m_ex_list_idx;  //!< List of excluded particles referenced by index
+    GlobalVector<unsigned int> m_n_ex_tag;    //!< Number of exclusions for a given particle tag
+    GlobalArray<unsigned int> m_n_ex_idx;     //!< Number of exclusions for a given particle index
+    Index2D m_ex_list_indexer;                //!< Indexer for accessing the exclusion list
+    Index2D m_ex_list_indexer_tag;            //!< Indexer for accessing the by-tag exclusion list
+    bool m_exclusions_set;                    //!< True if any exclusions have been set
+
+    GlobalArray<uint64_t> m_ex_mask_tag;      //!< Exclusions of each tag within the mask range
+    GlobalArray<unsigned int> m_ex_head_tag;  //!< Start of the remaining exclusions of each tag
+    GlobalArray<unsigned int> m_ex_tags;      //!< Excluded tags outside of the mask range
+    bool m_ex_compact_changed = true;         //!< True when the compact exclusions are out of date
+
+    /// True when the current build only rebuilds the lists of some particles, see buildNlist()
+    bool m_partial_build = false;
 
     /// True if the number of particles has changed.
     bool m_n_particles_changed = false;
@@ -550,20 +663,53 @@ class PYBIND11_EXPORT NeighborList : public Compute
     virtual void setLastUpdatedPos();
 
     //! Builds the neighbor list
+    /*! When m_partial_build is set, implementations rebuild at least the lists of all particles
+        within the list cutoff of a particle flagged in m_moved and keep the lists of the other
+        particles.
+    */
     virtual void buildNlist(uint64_t timestep);
 
+    //! Test if buildNlist() implements partial builds
+    virtual bool supportsIncrementalBuild()
+        {
+        return false;
+        }
+
+    //! Test if buildNlist() skips the excluded pairs itself
+    virtual bool checksExclusionsInBuild()
+        {
+        return false;
+        }
+
     //! Updates the idx exclusion list
     virtual void updateExListIdx();
 
+    //! Updates the compact exclusions read by builds that check exclusions
+    void updateExListCompact();
+
     //! Loops through all pairs, and updates the r_list(i,j)
     void updateRList();
 
+    //! Get the type ids in each size class and check that the classes partition the types
+    std::vector<std::vector<unsigned int>>
+    getTypeClassIds(const std::vector<std::vector<std::string>>& type_classes);
+
+    //! Get the types with a positive r_cut to at least one type, for CellList::setTypeFilter()
+    std::vector<unsigned int> getInteractingTypes();
+
+    //! Get the cell width and the per-type stencil radii to search the neighbors in a size class
+    Scalar getTypeClassStencil(const std::vector<unsigned int>& types,
+                               std::vector<Scalar>& rstencil);
+
     //! Checks that box is big enough for neighbor list cutoff
     void checkBoxSize();
 
     //! Filter the neighbor list of excluded particles
     virtual void filterNlist();
 
+    //! Compress the neighbor list in place
+    virtual void compressNlist();
+
     //! Build the head list to allocated memory
     virtual void buildHeadList();
 
@@ -627,7 +773,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
     void reallocate();
 
     //! Check the status of the conditions
-    bool checkConditions();
+    virtual bool checkConditions();
 
     //! Resets the condition status to all zeroes
     virtual void resetConditions();
@@ -647,6 +793,34 @@ class PYBIND11_EXPORT NeighborList : public Compute
         m_topology_changed = true;
         }
 
+    //! Method to be called when a bond is added or removed
+    void slotBondChange(const BondData::members_t& members, bool added);
+
+    //! Method to be called when the global bond number changes
+    void slotBondNumberChange()
+        {
+        // slotBondChange() has already updated the exclusions of a single added or removed bond
+        if (m_bond_change_applied)
+            m_bond_change_applied = false;
+        else
+            m_topology_changed = true;
+        }
+
+    /// Bonded partners of each tag, used to derive the 1-3 and 1-4 exclusions
+    std::vector<std::vector<unsigned int>> m_bond_partners;
+
+    /// True when m_bond_partners matches the bond data
+    bool m_bond_partners_valid = false;
+
+    /// True when slotBondChange() has updated the exclusions for the last bond number change
+    bool m_bond_change_applied = false;
+
+    //! Collect the bonded partners of each tag from the bond data
+    void buildBondPartners();
+
+    //! Add or remove the bond derived exclusions of one bond
+    void updateBondExclusions(unsigned int tag_a, unsigned int tag_b, bool added);
+
     //! Clear all existing exclusions
     void resizeAndClearExclusions();
 
@@ -679,11 +853,89 @@ class PYBIND11_EXPORT NeighborList : public Compute
 #endif
     };
 
+/// Allow the usage of NeighborList arrays in Python.
+/** Uses the LocalDataAccess templated class to expose the neighbor list of the local particles to
+ *  Python. The neighbors of local particle i are nlist[head_list[i] + n] for n in
+ *  [0, n_neigh[i]). The arrays are read only and reflect the most recent neighbor list build.
+ *
+ *  Template Parameters
+ *  Output: The buffer output type (either HOOMDHostBuffer or HOOMDDeviceBuffer)
+ */
+template<class Output>
+class PYBIND11_EXPORT LocalNeighborListData : public LocalDataAccess<Output, NeighborList>
+    {
+    public:
+    LocalNeighborListData(NeighborList& data, ParticleData& pdata)
+        : LocalDataAccess<Output, NeighborList>(data), m_nlist(data), m_pdata(pdata),
+          m_head_list_handle(), m_n_neigh_handle(), m_nlist_handle()
+        {
+        }
+
+    virtual ~LocalNeighborListData() = default;
+
+    Output getHeadList()
+        {
+        return this->template getArrayBuffer<size_t, size_t>(
+            m_head_list_handle,
+            m_nlist.getHeadList(),
+            std::vector<ssize_t>({m_pdata.getN()}),
+            std::vector<ssize_t>({sizeof(size_t)}));
+        }
+
+    Output getNNeigh()
+        {
+        return this->template getArrayBuffer<unsigned int, unsigned int>(
+            m_n_neigh_handle,
+            m_nlist.getNNeighArray(),
+            std::vector<ssize_t>({m_pdata.getN()}),
+            std::vector<ssize_t>({sizeof(unsigned int)}));
+        }
+
+    Output getNList()
+        {
+        const GlobalArray<unsigned int>& nlist = m_nlist.getNListArray();
+        return this->template getArrayBuffer<unsigned int, unsigned int>(
+            m_nlist_handle,
+            nlist,
+            std::vector<ssize_t>({(ssize_t)nlist.getNumElements()}),
+            std::vector<ssize_t>({sizeof(unsigned int)}));
+        }
+
+    protected:
+    void clear()
+        {
+        m_head_list_handle.reset(nullptr);
+        m_n_neigh_handle.reset(nullptr);
+        m_nlist_handle.reset(nullptr);
+        }
+
+    private:
+    NeighborList& m_nlist;
+    ParticleData& m_pdata;
+    std::unique_ptr<ArrayHandle<size_t>> m_head_list_handle;
+    std::unique_ptr<ArrayHandle<unsigned int>> m_n_neigh_handle;
+    std::unique_ptr<ArrayHandle<unsigned int>> m_nlist_handle;
+    };
+
 namespace detail
     {
 //! Exports NeighborList to python
 void export_NeighborList(pybind11::module& m);
 
+/// Export local access to NeighborList
+template<class Output> void export_LocalNeighborListData(pybind11::module& m, std::string name)
+    {
+    pybind11::class_<LocalNeighborListData<Output>, std::shared_ptr<LocalNeighborListData<Output>>>(
+        m,
+        name.c_str())
+        .def(pybind11::init<NeighborList&, ParticleData&>())
+        .def("getHeadList", &LocalNeighborListData<Output>::getHeadList)
+        .def("getNNeigh", &LocalNeighborListData<Output>::getNNeigh)
+        .def("getNList", &LocalNeighborListData<Output>::getNList)
+        .def("enter", &LocalNeighborListData<Output>::enter)
+        .def("exit", &LocalNeighborListData<Output>::exit);
+    }
+
     } // end namespace detail
     } // end namespace md
     } // end namespace hoomd
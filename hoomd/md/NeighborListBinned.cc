@@ -13,6 +13,12 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 
 namespace hoomd
@@ -45,6 +51,12 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
             rmax += m_d_max - Scalar(1.0);
 
         m_cl->setNominalWidth(rmax);
+
+        // particles of types without any interactions have no neighbors, leave them out
+        std::vector<unsigned int> types = getInteractingTypes();
+        if (types != m_cl->getTypeFilter())
+            m_cl->setTypeFilter(types);
+
         m_update_cell_size = false;
         }
 
@@ -65,6 +77,19 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
                                    access_location::host,
                                    access_mode::read);
 
+    // access the compact exclusions
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<uint64_t> h_ex_mask_tag(m_ex_mask_tag, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_head_tag(m_ex_head_tag,
+                                            access_location::host,
+                                            access_mode::read);
+    ArrayHandle<unsigned int> h_ex_tags(m_ex_tags, access_location::host, access_mode::read);
+    nlist_exclusions_t ex;
+    ex.tag = h_tag.data;
+    ex.ex_mask = m_exclusions_set ? h_ex_mask_tag.data : nullptr;
+    ex.ex_head = h_ex_head_tag.data;
+    ex.ex_tags = h_ex_tags.data;
+
     const BoxDim& box = m_pdata->getBox();
 
     // access the rlist data
@@ -88,8 +113,11 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
     ArrayHandle<unsigned int> h_conditions(m_conditions,
                                            access_location::host,
                                            access_mode::readwrite);
-    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
-    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
+    // a partial build keeps the lists of the particles it does not rebuild
+    const access_mode::Enum nlist_mode
+        = m_partial_build ? access_mode::readwrite : access_mode::overwrite;
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, nlist_mode);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, nlist_mode);
 
     // access indexers
     Index3D ci = m_cl->getCellIndexer();
@@ -102,14 +130,75 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
     // for each local particle
     unsigned int nparticles = m_pdata->getN();
 
-    for (int i = 0; i < (int)nparticles; i++)
+    // a partial build rebuilds the particles in all cells next to a cell that holds a moved
+    // particle, which includes every particle within the list cutoff of a moved particle
+    std::vector<unsigned char> cell_rebuild;
+    if (m_partial_build)
+        {
+        ArrayHandle<unsigned int> h_moved(m_moved, access_location::host, access_mode::read);
+        cell_rebuild.resize(ci.getNumElements(), 0);
+        for (unsigned int cur_cell = 0; cur_cell < ci.getNumElements(); cur_cell++)
+            {
+            bool cell_moved = false;
+            for (unsigned int cur_offset = 0; cur_offset < h_cell_size.data[cur_cell]; cur_offset++)
+                {
+                unsigned int cur_p = __scalar_as_int(h_cell_xyzf.data[cli(cur_offset, cur_cell)].w);
+                cell_moved = cell_moved || (cur_p < nparticles && h_moved.data[cur_p]);
+                }
+
+            if (cell_moved)
+                for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
+                    cell_rebuild[h_cell_adj.data[cadji(cur_adj, cur_cell)]] = 1;
+            }
+        }
+
+    // with some non-interacting type pairs, skip the adjacent cells that hold no particle of a type
+    // that interacts with type i
+    const unsigned int n_types = m_pdata->getNTypes();
+    std::vector<uint64_t> type_mask;
+    std::vector<uint64_t> cell_type_mask;
+    if (n_types <= 64)
         {
+        bool all_interact = true;
+        type_mask.resize(n_types, 0);
+        for (unsigned int type_i = 0; type_i < n_types; type_i++)
+            for (unsigned int type_j = 0; type_j < n_types; type_j++)
+                {
+                if (h_r_cut.data[m_typpair_idx(type_i, type_j)] > Scalar(0.0))
+                    type_mask[type_i] |= uint64_t(1) << type_j;
+                else
+                    all_interact = false;
+                }
+
+        if (all_interact)
+            {
+            type_mask.clear();
+            }
+        else
+            {
+            cell_type_mask.resize(ci.getNumElements(), 0);
+            for (unsigned int cur_cell = 0; cur_cell < ci.getNumElements(); cur_cell++)
+                for (unsigned int cur_offset = 0; cur_offset < h_cell_size.data[cur_cell];
+                     cur_offset++)
+                    {
+                    unsigned int cur_p
+                        = __scalar_as_int(h_cell_xyzf.data[cli(cur_offset, cur_cell)].w);
+                    cell_type_mask[cur_cell] |= uint64_t(1)
+                                                << __scalar_as_int(h_pos.data[cur_p].w);
+                    }
+            }
+        }
+
+    // build the neighbors of particle i, recording overflows in the given conditions array
+    auto build_particle_nlist = [&](unsigned int i, unsigned int* conditions)
+    {
         unsigned int cur_n_neigh = 0;
 
         const Scalar3 my_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
         const unsigned int body_i = h_body.data[i];
         const Scalar diam_i = h_diameter.data[i];
+        const unsigned int tag_i = h_tag.data[i];
 
         const unsigned int Nmax_i = h_Nmax.data[type_i];
         const size_t head_idx_i = h_head_list.data[i];
@@ -131,11 +220,25 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
         // identify the bin
         unsigned int my_cell = ci(ib, jb, kb);
 
+        if (m_partial_build && !cell_rebuild[my_cell])
+            return;
+
+        // particles of a type without any interactions have no neighbors
+        if (!type_mask.empty() && !type_mask[type_i])
+            {
+            h_n_neigh.data[i] = 0;
+            return;
+            }
+
         // loop through all neighboring bins
         for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
             {
             unsigned int neigh_cell = h_cell_adj.data[cadji(cur_adj, my_cell)];
 
+            // skip bins without any particle that interacts with type i
+            if (!type_mask.empty() && !(cell_type_mask[neigh_cell] & type_mask[type_i]))
+                continue;
+
             // check against all the particles in that neighboring bin to see if it is a neighbor
             unsigned int size = h_cell_size.data[neigh_cell];
             for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
@@ -151,7 +254,7 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
                 // (1) they are the same particle, or
                 // (2) the r_cut(i,j) indicates to skip, or
                 // (3) they are in the same body
-                bool excluded = ((i == (int)cur_neigh) || (r_cut <= Scalar(0.0)));
+                bool excluded = ((i == cur_neigh) || (r_cut <= Scalar(0.0)));
                 if (m_filter_body && body_i != NO_BODY)
                     excluded = excluded | (body_i == h_body.data[cur_neigh]);
                 if (excluded)
@@ -176,9 +279,13 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
 
                 // move the squared rlist by the diameter shift if necessary
                 Scalar r_listsq = h_r_listsq.data[m_typpair_idx(type_i, cur_neigh_type)];
+                // check the exclusions only for the pairs within the list cutoff
+                if (dr_sq <= (r_listsq + sqshift) && ex.ex_mask)
+                    excluded = detail::nlist_is_excluded(tag_i, h_tag.data[cur_neigh], ex);
+
                 if (dr_sq <= (r_listsq + sqshift) && !excluded)
                     {
-                    if (m_storage_mode == full || i < (int)cur_neigh)
+                    if (m_storage_mode == full || i < cur_neigh)
                         {
                         // local neighbor
                         if (cur_n_neigh < Nmax_i)
@@ -186,8 +293,7 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
                             h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
                             }
                         else
-                            h_conditions.data[type_i]
-                                = max(h_conditions.data[type_i], cur_n_neigh + 1);
+                            conditions[type_i] = max(conditions[type_i], cur_n_neigh + 1);
 
                         cur_n_neigh++;
                         }
@@ -196,6 +302,38 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
             }
 
         h_n_neigh.data[i] = cur_n_neigh;
+    };
+
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        // rows are independent once the head list is set, only the overflow conditions are shared
+        tbb::enumerable_thread_specific<std::vector<unsigned int>> thread_conditions(
+            std::vector<unsigned int>(n_types, 0));
+
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                m_exec_conf->parallelFor(
+                    0,
+                    nparticles,
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                        unsigned int* conditions = thread_conditions.local().data();
+                        for (unsigned int i = r.begin(); i != r.end(); ++i)
+                            build_particle_nlist(i, conditions);
+                    });
+            }); // end task arena execute()
+
+        for (const auto& conditions : thread_conditions)
+            for (unsigned int t = 0; t < n_types; ++t)
+                h_conditions.data[t] = max(h_conditions.data[t], conditions[t]);
+        }
+    else
+#endif
+        {
+        for (unsigned int i = 0; i < nparticles; i++)
+            build_particle_nlist(i, h_conditions.data);
         }
 
     if (m_prof)
@@ -212,7 +350,8 @@ void export_NeighborListBinned(pybind11::module& m)
         .def(pybind11::init<std::shared_ptr<SystemDefinition>, Scalar>())
         .def_property("deterministic",
                       &NeighborListBinned::getDeterministic,
-                      &NeighborListBinned::setDeterministic);
+                      &NeighborListBinned::setDeterministic)
+        .def("getCellList", &NeighborListBinned::getCellList);
     }
 
     } // end namespace detail
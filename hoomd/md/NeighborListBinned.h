@@ -44,6 +44,13 @@ class PYBIND11_EXPORT NeighborListBinned : public NeighborList
         NeighborList::notifyRCutMatrixChange();
         }
 
+    /// Notify NeighborList that r_cut matrix values have decreased
+    virtual void notifyRCutMatrixShrink()
+        {
+        m_update_cell_size = true;
+        NeighborList::notifyRCutMatrixShrink();
+        }
+
     /// Make the neighborlist deterministic
     void setDeterministic(bool deterministic)
         {
@@ -56,6 +63,12 @@ class PYBIND11_EXPORT NeighborListBinned : public NeighborList
         return m_cl->getSortCellList();
         }
 
+    /// Get the cell list
+    std::shared_ptr<CellList> getCellList()
+        {
+        return m_cl;
+        }
+
     protected:
     std::shared_ptr<CellList> m_cl; //!< The cell list
 
@@ -64,6 +77,18 @@ class PYBIND11_EXPORT NeighborListBinned : public NeighborList
 
     //! Builds the neighbor list
     virtual void buildNlist(uint64_t timestep);
+
+    //! Partial builds rebuild the particles in the cells next to cells with moved particles
+    virtual bool supportsIncrementalBuild()
+        {
+        return true;
+        }
+
+    //! The build skips excluded pairs
+    virtual bool checksExclusionsInBuild()
+        {
+        return true;
+        }
     };
 
 namespace detail
@@ -0,0 +1,219 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file NeighborListBufferTuner.cc
+    \brief Defines the NeighborListBufferTuner class
+*/
+
+#include "NeighborListBufferTuner.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System the neighbor list belongs to
+    \param trigger Select the time steps at which samples end
+    \param nlist Neighbor list to tune
+    \param min_buffer Smallest buffer to try
+    \param max_buffer Largest buffer to try
+*/
+NeighborListBufferTuner::NeighborListBufferTuner(std::shared_ptr<SystemDefinition> sysdef,
+                                                 std::shared_ptr<Trigger> trigger,
+                                                 std::shared_ptr<NeighborList> nlist,
+                                                 Scalar min_buffer,
+                                                 Scalar max_buffer)
+    : Tuner(sysdef, trigger), m_nlist(nlist), m_min_buffer(0), m_max_buffer(max_buffer)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing NeighborListBufferTuner" << endl;
+    setMinBuffer(min_buffer);
+    setMaxBuffer(max_buffer);
+    }
+
+NeighborListBufferTuner::~NeighborListBufferTuner()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying NeighborListBufferTuner" << endl;
+    }
+
+void NeighborListBufferTuner::setMinBuffer(Scalar min_buffer)
+    {
+    if (min_buffer <= Scalar(0.0))
+        throw invalid_argument("min_buffer must be positive.");
+    m_min_buffer = min_buffer;
+    }
+
+void NeighborListBufferTuner::setMaxBuffer(Scalar max_buffer)
+    {
+    if (max_buffer < m_min_buffer)
+        throw invalid_argument("max_buffer must not be smaller than min_buffer.");
+    m_max_buffer = max_buffer;
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void NeighborListBufferTuner::startSample(uint64_t timestep)
+    {
+    m_sampling = true;
+    m_sample_timestep = timestep;
+    m_sample_time = m_clock.getTime();
+    m_sample_nlist_time = m_nlist->getExecutionTime();
+    m_sample_dangerous = m_nlist->getNumDangerousUpdates();
+    }
+
+/*! \returns The next buffer to try, or m_best_buffer after setting m_tuned when the search has
+    converged
+*/
+Scalar NeighborListBufferTuner::nextTrial()
+    {
+    while (true)
+        {
+        // try the other direction first, then refine the step
+        if (m_direction > 0)
+            {
+            m_direction = -1;
+            }
+        else
+            {
+            m_direction = 1;
+            m_step *= Scalar(0.5);
+            if (m_step < m_tolerance)
+                {
+                m_tuned = true;
+                return m_best_buffer;
+                }
+            }
+
+        Scalar trial = m_best_buffer * (Scalar(1.0) + Scalar(m_direction) * m_step);
+        trial = std::min(std::max(trial, m_min_buffer), m_max_buffer);
+        if (trial != m_best_buffer)
+            return trial;
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void NeighborListBufferTuner::update(uint64_t timestep)
+    {
+    Updater::update(timestep);
+
+    if (!m_sampling)
+        {
+        startSample(timestep);
+        return;
+        }
+
+    if (timestep <= m_sample_timestep)
+        return;
+
+    uint64_t n_steps = timestep - m_sample_timestep;
+    double time_per_step = double(m_clock.getTime() - m_sample_time) / 1e9 / double(n_steps);
+    double nlist_time_per_step
+        = (m_nlist->getExecutionTime() - m_sample_nlist_time) / double(n_steps);
+
+#ifdef ENABLE_MPI
+    // all ranks must choose the same buffer
+    if (m_sysdef->isDomainDecomposed())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &time_per_step,
+                      1,
+                      MPI_DOUBLE,
+                      MPI_MAX,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    // the neighbor list statistics were reset during the sample
+    if (m_nlist->getNumDangerousUpdates() < m_sample_dangerous)
+        {
+        startSample(timestep);
+        return;
+        }
+
+    // discard samples with dangerous builds and check more often
+    if (m_nlist->getNumDangerousUpdates() > m_sample_dangerous)
+        {
+        uint64_t delay = m_nlist->getRebuildCheckDelay();
+        if (delay > 1)
+            {
+            m_nlist->setRebuildCheckDelay(delay / 2);
+            m_exec_conf->msg->notice(2)
+                << "NeighborListBufferTuner: dangerous builds occurred, reducing the rebuild check "
+                   "delay to "
+                << delay / 2 << endl;
+            }
+        startSample(timestep);
+        return;
+        }
+
+    Scalar buffer = m_nlist->getRBuff();
+    m_exec_conf->msg->notice(6) << "NeighborListBufferTuner: buffer " << buffer << ": "
+                                << time_per_step * 1e3 << " ms per step, "
+                                << nlist_time_per_step * 1e3 << " ms in the neighbor list"
+                                << endl;
+
+    if (!m_tuned)
+        {
+        Scalar trial;
+        if (!m_has_best || time_per_step < m_best_time_per_step)
+            {
+            // keep moving in the same direction while the time per step decreases
+            m_has_best = true;
+            m_best_buffer = buffer;
+            m_best_time_per_step = time_per_step;
+            trial = m_best_buffer * (Scalar(1.0) + Scalar(m_direction) * m_step);
+            trial = std::min(std::max(trial, m_min_buffer), m_max_buffer);
+            if (trial == m_best_buffer)
+                trial = nextTrial();
+            }
+        else
+            {
+            trial = nextTrial();
+            }
+
+        m_nlist->setRBuff(trial);
+
+        if (m_tuned)
+            {
+            // check for builds no more often than needed by the fastest rebuilds so far
+            uint64_t delay = std::max(uint64_t(1), uint64_t(m_nlist->getSmallestRebuild() / 2));
+            if (delay > m_nlist->getRebuildCheckDelay())
+                m_nlist->setRebuildCheckDelay(delay);
+
+            m_exec_conf->msg->notice(4)
+                << "NeighborListBufferTuner: tuned buffer " << m_best_buffer
+                << ", rebuild check delay " << m_nlist->getRebuildCheckDelay() << endl;
+            }
+        }
+
+    startSample(timestep);
+    }
+
+namespace detail
+    {
+void export_NeighborListBufferTuner(pybind11::module& m)
+    {
+    pybind11::class_<NeighborListBufferTuner, Tuner, std::shared_ptr<NeighborListBufferTuner>>(
+        m,
+        "NeighborListBufferTuner")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<Trigger>,
+                            std::shared_ptr<NeighborList>,
+                            Scalar,
+                            Scalar>())
+        .def_property("min_buffer",
+                      &NeighborListBufferTuner::getMinBuffer,
+                      &NeighborListBufferTuner::setMinBuffer)
+        .def_property("max_buffer",
+                      &NeighborListBufferTuner::getMaxBuffer,
+                      &NeighborListBufferTuner::setMaxBuffer)
+        .def_property_readonly("tuned", &NeighborListBufferTuner::isTuned);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,126 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file NeighborListBufferTuner.h
+    \brief Declares a tuner that adjusts the neighbor list buffer to minimize the time per step
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "NeighborList.h"
+#include "hoomd/ClockSource.h"
+#include "hoomd/Tuner.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+
+#ifndef __NEIGHBORLISTBUFFERTUNER_H__
+#define __NEIGHBORLISTBUFFERTUNER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Tunes the neighbor list buffer and check period
+/*! A larger buffer makes neighbor list builds less frequent, but adds neighbors that every pair
+    force must skip. NeighborListBufferTuner measures the wall clock time per step between calls to
+    update(), which includes both the neighbor list builds and the force evaluations, and searches
+    for the buffer that minimizes it.
+
+    Each call to update() ends the current sample and starts the next one with a new trial buffer
+    \a b. Trials move from the best buffer \a b* to <code>b*(1 + s)</code>, or to
+    <code>b*(1 - s)</code> when the larger buffer is slower. The relative step \a s is halved
+    when neither trial improves on \a b*. Once \a s drops below the tolerance, the tuner sets the
+    buffer to \a b* and increases the rebuild check delay to half of the shortest rebuild period.
+
+    Samples that contained a dangerous build are discarded and halve the rebuild check delay, so the
+    tuner never trades correctness for speed.
+
+    \ingroup tuners
+*/
+class PYBIND11_EXPORT NeighborListBufferTuner : public Tuner
+    {
+    public:
+    //! Constructor
+    NeighborListBufferTuner(std::shared_ptr<SystemDefinition> sysdef,
+                            std::shared_ptr<Trigger> trigger,
+                            std::shared_ptr<NeighborList> nlist,
+                            Scalar min_buffer,
+                            Scalar max_buffer);
+
+    //! Destructor
+    virtual ~NeighborListBufferTuner();
+
+    //! Measure the last sample and choose the next trial buffer
+    virtual void update(uint64_t timestep);
+
+    //! Discard the current sample, the time between runs is not part of any step
+    virtual void resetStats()
+        {
+        m_sampling = false;
+        }
+
+    //! Set the smallest buffer to try
+    void setMinBuffer(Scalar min_buffer);
+
+    //! Get the smallest buffer to try
+    Scalar getMinBuffer()
+        {
+        return m_min_buffer;
+        }
+
+    //! Set the largest buffer to try
+    void setMaxBuffer(Scalar max_buffer);
+
+    //! Get the largest buffer to try
+    Scalar getMaxBuffer()
+        {
+        return m_max_buffer;
+        }
+
+    //! Test if the search has converged
+    bool isTuned()
+        {
+        return m_tuned;
+        }
+
+    protected:
+    std::shared_ptr<NeighborList> m_nlist; //!< The neighbor list to tune
+    Scalar m_min_buffer;                   //!< Smallest buffer to try
+    Scalar m_max_buffer;                   //!< Largest buffer to try
+    ClockSource m_clock;                   //!< Wall clock to time the samples
+
+    bool m_sampling = false;         //!< True when a sample is in progress
+    uint64_t m_sample_timestep = 0;  //!< Time step at the start of the sample
+    int64_t m_sample_time = 0;       //!< Wall clock time at the start of the sample [ns]
+    double m_sample_nlist_time = 0;  //!< Neighbor list execution time at the start [s]
+    uint64_t m_sample_dangerous = 0; //!< Dangerous builds at the start of the sample
+    bool m_has_best = false;         //!< True when m_best_buffer has been measured
+    Scalar m_best_buffer = 0;        //!< Fastest buffer found so far
+    double m_best_time_per_step = 0; //!< Time per step with m_best_buffer [s]
+    Scalar m_step = Scalar(0.2);     //!< Relative step of the search
+    int m_direction = 1;             //!< Direction of the current trial
+    bool m_tuned = false;            //!< True once the search has converged
+
+    /// Relative step at which the search stops
+    const Scalar m_tolerance = Scalar(0.02);
+
+    //! Start a sample at the given time step
+    void startSample(uint64_t timestep);
+
+    //! Choose the next trial buffer after a trial slower than m_best_buffer
+    Scalar nextTrial();
+    };
+
+namespace detail
+    {
+//! Export the NeighborListBufferTuner to python
+void export_NeighborListBufferTuner(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
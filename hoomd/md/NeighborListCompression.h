@@ -0,0 +1,104 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __NEIGHBORLIST_COMPRESSION_H__
+#define __NEIGHBORLIST_COMPRESSION_H__
+
+#include <stdint.h>
+
+/*! \file NeighborListCompression.h
+    \brief Defines the compressed neighbor list format
+
+    A compressed neighbor list stores the neighbors of particle \a i in the same place in the
+    neighbor list as the uncompressed list, starting at head_list[i]. Neighbors \a j where
+    <code>j - i</code> fits in a 16 bit signed integer are stored as 16 bit deltas. The
+    \a n_outliers remaining neighbors are stored first as full 32 bit indices, followed by the
+    deltas:
+
+     - <code>j = nlist[head_list[i] + k]</code> for <code>k < n_outliers</code>
+     - <code>j = i + ((int16_t*)(nlist + head_list[i]))[n_outliers + k]</code> for
+       <code>n_outliers <= k < n_neigh[i]</code>
+
+    Sorting particles along a space filling curve keeps most neighbor indices close to \a i. An
+    uncompressed list is a compressed list with \a n_outliers equal to \a n_neigh.
+*/
+
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace detail
+    {
+//! Test if neighbor \a j of particle \a i can be stored as a 16 bit delta
+HOSTDEVICE inline bool nlist_delta_fits(unsigned int i, unsigned int j)
+    {
+    int64_t delta = int64_t(j) - int64_t(i);
+    return delta >= INT16_MIN && delta <= INT16_MAX;
+    }
+
+//! Compress the neighbor list of one particle in place
+/*! \param nlist Neighbors of particle \a i, starting at its head
+    \param i Particle index
+    \param n_neigh Number of neighbors of particle \a i
+    \returns The number of outliers
+
+    The outliers move to the front of the list, then the remaining neighbors are packed as 16 bit
+    deltas after them. Each delta is written at or before the 32 bit entry it was read from, so the
+    list can be compressed in place. The order of the neighbors changes.
+*/
+HOSTDEVICE inline unsigned int
+nlist_compress(unsigned int* nlist, unsigned int i, unsigned int n_neigh)
+    {
+    unsigned int n_outliers = 0;
+    for (unsigned int k = 0; k < n_neigh; ++k)
+        {
+        unsigned int j = nlist[k];
+        if (!nlist_delta_fits(i, j))
+            {
+            nlist[k] = nlist[n_outliers];
+            nlist[n_outliers] = j;
+            n_outliers++;
+            }
+        }
+
+    int16_t* deltas = reinterpret_cast<int16_t*>(nlist);
+    for (unsigned int k = n_outliers; k < n_neigh; ++k)
+        {
+        int16_t delta = int16_t(int64_t(nlist[k]) - int64_t(i));
+        deltas[n_outliers + k] = delta;
+        }
+
+    return n_outliers;
+    }
+
+//! Get neighbor \a k of particle \a i from a compressed neighbor list
+/*! \param nlist Neighbors of particle \a i, starting at its head
+    \param i Particle index
+    \param n_outliers Number of outliers of particle \a i
+    \param k Index of the neighbor
+*/
+HOSTDEVICE inline unsigned int nlist_get_neighbor(const unsigned int* nlist,
+                                                 unsigned int i,
+                                                 unsigned int n_outliers,
+                                                 unsigned int k)
+    {
+    if (k < n_outliers)
+        return nlist[k];
+
+    const int16_t* deltas = reinterpret_cast<const int16_t*>(nlist);
+    return i + deltas[n_outliers + k];
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __NEIGHBORLIST_COMPRESSION_H__
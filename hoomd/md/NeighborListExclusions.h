@@ -0,0 +1,90 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __NEIGHBORLIST_EXCLUSIONS_H__
+#define __NEIGHBORLIST_EXCLUSIONS_H__
+
+#include <stdint.h>
+
+/*! \file NeighborListExclusions.h
+    \brief Defines the compact exclusion format that neighbor list builds check directly
+
+    Bonded exclusions almost always join particles whose tags are close, because molecules are
+    usually numbered consecutively. The compact format stores the exclusions of tag \a i with tags
+    <code>i - 32</code> to <code>i + 32</code> as bits of a 64 bit mask:
+
+     - bit <code>j - i + 32</code> for <code>j < i</code>
+     - bit <code>j - i + 31</code> for <code>j > i</code>
+
+    The remaining exclusions of tag \a i are listed in CSR form, in
+    <code>ex_tags[ex_head[i]]</code> to <code>ex_tags[ex_head[i + 1] - 1]</code>. All arrays are
+    indexed by tag, so they do not change when the particles are sorted.
+*/
+
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Compact exclusions read by the neighbor list builds
+/*! Holds host or device pointers, depending on the build. A null \a ex_mask means that no
+    exclusions are set.
+*/
+struct nlist_exclusions_t
+    {
+    const unsigned int* tag;     //!< Tag of each particle index
+    const uint64_t* ex_mask;     //!< Exclusions of each tag within the mask range
+    const unsigned int* ex_head; //!< Start of the remaining exclusions of each tag
+    const unsigned int* ex_tags; //!< Remaining excluded tags, grouped by tag
+    };
+
+namespace detail
+    {
+//! Largest tag offset stored in the exclusion mask
+const int64_t nlist_ex_mask_range = 32;
+
+//! Find the bit of the exclusion mask of tag \a i that stores tag \a j
+/*! \returns false when \a j is outside the mask range of \a i
+ */
+HOSTDEVICE inline bool nlist_ex_mask_bit(unsigned int i, unsigned int j, unsigned int& bit)
+    {
+    int64_t delta = int64_t(j) - int64_t(i);
+    if (delta == 0 || delta < -nlist_ex_mask_range || delta > nlist_ex_mask_range)
+        return false;
+
+    bit = (unsigned int)(delta < 0 ? delta + nlist_ex_mask_range : delta + nlist_ex_mask_range - 1);
+    return true;
+    }
+
+//! Test if tags \a i and \a j are excluded
+/*! \param i Tag of the particle that owns the list
+    \param j Tag of the candidate neighbor
+    \param ex Compact exclusions
+*/
+HOSTDEVICE inline bool
+nlist_is_excluded(unsigned int i, unsigned int j, const nlist_exclusions_t& ex)
+    {
+    unsigned int bit;
+    if (nlist_ex_mask_bit(i, j, bit))
+        return (ex.ex_mask[i] >> bit) & 1;
+
+    for (unsigned int k = ex.ex_head[i]; k < ex.ex_head[i + 1]; k++)
+        {
+        if (ex.ex_tags[k] == j)
+            return true;
+        }
+    return false;
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __NEIGHBORLIST_EXCLUSIONS_H__
@@ -183,6 +183,35 @@ void NeighborListGPU::filterNlist()
         m_prof->pop(m_exec_conf);
     }
 
+/*! Calls gpu_nlist_compress() to compress the neighbor list on the GPU
+ */
+void NeighborListGPU::compressNlist()
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "compress");
+
+    ArrayHandle<unsigned int> d_n_neigh(m_n_neigh, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_nlist(m_nlist, access_location::device, access_mode::readwrite);
+    ArrayHandle<size_t> d_head_list(m_head_list, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_n_outliers(m_n_outliers,
+                                           access_location::device,
+                                           access_mode::overwrite);
+
+    m_tuner_compress->begin();
+    kernel::gpu_nlist_compress(d_nlist.data,
+                               d_n_outliers.data,
+                               d_n_neigh.data,
+                               d_head_list.data,
+                               m_pdata->getN(),
+                               m_tuner_compress->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner_compress->end();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
 //! Update the exclusion list on the GPU
 void NeighborListGPU::updateExListIdx()
     {
@@ -287,6 +316,56 @@ void NeighborListGPU::buildHeadList()
         m_prof->pop(m_exec_conf);
     }
 
+/*! The head list gives each particle room for the number of neighbors in m_n_neigh, so that a
+    following build that fills in the counted neighbors cannot overflow.
+*/
+void NeighborListGPU::buildHeadListFromCounts()
+    {
+    // don't do anything if there are no particles owned by this rank
+    if (!m_pdata->getN())
+        return;
+
+    if (m_prof)
+        {
+        m_prof->push(m_exec_conf, "head-list");
+        }
+
+        {
+        ArrayHandle<size_t> d_head_list(m_head_list,
+                                        access_location::device,
+                                        access_mode::overwrite);
+        ArrayHandle<unsigned int> d_n_neigh(m_n_neigh, access_location::device, access_mode::read);
+        ArrayHandle<size_t> d_req_size_nlist(m_req_size_nlist,
+                                             access_location::device,
+                                             access_mode::overwrite);
+
+        m_tuner_head_list->begin();
+        kernel::gpu_nlist_build_head_list_from_counts(d_head_list.data,
+                                                      d_req_size_nlist.data,
+                                                      d_n_neigh.data,
+                                                      m_pdata->getN(),
+                                                      m_tuner_head_list->getParam());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_head_list->end();
+        }
+
+    // the size of the list is the only value that returns to the host
+    size_t req_size_nlist;
+        {
+        ArrayHandle<size_t> h_req_size_nlist(m_req_size_nlist,
+                                             access_location::host,
+                                             access_mode::read);
+        req_size_nlist = *h_req_size_nlist.data;
+        }
+
+    resizeNlist(req_size_nlist);
+    updateMemoryMapping();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
 namespace detail
     {
 void export_NeighborListGPU(pybind11::module& m)
@@ -8,6 +8,7 @@
     \brief Defines GPU kernel code for neighbor list processing on the GPU
 */
 
+#include "NeighborListCompression.h"
 #include "NeighborListGPU.cuh"
 
 #pragma GCC diagnostic push
@@ -282,6 +283,64 @@ hipError_t gpu_nlist_filter(unsigned int* d_n_neigh,
     return hipSuccess;
     }
 
+/*! \param d_nlist Neighbor list to compress in place
+    \param d_n_outliers Number of outliers of each particle (output)
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_head_list Head list indexing the neighbor list
+    \param N Number of particles
+
+    One thread is run for each particle, which compresses that particle's list with
+    detail::nlist_compress().
+*/
+__global__ void gpu_nlist_compress_kernel(unsigned int* d_nlist,
+                                          unsigned int* d_n_outliers,
+                                          const unsigned int* d_n_neigh,
+                                          const size_t* d_head_list,
+                                          const unsigned int N)
+    {
+    const unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    d_n_outliers[idx] = detail::nlist_compress(d_nlist + d_head_list[idx], idx, d_n_neigh[idx]);
+    }
+
+/*! \param d_nlist Neighbor list to compress in place
+    \param d_n_outliers Number of outliers of each particle (output)
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_head_list Head list indexing the neighbor list
+    \param N Number of particles
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_nlist_compress(unsigned int* d_nlist,
+                              unsigned int* d_n_outliers,
+                              const unsigned int* d_n_neigh,
+                              const size_t* d_head_list,
+                              const unsigned int N,
+                              const unsigned int block_size)
+    {
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_nlist_compress_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipLaunchKernelGGL((gpu_nlist_compress_kernel),
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_nlist,
+                       d_n_outliers,
+                       d_n_neigh,
+                       d_head_list,
+                       N);
+
+    return hipSuccess;
+    }
+
 //! GPU kernel to update the exclusions list
 __global__ void gpu_update_exclusion_list_kernel(const unsigned int* tags,
                                                  const unsigned int* rtags,
@@ -484,6 +543,89 @@ hipError_t gpu_nlist_build_head_list(size_t* d_head_list,
     return hipSuccess;
     }
 
+/*!
+ * \param d_head_list The head list of indexes to overwrite with the rounded neighbor counts
+ * \param d_req_size_nlist Flag for the total size of the neighbor list
+ * \param d_n_neigh Number of neighbors of each particle
+ * \param N the number of particles on this rank
+ *
+ * The list of each particle is sized to its number of neighbors, rounded up to a multiple of 4 the
+ * same way as NeighborList::checkConditions() rounds Nmax.
+ */
+__global__ void gpu_nlist_init_head_list_from_counts_kernel(size_t* d_head_list,
+                                                            size_t* d_req_size_nlist,
+                                                            const unsigned int* d_n_neigh,
+                                                            const unsigned int N)
+    {
+    // particle index
+    const unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    // one thread per particle
+    if (idx >= N)
+        return;
+
+    const unsigned int n_neigh = d_n_neigh[idx];
+    const size_t size_i = (n_neigh > 4) ? (n_neigh + 3) & ~3 : 4;
+
+    d_head_list[idx] = size_i;
+
+    // last thread presets its number of particles in the memory req as well
+    if (idx == (N - 1))
+        {
+        *d_req_size_nlist = size_i;
+        }
+    }
+
+/*!
+ * \param d_head_list The head list of indexes to compute for reading the neighbor list
+ * \param d_req_size_nlist Flag for the total size of the neighbor list
+ * \param d_n_neigh Number of neighbors of each particle
+ * \param N the number of particles on this rank
+ * \param block_size Number of threads per block
+ *
+ * \return hipSuccess on completion
+ *
+ * Same as gpu_nlist_build_head_list(), but sizes the list of each particle to its counted number
+ * of neighbors instead of the Nmax of its type.
+ */
+hipError_t gpu_nlist_build_head_list_from_counts(size_t* d_head_list,
+                                                 size_t* d_req_size_nlist,
+                                                 const unsigned int* d_n_neigh,
+                                                 const unsigned int N,
+                                                 const unsigned int block_size)
+    {
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_nlist_init_head_list_from_counts_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipLaunchKernelGGL((gpu_nlist_init_head_list_from_counts_kernel),
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_head_list,
+                       d_req_size_nlist,
+                       d_n_neigh,
+                       N);
+
+    thrust::device_ptr<size_t> t_head_list = thrust::device_pointer_cast(d_head_list);
+    thrust::exclusive_scan(t_head_list, t_head_list + N, t_head_list);
+
+    hipLaunchKernelGGL((gpu_nlist_get_nlist_size_kernel),
+                       dim3(1),
+                       dim3(1),
+                       0,
+                       0,
+                       d_req_size_nlist,
+                       d_head_list,
+                       N);
+
+    return hipSuccess;
+    }
+
     } // end namespace kernel
     } // end namespace md
     } // end namespace hoomd
@@ -47,6 +47,14 @@ hipError_t gpu_nlist_filter(unsigned int* d_n_neigh,
                             const unsigned int N,
                             const unsigned int block_size);
 
+//! Kernel driver for gpu_nlist_compress_kernel()
+hipError_t gpu_nlist_compress(unsigned int* d_nlist,
+                              unsigned int* d_n_outliers,
+                              const unsigned int* d_n_neigh,
+                              const size_t* d_head_list,
+                              const unsigned int N,
+                              const unsigned int block_size);
+
 //! Kernel driver to build head list on gpu
 hipError_t gpu_nlist_build_head_list(size_t* d_head_list,
                                      size_t* d_req_size_nlist,
@@ -56,6 +64,13 @@ hipError_t gpu_nlist_build_head_list(size_t* d_head_list,
                                      const unsigned int n_types,
                                      const unsigned int block_size);
 
+//! Kernel driver to build the head list from the number of neighbors of each particle
+hipError_t gpu_nlist_build_head_list_from_counts(size_t* d_head_list,
+                                                 size_t* d_req_size_nlist,
+                                                 const unsigned int* d_n_neigh,
+                                                 const unsigned int N,
+                                                 const unsigned int block_size);
+
 //! GPU function to update the exclusion list on the device
 hipError_t gpu_update_exclusion_list(const unsigned int* d_tag,
                                      const unsigned int* d_rtag,
@@ -100,6 +100,13 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
                                               100000,
                                               "nlist_head_list",
                                               this->m_exec_conf));
+        m_tuner_compress.reset(new Autotuner(warp_size,
+                                             1024,
+                                             warp_size,
+                                             5,
+                                             100000,
+                                             "nlist_compress",
+                                             this->m_exec_conf));
         }
 
     //! Destructor
@@ -117,6 +124,9 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
 
         m_tuner_head_list->setPeriod(period / 10);
         m_tuner_head_list->setEnabled(enable);
+
+        m_tuner_compress->setPeriod(period / 10);
+        m_tuner_compress->setEnabled(enable);
         }
 
     //! Benchmark the filter kernel
@@ -147,9 +157,15 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
     //! Filter the neighbor list of excluded particles
     virtual void filterNlist();
 
+    //! Compress the neighbor list in place on the GPU
+    virtual void compressNlist();
+
     //! Build the head list for neighbor list indexing on the GPU
     virtual void buildHeadList();
 
+    //! Build the head list from the number of neighbors of each particle in m_n_neigh
+    void buildHeadListFromCounts();
+
     //! Schedule the distance check kernel
     /*! \param timestep Current time step
      */
@@ -159,6 +175,7 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
     private:
     std::unique_ptr<Autotuner> m_tuner_filter;    //!< Autotuner for filter block size
     std::unique_ptr<Autotuner> m_tuner_head_list; //!< Autotuner for the head list block size
+    std::unique_ptr<Autotuner> m_tuner_compress;  //!< Autotuner for the compress block size
 
     GlobalArray<unsigned int>
         m_alt_head_list; //!< Alternate array to hold the head list from prefix sum
@@ -38,23 +38,30 @@ NeighborListGPUBinned::NeighborListGPUBinned(std::shared_ptr<SystemDefinition> s
     CHECK_CUDA_ERROR();
 
     // initialize autotuner
-    // the full block size and threads_per_particle matrix is searched,
-    // encoded as block_size*10000 + threads_per_particle
-    std::vector<unsigned int> valid_params;
+    // the block size and threads_per_particle are searched by coordinate descent
+    std::vector<unsigned int> block_sizes;
+    std::vector<unsigned int> threads_per_particle;
 
     const unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
     for (unsigned int block_size = warp_size; block_size <= 1024; block_size += warp_size)
         {
-        unsigned int s = 1;
-
-        while (s <= warp_size)
-            {
-            valid_params.push_back(block_size * 10000 + s);
-            s = s * 2;
-            }
+        block_sizes.push_back(block_size);
+        }
+    for (unsigned int s = 1; s <= warp_size; s *= 2)
+        {
+        threads_per_particle.push_back(s);
         }
 
-    m_tuner.reset(new Autotuner(valid_params, 5, 100000, "nlist_binned", this->m_exec_conf));
+    // the threads of one particle must be in the same block
+    auto is_valid
+        = [](const std::vector<unsigned int>& param) { return param[0] % param[1] == 0; };
+
+    m_tuner.reset(new Autotuner({block_sizes, threads_per_particle},
+                                is_valid,
+                                5,
+                                100000,
+                                "nlist_binned",
+                                this->m_exec_conf));
     }
 
 NeighborListGPUBinned::~NeighborListGPUBinned() { }
@@ -74,6 +81,12 @@ void NeighborListGPUBinned::buildNlist(uint64_t timestep)
             rmax += m_d_max - Scalar(1.0);
 
         m_cl->setNominalWidth(rmax);
+
+        // particles of types without any interactions have no neighbors, leave them out
+        std::vector<unsigned int> types = getInteractingTypes();
+        if (types != m_cl->getTypeFilter())
+            m_cl->setTypeFilter(types);
+
         m_update_cell_size = false;
         }
 
@@ -82,6 +95,26 @@ void NeighborListGPUBinned::buildNlist(uint64_t timestep)
     if (m_prof)
         m_prof->push(m_exec_conf, "compute");
 
+    if (m_count_first)
+        {
+        // size the list of each particle to its number of neighbors, then fill the lists
+        launchBuild(kernel::nlist_build_mode::count);
+        buildHeadListFromCounts();
+        launchBuild(kernel::nlist_build_mode::fill);
+        }
+    else
+        {
+        launchBuild(kernel::nlist_build_mode::bounded);
+        }
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+/*! \param build_mode One of kernel::nlist_build_mode::Enum
+ */
+void NeighborListGPUBinned::launchBuild(unsigned int build_mode)
+    {
     // acquire the particle data
     ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
     ArrayHandle<Scalar> d_diameter(m_pdata->getDiameters(),
@@ -131,12 +164,30 @@ void NeighborListGPUBinned::buildNlist(uint64_t timestep)
                                            access_location::device,
                                            access_mode::readwrite);
     ArrayHandle<unsigned int> d_nlist(m_nlist, access_location::device, access_mode::overwrite);
-    ArrayHandle<unsigned int> d_n_neigh(m_n_neigh, access_location::device, access_mode::overwrite);
+    // the fill pass reads the counts of the count pass
+    ArrayHandle<unsigned int> d_n_neigh(m_n_neigh,
+                                        access_location::device,
+                                        build_mode == kernel::nlist_build_mode::fill
+                                            ? access_mode::readwrite
+                                            : access_mode::overwrite);
     ArrayHandle<Scalar4> d_last_pos(m_last_pos, access_location::device, access_mode::overwrite);
 
     ArrayHandle<Scalar> d_r_cut(m_r_cut, access_location::device, access_mode::read);
     ArrayHandle<Scalar> d_r_listsq(m_r_listsq, access_location::device, access_mode::read);
 
+    // access the compact exclusions
+    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
+    ArrayHandle<uint64_t> d_ex_mask_tag(m_ex_mask_tag, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_ex_head_tag(m_ex_head_tag,
+                                            access_location::device,
+                                            access_mode::read);
+    ArrayHandle<unsigned int> d_ex_tags(m_ex_tags, access_location::device, access_mode::read);
+    nlist_exclusions_t ex;
+    ex.tag = d_tag.data;
+    ex.ex_mask = m_exclusions_set ? d_ex_mask_tag.data : nullptr;
+    ex.ex_head = d_ex_head_tag.data;
+    ex.ex_tags = d_ex_tags.data;
+
 #ifdef __HIP_PLATFORM_NVCC__
     auto& gpu_map = m_exec_conf->getGPUIds();
 
@@ -159,9 +210,15 @@ void NeighborListGPUBinned::buildNlist(uint64_t timestep)
     m_exec_conf->beginMultiGPU();
 
     this->m_tuner->begin();
-    unsigned int param = !m_param ? this->m_tuner->getParam() : m_param;
-    unsigned int block_size = param / 10000;
-    unsigned int threads_per_particle = param % 10000;
+    // m_param overrides the autotuner, encoded as block_size*10000 + threads_per_particle
+    unsigned int block_size = m_param / 10000;
+    unsigned int threads_per_particle = m_param % 10000;
+    if (!m_param)
+        {
+        std::vector<unsigned int> param = this->m_tuner->getParams();
+        block_size = param[0];
+        threads_per_particle = param[1];
+        }
 
     kernel::gpu_compute_nlist_binned(
         d_nlist.data,
@@ -173,6 +230,7 @@ void NeighborListGPUBinned::buildNlist(uint64_t timestep)
         d_pos.data,
         d_body.data,
         d_diameter.data,
+        ex,
         m_pdata->getN(),
         m_cl->getPerDevice() ? d_cell_size_per_device.data : d_cell_size.data,
         d_cell_xyzf.data,
@@ -192,16 +250,34 @@ void NeighborListGPUBinned::buildNlist(uint64_t timestep)
         m_diameter_shift,
         m_cl->getGhostWidth(),
         m_pdata->getGPUPartition(),
-        m_use_index);
+        m_use_index,
+        build_mode);
 
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
     this->m_tuner->end();
 
     m_exec_conf->endMultiGPU();
+    }
 
-    if (m_prof)
-        m_prof->pop(m_exec_conf);
+/*! Without the count pass, the head list is sized by the Nmax of each type.
+ */
+void NeighborListGPUBinned::buildHeadList()
+    {
+    // the count pass builds the head list
+    if (m_count_first)
+        return;
+
+    NeighborListGPU::buildHeadList();
+    }
+
+bool NeighborListGPUBinned::checkConditions()
+    {
+    // the lists sized by the count pass cannot overflow
+    if (m_count_first)
+        return false;
+
+    return NeighborListGPU::checkConditions();
     }
 
 namespace detail
@@ -215,7 +291,11 @@ void export_NeighborListGPUBinned(pybind11::module& m)
         .def("setTuningParam", &NeighborListGPUBinned::setTuningParam)
         .def_property("deterministic",
                       &NeighborListGPUBinned::getDeterministic,
-                      &NeighborListGPUBinned::setDeterministic);
+                      &NeighborListGPUBinned::setDeterministic)
+        .def_property("count_first",
+                      &NeighborListGPUBinned::getCountFirst,
+                      &NeighborListGPUBinned::setCountFirst)
+        .def("getCellList", &NeighborListGPUBinned::getCellList);
     }
 
     } // end namespace detail
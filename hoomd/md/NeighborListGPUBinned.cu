@@ -29,6 +29,7 @@ namespace kernel
     \param d_pos Particle positions
     \param d_body Particle body indices
     \param d_diameter Particle diameters
+    \param ex Compact exclusions, skipped when \a ex.ex_mask is null
     \param N Number of particles
     \param d_cell_size Number of particles in each cell
     \param d_cell_xyzf Cell contents (xyzf array from CellList with flag=type)
@@ -45,6 +46,12 @@ namespace kernel
     \param ghost_width Width of ghost cell layer
     \param offset Starting particle index
     \param nwork Number of particles to process
+    \param ngpu Number of GPUs
+    \param build_mode One of nlist_build_mode::Enum
+
+    In the bounded mode, the list of each particle holds at most Nmax of its type and larger counts
+    are flagged in \a d_conditions. The count mode only writes \a d_n_neigh, and the fill mode
+    writes at most the \a d_n_neigh entries that the count mode found.
 
     \note optimized for Kepler
 */
@@ -58,6 +65,7 @@ __global__ void gpu_compute_nlist_binned_kernel(unsigned int* d_nlist,
                                                 const Scalar4* d_pos,
                                                 const unsigned int* d_body,
                                                 const Scalar* d_diameter,
+                                                const nlist_exclusions_t ex,
                                                 const unsigned int N,
                                                 const unsigned int* d_cell_size,
                                                 const Scalar4* d_cell_xyzf,
@@ -74,7 +82,8 @@ __global__ void gpu_compute_nlist_binned_kernel(unsigned int* d_nlist,
                                                 const Scalar3 ghost_width,
                                                 const unsigned int offset,
                                                 const unsigned int nwork,
-                                                const unsigned int ngpu)
+                                                const unsigned int ngpu,
+                                                const unsigned int build_mode)
     {
     bool filter_body = flags & 1;
     bool diameter_shift = flags & 2;
@@ -125,8 +134,13 @@ __global__ void gpu_compute_nlist_binned_kernel(unsigned int* d_nlist,
     unsigned int my_type = __scalar_as_int(my_postype.w);
     unsigned int my_body = d_body[my_pidx];
     Scalar my_diam = d_diameter[my_pidx];
+    unsigned int my_tag = ex.ex_mask ? ex.tag[my_pidx] : 0;
     size_t my_head = d_head_list[my_pidx];
 
+    // the count pass has sized the list of each particle for the fill pass
+    const unsigned int my_max
+        = (build_mode == nlist_build_mode::fill) ? d_n_neigh[my_pidx] : s_Nmax[my_type];
+
     Scalar3 f = box.makeFraction(my_pos, ghost_width);
 
     // find the bin each particle belongs in
@@ -255,6 +269,10 @@ __global__ void gpu_compute_nlist_binned_kernel(unsigned int* d_nlist,
                     sqshift = (delta + Scalar(2.0) * r_list) * delta;
                     }
 
+                // check the exclusions only for the pairs within the list cutoff
+                if (drsq <= (r_list * r_list + sqshift) && !excluded && ex.ex_mask)
+                    excluded = detail::nlist_is_excluded(my_tag, ex.tag[cur_neigh], ex);
+
                 // store result in shared memory
                 if (drsq <= (r_list * r_list + sqshift) && !excluded)
                     {
@@ -277,7 +295,7 @@ __global__ void gpu_compute_nlist_binned_kernel(unsigned int* d_nlist,
                 n);
 
             // write neighbor if it fits in list
-            if (has_neighbor && (nneigh + k) < s_Nmax[my_type])
+            if (has_neighbor && build_mode != nlist_build_mode::count && (nneigh + k) < my_max)
                 d_nlist[my_head + nneigh + k] = neighbor;
 
             // increment total neighbor count
@@ -288,7 +306,7 @@ __global__ void gpu_compute_nlist_binned_kernel(unsigned int* d_nlist,
     if (threadIdx.x % threads_per_particle == 0)
         {
         // flag if we need to grow the neighbor list
-        if (nneigh >= s_Nmax[my_type])
+        if (build_mode == nlist_build_mode::bounded && nneigh >= s_Nmax[my_type])
             atomicMax(&d_conditions[my_type], nneigh);
 
         d_n_neigh[my_pidx] = nneigh;
@@ -319,6 +337,7 @@ inline void launcher(unsigned int* d_nlist,
                      const Scalar4* d_pos,
                      const unsigned int* d_body,
                      const Scalar* d_diameter,
+                     const nlist_exclusions_t ex,
                      const unsigned int N,
                      const unsigned int* d_cell_size,
                      const Scalar4* d_cell_xyzf,
@@ -339,7 +358,8 @@ inline void launcher(unsigned int* d_nlist,
                      unsigned int block_size,
                      std::pair<unsigned int, unsigned int> range,
                      bool use_index,
-                     const unsigned int ngpu)
+                     const unsigned int ngpu,
+                     const unsigned int build_mode)
     {
     // shared memory = r_listsq + Nmax + stuff needed for neighborlist (computed below)
     Index2D typpair_idx(ntypes);
@@ -375,6 +395,7 @@ inline void launcher(unsigned int* d_nlist,
                                    d_pos,
                                    d_body,
                                    d_diameter,
+                                   ex,
                                    N,
                                    d_cell_size,
                                    d_cell_xyzf,
@@ -391,7 +412,8 @@ inline void launcher(unsigned int* d_nlist,
                                    ghost_width,
                                    offset,
                                    nwork,
-                                   ngpu);
+                                   ngpu,
+                                   build_mode);
                 }
             else if (!diameter_shift && filter_body)
                 {
@@ -415,6 +437,7 @@ inline void launcher(unsigned int* d_nlist,
                                    d_pos,
                                    d_body,
                                    d_diameter,
+                                   ex,
                                    N,
                                    d_cell_size,
                                    d_cell_xyzf,
@@ -431,7 +454,8 @@ inline void launcher(unsigned int* d_nlist,
                                    ghost_width,
                                    offset,
                                    nwork,
-                                   ngpu);
+                                   ngpu,
+                                   build_mode);
                 }
             else if (diameter_shift && !filter_body)
                 {
@@ -455,6 +479,7 @@ inline void launcher(unsigned int* d_nlist,
                                    d_pos,
                                    d_body,
                                    d_diameter,
+                                   ex,
                                    N,
                                    d_cell_size,
                                    d_cell_xyzf,
@@ -471,7 +496,8 @@ inline void launcher(unsigned int* d_nlist,
                                    ghost_width,
                                    offset,
                                    nwork,
-                                   ngpu);
+                                   ngpu,
+                                   build_mode);
                 }
             else if (diameter_shift && filter_body)
                 {
@@ -495,6 +521,7 @@ inline void launcher(unsigned int* d_nlist,
                                    d_pos,
                                    d_body,
                                    d_diameter,
+                                   ex,
                                    N,
                                    d_cell_size,
                                    d_cell_xyzf,
@@ -511,7 +538,8 @@ inline void launcher(unsigned int* d_nlist,
                                    ghost_width,
                                    offset,
                                    nwork,
-                                   ngpu);
+                                   ngpu,
+                                   build_mode);
                 }
             }
         else // use_index
@@ -538,6 +566,7 @@ inline void launcher(unsigned int* d_nlist,
                                    d_pos,
                                    d_body,
                                    d_diameter,
+                                   ex,
                                    N,
                                    d_cell_size,
                                    d_cell_xyzf,
@@ -554,7 +583,8 @@ inline void launcher(unsigned int* d_nlist,
                                    ghost_width,
                                    offset,
                                    nwork,
-                                   ngpu);
+                                   ngpu,
+                                   build_mode);
                 }
             else if (!diameter_shift && filter_body)
                 {
@@ -578,6 +608,7 @@ inline void launcher(unsigned int* d_nlist,
                                    d_pos,
                                    d_body,
                                    d_diameter,
+                                   ex,
                                    N,
                                    d_cell_size,
                                    d_cell_xyzf,
@@ -594,7 +625,8 @@ inline void launcher(unsigned int* d_nlist,
                                    ghost_width,
                                    offset,
                                    nwork,
-                                   ngpu);
+                                   ngpu,
+                                   build_mode);
                 }
             else if (diameter_shift && !filter_body)
                 {
@@ -618,6 +650,7 @@ inline void launcher(unsigned int* d_nlist,
                                    d_pos,
                                    d_body,
                                    d_diameter,
+                                   ex,
                                    N,
                                    d_cell_size,
                                    d_cell_xyzf,
@@ -634,7 +667,8 @@ inline void launcher(unsigned int* d_nlist,
                                    ghost_width,
                                    offset,
                                    nwork,
-                                   ngpu);
+                                   ngpu,
+                                   build_mode);
                 }
             else if (diameter_shift && filter_body)
                 {
@@ -658,6 +692,7 @@ inline void launcher(unsigned int* d_nlist,
                                    d_pos,
                                    d_body,
                                    d_diameter,
+                                   ex,
                                    N,
                                    d_cell_size,
                                    d_cell_xyzf,
@@ -674,7 +709,8 @@ inline void launcher(unsigned int* d_nlist,
                                    ghost_width,
                                    offset,
                                    nwork,
-                                   ngpu);
+                                   ngpu,
+                                   build_mode);
                 }
             }
         }
@@ -689,6 +725,7 @@ inline void launcher(unsigned int* d_nlist,
                               d_pos,
                               d_body,
                               d_diameter,
+                              ex,
                               N,
                               d_cell_size,
                               d_cell_xyzf,
@@ -709,7 +746,8 @@ inline void launcher(unsigned int* d_nlist,
                               block_size,
                               range,
                               use_index,
-                              ngpu);
+                              ngpu,
+                              build_mode);
         }
     }
 
@@ -724,6 +762,7 @@ inline void launcher<min_threads_per_particle / 2>(unsigned int* d_nlist,
                                                    const Scalar4* d_pos,
                                                    const unsigned int* d_body,
                                                    const Scalar* d_diameter,
+                                                   const nlist_exclusions_t ex,
                                                    const unsigned int N,
                                                    const unsigned int* d_cell_size,
                                                    const Scalar4* d_cell_xyzf,
@@ -744,7 +783,8 @@ inline void launcher<min_threads_per_particle / 2>(unsigned int* d_nlist,
                                                    unsigned int block_size,
                                                    std::pair<unsigned int, unsigned int> range,
                                                    bool use_index,
-                                                   const unsigned int ngpu)
+                                                   const unsigned int ngpu,
+                                                   const unsigned int build_mode)
     {
     }
 
@@ -757,6 +797,7 @@ hipError_t gpu_compute_nlist_binned(unsigned int* d_nlist,
                                     const Scalar4* d_pos,
                                     const unsigned int* d_body,
                                     const Scalar* d_diameter,
+                                    const nlist_exclusions_t& ex,
                                     const unsigned int N,
                                     const unsigned int* d_cell_size,
                                     const Scalar4* d_cell_xyzf,
@@ -776,7 +817,8 @@ hipError_t gpu_compute_nlist_binned(unsigned int* d_nlist,
                                     bool diameter_shift,
                                     const Scalar3& ghost_width,
                                     const GPUPartition& gpu_partition,
-                                    bool use_index)
+                                    bool use_index,
+                                    const unsigned int build_mode)
     {
     unsigned int ngpu = gpu_partition.getNumActiveGPUs();
 
@@ -794,6 +836,7 @@ hipError_t gpu_compute_nlist_binned(unsigned int* d_nlist,
                                            d_pos,
                                            d_body,
                                            d_diameter,
+                                           ex,
                                            N,
                                            d_cell_size,
                                            d_cell_xyzf,
@@ -814,7 +857,8 @@ hipError_t gpu_compute_nlist_binned(unsigned int* d_nlist,
                                            block_size,
                                            range,
                                            use_index,
-                                           ngpu);
+                                           ngpu,
+                                           build_mode);
         }
     return hipSuccess;
     }
@@ -13,6 +13,8 @@
 #include "hoomd/Index1D.h"
 #include "hoomd/ParticleData.cuh"
 
+#include "NeighborListExclusions.h"
+
 /*! \file NeighborListGPUBinned.cuh
     \brief Declares GPU kernel code for neighbor list generation on the GPU
 */
@@ -33,6 +35,18 @@ namespace kernel
 const unsigned int min_threads_per_particle = 1;
 const unsigned int max_threads_per_particle = WARP_SIZE;
 
+//! Modes of gpu_compute_nlist_binned()
+struct nlist_build_mode
+    {
+    //! The enum
+    enum Enum
+        {
+        bounded = 0, //!< Write at most Nmax neighbors per particle and flag overflows
+        count,       //!< Only count the neighbors of each particle
+        fill         //!< Write the neighbors counted by a previous count pass
+        };
+    };
+
 //! Kernel driver for gpu_compute_nlist_kernel()
 hipError_t gpu_compute_nlist_binned(unsigned int* d_nlist,
                                     unsigned int* d_n_neigh,
@@ -43,6 +57,7 @@ hipError_t gpu_compute_nlist_binned(unsigned int* d_nlist,
                                     const Scalar4* d_pos,
                                     const unsigned int* d_body,
                                     const Scalar* d_diameter,
+                                    const nlist_exclusions_t& ex,
                                     const unsigned int N,
                                     const unsigned int* d_cell_size,
                                     const Scalar4* d_cell_xyzf,
@@ -62,7 +77,8 @@ hipError_t gpu_compute_nlist_binned(unsigned int* d_nlist,
                                     bool diameter_shift,
                                     const Scalar3& ghost_width,
                                     const GPUPartition& gpu_partition,
-                                    bool use_index);
+                                    bool use_index,
+                                    const unsigned int build_mode);
 
     } // end namespace kernel
     } // end namespace md
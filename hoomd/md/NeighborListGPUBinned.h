@@ -48,6 +48,13 @@ class PYBIND11_EXPORT NeighborListGPUBinned : public NeighborListGPU
         NeighborListGPU::notifyRCutMatrixChange();
         }
 
+    /// Notify NeighborList that r_cut matrix values have decreased
+    virtual void notifyRCutMatrixShrink()
+        {
+        m_update_cell_size = true;
+        NeighborListGPU::notifyRCutMatrixShrink();
+        }
+
     //! Set the autotuner period
     void setTuningParam(unsigned int param)
         {
@@ -77,6 +84,25 @@ class PYBIND11_EXPORT NeighborListGPUBinned : public NeighborListGPU
         return m_cl->getSortCellList();
         }
 
+    /// Get the cell list
+    std::shared_ptr<CellList> getCellList()
+        {
+        return m_cl;
+        }
+
+    /// Set whether to count the neighbors before building the list
+    void setCountFirst(bool count_first)
+        {
+        m_count_first = count_first;
+        forceUpdate();
+        }
+
+    /// Get whether to count the neighbors before building the list
+    bool getCountFirst()
+        {
+        return m_count_first;
+        }
+
     protected:
     std::shared_ptr<CellList> m_cl; //!< The cell list
     unsigned int m_block_size;      //!< Block size to execute on the GPU
@@ -86,10 +112,28 @@ class PYBIND11_EXPORT NeighborListGPUBinned : public NeighborListGPU
     /// Track when the cell size needs to be updated
     bool m_update_cell_size = true;
 
+    /// Count the neighbors of each particle and size the lists before filling them
+    bool m_count_first = false;
+
     std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size and threads per particle
 
     //! Builds the neighbor list
     virtual void buildNlist(uint64_t timestep);
+
+    //! The build kernel skips excluded pairs
+    virtual bool checksExclusionsInBuild()
+        {
+        return true;
+        }
+
+    //! Launch one pass of the neighbor list build
+    void launchBuild(unsigned int build_mode);
+
+    //! Build the head list sized by Nmax, unless the count pass sizes it
+    virtual void buildHeadList();
+
+    //! Check for overflows, which cannot occur when the count pass sizes the lists
+    virtual bool checkConditions();
     };
 
 namespace detail
@@ -0,0 +1,205 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file NeighborListGPUCluster.cc
+    \brief Defines NeighborListGPUCluster
+*/
+
+#include "NeighborListGPUCluster.h"
+#include "NeighborListGPUCluster.cuh"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+NeighborListGPUCluster::NeighborListGPUCluster(std::shared_ptr<SystemDefinition> sysdef,
+                                               Scalar r_buff)
+    : NeighborListGPUBinned(sysdef, r_buff)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing NeighborListGPUCluster" << endl;
+
+    GlobalArray<unsigned int> conditions(1, m_exec_conf);
+    m_cluster_conditions.swap(conditions);
+    TAG_ALLOCATION(m_cluster_conditions);
+
+        {
+        ArrayHandle<unsigned int> h_conditions(m_cluster_conditions,
+                                               access_location::host,
+                                               access_mode::overwrite);
+        *h_conditions.data = 0;
+        }
+
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner_cluster.reset(new Autotuner(warp_size,
+                                        1024,
+                                        warp_size,
+                                        5,
+                                        100000,
+                                        "nlist_cluster",
+                                        this->m_exec_conf));
+    }
+
+NeighborListGPUCluster::~NeighborListGPUCluster()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying NeighborListGPUCluster" << endl;
+    }
+
+/*! \param cluster_size Number of particles per cluster, 4 or 8
+ */
+void NeighborListGPUCluster::setClusterSize(unsigned int cluster_size)
+    {
+    if (cluster_size != 4 && cluster_size != 8)
+        {
+        throw std::invalid_argument("cluster_size must be 4 or 8");
+        }
+
+    m_cluster_size = cluster_size;
+    m_cluster_valid = false;
+    }
+
+void NeighborListGPUCluster::resetStats()
+    {
+    NeighborListGPUBinned::resetStats();
+
+    // the update counter restarts, so it no longer identifies the last build
+    m_cluster_valid = false;
+    }
+
+/*! \param timestep Current time step
+
+    The cluster pair list is rebuilt whenever the per-particle list is.
+*/
+void NeighborListGPUCluster::compute(uint64_t timestep)
+    {
+    NeighborListGPUBinned::compute(timestep);
+
+    if (m_cluster_valid && getNumUpdates() == m_cluster_updates)
+        return;
+
+    int64_t start_time = m_execution_clock.getTime();
+    if (m_prof)
+        m_prof->push(m_exec_conf, "Cluster");
+
+    buildClusterList();
+    m_cluster_updates = getNumUpdates();
+    m_cluster_valid = true;
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    m_execution_time += m_execution_clock.getTime() - start_time;
+    }
+
+void NeighborListGPUCluster::buildClusterList()
+    {
+    // i-clusters cover the local particles, j-clusters may also hold ghost particles
+    unsigned int N = m_pdata->getN();
+    unsigned int n_i_clusters = (N + m_cluster_size - 1) / m_cluster_size;
+
+    if (m_cluster_nmax == 0)
+        {
+        // start from the per-particle capacity, the list grows on overflow
+        ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
+            m_cluster_nmax = std::max(m_cluster_nmax, h_Nmax.data[i]);
+        m_cluster_nmax = std::max(m_cluster_nmax, 4u);
+        }
+
+    if (m_cluster_n_neigh.getNumElements() < n_i_clusters)
+        {
+        GlobalArray<unsigned int> cluster_n_neigh(n_i_clusters, m_exec_conf);
+        m_cluster_n_neigh.swap(cluster_n_neigh);
+        TAG_ALLOCATION(m_cluster_n_neigh);
+        }
+
+    bool overflowed = false;
+    do
+        {
+        size_t size = size_t(n_i_clusters) * m_cluster_nmax;
+        if (m_cluster_nlist.getNumElements() < size)
+            {
+            GlobalArray<unsigned int> cluster_nlist(size, m_exec_conf);
+            m_cluster_nlist.swap(cluster_nlist);
+            TAG_ALLOCATION(m_cluster_nlist);
+
+            GlobalArray<unsigned long long> cluster_mask(size, m_exec_conf);
+            m_cluster_mask.swap(cluster_mask);
+            TAG_ALLOCATION(m_cluster_mask);
+            }
+
+            {
+            ArrayHandle<unsigned int> d_cluster_n_neigh(m_cluster_n_neigh,
+                                                        access_location::device,
+                                                        access_mode::overwrite);
+            ArrayHandle<unsigned int> d_cluster_nlist(m_cluster_nlist,
+                                                      access_location::device,
+                                                      access_mode::overwrite);
+            ArrayHandle<unsigned long long> d_cluster_mask(m_cluster_mask,
+                                                           access_location::device,
+                                                           access_mode::overwrite);
+            ArrayHandle<unsigned int> d_conditions(m_cluster_conditions,
+                                                   access_location::device,
+                                                   access_mode::readwrite);
+            ArrayHandle<unsigned int> d_n_neigh(m_n_neigh,
+                                                access_location::device,
+                                                access_mode::read);
+            ArrayHandle<unsigned int> d_nlist(m_nlist, access_location::device, access_mode::read);
+            ArrayHandle<unsigned int> d_n_outliers(m_n_outliers,
+                                                   access_location::device,
+                                                   access_mode::read);
+            ArrayHandle<size_t> d_head_list(m_head_list,
+                                            access_location::device,
+                                            access_mode::read);
+
+            m_tuner_cluster->begin();
+            kernel::gpu_compute_cluster_nlist(d_cluster_n_neigh.data,
+                                              d_cluster_nlist.data,
+                                              d_cluster_mask.data,
+                                              d_conditions.data,
+                                              m_cluster_nmax,
+                                              d_n_neigh.data,
+                                              d_nlist.data,
+                                              m_compress ? d_n_outliers.data : nullptr,
+                                              d_head_list.data,
+                                              N,
+                                              m_cluster_size,
+                                              m_tuner_cluster->getParam());
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            m_tuner_cluster->end();
+            }
+
+        ArrayHandle<unsigned int> h_conditions(m_cluster_conditions,
+                                               access_location::host,
+                                               access_mode::readwrite);
+        overflowed = *h_conditions.data > m_cluster_nmax;
+        if (overflowed)
+            {
+            m_cluster_nmax = (*h_conditions.data + 3) & ~3;
+            m_exec_conf->msg->notice(6)
+                << "nlist.Cluster: (Re-)allocating cluster list, new size " << m_cluster_nmax
+                << " j-clusters per i-cluster" << endl;
+            }
+        *h_conditions.data = 0;
+        } while (overflowed);
+    }
+
+namespace detail
+    {
+void export_NeighborListGPUCluster(pybind11::module& m)
+    {
+    pybind11::class_<NeighborListGPUCluster,
+                     NeighborListGPUBinned,
+                     std::shared_ptr<NeighborListGPUCluster>>(m, "NeighborListGPUCluster")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>, Scalar>())
+        .def_property("cluster_size",
+                      &NeighborListGPUCluster::getClusterSize,
+                      &NeighborListGPUCluster::setClusterSize);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
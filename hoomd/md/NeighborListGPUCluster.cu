@@ -0,0 +1,185 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "NeighborListCompression.h"
+#include "NeighborListGPUCluster.cuh"
+
+/*! \file NeighborListGPUCluster.cu
+    \brief Defines GPU kernel code for cluster pair list generation on the GPU
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Kernel to build the cluster pair list from the per-particle neighbor list
+/*! \param d_cluster_n_neigh Number of j-clusters of each i-cluster
+    \param d_cluster_nlist j-clusters of each i-cluster, \a cluster_nmax per i-cluster
+    \param d_cluster_mask Interaction mask of each cluster pair
+    \param d_conditions Set to the required number of j-clusters per i-cluster on overflow
+    \param cluster_nmax Maximum number of j-clusters per i-cluster
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_nlist Per-particle neighbor list
+    \param d_n_outliers Number of outliers of each particle in a compressed \a d_nlist, or
+           nullptr when \a d_nlist is not compressed
+    \param d_head_list Indexes for reading \a d_nlist
+    \param N Number of local particles
+
+    \tparam cluster_size Number of particles per cluster
+
+    Cluster \a c holds the particles with indices \a c * \a cluster_size to
+    (\a c + 1) * \a cluster_size - 1. Bit \a i_sub * \a cluster_size + \a j_sub of the mask of a
+    cluster pair is set when particle \a j_sub of the j-cluster is in the neighbor list of
+    particle \a i_sub of the i-cluster, so the mask carries over the exclusions and body filters
+    already applied to the neighbor list.
+
+    Each thread builds the list of one i-cluster, merging the neighbors of its particles with a
+    linear search over the j-clusters found so far.
+*/
+template<unsigned int cluster_size>
+__global__ void gpu_compute_cluster_nlist_kernel(unsigned int* d_cluster_n_neigh,
+                                                 unsigned int* d_cluster_nlist,
+                                                 unsigned long long* d_cluster_mask,
+                                                 unsigned int* d_conditions,
+                                                 const unsigned int cluster_nmax,
+                                                 const unsigned int* d_n_neigh,
+                                                 const unsigned int* d_nlist,
+                                                 const unsigned int* d_n_outliers,
+                                                 const size_t* d_head_list,
+                                                 const unsigned int N)
+    {
+    unsigned int ci = blockIdx.x * blockDim.x + threadIdx.x;
+    if (ci >= (N + cluster_size - 1) / cluster_size)
+        return;
+
+    const size_t head = size_t(ci) * cluster_nmax;
+    unsigned int n_cj = 0;
+    unsigned int n_candidates = 0;
+    bool overflow = false;
+
+    for (unsigned int i_sub = 0; i_sub < cluster_size; ++i_sub)
+        {
+        unsigned int i = ci * cluster_size + i_sub;
+        if (i >= N)
+            break;
+
+        unsigned int n_neigh = d_n_neigh[i];
+        unsigned int n_outliers = d_n_outliers ? d_n_outliers[i] : n_neigh;
+        const unsigned int* my_nlist = d_nlist + d_head_list[i];
+        n_candidates += n_neigh;
+
+        for (unsigned int k = 0; k < n_neigh; ++k)
+            {
+            unsigned int j = detail::nlist_get_neighbor(my_nlist, i, n_outliers, k);
+            unsigned int cj = j / cluster_size;
+            unsigned long long bit = 1ull << (i_sub * cluster_size + j % cluster_size);
+
+            // find the j-cluster among those already in the list
+            unsigned int m = 0;
+            while (m < n_cj && d_cluster_nlist[head + m] != cj)
+                m++;
+
+            if (m < n_cj)
+                {
+                d_cluster_mask[head + m] |= bit;
+                }
+            else if (n_cj < cluster_nmax)
+                {
+                d_cluster_nlist[head + n_cj] = cj;
+                d_cluster_mask[head + n_cj] = bit;
+                n_cj++;
+                }
+            else
+                {
+                overflow = true;
+                }
+            }
+        }
+
+    // the number of neighbors bounds the number of unique j-clusters
+    if (overflow)
+        atomicMax(d_conditions, n_candidates);
+
+    d_cluster_n_neigh[ci] = n_cj;
+    }
+
+/*! \param d_cluster_n_neigh Number of j-clusters of each i-cluster
+    \param d_cluster_nlist j-clusters of each i-cluster, \a cluster_nmax per i-cluster
+    \param d_cluster_mask Interaction mask of each cluster pair
+    \param d_conditions Set to the required number of j-clusters per i-cluster on overflow
+    \param cluster_nmax Maximum number of j-clusters per i-cluster
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_nlist Per-particle neighbor list
+    \param d_n_outliers Number of outliers of each particle in a compressed \a d_nlist, or
+           nullptr when \a d_nlist is not compressed
+    \param d_head_list Indexes for reading \a d_nlist
+    \param N Number of local particles
+    \param cluster_size Number of particles per cluster (4 or 8)
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_compute_cluster_nlist(unsigned int* d_cluster_n_neigh,
+                                     unsigned int* d_cluster_nlist,
+                                     unsigned long long* d_cluster_mask,
+                                     unsigned int* d_conditions,
+                                     const unsigned int cluster_nmax,
+                                     const unsigned int* d_n_neigh,
+                                     const unsigned int* d_nlist,
+                                     const unsigned int* d_n_outliers,
+                                     const size_t* d_head_list,
+                                     const unsigned int N,
+                                     const unsigned int cluster_size,
+                                     const unsigned int block_size)
+    {
+    unsigned int n_clusters = (N + cluster_size - 1) / cluster_size;
+    dim3 grid(n_clusters / block_size + 1);
+
+    if (cluster_size == 4)
+        {
+        hipLaunchKernelGGL((gpu_compute_cluster_nlist_kernel<4>),
+                           grid,
+                           dim3(block_size),
+                           0,
+                           0,
+                           d_cluster_n_neigh,
+                           d_cluster_nlist,
+                           d_cluster_mask,
+                           d_conditions,
+                           cluster_nmax,
+                           d_n_neigh,
+                           d_nlist,
+                           d_n_outliers,
+                           d_head_list,
+                           N);
+        }
+    else if (cluster_size == 8)
+        {
+        hipLaunchKernelGGL((gpu_compute_cluster_nlist_kernel<8>),
+                           grid,
+                           dim3(block_size),
+                           0,
+                           0,
+                           d_cluster_n_neigh,
+                           d_cluster_nlist,
+                           d_cluster_mask,
+                           d_conditions,
+                           cluster_nmax,
+                           d_n_neigh,
+                           d_nlist,
+                           d_n_outliers,
+                           d_head_list,
+                           N);
+        }
+    else
+        {
+        return hipErrorInvalidValue;
+        }
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
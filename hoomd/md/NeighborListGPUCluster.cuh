@@ -0,0 +1,39 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __NEIGHBORLISTGPUCLUSTER_CUH__
+#define __NEIGHBORLISTGPUCLUSTER_CUH__
+
+#include <hip/hip_runtime.h>
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file NeighborListGPUCluster.cuh
+    \brief Declares GPU kernel code for cluster pair list generation on the GPU
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Kernel driver for gpu_compute_cluster_nlist_kernel()
+hipError_t gpu_compute_cluster_nlist(unsigned int* d_cluster_n_neigh,
+                                     unsigned int* d_cluster_nlist,
+                                     unsigned long long* d_cluster_mask,
+                                     unsigned int* d_conditions,
+                                     const unsigned int cluster_nmax,
+                                     const unsigned int* d_n_neigh,
+                                     const unsigned int* d_nlist,
+                                     const unsigned int* d_n_outliers,
+                                     const size_t* d_head_list,
+                                     const unsigned int N,
+                                     const unsigned int cluster_size,
+                                     const unsigned int block_size);
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -0,0 +1,130 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "NeighborListGPUBinned.h"
+
+/*! \file NeighborListGPUCluster.h
+    \brief Declares the NeighborListGPUCluster class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __NEIGHBORLISTGPUCLUSTER_H__
+#define __NEIGHBORLISTGPUCLUSTER_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Cluster pair list built on the GPU
+/*! Groups consecutive particles into clusters of 4 or 8 and lists the pairs of clusters that
+    interact, in the spirit of the GROMACS cluster pair lists. Particles are sorted along a space
+    filling curve, so the particles in a cluster are close in space and an i-cluster interacts with
+    far fewer j-clusters than its particles have neighbors. PotentialPairGPU walks the cluster pair
+    list with one thread per i-particle, where all threads of an i-cluster load the particles of a
+    j-cluster from consecutive addresses.
+
+    The cluster pair list is derived from the per-particle list built by NeighborListGPUBinned
+    every time that list is rebuilt. Each cluster pair carries an interaction mask with one bit per
+    particle pair that is set when the pair is in the per-particle list, so exclusions, body
+    filtering, and diameter shifting apply unchanged.
+
+    Cluster \a c holds the particles with indices \a c * cluster_size to
+    (\a c + 1) * cluster_size - 1, including ghost particles. The j-clusters of i-cluster \a c are
+    stored in getClusterNListArray() starting at \a c * getClusterNmax(), the number of j-clusters
+    in getClusterNNeighArray() and the masks in getClusterMaskArray(). Bit
+    \a i_sub * cluster_size + \a j_sub of a mask refers to particle \a i_sub of the i-cluster and
+    particle \a j_sub of the j-cluster.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT NeighborListGPUCluster : public NeighborListGPUBinned
+    {
+    public:
+    //! Constructs the compute
+    NeighborListGPUCluster(std::shared_ptr<SystemDefinition> sysdef, Scalar r_buff);
+
+    //! Destructor
+    virtual ~NeighborListGPUCluster();
+
+    //! Computes the per-particle list and the cluster pair list
+    virtual void compute(uint64_t timestep);
+
+    //! Number of particles per cluster
+    virtual unsigned int getClusterSize()
+        {
+        return m_cluster_size;
+        }
+
+    //! Set the number of particles per cluster
+    void setClusterSize(unsigned int cluster_size);
+
+    //! Invalidate the cluster pair list along with the update statistics
+    virtual void resetStats();
+
+    //! Set autotuner parameters
+    /*! \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        NeighborListGPUBinned::setAutotunerParams(enable, period);
+        m_tuner_cluster->setPeriod(period / 10);
+        m_tuner_cluster->setEnabled(enable);
+        }
+
+    //! Get the number of j-clusters of each i-cluster
+    const GlobalArray<unsigned int>& getClusterNNeighArray()
+        {
+        return m_cluster_n_neigh;
+        }
+
+    //! Get the j-clusters of each i-cluster
+    const GlobalArray<unsigned int>& getClusterNListArray()
+        {
+        return m_cluster_nlist;
+        }
+
+    //! Get the interaction mask of each cluster pair
+    const GlobalArray<unsigned long long>& getClusterMaskArray()
+        {
+        return m_cluster_mask;
+        }
+
+    //! Get the maximum number of j-clusters per i-cluster
+    unsigned int getClusterNmax()
+        {
+        return m_cluster_nmax;
+        }
+
+    protected:
+    unsigned int m_cluster_size = 8; //!< Number of particles per cluster
+    unsigned int m_cluster_nmax = 0; //!< Maximum number of j-clusters per i-cluster
+    uint64_t m_cluster_updates = 0;  //!< Value of getNumUpdates() at the last cluster list build
+    bool m_cluster_valid = false;    //!< True when the cluster pair list is up to date
+
+    GlobalArray<unsigned int> m_cluster_n_neigh;    //!< Number of j-clusters of each i-cluster
+    GlobalArray<unsigned int> m_cluster_nlist;      //!< j-clusters of each i-cluster
+    GlobalArray<unsigned long long> m_cluster_mask; //!< Interaction mask of each cluster pair
+    GlobalArray<unsigned int> m_cluster_conditions; //!< Required m_cluster_nmax on overflow
+
+    std::unique_ptr<Autotuner> m_tuner_cluster; //!< Autotuner for the cluster list block size
+
+    //! Builds the cluster pair list from the per-particle list
+    void buildClusterList();
+    };
+
+namespace detail
+    {
+//! Exports NeighborListGPUCluster to python
+void export_NeighborListGPUCluster(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
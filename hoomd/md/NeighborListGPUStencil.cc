@@ -14,6 +14,8 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#include <pybind11/stl.h>
+
 namespace hoomd
     {
 namespace md
@@ -90,8 +92,50 @@ NeighborListGPUStencil::~NeighborListGPUStencil()
         .disconnect<NeighborListGPUStencil, &NeighborListGPUStencil::slotParticleSort>(this);
     }
 
+/*! \param type_classes Names of the types in each class
+
+    Every type must be in exactly one class. An empty list bins all particles in one cell list. The
+    cell width of each class is set from the cutoffs to that class, not by setCellWidth().
+*/
+void NeighborListGPUStencil::setTypeClasses(
+    const std::vector<std::vector<std::string>>& type_classes)
+    {
+    std::vector<std::vector<unsigned int>> type_class_ids = getTypeClassIds(type_classes);
+
+    m_class_cl.clear();
+    m_class_cls.clear();
+    for (const std::vector<unsigned int>& types : type_class_ids)
+        {
+        std::shared_ptr<CellList> cl = std::make_shared<CellListGPU>(m_sysdef);
+        cl->setRadius(1);
+        cl->setComputeTDB(true);
+        cl->setFlagIndex();
+        cl->setComputeAdjList(false);
+        cl->setTypeFilter(types);
+
+        m_class_cl.push_back(cl);
+        m_class_cls.push_back(std::make_shared<CellListStencil>(m_sysdef, cl));
+        }
+
+    m_type_classes = type_classes;
+    m_update_cell_size = true;
+    m_needs_restencil = true;
+    forceUpdate();
+    }
+
 void NeighborListGPUStencil::updateRStencil()
     {
+    if (!m_type_classes.empty())
+        {
+        for (unsigned int cur_class = 0; cur_class < m_class_cl.size(); ++cur_class)
+            {
+            std::vector<Scalar> rstencil;
+            getTypeClassStencil(m_class_cl[cur_class]->getTypeFilter(), rstencil);
+            m_class_cls[cur_class]->setRStencil(rstencil);
+            }
+        return;
+        }
+
     ArrayHandle<Scalar> h_rcut_max(m_rcut_max, access_location::host, access_mode::read);
     std::vector<Scalar> rstencil(m_pdata->getNTypes(), -1.0);
     for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
@@ -190,10 +234,27 @@ void NeighborListGPUStencil::buildNlist(uint64_t timestep)
 
             m_cl->setNominalWidth(rmin);
             }
+
+        // size the cells of each class for the shortest cutoff to that class
+        for (auto& cl : m_class_cl)
+            {
+            std::vector<Scalar> rstencil;
+            cl->setNominalWidth(getTypeClassStencil(cl->getTypeFilter(), rstencil));
+            }
         m_update_cell_size = false;
         }
 
-    m_cl->compute(timestep);
+    // search one cell list per class, or one cell list with all particles
+    std::vector<std::shared_ptr<CellList>> cell_lists(1, m_cl);
+    std::vector<std::shared_ptr<CellListStencil>> stencils(1, m_cls);
+    if (!m_type_classes.empty())
+        {
+        cell_lists = m_class_cl;
+        stencils = m_class_cls;
+        }
+
+    for (auto& cl : cell_lists)
+        cl->compute(timestep);
 
     // update the stencil radii if there was a change
     if (m_needs_restencil)
@@ -201,7 +262,8 @@ void NeighborListGPUStencil::buildNlist(uint64_t timestep)
         updateRStencil();
         m_needs_restencil = false;
         }
-    m_cls->compute(timestep);
+    for (auto& cls : stencils)
+        cls->compute(timestep);
 
     // sort the particles by type
     if (m_needs_resort)
@@ -226,24 +288,6 @@ void NeighborListGPUStencil::buildNlist(uint64_t timestep)
     const BoxDim& box = m_pdata->getBox();
     Scalar3 nearest_plane_distance = box.getNearestPlaneDistance();
 
-    // access the cell list data arrays
-    ArrayHandle<unsigned int> d_cell_size(m_cl->getCellSizeArray(),
-                                          access_location::device,
-                                          access_mode::read);
-    ArrayHandle<Scalar4> d_cell_xyzf(m_cl->getXYZFArray(),
-                                     access_location::device,
-                                     access_mode::read);
-    ArrayHandle<Scalar4> d_cell_tdb(m_cl->getTDBArray(),
-                                    access_location::device,
-                                    access_mode::read);
-    ArrayHandle<Scalar4> d_stencil(m_cls->getStencils(),
-                                   access_location::device,
-                                   access_mode::read);
-    ArrayHandle<unsigned int> d_n_stencil(m_cls->getStencilSizes(),
-                                          access_location::device,
-                                          access_mode::read);
-    const Index2D& stencil_idx = m_cls->getStencilIndexer();
-
     ArrayHandle<size_t> d_head_list(m_head_list, access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_Nmax(m_Nmax, access_location::device, access_mode::read);
     ArrayHandle<unsigned int> d_conditions(m_conditions,
@@ -297,38 +341,62 @@ void NeighborListGPUStencil::buildNlist(uint64_t timestep)
     unsigned int block_size = param / 10000;
     unsigned int threads_per_particle = param % 10000;
 
-    // launch neighbor list kernel
-    kernel::gpu_compute_nlist_stencil(d_nlist.data,
-                                      d_n_neigh.data,
-                                      d_last_pos.data,
-                                      d_conditions.data,
-                                      d_Nmax.data,
-                                      d_head_list.data,
-                                      d_pid_map.data,
-                                      d_pos.data,
-                                      d_body.data,
-                                      d_diameter.data,
-                                      m_pdata->getN(),
-                                      d_cell_size.data,
-                                      d_cell_xyzf.data,
-                                      d_cell_tdb.data,
-                                      m_cl->getCellIndexer(),
-                                      m_cl->getCellListIndexer(),
-                                      d_stencil.data,
-                                      d_n_stencil.data,
-                                      stencil_idx,
-                                      box,
-                                      d_r_cut.data,
-                                      m_r_buff,
-                                      m_pdata->getNTypes(),
-                                      m_cl->getGhostWidth(),
-                                      m_filter_body,
-                                      m_diameter_shift,
-                                      threads_per_particle,
-                                      block_size);
-
-    if (m_exec_conf->isCUDAErrorCheckingEnabled())
-        CHECK_CUDA_ERROR();
+    // launch the neighbor list kernel once per class, each class adds to the previous neighbors
+    for (unsigned int cur_class = 0; cur_class < cell_lists.size(); ++cur_class)
+        {
+        const std::shared_ptr<CellList>& cl = cell_lists[cur_class];
+        const std::shared_ptr<CellListStencil>& cls = stencils[cur_class];
+
+        // access the cell list data arrays
+        ArrayHandle<unsigned int> d_cell_size(cl->getCellSizeArray(),
+                                              access_location::device,
+                                              access_mode::read);
+        ArrayHandle<Scalar4> d_cell_xyzf(cl->getXYZFArray(),
+                                         access_location::device,
+                                         access_mode::read);
+        ArrayHandle<Scalar4> d_cell_tdb(cl->getTDBArray(),
+                                        access_location::device,
+                                        access_mode::read);
+        ArrayHandle<Scalar4> d_stencil(cls->getStencils(),
+                                       access_location::device,
+                                       access_mode::read);
+        ArrayHandle<unsigned int> d_n_stencil(cls->getStencilSizes(),
+                                              access_location::device,
+                                              access_mode::read);
+
+        kernel::gpu_compute_nlist_stencil(d_nlist.data,
+                                          d_n_neigh.data,
+                                          d_last_pos.data,
+                                          d_conditions.data,
+                                          d_Nmax.data,
+                                          d_head_list.data,
+                                          d_pid_map.data,
+                                          d_pos.data,
+                                          d_body.data,
+                                          d_diameter.data,
+                                          m_pdata->getN(),
+                                          d_cell_size.data,
+                                          d_cell_xyzf.data,
+                                          d_cell_tdb.data,
+                                          cl->getCellIndexer(),
+                                          cl->getCellListIndexer(),
+                                          d_stencil.data,
+                                          d_n_stencil.data,
+                                          cls->getStencilIndexer(),
+                                          box,
+                                          d_r_cut.data,
+                                          m_r_buff,
+                                          m_pdata->getNTypes(),
+                                          cl->getGhostWidth(),
+                                          cur_class > 0,
+                                          m_filter_body,
+                                          m_diameter_shift,
+                                          threads_per_particle,
+                                          block_size);
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
     if (tune)
         this->m_tuner->end();
 
@@ -346,7 +414,10 @@ void export_NeighborListGPUStencil(pybind11::module& m)
                      NeighborListGPU,
                      std::shared_ptr<NeighborListGPUStencil>>(m, "NeighborListGPUStencil")
         .def(pybind11::init<std::shared_ptr<SystemDefinition>, Scalar>())
-        .def("setCellWidth", &NeighborListGPUStencil::setCellWidth);
+        .def("setCellWidth", &NeighborListGPUStencil::setCellWidth)
+        .def_property("type_classes",
+                      &NeighborListGPUStencil::getTypeClasses,
+                      &NeighborListGPUStencil::setTypeClasses);
     }
 
     } // end namespace detail
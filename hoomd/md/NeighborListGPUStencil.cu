@@ -47,6 +47,7 @@ namespace kernel
     \param r_buff The maximum radius for which to include particles as neighbors
     \param ntypes Number of particle types
     \param ghost_width Width of ghost cell layer
+    \param append Add the neighbors found to those already in \a d_n_neigh
 
     \note optimized for Kepler
 */
@@ -74,7 +75,8 @@ __global__ void gpu_compute_nlist_stencil_kernel(unsigned int* d_nlist,
                                                  const Scalar* d_r_cut,
                                                  const Scalar r_buff,
                                                  const unsigned int ntypes,
-                                                 const Scalar3 ghost_width)
+                                                 const Scalar3 ghost_width,
+                                                 const bool append)
     {
     bool filter_body = flags & 1;
     bool diameter_shift = flags & 2;
@@ -164,8 +166,8 @@ __global__ void gpu_compute_nlist_stencil_kernel(unsigned int* d_nlist,
 
     bool done = false;
 
-    // total number of neighbors
-    unsigned int nneigh = 0;
+    // total number of neighbors, continuing from an earlier build over a different cell list
+    unsigned int nneigh = append ? d_n_neigh[my_pidx] : 0;
 
     while (!done)
         {
@@ -345,6 +347,7 @@ inline void stencil_launcher(unsigned int* d_nlist,
                              const Scalar r_buff,
                              const unsigned int ntypes,
                              const Scalar3& ghost_width,
+                             const bool append,
                              bool filter_body,
                              bool diameter_shift,
                              const unsigned int threads_per_particle,
@@ -394,7 +397,8 @@ inline void stencil_launcher(unsigned int* d_nlist,
                                d_r_cut,
                                r_buff,
                                ntypes,
-                               ghost_width);
+                               ghost_width,
+                               append);
             }
         else if (!diameter_shift && filter_body)
             {
@@ -433,7 +437,8 @@ inline void stencil_launcher(unsigned int* d_nlist,
                                d_r_cut,
                                r_buff,
                                ntypes,
-                               ghost_width);
+                               ghost_width,
+                               append);
             }
         else if (diameter_shift && !filter_body)
             {
@@ -472,7 +477,8 @@ inline void stencil_launcher(unsigned int* d_nlist,
                                d_r_cut,
                                r_buff,
                                ntypes,
-                               ghost_width);
+                               ghost_width,
+                               append);
             }
         else if (diameter_shift && filter_body)
             {
@@ -511,7 +517,8 @@ inline void stencil_launcher(unsigned int* d_nlist,
                                d_r_cut,
                                r_buff,
                                ntypes,
-                               ghost_width);
+                               ghost_width,
+                               append);
             }
         }
     else
@@ -540,6 +547,7 @@ inline void stencil_launcher(unsigned int* d_nlist,
                                       r_buff,
                                       ntypes,
                                       ghost_width,
+                                      append,
                                       filter_body,
                                       diameter_shift,
                                       threads_per_particle,
@@ -573,6 +581,7 @@ inline void stencil_launcher<min_threads_per_particle / 2>(unsigned int* d_nlist
                                                            const Scalar r_buff,
                                                            const unsigned int ntypes,
                                                            const Scalar3& ghost_width,
+                                                           const bool append,
                                                            bool filter_body,
                                                            bool diameter_shift,
                                                            const unsigned int threads_per_particle,
@@ -604,6 +613,7 @@ hipError_t gpu_compute_nlist_stencil(unsigned int* d_nlist,
                                      const Scalar r_buff,
                                      const unsigned int ntypes,
                                      const Scalar3& ghost_width,
+                                     const bool append,
                                      bool filter_body,
                                      bool diameter_shift,
                                      const unsigned int threads_per_particle,
@@ -633,6 +643,7 @@ hipError_t gpu_compute_nlist_stencil(unsigned int* d_nlist,
                                                r_buff,
                                                ntypes,
                                                ghost_width,
+                                               append,
                                                filter_body,
                                                diameter_shift,
                                                threads_per_particle,
@@ -56,6 +56,7 @@ hipError_t gpu_compute_nlist_stencil(unsigned int* d_nlist,
                                      const Scalar r_buff,
                                      const unsigned int ntypes,
                                      const Scalar3& ghost_width,
+                                     const bool append,
                                      bool filter_body,
                                      bool diameter_shift,
                                      const unsigned int threads_per_particle,
@@ -31,6 +31,10 @@ namespace md
     GPU kernel methods are defined in NeighborListGPUStencil.cuh and defined in
    NeighborListGPUStencil.cu.
 
+    When type classes are set, each class is binned in its own cell list and the kernel is launched
+    once per class, adding the neighbors found to those of the previous classes (see
+    NeighborListStencil).
+
     \ingroup computes
 */
 class PYBIND11_EXPORT NeighborListGPUStencil : public NeighborListGPU
@@ -50,6 +54,14 @@ class PYBIND11_EXPORT NeighborListGPUStencil : public NeighborListGPU
         NeighborListGPU::notifyRCutMatrixChange();
         }
 
+    /// Notify NeighborList that r_cut matrix values have decreased
+    virtual void notifyRCutMatrixShrink()
+        {
+        m_update_cell_size = true;
+        m_needs_restencil = true;
+        NeighborListGPU::notifyRCutMatrixShrink();
+        }
+
     //! Change the underlying cell width
     void setCellWidth(Scalar cell_width)
         {
@@ -58,6 +70,15 @@ class PYBIND11_EXPORT NeighborListGPUStencil : public NeighborListGPU
         m_cl->setNominalWidth(cell_width);
         }
 
+    /// Set the names of the types in each class (empty to bin all types together)
+    void setTypeClasses(const std::vector<std::vector<std::string>>& type_classes);
+
+    /// Get the names of the types in each class
+    std::vector<std::vector<std::string>> getTypeClasses()
+        {
+        return m_type_classes;
+        }
+
     //! Set autotuner parameters
     /*! \param enable Enable/disable autotuning
         \param period period (approximate) in time steps when returning occurs
@@ -101,6 +122,11 @@ class PYBIND11_EXPORT NeighborListGPUStencil : public NeighborListGPU
 
     /// Track when the cell size needs to be updated
     bool m_update_cell_size = false;
+
+    /// Names of the types in each class
+    std::vector<std::vector<std::string>> m_type_classes;
+    std::vector<std::shared_ptr<CellList>> m_class_cl;         //!< Cell list of each class
+    std::vector<std::shared_ptr<CellListStencil>> m_class_cls; //!< Stencils of each class
     };
 
 namespace detail
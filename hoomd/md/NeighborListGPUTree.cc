@@ -25,6 +25,7 @@ namespace md
  */
 NeighborListGPUTree::NeighborListGPUTree(std::shared_ptr<SystemDefinition> sysdef, Scalar r_buff)
     : NeighborListGPU(sysdef, r_buff), m_type_bits(1), m_lbvh_errors(m_exec_conf), m_n_images(0),
+      m_refit_threshold(0.0), m_can_refit(false), m_refit_n(0), m_types_changed(m_exec_conf),
       m_types_allocated(false), m_box_changed(true), m_max_num_changed(true), m_max_types(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing NeighborListGPUTree" << std::endl;
@@ -32,6 +33,8 @@ NeighborListGPUTree::NeighborListGPUTree(std::shared_ptr<SystemDefinition> sysde
         .connect<NeighborListGPUTree, &NeighborListGPUTree::slotBoxChanged>(this);
     m_pdata->getMaxParticleNumberChangeSignal()
         .connect<NeighborListGPUTree, &NeighborListGPUTree::slotMaxNumChanged>(this);
+    m_pdata->getParticleSortSignal()
+        .connect<NeighborListGPUTree, &NeighborListGPUTree::slotParticleSort>(this);
 
     hipDeviceProp_t dev_prop = m_exec_conf->dev_prop;
     unsigned int warp_size = dev_prop.warpSize;
@@ -57,6 +60,13 @@ NeighborListGPUTree::NeighborListGPUTree(std::shared_ptr<SystemDefinition> sysde
                                      100000,
                                      "nlist_tree_copy",
                                      m_exec_conf));
+    m_refit_tuner.reset(new Autotuner(warp_size,
+                                      max_threads,
+                                      warp_size,
+                                      5,
+                                      100000,
+                                      "nlist_tree_refit",
+                                      m_exec_conf));
     }
 
 /*!
@@ -69,6 +79,8 @@ NeighborListGPUTree::~NeighborListGPUTree()
         .disconnect<NeighborListGPUTree, &NeighborListGPUTree::slotBoxChanged>(this);
     m_pdata->getMaxParticleNumberChangeSignal()
         .disconnect<NeighborListGPUTree, &NeighborListGPUTree::slotMaxNumChanged>(this);
+    m_pdata->getParticleSortSignal()
+        .disconnect<NeighborListGPUTree, &NeighborListGPUTree::slotParticleSort>(this);
 
     // destroy all of the created streams
     for (auto stream = m_streams.begin(); stream != m_streams.end(); ++stream)
@@ -83,7 +95,8 @@ NeighborListGPUTree::~NeighborListGPUTree()
  * First, memory is reallocated based on the number of particles and types.
  * The traversal images are also updated if the box has changed. One LBVH is then
  * built for each particle type using buildTree(), and these LBVHs are traversed in
- * traverseTree().
+ * traverseTree(). When a refit threshold is set, refitTree() first tries to reuse the
+ * LBVHs of the last build.
  */
 void NeighborListGPUTree::buildNlist(uint64_t timestep)
     {
@@ -108,6 +121,9 @@ void NeighborListGPUTree::buildNlist(uint64_t timestep)
         GPUArray<unsigned int> traverse_order(m_pdata->getMaxN(), m_exec_conf);
         m_traverse_order.swap(traverse_order);
 
+        GPUArray<unsigned int> refit_visits(m_pdata->getMaxN(), m_exec_conf);
+        m_refit_visits.swap(refit_visits);
+
         // all done with the particle data reallocation
         m_max_num_changed = false;
         }
@@ -190,7 +206,9 @@ void NeighborListGPUTree::buildNlist(uint64_t timestep)
     // build the tree
     if (m_prof)
         m_prof->push(m_exec_conf, "build");
-    buildTree();
+    markTypes();
+    if (!refitTree())
+        buildTree();
     if (m_prof)
         m_prof->pop(m_exec_conf);
 
@@ -202,12 +220,89 @@ void NeighborListGPUTree::buildNlist(uint64_t timestep)
         m_prof->pop(m_exec_conf);
     }
 
+/*!
+ * Each particle is marked with its type for sorting, and ghosts that lie outside the current box
+ * are marked with the ghost sentinel. The positions are also saved for the distance check. An
+ * error is raised if a local particle is out of bounds.
+ */
+void NeighborListGPUTree::markTypes()
+    {
+    // also, check particles to filter out ghosts that lie outside the current box
+    const BoxDim& box = m_pdata->getBox();
+    Scalar ghost_layer_width(0.0);
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        ghost_layer_width = m_comm->getGhostLayerMaxWidth();
+#endif
+    Scalar3 ghost_width = make_scalar3(0.0, 0.0, 0.0);
+    if (!box.getPeriodic().x)
+        ghost_width.x = ghost_layer_width;
+    if (!box.getPeriodic().y)
+        ghost_width.y = ghost_layer_width;
+    if (!box.getPeriodic().z && m_sysdef->getNDimensions() == 3)
+        {
+        ghost_width.z = ghost_layer_width;
+        }
+
+        {
+        ArrayHandle<unsigned int> d_types(m_types, access_location::device, access_mode::overwrite);
+        ArrayHandle<unsigned int> d_indexes(m_indexes,
+                                            access_location::device,
+                                            access_mode::overwrite);
+        m_lbvh_errors.resetFlags(0);
+        ArrayHandle<Scalar4> d_last_pos(m_last_pos,
+                                        access_location::device,
+                                        access_mode::overwrite);
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::read);
+
+        m_mark_tuner->begin();
+        kernel::gpu_nlist_mark_types(d_types.data,
+                                     d_indexes.data,
+                                     m_lbvh_errors.getDeviceFlags(),
+                                     d_last_pos.data,
+                                     d_pos.data,
+                                     m_pdata->getN(),
+                                     m_pdata->getNGhosts(),
+                                     box,
+                                     ghost_width,
+                                     m_mark_tuner->getParam());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_mark_tuner->end();
+        }
+
+    // error check that no local particles are out of bounds
+    const unsigned int lbvh_errors = m_lbvh_errors.readFlags();
+    if (lbvh_errors)
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::read);
+
+        const unsigned int error_idx = lbvh_errors - 1;
+        const Scalar4 error_pos = h_pos.data[error_idx];
+        const unsigned int error_tag = h_tag.data[error_idx];
+
+        m_exec_conf->msg->error() << "nlist.tree(): Particle " << error_tag << " is out of bounds "
+                                  << "(" << error_pos.x << ", " << error_pos.y << ", "
+                                  << error_pos.z << ")" << std::endl;
+        throw std::runtime_error("Error updating neighborlist");
+        }
+    }
+
 /*!
  * Builds the LBVHs by first sorting the particles by type (to make one LBVH per type).
  * This method also puts the particles into the right order for traversal, and it prepares
  * each LBVH traverser so that subsequent calls to traverse can safely use the cached version
  * of the traverser internal data.
  *
+ * The particles must already be marked by markTypes().
+ *
  * The builds and the traverser setup are done in CUDA streams. I believe that the build has
  * a blocking call for a single CPU thread because of a stream synchronize due to CUB's use of the
  * double buffer. (It must report which buffer holds the sorted data.) However, benchmarks showed
@@ -219,79 +314,6 @@ void NeighborListGPUTree::buildNlist(uint64_t timestep)
  */
 void NeighborListGPUTree::buildTree()
     {
-        // set the data by type
-        {
-        // also, check particles to filter out ghosts that lie outside the current box
-        const BoxDim& box = m_pdata->getBox();
-        Scalar ghost_layer_width(0.0);
-#ifdef ENABLE_MPI
-        if (m_sysdef->isDomainDecomposed())
-            ghost_layer_width = m_comm->getGhostLayerMaxWidth();
-#endif
-        Scalar3 ghost_width = make_scalar3(0.0, 0.0, 0.0);
-        if (!box.getPeriodic().x)
-            ghost_width.x = ghost_layer_width;
-        if (!box.getPeriodic().y)
-            ghost_width.y = ghost_layer_width;
-        if (!box.getPeriodic().z && m_sysdef->getNDimensions() == 3)
-            {
-            ghost_width.z = ghost_layer_width;
-            }
-
-            {
-            ArrayHandle<unsigned int> d_types(m_types,
-                                              access_location::device,
-                                              access_mode::overwrite);
-            ArrayHandle<unsigned int> d_indexes(m_indexes,
-                                                access_location::device,
-                                                access_mode::overwrite);
-            m_lbvh_errors.resetFlags(0);
-            ArrayHandle<Scalar4> d_last_pos(m_last_pos,
-                                            access_location::device,
-                                            access_mode::overwrite);
-            ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
-                                       access_location::device,
-                                       access_mode::read);
-
-            m_mark_tuner->begin();
-            kernel::gpu_nlist_mark_types(d_types.data,
-                                         d_indexes.data,
-                                         m_lbvh_errors.getDeviceFlags(),
-                                         d_last_pos.data,
-                                         d_pos.data,
-                                         m_pdata->getN(),
-                                         m_pdata->getNGhosts(),
-                                         box,
-                                         ghost_width,
-                                         m_mark_tuner->getParam());
-            if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                CHECK_CUDA_ERROR();
-            m_mark_tuner->end();
-            }
-
-        // error check that no local particles are out of bounds
-        const unsigned int lbvh_errors = m_lbvh_errors.readFlags();
-        if (lbvh_errors)
-            {
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                       access_location::host,
-                                       access_mode::read);
-            ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
-                                            access_location::host,
-                                            access_mode::read);
-
-            const unsigned int error_idx = lbvh_errors - 1;
-            const Scalar4 error_pos = h_pos.data[error_idx];
-            const unsigned int error_tag = h_tag.data[error_idx];
-
-            m_exec_conf->msg->error()
-                << "nlist.tree(): Particle " << error_tag << " is out of bounds "
-                << "(" << error_pos.x << ", " << error_pos.y << ", " << error_pos.z << ")"
-                << std::endl;
-            throw std::runtime_error("Error updating neighborlist");
-            }
-        }
-
     // sort the particles by type, pushing out-of-bounds ghosts to the ends
     if (m_pdata->getNTypes() > 1 || m_pdata->getNGhosts() > 0)
         {
@@ -480,16 +502,145 @@ void NeighborListGPUTree::buildTree()
         // loops are not fused to avoid streams or syncing in kernel loop above, but could be done
         // if necessary
         hipDeviceSynchronize();
+        }
+    setupTraversers();
+
+    // save the quality of the new LBVHs to decide when the refits have degraded them
+    if (m_refit_threshold > Scalar(0.0))
+        {
+        m_build_area.resize(m_pdata->getNTypes());
+        for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
+            {
+            m_build_area[i] = m_lbvhs[i]->getSurfaceArea();
+            }
+        m_refit_n = m_pdata->getN() + m_pdata->getNGhosts();
+        m_can_refit = true;
+        }
+    }
+
+/*!
+ * \returns True if the LBVHs were refit, false if they must be rebuilt.
+ *
+ * The LBVHs of the last build are refit to the current positions when they still hold the same
+ * particles in the same order: the particles have not been sorted, have not changed type, and
+ * have not been added or removed. The refit keeps the topology of each LBVH, so its bounding boxes
+ * grow as the particles diffuse away from the positions they were built at. The LBVHs are rebuilt
+ * once the surface area of any LBVH exceeds m_refit_threshold times its area after the build.
+ *
+ * The particles must already be marked by markTypes(). Refits are not used in domain decomposed
+ * simulations, where the ghost particles change on every step.
+ */
+bool NeighborListGPUTree::refitTree()
+    {
+    if (m_refit_threshold <= Scalar(0.0) || !m_can_refit)
+        return false;
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        return false;
+#endif
+
+    const unsigned int N = m_pdata->getN() + m_pdata->getNGhosts();
+    if (N != m_refit_n || m_build_area.size() != m_pdata->getNTypes())
+        return false;
+
+        // check that the particles still have the types they were sorted by
+        {
+        ArrayHandle<unsigned int> d_types(m_types, access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_sorted_types(m_sorted_types,
+                                                 access_location::device,
+                                                 access_mode::read);
+        ArrayHandle<unsigned int> d_sorted_indexes(m_sorted_indexes,
+                                                   access_location::device,
+                                                   access_mode::read);
+
+        m_types_changed.resetFlags(0);
+        kernel::gpu_nlist_check_types(m_types_changed.getDeviceFlags(),
+                                      d_types.data,
+                                      d_sorted_types.data,
+                                      d_sorted_indexes.data,
+                                      N,
+                                      m_mark_tuner->getParam());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+    if (m_types_changed.readFlags())
+        {
+        m_can_refit = false;
+        return false;
+        }
+
+        // refit each lbvh in its own stream
+        {
+        ArrayHandle<unsigned int> h_type_first(m_type_first,
+                                               access_location::host,
+                                               access_mode::read);
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> d_sorted_indexes(m_sorted_indexes,
+                                                   access_location::device,
+                                                   access_mode::read);
+        ArrayHandle<unsigned int> d_refit_visits(m_refit_visits,
+                                                 access_location::device,
+                                                 access_mode::overwrite);
+
+        hipDeviceSynchronize();
+        m_refit_tuner->begin();
+        const unsigned int block_size = m_refit_tuner->getParam();
         for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
             {
             if (m_lbvhs[i]->getN() == 0)
                 continue;
-            m_traversers[i]->setup(d_sorted_indexes.data + h_type_first.data[i],
-                                   *(*m_lbvhs[i]).get(),
-                                   m_streams[i]);
+
+            // each type counts its visits in its own range of the scratch array
+            const unsigned int first = h_type_first.data[i];
+            m_lbvhs[i]->refit(d_pos.data,
+                              d_sorted_indexes.data + first,
+                              d_refit_visits.data + first,
+                              m_streams[i],
+                              block_size);
             }
+        m_refit_tuner->end();
+        // wait for all refits to finish
         hipDeviceSynchronize();
         }
+
+    // rebuild if the refits have degraded the lbvhs too much
+    for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
+        {
+        if (m_lbvhs[i]->getN() > 0
+            && m_lbvhs[i]->getSurfaceArea() > m_refit_threshold * m_build_area[i])
+            {
+            return false;
+            }
+        }
+
+    setupTraversers();
+    return true;
+    }
+
+/*!
+ * Each traverser compresses its LBVH so that subsequent calls to traverse can use the cached
+ * version of the traverser internal data. The traversers must be set up again after each build or
+ * refit.
+ */
+void NeighborListGPUTree::setupTraversers()
+    {
+    ArrayHandle<unsigned int> h_type_first(m_type_first, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> d_sorted_indexes(m_sorted_indexes,
+                                               access_location::device,
+                                               access_mode::read);
+
+    for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
+        {
+        if (m_lbvhs[i]->getN() == 0)
+            continue;
+        m_traversers[i]->setup(d_sorted_indexes.data + h_type_first.data[i],
+                               *(*m_lbvhs[i]).get(),
+                               m_streams[i]);
+        }
+    hipDeviceSynchronize();
     }
 
 /*!
@@ -680,7 +831,10 @@ void export_NeighborListGPUTree(pybind11::module& m)
     pybind11::class_<NeighborListGPUTree, NeighborListGPU, std::shared_ptr<NeighborListGPUTree>>(
         m,
         "NeighborListGPUTree")
-        .def(pybind11::init<std::shared_ptr<SystemDefinition>, Scalar>());
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>, Scalar>())
+        .def_property("refit_threshold",
+                      &NeighborListGPUTree::getRefitThreshold,
+                      &NeighborListGPUTree::setRefitThreshold);
     }
 
     } // end namespace detail
@@ -11,7 +11,10 @@
 #include <hipcub/hipcub.hpp>
 #include <thrust/execution_policy.h>
 #include <thrust/fill.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/counting_iterator.h>
 #include <thrust/remove.h>
+#include <thrust/transform_reduce.h>
 #pragma GCC diagnostic pop
 
 #include <neighbor/neighbor.h>
@@ -339,6 +342,67 @@ hipError_t gpu_nlist_copy_primitives(unsigned int* d_traverse_order,
     return hipSuccess;
     }
 
+//! Kernel to check that the particles still have the types they were sorted by
+/*!
+ * \param d_changed Flag set to 1 if any particle changed its type.
+ * \param d_types Current type of each particle (or the ghost sentinel).
+ * \param d_sorted_types Types of the particles when they were sorted.
+ * \param d_sorted_indexes Particle indexes in sorted order.
+ * \param N Number of particles (local + ghosts).
+ *
+ * The LBVHs can only be refit if they still hold the particles of their type.
+ */
+__global__ void gpu_nlist_check_types_kernel(unsigned int* d_changed,
+                                             const unsigned int* d_types,
+                                             const unsigned int* d_sorted_types,
+                                             const unsigned int* d_sorted_indexes,
+                                             const unsigned int N)
+    {
+    // one thread per particle
+    const unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    if (d_types[d_sorted_indexes[idx]] != d_sorted_types[idx])
+        *d_changed = 1;
+    }
+
+/*!
+ * \param d_changed Flag set to 1 if any particle changed its type.
+ * \param d_types Current type of each particle (or the ghost sentinel).
+ * \param d_sorted_types Types of the particles when they were sorted.
+ * \param d_sorted_indexes Particle indexes in sorted order.
+ * \param N Number of particles (local + ghosts).
+ * \param block_size Number of CUDA threads per block.
+ *
+ * \sa gpu_nlist_check_types_kernel
+ */
+hipError_t gpu_nlist_check_types(unsigned int* d_changed,
+                                 const unsigned int* d_types,
+                                 const unsigned int* d_sorted_types,
+                                 const unsigned int* d_sorted_indexes,
+                                 const unsigned int N,
+                                 const unsigned int block_size)
+    {
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(gpu_nlist_check_types_kernel));
+    max_block_size = attr.maxThreadsPerBlock;
+
+    int run_block_size = min(block_size, max_block_size);
+    hipLaunchKernelGGL(gpu_nlist_check_types_kernel,
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_changed,
+                       d_types,
+                       d_sorted_types,
+                       d_sorted_indexes,
+                       N);
+    return hipSuccess;
+    }
+
 /////////////////////////////////////
 // neighbor program and wrappers
 /////////////////////////////////////
@@ -436,6 +500,105 @@ struct PointMapInsertOp
     const unsigned int N;
     };
 
+//! Load a bounding box corner written by another thread
+DEVICE float3 load_volatile(const float3* p)
+    {
+    const volatile float* v = reinterpret_cast<const volatile float*>(p);
+    return make_float3(v[0], v[1], v[2]);
+    }
+
+//! Kernel to refit the bounding boxes of an LBVH to the current positions
+/*!
+ * \param d_lo Lower bounds of the nodes.
+ * \param d_hi Upper bounds of the nodes.
+ * \param d_visits Number of children that reached each internal node (zeroed before launch).
+ * \param d_parent Parent of each node.
+ * \param d_left Left child of each internal node.
+ * \param d_right Right child of each internal node.
+ * \param d_primitives Primitive of each leaf.
+ * \param insert Insert operation for the current positions.
+ * \param root Root node of the LBVH.
+ *
+ * The topology of the LBVH is kept. One thread per leaf recomputes the bounding box of the leaf
+ * and then walks toward the root. The first child to reach an internal node stops, and the second
+ * merges the boxes of both children, so each internal node is computed once after both of its
+ * children are final. The internal nodes are indexed [0,N-1) and the leaves [N-1,2N-1).
+ */
+__global__ void gpu_nlist_refit_kernel(float3* d_lo,
+                                       float3* d_hi,
+                                       unsigned int* d_visits,
+                                       const int* d_parent,
+                                       const int* d_left,
+                                       const int* d_right,
+                                       const unsigned int* d_primitives,
+                                       const PointMapInsertOp insert,
+                                       const int root)
+    {
+    // one thread per leaf
+    const unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+    const unsigned int N = insert.size();
+    if (idx >= N)
+        return;
+
+    int node = N - 1 + idx;
+    const neighbor::BoundingBox leaf = insert.get(d_primitives[idx]);
+    d_lo[node] = leaf.lo;
+    d_hi[node] = leaf.hi;
+
+    while (node != root)
+        {
+        node = d_parent[node];
+
+        // make the box of this child visible before the sibling can read it
+        __threadfence();
+        if (atomicAdd(d_visits + node, 1) == 0)
+            return;
+
+        const int left = d_left[node];
+        const int right = d_right[node];
+        const float3 lo_left = load_volatile(d_lo + left);
+        const float3 hi_left = load_volatile(d_hi + left);
+        const float3 lo_right = load_volatile(d_lo + right);
+        const float3 hi_right = load_volatile(d_hi + right);
+
+        d_lo[node] = make_float3(fminf(lo_left.x, lo_right.x),
+                                 fminf(lo_left.y, lo_right.y),
+                                 fminf(lo_left.z, lo_right.z));
+        d_hi[node] = make_float3(fmaxf(hi_left.x, hi_right.x),
+                                 fmaxf(hi_left.y, hi_right.y),
+                                 fmaxf(hi_left.z, hi_right.z));
+        }
+    }
+
+//! Surface area of an LBVH node
+struct NodeSurfaceAreaOp
+    {
+    //! Constructor
+    /*!
+     * \param lo_ Lower bounds of the nodes.
+     * \param hi_ Upper bounds of the nodes.
+     */
+    NodeSurfaceAreaOp(const float3* lo_, const float3* hi_) : lo(lo_), hi(hi_) { }
+
+    //! Compute the surface area of a node
+    /*!
+     * \param node Index of the node.
+     * \returns The surface area of the bounding box of \a node.
+     */
+    __host__ __device__ float operator()(const unsigned int node) const
+        {
+        const float3 l = lo[node];
+        const float3 h = hi[node];
+        const float dx = h.x - l.x;
+        const float dy = h.y - l.y;
+        const float dz = h.z - l.z;
+        return 2.0f * (dx * dy + dy * dz + dz * dx);
+        }
+
+    const float3* lo; //!< Lower bounds of the nodes
+    const float3* hi; //!< Upper bounds of the nodes
+    };
+
 //! Neighbor list particle query operation.
 /*!
  * \tparam use_body If true, use the body fields during query.
@@ -881,6 +1044,75 @@ std::vector<unsigned int> LBVHWrapper::getTunableParameters() const
     return lbvh_->getTunableParameters();
     }
 
+/*!
+ * \param points Particle positions
+ * \param map Mapping of particles for insertion (same as for the last build)
+ * \param visits Scratch space for at least getN() counters
+ * \param stream CUDA stream for execution
+ * \param block_size CUDA block size for execution
+ *
+ * The bounding boxes of all nodes are recomputed for the current positions without changing the
+ * topology of the LBVH, so the primitives must be the same as in the last build.
+ *
+ * \sa gpu_nlist_refit_kernel
+ */
+void LBVHWrapper::refit(const Scalar4* points,
+                        const unsigned int* map,
+                        unsigned int* visits,
+                        hipStream_t stream,
+                        unsigned int block_size)
+    {
+    const unsigned int N = lbvh_->getN();
+    if (N == 0)
+        return;
+
+    if (N > 1)
+        hipMemsetAsync(visits, 0, sizeof(unsigned int) * (N - 1), stream);
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(gpu_nlist_refit_kernel));
+    max_block_size = attr.maxThreadsPerBlock;
+
+    PointMapInsertOp insert(points, map, N);
+    int run_block_size = min(block_size, max_block_size);
+    hipLaunchKernelGGL(gpu_nlist_refit_kernel,
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       stream,
+                       lbvh_->getLowerBounds().get(),
+                       lbvh_->getUpperBounds().get(),
+                       visits,
+                       lbvh_->getParents().get(),
+                       lbvh_->getLeftChildren().get(),
+                       lbvh_->getRightChildren().get(),
+                       lbvh_->getPrimitives().get(),
+                       insert,
+                       lbvh_->getRoot());
+    }
+
+/*!
+ * \returns The summed surface area of the internal nodes.
+ *
+ * The sum measures the quality of the LBVH: it grows as refits stretch the boxes of nodes whose
+ * particles have moved apart.
+ */
+float LBVHWrapper::getSurfaceArea() const
+    {
+    const unsigned int N = lbvh_->getN();
+    if (N <= 1)
+        return 0.0f;
+
+    NodeSurfaceAreaOp area(lbvh_->getLowerBounds().get(), lbvh_->getUpperBounds().get());
+    return thrust::transform_reduce(thrust::device,
+                                    thrust::counting_iterator<unsigned int>(0),
+                                    thrust::counting_iterator<unsigned int>(N - 1),
+                                    area,
+                                    0.0f,
+                                    thrust::plus<float>());
+    }
+
 /*!
  * Initializes the shared pointer for the underlying LBVHTraverser.
  */
@@ -69,6 +69,14 @@ hipError_t gpu_nlist_copy_primitives(unsigned int* d_traverse_order,
                                      const unsigned int N,
                                      const unsigned int block_size);
 
+//! Kernel driver to check that the particles still have the types they were sorted by
+hipError_t gpu_nlist_check_types(unsigned int* d_changed,
+                                 const unsigned int* d_types,
+                                 const unsigned int* d_sorted_types,
+                                 const unsigned int* d_sorted_indexes,
+                                 const unsigned int N,
+                                 const unsigned int block_size);
+
 //! Wrapper around the neighbor::LBVH class
 /*!
  * This wrapper only exposes data types that are natively supported in HOOMD
@@ -93,6 +101,16 @@ class LBVHWrapper
                hipStream_t stream,
                unsigned int block_size);
 
+    //! Refit the bounding boxes of the LBVH to the current positions
+    void refit(const Scalar4* points,
+               const unsigned int* map,
+               unsigned int* visits,
+               hipStream_t stream,
+               unsigned int block_size);
+
+    //! Get the summed surface area of the internal nodes
+    float getSurfaceArea() const;
+
     //! Get the underlying LBVH
     std::shared_ptr<neighbor::LBVH> get()
         {
@@ -66,6 +66,9 @@ class PYBIND11_EXPORT NeighborListGPUTree : public NeighborListGPU
         m_copy_tuner->setPeriod(period / 10);
         m_copy_tuner->setEnabled(enable);
 
+        m_refit_tuner->setPeriod(period / 10);
+        m_refit_tuner->setEnabled(enable);
+
         /* These may be null pointers if the first compute has not occurred, since construction of
            these tuners is deferred until the first neighbor list build (in order to get the tuner
            parameters from the LBVHWrapper and LBVHTraverserWrapper). When initialized, the period
@@ -84,6 +87,23 @@ class PYBIND11_EXPORT NeighborListGPUTree : public NeighborListGPU
             }
         }
 
+    //! Set the growth of the tree surface area that triggers a rebuild
+    /*! \param threshold Ratio of the refit to the built surface area (0 to always rebuild)
+     */
+    void setRefitThreshold(Scalar threshold)
+        {
+        if (threshold < Scalar(0.0))
+            throw std::invalid_argument("refit_threshold must be non-negative.");
+        m_refit_threshold = threshold;
+        m_can_refit = false;
+        }
+
+    //! Get the growth of the tree surface area that triggers a rebuild
+    Scalar getRefitThreshold()
+        {
+        return m_refit_threshold;
+        }
+
     protected:
     //! Builds the neighbor list
     virtual void buildNlist(uint64_t timestep);
@@ -94,6 +114,7 @@ class PYBIND11_EXPORT NeighborListGPUTree : public NeighborListGPU
     std::unique_ptr<Autotuner> m_copy_tuner;     //!< Tuner for the primitive-copy kernel
     std::unique_ptr<Autotuner> m_build_tuner;    //!< Tuner for LBVH builds
     std::unique_ptr<Autotuner> m_traverse_tuner; //!< Tuner for LBVH traversers
+    std::unique_ptr<Autotuner> m_refit_tuner;    //!< Tuner for LBVH refits
 
     GPUArray<unsigned int> m_types;          //!< Particle types (for sorting)
     GPUArray<unsigned int> m_sorted_types;   //!< Sorted particle types
@@ -114,9 +135,25 @@ class PYBIND11_EXPORT NeighborListGPUTree : public NeighborListGPU
     unsigned int m_n_images;                 //!< Number of translation vectors for traversal
     GPUArray<unsigned int> m_traverse_order; //!< Order to traverse primitives
 
+    Scalar m_refit_threshold;               //!< Surface area ratio that triggers a rebuild
+    std::vector<float> m_build_area;        //!< Surface area of each LBVH when it was built
+    bool m_can_refit;                       //!< True if the LBVHs hold the current particles
+    unsigned int m_refit_n;                 //!< Number of particles when the LBVHs were built
+    GPUFlags<unsigned int> m_types_changed; //!< Flag if a particle changed type since the build
+    GPUArray<unsigned int> m_refit_visits;  //!< Node visit counters for the refits
+
+    //! Mark the particle types and check the particle bounds
+    void markTypes();
+
     //! Build the LBVHs using the neighbor library
     void buildTree();
 
+    //! Refit the LBVHs to the current positions
+    bool refitTree();
+
+    //! Prepare the LBVH traversers for the current LBVHs
+    void setupTraversers();
+
     //! Traverse the LBVHs using the neighbor library
     void traverseTree();
 
@@ -153,12 +190,20 @@ class PYBIND11_EXPORT NeighborListGPUTree : public NeighborListGPU
     void slotBoxChanged()
         {
         m_box_changed = true;
+        m_can_refit = false;
         }
 
     //! Notification of a change in the maximum number of particles on any rank
     void slotMaxNumChanged()
         {
         m_max_num_changed = true;
+        m_can_refit = false;
+        }
+
+    //! Notification of a particle sort
+    void slotParticleSort()
+        {
+        m_can_refit = false;
         }
 
     /// set to true when the type data has been allocated
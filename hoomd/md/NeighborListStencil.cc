@@ -13,6 +13,8 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#include <pybind11/stl.h>
+
 using namespace std;
 
 namespace hoomd
@@ -45,8 +47,50 @@ NeighborListStencil::~NeighborListStencil()
     m_exec_conf->msg->notice(5) << "Destroying NeighborListStencil" << endl;
     }
 
+/*! \param type_classes Names of the types in each class
+
+    Every type must be in exactly one class. An empty list bins all particles in one cell list. The
+    cell width of each class is set from the cutoffs to that class, not by setCellWidth().
+*/
+void NeighborListStencil::setTypeClasses(const std::vector<std::vector<std::string>>& type_classes)
+    {
+    std::vector<std::vector<unsigned int>> type_class_ids = getTypeClassIds(type_classes);
+
+    m_class_cl.clear();
+    m_class_cls.clear();
+    for (const std::vector<unsigned int>& types : type_class_ids)
+        {
+        std::shared_ptr<CellList> cl = std::make_shared<CellList>(m_sysdef);
+        cl->setRadius(1);
+        cl->setComputeTDB(true);
+        cl->setFlagIndex();
+        cl->setComputeAdjList(false);
+        cl->setSortCellList(m_cl->getSortCellList());
+        cl->setTypeFilter(types);
+
+        m_class_cl.push_back(cl);
+        m_class_cls.push_back(std::make_shared<CellListStencil>(m_sysdef, cl));
+        }
+
+    m_type_classes = type_classes;
+    m_update_cell_size = true;
+    m_needs_restencil = true;
+    forceUpdate();
+    }
+
 void NeighborListStencil::updateRStencil()
     {
+    if (!m_type_classes.empty())
+        {
+        for (unsigned int cur_class = 0; cur_class < m_class_cl.size(); ++cur_class)
+            {
+            std::vector<Scalar> rstencil;
+            getTypeClassStencil(m_class_cl[cur_class]->getTypeFilter(), rstencil);
+            m_class_cls[cur_class]->setRStencil(rstencil);
+            }
+        return;
+        }
+
     ArrayHandle<Scalar> h_rcut_max(m_rcut_max, access_location::host, access_mode::read);
     std::vector<Scalar> rstencil(m_pdata->getNTypes(), -1.0);
     for (unsigned int cur_type = 0; cur_type < m_pdata->getNTypes(); ++cur_type)
@@ -77,10 +121,27 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
             m_cl->setNominalWidth(rmin);
             }
 
+        // size the cells of each class for the shortest cutoff to that class
+        for (auto& cl : m_class_cl)
+            {
+            std::vector<Scalar> rstencil;
+            cl->setNominalWidth(getTypeClassStencil(cl->getTypeFilter(), rstencil));
+            }
+
         m_update_cell_size = false;
         }
 
-    m_cl->compute(timestep);
+    // search one cell list per class, or one cell list with all particles
+    std::vector<std::shared_ptr<CellList>> cell_lists(1, m_cl);
+    std::vector<std::shared_ptr<CellListStencil>> stencils(1, m_cls);
+    if (!m_type_classes.empty())
+        {
+        cell_lists = m_class_cl;
+        stencils = m_class_cls;
+        }
+
+    for (auto& cl : cell_lists)
+        cl->compute(timestep);
 
     // update the stencil radii if there was a change
     if (m_needs_restencil)
@@ -88,22 +149,8 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
         updateRStencil();
         m_needs_restencil = false;
         }
-    m_cls->compute(timestep);
-
-    uint3 dim = m_cl->getDim();
-    Scalar3 ghost_width = m_cl->getGhostWidth();
-
-    if (m_prof)
-        m_prof->push(m_exec_conf, "compute");
-
-    // acquire the particle data and box dimension
-    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
-                                     access_location::host,
-                                     access_mode::read);
-    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
-                                   access_location::host,
-                                   access_mode::read);
+    for (auto& cls : stencils)
+        cls->compute(timestep);
 
     const BoxDim& box = m_pdata->getBox();
     Scalar3 nearest_plane_distance = box.getNearestPlaneDistance();
@@ -141,22 +188,54 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
         throw std::runtime_error(oss.str());
         }
 
+    if (m_prof)
+        m_prof->push(m_exec_conf, "compute");
+
+    // each class adds its neighbors to those found in the previous classes
+    for (unsigned int cur_class = 0; cur_class < cell_lists.size(); ++cur_class)
+        buildFromCellList(cell_lists[cur_class], stencils[cur_class], cur_class > 0);
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+/*! \param cl Cell list to search
+    \param cls Stencils of \a cl
+    \param append When true, add the neighbors to those already in the list
+*/
+void NeighborListStencil::buildFromCellList(std::shared_ptr<CellList> cl,
+                                            std::shared_ptr<CellListStencil> cls,
+                                            bool append)
+    {
+    uint3 dim = cl->getDim();
+    Scalar3 ghost_width = cl->getGhostWidth();
+
+    // acquire the particle data and box dimension
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                   access_location::host,
+                                   access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+    uchar3 periodic = box.getPeriodic();
+
     // access the rlist data
     ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
 
     // access the cell list data arrays
-    ArrayHandle<unsigned int> h_cell_size(m_cl->getCellSizeArray(),
+    ArrayHandle<unsigned int> h_cell_size(cl->getCellSizeArray(),
                                           access_location::host,
                                           access_mode::read);
-    ArrayHandle<Scalar4> h_cell_xyzf(m_cl->getXYZFArray(),
-                                     access_location::host,
-                                     access_mode::read);
-    ArrayHandle<Scalar4> h_cell_tdb(m_cl->getTDBArray(), access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_stencil(m_cls->getStencils(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_n_stencil(m_cls->getStencilSizes(),
+    ArrayHandle<Scalar4> h_cell_xyzf(cl->getXYZFArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_cell_tdb(cl->getTDBArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_stencil(cls->getStencils(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_stencil(cls->getStencilSizes(),
                                           access_location::host,
                                           access_mode::read);
-    const Index2D& stencil_idx = m_cls->getStencilIndexer();
+    const Index2D& stencil_idx = cls->getStencilIndexer();
 
     // access the neighbor list data
     ArrayHandle<size_t> h_head_list(m_head_list, access_location::host, access_mode::read);
@@ -164,19 +243,20 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
     ArrayHandle<unsigned int> h_conditions(m_conditions,
                                            access_location::host,
                                            access_mode::readwrite);
-    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
-    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
+    const access_mode::Enum nlist_mode = append ? access_mode::readwrite : access_mode::overwrite;
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, nlist_mode);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, nlist_mode);
 
     // access indexers
-    Index3D ci = m_cl->getCellIndexer();
-    Index2D cli = m_cl->getCellListIndexer();
+    Index3D ci = cl->getCellIndexer();
+    Index2D cli = cl->getCellListIndexer();
 
     // for each local particle
     unsigned int nparticles = m_pdata->getN();
 
     for (int i = 0; i < (int)nparticles; i++)
         {
-        unsigned int cur_n_neigh = 0;
+        unsigned int cur_n_neigh = append ? h_n_neigh.data[i] : 0;
 
         const Scalar3 my_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
@@ -329,9 +409,6 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
 
         h_n_neigh.data[i] = cur_n_neigh;
         }
-
-    if (m_prof)
-        m_prof->pop(m_exec_conf);
     }
 
 namespace detail
@@ -347,7 +424,10 @@ void export_NeighborListStencil(pybind11::module& m)
                       &NeighborListStencil::setCellWidth)
         .def_property("deterministic",
                       &NeighborListStencil::getDeterministic,
-                      &NeighborListStencil::setDeterministic);
+                      &NeighborListStencil::setDeterministic)
+        .def_property("type_classes",
+                      &NeighborListStencil::getTypeClasses,
+                      &NeighborListStencil::setTypeClasses);
     }
 
     } // end namespace detail
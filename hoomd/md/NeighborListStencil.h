@@ -27,6 +27,11 @@ namespace md
 //! Efficient neighbor list build on the CPU with multiple bin stencils
 /*! Implements the O(N) neighbor list build on the CPU using a cell list with multiple bin stencils.
 
+    When type classes are set, the particles of each class are binned in their own cell list with a
+    cell width sized for the shortest cutoff to that class. Each particle searches the cell list of
+    every class with a stencil sized for its own cutoff to that class, so the small particles of a
+    size-asymmetric mixture are not binned into cells as wide as the cutoffs of the large ones.
+
     \sa CellListStencil
     \ingroup computes
 */
@@ -47,6 +52,14 @@ class PYBIND11_EXPORT NeighborListStencil : public NeighborList
         NeighborList::notifyRCutMatrixChange();
         }
 
+    /// Notify NeighborList that r_cut matrix values have decreased
+    virtual void notifyRCutMatrixShrink()
+        {
+        m_update_cell_size = true;
+        m_needs_restencil = true;
+        NeighborList::notifyRCutMatrixShrink();
+        }
+
     //! Change the underlying cell width
     void setCellWidth(Scalar cell_width)
         {
@@ -58,6 +71,8 @@ class PYBIND11_EXPORT NeighborListStencil : public NeighborList
     void setDeterministic(bool deterministic)
         {
         m_cl->setSortCellList(deterministic);
+        for (auto& cl : m_class_cl)
+            cl->setSortCellList(deterministic);
         }
 
     bool getDeterministic()
@@ -70,6 +85,15 @@ class PYBIND11_EXPORT NeighborListStencil : public NeighborList
         return m_cl->getNominalWidth();
         }
 
+    /// Set the names of the types in each class (empty to bin all types together)
+    void setTypeClasses(const std::vector<std::vector<std::string>>& type_classes);
+
+    /// Get the names of the types in each class
+    std::vector<std::vector<std::string>> getTypeClasses()
+        {
+        return m_type_classes;
+        }
+
     protected:
     //! Builds the neighbor list
     virtual void buildNlist(uint64_t timestep);
@@ -84,8 +108,18 @@ class PYBIND11_EXPORT NeighborListStencil : public NeighborList
     /// Track when the cell size needs to be updated
     bool m_update_cell_size = true;
 
+    /// Names of the types in each class
+    std::vector<std::vector<std::string>> m_type_classes;
+    std::vector<std::shared_ptr<CellList>> m_class_cl;         //!< Cell list of each class
+    std::vector<std::shared_ptr<CellListStencil>> m_class_cls; //!< Stencils of each class
+
     //! Update the stencil radius
     void updateRStencil();
+
+    /// Find the neighbors in one cell list
+    void buildFromCellList(std::shared_ptr<CellList> cl,
+                           std::shared_ptr<CellListStencil> cls,
+                           bool append);
     };
 
 namespace detail
@@ -14,6 +14,12 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 
 namespace hoomd
@@ -21,17 +27,13 @@ namespace hoomd
 namespace md
     {
 NeighborListTree::NeighborListTree(std::shared_ptr<SystemDefinition> sysdef, Scalar r_buff)
-    : NeighborList(sysdef, r_buff), m_box_changed(true), m_max_num_changed(true),
-      m_remap_particles(true), m_types_allocated(false), m_n_images(0)
+    : NeighborList(sysdef, r_buff), m_box_changed(true),
+      m_spatial_index(sysdef->getSpatialIndex()), m_n_images(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing NeighborListTree" << endl;
 
     m_pdata->getBoxChangeSignal().connect<NeighborListTree, &NeighborListTree::slotBoxChanged>(
         this);
-    m_pdata->getMaxParticleNumberChangeSignal()
-        .connect<NeighborListTree, &NeighborListTree::slotMaxNumChanged>(this);
-    m_pdata->getParticleSortSignal()
-        .connect<NeighborListTree, &NeighborListTree::slotRemapParticles>(this);
     }
 
 NeighborListTree::~NeighborListTree()
@@ -39,102 +41,48 @@ NeighborListTree::~NeighborListTree()
     m_exec_conf->msg->notice(5) << "Destroying NeighborListTree" << endl;
     m_pdata->getBoxChangeSignal().disconnect<NeighborListTree, &NeighborListTree::slotBoxChanged>(
         this);
-    m_pdata->getMaxParticleNumberChangeSignal()
-        .disconnect<NeighborListTree, &NeighborListTree::slotMaxNumChanged>(this);
-    m_pdata->getParticleSortSignal()
-        .disconnect<NeighborListTree, &NeighborListTree::slotRemapParticles>(this);
     }
 
+/*!
+ * \param timestep Current timestep
+ *
+ * The trees of each type are taken from the SpatialIndex of the system, which builds them at most
+ * once for each set of positions and shares them with the other neighbor lists.
+ */
 void NeighborListTree::buildNlist(uint64_t timestep)
     {
-    // allocate the memory as needed and sort particles
-    setupTree();
-
-    // build the trees
-    buildTree();
-
-    // now walk the trees
-    traverseTree();
-    }
-
-void NeighborListTree::setupTree()
-    {
-    if (m_max_num_changed)
-        {
-        m_aabbs.resize(m_pdata->getMaxN());
-        m_map_pid_tree.resize(m_pdata->getMaxN());
-
-        m_max_num_changed = false;
-        }
-
-    if (!m_types_allocated)
-        {
-        // double corruption happens if we just resize due to the way the AABBNodes are allocated
-        // so first destroy all of the trees from the vector and then resize. could probably be
-        // fixed using scoped pointers as well
-        m_aabb_trees.clear();
-        m_aabb_trees.resize(m_pdata->getNTypes());
-
-        m_num_per_type.resize(m_pdata->getNTypes(), 0);
-        m_type_head.resize(m_pdata->getNTypes(), 0);
-
-        slotRemapParticles();
-
-        m_types_allocated = true;
-        }
-
-    if (m_remap_particles)
-        {
-        mapParticlesByType();
-        m_remap_particles = false;
-        }
-
     if (m_box_changed)
         {
         updateImageVectors();
         m_box_changed = false;
         }
-    }
 
-/*!
- * Efficiently "sorts" particles by type into trees by generating a map from the local particle id
- * to the id within a flat array of AABBs sorted by type.
- */
-void NeighborListTree::mapParticlesByType()
-    {
-    if (this->m_prof)
-        this->m_prof->push("Histogram");
-
-    // clear out counters
-    unsigned int n_types = m_pdata->getNTypes();
-    for (unsigned int i = 0; i < n_types; ++i)
-        {
-        m_num_per_type[i] = 0;
-        }
-
-    // histogram all particles on this rank, and accumulate their positions within the tree
-    unsigned int n_local = m_pdata->getN() + m_pdata->getNGhosts();
-    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::read);
-    for (unsigned int i = 0; i < n_local; ++i)
-        {
-        unsigned int my_type = __scalar_as_int(h_postype.data[i].w);
-        m_map_pid_tree[i]
-            = m_num_per_type[my_type]; // global id i is particle num_per_type after head of my_type
-        ++m_num_per_type[my_type];
-        }
+    const BoxDim& box = m_pdata->getBox();
+    Scalar ghost_layer_width(0.0);
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed())
+        ghost_layer_width = m_comm->getGhostLayerMaxWidth();
+#endif
 
-    // set the head for each type in m_aabbs by looping back over the types
-    unsigned int local_head = 0;
-    for (unsigned int i = 0; i < n_types; ++i)
+    Scalar3 ghost_width = make_scalar3(0.0, 0.0, 0.0);
+    if (!box.getPeriodic().x)
+        ghost_width.x = ghost_layer_width;
+    if (!box.getPeriodic().y)
+        ghost_width.y = ghost_layer_width;
+    if (this->m_sysdef->getNDimensions() == 3 && !box.getPeriodic().z)
         {
-        m_type_head[i] = local_head;
-        local_head += m_num_per_type[i];
+        ghost_width.z = ghost_layer_width;
         }
 
+    // build the trees, or reuse the trees already built for these positions
+    if (this->m_prof)
+        this->m_prof->push("Build");
+    const std::vector<hoomd::detail::AABBTree>& trees = m_spatial_index->getTypeTrees(ghost_width);
     if (this->m_prof)
         this->m_prof->pop();
+
+    // now walk the trees
+    traverseTree(trees);
     }
 
 /*!
@@ -200,92 +148,16 @@ void NeighborListTree::updateImageVectors()
         }
     }
 
-/*!
- * \note AABBTree implements its own build routine, so this is a wrapper to call this for multiple
- * tree types.
- */
-void NeighborListTree::buildTree()
-    {
-    if (this->m_prof)
-        this->m_prof->push("Build");
-    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::read);
-    ArrayHandle<hoomd::detail::AABB> h_aabbs(m_aabbs,
-                                             access_location::host,
-                                             access_mode::readwrite);
-
-    const BoxDim& box = m_pdata->getBox();
-    Scalar ghost_layer_width(0.0);
-#ifdef ENABLE_MPI
-    if (m_sysdef->isDomainDecomposed())
-        ghost_layer_width = m_comm->getGhostLayerMaxWidth();
-#endif
-
-    Scalar3 ghost_width = make_scalar3(0.0, 0.0, 0.0);
-    if (!box.getPeriodic().x)
-        ghost_width.x = ghost_layer_width;
-    if (!box.getPeriodic().y)
-        ghost_width.y = ghost_layer_width;
-    if (this->m_sysdef->getNDimensions() == 3 && !box.getPeriodic().z)
-        {
-        ghost_width.z = ghost_layer_width;
-        }
-
-    // construct a point AABB for each particle owned by this rank, and push it into the right spot
-    // in the AABB list
-    for (unsigned int i = 0; i < m_pdata->getN() + m_pdata->getNGhosts(); ++i)
-        {
-        // make a point particle AABB
-        vec3<Scalar> my_pos(h_postype.data[i]);
-
-        /* check if the particle is inside the unit cell + ghost layer in all dimensions
-         *
-         * This is not strictly necessary for building the tree, but the tree traversal
-         * may get stuck when particles are far outside the box
-         */
-        Scalar3 f = box.makeFraction(vec_to_scalar3(my_pos), ghost_width);
-        if (((f.x < Scalar(-0.00001) || f.x >= Scalar(1.00001))
-             || (f.y < Scalar(-0.00001) || f.y >= Scalar(1.00001))
-             || (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)))
-            && i < m_pdata->getN())
-            {
-            ArrayHandle<unsigned int> h_tag(m_pdata->getTags(),
-                                            access_location::host,
-                                            access_mode::read);
-            m_exec_conf->msg->errorAllRanks()
-                << "nlist.tree(): Particle " << h_tag.data[i] << " is out of bounds "
-                << "(x: " << my_pos.x << ", y: " << my_pos.y << ", z: " << my_pos.z
-                << ", fx: " << f.x << ", fy: " << f.y << ", fz:" << f.z << ")" << endl;
-            throw runtime_error("Error updating neighborlist");
-            return;
-            }
-
-        unsigned int my_type = __scalar_as_int(h_postype.data[i].w);
-        unsigned int my_aabb_idx = m_type_head[my_type] + m_map_pid_tree[i];
-        h_aabbs.data[my_aabb_idx] = hoomd::detail::AABB(my_pos, i);
-        }
-
-    // call the tree build routine, one tree per type
-    for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
-        {
-        if (m_num_per_type[i] > 0)
-            {
-            m_aabb_trees[i].buildTree(&(h_aabbs.data[0]) + m_type_head[i], m_num_per_type[i]);
-            }
-        }
-    if (this->m_prof)
-        this->m_prof->pop();
-    }
-
 /*!
  * Each AABBTree is traversed in a stackless fashion. One traversal is performed (per particle)-(per
  * tree)-(per image). The stackless traversal is a variation on left descent, where each node knows
  * how far ahead to advance in the list of nodes if there is no intersection between the current
  * node AABB and the query AABB. Otherwise, the search advances by one to the next node in the list.
  */
-void NeighborListTree::traverseTree()
+void NeighborListTree::traverseTree(const std::vector<hoomd::detail::AABBTree>& trees)
     {
+    const std::vector<unsigned int>& num_per_type = m_spatial_index->getNumPerType();
+
     if (this->m_prof)
         this->m_prof->push("Traverse");
 
@@ -311,9 +183,9 @@ void NeighborListTree::traverseTree()
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
 
-    // Loop over all particles
-    for (unsigned int i = 0; i < m_pdata->getN(); ++i)
-        {
+    // find the neighbors of particle i, recording overflows in the given conditions array
+    auto traverse_particle = [&](unsigned int i, unsigned int* conditions)
+    {
         // read in the current position and orientation
         const Scalar4 postype_i = h_postype.data[i];
         const vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
@@ -329,7 +201,7 @@ void NeighborListTree::traverseTree()
              ++cur_pair_type) // loop on pair types
             {
             // pass on empty types
-            if (!m_num_per_type[cur_pair_type])
+            if (!num_per_type[cur_pair_type])
                 continue;
 
             // Check if this tree type should be excluded by r_cut(i,j) <= 0.0
@@ -350,7 +222,7 @@ void NeighborListTree::traverseTree()
             if (m_diameter_shift)
                 r_list_i += m_d_max - Scalar(1.0);
 
-            hoomd::detail::AABBTree* cur_aabb_tree = &m_aabb_trees[cur_pair_type];
+            const hoomd::detail::AABBTree* cur_aabb_tree = &trees[cur_pair_type];
 
             for (unsigned int cur_image = 0; cur_image < m_n_images;
                  ++cur_image) // for each image vector
@@ -410,8 +282,8 @@ void NeighborListTree::traverseTree()
                                             if (n_neigh_i < Nmax_i)
                                                 h_nlist.data[nlist_head_i + n_neigh_i] = j;
                                             else
-                                                h_conditions.data[type_i]
-                                                    = max(h_conditions.data[type_i], n_neigh_i + 1);
+                                                conditions[type_i]
+                                                    = max(conditions[type_i], n_neigh_i + 1);
 
                                             ++n_neigh_i;
                                             }
@@ -429,7 +301,41 @@ void NeighborListTree::traverseTree()
                 }     // end loop over images
             }         // end loop over pair types
         h_n_neigh.data[i] = n_neigh_i;
-        } // end loop over particles
+    };
+
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        // rows are independent once the head list is set, only the overflow conditions are shared
+        const unsigned int n_types = m_pdata->getNTypes();
+        tbb::enumerable_thread_specific<std::vector<unsigned int>> thread_conditions(
+            std::vector<unsigned int>(n_types, 0));
+
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                m_exec_conf->parallelFor(
+                    0,
+                    m_pdata->getN(),
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                        unsigned int* conditions = thread_conditions.local().data();
+                        for (unsigned int i = r.begin(); i != r.end(); ++i)
+                            traverse_particle(i, conditions);
+                    });
+            }); // end task arena execute()
+
+        for (const auto& conditions : thread_conditions)
+            for (unsigned int t = 0; t < n_types; ++t)
+                h_conditions.data[t] = max(h_conditions.data[t], conditions[t]);
+        }
+    else
+#endif
+        {
+        // Loop over all particles
+        for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+            traverse_particle(i, h_conditions.data);
+        }
 
     if (this->m_prof)
         this->m_prof->pop();
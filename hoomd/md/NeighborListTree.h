@@ -4,7 +4,7 @@
 // Maintainer: mphoward
 
 #include "NeighborList.h"
-#include "hoomd/AABBTree.h"
+#include "hoomd/SpatialIndex.h"
 #include <vector>
 
 /*! \file NeighborListTree.h
@@ -35,10 +35,9 @@ namespace md
  * by all possible image vectors, many of which are trivially rejected for not intersecting the root
  * node.
  *
- * Because one tree is built per type, complications can arise if particles change type "on the fly"
- * during a a simulation. At present, there is no signal for the types of particles changing (only
- * the total number of types). Any class directly modifying the types of particles \b must signal
- * this change to NeighborListTree using notifyParticleSort().
+ * The trees are owned by the SpatialIndex of the system, so all tree neighbor lists (and other
+ * consumers) that search the same positions share a single build. The SpatialIndex rebuilds the
+ * trees when the particles move, change type, or are sorted.
  *
  * \ingroup computes
  */
@@ -62,51 +61,18 @@ class PYBIND11_EXPORT NeighborListTree : public NeighborList
         m_box_changed = true;
         }
 
-    //! Notification of a max number of particle change
-    void slotMaxNumChanged()
-        {
-        m_max_num_changed = true;
-        }
-
-    //! Notification of a particle sort
-    void slotRemapParticles()
-        {
-        m_remap_particles = true;
-        }
+    bool m_box_changed; //!< Flag if box size has changed
 
-    bool m_box_changed;     //!< Flag if box size has changed
-    bool m_max_num_changed; //!< Flag if the particle arrays need to be resized
-    bool m_remap_particles; //!< Flag if the particles need to remapped (triggered by sort)
-
-    /// set to true when the type data has been allocated
-    bool m_types_allocated;
-
-    // we use stl vectors here because these tree data structures should *never* be
-    // accessed on the GPU, they were optimized for the CPU with SIMD support
-    std::vector<hoomd::detail::AABBTree> m_aabb_trees; //!< Flat array of AABB trees of all types
-    GPUVector<hoomd::detail::AABB> m_aabbs;            //!< Flat array of AABBs of all types
-    std::vector<unsigned int> m_num_per_type;          //!< Total number of particles per type
-    std::vector<unsigned int> m_type_head; //!< Index of first particle of each type, after sorting
-    std::vector<unsigned int>
-        m_map_pid_tree; //!< Maps the particle id to its tag in tree for sorting
+    std::shared_ptr<SpatialIndex> m_spatial_index; //!< Shared AABB trees of all types
 
     std::vector<vec3<Scalar>> m_image_list; //!< List of translation vectors
     unsigned int m_n_images;                //!< The number of image vectors to check
 
-    //! Driver for tree configuration
-    void setupTree();
-
-    //! Maps particles by local id to their id within their type trees
-    void mapParticlesByType();
-
     //! Computes the image vectors to query for
     void updateImageVectors();
 
-    //! Driver to build AABB trees
-    void buildTree();
-
     //! Traverses AABB trees to compute neighbors
-    void traverseTree();
+    void traverseTree(const std::vector<hoomd::detail::AABBTree>& trees);
     };
 
 namespace detail
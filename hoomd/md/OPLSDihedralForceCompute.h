@@ -76,6 +76,12 @@ class PYBIND11_EXPORT OPLSDihedralForceCompute : public ForceCompute
     /// Get the parameters for a specified type
     pybind11::dict getParams(std::string type);
 
+    /// Get the per-type parameters (k1/2, k2/2, k3/2, k4/2)
+    const GPUArray<Scalar4>& getParamArray() const
+        {
+        return m_params;
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     /*! \param timestep Current time step
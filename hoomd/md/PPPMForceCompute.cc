@@ -52,6 +52,14 @@ PPPMForceCompute::PPPMForceCompute(std::shared_ptr<SystemDefinition> sysdef,
     m_rcut = Scalar(0.0);
     m_order = 0;
     m_alpha = Scalar(0.0);
+    m_analytic_diff = false;
+    m_single_rank_fft = false;
+    m_slab_correction = false;
+    m_fourier_dim = make_uint3(0, 0, 0);
+    m_n_fourier_cells = 0;
+#ifdef ENABLE_MPI
+    m_fft_gathered = false;
+#endif
 
     m_pdata->getGlobalParticleNumberChangeSignal()
         .connect<PPPMForceCompute, &PPPMForceCompute::slotGlobalParticleNumberChange>(this);
@@ -63,11 +71,17 @@ void PPPMForceCompute::setParams(unsigned int nx,
                                  unsigned int order,
                                  Scalar kappa,
                                  Scalar rcut,
-                                 Scalar alpha)
+                                 Scalar alpha,
+                                 bool analytic_diff,
+                                 bool single_rank_fft,
+                                 bool slab_correction)
     {
     m_kappa = kappa;
     m_rcut = rcut;
     m_alpha = alpha;
+    m_analytic_diff = analytic_diff;
+    m_single_rank_fft = single_rank_fft;
+    m_slab_correction = slab_correction;
 
     m_mesh_points = make_uint3(nx, ny, nz);
     m_global_dim = m_mesh_points;
@@ -87,7 +101,10 @@ void PPPMForceCompute::setParams(unsigned int nx,
         {
         const Index3D& didx = m_pdata->getDomainDecomposition()->getDomainIndexer();
 
-        if (!is_pow2(m_mesh_points.x) || !is_pow2(m_mesh_points.y) || !is_pow2(m_mesh_points.z))
+        // rank 0 transforms the global mesh with a local FFT, which accepts any size
+        if (!m_single_rank_fft
+            && (!is_pow2(m_mesh_points.x) || !is_pow2(m_mesh_points.y)
+                || !is_pow2(m_mesh_points.z)))
             {
             throw std::runtime_error(
                 "The number of mesh points along the every direction must be a power of two!");
@@ -140,9 +157,14 @@ PPPMForceCompute::~PPPMForceCompute()
 
     if (m_kiss_fft_initialized)
         {
+#ifdef ENABLE_FFTW
+        fftwf_destroy_plan(m_fftw_plan_forward);
+        fftwf_destroy_plan(m_fftw_plan_inverse);
+#else
         kiss_fft_free(m_kiss_fft);
         kiss_fft_free(m_kiss_ifft);
         kiss_fft_cleanup();
+#endif
         }
 #ifdef ENABLE_MPI
     if (m_dfft_initialized)
@@ -399,14 +421,25 @@ void PPPMForceCompute::setupMesh()
     m_n_cells = m_grid_dim.x * m_grid_dim.y * m_grid_dim.z;
     m_n_inner_cells = m_mesh_points.x * m_mesh_points.y * m_mesh_points.z;
 
+    // transform the local mesh, or the global mesh on rank 0
+    m_fourier_dim = m_mesh_points;
+#ifdef ENABLE_MPI
+    m_fft_gathered = m_single_rank_fft && m_pdata->getDomainDecomposition();
+    if (m_fft_gathered)
+        {
+        m_fourier_dim = m_exec_conf->getRank() == 0 ? m_global_dim : make_uint3(0, 0, 0);
+        }
+#endif
+    m_n_fourier_cells = m_fourier_dim.x * m_fourier_dim.y * m_fourier_dim.z;
+
     // allocate memory for influence function and k values
-    GlobalArray<Scalar> inf_f(m_n_inner_cells, m_exec_conf);
+    GlobalArray<Scalar> inf_f(m_n_fourier_cells, m_exec_conf);
     m_inf_f.swap(inf_f);
 
-    GlobalArray<Scalar3> k(m_n_inner_cells, m_exec_conf);
+    GlobalArray<Scalar3> k(m_n_fourier_cells, m_exec_conf);
     m_k.swap(k);
 
-    GlobalArray<Scalar> virial_mesh(6 * m_n_inner_cells, m_exec_conf);
+    GlobalArray<Scalar> virial_mesh(6 * m_n_fourier_cells, m_exec_conf);
     m_virial_mesh.swap(virial_mesh);
 
     initializeFFT();
@@ -488,50 +521,100 @@ void PPPMForceCompute::initializeFFT()
         embed[2] = m_mesh_points.x + 2 * m_n_ghost_cells.x;
         m_ghost_offset
             = (m_n_ghost_cells.z * embed[1] + m_n_ghost_cells.y) * embed[2] + m_n_ghost_cells.x;
-        uint3 pcoord = m_pdata->getDomainDecomposition()->getGridPos();
-        int pidx[3];
-        pidx[0] = pcoord.z;
-        pidx[1] = pcoord.y;
-        pidx[2] = pcoord.x;
-        int row_m = 0; /* both local grid and proc grid are row major, no transposition necessary */
-        ArrayHandle<unsigned int> h_cart_ranks(m_pdata->getDomainDecomposition()->getCartRanks(),
-                                               access_location::host,
-                                               access_mode::read);
-        dfft_create_plan(&m_dfft_plan_forward,
-                         3,
-                         gdim,
-                         embed,
-                         NULL,
-                         pdim,
-                         pidx,
-                         row_m,
-                         0,
-                         1,
-                         m_exec_conf->getMPICommunicator(),
-                         (int*)h_cart_ranks.data);
-        dfft_create_plan(&m_dfft_plan_inverse,
-                         3,
-                         gdim,
-                         NULL,
-                         embed,
-                         pdim,
-                         pidx,
-                         row_m,
-                         0,
-                         1,
-                         m_exec_conf->getMPICommunicator(),
-                         (int*)h_cart_ranks.data);
-        m_dfft_initialized = true;
+
+        if (m_fft_gathered)
+            {
+            // rank 0 transforms the global mesh with a local FFT
+            unsigned int n_global = m_exec_conf->getRank() == 0 ? m_n_fourier_cells : 0;
+            m_inner_buf.resize(m_n_inner_cells);
+            m_gather_buf.resize(n_global);
+            m_global_mesh.resize(n_global);
+            local_fft = m_exec_conf->getRank() == 0;
+            }
+        else
+            {
+            uint3 pcoord = m_pdata->getDomainDecomposition()->getGridPos();
+            int pidx[3];
+            pidx[0] = pcoord.z;
+            pidx[1] = pcoord.y;
+            pidx[2] = pcoord.x;
+            /* both local grid and proc grid are row major, no transposition necessary */
+            int row_m = 0;
+            ArrayHandle<unsigned int> h_cart_ranks(
+                m_pdata->getDomainDecomposition()->getCartRanks(),
+                access_location::host,
+                access_mode::read);
+            dfft_create_plan(&m_dfft_plan_forward,
+                             3,
+                             gdim,
+                             embed,
+                             NULL,
+                             pdim,
+                             pidx,
+                             row_m,
+                             0,
+                             1,
+                             m_exec_conf->getMPICommunicator(),
+                             (int*)h_cart_ranks.data);
+            dfft_create_plan(&m_dfft_plan_inverse,
+                             3,
+                             gdim,
+                             NULL,
+                             embed,
+                             pdim,
+                             pidx,
+                             row_m,
+                             0,
+                             1,
+                             m_exec_conf->getMPICommunicator(),
+                             (int*)h_cart_ranks.data);
+            m_dfft_initialized = true;
+            }
         }
 #endif // ENABLE_MPI
 
     if (local_fft)
         {
         int dims[3];
-        dims[0] = m_mesh_points.z;
-        dims[1] = m_mesh_points.y;
-        dims[2] = m_mesh_points.x;
+        dims[0] = m_fourier_dim.z;
+        dims[1] = m_fourier_dim.y;
+        dims[2] = m_fourier_dim.x;
 
+#ifdef ENABLE_FFTW
+        if (m_fftw_plan_forward)
+            {
+            fftwf_destroy_plan(m_fftw_plan_forward);
+            }
+        if (m_fftw_plan_inverse)
+            {
+            fftwf_destroy_plan(m_fftw_plan_inverse);
+            }
+
+        // FFTW_MEASURE overwrites the arrays it plans with, so plan on scratch arrays. The
+        // transforms execute on the mesh arrays, which need not have the same alignment.
+        size_t n_points = size_t(dims[0]) * dims[1] * dims[2];
+        fftwf_complex* scratch_in = fftwf_alloc_complex(n_points);
+        fftwf_complex* scratch_out = fftwf_alloc_complex(n_points);
+        m_fftw_plan_forward = fftwf_plan_dft(3,
+                                             dims,
+                                             scratch_in,
+                                             scratch_out,
+                                             FFTW_FORWARD,
+                                             FFTW_MEASURE | FFTW_UNALIGNED);
+        m_fftw_plan_inverse = fftwf_plan_dft(3,
+                                             dims,
+                                             scratch_in,
+                                             scratch_out,
+                                             FFTW_BACKWARD,
+                                             FFTW_MEASURE | FFTW_UNALIGNED);
+        fftwf_free(scratch_in);
+        fftwf_free(scratch_out);
+
+        if (!m_fftw_plan_forward || !m_fftw_plan_inverse)
+            {
+            throw std::runtime_error("Error creating FFTW plans for PPPM.");
+            }
+#else
         if (m_kiss_fft)
             {
             kiss_fft_free(m_kiss_fft);
@@ -543,6 +626,7 @@ void PPPMForceCompute::initializeFFT()
 
         m_kiss_fft = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
         m_kiss_ifft = kiss_fftnd_alloc(dims, 3, 1, NULL, NULL);
+#endif
 
         m_kiss_fft_initialized = true;
         }
@@ -553,16 +637,16 @@ void PPPMForceCompute::initializeFFT()
     GlobalArray<kiss_fft_cpx> mesh(m_n_cells + m_ghost_offset, m_exec_conf);
     m_mesh.swap(mesh);
 
-    GlobalArray<kiss_fft_cpx> fourier_mesh(m_n_inner_cells, m_exec_conf);
+    GlobalArray<kiss_fft_cpx> fourier_mesh(m_n_fourier_cells, m_exec_conf);
     m_fourier_mesh.swap(fourier_mesh);
 
-    GlobalArray<kiss_fft_cpx> fourier_mesh_G_x(m_n_inner_cells, m_exec_conf);
+    GlobalArray<kiss_fft_cpx> fourier_mesh_G_x(m_n_fourier_cells, m_exec_conf);
     m_fourier_mesh_G_x.swap(fourier_mesh_G_x);
 
-    GlobalArray<kiss_fft_cpx> fourier_mesh_G_y(m_n_inner_cells, m_exec_conf);
+    GlobalArray<kiss_fft_cpx> fourier_mesh_G_y(m_n_fourier_cells, m_exec_conf);
     m_fourier_mesh_G_y.swap(fourier_mesh_G_y);
 
-    GlobalArray<kiss_fft_cpx> fourier_mesh_G_z(m_n_inner_cells, m_exec_conf);
+    GlobalArray<kiss_fft_cpx> fourier_mesh_G_z(m_n_fourier_cells, m_exec_conf);
     m_fourier_mesh_G_z.swap(fourier_mesh_G_z);
 
     // pad with offset
@@ -664,7 +748,7 @@ void PPPMForceCompute::computeInfluenceFunction()
     temp = floor(((m_kappa * L.z / (M_PI * m_global_dim.z)) * pow(-log(EPS_HOC), 0.25)));
     int nbz = (int)temp;
 
-    for (unsigned int cell_idx = 0; cell_idx < m_n_inner_cells; ++cell_idx)
+    for (unsigned int cell_idx = 0; cell_idx < m_n_fourier_cells; ++cell_idx)
         {
         uint3 wave_idx;
 #ifdef ENABLE_MPI
@@ -685,10 +769,10 @@ void PPPMForceCompute::computeInfluenceFunction()
 #endif
             {
             // kiss FFT expects data in row major format
-            wave_idx.z = cell_idx / (m_mesh_points.y * m_mesh_points.x);
+            wave_idx.z = cell_idx / (m_fourier_dim.y * m_fourier_dim.x);
             wave_idx.y
-                = (cell_idx - wave_idx.z * m_mesh_points.x * m_mesh_points.y) / m_mesh_points.x;
-            wave_idx.x = cell_idx % m_mesh_points.x;
+                = (cell_idx - wave_idx.z * m_fourier_dim.x * m_fourier_dim.y) / m_fourier_dim.x;
+            wave_idx.x = cell_idx % m_fourier_dim.x;
             }
 
         int3 n = make_int3(wave_idx.x, wave_idx.y, wave_idx.z);
@@ -754,7 +838,10 @@ void PPPMForceCompute::computeInfluenceFunction()
                             }
 
                         Scalar3 kn = knx + kny + knz;
-                        Scalar dot1 = dot(kn, k);
+
+                        // the optimal ad influence function weighs the aliases by k_n^2
+                        // instead of k_n.k, approximating sum_n k_n^2 W_n^2 by k^2 sum_n W_n^2
+                        Scalar dot1 = m_analytic_diff ? dot(kn, kn) : dot(kn, k);
                         Scalar dot2 = dot(kn, kn) + m_alpha * m_alpha;
 
                         Scalar arg_gauss = Scalar(0.25) * dot2 / m_kappa / m_kappa;
@@ -938,8 +1025,72 @@ void PPPMForceCompute::assignParticles()
         m_prof->pop();
     }
 
+/*! Writes the transformed electric field components to the G_x, G_y, and G_z meshes (ik), or the
+    transformed potential to the G_x mesh (ad).
+*/
+void PPPMForceCompute::applyInfluenceFunction()
+    {
+    if (m_prof)
+        m_prof->push("update");
+
+    ArrayHandle<Scalar3> h_k(m_k, access_location::host, access_mode::read);
+    ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_x(m_fourier_mesh_G_x,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+    ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_y(m_fourier_mesh_G_y,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+    ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_z(m_fourier_mesh_G_z,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+    ArrayHandle<Scalar> h_inf_f(m_inf_f, access_location::host, access_mode::read);
+    ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh,
+                                             access_location::host,
+                                             access_mode::read);
+
+    unsigned int NNN = m_global_dim.x * m_global_dim.y * m_global_dim.z;
+
+    // multiply with influence function and I*k
+    for (unsigned int k = 0; k < m_n_fourier_cells; ++k)
+        {
+        kiss_fft_cpx f = h_fourier_mesh.data[k];
+
+        Scalar scaled_inf_f = h_inf_f.data[k] / ((Scalar)NNN);
+
+        if (m_analytic_diff)
+            {
+            // the x component holds the potential mesh
+            h_fourier_mesh_G_x.data[k].r = float(f.r * scaled_inf_f);
+            h_fourier_mesh_G_x.data[k].i = float(f.i * scaled_inf_f);
+            continue;
+            }
+
+        Scalar3 kvec = h_k.data[k];
+
+        h_fourier_mesh_G_x.data[k].r = float(f.i * kvec.x * scaled_inf_f);
+        h_fourier_mesh_G_x.data[k].i = float(-f.r * kvec.x * scaled_inf_f);
+
+        h_fourier_mesh_G_y.data[k].r = float(f.i * kvec.y * scaled_inf_f);
+        h_fourier_mesh_G_y.data[k].i = float(-f.r * kvec.y * scaled_inf_f);
+
+        h_fourier_mesh_G_z.data[k].r = float(f.i * kvec.z * scaled_inf_f);
+        h_fourier_mesh_G_z.data[k].i = float(-f.r * kvec.z * scaled_inf_f);
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 void PPPMForceCompute::updateMeshes()
     {
+#ifdef ENABLE_MPI
+    if (m_fft_gathered)
+        {
+        updateMeshesGathered();
+        return;
+        }
+#endif
+
     if (m_kiss_fft_initialized)
         {
         if (m_prof)
@@ -950,7 +1101,13 @@ void PPPMForceCompute::updateMeshes()
                                                  access_location::host,
                                                  access_mode::overwrite);
 
+#ifdef ENABLE_FFTW
+        fftwf_execute_dft(m_fftw_plan_forward,
+                          (fftwf_complex*)h_mesh.data,
+                          (fftwf_complex*)h_fourier_mesh.data);
+#else
         kiss_fftnd(m_kiss_fft, h_mesh.data, h_fourier_mesh.data);
+#endif
         if (m_prof)
             m_prof->pop();
         }
@@ -985,51 +1142,7 @@ void PPPMForceCompute::updateMeshes()
         }
 #endif
 
-    if (m_prof)
-        {
-        m_prof->push("update");
-        }
-
-        {
-        ArrayHandle<Scalar3> h_k(m_k, access_location::host, access_mode::read);
-        ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_x(m_fourier_mesh_G_x,
-                                                     access_location::host,
-                                                     access_mode::overwrite);
-        ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_y(m_fourier_mesh_G_y,
-                                                     access_location::host,
-                                                     access_mode::overwrite);
-        ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G_z(m_fourier_mesh_G_z,
-                                                     access_location::host,
-                                                     access_mode::overwrite);
-        ArrayHandle<Scalar> h_inf_f(m_inf_f, access_location::host, access_mode::read);
-        ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh,
-                                                 access_location::host,
-                                                 access_mode::read);
-
-        unsigned int NNN = m_global_dim.x * m_global_dim.y * m_global_dim.z;
-
-        // multiply with influence function and I*k
-        for (unsigned int k = 0; k < m_n_inner_cells; ++k)
-            {
-            kiss_fft_cpx f = h_fourier_mesh.data[k];
-
-            Scalar scaled_inf_f = h_inf_f.data[k] / ((Scalar)NNN);
-
-            Scalar3 kvec = h_k.data[k];
-
-            h_fourier_mesh_G_x.data[k].r = float(f.i * kvec.x * scaled_inf_f);
-            h_fourier_mesh_G_x.data[k].i = float(-f.r * kvec.x * scaled_inf_f);
-
-            h_fourier_mesh_G_y.data[k].r = float(f.i * kvec.y * scaled_inf_f);
-            h_fourier_mesh_G_y.data[k].i = float(-f.r * kvec.y * scaled_inf_f);
-
-            h_fourier_mesh_G_z.data[k].r = float(f.i * kvec.z * scaled_inf_f);
-            h_fourier_mesh_G_z.data[k].i = float(-f.r * kvec.z * scaled_inf_f);
-            }
-        }
-
-    if (m_prof)
-        m_prof->pop();
+    applyInfluenceFunction();
 
     if (m_kiss_fft_initialized)
         {
@@ -1054,9 +1167,27 @@ void PPPMForceCompute::updateMeshes()
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z,
                                                        access_location::host,
                                                        access_mode::overwrite);
+#ifdef ENABLE_FFTW
+        fftwf_execute_dft(m_fftw_plan_inverse,
+                          (fftwf_complex*)h_fourier_mesh_G_x.data,
+                          (fftwf_complex*)h_inv_fourier_mesh_x.data);
+        if (!m_analytic_diff)
+            {
+            fftwf_execute_dft(m_fftw_plan_inverse,
+                              (fftwf_complex*)h_fourier_mesh_G_y.data,
+                              (fftwf_complex*)h_inv_fourier_mesh_y.data);
+            fftwf_execute_dft(m_fftw_plan_inverse,
+                              (fftwf_complex*)h_fourier_mesh_G_z.data,
+                              (fftwf_complex*)h_inv_fourier_mesh_z.data);
+            }
+#else
         kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
+        if (!m_analytic_diff)
+            {
+            kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
+            kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
+            }
+#endif
         if (m_prof)
             m_prof->pop();
         }
@@ -1092,14 +1223,17 @@ void PPPMForceCompute::updateMeshes()
                      (cpx_t*)(h_inv_fourier_mesh_x.data + m_ghost_offset),
                      1,
                      m_dfft_plan_inverse);
-        dfft_execute((cpx_t*)h_fourier_mesh_G_y.data,
-                     (cpx_t*)(h_inv_fourier_mesh_y.data + m_ghost_offset),
-                     1,
-                     m_dfft_plan_inverse);
-        dfft_execute((cpx_t*)h_fourier_mesh_G_z.data,
-                     (cpx_t*)(h_inv_fourier_mesh_z.data + m_ghost_offset),
-                     1,
-                     m_dfft_plan_inverse);
+        if (!m_analytic_diff)
+            {
+            dfft_execute((cpx_t*)h_fourier_mesh_G_y.data,
+                         (cpx_t*)(h_inv_fourier_mesh_y.data + m_ghost_offset),
+                         1,
+                         m_dfft_plan_inverse);
+            dfft_execute((cpx_t*)h_fourier_mesh_G_z.data,
+                         (cpx_t*)(h_inv_fourier_mesh_z.data + m_ghost_offset),
+                         1,
+                         m_dfft_plan_inverse);
+            }
         if (m_prof)
             m_prof->pop();
         }
@@ -1115,14 +1249,239 @@ void PPPMForceCompute::updateMeshes()
             m_prof->push("ghost cell update");
         m_exec_conf->msg->notice(8) << "charge.pppm: Ghost cell update" << std::endl;
         m_grid_comm_reverse->communicate(m_inv_fourier_mesh_x);
-        m_grid_comm_reverse->communicate(m_inv_fourier_mesh_y);
-        m_grid_comm_reverse->communicate(m_inv_fourier_mesh_z);
+        if (!m_analytic_diff)
+            {
+            m_grid_comm_reverse->communicate(m_inv_fourier_mesh_y);
+            m_grid_comm_reverse->communicate(m_inv_fourier_mesh_z);
+            }
         if (m_prof)
             m_prof->pop();
         }
 #endif
     }
 
+#ifdef ENABLE_MPI
+/*! \param to_global True to copy the gathered inner cells into the global mesh, false to copy the
+    global mesh into the inner cells to scatter
+
+    Only called on rank 0.
+*/
+void PPPMForceCompute::copyGatheredCells(bool to_global)
+    {
+    const Index3D& di = m_pdata->getDomainDecomposition()->getDomainIndexer();
+    ArrayHandle<unsigned int> h_cart_ranks_inv(
+        m_pdata->getDomainDecomposition()->getInverseCartRanks(),
+        access_location::host,
+        access_mode::read);
+
+    for (unsigned int rank = 0; rank < m_exec_conf->getNRanks(); ++rank)
+        {
+        uint3 grid_pos = di.getTriple(h_cart_ranks_inv.data[rank]);
+        uint3 origin = make_uint3(grid_pos.x * m_mesh_points.x,
+                                  grid_pos.y * m_mesh_points.y,
+                                  grid_pos.z * m_mesh_points.z);
+        kiss_fft_cpx* cells = m_gather_buf.data() + rank * m_n_inner_cells;
+
+        for (unsigned int k = 0; k < m_mesh_points.z; ++k)
+            for (unsigned int j = 0; j < m_mesh_points.y; ++j)
+                for (unsigned int i = 0; i < m_mesh_points.x; ++i)
+                    {
+                    unsigned int inner_idx = i + m_mesh_points.x * (j + m_mesh_points.y * k);
+                    unsigned int global_idx
+                        = origin.x + i
+                          + m_global_dim.x * (origin.y + j + m_global_dim.y * (origin.z + k));
+                    if (to_global)
+                        m_global_mesh[global_idx] = cells[inner_idx];
+                    else
+                        cells[inner_idx] = m_global_mesh[global_idx];
+                    }
+        }
+    }
+
+/*! \param mesh Local mesh, including ghost cells
+
+    Collective call. On return, m_global_mesh on rank 0 holds the global mesh.
+*/
+void PPPMForceCompute::gatherMesh(const GlobalArray<kiss_fft_cpx>& mesh)
+    {
+        {
+        ArrayHandle<kiss_fft_cpx> h_mesh(mesh, access_location::host, access_mode::read);
+        for (unsigned int k = 0; k < m_mesh_points.z; ++k)
+            for (unsigned int j = 0; j < m_mesh_points.y; ++j)
+                for (unsigned int i = 0; i < m_mesh_points.x; ++i)
+                    {
+                    unsigned int cell_idx
+                        = i + m_n_ghost_cells.x
+                          + m_grid_dim.x
+                                * (j + m_n_ghost_cells.y + m_grid_dim.y * (k + m_n_ghost_cells.z));
+                    m_inner_buf[i + m_mesh_points.x * (j + m_mesh_points.y * k)]
+                        = h_mesh.data[cell_idx];
+                    }
+        }
+
+    int n_bytes = int(m_n_inner_cells * sizeof(kiss_fft_cpx));
+    MPI_Gather(m_inner_buf.data(),
+               n_bytes,
+               MPI_BYTE,
+               m_gather_buf.data(),
+               n_bytes,
+               MPI_BYTE,
+               0,
+               m_exec_conf->getMPICommunicator());
+
+    if (m_exec_conf->getRank() == 0)
+        copyGatheredCells(true);
+    }
+
+/*! \param mesh Local mesh, including ghost cells
+
+    Collective call. Overwrites the inner cells of \a mesh with the matching cells of m_global_mesh
+    on rank 0. The ghost cells are left untouched.
+*/
+void PPPMForceCompute::scatterMesh(GlobalArray<kiss_fft_cpx>& mesh)
+    {
+    if (m_exec_conf->getRank() == 0)
+        copyGatheredCells(false);
+
+    int n_bytes = int(m_n_inner_cells * sizeof(kiss_fft_cpx));
+    MPI_Scatter(m_gather_buf.data(),
+                n_bytes,
+                MPI_BYTE,
+                m_inner_buf.data(),
+                n_bytes,
+                MPI_BYTE,
+                0,
+                m_exec_conf->getMPICommunicator());
+
+    ArrayHandle<kiss_fft_cpx> h_mesh(mesh, access_location::host, access_mode::readwrite);
+    for (unsigned int k = 0; k < m_mesh_points.z; ++k)
+        for (unsigned int j = 0; j < m_mesh_points.y; ++j)
+            for (unsigned int i = 0; i < m_mesh_points.x; ++i)
+                {
+                unsigned int cell_idx
+                    = i + m_n_ghost_cells.x
+                      + m_grid_dim.x
+                            * (j + m_n_ghost_cells.y + m_grid_dim.y * (k + m_n_ghost_cells.z));
+                h_mesh.data[cell_idx]
+                    = m_inner_buf[i + m_mesh_points.x * (j + m_mesh_points.y * k)];
+                }
+    }
+
+/*! Replaces the distributed FFTs of updateMeshes() when m_fft_gathered is set. Rank 0 transforms
+    the global charge mesh, applies the influence function, and transforms the force (or
+    potential) meshes back. The other ranks only send and receive their inner cells.
+*/
+void PPPMForceCompute::updateMeshesGathered()
+    {
+    if (m_prof)
+        m_prof->push("ghost cell update");
+    m_exec_conf->msg->notice(8) << "charge.pppm: Ghost cell update" << std::endl;
+    m_grid_comm_forward->communicate(m_mesh);
+    if (m_prof)
+        m_prof->pop();
+
+    if (m_prof)
+        m_prof->push("gather");
+    gatherMesh(m_mesh);
+    if (m_prof)
+        m_prof->pop();
+
+    if (m_kiss_fft_initialized)
+        {
+        if (m_prof)
+            m_prof->push("FFT");
+        ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+#ifdef ENABLE_FFTW
+        fftwf_execute_dft(m_fftw_plan_forward,
+                          (fftwf_complex*)m_global_mesh.data(),
+                          (fftwf_complex*)h_fourier_mesh.data);
+#else
+        kiss_fftnd(m_kiss_fft, m_global_mesh.data(), h_fourier_mesh.data);
+#endif
+        if (m_prof)
+            m_prof->pop();
+        }
+
+    applyInfluenceFunction();
+
+    GlobalArray<kiss_fft_cpx>* fourier_mesh_G[3]
+        = {&m_fourier_mesh_G_x, &m_fourier_mesh_G_y, &m_fourier_mesh_G_z};
+    GlobalArray<kiss_fft_cpx>* inv_fourier_mesh[3]
+        = {&m_inv_fourier_mesh_x, &m_inv_fourier_mesh_y, &m_inv_fourier_mesh_z};
+
+    // ad needs only the potential mesh
+    unsigned int n_meshes = m_analytic_diff ? 1 : 3;
+    for (unsigned int i = 0; i < n_meshes; ++i)
+        {
+        if (m_kiss_fft_initialized)
+            {
+            if (m_prof)
+                m_prof->push("FFT");
+            ArrayHandle<kiss_fft_cpx> h_fourier_mesh_G(*fourier_mesh_G[i],
+                                                       access_location::host,
+                                                       access_mode::read);
+#ifdef ENABLE_FFTW
+            fftwf_execute_dft(m_fftw_plan_inverse,
+                              (fftwf_complex*)h_fourier_mesh_G.data,
+                              (fftwf_complex*)m_global_mesh.data());
+#else
+            kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G.data, m_global_mesh.data());
+#endif
+            if (m_prof)
+                m_prof->pop();
+            }
+
+        if (m_prof)
+            m_prof->push("scatter");
+        scatterMesh(*inv_fourier_mesh[i]);
+        if (m_prof)
+            m_prof->pop();
+
+        // update outer cells of the mesh using ghost cells from neighboring processors
+        if (m_prof)
+            m_prof->push("ghost cell update");
+        m_grid_comm_reverse->communicate(*inv_fourier_mesh[i]);
+        if (m_prof)
+            m_prof->pop();
+        }
+    }
+#endif
+
+/*! \param grad_x Output gradient of the first mesh coordinate
+    \param grad_y Output gradient of the second mesh coordinate
+    \param grad_z Output gradient of the third mesh coordinate
+
+    The mesh coordinates of a particle are its fractional coordinates in the local box times the
+    number of local mesh points. Their gradients are the reciprocal lattice vectors of the local box
+    (without the factor 2 pi) times the number of mesh points.
+*/
+void PPPMForceCompute::computeMeshGradients(Scalar3& grad_x, Scalar3& grad_y, Scalar3& grad_z)
+    {
+    const BoxDim& box = m_pdata->getBox();
+    Scalar3 a1 = box.getLatticeVector(0);
+    Scalar3 a2 = box.getLatticeVector(1);
+    Scalar3 a3 = box.getLatticeVector(2);
+    Scalar V = box.getVolume();
+
+    grad_x = (Scalar)m_mesh_points.x
+             * make_scalar3(a2.y * a3.z - a2.z * a3.y,
+                            a2.z * a3.x - a2.x * a3.z,
+                            a2.x * a3.y - a2.y * a3.x)
+             / V;
+    grad_y = (Scalar)m_mesh_points.y
+             * make_scalar3(a3.y * a1.z - a3.z * a1.y,
+                            a3.z * a1.x - a3.x * a1.z,
+                            a3.x * a1.y - a3.y * a1.x)
+             / V;
+    grad_z = (Scalar)m_mesh_points.z
+             * make_scalar3(a1.y * a2.z - a1.z * a2.y,
+                            a1.z * a2.x - a1.x * a2.z,
+                            a1.x * a2.y - a1.y * a2.x)
+             / V;
+    }
+
 void PPPMForceCompute::interpolateForces()
     {
     if (m_prof)
@@ -1155,6 +1514,9 @@ void PPPMForceCompute::interpolateForces()
 
     const BoxDim& box = m_pdata->getBox();
 
+    Scalar3 grad_x, grad_y, grad_z;
+    computeMeshGradients(grad_x, grad_y, grad_z);
+
     // loop over group
     unsigned int group_size = m_group->getNumMembers();
     for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
@@ -1220,8 +1582,12 @@ void PPPMForceCompute::interpolateForces()
 
         Scalar3 force = make_scalar3(0.0, 0.0, 0.0);
 
+        // derivatives of the potential with respect to the mesh coordinates (ad)
+        Scalar3 dphi = make_scalar3(0.0, 0.0, 0.0);
+
         int mult_fact = 2 * m_order + 1;
         Scalar Wx, Wy, Wz;
+        Scalar dWx, dWy, dWz;
 
         int nlower = -(m_order - 1) / 2;
         int nupper = m_order / 2;
@@ -1229,8 +1595,10 @@ void PPPMForceCompute::interpolateForces()
         for (int i = nlower; i <= nupper; ++i)
             {
             Wx = Scalar(0.0);
+            dWx = Scalar(0.0);
             for (int iorder = m_order - 1; iorder >= 0; iorder--)
                 {
+                dWx = Wx + dWx * dx;
                 Wx = h_rho_coeff.data[i - nlower + iorder * mult_fact] + Wx * dx;
                 }
 
@@ -1247,8 +1615,10 @@ void PPPMForceCompute::interpolateForces()
             for (int j = nlower; j <= nupper; ++j)
                 {
                 Wy = Scalar(0.0);
+                dWy = Scalar(0.0);
                 for (int iorder = m_order - 1; iorder >= 0; iorder--)
                     {
+                    dWy = Wy + dWy * dy;
                     Wy = h_rho_coeff.data[j - nlower + iorder * mult_fact] + Wy * dy;
                     }
 
@@ -1265,8 +1635,10 @@ void PPPMForceCompute::interpolateForces()
                 for (int k = nlower; k <= nupper; ++k)
                     {
                     Wz = Scalar(0.0);
+                    dWz = Scalar(0.0);
                     for (int iorder = m_order - 1; iorder >= 0; iorder--)
                         {
+                        dWz = Wz + dWz * dz;
                         Wz = h_rho_coeff.data[k - nlower + iorder * mult_fact] + Wz * dz;
                         }
 
@@ -1282,6 +1654,16 @@ void PPPMForceCompute::interpolateForces()
                     unsigned int neigh_idx
                         = neighi + m_grid_dim.x * (neighj + m_grid_dim.y * neighk);
 
+                    if (m_analytic_diff)
+                        {
+                        // the weights depend on the mesh coordinates through -dx, -dy, -dz
+                        Scalar phi = h_inv_fourier_mesh_x.data[neigh_idx].r;
+                        dphi.x -= phi * dWx * Wy * Wz;
+                        dphi.y -= phi * Wx * dWy * Wz;
+                        dphi.z -= phi * Wx * Wy * dWz;
+                        continue;
+                        }
+
                     kiss_fft_cpx E_x = h_inv_fourier_mesh_x.data[neigh_idx];
                     kiss_fft_cpx E_y = h_inv_fourier_mesh_y.data[neigh_idx];
                     kiss_fft_cpx E_z = h_inv_fourier_mesh_z.data[neigh_idx];
@@ -1294,6 +1676,11 @@ void PPPMForceCompute::interpolateForces()
                 }
             }
 
+        if (m_analytic_diff)
+            {
+            force = -qi * (dphi.x * grad_x + dphi.y * grad_y + dphi.z * grad_z);
+            }
+
         h_force.data[idx] = make_scalar4(force.x, force.y, force.z, 0.0);
         } // end of loop over particles
 
@@ -1315,14 +1702,14 @@ Scalar PPPMForceCompute::computePE()
 
     bool exclude_dc = true;
 #ifdef ENABLE_MPI
-    if (m_pdata->getDomainDecomposition())
+    if (m_pdata->getDomainDecomposition() && !m_fft_gathered)
         {
         uint3 my_pos = m_pdata->getDomainDecomposition()->getGridPos();
         exclude_dc = !my_pos.x && !my_pos.y && !my_pos.z;
         }
 #endif
 
-    for (unsigned int k = 0; k < m_n_inner_cells; ++k)
+    for (unsigned int k = 0; k < m_n_fourier_cells; ++k)
         {
         bool exclude = false;
         if (exclude_dc)
@@ -1444,6 +1831,11 @@ void PPPMForceCompute::computeForces(uint64_t timestep)
 
     interpolateForces();
 
+    if (m_slab_correction)
+        {
+        applySlabCorrection();
+        }
+
     if (flags[pdata_flag::pressure_tensor])
         {
         computeVirial();
@@ -1483,14 +1875,14 @@ void PPPMForceCompute::computeVirial()
 
     bool exclude_dc = true;
 #ifdef ENABLE_MPI
-    if (m_pdata->getDomainDecomposition())
+    if (m_pdata->getDomainDecomposition() && !m_fft_gathered)
         {
         uint3 my_pos = m_pdata->getDomainDecomposition()->getGridPos();
         exclude_dc = !my_pos.x && !my_pos.y && !my_pos.z;
         }
 #endif
 
-    for (unsigned int kidx = 0; kidx < m_n_inner_cells; ++kidx)
+    for (unsigned int kidx = 0; kidx < m_n_fourier_cells; ++kidx)
         {
         bool exclude = false;
         if (exclude_dc)
@@ -1530,6 +1922,89 @@ void PPPMForceCompute::computeVirial()
         m_prof->pop();
     }
 
+/*! The correction energy is
+
+    \f[ E = \frac{2\pi}{V} \left( M_z^2 - Q \sum_i q_i z_i^2 - Q^2 \frac{L_z^2}{12} \right) \f]
+
+    where \f$ M_z = \sum_i q_i z_i \f$ and \f$ Q \f$ is the total charge. The correction does not
+    contribute to the virial.
+*/
+void PPPMForceCompute::applySlabCorrection()
+    {
+    if (m_prof)
+        m_prof->push("slab correction");
+
+    Scalar2 moments = computeSlabMoments();
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &moments,
+                      2,
+                      MPI_HOOMD_SCALAR,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    Scalar V = global_box.getVolume();
+    Scalar L_z = global_box.getL().z;
+    Scalar M_z = moments.x;
+
+    if (m_exec_conf->getRank() == 0)
+        {
+        m_external_energy += Scalar(2.0 * M_PI) / V
+                             * (M_z * M_z - m_q * moments.y - m_q * m_q * L_z * L_z / Scalar(12.0));
+        }
+
+    addSlabForces(M_z);
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+Scalar2 PPPMForceCompute::computeSlabMoments()
+    {
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+
+    Scalar2 moments = make_scalar2(0.0, 0.0);
+    unsigned int group_size = m_group->getNumMembers();
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        {
+        unsigned int idx = m_group->getMemberIndex(group_idx);
+        Scalar qi = h_charge.data[idx];
+        Scalar zi = h_postype.data[idx].z;
+        moments.x += qi * zi;
+        moments.y += qi * zi * zi;
+        }
+
+    return moments;
+    }
+
+void PPPMForceCompute::addSlabForces(Scalar M_z)
+    {
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::readwrite);
+
+    Scalar prefactor = Scalar(-4.0 * M_PI) / m_pdata->getGlobalBox().getVolume();
+    unsigned int group_size = m_group->getNumMembers();
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        {
+        unsigned int idx = m_group->getMemberIndex(group_idx);
+        Scalar qi = h_charge.data[idx];
+        Scalar zi = h_postype.data[idx].z;
+        h_force.data[idx].z += prefactor * qi * (M_z - m_q * zi);
+        }
+    }
+
 //! The real space form of the long-range interaction part, for exclusions
 inline void
 eval_pppm_real_space(Scalar alpha, Scalar kappa, Scalar rsq, Scalar& pair_eng, Scalar& force_divr)
@@ -1841,7 +2316,10 @@ void export_PPPMForceCompute(pybind11::module& m)
         .def_property_readonly("order", &PPPMForceCompute::getOrder)
         .def_property_readonly("kappa", &PPPMForceCompute::getKappa)
         .def_property_readonly("r_cut", &PPPMForceCompute::getRCut)
-        .def_property_readonly("alpha", &PPPMForceCompute::getAlpha);
+        .def_property_readonly("alpha", &PPPMForceCompute::getAlpha)
+        .def_property_readonly("differentiation", &PPPMForceCompute::getDifferentiation)
+        .def_property_readonly("single_rank_fft", &PPPMForceCompute::getSingleRankFFT)
+        .def_property_readonly("slab_correction", &PPPMForceCompute::getSlabCorrection);
     }
 
     } // end namespace detail
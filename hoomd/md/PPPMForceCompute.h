@@ -15,8 +15,14 @@
 
 #include "hoomd/extern/kiss_fftnd.h"
 
+#ifdef ENABLE_FFTW
+#include <fftw3.h>
+#endif
+
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace hoomd
     {
@@ -43,7 +49,10 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
                            unsigned int order,
                            Scalar kappa,
                            Scalar rcut,
-                           Scalar alpha = 0);
+                           Scalar alpha = 0,
+                           bool analytic_diff = false,
+                           bool single_rank_fft = false,
+                           bool slab_correction = false);
 
     void computeForces(uint64_t timestep);
 
@@ -84,6 +93,24 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         return m_alpha;
         }
 
+    /// Get the differentiation scheme ("ik" or "ad")
+    std::string getDifferentiation()
+        {
+        return m_analytic_diff ? "ad" : "ik";
+        }
+
+    /// Get whether the reciprocal space term is computed on rank 0 only
+    bool getSingleRankFFT()
+        {
+        return m_single_rank_fft;
+        }
+
+    /// Get whether the slab correction is applied
+    bool getSlabCorrection()
+        {
+        return m_slab_correction;
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     /*! \param timestep Current time step
@@ -138,11 +165,37 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
 
     GlobalArray<Scalar> m_virial_mesh; //!< k-space mesh of virial tensor values
 
+    uint3 m_fourier_dim;            //!< Dimensions of the mesh transformed on this rank
+    unsigned int m_n_fourier_cells; //!< Number of wave vectors held by this rank
+
     Scalar m_kappa; //!< Splitting parameter
     Scalar m_rcut;  //!< Cutoff for short-ranged interaction
     int m_order;    //!< Order of interpolation scheme
     Scalar m_alpha; //!< Debye screening parameter
 
+    //! True to differentiate the assignment function (ad) instead of the potential mesh (ik)
+    /*! Analytical differentiation transforms a single potential mesh back to real space and
+        interpolates the force with the gradient of the assignment function, so it needs one
+        inverse FFT per step instead of three.
+    */
+    bool m_analytic_diff;
+
+    //! True to compute the reciprocal space term on rank 0 in MPI simulations
+    /*! The other ranks send the inner cells of their charge mesh to rank 0, which transforms the
+        global mesh with a local FFT and sends back the inner cells of the force (or potential)
+        meshes. This replaces the all-to-all communication of the distributed FFT with one gather
+        and one scatter per transformed mesh.
+    */
+    bool m_single_rank_fft;
+
+    //! True to correct for the periodic images along z in slab systems
+    /*! The slab correction (Yeh and Berkowitz 1999, with the terms for non-neutral systems from
+        Ballenegger et al. 2009) removes the interaction of the slab with its periodic images along
+        z. It lets slab systems use a vacuum gap of about twice the slab thickness instead of a much
+        larger one.
+    */
+    bool m_slab_correction;
+
     Scalar m_q;  //!< Total system charge
     Scalar m_q2; //!< Sum of charge squared
 
@@ -197,10 +250,29 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
     //! Compute rigid body correction
     virtual void computeBodyCorrection();
 
+    //! Compute the gradients of the local mesh coordinates with respect to the particle position
+    void computeMeshGradients(Scalar3& grad_x, Scalar3& grad_y, Scalar3& grad_z);
+
+    //! Add the slab correction to the energy and forces
+    void applySlabCorrection();
+
+    //! Sum q*z and q*z^2 over the local group members
+    virtual Scalar2 computeSlabMoments();
+
+    //! Add the slab correction forces
+    /*! \param M_z Total dipole moment along z
+     */
+    virtual void addSlabForces(Scalar M_z);
+
     private:
     kiss_fftnd_cfg m_kiss_fft = NULL;  //!< The FFT configuration
     kiss_fftnd_cfg m_kiss_ifft = NULL; //!< Inverse FFT configuration
 
+#ifdef ENABLE_FFTW
+    fftwf_plan m_fftw_plan_forward = NULL; //!< FFTW plan for the local forward transform
+    fftwf_plan m_fftw_plan_inverse = NULL; //!< FFTW plan for the local inverse transform
+#endif
+
 #ifdef ENABLE_MPI
     dfft_plan m_dfft_plan_forward; //!< Distributed FFT for forward transform
     dfft_plan m_dfft_plan_inverse; //!< Distributed FFT for inverse transform
@@ -210,7 +282,7 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         m_grid_comm_reverse; //!< Communicator for inv fourier mesh
 #endif
 
-    bool m_kiss_fft_initialized; //!< True if a local KISS FFT has been set up
+    bool m_kiss_fft_initialized; //!< True if a local (KISS or FFTW) FFT has been set up
 
     GlobalArray<kiss_fft_cpx> m_mesh;         //!< The particle density mesh
     GlobalArray<kiss_fft_cpx> m_fourier_mesh; //!< The fourier transformed mesh
@@ -229,6 +301,29 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
 
     bool m_dfft_initialized; //! True if host dfft has been initialized
 
+#ifdef ENABLE_MPI
+    bool m_fft_gathered; //!< True if the meshes are gathered to rank 0 for the FFT
+
+    std::vector<kiss_fft_cpx> m_inner_buf;   //!< Inner cells of the local mesh
+    std::vector<kiss_fft_cpx> m_gather_buf;  //!< Inner cells of the meshes of all ranks, by rank
+    std::vector<kiss_fft_cpx> m_global_mesh; //!< Global mesh on rank 0, in FFT layout
+
+    //! Copy between the gathered inner cells and the global mesh on rank 0
+    void copyGatheredCells(bool to_global);
+
+    //! Gather the inner cells of a local mesh into the global mesh on rank 0
+    void gatherMesh(const GlobalArray<kiss_fft_cpx>& mesh);
+
+    //! Scatter the global mesh on rank 0 into the inner cells of the local meshes
+    void scatterMesh(GlobalArray<kiss_fft_cpx>& mesh);
+
+    //! Transform the meshes on rank 0
+    void updateMeshesGathered();
+#endif
+
+    //! Multiply the transformed charge mesh with the influence function
+    void applyInfluenceFunction();
+
     //! Compute virial on mesh
     void computeVirialMesh();
 
@@ -44,6 +44,9 @@ PPPMForceComputeGPU::PPPMForceComputeGPU(std::shared_ptr<SystemDefinition> sysde
 
     m_cufft_initialized = false;
     m_cuda_dfft_initialized = false;
+
+    GlobalArray<Scalar2> slab_moments(1, m_exec_conf);
+    m_slab_moments.swap(slab_moments);
     }
 
 PPPMForceComputeGPU::~PPPMForceComputeGPU()
@@ -67,6 +70,13 @@ PPPMForceComputeGPU::~PPPMForceComputeGPU()
 
 void PPPMForceComputeGPU::initializeFFT()
     {
+#ifdef ENABLE_MPI
+    if (m_single_rank_fft && m_pdata->getDomainDecomposition())
+        {
+        throw std::runtime_error("charge.pppm: single_rank_fft is not supported on the GPU.");
+        }
+#endif
+
     // free plans if they have already been initialized
     if (m_local_fft && m_cufft_initialized)
         {
@@ -448,6 +458,7 @@ void PPPMForceComputeGPU::updateMeshes()
                                   d_inf_f.data,
                                   d_k.data,
                                   m_global_dim.x * m_global_dim.y * m_global_dim.z,
+                                  m_analytic_diff,
                                   block_size);
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -463,7 +474,8 @@ void PPPMForceComputeGPU::updateMeshes()
         if (m_prof)
             m_prof->push(m_exec_conf, "FFT");
 
-        // do local inverse transform of all three components of the force mesh
+        // do local inverse transform of the potential mesh (ad) or of all three components of the
+        // force mesh (ik)
         ArrayHandle<hipfftComplex> d_inv_fourier_mesh_x(m_inv_fourier_mesh_x,
                                                         access_location::device,
                                                         access_mode::overwrite);
@@ -483,27 +495,33 @@ void PPPMForceComputeGPU::updateMeshes()
                                          d_inv_fourier_mesh_x.data,
                                          d_inv_fourier_mesh_x.data,
                                          HIPFFT_BACKWARD));
-        CHECK_HIPFFT_ERROR(hipfftExecC2C(m_hipfft_plan,
-                                         d_inv_fourier_mesh_y.data,
-                                         d_inv_fourier_mesh_y.data,
-                                         HIPFFT_BACKWARD));
-        CHECK_HIPFFT_ERROR(hipfftExecC2C(m_hipfft_plan,
-                                         d_inv_fourier_mesh_z.data,
-                                         d_inv_fourier_mesh_z.data,
-                                         HIPFFT_BACKWARD));
+        if (!m_analytic_diff)
+            {
+            CHECK_HIPFFT_ERROR(hipfftExecC2C(m_hipfft_plan,
+                                             d_inv_fourier_mesh_y.data,
+                                             d_inv_fourier_mesh_y.data,
+                                             HIPFFT_BACKWARD));
+            CHECK_HIPFFT_ERROR(hipfftExecC2C(m_hipfft_plan,
+                                             d_inv_fourier_mesh_z.data,
+                                             d_inv_fourier_mesh_z.data,
+                                             HIPFFT_BACKWARD));
+            }
 #else
         CHECK_HIPFFT_ERROR(cufftExecC2C(m_hipfft_plan,
                                         d_inv_fourier_mesh_x.data,
                                         d_inv_fourier_mesh_x.data,
                                         CUFFT_INVERSE));
-        CHECK_HIPFFT_ERROR(cufftExecC2C(m_hipfft_plan,
-                                        d_inv_fourier_mesh_y.data,
-                                        d_inv_fourier_mesh_y.data,
-                                        CUFFT_INVERSE));
-        CHECK_HIPFFT_ERROR(cufftExecC2C(m_hipfft_plan,
-                                        d_inv_fourier_mesh_z.data,
-                                        d_inv_fourier_mesh_z.data,
-                                        CUFFT_INVERSE));
+        if (!m_analytic_diff)
+            {
+            CHECK_HIPFFT_ERROR(cufftExecC2C(m_hipfft_plan,
+                                            d_inv_fourier_mesh_y.data,
+                                            d_inv_fourier_mesh_y.data,
+                                            CUFFT_INVERSE));
+            CHECK_HIPFFT_ERROR(cufftExecC2C(m_hipfft_plan,
+                                            d_inv_fourier_mesh_z.data,
+                                            d_inv_fourier_mesh_z.data,
+                                            CUFFT_INVERSE));
+            }
 #endif
         m_exec_conf->endMultiGPU();
 
@@ -538,14 +556,17 @@ void PPPMForceComputeGPU::updateMeshes()
                           d_inv_fourier_mesh_x.data + m_ghost_offset,
                           1,
                           &m_dfft_plan_inverse);
-        dfft_cuda_execute(d_inv_fourier_mesh_y.data + m_ghost_offset,
-                          d_inv_fourier_mesh_y.data + m_ghost_offset,
-                          1,
-                          &m_dfft_plan_inverse);
-        dfft_cuda_execute(d_inv_fourier_mesh_z.data + m_ghost_offset,
-                          d_inv_fourier_mesh_z.data + m_ghost_offset,
-                          1,
-                          &m_dfft_plan_inverse);
+        if (!m_analytic_diff)
+            {
+            dfft_cuda_execute(d_inv_fourier_mesh_y.data + m_ghost_offset,
+                              d_inv_fourier_mesh_y.data + m_ghost_offset,
+                              1,
+                              &m_dfft_plan_inverse);
+            dfft_cuda_execute(d_inv_fourier_mesh_z.data + m_ghost_offset,
+                              d_inv_fourier_mesh_z.data + m_ghost_offset,
+                              1,
+                              &m_dfft_plan_inverse);
+            }
 #else
         ArrayHandle<hipfftComplex> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x,
                                                         access_location::host,
@@ -560,14 +581,17 @@ void PPPMForceComputeGPU::updateMeshes()
                      (cpx_t*)h_inv_fourier_mesh_x.data + m_ghost_offset,
                      1,
                      m_dfft_plan_inverse);
-        dfft_execute((cpx_t*)h_inv_fourier_mesh_y.data + m_ghost_offset,
-                     (cpx_t*)h_inv_fourier_mesh_y.data + m_ghost_offset,
-                     1,
-                     m_dfft_plan_inverse);
-        dfft_execute((cpx_t*)h_inv_fourier_mesh_z.data + m_ghost_offset,
-                     (cpx_t*)h_inv_fourier_mesh_z.data + m_ghost_offset,
-                     1,
-                     m_dfft_plan_inverse);
+        if (!m_analytic_diff)
+            {
+            dfft_execute((cpx_t*)h_inv_fourier_mesh_y.data + m_ghost_offset,
+                         (cpx_t*)h_inv_fourier_mesh_y.data + m_ghost_offset,
+                         1,
+                         m_dfft_plan_inverse);
+            dfft_execute((cpx_t*)h_inv_fourier_mesh_z.data + m_ghost_offset,
+                         (cpx_t*)h_inv_fourier_mesh_z.data + m_ghost_offset,
+                         1,
+                         m_dfft_plan_inverse);
+            }
 #endif
         if (m_prof)
             m_prof->pop(m_exec_conf);
@@ -583,10 +607,13 @@ void PPPMForceComputeGPU::updateMeshes()
             m_prof->push(m_exec_conf, "ghost cell update");
         m_exec_conf->msg->notice(8) << "charge.pppm: Ghost cell update" << std::endl;
         m_gpu_grid_comm_reverse->communicate(m_inv_fourier_mesh_x);
-        m_gpu_grid_comm_reverse->communicate(m_inv_fourier_mesh_y);
-        m_gpu_grid_comm_reverse->communicate(m_inv_fourier_mesh_z);
+        if (!m_analytic_diff)
+            {
+            m_gpu_grid_comm_reverse->communicate(m_inv_fourier_mesh_y);
+            m_gpu_grid_comm_reverse->communicate(m_inv_fourier_mesh_z);
+            }
         if (m_prof)
-            m_prof->pop();
+            m_prof->pop(m_exec_conf);
         }
 #endif
     }
@@ -620,6 +647,9 @@ void PPPMForceComputeGPU::interpolateForces()
     // access polynomial interpolation coefficients
     ArrayHandle<Scalar> d_rho_coeff(m_rho_coeff, access_location::device, access_mode::read);
 
+    Scalar3 grad_x, grad_y, grad_z;
+    computeMeshGradients(grad_x, grad_y, grad_z);
+
     m_exec_conf->beginMultiGPU();
 
     unsigned int block_size = m_tuner_force->getParam();
@@ -641,7 +671,11 @@ void PPPMForceComputeGPU::interpolateForces()
                                d_rho_coeff.data,
                                block_size,
                                m_local_fft,
-                               m_n_cells + m_ghost_offset);
+                               m_n_cells + m_ghost_offset,
+                               m_analytic_diff,
+                               grad_x,
+                               grad_y,
+                               grad_z);
 
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
@@ -832,6 +866,7 @@ void PPPMForceComputeGPU::computeInfluenceFunction()
                                            m_alpha,
                                            d_gf_b.data,
                                            m_order,
+                                           m_analytic_diff,
                                            block_size);
 
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -894,6 +929,75 @@ void PPPMForceComputeGPU::fixExclusions()
         m_prof->pop(m_exec_conf);
     }
 
+Scalar2 PPPMForceComputeGPU::computeSlabMoments()
+    {
+    unsigned int group_size = m_group->getNumMembers();
+    unsigned int n_blocks = group_size / m_block_size + 1;
+    if (m_slab_moments_partial.getNumElements() < n_blocks)
+        {
+        GlobalArray<Scalar2> slab_moments_partial(n_blocks, m_exec_conf);
+        m_slab_moments_partial.swap(slab_moments_partial);
+        }
+
+        {
+        ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
+                                                access_location::device,
+                                                access_mode::read);
+        ArrayHandle<Scalar4> d_postype(m_pdata->getPositions(),
+                                       access_location::device,
+                                       access_mode::read);
+        ArrayHandle<Scalar> d_charge(m_pdata->getCharges(),
+                                     access_location::device,
+                                     access_mode::read);
+        ArrayHandle<Scalar2> d_slab_moments_partial(m_slab_moments_partial,
+                                                    access_location::device,
+                                                    access_mode::overwrite);
+        ArrayHandle<Scalar2> d_slab_moments(m_slab_moments,
+                                            access_location::device,
+                                            access_mode::overwrite);
+
+        kernel::gpu_compute_slab_moments(d_slab_moments_partial.data,
+                                         d_slab_moments.data,
+                                         d_postype.data,
+                                         d_charge.data,
+                                         d_index_array.data,
+                                         group_size,
+                                         m_block_size);
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    ArrayHandle<Scalar2> h_slab_moments(m_slab_moments, access_location::host, access_mode::read);
+    return h_slab_moments.data[0];
+    }
+
+void PPPMForceComputeGPU::addSlabForces(Scalar M_z)
+    {
+    ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
+                                            access_location::device,
+                                            access_mode::read);
+    ArrayHandle<Scalar4> d_postype(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::read);
+    ArrayHandle<Scalar> d_charge(m_pdata->getCharges(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::readwrite);
+
+    Scalar prefactor = Scalar(-4.0 * M_PI) / m_pdata->getGlobalBox().getVolume();
+    kernel::gpu_add_slab_forces(d_force.data,
+                                d_postype.data,
+                                d_charge.data,
+                                d_index_array.data,
+                                m_group->getNumMembers(),
+                                prefactor,
+                                M_z,
+                                m_q,
+                                m_block_size);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
 namespace detail
     {
 void export_PPPMForceComputeGPU(pybind11::module& m)
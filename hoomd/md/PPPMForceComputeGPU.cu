@@ -481,7 +481,8 @@ __global__ void gpu_update_meshes_kernel(const unsigned int n_wave_vectors,
                                          hipfftComplex* d_fourier_mesh_G_z,
                                          const Scalar* d_inf_f,
                                          const Scalar3* d_k,
-                                         unsigned int NNN)
+                                         unsigned int NNN,
+                                         bool analytic_diff)
     {
     unsigned int k;
 
@@ -494,6 +495,16 @@ __global__ void gpu_update_meshes_kernel(const unsigned int n_wave_vectors,
 
     Scalar scaled_inf_f = d_inf_f[k] / ((Scalar)NNN);
 
+    if (analytic_diff)
+        {
+        // the x component holds the potential mesh
+        hipfftComplex fourier_phi;
+        fourier_phi.x = f.x * scaled_inf_f;
+        fourier_phi.y = f.y * scaled_inf_f;
+        d_fourier_mesh_G_x[k] = fourier_phi;
+        return;
+        }
+
     Scalar3 kvec = d_k[k];
 
     // Normalization
@@ -523,6 +534,7 @@ void gpu_update_meshes(const unsigned int n_wave_vectors,
                        const Scalar* d_inf_f,
                        const Scalar3* d_k,
                        unsigned int NNN,
+                       bool analytic_diff,
                        unsigned int block_size)
 
     {
@@ -546,7 +558,8 @@ void gpu_update_meshes(const unsigned int n_wave_vectors,
                        d_fourier_mesh_G_z,
                        d_inf_f,
                        d_k,
-                       NNN);
+                       NNN,
+                       analytic_diff);
     }
 
 __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
@@ -562,7 +575,11 @@ __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
                                           const hipfftComplex* inv_fourier_mesh_y,
                                           const hipfftComplex* inv_fourier_mesh_z,
                                           const Scalar* d_rho_coeff,
-                                          const unsigned int offset)
+                                          const unsigned int offset,
+                                          const bool analytic_diff,
+                                          const Scalar3 grad_x,
+                                          const Scalar3 grad_y,
+                                          const Scalar3 grad_z)
     {
     extern __shared__ Scalar s_coeff[];
 
@@ -612,36 +629,48 @@ __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
 
     Scalar3 force = make_scalar3(0.0, 0.0, 0.0);
 
+    // derivatives of the potential with respect to the mesh coordinates (ad)
+    Scalar3 dphi = make_scalar3(0.0, 0.0, 0.0);
+
     int nlower = -(order - 1) / 2;
     int nupper = order / 2;
 
-    Scalar result;
+    Scalar result, dresult;
     int mult_fact = 2 * order + 1;
 
     // back-interpolate forces from neighboring mesh points
     for (int l = nlower; l <= nupper; ++l)
         {
         result = Scalar(0.0);
+        dresult = Scalar(0.0);
         for (int k = order - 1; k >= 0; k--)
             {
+            dresult = result + dresult * dr.x;
             result = s_coeff[l - nlower + k * mult_fact] + result * dr.x;
             }
         Scalar x0 = result;
+        Scalar dx0 = dresult;
 
         for (int m = nlower; m <= nupper; ++m)
             {
             result = Scalar(0.0);
+            dresult = Scalar(0.0);
             for (int k = order - 1; k >= 0; k--)
                 {
+                dresult = result + dresult * dr.y;
                 result = s_coeff[m - nlower + k * mult_fact] + result * dr.y;
                 }
             Scalar y0 = x0 * result;
+            Scalar y1 = dx0 * result;
+            Scalar y2 = x0 * dresult;
 
             for (int n = nlower; n <= nupper; ++n)
                 {
                 result = Scalar(0.0);
+                dresult = Scalar(0.0);
                 for (int k = order - 1; k >= 0; k--)
                     {
+                    dresult = result + dresult * dr.z;
                     result = s_coeff[n - nlower + k * mult_fact] + result * dr.z;
                     }
                 Scalar z0 = y0 * result;
@@ -677,6 +706,16 @@ __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
                 // use column-major layout
                 unsigned int cell_idx = neighl + grid_dim.x * (neighm + grid_dim.y * neighn);
 
+                if (analytic_diff)
+                    {
+                    // the weights depend on the mesh coordinates through -dr
+                    Scalar phi = inv_fourier_mesh_x[cell_idx].x;
+                    dphi.x -= phi * y1 * result;
+                    dphi.y -= phi * y2 * result;
+                    dphi.z -= phi * y0 * dresult;
+                    continue;
+                    }
+
                 hipfftComplex inv_mesh_x = inv_fourier_mesh_x[cell_idx];
                 hipfftComplex inv_mesh_y = inv_fourier_mesh_y[cell_idx];
                 hipfftComplex inv_mesh_z = inv_fourier_mesh_z[cell_idx];
@@ -688,6 +727,9 @@ __global__ void gpu_compute_forces_kernel(const unsigned int work_size,
             }
         } // end neighbor cells loop
 
+    if (analytic_diff)
+        force = -qi * (dphi.x * grad_x + dphi.y * grad_y + dphi.z * grad_z);
+
     d_force[idx] = make_scalar4(force.x, force.y, force.z, 0.0);
     }
 
@@ -708,7 +750,11 @@ void gpu_compute_forces(const unsigned int N,
                         const Scalar* d_rho_coeff,
                         unsigned int block_size,
                         bool local_fft,
-                        unsigned int inv_mesh_elements)
+                        unsigned int inv_mesh_elements,
+                        bool analytic_diff,
+                        const Scalar3 grad_x,
+                        const Scalar3 grad_y,
+                        const Scalar3 grad_z)
     {
     unsigned int max_block_size;
     hipFuncAttributes attr;
@@ -754,7 +800,11 @@ void gpu_compute_forces(const unsigned int N,
             local_fft ? d_inv_fourier_mesh_y + idev * inv_mesh_elements : d_inv_fourier_mesh_y,
             local_fft ? d_inv_fourier_mesh_z + idev * inv_mesh_elements : d_inv_fourier_mesh_z,
             d_rho_coeff,
-            range.first);
+            range.first,
+            analytic_diff,
+            grad_x,
+            grad_y,
+            grad_z);
         }
     }
 
@@ -1070,7 +1120,8 @@ __global__ void gpu_compute_influence_function_kernel(const uint3 mesh_dim,
                                                       const Scalar* gf_b,
                                                       int order,
                                                       Scalar kappa,
-                                                      Scalar alpha)
+                                                      Scalar alpha,
+                                                      bool analytic_diff)
     {
     unsigned int kidx;
 
@@ -1186,7 +1237,9 @@ __global__ void gpu_compute_influence_function_kernel(const uint3 mesh_dim,
                         }
 
                     Scalar3 kn = knx + kny + knz;
-                    Scalar dot1 = dot(kn, kval);
+
+                    // the optimal ad influence function weighs the aliases by k_n^2
+                    Scalar dot1 = analytic_diff ? dot(kn, kn) : dot(kn, kval);
                     Scalar dot2 = dot(kn, kn) + alpha * alpha;
 
                     Scalar arg_gauss = Scalar(0.25) * dot2 / kappa / kappa;
@@ -1221,6 +1274,7 @@ void gpu_compute_influence_function(const uint3 mesh_dim,
                                     Scalar alpha,
                                     const Scalar* d_gf_b,
                                     int order,
+                                    bool analytic_diff,
                                     unsigned int block_size)
     {
     // compute reciprocal lattice vectors
@@ -1291,7 +1345,8 @@ void gpu_compute_influence_function(const uint3 mesh_dim,
                            d_gf_b,
                            order,
                            kappa,
-                           alpha);
+                           alpha,
+                           analytic_diff);
         }
 #ifdef ENABLE_MPI
     else
@@ -1330,7 +1385,8 @@ void gpu_compute_influence_function(const uint3 mesh_dim,
                            d_gf_b,
                            order,
                            kappa,
-                           alpha);
+                           alpha,
+                           analytic_diff);
         }
 #endif
     }
@@ -1478,6 +1534,167 @@ hipError_t gpu_fix_exclusions(Scalar4* d_force,
     return hipSuccess;
     }
 
+__global__ void kernel_slab_moments_partial(Scalar2* d_slab_moments_partial,
+                                            const Scalar4* d_pos,
+                                            const Scalar* d_charge,
+                                            const unsigned int* d_group_members,
+                                            unsigned int group_size)
+    {
+    HIP_DYNAMIC_SHARED(Scalar2, sdata2)
+
+    unsigned int group_idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    Scalar2 my_moments = make_scalar2(0.0, 0.0);
+    if (group_idx < group_size)
+        {
+        unsigned int idx = d_group_members[group_idx];
+        Scalar qi = d_charge[idx];
+        Scalar zi = d_pos[idx].z;
+        my_moments = make_scalar2(qi * zi, qi * zi * zi);
+        }
+
+    sdata2[threadIdx.x] = my_moments;
+    __syncthreads();
+
+    int offs = blockDim.x >> 1;
+    while (offs > 0)
+        {
+        if (threadIdx.x < offs)
+            {
+            sdata2[threadIdx.x].x += sdata2[threadIdx.x + offs].x;
+            sdata2[threadIdx.x].y += sdata2[threadIdx.x + offs].y;
+            }
+        offs >>= 1;
+        __syncthreads();
+        }
+
+    if (threadIdx.x == 0)
+        d_slab_moments_partial[blockIdx.x] = sdata2[0];
+    }
+
+__global__ void kernel_final_reduce_slab_moments(const Scalar2* d_slab_moments_partial,
+                                                 unsigned int nblocks,
+                                                 Scalar2* d_slab_moments)
+    {
+    HIP_DYNAMIC_SHARED(Scalar2, smem2)
+
+    Scalar2 sum = make_scalar2(0.0, 0.0);
+
+    for (int start = 0; start < nblocks; start += blockDim.x)
+        {
+        __syncthreads();
+        if (start + threadIdx.x < nblocks)
+            smem2[threadIdx.x] = d_slab_moments_partial[start + threadIdx.x];
+        else
+            smem2[threadIdx.x] = make_scalar2(0.0, 0.0);
+
+        __syncthreads();
+
+        // reduce the sum
+        int offs = blockDim.x >> 1;
+        while (offs > 0)
+            {
+            if (threadIdx.x < offs)
+                {
+                smem2[threadIdx.x].x += smem2[threadIdx.x + offs].x;
+                smem2[threadIdx.x].y += smem2[threadIdx.x + offs].y;
+                }
+            offs >>= 1;
+            __syncthreads();
+            }
+
+        if (threadIdx.x == 0)
+            {
+            sum.x += smem2[0].x;
+            sum.y += smem2[0].y;
+            }
+        }
+
+    if (threadIdx.x == 0)
+        *d_slab_moments = sum;
+    }
+
+//! Sum the moments (sum q_i z_i, sum q_i z_i^2) of the group members for the slab correction
+void gpu_compute_slab_moments(Scalar2* d_slab_moments_partial,
+                              Scalar2* d_slab_moments,
+                              const Scalar4* d_pos,
+                              const Scalar* d_charge,
+                              const unsigned int* d_group_members,
+                              unsigned int group_size,
+                              unsigned int block_size)
+    {
+    unsigned int n_blocks = group_size / block_size + 1;
+    unsigned int shared_size = (unsigned int)(block_size * sizeof(Scalar2));
+
+    hipLaunchKernelGGL((kernel_slab_moments_partial),
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       shared_size,
+                       0,
+                       d_slab_moments_partial,
+                       d_pos,
+                       d_charge,
+                       d_group_members,
+                       group_size);
+
+    const unsigned int final_block_size = 256;
+    shared_size = final_block_size * sizeof(Scalar2);
+    hipLaunchKernelGGL((kernel_final_reduce_slab_moments),
+                       dim3(1),
+                       dim3(final_block_size),
+                       shared_size,
+                       0,
+                       d_slab_moments_partial,
+                       n_blocks,
+                       d_slab_moments);
+    }
+
+__global__ void gpu_add_slab_forces_kernel(Scalar4* d_force,
+                                           const Scalar4* d_pos,
+                                           const Scalar* d_charge,
+                                           const unsigned int* d_group_members,
+                                           unsigned int group_size,
+                                           Scalar prefactor,
+                                           Scalar M_z,
+                                           Scalar Q)
+    {
+    unsigned int group_idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    if (group_idx >= group_size)
+        return;
+
+    unsigned int idx = d_group_members[group_idx];
+    Scalar qi = d_charge[idx];
+    Scalar zi = d_pos[idx].z;
+    d_force[idx].z += prefactor * qi * (M_z - Q * zi);
+    }
+
+//! Add the slab correction force prefactor * q_i * (M_z - Q z_i) to the group members
+void gpu_add_slab_forces(Scalar4* d_force,
+                         const Scalar4* d_pos,
+                         const Scalar* d_charge,
+                         const unsigned int* d_group_members,
+                         unsigned int group_size,
+                         Scalar prefactor,
+                         Scalar M_z,
+                         Scalar Q,
+                         unsigned int block_size)
+    {
+    hipLaunchKernelGGL((gpu_add_slab_forces_kernel),
+                       dim3(group_size / block_size + 1),
+                       dim3(block_size),
+                       0,
+                       0,
+                       d_force,
+                       d_pos,
+                       d_charge,
+                       d_group_members,
+                       group_size,
+                       prefactor,
+                       M_z,
+                       Q);
+    }
+
     } // namespace kernel
     } // end namespace md
     } // end namespace hoomd
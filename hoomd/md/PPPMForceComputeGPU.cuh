@@ -63,6 +63,7 @@ void gpu_update_meshes(const unsigned int n_wave_vectors,
                        const Scalar* d_inf_f,
                        const Scalar3* d_k,
                        unsigned int NNN,
+                       bool analytic_diff,
                        unsigned int block_size);
 
 void gpu_compute_forces(const unsigned int N,
@@ -82,7 +83,11 @@ void gpu_compute_forces(const unsigned int N,
                         const Scalar* d_rho_coeff,
                         unsigned int block_size,
                         bool local_fft,
-                        unsigned int inv_mesh_elements);
+                        unsigned int inv_mesh_elements,
+                        bool analytic_diff,
+                        const Scalar3 grad_x,
+                        const Scalar3 grad_y,
+                        const Scalar3 grad_z);
 
 void gpu_compute_pe(unsigned int n_wave_vectors,
                     Scalar* d_sum_partial,
@@ -112,6 +117,7 @@ void gpu_compute_influence_function(const uint3 mesh_dim,
                                     Scalar alpha,
                                     const Scalar* gf_b,
                                     int order,
+                                    bool analytic_diff,
                                     unsigned int block_size);
 
 hipError_t gpu_fix_exclusions(Scalar4* d_force,
@@ -130,6 +136,24 @@ hipError_t gpu_fix_exclusions(Scalar4* d_force,
                               unsigned int group_size,
                               int block_size);
 
+void gpu_compute_slab_moments(Scalar2* d_slab_moments_partial,
+                              Scalar2* d_slab_moments,
+                              const Scalar4* d_pos,
+                              const Scalar* d_charge,
+                              const unsigned int* d_group_members,
+                              unsigned int group_size,
+                              unsigned int block_size);
+
+void gpu_add_slab_forces(Scalar4* d_force,
+                         const Scalar4* d_pos,
+                         const Scalar* d_charge,
+                         const unsigned int* d_group_members,
+                         unsigned int group_size,
+                         Scalar prefactor,
+                         Scalar M_z,
+                         Scalar Q,
+                         unsigned int block_size);
+
 void gpu_initialize_coeff(Scalar* CPU_rho_coeff, int order, const GPUPartition& gpu_partition);
 
     } // end namespace kernel
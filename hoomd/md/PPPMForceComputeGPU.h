@@ -96,6 +96,12 @@ class PYBIND11_EXPORT PPPMForceComputeGPU : public PPPMForceCompute
     //! Helper function to correct forces on excluded particles
     virtual void fixExclusions();
 
+    //! Sum the first and second moments of the charge distribution along z
+    virtual Scalar2 computeSlabMoments();
+
+    //! Add the slab correction forces
+    virtual void addSlabForces(Scalar M_z);
+
 //! Check for HIPFFT errors
 #ifdef __HIP_PLATFORM_HCC__
     inline void handleHIPFFTResult(hipfftResult result, const char* file, unsigned int line) const
@@ -150,6 +156,9 @@ class PYBIND11_EXPORT PPPMForceComputeGPU : public PPPMForceCompute
     GlobalArray<Scalar> m_sum_virial_partial; //!< Partial sums over virial mesh values
     GlobalArray<Scalar> m_sum_virial;         //!< Final sum over virial mesh values
     unsigned int m_block_size;                //!< Block size for fourier mesh reduction
+
+    GlobalArray<Scalar2> m_slab_moments_partial; //!< Partial sums of the slab correction moments
+    GlobalArray<Scalar2> m_slab_moments;         //!< Final sum of the slab correction moments
     };
 
 namespace detail
@@ -0,0 +1,118 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "PairEvalFactory.h"
+#include "hoomd/hpmc/ClangCompiler.h"
+
+#include <memory>
+#include <sstream>
+#include <utility>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+
+#include "llvm/Support/DynamicLibrary.h"
+
+#pragma GCC diagnostic pop
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param cpp_code C++ code to compile
+    \param compiler_args Additional arguments to pass to the compiler
+    \param cache_dir Directory to cache the compiled module in (empty to disable the cache)
+
+    On failure, getEval() returns nullptr and getError() describes the problem.
+*/
+PairEvalFactory::PairEvalFactory(const std::string& cpp_code,
+                                 const std::vector<std::string>& compiler_args,
+                                 const std::string& cache_dir)
+    {
+    std::ostringstream sstream;
+    m_eval = nullptr;
+    m_param_array = nullptr;
+
+    // initialize LLVM
+    auto clang_compiler = hpmc::ClangCompiler::getClangCompiler();
+
+    // Add the program's symbols into the JIT's search space.
+    if (llvm::sys::DynamicLibrary::LoadLibraryPermanently(nullptr))
+        {
+        m_error_msg = "Error loading program symbols.\n";
+        return;
+        }
+
+    llvm::LLVMContext Context;
+
+    // compile the module with the precision of this build
+    std::vector<std::string> args(compiler_args);
+#ifdef SINGLE_PRECISION
+    args.push_back("-DSINGLE_PRECISION");
+#endif
+    auto module = clang_compiler->compileCode(cpp_code, args, Context, sstream, cache_dir);
+
+    if (!module)
+        {
+        // if the module didn't load, report an error
+        m_error_msg = sstream.str();
+        return;
+        }
+
+    // Build the JIT
+    m_jit = llvm::orc::KaleidoscopeJIT::Create();
+
+    if (!m_jit)
+        {
+        m_error_msg = "Could not initialize JIT.";
+        return;
+        }
+
+    // Add the module.
+    if (auto E = m_jit->addModule(std::move(module)))
+        {
+        m_error_msg = "Could not add JIT module.";
+        return;
+        }
+
+    // Check the interface version before touching any other symbol
+    auto abi_version = m_jit->findSymbol("hoomd_pair_jit_abi_version");
+    if (!abi_version)
+        {
+        m_error_msg = "Could not find hoomd_pair_jit_abi_version in LLVM module.";
+        return;
+        }
+
+    unsigned int version = *(unsigned int*)(abi_version->getAddress());
+    if (version != HOOMD_PAIR_JIT_ABI_VERSION)
+        {
+        m_error_msg = "The code was written for pair JIT interface version "
+                      + std::to_string(version) + ", this build of HOOMD-blue implements version "
+                      + std::to_string(HOOMD_PAIR_JIT_ABI_VERSION) + ".";
+        return;
+        }
+
+    // Look up the eval function pointer.
+    auto eval = m_jit->findSymbol("eval");
+
+    if (!eval)
+        {
+        m_error_msg = "Could not find eval function in LLVM module.";
+        return;
+        }
+
+    auto param_array = m_jit->findSymbol("param_array");
+    if (!param_array)
+        {
+        m_error_msg = "Could not find param_array array in LLVM module.";
+        return;
+        }
+
+    /// these casts are like this because 1) it works correctly like this and
+    /// 2) trying to use static_cast or reinterpret_cast gives compilation errors
+    m_param_array = (float**)(param_array->getAddress());
+    m_eval = (PairJITEvalFn)(long unsigned int)(eval->getAddress());
+    }
+
+    } // end namespace md
+    } // end namespace hoomd
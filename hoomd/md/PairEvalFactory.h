@@ -0,0 +1,65 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "PairJITABI.h"
+
+#include "hoomd/hpmc/KaleidoscopeJIT.h"
+
+#include <string>
+#include <vector>
+
+/*! \file PairEvalFactory.h
+    \brief Declares the class that compiles pair evaluators at run time
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Compile a pair evaluator with LLVM and look up its symbols
+/*! The code must define the symbols listed in PairJITABI.h. The factory checks that
+    hoomd_pair_jit_abi_version matches HOOMD_PAIR_JIT_ABI_VERSION before it returns the function.
+*/
+class PairEvalFactory
+    {
+    public:
+    //! Constructor
+    PairEvalFactory(const std::string& cpp_code,
+                    const std::vector<std::string>& compiler_args,
+                    const std::string& cache_dir = "");
+
+    //! Return the evaluator
+    PairJITEvalFn getEval()
+        {
+        return m_eval;
+        }
+
+    //! Get the error message from initialization
+    const std::string& getError()
+        {
+        return m_error_msg;
+        }
+
+    //! Retrieve the parameter array
+    float* getParamArray() const
+        {
+        return *m_param_array;
+        }
+
+    //! Set the parameter array
+    void setParamArray(float* h_param_array)
+        {
+        *m_param_array = h_param_array;
+        }
+
+    private:
+    std::unique_ptr<llvm::orc::KaleidoscopeJIT> m_jit; //!< The persistent JIT engine
+    PairJITEvalFn m_eval;                              //!< Function pointer to evaluator
+    float** m_param_array;                             //!< Pointer to the param_array symbol
+    std::string m_error_msg; //!< The error message if initialization fails
+    };
+
+    } // end namespace md
+    } // end namespace hoomd
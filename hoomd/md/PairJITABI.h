@@ -0,0 +1,47 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_JIT_ABI_H__
+#define __PAIR_JIT_ABI_H__
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file PairJITABI.h
+    \brief Defines the interface between PotentialPairJIT and run time compiled pair evaluators
+
+    This header is included both by HOOMD-blue and by the code compiled at run time, so it must
+    not include python or pybind11 headers.
+*/
+
+//! Version of the run time compiled pair evaluator interface
+/*! Increment the version whenever the signature of the eval function or the set of symbols
+    changes. PotentialPairJIT refuses to load code compiled against a different version.
+*/
+#define HOOMD_PAIR_JIT_ABI_VERSION 1
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Signature of the run time compiled pair evaluator
+/*! The compiled module defines these symbols with C linkage:
+
+    - unsigned int hoomd_pair_jit_abi_version: set to HOOMD_PAIR_JIT_ABI_VERSION
+    - float* param_array: set by HOOMD-blue to the adjustable parameters
+    - Scalar eval(Scalar r_sq, unsigned int type_i, unsigned int type_j, Scalar charge_i,
+                  Scalar charge_j, Scalar& force_divr)
+
+    eval returns the pair energy V(r) for r_sq < r_cut^2 and sets force_divr to
+    -(1/r) dV/dr. The code is compiled with the same precision as HOOMD-blue, so Scalar matches.
+*/
+typedef Scalar (*PairJITEvalFn)(Scalar r_sq,
+                                unsigned int type_i,
+                                unsigned int type_j,
+                                Scalar charge_i,
+                                Scalar charge_j,
+                                Scalar& force_divr);
+
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __PAIR_JIT_ABI_H__
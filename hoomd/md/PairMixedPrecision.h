@@ -0,0 +1,103 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_MIXED_PRECISION_H__
+#define __PAIR_MIXED_PRECISION_H__
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file PairMixedPrecision.h
+    \brief Selects between the full and single precision evaluation of pair evaluators
+
+    Evaluators opt in to mixed precision by implementing
+
+        bool evalForceAndEnergyFloat(float& force_divr, float& pair_eng, bool energy_shift)
+
+    with the same contract as evalForceAndEnergy(). PotentialPair computes the pair distance from
+    the full precision positions and accumulates forces, energies, and virials in Scalar, so only
+    the evaluation of the potential itself is performed in single precision.
+*/
+
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace detail
+    {
+//! Test whether an evaluator implements evalForceAndEnergyFloat()
+template<class evaluator> class supports_mixed_precision
+    {
+    template<class T> static char test(decltype(&T::evalForceAndEnergyFloat));
+    template<class T> static long test(...);
+
+    public:
+    static const bool value = sizeof(test<evaluator>(nullptr)) == sizeof(char);
+    };
+
+//! Evaluate the force and energy of a pair in full precision
+template<class evaluator, bool mixed = supports_mixed_precision<evaluator>::value>
+struct MixedPrecisionEval
+    {
+    HOSTDEVICE static bool
+    eval(evaluator& eval, Scalar& force_divr, Scalar& pair_eng, bool energy_shift, bool)
+        {
+        return eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+        }
+    };
+
+//! Evaluate the force and energy of a pair in single precision when requested
+template<class evaluator> struct MixedPrecisionEval<evaluator, true>
+    {
+    HOSTDEVICE static bool eval(evaluator& eval,
+                                Scalar& force_divr,
+                                Scalar& pair_eng,
+                                bool energy_shift,
+                                bool mixed_precision)
+        {
+        if (!mixed_precision)
+            return eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+
+        float force_divr_f = float(force_divr);
+        float pair_eng_f = float(pair_eng);
+        bool evaluated = eval.evalForceAndEnergyFloat(force_divr_f, pair_eng_f, energy_shift);
+        force_divr = Scalar(force_divr_f);
+        pair_eng = Scalar(pair_eng_f);
+        return evaluated;
+        }
+    };
+
+//! Evaluate the force and energy of a pair
+/*! \param eval Evaluator constructed for the pair
+    \param force_divr Output parameter to write the computed force divided by r
+    \param pair_eng Output parameter to write the computed pair energy
+    \param energy_shift If true, the potential is shifted so that V(r) is continuous at the cutoff
+    \param mixed_precision If true, evaluate in single precision when the evaluator supports it
+    \returns The return value of the evaluator
+*/
+template<class evaluator>
+HOSTDEVICE inline bool eval_force_and_energy(evaluator& eval,
+                                             Scalar& force_divr,
+                                             Scalar& pair_eng,
+                                             bool energy_shift,
+                                             bool mixed_precision)
+    {
+    return MixedPrecisionEval<evaluator>::eval(eval,
+                                               force_divr,
+                                               pair_eng,
+                                               energy_shift,
+                                               mixed_precision);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __PAIR_MIXED_PRECISION_H__
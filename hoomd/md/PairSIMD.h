@@ -0,0 +1,128 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_SIMD_H__
+#define __PAIR_SIMD_H__
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file PairSIMD.h
+    \brief Evaluates batches of neighbors with SIMD instructions in the CPU pair potentials
+
+    Evaluators opt in to batched evaluation by implementing
+
+        void evalForceAndEnergyMasked(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+
+    which computes the same quantities as evalForceAndEnergy() without branches. Pairs that
+    evalForceAndEnergy() would skip (beyond the cutoff or with zero parameters) must produce zero
+    force and energy instead of returning false. PotentialPair gathers PAIR_SIMD_WIDTH neighbors of
+    a particle, evaluates them in one loop that the compiler vectorizes, and then accumulates the
+    forces. Lanes past the last neighbor are masked by setting rsq to rcutsq. The XPLOR shift mode
+    and mixed precision use the scalar path.
+
+    GCC if-converts the masked selects only without trapping math, see hoomd/md/CMakeLists.txt.
+    Evaluators that call fast::exp() vectorize only when a vector math library is available to the
+    compiler.
+
+    The batch width matches the vector registers of the instruction set the code is compiled for:
+    AVX-512, AVX, SSE2, or NEON (ARM). Builds for other instruction sets fall back to the scalar
+    path.
+*/
+
+// the width of the vector registers in bytes
+#if defined(__AVX512F__)
+#define HOOMD_SIMD_BYTES 64
+#elif defined(__AVX__)
+#define HOOMD_SIMD_BYTES 32
+#elif defined(__SSE2__) || defined(__ARM_NEON)
+#define HOOMD_SIMD_BYTES 16
+#else
+#define HOOMD_SIMD_BYTES 0
+#endif
+
+// ask the compiler to vectorize the following loop
+#if defined(__clang__)
+#define HOOMD_SIMD_LOOP _Pragma("clang loop vectorize(enable) interleave(enable)")
+#elif defined(__GNUC__)
+#define HOOMD_SIMD_LOOP _Pragma("GCC ivdep")
+#else
+#define HOOMD_SIMD_LOOP
+#endif
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace detail
+    {
+//! Number of neighbors evaluated in one batch
+const unsigned int PAIR_SIMD_WIDTH
+    = HOOMD_SIMD_BYTES > 0 ? (unsigned int)(HOOMD_SIMD_BYTES / sizeof(Scalar)) : 1;
+
+//! Test whether an evaluator implements evalForceAndEnergyMasked()
+template<class evaluator> class supports_simd
+    {
+    template<class T> static char test(decltype(&T::evalForceAndEnergyMasked));
+    template<class T> static long test(...);
+
+    public:
+    static const bool value = sizeof(test<evaluator>(nullptr)) == sizeof(char);
+    };
+
+//! Evaluators without evalForceAndEnergyMasked() use the scalar path
+template<class evaluator, bool simd = supports_simd<evaluator>::value> struct SIMDEval
+    {
+    static const bool enabled = false;
+
+    static void eval(const Scalar*,
+                     const Scalar*,
+                     const typename evaluator::param_type* const*,
+                     bool,
+                     Scalar*,
+                     Scalar*)
+        {
+        }
+    };
+
+//! Evaluate a batch of PAIR_SIMD_WIDTH pairs
+template<class evaluator> struct SIMDEval<evaluator, true>
+    {
+    static const bool enabled = PAIR_SIMD_WIDTH > 1;
+
+    /*! \param rsq Squared distances of the pairs
+        \param rcutsq Squared cutoffs of the pairs
+        \param params Parameters of the pairs
+        \param energy_shift If true, shift the energies so that V(r) is continuous at the cutoff
+        \param force_divr Output forces divided by r
+        \param pair_eng Output pair energies
+    */
+    static inline void eval(const Scalar* rsq,
+                            const Scalar* rcutsq,
+                            const typename evaluator::param_type* const* params,
+                            bool energy_shift,
+                            Scalar* force_divr,
+                            Scalar* pair_eng)
+        {
+        // copy the parameters so that the vectorized loop reads them with strided loads
+        typename evaluator::param_type batch_params[PAIR_SIMD_WIDTH];
+        for (unsigned int l = 0; l < PAIR_SIMD_WIDTH; l++)
+            batch_params[l] = *params[l];
+
+        HOOMD_SIMD_LOOP
+        for (unsigned int l = 0; l < PAIR_SIMD_WIDTH; l++)
+            {
+            evaluator eval(rsq[l], rcutsq[l], batch_params[l]);
+            eval.evalForceAndEnergyMasked(force_divr[l], pair_eng[l], energy_shift);
+            }
+        }
+    };
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __PAIR_SIMD_H__
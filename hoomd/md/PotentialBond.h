@@ -47,6 +47,12 @@ template<class evaluator> class PotentialBond : public ForceCompute
     /// Get the parameters
     pybind11::dict getParams(std::string type);
 
+    /// Get the per-type parameter array
+    const GPUArray<param_type>& getParamArray() const
+        {
+        return m_params;
+        }
+
     /// Validate bond type
     virtual void validateType(unsigned int type, std::string action);
 
@@ -55,6 +61,15 @@ template<class evaluator> class PotentialBond : public ForceCompute
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
 #endif
 
+    //! Bond potentials read the particle and bond data, box, and parameters and write only their
+    //! forces
+    virtual DataDependencies getDataDependencies()
+        {
+        return DataDependencies(data_dependency::particles | data_dependency::bonded
+                                    | data_dependency::box | data_dependency::parameters,
+                                data_dependency::none);
+        }
+
     protected:
     GPUArray<param_type> m_params;         //!< Bond parameters per type
     std::shared_ptr<BondData> m_bond_data; //!< Bond data to use in computing bonds
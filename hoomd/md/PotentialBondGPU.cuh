@@ -43,11 +43,13 @@ struct bond_args_t
                 const Index2D& _gpu_table_indexer,
                 const unsigned int* _d_gpu_n_bonds,
                 const unsigned int _n_bond_types,
-                const unsigned int _block_size)
+                const unsigned int _block_size,
+                const hipStream_t _stream = 0)
         : d_force(_d_force), d_virial(_d_virial), virial_pitch(_virial_pitch), N(_N), n_max(_n_max),
           d_pos(_d_pos), d_charge(_d_charge), d_diameter(_d_diameter), box(_box),
           d_gpu_bondlist(_d_gpu_bondlist), gpu_table_indexer(_gpu_table_indexer),
-          d_gpu_n_bonds(_d_gpu_n_bonds), n_bond_types(_n_bond_types), block_size(_block_size) {};
+          d_gpu_n_bonds(_d_gpu_n_bonds), n_bond_types(_n_bond_types), block_size(_block_size),
+          stream(_stream) {};
 
     Scalar4* d_force;                       //!< Force to write out
     Scalar* d_virial;                       //!< Virial to write out
@@ -63,6 +65,7 @@ struct bond_args_t
     const unsigned int* d_gpu_n_bonds;      //!< List of number of bonds stored on the GPU
     const unsigned int n_bond_types;        //!< Number of bond types in the simulation
     const unsigned int block_size;          //!< Block size to execute
+    const hipStream_t stream;               //!< Stream to launch the kernel on
     };
 
 #ifdef __HIPCC__
@@ -273,7 +276,7 @@ hipError_t gpu_compute_bond_forces(const kernel::bond_args_t& bond_args,
                        grid,
                        threads,
                        shared_bytes,
-                       0,
+                       bond_args.stream,
                        bond_args.d_force,
                        bond_args.d_virial,
                        bond_args.virial_pitch,
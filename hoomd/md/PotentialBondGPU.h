@@ -148,6 +148,7 @@ void PotentialBondGPU<evaluator, gpu_cgbf>::computeForces(uint64_t timestep)
         ArrayHandle<unsigned int> d_flags(m_flags, access_location::device, access_mode::readwrite);
 
         this->m_tuner->begin();
+        this->waitDefaultStream();
         gpu_cgbf(kernel::bond_args_t(d_force.data,
                                      d_virial.data,
                                      this->m_virial.getPitch(),
@@ -161,7 +162,8 @@ void PotentialBondGPU<evaluator, gpu_cgbf>::computeForces(uint64_t timestep)
                                      gpu_table_indexer,
                                      d_gpu_n_bonds.data,
                                      this->m_bond_data->getNTypes(),
-                                     this->m_tuner->getParam()),
+                                     this->m_tuner->getParam(),
+                                     this->m_stream),
                  d_params.data,
                  d_flags.data);
         }
@@ -55,12 +55,28 @@ template<class evaluator> class PotentialExternal : public ForceCompute
     //! set the field type of the evaluator
     void setField(field_type field);
 
+    //! External fields add their forces directly to the net force
+    virtual bool addsToNetForce()
+        {
+        return true;
+        }
+
+    //! Add the forces directly to the net force
+    virtual void addToNetForce(uint64_t timestep, Scalar scale);
+
     protected:
     GPUArray<param_type> m_params; //!< Array of per-type parameters
     GPUArray<field_type> m_field;
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
+
+    //! Evaluate the field for all particles
+    void evaluateForces(Scalar4* h_force,
+                        Scalar* h_virial,
+                        size_t virial_pitch,
+                        Scalar scale,
+                        bool accumulate);
     };
 
 /*! Constructor
@@ -89,12 +105,56 @@ template<class evaluator> void PotentialExternal<evaluator>::computeForces(uint6
     if (m_prof)
         m_prof->push("PotentialExternal");
 
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+
+    // Zero data for force calculation.
+    memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+
+    evaluateForces(h_force.data, h_virial.data, m_virial_pitch, Scalar(1.0), false);
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param timestep Current timestep
+    \param scale Factor that scales the force
+*/
+template<class evaluator>
+void PotentialExternal<evaluator>::addToNetForce(uint64_t timestep, Scalar scale)
+    {
+    if (m_prof)
+        m_prof->push("PotentialExternal");
+
+    const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
+    ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(),
+                                     access_location::host,
+                                     access_mode::readwrite);
+    ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::readwrite);
+
+    evaluateForces(h_net_force.data, h_net_virial.data, net_virial.getPitch(), scale, true);
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param h_force Output forces and energies
+    \param h_virial Output virials
+    \param virial_pitch Pitch of \a h_virial
+    \param scale Factor that scales the force, when accumulating
+    \param accumulate When true, add to \a h_force and \a h_virial instead of overwriting them
+*/
+template<class evaluator>
+void PotentialExternal<evaluator>::evaluateForces(Scalar4* h_force,
+                                                  Scalar* h_virial,
+                                                  size_t virial_pitch,
+                                                  Scalar scale,
+                                                  bool accumulate)
+    {
     assert(m_pdata);
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-
-    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
                                    access_location::host,
                                    access_mode::read);
@@ -120,13 +180,9 @@ template<class evaluator> void PotentialExternal<evaluator>::computeForces(uint6
 
     unsigned int nparticles = m_pdata->getN();
 
-    // Zero data for force calculation.
-    memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
-    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
-
     // there are enough other checks on the input data: but it doesn't hurt to be safe
-    assert(h_force.data);
-    assert(h_virial.data);
+    assert(h_force);
+    assert(h_virial);
 
     // for each of the particles
     for (unsigned int idx = 0; idx < nparticles; idx++)
@@ -154,16 +210,25 @@ template<class evaluator> void PotentialExternal<evaluator>::computeForces(uint6
         eval.evalForceEnergyAndVirial(F, energy, virial);
 
         // apply the constraint force
-        h_force.data[idx].x = F.x;
-        h_force.data[idx].y = F.y;
-        h_force.data[idx].z = F.z;
-        h_force.data[idx].w = energy;
-        for (int k = 0; k < 6; k++)
-            h_virial.data[k * m_virial_pitch + idx] = virial[k];
+        if (accumulate)
+            {
+            h_force[idx].x += scale * F.x;
+            h_force[idx].y += scale * F.y;
+            h_force[idx].z += scale * F.z;
+            h_force[idx].w += energy;
+            for (int k = 0; k < 6; k++)
+                h_virial[k * virial_pitch + idx] += virial[k];
+            }
+        else
+            {
+            h_force[idx].x = F.x;
+            h_force[idx].y = F.y;
+            h_force[idx].z = F.z;
+            h_force[idx].w = energy;
+            for (int k = 0; k < 6; k++)
+                h_virial[k * virial_pitch + idx] = virial[k];
+            }
         }
-
-    if (m_prof)
-        m_prof->pop();
     }
 
 template<class evaluator>
@@ -34,9 +34,12 @@ struct external_potential_args_t
                               const Scalar* _d_diameter,
                               const Scalar* _d_charge,
                               const BoxDim& _box,
-                              const unsigned int _block_size)
+                              const unsigned int _block_size,
+                              const Scalar _scale = Scalar(1.0),
+                              const bool _accumulate = false)
         : d_force(_d_force), d_virial(_d_virial), virial_pitch(_virial_pitch), box(_box), N(_N),
-          d_pos(_d_pos), d_diameter(_d_diameter), d_charge(_d_charge), block_size(_block_size) {};
+          d_pos(_d_pos), d_diameter(_d_diameter), d_charge(_d_charge), block_size(_block_size),
+          scale(_scale), accumulate(_accumulate) {};
 
     Scalar4* d_force;              //!< Force to write out
     Scalar* d_virial;              //!< Virial to write out
@@ -47,6 +50,8 @@ struct external_potential_args_t
     const Scalar* d_diameter;      //!< particle diameters
     const Scalar* d_charge;        //!< particle charges
     const unsigned int block_size; //!< Block size to execute
+    const Scalar scale;            //!< Factor that scales the force, when accumulating
+    const bool accumulate;         //!< Add to d_force and d_virial instead of overwriting them
     };
 
 //! Driver function for compute external field kernel
@@ -74,6 +79,8 @@ gpu_cpef(const kernel::external_potential_args_t& external_potential_args,
     \param d_pos device array of particle positions
     \param box Box dimensions used to implement periodic boundary conditions
     \param params per-type array of parameters for the potential
+    \param scale Factor that scales the force, when accumulating
+    \param accumulate When true, add to \a d_force and \a d_virial instead of overwriting them
 
 */
 template<class evaluator>
@@ -86,7 +93,9 @@ __global__ void gpu_compute_external_forces_kernel(Scalar4* d_force,
                                                    const Scalar* d_charge,
                                                    const BoxDim box,
                                                    const typename evaluator::param_type* params,
-                                                   const typename evaluator::field_type* d_field)
+                                                   const typename evaluator::field_type* d_field,
+                                                   const Scalar scale,
+                                                   const bool accumulate)
     {
     // start by identifying which particle we are to handle
     unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -149,13 +158,28 @@ __global__ void gpu_compute_external_forces_kernel(Scalar4* d_force,
     eval.evalForceEnergyAndVirial(force, energy, virial);
 
     // now that the force calculation is complete, write out the result)
-    d_force[idx].x = force.x;
-    d_force[idx].y = force.y;
-    d_force[idx].z = force.z;
-    d_force[idx].w = energy;
+    if (accumulate)
+        {
+        Scalar4 net_force = d_force[idx];
+        net_force.x += scale * force.x;
+        net_force.y += scale * force.y;
+        net_force.z += scale * force.z;
+        net_force.w += energy;
+        d_force[idx] = net_force;
+
+        for (unsigned int k = 0; k < 6; k++)
+            d_virial[k * virial_pitch + idx] += virial[k];
+        }
+    else
+        {
+        d_force[idx].x = force.x;
+        d_force[idx].y = force.y;
+        d_force[idx].z = force.z;
+        d_force[idx].w = energy;
 
-    for (unsigned int k = 0; k < 6; k++)
-        d_virial[k * virial_pitch + idx] = virial[k];
+        for (unsigned int k = 0; k < 6; k++)
+            d_virial[k * virial_pitch + idx] = virial[k];
+        }
     }
 
 /*!
@@ -196,7 +220,9 @@ hipError_t gpu_cpef(const kernel::external_potential_args_t& external_potential_
                        external_potential_args.d_charge,
                        external_potential_args.box,
                        d_params,
-                       d_field);
+                       d_field,
+                       external_potential_args.scale,
+                       external_potential_args.accumulate);
 
     return hipSuccess;
     };
@@ -45,10 +45,20 @@ template<class evaluator> class PotentialExternalGPU : public PotentialExternal<
         m_tuner->setEnabled(enable);
         }
 
+    //! Add the forces directly to the net force
+    virtual void addToNetForce(uint64_t timestep, Scalar scale);
+
     protected:
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
 
+    //! Evaluate the field for all particles on the GPU
+    void evaluateForcesGPU(Scalar4* d_force,
+                           Scalar* d_virial,
+                           size_t virial_pitch,
+                           Scalar scale,
+                           bool accumulate);
+
     std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
     };
 
@@ -78,6 +88,49 @@ template<class evaluator> void PotentialExternalGPU<evaluator>::computeForces(ui
     if (this->m_prof)
         this->m_prof->push(this->m_exec_conf, "PotentialExternalGPU");
 
+    ArrayHandle<Scalar4> d_force(this->m_force, access_location::device, access_mode::overwrite);
+    ArrayHandle<Scalar> d_virial(this->m_virial, access_location::device, access_mode::overwrite);
+
+    evaluateForcesGPU(d_force.data, d_virial.data, this->m_virial.getPitch(), Scalar(1.0), false);
+
+    if (this->m_prof)
+        this->m_prof->pop();
+    }
+
+/*! \param timestep Current timestep
+    \param scale Factor that scales the force
+*/
+template<class evaluator>
+void PotentialExternalGPU<evaluator>::addToNetForce(uint64_t timestep, Scalar scale)
+    {
+    if (this->m_prof)
+        this->m_prof->push(this->m_exec_conf, "PotentialExternalGPU");
+
+    const GlobalArray<Scalar>& net_virial = this->m_pdata->getNetVirial();
+    ArrayHandle<Scalar4> d_net_force(this->m_pdata->getNetForce(),
+                                     access_location::device,
+                                     access_mode::readwrite);
+    ArrayHandle<Scalar> d_net_virial(net_virial, access_location::device, access_mode::readwrite);
+
+    evaluateForcesGPU(d_net_force.data, d_net_virial.data, net_virial.getPitch(), scale, true);
+
+    if (this->m_prof)
+        this->m_prof->pop();
+    }
+
+/*! \param d_force Output forces and energies
+    \param d_virial Output virials
+    \param virial_pitch Pitch of \a d_virial
+    \param scale Factor that scales the force, when accumulating
+    \param accumulate When true, add to \a d_force and \a d_virial instead of overwriting them
+*/
+template<class evaluator>
+void PotentialExternalGPU<evaluator>::evaluateForcesGPU(Scalar4* d_force,
+                                                        Scalar* d_virial,
+                                                        size_t virial_pitch,
+                                                        Scalar scale,
+                                                        bool accumulate)
+    {
     // access the particle data
     ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(),
                                access_location::device,
@@ -91,8 +144,6 @@ template<class evaluator> void PotentialExternalGPU<evaluator>::computeForces(ui
 
     const BoxDim& box = this->m_pdata->getGlobalBox();
 
-    ArrayHandle<Scalar4> d_force(this->m_force, access_location::device, access_mode::overwrite);
-    ArrayHandle<Scalar> d_virial(this->m_virial, access_location::device, access_mode::overwrite);
     ArrayHandle<typename evaluator::param_type> d_params(this->m_params,
                                                          access_location::device,
                                                          access_mode::read);
@@ -104,15 +155,17 @@ template<class evaluator> void PotentialExternalGPU<evaluator>::computeForces(ui
     PDataFlags flags = this->m_pdata->getFlags();
 
     this->m_tuner->begin();
-    kernel::gpu_cpef<evaluator>(kernel::external_potential_args_t(d_force.data,
-                                                                  d_virial.data,
-                                                                  this->m_virial.getPitch(),
+    kernel::gpu_cpef<evaluator>(kernel::external_potential_args_t(d_force,
+                                                                  d_virial,
+                                                                  virial_pitch,
                                                                   this->m_pdata->getN(),
                                                                   d_pos.data,
                                                                   d_diameter.data,
                                                                   d_charge.data,
                                                                   box,
-                                                                  this->m_tuner->getParam()),
+                                                                  this->m_tuner->getParam(),
+                                                                  scale,
+                                                                  accumulate),
                                 d_params.data,
                                 d_field.data);
 
@@ -121,9 +174,6 @@ template<class evaluator> void PotentialExternalGPU<evaluator>::computeForces(ui
 
     this->m_tuner->end();
 
-    if (this->m_prof)
-        this->m_prof->pop();
-
     if (flags[pdata_flag::external_field_virial])
         {
         bool virial_terms_defined = evaluator::requestFieldVirialTerm();
@@ -6,13 +6,20 @@
 #ifndef __POTENTIAL_PAIR_H__
 #define __POTENTIAL_PAIR_H__
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <stdexcept>
+#include <tuple>
+#include <vector>
 
 #include "NeighborList.h"
+#include "NeighborListCompression.h"
+#include "PairMixedPrecision.h"
+#include "PairSIMD.h"
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GSDShapeSpecWriter.h"
 #include "hoomd/GlobalArray.h"
@@ -29,6 +36,12 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 /*! \file PotentialPair.h
     \brief Defines the template class for standard pair potentials
     \details The heart of the code that computes pair potentials is in this file.
@@ -102,6 +115,8 @@ template<class evaluator> class PotentialPair : public ForceCompute
     //! Set and get the pair parameters for a single type pair
     virtual void setParams(unsigned int typ1, unsigned int typ2, const param_type& param);
     virtual void setParamsPython(pybind11::tuple typ, pybind11::dict params);
+    /// Set the params for many type pairs using a dict that maps tuples of strings to params
+    virtual void setParamsBatchPython(pybind11::dict params);
     /// Get params for a single type pair using a tuple of strings
     virtual pybind11::dict getParams(pybind11::tuple typ);
     //! Set the rcut for a single type pair
@@ -110,6 +125,8 @@ template<class evaluator> class PotentialPair : public ForceCompute
     Scalar getRCut(pybind11::tuple types);
     /// Set the rcut for a single type pair using a tuple of strings
     virtual void setRCutPython(pybind11::tuple types, Scalar r_cut);
+    /// Set the rcut for many type pairs using a dict that maps tuples of strings to r_cut
+    virtual void setRCutBatchPython(pybind11::dict r_cuts);
     //! Set ron for a single type pair
     virtual void setRon(unsigned int typ1, unsigned int typ2, Scalar ron);
     /// Get the r_on for a single type pair
@@ -173,6 +190,28 @@ template<class evaluator> class PotentialPair : public ForceCompute
             }
         }
 
+    //! Set whether the potential is evaluated in single precision
+    /*! \param mixed_precision true to evaluate the potential in single precision
+
+        Distances, forces, energies, and virials remain in Scalar precision. Only evaluators that
+        implement evalForceAndEnergyFloat() support mixed precision, see PairMixedPrecision.h.
+    */
+    void setMixedPrecision(bool mixed_precision)
+        {
+        if (mixed_precision && !detail::supports_mixed_precision<evaluator>::value)
+            {
+            throw std::invalid_argument("pair." + evaluator::getName()
+                                        + " does not support mixed precision.");
+            }
+        m_mixed_precision = mixed_precision;
+        }
+
+    //! Get whether the potential is evaluated in single precision
+    bool getMixedPrecision()
+        {
+        return m_mixed_precision;
+        }
+
     virtual void notifyDetach()
         {
         if (m_attached)
@@ -187,6 +226,14 @@ template<class evaluator> class PotentialPair : public ForceCompute
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
 #endif
 
+    //! Pair potentials read the particle data, box, and parameters and write only their forces
+    virtual DataDependencies getDataDependencies()
+        {
+        return DataDependencies(data_dependency::particles | data_dependency::box
+                                    | data_dependency::parameters,
+                                data_dependency::none);
+        }
+
     //! Calculates the energy between two lists of particles.
     template<class InputIterator>
     void computeEnergyBetweenSets(InputIterator first1,
@@ -199,6 +246,13 @@ template<class evaluator> class PotentialPair : public ForceCompute
     computeEnergyBetweenSetsPythonList(pybind11::array_t<int, pybind11::array::c_style> tags1,
                                        pybind11::array_t<int, pybind11::array::c_style> tags2);
 
+    //! Tabulate the potential for a tabulated pair potential
+    static pybind11::dict tabulatePython(pybind11::dict params,
+                                         Scalar r_min,
+                                         Scalar r_cut,
+                                         unsigned int width,
+                                         bool energy_shift);
+
     std::vector<std::string> getTypeShapeMapping() const
         {
         std::vector<std::string> type_shape_mapping(m_pdata->getNTypes());
@@ -221,19 +275,45 @@ template<class evaluator> class PotentialPair : public ForceCompute
     std::vector<param_type, hoomd::detail::managed_allocator<param_type>> m_params;
     std::string m_prof_name; //!< Cached profiler name
 
+    bool m_mixed_precision = false; //!< True when the potential is evaluated in single precision
+
+    /// Type class of each particle type, see updateTypeClasses()
+    GlobalArray<unsigned int> m_type_class;
+    GlobalArray<Scalar> m_class_rcutsq; //!< Cutoff radius squared per type class pair
+    GlobalArray<Scalar> m_class_ronsq;  //!< ron squared per type class pair
+
+    /// Per type class pair potential parameters
+    std::vector<param_type, hoomd::detail::managed_allocator<param_type>> m_class_params;
+    unsigned int m_n_type_classes = 0;  //!< Number of type classes
+    bool m_type_classes_changed = true; //!< True when the type classes must be recomputed
+
     /// Track whether we have attached to the Simulation object
     bool m_attached = true;
 
     /// r_cut (not squared) given to the neighbor list
     std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;
 
+    /// Store r_cut for (typ1, typ2, r_cut) entries and notify the neighbor list of the changes
+    void storeRCuts(const std::vector<std::tuple<unsigned int, unsigned int, Scalar>>& r_cuts);
+
 #ifdef ENABLE_MPI
     /// The system's communicator.
     std::shared_ptr<Communicator> m_comm;
 #endif
 
+#ifdef ENABLE_TBB
+    /// Per-thread force accumulators used with a half neighbor list
+    tbb::enumerable_thread_specific<std::vector<Scalar4>> m_thread_force;
+
+    /// Per-thread virial accumulators used with a half neighbor list (pitch N)
+    tbb::enumerable_thread_specific<std::vector<Scalar>> m_thread_virial;
+#endif
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
+
+    //! Group the particle types with identical interactions into type classes
+    void updateTypeClasses();
     };
 
 /*! \param sysdef System to compute forces on
@@ -264,6 +344,9 @@ PotentialPair<evaluator>::PotentialPair(std::shared_ptr<SystemDefinition> sysdef
         = std::make_shared<GlobalArray<Scalar>>(m_typpair_idx.getNumElements(), m_exec_conf);
     nlist->addRCutMatrix(m_r_cut_nlist);
 
+    GlobalArray<unsigned int> type_class(m_pdata->getNTypes(), m_exec_conf);
+    m_type_class.swap(type_class);
+
 #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
     if (m_pdata->getExecConf()->isCUDAEnabled() && m_exec_conf->allConcurrentManagedAccess())
         {
@@ -337,6 +420,7 @@ void PotentialPair<evaluator>::setParams(unsigned int typ1,
     validateTypes(typ1, typ2, "setting params");
     m_params[m_typpair_idx(typ1, typ2)] = param;
     m_params[m_typpair_idx(typ2, typ1)] = param;
+    m_type_classes_changed = true;
     }
 
 template<class evaluator>
@@ -347,6 +431,19 @@ void PotentialPair<evaluator>::setParamsPython(pybind11::tuple typ, pybind11::di
     setParams(typ1, typ2, param_type(params, m_exec_conf->isCUDAEnabled()));
     }
 
+/*! \param params Dictionary that maps (type1, type2) tuples to parameter dictionaries
+
+    Sets all parameters with one call from Python.
+*/
+template<class evaluator> void PotentialPair<evaluator>::setParamsBatchPython(pybind11::dict params)
+    {
+    for (auto item : params)
+        {
+        setParamsPython(pybind11::cast<pybind11::tuple>(item.first),
+                        pybind11::cast<pybind11::dict>(item.second));
+        }
+    }
+
 template<class evaluator> pybind11::dict PotentialPair<evaluator>::getParams(pybind11::tuple typ)
     {
     auto typ1 = m_pdata->getTypeByName(typ[0].cast<std::string>());
@@ -378,22 +475,64 @@ template<class evaluator>
 void PotentialPair<evaluator>::setRcut(unsigned int typ1, unsigned int typ2, Scalar rcut)
     {
     validateTypes(typ1, typ2, "setting r_cut");
+    storeRCuts({std::make_tuple(typ1, typ2, rcut)});
+    }
+
+/*! \param r_cuts (typ1, typ2, r_cut) entries to set
+
+    Unchanged values leave the arrays untouched, so they are not copied to the device again. The
+    neighbor list must only rebuild when a cutoff grows: the current list remains a valid superset
+    of the neighbors within smaller cutoffs.
+*/
+template<class evaluator>
+void PotentialPair<evaluator>::storeRCuts(
+    const std::vector<std::tuple<unsigned int, unsigned int, Scalar>>& r_cuts)
+    {
+    bool changed = false;
+    bool grew = false;
         {
-        // store r_cut**2 for use internally
-        ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::readwrite);
-        h_rcutsq.data[m_typpair_idx(typ1, typ2)] = rcut * rcut;
-        h_rcutsq.data[m_typpair_idx(typ2, typ1)] = rcut * rcut;
+        ArrayHandle<Scalar> h_r_cut_nlist(*m_r_cut_nlist,
+                                          access_location::host,
+                                          access_mode::read);
+        for (const auto& entry : r_cuts)
+            {
+            Scalar old_rcut = h_r_cut_nlist.data[m_typpair_idx(std::get<0>(entry),
+                                                               std::get<1>(entry))];
+            changed = changed || std::get<2>(entry) != old_rcut;
+            grew = grew || std::get<2>(entry) > old_rcut;
+            }
+        }
+
+    if (!changed)
+        return;
 
-        // store r_cut unmodified for so the neighbor list knows what particles to include
+        {
+        ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::readwrite);
         ArrayHandle<Scalar> h_r_cut_nlist(*m_r_cut_nlist,
                                           access_location::host,
                                           access_mode::readwrite);
-        h_r_cut_nlist.data[m_typpair_idx(typ1, typ2)] = rcut;
-        h_r_cut_nlist.data[m_typpair_idx(typ2, typ1)] = rcut;
+        for (const auto& entry : r_cuts)
+            {
+            unsigned int typ1 = std::get<0>(entry);
+            unsigned int typ2 = std::get<1>(entry);
+            Scalar rcut = std::get<2>(entry);
+
+            // store r_cut**2 for use internally
+            h_rcutsq.data[m_typpair_idx(typ1, typ2)] = rcut * rcut;
+            h_rcutsq.data[m_typpair_idx(typ2, typ1)] = rcut * rcut;
+
+            // store r_cut unmodified for so the neighbor list knows what particles to include
+            h_r_cut_nlist.data[m_typpair_idx(typ1, typ2)] = rcut;
+            h_r_cut_nlist.data[m_typpair_idx(typ2, typ1)] = rcut;
+            }
         }
+    m_type_classes_changed = true;
 
     // notify the neighbor list that we have changed r_cut values
-    m_nlist->notifyRCutMatrixChange();
+    if (grew)
+        m_nlist->notifyRCutMatrixChange();
+    else
+        m_nlist->notifyRCutMatrixShrink();
     }
 
 template<class evaluator>
@@ -404,6 +543,24 @@ void PotentialPair<evaluator>::setRCutPython(pybind11::tuple types, Scalar r_cut
     setRcut(typ1, typ2, r_cut);
     }
 
+/*! \param r_cuts Dictionary that maps (type1, type2) tuples to r_cut values
+
+    Notifies the neighbor list once for all type pairs.
+*/
+template<class evaluator> void PotentialPair<evaluator>::setRCutBatchPython(pybind11::dict r_cuts)
+    {
+    std::vector<std::tuple<unsigned int, unsigned int, Scalar>> entries;
+    for (auto item : r_cuts)
+        {
+        auto types = pybind11::cast<pybind11::tuple>(item.first);
+        auto typ1 = m_pdata->getTypeByName(types[0].cast<std::string>());
+        auto typ2 = m_pdata->getTypeByName(types[1].cast<std::string>());
+        validateTypes(typ1, typ2, "setting r_cut");
+        entries.push_back(std::make_tuple(typ1, typ2, item.second.cast<Scalar>()));
+        }
+    storeRCuts(entries);
+    }
+
 template<class evaluator> Scalar PotentialPair<evaluator>::getRCut(pybind11::tuple types)
     {
     auto typ1 = m_pdata->getTypeByName(types[0].cast<std::string>());
@@ -426,6 +583,7 @@ void PotentialPair<evaluator>::setRon(unsigned int typ1, unsigned int typ2, Scal
     ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::readwrite);
     h_ronsq.data[m_typpair_idx(typ1, typ2)] = ron * ron;
     h_ronsq.data[m_typpair_idx(typ2, typ1)] = ron * ron;
+    m_type_classes_changed = true;
     }
 
 template<class evaluator> Scalar PotentialPair<evaluator>::getROn(pybind11::tuple types)
@@ -465,6 +623,89 @@ int PotentialPair<evaluator>::slotWriteGSDShapeSpec(gsd_handle& handle) const
     return retval;
     }
 
+/*! Two particle types belong to the same type class when their rows of m_params, m_rcutsq, and
+    m_ronsq are identical, so every interaction can be computed from the per type class pair arrays
+    m_class_params, m_class_rcutsq, and m_class_ronsq indexed by the class of each type. Models with
+    many particle types and few distinct interactions have far fewer type classes than types, so
+    the class arrays fit in the shared memory of the GPU kernels.
+
+    Parameters are compared bytewise, so parameters that compare unequal only in their padding or in
+    distinct managed arrays with the same contents put the types in different classes. This never
+    changes the computed forces.
+*/
+template<class evaluator> void PotentialPair<evaluator>::updateTypeClasses()
+    {
+    if (!m_type_classes_changed)
+        return;
+
+    const unsigned int ntypes = m_pdata->getNTypes();
+    ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
+
+    // test if the interactions of types a and b with every other type are identical
+    auto same_row = [&](unsigned int a, unsigned int b)
+    {
+        for (unsigned int t = 0; t < ntypes; ++t)
+            {
+            unsigned int at = m_typpair_idx(a, t);
+            unsigned int bt = m_typpair_idx(b, t);
+            if (h_rcutsq.data[at] != h_rcutsq.data[bt] || h_ronsq.data[at] != h_ronsq.data[bt]
+                || memcmp(&m_params[at], &m_params[bt], sizeof(param_type)) != 0)
+                return false;
+            }
+        return true;
+    };
+
+    // assign each type to the class of the first type with identical interactions
+    std::vector<unsigned int> class_type;
+    ArrayHandle<unsigned int> h_type_class(m_type_class,
+                                           access_location::host,
+                                           access_mode::overwrite);
+    for (unsigned int a = 0; a < ntypes; ++a)
+        {
+        unsigned int cur_class = 0;
+        while (cur_class < class_type.size() && !same_row(a, class_type[cur_class]))
+            cur_class++;
+
+        if (cur_class == class_type.size())
+            class_type.push_back(a);
+        h_type_class.data[a] = cur_class;
+        }
+
+    // build the per type class pair arrays from the representative type of each class
+    m_n_type_classes = static_cast<unsigned int>(class_type.size());
+    Index2D class_pair_idx(m_n_type_classes);
+
+    GlobalArray<Scalar> class_rcutsq(class_pair_idx.getNumElements(), m_exec_conf);
+    m_class_rcutsq.swap(class_rcutsq);
+    GlobalArray<Scalar> class_ronsq(class_pair_idx.getNumElements(), m_exec_conf);
+    m_class_ronsq.swap(class_ronsq);
+    m_class_params = std::vector<param_type, hoomd::detail::managed_allocator<param_type>>(
+        class_pair_idx.getNumElements(),
+        param_type(),
+        hoomd::detail::managed_allocator<param_type>(m_exec_conf->isCUDAEnabled()));
+
+    ArrayHandle<Scalar> h_class_rcutsq(m_class_rcutsq,
+                                       access_location::host,
+                                       access_mode::overwrite);
+    ArrayHandle<Scalar> h_class_ronsq(m_class_ronsq, access_location::host, access_mode::overwrite);
+    for (unsigned int i = 0; i < m_n_type_classes; ++i)
+        {
+        for (unsigned int j = 0; j < m_n_type_classes; ++j)
+            {
+            unsigned int typpair = m_typpair_idx(class_type[i], class_type[j]);
+            h_class_rcutsq.data[class_pair_idx(i, j)] = h_rcutsq.data[typpair];
+            h_class_ronsq.data[class_pair_idx(i, j)] = h_ronsq.data[typpair];
+            m_class_params[class_pair_idx(i, j)] = m_params[typpair];
+            }
+        }
+
+    m_exec_conf->msg->notice(7) << "PotentialPair<" << evaluator::getName() << ">: "
+                                << m_n_type_classes << " type classes for " << ntypes << " types"
+                                << std::endl;
+    m_type_classes_changed = false;
+    }
+
 /*! \post The pair forces are computed for the given timestep. The neighborlist's compute method is
    called to ensure that it is up to date before proceeding.
 
@@ -487,9 +728,13 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
     ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
                                         access_location::host,
                                         access_mode::read);
-    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getCompressedNListArray(),
                                       access_location::host,
                                       access_mode::read);
+    const bool compress = m_nlist->getCompress();
+    ArrayHandle<unsigned int> h_n_outliers(m_nlist->getNOutliersArray(),
+                                           access_location::host,
+                                           access_mode::read);
     //     Index2D nli = m_nlist->getNListIndexer();
     ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
                                     access_location::host,
@@ -512,13 +757,16 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor];
 
+    const unsigned int N = m_pdata->getN();
+
     // need to start from a zero force, energy and virial
     memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
     memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
 
-    // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
-        {
+    // compute the forces on particle i, accumulating into the given force and virial arrays
+    auto compute_particle_forces
+        = [&](unsigned int i, Scalar4* force, Scalar* virial, size_t virial_pitch)
+    {
         // access the particle's position and type (MEM TRANSFER: 4 scalars)
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         unsigned int typei = __scalar_as_int(h_pos.data[i].w);
@@ -544,151 +792,320 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
         Scalar virialyzi = 0.0;
         Scalar virialzzi = 0.0;
 
-        // loop over all of the neighbors of this particle
-        const size_t myHead = h_head_list.data[i];
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int k = 0; k < size; k++)
-            {
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[myHead + k];
-            assert(j < m_pdata->getN() + m_pdata->getNGhosts());
-
-            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 dx = pi - pj;
-
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
-            assert(typej < m_pdata->getNTypes());
-
-            // access diameter and charge (if needed)
-            Scalar dj = Scalar(0.0);
-            Scalar qj = Scalar(0.0);
-            if (evaluator::needsDiameter())
-                dj = h_diameter.data[j];
-            if (evaluator::needsCharge())
-                qj = h_charge.data[j];
-
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
-            // calculate r_ij squared (FLOPS: 5)
-            Scalar rsq = dot(dx, dx);
-
-            // get parameters for this type pair
-            unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            param_type param = m_params[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
-            Scalar ronsq = Scalar(0.0);
+        // design specifies that energies are shifted if
+        // 1) shift mode is set to shift
+        // or 2) shift mode is explor and ron > rcut
+        auto get_energy_shift = [&](Scalar rcutsq, Scalar ronsq)
+        { return m_shift_mode == shift || (m_shift_mode == xplor && ronsq > rcutsq); };
+
+        // add the force, potential energy, and virial of an evaluated pair
+        auto accumulate_pair = [&](unsigned int j,
+                                   const Scalar3& dx,
+                                   Scalar rsq,
+                                   Scalar rcutsq,
+                                   Scalar ronsq,
+                                   Scalar force_divr,
+                                   Scalar pair_eng)
+        {
+            // modify the potential for xplor shifting
             if (m_shift_mode == xplor)
-                ronsq = h_ronsq.data[typpair_idx];
-
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            // or 2) shift mode is explor and ron > rcut
-            bool energy_shift = false;
-            if (m_shift_mode == shift)
-                energy_shift = true;
-            else if (m_shift_mode == xplor)
                 {
-                if (ronsq > rcutsq)
-                    energy_shift = true;
+                if (rsq >= ronsq && rsq < rcutsq)
+                    {
+                    // Implement XPLOR smoothing (FLOPS: 16)
+                    Scalar old_pair_eng = pair_eng;
+                    Scalar old_force_divr = force_divr;
+
+                    // calculate 1.0 / (xplor denominator)
+                    Scalar xplor_denom_inv
+                        = Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+
+                    Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+                    Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
+                               * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq)
+                               * xplor_denom_inv;
+                    Scalar ds_dr_divr
+                        = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+
+                    // make modifications to the old pair energy and force
+                    pair_eng = old_pair_eng * s;
+                    // note: I'm not sure why the minus sign needs to be there: my notes have a
+                    // + But this is verified correct via plotting
+                    force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+                    }
                 }
 
-            // compute the force and potential energy
-            Scalar force_divr = Scalar(0.0);
-            Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
-            if (evaluator::needsDiameter())
-                eval.setDiameter(di, dj);
-            if (evaluator::needsCharge())
-                eval.setCharge(qi, qj);
-
-            bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+            Scalar force_div2r = force_divr * Scalar(0.5);
+            // add the force, potential energy and virial to the particle i
+            // (FLOPS: 8)
+            fi += dx * force_divr;
+            pei += pair_eng * Scalar(0.5);
+            if (compute_virial)
+                {
+                virialxxi += force_div2r * dx.x * dx.x;
+                virialxyi += force_div2r * dx.x * dx.y;
+                virialxzi += force_div2r * dx.x * dx.z;
+                virialyyi += force_div2r * dx.y * dx.y;
+                virialyzi += force_div2r * dx.y * dx.z;
+                virialzzi += force_div2r * dx.z * dx.z;
+                }
 
-            if (evaluated)
+            // add the force to particle j if we are using the third law (MEM TRANSFER: 10
+            // scalars / FLOPS: 8) only add force to local particles
+            if (third_law && j < N)
                 {
-                // modify the potential for xplor shifting
-                if (m_shift_mode == xplor)
+                unsigned int mem_idx = j;
+                force[mem_idx].x -= dx.x * force_divr;
+                force[mem_idx].y -= dx.y * force_divr;
+                force[mem_idx].z -= dx.z * force_divr;
+                force[mem_idx].w += pair_eng * Scalar(0.5);
+                if (compute_virial)
                     {
-                    if (rsq >= ronsq && rsq < rcutsq)
-                        {
-                        // Implement XPLOR smoothing (FLOPS: 16)
-                        Scalar old_pair_eng = pair_eng;
-                        Scalar old_force_divr = force_divr;
+                    virial[0 * virial_pitch + mem_idx] += force_div2r * dx.x * dx.x;
+                    virial[1 * virial_pitch + mem_idx] += force_div2r * dx.x * dx.y;
+                    virial[2 * virial_pitch + mem_idx] += force_div2r * dx.x * dx.z;
+                    virial[3 * virial_pitch + mem_idx] += force_div2r * dx.y * dx.y;
+                    virial[4 * virial_pitch + mem_idx] += force_div2r * dx.y * dx.z;
+                    virial[5 * virial_pitch + mem_idx] += force_div2r * dx.z * dx.z;
+                    }
+                }
+        };
 
-                        // calculate 1.0 / (xplor denominator)
-                        Scalar xplor_denom_inv
-                            = Scalar(1.0)
-                              / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+        // loop over all of the neighbors of this particle
+        const size_t myHead = h_head_list.data[i];
+        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        const unsigned int n_outliers = compress ? h_n_outliers.data[i] : size;
 
-                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
-                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
-                                   * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq)
-                                   * xplor_denom_inv;
-                        Scalar ds_dr_divr
-                            = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+        if (detail::SIMDEval<evaluator>::enabled && !m_mixed_precision && m_shift_mode != xplor)
+            {
+            // evaluate the neighbors in batches, see PairSIMD.h
+            const unsigned int W = detail::PAIR_SIMD_WIDTH;
+            const bool energy_shift = m_shift_mode == shift;
+            unsigned int j_batch[W];
+            Scalar3 dx_batch[W];
+            Scalar rsq_batch[W];
+            Scalar rcutsq_batch[W];
+            const param_type* param_batch[W];
+            Scalar force_divr_batch[W];
+            Scalar pair_eng_batch[W];
+
+            for (unsigned int k0 = 0; k0 < size; k0 += W)
+                {
+                const unsigned int n_batch = std::min(W, size - k0);
 
-                        // make modifications to the old pair energy and force
-                        pair_eng = old_pair_eng * s;
-                        // note: I'm not sure why the minus sign needs to be there: my notes have a
-                        // + But this is verified correct via plotting
-                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
-                        }
+                // gather the pairs (MEM TRANSFER: 5 scalars per pair)
+                for (unsigned int l = 0; l < n_batch; l++)
+                    {
+                    unsigned int j
+                        = detail::nlist_get_neighbor(h_nlist.data + myHead, i, n_outliers, k0 + l);
+                    assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+
+                    Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                    Scalar3 dx = box.minImage(pi - pj);
+                    unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+                    assert(typej < m_pdata->getNTypes());
+
+                    unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                    j_batch[l] = j;
+                    dx_batch[l] = dx;
+                    rsq_batch[l] = dot(dx, dx);
+                    rcutsq_batch[l] = h_rcutsq.data[typpair_idx];
+                    param_batch[l] = &m_params[typpair_idx];
                     }
 
-                Scalar force_div2r = force_divr * Scalar(0.5);
-                // add the force, potential energy and virial to the particle i
-                // (FLOPS: 8)
-                fi += dx * force_divr;
-                pei += pair_eng * Scalar(0.5);
-                if (compute_virial)
+                // mask the unused lanes
+                for (unsigned int l = n_batch; l < W; l++)
                     {
-                    virialxxi += force_div2r * dx.x * dx.x;
-                    virialxyi += force_div2r * dx.x * dx.y;
-                    virialxzi += force_div2r * dx.x * dx.z;
-                    virialyyi += force_div2r * dx.y * dx.y;
-                    virialyzi += force_div2r * dx.y * dx.z;
-                    virialzzi += force_div2r * dx.z * dx.z;
+                    rsq_batch[l] = rcutsq_batch[0];
+                    rcutsq_batch[l] = rcutsq_batch[0];
+                    param_batch[l] = param_batch[0];
                     }
 
-                // add the force to particle j if we are using the third law (MEM TRANSFER: 10
-                // scalars / FLOPS: 8) only add force to local particles
-                if (third_law && j < m_pdata->getN())
+                // compute the forces and potential energies of the batch
+                detail::SIMDEval<evaluator>::eval(rsq_batch,
+                                                  rcutsq_batch,
+                                                  param_batch,
+                                                  energy_shift,
+                                                  force_divr_batch,
+                                                  pair_eng_batch);
+
+                for (unsigned int l = 0; l < n_batch; l++)
                     {
-                    unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x * force_divr;
-                    h_force.data[mem_idx].y -= dx.y * force_divr;
-                    h_force.data[mem_idx].z -= dx.z * force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
-                    if (compute_virial)
-                        {
-                        h_virial.data[0 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.x;
-                        h_virial.data[1 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.y;
-                        h_virial.data[2 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.z;
-                        h_virial.data[3 * m_virial_pitch + mem_idx] += force_div2r * dx.y * dx.y;
-                        h_virial.data[4 * m_virial_pitch + mem_idx] += force_div2r * dx.y * dx.z;
-                        h_virial.data[5 * m_virial_pitch + mem_idx] += force_div2r * dx.z * dx.z;
-                        }
+                    // pairs outside of the cutoff have no force or energy
+                    if (force_divr_batch[l] == Scalar(0.0) && pair_eng_batch[l] == Scalar(0.0))
+                        continue;
+
+                    accumulate_pair(j_batch[l],
+                                    dx_batch[l],
+                                    rsq_batch[l],
+                                    rcutsq_batch[l],
+                                    Scalar(0.0),
+                                    force_divr_batch[l],
+                                    pair_eng_batch[l]);
                     }
                 }
             }
+        else
+            {
+            for (unsigned int k = 0; k < size; k++)
+                {
+                // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+                unsigned int j
+                    = detail::nlist_get_neighbor(h_nlist.data + myHead, i, n_outliers, k);
+                assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+
+                // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                Scalar3 dx = pi - pj;
+
+                // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
+                unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+                assert(typej < m_pdata->getNTypes());
+
+                // access diameter and charge (if needed)
+                Scalar dj = Scalar(0.0);
+                Scalar qj = Scalar(0.0);
+                if (evaluator::needsDiameter())
+                    dj = h_diameter.data[j];
+                if (evaluator::needsCharge())
+                    qj = h_charge.data[j];
+
+                // apply periodic boundary conditions
+                dx = box.minImage(dx);
+
+                // calculate r_ij squared (FLOPS: 5)
+                Scalar rsq = dot(dx, dx);
+
+                // get parameters for this type pair
+                unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                param_type param = m_params[typpair_idx];
+                Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                Scalar ronsq = Scalar(0.0);
+                if (m_shift_mode == xplor)
+                    ronsq = h_ronsq.data[typpair_idx];
+
+                bool energy_shift = get_energy_shift(rcutsq, ronsq);
+
+                // compute the force and potential energy
+                Scalar force_divr = Scalar(0.0);
+                Scalar pair_eng = Scalar(0.0);
+                evaluator eval(rsq, rcutsq, param);
+                if (evaluator::needsDiameter())
+                    eval.setDiameter(di, dj);
+                if (evaluator::needsCharge())
+                    eval.setCharge(qi, qj);
+
+                bool evaluated = detail::eval_force_and_energy(eval,
+                                                               force_divr,
+                                                               pair_eng,
+                                                               energy_shift,
+                                                               m_mixed_precision);
+
+                if (evaluated)
+                    accumulate_pair(j, dx, rsq, rcutsq, ronsq, force_divr, pair_eng);
+                }
+            }
 
         // finally, increment the force, potential energy and virial for particle i
         unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
+        force[mem_idx].x += fi.x;
+        force[mem_idx].y += fi.y;
+        force[mem_idx].z += fi.z;
+        force[mem_idx].w += pei;
         if (compute_virial)
             {
-            h_virial.data[0 * m_virial_pitch + mem_idx] += virialxxi;
-            h_virial.data[1 * m_virial_pitch + mem_idx] += virialxyi;
-            h_virial.data[2 * m_virial_pitch + mem_idx] += virialxzi;
-            h_virial.data[3 * m_virial_pitch + mem_idx] += virialyyi;
-            h_virial.data[4 * m_virial_pitch + mem_idx] += virialyzi;
-            h_virial.data[5 * m_virial_pitch + mem_idx] += virialzzi;
+            virial[0 * virial_pitch + mem_idx] += virialxxi;
+            virial[1 * virial_pitch + mem_idx] += virialxyi;
+            virial[2 * virial_pitch + mem_idx] += virialxzi;
+            virial[3 * virial_pitch + mem_idx] += virialyyi;
+            virial[4 * virial_pitch + mem_idx] += virialyzi;
+            virial[5 * virial_pitch + mem_idx] += virialzzi;
             }
+    };
+
+#ifdef ENABLE_TBB
+    if (m_exec_conf->getNumThreads() > 1)
+        {
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                if (!third_law)
+                    {
+                    // with a full neighbor list, each particle only writes to its own entry
+                    m_exec_conf->parallelFor(
+                        0,
+                        N,
+                        [&](const tbb::blocked_range<unsigned int>& r)
+                        {
+                            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                compute_particle_forces(i,
+                                                        h_force.data,
+                                                        h_virial.data,
+                                                        m_virial_pitch);
+                        });
+                    return;
+                    }
+
+                // the third law scatters into j, so accumulate into per-thread buffers.
+                // Buffers are left zeroed by the reduction below, resize them if N changed.
+                const size_t virial_size = compute_virial ? 6 * size_t(N) : 0;
+                for (auto& buf : m_thread_force)
+                    if (buf.size() != N)
+                        buf.assign(N, make_scalar4(0, 0, 0, 0));
+                for (auto& buf : m_thread_virial)
+                    if (buf.size() != virial_size)
+                        buf.assign(virial_size, Scalar(0.0));
+
+                m_exec_conf->parallelFor(
+                    0,
+                    N,
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                        bool exists;
+                        std::vector<Scalar4>& force = m_thread_force.local(exists);
+                        if (!exists)
+                            force.assign(N, make_scalar4(0, 0, 0, 0));
+                        std::vector<Scalar>& virial = m_thread_virial.local(exists);
+                        if (!exists)
+                            virial.assign(virial_size, Scalar(0.0));
+
+                        for (unsigned int i = r.begin(); i != r.end(); ++i)
+                            compute_particle_forces(i, force.data(), virial.data(), N);
+                    });
+
+                // sum the per-thread contributions and zero the buffers for the next call
+                m_exec_conf->parallelFor(
+                    0,
+                    N,
+                    [&](const tbb::blocked_range<unsigned int>& r)
+                    {
+                        for (auto& force : m_thread_force)
+                            for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                {
+                                h_force.data[i].x += force[i].x;
+                                h_force.data[i].y += force[i].y;
+                                h_force.data[i].z += force[i].z;
+                                h_force.data[i].w += force[i].w;
+                                force[i] = make_scalar4(0, 0, 0, 0);
+                                }
+                        if (!compute_virial)
+                            return;
+                        for (auto& virial : m_thread_virial)
+                            for (unsigned int k = 0; k < 6; ++k)
+                                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                    {
+                                    h_virial.data[k * m_virial_pitch + i] += virial[k * N + i];
+                                    virial[k * N + i] = Scalar(0.0);
+                                    }
+                    });
+            }); // end task arena execute()
+        }
+    else
+#endif
+        {
+        // for each particle
+        for (unsigned int i = 0; i < N; i++)
+            compute_particle_forces(i, h_force.data, h_virial.data, m_virial_pitch);
         }
 
     if (m_prof)
@@ -917,6 +1334,64 @@ Scalar PotentialPair<evaluator>::computeEnergyBetweenSetsPythonList(
     return eng;
     }
 
+/*! \param params Parameters of the potential for one type pair
+    \param r_min Distance of the first table point
+    \param r_cut Cutoff radius
+    \param width Number of table points
+    \param energy_shift If true, shift the energies so that V(r) is continuous at the cutoff
+    \returns Parameters of EvaluatorPairTable and EvaluatorPairTableSpline that tabulate the
+             potential at the points numpy.linspace(r_min, r_cut, width, endpoint=False)
+
+    Tabulating an expensive potential once at setup replaces its evaluation in every step with a
+    table lookup.
+*/
+template<class evaluator>
+pybind11::dict PotentialPair<evaluator>::tabulatePython(pybind11::dict params,
+                                                        Scalar r_min,
+                                                        Scalar r_cut,
+                                                        unsigned int width,
+                                                        bool energy_shift)
+    {
+    if (evaluator::needsDiameter() || evaluator::needsCharge())
+        {
+        throw std::runtime_error("Potentials that depend on the diameter or charge "
+                                 "cannot be tabulated.");
+        }
+    if (width == 0)
+        {
+        throw std::runtime_error("The table width must not be zero.");
+        }
+    if (r_min < 0 || r_cut <= r_min)
+        {
+        throw std::runtime_error("The table range must satisfy 0 <= r_min < r_cut.");
+        }
+
+    const param_type param(params, false);
+    const Scalar rcutsq = r_cut * r_cut;
+    const Scalar delta_r = (r_cut - r_min) / Scalar(width);
+
+    pybind11::array_t<Scalar> V(width);
+    pybind11::array_t<Scalar> F(width);
+    auto h_V = V.mutable_unchecked<1>();
+    auto h_F = F.mutable_unchecked<1>();
+    for (unsigned int i = 0; i < width; i++)
+        {
+        const Scalar r = r_min + delta_r * Scalar(i);
+        Scalar force_divr = Scalar(0.0);
+        Scalar pair_eng = Scalar(0.0);
+        evaluator eval(r * r, rcutsq, param);
+        eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+        h_V(i) = pair_eng;
+        h_F(i) = force_divr * r;
+        }
+
+    pybind11::dict table;
+    table["r_min"] = r_min;
+    table["V"] = V;
+    table["F"] = F;
+    return table;
+    }
+
 namespace detail
     {
 //! Export this pair potential to python
@@ -929,13 +1404,17 @@ template<class T> void export_PotentialPair(pybind11::module& m, const std::stri
     potentialpair
         .def(pybind11::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<NeighborList>>())
         .def("setParams", &T::setParamsPython)
+        .def("setParamsBatch", &T::setParamsBatchPython)
         .def("getParams", &T::getParams)
         .def("setRCut", &T::setRCutPython)
+        .def("setRCutBatch", &T::setRCutBatchPython)
         .def("getRCut", &T::getRCut)
         .def("setROn", &T::setROnPython)
         .def("getROn", &T::getROn)
         .def_property("mode", &T::getShiftMode, &T::setShiftModePython)
+        .def_property("mixed_precision", &T::getMixedPrecision, &T::setMixedPrecision)
         .def("computeEnergyBetweenSets", &T::computeEnergyBetweenSetsPythonList)
+        .def_static("tabulate", &T::tabulatePython)
         .def("slotWriteGSDShapeSpec", &T::slotWriteGSDShapeSpec)
         .def("connectGSDShapeSpec", &T::connectGSDShapeSpec);
     }
@@ -10,6 +10,7 @@
 #include "hoomd/TextureTools.h"
 
 #include "hoomd/GPUPartition.cuh"
+#include "hoomd/md/PairMixedPrecision.h"
 
 #ifdef __HIPCC__
 #include "hoomd/WarpTools.cuh"
@@ -59,19 +60,35 @@ struct pair_args_t
                 const Scalar* _d_ronsq,
                 const size_t _size_neigh_list,
                 const unsigned int _ntypes,
+                const unsigned int* _d_type_class,
+                const unsigned int _n_type_classes,
                 const unsigned int _block_size,
                 const unsigned int _shift_mode,
                 const unsigned int _compute_virial,
+                const unsigned int _compute_energy,
                 const unsigned int _threads_per_particle,
                 const GPUPartition& _gpu_partition,
-                const hipDeviceProp_t& _devprop)
+                const hipDeviceProp_t& _devprop,
+                const unsigned int _ghost_phase = 0,
+                const unsigned int _cluster_size = 0,
+                const unsigned int* _d_cluster_n_neigh = nullptr,
+                const unsigned int* _d_cluster_nlist = nullptr,
+                const unsigned long long* _d_cluster_mask = nullptr,
+                const unsigned int _cluster_nmax = 0,
+                const unsigned int* _d_n_outliers = nullptr,
+                const bool _mixed_precision = false,
+                const hipStream_t _stream = 0)
         : d_force(_d_force), d_virial(_d_virial), virial_pitch(_virial_pitch), N(_N), n_max(_n_max),
           d_pos(_d_pos), d_diameter(_d_diameter), d_charge(_d_charge), box(_box),
           d_n_neigh(_d_n_neigh), d_nlist(_d_nlist), d_head_list(_d_head_list), d_rcutsq(_d_rcutsq),
           d_ronsq(_d_ronsq), size_neigh_list(_size_neigh_list), ntypes(_ntypes),
-          block_size(_block_size), shift_mode(_shift_mode), compute_virial(_compute_virial),
+          d_type_class(_d_type_class), n_type_classes(_n_type_classes), block_size(_block_size),
+          shift_mode(_shift_mode), compute_virial(_compute_virial), compute_energy(_compute_energy),
           threads_per_particle(_threads_per_particle), gpu_partition(_gpu_partition),
-          devprop(_devprop) {};
+          devprop(_devprop), ghost_phase(_ghost_phase), cluster_size(_cluster_size),
+          d_cluster_n_neigh(_d_cluster_n_neigh), d_cluster_nlist(_d_cluster_nlist),
+          d_cluster_mask(_d_cluster_mask), cluster_nmax(_cluster_nmax),
+          d_n_outliers(_d_n_outliers), mixed_precision(_mixed_precision), stream(_stream) {};
 
     Scalar4* d_force;          //!< Force to write out
     Scalar* d_virial;          //!< Virial to write out
@@ -86,20 +103,258 @@ struct pair_args_t
         d_n_neigh;                //!< Device array listing the number of neighbors on each particle
     const unsigned int* d_nlist;  //!< Device array listing the neighbors of each particle
     const size_t* d_head_list;    //!< Head list indexes for accessing d_nlist
-    const Scalar* d_rcutsq;       //!< Device array listing r_cut squared per particle type pair
-    const Scalar* d_ronsq;        //!< Device array listing r_on squared per particle type pair
+    const Scalar* d_rcutsq;       //!< Device array listing r_cut squared per type class pair
+    const Scalar* d_ronsq;        //!< Device array listing r_on squared per type class pair
     const size_t size_neigh_list; //!< Size of the neighbor list for texture binding
     const unsigned int ntypes;    //!< Number of particle types in the simulation
+    const unsigned int* d_type_class;  //!< Type class of each particle type
+    const unsigned int n_type_classes; //!< Number of type classes
     const unsigned int block_size;           //!< Block size to execute
     const unsigned int shift_mode;           //!< The potential energy shift mode
     const unsigned int compute_virial;       //!< Flag to indicate if virials should be computed
+    const unsigned int compute_energy;       //!< Flag to indicate if energies should be computed
     const unsigned int threads_per_particle; //!< Number of threads per particle (maximum: 1 warp)
     const GPUPartition& gpu_partition; //!< The load balancing partition of particles between GPUs
     const hipDeviceProp_t& devprop;    //!< CUDA device properties
+    const unsigned int ghost_phase;    //!< 0: all particles, 1: interior only, 2: boundary only
+    const unsigned int cluster_size;   //!< Particles per cluster, 0 for a per-particle list
+    const unsigned int* d_cluster_n_neigh;    //!< Number of j-clusters of each i-cluster
+    const unsigned int* d_cluster_nlist;      //!< j-clusters of each i-cluster
+    const unsigned long long* d_cluster_mask; //!< Interaction mask of each cluster pair
+    const unsigned int cluster_nmax;          //!< Maximum number of j-clusters per i-cluster
+    const unsigned int* d_n_outliers; //!< Outliers in a compressed d_nlist, nullptr if uncompressed
+    const bool mixed_precision;       //!< Evaluate the potential in single precision
+    const hipStream_t stream;         //!< Stream to launch the kernels on
     };
 
 #ifdef __HIPCC__
 
+//! Load neighbor \a k of particle \a i through the read-only cache
+/*! \param nlist Neighbors of particle \a i, starting at its head
+    \param i Particle index
+    \param n_outliers Number of outliers of particle \a i, the number of neighbors when the list is
+           not compressed
+    \param k Index of the neighbor
+
+    See NeighborListCompression.h for the compressed format.
+*/
+__device__ inline unsigned int
+load_neighbor(const unsigned int* nlist, unsigned int i, unsigned int n_outliers, unsigned int k)
+    {
+    if (k < n_outliers)
+        return __ldg(nlist + k);
+
+    return i + __ldg(reinterpret_cast<const short*>(nlist) + n_outliers + k);
+    }
+
+//! Evaluate the force and energy of one particle pair
+/*! \param force_divr Set to the magnitude of the force divided by r
+    \param pair_eng Set to the pair energy
+    \param rsq Squared distance between the particles
+    \param rcutsq Squared cutoff radius of the type pair
+    \param ronsq Squared XPLOR switching radius of the type pair (only used when shift_mode is 2)
+    \param param Parameters of the type pair
+    \param di Diameter of particle i
+    \param dj Diameter of particle j
+    \param qi Charge of particle i
+    \param qj Charge of particle j
+    \param mixed_precision Evaluate the potential in single precision when the evaluator supports
+           it, see PairMixedPrecision.h
+
+    \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r
+    \tparam shift_mode 0: No energy shifting is done. 1: V(r) is shifted to be 0 at rcut. 2: XPLOR
+    switching is enabled (See PotentialPair for a discussion on what that entails)
+*/
+template<class evaluator, unsigned int shift_mode>
+__device__ inline void eval_pair_force(Scalar& force_divr,
+                                       Scalar& pair_eng,
+                                       const Scalar rsq,
+                                       const Scalar rcutsq,
+                                       const Scalar ronsq,
+                                       const typename evaluator::param_type& param,
+                                       const Scalar di,
+                                       const Scalar dj,
+                                       const Scalar qi,
+                                       const Scalar qj,
+                                       const bool mixed_precision)
+    {
+    // design specifies that energies are shifted if
+    // 1) shift mode is set to shift
+    // or 2) shift mode is explor and ron > rcut
+    bool energy_shift = false;
+    if (shift_mode == 1)
+        energy_shift = true;
+    else if (shift_mode == 2)
+        {
+        if (ronsq > rcutsq)
+            energy_shift = true;
+        }
+
+    evaluator eval(rsq, rcutsq, param);
+    if (evaluator::needsDiameter())
+        eval.setDiameter(di, dj);
+    if (evaluator::needsCharge())
+        eval.setCharge(qi, qj);
+
+    detail::eval_force_and_energy(eval, force_divr, pair_eng, energy_shift, mixed_precision);
+
+    if (shift_mode == 2)
+        {
+        if (rsq >= ronsq && rsq < rcutsq)
+            {
+            // Implement XPLOR smoothing
+            Scalar old_pair_eng = pair_eng;
+            Scalar old_force_divr = force_divr;
+
+            // calculate 1.0 / (xplor denominator)
+            Scalar xplor_denom_inv
+                = Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+
+            Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+            Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
+                       * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
+            Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+
+            // make modifications to the old pair energy and force
+            pair_eng = old_pair_eng * s;
+            force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+            }
+        }
+    }
+
+//! Number of type class entries cached in shared memory, padded to keep the extra data aligned
+__host__ __device__ inline unsigned int pair_type_class_shared_size(unsigned int ntypes)
+    {
+    return (ntypes + 3) / 4 * 4;
+    }
+
+//! Shared memory needed to cache the per type class pair parameters of a pair force kernel
+/*! \param ntypes Number of particle types
+    \param n_type_classes Number of type classes
+*/
+template<class evaluator>
+__host__ __device__ inline size_t pair_param_shared_bytes(unsigned int ntypes,
+                                                          unsigned int n_type_classes)
+    {
+    Index2D class_pair_idx(n_type_classes);
+    return (2 * sizeof(Scalar) + sizeof(typename evaluator::param_type))
+               * class_pair_idx.getNumElements()
+           + sizeof(unsigned int) * pair_type_class_shared_size(ntypes);
+    }
+
+//! Per type class pair parameters of a pair force kernel
+/*! The parameters of the particle type pair (\a typei, \a typej) are stored at the index
+    <code>class_pair_idx(type_class[typei], type_class[typej])</code>, see
+    PotentialPair::updateTypeClasses().
+*/
+template<class evaluator> struct pair_param_tables
+    {
+    const typename evaluator::param_type* params; //!< Parameters per type class pair
+    const Scalar* rcutsq;                         //!< r_cut squared per type class pair
+    const Scalar* ronsq;                          //!< r_on squared per type class pair
+    const unsigned int* type_class;               //!< Type class of each particle type
+    Index2D class_pair_idx;                       //!< Indexer of the per type class pair arrays
+
+    //! Get the index of the parameters of a particle type pair
+    __device__ unsigned int operator()(unsigned int typei, unsigned int typej) const
+        {
+        return class_pair_idx(type_class[typei], type_class[typej]);
+        }
+    };
+
+//! Cache the per type class pair parameters in shared memory
+/*! \param s_data Dynamic shared memory of the kernel
+    \param d_params Parameters for the potential, stored per type class pair
+    \param d_rcutsq rcut squared, stored per type class pair
+    \param d_ronsq ron squared, stored per type class pair
+    \param d_type_class Type class of each particle type
+    \param ntypes Number of types in the simulation
+    \param n_type_classes Number of type classes
+    \param params_in_shared When false, the parameters do not fit in shared memory and are read
+           from global memory
+    \param max_extra_bytes Maximum shared memory for the nested managed arrays of the parameters
+    \returns The parameter tables to read from
+
+    Must be called by all threads of the block. The layout of \a s_data is given by
+    pair_param_shared_bytes().
+*/
+template<class evaluator, unsigned int shift_mode>
+__device__ pair_param_tables<evaluator>
+load_pair_param_tables(char* s_data,
+                       const typename evaluator::param_type* d_params,
+                       const Scalar* d_rcutsq,
+                       const Scalar* d_ronsq,
+                       const unsigned int* d_type_class,
+                       const unsigned int ntypes,
+                       const unsigned int n_type_classes,
+                       const bool params_in_shared,
+                       unsigned int max_extra_bytes)
+    {
+    pair_param_tables<evaluator> tables;
+    tables.class_pair_idx = Index2D(n_type_classes);
+    tables.params = d_params;
+    tables.rcutsq = d_rcutsq;
+    tables.ronsq = d_ronsq;
+    tables.type_class = d_type_class;
+    if (!params_in_shared)
+        return tables;
+
+    const unsigned int num_typ_parameters = tables.class_pair_idx.getNumElements();
+
+    // shared arrays for per type class pair parameters
+    typename evaluator::param_type* s_params = (typename evaluator::param_type*)(&s_data[0]);
+    Scalar* s_rcutsq
+        = (Scalar*)(&s_data[num_typ_parameters * sizeof(typename evaluator::param_type)]);
+    Scalar* s_ronsq
+        = (Scalar*)(&s_data[num_typ_parameters
+                            * (sizeof(typename evaluator::param_type) + sizeof(Scalar))]);
+    unsigned int* s_type_class = (unsigned int*)(s_ronsq + num_typ_parameters);
+
+    // load in the per type class pair parameters
+    for (unsigned int cur_offset = 0; cur_offset < num_typ_parameters; cur_offset += blockDim.x)
+        {
+        if (cur_offset + threadIdx.x < num_typ_parameters)
+            {
+            s_rcutsq[cur_offset + threadIdx.x] = d_rcutsq[cur_offset + threadIdx.x];
+            if (shift_mode == 2)
+                s_ronsq[cur_offset + threadIdx.x] = d_ronsq[cur_offset + threadIdx.x];
+            }
+        }
+
+    unsigned int param_size
+        = num_typ_parameters * sizeof(typename evaluator::param_type) / sizeof(int);
+    for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += blockDim.x)
+        {
+        if (cur_offset + threadIdx.x < param_size)
+            {
+            ((int*)s_params)[cur_offset + threadIdx.x] = ((int*)d_params)[cur_offset + threadIdx.x];
+            }
+        }
+
+    for (unsigned int cur_offset = 0; cur_offset < ntypes; cur_offset += blockDim.x)
+        {
+        if (cur_offset + threadIdx.x < ntypes)
+            s_type_class[cur_offset + threadIdx.x] = d_type_class[cur_offset + threadIdx.x];
+        }
+
+    // initialize extra shared mem
+    auto s_extra = reinterpret_cast<char*>(s_type_class + pair_type_class_shared_size(ntypes));
+
+    __syncthreads();
+
+    unsigned int available_bytes = max_extra_bytes;
+    for (unsigned int cur_pair = 0; cur_pair < num_typ_parameters; ++cur_pair)
+        s_params[cur_pair].load_shared(s_extra, available_bytes);
+
+    __syncthreads();
+
+    tables.params = s_params;
+    tables.rcutsq = s_rcutsq;
+    tables.ronsq = s_ronsq;
+    tables.type_class = s_type_class;
+    return tables;
+    }
+
 //! Kernel for calculating pair forces
 /*! This kernel is called to calculate the pair forces on all N particles. Actual evaluation of the
    potentials and forces for each pair is handled via the template class \a evaluator.
@@ -114,32 +369,47 @@ struct pair_args_t
     \param box Box dimensions used to implement periodic boundary conditions
     \param d_n_neigh Device memory array listing the number of neighbors for each particle
     \param d_nlist Device memory array containing the neighbor list contents
+    \param d_n_outliers Number of outliers of each particle in a compressed \a d_nlist, or
+           nullptr when \a d_nlist is not compressed
     \param d_head_list Indexes for reading \a d_nlist
-    \param d_params Parameters for the potential, stored per type pair
-    \param d_rcutsq rcut squared, stored per type pair
-    \param d_ronsq ron squared, stored per type pair
+    \param d_params Parameters for the potential, stored per type class pair
+    \param d_rcutsq rcut squared, stored per type class pair
+    \param d_ronsq ron squared, stored per type class pair
+    \param d_type_class Type class of each particle type
     \param ntypes Number of types in the simulation
+    \param n_type_classes Number of type classes
+    \param params_in_shared Cache the parameters in shared memory
     \param offset Offset of first particle
+    \param n_local Number of local particles, neighbor indices >= n_local are ghosts
+    \param ghost_phase 0: compute all particles. 1: compute only particles without ghost neighbors.
+           2: compute only particles with at least one ghost neighbor.
 
-    \a d_params, \a d_rcutsq, and \a d_ronsq must be indexed with an Index2DUpperTriangular(typei,
-   typej) to access the unique value for that type pair. These values are all cached into shared
-   memory for quick access, so a dynamic amount of shared memory must be allocated for this kernel
-   launch. The amount is (2*sizeof(Scalar) + sizeof(typename evaluator::param_type)) *
-   typpair_idx.getNumElements()
+    \a d_params, \a d_rcutsq, and \a d_ronsq are indexed by the type classes of the particles, see
+    pair_param_tables. When \a params_in_shared is set, these values and \a d_type_class are cached
+    into shared memory for quick access, so a dynamic amount of shared memory must be allocated for
+    this kernel launch. The amount is given by pair_param_shared_bytes().
 
     Certain options are controlled via template parameters to avoid the performance hit when they
    are not enabled. \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r \tparam
    shift_mode 0: No energy shifting is done. 1: V(r) is shifted to be 0 at rcut. 2: XPLOR switching
    is enabled (See PotentialPair for a discussion on what that entails) \tparam compute_virial When
    non-zero, the virial tensor is computed. When zero, the virial tensor is not computed. \tparam
-   tpp Number of threads to use per particle, must be power of 2 and smaller than warp size
+   compute_energy When zero, the energy is not accumulated and the energy arithmetic that the force
+   does not depend on is compiled out. \tparam mixed_precision Evaluate the potential in single
+   precision, see PairMixedPrecision.h \tparam tpp Number of threads to use per particle, must be
+   power of 2 and smaller than warp size
 
     <b>Implementation details</b>
     Each block will calculate the forces on a block of particles.
     Each group of \a tpp threads will calculate the total force on one particle.
     The neighborlist is arranged in columns so that reads are fully coalesced when doing this.
 */
-template<class evaluator, unsigned int shift_mode, unsigned int compute_virial, int tpp>
+template<class evaluator,
+         unsigned int shift_mode,
+         unsigned int compute_virial,
+         unsigned int compute_energy,
+         bool mixed_precision,
+         int tpp>
 __global__ void
 gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
                                       Scalar* d_virial,
@@ -151,57 +421,32 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
                                       const BoxDim box,
                                       const unsigned int* d_n_neigh,
                                       const unsigned int* d_nlist,
+                                      const unsigned int* d_n_outliers,
                                       const size_t* d_head_list,
                                       const typename evaluator::param_type* d_params,
                                       const Scalar* d_rcutsq,
                                       const Scalar* d_ronsq,
+                                      const unsigned int* d_type_class,
                                       const unsigned int ntypes,
+                                      const unsigned int n_type_classes,
+                                      const bool params_in_shared,
                                       const unsigned int offset,
+                                      const unsigned int n_local,
+                                      const unsigned int ghost_phase,
                                       unsigned int max_extra_bytes)
     {
-    Index2D typpair_idx(ntypes);
-    const unsigned int num_typ_parameters = typpair_idx.getNumElements();
-
-    // shared arrays for per type pair parameters
+    // per type class pair parameters
     HIP_DYNAMIC_SHARED(char, s_data)
-    typename evaluator::param_type* s_params = (typename evaluator::param_type*)(&s_data[0]);
-    Scalar* s_rcutsq
-        = (Scalar*)(&s_data[num_typ_parameters * sizeof(typename evaluator::param_type)]);
-    Scalar* s_ronsq
-        = (Scalar*)(&s_data[num_typ_parameters
-                            * (sizeof(typename evaluator::param_type) + sizeof(Scalar))]);
-
-    // load in the per type pair parameters
-    for (unsigned int cur_offset = 0; cur_offset < num_typ_parameters; cur_offset += blockDim.x)
-        {
-        if (cur_offset + threadIdx.x < num_typ_parameters)
-            {
-            s_rcutsq[cur_offset + threadIdx.x] = d_rcutsq[cur_offset + threadIdx.x];
-            if (shift_mode == 2)
-                s_ronsq[cur_offset + threadIdx.x] = d_ronsq[cur_offset + threadIdx.x];
-            }
-        }
-
-    unsigned int param_size
-        = num_typ_parameters * sizeof(typename evaluator::param_type) / sizeof(int);
-    for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += blockDim.x)
-        {
-        if (cur_offset + threadIdx.x < param_size)
-            {
-            ((int*)s_params)[cur_offset + threadIdx.x] = ((int*)d_params)[cur_offset + threadIdx.x];
-            }
-        }
-
-    // initialize extra shared mem
-    auto s_extra = reinterpret_cast<char*>(s_ronsq + num_typ_parameters);
-
-    __syncthreads();
-
-    unsigned int available_bytes = max_extra_bytes;
-    for (unsigned int cur_pair = 0; cur_pair < num_typ_parameters; ++cur_pair)
-        s_params[cur_pair].load_shared(s_extra, available_bytes);
-
-    __syncthreads();
+    const pair_param_tables<evaluator> param_tables
+        = load_pair_param_tables<evaluator, shift_mode>(s_data,
+                                                        d_params,
+                                                        d_rcutsq,
+                                                        d_ronsq,
+                                                        d_type_class,
+                                                        ntypes,
+                                                        n_type_classes,
+                                                        params_in_shared,
+                                                        max_extra_bytes);
 
     // start by identifying which particle we are to handle
     unsigned int idx = blockIdx.x * (blockDim.x / tpp) + threadIdx.x / tpp;
@@ -215,6 +460,32 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
     // add offset to get actual particle index
     idx += offset;
 
+    // when the ghost update is overlapped, split the particles into interior ones (all neighbors
+    // are local) and boundary ones (at least one ghost neighbor), and only handle one of the two
+    if (ghost_phase != 0)
+        {
+        unsigned int n_ghost_neigh = 0;
+        if (active)
+            {
+            unsigned int n_neigh = d_n_neigh[idx];
+            unsigned int n_outliers = d_n_outliers ? d_n_outliers[idx] : n_neigh;
+            const unsigned int* my_nlist = d_nlist + d_head_list[idx];
+            for (unsigned int neigh_idx = threadIdx.x % tpp; neigh_idx < n_neigh; neigh_idx += tpp)
+                {
+                if (load_neighbor(my_nlist, idx, n_outliers, neigh_idx) >= n_local)
+                    n_ghost_neigh++;
+                }
+            }
+
+        // the warp aggregate is available to all threads in the group
+        unsigned int n_ghost_neigh_scan;
+        hoomd::detail::WarpScan<unsigned int, tpp> scanner;
+        scanner.InclusiveSum(n_ghost_neigh, n_ghost_neigh_scan, n_ghost_neigh);
+
+        if ((ghost_phase == 1) == (n_ghost_neigh > 0))
+            active = false;
+        }
+
     // initialize the force to 0
     Scalar4 force = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
     Scalar virialxx = Scalar(0.0);
@@ -241,11 +512,14 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
         if (evaluator::needsCharge())
             qi = __ldg(d_charge + idx);
 
-        size_t my_head = d_head_list[idx];
+        unsigned int n_outliers = d_n_outliers ? d_n_outliers[idx] : n_neigh;
+        const unsigned int* my_nlist = d_nlist + d_head_list[idx];
         unsigned int cur_j = 0;
 
         unsigned int next_j(0);
-        next_j = threadIdx.x % tpp < n_neigh ? __ldg(d_nlist + my_head + threadIdx.x % tpp) : 0;
+        next_j = threadIdx.x % tpp < n_neigh
+                     ? load_neighbor(my_nlist, idx, n_outliers, threadIdx.x % tpp)
+                     : 0;
 
         // loop over neighbors
         for (int neigh_idx = threadIdx.x % tpp; neigh_idx < n_neigh; neigh_idx += tpp)
@@ -255,7 +529,7 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
                 cur_j = next_j;
                 if (neigh_idx + tpp < n_neigh)
                     {
-                    next_j = __ldg(d_nlist + my_head + neigh_idx + tpp);
+                    next_j = load_neighbor(my_nlist, idx, n_outliers, neigh_idx + tpp);
                     }
                 // get the neighbor's position
                 Scalar4 postypej = __ldg(d_pos + cur_j);
@@ -278,64 +552,30 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
                 // calculate r squared
                 Scalar rsq = dot(dx, dx);
 
-                // access the per type pair parameters
+                // access the per type class pair parameters
                 unsigned int typpair
-                    = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(postypej.w));
-                Scalar rcutsq = s_rcutsq[typpair];
-                typename evaluator::param_type param = s_params[typpair];
+                    = param_tables(__scalar_as_int(postypei.w), __scalar_as_int(postypej.w));
+                Scalar rcutsq = param_tables.rcutsq[typpair];
+                typename evaluator::param_type param = param_tables.params[typpair];
                 Scalar ronsq = Scalar(0.0);
                 if (shift_mode == 2)
-                    ronsq = s_ronsq[typpair];
-
-                // design specifies that energies are shifted if
-                // 1) shift mode is set to shift
-                // or 2) shift mode is explor and ron > rcut
-                bool energy_shift = false;
-                if (shift_mode == 1)
-                    energy_shift = true;
-                else if (shift_mode == 2)
-                    {
-                    if (ronsq > rcutsq)
-                        energy_shift = true;
-                    }
+                    ronsq = param_tables.ronsq[typpair];
 
                 // evaluate the potential
                 Scalar force_divr = Scalar(0.0);
                 Scalar pair_eng = Scalar(0.0);
+                eval_pair_force<evaluator, shift_mode>(force_divr,
+                                                       pair_eng,
+                                                       rsq,
+                                                       rcutsq,
+                                                       ronsq,
+                                                       param,
+                                                       di,
+                                                       dj,
+                                                       qi,
+                                                       qj,
+                                                       mixed_precision);
 
-                evaluator eval(rsq, rcutsq, param);
-                if (evaluator::needsDiameter())
-                    eval.setDiameter(di, dj);
-                if (evaluator::needsCharge())
-                    eval.setCharge(qi, qj);
-
-                eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
-
-                if (shift_mode == 2)
-                    {
-                    if (rsq >= ronsq && rsq < rcutsq)
-                        {
-                        // Implement XPLOR smoothing
-                        Scalar old_pair_eng = pair_eng;
-                        Scalar old_force_divr = force_divr;
-
-                        // calculate 1.0 / (xplor denominator)
-                        Scalar xplor_denom_inv
-                            = Scalar(1.0)
-                              / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
-
-                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
-                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
-                                   * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq)
-                                   * xplor_denom_inv;
-                        Scalar ds_dr_divr
-                            = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
-
-                        // make modifications to the old pair energy and force
-                        pair_eng = old_pair_eng * s;
-                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
-                        }
-                    }
                 // calculate the virial
                 if (compute_virial)
                     {
@@ -353,12 +593,14 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
                 force.y += dx.y * force_divr;
                 force.z += dx.z * force_divr;
 
-                force.w += pair_eng;
+                if (compute_energy)
+                    force.w += pair_eng;
                 }
             }
 
         // potential energy per particle must be halved
-        force.w *= Scalar(0.5);
+        if (compute_energy)
+            force.w *= Scalar(0.5);
         }
 
     // reduce force over threads in cta
@@ -366,7 +608,8 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
     force.x = reducer.Sum(force.x);
     force.y = reducer.Sum(force.y);
     force.z = reducer.Sum(force.z);
-    force.w = reducer.Sum(force.w);
+    if (compute_energy)
+        force.w = reducer.Sum(force.w);
 
     // now that the force calculation is complete, write out the result
     if (active && threadIdx.x % tpp == 0)
@@ -394,6 +637,222 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
         }
     }
 
+//! Kernel for calculating pair forces with a cluster pair list
+/*! This kernel computes the same forces as gpu_compute_pair_forces_shared_kernel(), walking the
+    cluster pair list of NeighborListGPUCluster instead of the per-particle neighbor list. The
+    parameters in common are documented there.
+
+    \param first Index of the first particle to compute
+    \param last One past the index of the last particle to compute
+    \param d_cluster_n_neigh Number of j-clusters of each i-cluster
+    \param d_cluster_nlist j-clusters of each i-cluster, \a cluster_nmax per i-cluster
+    \param d_cluster_mask Interaction mask of each cluster pair
+    \param cluster_nmax Maximum number of j-clusters per i-cluster
+
+    \tparam cluster_size Number of particles per cluster
+
+    <b>Implementation details</b>
+    Each thread computes the force on one particle and each group of \a cluster_size consecutive
+    threads handles one i-cluster. The threads of an i-cluster walk the same list of j-clusters and
+    load the particles of a j-cluster from the same consecutive addresses, so the loads are
+    coalesced and shared between the threads. The interaction mask selects the particle pairs that
+    are in the neighbor list. No reduction is needed since each particle has a single thread.
+*/
+template<class evaluator,
+         unsigned int shift_mode,
+         unsigned int compute_virial,
+         unsigned int compute_energy,
+         bool mixed_precision,
+         unsigned int cluster_size>
+__global__ void
+gpu_compute_pair_forces_cluster_kernel(Scalar4* d_force,
+                                       Scalar* d_virial,
+                                       const size_t virial_pitch,
+                                       const unsigned int first,
+                                       const unsigned int last,
+                                       const Scalar4* d_pos,
+                                       const Scalar* d_diameter,
+                                       const Scalar* d_charge,
+                                       const BoxDim box,
+                                       const unsigned int* d_cluster_n_neigh,
+                                       const unsigned int* d_cluster_nlist,
+                                       const unsigned long long* d_cluster_mask,
+                                       const unsigned int cluster_nmax,
+                                       const typename evaluator::param_type* d_params,
+                                       const Scalar* d_rcutsq,
+                                       const Scalar* d_ronsq,
+                                       const unsigned int* d_type_class,
+                                       const unsigned int ntypes,
+                                       const unsigned int n_type_classes,
+                                       const bool params_in_shared,
+                                       const unsigned int n_local,
+                                       const unsigned int ghost_phase,
+                                       unsigned int max_extra_bytes)
+    {
+    // per type class pair parameters
+    HIP_DYNAMIC_SHARED(char, s_data)
+    const pair_param_tables<evaluator> param_tables
+        = load_pair_param_tables<evaluator, shift_mode>(s_data,
+                                                        d_params,
+                                                        d_rcutsq,
+                                                        d_ronsq,
+                                                        d_type_class,
+                                                        ntypes,
+                                                        n_type_classes,
+                                                        params_in_shared,
+                                                        max_extra_bytes);
+
+    // threads are assigned to particles starting at the i-cluster that holds the first particle,
+    // so that the threads of an i-cluster are consecutive
+    unsigned int idx
+        = (first / cluster_size) * cluster_size + blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx < first || idx >= last)
+        return;
+
+    const unsigned int ci = idx / cluster_size;
+    const unsigned int row_shift = (idx % cluster_size) * cluster_size;
+    const unsigned long long row_mask = (1ull << cluster_size) - 1;
+    const unsigned int n_cj = d_cluster_n_neigh[ci];
+    const size_t head = size_t(ci) * cluster_nmax;
+
+    // when the ghost update is overlapped, split the particles into interior ones (all neighbors
+    // are local) and boundary ones (at least one ghost neighbor), and only handle one of the two
+    if (ghost_phase != 0)
+        {
+        bool has_ghost_neigh = false;
+        for (unsigned int k = 0; k < n_cj; ++k)
+            {
+            unsigned int cj = __ldg(d_cluster_nlist + head + k);
+            if ((cj + 1) * cluster_size > n_local)
+                {
+                unsigned int row = static_cast<unsigned int>(
+                    (__ldg(d_cluster_mask + head + k) >> row_shift) & row_mask);
+                unsigned int ghost_bits = n_local > cj * cluster_size
+                                              ? ~((1u << (n_local - cj * cluster_size)) - 1)
+                                              : ~0u;
+                if (row & ghost_bits)
+                    has_ghost_neigh = true;
+                }
+            }
+
+        if ((ghost_phase == 1) == has_ghost_neigh)
+            return;
+        }
+
+    // initialize the force to 0
+    Scalar4 force = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+    Scalar virialxx = Scalar(0.0);
+    Scalar virialxy = Scalar(0.0);
+    Scalar virialxz = Scalar(0.0);
+    Scalar virialyy = Scalar(0.0);
+    Scalar virialyz = Scalar(0.0);
+    Scalar virialzz = Scalar(0.0);
+
+    // read in the position of our particle.
+    Scalar4 postypei = __ldg(d_pos + idx);
+    Scalar3 posi = make_scalar3(postypei.x, postypei.y, postypei.z);
+
+    Scalar di = Scalar(0);
+    if (evaluator::needsDiameter())
+        di = __ldg(d_diameter + idx);
+
+    Scalar qi = Scalar(0);
+    if (evaluator::needsCharge())
+        qi = __ldg(d_charge + idx);
+
+    // loop over j-clusters
+    for (unsigned int k = 0; k < n_cj; ++k)
+        {
+        unsigned int cj = __ldg(d_cluster_nlist + head + k);
+        unsigned int row
+            = static_cast<unsigned int>((__ldg(d_cluster_mask + head + k) >> row_shift) & row_mask);
+
+#pragma unroll
+        for (unsigned int j_sub = 0; j_sub < cluster_size; ++j_sub)
+            {
+            if (!(row & (1u << j_sub)))
+                continue;
+
+            // get the neighbor's position
+            unsigned int cur_j = cj * cluster_size + j_sub;
+            Scalar4 postypej = __ldg(d_pos + cur_j);
+            Scalar3 posj = make_scalar3(postypej.x, postypej.y, postypej.z);
+
+            Scalar dj = Scalar(0.0);
+            if (evaluator::needsDiameter())
+                dj = __ldg(d_diameter + cur_j);
+
+            Scalar qj = Scalar(0.0);
+            if (evaluator::needsCharge())
+                qj = __ldg(d_charge + cur_j);
+
+            // calculate dr (with periodic boundary conditions)
+            Scalar3 dx = posi - posj;
+            dx = box.minImage(dx);
+            Scalar rsq = dot(dx, dx);
+
+            // access the per type class pair parameters
+            unsigned int typpair
+                = param_tables(__scalar_as_int(postypei.w), __scalar_as_int(postypej.w));
+            Scalar rcutsq = param_tables.rcutsq[typpair];
+            typename evaluator::param_type param = param_tables.params[typpair];
+            Scalar ronsq = Scalar(0.0);
+            if (shift_mode == 2)
+                ronsq = param_tables.ronsq[typpair];
+
+            // evaluate the potential
+            Scalar force_divr = Scalar(0.0);
+            Scalar pair_eng = Scalar(0.0);
+            eval_pair_force<evaluator, shift_mode>(force_divr,
+                                                   pair_eng,
+                                                   rsq,
+                                                   rcutsq,
+                                                   ronsq,
+                                                   param,
+                                                   di,
+                                                   dj,
+                                                   qi,
+                                                   qj,
+                                                   mixed_precision);
+
+            // calculate the virial
+            if (compute_virial)
+                {
+                Scalar force_div2r = Scalar(0.5) * force_divr;
+                virialxx += dx.x * dx.x * force_div2r;
+                virialxy += dx.x * dx.y * force_div2r;
+                virialxz += dx.x * dx.z * force_div2r;
+                virialyy += dx.y * dx.y * force_div2r;
+                virialyz += dx.y * dx.z * force_div2r;
+                virialzz += dx.z * dx.z * force_div2r;
+                }
+
+            // add up the force vector components
+            force.x += dx.x * force_divr;
+            force.y += dx.y * force_divr;
+            force.z += dx.z * force_divr;
+
+            if (compute_energy)
+                force.w += pair_eng;
+            }
+        }
+
+    // potential energy per particle must be halved
+    if (compute_energy)
+        force.w *= Scalar(0.5);
+    d_force[idx] = force;
+
+    if (compute_virial)
+        {
+        d_virial[0 * virial_pitch + idx] = virialxx;
+        d_virial[1 * virial_pitch + idx] = virialxy;
+        d_virial[2 * virial_pitch + idx] = virialxz;
+        d_virial[3 * virial_pitch + idx] = virialyy;
+        d_virial[4 * virial_pitch + idx] = virialyz;
+        d_virial[5 * virial_pitch + idx] = virialzz;
+        }
+    }
+
 template<typename T> int get_max_block_size(T func)
     {
     hipFuncAttributes attr;
@@ -410,20 +869,25 @@ template<typename T> int get_max_block_size(T func)
  * \tparam shift_mode 0: No energy shifting is done. 1: V(r) is shifted to be 0 at rcut. 2: XPLOR
  * switching is enabled (See PotentialPair for a discussion on what that entails) \tparam
  * compute_virial When non-zero, the virial tensor is computed. When zero, the virial tensor is not
- * computed. \tparam tpp Number of threads to use per particle, must be power of 2 and smaller than
- * warp size
+ * computed. \tparam compute_energy When non-zero, the energy is computed. \tparam tpp Number of
+ * threads to use per particle, must be power of 2 and smaller than warp size
  *
  * Partial function template specialization is not allowed in C++, so instead we have to wrap this
  * with a struct that we are allowed to partially specialize.
  */
-template<class evaluator, unsigned int shift_mode, unsigned int compute_virial, int tpp>
+template<class evaluator,
+         unsigned int shift_mode,
+         unsigned int compute_virial,
+         unsigned int compute_energy,
+         bool mixed_precision,
+         int tpp>
 struct PairForceComputeKernel
     {
     //! Launcher for the pair force kernel
     /*!
      * \param pair_args Other arguments to pass onto the kernel
      * \param range Range of particle indices this GPU operates on
-     * \param d_params Parameters for the potential, stored per type pair
+     * \param d_params Parameters for the potential, stored per type class pair
      */
 
     static void launch(const pair_args_t& pair_args,
@@ -437,45 +901,62 @@ struct PairForceComputeKernel
             {
             unsigned int block_size = pair_args.block_size;
 
-            Index2D typpair_idx(pair_args.ntypes);
             size_t param_shared_bytes
-                = (2 * sizeof(Scalar) + sizeof(typename evaluator::param_type))
-                  * typpair_idx.getNumElements();
+                = pair_param_shared_bytes<evaluator>(pair_args.ntypes, pair_args.n_type_classes);
 
-            unsigned int max_block_size;
-            max_block_size = get_max_block_size(
-                gpu_compute_pair_forces_shared_kernel<evaluator, shift_mode, compute_virial, tpp>);
+            auto kernel_func = &gpu_compute_pair_forces_shared_kernel<evaluator,
+                                                                      shift_mode,
+                                                                      compute_virial,
+                                                                      compute_energy,
+                                                                      mixed_precision,
+                                                                      tpp>;
+            unsigned int max_block_size = get_max_block_size(kernel_func);
 
             hipFuncAttributes attr;
-            hipFuncGetAttributes(
-                &attr,
-                reinterpret_cast<const void*>(&gpu_compute_pair_forces_shared_kernel<evaluator,
-                                                                                     shift_mode,
-                                                                                     compute_virial,
-                                                                                     tpp>));
-
-            unsigned int max_extra_bytes = static_cast<unsigned int>(
-                pair_args.devprop.sharedMemPerBlock - param_shared_bytes - attr.sharedSizeBytes);
-
-            // determine dynamically requested shared memory in nested managed arrays
-            char* ptr = nullptr;
-            unsigned int available_bytes = max_extra_bytes;
-            for (unsigned int i = 0; i < typpair_idx.getNumElements(); ++i)
+            hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel_func));
+
+            // read the parameters from global memory when there are too many type classes to
+            // cache them in shared memory
+            bool params_in_shared
+                = param_shared_bytes + attr.sharedSizeBytes <= pair_args.devprop.sharedMemPerBlock;
+            unsigned int max_extra_bytes = 0;
+            unsigned int extra_shared_bytes = 0;
+            if (params_in_shared)
                 {
-                d_params[i].allocate_shared(ptr, available_bytes);
-                }
+                max_extra_bytes = static_cast<unsigned int>(pair_args.devprop.sharedMemPerBlock
+                                                            - param_shared_bytes
+                                                            - attr.sharedSizeBytes);
+
+                // determine dynamically requested shared memory in nested managed arrays
+                char* ptr = nullptr;
+                unsigned int available_bytes = max_extra_bytes;
+                Index2D class_pair_idx(pair_args.n_type_classes);
+                for (unsigned int i = 0; i < class_pair_idx.getNumElements(); ++i)
+                    {
+                    d_params[i].allocate_shared(ptr, available_bytes);
+                    }
 
-            unsigned int extra_shared_bytes = max_extra_bytes - available_bytes;
+                extra_shared_bytes = max_extra_bytes - available_bytes;
+                }
+            else
+                {
+                param_shared_bytes = 0;
+                }
 
             block_size = block_size < max_block_size ? block_size : max_block_size;
             dim3 grid(N / (block_size / tpp) + 1, 1, 1);
 
             hipLaunchKernelGGL(
-                (gpu_compute_pair_forces_shared_kernel<evaluator, shift_mode, compute_virial, tpp>),
+                (gpu_compute_pair_forces_shared_kernel<evaluator,
+                                                       shift_mode,
+                                                       compute_virial,
+                                                       compute_energy,
+                                                       mixed_precision,
+                                                       tpp>),
                 dim3(grid),
                 dim3(block_size),
                 param_shared_bytes + extra_shared_bytes,
-                0,
+                pair_args.stream,
                 pair_args.d_force,
                 pair_args.d_virial,
                 pair_args.virial_pitch,
@@ -486,27 +967,44 @@ struct PairForceComputeKernel
                 pair_args.box,
                 pair_args.d_n_neigh,
                 pair_args.d_nlist,
+                pair_args.d_n_outliers,
                 pair_args.d_head_list,
                 d_params,
                 pair_args.d_rcutsq,
                 pair_args.d_ronsq,
+                pair_args.d_type_class,
                 pair_args.ntypes,
+                pair_args.n_type_classes,
+                params_in_shared,
                 offset,
+                pair_args.N,
+                pair_args.ghost_phase,
                 max_extra_bytes);
             }
         else
             {
-            PairForceComputeKernel<evaluator, shift_mode, compute_virial, tpp / 2>::launch(
-                pair_args,
-                range,
-                d_params);
+            PairForceComputeKernel<evaluator,
+                                   shift_mode,
+                                   compute_virial,
+                                   compute_energy,
+                                   mixed_precision,
+                                   tpp / 2>::launch(pair_args, range, d_params);
             }
         }
     };
 
 //! Template specialization to do nothing for the tpp = 0 case
-template<class evaluator, unsigned int shift_mode, unsigned int compute_virial>
-struct PairForceComputeKernel<evaluator, shift_mode, compute_virial, 0>
+template<class evaluator,
+         unsigned int shift_mode,
+         unsigned int compute_virial,
+         unsigned int compute_energy,
+         bool mixed_precision>
+struct PairForceComputeKernel<evaluator,
+                              shift_mode,
+                              compute_virial,
+                              compute_energy,
+                              mixed_precision,
+                              0>
     {
     static void launch(const pair_args_t& pair_args,
                        std::pair<unsigned int, unsigned int> range,
@@ -516,9 +1014,267 @@ struct PairForceComputeKernel<evaluator, shift_mode, compute_virial, 0>
         }
     };
 
+//! Cluster pair force compute kernel launcher
+/*!
+ * \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r
+ * \tparam shift_mode 0: No energy shifting is done. 1: V(r) is shifted to be 0 at rcut. 2: XPLOR
+ * switching is enabled \tparam compute_virial When non-zero, the virial tensor is computed.
+ * \tparam compute_energy When non-zero, the energy is computed.
+ * \tparam cluster_size Number of particles per cluster
+ *
+ * Launches gpu_compute_pair_forces_cluster_kernel() instantiated for the cluster size of the
+ * neighbor list, trying cluster sizes of 8 and 4.
+ */
+template<class evaluator,
+         unsigned int shift_mode,
+         unsigned int compute_virial,
+         unsigned int compute_energy,
+         bool mixed_precision,
+         unsigned int cluster_size>
+struct PairForceClusterKernel
+    {
+    //! Launcher for the cluster pair force kernel
+    /*!
+     * \param pair_args Other arguments to pass onto the kernel
+     * \param range Range of particle indices this GPU operates on
+     * \param d_params Parameters for the potential, stored per type class pair
+     */
+    static void launch(const pair_args_t& pair_args,
+                       std::pair<unsigned int, unsigned int> range,
+                       const typename evaluator::param_type* d_params)
+        {
+        if (cluster_size == pair_args.cluster_size)
+            {
+            unsigned int block_size = pair_args.block_size;
+
+            size_t param_shared_bytes
+                = pair_param_shared_bytes<evaluator>(pair_args.ntypes, pair_args.n_type_classes);
+
+            auto kernel_func = &gpu_compute_pair_forces_cluster_kernel<evaluator,
+                                                                       shift_mode,
+                                                                       compute_virial,
+                                                                       compute_energy,
+                                                                       mixed_precision,
+                                                                       cluster_size>;
+            unsigned int max_block_size = get_max_block_size(kernel_func);
+
+            hipFuncAttributes attr;
+            hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel_func));
+
+            // read the parameters from global memory when there are too many type classes to
+            // cache them in shared memory
+            bool params_in_shared
+                = param_shared_bytes + attr.sharedSizeBytes <= pair_args.devprop.sharedMemPerBlock;
+            unsigned int max_extra_bytes = 0;
+            unsigned int extra_shared_bytes = 0;
+            if (params_in_shared)
+                {
+                max_extra_bytes = static_cast<unsigned int>(pair_args.devprop.sharedMemPerBlock
+                                                            - param_shared_bytes
+                                                            - attr.sharedSizeBytes);
+
+                // determine dynamically requested shared memory in nested managed arrays
+                char* ptr = nullptr;
+                unsigned int available_bytes = max_extra_bytes;
+                Index2D class_pair_idx(pair_args.n_type_classes);
+                for (unsigned int i = 0; i < class_pair_idx.getNumElements(); ++i)
+                    {
+                    d_params[i].allocate_shared(ptr, available_bytes);
+                    }
+
+                extra_shared_bytes = max_extra_bytes - available_bytes;
+                }
+            else
+                {
+                param_shared_bytes = 0;
+                }
+
+            // the threads start at the i-cluster that holds the first particle
+            unsigned int n_threads = range.second - (range.first / cluster_size) * cluster_size;
+            block_size = block_size < max_block_size ? block_size : max_block_size;
+            dim3 grid(n_threads / block_size + 1, 1, 1);
+
+            hipLaunchKernelGGL((gpu_compute_pair_forces_cluster_kernel<evaluator,
+                                                                       shift_mode,
+                                                                       compute_virial,
+                                                                       compute_energy,
+                                                                       mixed_precision,
+                                                                       cluster_size>),
+                               dim3(grid),
+                               dim3(block_size),
+                               param_shared_bytes + extra_shared_bytes,
+                               pair_args.stream,
+                               pair_args.d_force,
+                               pair_args.d_virial,
+                               pair_args.virial_pitch,
+                               range.first,
+                               range.second,
+                               pair_args.d_pos,
+                               pair_args.d_diameter,
+                               pair_args.d_charge,
+                               pair_args.box,
+                               pair_args.d_cluster_n_neigh,
+                               pair_args.d_cluster_nlist,
+                               pair_args.d_cluster_mask,
+                               pair_args.cluster_nmax,
+                               d_params,
+                               pair_args.d_rcutsq,
+                               pair_args.d_ronsq,
+                               pair_args.d_type_class,
+                               pair_args.ntypes,
+                               pair_args.n_type_classes,
+                               params_in_shared,
+                               pair_args.N,
+                               pair_args.ghost_phase,
+                               max_extra_bytes);
+            }
+        else
+            {
+            PairForceClusterKernel<evaluator,
+                                   shift_mode,
+                                   compute_virial,
+                                   compute_energy,
+                                   mixed_precision,
+                                   cluster_size / 2>::launch(pair_args, range, d_params);
+            }
+        }
+    };
+
+//! Template specialization to do nothing for clusters smaller than 4 particles
+template<class evaluator,
+         unsigned int shift_mode,
+         unsigned int compute_virial,
+         unsigned int compute_energy,
+         bool mixed_precision>
+struct PairForceClusterKernel<evaluator,
+                              shift_mode,
+                              compute_virial,
+                              compute_energy,
+                              mixed_precision,
+                              2>
+    {
+    static void launch(const pair_args_t& pair_args,
+                       std::pair<unsigned int, unsigned int> range,
+                       const typename evaluator::param_type* d_params)
+        {
+        // do nothing
+        }
+    };
+
+//! Launch the pair force kernel that matches the neighbor list
+/*! \param pair_args Other arguments to pass onto the kernel
+    \param range Range of particle indices this GPU operates on
+    \param d_params Parameters for the potential, stored per type class pair
+*/
+template<class evaluator,
+         unsigned int shift_mode,
+         unsigned int compute_virial,
+         unsigned int compute_energy,
+         bool mixed_precision>
+void launch_pair_force_kernel(const pair_args_t& pair_args,
+                              std::pair<unsigned int, unsigned int> range,
+                              const typename evaluator::param_type* d_params)
+    {
+    if (pair_args.cluster_size != 0)
+        {
+        PairForceClusterKernel<evaluator,
+                               shift_mode,
+                               compute_virial,
+                               compute_energy,
+                               mixed_precision,
+                               8>::launch(pair_args, range, d_params);
+        }
+    else
+        {
+        PairForceComputeKernel<evaluator,
+                               shift_mode,
+                               compute_virial,
+                               compute_energy,
+                               mixed_precision,
+                               gpu_pair_force_max_tpp>::launch(pair_args, range, d_params);
+        }
+    }
+
+//! Launch the pair force kernel for the shift mode in \a pair_args
+/*! \param pair_args Other arguments to pass onto the kernel
+    \param range Range of particle indices this GPU operates on
+    \param d_params Parameters for the potential, stored per type class pair
+*/
+template<class evaluator,
+         unsigned int compute_virial,
+         unsigned int compute_energy,
+         bool mixed_precision>
+void launch_pair_force_kernel_shift(const pair_args_t& pair_args,
+                                    std::pair<unsigned int, unsigned int> range,
+                                    const typename evaluator::param_type* d_params)
+    {
+    switch (pair_args.shift_mode)
+        {
+    case 0:
+        {
+        launch_pair_force_kernel<evaluator, 0, compute_virial, compute_energy, mixed_precision>(
+            pair_args,
+            range,
+            d_params);
+        break;
+        }
+    case 1:
+        {
+        launch_pair_force_kernel<evaluator, 1, compute_virial, compute_energy, mixed_precision>(
+            pair_args,
+            range,
+            d_params);
+        break;
+        }
+    case 2:
+        {
+        launch_pair_force_kernel<evaluator, 2, compute_virial, compute_energy, mixed_precision>(
+            pair_args,
+            range,
+            d_params);
+        break;
+        }
+    default:
+        break;
+        }
+    }
+
+//! Launch the pair force kernel for the virial and energy flags in \a pair_args
+/*! \param pair_args Other arguments to pass onto the kernel
+    \param range Range of particle indices this GPU operates on
+    \param d_params Parameters for the potential, stored per type class pair
+
+    The virial is only requested together with the energy, so only three of the four combinations
+    are instantiated.
+*/
+template<class evaluator, bool mixed_precision>
+void launch_pair_force_kernel_flags(const pair_args_t& pair_args,
+                                    std::pair<unsigned int, unsigned int> range,
+                                    const typename evaluator::param_type* d_params)
+    {
+    if (pair_args.compute_virial)
+        {
+        launch_pair_force_kernel_shift<evaluator, 1, 1, mixed_precision>(pair_args,
+                                                                         range,
+                                                                         d_params);
+        }
+    else if (pair_args.compute_energy)
+        {
+        launch_pair_force_kernel_shift<evaluator, 0, 1, mixed_precision>(pair_args,
+                                                                         range,
+                                                                         d_params);
+        }
+    else
+        {
+        launch_pair_force_kernel_shift<evaluator, 0, 0, mixed_precision>(pair_args,
+                                                                         range,
+                                                                         d_params);
+        }
+    }
+
 //! Kernel driver that computes lj forces on the GPU for LJForceComputeGPU
 /*! \param pair_args Other arguments to pass onto the kernel
-    \param d_params Parameters for the potential, stored per type pair
+    \param d_params Parameters for the potential, stored per type class pair
 
     This is just a driver function for gpu_compute_pair_forces_shared_kernel(), see it for details.
 */
@@ -536,64 +1292,19 @@ hipError_t gpu_compute_pair_forces(const pair_args_t& pair_args,
         {
         auto range = pair_args.gpu_partition.getRangeAndSetGPU(idev);
 
-        // Launch kernel
-        if (pair_args.compute_virial)
+        // Launch kernel. Evaluators without a single precision evaluation only instantiate the
+        // full precision kernels.
+        if (pair_args.mixed_precision)
             {
-            switch (pair_args.shift_mode)
-                {
-            case 0:
-                {
-                PairForceComputeKernel<evaluator, 0, 1, gpu_pair_force_max_tpp>::launch(pair_args,
-                                                                                        range,
-                                                                                        d_params);
-                break;
-                }
-            case 1:
-                {
-                PairForceComputeKernel<evaluator, 1, 1, gpu_pair_force_max_tpp>::launch(pair_args,
-                                                                                        range,
-                                                                                        d_params);
-                break;
-                }
-            case 2:
-                {
-                PairForceComputeKernel<evaluator, 2, 1, gpu_pair_force_max_tpp>::launch(pair_args,
-                                                                                        range,
-                                                                                        d_params);
-                break;
-                }
-            default:
-                break;
-                }
+            launch_pair_force_kernel_flags<evaluator,
+                                           detail::supports_mixed_precision<evaluator>::value>(
+                pair_args,
+                range,
+                d_params);
             }
         else
             {
-            switch (pair_args.shift_mode)
-                {
-            case 0:
-                {
-                PairForceComputeKernel<evaluator, 0, 0, gpu_pair_force_max_tpp>::launch(pair_args,
-                                                                                        range,
-                                                                                        d_params);
-                break;
-                }
-            case 1:
-                {
-                PairForceComputeKernel<evaluator, 1, 0, gpu_pair_force_max_tpp>::launch(pair_args,
-                                                                                        range,
-                                                                                        d_params);
-                break;
-                }
-            case 2:
-                {
-                PairForceComputeKernel<evaluator, 2, 0, gpu_pair_force_max_tpp>::launch(pair_args,
-                                                                                        range,
-                                                                                        d_params);
-                break;
-                }
-            default:
-                break;
-                }
+            launch_pair_force_kernel_flags<evaluator, false>(pair_args, range, d_params);
             }
         }
 
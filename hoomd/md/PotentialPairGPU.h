@@ -10,6 +10,7 @@
 
 #include <memory>
 
+#include "NeighborListGPUCluster.h"
 #include "PotentialPair.h"
 #include "PotentialPairGPU.cuh"
 
@@ -78,11 +79,20 @@ class PotentialPairGPU : public PotentialPair<evaluator>
         PotentialPair<evaluator>::setAutotunerParams(enable, period);
         m_tuner->setPeriod(period);
         m_tuner->setEnabled(enable);
+        m_tuner_cluster->setPeriod(period);
+        m_tuner_cluster->setEnabled(enable);
+        }
+
+    //! The interior particles are computed while a pending ghost update completes
+    virtual bool overlapsGhostUpdate()
+        {
+        return true;
         }
 
     protected:
-    std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size and threads per particle
-    unsigned int m_param;               //!< Kernel tuning parameter
+    std::unique_ptr<Autotuner> m_tuner;         //!< Autotuner for block size and threads/particle
+    std::unique_ptr<Autotuner> m_tuner_cluster; //!< Autotuner for block size with cluster lists
+    unsigned int m_param;                       //!< Kernel tuning parameter
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
@@ -105,23 +115,33 @@ PotentialPairGPU<evaluator, gpu_cgpf>::PotentialPairGPU(std::shared_ptr<SystemDe
         }
 
     // initialize autotuner
-    // the full block size and threads_per_particle matrix is searched,
-    // encoded as block_size*10000 + threads_per_particle
-    std::vector<unsigned int> valid_params;
+    // the block size and threads_per_particle are searched by coordinate descent
+    std::vector<unsigned int> block_sizes;
     const unsigned int warp_size = this->m_exec_conf->dev_prop.warpSize;
     for (unsigned int block_size = warp_size; block_size <= 1024; block_size += warp_size)
         {
-        for (auto s : Autotuner::getTppListPow2(warp_size))
-            {
-            valid_params.push_back(block_size * 10000 + s);
-            }
+        block_sizes.push_back(block_size);
         }
 
-    m_tuner.reset(
-        new Autotuner(valid_params, 5, 100000, "pair_" + evaluator::getName(), this->m_exec_conf));
+    m_tuner.reset(new Autotuner({block_sizes, Autotuner::getTppListPow2(warp_size)},
+                                nullptr,
+                                5,
+                                100000,
+                                "pair_" + evaluator::getName(),
+                                this->m_exec_conf));
+
+    // the cluster kernel uses one thread per particle
+    m_tuner_cluster.reset(new Autotuner(warp_size,
+                                        1024,
+                                        warp_size,
+                                        5,
+                                        100000,
+                                        "pair_" + evaluator::getName() + "_cluster",
+                                        this->m_exec_conf));
 #ifdef ENABLE_MPI
     // synchronize autotuner results across ranks
     m_tuner->setSync(bool(this->m_pdata->getDomainDecomposition()));
+    m_tuner_cluster->setSync(bool(this->m_pdata->getDomainDecomposition()));
 #endif
     }
 
@@ -145,74 +165,167 @@ void PotentialPairGPU<evaluator, gpu_cgpf>::computeForces(uint64_t timestep)
         throw std::runtime_error("Error computing forces in PotentialPairGPU");
         }
 
-    // access the neighbor list
-    ArrayHandle<unsigned int> d_n_neigh(this->m_nlist->getNNeighArray(),
-                                        access_location::device,
-                                        access_mode::read);
-    ArrayHandle<unsigned int> d_nlist(this->m_nlist->getNListArray(),
-                                      access_location::device,
-                                      access_mode::read);
-    ArrayHandle<size_t> d_head_list(this->m_nlist->getHeadList(),
-                                    access_location::device,
-                                    access_mode::read);
-
-    // access the particle data
-    ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(),
-                               access_location::device,
-                               access_mode::read);
-    ArrayHandle<Scalar> d_diameter(this->m_pdata->getDiameters(),
-                                   access_location::device,
-                                   access_mode::read);
-    ArrayHandle<Scalar> d_charge(this->m_pdata->getCharges(),
-                                 access_location::device,
-                                 access_mode::read);
-
     BoxDim box = this->m_pdata->getBox();
 
-    // access parameters
-    ArrayHandle<Scalar> d_ronsq(this->m_ronsq, access_location::device, access_mode::read);
-    ArrayHandle<Scalar> d_rcutsq(this->m_rcutsq, access_location::device, access_mode::read);
-    ArrayHandle<Scalar4> d_force(this->m_force, access_location::device, access_mode::readwrite);
-    ArrayHandle<Scalar> d_virial(this->m_virial, access_location::device, access_mode::readwrite);
+    // the kernels read the parameters per type class pair
+    this->updateTypeClasses();
 
     // access flags
     PDataFlags flags = this->m_pdata->getFlags();
 
     this->m_exec_conf->beginMultiGPU();
 
-    if (!m_param)
+    // cluster pair lists are walked with one thread per particle
+    unsigned int cluster_size = this->m_nlist->getClusterSize();
+    std::shared_ptr<NeighborListGPUCluster> cluster_nlist;
+    if (cluster_size)
+        cluster_nlist = std::static_pointer_cast<NeighborListGPUCluster>(this->m_nlist);
+
+    // m_param overrides the autotuner, encoded as block_size*10000 + threads_per_particle
+    unsigned int block_size = m_param / 10000;
+    unsigned int threads_per_particle = m_param % 10000;
+    if (!m_param && cluster_size)
+        {
+        this->m_tuner_cluster->begin();
+        block_size = this->m_tuner_cluster->getParam();
+        threads_per_particle = 1;
+        }
+    else if (!m_param)
+        {
         this->m_tuner->begin();
-    unsigned int param = !m_param ? this->m_tuner->getParam() : m_param;
-    unsigned int block_size = param / 10000;
-    unsigned int threads_per_particle = param % 10000;
-
-    gpu_cgpf(kernel::pair_args_t(d_force.data,
-                                 d_virial.data,
-                                 this->m_virial.getPitch(),
-                                 this->m_pdata->getN(),
-                                 this->m_pdata->getMaxN(),
-                                 d_pos.data,
-                                 d_diameter.data,
-                                 d_charge.data,
-                                 box,
-                                 d_n_neigh.data,
-                                 d_nlist.data,
-                                 d_head_list.data,
-                                 d_rcutsq.data,
-                                 d_ronsq.data,
-                                 this->m_nlist->getNListArray().getPitch(),
-                                 this->m_pdata->getNTypes(),
-                                 block_size,
-                                 this->m_shift_mode,
-                                 flags[pdata_flag::pressure_tensor],
-                                 threads_per_particle,
-                                 this->m_pdata->getGPUPartition(),
-                                 this->m_exec_conf->dev_prop),
-             this->m_params.data());
+        std::vector<unsigned int> param = this->m_tuner->getParams();
+        block_size = param[0];
+        threads_per_particle = param[1];
+        }
+
+    // the array handles are scoped to a single launch so that a pending ghost update can complete
+    // in between the interior and boundary phases
+    auto launch_pair_kernel = [&](unsigned int ghost_phase)
+    {
+        // access the neighbor list
+        ArrayHandle<unsigned int> d_n_neigh(this->m_nlist->getNNeighArray(),
+                                            access_location::device,
+                                            access_mode::read);
+        ArrayHandle<unsigned int> d_nlist(this->m_nlist->getCompressedNListArray(),
+                                          access_location::device,
+                                          access_mode::read);
+        ArrayHandle<unsigned int> d_n_outliers(this->m_nlist->getNOutliersArray(),
+                                               access_location::device,
+                                               access_mode::read);
+        ArrayHandle<size_t> d_head_list(this->m_nlist->getHeadList(),
+                                        access_location::device,
+                                        access_mode::read);
+
+        // access the cluster pair list
+        const ArrayHandle<unsigned int>& d_cluster_n_neigh = cluster_nlist
+            ? ArrayHandle<unsigned int>(cluster_nlist->getClusterNNeighArray(),
+                                        access_location::device,
+                                        access_mode::read)
+            : ArrayHandle<unsigned int>(GlobalArray<unsigned int>(),
+                                        access_location::device,
+                                        access_mode::read);
+        const ArrayHandle<unsigned int>& d_cluster_nlist = cluster_nlist
+            ? ArrayHandle<unsigned int>(cluster_nlist->getClusterNListArray(),
+                                        access_location::device,
+                                        access_mode::read)
+            : ArrayHandle<unsigned int>(GlobalArray<unsigned int>(),
+                                        access_location::device,
+                                        access_mode::read);
+        const ArrayHandle<unsigned long long>& d_cluster_mask = cluster_nlist
+            ? ArrayHandle<unsigned long long>(cluster_nlist->getClusterMaskArray(),
+                                              access_location::device,
+                                              access_mode::read)
+            : ArrayHandle<unsigned long long>(GlobalArray<unsigned long long>(),
+                                              access_location::device,
+                                              access_mode::read);
+
+        // access the particle data
+        ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::read);
+        ArrayHandle<Scalar> d_diameter(this->m_pdata->getDiameters(),
+                                       access_location::device,
+                                       access_mode::read);
+        ArrayHandle<Scalar> d_charge(this->m_pdata->getCharges(),
+                                     access_location::device,
+                                     access_mode::read);
+
+        // access parameters
+        ArrayHandle<Scalar> d_ronsq(this->m_class_ronsq,
+                                    access_location::device,
+                                    access_mode::read);
+        ArrayHandle<Scalar> d_rcutsq(this->m_class_rcutsq,
+                                     access_location::device,
+                                     access_mode::read);
+        ArrayHandle<unsigned int> d_type_class(this->m_type_class,
+                                               access_location::device,
+                                               access_mode::read);
+        ArrayHandle<Scalar4> d_force(this->m_force,
+                                     access_location::device,
+                                     access_mode::readwrite);
+        ArrayHandle<Scalar> d_virial(this->m_virial,
+                                     access_location::device,
+                                     access_mode::readwrite);
+
+        // the kernels start after the neighbor list build and copies on the default stream
+        this->waitDefaultStream();
+        gpu_cgpf(kernel::pair_args_t(d_force.data,
+                                     d_virial.data,
+                                     this->m_virial.getPitch(),
+                                     this->m_pdata->getN(),
+                                     this->m_pdata->getMaxN(),
+                                     d_pos.data,
+                                     d_diameter.data,
+                                     d_charge.data,
+                                     box,
+                                     d_n_neigh.data,
+                                     d_nlist.data,
+                                     d_head_list.data,
+                                     d_rcutsq.data,
+                                     d_ronsq.data,
+                                     this->m_nlist->getCompressedNListArray().getPitch(),
+                                     this->m_pdata->getNTypes(),
+                                     d_type_class.data,
+                                     this->m_n_type_classes,
+                                     block_size,
+                                     this->m_shift_mode,
+                                     flags[pdata_flag::pressure_tensor],
+                                     flags[pdata_flag::potential_energy],
+                                     threads_per_particle,
+                                     this->m_pdata->getGPUPartition(),
+                                     this->m_exec_conf->dev_prop,
+                                     ghost_phase,
+                                     cluster_size,
+                                     d_cluster_n_neigh.data,
+                                     d_cluster_nlist.data,
+                                     d_cluster_mask.data,
+                                     cluster_nlist ? cluster_nlist->getClusterNmax() : 0,
+                                     this->m_nlist->getCompress() ? d_n_outliers.data : nullptr,
+                                     this->m_mixed_precision,
+                                     this->m_stream),
+                 this->m_class_params.data());
+    };
+
+#ifdef ENABLE_MPI
+    if (this->m_comm && this->m_comm->isGhostUpdatePending())
+        {
+        // interior particles do not depend on ghost positions, compute them while the ghost
+        // update is in flight, then wait for it to complete and compute the boundary particles
+        launch_pair_kernel(1);
+        this->m_comm->finishUpdateGhosts(timestep);
+        launch_pair_kernel(2);
+        }
+    else
+#endif
+        {
+        launch_pair_kernel(0);
+        }
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
-    if (!m_param)
+    if (!m_param && cluster_size)
+        this->m_tuner_cluster->end();
+    else if (!m_param)
         this->m_tuner->end();
 
     this->m_exec_conf->endMultiGPU();
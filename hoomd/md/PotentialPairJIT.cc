@@ -0,0 +1,97 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "PotentialPairJIT.h"
+
+#include <pybind11/stl.h>
+
+#include <sstream>
+
+/*! \file PotentialPairJIT.cc
+    \brief Defines the pair potential with an evaluator compiled at run time
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System to compute forces on
+    \param nlist Neighborlist to use for computing the forces
+    \param cpu_code C++ code to compile
+    \param compiler_args Additional arguments to pass to the compiler
+    \param param_array Values for the parameter array
+
+    After construction, the C++ code is compiled, and the potential is ready to compute forces.
+*/
+PotentialPairJIT::PotentialPairJIT(std::shared_ptr<SystemDefinition> sysdef,
+                                   std::shared_ptr<NeighborList> nlist,
+                                   const std::string& cpu_code,
+                                   const std::vector<std::string>& compiler_args,
+                                   pybind11::array_t<float> param_array)
+    : PotentialPair<EvaluatorPairJIT>(sysdef, nlist),
+      m_param_array(param_array.data(),
+                    param_array.data() + param_array.size(),
+                    hoomd::detail::managed_allocator<float>(m_exec_conf->isCUDAEnabled()))
+    {
+    m_exec_conf->msg->notice(5) << "Constructing PotentialPairJIT" << std::endl;
+
+    // build the JIT.
+    m_factory = std::make_shared<PairEvalFactory>(cpu_code,
+                                                  compiler_args,
+                                                  m_exec_conf->getJITCacheDir());
+
+    // get the evaluator
+    m_eval = m_factory->getEval();
+
+    if (!m_eval)
+        {
+        std::ostringstream s;
+        s << "Error compiling JIT code:" << std::endl;
+        s << cpu_code << std::endl;
+        s << m_factory->getError() << std::endl;
+        throw std::runtime_error(s.str());
+        }
+
+    m_factory->setParamArray(m_param_array.data());
+    setEvalParams();
+    }
+
+PotentialPairJIT::~PotentialPairJIT()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying PotentialPairJIT" << std::endl;
+    }
+
+/*! The parameters of the pair (i, j) hold the types in that order, so the compiled function
+    receives the types of the particles it is called with.
+*/
+void PotentialPairJIT::setEvalParams()
+    {
+    const unsigned int n_types = m_pdata->getNTypes();
+    for (unsigned int i = 0; i < n_types; i++)
+        {
+        for (unsigned int j = 0; j < n_types; j++)
+            {
+            m_params[m_typpair_idx(i, j)] = EvaluatorPairJIT::param_type(m_eval, i, j);
+            }
+        }
+    m_type_classes_changed = true;
+    }
+
+namespace detail
+    {
+void export_PotentialPairJIT(pybind11::module& m)
+    {
+    pybind11::class_<PotentialPairJIT,
+                     PotentialPair<EvaluatorPairJIT>,
+                     std::shared_ptr<PotentialPairJIT>>(m, "PotentialPairJIT")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<NeighborList>,
+                            const std::string&,
+                            const std::vector<std::string>&,
+                            pybind11::array_t<float>>())
+        .def_property_readonly("param_array", &PotentialPairJIT::getParamArray);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,78 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __POTENTIAL_PAIR_JIT_H__
+#define __POTENTIAL_PAIR_JIT_H__
+
+#include "EvaluatorPairJIT.h"
+#include "PairEvalFactory.h"
+#include "PotentialPair.h"
+
+#include "hoomd/managed_allocator.h"
+
+#include <pybind11/numpy.h>
+
+/*! \file PotentialPairJIT.h
+    \brief Declares the pair potential with an evaluator compiled at run time
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Pair potential with an evaluator compiled at run time
+/*! The user provides C++ code that defines the symbols in PairJITABI.h. On construction, this
+    class compiles the code with LLVM and stores the resulting function pointer in the parameters
+    of every type pair. PotentialPair<EvaluatorPairJIT> then computes the forces with the same
+    neighbor loop, type classes, cutoffs, and energy shifting modes as the built-in potentials,
+    so adding a potential requires neither a plugin nor a rebuild of HOOMD-blue.
+
+    The adjustable parameters are stored in m_param_array, which the compiled code reads through
+    its param_array pointer. Python may modify the values in place between steps.
+*/
+class PYBIND11_EXPORT PotentialPairJIT : public PotentialPair<EvaluatorPairJIT>
+    {
+    public:
+    //! Constructor
+    PotentialPairJIT(std::shared_ptr<SystemDefinition> sysdef,
+                     std::shared_ptr<NeighborList> nlist,
+                     const std::string& cpu_code,
+                     const std::vector<std::string>& compiler_args,
+                     pybind11::array_t<float> param_array);
+
+    //! Destructor
+    virtual ~PotentialPairJIT();
+
+    //! Access the parameter array from python without copies
+    static pybind11::object getParamArray(pybind11::object self)
+        {
+        auto self_cpp = self.cast<PotentialPairJIT*>();
+        return pybind11::array(self_cpp->m_param_array.size(),
+                               self_cpp->m_factory->getParamArray(),
+                               self);
+        }
+
+    protected:
+    std::shared_ptr<PairEvalFactory> m_factory; //!< The factory for the evaluator function
+    PairJITEvalFn m_eval; //!< Pointer to evaluator function inside the JIT module
+    std::vector<float, hoomd::detail::managed_allocator<float>>
+        m_param_array; //!< Array containing adjustable parameters
+
+    //! Store the evaluator in the parameters of every type pair
+    void setEvalParams();
+    };
+
+namespace detail
+    {
+//! Exports the PotentialPairJIT class to python
+void export_PotentialPairJIT(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __POTENTIAL_PAIR_JIT_H__
@@ -4,10 +4,12 @@
 #ifndef __POTENTIAL_TERSOFF_H__
 #define __POTENTIAL_TERSOFF_H__
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
+#include <vector>
 
 #include "NeighborList.h"
 #include "hoomd/ForceCompute.h"
@@ -123,6 +125,16 @@ template<class evaluator> class PotentialTersoff : public ForceCompute
     // r_cut (not squared) given to the neighborlist
     std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;
 
+    //! Neighbor of the current particle inside the largest cutoff of its type
+    struct ShortNeighbor
+        {
+        unsigned int idx;  //!< Index of the neighbor
+        unsigned int type; //!< Type of the neighbor
+        Scalar3 dx;        //!< Minimum image separation from the current particle to the neighbor
+        Scalar rsq;        //!< Squared distance to the neighbor
+        };
+    std::vector<ShortNeighbor> m_short_nlist; //!< Short neighbor list of the current particle
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
     };
@@ -583,6 +595,17 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
 
         unsigned int ntypes = m_pdata->getNTypes();
 
+        // largest cutoff of each type, which bounds both the ij and the ik distances
+        std::vector<Scalar> rcutsq_max(ntypes, Scalar(0.0));
+        for (unsigned int typ_a = 0; typ_a < ntypes; ++typ_a)
+            {
+            for (unsigned int typ_b = 0; typ_b < ntypes; ++typ_b)
+                {
+                rcutsq_max[typ_a]
+                    = std::max(rcutsq_max[typ_a], h_rcutsq.data[m_typpair_idx(typ_a, typ_b)]);
+                }
+            }
+
         // for each particle
         for (int i = 0; i < (int)m_pdata->getN(); i++)
             {
@@ -612,30 +635,42 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
                 phi_ab[typ_b] = Scalar(0.0);
                 }
 
-            // all neighbors of this particle
-            const unsigned int size = (unsigned int)h_n_neigh.data[i];
-            if (evaluator::hasPerParticleEnergy())
+            // build the short list of neighbors once, so that the pair and triplet loops below
+            // do not repeat the position loads and minimum image conventions
+            m_short_nlist.clear();
+            const unsigned int n_neigh = (unsigned int)h_n_neigh.data[i];
+            for (unsigned int j = 0; j < n_neigh; j++)
                 {
-                for (unsigned int j = 0; j < size; j++)
-                    {
-                    // access the index of neighbor j (MEM TRANSFER: 1 scalar)
-                    unsigned int jj = h_nlist.data[head_i + j];
-                    assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
-
-                    // access the position and type of particle j
-                    Scalar3 posj
-                        = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
-                    unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
-                    assert(typej < m_pdata->getNTypes());
+                // access the index of neighbor j (MEM TRANSFER: 1 scalar)
+                unsigned int jj = h_nlist.data[head_i + j];
+                assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
 
-                    // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                    Scalar3 dxij = posi - posj;
+                // calculate dr_ij and apply periodic boundary conditions
+                Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
+                Scalar3 dxij = box.minImage(posi - posj);
+                Scalar rij_sq = dot(dxij, dxij);
 
-                    // apply periodic boundary conditions
-                    dxij = box.minImage(dxij);
+                if (rij_sq < rcutsq_max[typei])
+                    {
+                    ShortNeighbor neigh;
+                    neigh.idx = jj;
+                    neigh.type = __scalar_as_int(h_pos.data[jj].w);
+                    neigh.dx = dxij;
+                    neigh.rsq = rij_sq;
+                    assert(neigh.type < m_pdata->getNTypes());
+                    m_short_nlist.push_back(neigh);
+                    }
+                }
 
-                    // compute rij_sq (FLOPS: 5)
-                    Scalar rij_sq = dot(dxij, dxij);
+            // all neighbors of this particle inside the cutoff
+            const unsigned int size = (unsigned int)m_short_nlist.size();
+            if (evaluator::hasPerParticleEnergy())
+                {
+                for (unsigned int j = 0; j < size; j++)
+                    {
+                    // access the type and distance of neighbor j
+                    unsigned int typej = m_short_nlist[j].type;
+                    Scalar rij_sq = m_short_nlist[j].rsq;
 
                     // get parameters for this type pair
                     unsigned int typpair_idx = m_typpair_idx(typei, typej);
@@ -663,28 +698,17 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
             // loop over all of the neighbors of this particle
             for (unsigned int j = 0; j < size; j++)
                 {
-                // access the index of neighbor j (MEM TRANSFER: 1 scalar)
-                unsigned int jj = h_nlist.data[head_i + j];
-                assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
-
-                // access the position and type of particle j
-                Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
-                unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
-                assert(typej < m_pdata->getNTypes());
+                // access the index, type, and separation of neighbor j
+                const ShortNeighbor& neigh_j = m_short_nlist[j];
+                unsigned int jj = neigh_j.idx;
+                unsigned int typej = neigh_j.type;
+                Scalar3 dxij = neigh_j.dx;
+                Scalar rij_sq = neigh_j.rsq;
 
                 // initialize the current force and potential energy of particle j to 0
                 Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
                 Scalar pej = 0.0;
 
-                // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                Scalar3 dxij = posi - posj;
-
-                // apply periodic boundary conditions
-                dxij = box.minImage(dxij);
-
-                // compute rij_sq (FLOPS: 5)
-                Scalar rij_sq = dot(dxij, dxij);
-
                 // get parameters for this type pair
                 unsigned int typpair_idx = m_typpair_idx(typei, typej);
                 param_type param = h_params.data[typpair_idx];
@@ -711,16 +735,10 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
                         {
                         for (unsigned int k = 0; k < size; k++)
                             {
-                            // access the index of neighbor k
-                            unsigned int kk = h_nlist.data[head_i + k];
-                            assert(kk < m_pdata->getN());
-
-                            // access the position and type of neighbor k
-                            Scalar3 posk = make_scalar3(h_pos.data[kk].x,
-                                                        h_pos.data[kk].y,
-                                                        h_pos.data[kk].z);
-                            unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
-                            assert(typek < m_pdata->getNTypes());
+                            // access the index and type of neighbor k
+                            const ShortNeighbor& neigh_k = m_short_nlist[k];
+                            unsigned int kk = neigh_k.idx;
+                            unsigned int typek = neigh_k.type;
 
                             // access the type pair parameters for i and k
                             typpair_idx = m_typpair_idx(typei, typek);
@@ -731,14 +749,9 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
 
                             if (kk != jj && temp_evaluated)
                                 {
-                                // compute drik
-                                Scalar3 dxik = posi - posk;
-
-                                // apply periodic boundary conditions
-                                dxik = box.minImage(dxik);
-
-                                // compute rik_sq
-                                Scalar rik_sq = dot(dxik, dxik);
+                                // separation of neighbor k
+                                Scalar3 dxik = neigh_k.dx;
+                                Scalar rik_sq = neigh_k.rsq;
 
                                 // compute the bond angle (if needed)
                                 Scalar cos_th = Scalar(0.0);
@@ -798,16 +811,10 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
                         // evaluate the force from the ik interactions
                         for (unsigned int k = 0; k < size; k++)
                             {
-                            // access the index of neighbor k
-                            unsigned int kk = h_nlist.data[head_i + k];
-                            assert(kk < m_pdata->getN());
-
-                            // access the position and type of neighbor k
-                            Scalar3 posk = make_scalar3(h_pos.data[kk].x,
-                                                        h_pos.data[kk].y,
-                                                        h_pos.data[kk].z);
-                            unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
-                            assert(typek < m_pdata->getNTypes());
+                            // access the index and type of neighbor k
+                            const ShortNeighbor& neigh_k = m_short_nlist[k];
+                            unsigned int kk = neigh_k.idx;
+                            unsigned int typek = neigh_k.type;
 
                             // access the type pair parameters for i and k
                             typpair_idx = m_typpair_idx(typei, typek);
@@ -821,14 +828,9 @@ template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64
                                 // create variable for the force on k
                                 Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
 
-                                // compute dr_ik
-                                Scalar3 dxik = posi - posk;
-
-                                // apply periodic boundary conditions
-                                dxik = box.minImage(dxik);
-
-                                // compute rik_sq
-                                Scalar rik_sq = dot(dxik, dxik);
+                                // separation of neighbor k
+                                Scalar3 dxik = neigh_k.dx;
+                                Scalar rik_sq = neigh_k.rsq;
 
                                 // compute the bond angle (if needed)
                                 Scalar cos_th = Scalar(0.0);
@@ -0,0 +1,233 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file RadialDistributionFunction.cc
+    \brief Contains code for the RadialDistributionFunction class
+*/
+
+#include "RadialDistributionFunction.h"
+#include "NeighborListCompression.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#include <pybind11/stl.h>
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System to compute the radial distribution function of
+    \param nlist Neighbor list to read the pairs from
+    \param r_max Maximum pair distance
+    \param bins Number of bins between 0 and r_max
+*/
+RadialDistributionFunction::RadialDistributionFunction(std::shared_ptr<SystemDefinition> sysdef,
+                                                       std::shared_ptr<NeighborList> nlist,
+                                                       Scalar r_max,
+                                                       unsigned int bins)
+    : Analyzer(sysdef), m_nlist(nlist), m_r_max(r_max), m_bins(bins), m_num_frames(0),
+      m_sum_n_rho(0.0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing RadialDistributionFunction" << endl;
+
+    if (!(r_max > Scalar(0.0)))
+        throw std::invalid_argument("r_max must be positive.");
+    if (bins == 0)
+        throw std::invalid_argument("bins must be positive.");
+
+    GlobalArray<unsigned long long> counts(m_bins, m_exec_conf);
+    m_counts.swap(counts);
+    TAG_ALLOCATION(m_counts);
+    reset();
+
+    // request pairs up to r_max between all types from the neighbor list
+    unsigned int n_types = m_pdata->getNTypes();
+    m_r_cut_nlist = std::make_shared<GlobalArray<Scalar>>(n_types * n_types, m_exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut_nlist(*m_r_cut_nlist,
+                                          access_location::host,
+                                          access_mode::overwrite);
+        for (unsigned int i = 0; i < n_types * n_types; i++)
+            h_r_cut_nlist.data[i] = m_r_max;
+        }
+    m_nlist->addRCutMatrix(m_r_cut_nlist);
+    }
+
+RadialDistributionFunction::~RadialDistributionFunction()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying RadialDistributionFunction" << endl;
+
+    if (m_attached)
+        {
+        m_nlist->removeRCutMatrix(m_r_cut_nlist);
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void RadialDistributionFunction::analyze(uint64_t timestep)
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "RDF");
+
+    m_nlist->compute(timestep);
+    accumulate();
+
+    double n_global = double(m_pdata->getNGlobal());
+    bool twod = m_sysdef->getNDimensions() == 2;
+    m_sum_n_rho += n_global * n_global / double(m_pdata->getGlobalBox().getVolume(twod));
+    m_num_frames++;
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+/*! Each local particle counts its neighbors closer than r_max. A half neighbor list stores local
+    pairs only once, so they count twice. Pairs with ghost particles are stored once on each rank
+    in both storage modes and count once.
+*/
+void RadialDistributionFunction::accumulate()
+    {
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getCompressedNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<unsigned int> h_n_outliers(m_nlist->getNOutliersArray(),
+                                           access_location::host,
+                                           access_mode::read);
+    ArrayHandle<size_t> h_head_list(m_nlist->getHeadList(),
+                                    access_location::host,
+                                    access_mode::read);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned long long> h_counts(m_counts,
+                                             access_location::host,
+                                             access_mode::readwrite);
+
+    const bool compress = m_nlist->getCompress();
+    const bool half = m_nlist->getStorageMode() == NeighborList::half;
+    const BoxDim box = m_pdata->getBox();
+    const unsigned int N = m_pdata->getN();
+    const Scalar r_max_sq = m_r_max * m_r_max;
+    const Scalar bins_per_r = Scalar(m_bins) / m_r_max;
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        const unsigned int* nlist_i = h_nlist.data + h_head_list.data[i];
+        const unsigned int size = h_n_neigh.data[i];
+        const unsigned int n_outliers = compress ? h_n_outliers.data[i] : size;
+
+        for (unsigned int k = 0; k < size; k++)
+            {
+            unsigned int j = detail::nlist_get_neighbor(nlist_i, i, n_outliers, k);
+            Scalar3 dx = pi - make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            dx = box.minImage(dx);
+            Scalar rsq = dot(dx, dx);
+
+            // the neighbor list includes the buffer
+            if (rsq >= r_max_sq)
+                continue;
+
+            unsigned int bin = (unsigned int)(fast::sqrt(rsq) * bins_per_r);
+            if (bin >= m_bins)
+                continue;
+
+            h_counts.data[bin] += (half && j < N) ? 2 : 1;
+            }
+        }
+    }
+
+std::vector<Scalar> RadialDistributionFunction::getBinCenters()
+    {
+    std::vector<Scalar> centers(m_bins);
+    Scalar dr = m_r_max / Scalar(m_bins);
+    for (unsigned int b = 0; b < m_bins; b++)
+        centers[b] = (Scalar(b) + Scalar(0.5)) * dr;
+    return centers;
+    }
+
+/*! \returns g(r) in each bin, 0 when no frames have been accumulated
+
+    In MPI simulations, all ranks must call getRDF() to sum the histograms of all ranks.
+*/
+std::vector<Scalar> RadialDistributionFunction::getRDF()
+    {
+    std::vector<unsigned long long> counts(m_bins);
+        {
+        ArrayHandle<unsigned long long> h_counts(m_counts,
+                                                 access_location::host,
+                                                 access_mode::read);
+        std::copy(h_counts.data, h_counts.data + m_bins, counts.begin());
+        }
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      counts.data(),
+                      m_bins,
+                      MPI_UNSIGNED_LONG_LONG,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    std::vector<Scalar> rdf(m_bins, Scalar(0.0));
+    if (m_num_frames == 0)
+        return rdf;
+
+    bool twod = m_sysdef->getNDimensions() == 2;
+    double dr = double(m_r_max) / double(m_bins);
+    for (unsigned int b = 0; b < m_bins; b++)
+        {
+        double r_lo = double(b) * dr;
+        double r_hi = r_lo + dr;
+        double shell = twod ? M_PI * (r_hi * r_hi - r_lo * r_lo)
+                            : 4.0 / 3.0 * M_PI * (r_hi * r_hi * r_hi - r_lo * r_lo * r_lo);
+        rdf[b] = Scalar(double(counts[b]) / (m_sum_n_rho * shell));
+        }
+    return rdf;
+    }
+
+void RadialDistributionFunction::reset()
+    {
+    ArrayHandle<unsigned long long> h_counts(m_counts,
+                                             access_location::host,
+                                             access_mode::overwrite);
+    for (unsigned int b = 0; b < m_bins; b++)
+        h_counts.data[b] = 0;
+
+    m_num_frames = 0;
+    m_sum_n_rho = 0.0;
+    }
+
+namespace detail
+    {
+void export_RadialDistributionFunction(pybind11::module& m)
+    {
+    pybind11::class_<RadialDistributionFunction,
+                     Analyzer,
+                     std::shared_ptr<RadialDistributionFunction>>(m, "RadialDistributionFunction")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<NeighborList>,
+                            Scalar,
+                            unsigned int>())
+        .def_property_readonly("r_max", &RadialDistributionFunction::getRMax)
+        .def_property_readonly("bins", &RadialDistributionFunction::getBins)
+        .def_property_readonly("num_frames", &RadialDistributionFunction::getNumFrames)
+        .def("getBinCenters", &RadialDistributionFunction::getBinCenters)
+        .def("getRDF", &RadialDistributionFunction::getRDF)
+        .def("reset", &RadialDistributionFunction::reset);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
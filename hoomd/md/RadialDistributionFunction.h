@@ -0,0 +1,122 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "NeighborList.h"
+#include "hoomd/Analyzer.h"
+#include "hoomd/GlobalArray.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file RadialDistributionFunction.h
+    \brief Declares a class that accumulates the radial distribution function during a run
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __RADIAL_DISTRIBUTION_FUNCTION_H__
+#define __RADIAL_DISTRIBUTION_FUNCTION_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Accumulates the radial distribution function of all particles during a run
+/*! Every time analyze() is called, RadialDistributionFunction adds the distances of all pairs of
+    particles closer than r_max to a histogram. The pairs are read from a neighbor list, typically
+    the one the pair forces already build: RadialDistributionFunction gives the neighbor list an
+    r_cut matrix of r_max, so no additional pair search is needed when r_max does not exceed the
+    cutoffs of the pair forces. Pairs that the neighbor list excludes (e.g. bonded particles) are
+    not counted.
+
+    The histogram counts ordered pairs (each pair i,j counts for both i and j) and stays in
+    m_counts, which GPU implementations update on the device. It is only read when the averaged
+    g(r) = n(r) / (sum over frames of N rho * V_shell(r)) is requested with getRDF(). N rho is
+    summed per frame so that the average is correct in changing boxes.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT RadialDistributionFunction : public Analyzer
+    {
+    public:
+    //! Constructs the analyzer
+    RadialDistributionFunction(std::shared_ptr<SystemDefinition> sysdef,
+                               std::shared_ptr<NeighborList> nlist,
+                               Scalar r_max,
+                               unsigned int bins);
+
+    //! Destructor
+    virtual ~RadialDistributionFunction();
+
+    //! Add the pair distances of the current configuration to the histogram
+    virtual void analyze(uint64_t timestep);
+
+    /// Remove the r_cut matrix from the neighbor list
+    virtual void notifyDetach()
+        {
+        if (m_attached)
+            {
+            m_nlist->removeRCutMatrix(m_r_cut_nlist);
+            }
+        m_attached = false;
+        }
+
+    //! Get the maximum pair distance
+    Scalar getRMax()
+        {
+        return m_r_max;
+        }
+
+    //! Get the number of bins
+    unsigned int getBins()
+        {
+        return m_bins;
+        }
+
+    //! Get the number of accumulated frames
+    uint64_t getNumFrames()
+        {
+        return m_num_frames;
+        }
+
+    //! Get the centers of the bins
+    std::vector<Scalar> getBinCenters();
+
+    //! Get the radial distribution function averaged over the accumulated frames
+    std::vector<Scalar> getRDF();
+
+    //! Discard the accumulated frames
+    void reset();
+
+    protected:
+    std::shared_ptr<NeighborList> m_nlist; //!< Neighbor list to read the pairs from
+    Scalar m_r_max;                        //!< Maximum pair distance
+    unsigned int m_bins;                   //!< Number of bins
+    GlobalArray<unsigned long long> m_counts; //!< Number of ordered pairs in each bin (local)
+    uint64_t m_num_frames;                    //!< Number of accumulated frames
+    double m_sum_n_rho; //!< Sum of N^2/V (N^2/A in 2D) over the accumulated frames
+
+    /// r_cut (not squared) given to the neighbor list
+    std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;
+
+    /// Track whether we have attached to the Simulation object
+    bool m_attached = true;
+
+    //! Add the pairs of the local particles to m_counts
+    virtual void accumulate();
+    };
+
+namespace detail
+    {
+//! Exports the RadialDistributionFunction class to python
+void export_RadialDistributionFunction(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -0,0 +1,102 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file RadialDistributionFunctionGPU.cc
+    \brief Contains code for the RadialDistributionFunctionGPU class
+*/
+
+#include "RadialDistributionFunctionGPU.h"
+#include "RadialDistributionFunctionGPU.cuh"
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System to compute the radial distribution function of
+    \param nlist Neighbor list to read the pairs from
+    \param r_max Maximum pair distance
+    \param bins Number of bins between 0 and r_max
+*/
+RadialDistributionFunctionGPU::RadialDistributionFunctionGPU(
+    std::shared_ptr<SystemDefinition> sysdef,
+    std::shared_ptr<NeighborList> nlist,
+    Scalar r_max,
+    unsigned int bins)
+    : RadialDistributionFunction(sysdef, nlist, r_max, bins)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error()
+            << "Creating a RadialDistributionFunctionGPU with no GPU in the execution configuration"
+            << endl;
+        throw std::runtime_error("Error initializing RadialDistributionFunctionGPU");
+        }
+
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner.reset(new Autotuner(warp_size, 1024, warp_size, 5, 100000, "rdf", m_exec_conf));
+    }
+
+RadialDistributionFunctionGPU::~RadialDistributionFunctionGPU() { }
+
+void RadialDistributionFunctionGPU::accumulate()
+    {
+    ArrayHandle<unsigned int> d_n_neigh(m_nlist->getNNeighArray(),
+                                        access_location::device,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> d_nlist(m_nlist->getCompressedNListArray(),
+                                      access_location::device,
+                                      access_mode::read);
+    ArrayHandle<unsigned int> d_n_outliers(m_nlist->getNOutliersArray(),
+                                           access_location::device,
+                                           access_mode::read);
+    ArrayHandle<size_t> d_head_list(m_nlist->getHeadList(),
+                                    access_location::device,
+                                    access_mode::read);
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned long long> d_counts(m_counts,
+                                             access_location::device,
+                                             access_mode::readwrite);
+
+    // collect the counts of a block in shared memory when the histogram fits
+    bool shared_histogram
+        = m_bins * sizeof(unsigned int) <= m_exec_conf->dev_prop.sharedMemPerBlock / 2;
+
+    m_tuner->begin();
+    kernel::gpu_rdf_accumulate(d_counts.data,
+                               d_pos.data,
+                               d_n_neigh.data,
+                               d_nlist.data,
+                               m_nlist->getCompress() ? d_n_outliers.data : nullptr,
+                               d_head_list.data,
+                               m_pdata->getBox(),
+                               m_pdata->getN(),
+                               m_nlist->getStorageMode() == NeighborList::half,
+                               m_r_max,
+                               m_bins,
+                               shared_histogram,
+                               m_tuner->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner->end();
+    }
+
+namespace detail
+    {
+void export_RadialDistributionFunctionGPU(pybind11::module& m)
+    {
+    pybind11::class_<RadialDistributionFunctionGPU,
+                     RadialDistributionFunction,
+                     std::shared_ptr<RadialDistributionFunctionGPU>>(
+        m,
+        "RadialDistributionFunctionGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<NeighborList>,
+                            Scalar,
+                            unsigned int>());
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
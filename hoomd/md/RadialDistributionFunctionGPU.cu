@@ -0,0 +1,172 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "RadialDistributionFunctionGPU.cuh"
+
+#include <assert.h>
+
+/*! \file RadialDistributionFunctionGPU.cu
+    \brief Defines GPU kernel code for accumulating the radial distribution function on the GPU.
+   Used by RadialDistributionFunctionGPU.
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Add the pair distances of the local particles to a histogram
+/*! \param d_counts Histogram of ordered pairs to add to
+    \param d_pos Particle positions, including ghosts
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_nlist Neighbor list
+    \param d_n_outliers Outliers in a compressed d_nlist, nullptr if uncompressed
+    \param d_head_list Head of the neighbors of each particle in d_nlist
+    \param box Local simulation box
+    \param N Number of local particles
+    \param half True if d_nlist stores each local pair only once
+    \param r_max Maximum pair distance
+    \param bins Number of bins
+    \param shared_histogram True to collect the block's counts in shared memory first
+
+    One thread is executed per local particle. With \a shared_histogram, the block collects its
+   counts in bins*sizeof(unsigned int) bytes of dynamic shared memory and adds them to d_counts
+   once, so that the global atomics scale with the number of bins instead of the number of pairs.
+*/
+__global__ void gpu_rdf_accumulate_kernel(unsigned long long* d_counts,
+                                          const Scalar4* d_pos,
+                                          const unsigned int* d_n_neigh,
+                                          const unsigned int* d_nlist,
+                                          const unsigned int* d_n_outliers,
+                                          const size_t* d_head_list,
+                                          const BoxDim box,
+                                          unsigned int N,
+                                          bool half,
+                                          Scalar r_max,
+                                          unsigned int bins,
+                                          bool shared_histogram)
+    {
+    extern __shared__ unsigned int rdf_sdata[];
+
+    if (shared_histogram)
+        {
+        for (unsigned int b = threadIdx.x; b < bins; b += blockDim.x)
+            rdf_sdata[b] = 0;
+        __syncthreads();
+        }
+
+    unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (i < N)
+        {
+        Scalar4 postype_i = d_pos[i];
+        Scalar3 pi = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
+        const unsigned int* nlist_i = d_nlist + d_head_list[i];
+        unsigned int size = d_n_neigh[i];
+        unsigned int n_outliers = d_n_outliers ? d_n_outliers[i] : size;
+        Scalar r_max_sq = r_max * r_max;
+        Scalar bins_per_r = Scalar(bins) / r_max;
+
+        for (unsigned int k = 0; k < size; k++)
+            {
+            unsigned int j = k < n_outliers
+                                 ? nlist_i[k]
+                                 : i + reinterpret_cast<const short*>(nlist_i)[n_outliers + k];
+            Scalar4 postype_j = d_pos[j];
+            Scalar3 dx = pi - make_scalar3(postype_j.x, postype_j.y, postype_j.z);
+            dx = box.minImage(dx);
+            Scalar rsq = dot(dx, dx);
+
+            // the neighbor list includes the buffer
+            if (rsq >= r_max_sq)
+                continue;
+
+            unsigned int bin = (unsigned int)(fast::sqrt(rsq) * bins_per_r);
+            if (bin >= bins)
+                continue;
+
+            unsigned int weight = (half && j < N) ? 2 : 1;
+            if (shared_histogram)
+                atomicAdd(&rdf_sdata[bin], weight);
+            else
+                atomicAdd(&d_counts[bin], (unsigned long long)weight);
+            }
+        }
+
+    if (shared_histogram)
+        {
+        __syncthreads();
+        for (unsigned int b = threadIdx.x; b < bins; b += blockDim.x)
+            {
+            if (rdf_sdata[b])
+                atomicAdd(&d_counts[b], (unsigned long long)rdf_sdata[b]);
+            }
+        }
+    }
+
+/*! \param d_counts Histogram of ordered pairs to add to
+    \param d_pos Particle positions, including ghosts
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_nlist Neighbor list
+    \param d_n_outliers Outliers in a compressed d_nlist, nullptr if uncompressed
+    \param d_head_list Head of the neighbors of each particle in d_nlist
+    \param box Local simulation box
+    \param N Number of local particles
+    \param half True if d_nlist stores each local pair only once
+    \param r_max Maximum pair distance
+    \param bins Number of bins
+    \param shared_histogram True to collect the block's counts in shared memory first
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_rdf_accumulate(unsigned long long* d_counts,
+                              const Scalar4* d_pos,
+                              const unsigned int* d_n_neigh,
+                              const unsigned int* d_nlist,
+                              const unsigned int* d_n_outliers,
+                              const size_t* d_head_list,
+                              const BoxDim& box,
+                              unsigned int N,
+                              bool half,
+                              Scalar r_max,
+                              unsigned int bins,
+                              bool shared_histogram,
+                              unsigned int block_size)
+    {
+    assert(d_counts);
+
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_rdf_accumulate_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    size_t shared_bytes = shared_histogram ? bins * sizeof(unsigned int) : 0;
+
+    hipLaunchKernelGGL(gpu_rdf_accumulate_kernel,
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       shared_bytes,
+                       0,
+                       d_counts,
+                       d_pos,
+                       d_n_neigh,
+                       d_nlist,
+                       d_n_outliers,
+                       d_head_list,
+                       box,
+                       N,
+                       half,
+                       r_max,
+                       bins,
+                       shared_histogram);
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
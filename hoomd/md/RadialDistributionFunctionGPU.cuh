@@ -0,0 +1,41 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _RADIAL_DISTRIBUTION_FUNCTION_GPU_CUH_
+#define _RADIAL_DISTRIBUTION_FUNCTION_GPU_CUH_
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+
+#include <hip/hip_runtime.h>
+
+/*! \file RadialDistributionFunctionGPU.cuh
+    \brief Kernel driver function declarations for RadialDistributionFunctionGPU
+    */
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Adds the pair distances of the local particles to a histogram on the GPU
+hipError_t gpu_rdf_accumulate(unsigned long long* d_counts,
+                              const Scalar4* d_pos,
+                              const unsigned int* d_n_neigh,
+                              const unsigned int* d_nlist,
+                              const unsigned int* d_n_outliers,
+                              const size_t* d_head_list,
+                              const BoxDim& box,
+                              unsigned int N,
+                              bool half,
+                              Scalar r_max,
+                              unsigned int bins,
+                              bool shared_histogram,
+                              unsigned int block_size);
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
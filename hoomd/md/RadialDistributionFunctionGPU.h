@@ -0,0 +1,67 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "RadialDistributionFunction.h"
+#include "hoomd/Autotuner.h"
+
+/*! \file RadialDistributionFunctionGPU.h
+    \brief Declares a class that accumulates the radial distribution function on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __RADIAL_DISTRIBUTION_FUNCTION_GPU_H__
+#define __RADIAL_DISTRIBUTION_FUNCTION_GPU_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Accumulates the radial distribution function on the GPU
+/*! RadialDistributionFunctionGPU reads the neighbor list on the device and adds the pairs to the
+    histogram with atomics, collecting the counts of a block in shared memory when the histogram
+    fits. Positions and counts never leave the device during the run.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT RadialDistributionFunctionGPU : public RadialDistributionFunction
+    {
+    public:
+    //! Constructs the analyzer
+    RadialDistributionFunctionGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                  std::shared_ptr<NeighborList> nlist,
+                                  Scalar r_max,
+                                  unsigned int bins);
+
+    //! Destructor
+    virtual ~RadialDistributionFunctionGPU();
+
+    //! Set autotuner parameters
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        RadialDistributionFunction::setAutotunerParams(enable, period);
+        m_tuner->setPeriod(period);
+        m_tuner->setEnabled(enable);
+        }
+
+    protected:
+    std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
+
+    //! Add the pairs of the local particles to m_counts
+    virtual void accumulate();
+    };
+
+namespace detail
+    {
+//! Exports the RadialDistributionFunctionGPU class to python
+void export_RadialDistributionFunctionGPU(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
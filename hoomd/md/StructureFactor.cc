@@ -0,0 +1,388 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file StructureFactor.cc
+    \brief Contains code for the StructureFactor class
+*/
+
+#include "StructureFactor.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#include <pybind11/stl.h>
+
+#include <stdexcept>
+#include <string.h>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System to compute the structure factor of
+    \param group Group of particles to compute the structure factor of
+    \param nx Number of mesh cells along the first lattice vector
+    \param ny Number of mesh cells along the second lattice vector
+    \param nz Number of mesh cells along the third lattice vector (1 in 2D)
+    \param k_max Maximum wave vector magnitude
+    \param bins Number of bins between 0 and k_max
+*/
+StructureFactor::StructureFactor(std::shared_ptr<SystemDefinition> sysdef,
+                                 std::shared_ptr<ParticleGroup> group,
+                                 unsigned int nx,
+                                 unsigned int ny,
+                                 unsigned int nz,
+                                 Scalar k_max,
+                                 unsigned int bins)
+    : Analyzer(sysdef), m_group(group), m_mesh_points(make_uint3(nx, ny, nz)), m_k_max(k_max),
+      m_bins(bins), m_num_frames(0), m_fft_initialized(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing StructureFactor" << endl;
+
+    if (nx == 0 || ny == 0 || nz == 0)
+        throw std::invalid_argument("The mesh must have at least one cell in each direction.");
+    if (m_sysdef->getNDimensions() == 2 && nz != 1)
+        throw std::invalid_argument("The mesh must have one cell along z in 2D.");
+    if (!(k_max > Scalar(0.0)))
+        throw std::invalid_argument("k_max must be positive.");
+    if (bins == 0)
+        throw std::invalid_argument("bins must be positive.");
+
+    GlobalArray<double> sq_sum(m_bins, m_exec_conf);
+    m_sq_sum.swap(sq_sum);
+    TAG_ALLOCATION(m_sq_sum);
+
+    GlobalArray<unsigned long long> mode_count(m_bins, m_exec_conf);
+    m_mode_count.swap(mode_count);
+    TAG_ALLOCATION(m_mode_count);
+
+    reset();
+    }
+
+StructureFactor::~StructureFactor()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying StructureFactor" << endl;
+
+    if (m_fft_initialized)
+        {
+#ifdef ENABLE_FFTW
+        fftwf_destroy_plan(m_fftw_plan);
+#else
+        kiss_fft_free(m_kiss_fft);
+        kiss_fft_cleanup();
+#endif
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void StructureFactor::analyze(uint64_t timestep)
+    {
+    if (m_prof)
+        m_prof->push("S(q)");
+
+    if (!m_fft_initialized)
+        initializeFFT();
+
+    assignParticles();
+
+        {
+        ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::readwrite);
+        reduceMesh(reinterpret_cast<float*>(h_mesh.data));
+
+        ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+#ifdef ENABLE_FFTW
+        fftwf_execute_dft(m_fftw_plan,
+                          (fftwf_complex*)h_mesh.data,
+                          (fftwf_complex*)h_fourier_mesh.data);
+#else
+        kiss_fftnd(m_kiss_fft, h_mesh.data, h_fourier_mesh.data);
+#endif
+        }
+
+    accumulateModes();
+    m_num_frames++;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+void StructureFactor::initializeFFT()
+    {
+    unsigned int n_cells = m_mesh_points.x * m_mesh_points.y * m_mesh_points.z;
+
+    GlobalArray<kiss_fft_cpx> mesh(n_cells, m_exec_conf);
+    m_mesh.swap(mesh);
+    TAG_ALLOCATION(m_mesh);
+
+    GlobalArray<kiss_fft_cpx> fourier_mesh(n_cells, m_exec_conf);
+    m_fourier_mesh.swap(fourier_mesh);
+    TAG_ALLOCATION(m_fourier_mesh);
+
+    // kiss FFT and FFTW expect data in row major format
+    int dims[3];
+    dims[0] = m_mesh_points.z;
+    dims[1] = m_mesh_points.y;
+    dims[2] = m_mesh_points.x;
+
+#ifdef ENABLE_FFTW
+    // FFTW_MEASURE overwrites the arrays it plans with, so plan on scratch arrays
+    fftwf_complex* scratch_in = fftwf_alloc_complex(n_cells);
+    fftwf_complex* scratch_out = fftwf_alloc_complex(n_cells);
+    m_fftw_plan = fftwf_plan_dft(3,
+                                 dims,
+                                 scratch_in,
+                                 scratch_out,
+                                 FFTW_FORWARD,
+                                 FFTW_MEASURE | FFTW_UNALIGNED);
+    fftwf_free(scratch_in);
+    fftwf_free(scratch_out);
+
+    if (!m_fftw_plan)
+        {
+        throw std::runtime_error("Error creating FFTW plan for the structure factor.");
+        }
+#else
+    m_kiss_fft = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
+#endif
+
+    m_fft_initialized = true;
+    }
+
+/*! Each particle adds its cloud-in-cell weights to the 8 (4 in 2D) nearest mesh points, the mesh
+    is periodic.
+*/
+void StructureFactor::assignParticles()
+    {
+    // access the group first, rebuilding the group may access the tags
+    ArrayHandle<unsigned int> h_index_array(m_group->getIndexArray(),
+                                            access_location::host,
+                                            access_mode::read);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::overwrite);
+
+    memset(h_mesh.data, 0, sizeof(kiss_fft_cpx) * m_mesh.getNumElements());
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    bool twod = m_sysdef->getNDimensions() == 2;
+    const uint3 dim = m_mesh_points;
+
+    unsigned int n_members = m_group->getNumMembers();
+    for (unsigned int group_idx = 0; group_idx < n_members; group_idx++)
+        {
+        unsigned int j = h_index_array.data[group_idx];
+        Scalar3 pos = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+        Scalar3 f = box.makeFraction(pos);
+        if (twod)
+            f.z = Scalar(0.0);
+
+        // coordinates in units of the mesh size, relative to the cell centers
+        Scalar3 reduced_pos = make_scalar3(f.x * Scalar(dim.x) - Scalar(0.5),
+                                           f.y * Scalar(dim.y) - Scalar(0.5),
+                                           f.z * Scalar(dim.z) - Scalar(0.5));
+        int3 cell = make_int3(int(floor(reduced_pos.x)),
+                              int(floor(reduced_pos.y)),
+                              int(floor(reduced_pos.z)));
+        Scalar3 w = reduced_pos - make_scalar3(Scalar(cell.x), Scalar(cell.y), Scalar(cell.z));
+
+        for (int dz = 0; dz < 2; dz++)
+            {
+            unsigned int iz = (unsigned int)((cell.z + dz + (int)dim.z) % (int)dim.z);
+            Scalar wz = dz ? w.z : Scalar(1.0) - w.z;
+            for (int dy = 0; dy < 2; dy++)
+                {
+                unsigned int iy = (unsigned int)((cell.y + dy + (int)dim.y) % (int)dim.y);
+                Scalar wy = dy ? w.y : Scalar(1.0) - w.y;
+                for (int dx = 0; dx < 2; dx++)
+                    {
+                    unsigned int ix = (unsigned int)((cell.x + dx + (int)dim.x) % (int)dim.x);
+                    Scalar wx = dx ? w.x : Scalar(1.0) - w.x;
+                    h_mesh.data[(iz * dim.y + iy) * dim.x + ix].r += float(wx * wy * wz);
+                    }
+                }
+            }
+        }
+    }
+
+/*! \param mesh Mesh of 2 * n_cells floats (real and imaginary parts) to sum over all ranks
+ */
+void StructureFactor::reduceMesh(float* mesh)
+    {
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        unsigned int n_cells = m_mesh_points.x * m_mesh_points.y * m_mesh_points.z;
+        MPI_Allreduce(MPI_IN_PLACE,
+                      mesh,
+                      2 * n_cells,
+                      MPI_FLOAT,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+    }
+
+/*! \param b1 Set to the first reciprocal lattice vector
+    \param b2 Set to the second reciprocal lattice vector
+    \param b3 Set to the third reciprocal lattice vector
+
+    The reciprocal lattice vectors include the factor 2 pi. In 2D, the third lattice vector is
+    taken as the unit vector along z.
+*/
+void StructureFactor::getReciprocalLattice(Scalar3& b1, Scalar3& b2, Scalar3& b3)
+    {
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    Scalar3 a1 = global_box.getLatticeVector(0);
+    Scalar3 a2 = global_box.getLatticeVector(1);
+    Scalar3 a3 = global_box.getLatticeVector(2);
+    if (m_sysdef->getNDimensions() == 2)
+        a3 = make_scalar3(0, 0, 1);
+
+    Scalar3 a2_x_a3 = make_scalar3(a2.y * a3.z - a2.z * a3.y,
+                                   a2.z * a3.x - a2.x * a3.z,
+                                   a2.x * a3.y - a2.y * a3.x);
+    Scalar3 a3_x_a1 = make_scalar3(a3.y * a1.z - a3.z * a1.y,
+                                   a3.z * a1.x - a3.x * a1.z,
+                                   a3.x * a1.y - a3.y * a1.x);
+    Scalar3 a1_x_a2 = make_scalar3(a1.y * a2.z - a1.z * a2.y,
+                                   a1.z * a2.x - a1.x * a2.z,
+                                   a1.x * a2.y - a1.y * a2.x);
+    Scalar V = dot(a1, a2_x_a3);
+
+    b1 = Scalar(2.0 * M_PI) * a2_x_a3 / V;
+    b2 = Scalar(2.0 * M_PI) * a3_x_a1 / V;
+    b3 = Scalar(2.0 * M_PI) * a1_x_a2 / V;
+    }
+
+void StructureFactor::accumulateModes()
+    {
+    ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh,
+                                             access_location::host,
+                                             access_mode::read);
+    ArrayHandle<double> h_sq_sum(m_sq_sum, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned long long> h_mode_count(m_mode_count,
+                                                 access_location::host,
+                                                 access_mode::readwrite);
+
+    Scalar3 b1, b2, b3;
+    getReciprocalLattice(b1, b2, b3);
+
+    const uint3 dim = m_mesh_points;
+    const unsigned int n_cells = dim.x * dim.y * dim.z;
+    const double n_members = double(m_group->getNumMembersGlobal());
+    const Scalar bins_per_k = Scalar(m_bins) / m_k_max;
+
+    if (n_members == 0)
+        return;
+
+    for (unsigned int cell_idx = 0; cell_idx < n_cells; cell_idx++)
+        {
+        // compute Miller indices
+        int3 n = make_int3(cell_idx % dim.x,
+                           (cell_idx / dim.x) % dim.y,
+                           cell_idx / (dim.x * dim.y));
+        if (n.x >= (int)(dim.x / 2 + dim.x % 2))
+            n.x -= (int)dim.x;
+        if (n.y >= (int)(dim.y / 2 + dim.y % 2))
+            n.y -= (int)dim.y;
+        if (n.z >= (int)(dim.z / 2 + dim.z % 2))
+            n.z -= (int)dim.z;
+
+        if (n.x == 0 && n.y == 0 && n.z == 0)
+            continue;
+
+        Scalar3 k = Scalar(n.x) * b1 + Scalar(n.y) * b2 + Scalar(n.z) * b3;
+        Scalar k_mag = fast::sqrt(dot(k, k));
+        if (k_mag >= m_k_max)
+            continue;
+
+        unsigned int bin = (unsigned int)(k_mag * bins_per_k);
+        if (bin >= m_bins)
+            continue;
+
+        // remove the smoothing of the cloud-in-cell assignment
+        Scalar W = detail::structure_factor_cic_window(n.x, dim.x)
+                   * detail::structure_factor_cic_window(n.y, dim.y)
+                   * detail::structure_factor_cic_window(n.z, dim.z);
+
+        kiss_fft_cpx rho = h_fourier_mesh.data[cell_idx];
+        double rho_sq = double(rho.r) * double(rho.r) + double(rho.i) * double(rho.i);
+        h_sq_sum.data[bin] += rho_sq / (n_members * double(W) * double(W));
+        h_mode_count.data[bin]++;
+        }
+    }
+
+std::vector<Scalar> StructureFactor::getBinCenters()
+    {
+    std::vector<Scalar> centers(m_bins);
+    Scalar dk = m_k_max / Scalar(m_bins);
+    for (unsigned int b = 0; b < m_bins; b++)
+        centers[b] = (Scalar(b) + Scalar(0.5)) * dk;
+    return centers;
+    }
+
+/*! \returns S(k) in each bin, 0 in bins without wave vectors
+
+    All ranks hold the same sums, no communication is needed.
+*/
+std::vector<Scalar> StructureFactor::getStructureFactor()
+    {
+    ArrayHandle<double> h_sq_sum(m_sq_sum, access_location::host, access_mode::read);
+    ArrayHandle<unsigned long long> h_mode_count(m_mode_count,
+                                                 access_location::host,
+                                                 access_mode::read);
+
+    std::vector<Scalar> sq(m_bins, Scalar(0.0));
+    for (unsigned int b = 0; b < m_bins; b++)
+        {
+        if (h_mode_count.data[b] > 0)
+            sq[b] = Scalar(h_sq_sum.data[b] / double(h_mode_count.data[b]));
+        }
+    return sq;
+    }
+
+void StructureFactor::reset()
+    {
+    ArrayHandle<double> h_sq_sum(m_sq_sum, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned long long> h_mode_count(m_mode_count,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+    for (unsigned int b = 0; b < m_bins; b++)
+        {
+        h_sq_sum.data[b] = 0.0;
+        h_mode_count.data[b] = 0;
+        }
+
+    m_num_frames = 0;
+    }
+
+namespace detail
+    {
+void export_StructureFactor(pybind11::module& m)
+    {
+    pybind11::class_<StructureFactor, Analyzer, std::shared_ptr<StructureFactor>>(
+        m,
+        "StructureFactor")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<ParticleGroup>,
+                            unsigned int,
+                            unsigned int,
+                            unsigned int,
+                            Scalar,
+                            unsigned int>())
+        .def_property_readonly("k_max", &StructureFactor::getKMax)
+        .def_property_readonly("bins", &StructureFactor::getBins)
+        .def_property_readonly("num_frames", &StructureFactor::getNumFrames)
+        .def("getBinCenters", &StructureFactor::getBinCenters)
+        .def("getStructureFactor", &StructureFactor::getStructureFactor)
+        .def("reset", &StructureFactor::reset);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,152 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/Analyzer.h"
+#include "hoomd/GlobalArray.h"
+#include "hoomd/ParticleGroup.h"
+
+#include "hoomd/extern/kiss_fftnd.h"
+
+#ifdef ENABLE_FFTW
+#include <fftw3.h>
+#endif
+
+#include <memory>
+#include <vector>
+
+/*! \file StructureFactor.h
+    \brief Declares a class that accumulates the static structure factor during a run
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __STRUCTURE_FACTOR_H__
+#define __STRUCTURE_FACTOR_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Accumulates the static structure factor of a group of particles during a run
+/*! Every time analyze() is called, StructureFactor assigns the group members to a mesh that
+    spans the global box with cloud-in-cell weights, Fourier transforms the mesh with the same FFT
+    that PPPMForceCompute uses (kiss FFT, or FFTW when available), and adds
+    S(k) = |rho(k)|^2 / (N W(k)^2) of every wave vector with |k| < k_max to the bin of |k|. W(k) is
+    the Fourier transform of the assignment function, dividing by it removes the smoothing of the
+    mesh. The sums stay in m_sq_sum and m_mode_count until the averaged S(k) is requested.
+
+    In MPI simulations, the meshes of all ranks are summed with one MPI_Allreduce per frame, then
+    every rank transforms the global mesh. The mesh is much smaller than the particle data for
+    the meshes this class is intended for (e.g. 32^3 to 128^3 cells).
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT StructureFactor : public Analyzer
+    {
+    public:
+    //! Constructs the analyzer
+    StructureFactor(std::shared_ptr<SystemDefinition> sysdef,
+                    std::shared_ptr<ParticleGroup> group,
+                    unsigned int nx,
+                    unsigned int ny,
+                    unsigned int nz,
+                    Scalar k_max,
+                    unsigned int bins);
+
+    //! Destructor
+    virtual ~StructureFactor();
+
+    //! Add the structure factor of the current configuration to the sums
+    virtual void analyze(uint64_t timestep);
+
+    //! Get the maximum wave vector magnitude
+    Scalar getKMax()
+        {
+        return m_k_max;
+        }
+
+    //! Get the number of bins
+    unsigned int getBins()
+        {
+        return m_bins;
+        }
+
+    //! Get the number of accumulated frames
+    uint64_t getNumFrames()
+        {
+        return m_num_frames;
+        }
+
+    //! Get the centers of the bins
+    std::vector<Scalar> getBinCenters();
+
+    //! Get the structure factor averaged over the wave vectors in each bin and the frames
+    std::vector<Scalar> getStructureFactor();
+
+    //! Discard the accumulated frames
+    void reset();
+
+    protected:
+    std::shared_ptr<ParticleGroup> m_group; //!< Group to compute the structure factor of
+    uint3 m_mesh_points;                    //!< Number of mesh cells along each lattice vector
+    Scalar m_k_max;                         //!< Maximum wave vector magnitude
+    unsigned int m_bins;                    //!< Number of bins
+    GlobalArray<double> m_sq_sum;                 //!< Sum of S(k) of the wave vectors in each bin
+    GlobalArray<unsigned long long> m_mode_count; //!< Number of wave vectors summed in each bin
+    uint64_t m_num_frames;                        //!< Number of accumulated frames
+
+    //! Get the reciprocal lattice vectors of the global box
+    void getReciprocalLattice(Scalar3& b1, Scalar3& b2, Scalar3& b3);
+
+    //! Sum the meshes of all ranks
+    void reduceMesh(float* mesh);
+
+    private:
+    bool m_fft_initialized;             //!< True when the FFT and the meshes have been set up
+    GlobalArray<kiss_fft_cpx> m_mesh;   //!< The particle density mesh
+    GlobalArray<kiss_fft_cpx> m_fourier_mesh; //!< The Fourier transformed mesh
+
+#ifdef ENABLE_FFTW
+    fftwf_plan m_fftw_plan = NULL; //!< FFTW plan for the forward transform
+#else
+    kiss_fftnd_cfg m_kiss_fft = NULL; //!< The FFT configuration
+#endif
+
+    //! Set up the FFT and allocate the meshes
+    void initializeFFT();
+
+    //! Assign the local group members to m_mesh
+    void assignParticles();
+
+    //! Add S(k) of the transformed mesh to the sums
+    void accumulateModes();
+    };
+
+namespace detail
+    {
+//! Compute the CIC assignment function in Fourier space for one dimension
+/*! \param n Miller index
+    \param n_cells Number of mesh cells in the dimension
+    \returns sinc(pi n / n_cells)^2
+*/
+inline Scalar structure_factor_cic_window(int n, unsigned int n_cells)
+    {
+    if (n == 0)
+        return Scalar(1.0);
+    Scalar x = Scalar(M_PI) * Scalar(n) / Scalar(n_cells);
+    Scalar sinc = fast::sin(x) / x;
+    return sinc * sinc;
+    }
+
+//! Exports the StructureFactor class to python
+void export_StructureFactor(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
@@ -0,0 +1,234 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file StructureFactorGPU.cc
+    \brief Contains code for the StructureFactorGPU class
+*/
+
+#include "StructureFactorGPU.h"
+#include "StructureFactorGPU.cuh"
+
+#include <sstream>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace
+    {
+//! Throw an exception when a hipFFT call fails
+#ifdef __HIP_PLATFORM_HCC__
+void checkHIPFFT(hipfftResult result, const char* file, unsigned int line)
+    {
+    if (result != HIPFFT_SUCCESS)
+#else
+void checkHIPFFT(cufftResult result, const char* file, unsigned int line)
+    {
+    if (result != CUFFT_SUCCESS)
+#endif
+        {
+        std::ostringstream oss;
+        oss << "HIPFFT returned error " << result << " in file " << file << " line " << line
+            << std::endl;
+        throw std::runtime_error(oss.str());
+        }
+    }
+    } // end anonymous namespace
+
+/*! \param sysdef System to compute the structure factor of
+    \param group Group of particles to compute the structure factor of
+    \param nx Number of mesh cells along the first lattice vector
+    \param ny Number of mesh cells along the second lattice vector
+    \param nz Number of mesh cells along the third lattice vector (1 in 2D)
+    \param k_max Maximum wave vector magnitude
+    \param bins Number of bins between 0 and k_max
+*/
+StructureFactorGPU::StructureFactorGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                       std::shared_ptr<ParticleGroup> group,
+                                       unsigned int nx,
+                                       unsigned int ny,
+                                       unsigned int nz,
+                                       Scalar k_max,
+                                       unsigned int bins)
+    : StructureFactor(sysdef, group, nx, ny, nz, k_max, bins), m_hipfft_initialized(false)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error()
+            << "Creating a StructureFactorGPU with no GPU in the execution configuration" << endl;
+        throw std::runtime_error("Error initializing StructureFactorGPU");
+        }
+
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner_assign.reset(new Autotuner(warp_size,
+                                       1024,
+                                       warp_size,
+                                       5,
+                                       100000,
+                                       "structure_factor_assign",
+                                       m_exec_conf));
+    m_tuner_accumulate.reset(new Autotuner(warp_size,
+                                           1024,
+                                           warp_size,
+                                           5,
+                                           100000,
+                                           "structure_factor_accumulate",
+                                           m_exec_conf));
+    }
+
+StructureFactorGPU::~StructureFactorGPU()
+    {
+    if (m_hipfft_initialized)
+        {
+#ifdef __HIP_PLATFORM_HCC__
+        checkHIPFFT(hipfftDestroy(m_hipfft_plan), __FILE__, __LINE__);
+#else
+        checkHIPFFT(cufftDestroy(m_hipfft_plan), __FILE__, __LINE__);
+#endif
+        }
+    }
+
+void StructureFactorGPU::initializeFFT()
+    {
+    unsigned int n_cells = m_mesh_points.x * m_mesh_points.y * m_mesh_points.z;
+
+    GlobalArray<hipfftComplex> mesh(n_cells, m_exec_conf);
+    m_gpu_mesh.swap(mesh);
+    TAG_ALLOCATION(m_gpu_mesh);
+
+    GlobalArray<hipfftComplex> fourier_mesh(n_cells, m_exec_conf);
+    m_gpu_fourier_mesh.swap(fourier_mesh);
+    TAG_ALLOCATION(m_gpu_fourier_mesh);
+
+#ifdef __HIP_PLATFORM_HCC__
+    checkHIPFFT(
+        hipfftPlan3d(&m_hipfft_plan, m_mesh_points.z, m_mesh_points.y, m_mesh_points.x, HIPFFT_C2C),
+        __FILE__,
+        __LINE__);
+#else
+    checkHIPFFT(
+        cufftPlan3d(&m_hipfft_plan, m_mesh_points.z, m_mesh_points.y, m_mesh_points.x, CUFFT_C2C),
+        __FILE__,
+        __LINE__);
+#endif
+    m_hipfft_initialized = true;
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void StructureFactorGPU::analyze(uint64_t timestep)
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "S(q)");
+
+    if (!m_hipfft_initialized)
+        initializeFFT();
+
+        {
+        // access the group first, rebuilding the group may access the tags
+        ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
+                                                access_location::device,
+                                                access_mode::read);
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::read);
+        ArrayHandle<hipfftComplex> d_mesh(m_gpu_mesh,
+                                          access_location::device,
+                                          access_mode::overwrite);
+
+        m_tuner_assign->begin();
+        kernel::gpu_structure_factor_assign(d_mesh.data,
+                                            d_pos.data,
+                                            d_index_array.data,
+                                            m_group->getNumMembers(),
+                                            m_pdata->getGlobalBox(),
+                                            m_sysdef->getNDimensions() == 2,
+                                            m_mesh_points,
+                                            m_tuner_assign->getParam());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_assign->end();
+        }
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        ArrayHandle<hipfftComplex> h_mesh(m_gpu_mesh,
+                                          access_location::host,
+                                          access_mode::readwrite);
+        reduceMesh(reinterpret_cast<float*>(h_mesh.data));
+        }
+#endif
+
+        {
+        ArrayHandle<hipfftComplex> d_mesh(m_gpu_mesh, access_location::device, access_mode::read);
+        ArrayHandle<hipfftComplex> d_fourier_mesh(m_gpu_fourier_mesh,
+                                                  access_location::device,
+                                                  access_mode::overwrite);
+#ifdef __HIP_PLATFORM_HCC__
+        checkHIPFFT(
+            hipfftExecC2C(m_hipfft_plan, d_mesh.data, d_fourier_mesh.data, HIPFFT_FORWARD),
+            __FILE__,
+            __LINE__);
+#else
+        checkHIPFFT(cufftExecC2C(m_hipfft_plan, d_mesh.data, d_fourier_mesh.data, CUFFT_FORWARD),
+                    __FILE__,
+                    __LINE__);
+#endif
+
+        Scalar3 b1, b2, b3;
+        getReciprocalLattice(b1, b2, b3);
+
+        ArrayHandle<double> d_sq_sum(m_sq_sum, access_location::device, access_mode::readwrite);
+        ArrayHandle<unsigned long long> d_mode_count(m_mode_count,
+                                                     access_location::device,
+                                                     access_mode::readwrite);
+
+        unsigned int n_members = m_group->getNumMembersGlobal();
+        if (n_members > 0)
+            {
+            m_tuner_accumulate->begin();
+            kernel::gpu_structure_factor_accumulate(d_sq_sum.data,
+                                                    d_mode_count.data,
+                                                    d_fourier_mesh.data,
+                                                    m_mesh_points,
+                                                    b1,
+                                                    b2,
+                                                    b3,
+                                                    m_k_max,
+                                                    m_bins,
+                                                    double(n_members),
+                                                    m_tuner_accumulate->getParam());
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            m_tuner_accumulate->end();
+            }
+        }
+
+    m_num_frames++;
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+namespace detail
+    {
+void export_StructureFactorGPU(pybind11::module& m)
+    {
+    pybind11::class_<StructureFactorGPU, StructureFactor, std::shared_ptr<StructureFactorGPU>>(
+        m,
+        "StructureFactorGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<ParticleGroup>,
+                            unsigned int,
+                            unsigned int,
+                            unsigned int,
+                            Scalar,
+                            unsigned int>());
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,242 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "StructureFactorGPU.cuh"
+
+#include <assert.h>
+
+/*! \file StructureFactorGPU.cu
+    \brief Defines GPU kernel code for accumulating the structure factor on the GPU. Used by
+   StructureFactorGPU.
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Assign the group members to the density mesh with cloud-in-cell weights
+/*! \param d_mesh Density mesh to add to, zeroed by the caller
+    \param d_pos Particle positions
+    \param d_index_array Indices of the group members
+    \param n_members Number of local group members
+    \param box Global simulation box
+    \param twod True in 2D simulations
+    \param mesh_points Number of mesh cells along each lattice vector
+
+    One thread is executed per group member, see StructureFactor::assignParticles().
+*/
+__global__ void gpu_structure_factor_assign_kernel(hipfftComplex* d_mesh,
+                                                   const Scalar4* d_pos,
+                                                   const unsigned int* d_index_array,
+                                                   unsigned int n_members,
+                                                   const BoxDim box,
+                                                   bool twod,
+                                                   uint3 mesh_points)
+    {
+    unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (group_idx >= n_members)
+        return;
+
+    unsigned int j = d_index_array[group_idx];
+    Scalar4 postype = d_pos[j];
+    Scalar3 f = box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+    if (twod)
+        f.z = Scalar(0.0);
+
+    // coordinates in units of the mesh size, relative to the cell centers
+    Scalar3 reduced_pos = make_scalar3(f.x * Scalar(mesh_points.x) - Scalar(0.5),
+                                       f.y * Scalar(mesh_points.y) - Scalar(0.5),
+                                       f.z * Scalar(mesh_points.z) - Scalar(0.5));
+    int3 cell = make_int3(int(floor(reduced_pos.x)),
+                          int(floor(reduced_pos.y)),
+                          int(floor(reduced_pos.z)));
+    Scalar3 w = reduced_pos - make_scalar3(Scalar(cell.x), Scalar(cell.y), Scalar(cell.z));
+
+    for (int dz = 0; dz < 2; dz++)
+        {
+        unsigned int iz = (cell.z + dz + (int)mesh_points.z) % (int)mesh_points.z;
+        Scalar wz = dz ? w.z : Scalar(1.0) - w.z;
+        for (int dy = 0; dy < 2; dy++)
+            {
+            unsigned int iy = (cell.y + dy + (int)mesh_points.y) % (int)mesh_points.y;
+            Scalar wy = dy ? w.y : Scalar(1.0) - w.y;
+            for (int dx = 0; dx < 2; dx++)
+                {
+                unsigned int ix = (cell.x + dx + (int)mesh_points.x) % (int)mesh_points.x;
+                Scalar wx = dx ? w.x : Scalar(1.0) - w.x;
+                atomicAdd(&d_mesh[(iz * mesh_points.y + iy) * mesh_points.x + ix].x,
+                          float(wx * wy * wz));
+                }
+            }
+        }
+    }
+
+//! Compute the CIC assignment function in Fourier space for one dimension
+__device__ inline Scalar gpu_structure_factor_cic_window(int n, unsigned int n_cells)
+    {
+    if (n == 0)
+        return Scalar(1.0);
+    Scalar x = Scalar(M_PI) * Scalar(n) / Scalar(n_cells);
+    Scalar sinc = fast::sin(x) / x;
+    return sinc * sinc;
+    }
+
+//! Add S(k) of the transformed mesh to the sums
+/*! \param d_sq_sum Sum of S(k) of the wave vectors in each bin
+    \param d_mode_count Number of wave vectors summed in each bin
+    \param d_fourier_mesh Fourier transformed density mesh
+    \param mesh_points Number of mesh cells along each lattice vector
+    \param b1 First reciprocal lattice vector
+    \param b2 Second reciprocal lattice vector
+    \param b3 Third reciprocal lattice vector
+    \param k_max Maximum wave vector magnitude
+    \param bins Number of bins
+    \param n_members Number of particles in the group
+
+    One thread is executed per mesh cell, see StructureFactor::accumulateModes().
+*/
+__global__ void gpu_structure_factor_accumulate_kernel(double* d_sq_sum,
+                                                       unsigned long long* d_mode_count,
+                                                       const hipfftComplex* d_fourier_mesh,
+                                                       uint3 mesh_points,
+                                                       Scalar3 b1,
+                                                       Scalar3 b2,
+                                                       Scalar3 b3,
+                                                       Scalar k_max,
+                                                       unsigned int bins,
+                                                       double n_members)
+    {
+    unsigned int cell_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (cell_idx >= mesh_points.x * mesh_points.y * mesh_points.z)
+        return;
+
+    // compute Miller indices
+    int3 n = make_int3(cell_idx % mesh_points.x,
+                       (cell_idx / mesh_points.x) % mesh_points.y,
+                       cell_idx / (mesh_points.x * mesh_points.y));
+    if (n.x >= (int)(mesh_points.x / 2 + mesh_points.x % 2))
+        n.x -= (int)mesh_points.x;
+    if (n.y >= (int)(mesh_points.y / 2 + mesh_points.y % 2))
+        n.y -= (int)mesh_points.y;
+    if (n.z >= (int)(mesh_points.z / 2 + mesh_points.z % 2))
+        n.z -= (int)mesh_points.z;
+
+    if (n.x == 0 && n.y == 0 && n.z == 0)
+        return;
+
+    Scalar3 k = Scalar(n.x) * b1 + Scalar(n.y) * b2 + Scalar(n.z) * b3;
+    Scalar k_mag = fast::sqrt(dot(k, k));
+    if (k_mag >= k_max)
+        return;
+
+    unsigned int bin = (unsigned int)(k_mag * Scalar(bins) / k_max);
+    if (bin >= bins)
+        return;
+
+    // remove the smoothing of the cloud-in-cell assignment
+    Scalar W = gpu_structure_factor_cic_window(n.x, mesh_points.x)
+               * gpu_structure_factor_cic_window(n.y, mesh_points.y)
+               * gpu_structure_factor_cic_window(n.z, mesh_points.z);
+
+    hipfftComplex rho = d_fourier_mesh[cell_idx];
+    double rho_sq = double(rho.x) * double(rho.x) + double(rho.y) * double(rho.y);
+    atomicAdd(&d_sq_sum[bin], rho_sq / (n_members * double(W) * double(W)));
+    atomicAdd(&d_mode_count[bin], 1ull);
+    }
+
+/*! \param d_mesh Density mesh to write
+    \param d_pos Particle positions
+    \param d_index_array Indices of the group members
+    \param n_members Number of local group members
+    \param box Global simulation box
+    \param twod True in 2D simulations
+    \param mesh_points Number of mesh cells along each lattice vector
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_structure_factor_assign(hipfftComplex* d_mesh,
+                                       const Scalar4* d_pos,
+                                       const unsigned int* d_index_array,
+                                       unsigned int n_members,
+                                       const BoxDim& box,
+                                       bool twod,
+                                       uint3 mesh_points,
+                                       unsigned int block_size)
+    {
+    assert(d_mesh);
+
+    hipMemsetAsync(d_mesh,
+                   0,
+                   sizeof(hipfftComplex) * mesh_points.x * mesh_points.y * mesh_points.z);
+
+    if (n_members == 0)
+        return hipSuccess;
+
+    hipLaunchKernelGGL(gpu_structure_factor_assign_kernel,
+                       dim3(n_members / block_size + 1),
+                       dim3(block_size),
+                       0,
+                       0,
+                       d_mesh,
+                       d_pos,
+                       d_index_array,
+                       n_members,
+                       box,
+                       twod,
+                       mesh_points);
+
+    return hipSuccess;
+    }
+
+/*! \param d_sq_sum Sum of S(k) of the wave vectors in each bin
+    \param d_mode_count Number of wave vectors summed in each bin
+    \param d_fourier_mesh Fourier transformed density mesh
+    \param mesh_points Number of mesh cells along each lattice vector
+    \param b1 First reciprocal lattice vector
+    \param b2 Second reciprocal lattice vector
+    \param b3 Third reciprocal lattice vector
+    \param k_max Maximum wave vector magnitude
+    \param bins Number of bins
+    \param n_members Number of particles in the group
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_structure_factor_accumulate(double* d_sq_sum,
+                                           unsigned long long* d_mode_count,
+                                           const hipfftComplex* d_fourier_mesh,
+                                           uint3 mesh_points,
+                                           Scalar3 b1,
+                                           Scalar3 b2,
+                                           Scalar3 b3,
+                                           Scalar k_max,
+                                           unsigned int bins,
+                                           double n_members,
+                                           unsigned int block_size)
+    {
+    assert(d_sq_sum);
+    assert(d_mode_count);
+
+    unsigned int n_cells = mesh_points.x * mesh_points.y * mesh_points.z;
+
+    hipLaunchKernelGGL(gpu_structure_factor_accumulate_kernel,
+                       dim3(n_cells / block_size + 1),
+                       dim3(block_size),
+                       0,
+                       0,
+                       d_sq_sum,
+                       d_mode_count,
+                       d_fourier_mesh,
+                       mesh_points,
+                       b1,
+                       b2,
+                       b3,
+                       k_max,
+                       bins,
+                       n_members);
+
+    return hipSuccess;
+    }
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
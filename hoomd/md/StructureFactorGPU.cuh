@@ -0,0 +1,56 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _STRUCTURE_FACTOR_GPU_CUH_
+#define _STRUCTURE_FACTOR_GPU_CUH_
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+
+#include <hip/hip_runtime.h>
+
+#ifdef __HIP_PLATFORM_HCC__
+#include <hipfft.h>
+#else
+#include <cufft.h>
+typedef cufftComplex hipfftComplex;
+#endif
+
+/*! \file StructureFactorGPU.cuh
+    \brief Kernel driver function declarations for StructureFactorGPU
+    */
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace kernel
+    {
+//! Assigns the group members to the density mesh on the GPU
+hipError_t gpu_structure_factor_assign(hipfftComplex* d_mesh,
+                                       const Scalar4* d_pos,
+                                       const unsigned int* d_index_array,
+                                       unsigned int n_members,
+                                       const BoxDim& box,
+                                       bool twod,
+                                       uint3 mesh_points,
+                                       unsigned int block_size);
+
+//! Adds S(k) of the transformed mesh to the sums on the GPU
+hipError_t gpu_structure_factor_accumulate(double* d_sq_sum,
+                                           unsigned long long* d_mode_count,
+                                           const hipfftComplex* d_fourier_mesh,
+                                           uint3 mesh_points,
+                                           Scalar3 b1,
+                                           Scalar3 b2,
+                                           Scalar3 b3,
+                                           Scalar k_max,
+                                           unsigned int bins,
+                                           double n_members,
+                                           unsigned int block_size);
+
+    } // end namespace kernel
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
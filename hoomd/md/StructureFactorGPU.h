@@ -0,0 +1,89 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "StructureFactor.h"
+#include "hoomd/Autotuner.h"
+
+#ifdef __HIP_PLATFORM_HCC__
+#include <hipfft.h>
+#else
+#include <cufft.h>
+typedef cufftComplex hipfftComplex;
+typedef cufftHandle hipfftHandle;
+#endif
+
+/*! \file StructureFactorGPU.h
+    \brief Declares a class that accumulates the static structure factor on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __STRUCTURE_FACTOR_GPU_H__
+#define __STRUCTURE_FACTOR_GPU_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Accumulates the static structure factor of a group of particles on the GPU
+/*! StructureFactorGPU assigns the particles to the mesh, transforms it with the same hipFFT/cuFFT
+    C2C transform as PPPMForceComputeGPU, and bins the modes, all on the device. Only in MPI
+    simulations does the mesh visit the host, to be summed over the ranks.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT StructureFactorGPU : public StructureFactor
+    {
+    public:
+    //! Constructs the analyzer
+    StructureFactorGPU(std::shared_ptr<SystemDefinition> sysdef,
+                       std::shared_ptr<ParticleGroup> group,
+                       unsigned int nx,
+                       unsigned int ny,
+                       unsigned int nz,
+                       Scalar k_max,
+                       unsigned int bins);
+
+    //! Destructor
+    virtual ~StructureFactorGPU();
+
+    //! Add the structure factor of the current configuration to the sums
+    virtual void analyze(uint64_t timestep);
+
+    //! Set autotuner parameters
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        StructureFactor::setAutotunerParams(enable, period);
+        m_tuner_assign->setPeriod(period);
+        m_tuner_assign->setEnabled(enable);
+        m_tuner_accumulate->setPeriod(period);
+        m_tuner_accumulate->setEnabled(enable);
+        }
+
+    private:
+    hipfftHandle m_hipfft_plan;                   //!< The FFT plan
+    bool m_hipfft_initialized;                    //!< True if the FFT plan has been created
+    GlobalArray<hipfftComplex> m_gpu_mesh;        //!< The particle density mesh
+    GlobalArray<hipfftComplex> m_gpu_fourier_mesh; //!< The Fourier transformed mesh
+
+    std::unique_ptr<Autotuner> m_tuner_assign;     //!< Autotuner for the assignment block size
+    std::unique_ptr<Autotuner> m_tuner_accumulate; //!< Autotuner for the binning block size
+
+    //! Create the FFT plan and allocate the meshes
+    void initializeFFT();
+    };
+
+namespace detail
+    {
+//! Exports the StructureFactorGPU class to python
+void export_StructureFactorGPU(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
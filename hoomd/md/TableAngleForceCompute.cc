@@ -5,6 +5,7 @@
 
 #include "TableAngleForceCompute.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 /*! \file TableAngleForceCompute.cc
@@ -28,7 +29,7 @@ namespace md
 */
 TableAngleForceCompute::TableAngleForceCompute(std::shared_ptr<SystemDefinition> sysdef,
                                                unsigned int table_width)
-    : ForceCompute(sysdef), m_table_width(table_width)
+    : ForceCompute(sysdef), m_table_width(table_width), m_use_spline(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing TableAngleForceCompute" << endl;
 
@@ -52,6 +53,8 @@ TableAngleForceCompute::TableAngleForceCompute(std::shared_ptr<SystemDefinition>
     GPUArray<Scalar2> tables(m_table_width, m_angle_data->getNTypes(), m_exec_conf);
     m_tables.swap(tables);
     assert(!m_tables.isNull());
+    GPUArray<Scalar4> spline(m_table_width, m_angle_data->getNTypes(), m_exec_conf);
+    m_spline.swap(spline);
 
     // helper to compute indices
     Index2D table_value((unsigned int)m_tables.getPitch(), (unsigned int)m_angle_data->getNTypes());
@@ -80,6 +83,7 @@ void TableAngleForceCompute::setTable(unsigned int type,
 
     // access the arrays
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_spline(m_spline, access_location::host, access_mode::readwrite);
 
     if (V.size() != m_table_width || T.size() != m_table_width)
         {
@@ -94,6 +98,14 @@ void TableAngleForceCompute::setTable(unsigned int type,
         h_tables.data[m_table_value(i, type)].x = V[i];
         h_tables.data[m_table_value(i, type)].y = T[i];
         }
+
+    // precompute the spline coefficients of each interval
+    Scalar delta_th = Scalar(M_PI) / Scalar(m_table_width - 1);
+    for (unsigned int i = 0; i + 1 < m_table_width; i++)
+        {
+        h_spline.data[m_table_value(i, type)]
+            = detail::table_spline_coeff(V[i], V[i + 1], T[i], T[i + 1], delta_th);
+        }
     }
 
 /*! \post The table based forces are computed for the given timestep.
@@ -128,6 +140,9 @@ void TableAngleForceCompute::computeForces(uint64_t timestep)
 
     // access the table data
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_spline(m_spline, access_location::host, access_mode::read);
+
+    Scalar inv_delta_th = Scalar(m_table_width - 1) / Scalar(M_PI);
 
     // for each of the angles
     const unsigned int size = (unsigned int)m_angle_data->getN();
@@ -180,8 +195,6 @@ void TableAngleForceCompute::computeForces(uint64_t timestep)
         dcb = box.minImage(dcb);
         dac = box.minImage(dac);
 
-        Scalar delta_th = Scalar(M_PI) / Scalar(m_table_width - 1);
-
         // start computing the force
         Scalar rsqab = dab.x * dab.x + dab.y * dab.y + dab.z * dab.z;
         Scalar rab = sqrt(rsqab);
@@ -207,27 +220,42 @@ void TableAngleForceCompute::computeForces(uint64_t timestep)
         Scalar theta = acos(c_abbc);
 
         // precomputed term
-        Scalar value_f = theta / delta_th;
+        Scalar value_f = theta * inv_delta_th;
 
         // compute index into the table and read in values
 
         /// Here we use the table!!
         unsigned int angle_type = m_angle_data->getTypeByIndex(i);
         unsigned int value_i = (unsigned int)(slow::floor(value_f));
-        Scalar2 VT0 = h_tables.data[m_table_value(value_i, angle_type)];
-        Scalar2 VT1 = h_tables.data[m_table_value(value_i + 1, angle_type)];
-        // unpack the data
-        Scalar V0 = VT0.x;
-        Scalar V1 = VT1.x;
-        Scalar T0 = VT0.y;
-        Scalar T1 = VT1.y;
-
-        // compute the linear interpolation coefficient
-        Scalar f = value_f - Scalar(value_i);
-
-        // interpolate to get V and T;
-        Scalar V = V0 + f * (V1 - V0);
-        Scalar T = T0 + f * (T1 - T0);
+        Scalar V, T;
+        if (m_use_spline)
+            {
+            // theta = pi falls at the end of the last interval
+            value_i = std::min(value_i, m_table_width - 2);
+            Scalar f = value_f - Scalar(value_i);
+            detail::table_spline_eval(h_spline.data[m_table_value(value_i, angle_type)],
+                                      f,
+                                      inv_delta_th,
+                                      V,
+                                      T);
+            }
+        else
+            {
+            Scalar2 VT0 = h_tables.data[m_table_value(value_i, angle_type)];
+            Scalar2 VT1 = h_tables.data[m_table_value(value_i + 1, angle_type)];
+            // unpack the data
+            Scalar V0 = VT0.x;
+            Scalar V1 = VT1.x;
+            Scalar T0 = VT0.y;
+            Scalar T1 = VT1.y;
+
+            // compute the linear interpolation coefficient
+            Scalar f = value_f - Scalar(value_i);
+
+            // interpolate to get V and T;
+            V = V0 + f * (V1 - V0);
+            T = T0 + f * (T1 - T0);
+            }
 
         Scalar a = T * s_abbc;
         Scalar a11 = a * c_abbc / rsqab;
@@ -302,7 +330,10 @@ void export_TableAngleForceCompute(pybind11::module& m)
         m,
         "TableAngleForceCompute")
         .def(pybind11::init<std::shared_ptr<SystemDefinition>, unsigned int>())
-        .def("setTable", &TableAngleForceCompute::setTable);
+        .def("setTable", &TableAngleForceCompute::setTable)
+        .def_property("spline",
+                      &TableAngleForceCompute::getSpline,
+                      &TableAngleForceCompute::setSpline);
     }
 
     } // end namespace detail
@@ -37,8 +37,11 @@ namespace kernel
     \param n_angles_list List of numbers of angles stored on the GPU
     \param n_angle_type number of angle types
     \param d_tables Tables of the potential and force
+    \param d_spline Spline coefficients of each table interval
+    \param use_spline True to interpolate with cubic splines
+    \param table_width Number of points in each table
     \param table_value index helper function
-    \param delta_th angle delta of the table
+    \param inv_delta_th inverse angle delta of the table
 
     See TableAngleForceCompute for information on the memory layout.
 */
@@ -53,8 +56,11 @@ __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
                                                       const unsigned int pitch,
                                                       const unsigned int* n_angles_list,
                                                       const Scalar2* d_tables,
+                                                      const Scalar4* d_spline,
+                                                      const bool use_spline,
+                                                      const unsigned int table_width,
                                                       const Index2D table_value,
-                                                      const Scalar delta_th)
+                                                      const Scalar inv_delta_th)
     {
     // start by identifying which particle we are to handle
     unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -147,24 +153,39 @@ __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
         Scalar theta = acosf(c_abbc);
 
         // precomputed term
-        Scalar value_f = theta / delta_th;
+        Scalar value_f = theta * inv_delta_th;
 
         // compute index into the table and read in values
         unsigned int value_i = value_f;
-        Scalar2 VT0 = __ldg(d_tables + table_value(value_i, cur_angle_type));
-        Scalar2 VT1 = __ldg(d_tables + table_value(value_i + 1, cur_angle_type));
-        // unpack the data
-        Scalar V0 = VT0.x;
-        Scalar V1 = VT1.x;
-        Scalar T0 = VT0.y;
-        Scalar T1 = VT1.y;
-
-        // compute the linear interpolation coefficient
-        Scalar f = value_f - Scalar(value_i);
-
-        // interpolate to get V and T;
-        Scalar V = V0 + f * (V1 - V0);
-        Scalar T = T0 + f * (T1 - T0);
+        Scalar V, T;
+        if (use_spline)
+            {
+            // theta = pi falls at the end of the last interval
+            value_i = min(value_i, table_width - 2);
+            Scalar f = value_f - Scalar(value_i);
+            detail::table_spline_eval(__ldg(d_spline + table_value(value_i, cur_angle_type)),
+                                      f,
+                                      inv_delta_th,
+                                      V,
+                                      T);
+            }
+        else
+            {
+            Scalar2 VT0 = __ldg(d_tables + table_value(value_i, cur_angle_type));
+            Scalar2 VT1 = __ldg(d_tables + table_value(value_i + 1, cur_angle_type));
+            // unpack the data
+            Scalar V0 = VT0.x;
+            Scalar V1 = VT1.x;
+            Scalar T0 = VT0.y;
+            Scalar T1 = VT1.y;
+
+            // compute the linear interpolation coefficient
+            Scalar f = value_f - Scalar(value_i);
+
+            // interpolate to get V and T;
+            V = V0 + f * (V1 - V0);
+            T = T0 + f * (T1 - T0);
+            }
 
         Scalar a = T * s_abbc;
         Scalar a11 = a * c_abbc / rsqab;
@@ -233,6 +254,8 @@ __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
     \param n_angles_list List of numbers of angles stored on the GPU
     \param n_angle_type number of angle types
     \param d_tables Tables of the potential and force
+    \param d_spline Spline coefficients of each table interval
+    \param use_spline True to interpolate with cubic splines
     \param table_width Number of points in each table
     \param table_value indexer helper
     \param block_size Block size at which to run the kernel
@@ -252,6 +275,8 @@ hipError_t gpu_compute_table_angle_forces(Scalar4* d_force,
                                           const unsigned int pitch,
                                           const unsigned int* n_angles_list,
                                           const Scalar2* d_tables,
+                                          const Scalar4* d_spline,
+                                          const bool use_spline,
                                           const unsigned int table_width,
                                           const Index2D& table_value,
                                           const unsigned int block_size)
@@ -273,7 +298,7 @@ hipError_t gpu_compute_table_angle_forces(Scalar4* d_force,
     dim3 grid(N / run_block_size + 1, 1, 1);
     dim3 threads(run_block_size, 1, 1);
 
-    Scalar delta_th = Scalar(M_PI) / (Scalar)(table_width - 1);
+    Scalar inv_delta_th = (Scalar)(table_width - 1) / Scalar(M_PI);
 
     hipLaunchKernelGGL((gpu_compute_table_angle_forces_kernel),
                        dim3(grid),
@@ -291,8 +316,11 @@ hipError_t gpu_compute_table_angle_forces(Scalar4* d_force,
                        pitch,
                        n_angles_list,
                        d_tables,
+                       d_spline,
+                       use_spline,
+                       table_width,
                        table_value,
-                       delta_th);
+                       inv_delta_th);
 
     return hipSuccess;
     }
@@ -13,6 +13,8 @@
 #include "hoomd/Index1D.h"
 #include "hoomd/ParticleData.cuh"
 
+#include "TableSpline.h"
+
 #ifndef __TABLEANGLEFORCECOMPUTEGPU_CUH__
 #define __TABLEANGLEFORCECOMPUTEGPU_CUH__
 
@@ -34,6 +36,8 @@ hipError_t gpu_compute_table_angle_forces(Scalar4* d_force,
                                           const unsigned int pitch,
                                           const unsigned int* n_angles_list,
                                           const Scalar2* d_tables,
+                                          const Scalar4* d_spline,
+                                          const bool use_spline,
                                           const unsigned int table_width,
                                           const Index2D& table_value,
                                           const unsigned int block_size);
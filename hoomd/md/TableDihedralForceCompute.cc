@@ -6,6 +6,7 @@
 #include "TableDihedralForceCompute.h"
 #include "hoomd/VectorMath.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 /*! \file TableDihedralForceCompute.cc
@@ -29,7 +30,7 @@ namespace md
 */
 TableDihedralForceCompute::TableDihedralForceCompute(std::shared_ptr<SystemDefinition> sysdef,
                                                      unsigned int table_width)
-    : ForceCompute(sysdef), m_table_width(table_width)
+    : ForceCompute(sysdef), m_table_width(table_width), m_use_spline(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing TableDihedralForceCompute" << endl;
 
@@ -47,6 +48,8 @@ TableDihedralForceCompute::TableDihedralForceCompute(std::shared_ptr<SystemDefin
     GPUArray<Scalar2> tables(m_table_width, m_dihedral_data->getNTypes(), m_exec_conf);
     m_tables.swap(tables);
     assert(!m_tables.isNull());
+    GPUArray<Scalar4> spline(m_table_width, m_dihedral_data->getNTypes(), m_exec_conf);
+    m_spline.swap(spline);
 
     // helper to compute indices
     Index2D table_value((unsigned int)m_tables.getPitch(),
@@ -76,6 +79,7 @@ void TableDihedralForceCompute::setTable(unsigned int type,
 
     // access the arrays
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_spline(m_spline, access_location::host, access_mode::readwrite);
 
     if (V.size() != m_table_width || T.size() != m_table_width)
         {
@@ -90,6 +94,14 @@ void TableDihedralForceCompute::setTable(unsigned int type,
         h_tables.data[m_table_value(i, type)].x = V[i];
         h_tables.data[m_table_value(i, type)].y = T[i];
         }
+
+    // precompute the spline coefficients of each interval
+    Scalar delta_phi = Scalar(2.0 * M_PI) / Scalar(m_table_width - 1);
+    for (unsigned int i = 0; i + 1 < m_table_width; i++)
+        {
+        h_spline.data[m_table_value(i, type)]
+            = detail::table_spline_coeff(V[i], V[i + 1], T[i], T[i + 1], delta_phi);
+        }
     }
 
 /*! \post The table based forces are computed for the given timestep.
@@ -123,6 +135,9 @@ void TableDihedralForceCompute::computeForces(uint64_t timestep)
 
     // access the table data
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_spline(m_spline, access_location::host, access_mode::read);
+
+    Scalar inv_delta_phi = Scalar(m_table_width - 1) / Scalar(2.0 * M_PI);
 
     // for each of the dihedrals
     const unsigned int size = (unsigned int)m_dihedral_data->getN();
@@ -247,28 +262,42 @@ void TableDihedralForceCompute::computeForces(uint64_t timestep)
             phi = -phi;
 
         // precomputed term
-        Scalar delta_phi = Scalar(2.0 * M_PI) / Scalar(m_table_width - 1);
-        Scalar value_f = (Scalar(M_PI) + phi) / delta_phi;
+        Scalar value_f = (Scalar(M_PI) + phi) * inv_delta_phi;
 
         // compute index into the table and read in values
 
         /// Here we use the table!!
         unsigned int dihedral_type = m_dihedral_data->getTypeByIndex(i);
         unsigned int value_i = (unsigned int)value_f;
-        Scalar2 VT0 = h_tables.data[m_table_value(value_i, dihedral_type)];
-        Scalar2 VT1 = h_tables.data[m_table_value(value_i + 1, dihedral_type)];
-        // unpack the data
-        Scalar V0 = VT0.x;
-        Scalar V1 = VT1.x;
-        Scalar T0 = VT0.y;
-        Scalar T1 = VT1.y;
-
-        // compute the linear interpolation coefficient
-        Scalar f = value_f - Scalar(value_i);
-
-        // interpolate to get V and T;
-        Scalar V = V0 + f * (V1 - V0);
-        Scalar T = T0 + f * (T1 - T0);
+        Scalar V, T;
+        if (m_use_spline)
+            {
+            // phi = pi falls at the end of the last interval
+            value_i = std::min(value_i, m_table_width - 2);
+            Scalar f = value_f - Scalar(value_i);
+            detail::table_spline_eval(h_spline.data[m_table_value(value_i, dihedral_type)],
+                                      f,
+                                      inv_delta_phi,
+                                      V,
+                                      T);
+            }
+        else
+            {
+            Scalar2 VT0 = h_tables.data[m_table_value(value_i, dihedral_type)];
+            Scalar2 VT1 = h_tables.data[m_table_value(value_i + 1, dihedral_type)];
+            // unpack the data
+            Scalar V0 = VT0.x;
+            Scalar V1 = VT1.x;
+            Scalar T0 = VT0.y;
+            Scalar T1 = VT1.y;
+
+            // compute the linear interpolation coefficient
+            Scalar f = value_f - Scalar(value_i);
+
+            // interpolate to get V and T;
+            V = V0 + f * (V1 - V0);
+            T = T0 + f * (T1 - T0);
+            }
 
         // from Blondel and Karplus 1995
         vec3<Scalar> A = cross(vec3<Scalar>(dab), vec3<Scalar>(dcbm));
@@ -345,7 +374,10 @@ void export_TableDihedralForceCompute(pybind11::module& m)
                      std::shared_ptr<TableDihedralForceCompute>>(m, "TableDihedralForceCompute")
         .def(pybind11::init<std::shared_ptr<SystemDefinition>, unsigned int>())
         .def("setTable", &TableDihedralForceCompute::setTable)
-        .def("getEntry", &TableDihedralForceCompute::getEntry);
+        .def("getEntry", &TableDihedralForceCompute::getEntry)
+        .def_property("spline",
+                      &TableDihedralForceCompute::getSpline,
+                      &TableDihedralForceCompute::setSpline);
     }
 
     } // end namespace detail
@@ -8,6 +8,8 @@
 #include "hoomd/GPUArray.h"
 #include "hoomd/Index1D.h"
 
+#include "TableSpline.h"
+
 #include <memory>
 
 /*! \file TableDihedralForceCompute.h
@@ -53,7 +55,14 @@ namespace md
     Values are interpolated linearly between two points straddling the given r. For a given r, the
    first point needed, i can be calculated via i = floorf((r - rmin) / dr). The fraction between ri
    and ri+1 can be calculated via f = (r - rmin) / dr - Scalar(i). And the linear interpolation can
-   then be performed via V(r) ~= Vi + f * (Vi+1 - Vi) \ingroup computes
+   then be performed via V(r) ~= Vi + f * (Vi+1 - Vi)
+
+    \b Spline interpolation
+    When spline interpolation is enabled, each interval of the table is interpolated with the cubic
+    spline described in TableSpline.h. The spline coefficients are computed in setTable() and
+    stored in \a m_spline with the same layout as \a m_tables.
+
+    \ingroup computes
 */
 class PYBIND11_EXPORT TableDihedralForceCompute : public ForceCompute
     {
@@ -68,6 +77,18 @@ class PYBIND11_EXPORT TableDihedralForceCompute : public ForceCompute
     virtual void
     setTable(unsigned int type, const std::vector<Scalar>& V, const std::vector<Scalar>& T);
 
+    //! Set whether to interpolate the tables with cubic splines
+    void setSpline(bool spline)
+        {
+        m_use_spline = spline;
+        }
+
+    //! Get whether to interpolate the tables with cubic splines
+    bool getSpline() const
+        {
+        return m_use_spline;
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     /*! \param timestep Current time step
@@ -98,7 +119,9 @@ class PYBIND11_EXPORT TableDihedralForceCompute : public ForceCompute
     std::shared_ptr<DihedralData> m_dihedral_data; //!< Bond data to use in computing dihedrals
     unsigned int m_table_width;                    //!< Width of the tables in memory
     GPUArray<Scalar2> m_tables;                    //!< Stored V and F tables
+    GPUArray<Scalar4> m_spline;                    //!< Spline coefficients of each table interval
     Index2D m_table_value;                         //!< Index table helper
+    bool m_use_spline;                             //!< True to interpolate with cubic splines
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
@@ -60,6 +60,7 @@ void TableDihedralForceComputeGPU::computeForces(uint64_t timestep)
 
     // access the table data
     ArrayHandle<Scalar2> d_tables(m_tables, access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_spline(m_spline, access_location::device, access_mode::read);
 
     ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::overwrite);
     ArrayHandle<Scalar> d_virial(m_virial, access_location::device, access_mode::overwrite);
@@ -89,6 +90,8 @@ void TableDihedralForceComputeGPU::computeForces(uint64_t timestep)
                                                   m_dihedral_data->getGPUTableIndexer().getW(),
                                                   d_gpu_n_dihedrals.data,
                                                   d_tables.data,
+                                                  d_spline.data,
+                                                  m_use_spline,
                                                   m_table_width,
                                                   m_table_value,
                                                   m_tuner->getParam());
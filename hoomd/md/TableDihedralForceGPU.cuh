@@ -13,6 +13,8 @@
 #include "hoomd/Index1D.h"
 #include "hoomd/ParticleData.cuh"
 
+#include "TableSpline.h"
+
 #ifndef __TABLEDIHEDRALFORCECOMPUTEGPU_CUH__
 #define __TABLEDIHEDRALFORCECOMPUTEGPU_CUH__
 
@@ -34,6 +36,8 @@ hipError_t gpu_compute_table_dihedral_forces(Scalar4* d_force,
                                              const unsigned int pitch,
                                              const unsigned int* n_dihedrals_list,
                                              const Scalar2* d_tables,
+                                             const Scalar4* d_spline,
+                                             const bool use_spline,
                                              const unsigned int table_width,
                                              const Index2D& table_value,
                                              const unsigned int block_size);
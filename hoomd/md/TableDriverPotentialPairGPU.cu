@@ -7,6 +7,7 @@
 
 #include "AllDriverPotentialPairGPU.cuh"
 #include "EvaluatorPairTable.h"
+#include "EvaluatorPairTableSpline.h"
 
 namespace hoomd
     {
@@ -20,6 +21,12 @@ hipError_t gpu_compute_table_forces(const pair_args_t& pair_args,
     return gpu_compute_pair_forces<EvaluatorPairTable>(pair_args, d_params);
     }
 
+hipError_t gpu_compute_table_spline_forces(const pair_args_t& pair_args,
+                                           const EvaluatorPairTableSpline::param_type* d_params)
+    {
+    return gpu_compute_pair_forces<EvaluatorPairTableSpline>(pair_args, d_params);
+    }
+
     } // end namespace kernel
     } // end namespace md
     } // end namespace hoomd
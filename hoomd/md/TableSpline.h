@@ -0,0 +1,72 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/HOOMDMath.h"
+
+#ifndef __TABLE_SPLINE_H__
+#define __TABLE_SPLINE_H__
+
+/*! \file TableSpline.h
+    \brief Defines the cubic spline coefficients used by the bonded table potentials
+
+    The bonded table potentials (BondTablePotential, TableAngleForceCompute, and
+    TableDihedralForceCompute) store V and F = -dV/dx at evenly spaced points x_i. For spline
+    interpolation, the interval [x_i, x_i+1] holds the cubic Hermite spline through V_i and V_i+1
+    with slopes -F_i and -F_i+1 (the same spline as EvaluatorPairTableSpline) as the coefficients
+    of a polynomial in the fraction f = (x - x_i) / dx:
+
+        V(f) = c.x + f * (c.y + f * (c.z + f * c.w))
+
+    The coefficients are computed once when the table is set. Evaluation needs one Scalar4 load
+    and no divides, and the force is the exact derivative of the interpolated energy.
+*/
+
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace detail
+    {
+//! Compute the spline coefficients of one table interval
+/*! \param V0 Energy at the start of the interval
+    \param V1 Energy at the end of the interval
+    \param F0 -dV/dx at the start of the interval
+    \param F1 -dV/dx at the end of the interval
+    \param dx Width of the interval
+*/
+HOSTDEVICE inline Scalar4
+table_spline_coeff(Scalar V0, Scalar V1, Scalar F0, Scalar F1, Scalar dx)
+    {
+    return make_scalar4(V0,
+                        -dx * F0,
+                        Scalar(3.0) * (V1 - V0) + dx * (Scalar(2.0) * F0 + F1),
+                        Scalar(2.0) * (V0 - V1) - dx * (F0 + F1));
+    }
+
+//! Evaluate the spline of one table interval
+/*! \param c Spline coefficients of the interval
+    \param f Fraction of the interval, in [0,1]
+    \param inv_dx Inverse width of the interval
+    \param V Output energy
+    \param F Output -dV/dx
+*/
+HOSTDEVICE inline void
+table_spline_eval(const Scalar4& c, Scalar f, Scalar inv_dx, Scalar& V, Scalar& F)
+    {
+    V = c.x + f * (c.y + f * (c.z + f * c.w));
+    F = -inv_dx * (c.y + f * (Scalar(2.0) * c.z + f * Scalar(3.0) * c.w));
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif // __TABLE_SPLINE_H__
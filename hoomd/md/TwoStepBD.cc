@@ -100,15 +100,19 @@ void TwoStepBD::integrateStepOne(uint64_t timestep)
         unsigned int j = m_group->getMemberIndex(group_idx);
         unsigned int ptag = h_tag.data[j];
 
-        // Initialize the RNG
+        // Initialize the RNG. Draw the values in the same order as the GPU kernel.
         RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepBD, timestep, seed),
                             hoomd::Counter(ptag));
+        BulkRandomGenerator<Scalar> noise(rng);
 
         // compute the random force
-        UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
-        Scalar rx = uniform(rng);
-        Scalar ry = uniform(rng);
-        Scalar rz = uniform(rng);
+        Scalar rx = Scalar(0.0), ry = Scalar(0.0), rz = Scalar(0.0);
+        if (!m_noiseless_t)
+            {
+            rx = noise.uniformNeg11();
+            ry = noise.uniformNeg11();
+            rz = noise.uniformNeg11();
+            }
 
         Scalar gamma;
         if (m_use_alpha)
@@ -154,11 +158,10 @@ void TwoStepBD::integrateStepOne(uint64_t timestep)
             // draw a new random velocity for particle j
             Scalar mass = h_vel.data[j].w;
             Scalar sigma = fast::sqrt(currentTemp / mass);
-            NormalDistribution<Scalar> normal(sigma);
-            h_vel.data[j].x = normal(rng);
-            h_vel.data[j].y = normal(rng);
+            h_vel.data[j].x = noise.normal(sigma);
+            h_vel.data[j].y = noise.normal(sigma);
             if (D > 2)
-                h_vel.data[j].z = normal(rng);
+                h_vel.data[j].z = noise.normal(sigma);
             else
                 h_vel.data[j].z = 0;
             }
@@ -189,10 +192,13 @@ void TwoStepBD::integrateStepOne(uint64_t timestep)
 
                 // original Gaussian random torque
                 // Gaussian random distribution is preferred in terms of preserving the exact math
-                vec3<Scalar> bf_torque;
-                bf_torque.x = NormalDistribution<Scalar>(sigma_r.x)(rng);
-                bf_torque.y = NormalDistribution<Scalar>(sigma_r.y)(rng);
-                bf_torque.z = NormalDistribution<Scalar>(sigma_r.z)(rng);
+                vec3<Scalar> bf_torque(0, 0, 0);
+                if (!m_noiseless_r)
+                    {
+                    bf_torque.x = noise.normal(sigma_r.x);
+                    bf_torque.y = noise.normal(sigma_r.y);
+                    bf_torque.z = noise.normal(sigma_r.z);
+                    }
 
                 if (x_zero)
                     bf_torque.x = 0;
@@ -229,9 +235,9 @@ void TwoStepBD::integrateStepOne(uint64_t timestep)
                 else
                     {
                     // draw a new random ang_mom for particle j in body frame
-                    p_vec.x = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.x))(rng);
-                    p_vec.y = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.y))(rng);
-                    p_vec.z = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.z))(rng);
+                    p_vec.x = noise.normal(fast::sqrt(currentTemp * I.x));
+                    p_vec.y = noise.normal(fast::sqrt(currentTemp * I.y));
+                    p_vec.z = noise.normal(fast::sqrt(currentTemp * I.z));
                     }
 
                 if (x_zero)
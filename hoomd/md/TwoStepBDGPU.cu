@@ -125,13 +125,18 @@ __global__ void gpu_brownian_step_one_kernel(Scalar4* d_pos,
         // read in the tag of our particle.
         unsigned int ptag = d_tag[idx];
 
-        // compute the random force
+        // compute the random force. The translational and rotational noise share one stream that
+        // uses all 128 bits of each step.
         RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepBD, timestep, seed),
                             hoomd::Counter(ptag));
-        UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
-        Scalar rx = uniform(rng);
-        Scalar ry = uniform(rng);
-        Scalar rz = uniform(rng);
+        BulkRandomGenerator<Scalar> noise(rng);
+        Scalar rx = Scalar(0.0), ry = Scalar(0.0), rz = Scalar(0.0);
+        if (!d_noiseless_t)
+            {
+            rx = noise.uniformNeg11();
+            ry = noise.uniformNeg11();
+            rz = noise.uniformNeg11();
+            }
 
         // calculate the magnitude of the random force
         Scalar gamma;
@@ -182,11 +187,10 @@ __global__ void gpu_brownian_step_one_kernel(Scalar4* d_pos,
             // draw a new random velocity for particle j
             Scalar mass = vel.w;
             Scalar sigma = fast::sqrt(T / mass);
-            NormalDistribution<Scalar> normal(sigma);
-            vel.x = normal(rng);
-            vel.y = normal(rng);
+            vel.x = noise.normal(sigma);
+            vel.y = noise.normal(sigma);
             if (D > 2)
-                vel.z = normal(rng);
+                vel.z = noise.normal(sigma);
             else
                 vel.z = 0;
             }
@@ -224,10 +228,13 @@ __global__ void gpu_brownian_step_one_kernel(Scalar4* d_pos,
 
                 // original Gaussian random torque
                 // Gaussian random distribution is preferred in terms of preserving the exact math
-                vec3<Scalar> bf_torque;
-                bf_torque.x = NormalDistribution<Scalar>(sigma_r.x)(rng);
-                bf_torque.y = NormalDistribution<Scalar>(sigma_r.y)(rng);
-                bf_torque.z = NormalDistribution<Scalar>(sigma_r.z)(rng);
+                vec3<Scalar> bf_torque(0, 0, 0);
+                if (!d_noiseless_r)
+                    {
+                    bf_torque.x = noise.normal(sigma_r.x);
+                    bf_torque.y = noise.normal(sigma_r.y);
+                    bf_torque.z = noise.normal(sigma_r.z);
+                    }
 
                 if (x_zero)
                     bf_torque.x = 0;
@@ -261,9 +268,9 @@ __global__ void gpu_brownian_step_one_kernel(Scalar4* d_pos,
                 else
                     {
                     // draw a new random ang_mom for particle j in body frame
-                    p_vec.x = NormalDistribution<Scalar>(fast::sqrt(T * I.x))(rng);
-                    p_vec.y = NormalDistribution<Scalar>(fast::sqrt(T * I.y))(rng);
-                    p_vec.z = NormalDistribution<Scalar>(fast::sqrt(T * I.z))(rng);
+                    p_vec.x = noise.normal(fast::sqrt(T * I.x));
+                    p_vec.y = noise.normal(fast::sqrt(T * I.y));
+                    p_vec.z = noise.normal(fast::sqrt(T * I.z));
                     }
 
                 if (x_zero)
@@ -36,6 +36,9 @@ TwoStepBerendsen::TwoStepBerendsen(std::shared_ptr<SystemDefinition> sysdef,
 
     if (m_tau <= 0.0)
         m_exec_conf->msg->warning() << "integrate.berendsen: tau set less than 0.0" << endl;
+
+    // the thermostat only reads the kinetic energy
+    m_thermo->setRequestedQuantities(thermo_request::kinetic);
     }
 
 TwoStepBerendsen::~TwoStepBerendsen()
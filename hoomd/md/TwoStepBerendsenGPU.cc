@@ -44,8 +44,6 @@ TwoStepBerendsenGPU::TwoStepBerendsenGPU(std::shared_ptr<SystemDefinition> sysde
 */
 void TwoStepBerendsenGPU::integrateStepOne(uint64_t timestep)
     {
-    unsigned int group_size = m_group->getNumMembers();
-
     if (m_prof)
         m_prof->push("Berendsen");
 
@@ -76,13 +74,14 @@ void TwoStepBerendsenGPU::integrateStepOne(uint64_t timestep)
                                             access_location::device,
                                             access_mode::read);
 
-    // perform the integration on the GPU
+    // perform the integration on the GPU(s)
+    m_exec_conf->beginMultiGPU();
     kernel::gpu_berendsen_step_one(d_pos.data,
                                    d_vel.data,
                                    d_accel.data,
                                    d_image.data,
                                    d_index_array.data,
-                                   group_size,
+                                   m_group->getGPUPartition(),
                                    box,
                                    m_block_size,
                                    lambda,
@@ -90,6 +89,7 @@ void TwoStepBerendsenGPU::integrateStepOne(uint64_t timestep)
 
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
+    m_exec_conf->endMultiGPU();
 
     if (m_prof)
         m_prof->pop();
@@ -97,8 +97,6 @@ void TwoStepBerendsenGPU::integrateStepOne(uint64_t timestep)
 
 void TwoStepBerendsenGPU::integrateStepTwo(uint64_t timestep)
     {
-    unsigned int group_size = m_group->getNumMembers();
-
     if (m_prof)
         m_prof->push("Berendsen");
 
@@ -118,11 +116,12 @@ void TwoStepBerendsenGPU::integrateStepTwo(uint64_t timestep)
                                             access_location::device,
                                             access_mode::read);
 
-    // perform the second step of the integration on the GPU
+    // perform the second step of the integration on the GPU(s)
+    m_exec_conf->beginMultiGPU();
     kernel::gpu_berendsen_step_two(d_vel.data,
                                    d_accel.data,
                                    d_index_array.data,
-                                   group_size,
+                                   m_group->getGPUPartition(),
                                    d_net_force.data,
                                    m_block_size,
                                    m_deltaT);
@@ -130,6 +129,7 @@ void TwoStepBerendsenGPU::integrateStepTwo(uint64_t timestep)
     // check if an error occurred
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
+    m_exec_conf->endMultiGPU();
 
     if (m_prof)
         m_prof->pop();
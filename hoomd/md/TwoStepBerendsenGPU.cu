@@ -25,7 +25,8 @@ namespace kernel
     \param d_accel array of particle accelerations
     \param d_image array of particle images
     \param d_group_members Device array listing the indices of the members of the group to integrate
-    \param group_size Number of members in the group
+    \param nwork Number of group members to process on this GPU
+    \param offset Offset of this GPU in the list of group members
     \param box Box dimensions for applying periodic boundary conditions
     \param lambda Intermediate variable computed on the host and used in integrating the velocity
     \param deltaT Length of one timestep
@@ -38,16 +39,18 @@ __global__ void gpu_berendsen_step_one_kernel(Scalar4* d_pos,
                                               const Scalar3* d_accel,
                                               int3* d_image,
                                               unsigned int* d_group_members,
-                                              const unsigned int group_size,
+                                              const unsigned int nwork,
+                                              const unsigned int offset,
                                               const BoxDim box,
                                               const Scalar lambda,
                                               const Scalar deltaT)
     {
     // determine the particle index for this thread
-    int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
-    if (group_idx < group_size)
+    if (work_idx < nwork)
         {
+        const unsigned int group_idx = work_idx + offset;
         unsigned int idx = d_group_members[group_idx];
 
         // read the particle position
@@ -80,7 +83,8 @@ __global__ void gpu_berendsen_step_one_kernel(Scalar4* d_pos,
 /*! \param d_vel array of particle velocities
     \param d_accel array of particle accelerations
     \param d_group_members Device array listing the indices of the members of the group to integrate
-    \param group_size Number of members in the group
+    \param nwork Number of group members to process on this GPU
+    \param offset Offset of this GPU in the list of group members
     \param d_net_force Current net force on the particles
     \param deltaT Length of one timestep
 
@@ -90,15 +94,17 @@ __global__ void gpu_berendsen_step_one_kernel(Scalar4* d_pos,
 __global__ void gpu_berendsen_step_two_kernel(Scalar4* d_vel,
                                               Scalar3* d_accel,
                                               unsigned int* d_group_members,
-                                              const unsigned int group_size,
+                                              const unsigned int nwork,
+                                              const unsigned int offset,
                                               const Scalar4* d_net_force,
                                               const Scalar deltaT)
     {
     // determine the particle index for this thread
-    int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
-    if (group_idx < group_size)
+    if (work_idx < nwork)
         {
+        const unsigned int group_idx = work_idx + offset;
         unsigned int idx = d_group_members[group_idx];
 
         // read in the velocity
@@ -126,31 +132,40 @@ hipError_t gpu_berendsen_step_one(Scalar4* d_pos,
                                   const Scalar3* d_accel,
                                   int3* d_image,
                                   unsigned int* d_group_members,
-                                  unsigned int group_size,
+                                  const GPUPartition& gpu_partition,
                                   const BoxDim& box,
                                   unsigned int block_size,
                                   Scalar lambda,
                                   Scalar deltaT)
     {
-    // setup the grid to run the kernel
-    dim3 grid((group_size / block_size) + 1, 1, 1);
-    dim3 threads(block_size, 1, 1);
-
-    // run the kernel
-    hipLaunchKernelGGL((gpu_berendsen_step_one_kernel),
-                       dim3(grid),
-                       dim3(threads),
-                       block_size * sizeof(Scalar),
-                       0,
-                       d_pos,
-                       d_vel,
-                       d_accel,
-                       d_image,
-                       d_group_members,
-                       group_size,
-                       box,
-                       lambda,
-                       deltaT);
+    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+
+        // setup the grid to run the kernel
+        dim3 grid((nwork / block_size) + 1, 1, 1);
+        dim3 threads(block_size, 1, 1);
+
+        // run the kernel
+        hipLaunchKernelGGL((gpu_berendsen_step_one_kernel),
+                           dim3(grid),
+                           dim3(threads),
+                           0,
+                           0,
+                           d_pos,
+                           d_vel,
+                           d_accel,
+                           d_image,
+                           d_group_members,
+                           nwork,
+                           range.first,
+                           box,
+                           lambda,
+                           deltaT);
+        }
 
     return hipSuccess;
     }
@@ -158,27 +173,36 @@ hipError_t gpu_berendsen_step_one(Scalar4* d_pos,
 hipError_t gpu_berendsen_step_two(Scalar4* d_vel,
                                   Scalar3* d_accel,
                                   unsigned int* d_group_members,
-                                  unsigned int group_size,
+                                  const GPUPartition& gpu_partition,
                                   Scalar4* d_net_force,
                                   unsigned int block_size,
                                   Scalar deltaT)
     {
-    // setup the grid to run the kernel
-    dim3 grid((group_size / block_size) + 1, 1, 1);
-    dim3 threads(block_size, 1, 1);
-
-    // run the kernel
-    hipLaunchKernelGGL((gpu_berendsen_step_two_kernel),
-                       dim3(grid),
-                       dim3(threads),
-                       block_size * sizeof(Scalar),
-                       0,
-                       d_vel,
-                       d_accel,
-                       d_group_members,
-                       group_size,
-                       d_net_force,
-                       deltaT);
+    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+
+        // setup the grid to run the kernel
+        dim3 grid((nwork / block_size) + 1, 1, 1);
+        dim3 threads(block_size, 1, 1);
+
+        // run the kernel
+        hipLaunchKernelGGL((gpu_berendsen_step_two_kernel),
+                           dim3(grid),
+                           dim3(threads),
+                           0,
+                           0,
+                           d_vel,
+                           d_accel,
+                           d_group_members,
+                           nwork,
+                           range.first,
+                           d_net_force,
+                           deltaT);
+        }
 
     return hipSuccess;
     }
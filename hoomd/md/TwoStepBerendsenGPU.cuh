@@ -3,6 +3,7 @@
 
 // Maintainer: joaander
 
+#include "hoomd/GPUPartition.cuh"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/ParticleData.cuh"
 
@@ -25,7 +26,7 @@ hipError_t gpu_berendsen_step_one(Scalar4* d_pos,
                                   const Scalar3* d_accel,
                                   int3* d_image,
                                   unsigned int* d_group_members,
-                                  unsigned int group_size,
+                                  const GPUPartition& gpu_partition,
                                   const BoxDim& box,
                                   unsigned int block_size,
                                   Scalar lambda,
@@ -35,7 +36,7 @@ hipError_t gpu_berendsen_step_one(Scalar4* d_pos,
 hipError_t gpu_berendsen_step_two(Scalar4* d_vel,
                                   Scalar3* d_accel,
                                   unsigned int* d_group_members,
-                                  unsigned int group_size,
+                                  const GPUPartition& gpu_partition,
                                   Scalar4* d_net_force,
                                   unsigned int block_size,
                                   Scalar deltaT);
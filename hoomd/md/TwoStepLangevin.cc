@@ -268,13 +268,17 @@ void TwoStepLangevin::integrateStepTwo(uint64_t timestep)
         // Initialize the RNG
         RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepLangevin, timestep, seed),
                             hoomd::Counter(ptag));
+        BulkRandomGenerator<Scalar> noise(rng);
 
         // first, calculate the BD forces
         // Generate three random numbers
-        hoomd::UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
-        Scalar rx = uniform(rng);
-        Scalar ry = uniform(rng);
-        Scalar rz = uniform(rng);
+        Scalar rx = Scalar(0.0), ry = Scalar(0.0), rz = Scalar(0.0);
+        if (!m_noiseless_t)
+            {
+            rx = noise.uniformNeg11();
+            ry = noise.uniformNeg11();
+            rz = noise.uniformNeg11();
+            }
 
         Scalar gamma;
         if (m_use_alpha)
@@ -341,9 +345,13 @@ void TwoStepLangevin::integrateStepTwo(uint64_t timestep)
                 if (m_noiseless_r)
                     sigma_r = make_scalar3(0.0, 0.0, 0.0);
 
-                Scalar rand_x = hoomd::NormalDistribution<Scalar>(sigma_r.x)(rng);
-                Scalar rand_y = hoomd::NormalDistribution<Scalar>(sigma_r.y)(rng);
-                Scalar rand_z = hoomd::NormalDistribution<Scalar>(sigma_r.z)(rng);
+                Scalar rand_x = Scalar(0.0), rand_y = Scalar(0.0), rand_z = Scalar(0.0);
+                if (!m_noiseless_r)
+                    {
+                    rand_x = noise.normal(sigma_r.x);
+                    rand_y = noise.normal(sigma_r.y);
+                    rand_z = noise.normal(sigma_r.z);
+                    }
 
                 // check for degenerate moment of inertia
                 bool x_zero, y_zero, z_zero;
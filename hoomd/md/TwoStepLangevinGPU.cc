@@ -22,23 +22,18 @@ namespace md
 TwoStepLangevinGPU::TwoStepLangevinGPU(std::shared_ptr<SystemDefinition> sysdef,
                                        std::shared_ptr<ParticleGroup> group,
                                        std::shared_ptr<Variant> T)
-    : TwoStepLangevin(sysdef, group, T)
+    : TwoStepLangevin(sysdef, group, T), m_partial_sum1(m_exec_conf)
     {
     if (!m_exec_conf->isCUDAEnabled())
         {
         throw std::runtime_error("Cannot create TwoStepLangevinGPU on a CPU device.");
         }
 
-    // allocate the sum arrays
-    GPUArray<Scalar> sum(1, m_exec_conf);
+    // allocate the sum array, the partial sum array is sized in integrateStepTwo()
+    GlobalArray<Scalar> sum(1, m_exec_conf);
     m_sum.swap(sum);
-
-    // initialize the partial sum array
     m_block_size = 256;
-    unsigned int group_size = m_group->getNumMembers();
-    m_num_blocks = group_size / m_block_size + 1;
-    GPUArray<Scalar> partial_sum1(m_num_blocks, m_exec_conf);
-    m_partial_sum1.swap(partial_sum1);
+    m_num_blocks = 0;
 
     hipDeviceProp_t dev_prop = m_exec_conf->dev_prop;
     m_tuner_one.reset(new Autotuner(dev_prop.warpSize,
@@ -172,6 +167,36 @@ void TwoStepLangevinGPU::integrateStepTwo(uint64_t timestep)
                                             access_location::device,
                                             access_mode::read);
 
+    // each GPU reduces its range of the group into its own blocks of the partial sum array
+    const GPUPartition& gpu_partition = m_group->getGPUPartition();
+    m_num_blocks = 0;
+    for (unsigned int idev = 0; idev < gpu_partition.getNumActiveGPUs(); ++idev)
+        {
+        auto range = gpu_partition.getRange(idev);
+        m_num_blocks += (range.second - range.first) / m_block_size + 1;
+        }
+
+    if (m_partial_sum1.size() < m_num_blocks)
+        {
+        m_partial_sum1.resize(m_num_blocks);
+#ifdef __HIP_PLATFORM_NVCC__
+        if (m_exec_conf->allConcurrentManagedAccess())
+            {
+            auto& gpu_map = m_exec_conf->getGPUIds();
+
+            // map the partial sums into the memory of all GPUs
+            for (unsigned int idev = 0; idev < m_exec_conf->getNumActiveGPUs(); ++idev)
+                {
+                cudaMemAdvise(m_partial_sum1.get(),
+                              sizeof(Scalar) * m_partial_sum1.getNumElements(),
+                              cudaMemAdviseSetAccessedBy,
+                              gpu_map[idev]);
+                }
+            CHECK_CUDA_ERROR();
+            }
+#endif
+        }
+
         {
         ArrayHandle<Scalar> d_partial_sumBD(m_partial_sum1,
                                             access_location::device,
@@ -193,10 +218,7 @@ void TwoStepLangevinGPU::integrateStepTwo(uint64_t timestep)
                                         access_location::device,
                                         access_mode::read);
 
-        unsigned int group_size = m_group->getNumMembers();
-        m_num_blocks = group_size / m_block_size + 1;
-
-        // perform the update on the GPU
+        // perform the update on the GPU(s)
         kernel::langevin_step_two_args args;
         args.d_gamma = d_gamma.data;
         args.n_types = (unsigned int)m_gamma.getNumElements();
@@ -213,13 +235,14 @@ void TwoStepLangevinGPU::integrateStepTwo(uint64_t timestep)
         args.noiseless_r = m_noiseless_r;
         args.tally = m_tally;
 
+        m_exec_conf->beginMultiGPU();
         kernel::gpu_langevin_step_two(d_pos.data,
                                       d_vel.data,
                                       d_accel.data,
                                       d_diameter.data,
                                       d_tag.data,
                                       d_index_array.data,
-                                      group_size,
+                                      gpu_partition,
                                       d_net_force.data,
                                       args,
                                       m_deltaT,
@@ -227,6 +250,16 @@ void TwoStepLangevinGPU::integrateStepTwo(uint64_t timestep)
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
+        m_exec_conf->endMultiGPU();
+
+        // reduce the partial sums of all GPUs on the first GPU
+        if (m_tally)
+            {
+            kernel::gpu_langevin_bdtally_reduce(args);
+
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
 
         if (m_aniso)
             {
@@ -244,7 +277,7 @@ void TwoStepLangevinGPU::integrateStepTwo(uint64_t timestep)
                                            access_location::device,
                                            access_mode::read);
 
-            unsigned int group_size = m_group->getNumMembers();
+            m_exec_conf->beginMultiGPU();
             gpu_langevin_angular_step_two(d_pos.data,
                                           d_orientation.data,
                                           d_angmom.data,
@@ -253,7 +286,7 @@ void TwoStepLangevinGPU::integrateStepTwo(uint64_t timestep)
                                           d_index_array.data,
                                           d_gamma_r.data,
                                           d_tag.data,
-                                          group_size,
+                                          gpu_partition,
                                           args,
                                           m_deltaT,
                                           D,
@@ -261,6 +294,7 @@ void TwoStepLangevinGPU::integrateStepTwo(uint64_t timestep)
 
             if (m_exec_conf->isCUDAErrorCheckingEnabled())
                 CHECK_CUDA_ERROR();
+            m_exec_conf->endMultiGPU();
             }
         }
 
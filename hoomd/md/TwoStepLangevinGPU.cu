@@ -29,7 +29,8 @@ namespace kernel
     \param d_diameter array of particle diameters
     \param d_tag array of particle tags
     \param d_group_members Device array listing the indices of the members of the group to integrate
-    \param group_size Number of members in the group
+    \param nwork Number of group members to process on this GPU
+    \param offset Offset of this GPU into the group member list
     \param d_net_force Net force on each particle
     \param d_gamma List of per-type gammas
     \param n_types Number of particle types in the simulation
@@ -42,6 +43,7 @@ namespace kernel
     \param D Dimensionality of the system
     \param tally Boolean indicating whether energy tally is performed or not
     \param d_partial_sum_bdenergy Placeholder for the partial sum
+    \param block_offset Offset of this GPU into the partial sum array
 
     This kernel is implemented in a very similar manner to gpu_nve_step_two_kernel(), see it for
    design details.
@@ -56,7 +58,8 @@ __global__ void gpu_langevin_step_two_kernel(const Scalar4* d_pos,
                                              const Scalar* d_diameter,
                                              const unsigned int* d_tag,
                                              unsigned int* d_group_members,
-                                             unsigned int group_size,
+                                             unsigned int nwork,
+                                             unsigned int offset,
                                              Scalar4* d_net_force,
                                              Scalar* d_gamma,
                                              unsigned int n_types,
@@ -69,7 +72,8 @@ __global__ void gpu_langevin_step_two_kernel(const Scalar4* d_pos,
                                              Scalar deltaT,
                                              unsigned int D,
                                              bool tally,
-                                             Scalar* d_partial_sum_bdenergy)
+                                             Scalar* d_partial_sum_bdenergy,
+                                             unsigned int block_offset)
     {
     HIP_DYNAMIC_SHARED(char, s_data)
     Scalar* s_gammas = (Scalar*)s_data;
@@ -86,12 +90,13 @@ __global__ void gpu_langevin_step_two_kernel(const Scalar4* d_pos,
         }
 
     // determine which particle this thread works on (MEM TRANSFER: 4 bytes)
-    int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
     Scalar bd_energy_transfer = 0;
 
-    if (group_idx < group_size)
+    if (work_idx < nwork)
         {
+        const unsigned int group_idx = work_idx + offset;
         unsigned int idx = d_group_members[group_idx];
 
         // ******** first, calculate the additional BD force
@@ -122,14 +127,17 @@ __global__ void gpu_langevin_step_two_kernel(const Scalar4* d_pos,
         if (noiseless_t)
             coeff = Scalar(0.0);
 
-        // Initialize the Random Number Generator and generate the 3 random numbers
-        RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepLangevin, timestep, seed),
-                            hoomd::Counter(ptag));
-        UniformDistribution<Scalar> uniform(-1, 1);
-
-        Scalar randomx = uniform(rng);
-        Scalar randomy = uniform(rng);
-        Scalar randomz = uniform(rng);
+        // Initialize the Random Number Generator and generate the 3 random numbers from 2 steps
+        Scalar randomx = Scalar(0.0), randomy = Scalar(0.0), randomz = Scalar(0.0);
+        if (!noiseless_t)
+            {
+            RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepLangevin, timestep, seed),
+                                hoomd::Counter(ptag));
+            BulkRandomGenerator<Scalar> noise(rng);
+            randomx = noise.uniformNeg11();
+            randomy = noise.uniformNeg11();
+            randomz = noise.uniformNeg11();
+            }
 
         bd_force.x = randomx * coeff - gamma * vel.x;
         bd_force.y = randomy * coeff - gamma * vel.y;
@@ -182,7 +190,7 @@ __global__ void gpu_langevin_step_two_kernel(const Scalar4* d_pos,
         // write out our partial sum
         if (threadIdx.x == 0)
             {
-            d_partial_sum_bdenergy[blockIdx.x] = bdtally_sdata[0];
+            d_partial_sum_bdenergy[block_offset + blockIdx.x] = bdtally_sdata[0];
             }
         }
     }
@@ -237,7 +245,8 @@ gpu_bdtally_reduce_partial_sum_kernel(Scalar* d_sum, Scalar* d_partial_sum, unsi
     \param d_group_members Device array listing the indices of the members of the group to integrate
     \param d_gamma_r List of per-type gamma_rs (rotational drag coeff.)
     \param d_tag array of particle tags
-    \param group_size Number of members in the group
+    \param nwork Number of group members to process on this GPU
+    \param offset Offset of this GPU into the group member list
     \param timestep Current timestep of the simulation
     \param seed User chosen random number seed
     \param T Temperature set point
@@ -255,7 +264,8 @@ __global__ void gpu_langevin_angular_step_two_kernel(const Scalar4* d_pos,
                                                      const Scalar3* d_gamma_r,
                                                      const unsigned int* d_tag,
                                                      unsigned int n_types,
-                                                     unsigned int group_size,
+                                                     unsigned int nwork,
+                                                     unsigned int offset,
                                                      uint64_t timestep,
                                                      uint16_t seed,
                                                      Scalar T,
@@ -276,10 +286,11 @@ __global__ void gpu_langevin_angular_step_two_kernel(const Scalar4* d_pos,
     __syncthreads();
 
     // determine which particle this thread works on (MEM TRANSFER: 4 bytes)
-    int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
-    if (group_idx < group_size)
+    if (work_idx < nwork)
         {
+        const unsigned int group_idx = work_idx + offset;
         unsigned int idx = d_group_members[group_idx];
         unsigned int ptag = d_tag[idx];
 
@@ -309,11 +320,17 @@ __global__ void gpu_langevin_angular_step_two_kernel(const Scalar4* d_pos,
             if (noiseless_r)
                 sigma_r = make_scalar3(0, 0, 0);
 
-            RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepLangevinAngular, timestep, seed),
-                                hoomd::Counter(ptag));
-            Scalar rand_x = NormalDistribution<Scalar>(sigma_r.x)(rng);
-            Scalar rand_y = NormalDistribution<Scalar>(sigma_r.y)(rng);
-            Scalar rand_z = NormalDistribution<Scalar>(sigma_r.z)(rng);
+            Scalar rand_x = Scalar(0.0), rand_y = Scalar(0.0), rand_z = Scalar(0.0);
+            if (!noiseless_r)
+                {
+                RandomGenerator rng(
+                    hoomd::Seed(RNGIdentifier::TwoStepLangevinAngular, timestep, seed),
+                    hoomd::Counter(ptag));
+                BulkRandomGenerator<Scalar> noise(rng);
+                rand_x = noise.normal(sigma_r.x);
+                rand_y = noise.normal(sigma_r.y);
+                rand_z = noise.normal(sigma_r.z);
+                }
 
             // check for zero moment of inertia
             bool x_zero, y_zero, z_zero;
@@ -388,7 +405,7 @@ __global__ void gpu_langevin_angular_step_two_kernel(const Scalar4* d_pos,
     \param d_group_members Device array listing the indices of the members of the group to integrate
     \param d_gamma_r List of per-type gamma_rs (rotational drag coeff.)
     \param d_tag array of particle tags
-    \param group_size Number of members in the group
+    \param gpu_partition Load balancing info for multi-GPU execution
     \param langevin_args Collected arguments for gpu_langevin_step_two_kernel() and
    gpu_langevin_angular_step_two() \param deltaT timestep \param D dimensionality of the system
 
@@ -403,7 +420,7 @@ hipError_t gpu_langevin_angular_step_two(const Scalar4* d_pos,
                                          const unsigned int* d_group_members,
                                          const Scalar3* d_gamma_r,
                                          const unsigned int* d_tag,
-                                         unsigned int group_size,
+                                         const GPUPartition& gpu_partition,
                                          const langevin_step_two_args& langevin_args,
                                          Scalar deltaT,
                                          unsigned int D,
@@ -411,33 +428,41 @@ hipError_t gpu_langevin_angular_step_two(const Scalar4* d_pos,
     {
     // setup the grid to run the kernel
     int block_size = 256;
-    dim3 grid((group_size / block_size) + 1, 1, 1);
     dim3 threads(block_size, 1, 1);
 
-    // run the kernel
-    hipLaunchKernelGGL(gpu_langevin_angular_step_two_kernel,
-                       grid,
-                       threads,
-                       max((unsigned int)(sizeof(Scalar3) * langevin_args.n_types),
-                           (unsigned int)(langevin_args.block_size * sizeof(Scalar))),
-                       0,
-                       d_pos,
-                       d_orientation,
-                       d_angmom,
-                       d_inertia,
-                       d_net_torque,
-                       d_group_members,
-                       d_gamma_r,
-                       d_tag,
-                       langevin_args.n_types,
-                       group_size,
-                       langevin_args.timestep,
-                       langevin_args.seed,
-                       langevin_args.T,
-                       langevin_args.noiseless_r,
-                       deltaT,
-                       D,
-                       scale);
+    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+        dim3 grid((nwork / block_size) + 1, 1, 1);
+
+        // run the kernel
+        hipLaunchKernelGGL(gpu_langevin_angular_step_two_kernel,
+                           grid,
+                           threads,
+                           (unsigned int)(sizeof(Scalar3) * langevin_args.n_types),
+                           0,
+                           d_pos,
+                           d_orientation,
+                           d_angmom,
+                           d_inertia,
+                           d_net_torque,
+                           d_group_members,
+                           d_gamma_r,
+                           d_tag,
+                           langevin_args.n_types,
+                           nwork,
+                           range.first,
+                           langevin_args.timestep,
+                           langevin_args.seed,
+                           langevin_args.T,
+                           langevin_args.noiseless_r,
+                           deltaT,
+                           D,
+                           scale);
+        }
 
     return hipSuccess;
     }
@@ -448,7 +473,7 @@ hipError_t gpu_langevin_angular_step_two(const Scalar4* d_pos,
     \param d_diameter array of particle diameters
     \param d_tag array of particle tags
     \param d_group_members Device array listing the indices of the members of the group to integrate
-    \param group_size Number of members in the group
+    \param gpu_partition Load balancing info for multi-GPU execution
     \param d_net_force Net force on each particle
     \param langevin_args Collected arguments for gpu_langevin_step_two_kernel() and
    gpu_langevin_angular_step_two() \param deltaT Amount of real time to step forward in one time
@@ -462,56 +487,76 @@ hipError_t gpu_langevin_step_two(const Scalar4* d_pos,
                                  const Scalar* d_diameter,
                                  const unsigned int* d_tag,
                                  unsigned int* d_group_members,
-                                 unsigned int group_size,
+                                 const GPUPartition& gpu_partition,
                                  Scalar4* d_net_force,
                                  const langevin_step_two_args& langevin_args,
                                  Scalar deltaT,
                                  unsigned int D)
     {
     // setup the grid to run the kernel
-    dim3 grid(langevin_args.num_blocks, 1, 1);
-    dim3 grid1(1, 1, 1);
     dim3 threads(langevin_args.block_size, 1, 1);
-    dim3 threads1(256, 1, 1);
-
-    // run the kernel
-    hipLaunchKernelGGL((gpu_langevin_step_two_kernel),
-                       grid,
-                       threads,
-                       max((unsigned int)(sizeof(Scalar) * langevin_args.n_types),
-                           (unsigned int)(langevin_args.block_size * sizeof(Scalar))),
-                       0,
-                       d_pos,
-                       d_vel,
-                       d_accel,
-                       d_diameter,
-                       d_tag,
-                       d_group_members,
-                       group_size,
-                       d_net_force,
-                       langevin_args.d_gamma,
-                       langevin_args.n_types,
-                       langevin_args.use_alpha,
-                       langevin_args.alpha,
-                       langevin_args.timestep,
-                       langevin_args.seed,
-                       langevin_args.T,
-                       langevin_args.noiseless_t,
-                       deltaT,
-                       D,
-                       langevin_args.tally,
-                       langevin_args.d_partial_sum_bdenergy);
-
-    // run the summation kernel
-    if (langevin_args.tally)
-        hipLaunchKernelGGL((gpu_bdtally_reduce_partial_sum_kernel),
-                           dim3(grid1),
-                           dim3(threads1),
-                           langevin_args.block_size * sizeof(Scalar),
+
+    // each GPU writes its partial sums after those of the GPUs with lower index
+    unsigned int block_offset = langevin_args.num_blocks;
+
+    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+        dim3 grid(nwork / langevin_args.block_size + 1, 1, 1);
+        block_offset -= grid.x;
+
+        // run the kernel
+        hipLaunchKernelGGL((gpu_langevin_step_two_kernel),
+                           grid,
+                           threads,
+                           max((unsigned int)(sizeof(Scalar) * langevin_args.n_types),
+                               (unsigned int)(langevin_args.block_size * sizeof(Scalar))),
                            0,
-                           &langevin_args.d_sum_bdenergy[0],
+                           d_pos,
+                           d_vel,
+                           d_accel,
+                           d_diameter,
+                           d_tag,
+                           d_group_members,
+                           nwork,
+                           range.first,
+                           d_net_force,
+                           langevin_args.d_gamma,
+                           langevin_args.n_types,
+                           langevin_args.use_alpha,
+                           langevin_args.alpha,
+                           langevin_args.timestep,
+                           langevin_args.seed,
+                           langevin_args.T,
+                           langevin_args.noiseless_t,
+                           deltaT,
+                           D,
+                           langevin_args.tally,
                            langevin_args.d_partial_sum_bdenergy,
-                           langevin_args.num_blocks);
+                           block_offset);
+        }
+
+    return hipSuccess;
+    }
+
+/*! \param langevin_args Collected arguments for gpu_langevin_step_two_kernel()
+
+    Sums the langevin_args.num_blocks partial sums written by gpu_langevin_step_two() on all GPUs
+    into langevin_args.d_sum_bdenergy. Call on the first GPU after the step two kernels complete.
+*/
+hipError_t gpu_langevin_bdtally_reduce(const langevin_step_two_args& langevin_args)
+    {
+    hipLaunchKernelGGL((gpu_bdtally_reduce_partial_sum_kernel),
+                       dim3(1, 1, 1),
+                       dim3(256, 1, 1),
+                       256 * sizeof(Scalar),
+                       0,
+                       &langevin_args.d_sum_bdenergy[0],
+                       langevin_args.d_partial_sum_bdenergy,
+                       langevin_args.num_blocks);
 
     return hipSuccess;
     }
@@ -7,6 +7,7 @@
     \brief Declares GPU kernel code for Langevin dynamics on the GPU. Used by TwoStepLangevinGPU.
 */
 
+#include "hoomd/GPUPartition.cuh"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/ParticleData.cuh"
 #include <hip/hip_runtime.h>
@@ -46,12 +47,15 @@ hipError_t gpu_langevin_step_two(const Scalar4* d_pos,
                                  const Scalar* d_diameter,
                                  const unsigned int* d_tag,
                                  unsigned int* d_group_members,
-                                 unsigned int group_size,
+                                 const GPUPartition& gpu_partition,
                                  Scalar4* d_net_force,
                                  const langevin_step_two_args& langevin_args,
                                  Scalar deltaT,
                                  unsigned int D);
 
+//! Kernel driver that sums the partial bd energy transfers of all GPUs
+hipError_t gpu_langevin_bdtally_reduce(const langevin_step_two_args& langevin_args);
+
 //! Kernel driver for the second part of the angular Langevin update (NO_SQUISH) by
 //! TwoStepLangevinGPU
 hipError_t gpu_langevin_angular_step_two(const Scalar4* d_pos,
@@ -62,7 +66,7 @@ hipError_t gpu_langevin_angular_step_two(const Scalar4* d_pos,
                                          const unsigned int* d_group_members,
                                          const Scalar3* d_gamma_r,
                                          const unsigned int* d_tag,
-                                         unsigned int group_size,
+                                         const GPUPartition& gpu_partition,
                                          const langevin_step_two_args& langevin_args,
                                          Scalar deltaT,
                                          unsigned int D,
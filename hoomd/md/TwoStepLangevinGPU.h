@@ -50,10 +50,10 @@ class PYBIND11_EXPORT TwoStepLangevinGPU : public TwoStepLangevin
         }
 
     protected:
-    unsigned int m_block_size;       //!< block size for partial sum memory
-    unsigned int m_num_blocks;       //!< number of memory blocks reserved for partial sum memory
-    GPUArray<Scalar> m_partial_sum1; //!< memory space for partial sum over bd energy transfers
-    GPUArray<Scalar> m_sum;          //!< memory space for sum over bd energy transfers
+    unsigned int m_block_size;           //!< block size for partial sum memory
+    unsigned int m_num_blocks;           //!< number of memory blocks used for partial sum memory
+    GlobalVector<Scalar> m_partial_sum1; //!< memory space for partial sum over bd energy transfers
+    GlobalArray<Scalar> m_sum;           //!< memory space for sum over bd energy transfers
 
     std::unique_ptr<Autotuner> m_tuner_one; //!< Autotuner for block size (step one kernel)
     std::unique_ptr<Autotuner>
@@ -78,6 +78,9 @@ TwoStepNPTMTK::TwoStepNPTMTK(std::shared_ptr<SystemDefinition> sysdef,
     if (m_flags == 0)
         m_exec_conf->msg->warning() << "integrate.npt: No barostat couplings specified." << endl;
 
+    // the thermostat half step only reads the kinetic energy
+    m_thermo_half_step->setRequestedQuantities(thermo_request::kinetic);
+
     bool is_two_dimensions = m_sysdef->getNDimensions() == 2;
     m_V = m_pdata->getGlobalBox().getVolume(is_two_dimensions); // volume
 
@@ -405,10 +408,9 @@ void TwoStepNPTMTK::integrateStepOne(uint64_t timestep)
 #ifdef ENABLE_MPI
     if (m_sysdef->isDomainDecomposed())
         {
-        // broadcast integrator variables from rank 0 to other processors
-        v = getIntegratorVariables();
-        MPI_Bcast(&v.variable.front(), 10, MPI_HOOMD_SCALAR, 0, m_exec_conf->getMPICommunicator());
-        setIntegratorVariables(v);
+        // broadcast integrator variables from rank 0 to other processors, overlapped with the
+        // force computation
+        startBroadcastIntegratorVariables();
         }
 #endif
 
@@ -334,10 +334,9 @@ void TwoStepNPTMTKGPU::integrateStepOne(uint64_t timestep)
 #ifdef ENABLE_MPI
     if (m_sysdef->isDomainDecomposed())
         {
-        // broadcast integrator variables from rank 0 to other processors
-        v = getIntegratorVariables();
-        MPI_Bcast(&v.variable.front(), 10, MPI_HOOMD_SCALAR, 0, m_exec_conf->getMPICommunicator());
-        setIntegratorVariables(v);
+        // broadcast integrator variables from rank 0 to other processors, overlapped with the
+        // force computation
+        startBroadcastIntegratorVariables();
         }
 #endif
 
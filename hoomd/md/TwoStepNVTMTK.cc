@@ -41,6 +41,9 @@ TwoStepNVTMTK::TwoStepNVTMTK(std::shared_ptr<SystemDefinition> sysdef,
     if (m_tau <= 0.0)
         m_exec_conf->msg->warning() << "integrate.nvt: tau set less than 0.0 in NVTUpdater" << endl;
 
+    // the thermostat only reads the kinetic energy
+    m_thermo->setRequestedQuantities(thermo_request::kinetic);
+
     // set initial state
     if (!restartInfoTestValid(getIntegratorVariables(), "nvt_mtk", 4))
         {
@@ -407,15 +410,6 @@ void TwoStepNVTMTK::advanceThermostat(uint64_t timestep, bool broadcast)
     // update loop-invariant quantity
     m_exp_thermo_fac = exp(-Scalar(1.0 / 2.0) * xi * m_deltaT);
 
-#ifdef ENABLE_MPI
-    if (m_sysdef->isDomainDecomposed() && broadcast)
-        {
-        // broadcast integrator variables from rank 0 to other processors
-        MPI_Bcast(&xi, 1, MPI_HOOMD_SCALAR, 0, m_exec_conf->getMPICommunicator());
-        MPI_Bcast(&eta, 1, MPI_HOOMD_SCALAR, 0, m_exec_conf->getMPICommunicator());
-        }
-#endif
-
     if (m_aniso)
         {
         // update thermostat for rotational DOF
@@ -434,18 +428,18 @@ void TwoStepNVTMTK::advanceThermostat(uint64_t timestep, bool broadcast)
                        * (Scalar(2.0) * curr_ke_rot / ndof_rot / (*m_T)(timestep)-Scalar(1.0));
 
         eta_rot += xi_prime_rot * m_deltaT;
-
-#ifdef ENABLE_MPI
-        if (m_sysdef->isDomainDecomposed())
-            {
-            // broadcast integrator variables from rank 0 to other processors
-            MPI_Bcast(&xi_rot, 1, MPI_HOOMD_SCALAR, 0, m_exec_conf->getMPICommunicator());
-            MPI_Bcast(&eta_rot, 1, MPI_HOOMD_SCALAR, 0, m_exec_conf->getMPICommunicator());
-            }
-#endif
         }
 
     setIntegratorVariables(v);
+
+#ifdef ENABLE_MPI
+    if (m_sysdef->isDomainDecomposed() && broadcast)
+        {
+        // broadcast integrator variables from rank 0 to other processors, overlapped with the
+        // force computation
+        startBroadcastIntegratorVariables();
+        }
+#endif
     }
 
 void TwoStepNVTMTK::thermalizeThermostatDOF(uint64_t timestep)
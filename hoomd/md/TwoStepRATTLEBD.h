@@ -503,40 +503,56 @@ template<class Manifold> void TwoStepRATTLEBD<Manifold>::includeRATTLEForce(uint
 
         Scalar inv_alpha = -Scalar(1.0) / deltaT_gamma;
 
-        Scalar3 residual;
-        Scalar resid;
-
-        unsigned int iteration = 0;
-        do
+        // project along the normal in closed form when the manifold allows it
+        Scalar3 unconstrained_pos;
+        unconstrained_pos.x = h_pos.data[j].x + (h_net_force.data[j].x + Fr_x) * deltaT_gamma;
+        unconstrained_pos.y = h_pos.data[j].y + (h_net_force.data[j].y + Fr_y) * deltaT_gamma;
+        unconstrained_pos.z = h_pos.data[j].z + (h_net_force.data[j].z + Fr_z) * deltaT_gamma;
+
+        Scalar t;
+        if (m_manifold.intersectLine(unconstrained_pos, normal, t))
             {
-            iteration++;
-            residual.x = h_pos.data[j].x - next_pos.x
-                         + (h_net_force.data[j].x + Fr_x - mu * normal.x) * deltaT_gamma;
-            residual.y = h_pos.data[j].y - next_pos.y
-                         + (h_net_force.data[j].y + Fr_y - mu * normal.y) * deltaT_gamma;
-            residual.z = h_pos.data[j].z - next_pos.z
-                         + (h_net_force.data[j].z + Fr_z - mu * normal.z) * deltaT_gamma;
-            resid = m_manifold.implicitFunction(next_pos);
+            mu = t * inv_alpha;
+            }
+        else
+            {
+            Scalar3 residual;
+            Scalar resid;
 
-            Scalar3 next_normal = m_manifold.derivative(next_pos);
+            unsigned int iteration = 0;
+            do
+                {
+                iteration++;
+                residual.x = h_pos.data[j].x - next_pos.x
+                             + (h_net_force.data[j].x + Fr_x - mu * normal.x) * deltaT_gamma;
+                residual.y = h_pos.data[j].y - next_pos.y
+                             + (h_net_force.data[j].y + Fr_y - mu * normal.y) * deltaT_gamma;
+                residual.z = h_pos.data[j].z - next_pos.z
+                             + (h_net_force.data[j].z + Fr_z - mu * normal.z) * deltaT_gamma;
+                resid = m_manifold.implicitFunction(next_pos);
 
-            Scalar nndotr = dot(next_normal, residual);
-            Scalar nndotn = dot(next_normal, normal);
-            Scalar beta = (resid + nndotr) / nndotn;
+                Scalar3 next_normal = m_manifold.derivative(next_pos);
 
-            next_pos.x = next_pos.x - beta * normal.x + residual.x;
-            next_pos.y = next_pos.y - beta * normal.y + residual.y;
-            next_pos.z = next_pos.z - beta * normal.z + residual.z;
-            mu = mu - beta * inv_alpha;
+                Scalar nndotr = dot(next_normal, residual);
+                Scalar nndotn = dot(next_normal, normal);
+                Scalar beta = (resid + nndotr) / nndotn;
 
-            } while (maxNorm(residual, resid) > m_tolerance && iteration < maxiteration);
+                next_pos.x = next_pos.x - beta * normal.x + residual.x;
+                next_pos.y = next_pos.y - beta * normal.y + residual.y;
+                next_pos.z = next_pos.z - beta * normal.z + residual.z;
+                mu = mu - beta * inv_alpha;
 
-        if (iteration == maxiteration)
-            {
-            m_exec_conf->msg->warning()
-                << "The RATTLE integrator needed an unusual high number of iterations!" << std::endl
-                << "It is recomended to change the initial configuration or lower the step size."
-                << std::endl;
+                } while (maxNorm(residual, resid) > m_tolerance && iteration < maxiteration);
+
+            if (iteration == maxiteration)
+                {
+                m_exec_conf->msg->warning()
+                    << "The RATTLE integrator needed an unusual high number of iterations!"
+                    << std::endl
+                    << "It is recomended to change the initial configuration or lower the step "
+                       "size."
+                    << std::endl;
+                }
             }
 
         h_net_force.data[j].x -= mu * normal.x;
@@ -556,39 +556,53 @@ __global__ void gpu_include_rattle_force_bd_kernel(const Scalar4* d_pos,
         Scalar inv_alpha = -deltaT_gamma;
         inv_alpha = Scalar(1.0) / inv_alpha;
 
-        Scalar3 residual;
-        Scalar resid;
-        unsigned int iteration = 0;
-        const unsigned int maxiteration = 10;
-
-        do
+        // project along the normal in closed form when the manifold allows it
+        Scalar3 unconstrained_pos;
+        unconstrained_pos.x = postype.x + (net_force.x + brownian_force.x) * deltaT_gamma;
+        unconstrained_pos.y = postype.y + (net_force.y + brownian_force.y) * deltaT_gamma;
+        unconstrained_pos.z = postype.z + (net_force.z + brownian_force.z) * deltaT_gamma;
+
+        Scalar t;
+        if (manifold.intersectLine(unconstrained_pos, normal, t))
+            {
+            mu = t * inv_alpha;
+            }
+        else
             {
-            iteration++;
-            residual.x = postype.x - next_pos.x
-                         + (net_force.x + brownian_force.x - mu * normal.x) * deltaT_gamma;
-            residual.y = postype.y - next_pos.y
-                         + (net_force.y + brownian_force.y - mu * normal.y) * deltaT_gamma;
-            residual.z = postype.z - next_pos.z
-                         + (net_force.z + brownian_force.z - mu * normal.z) * deltaT_gamma;
-            resid = manifold.implicitFunction(next_pos);
-
-            Scalar3 next_normal = manifold.derivative(next_pos);
-
-            Scalar nndotr = dot(next_normal, residual);
-            Scalar nndotn = dot(next_normal, normal);
-            Scalar beta = (resid + nndotr) / nndotn;
-
-            next_pos.x = next_pos.x - beta * normal.x + residual.x;
-            next_pos.y = next_pos.y - beta * normal.y + residual.y;
-            next_pos.z = next_pos.z - beta * normal.z + residual.z;
-            mu = mu - beta * inv_alpha;
-
-            resid = fabs(resid);
-            Scalar vec_norm = sqrt(dot(residual, residual));
-            if (vec_norm > resid)
-                resid = vec_norm;
-
-            } while (resid > tolerance && iteration < maxiteration);
+            Scalar3 residual;
+            Scalar resid;
+            unsigned int iteration = 0;
+            const unsigned int maxiteration = 10;
+
+            do
+                {
+                iteration++;
+                residual.x = postype.x - next_pos.x
+                             + (net_force.x + brownian_force.x - mu * normal.x) * deltaT_gamma;
+                residual.y = postype.y - next_pos.y
+                             + (net_force.y + brownian_force.y - mu * normal.y) * deltaT_gamma;
+                residual.z = postype.z - next_pos.z
+                             + (net_force.z + brownian_force.z - mu * normal.z) * deltaT_gamma;
+                resid = manifold.implicitFunction(next_pos);
+
+                Scalar3 next_normal = manifold.derivative(next_pos);
+
+                Scalar nndotr = dot(next_normal, residual);
+                Scalar nndotn = dot(next_normal, normal);
+                Scalar beta = (resid + nndotr) / nndotn;
+
+                next_pos.x = next_pos.x - beta * normal.x + residual.x;
+                next_pos.y = next_pos.y - beta * normal.y + residual.y;
+                next_pos.z = next_pos.z - beta * normal.z + residual.z;
+                mu = mu - beta * inv_alpha;
+
+                resid = fabs(resid);
+                Scalar vec_norm = sqrt(dot(residual, residual));
+                if (vec_norm > resid)
+                    resid = vec_norm;
+
+                } while (resid > tolerance && iteration < maxiteration);
+            }
 
         net_force.x -= mu * normal.x;
         net_force.y -= mu * normal.y;
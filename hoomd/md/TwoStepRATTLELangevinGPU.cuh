@@ -255,41 +255,8 @@ __global__ void gpu_rattle_langevin_step_two_kernel(const Scalar4* d_pos,
         next_vel.y = vel.y + Scalar(1.0 / 2.0) * deltaT * accel.y;
         next_vel.z = vel.z + Scalar(1.0 / 2.0) * deltaT * accel.z;
 
-        Scalar mu = 0;
-        Scalar inv_alpha = -Scalar(1.0 / 2.0) * deltaT;
-        inv_alpha = Scalar(1.0) / inv_alpha;
-
-        Scalar3 residual;
-        Scalar resid;
-        Scalar3 vel_dot;
-
-        const unsigned int maxiteration = 10;
-        unsigned int iteration = 0;
-        do
-            {
-            iteration++;
-            vel_dot.x = accel.x - mu * minv * normal.x;
-            vel_dot.y = accel.y - mu * minv * normal.y;
-            vel_dot.z = accel.z - mu * minv * normal.z;
-
-            residual.x = vel.x - next_vel.x + Scalar(1.0 / 2.0) * deltaT * vel_dot.x;
-            residual.y = vel.y - next_vel.y + Scalar(1.0 / 2.0) * deltaT * vel_dot.y;
-            residual.z = vel.z - next_vel.z + Scalar(1.0 / 2.0) * deltaT * vel_dot.z;
-            resid = dot(normal, next_vel) * minv;
-
-            Scalar ndotr = dot(normal, residual);
-            Scalar beta = (mass * resid + ndotr) / ndotn;
-            next_vel.x = next_vel.x - normal.x * beta + residual.x;
-            next_vel.y = next_vel.y - normal.y * beta + residual.y;
-            next_vel.z = next_vel.z - normal.z * beta + residual.z;
-            mu = mu - mass * beta * inv_alpha;
-
-            resid = fabs(resid);
-            Scalar vec_norm = sqrt(dot(residual, residual));
-            if (vec_norm > resid)
-                resid = vec_norm;
-
-            } while (resid * mass > tolerance && iteration < maxiteration);
+        // the velocity constraint is linear in mu, so it has a closed form solution
+        Scalar mu = Scalar(2.0) * mass * dot(normal, next_vel) / (deltaT * ndotn);
 
         vel.x += (Scalar(1.0) / Scalar(2.0)) * (accel.x - mu * minv * normal.x) * deltaT;
         vel.y += (Scalar(1.0) / Scalar(2.0)) * (accel.y - mu * minv * normal.y) * deltaT;
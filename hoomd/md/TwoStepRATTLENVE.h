@@ -448,10 +448,6 @@ template<class Manifold> void TwoStepRATTLENVE<Manifold>::integrateStepTwo(uint6
             h_accel.data[j].z = h_net_force.data[j].z * inv_mass;
             }
 
-        Scalar mu = 0;
-        Scalar inv_alpha = -Scalar(1.0 / 2.0) * m_deltaT;
-        inv_alpha = Scalar(1.0) / inv_alpha;
-
         Scalar3 normal = m_manifold.derivative(
             make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z));
 
@@ -460,40 +456,8 @@ template<class Manifold> void TwoStepRATTLENVE<Manifold>::integrateStepTwo(uint6
         next_vel.y = h_vel.data[j].y + Scalar(1.0 / 2.0) * m_deltaT * h_accel.data[j].y;
         next_vel.z = h_vel.data[j].z + Scalar(1.0 / 2.0) * m_deltaT * h_accel.data[j].z;
 
-        Scalar3 residual;
-        Scalar resid;
-        Scalar3 vel_dot;
-
-        unsigned int iteration = 0;
-        do
-            {
-            iteration++;
-            vel_dot.x = h_accel.data[j].x - mu * inv_mass * normal.x;
-            vel_dot.y = h_accel.data[j].y - mu * inv_mass * normal.y;
-            vel_dot.z = h_accel.data[j].z - mu * inv_mass * normal.z;
-
-            residual.x = h_vel.data[j].x - next_vel.x + Scalar(1.0 / 2.0) * m_deltaT * vel_dot.x;
-            residual.y = h_vel.data[j].y - next_vel.y + Scalar(1.0 / 2.0) * m_deltaT * vel_dot.y;
-            residual.z = h_vel.data[j].z - next_vel.z + Scalar(1.0 / 2.0) * m_deltaT * vel_dot.z;
-            resid = dot(normal, next_vel) * inv_mass;
-
-            Scalar ndotr = dot(normal, residual);
-            Scalar ndotn = dot(normal, normal);
-            Scalar beta = (mass * resid + ndotr) / ndotn;
-            next_vel.x = next_vel.x - normal.x * beta + residual.x;
-            next_vel.y = next_vel.y - normal.y * beta + residual.y;
-            next_vel.z = next_vel.z - normal.z * beta + residual.z;
-            mu = mu - mass * beta * inv_alpha;
-
-            } while (maxNorm(residual, resid) * mass > m_tolerance && iteration < maxiteration);
-
-        if (iteration == maxiteration)
-            {
-            m_exec_conf->msg->warning()
-                << "The RATTLE integrator needed an unusual high number of iterations!" << std::endl
-                << "It is recomended to change the initial configuration or lower the step size."
-                << std::endl;
-            }
+        // the velocity constraint is linear in mu, so it has a closed form solution
+        Scalar mu = Scalar(2.0) * mass * dot(normal, next_vel) / (m_deltaT * dot(normal, normal));
 
         // then, update the velocity
         h_vel.data[j].x
@@ -613,44 +577,59 @@ template<class Manifold> void TwoStepRATTLENVE<Manifold>::includeRATTLEForce(uin
         Scalar inv_alpha = -deltaT_half * m_deltaT * inv_mass;
         inv_alpha = Scalar(1.0) / inv_alpha;
 
-        Scalar3 residual;
-        Scalar resid;
+        // project along the normal in closed form when the manifold allows it
         Scalar3 half_vel;
+        half_vel.x = h_vel.data[j].x + deltaT_half * h_accel.data[j].x;
+        half_vel.y = h_vel.data[j].y + deltaT_half * h_accel.data[j].y;
+        half_vel.z = h_vel.data[j].z + deltaT_half * h_accel.data[j].z;
 
-        unsigned int iteration = 0;
-        do
+        Scalar t;
+        if (m_manifold.intersectLine(next_pos + m_deltaT * half_vel, normal, t))
             {
-            iteration++;
-            half_vel.x = h_vel.data[j].x
-                         + deltaT_half * (h_accel.data[j].x - inv_mass * lambda * normal.x);
-            half_vel.y = h_vel.data[j].y
-                         + deltaT_half * (h_accel.data[j].y - inv_mass * lambda * normal.y);
-            half_vel.z = h_vel.data[j].z
-                         + deltaT_half * (h_accel.data[j].z - inv_mass * lambda * normal.z);
-
-            residual.x = h_pos.data[j].x - next_pos.x + m_deltaT * half_vel.x;
-            residual.y = h_pos.data[j].y - next_pos.y + m_deltaT * half_vel.y;
-            residual.z = h_pos.data[j].z - next_pos.z + m_deltaT * half_vel.z;
-            resid = m_manifold.implicitFunction(next_pos);
-
-            Scalar3 next_normal = m_manifold.derivative(next_pos);
-            Scalar nndotr = dot(next_normal, residual);
-            Scalar nndotn = dot(next_normal, normal);
-            Scalar beta = (resid + nndotr) / nndotn;
-
-            next_pos.x = next_pos.x - beta * normal.x + residual.x;
-            next_pos.y = next_pos.y - beta * normal.y + residual.y;
-            next_pos.z = next_pos.z - beta * normal.z + residual.z;
-            lambda = lambda - beta * inv_alpha;
-
-            } while (maxNorm(residual, resid) > m_tolerance && iteration < maxiteration);
-
-        if (iteration == maxiteration)
+            lambda = t * inv_alpha;
+            }
+        else
             {
-            m_exec_conf->msg->warning()
-                << "The RATTLE integrator needed an unusual high number of iterations!" << std::endl
-                << "It is recomended to change the initial configuration or lower the step size."
-                << std::endl;
+            Scalar3 residual;
+            Scalar resid;
+
+            unsigned int iteration = 0;
+            do
+                {
+                iteration++;
+                half_vel.x = h_vel.data[j].x
+                             + deltaT_half * (h_accel.data[j].x - inv_mass * lambda * normal.x);
+                half_vel.y = h_vel.data[j].y
+                             + deltaT_half * (h_accel.data[j].y - inv_mass * lambda * normal.y);
+                half_vel.z = h_vel.data[j].z
+                             + deltaT_half * (h_accel.data[j].z - inv_mass * lambda * normal.z);
+
+                residual.x = h_pos.data[j].x - next_pos.x + m_deltaT * half_vel.x;
+                residual.y = h_pos.data[j].y - next_pos.y + m_deltaT * half_vel.y;
+                residual.z = h_pos.data[j].z - next_pos.z + m_deltaT * half_vel.z;
+                resid = m_manifold.implicitFunction(next_pos);
+
+                Scalar3 next_normal = m_manifold.derivative(next_pos);
+                Scalar nndotr = dot(next_normal, residual);
+                Scalar nndotn = dot(next_normal, normal);
+                Scalar beta = (resid + nndotr) / nndotn;
+
+                next_pos.x = next_pos.x - beta * normal.x + residual.x;
+                next_pos.y = next_pos.y - beta * normal.y + residual.y;
+                next_pos.z = next_pos.z - beta * normal.z + residual.z;
+                lambda = lambda - beta * inv_alpha;
+
+                } while (maxNorm(residual, resid) > m_tolerance && iteration < maxiteration);
+
+            if (iteration == maxiteration)
+                {
+                m_exec_conf->msg->warning()
+                    << "The RATTLE integrator needed an unusual high number of iterations!"
+                    << std::endl
+                    << "It is recomended to change the initial configuration or lower the step "
+                       "size."
+                    << std::endl;
+                }
             }
 
         h_net_force.data[j].x -= lambda * normal.x;
@@ -160,9 +160,6 @@ __global__ void gpu_rattle_nve_step_two_kernel(Scalar4* d_pos,
 
         // update the velocity (FLOPS: 6)
 
-        Scalar mu = 0;
-        Scalar inv_alpha = -Scalar(1.0 / 2.0) * deltaT;
-        inv_alpha = Scalar(1.0) / inv_alpha;
         Scalar mass = vel.w;
         Scalar inv_mass = Scalar(1.0) / mass;
 
@@ -173,38 +170,8 @@ __global__ void gpu_rattle_nve_step_two_kernel(Scalar4* d_pos,
         next_vel.y = vel.y + Scalar(1.0 / 2.0) * deltaT * accel.y;
         next_vel.z = vel.z + Scalar(1.0 / 2.0) * deltaT * accel.z;
 
-        Scalar3 residual;
-        Scalar resid;
-        Scalar3 vel_dot;
-
-        const unsigned int maxiteration = 10;
-        unsigned int iteration = 0;
-        do
-            {
-            iteration++;
-            vel_dot.x = accel.x - mu * inv_mass * normal.x;
-            vel_dot.y = accel.y - mu * inv_mass * normal.y;
-            vel_dot.z = accel.z - mu * inv_mass * normal.z;
-
-            residual.x = vel.x - next_vel.x + Scalar(1.0 / 2.0) * deltaT * vel_dot.x;
-            residual.y = vel.y - next_vel.y + Scalar(1.0 / 2.0) * deltaT * vel_dot.y;
-            residual.z = vel.z - next_vel.z + Scalar(1.0 / 2.0) * deltaT * vel_dot.z;
-            resid = dot(normal, next_vel) * inv_mass;
-
-            Scalar ndotr = dot(normal, residual);
-            Scalar ndotn = dot(normal, normal);
-            Scalar beta = (mass * resid + ndotr) / ndotn;
-            next_vel.x = next_vel.x - normal.x * beta + residual.x;
-            next_vel.y = next_vel.y - normal.y * beta + residual.y;
-            next_vel.z = next_vel.z - normal.z * beta + residual.z;
-            mu = mu - mass * beta * inv_alpha;
-
-            resid = fabs(resid);
-            Scalar vec_norm = sqrt(dot(residual, residual));
-            if (vec_norm > resid)
-                resid = vec_norm;
-
-            } while (resid * mass > tolerance && iteration < maxiteration);
+        // the velocity constraint is linear in mu, so it has a closed form solution
+        Scalar mu = Scalar(2.0) * mass * dot(normal, next_vel) / (deltaT * dot(normal, normal));
 
         vel.x += (Scalar(1.0) / Scalar(2.0)) * (accel.x - mu * inv_mass * normal.x) * deltaT;
         vel.y += (Scalar(1.0) / Scalar(2.0)) * (accel.y - mu * inv_mass * normal.y) * deltaT;
@@ -356,34 +323,44 @@ __global__ void gpu_include_rattle_force_nve_kernel(const Scalar4* d_pos,
         inv_alpha = Scalar(1.0) / inv_alpha;
 
         Scalar3 next_pos = pos;
-        Scalar3 residual;
-        Scalar resid;
-        Scalar3 half_vel;
 
-        const unsigned int maxiteration = 10;
-        unsigned int iteration = 0;
-        do
+        // project along the normal in closed form when the manifold allows it
+        Scalar t;
+        if (manifold.intersectLine(pos + deltaT * (vel + deltaT_half * accel), normal, t))
+            {
+            lambda = t * inv_alpha;
+            }
+        else
             {
-            iteration++;
-            half_vel = vel + deltaT_half * accel - deltaT_half * inv_mass * lambda * normal;
+            Scalar3 residual;
+            Scalar resid;
+            Scalar3 half_vel;
+
+            const unsigned int maxiteration = 10;
+            unsigned int iteration = 0;
+            do
+                {
+                iteration++;
+                half_vel = vel + deltaT_half * accel - deltaT_half * inv_mass * lambda * normal;
 
-            residual = pos - next_pos + deltaT * half_vel;
-            resid = manifold.implicitFunction(next_pos);
+                residual = pos - next_pos + deltaT * half_vel;
+                resid = manifold.implicitFunction(next_pos);
 
-            Scalar3 next_normal = manifold.derivative(next_pos);
-            Scalar nndotr = dot(next_normal, residual);
-            Scalar nndotn = dot(next_normal, normal);
-            Scalar beta = (resid + nndotr) / nndotn;
+                Scalar3 next_normal = manifold.derivative(next_pos);
+                Scalar nndotr = dot(next_normal, residual);
+                Scalar nndotn = dot(next_normal, normal);
+                Scalar beta = (resid + nndotr) / nndotn;
 
-            next_pos = next_pos - beta * normal + residual;
-            lambda = lambda - beta * inv_alpha;
+                next_pos = next_pos - beta * normal + residual;
+                lambda = lambda - beta * inv_alpha;
 
-            resid = fabs(resid);
-            Scalar vec_norm = sqrt(dot(residual, residual));
-            if (vec_norm > resid)
-                resid = vec_norm;
+                resid = fabs(resid);
+                Scalar vec_norm = sqrt(dot(residual, residual));
+                if (vec_norm > resid)
+                    resid = vec_norm;
 
-            } while (resid > tolerance && iteration < maxiteration);
+                } while (resid > tolerance && iteration < maxiteration);
+            }
 
         accel -= lambda * normal;
 
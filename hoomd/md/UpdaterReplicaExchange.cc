@@ -0,0 +1,219 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file UpdaterReplicaExchange.cc
+    \brief Defines the UpdaterReplicaExchange class
+*/
+
+#include "UpdaterReplicaExchange.h"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#include <pybind11/stl.h>
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+namespace hoomd
+    {
+namespace md
+    {
+/*! \param sysdef System of this replica
+    \param group Group of all particles, used to compute the potential energy
+    \param kT Variant that holds the temperature of this replica
+    \param ladder Temperatures of the replicas, one per partition
+
+    Partition p starts at the temperature ladder[p].
+*/
+UpdaterReplicaExchange::UpdaterReplicaExchange(std::shared_ptr<SystemDefinition> sysdef,
+                                               std::shared_ptr<ParticleGroup> group,
+                                               std::shared_ptr<VariantConstant> kT,
+                                               const std::vector<Scalar>& ladder)
+    : Updater(sysdef), m_kT(kT), m_ladder(ladder), m_n_updates(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing UpdaterReplicaExchange" << endl;
+
+    if (m_ladder.size() != m_exec_conf->getNPartitions())
+        {
+        throw invalid_argument("ReplicaExchange: The temperature ladder must have one temperature "
+                               "per partition");
+        }
+    for (Scalar value : m_ladder)
+        {
+        if (!(value > Scalar(0.0)))
+            throw invalid_argument("ReplicaExchange: Temperatures must be positive");
+        }
+
+    m_thermo = std::make_shared<ComputeThermo>(sysdef, group);
+    m_thermo->setRequestedQuantities(thermo_request::potential_energy);
+
+    m_ladder_index = m_exec_conf->getPartition();
+    m_kT->setValue(m_ladder[m_ladder_index]);
+
+    m_n_attempted.resize(m_ladder.size() - 1, 0);
+    m_n_accepted.resize(m_ladder.size() - 1, 0);
+
+#ifdef ENABLE_MPI
+    // communicator that contains only the partition roots, ordered by partition
+    MPI_Comm_split(m_exec_conf->getHOOMDWorldMPICommunicator(),
+                   m_exec_conf->isRoot() ? 0 : MPI_UNDEFINED,
+                   m_exec_conf->getPartition(),
+                   &m_roots_comm);
+#endif
+    }
+
+UpdaterReplicaExchange::~UpdaterReplicaExchange()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying UpdaterReplicaExchange" << endl;
+
+#ifdef ENABLE_MPI
+    if (m_roots_comm != MPI_COMM_NULL)
+        MPI_Comm_free(&m_roots_comm);
+#endif
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void UpdaterReplicaExchange::update(uint64_t timestep)
+    {
+    Updater::update(timestep);
+
+    const unsigned int n_replicas = (unsigned int)m_ladder.size();
+    if (n_replicas < 2)
+        return;
+
+    if (m_prof)
+        m_prof->push("ReplicaExchange");
+
+    // all ranks of the partition take part in the reduction of the energy
+    m_thermo->compute(timestep);
+    double energy = m_thermo->getPotentialEnergy();
+    const unsigned int old_index = m_ladder_index;
+
+    // exchanges are attempted between the even pairs (0, 1), (2, 3), ... and the odd pairs
+    // (1, 2), (3, 4), ... on alternating updates
+    const unsigned int first = (unsigned int)(m_n_updates % 2);
+    m_n_updates++;
+
+    // counts of accepted exchanges, followed by the new ladder index of this partition
+    std::vector<unsigned int> result(n_replicas, 0);
+
+#ifdef ENABLE_MPI
+    if (m_exec_conf->isRoot())
+        {
+        double send[2] = {energy, double(m_ladder_index)};
+        std::vector<double> recv(2 * n_replicas);
+        MPI_Allgather(send, 2, MPI_DOUBLE, recv.data(), 2, MPI_DOUBLE, m_roots_comm);
+
+        // the partition and energy at each ladder index
+        std::vector<unsigned int> partition_of(n_replicas);
+        std::vector<double> energy_of(n_replicas);
+        for (unsigned int p = 0; p < n_replicas; p++)
+            {
+            unsigned int k = (unsigned int)recv[2 * p + 1];
+            partition_of[k] = p;
+            energy_of[k] = recv[2 * p];
+            }
+
+        // every root draws the same random numbers and makes the same decisions
+        RandomGenerator rng(
+            hoomd::Seed(RNGIdentifier::UpdaterReplicaExchange, timestep, m_sysdef->getSeed()),
+            hoomd::Counter());
+        UniformDistribution<double> uniform(0.0, 1.0);
+
+        for (unsigned int k = first; k + 1 < n_replicas; k += 2)
+            {
+            double delta = (1.0 / m_ladder[k] - 1.0 / m_ladder[k + 1])
+                           * (energy_of[k] - energy_of[k + 1]);
+            double u = uniform(rng);
+            if (delta >= 0.0 || u < exp(delta))
+                {
+                std::swap(partition_of[k], partition_of[k + 1]);
+                m_n_accepted[k]++;
+                }
+            }
+
+        for (unsigned int k = 0; k < n_replicas; k++)
+            {
+            if (partition_of[k] == m_exec_conf->getPartition())
+                m_ladder_index = k;
+            }
+
+        std::copy(m_n_accepted.begin(), m_n_accepted.end(), result.begin());
+        result[n_replicas - 1] = m_ladder_index;
+        }
+
+    // send the result to the other ranks of the partition
+    MPI_Bcast(result.data(),
+              n_replicas,
+              MPI_UNSIGNED,
+              0,
+              m_exec_conf->getMPICommunicator());
+#endif
+
+    std::copy(result.begin(), result.end() - 1, m_n_accepted.begin());
+    m_ladder_index = result[n_replicas - 1];
+    for (unsigned int k = first; k + 1 < n_replicas; k += 2)
+        m_n_attempted[k]++;
+
+    if (m_ladder_index != old_index)
+        {
+        Scalar kT_old = m_ladder[old_index];
+        Scalar kT_new = m_ladder[m_ladder_index];
+        m_kT->setValue(kT_new);
+        scaleMomenta(slow::sqrt(kT_new / kT_old));
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param factor Factor to multiply the velocities and angular momenta by
+ */
+void UpdaterReplicaExchange::scaleMomenta(Scalar factor)
+    {
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        {
+        h_vel.data[i].x *= factor;
+        h_vel.data[i].y *= factor;
+        h_vel.data[i].z *= factor;
+        h_angmom.data[i].x *= factor;
+        h_angmom.data[i].y *= factor;
+        h_angmom.data[i].z *= factor;
+        h_angmom.data[i].w *= factor;
+        }
+    }
+
+namespace detail
+    {
+void export_UpdaterReplicaExchange(pybind11::module& m)
+    {
+    pybind11::class_<UpdaterReplicaExchange, Updater, std::shared_ptr<UpdaterReplicaExchange>>(
+        m,
+        "UpdaterReplicaExchange")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<ParticleGroup>,
+                            std::shared_ptr<VariantConstant>,
+                            const std::vector<Scalar>&>())
+        .def_property_readonly("ladder", &UpdaterReplicaExchange::getLadder)
+        .def_property_readonly("ladder_index", &UpdaterReplicaExchange::getLadderIndex)
+        .def_property_readonly("num_attempted", &UpdaterReplicaExchange::getNumAttempted)
+        .def_property_readonly("num_accepted", &UpdaterReplicaExchange::getNumAccepted);
+    }
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
@@ -0,0 +1,106 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file UpdaterReplicaExchange.h
+    \brief Declares an updater that exchanges temperatures between partitions
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "ComputeThermo.h"
+#include "hoomd/Updater.h"
+#include "hoomd/Variant.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+#include <vector>
+
+#ifndef __UPDATER_REPLICA_EXCHANGE_H__
+#define __UPDATER_REPLICA_EXCHANGE_H__
+
+namespace hoomd
+    {
+namespace md
+    {
+//! Exchanges temperatures between the partitions of a parallel tempering simulation
+/*! Each partition of the HOOMD world communicator runs one replica. The replicas keep their
+    particle configurations and exchange only the index into the temperature ladder. On each
+    update, the partition roots gather the potential energies and current ladder indices of all
+    partitions with one MPI_Allgather on a communicator that contains only the partition roots.
+    Every root then makes the same Metropolis decisions for alternating even and odd neighboring
+    pairs of temperatures with a random number stream that depends only on the seed and the
+    timestep, and broadcasts the result to the other ranks of its partition.
+
+    The temperature of the replica is stored in a VariantConstant that the integration methods of
+    the partition use. When the temperature of a partition changes, the velocities and angular
+    momenta are scaled by sqrt(kT_new / kT_old).
+
+    \ingroup updaters
+*/
+class PYBIND11_EXPORT UpdaterReplicaExchange : public Updater
+    {
+    public:
+    //! Constructor
+    UpdaterReplicaExchange(std::shared_ptr<SystemDefinition> sysdef,
+                           std::shared_ptr<ParticleGroup> group,
+                           std::shared_ptr<VariantConstant> kT,
+                           const std::vector<Scalar>& ladder);
+    virtual ~UpdaterReplicaExchange();
+
+    //! Attempt the exchanges
+    virtual void update(uint64_t timestep);
+
+    //! Get the index of the temperature of this partition in the ladder
+    unsigned int getLadderIndex()
+        {
+        return m_ladder_index;
+        }
+
+    //! Get the temperature ladder
+    std::vector<Scalar> getLadder()
+        {
+        return m_ladder;
+        }
+
+    //! Get the number of exchanges attempted between each pair of neighboring temperatures
+    std::vector<unsigned int> getNumAttempted()
+        {
+        return m_n_attempted;
+        }
+
+    //! Get the number of exchanges accepted between each pair of neighboring temperatures
+    std::vector<unsigned int> getNumAccepted()
+        {
+        return m_n_accepted;
+        }
+
+    protected:
+    std::shared_ptr<ComputeThermo> m_thermo; //!< Computes the potential energy of the replica
+    std::shared_ptr<VariantConstant> m_kT;   //!< Temperature of the replica
+    std::vector<Scalar> m_ladder;            //!< Temperature of each ladder index
+    unsigned int m_ladder_index;             //!< Ladder index of this partition
+    uint64_t m_n_updates;                    //!< Number of calls to update()
+
+    std::vector<unsigned int> m_n_attempted; //!< Attempted exchanges of each neighboring pair
+    std::vector<unsigned int> m_n_accepted;  //!< Accepted exchanges of each neighboring pair
+
+#ifdef ENABLE_MPI
+    MPI_Comm m_roots_comm; //!< Communicator of the partition roots
+#endif
+
+    //! Scale the velocities and angular momenta
+    void scaleMomenta(Scalar factor);
+    };
+
+namespace detail
+    {
+//! Export the UpdaterReplicaExchange to python
+void export_UpdaterReplicaExchange(pybind11::module& m);
+
+    } // end namespace detail
+    } // end namespace md
+    } // end namespace hoomd
+
+#endif
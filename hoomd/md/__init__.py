@@ -7,10 +7,12 @@
 Perform Molecular Dynamics simulations with HOOMD-blue.
 """
 
+from hoomd.md import analyze
 from hoomd.md import angle
 from hoomd.md import bond
 from hoomd.md import compute
 from hoomd.md import constrain
+from hoomd.md import data
 from hoomd.md import dihedral
 from hoomd.md import external
 from hoomd.md import force
@@ -19,8 +21,10 @@ from hoomd.md.integrate import Integrator
 from hoomd.md import long_range
 from hoomd.md import manifold
 from hoomd.md import minimize
+from hoomd.md import ml
 from hoomd.md import nlist
 from hoomd.md import pair
+from hoomd.md import tune
 from hoomd.md import update
 from hoomd.md import wall
 from hoomd.md import special_pair
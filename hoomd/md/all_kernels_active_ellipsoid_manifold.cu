@@ -10,14 +10,23 @@ namespace md
     {
 namespace kernel
     {
-template hipError_t
-gpu_compute_active_force_set_constraints<ManifoldEllipsoid>(const unsigned int group_size,
-                                                            unsigned int* d_index_array,
-                                                            const Scalar4* d_pos,
-                                                            Scalar4* d_orientation,
-                                                            const Scalar4* d_f_act,
-                                                            ManifoldEllipsoid manifold,
-                                                            unsigned int block_size);
+template hipError_t gpu_compute_active_force_constraint_set_forces<ManifoldEllipsoid>(
+    const unsigned int group_size,
+    unsigned int* d_index_array,
+    Scalar4* d_force,
+    Scalar4* d_torque,
+    const Scalar4* d_pos,
+    Scalar4* d_orientation,
+    const Scalar4* d_f_act,
+    const Scalar4* d_t_act,
+    const unsigned int* d_tag,
+    ManifoldEllipsoid manifold,
+    const bool diffuse,
+    const Scalar rotationConst,
+    const uint64_t timestep,
+    const uint16_t seed,
+    const unsigned int N,
+    unsigned int block_size);
 
 template hipError_t gpu_compute_active_force_constraint_rotational_diffusion<ManifoldEllipsoid>(
     const unsigned int group_size,
@@ -0,0 +1,473 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""In-situ analysis.
+
+The analyzers in `hoomd.md.analyze` accumulate structural and dynamical
+quantities while the simulation runs. They operate on the particle data where it
+resides (on the GPU when the simulation runs on a GPU) and copy only the reduced
+results to Python when a property is accessed. Add them to
+`hoomd.Operations.writers` to set the timesteps they sample with their trigger.
+"""
+
+import numpy as np
+
+import hoomd
+from hoomd.md import _md
+from hoomd.md.nlist import NList
+from hoomd.md.compute import ThermodynamicQuantities
+from hoomd.operation import Writer
+from hoomd.custom.custom_action import Action, _InternalAction
+from hoomd.write.custom_writer import _InternalCustomWriter
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import (OnlyTypes, positive_real,
+                                      nonnegative_real)
+from hoomd.filter import ParticleFilter
+from hoomd.logging import log
+
+validate_nlist = OnlyTypes(NList)
+
+
+class RDF(Writer):
+    r"""Radial distribution function.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        nlist (`hoomd.md.nlist.NList`): Neighbor list to find the pairs with.
+        r_max (float): Maximum pair distance :math:`[\mathrm{length}]`.
+        bins (int): Number of bins between 0 and *r_max*.
+
+    `RDF` histograms the distances of all particle pairs closer than *r_max*
+    on the timesteps selected by *trigger* and averages :math:`g(r)` over the
+    sampled frames. `RDF` reads the pairs from *nlist*, so it costs little more
+    than a pair force when it shares the neighbor list with one. *nlist* builds
+    its list with a cutoff of at least *r_max*.
+
+    Example::
+
+        cell = hoomd.md.nlist.Cell(buffer=0.4)
+        rdf = hoomd.md.analyze.RDF(trigger=hoomd.trigger.Periodic(100),
+                                   nlist=cell,
+                                   r_max=3.0,
+                                   bins=100)
+        sim.operations.writers.append(rdf)
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        r_max (float): Maximum pair distance :math:`[\mathrm{length}]`.
+        bins (int): Number of bins between 0 and *r_max*.
+    """
+
+    def __init__(self, trigger, nlist, r_max, bins=100):
+        super().__init__(trigger)
+        self._nlist = validate_nlist(nlist)
+        self._param_dict.update(
+            ParameterDict(r_max=positive_real, bins=int))
+        self.r_max = r_max
+        self.bins = bins
+
+    def _add(self, simulation):
+        if (not self._added and self._nlist._added
+                and self._nlist._simulation != simulation):
+            raise RuntimeError(
+                f"NeighborList associated with {self} is associated with "
+                f"another simulation.")
+        super()._add(simulation)
+        self._nlist._add(simulation)
+        self._add_dependency(self._nlist)
+
+    def _attach(self):
+        if not self._nlist._added:
+            self._nlist._add(self._simulation)
+        elif self._simulation != self._nlist._simulation:
+            raise RuntimeError("{} object's neighbor list is used in a "
+                               "different simulation.".format(type(self)))
+        if not self._nlist._attached:
+            self._nlist._attach()
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            cls = _md.RadialDistributionFunction
+            self._nlist._cpp_obj.setStorageMode(
+                _md.NeighborList.storageMode.half)
+        else:
+            cls = _md.RadialDistributionFunctionGPU
+            self._nlist._cpp_obj.setStorageMode(
+                _md.NeighborList.storageMode.full)
+        self._cpp_obj = cls(self._simulation.state._cpp_sys_def,
+                            self._nlist._cpp_obj, self.r_max, self.bins)
+        super()._attach()
+
+    @property
+    def nlist(self):
+        """hoomd.md.nlist.NList: Neighbor list to find the pairs with."""
+        return self._nlist
+
+    @nlist.setter
+    def nlist(self, value):
+        if self._attached:
+            raise RuntimeError("nlist cannot be set after scheduling.")
+        self._nlist = validate_nlist(value)
+
+    @property
+    def _children(self):
+        return [self._nlist]
+
+    @log(category='sequence', requires_run=True)
+    def bin_centers(self):
+        """(*bins*, ) `numpy.ndarray` of ``float``: Centers of the bins \
+        :math:`[\\mathrm{length}]`."""
+        return np.array(self._cpp_obj.getBinCenters())
+
+    @log(category='sequence', requires_run=True)
+    def rdf(self):
+        """(*bins*, ) `numpy.ndarray` of ``float``: :math:`g(r)` averaged over \
+        the sampled frames."""
+        return np.array(self._cpp_obj.getRDF())
+
+    @log(requires_run=True)
+    def num_frames(self):
+        """int: Number of sampled frames."""
+        return self._cpp_obj.num_frames
+
+    def reset(self):
+        """Discard the sampled frames."""
+        if self._attached:
+            self._cpp_obj.reset()
+
+
+class MSD(Writer):
+    r"""Mean squared displacement.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        filter (hoomd.filter.ParticleFilter): Particles to compute the mean
+            squared displacement of.
+
+    On the first timestep selected by *trigger*, `MSD` stores the unwrapped
+    positions of the particles selected by *filter* as the reference. On every
+    selected timestep it records
+
+    .. math::
+
+        \mathrm{MSD}(t) = \frac{1}{N} \sum_{i=1}^{N}
+        \left| \vec{r}_i(t) - \vec{r}_i(t_0) \right|^2
+
+    where :math:`\vec{r}_i` are positions unwrapped with the particle images.
+
+    Example::
+
+        msd = hoomd.md.analyze.MSD(trigger=hoomd.trigger.Periodic(1000),
+                                   filter=hoomd.filter.All())
+        sim.operations.writers.append(msd)
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        filter (hoomd.filter.ParticleFilter): Particles to compute the mean
+            squared displacement of.
+    """
+
+    def __init__(self, trigger, filter):
+        super().__init__(trigger)
+        self._param_dict.update(ParameterDict(filter=ParticleFilter))
+        self.filter = filter
+
+    def _attach(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            cls = _md.MeanSquaredDisplacement
+        else:
+            cls = _md.MeanSquaredDisplacementGPU
+        group = self._simulation.state._get_group(self.filter)
+        self._cpp_obj = cls(self._simulation.state._cpp_sys_def, group)
+        super()._attach()
+
+    @log(category='sequence', requires_run=True)
+    def timesteps(self):
+        """(*N_frames*, ) `numpy.ndarray` of ``int``: Timesteps of the \
+        recorded frames."""
+        return np.array(self._cpp_obj.getTimesteps(), dtype=np.uint64)
+
+    @log(category='sequence', requires_run=True)
+    def msd(self):
+        """(*N_frames*, ) `numpy.ndarray` of ``float``: Mean squared \
+        displacement of the recorded frames :math:`[\\mathrm{length}^2]`."""
+        return np.array(self._cpp_obj.getMSD())
+
+    def reset(self):
+        """Discard the recorded frames and take a new reference."""
+        if self._attached:
+            self._cpp_obj.reset()
+
+
+class StructureFactor(Writer):
+    r"""Static structure factor.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        filter (hoomd.filter.ParticleFilter): Particles to compute the
+            structure factor of.
+        num_cells (tuple[int, int, int]): Number of mesh cells along each box
+            vector.
+        k_max (float): Maximum wave vector magnitude
+            :math:`[\mathrm{length}^{-1}]`.
+        bins (int): Number of bins between 0 and *k_max*.
+
+    `StructureFactor` assigns the particles selected by *filter* to a mesh with
+    cloud-in-cell weights, computes the Fourier transform of the density
+    :math:`\rho(\vec{k})` with a FFT, and averages
+
+    .. math::
+
+        S(\vec{k}) = \frac{1}{N} \left| \rho(\vec{k}) \right|^2
+
+    over the wave vectors of the mesh in each bin of :math:`|\vec{k}|` and over
+    the sampled frames. The transform is deconvolved by the assignment function.
+    Choose *num_cells* so that the mesh spacing is small compared to
+    :math:`2 \pi / k_\mathrm{max}`. In 2D simulations, the third element of
+    *num_cells* must be 1.
+
+    Example::
+
+        sq = hoomd.md.analyze.StructureFactor(
+            trigger=hoomd.trigger.Periodic(1000),
+            filter=hoomd.filter.All(),
+            num_cells=(64, 64, 64),
+            k_max=10.0,
+            bins=100)
+        sim.operations.writers.append(sq)
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        filter (hoomd.filter.ParticleFilter): Particles to compute the
+            structure factor of.
+        num_cells (tuple[int, int, int]): Number of mesh cells along each box
+            vector.
+        k_max (float): Maximum wave vector magnitude
+            :math:`[\mathrm{length}^{-1}]`.
+        bins (int): Number of bins between 0 and *k_max*.
+    """
+
+    def __init__(self, trigger, filter, num_cells, k_max, bins=100):
+        super().__init__(trigger)
+        self._param_dict.update(
+            ParameterDict(filter=ParticleFilter,
+                          num_cells=(int, int, int),
+                          k_max=positive_real,
+                          bins=int))
+        self.filter = filter
+        self.num_cells = num_cells
+        self.k_max = k_max
+        self.bins = bins
+
+    def _attach(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            cls = _md.StructureFactor
+        else:
+            cls = _md.StructureFactorGPU
+        group = self._simulation.state._get_group(self.filter)
+        nx, ny, nz = self.num_cells
+        self._cpp_obj = cls(self._simulation.state._cpp_sys_def, group, nx, ny,
+                            nz, self.k_max, self.bins)
+        super()._attach()
+
+    @log(category='sequence', requires_run=True)
+    def bin_centers(self):
+        """(*bins*, ) `numpy.ndarray` of ``float``: Centers of the bins \
+        :math:`[\\mathrm{length}^{-1}]`."""
+        return np.array(self._cpp_obj.getBinCenters())
+
+    @log(category='sequence', requires_run=True)
+    def S(self):
+        """(*bins*, ) `numpy.ndarray` of ``float``: :math:`S(k)` averaged \
+        over the wave vectors in each bin and the sampled frames.
+
+        Bins that contain no wave vector of the mesh are 0.
+        """
+        return np.array(self._cpp_obj.getStructureFactor())
+
+    @log(requires_run=True)
+    def num_frames(self):
+        """int: Number of sampled frames."""
+        return self._cpp_obj.num_frames
+
+    def reset(self):
+        """Discard the sampled frames."""
+        if self._attached:
+            self._cpp_obj.reset()
+
+
+class _HealthMonitorInternal(_InternalAction):
+    """Implements the sampling and reactions of `HealthMonitor`."""
+
+    def __init__(self, nlist=None, thermo=None, buffer_increase=0.0):
+        param_dict = ParameterDict(
+            nlist=OnlyTypes(NList, allow_none=True),
+            thermo=OnlyTypes(ThermodynamicQuantities, allow_none=True),
+            buffer_increase=nonnegative_real)
+        param_dict.update(
+            dict(nlist=nlist, thermo=thermo, buffer_increase=buffer_increase))
+        self._param_dict = param_dict
+        self._reset_samples()
+
+    def _reset_samples(self):
+        self._tps = 0.0
+        self._dangerous_builds = 0
+        self._last_dangerous_count = 0
+        self._memory_usage = 0
+        self._initial_memory_usage = None
+        self._energy_drift = 0.0
+        self._initial_energy = None
+
+    @property
+    def flags(self):
+        # the energy drift needs the current potential energy on the sampled
+        # steps, also when Simulation.always_compute_energy is False
+        if self.thermo is None:
+            return []
+        return [Action.Flags.POTENTIAL_ENERGY]
+
+    def attach(self, simulation):
+        super().attach(simulation)
+        self._simulation = simulation
+        self._reset_samples()
+
+    def detach(self):
+        self._simulation = None
+        super().detach()
+
+    def act(self, timestep):
+        """Sample the health of the simulation.
+
+        Args:
+            timestep (int): Current simulation timestep.
+        """
+        sim = self._simulation
+        self._tps = sim.tps
+
+        memory_usage = sum(sim.memory_usage.values())
+        if self._initial_memory_usage is None:
+            self._initial_memory_usage = memory_usage
+        self._memory_usage = memory_usage
+
+        if self.nlist is not None and self.nlist._attached:
+            # the count restarts at the beginning of every run
+            count = self.nlist._cpp_obj.getNumDangerousUpdates()
+            if count < self._last_dangerous_count:
+                self._last_dangerous_count = 0
+            new_builds = count - self._last_dangerous_count
+            self._last_dangerous_count = count
+            self._dangerous_builds += new_builds
+
+            if new_builds > 0 and self.buffer_increase > 0:
+                self.nlist.buffer = self.nlist.buffer + self.buffer_increase
+                sim.device._cpp_msg.notice(
+                    2, f"HealthMonitor: increased the neighbor list buffer to "
+                    f"{self.nlist.buffer} after {new_builds} dangerous "
+                    f"builds.\n")
+
+        if self.thermo is not None and self.thermo._attached:
+            energy = self.thermo.kinetic_energy + self.thermo.potential_energy
+            if self._initial_energy is None:
+                self._initial_energy = energy
+            self._energy_drift = ((energy - self._initial_energy)
+                                  / self.thermo.num_particles)
+
+    @log(requires_run=True)
+    def tps(self):
+        """float: `hoomd.Simulation.tps` at the last sample."""
+        return self._tps
+
+    @log(requires_run=True)
+    def dangerous_builds(self):
+        """int: Number of dangerous neighbor list builds counted by the \
+        samples."""
+        return self._dangerous_builds
+
+    @log(requires_run=True)
+    def memory_usage(self):
+        """int: Bytes allocated on the local rank at the last sample."""
+        return self._memory_usage
+
+    @log(requires_run=True)
+    def memory_growth(self):
+        """int: Bytes allocated on the local rank since the first sample."""
+        if self._initial_memory_usage is None:
+            return 0
+        return self._memory_usage - self._initial_memory_usage
+
+    @log(requires_run=True)
+    def energy_drift(self):
+        """float: Change of the total energy per particle since the first \
+        sample :math:`[\\mathrm{energy}]`."""
+        return self._energy_drift
+
+    def reset(self):
+        """Discard the samples and start again at the next sample."""
+        self._reset_samples()
+
+
+class HealthMonitor(_InternalCustomWriter):
+    r"""Monitor the performance and energy conservation of a simulation.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps at which to
+            sample.
+        nlist (hoomd.md.nlist.NList): Neighbor list to check for dangerous
+            builds (defaults to ``None``).
+        thermo (hoomd.md.compute.ThermodynamicQuantities): Compute the total
+            energy for the energy drift (defaults to ``None``).
+        buffer_increase (float): Amount to add to the neighbor list buffer
+            after a sample that counted dangerous builds
+            :math:`[\mathrm{length}]` (defaults to 0).
+
+    `HealthMonitor` samples the health of unattended production runs: the
+    steps per second, the number of dangerous neighbor list builds, the memory
+    allocated on the local rank and its growth, and the drift of the total
+    energy per particle, which should stay close to 0 in NVE simulations.
+    Each sample reads values that the simulation already keeps, so
+    `HealthMonitor` costs nothing on the timesteps where *trigger* does not
+    select it. Use a low sampling frequency and log the properties with a
+    `hoomd.logging.Logger` to record them.
+
+    Set *buffer_increase* to react to dangerous builds by increasing
+    `hoomd.md.nlist.NList.buffer`.
+
+    Writers run in the order of `hoomd.Operations.writers`. Add
+    `HealthMonitor` before the writers that log it, with the same trigger, so
+    that they record the current sample.
+
+    Note:
+        Add *thermo* to `hoomd.Operations.computes`. `HealthMonitor` does not
+        check the energy drift of an unattached *thermo*, nor the builds of a
+        neighbor list that the simulation does not use. With *thermo*,
+        `HealthMonitor` requests the potential energy on the sampled steps
+        when `hoomd.Simulation.always_compute_energy` is `False`. Set *thermo*
+        before the first run, the request is made when `HealthMonitor`
+        attaches.
+
+    Example::
+
+        thermo = hoomd.md.compute.ThermodynamicQuantities(
+            filter=hoomd.filter.All())
+        sim.operations.computes.append(thermo)
+        monitor = hoomd.md.analyze.HealthMonitor(
+            trigger=hoomd.trigger.Periodic(10000),
+            nlist=nlist,
+            thermo=thermo)
+        logger = hoomd.logging.Logger(categories=['scalar'])
+        logger.add(monitor)
+        table = hoomd.write.Table(trigger=hoomd.trigger.Periodic(10000),
+                                  logger=logger)
+        sim.operations.writers.extend([monitor, table])
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps at which to
+            sample.
+        nlist (hoomd.md.nlist.NList): Neighbor list to check for dangerous
+            builds.
+        thermo (hoomd.md.compute.ThermodynamicQuantities): Compute the total
+            energy for the energy drift.
+        buffer_increase (float): Amount to add to the neighbor list buffer
+            after a sample that counted dangerous builds
+            :math:`[\mathrm{length}]`.
+    """
+    _internal_class = _HealthMonitorInternal
@@ -276,6 +276,151 @@ class ThermodynamicQuantities(_Thermo):
         return self._cpp_obj.volume
 
 
+class MultiGroupThermodynamicQuantities(Compute):
+    """Compute thermodynamic properties of several groups of particles.
+
+    Args:
+        filters (list[``hoomd.filter``]): Particle filters to compute
+            thermodynamic properties for (at most 32).
+
+    :py:class:`MultiGroupThermodynamicQuantities` computes the same quantities
+    as one `ThermodynamicQuantities` per filter. Each quantity is a list with
+    one entry per filter, in the order of *filters*. Use it to log many groups
+    (e.g. species or regions): it reads the particle data once for all groups
+    and, in MPI simulations, reduces the quantities of all groups in a single
+    collective, where separate `ThermodynamicQuantities` compute and reduce
+    each group on its own.
+
+    Examples::
+
+        thermo = compute.MultiGroupThermodynamicQuantities(
+            filters=[hoomd.filter.Type(['A']), hoomd.filter.Type(['B'])])
+        logger.add(thermo, quantities=['kinetic_temperature'])
+
+    Attributes:
+        filters (list[hoomd.filter.ParticleFilter]): Subsets of particles to
+            compute thermodynamic properties for.
+    """
+
+    def __init__(self, filters):
+        self._filters = list(filters)
+
+    @property
+    def filters(self):  # noqa: D102 - documented in Attributes above
+        return self._filters
+
+    def _attach(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            thermo_cls = _md.ComputeThermoMultiGroup
+        else:
+            thermo_cls = _md.ComputeThermoMultiGroupGPU
+        groups = [
+            self._simulation.state._get_group(filter_)
+            for filter_ in self._filters
+        ]
+        self._cpp_obj = thermo_cls(self._simulation.state._cpp_sys_def, groups)
+        super()._attach()
+
+    def _get_quantity(self, getter, compute=True):
+        if compute:
+            self._cpp_obj.compute(self._simulation.timestep)
+        getter = getattr(self._cpp_obj, getter)
+        return [getter(i) for i in range(self._cpp_obj.num_groups)]
+
+    @log(category='sequence', requires_run=True)
+    def kinetic_temperature(self):
+        """list[float]: :math:`kT_k` of each group \
+        :math:`[\\mathrm{energy}]`.
+
+        See `ThermodynamicQuantities.kinetic_temperature`.
+        """
+        return self._get_quantity('getKineticTemperature')
+
+    @log(category='sequence', requires_run=True)
+    def pressure(self):
+        """list[float]: :math:`P` of each group :math:`[\\mathrm{pressure}]`.
+
+        See `ThermodynamicQuantities.pressure`.
+        """
+        return self._get_quantity('getPressure')
+
+    @log(category='sequence', requires_run=True)
+    def pressure_tensor(self):
+        """list[list[float]]: Pressure tensor of each group \
+        :math:`[\\mathrm{pressure}]`.
+
+        See `ThermodynamicQuantities.pressure_tensor`.
+        """
+        return self._get_quantity('getPressureTensor')
+
+    @log(category='sequence', requires_run=True)
+    def kinetic_energy(self):
+        """list[float]: :math:`K` of each group :math:`[\\mathrm{energy}]`.
+
+        See `ThermodynamicQuantities.kinetic_energy`.
+        """
+        return self._get_quantity('getKineticEnergy')
+
+    @log(category='sequence', requires_run=True)
+    def translational_kinetic_energy(self):
+        r"""list[float]: :math:`K_{\mathrm{trans}}` of each group.
+
+        :math:`[\mathrm{energy}]`
+
+        See `ThermodynamicQuantities.translational_kinetic_energy`.
+        """
+        return self._get_quantity('getTranslationalKineticEnergy')
+
+    @log(category='sequence', requires_run=True)
+    def rotational_kinetic_energy(self):
+        r"""list[float]: :math:`K_{\mathrm{rot}}` of each group.
+
+        :math:`[\mathrm{energy}]`
+
+        See `ThermodynamicQuantities.rotational_kinetic_energy`.
+        """
+        return self._get_quantity('getRotationalKineticEnergy')
+
+    @log(category='sequence', requires_run=True)
+    def potential_energy(self):
+        """list[float]: :math:`U` of each group :math:`[\\mathrm{energy}]`.
+
+        See `ThermodynamicQuantities.potential_energy`.
+        """
+        return self._get_quantity('getPotentialEnergy')
+
+    @log(category='sequence', requires_run=True)
+    def degrees_of_freedom(self):
+        r"""list[float]: :math:`N_{\mathrm{dof}}` of each group.
+
+        See `ThermodynamicQuantities.degrees_of_freedom`.
+        """
+        return self._get_quantity('getDegreesOfFreedom', compute=False)
+
+    @log(category='sequence', requires_run=True)
+    def translational_degrees_of_freedom(self):
+        r"""list[float]: :math:`N_{\mathrm{dof, trans}}` of each group.
+
+        See `ThermodynamicQuantities.translational_degrees_of_freedom`.
+        """
+        return self._get_quantity('getTranslationalDegreesOfFreedom',
+                                  compute=False)
+
+    @log(category='sequence', requires_run=True)
+    def rotational_degrees_of_freedom(self):
+        r"""list[float]: :math:`N_{\mathrm{dof, rot}}` of each group.
+
+        See `ThermodynamicQuantities.rotational_degrees_of_freedom`.
+        """
+        return self._get_quantity('getRotationalDegreesOfFreedom',
+                                  compute=False)
+
+    @log(category='sequence', requires_run=True)
+    def num_particles(self):
+        """list[int]: :math:`N`, number of particles in each group."""
+        return self._get_quantity('getNumParticles', compute=False)
+
+
 class HarmonicAveragedThermodynamicQuantities(Compute):
     """Compute harmonic averaged thermodynamic properties of particles.
 
@@ -24,12 +24,12 @@ accounted for in `hoomd.md.compute.ThermodynamicQuantities`.
 from hoomd.md import _md
 from hoomd.data.parameterdicts import ParameterDict, TypeParameterDict
 from hoomd.data.typeparam import TypeParameter
-from hoomd.data.typeconverter import OnlyIf, to_type_converter
+from hoomd.data.typeconverter import OnlyFrom, OnlyIf, to_type_converter
 import hoomd
-from hoomd.operation import _HOOMDBaseObject
+from hoomd.operation import _TimedObject
 
 
-class Constraint(_HOOMDBaseObject):
+class Constraint(_TimedObject):
     """A constraint force that acts on the system."""
 
     def _attach(self):
@@ -49,6 +49,10 @@ class Distance(Constraint):
 
     Args:
         tolerance (float): Relative tolerance for constraint violation warnings.
+        solver (str): Linear solver for the constraint equations, ``'direct'``
+            or ``'iterative'``.
+        solver_tolerance (float): Relative residual at which the iterative
+            solver stops.
 
     `Distance` applies forces between particles to constrain the distances
     between particles to specific values. The algorithm implemented is described
@@ -94,14 +98,32 @@ class Distance(Constraint):
         issue a warning message. It does not influence the computation of the
         constraint force.
 
+    The ``'direct'`` solver factorizes the sparse constraint matrix with an LU
+    decomposition every step. The ``'iterative'`` solver uses a preconditioned
+    BiCGSTAB method started from the Lagrange multipliers of the previous step,
+    which converges in a few iterations when the constraints change slowly. It
+    falls back to the direct solver when it does not converge. On the GPU, the
+    iterative solver runs on the CPU.
+
     Attributes:
         tolerance (float): Relative tolerance for constraint violation warnings.
+        solver (str): Linear solver for the constraint equations, ``'direct'``
+            or ``'iterative'``.
+        solver_tolerance (float): Relative residual at which the iterative
+            solver stops.
     """
 
     _cpp_class_name = "ForceDistanceConstraint"
 
-    def __init__(self, tolerance=1e-3):
-        self._param_dict.update(ParameterDict(tolerance=float(tolerance)))
+    def __init__(self,
+                 tolerance=1e-3,
+                 solver='direct',
+                 solver_tolerance=1e-8):
+        self._param_dict.update(
+            ParameterDict(tolerance=float(tolerance),
+                          solver=OnlyFrom(['direct', 'iterative']),
+                          solver_tolerance=float(solver_tolerance)))
+        self.solver = solver
 
 
 class Rigid(Constraint):
@@ -0,0 +1,12 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Access MD force, neighbor list, and cell list data."""
+
+from .local_access import (ForceLocalAccessBase, NeighborListLocalAccessBase,
+                           CellListLocalAccessBase)
+from .local_access_cpu import (ForceLocalAccess, NeighborListLocalAccess,
+                               CellListLocalAccess)
+from .local_access_gpu import (ForceLocalAccessGPU, NeighborListLocalAccessGPU,
+                               CellListLocalAccessGPU)
@@ -0,0 +1,152 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Access force, neighbor list, and cell list data directly."""
+
+from abc import abstractmethod
+from hoomd.data.local_access import _LocalAccess
+
+
+class _ArrayLocalAccess(_LocalAccess):
+    """Context manager access to arrays that have no ghost variants."""
+
+    _global_fields = {}
+
+    @property
+    @abstractmethod
+    def _cpp_cls(self):
+        pass
+
+    def __init__(self, state):
+        super().__init__()
+        self._state = state
+
+    def __getattr__(self, attr):
+        if attr in self._accessed_fields:
+            return self._accessed_fields[attr]
+        elif attr in self._fields:
+            buff = getattr(self._cpp_obj, self._fields[attr])()
+        else:
+            raise AttributeError("{} object has no attribute {}".format(
+                type(self), attr))
+
+        self._accessed_fields[attr] = arr = self._array_cls(
+            buff, lambda: self._entered)
+        return arr
+
+    def __enter__(self):
+        if self._state._in_context_manager:
+            raise RuntimeError(
+                "Cannot enter a local access context manager inside another "
+                "local access context manager.")
+        self._state._in_context_manager = True
+        self._enter()
+        return self
+
+    def __exit__(self, type, value, traceback):
+        self._state._in_context_manager = False
+        self._exit()
+
+
+class ForceLocalAccessBase(_ArrayLocalAccess):
+    """Class for directly accessing the arrays of a HOOMD-blue force.
+
+    All arrays are read only and have one row for each local particle, in the
+    same order as the particle arrays of `hoomd.State.cpu_local_snapshot`.
+
+    Attributes:
+        force ((N_particles, 3) `hoomd.data.array` object of ``float``):
+            Force on each particle :math:`[\\mathrm{force}]`.
+        potential_energy ((N_particles,) `hoomd.data.array` object of \
+            ``float``):
+            Potential energy of each particle :math:`[\\mathrm{energy}]`.
+        torque ((N_particles, 3) `hoomd.data.array` object of ``float``):
+            Torque on each particle
+            :math:`[\\mathrm{force} \\cdot \\mathrm{length}]`.
+        virial ((N_particles, 6) `hoomd.data.array` object of ``float``):
+            Virial of each particle in the order xx, xy, xz, yy, yz, zz
+            :math:`[\\mathrm{energy}]`. Only valid on steps where the force
+            computes virials (see `hoomd.md.force.Force.virials`).
+    """
+
+    _fields = {
+        'force': 'getForce',
+        'potential_energy': 'getPotentialEnergy',
+        'torque': 'getTorque',
+        'virial': 'getVirial'
+    }
+
+    def __init__(self, force, state):
+        super().__init__(state)
+        self._cpp_obj = self._cpp_cls(force._cpp_obj,
+                                      state._cpp_sys_def.getParticleData())
+
+
+class NeighborListLocalAccessBase(_ArrayLocalAccess):
+    """Class for directly accessing a HOOMD-blue neighbor list.
+
+    The neighbors of local particle ``i`` are
+    ``nlist[head_list[i]:head_list[i] + n_neigh[i]]``. Neighbors are given by
+    their local particle index, which may refer to a ghost particle. When
+    `half_nlist` is `True`, each pair of particles is listed only once. All
+    arrays are read only and reflect the most recent neighbor list build.
+
+    Attributes:
+        head_list ((N_particles,) `hoomd.data.array` object of ``int``):
+            Index in `nlist` of the first neighbor of each particle.
+        n_neigh ((N_particles,) `hoomd.data.array` object of ``int``):
+            Number of neighbors of each particle.
+        nlist ((N_nlist,) `hoomd.data.array` object of ``int``):
+            The neighbor list storage. Entries that are not in the range of any
+            particle are unused.
+    """
+
+    _fields = {
+        'head_list': 'getHeadList',
+        'n_neigh': 'getNNeigh',
+        'nlist': 'getNList'
+    }
+
+    def __init__(self, nlist, state):
+        super().__init__(state)
+        self._half_nlist = (nlist._cpp_obj.getStorageMode() ==
+                            nlist._cpp_obj.storageMode.half)
+        self._cpp_obj = self._cpp_cls(nlist._cpp_obj,
+                                      state._cpp_sys_def.getParticleData())
+
+    @property
+    def half_nlist(self):
+        """bool: `True` when each pair of particles is listed only once."""
+        return self._half_nlist
+
+
+class CellListLocalAccessBase(_ArrayLocalAccess):
+    """Class for directly accessing the cell list of a HOOMD-blue neighbor list.
+
+    Cells are indexed as ``[k, j, i]`` over the cell list dimensions in the
+    z, y, and x directions of the local box, including the ghost layer. Each
+    cell has ``N_max`` slots, of which the first ``cell_size[k, j, i]`` are
+    filled. All arrays are read only and reflect the most recent cell list
+    build.
+
+    Attributes:
+        cell_size ((N_z, N_y, N_x) `hoomd.data.array` object of ``int``):
+            Number of particles in each cell.
+        position ((N_z, N_y, N_x, N_max, 3) `hoomd.data.array` object of \
+            ``float``):
+            Positions of the particles in each cell
+            :math:`[\\mathrm{length}]`.
+        index ((N_z, N_y, N_x, N_max) `hoomd.data.array` object of ``int``):
+            Local particle index of the particles in each cell.
+    """
+
+    _fields = {
+        'cell_size': 'getCellSize',
+        'position': 'getPosition',
+        'index': 'getFlag'
+    }
+
+    def __init__(self, nlist, state):
+        super().__init__(state)
+        self._cpp_obj = self._cpp_cls(nlist._cpp_obj.getCellList())
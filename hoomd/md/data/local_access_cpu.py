@@ -0,0 +1,30 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Implement MD local access classes for the CPU."""
+
+from hoomd.md.data.local_access import (ForceLocalAccessBase,
+                                        NeighborListLocalAccessBase,
+                                        CellListLocalAccessBase)
+from hoomd.data.array import HOOMDArray
+from hoomd import _hoomd
+from hoomd.md import _md
+
+
+class ForceLocalAccess(ForceLocalAccessBase):
+    """Access force arrays on the CPU."""
+    _cpp_cls = _hoomd.LocalForceComputeDataHost
+    _array_cls = HOOMDArray
+
+
+class NeighborListLocalAccess(NeighborListLocalAccessBase):
+    """Access neighbor list arrays on the CPU."""
+    _cpp_cls = _md.LocalNeighborListDataHost
+    _array_cls = HOOMDArray
+
+
+class CellListLocalAccess(CellListLocalAccessBase):
+    """Access cell list arrays on the CPU."""
+    _cpp_cls = _hoomd.LocalCellListDataHost
+    _array_cls = HOOMDArray
@@ -0,0 +1,45 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Implement MD local access classes for the GPU."""
+
+from hoomd import _hoomd
+from hoomd.md import _md
+from hoomd.md.data.local_access import (ForceLocalAccessBase,
+                                        NeighborListLocalAccessBase,
+                                        CellListLocalAccessBase)
+from hoomd.data.array import HOOMDGPUArray
+import hoomd
+
+if hoomd.version.gpu_enabled:
+
+    class ForceLocalAccessGPU(ForceLocalAccessBase):
+        """Access force arrays on the GPU."""
+        _cpp_cls = _hoomd.LocalForceComputeDataDevice
+        _array_cls = HOOMDGPUArray
+
+    class NeighborListLocalAccessGPU(NeighborListLocalAccessBase):
+        """Access neighbor list arrays on the GPU."""
+        _cpp_cls = _md.LocalNeighborListDataDevice
+        _array_cls = HOOMDGPUArray
+
+    class CellListLocalAccessGPU(CellListLocalAccessBase):
+        """Access cell list arrays on the GPU."""
+        _cpp_cls = _hoomd.LocalCellListDataDevice
+        _array_cls = HOOMDGPUArray
+
+else:
+    from hoomd.util import _NoGPU
+
+    class ForceLocalAccessGPU(_NoGPU):
+        """GPU data access is not available in CPU builds."""
+        pass
+
+    class NeighborListLocalAccessGPU(_NoGPU):
+        """GPU data access is not available in CPU builds."""
+        pass
+
+    class CellListLocalAccessGPU(_NoGPU):
+        """GPU data access is not available in CPU builds."""
+        pass
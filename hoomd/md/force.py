@@ -7,7 +7,7 @@
 import hoomd
 from hoomd import _hoomd
 from hoomd.md import _md
-from hoomd.operation import _HOOMDBaseObject
+from hoomd.operation import _TimedObject
 from hoomd.logging import log
 from hoomd.data.typeparam import TypeParameter
 from hoomd.data.typeconverter import OnlyTypes
@@ -21,7 +21,7 @@ class _force:  # noqa - This will be removed eventually. Needed to build docs.
     pass
 
 
-class Force(_HOOMDBaseObject):
+class Force(_TimedObject):
     """Defines a force in HOOMD-blue.
 
     Pair, angle, bond, and other forces are subclasses of this class.
@@ -31,13 +31,43 @@ class Force(_HOOMDBaseObject):
         Users should not instantiate this class directly.
 
     Initializes some loggable quantities.
+
+    .. rubric:: Multiple timestep integration
+
+    Set `respa_interval` to :math:`k > 1` to evaluate a slowly varying force,
+    such as the reciprocal space part of `md.long_range.pppm.Coulomb`, only
+    every :math:`k` steps. The integrator applies the force as an impulse
+    (reversible RESPA): on timesteps that are multiples of :math:`k` the force
+    enters the net force multiplied by :math:`k` and on all other timesteps it
+    is not computed. Forces with the default interval of 1 are evaluated every
+    step as usual.
+
+    Note:
+        The energy and virial of a force with `respa_interval` :math:`k > 1`
+        contribute to thermodynamic quantities only on timesteps that are
+        multiples of :math:`k`. Log these quantities on such timesteps. Start
+        the simulation at a timestep that is a multiple of :math:`k` so that
+        the first impulse is symmetric.
+
+    Warning:
+        Large intervals excite resonances with the fast motions in the system.
+        Check energy conservation in NVE simulations before production runs.
+
+    Attributes:
+        respa_interval (int): Number of timesteps between evaluations of this
+            force in the net force (default: 1).
     """
 
+    _reserved_default_attrs = {
+        **_TimedObject._reserved_default_attrs,
+        '_param_dict': lambda: ParameterDict(respa_interval=int(1))
+    }
+
     @log(requires_run=True)
     def energy(self):
         """float: Total contribution to the potential energy of the system \
         :math:`[\\mathrm{energy}]`."""
-        self._cpp_obj.compute(self._simulation.timestep)
+        self._cpp_obj.computeEnergies(self._simulation.timestep)
         return self._cpp_obj.calcEnergySum()
 
     @log(category="particle", requires_run=True)
@@ -49,7 +79,7 @@ class Force(_HOOMDBaseObject):
             In MPI parallel execution, the array is available on rank 0 only.
             `energies` is `None` on ranks >= 1.
         """
-        self._cpp_obj.compute(self._simulation.timestep)
+        self._cpp_obj.computeEnergies(self._simulation.timestep)
         return self._cpp_obj.getEnergies()
 
     @log(requires_run=True)
@@ -116,6 +146,47 @@ class Force(_HOOMDBaseObject):
             virial.append(self._cpp_obj.getExternalVirial(i))
         return numpy.array(virial, dtype=numpy.float64)
 
+    @property
+    def cpu_local_force_arrays(self):
+        """hoomd.md.data.ForceLocalAccess: Expose force arrays on the CPU.
+
+        Provides zero-copy, read only access to the per-particle force,
+        potential energy, torque, and virial of this force through a context
+        manager. The arrays are MPI rank local and have one row for each local
+        particle, in the order of `hoomd.State.cpu_local_snapshot`.
+
+        .. code-block:: python
+
+            with lj.cpu_local_force_arrays as arrays:
+                total_energy = numpy.sum(arrays.potential_energy)
+
+        Note:
+            The state cannot change within the context manager.
+        """
+        if not self._attached:
+            raise hoomd.error.DataAccessError("cpu_local_force_arrays")
+        self._cpp_obj.computeEnergies(self._simulation.timestep)
+        return hoomd.md.data.ForceLocalAccess(self, self._simulation.state)
+
+    @property
+    def gpu_local_force_arrays(self):
+        """hoomd.md.data.ForceLocalAccessGPU: Expose force arrays on the GPU.
+
+        Provides the same arrays as `cpu_local_force_arrays` in device memory.
+        The arrays implement the ``__cuda_array_interface__`` and can be used
+        with CuPy or PyTorch without a copy.
+
+        Warning:
+            This property is only available when running on a GPU(s).
+        """
+        if not isinstance(self._simulation.device, hoomd.device.GPU):
+            raise RuntimeError(
+                "Cannot access gpu_local_force_arrays with a non GPU device.")
+        if not self._attached:
+            raise hoomd.error.DataAccessError("gpu_local_force_arrays")
+        self._cpp_obj.computeEnergies(self._simulation.timestep)
+        return hoomd.md.data.ForceLocalAccessGPU(self, self._simulation.state)
+
 
 class constant(Force):  # noqa - this will be renamed when it is ported to v3
     R"""Constant force.
@@ -543,3 +614,120 @@ class ActiveOnManifold(Active):
 
         # Attach param_dict and typeparam_dict
         super()._attach()
+
+
+class FusedBonded(Force):
+    r"""Bond, angle, and dihedral forces evaluated together.
+
+    Args:
+        bond (`hoomd.md.bond.Bond`): Bond potential (or `None`).
+        angle (`hoomd.md.angle.Angle`): Angle potential (or `None`).
+        dihedral (`hoomd.md.dihedral.Dihedral`): Dihedral potential (or
+            `None`).
+        per_group (bool): Evaluate each group once on the GPU.
+
+    `FusedBonded` applies the sum of the given bonded potentials as a single
+    force. On the GPU, one kernel walks the bonds, angles, and dihedrals of each
+    particle, reading its position once and writing its force once, instead of
+    one kernel per potential. This reduces the memory traffic of bonded forces
+    in systems such as polymer melts where most particles belong to several
+    bonded groups.
+
+    The component potentials hold the parameters: set ``params`` on them as
+    usual, before or after adding `FusedBonded` to the integrator. Do not also
+    add the components to the integrator's forces, which would apply them twice.
+
+    On the GPU, `FusedBonded` supports `hoomd.md.bond.Harmonic`,
+    `hoomd.md.angle.Harmonic`, and `hoomd.md.dihedral.Harmonic` or
+    `hoomd.md.dihedral.OPLS` and raises an error for other potentials. On the
+    CPU, it accepts any bond, angle, and dihedral potentials and sums their
+    forces.
+
+    With ``per_group=True``, the GPU kernel evaluates each bond, angle, and
+    dihedral once and adds the resulting forces to its members with atomic
+    operations, instead of evaluating each group once for every member. This
+    does a half to a quarter of the potential evaluations and can be faster for
+    expensive dihedrals, at the cost of contention on the atomic additions. The
+    order of the additions varies from run to run, so the forces are not
+    bitwise reproducible. ``per_group`` has no effect on the CPU.
+
+    Examples::
+
+        harmonic_bond = hoomd.md.bond.Harmonic()
+        harmonic_bond.params['backbone'] = dict(k=300.0, r0=1.0)
+        harmonic_angle = hoomd.md.angle.Harmonic()
+        harmonic_angle.params['backbone'] = dict(k=10.0, t0=2.0)
+        opls = hoomd.md.dihedral.OPLS()
+        opls.params['backbone'] = dict(k1=1.0, k2=0.5, k3=0.25, k4=0.0)
+        bonded = hoomd.md.force.FusedBonded(bond=harmonic_bond,
+                                            angle=harmonic_angle,
+                                            dihedral=opls)
+        integrator.forces.append(bonded)
+
+    Attributes:
+        per_group (bool): Evaluate each group once on the GPU.
+    """
+
+    def __init__(self, bond=None, angle=None, dihedral=None, per_group=False):
+        for name, value, cls in (('bond', bond, hoomd.md.bond.Bond),
+                                 ('angle', angle, hoomd.md.angle.Angle),
+                                 ('dihedral', dihedral,
+                                  hoomd.md.dihedral.Dihedral)):
+            if value is not None and not isinstance(value, cls):
+                raise TypeError(f"{name} must be a {cls.__name__} or None.")
+        self._bond = bond
+        self._angle = angle
+        self._dihedral = dihedral
+        self._param_dict.update(ParameterDict(per_group=bool(per_group)))
+
+    @property
+    def bond(self):
+        """`hoomd.md.bond.Bond`: Bond potential (or `None`)."""
+        return self._bond
+
+    @property
+    def angle(self):
+        """`hoomd.md.angle.Angle`: Angle potential (or `None`)."""
+        return self._angle
+
+    @property
+    def dihedral(self):
+        """`hoomd.md.dihedral.Dihedral`: Dihedral potential (or `None`)."""
+        return self._dihedral
+
+    def _add(self, simulation):
+        super()._add(simulation)
+        for child in self._children:
+            if not child._added:
+                child._add(simulation)
+            elif child._simulation != simulation:
+                raise RuntimeError(
+                    f"{child} is associated with another simulation.")
+
+    def _attach(self):
+        for child in self._children:
+            if not child._added:
+                child._add(self._simulation)
+            if not child._attached:
+                child._attach()
+
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            cpp_cls = _md.FusedBondedForceCompute
+        else:
+            cpp_cls = _md.FusedBondedForceComputeGPU
+
+        components = [
+            None if force is None else force._cpp_obj
+            for force in (self._bond, self._angle, self._dihedral)
+        ]
+        self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
+                                *components)
+
+        super()._attach()
+
+    @property
+    def _children(self):
+        return [
+            force for force in (self._bond, self._angle, self._dihedral)
+            if force is not None
+        ]
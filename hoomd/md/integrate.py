@@ -177,6 +177,51 @@ class Integrator(_DynamicIntegrator):
         rigid (hoomd.md.constrain.Rigid): A rigid bodies object defining the
             rigid bodies in the simulation.
 
+        overlap_ghost_update (bool): When True, compute pair forces on
+            particles with no ghost neighbors while the ghost position update
+            is in flight, then the remaining particles after it completes. Has
+            an effect only with domain decomposition on the GPU.
+
+        concurrent_forces (bool): When True, forces that do not depend on each
+            other's results launch their GPU kernels on separate streams, so
+            that they execute concurrently. The net force summation waits for
+            all of them. Pair and bond potentials execute concurrently, the
+            other forces execute in order. Has no effect on the CPU or with
+            multiple GPUs.
+
+        max_displacement (float): When set, adapt the time step after every
+            step so that no particle moves more than ``max_displacement`` in
+            the next step :math:`[\\mathrm{length}]`. The default value of
+            ``None`` keeps `dt` fixed.
+
+        dt_min (float): Smallest adaptive time step
+            :math:`[\\mathrm{time}]`.
+
+        dt_max (float): Largest adaptive time step :math:`[\\mathrm{time}]`.
+            Defaults to ``dt``.
+
+        finc_dt (float): Largest factor by which the adaptive time step
+            increases in one step.
+
+    When `max_displacement` is set, `Integrator` sets `dt` before every step
+    to the largest value for which
+
+    .. math::
+
+        v_\\mathrm{max} \\Delta t + \\frac{1}{2} a_\\mathrm{max} \\Delta t^2
+        \\le \\mathrm{max\\_displacement}
+
+    where :math:`v_\\mathrm{max}` and :math:`a_\\mathrm{max}` are the largest
+    speed and acceleration of all particles. `dt` increases by at most a factor of `finc_dt` per step and
+    stays in the range [`dt_min`, `dt_max`]. The integration methods and
+    rigid bodies use the new time step, and their thermostat and barostat
+    variables remain consistent. Methods that do not use the particle
+    velocities, such as `hoomd.md.methods.Brownian`, are not limited by the
+    adaptive time step.
+
+    Note:
+        With an adaptive time step, the simulated time is not the number of
+        steps times `dt`.
 
     Classes of the following modules can be used as elements in `methods`:
 
@@ -230,6 +275,24 @@ class Integrator(_DynamicIntegrator):
 
         rigid (hoomd.md.constrain.Rigid): The rigid body definition for the
             simulation associated with the integrator.
+
+        overlap_ghost_update (bool): When True, overlap the ghost position
+            update with the pair force computation.
+
+        concurrent_forces (bool): When True, independent forces launch their
+            GPU kernels on separate streams.
+
+        max_displacement (float): Largest displacement of any particle in one
+            step when adapting the time step, or ``None`` when `dt` is fixed
+            :math:`[\\mathrm{length}]`.
+
+        dt_min (float): Smallest adaptive time step
+            :math:`[\\mathrm{time}]`.
+
+        dt_max (float): Largest adaptive time step :math:`[\\mathrm{time}]`.
+
+        finc_dt (float): Largest factor by which the adaptive time step
+            increases in one step.
     """
 
     def __init__(self,
@@ -238,14 +301,27 @@ class Integrator(_DynamicIntegrator):
                  forces=None,
                  constraints=None,
                  methods=None,
-                 rigid=None):
+                 rigid=None,
+                 overlap_ghost_update=False,
+                 concurrent_forces=False,
+                 max_displacement=None,
+                 dt_min=0.0,
+                 dt_max=None,
+                 finc_dt=1.1):
 
         super().__init__(forces, constraints, methods, rigid)
 
         self._param_dict.update(
             ParameterDict(
                 dt=float(dt),
-                integrate_rotational_dof=bool(integrate_rotational_dof)))
+                integrate_rotational_dof=bool(integrate_rotational_dof),
+                overlap_ghost_update=bool(overlap_ghost_update),
+                concurrent_forces=bool(concurrent_forces),
+                max_displacement=OnlyTypes(float, allow_none=True),
+                dt_min=float(dt_min),
+                dt_max=float(dt if dt_max is None else dt_max),
+                finc_dt=float(finc_dt)))
+        self._param_dict.update(dict(max_displacement=max_displacement))
 
     def _attach(self):
         # initialize the reflected c++ class
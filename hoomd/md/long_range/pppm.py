@@ -10,7 +10,14 @@ import math
 import numpy
 
 
-def make_pppm_coulomb_forces(nlist, resolution, order, r_cut, alpha=0):
+def make_pppm_coulomb_forces(nlist,
+                             resolution,
+                             order,
+                             r_cut,
+                             alpha=0,
+                             differentiation='ik',
+                             single_rank_fft=False,
+                             slab_correction=False):
     """Long range Coulomb interactions evaluated using the PPPM method.
 
     Args:
@@ -23,6 +30,12 @@ def make_pppm_coulomb_forces(nlist, resolution, order, r_cut, alpha=0):
           space terms :math:`\\mathrm{[length]}`.
         alpha (float): Debye screening parameter
           :math:`\\mathrm{[length^{-1}]}`.
+        differentiation (str): Method to compute the forces on the grid,
+          ``'ik'`` or ``'ad'``.
+        single_rank_fft (bool): When True, compute the reciprocal space term
+          on rank 0 in MPI simulations.
+        slab_correction (bool): When True, remove the interactions between
+          the periodic images of a slab along z.
 
     Evaluate the potential energy :math:`U_\\mathrm{coulomb}` and apply
     the corresponding forces to the particles in the simulation.
@@ -75,9 +88,38 @@ def make_pppm_coulomb_forces(nlist, resolution, order, r_cut, alpha=0):
     cutoff is so large that the short ranged interactions are inefficient. See
     `Salin, G and Caillol, J. 2000`_ for details.
 
+    With ``differentiation='ik'`` (the default), `md.long_range.pppm.Coulomb`
+    computes the electric field in Fourier space and transforms each of its
+    three components back to the grid. With ``differentiation='ad'``, it
+    transforms only the electrostatic potential back to the grid and
+    differentiates the charge assignment function to interpolate the forces.
+    Analytical differentiation performs one inverse FFT instead of three and
+    uses the optimal influence function for this scheme (see Hockney, R. W.
+    and Eastwood, J. W., Computer Simulation Using Particles, 1988). It is
+    faster for large grids, but does not conserve momentum exactly. Use a
+    larger ``order`` with ``'ad'`` to reach the same accuracy as ``'ik'``.
+
+    In MPI simulations, the reciprocal space term uses a distributed FFT by
+    default. Its all-to-all communication scales poorly to many ranks. With
+    ``single_rank_fft=True``, the ranks instead send their part of the charge
+    grid to rank 0, which transforms the whole grid and sends back the parts
+    of the force grids. This is faster when the grid is small compared to the
+    number of ranks. ``single_rank_fft`` is not supported on the GPU.
+
+    To model a slab that is periodic only in x and y, place it in a box with an
+    empty gap along z and set ``slab_correction=True``. The slab correction
+    adds the energy :math:`\frac{2\pi}{V} \left(M_z^2 - Q \sum_i q_i z_i^2 -
+    Q^2 L_z^2 / 12\right)` and the corresponding forces, where :math:`M_z =
+    \sum_i q_i z_i` and :math:`Q = \sum_i q_i`. This removes the dipolar
+    interaction between the periodic images of the slab along z, so a gap of
+    about twice the slab thickness is enough, instead of the much larger gap
+    needed without the correction. See `Yeh, I. and Berkowitz, M. 1999`_ and,
+    for systems with a net charge, `Ballenegger, V. et. al. 2009`_. The slab
+    correction does not contribute to the pressure.
+
     Warning:
         In MPI simulations with multiple ranks, the grid resolution must be a
-        power of two in each dimension.
+        power of two in each dimension, unless ``single_rank_fft`` is True.
 
     Returns:
         ``real_space_force``, ``reciprocal_space_force``
@@ -95,6 +137,10 @@ def make_pppm_coulomb_forces(nlist, resolution, order, r_cut, alpha=0):
     .. _D. LeBard et. al. 2012: http://dx.doi.org/10.1039/c1sm06787g
 
     .. _Salin, G and Caillol, J. 2000: http://dx.doi.org/10.1063/1.1326477
+
+    .. _Yeh, I. and Berkowitz, M. 1999: https://doi.org/10.1063/1.479595
+
+    .. _Ballenegger, V. et. al. 2009: https://doi.org/10.1063/1.3216473
     """
     real_space_force = hoomd.md.pair.Ewald(nlist)
 
@@ -108,7 +154,10 @@ def make_pppm_coulomb_forces(nlist, resolution, order, r_cut, alpha=0):
                                      order=order,
                                      r_cut=r_cut,
                                      alpha=0,
-                                     pair_force=real_space_force)
+                                     pair_force=real_space_force,
+                                     differentiation=differentiation,
+                                     single_rank_fft=single_rank_fft,
+                                     slab_correction=slab_correction)
 
     return real_space_force, reciprocal_space_force
 
@@ -130,21 +179,44 @@ class Coulomb(Force):
           space terms :math:`\\mathrm{[length]}`.
         alpha (float): Debye screening parameter
           :math:`\\mathrm{[length^{-1}]}`.
+        differentiation (str): Method to compute the forces on the grid,
+          ``'ik'`` or ``'ad'``.
+        single_rank_fft (bool): When True, compute the reciprocal space term
+          on rank 0 in MPI simulations.
+        slab_correction (bool): When True, remove the interactions between
+          the periodic images of a slab along z.
     """
 
-    def __init__(self, nlist, resolution, order, r_cut, alpha, pair_force):
+    def __init__(self,
+                 nlist,
+                 resolution,
+                 order,
+                 r_cut,
+                 alpha,
+                 pair_force,
+                 differentiation='ik',
+                 single_rank_fft=False,
+                 slab_correction=False):
         self._nlist = hoomd.data.typeconverter.OnlyTypes(
             hoomd.md.nlist.NList)(nlist)
+        differentiation_type = hoomd.data.typeconverter.OnlyFrom(['ik', 'ad'])
         self._param_dict.update(
-            hoomd.data.parameterdicts.ParameterDict(resolution=(int, int, int),
-                                                    order=int,
-                                                    r_cut=float,
-                                                    alpha=float))
+            hoomd.data.parameterdicts.ParameterDict(
+                resolution=(int, int, int),
+                order=int,
+                r_cut=float,
+                alpha=float,
+                differentiation=differentiation_type,
+                single_rank_fft=bool,
+                slab_correction=bool))
 
         self.resolution = resolution
         self.order = order
         self.r_cut = r_cut
         self.alpha = alpha
+        self.differentiation = differentiation
+        self.single_rank_fft = single_rank_fft
+        self.slab_correction = slab_correction
         self._pair_force = pair_force
 
     def _attach(self):
@@ -170,6 +242,7 @@ class Coulomb(Force):
         order = self.order
         rcut = self.r_cut
         alpha = self.alpha
+        analytic_diff = self.differentiation == 'ad'
 
         group = self._simulation.state._get_group(hoomd.filter.All())
         self._cpp_obj = cls(self._simulation.state._cpp_sys_def,
@@ -235,7 +308,9 @@ class Coulomb(Force):
                 self._pair_force.params[(a, b)] = dict(kappa=kappa, alpha=alpha)
                 self._pair_force.r_cut[(a, b)] = rcut
 
-        self._cpp_obj.setParams(Nx, Ny, Nz, order, kappa, rcut, alpha)
+        self._cpp_obj.setParams(Nx, Ny, Nz, order, kappa, rcut, alpha,
+                                analytic_diff, self.single_rank_fft,
+                                self.slab_correction)
 
         super()._attach()
 
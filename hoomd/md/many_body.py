@@ -457,3 +457,98 @@ class SquareDensity(Triplet):
         params = TypeParameter('params', 'particle_types',
                                TypeParameterDict(A=0.0, B=float, len_keys=2))
         self._add_typeparam(params)
+
+
+class StillingerWeber(Triplet):
+    r"""Stillinger-Weber three-body potential.
+
+    Args:
+        nlist (:py:mod:`hoomd.md.nlist`): Neighbor list
+        default_r_cut (float): Default cutoff radius :math:`[\mathrm{length}]`.
+
+    :py:class:`StillingerWeber` computes the Stillinger-Weber potential
+    between all triplets of particles:
+
+    .. math::
+
+        V = \sum_{i<j} \phi_2(r_{ij})
+            + \sum_i \sum_{j<k} \phi_3(r_{ij}, r_{ik}, \theta_{jik})
+
+    .. math::
+
+        \phi_2(r) = A \varepsilon \left[ B \left(\frac{\sigma}{r}\right)^p
+                    - \left(\frac{\sigma}{r}\right)^q \right]
+                    \exp\left(\frac{\sigma}{r - r_{\mathrm{cut}}}\right)
+
+    .. math::
+
+        \phi_3 = \lambda \varepsilon
+                 (\cos\theta_{jik} - \cos\theta_0)^2
+                 \exp\left(\frac{\gamma \sigma}{r_{ij}
+                    - r_{\mathrm{cut}}}\right)
+                 \exp\left(\frac{\gamma \sigma}{r_{ik}
+                    - r_{\mathrm{cut}}}\right)
+
+    The cutoff :math:`r_{\mathrm{cut}}` is the parameter :math:`a \sigma` of
+    the original potential. The three-body term of a triplet uses the
+    parameters of the :math:`(i, j)` type pair.
+
+    .. py:attribute:: params
+
+        The Stillinger-Weber potential parameters. The dictionary has the
+        following keys:
+
+        * ``epsilon`` (`float`, **required**) - :math:`\varepsilon`
+          :math:`[\mathrm{energy}]`
+        * ``sigma`` (`float`, **required**) - :math:`\sigma`
+          :math:`[\mathrm{length}]`
+        * ``A`` (`float`, **required**) - :math:`A` - magnitude of the pair
+          term :math:`[\mathrm{dimensionless}]`
+        * ``B`` (`float`, **required**) - :math:`B` - magnitude of the
+          repulsive part of the pair term :math:`[\mathrm{dimensionless}]`
+        * ``p`` (`float`, **required**) - :math:`p` - repulsive exponent
+          :math:`[\mathrm{dimensionless}]`
+        * ``q`` (`float`, **required**) - :math:`q` - attractive exponent
+          :math:`[\mathrm{dimensionless}]`
+        * ``lambda3`` (`float`, **required**) - :math:`\lambda` - magnitude
+          of the three-body term :math:`[\mathrm{dimensionless}]`
+        * ``gamma`` (`float`, **required**) - :math:`\gamma` - range of the
+          three-body term :math:`[\mathrm{dimensionless}]`
+        * ``cos_theta0`` (`float`, **optional**) - :math:`\cos\theta_0` -
+          cosine of the equilibrium bond angle (*default*: -1/3)
+          :math:`[\mathrm{dimensionless}]`
+
+        Type: `TypeParameter` [`tuple` [``particle_type``, ``particle_type``],
+        `dict`]
+
+    Example::
+
+        nl = md.nlist.Cell(buffer=0.4)
+        sw = md.many_body.StillingerWeber(nl, default_r_cut=1.8 * 2.0951)
+        sw.params[('Si', 'Si')] = dict(epsilon=2.1683, sigma=2.0951,
+            A=7.049556277, B=0.6022245584, p=4.0, q=0.0, lambda3=21.0,
+            gamma=1.2)
+
+    For further details regarding this potential, see
+
+    [1] F. H. Stillinger and T. A. Weber, "Computer simulation of local order
+    in condensed phases of silicon" Phys. Rev. B, vol. 31, no. 8,
+    p. 5262, 1985.
+    """
+    _cpp_class_name = "PotentialStillingerWeber"
+
+    def __init__(self, nlist, default_r_cut=None):
+        super().__init__(nlist, default_r_cut)
+        params = TypeParameter(
+            'params', 'particle_types',
+            TypeParameterDict(epsilon=float,
+                              sigma=float,
+                              A=float,
+                              B=float,
+                              p=float,
+                              q=float,
+                              lambda3=float,
+                              gamma=float,
+                              cos_theta0=-1.0 / 3.0,
+                              len_keys=2))
+        self._add_typeparam(params)
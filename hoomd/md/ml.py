@@ -0,0 +1,117 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Machine-learned potentials."""
+
+import hoomd
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyTypes, positive_real
+from hoomd.md import _md
+from hoomd.md.force import Force
+from hoomd.md.nlist import NList
+
+validate_nlist = OnlyTypes(NList)
+
+
+class TorchScript(Force):
+    r"""Machine-learned potential evaluated by a TorchScript model.
+
+    Args:
+        nlist (`hoomd.md.nlist.NList`): Neighbor list to build the graph from.
+        filename (str): TorchScript file to load the model from.
+        r_cut (float): Cutoff radius of the graph :math:`[\mathrm{length}]`.
+
+    `TorchScript` evaluates a model saved with `torch.jit.save` on the local
+    particle graph. Each step, it builds one directed edge :math:`i \to j` for
+    each particle :math:`i` and each neighbor :math:`j` closer than *r_cut* and
+    calls the model with:
+
+    * ``types``: ``int64`` tensor of shape :math:`(N,)` with the type id of each
+      particle.
+    * ``edge_index``: ``int64`` tensor of shape :math:`(2, E)` with the indices
+      :math:`i` (first row) and :math:`j` (second row) of each edge.
+    * ``edge_vec``: tensor of shape :math:`(E, 3)` with the minimum image
+      vectors :math:`\vec{r}_j - \vec{r}_i` in the precision of HOOMD-blue.
+
+    The model returns a tensor of shape :math:`(N,)` with the energy
+    :math:`U_i` of each particle :math:`i`, which must depend only on the
+    edges that start at :math:`i`. `TorchScript` computes the forces and the
+    virial from the gradient of :math:`\sum_i U_i` with respect to
+    ``edge_vec`` with autograd.
+
+    The graph is built where the simulation runs and passed to the model
+    without copies. On the GPU, the model runs on the simulation's device. In
+    MPI simulations, :math:`N` includes the ghost particles within *r_cut* of
+    the local domain, no edges start at ghost particles, and the forces on
+    ghost particles are sent to the ranks that own them.
+
+    Example::
+
+        nl = hoomd.md.nlist.Cell(buffer=0.4)
+        model = hoomd.md.ml.TorchScript(nlist=nl,
+                                        filename='model.pt',
+                                        r_cut=5.0)
+        integrator.forces.append(model)
+
+    Note:
+        `TorchScript` is available only when HOOMD-blue is built with
+        ``ENABLE_TORCH=on``. See `hoomd.version.torch_enabled`.
+
+    Warning:
+        HOOMD-blue does not support reverse force communication between MPI
+        domains on the GPU. `TorchScript` raises an error when used on the GPU
+        with more than one MPI rank.
+
+    Attributes:
+        filename (str): TorchScript file to load the model from.
+        r_cut (float): Cutoff radius of the graph :math:`[\mathrm{length}]`.
+    """
+
+    def __init__(self, nlist, filename, r_cut):
+        self._nlist = validate_nlist(nlist)
+        self._param_dict.update(
+            ParameterDict(filename=str, r_cut=positive_real))
+        self.filename = filename
+        self.r_cut = r_cut
+
+    def _attach(self):
+        if not hoomd.version.torch_enabled:
+            raise RuntimeError(
+                "TorchScript is not available in this build of HOOMD-blue.")
+
+        if not self._nlist._added:
+            self._nlist._add(self._simulation)
+        else:
+            if self._simulation != self._nlist._simulation:
+                raise RuntimeError("{} object's neighbor list is used in a "
+                                   "different simulation.".format(type(self)))
+        if not self.nlist._attached:
+            self.nlist._attach()
+        self.nlist._cpp_obj.setStorageMode(_md.NeighborList.storageMode.full)
+
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            cls = _md.MLPotential
+        else:
+            cls = _md.MLPotentialGPU
+
+        self._cpp_obj = cls(self._simulation.state._cpp_sys_def,
+                            self.nlist._cpp_obj, self.filename, self.r_cut)
+
+        super()._attach()
+
+    @property
+    def nlist(self):
+        """Neighbor list used to build the graph."""
+        return self._nlist
+
+    @nlist.setter
+    def nlist(self, value):
+        if self._attached:
+            raise RuntimeError("nlist cannot be set after scheduling.")
+        else:
+            self._nlist = validate_nlist(value)
+
+    @property
+    def _children(self):
+        return [self._nlist]
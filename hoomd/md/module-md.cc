@@ -16,13 +16,17 @@
 #include "BondTablePotential.h"
 #include "ComputeThermo.h"
 #include "ComputeThermoHMA.h"
+#include "ComputeThermoMultiGroup.h"
 #include "CosineSqAngleForceCompute.h"
+#include "DynamicBondUpdater.h"
 #include "EvaluatorRevCross.h"
 #include "EvaluatorSquareDensity.h"
+#include "EvaluatorStillingerWeber.h"
 #include "EvaluatorTersoff.h"
 #include "FIREEnergyMinimizer.h"
 #include "ForceComposite.h"
 #include "ForceDistanceConstraint.h"
+#include "FusedBondedForceCompute.h"
 #include "HarmonicAngleForceCompute.h"
 #include "HarmonicDihedralForceCompute.h"
 #include "HarmonicImproperForceCompute.h"
@@ -35,10 +39,13 @@
 #include "ManifoldSphere.h"
 #include "ManifoldXYPlane.h"
 #include "ManifoldZCylinder.h"
+#include "MLPotential.h"
+#include "MeanSquaredDisplacement.h"
 #include "MolecularForceCompute.h"
 #include "MuellerPlatheFlow.h"
 #include "NeighborList.h"
 #include "NeighborListBinned.h"
+#include "NeighborListBufferTuner.h"
 #include "NeighborListStencil.h"
 #include "NeighborListTree.h"
 #include "OPLSDihedralForceCompute.h"
@@ -49,6 +56,8 @@
 #include "PotentialPairDPDThermo.h"
 #include "PotentialTersoff.h"
 #include "QuaternionMath.h"
+#include "RadialDistributionFunction.h"
+#include "StructureFactor.h"
 #include "TableAngleForceCompute.h"
 #include "TableDihedralForceCompute.h"
 #include "TwoStepBD.h"
@@ -61,6 +70,7 @@
 #include "TwoStepRATTLEBD.h"
 #include "TwoStepRATTLELangevin.h"
 #include "TwoStepRATTLENVE.h"
+#include "UpdaterReplicaExchange.h"
 #include "WallData.h"
 #include "ZeroMomentumUpdater.h"
 
@@ -72,16 +82,22 @@
 #include "BondTablePotentialGPU.h"
 #include "ComputeThermoGPU.h"
 #include "ComputeThermoHMAGPU.h"
+#include "ComputeThermoMultiGroupGPU.h"
 #include "CosineSqAngleForceComputeGPU.h"
+#include "DynamicBondUpdaterGPU.h"
 #include "FIREEnergyMinimizerGPU.h"
 #include "ForceCompositeGPU.h"
 #include "ForceDistanceConstraintGPU.h"
+#include "FusedBondedForceComputeGPU.h"
 #include "HarmonicAngleForceComputeGPU.h"
 #include "HarmonicDihedralForceComputeGPU.h"
 #include "HarmonicImproperForceComputeGPU.h"
+#include "MLPotentialGPU.h"
+#include "MeanSquaredDisplacementGPU.h"
 #include "MuellerPlatheFlowGPU.h"
 #include "NeighborListGPU.h"
 #include "NeighborListGPUBinned.h"
+#include "NeighborListGPUCluster.h"
 #include "NeighborListGPUStencil.h"
 #include "NeighborListGPUTree.h"
 #include "OPLSDihedralForceComputeGPU.h"
@@ -91,6 +107,8 @@
 #include "PotentialPairDPDThermoGPU.h"
 #include "PotentialPairGPU.h"
 #include "PotentialTersoffGPU.h"
+#include "RadialDistributionFunctionGPU.h"
+#include "StructureFactorGPU.h"
 #include "TableAngleForceComputeGPU.h"
 #include "TableDihedralForceComputeGPU.h"
 #include "TwoStepBDGPU.h"
@@ -250,6 +268,7 @@ PYBIND11_MODULE(_md, m)
     export_ActiveRotationalDiffusionUpdater(m);
     export_ComputeThermo(m);
     export_ComputeThermoHMA(m);
+    export_ComputeThermoMultiGroup(m);
     export_HarmonicAngleForceCompute(m);
     export_CosineSqAngleForceCompute(m);
     export_TableAngleForceCompute(m);
@@ -257,6 +276,7 @@ PYBIND11_MODULE(_md, m)
     export_OPLSDihedralForceCompute(m);
     export_TableDihedralForceCompute(m);
     export_HarmonicImproperForceCompute(m);
+    export_FusedBondedForceCompute(m);
     export_BondTablePotential(m);
     export_PotentialPair<PotentialPairBuckingham>(m, "PotentialPairBuckingham");
     export_PotentialPair<PotentialPairLJ>(m, "PotentialPairLJ");
@@ -274,20 +294,24 @@ PYBIND11_MODULE(_md, m)
     export_PotentialTersoff<PotentialTripletTersoff>(m, "PotentialTersoff");
     export_PotentialTersoff<PotentialTripletSquareDensity>(m, "PotentialSquareDensity");
     export_PotentialTersoff<PotentialTripletRevCross>(m, "PotentialRevCross");
+    export_PotentialTersoff<PotentialTripletStillingerWeber>(m, "PotentialStillingerWeber");
     export_PotentialPair<PotentialPairMie>(m, "PotentialPairMie");
     export_PotentialPair<PotentialPairReactionField>(m, "PotentialPairReactionField");
     export_PotentialPair<PotentialPairDLVO>(m, "PotentialPairDLVO");
     export_PotentialPair<PotentialPairFourier>(m, "PotentialPairFourier");
     export_PotentialPair<PotentialPairOPP>(m, "PotentialPairOPP");
     export_PotentialPair<PotentialPairTWF>(m, "PotentialPairTWF");
+    export_PotentialPair<PotentialPairLJYukawa>(m, "PotentialPairLJYukawa");
     export_AnisoPotentialPair<AnisoPotentialPairGB>(m, "AnisoPotentialPairGB");
     export_AnisoPotentialPair<AnisoPotentialPairDipole>(m, "AnisoPotentialPairDipole");
+    export_AnisoPotentialPair<AnisoPotentialPairRigidSites>(m, "AnisoPotentialPairRigidSites");
     export_PotentialPair<PotentialPairForceShiftedLJ>(m, "PotentialPairForceShiftedLJ");
     export_PotentialPairDPDThermo<PotentialPairDPDThermoDPD, PotentialPairDPD>(
         m,
         "PotentialPairDPDThermoDPD");
     export_PotentialPair<PotentialPairDPDLJ>(m, "PotentialPairDPDLJ");
     export_PotentialPair<PotentialPairTable>(m, "PotentialPairTable");
+    export_PotentialPair<PotentialPairTableSpline>(m, "PotentialPairTableSpline");
     export_PotentialPairDPDThermo<PotentialPairDPDLJThermoDPD, PotentialPairDPDLJ>(
         m,
         "PotentialPairDPDLJThermoDPD");
@@ -297,7 +321,12 @@ PYBIND11_MODULE(_md, m)
     export_PotentialSpecialPair<PotentialSpecialPairLJ>(m, "PotentialSpecialPairLJ");
     export_PotentialSpecialPair<PotentialSpecialPairCoulomb>(m, "PotentialSpecialPairCoulomb");
     export_NeighborList(m);
+    export_LocalNeighborListData<HOOMDHostBuffer>(m, "LocalNeighborListDataHost");
+#ifdef ENABLE_HIP
+    export_LocalNeighborListData<HOOMDDeviceBuffer>(m, "LocalNeighborListDataDevice");
+#endif
     export_NeighborListBinned(m);
+    export_NeighborListBufferTuner(m);
     export_NeighborListStencil(m);
     export_NeighborListTree(m);
     export_MolecularForceCompute(m);
@@ -320,6 +349,7 @@ PYBIND11_MODULE(_md, m)
 #ifdef ENABLE_HIP
     export_NeighborListGPU(m);
     export_NeighborListGPUBinned(m);
+    export_NeighborListGPUCluster(m);
     export_NeighborListGPUStencil(m);
     export_NeighborListGPUTree(m);
     export_ForceCompositeGPU(m);
@@ -358,6 +388,8 @@ PYBIND11_MODULE(_md, m)
     export_PotentialTersoffGPU<PotentialTripletRevCrossGPU, PotentialTripletRevCross>(
         m,
         "PotentialRevCrossGPU");
+    export_PotentialTersoffGPU<PotentialTripletStillingerWeberGPU,
+                               PotentialTripletStillingerWeber>(m, "PotentialStillingerWeberGPU");
     export_PotentialPairGPU<PotentialPairForceShiftedLJGPU, PotentialPairForceShiftedLJ>(
         m,
         "PotentialPairForceShiftedLJGPU");
@@ -367,11 +399,17 @@ PYBIND11_MODULE(_md, m)
         "PotentialPairExpandedMieGPU");
     export_PotentialPairGPU<PotentialPairOPPGPU, PotentialPairOPP>(m, "PotentialPairOPPGPU");
     export_PotentialPairGPU<PotentialPairTWFGPU, PotentialPairTWF>(m, "PotentialPairTWFGPU");
+    export_PotentialPairGPU<PotentialPairLJYukawaGPU, PotentialPairLJYukawa>(
+        m,
+        "PotentialPairLJYukawaGPU");
     export_PotentialPairDPDThermoGPU<PotentialPairDPDThermoDPDGPU, PotentialPairDPDThermoDPD>(
         m,
         "PotentialPairDPDThermoDPDGPU");
     export_PotentialPairGPU<PotentialPairDPDLJGPU, PotentialPairDPDLJ>(m, "PotentialPairDPDLJGPU");
     export_PotentialPairGPU<PotentialPairTableGPU, PotentialPairTable>(m, "PotentialPairTableGPU");
+    export_PotentialPairGPU<PotentialPairTableSplineGPU, PotentialPairTableSpline>(
+        m,
+        "PotentialPairTableSplineGPU");
     export_PotentialPairDPDThermoGPU<PotentialPairDPDLJThermoDPDGPU, PotentialPairDPDLJThermoDPD>(
         m,
         "PotentialPairDPDLJThermoDPDGPU");
@@ -381,6 +419,9 @@ PYBIND11_MODULE(_md, m)
     export_AnisoPotentialPairGPU<AnisoPotentialPairDipoleGPU, AnisoPotentialPairDipole>(
         m,
         "AnisoPotentialPairDipoleGPU");
+    export_AnisoPotentialPairGPU<AnisoPotentialPairRigidSitesGPU, AnisoPotentialPairRigidSites>(
+        m,
+        "AnisoPotentialPairRigidSitesGPU");
     export_PotentialBondGPU<PotentialBondHarmonicGPU, PotentialBondHarmonic>(
         m,
         "PotentialBondHarmonicGPU");
@@ -401,9 +442,11 @@ PYBIND11_MODULE(_md, m)
     export_OPLSDihedralForceComputeGPU(m);
     export_TableDihedralForceComputeGPU(m);
     export_HarmonicImproperForceComputeGPU(m);
+    export_FusedBondedForceComputeGPU(m);
     export_ForceDistanceConstraintGPU(m);
     export_ComputeThermoGPU(m);
     export_ComputeThermoHMAGPU(m);
+    export_ComputeThermoMultiGroupGPU(m);
     export_PPPMForceComputeGPU(m);
     export_ActiveForceComputeGPU(m);
     export_ActiveForceConstraintComputeGPU<ManifoldZCylinder>(
@@ -453,6 +496,7 @@ PYBIND11_MODULE(_md, m)
     export_IntegratorTwoStep(m);
     export_IntegrationMethodTwoStep(m);
     export_ZeroMomentumUpdater(m);
+    export_UpdaterReplicaExchange(m);
     export_TwoStepNVE(m);
     export_TwoStepNVTMTK(m);
     export_TwoStepLangevinBase(m);
@@ -462,6 +506,13 @@ PYBIND11_MODULE(_md, m)
     export_Berendsen(m);
     export_FIREEnergyMinimizer(m);
     export_MuellerPlatheFlow(m);
+    export_DynamicBondUpdater(m);
+    export_RadialDistributionFunction(m);
+    export_MeanSquaredDisplacement(m);
+    export_StructureFactor(m);
+#ifdef ENABLE_TORCH
+    export_MLPotential(m);
+#endif
 
     // RATTLE
     export_TwoStepRATTLEBD<ManifoldZCylinder>(m, "TwoStepRATTLEBDCylinder");
@@ -497,6 +548,13 @@ PYBIND11_MODULE(_md, m)
     export_BerendsenGPU(m);
     export_FIREEnergyMinimizerGPU(m);
     export_MuellerPlatheFlowGPU(m);
+    export_DynamicBondUpdaterGPU(m);
+    export_RadialDistributionFunctionGPU(m);
+    export_MeanSquaredDisplacementGPU(m);
+    export_StructureFactorGPU(m);
+#ifdef ENABLE_TORCH
+    export_MLPotentialGPU(m);
+#endif
 
     export_TwoStepRATTLEBDGPU<ManifoldZCylinder>(m, "TwoStepRATTLEBDCylinderGPU");
     export_TwoStepRATTLEBDGPU<ManifoldDiamond>(m, "TwoStepRATTLEBDDiamondGPU");
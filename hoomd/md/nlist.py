@@ -17,10 +17,10 @@ from hoomd.data.parameterdicts import ParameterDict
 from hoomd.data.typeconverter import OnlyFrom
 from hoomd.logging import log
 from hoomd.md import _md
-from hoomd.operation import _HOOMDBaseObject
+from hoomd.operation import _TimedObject
 
 
-class NList(_HOOMDBaseObject):
+class NList(_TimedObject):
     r"""Base class neighbor list.
 
     Methods and attributes provided by this base class are available to all
@@ -70,6 +70,22 @@ class NList(_HOOMDBaseObject):
     largest value that any particle's diameter will achieve (where **diameter**
     is the per particle quantity stored in the `hoomd.State`).
 
+    .. rubric:: Compression
+
+    Set `compress` to `True` to store the neighbor list in a compressed format.
+    Neighbors whose index differs from the particle's own index by less than
+    32768 are stored as 16 bit offsets, which is nearly all of them when
+    `hoomd.tune.ParticleSorter` sorts the particles. The compressed list halves
+    the memory traffic of reading the neighbor list in pair forces. Only
+    `hoomd.md.pair` potentials that derive from `hoomd.md.pair.Pair` read
+    compressed lists, other forces raise an error when the neighbor list they
+    use is compressed.
+
+    Note:
+        Compression does not reduce the memory used by the neighbor list. The
+        builders write full 32 bit indices and the list is compressed in
+        place after each build, so the allocation stays the same size.
+
     Attributes:
         buffer (float): Buffer width :math:`[\mathrm{length}]`.
         exclusions (tuple[str]): Defines which particles to exlclude from the
@@ -80,10 +96,17 @@ class NList(_HOOMDBaseObject):
         check_dist (bool): Flag to enable / disable distance checking.
         max_diameter (float): The maximum diameter a particle will achieve
             :math:`[\mathrm{length}]`.
+        compress (bool): Flag to enable / disable compressed storage.
     """
 
-    def __init__(self, buffer, exclusions, rebuild_check_delay, diameter_shift,
-                 check_dist, max_diameter):
+    def __init__(self,
+                 buffer,
+                 exclusions,
+                 rebuild_check_delay,
+                 diameter_shift,
+                 check_dist,
+                 max_diameter,
+                 compress=False):
 
         validate_exclusions = OnlyFrom([
             'bond', 'angle', 'constraint', 'dihedral', 'special_pair', 'body',
@@ -96,6 +119,7 @@ class NList(_HOOMDBaseObject):
                                check_dist=bool(check_dist),
                                diameter_shift=bool(diameter_shift),
                                max_diameter=float(max_diameter),
+                               compress=bool(compress),
                                _defaults={'exclusions': exclusions})
         self._param_dict.update(params)
 
@@ -108,6 +132,54 @@ class NList(_HOOMDBaseObject):
         """
         return self._cpp_obj.getSmallestRebuild()
 
+    @property
+    def cpu_local_nlist_arrays(self):
+        """hoomd.md.data.NeighborListLocalAccess: Expose the neighbor list \
+        on the CPU.
+
+        Provides zero-copy, read only access to the neighbor list through a
+        context manager, so that custom analysis can reuse the neighbors found
+        by HOOMD-blue. The arrays are MPI rank local.
+
+        .. code-block:: python
+
+            with nlist.cpu_local_nlist_arrays as arrays:
+                start = arrays.head_list[i]
+                neighbors = arrays.nlist[start:start + arrays.n_neigh[i]]
+
+        Note:
+            The neighbor list must be used by an attached force. It contains
+            all particles within the largest cutoff plus the buffer, and lists
+            each pair once when `half_nlist` is `True`. Compressed neighbor
+            lists cannot be accessed.
+        """
+        if not self._attached:
+            raise hoomd.error.DataAccessError("cpu_local_nlist_arrays")
+        self._cpp_obj.compute(self._simulation.timestep)
+        return hoomd.md.data.NeighborListLocalAccess(self,
+                                                     self._simulation.state)
+
+    @property
+    def gpu_local_nlist_arrays(self):
+        """hoomd.md.data.NeighborListLocalAccessGPU: Expose the neighbor list \
+        on the GPU.
+
+        Provides the same arrays as `cpu_local_nlist_arrays` in device memory.
+        The arrays implement the ``__cuda_array_interface__`` and can be used
+        with CuPy or PyTorch without a copy.
+
+        Warning:
+            This property is only available when running on a GPU(s).
+        """
+        if not isinstance(self._simulation.device, hoomd.device.GPU):
+            raise RuntimeError(
+                "Cannot access gpu_local_nlist_arrays with a non GPU device.")
+        if not self._attached:
+            raise hoomd.error.DataAccessError("gpu_local_nlist_arrays")
+        self._cpp_obj.compute(self._simulation.timestep)
+        return hoomd.md.data.NeighborListLocalAccessGPU(self,
+                                                        self._simulation.state)
+
     def _remove_dependent(self, obj):
         super()._remove_dependent(obj)
         if len(self._dependents) == 0:
@@ -136,6 +208,10 @@ class Cell(NList):
             :math:`[\mathrm{length}]`.
         deterministic (bool): When `True`, sort neighbors to help provide
             deterministic simulation runs.
+        compress (bool): Flag to enable / disable compressed storage.
+        incremental (bool): Flag to enable / disable incremental updates.
+        count_first (bool): Flag to enable / disable counting the neighbors
+            before building the list on the GPU.
 
     `Cell` finds neighboring particles using a fixed width cell list, allowing
     for *O(kN)* construction of the neighbor list where *k* is the number of
@@ -144,6 +220,34 @@ class Cell(NList):
     but performance degrades for large cutoff radius asymmetries due to the
     significantly increased number of particles per cell.
 
+    .. rubric:: Incremental updates
+
+    Set `incremental` to `True` to update only part of the neighbor list when
+    few particles move, such as a small mobile region next to a frozen wall or
+    substrate. The distance check then flags the particles that moved more than
+    a quarter of the buffer and `Cell` rebuilds only the lists of the particles
+    in the cells next to cells with a flagged particle. The lists are updated
+    more often than with full rebuilds, but each update only handles the
+    particles near the mobile region. Updates forced by changes to the system,
+    updates in a deforming box, compressed lists, and MPI simulations always
+    rebuild the whole list.
+
+    Note:
+        Incremental updates are only implemented on the CPU. On the GPU,
+        `incremental` has no effect.
+
+    .. rubric:: Counting the neighbors first
+
+    By default, the GPU build writes at most a fixed number of neighbors per
+    particle of each type and rebuilds the list with more memory when a
+    particle has more neighbors. Each build then reads the overflow flags back
+    on the host. Set `count_first` to `True` to first count the neighbors of
+    each particle, size the list of each particle to its count, and then fill
+    in the neighbors. The build traverses the cells twice, but it never
+    overflows and only the total size of the list returns to the host, so its
+    cost does not depend on the history of the simulation. On the CPU,
+    `count_first` has no effect.
+
     Examples::
 
         cell = nlist.Cell()
@@ -151,6 +255,9 @@ class Cell(NList):
     Attributes:
         deterministic (bool): When `True`, sort neighbors to help provide
             deterministic simulation runs.
+        incremental (bool): Flag to enable / disable incremental updates.
+        count_first (bool): Flag to enable / disable counting the neighbors
+            before building the list on the GPU.
     """
 
     def __init__(self,
@@ -160,13 +267,18 @@ class Cell(NList):
                  diameter_shift=False,
                  check_dist=True,
                  max_diameter=1.0,
-                 deterministic=False):
+                 deterministic=False,
+                 compress=False,
+                 incremental=False,
+                 count_first=False):
 
         super().__init__(buffer, exclusions, rebuild_check_delay,
-                         diameter_shift, check_dist, max_diameter)
+                         diameter_shift, check_dist, max_diameter, compress)
 
         self._param_dict.update(
-            ParameterDict(deterministic=bool(deterministic)))
+            ParameterDict(deterministic=bool(deterministic),
+                          incremental=bool(incremental),
+                          count_first=bool(count_first)))
 
     def _attach(self):
         if isinstance(self._simulation.device, hoomd.device.CPU):
@@ -177,6 +289,116 @@ class Cell(NList):
                                   self.buffer)
         super()._attach()
 
+    @property
+    def cpu_local_cell_list_arrays(self):
+        """hoomd.md.data.CellListLocalAccess: Expose the cell list on the CPU.
+
+        Provides zero-copy, read only access to the cell list that `Cell` uses
+        to build the neighbor list through a context manager. The arrays are
+        MPI rank local and reflect the most recent cell list build.
+        """
+        if not self._attached:
+            raise hoomd.error.DataAccessError("cpu_local_cell_list_arrays")
+        return hoomd.md.data.CellListLocalAccess(self, self._simulation.state)
+
+    @property
+    def gpu_local_cell_list_arrays(self):
+        """hoomd.md.data.CellListLocalAccessGPU: Expose the cell list on the \
+        GPU.
+
+        Provides the same arrays as `cpu_local_cell_list_arrays` in device
+        memory.
+
+        Warning:
+            This property is only available when running on a GPU(s).
+        """
+        if not isinstance(self._simulation.device, hoomd.device.GPU):
+            raise RuntimeError(
+                "Cannot access gpu_local_cell_list_arrays with a non GPU "
+                "device.")
+        if not self._attached:
+            raise hoomd.error.DataAccessError("gpu_local_cell_list_arrays")
+        return hoomd.md.data.CellListLocalAccessGPU(self,
+                                                    self._simulation.state)
+
+
+class Cluster(Cell):
+    r"""Cluster pair list for GPU pair potentials.
+
+    Args:
+        buffer (float): Buffer width :math:`[\mathrm{length}]`.
+        exclusions (tuple[str]): Defines which particles to exlclude from the
+            neighbor list, see more details in `NList`.
+        rebuild_check_delay (int): How often to attempt to rebuild the neighbor
+            list.
+        diameter_shift (bool): Flag to enable / disable diameter shifting.
+        check_dist (bool): Flag to enable / disable distance checking.
+        max_diameter (float): The maximum diameter a particle will achieve
+            :math:`[\mathrm{length}]`.
+        deterministic (bool): When `True`, sort neighbors to help provide
+            deterministic simulation runs.
+        cluster_size (int): Number of particles per cluster (4 or 8).
+        compress (bool): Flag to enable / disable compressed storage.
+
+    `Cluster` groups particles with consecutive indices into clusters of
+    ``cluster_size`` particles and lists the pairs of clusters that interact.
+    HOOMD-blue sorts particles along a space filling curve, so the particles in
+    a cluster are close to each other and a cluster interacts with far fewer
+    clusters than its particles have neighbors. Pair potentials
+    (`hoomd.md.pair`) load the particles of each neighboring cluster with
+    coalesced memory reads, which speeds up force evaluations in dense liquids
+    where the pair kernel is limited by memory bandwidth. Anisotropic pair
+    potentials (`hoomd.md.pair.aniso`) stage the positions and orientations of
+    each neighboring cluster in shared memory and reuse them for every particle
+    of the cluster.
+
+    `Cluster` builds the same per-particle neighbor list as `Cell` and derives
+    the cluster pair list from it, so exclusions, body filters, and diameter
+    shifting apply unchanged. Other forces that use the neighbor list read the
+    per-particle list.
+
+    Note:
+        `Cluster` is only available on the GPU. It relies on the particle
+        sorting performed by `hoomd.tune.ParticleSorter` to keep the clusters
+        compact.
+
+    Examples::
+
+        cluster = nlist.Cluster(buffer=0.4, cluster_size=8)
+
+    Attributes:
+        deterministic (bool): When `True`, sort neighbors to help provide
+            deterministic simulation runs.
+        cluster_size (int): Number of particles per cluster (4 or 8).
+    """
+
+    def __init__(self,
+                 buffer,
+                 exclusions=('bond',),
+                 rebuild_check_delay=1,
+                 diameter_shift=False,
+                 check_dist=True,
+                 max_diameter=1.0,
+                 deterministic=False,
+                 cluster_size=8,
+                 compress=False):
+
+        super().__init__(buffer, exclusions, rebuild_check_delay,
+                         diameter_shift, check_dist, max_diameter,
+                         deterministic, compress)
+
+        self._param_dict.update(
+            ParameterDict(cluster_size=OnlyFrom([4, 8]),
+                          _defaults={'cluster_size': cluster_size}))
+
+    def _attach(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            raise hoomd.util.GPUNotAvailableError(
+                "nlist.Cluster is only available on the GPU.")
+        self._cpp_obj = _md.NeighborListGPUCluster(
+            self._simulation.state._cpp_sys_def, self.buffer)
+        NList._attach(self)
+
 
 class Stencil(NList):
     """Cell list based neighbor list using stencils.
@@ -195,6 +417,9 @@ class Stencil(NList):
             :math:`[\\mathrm{length}]`.
         deterministic (bool): When `True`, sort neighbors to help provide
             deterministic simulation runs.
+        compress (bool): Flag to enable / disable compressed storage.
+        type_classes (list[list[str]]): Names of the particle types in each
+            size class. Leave empty to bin all particles in one cell list.
 
     `Stencil` creates a cell list based neighbor list object to which pair
     potentials can be attached for computing non-bonded pairwise interactions.
@@ -220,15 +445,33 @@ class Stencil(NList):
     *cell_width*, and when the *cell_width* covers the simulation box with a
     roughly integer number of cells. The *cell_width* must be set manually.
 
+    .. rubric:: Size classes
+
+    In mixtures of very small and very large particles, cells wide enough for
+    the cutoffs of the large particles hold many small particles. Set
+    *type_classes* to bin the particles of each class in a separate cell list.
+    The cells of a class are as wide as the shortest cutoff to any particle in
+    that class, and each particle searches every class with a stencil sized
+    for its own cutoff to that class. Every type must be in exactly one class.
+    *cell_width* is not used when *type_classes* is set.
+
     Examples::
 
         nl_s = nlist.Stencil(cell_width=1.5)
 
+    .. code-block:: python
+
+        nl_s = nlist.Stencil(cell_width=1.0,
+                             buffer=0.4,
+                             type_classes=[['A'], ['B', 'C']])
+
     Attributes:
         cell_width (float): The underlying stencil bin width for the cell list
             :math:`[\\mathrm{length}]`.
         deterministic (bool): When `True`, sort neighbors to help provide
             deterministic simulation runs.
+        type_classes (list[list[str]]): Names of the particle types in each
+            size class.
     """
 
     def __init__(self,
@@ -239,13 +482,17 @@ class Stencil(NList):
                  diameter_shift=False,
                  check_dist=True,
                  max_diameter=1.0,
-                 deterministic=False):
+                 deterministic=False,
+                 compress=False,
+                 type_classes=()):
 
         super().__init__(buffer, exclusions, rebuild_check_delay,
-                         diameter_shift, check_dist, max_diameter)
+                         diameter_shift, check_dist, max_diameter, compress)
 
         params = ParameterDict(deterministic=bool(deterministic),
-                               cell_width=float(cell_width))
+                               cell_width=float(cell_width),
+                               type_classes=[[str]],
+                               _defaults={'type_classes': type_classes})
 
         self._param_dict.update(params)
 
@@ -272,6 +519,10 @@ class Tree(NList):
         check_dist (bool): Flag to enable / disable distance checking.
         max_diameter (float): The maximum diameter a particle will achieve
             :math:`[\\mathrm{length}]`.
+        compress (bool): Flag to enable / disable compressed storage.
+        refit_threshold (float): Rebuild the trees when the refits have grown
+            their surface area by this factor. 0 rebuilds the trees on every
+            update.
 
     `Tree` creates a neighbor list using a bounding volume hierarchy (BVH) tree
     traversal. A BVH tree of axis-aligned bounding boxes is constructed per
@@ -290,9 +541,29 @@ class Tree(NList):
     describes the improved algorithm that is currently implemented. Cite both
     if you utilize this neighbor list style in your work.
 
+    .. rubric:: Refits
+
+    On the GPU, `Tree` can refit the trees of the last build to the current
+    positions instead of building new ones. A refit keeps the structure of each
+    tree and only recomputes its bounding boxes, which is faster than a build.
+    As the particles diffuse, the boxes overlap more and the traversal slows
+    down, so the trees are rebuilt once the summed surface area of the boxes in
+    any tree exceeds *refit_threshold* times its area after the last build. The
+    trees are also rebuilt after the particles are sorted, change type, or the
+    box changes. Refits are not used in domain decomposed simulations or on the
+    CPU.
+
     Examples::
 
         nl_t = nlist.Tree(check_dist=False)
+
+    .. code-block:: python
+
+        nl_t = nlist.Tree(buffer=0.4, refit_threshold=2.0)
+
+    Attributes:
+        refit_threshold (float): Rebuild the trees when the refits have grown
+            their surface area by this factor (GPU only).
     """
 
     def __init__(self,
@@ -301,10 +572,15 @@ class Tree(NList):
                  rebuild_check_delay=1,
                  diameter_shift=False,
                  check_dist=True,
-                 max_diameter=1.0):
+                 max_diameter=1.0,
+                 compress=False,
+                 refit_threshold=0.0):
 
         super().__init__(buffer, exclusions, rebuild_check_delay,
-                         diameter_shift, check_dist, max_diameter)
+                         diameter_shift, check_dist, max_diameter, compress)
+
+        self._param_dict.update(
+            ParameterDict(refit_threshold=float(refit_threshold)))
 
     def _attach(self):
         if isinstance(self._simulation.device, hoomd.device.CPU):
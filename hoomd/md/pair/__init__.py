@@ -8,7 +8,8 @@ For anisotropic potentials see `hoomd.md.pair.aniso`
 """
 
 from . import aniso
+from . import user
 from .pair import (Pair, LJ, Gauss, SLJ, Yukawa, Ewald, Morse, DPD,
                    DPDConservative, DPDLJ, ForceShiftedLJ, Moliere, ZBL, Mie,
                    ExpandedMie, ReactionField, DLVO, Buckingham, LJ1208, LJ0804,
-                   Fourier, OPP, Table, TWF)
+                   LJYukawa, Fourier, OPP, Table, TableSpline, TWF)
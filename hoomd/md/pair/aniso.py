@@ -248,3 +248,92 @@ class GayBerne(AnisotropicPair):
             A list of dictionaries, one for each particle type in the system.
         """
         return super()._return_type_shapes()
+
+
+class RigidSites(AnisotropicPair):
+    r"""Lennard-Jones interactions between the sites of rigid bodies.
+
+    Args:
+        nlist (`hoomd.md.nlist.NList`): Neighbor list
+        default_r_cut (float): Default cutoff radius between the body centers
+            :math:`[\mathrm{length}]`.
+        mode (str): energy shifting/smoothing mode.
+
+    `RigidSites` computes the interactions between rigid bodies that are
+    made of interaction sites, without representing the sites as particles.
+    Each particle type has a list of site positions :math:`\vec{s}_a` in the
+    body frame. The sites of two bodies :math:`i` and :math:`j` interact with a
+    Lennard-Jones potential:
+
+    .. math::
+
+        U(\vec r, \mathbf{q}_i, \mathbf{q}_j) = \sum_{a \in i}
+            \sum_{b \in j} V_{\mathrm{LJ}}(|\vec{r} + \mathbf{q}_i
+            \vec{s}_a \mathbf{q}_i^* - \mathbf{q}_j \vec{s}_b
+            \mathbf{q}_j^*|)
+
+        V_{\mathrm{LJ}}(r) = 4 \varepsilon \left[
+            \left(\frac{\sigma}{r}\right)^{12}
+            - \left(\frac{\sigma}{r}\right)^{6} \right];
+            \quad r < r_{\mathrm{cut,site}}
+
+    where :math:`\vec{r}` is the vector between the body centers. The site
+    forces are summed into the force and torque on each body, so the bodies
+    can be integrated as single anisotropic particles with
+    ``integrate_rotational_dof=True``. Unlike `hoomd.md.constrain.Rigid`, the
+    sites need no particle data, ghost communication, or neighbor list
+    entries.
+
+    The neighbor list is built between the body centers with the cutoff
+    ``r_cut``. Set ``r_cut`` to at least :math:`r_{\mathrm{cut,site}}` plus
+    the largest distance of a site from the center of each body in the pair,
+    otherwise site interactions are missed. With ``mode='shift'``, each site
+    pair potential is shifted to zero at :math:`r_{\mathrm{cut,site}}`.
+
+    .. py:attribute:: params
+
+        The site interaction parameters. The dictionary has the following
+        keys:
+
+        * ``epsilon`` (`float`, **required**) - :math:`\varepsilon`
+          :math:`[\mathrm{energy}]`
+        * ``sigma`` (`float`, **required**) - :math:`\sigma`
+          :math:`[\mathrm{length}]`
+        * ``r_cut_site`` (`float`, **required**) -
+          :math:`r_{\mathrm{cut,site}}` :math:`[\mathrm{length}]`
+
+        Type: `TypeParameter` [`tuple` [``particle_type``, ``particle_type``],
+        `dict`]
+
+    .. py:attribute:: shape
+
+        The interaction sites of the body. The dictionary has the following
+        keys:
+
+        * ``positions`` (`list` [`tuple` [`float`, `float`, `float`]],
+          **required**) - site positions in the body frame
+          :math:`[\mathrm{length}]`
+
+        Type: `TypeParameter` [``particle_type``, `dict`]
+
+    Example::
+
+        nl = nlist.Cell(buffer=0.4)
+        sites = md.pair.aniso.RigidSites(nl, default_r_cut=2 * 0.5 + 2.5)
+        sites.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0, r_cut_site=2.5)
+        sites.shape['A'] = dict(positions=[(-0.5, 0, 0), (0.5, 0, 0)])
+    """
+    _cpp_class_name = "AnisoPotentialPairRigidSites"
+
+    def __init__(self, nlist, default_r_cut=None, mode='none'):
+        super().__init__(nlist, default_r_cut, mode)
+        params = TypeParameter(
+            'params', 'particle_types',
+            TypeParameterDict(epsilon=float,
+                              sigma=float,
+                              r_cut_site=positive_real,
+                              len_keys=2))
+        shape = TypeParameter(
+            'shape', 'particle_types',
+            TypeParameterDict(positions=[(float, float, float)], len_keys=1))
+        self._extend_typeparam((params, shape))
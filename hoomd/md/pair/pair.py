@@ -122,6 +122,19 @@ class Pair(force.Force):
         Possible values: ``"none"``, ``"shift"``, ``"xplor"``
 
         Type: `str`
+
+    .. py:attribute:: mixed_precision
+
+        When `True`, evaluate the potential in single precision. Pair
+        distances, forces, energies, and virials remain in the precision HOOMD
+        is built with, so the results match the full precision evaluation to
+        single precision round off. In double precision builds, this speeds up
+        the force computation on GPUs with low double precision throughput.
+        `LJ`, `Gauss`, and `Yukawa` support mixed precision, other potentials
+        raise an error when attached with `mixed_precision` set.
+        *Optional*: defaults to `False`.
+
+        Type: `bool`
     """
 
     # The accepted modes for the potential. Should be reset by subclasses with
@@ -141,7 +154,8 @@ class Pair(force.Force):
             tp_r_on.default = default_r_on
         self._extend_typeparam([tp_r_cut, tp_r_on])
         self._param_dict.update(
-            ParameterDict(mode=OnlyFrom(self._accepted_modes)))
+            ParameterDict(mode=OnlyFrom(self._accepted_modes),
+                          mixed_precision=False))
         self.mode = mode
 
     def compute_energy(self, tags1, tags2):
@@ -506,6 +520,77 @@ class Yukawa(Pair):
         self._add_typeparam(params)
 
 
+class LJYukawa(Pair):
+    r"""Sum of the Lennard-Jones and Yukawa pair potentials.
+
+    Args:
+        nlist (`hoomd.md.nlist.NList`): Neighbor list.
+        default_r_cut (float): Default cutoff radius :math:`[\mathrm{length}]`.
+        default_r_on (float): Default turn-on radius :math:`[\mathrm{length}]`.
+        mode (str): Energy shifting/smoothing mode.
+
+    `LJYukawa` computes the sum of the `LJ` and `Yukawa` pair potentials
+    between every non-excluded particle pair in the simulation:
+
+    .. math::
+        :nowrap:
+
+        \begin{eqnarray*}
+        V(r) = & V_{\mathrm{LJ}}(r) + V_{\mathrm{yukawa}}(r);
+               & r < r_{\mathrm{cut}} \\
+             = & 0; & r \ge r_{\mathrm{cut}} \\
+        \end{eqnarray*}
+
+    `LJYukawa` evaluates both potentials in a single pass over the neighbor
+    list, which is faster than adding separate `LJ` and `Yukawa` forces to
+    the integrator. Both terms share the same ``r_cut``, ``r_on``, and
+    ``mode``.
+
+    See `Pair` for details on how forces are calculated and the available
+    energy shifting and smoothing modes.
+
+    .. py:attribute:: params
+
+        The potential parameters. The dictionary has the following keys:
+
+        * ``lj`` (`dict`, **required**) - parameters of the Lennard-Jones
+          term:
+
+          * ``epsilon`` (`float`, **required**) - energy parameter
+            :math:`\varepsilon` :math:`[\mathrm{energy}]`
+          * ``sigma`` (`float`, **required**) - particle size
+            :math:`\sigma` :math:`[\mathrm{length}]`
+
+        * ``yukawa`` (`dict`, **required**) - parameters of the Yukawa term:
+
+          * ``epsilon`` (`float`, **required**) - energy parameter
+            :math:`\varepsilon` :math:`[\mathrm{energy}]`
+          * ``kappa`` (`float`, **required**) - scaling parameter
+            :math:`\kappa` :math:`[\mathrm{length}^{-1}]`
+
+        Type: `TypeParameter` [`tuple` [``particle_type``, ``particle_type``],
+        `dict`]
+
+    Example::
+
+        nl = nlist.Cell()
+        lj_yukawa = pair.LJYukawa(default_r_cut=3.0, nlist=nl)
+        lj_yukawa.params[('A', 'A')] = dict(
+            lj=dict(epsilon=1.0, sigma=1.0),
+            yukawa=dict(epsilon=0.5, kappa=1.0))
+    """
+    _cpp_class_name = "PotentialPairLJYukawa"
+
+    def __init__(self, nlist, default_r_cut=None, default_r_on=0., mode='none'):
+        super().__init__(nlist, default_r_cut, default_r_on, mode)
+        params = TypeParameter(
+            'params', 'particle_types',
+            TypeParameterDict(lj=dict(epsilon=float, sigma=float),
+                              yukawa=dict(epsilon=float, kappa=float),
+                              len_keys=2))
+        self._add_typeparam(params)
+
+
 class Ewald(Pair):
     r"""Ewald pair potential.
 
@@ -666,6 +751,74 @@ class Table(Pair):
                 len_keys=2))
         self._add_typeparam(params)
 
+    @classmethod
+    def from_pair(cls, pair, r_min, width=1000):
+        """Tabulate a pair potential.
+
+        Args:
+            pair (`Pair`): The pair potential to tabulate.
+            r_min (float): The minimum distance of the tables
+                :math:`[\\mathrm{length}]`.
+            width (int): The number of points in each table.
+
+        Returns:
+            A new table potential with the same neighbor list and cutoffs as
+            *pair* and the energies and forces of *pair* tabulated for every
+            type pair set in ``pair.params`` between *r_min* and the cutoff.
+
+        Tabulate expensive potentials to replace their evaluation with a table
+        lookup. The tables include the energy shift when ``pair.mode`` is
+        ``'shift'``. Type pairs with ``r_cut`` of 0 do not interact.
+
+        Example::
+
+            mie = hoomd.md.pair.ExpandedMie(nlist=nlist, default_r_cut=3.0)
+            mie.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0, n=12, m=6,
+                                          delta=0.5)
+            table = hoomd.md.pair.TableSpline.from_pair(mie, r_min=0.8)
+        """
+        if pair.mode == 'xplor':
+            raise ValueError("Cannot tabulate potentials in xplor mode.")
+
+        cpp_cls = getattr(_md, pair._cpp_class_name)
+        table = cls(nlist=pair.nlist)
+        for key in pair.params:
+            r_cut = pair.r_cut[key]
+            if r_cut == 0:
+                table.params[key] = dict(r_min=0, V=[0], F=[0])
+            else:
+                table.params[key] = cpp_cls.tabulate(pair.params[key], r_min,
+                                                     r_cut, width,
+                                                     pair.mode == 'shift')
+            table.r_cut[key] = r_cut
+        return table
+
+
+class TableSpline(Table):
+    """Tabulated pair potential with cubic spline interpolation.
+
+    Args:
+        nlist (`hoomd.md.nlist.NList`): Neighbor list
+        default_r_cut (float): Default cutoff radius :math:`[\\mathrm{length}]`.
+        default_r_on (float): Default turn-on radius :math:`[\\mathrm{length}]`.
+
+    `TableSpline` takes the same parameters as `Table`, and interpolates
+    :math:`V(r)` between the grid points with the cubic Hermite spline through
+    the tabulated energies with slopes :math:`-F`. The force is the derivative
+    of the interpolated energy. The interpolation error is fourth order in the
+    grid spacing, so `TableSpline` reaches the accuracy of `Table` with far
+    fewer points.
+
+    Use `Table.from_pair` to tabulate an existing pair potential.
+
+    Attributes:
+        params (`TypeParameter` [\
+          `tuple` [``particle_type``, ``particle_type``],\
+          `dict`]):
+          The potential parameters. See `Table`.
+    """
+    _cpp_class_name = "PotentialPairTableSpline"
+
 
 class Morse(Pair):
     r"""Morse pair potential.
@@ -0,0 +1,176 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""User-defined pair potentials for molecular dynamics."""
+
+import hoomd
+from hoomd import _compile
+from hoomd.md import _md
+if hoomd.version.llvm_enabled:
+    from hoomd.md import _jit
+from hoomd.md.pair.pair import Pair
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import NDArrayValidator
+import numpy as np
+
+
+class CPPPotential(Pair):
+    r"""Pair potential defined by C++ code compiled at run time.
+
+    Args:
+        nlist (`hoomd.md.nlist.NList`): Neighbor list.
+        code (str): C++ code defining the function body of the pair potential.
+        param_array (list[float]): Parameter values to make available in
+            ``float *param_array`` in the compiled code. If no adjustable
+            parameters are needed in the C++ code, pass an empty array.
+        default_r_cut (float): Default cutoff radius :math:`[\mathrm{length}]`.
+        default_r_on (float): Default turn-on radius :math:`[\mathrm{length}]`.
+        mode (str): Energy shifting/smoothing mode.
+
+    `CPPPotential` compiles the given C++ code with LLVM when attached and
+    evaluates it in the same CPU pair force loop as the built-in potentials,
+    so new pair potentials need neither a plugin nor a rebuild of HOOMD-blue.
+    The text provided is the body of a function with the following signature:
+
+    .. code::
+
+        Scalar eval(Scalar r_sq,
+                    unsigned int type_i,
+                    unsigned int type_j,
+                    Scalar charge_i,
+                    Scalar charge_j,
+                    Scalar& force_divr)
+
+    * ``r_sq`` is the squared distance between the particles.
+    * ``type_i`` and ``type_j`` are the integer type ids of the particles.
+    * ``charge_i`` and ``charge_j`` are the charges of the particles.
+    * ``force_divr`` must be set to :math:`-\frac{1}{r}\frac{\partial V}
+      {\partial r}`.
+
+    The function must return the pair energy :math:`V(r)`. `CPPPotential`
+    calls it only for pairs closer than `r_cut <Pair>` and applies the energy
+    shifting mode. The pair may be passed in either order, so the code must be
+    symmetric in *i* and *j*. ``Scalar`` is the floating point type of this
+    build of HOOMD-blue.
+
+    The compiled code must match the interface of the running HOOMD-blue
+    build, which is versioned in ``hoomd/md/PairJITABI.h``. `CPPPotential`
+    raises an error when the versions differ. Set
+    `hoomd.device.Device.jit_cache` to reuse compiled code between runs.
+
+    See `Pair` for details on how forces are calculated and the available
+    energy shifting and smoothing modes.
+
+    Note:
+        `CPPPotential` is available only when HOOMD-blue is built with
+        ``ENABLE_LLVM=on``, and only on the CPU.
+
+    Warning:
+        `CPPPotential` is **experimental** and subject to change in future
+        minor releases.
+
+    Attributes:
+        code (str): The C++ code that defines the body of the pair potential.
+            After running zero or more steps, this property cannot be changed.
+        param_array (``ndarray<float>``): Numpy array containing dynamically
+            adjustable elements in the potential as defined by the user. After
+            running zero or more steps, the array cannot be set, although
+            individual values can still be changed.
+
+    Example::
+
+        nl = hoomd.md.nlist.Cell(buffer=0.4)
+        lj = '''Scalar r2inv = Scalar(1.0) / r_sq;
+                Scalar r6inv = r2inv * r2inv * r2inv;
+                force_divr = r2inv * r6inv * (48 * r6inv - 24);
+                return 4 * r6inv * (r6inv - 1);
+             '''
+        user = hoomd.md.pair.user.CPPPotential(nlist=nl,
+                                               code=lj,
+                                               param_array=[],
+                                               default_r_cut=2.5)
+    """
+
+    def __init__(self,
+                 nlist,
+                 code,
+                 param_array,
+                 default_r_cut=None,
+                 default_r_on=0.,
+                 mode='none'):
+        super().__init__(nlist, default_r_cut, default_r_on, mode)
+        param_dict = ParameterDict(
+            param_array=NDArrayValidator(dtype=np.float32, shape=(None,)),
+            code=str)
+        param_dict['param_array'] = param_array
+        self._param_dict.update(param_dict)
+        self.code = code
+
+    def _getattr_param(self, attr):
+        if attr == 'code':
+            return self._param_dict[attr]
+        return super()._getattr_param(attr)
+
+    def _wrap_cpu_code(self, code):
+        r"""Wrap the provided code into a function with the expected signature.
+
+        Args:
+            code (`str`): Body of the C++ function
+        """
+        cpp_function = """
+                        #include "hoomd/HOOMDMath.h"
+                        #include "hoomd/md/PairJITABI.h"
+
+                        using namespace hoomd;
+
+                        extern "C"
+                        {
+                        unsigned int hoomd_pair_jit_abi_version
+                            = HOOMD_PAIR_JIT_ABI_VERSION;
+
+                        // param_array is allocated by the library
+                        float *param_array;
+
+                        Scalar eval(Scalar r_sq,
+                            unsigned int type_i,
+                            unsigned int type_j,
+                            Scalar charge_i,
+                            Scalar charge_j,
+                            Scalar& force_divr)
+                            {
+                        """
+        cpp_function += code
+        cpp_function += """
+                            }
+                        }
+                        """
+        return cpp_function
+
+    def _attach(self):
+        if not hoomd.version.llvm_enabled:
+            raise RuntimeError(
+                "CPPPotential is not available in this build of HOOMD-blue.")
+        if not isinstance(self._simulation.device, hoomd.device.CPU):
+            raise RuntimeError("CPPPotential is only available on the CPU.")
+
+        if not self._nlist._added:
+            self._nlist._add(self._simulation)
+        else:
+            if self._simulation != self._nlist._simulation:
+                raise RuntimeError("{} object's neighbor list is used in a "
+                                   "different simulation.".format(type(self)))
+        if not self.nlist._attached:
+            self.nlist._attach()
+        self.nlist._cpp_obj.setStorageMode(_md.NeighborList.storageMode.half)
+
+        self._cpp_obj = _jit.PotentialPairJIT(
+            self._simulation.state._cpp_sys_def,
+            self.nlist._cpp_obj,
+            self._wrap_cpu_code(self.code),
+            _compile.get_cpu_include_options(),
+            self.param_array,
+        )
+
+        # skip Pair._attach, which constructs the C++ object from _md
+        super(Pair, self)._attach()
@@ -0,0 +1,159 @@
+import hoomd
+from hoomd.error import DataAccessError
+import numpy as np
+import pytest
+
+
+def test_rdf_coordination(simulation_factory, lattice_snapshot_factory):
+    snap = lattice_snapshot_factory(n=8, a=1.0)
+    sim = simulation_factory(snap)
+    rdf = hoomd.md.analyze.RDF(trigger=hoomd.trigger.Periodic(1),
+                               nlist=hoomd.md.nlist.Cell(buffer=0.2),
+                               r_max=1.6,
+                               bins=32)
+    with pytest.raises(DataAccessError):
+        rdf.rdf
+    sim.operations.writers.append(rdf)
+    sim.run(3)
+
+    assert rdf.num_frames == 3
+    r = rdf.bin_centers
+    g = rdf.rdf
+    assert g.shape == (32,)
+    dr = 1.6 / 32
+    shell_volume = 4 / 3 * np.pi * ((r + dr / 2)**3 - (r - dr / 2)**3)
+
+    # each particle on the simple cubic lattice has 6 neighbors at r = 1
+    np.testing.assert_allclose(g[r < 0.9], 0)
+    np.testing.assert_allclose(np.sum((g * shell_volume)[r < 1.2]),
+                               6,
+                               rtol=1e-4)
+
+    rdf.reset()
+    assert rdf.num_frames == 0
+
+
+def test_msd_static(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory(n=4, a=1.5))
+    msd = hoomd.md.analyze.MSD(trigger=hoomd.trigger.Periodic(1),
+                               filter=hoomd.filter.All())
+    sim.operations.writers.append(msd)
+    sim.run(4)
+
+    assert len(msd.timesteps) == len(msd.msd)
+    assert len(msd.msd) > 0
+    np.testing.assert_allclose(msd.msd, 0, atol=1e-6)
+
+
+def test_msd_nve(simulation_factory, lattice_snapshot_factory):
+    snap = lattice_snapshot_factory(n=4, a=1.5)
+    if snap.communicator.rank == 0:
+        snap.particles.velocity[:] = [1, 0, 0]
+    sim = simulation_factory(snap)
+
+    integrator = hoomd.md.Integrator(dt=0.005)
+    integrator.methods.append(hoomd.md.methods.NVE(hoomd.filter.All()))
+    sim.operations.integrator = integrator
+    msd = hoomd.md.analyze.MSD(trigger=hoomd.trigger.Periodic(10),
+                               filter=hoomd.filter.All())
+    sim.operations.writers.append(msd)
+    sim.run(101)
+
+    # free particles moving ballistically across the periodic boundaries
+    t = (msd.timesteps - msd.timesteps[0]) * 0.005
+    np.testing.assert_allclose(msd.msd, t**2, rtol=1e-4, atol=1e-6)
+
+
+def test_structure_factor(simulation_factory, lattice_snapshot_factory):
+    snap = lattice_snapshot_factory(n=8, a=1.0, r=0.1)
+    sim = simulation_factory(snap)
+    sq = hoomd.md.analyze.StructureFactor(trigger=hoomd.trigger.Periodic(1),
+                                          filter=hoomd.filter.All(),
+                                          num_cells=(16, 16, 16),
+                                          k_max=8.0,
+                                          bins=16)
+    sim.operations.writers.append(sq)
+    sim.run(2)
+
+    assert sq.num_frames == 2
+    assert sq.bin_centers.shape == (16,)
+    S = sq.S
+    assert S.shape == (16,)
+    assert np.all(np.isfinite(S))
+    assert np.all(S >= 0)
+
+    # the Bragg peak of the lattice at |k| = 2 pi
+    peak_bin = int(2 * np.pi / (8.0 / 16))
+    assert S[peak_bin] > np.max(S[1:peak_bin])
+
+
+def test_health_monitor(simulation_factory, lattice_snapshot_factory):
+    snap = lattice_snapshot_factory(n=6, a=1.5, r=0.1)
+    sim = simulation_factory(snap)
+
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(dt=0.001, forces=[lj])
+    integrator.methods.append(hoomd.md.methods.NVE(hoomd.filter.All()))
+    sim.operations.integrator = integrator
+    thermo = hoomd.md.compute.ThermodynamicQuantities(hoomd.filter.All())
+    sim.operations.computes.append(thermo)
+
+    monitor = hoomd.md.analyze.HealthMonitor(
+        trigger=hoomd.trigger.Periodic(10),
+        nlist=nlist,
+        thermo=thermo,
+        buffer_increase=0.1)
+    with pytest.raises(DataAccessError):
+        monitor.tps
+
+    logger = hoomd.logging.Logger(categories=['scalar'])
+    logger.add(monitor)
+    assert ('md', 'analyze', 'HealthMonitor', 'energy_drift') in logger
+
+    sim.operations.writers.append(monitor)
+    sim.run(100)
+
+    assert monitor.tps > 0
+    assert monitor.memory_usage > 0
+    assert monitor.dangerous_builds >= 0
+    if monitor.dangerous_builds > 0:
+        assert nlist.buffer > 0.4
+    # NVE conserves the energy with a small time step
+    assert abs(monitor.energy_drift) < 1e-2
+
+    monitor.reset()
+    assert monitor.dangerous_builds == 0
+    assert monitor.energy_drift == 0
+
+
+def test_health_monitor_energy_flag(simulation_factory,
+                                    lattice_snapshot_factory):
+    # the drift must be computed from the current potential energy also when
+    # the simulation computes it only on demand
+    snap = lattice_snapshot_factory(n=6, a=1.2, r=0.1)
+    energy_drift = {}
+    for always_compute_energy in (True, False):
+        sim = simulation_factory(snap)
+        sim.always_compute_energy = always_compute_energy
+
+        lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(buffer=0.4),
+                              default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        integrator = hoomd.md.Integrator(dt=0.005, forces=[lj])
+        integrator.methods.append(hoomd.md.methods.NVE(hoomd.filter.All()))
+        sim.operations.integrator = integrator
+        thermo = hoomd.md.compute.ThermodynamicQuantities(hoomd.filter.All())
+        sim.operations.computes.append(thermo)
+
+        monitor = hoomd.md.analyze.HealthMonitor(
+            trigger=hoomd.trigger.Periodic(7), thermo=thermo)
+        sim.operations.writers.append(monitor)
+        sim.run(50)
+        energy_drift[always_compute_energy] = monitor.energy_drift
+
+    np.testing.assert_allclose(energy_drift[False],
+                               energy_drift[True],
+                               rtol=1e-5,
+                               atol=1e-8)
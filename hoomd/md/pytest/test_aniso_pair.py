@@ -243,6 +243,22 @@ def _valid_params(particle_types=['A', 'B']):
         make_aniso_spec(
             md.pair.aniso.GayBerne,
             to_type_parameter_dicts(particle_types, gay_berne_arg_dict)))
+
+    rigid_sites_arg_dict = {
+        'params': ({
+            'epsilon': [0.5, 0.25, 0.1],
+            'sigma': [0.5, 0.45, 0.3],
+            'r_cut_site': [1.0, 0.9, 0.75]
+        }, 2),
+        'shape': ({
+            'positions': [[(-0.25, 0, 0), (0.25, 0, 0)], [(0, 0, 0.1)]]
+        }, 1)
+    }
+
+    valid_params_list.append(
+        make_aniso_spec(
+            md.pair.aniso.RigidSites,
+            to_type_parameter_dicts(particle_types, rigid_sites_arg_dict)))
     return valid_params_list
 
 
@@ -399,6 +415,70 @@ def test_pickling(make_two_particle_simulation, pair_potential_spec):
     pickling_check(pair_potential)
 
 
+def test_rigid_sites_dimer(make_two_particle_simulation):
+    """Compare RigidSites on two dimers to the sum of the site pair forces."""
+    sigma = 0.5
+    epsilon = 1.0
+    r_cut_site = 1.5
+    half_bond = 0.25
+    pot = md.pair.aniso.RigidSites(nlist=md.nlist.Cell(buffer=0.4),
+                                   default_r_cut=r_cut_site + 2 * half_bond)
+    pot.params[('A', 'A')] = dict(epsilon=epsilon,
+                                  sigma=sigma,
+                                  r_cut_site=r_cut_site)
+    pot.shape['A'] = dict(positions=[(-half_bond, 0, 0), (half_bond, 0, 0)])
+    sim = make_two_particle_simulation(types=['A'], d=0.75, force=pot)
+
+    # second dimer rotated by 90 degrees about z
+    q = [math.cos(math.pi / 4), 0, 0, math.sin(math.pi / 4)]
+    snap = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        snap.particles.position[0] = [0, 0, 0.1]
+        snap.particles.position[1] = [0, 0, 0.85]
+        snap.particles.orientation[0] = [1, 0, 0, 0]
+        snap.particles.orientation[1] = q
+    sim.state.set_snapshot(snap)
+    sim.run(0)
+
+    center_i = np.array([0, 0, 0.1])
+    center_j = np.array([0, 0, 0.85])
+    sites_i = [center_i + [-half_bond, 0, 0], center_i + [half_bond, 0, 0]]
+    sites_j = [center_j + [0, -half_bond, 0], center_j + [0, half_bond, 0]]
+    force = np.zeros(3)
+    torque_i = np.zeros(3)
+    torque_j = np.zeros(3)
+    energy = 0
+    for s_a in sites_i:
+        for s_b in sites_j:
+            d = s_a - s_b
+            r = np.linalg.norm(d)
+            energy += 4 * epsilon * ((sigma / r)**12 - (sigma / r)**6)
+            f = 4 * epsilon * (12 * (sigma / r)**12 - 6 *
+                               (sigma / r)**6) / r**2 * d
+            force += f
+            torque_i += np.cross(s_a - center_i, f)
+            torque_j += np.cross(s_b - center_j, -f)
+
+    sim_energies = pot.energies
+    sim_forces = pot.forces
+    sim_torques = pot.torques
+    if sim_energies is not None:
+        np.testing.assert_allclose(np.sum(sim_energies), energy, rtol=1e-5)
+        np.testing.assert_allclose(sim_forces[0], force, rtol=1e-5, atol=1e-6)
+        np.testing.assert_allclose(sim_forces[1],
+                                   -force,
+                                   rtol=1e-5,
+                                   atol=1e-6)
+        np.testing.assert_allclose(sim_torques[0],
+                                   torque_i,
+                                   rtol=1e-5,
+                                   atol=1e-6)
+        np.testing.assert_allclose(sim_torques[1],
+                                   torque_j,
+                                   rtol=1e-5,
+                                   atol=1e-6)
+
+
 def test_logging():
     logging_check(
         hoomd.md.pair.aniso.GayBerne, ('md', 'pair', 'aniso'),
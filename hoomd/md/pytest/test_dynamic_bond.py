@@ -0,0 +1,149 @@
+import hoomd
+import numpy as np
+import pytest
+
+
+@pytest.fixture(scope='session')
+def chain_snapshot_factory(device):
+
+    def make_snapshot(N=4, spacing=1.0, L=20):
+        s = hoomd.Snapshot(device.communicator)
+        if s.communicator.rank == 0:
+            s.configuration.box = [L, L, L, 0, 0, 0]
+            s.particles.N = N
+            s.particles.types = ['A']
+            s.particles.position[:] = [
+                (spacing * i - N / 2, 0, 0) for i in range(N)
+            ]
+            s.bonds.N = 0
+            s.bonds.types = ['dynamic', 'static']
+        return s
+
+    return make_snapshot
+
+
+def _bonded_pairs(sim, bond_type='dynamic'):
+    snap = sim.state.get_snapshot()
+    if snap.communicator.rank != 0:
+        return None
+    type_id = snap.bonds.types.index(bond_type)
+    return sorted(
+        tuple(sorted(group))
+        for group, typeid in zip(snap.bonds.group, snap.bonds.typeid)
+        if typeid == type_id)
+
+
+def _make_simulation(simulation_factory, snap, updater):
+    sim = simulation_factory(snap)
+    if sim.device.communicator.num_ranks > 1:
+        pytest.skip("DynamicBond does not support domain decomposition")
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005)
+    sim.operations.updaters.append(updater)
+    return sim
+
+
+def test_attributes(simulation_factory, chain_snapshot_factory):
+    nl = hoomd.md.nlist.Cell(buffer=0.4)
+    updater = hoomd.md.update.DynamicBond(trigger=hoomd.trigger.Periodic(1),
+                                          nlist=nl,
+                                          bond_type='dynamic',
+                                          r_form=1.1)
+    assert updater.nlist is nl
+    assert updater.r_form == 1.1
+    assert updater.p_form == 1.0
+    assert updater.r_break == 0.0
+    assert updater.p_break == 0.0
+    assert updater.max_bonds == 1
+
+    sim = _make_simulation(simulation_factory, chain_snapshot_factory(),
+                           updater)
+    sim.run(0)
+
+    updater.r_form = 1.2
+    updater.p_break = 0.5
+    updater.max_bonds = 3
+    assert updater.r_form == pytest.approx(1.2)
+    assert updater.p_break == 0.5
+    assert updater.max_bonds == 3
+
+
+def test_form_all(simulation_factory, chain_snapshot_factory):
+    nl = hoomd.md.nlist.Cell(buffer=0.4)
+    updater = hoomd.md.update.DynamicBond(trigger=hoomd.trigger.Periodic(1),
+                                          nlist=nl,
+                                          bond_type='dynamic',
+                                          r_form=1.1,
+                                          max_bonds=2)
+    sim = _make_simulation(simulation_factory, chain_snapshot_factory(),
+                           updater)
+    sim.run(1)
+
+    assert updater.num_formed == 3
+    pairs = _bonded_pairs(sim)
+    if pairs is not None:
+        assert pairs == [(0, 1), (1, 2), (2, 3)]
+
+    # existing bonds are not formed again
+    sim.run(1)
+    assert updater.num_formed == 0
+
+
+def test_max_bonds(simulation_factory, chain_snapshot_factory):
+    nl = hoomd.md.nlist.Cell(buffer=0.4)
+    updater = hoomd.md.update.DynamicBond(trigger=hoomd.trigger.Periodic(1),
+                                          nlist=nl,
+                                          bond_type='dynamic',
+                                          r_form=1.1,
+                                          max_bonds=1)
+    sim = _make_simulation(simulation_factory, chain_snapshot_factory(N=8),
+                           updater)
+    sim.run(10)
+
+    pairs = _bonded_pairs(sim)
+    if pairs is not None:
+        counts = np.bincount(np.array(pairs).flatten(), minlength=8)
+        assert np.all(counts <= 1)
+        assert len(pairs) >= 3
+
+
+def test_skip_bonded_pairs(simulation_factory, chain_snapshot_factory):
+    snap = chain_snapshot_factory(N=2)
+    if snap.communicator.rank == 0:
+        snap.bonds.N = 1
+        snap.bonds.typeid[0] = 1
+        snap.bonds.group[0] = [0, 1]
+
+    nl = hoomd.md.nlist.Cell(buffer=0.4)
+    updater = hoomd.md.update.DynamicBond(trigger=hoomd.trigger.Periodic(1),
+                                          nlist=nl,
+                                          bond_type='dynamic',
+                                          r_form=1.1)
+    sim = _make_simulation(simulation_factory, snap, updater)
+    sim.run(1)
+
+    assert updater.num_formed == 0
+
+
+def test_break(simulation_factory, chain_snapshot_factory):
+    snap = chain_snapshot_factory(N=4, spacing=2.0)
+    if snap.communicator.rank == 0:
+        snap.bonds.N = 3
+        snap.bonds.typeid[:] = [0, 0, 1]
+        snap.bonds.group[:] = [[0, 1], [0, 3], [2, 3]]
+
+    nl = hoomd.md.nlist.Cell(buffer=0.4)
+    updater = hoomd.md.update.DynamicBond(trigger=hoomd.trigger.Periodic(1),
+                                          nlist=nl,
+                                          bond_type='dynamic',
+                                          r_form=0.0,
+                                          r_break=3.0,
+                                          p_break=1.0)
+    sim = _make_simulation(simulation_factory, snap, updater)
+    sim.run(1)
+
+    assert updater.num_broken == 1
+    assert updater.num_formed == 0
+    pairs = _bonded_pairs(sim)
+    if pairs is not None:
+        assert pairs == [(0, 1)]
+        assert _bonded_pairs(sim, 'static') == [(2, 3)]
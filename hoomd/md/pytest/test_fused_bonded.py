@@ -0,0 +1,141 @@
+import hoomd
+import numpy as np
+import pytest
+
+
+@pytest.fixture(scope='session')
+def helix_snapshot_factory(device):
+
+    def make_snapshot(N=8, L=20):
+        s = hoomd.Snapshot(device.communicator)
+        if s.communicator.rank == 0:
+            s.configuration.box = [L, L, L, 0, 0, 0]
+            s.particles.N = N
+            s.particles.types = ['A']
+            i = np.arange(N)
+            # a helix gives each angle and dihedral a different value
+            s.particles.position[:] = np.stack(
+                [np.cos(1.1 * i), np.sin(1.1 * i), 0.45 * i - 0.2 * N + 0.1],
+                axis=1)
+
+            s.bonds.N = N - 1
+            s.bonds.types = ['backbone']
+            s.bonds.group[:] = [(j, j + 1) for j in range(N - 1)]
+            s.angles.N = N - 2
+            s.angles.types = ['backbone']
+            s.angles.group[:] = [(j, j + 1, j + 2) for j in range(N - 2)]
+            s.dihedrals.N = N - 3
+            s.dihedrals.types = ['backbone']
+            s.dihedrals.group[:] = [
+                (j, j + 1, j + 2, j + 3) for j in range(N - 3)
+            ]
+        return s
+
+    return make_snapshot
+
+
+def _make_components(dihedral_cls):
+    bond = hoomd.md.bond.Harmonic()
+    bond.params['backbone'] = dict(k=300.0, r0=1.1)
+    angle = hoomd.md.angle.Harmonic()
+    angle.params['backbone'] = dict(k=20.0, t0=2.0)
+    dihedral = dihedral_cls()
+    if dihedral_cls is hoomd.md.dihedral.Harmonic:
+        dihedral.params['backbone'] = dict(k=5.0, d=1, n=3, phi0=0.3)
+    else:
+        dihedral.params['backbone'] = dict(k1=1.0, k2=0.5, k3=2.0, k4=0.25)
+    return bond, angle, dihedral
+
+
+@pytest.mark.parametrize(
+    "dihedral_cls", [hoomd.md.dihedral.Harmonic, hoomd.md.dihedral.OPLS])
+def test_fused_matches_components(simulation_factory, helix_snapshot_factory,
+                                  dihedral_cls):
+    snap = helix_snapshot_factory()
+
+    sim = simulation_factory(snap)
+    components = _make_components(dihedral_cls)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                    forces=list(components))
+    sim.run(0)
+    energies = [force.energies for force in components]
+    forces = [force.forces for force in components]
+
+    fused_sim = simulation_factory(snap)
+    bond, angle, dihedral = _make_components(dihedral_cls)
+    fused = hoomd.md.force.FusedBonded(bond=bond,
+                                       angle=angle,
+                                       dihedral=dihedral)
+    assert fused.bond is bond
+    fused_sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                          forces=[fused])
+    fused_sim.run(0)
+    fused_energies = fused.energies
+    fused_forces = fused.forces
+
+    if sim.device.communicator.rank == 0:
+        np.testing.assert_allclose(fused_energies,
+                                   sum(energies),
+                                   rtol=1e-4,
+                                   atol=1e-5)
+        np.testing.assert_allclose(fused_forces,
+                                   sum(forces),
+                                   rtol=1e-4,
+                                   atol=1e-5)
+
+    # parameters set on the components apply to the fused force on the next
+    # step (the integrators have no methods, so the particles do not move)
+    angle.params['backbone'] = dict(k=0.0, t0=2.0)
+    components[1].params['backbone'] = dict(k=0.0, t0=2.0)
+    sim.run(1)
+    fused_sim.run(1)
+    energy = sum(force.energy for force in components)
+    assert fused.energy == pytest.approx(energy, rel=1e-4)
+
+
+def test_fused_partial(simulation_factory, helix_snapshot_factory):
+    sim = simulation_factory(helix_snapshot_factory())
+    angle = hoomd.md.angle.Harmonic()
+    angle.params['backbone'] = dict(k=20.0, t0=2.0)
+    fused = hoomd.md.force.FusedBonded(angle=angle)
+    assert fused.bond is None
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005, forces=[fused])
+    sim.run(0)
+    assert fused.energy == pytest.approx(angle.energy, rel=1e-4)
+
+
+def test_fused_invalid_component():
+    with pytest.raises(TypeError):
+        hoomd.md.force.FusedBonded(bond=hoomd.md.angle.Harmonic())
+
+
+def test_fused_per_group(simulation_factory, helix_snapshot_factory):
+    snap = helix_snapshot_factory()
+
+    sim = simulation_factory(snap)
+    fused = hoomd.md.force.FusedBonded(
+        *_make_components(hoomd.md.dihedral.OPLS))
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005, forces=[fused])
+    sim.run(0)
+    energies = fused.energies
+    forces = fused.forces
+
+    group_sim = simulation_factory(snap)
+    group_fused = hoomd.md.force.FusedBonded(
+        *_make_components(hoomd.md.dihedral.OPLS), per_group=True)
+    assert group_fused.per_group
+    group_sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                          forces=[group_fused])
+    group_sim.run(0)
+    group_energies = group_fused.energies
+    group_forces = group_fused.forces
+
+    if sim.device.communicator.rank == 0:
+        np.testing.assert_allclose(group_energies,
+                                   energies,
+                                   rtol=1e-4,
+                                   atol=1e-5)
+        np.testing.assert_allclose(group_forces,
+                                   forces,
+                                   rtol=1e-4,
+                                   atol=1e-5)
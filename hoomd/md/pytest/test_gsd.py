@@ -115,6 +115,64 @@ def test_write_gsd_trigger(create_md_sim, tmp_path):
             assert [frame.configuration.step for frame in traj] == [5, 15, 25]
 
 
+def test_write_gsd_async(create_md_sim, tmp_path):
+
+    filename = tmp_path / "temporary_test_file.gsd"
+
+    sim = create_md_sim
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(1),
+                                 mode='wb',
+                                 dynamic=['momentum'],
+                                 async_write=True)
+    sim.operations.writers.append(gsd_writer)
+    assert gsd_writer.async_write
+
+    snapshot_list = []
+    for _ in range(5):
+        sim.run(1)
+        snap = sim.state.get_snapshot()
+        if snap.communicator.rank == 0:
+            snapshot_list.append(snap)
+
+    gsd_writer.flush()
+
+    if sim.device.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='rb') as traj:
+            assert len(traj) == 5
+            for gsd_snap, hoomd_snap in zip(traj, snapshot_list):
+                assert_equivalent_snapshots(gsd_snap, hoomd_snap)
+
+
+def test_write_gsd_distributed(create_md_sim, simulation_factory, tmp_path):
+
+    sim = create_md_sim
+
+    # all ranks write their shards next to the file on the root rank
+    filename = hoomd._hoomd.mpi_bcast_str(
+        str(tmp_path / "temporary_test_file.gsd"), sim.device._cpp_exec_conf)
+
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(1),
+                                 mode='wb',
+                                 distributed=True)
+    sim.operations.writers.append(gsd_writer)
+    assert gsd_writer.distributed
+
+    snapshot_list = []
+    for _ in range(3):
+        sim.run(1)
+        snapshot_list.append(sim.state.get_snapshot())
+
+    for frame, snap in enumerate(snapshot_list):
+        new_sim = simulation_factory()
+        new_sim.create_state_from_gsd(filename, frame=frame)
+        assert_equivalent_snapshots(snap, new_sim.state.get_snapshot())
+
+    with pytest.raises(RuntimeError):
+        gsd_writer.distributed = False
+
+
 def test_write_gsd_mode(create_md_sim, hoomd_snapshot, tmp_path,
                         simulation_factory):
 
@@ -390,3 +448,43 @@ def test_write_gsd_log(create_md_sim, tmp_path):
                 e = traj[s].log[
                     'md/compute/ThermodynamicQuantities/kinetic_energy']
                 assert e == kinetic_energy_list[s]
+
+
+def test_write_gsd_position_precision(device, simulation_factory, tmp_path):
+
+    filename = tmp_path / "temporary_test_file.gsd"
+
+    # 0.3 does not divide L / 2, so rounding the particles on the box faces
+    # would move them outside of the box
+    L = 10
+    position = [[-L / 2, -L / 2, -L / 2], [L / 2 - 1e-4, L / 2 - 1e-4, 0],
+                [1.01, -2.02, 3.03]]
+    snap = hoomd.Snapshot(device.communicator)
+    if snap.communicator.rank == 0:
+        snap.configuration.box = [L, L, L, 0, 0, 0]
+        snap.particles.types = ['A']
+        snap.particles.N = len(position)
+        snap.particles.position[:] = position
+
+    sim = simulation_factory(snap)
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(1),
+                                 mode='wb',
+                                 position_precision=0.3)
+    sim.operations.writers.append(gsd_writer)
+    sim.run(1)
+
+    if sim.device.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='rb') as traj:
+            written = traj[0].particles.position
+            np.testing.assert_allclose(written[2], [0.9, -2.1, 3.0],
+                                       rtol=1e-6)
+            np.testing.assert_allclose(written[:2], position[:2], atol=1e-6)
+            np.testing.assert_array_equal(traj[0].particles.image, 0)
+
+    # the file reads back without particles outside of the box
+    sim_read = simulation_factory()
+    sim_read.create_state_from_gsd(filename=filename)
+    snap_read = sim_read.state.get_snapshot()
+    if snap_read.communicator.rank == 0:
+        assert np.all(np.abs(snap_read.particles.position) <= L / 2)
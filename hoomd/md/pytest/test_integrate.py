@@ -1,3 +1,4 @@
+import numpy
 import pytest
 
 import hoomd
@@ -48,3 +49,255 @@ def test_detaching(make_simulation, methods, forces):
     assert not integrator._forces._synced
     assert not integrator._methods._synced
     assert not integrator._contraints._synced
+
+
+def _thermal_lattice_snapshot(lattice_snapshot_factory):
+    """Make a perturbed lattice with random velocities.
+
+    The particles feel nonzero forces and move, so runs with different
+    integrator options can be compared.
+    """
+    snapshot = lattice_snapshot_factory(n=8, a=1.2, r=0.1)
+    if snapshot.communicator.rank == 0:
+        rng = numpy.random.default_rng(seed=10)
+        N = snapshot.particles.N
+        snapshot.particles.velocity[:] = rng.normal(size=(N, 3))
+    return snapshot
+
+
+def _pair_forces():
+    """Make LJ and Gauss pair forces that share a neighbor list."""
+    nlist = md.nlist.Cell(buffer=0.4)
+    lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+    gauss = md.pair.Gauss(nlist, default_r_cut=3.0)
+    gauss.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+    return [lj, gauss]
+
+
+def _run(simulation_factory, snapshot, integrator, steps):
+    """Run a simulation of the snapshot with the integrator.
+
+    Returns:
+        The net force on and the position of each particle on rank 0 and
+        `None` on the other ranks.
+    """
+    sim = simulation_factory(snapshot)
+    sim.operations.integrator = integrator
+    sim.run(steps)
+
+    forces = [force.forces for force in integrator.forces]
+    snapshot = sim.state.get_snapshot()
+    if snapshot.communicator.rank != 0:
+        return None
+    return sum(forces), snapshot.particles.position
+
+
+def _assert_same_trajectory(simulation_factory, snapshot, integrators, steps):
+    """Assert that the integrators compute the same forces and trajectory."""
+    results = [
+        _run(simulation_factory, snapshot, integrator, steps)
+        for integrator in integrators
+    ]
+
+    if results[0] is not None:
+        forces, position = results[0]
+        # the comparison is meaningful only when the particles feel forces
+        # and move
+        assert numpy.max(numpy.abs(forces)) > 0.1
+        assert not numpy.allclose(position, snapshot.particles.position)
+
+        for other_forces, other_position in results[1:]:
+            numpy.testing.assert_allclose(other_forces,
+                                          forces,
+                                          rtol=1e-5,
+                                          atol=1e-5)
+            numpy.testing.assert_allclose(other_position,
+                                          position,
+                                          rtol=1e-5,
+                                          atol=1e-5)
+
+
+class _GraphIntegrator(md.Integrator):
+    """Integrator that replays the net force summation from a CUDA graph.
+
+    The graph is an internal option of the C++ integrator.
+    """
+
+    def _attach(self):
+        super()._attach()
+        self._cpp_obj.gpu_graph = True
+
+
+def test_gpu_graph(simulation_factory, lattice_snapshot_factory):
+    # run past a particle sort and neighbor list rebuilds, which reallocate
+    # or reorder the force arrays and invalidate the graph
+    integrators = [
+        integrator_class(0.005,
+                         methods=[md.methods.NVE(hoomd.filter.All())],
+                         forces=_pair_forces())
+        for integrator_class in (md.Integrator, _GraphIntegrator)
+    ]
+    _assert_same_trajectory(simulation_factory,
+                            _thermal_lattice_snapshot(lattice_snapshot_factory),
+                            integrators,
+                            steps=250)
+
+    assert not integrators[0]._cpp_obj.gpu_graph
+    integrators[1]._cpp_obj.gpu_graph = False
+    assert not integrators[1]._cpp_obj.gpu_graph
+
+
+def test_overlap_ghost_update(simulation_factory, lattice_snapshot_factory):
+    # with MPI, the particles near the domain boundaries interact with ghosts
+    # and their forces are computed after the ghost update completes
+    integrators = [
+        md.Integrator(0.005,
+                      methods=[md.methods.NVE(hoomd.filter.All())],
+                      forces=_pair_forces(),
+                      overlap_ghost_update=overlap_ghost_update)
+        for overlap_ghost_update in (False, True)
+    ]
+    _assert_same_trajectory(simulation_factory,
+                            _thermal_lattice_snapshot(lattice_snapshot_factory),
+                            integrators,
+                            steps=50)
+
+    for overlap_ghost_update, integrator in zip((False, True), integrators):
+        assert integrator.overlap_ghost_update == overlap_ghost_update
+
+
+def test_concurrent_forces(simulation_factory, lattice_snapshot_factory):
+    integrators = [
+        md.Integrator(0.005,
+                      methods=[md.methods.NVE(hoomd.filter.All())],
+                      forces=_pair_forces(),
+                      concurrent_forces=concurrent_forces)
+        for concurrent_forces in (False, True)
+    ]
+    _assert_same_trajectory(simulation_factory,
+                            _thermal_lattice_snapshot(lattice_snapshot_factory),
+                            integrators,
+                            steps=50)
+
+    for concurrent_forces, integrator in zip((False, True), integrators):
+        assert integrator.concurrent_forces == concurrent_forces
+
+
+def test_respa_schedule(simulation_factory, two_particle_snapshot_factory):
+    """Slow forces apply their impulse on every respa_interval'th step."""
+    snap = two_particle_snapshot_factory(d=2.0)
+    if snap.communicator.rank == 0:
+        snap.particles.charge[:] = 1.0
+    sim = simulation_factory(snap)
+
+    field = md.external.field.Electric()
+    field.E['A'] = (1.0, 0.5, 0.0)
+    field.respa_interval = 3
+    dt = 0.01
+    sim.operations.integrator = md.Integrator(
+        dt, methods=[md.methods.NVE(hoomd.filter.All())], forces=[field])
+
+    steps = 10
+    sim.run(steps)
+
+    # velocity Verlet with the force scaled by respa_interval on the steps
+    # that are a multiple of respa_interval and left out on the others
+    def scale(timestep):
+        return 3.0 if timestep % 3 == 0 else 0.0
+
+    force = numpy.array([1.0, 0.5, 0.0])
+    position = numpy.array([[-1.0, 0, 0.1], [1.0, 0, 0.1]])
+    velocity = numpy.zeros((2, 3))
+    acceleration = scale(0) * force
+    for timestep in range(steps):
+        velocity += 0.5 * dt * acceleration
+        position += dt * velocity
+        acceleration = scale(timestep + 1) * force
+        velocity += 0.5 * dt * acceleration
+
+    snapshot = sim.state.get_snapshot()
+    if snapshot.communicator.rank == 0:
+        numpy.testing.assert_allclose(snapshot.particles.position,
+                                      position,
+                                      rtol=1e-5,
+                                      atol=1e-6)
+        numpy.testing.assert_allclose(snapshot.particles.velocity,
+                                      velocity,
+                                      rtol=1e-5,
+                                      atol=1e-6)
+
+
+def test_respa_interval(simulation_factory, lattice_snapshot_factory):
+    """RESPA conserves energy with a nonzero slow force."""
+    sim = simulation_factory(
+        _thermal_lattice_snapshot(lattice_snapshot_factory))
+    lj, gauss = _pair_forces()
+    assert gauss.respa_interval == 1
+    gauss.respa_interval = 2
+    assert gauss.respa_interval == 2
+
+    integrator = md.Integrator(0.001,
+                               methods=[md.methods.NVE(hoomd.filter.All())],
+                               forces=[lj, gauss])
+    sim.operations.integrator = integrator
+    thermo = md.compute.ThermodynamicQuantities(hoomd.filter.All())
+    sim.operations.computes.append(thermo)
+
+    # the energy of a slow force is up to date on the steps that are a
+    # multiple of its respa_interval
+    sim.run(0)
+    assert abs(gauss.energy) > 1.0
+    energy = thermo.kinetic_energy + thermo.potential_energy
+    sim.run(200)
+    assert gauss.respa_interval == 2
+    assert lj.respa_interval == 1
+
+    new_energy = thermo.kinetic_energy + thermo.potential_energy
+    assert abs(new_energy - energy) / thermo.num_particles < 1e-3
+
+    with pytest.raises(ValueError):
+        gauss.respa_interval = 0
+
+
+def test_adaptive_dt(simulation_factory, lattice_snapshot_factory):
+    snap = lattice_snapshot_factory(n=5, a=1.0)
+    sim = simulation_factory(snap)
+    sim.state.thermalize_particle_momenta(hoomd.filter.All(), kT=1.0)
+    nlist = md.nlist.Cell(buffer=0.4)
+    lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+    integrator = md.Integrator(0.005,
+                               methods=[md.methods.NVE(hoomd.filter.All())],
+                               forces=[lj])
+    assert integrator.max_displacement is None
+    assert integrator.dt_max == 0.005
+
+    integrator.max_displacement = 0.002
+    integrator.dt_min = 1e-5
+    sim.operations.integrator = integrator
+    assert integrator.max_displacement == 0.002
+
+    for step in range(10):
+        dt = integrator.dt
+        assert 1e-5 <= dt <= 0.005
+
+        snapshot = sim.state.get_snapshot()
+        sim.run(1)
+        new_snapshot = sim.state.get_snapshot()
+        if snapshot.communicator.rank == 0:
+            L = snapshot.configuration.box[0]
+            delta = (new_snapshot.particles.position
+                     - snapshot.particles.position)
+            delta -= L * numpy.round(delta / L)
+            assert numpy.max(numpy.linalg.norm(delta, axis=1)) <= 0.002 * 1.001
+
+    with pytest.raises(ValueError):
+        integrator.max_displacement = 0.0
+    with pytest.raises(ValueError):
+        integrator.finc_dt = 0.5
+
+    integrator.max_displacement = None
+    dt = integrator.dt
+    sim.run(5)
+    assert integrator.dt == dt
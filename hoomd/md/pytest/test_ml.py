@@ -0,0 +1,56 @@
+import hoomd
+import numpy as np
+import pytest
+
+torch = pytest.importorskip("torch")
+
+pytestmark = pytest.mark.skipif(not hoomd.version.torch_enabled,
+                                reason="LibTorch support is not enabled")
+
+
+class LJModel(torch.nn.Module):
+    """Lennard-Jones with half of each pair energy on each particle."""
+
+    def forward(self, types, edge_index, edge_vec):
+        r2 = torch.sum(edge_vec * edge_vec, dim=1)
+        inv6 = 1.0 / (r2 * r2 * r2)
+        edge_energy = 2.0 * (inv6 * inv6 - inv6)
+        energies = torch.zeros(types.shape[0],
+                               dtype=edge_vec.dtype,
+                               device=edge_vec.device)
+        return energies.index_add(0, edge_index[0], edge_energy)
+
+
+@pytest.mark.serial
+def test_lj_model(simulation_factory, lattice_snapshot_factory, tmp_path):
+    filename = str(tmp_path / "lj.pt")
+    torch.jit.save(torch.jit.script(LJModel()), filename)
+
+    snap = lattice_snapshot_factory(n=5, a=1.2, r=0.05)
+    energies = []
+    forces = []
+    virials = []
+    for use_model in (False, True):
+        sim = simulation_factory(snap)
+        sim.always_compute_pressure = True
+        integrator = hoomd.md.Integrator(dt=0.005)
+        integrator.methods.append(hoomd.md.methods.NVE(hoomd.filter.All()))
+        nlist = hoomd.md.nlist.Cell(buffer=0.4)
+        if use_model:
+            force = hoomd.md.ml.TorchScript(nlist=nlist,
+                                            filename=filename,
+                                            r_cut=2.5)
+        else:
+            force = hoomd.md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+            force.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        integrator.forces.append(force)
+        sim.operations.integrator = integrator
+        sim.run(0)
+
+        energies.append(force.energies)
+        forces.append(force.forces)
+        virials.append(force.virials)
+
+    np.testing.assert_allclose(energies[1], energies[0], rtol=1e-4, atol=1e-5)
+    np.testing.assert_allclose(forces[1], forces[0], rtol=1e-4, atol=1e-4)
+    np.testing.assert_allclose(virials[1], virials[0], rtol=1e-4, atol=1e-4)
@@ -4,7 +4,7 @@ from hoomd.logging import LoggerCategories
 import numpy as np
 import pytest
 import random
-from hoomd.md.nlist import Cell, Stencil, Tree
+from hoomd.md.nlist import Cell, Cluster, Stencil, Tree
 from hoomd.conftest import logging_check
 
 
@@ -39,7 +39,8 @@ def test_common_params(nlist_params):
         "rebuild_check_delay": 1,
         "diameter_shift": False,
         "check_dist": True,
-        "max_diameter": 1.0
+        "max_diameter": 1.0,
+        "compress": False
     }
     _assert_nlist_params(nlist, default_params_dict)
     new_params_dict = {
@@ -57,7 +58,9 @@ def test_common_params(nlist_params):
         "check_dist":
             False,
         "max_diameter":
-            np.random.uniform(10.3)
+            np.random.uniform(10.3),
+        "compress":
+            True
     }
     for param in new_params_dict.keys():
         setattr(nlist, param, new_params_dict[param])
@@ -66,20 +69,283 @@ def test_common_params(nlist_params):
 
 def test_cell_specific_params():
     nlist = Cell(buffer=0.4)
-    _assert_nlist_params(nlist, dict(deterministic=False))
+    _assert_nlist_params(
+        nlist, dict(deterministic=False, incremental=False, count_first=False))
     nlist.deterministic = True
-    _assert_nlist_params(nlist, dict(deterministic=True))
+    nlist.incremental = True
+    nlist.count_first = True
+    _assert_nlist_params(
+        nlist, dict(deterministic=True, incremental=True, count_first=True))
 
 
 def test_stencil_specific_params():
     cell_width = np.random.uniform(12.1)
     nlist = Stencil(cell_width=cell_width, buffer=0.4)
-    _assert_nlist_params(nlist, dict(deterministic=False,
-                                     cell_width=cell_width))
+    _assert_nlist_params(
+        nlist, dict(deterministic=False, cell_width=cell_width,
+                    type_classes=[]))
     nlist.deterministic = True
     x = np.random.uniform(25.5)
     nlist.cell_width = x
-    _assert_nlist_params(nlist, dict(deterministic=True, cell_width=x))
+    nlist.type_classes = [['A'], ['B', 'C']]
+    _assert_nlist_params(
+        nlist,
+        dict(deterministic=True,
+             cell_width=x,
+             type_classes=[['A'], ['B', 'C']]))
+
+
+def test_tree_specific_params():
+    nlist = Tree(buffer=0.4)
+    _assert_nlist_params(nlist, dict(refit_threshold=0.0))
+    nlist.refit_threshold = 2.0
+    _assert_nlist_params(nlist, dict(refit_threshold=2.0))
+
+
+def test_cluster_specific_params():
+    nlist = Cluster(buffer=0.4)
+    _assert_nlist_params(nlist, dict(deterministic=False, cluster_size=8))
+    nlist.cluster_size = 4
+    _assert_nlist_params(nlist, dict(cluster_size=4))
+    with pytest.raises(ValueError):
+        nlist.cluster_size = 6
+
+
+@pytest.mark.gpu
+@pytest.mark.parametrize("cluster_size", [4, 8])
+def test_cluster_forces(cluster_size, simulation_factory,
+                        lattice_snapshot_factory):
+    """Cluster pair lists compute the same forces as per-particle lists."""
+    snap = lattice_snapshot_factory(n=10, a=1.1, r=0.1)
+    if snap.communicator.rank == 0:
+        snap.bonds.N = 1
+        snap.bonds.types = ['A-A']
+        snap.bonds.group[0] = [0, 1]
+
+    forces = []
+    for nlist in (Cell(buffer=0.4), Cluster(buffer=0.4,
+                                            cluster_size=cluster_size)):
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        integrator = hoomd.md.Integrator(0.005, forces=[lj])
+
+        sim = simulation_factory(snap)
+        sim.operations.integrator = integrator
+        sim.run(0)
+        forces.append(lj.forces)
+
+    if forces[0] is not None:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-5, atol=1e-5)
+
+
+def test_compress_forces(nlist_params, simulation_factory,
+                         lattice_snapshot_factory):
+    """Compressed neighbor lists compute the same forces."""
+    nlist_cls, required_args = nlist_params
+    snap = lattice_snapshot_factory(n=10, a=1.1, r=0.1)
+    if snap.communicator.rank == 0:
+        snap.bonds.N = 1
+        snap.bonds.types = ['A-A']
+        snap.bonds.group[0] = [0, 1]
+
+    forces = []
+    for compress in (False, True):
+        nlist = nlist_cls(**required_args, buffer=0.4, compress=compress)
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        integrator = hoomd.md.Integrator(0.005, forces=[lj])
+
+        sim = simulation_factory(snap)
+        sim.operations.integrator = integrator
+        sim.run(0)
+        forces.append(lj.forces)
+
+    if forces[0] is not None:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-5, atol=1e-5)
+
+
+def test_incremental(simulation_factory, lattice_snapshot_factory):
+    """Incremental updates follow the same trajectory as full rebuilds."""
+    snap = lattice_snapshot_factory(n=10, a=1.1, r=0.1)
+
+    positions = []
+    for incremental in (False, True):
+        nlist = Cell(buffer=0.4, incremental=incremental)
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        # only a small region of the system moves
+        integrator = hoomd.md.Integrator(0.005, forces=[lj])
+        integrator.methods.append(
+            hoomd.md.methods.Langevin(hoomd.filter.Tags(list(range(100))),
+                                      kT=1.5))
+
+        sim = simulation_factory(snap)
+        sim.operations.integrator = integrator
+        sim.run(100)
+        snapshot = sim.state.get_snapshot()
+        if snapshot.communicator.rank == 0:
+            positions.append(snapshot.particles.position)
+
+    if len(positions) > 0:
+        np.testing.assert_allclose(positions[0],
+                                   positions[1],
+                                   rtol=1e-5,
+                                   atol=1e-5)
+
+
+def test_count_first(simulation_factory, lattice_snapshot_factory):
+    """Counting the neighbors first gives the same forces."""
+    snap = lattice_snapshot_factory(n=8, a=0.9, r=0.1)
+
+    forces = []
+    for count_first in (False, True):
+        nlist = Cell(buffer=0.4, count_first=count_first)
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        integrator = hoomd.md.Integrator(0.005, forces=[lj])
+
+        sim = simulation_factory(snap)
+        sim.operations.integrator = integrator
+        sim.run(0)
+        forces.append(lj.forces)
+
+    if forces[0] is not None:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-5, atol=1e-5)
+
+
+def test_type_classes(simulation_factory, lattice_snapshot_factory):
+    """Binning each size class separately gives the same forces."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                    n=8,
+                                    a=1.1,
+                                    r=0.1)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[::4] = 1
+
+    forces = []
+    for type_classes in ([], [['A'], ['B']]):
+        nlist = Stencil(cell_width=1.0,
+                        buffer=0.4,
+                        type_classes=type_classes)
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=1.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=0.5)
+        lj.params[('A', 'B')] = dict(epsilon=1, sigma=1.0)
+        lj.params[('B', 'B')] = dict(epsilon=1, sigma=1.0)
+        lj.r_cut[('A', 'A')] = 1.2
+        lj.r_cut[('B', 'B')] = 3.5
+        integrator = hoomd.md.Integrator(0.005, forces=[lj])
+
+        sim = simulation_factory(snap)
+        sim.operations.integrator = integrator
+        sim.run(0)
+        forces.append(lj.forces)
+
+    if forces[0] is not None:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-5, atol=1e-5)
+
+    with pytest.raises(ValueError):
+        nlist.type_classes = [['A']]
+
+
+def test_non_interacting_types(simulation_factory, lattice_snapshot_factory):
+    """Skipping non-interacting types in cells gives the same forces."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B', 'C'],
+                                    n=8,
+                                    a=1.1,
+                                    r=0.1)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[::3] = 1
+        snap.particles.typeid[1::3] = 2
+
+    forces = []
+    for nlist in (Cell(buffer=0.4), Tree(buffer=0.4)):
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+        lj.params[(['A', 'B', 'C'], ['A', 'B', 'C'])] = dict(epsilon=1,
+                                                             sigma=1)
+        lj.r_cut[('A', 'B')] = 0
+        lj.r_cut[(['A', 'B', 'C'], 'C')] = 0
+        integrator = hoomd.md.Integrator(0.005, forces=[lj])
+
+        sim = simulation_factory(snap)
+        sim.operations.integrator = integrator
+        sim.run(0)
+        forces.append(lj.forces)
+
+    if forces[0] is not None:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-5, atol=1e-5)
+        np.testing.assert_array_equal(forces[0][1::3], 0)
+
+
+@pytest.mark.gpu
+def test_tree_refit(simulation_factory, lattice_snapshot_factory):
+    """Refitting the trees follows the same trajectory as rebuilding them."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                    n=10,
+                                    a=1.1,
+                                    r=0.1)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[::3] = 1
+        snap.particles.velocity[:] = np.random.default_rng(1).uniform(
+            -1, 1, (snap.particles.N, 3))
+
+    positions = []
+    for refit_threshold in (0.0, 2.0):
+        nlist = Tree(buffer=0.4, refit_threshold=refit_threshold)
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        lj.params[('A', 'B')] = dict(epsilon=1, sigma=1)
+        lj.params[('B', 'B')] = dict(epsilon=1, sigma=1)
+        integrator = hoomd.md.Integrator(0.005, forces=[lj])
+        integrator.methods.append(hoomd.md.methods.NVE(hoomd.filter.All()))
+
+        sim = simulation_factory(snap)
+        sim.operations.integrator = integrator
+        sim.run(100)
+        snapshot = sim.state.get_snapshot()
+        if snapshot.communicator.rank == 0:
+            positions.append(snapshot.particles.position)
+
+    if len(positions) > 0:
+        np.testing.assert_allclose(positions[0],
+                                   positions[1],
+                                   rtol=1e-5,
+                                   atol=1e-5)
+
+
+def test_incremental_forces(simulation_factory, lattice_snapshot_factory):
+    """Partial rebuilds find the same forces as a full neighbor list."""
+    snap = lattice_snapshot_factory(n=10, a=1.1, r=0.1)
+
+    # evaluate the same potential with an incremental and a reference list, a
+    # small buffer and a hot mobile region cause many partial rebuilds
+    incremental = Cell(buffer=0.2, incremental=True)
+    lj = hoomd.md.pair.LJ(incremental, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    lj_reference = hoomd.md.pair.LJ(Tree(buffer=0.2), default_r_cut=2.5)
+    lj_reference.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(0.005, forces=[lj, lj_reference])
+    integrator.methods.append(
+        hoomd.md.methods.Langevin(hoomd.filter.Tags(list(range(100))),
+                                  kT=2.0))
+
+    sim = simulation_factory(snap)
+    sim.operations.integrator = integrator
+    sim.run(0)
+
+    # the build statistics are reset at the start of each run
+    n_builds = 0
+    for step in range(500):
+        sim.run(1)
+        n_builds += incremental._cpp_obj.getNumUpdates()
+        forces = lj.forces
+        forces_reference = lj_reference.forces
+        if forces is not None:
+            np.testing.assert_allclose(forces,
+                                       forces_reference,
+                                       rtol=1e-4,
+                                       atol=1e-4)
+
+    assert n_builds > 10
 
 
 def test_simple_simulation(nlist_params, simulation_factory,
@@ -99,6 +365,92 @@ def test_simple_simulation(nlist_params, simulation_factory,
     sim.operations.integrator = integrator
     sim.run(2)
 
+    assert nlist.execution_time > 0
+    assert lj.execution_time > 0
+    assert integrator.execution_time > 0
+
+    logger = hoomd.logging.Logger(categories=['scalar'])
+    logger.add(lj, quantities=['execution_time'])
+    logger_namespace = logger.log()['md']['pair']['LJ']
+    assert logger_namespace['execution_time'][0] == lj.execution_time
+
+
+def test_local_nlist_arrays(nlist_params, simulation_factory,
+                            two_particle_snapshot_factory):
+    nlist_cls, required_args = nlist_params
+    nlist = nlist_cls(**required_args, buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=1.1)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    lj.params[('A', 'B')] = dict(epsilon=1, sigma=1)
+    lj.params[('B', 'B')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(0.005, forces=[lj])
+
+    sim = simulation_factory(two_particle_snapshot_factory(d=1.0))
+    sim.operations.integrator = integrator
+
+    with pytest.raises(hoomd.error.DataAccessError):
+        nlist.cpu_local_nlist_arrays
+
+    sim.run(0)
+    N = sim.state._cpp_sys_def.getParticleData().getN()
+    with nlist.cpu_local_nlist_arrays as arrays:
+        assert arrays.head_list.shape == (N,)
+        assert arrays.n_neigh.shape == (N,)
+        n_neigh = np.array(arrays.n_neigh)
+        head_list = np.array(arrays.head_list)
+        nlist_data = np.array(arrays.nlist)
+        half_nlist = arrays.half_nlist
+
+    # the arrays are not accessible outside of the context manager
+    with pytest.raises(RuntimeError):
+        arrays.n_neigh[0]
+
+    if sim.device.communicator.num_ranks == 1:
+        assert np.sum(n_neigh) == (1 if half_nlist else 2)
+        for i in range(N):
+            neighbors = nlist_data[head_list[i]:head_list[i] + n_neigh[i]]
+            assert all(j != i and j < N for j in neighbors)
+
+    if isinstance(nlist, Cell):
+        with nlist.cpu_local_cell_list_arrays as arrays:
+            cell_size = np.array(arrays.cell_size)
+            index = np.array(arrays.index)
+            assert arrays.position.shape == index.shape + (3,)
+        assert index.shape[:3] == cell_size.shape
+        assert np.sum(cell_size) >= N
+
+
+def test_local_force_arrays(simulation_factory, two_particle_snapshot_factory):
+    nlist = Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    lj.params[('A', 'B')] = dict(epsilon=1, sigma=1)
+    lj.params[('B', 'B')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(0.005, forces=[lj])
+
+    sim = simulation_factory(two_particle_snapshot_factory(d=1.2))
+    sim.operations.integrator = integrator
+
+    with pytest.raises(hoomd.error.DataAccessError):
+        lj.cpu_local_force_arrays
+
+    sim.run(0)
+    with sim.state.cpu_local_snapshot as data:
+        tags = np.array(data.particles.tag)
+
+    with lj.cpu_local_force_arrays as arrays:
+        assert arrays.force.shape == (len(tags), 3)
+        assert arrays.torque.shape == (len(tags), 3)
+        assert arrays.virial.shape == (len(tags), 6)
+        force = np.array(arrays.force)
+        energy = np.array(arrays.potential_energy)
+
+    forces = lj.forces
+    energies = lj.energies
+    if sim.device.communicator.rank == 0:
+        np.testing.assert_allclose(force, forces[tags], rtol=1e-6)
+        np.testing.assert_allclose(energy, energies[tags], rtol=1e-6)
+
 
 def test_auto_detach_simulation(simulation_factory,
                                 two_particle_snapshot_factory):
@@ -129,5 +481,9 @@ def test_logging():
         'shortest_rebuild': {
             'category': LoggerCategories.scalar,
             'default': True
+        },
+        'execution_time': {
+            'category': LoggerCategories.scalar,
+            'default': False
         }
     })
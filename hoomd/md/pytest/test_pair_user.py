@@ -0,0 +1,87 @@
+import hoomd
+import numpy as np
+import pytest
+
+pytestmark = pytest.mark.skipif(not hoomd.version.llvm_enabled,
+                                reason="LLVM support is not enabled")
+
+# LJ with epsilon = param_array[0] and sigma = param_array[1]
+lj_code = """
+Scalar sigma_6 = param_array[1] * param_array[1] * param_array[1]
+                 * param_array[1] * param_array[1] * param_array[1];
+Scalar r2inv = Scalar(1.0) / r_sq;
+Scalar r6inv = sigma_6 * r2inv * r2inv * r2inv;
+force_divr = 4 * param_array[0] * r2inv * r6inv * (12 * r6inv - 6);
+return 4 * param_array[0] * r6inv * (r6inv - 1);
+"""
+
+
+def _compute(simulation_factory, snap, force):
+    sim = simulation_factory(snap)
+    sim.always_compute_pressure = True
+    integrator = hoomd.md.Integrator(dt=0.005)
+    integrator.methods.append(hoomd.md.methods.NVE(hoomd.filter.All()))
+    integrator.forces.append(force)
+    sim.operations.integrator = integrator
+    sim.run(0)
+    return force.energies, force.forces, force.virials
+
+
+@pytest.mark.cpu
+@pytest.mark.parametrize("mode", ["none", "shift"])
+def test_lj(simulation_factory, lattice_snapshot_factory, mode):
+    snap = lattice_snapshot_factory(n=5, a=1.2, r=0.05)
+
+    lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(buffer=0.4),
+                          default_r_cut=2.5,
+                          mode=mode)
+    lj.params[('A', 'A')] = dict(epsilon=1.5, sigma=0.9)
+    reference = _compute(simulation_factory, snap, lj)
+
+    user = hoomd.md.pair.user.CPPPotential(
+        nlist=hoomd.md.nlist.Cell(buffer=0.4),
+        code=lj_code,
+        param_array=[1.5, 0.9],
+        default_r_cut=2.5,
+        mode=mode)
+    result = _compute(simulation_factory, snap, user)
+
+    if snap.communicator.rank == 0:
+        for r, ref in zip(result, reference):
+            np.testing.assert_allclose(r, ref, rtol=1e-5, atol=1e-6)
+
+
+@pytest.mark.cpu
+def test_param_array(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory(d=1.0))
+    user = hoomd.md.pair.user.CPPPotential(
+        nlist=hoomd.md.nlist.Cell(buffer=0.4),
+        code="force_divr = 0; return param_array[0] * (type_i + 1);",
+        param_array=[2.0],
+        default_r_cut=1.5)
+    integrator = hoomd.md.Integrator(dt=0.005, forces=[user])
+    sim.operations.integrator = integrator
+    sim.run(0)
+    assert user.energy == pytest.approx(2.0)
+
+    # the array may be modified in place after attaching
+    user.param_array[0] = 3.0
+    sim.run(0)
+    assert user.energy == pytest.approx(3.0)
+
+    with pytest.raises(AttributeError):
+        user.code = "return 0;"
+
+
+@pytest.mark.cpu
+def test_compile_error(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory(d=1.0))
+    user = hoomd.md.pair.user.CPPPotential(
+        nlist=hoomd.md.nlist.Cell(buffer=0.4),
+        code="this is not C++",
+        param_array=[],
+        default_r_cut=1.5)
+    integrator = hoomd.md.Integrator(dt=0.005, forces=[user])
+    sim.operations.integrator = integrator
+    with pytest.raises(RuntimeError):
+        sim.run(0)
@@ -124,6 +124,178 @@ def test_ron(simulation_factory, two_particle_snapshot_factory):
     assert _equivalent_data_structures({('A', 'A'): 1.0}, lj.r_on.to_dict())
 
 
+@pytest.mark.parametrize("pair_cls, params",
+                         [(md.pair.LJ, dict(sigma=1, epsilon=0.5)),
+                          (md.pair.Gauss, dict(sigma=1, epsilon=0.5)),
+                          (md.pair.Yukawa, dict(kappa=1, epsilon=0.5))])
+def test_mixed_precision(simulation_factory, lattice_snapshot_factory,
+                         pair_cls, params):
+    """Mixed precision matches full precision to single precision round off."""
+    snap = lattice_snapshot_factory(n=6, a=1.1, r=0.1)
+
+    forces = []
+    energies = []
+    for mixed_precision in (False, True):
+        pot = pair_cls(nlist=md.nlist.Cell(buffer=0.4),
+                       default_r_cut=2.5,
+                       mode='shift')
+        pot.params[('A', 'A')] = params
+        pot.mixed_precision = mixed_precision
+        integrator = md.Integrator(dt=0.005, forces=[pot])
+        sim = simulation_factory(snap)
+        sim.operations.integrator = integrator
+        sim.run(0)
+        assert pot.mixed_precision == mixed_precision
+        forces.append(pot.forces)
+        energies.append(pot.energy)
+
+    if forces[0] is not None:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-4, atol=1e-4)
+    np.testing.assert_allclose(energies[0], energies[1], rtol=1e-4)
+
+
+@pytest.mark.parametrize("pair_cls, params",
+                         [(md.pair.LJ, dict(sigma=1, epsilon=0.5)),
+                          (md.pair.ForceShiftedLJ, dict(sigma=1, epsilon=0.5)),
+                          (md.pair.Gauss, dict(sigma=1, epsilon=0.5)),
+                          (md.pair.Yukawa, dict(kappa=1, epsilon=0.5))])
+def test_simd_batches(simulation_factory, lattice_snapshot_factory, pair_cls,
+                      params):
+    """Batched evaluation matches the scalar path.
+
+    On the CPU, the shift mode evaluates neighbors in SIMD batches while the
+    xplor mode with r_on > r_cut evaluates them one at a time and computes the
+    same shifted potential.
+    """
+    snap = lattice_snapshot_factory(n=6, a=1.1, r=0.1)
+
+    forces = []
+    energies = []
+    for mode in ('shift', 'xplor'):
+        pot = pair_cls(nlist=md.nlist.Cell(buffer=0.4),
+                       default_r_cut=2.5,
+                       mode=mode)
+        pot.params[('A', 'A')] = params
+        pot.r_on[('A', 'A')] = 3.0
+        integrator = md.Integrator(dt=0.005, forces=[pot])
+        sim = simulation_factory(snap)
+        sim.operations.integrator = integrator
+        sim.run(0)
+        forces.append(pot.forces)
+        energies.append(pot.energy)
+
+    if forces[0] is not None:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-6, atol=1e-6)
+    np.testing.assert_allclose(energies[0], energies[1], rtol=1e-6)
+
+
+@pytest.mark.parametrize("table_cls, width, rtol",
+                         [(md.pair.Table, 2000, 1e-2),
+                          (md.pair.TableSpline, 1000, 1e-3)])
+def test_table_from_pair(simulation_factory, lattice_snapshot_factory,
+                         table_cls, width, rtol):
+    """Tabulated potentials match the potential they tabulate."""
+    snap = lattice_snapshot_factory(n=6, a=1.1, r=0.1)
+
+    lj = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4),
+                    default_r_cut=2.5,
+                    mode='shift')
+    lj.params[('A', 'A')] = dict(sigma=1, epsilon=0.5)
+    table = table_cls.from_pair(lj, r_min=0.5, width=width)
+    assert table.r_cut[('A', 'A')] == 2.5
+    assert len(table.params[('A', 'A')]['V']) == width
+
+    forces = []
+    energies = []
+    for pot in (lj, table):
+        sim = simulation_factory(snap)
+        sim.operations.integrator = md.Integrator(dt=0.005, forces=[pot])
+        sim.run(0)
+        forces.append(pot.forces)
+        energies.append(pot.energy)
+
+    if forces[0] is not None:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=rtol, atol=1e-2)
+    np.testing.assert_allclose(energies[0], energies[1], rtol=rtol)
+
+
+def test_table_from_pair_xplor():
+    lj = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4),
+                    default_r_cut=2.5,
+                    mode='xplor')
+    lj.params[('A', 'A')] = dict(sigma=1, epsilon=0.5)
+    with pytest.raises(ValueError):
+        md.pair.TableSpline.from_pair(lj, r_min=0.5)
+
+
+def test_mixed_precision_unsupported(simulation_factory,
+                                     two_particle_snapshot_factory):
+    morse = md.pair.Morse(nlist=md.nlist.Cell(buffer=0.4), default_r_cut=2.5)
+    morse.params[('A', 'A')] = dict(D0=1, alpha=3, r0=1)
+    morse.mixed_precision = True
+    sim = simulation_factory(two_particle_snapshot_factory(dimensions=3, d=.5))
+    with pytest.raises(ValueError):
+        sim.operations.integrator = md.Integrator(dt=0.005, forces=[morse])
+        sim.run(0)
+
+
+def test_lj_yukawa(simulation_factory, lattice_snapshot_factory):
+    """LJYukawa matches the sum of separate LJ and Yukawa potentials."""
+    snap = lattice_snapshot_factory(n=6, a=1.1, r=0.1)
+    lj_params = dict(epsilon=1.0, sigma=1.0)
+    yukawa_params = dict(epsilon=0.5, kappa=1.5)
+
+    lj_yukawa = md.pair.LJYukawa(nlist=md.nlist.Cell(buffer=0.4),
+                                 default_r_cut=2.5,
+                                 mode='shift')
+    lj_yukawa.params[('A', 'A')] = dict(lj=lj_params, yukawa=yukawa_params)
+    sim = simulation_factory(snap)
+    sim.operations.integrator = md.Integrator(dt=0.005, forces=[lj_yukawa])
+    sim.run(0)
+    composite_forces = lj_yukawa.forces
+    composite_energy = lj_yukawa.energy
+
+    nlist = md.nlist.Cell(buffer=0.4)
+    lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5, mode='shift')
+    lj.params[('A', 'A')] = lj_params
+    yukawa = md.pair.Yukawa(nlist=nlist, default_r_cut=2.5, mode='shift')
+    yukawa.params[('A', 'A')] = yukawa_params
+    sim = simulation_factory(snap)
+    sim.operations.integrator = md.Integrator(dt=0.005, forces=[lj, yukawa])
+    sim.run(0)
+
+    if composite_forces is not None:
+        np.testing.assert_allclose(composite_forces, lj.forces + yukawa.forces)
+    np.testing.assert_allclose(composite_energy, lj.energy + yukawa.energy)
+
+
+def test_type_classes(simulation_factory, lattice_snapshot_factory):
+    """Types with identical parameters give the same forces as a single type."""
+    snap = lattice_snapshot_factory(n=6, a=1.1, r=0.1)
+    types = [chr(ord('A') + i) for i in range(12)]
+
+    def compute(snap, types):
+        lj = md.pair.LJ(nlist=md.nlist.Cell(buffer=0.4),
+                        default_r_cut=2.5,
+                        mode='shift')
+        lj.params[(types, types)] = dict(epsilon=1.0, sigma=1.0)
+        sim = simulation_factory(snap)
+        sim.operations.integrator = md.Integrator(dt=0.005, forces=[lj])
+        sim.run(0)
+        return lj.forces, lj.energy
+
+    forces, energy = compute(snap, ['A'])
+
+    if snap.communicator.rank == 0:
+        snap.particles.types = types
+        snap.particles.typeid[:] = np.arange(snap.particles.N) % len(types)
+    many_type_forces, many_type_energy = compute(snap, types)
+
+    if forces is not None:
+        np.testing.assert_allclose(forces, many_type_forces)
+    np.testing.assert_allclose(energy, many_type_energy)
+
+
 def _make_invalid_param_dict(valid_dict):
     """This could is fragile if multiple types are allowed for a key."""
     invalid_dicts = [valid_dict] * len(valid_dict.keys()) * 2
@@ -343,6 +515,22 @@ def _invalid_params():
         _make_invalid_params(revcross_invalid_dicts,
                              hoomd.md.many_body.RevCross, {}))
 
+    stillinger_weber_valid_dict = {
+        'epsilon': 2.0,
+        'sigma': 1.0,
+        'A': 7.0,
+        'B': 0.6,
+        'p': 4.0,
+        'q': 0.0,
+        'lambda3': 21.0,
+        'gamma': 1.2,
+    }
+    stillinger_weber_invalid_dicts = _make_invalid_param_dict(
+        stillinger_weber_valid_dict)
+    invalid_params_list.extend(
+        _make_invalid_params(stillinger_weber_invalid_dicts,
+                             hoomd.md.many_body.StillingerWeber, {}))
+
     return invalid_params_list
 
 
@@ -571,6 +759,23 @@ def _valid_params(particle_types=['A', 'B']):
         paramtuple(hoomd.md.many_body.RevCross,
                    dict(zip(combos, revcross_valid_param_dicts)), {}))
 
+    stillinger_weber_arg_dict = {
+        'epsilon': [0.5, 1.0, 2.0],
+        'sigma': [0.5, 1.0, 1.5],
+        'A': [7.0, 5.0, 3.0],
+        'B': [0.6, 0.5, 0.4],
+        'p': [4.0, 4.0, 6.0],
+        'q': [0.0, 0.0, 1.0],
+        'lambda3': [21.0, 10.0, 5.0],
+        'gamma': [1.2, 1.0, 0.8],
+        'cos_theta0': [-1.0 / 3.0, -0.5, 0.0],
+    }
+    stillinger_weber_valid_param_dicts = _make_valid_param_dicts(
+        stillinger_weber_arg_dict)
+    valid_params_list.append(
+        paramtuple(hoomd.md.many_body.StillingerWeber,
+                   dict(zip(combos, stillinger_weber_valid_param_dicts)), {}))
+
     opp_arg_dict = {
         'C1': [1.0, 2.0, 5.0],
         'C2': [0.1, 0.5, 2.0],
@@ -623,6 +828,9 @@ def _valid_params(particle_types=['A', 'B']):
     valid_params_list.append(
         paramtuple(hoomd.md.pair.Table,
                    dict(zip(combos, table_valid_param_dicts)), {}))
+    valid_params_list.append(
+        paramtuple(hoomd.md.pair.TableSpline,
+                   dict(zip(combos, table_valid_param_dicts)), {}))
     return valid_params_list
 
 
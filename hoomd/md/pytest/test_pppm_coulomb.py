@@ -48,6 +48,9 @@ def test_attach_detach(simulation_factory,
     assert coulomb.order == 6
     assert coulomb.r_cut == 3.0
     assert coulomb.alpha == 0
+    assert coulomb.differentiation == 'ik'
+    assert not coulomb.single_rank_fft
+    assert not coulomb.slab_correction
 
     nlist2 = hoomd.md.nlist.Tree(buffer=0.4)
     coulomb.nlist = nlist2
@@ -66,6 +69,9 @@ def test_attach_detach(simulation_factory,
     coulomb.alpha = 1.5
     assert coulomb.alpha == 1.5
 
+    coulomb.differentiation = 'ad'
+    assert coulomb.differentiation == 'ad'
+
     # attached
     sim = simulation_factory(two_charged_particle_snapshot_factory())
     integrator = hoomd.md.Integrator(dt=0.005)
@@ -83,6 +89,7 @@ def test_attach_detach(simulation_factory,
     assert coulomb.order == 4
     assert coulomb.r_cut == 2.5
     assert coulomb.alpha == 1.5
+    assert coulomb.differentiation == 'ad'
 
     assert ewald.params[('A', 'A')]['alpha'] == 1.5
 
@@ -94,6 +101,8 @@ def test_attach_detach(simulation_factory,
         coulomb.r_cut = 4.5
     with pytest.raises(AttributeError):
         coulomb.alpha = 3.0
+    with pytest.raises(AttributeError):
+        coulomb.differentiation = 'ik'
 
 
 def test_pickling(simulation_factory, two_charged_particle_snapshot_factory):
@@ -120,11 +129,18 @@ def test_pickling(simulation_factory, two_charged_particle_snapshot_factory):
     pickling_check(coulomb)
 
 
-def test_pppm_energy(simulation_factory, two_charged_particle_snapshot_factory):
+@pytest.mark.parametrize("differentiation", ['ik', 'ad'])
+def test_pppm_energy(simulation_factory, two_charged_particle_snapshot_factory,
+                     differentiation):
     """Test that md.long_range.pppm.Coulomb computes the correct energy."""
     nlist = hoomd.md.nlist.Cell(buffer=0.4)
     ewald, coulomb = hoomd.md.long_range.pppm.make_pppm_coulomb_forces(
-        nlist=nlist, resolution=(64, 64, 64), order=6, r_cut=3.0, alpha=0)
+        nlist=nlist,
+        resolution=(64, 64, 64),
+        order=6,
+        r_cut=3.0,
+        alpha=0,
+        differentiation=differentiation)
 
     sim = simulation_factory(two_charged_particle_snapshot_factory())
     integrator = hoomd.md.Integrator(dt=0.005)
@@ -0,0 +1,36 @@
+import hoomd
+import pytest
+
+
+def test_before_attaching():
+    remd = hoomd.md.update.ReplicaExchange(hoomd.trigger.Periodic(10),
+                                           ladder=[1.5])
+    assert list(remd.ladder) == [1.5]
+    assert remd.kT(0) == 1.5
+
+
+def test_single_partition(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory())
+    if sim.device.communicator.num_partitions != 1:
+        pytest.skip("Test requires a single partition")
+
+    remd = hoomd.md.update.ReplicaExchange(hoomd.trigger.Periodic(1),
+                                           ladder=[2.0])
+    nvt = hoomd.md.methods.NVT(filter=hoomd.filter.All(), kT=remd.kT, tau=1.0)
+    sim.operations.integrator = hoomd.md.Integrator(0.005, methods=[nvt])
+    sim.operations.updaters.append(remd)
+    sim.run(10)
+
+    assert remd.ladder_index == 0
+    assert remd.kT(sim.timestep) == 2.0
+    assert remd.acceptance == []
+
+
+def test_ladder_size(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory())
+    remd = hoomd.md.update.ReplicaExchange(
+        hoomd.trigger.Periodic(1),
+        ladder=[1.0] * (sim.device.communicator.num_partitions + 1))
+    sim.operations.updaters.append(remd)
+    with pytest.raises(ValueError):
+        sim.run(0)
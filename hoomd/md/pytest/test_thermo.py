@@ -233,3 +233,45 @@ def test_logging():
                 'default': True
             }
         })
+
+
+def test_multi_group(simulation_factory, lattice_snapshot_factory):
+    filters = [
+        hoomd.filter.Type(['A']),
+        hoomd.filter.Type(['B']),
+        hoomd.filter.All()
+    ]
+    thermos = [hoomd.md.compute.ThermodynamicQuantities(f) for f in filters]
+    multi_thermo = hoomd.md.compute.MultiGroupThermodynamicQuantities(filters)
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'], n=4, a=1.5)
+    if snap.communicator.rank == 0:
+        rng = np.random.default_rng(seed=3)
+        snap.particles.velocity[:] = rng.normal(size=(snap.particles.N, 3))
+        snap.particles.typeid[:] = rng.integers(0, 2, size=snap.particles.N)
+    sim = simulation_factory(snap)
+    sim.always_compute_pressure = True
+    for thermo in thermos:
+        sim.operations.add(thermo)
+    sim.operations.add(multi_thermo)
+
+    integrator = hoomd.md.Integrator(dt=0.0001)
+    integrator.methods.append(hoomd.md.methods.NVE(hoomd.filter.All()))
+    lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(buffer=0.4))
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    lj.params[('A', 'B')] = dict(epsilon=1.5, sigma=1)
+    lj.params[('B', 'B')] = dict(epsilon=0.5, sigma=1)
+    lj.r_cut[('A', 'A'), ('A', 'B'), ('B', 'B')] = 2.5
+    integrator.forces.append(lj)
+    sim.operations.integrator = integrator
+
+    sim.run(1)
+
+    for qty, typ in _thermo_qtys:
+        values = getattr(multi_thermo, qty)
+        assert len(values) == len(filters)
+        for thermo, value in zip(thermos, values):
+            assert type(value) == typ
+            np.testing.assert_allclose(value,
+                                       getattr(thermo, qty),
+                                       rtol=1e-4,
+                                       atol=1e-5)
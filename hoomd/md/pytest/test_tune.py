@@ -0,0 +1,64 @@
+import hoomd
+import pytest
+
+
+def _make_nlist_simulation(simulation_factory, lattice_snapshot_factory):
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(0.005, forces=[lj])
+    integrator.methods.append(
+        hoomd.md.methods.Langevin(hoomd.filter.All(), kT=1.5))
+
+    sim = simulation_factory(lattice_snapshot_factory(n=6, a=1.1, r=0.1))
+    sim.operations.integrator = integrator
+    return sim, nlist
+
+
+def test_before_attaching():
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    trigger = hoomd.trigger.Periodic(100)
+    tuner = hoomd.md.tune.NeighborListBuffer(trigger=trigger,
+                                             nlist=nlist,
+                                             min_buffer=0.1,
+                                             max_buffer=0.8)
+    assert tuner.trigger is trigger
+    assert tuner.nlist is nlist
+    assert tuner.min_buffer == 0.1
+    assert tuner.max_buffer == 0.8
+
+    tuner.max_buffer = 0.6
+    assert tuner.max_buffer == 0.6
+
+    with pytest.raises(ValueError):
+        tuner.nlist = hoomd.md.nlist.Cell(buffer=0.4)
+
+
+def test_after_attaching(simulation_factory, lattice_snapshot_factory):
+    sim, nlist = _make_nlist_simulation(simulation_factory,
+                                        lattice_snapshot_factory)
+    tuner = hoomd.md.tune.NeighborListBuffer(
+        trigger=hoomd.trigger.Periodic(20),
+        nlist=nlist,
+        min_buffer=0.2,
+        max_buffer=0.6)
+    sim.operations.tuners.append(tuner)
+    sim.run(0)
+
+    assert tuner.min_buffer == 0.2
+    assert tuner.max_buffer == 0.6
+    assert isinstance(tuner.tuned, bool)
+
+    sim.run(400)
+    assert 0.2 <= nlist.buffer <= 0.6
+
+
+def test_unattached_nlist(simulation_factory, lattice_snapshot_factory):
+    sim, nlist = _make_nlist_simulation(simulation_factory,
+                                        lattice_snapshot_factory)
+    tuner = hoomd.md.tune.NeighborListBuffer(
+        trigger=hoomd.trigger.Periodic(20),
+        nlist=hoomd.md.nlist.Cell(buffer=0.4))
+    sim.operations.tuners.append(tuner)
+    with pytest.raises(hoomd.error.SimulationDefinitionError):
+        sim.run(0)
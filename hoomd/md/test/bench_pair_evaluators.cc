@@ -0,0 +1,261 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file bench_pair_evaluators.cc
+    \brief Measures the throughput of the pair potential evaluators
+
+    Each benchmark evaluates the force and energy of a fixed set of random pair distances. Run
+    the executable after changes to the evaluators, VectorMath.h, or HOOMDMath.h and compare the
+    evaluations per second (items/s) with the previous build.
+*/
+
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/GlobalArray.h"
+#include "hoomd/test/microbenchmark.h"
+
+#include "hoomd/md/EvaluatorPairBuckingham.h"
+#include "hoomd/md/EvaluatorPairDLVO.h"
+#include "hoomd/md/EvaluatorPairDPDThermo.h"
+#include "hoomd/md/EvaluatorPairEwald.h"
+#include "hoomd/md/EvaluatorPairExpandedMie.h"
+#include "hoomd/md/EvaluatorPairForceShiftedLJ.h"
+#include "hoomd/md/EvaluatorPairFourier.h"
+#include "hoomd/md/EvaluatorPairGauss.h"
+#include "hoomd/md/EvaluatorPairLJ.h"
+#include "hoomd/md/EvaluatorPairLJ0804.h"
+#include "hoomd/md/EvaluatorPairLJ1208.h"
+#include "hoomd/md/EvaluatorPairMie.h"
+#include "hoomd/md/EvaluatorPairMoliere.h"
+#include "hoomd/md/EvaluatorPairMorse.h"
+#include "hoomd/md/EvaluatorPairOPP.h"
+#include "hoomd/md/EvaluatorPairReactionField.h"
+#include "hoomd/md/EvaluatorPairTWF.h"
+#include "hoomd/md/EvaluatorPairYukawa.h"
+#include "hoomd/md/EvaluatorPairZBL.h"
+
+#ifdef ENABLE_HIP
+#include "bench_pair_evaluators.cuh"
+#endif
+
+#include <pybind11/embed.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace hoomd;
+using namespace hoomd::md;
+using namespace hoomd::test;
+using namespace pybind11::literals;
+
+//! Number of pair distances evaluated in one iteration
+const unsigned int n_samples = 4096;
+
+//! Cutoff radius of all potentials
+const Scalar r_cut = 2.5;
+
+//! Random pair distances and charges shared by all benchmarks
+struct PairSamples
+    {
+    PairSamples()
+        {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<Scalar> r_dist(0.9, r_cut);
+        for (unsigned int i = 0; i < n_samples; i++)
+            {
+            Scalar r = r_dist(rng);
+            rsq.push_back(r * r);
+            charge.push_back(i % 2 ? Scalar(1.0) : Scalar(-1.0));
+            }
+        }
+
+    std::vector<Scalar> rsq;    //!< Squared pair distances
+    std::vector<Scalar> charge; //!< Charge of the first particle, the second has the opposite
+    };
+
+//! Register the CPU and GPU benchmarks of one evaluator
+/*! \param registry Registry to add the benchmarks to
+    \param name Name of the potential
+    \param params Parameters of the potential as the Python API sets them
+    \param samples Pair distances to evaluate
+    \param gpu_exec_conf Execution configuration of the GPU benchmarks, null to skip them
+*/
+template<class evaluator>
+void add_pair_benchmarks(MicroBenchmarkRegistry& registry,
+                         const std::string& name,
+                         pybind11::dict params,
+                         std::shared_ptr<const PairSamples> samples,
+                         std::shared_ptr<ExecutionConfiguration> gpu_exec_conf)
+    {
+    typename evaluator::param_type param(params, false);
+    const Scalar rcutsq = r_cut * r_cut;
+
+    registry.add("pair/" + name + "/cpu",
+                 [param, rcutsq, samples](MicroBenchmarkState& state)
+                 {
+                     for (uint64_t iteration = 0; iteration < state.iterations(); iteration++)
+                         {
+                         for (unsigned int i = 0; i < n_samples; i++)
+                             {
+                             evaluator eval(samples->rsq[i], rcutsq, param);
+                             if (evaluator::needsDiameter())
+                                 eval.setDiameter(Scalar(0.5), Scalar(0.5));
+                             if (evaluator::needsCharge())
+                                 eval.setCharge(samples->charge[i], -samples->charge[i]);
+
+                             Scalar force_divr(0.0);
+                             Scalar pair_eng(0.0);
+                             eval.evalForceAndEnergy(force_divr, pair_eng, false);
+                             do_not_optimize(force_divr);
+                             do_not_optimize(pair_eng);
+                             }
+                         }
+                     state.setItemsPerIteration(n_samples);
+                 });
+
+#ifdef ENABLE_HIP
+    if (!gpu_exec_conf)
+        return;
+
+    registry.add(
+        "pair/" + name + "/gpu",
+        [param, rcutsq, samples, gpu_exec_conf](MicroBenchmarkState& state)
+        {
+            GlobalArray<Scalar> rsq(n_samples, gpu_exec_conf);
+            GlobalArray<Scalar> charge(n_samples, gpu_exec_conf);
+            GlobalArray<Scalar> out(n_samples, gpu_exec_conf);
+                {
+                ArrayHandle<Scalar> h_rsq(rsq, access_location::host, access_mode::overwrite);
+                ArrayHandle<Scalar> h_charge(charge,
+                                             access_location::host,
+                                             access_mode::overwrite);
+                for (unsigned int i = 0; i < n_samples; i++)
+                    {
+                    h_rsq.data[i] = samples->rsq[i];
+                    h_charge.data[i] = samples->charge[i];
+                    }
+                }
+
+            ArrayHandle<Scalar> d_rsq(rsq, access_location::device, access_mode::read);
+            ArrayHandle<Scalar> d_charge(charge, access_location::device, access_mode::read);
+            ArrayHandle<Scalar> d_out(out, access_location::device, access_mode::overwrite);
+
+            double elapsed_time = 0.0;
+            hipError_t error = gpu_bench_pair<evaluator>(d_out.data,
+                                                         d_rsq.data,
+                                                         d_charge.data,
+                                                         n_samples,
+                                                         rcutsq,
+                                                         param,
+                                                         state.iterations(),
+                                                         elapsed_time);
+            if (error != hipSuccess)
+                throw std::runtime_error(std::string("Error running benchmark: ")
+                                         + hipGetErrorString(error));
+
+            state.setManualTime(elapsed_time);
+            state.setItemsPerIteration(n_samples);
+        });
+#endif
+    }
+
+int main(int argc, char** argv)
+    {
+    // the param_type constructors take Python dictionaries
+    pybind11::scoped_interpreter guard {};
+
+    auto samples = std::make_shared<const PairSamples>();
+    MicroBenchmarkRegistry registry;
+
+    std::shared_ptr<ExecutionConfiguration> gpu_exec_conf;
+#ifdef ENABLE_HIP
+    if (ExecutionConfiguration::getCapableDevices().size() > 0)
+        gpu_exec_conf = std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::GPU));
+#endif
+
+    auto lj = pybind11::dict("epsilon"_a = 1.0, "sigma"_a = 1.0);
+    auto mie = pybind11::dict("epsilon"_a = 1.0, "sigma"_a = 1.0, "n"_a = 12.0, "m"_a = 6.0);
+    auto expanded_mie = pybind11::dict("epsilon"_a = 1.0,
+                                       "sigma"_a = 1.0,
+                                       "n"_a = 12.0,
+                                       "m"_a = 6.0,
+                                       "delta"_a = 0.1);
+    auto moliere = pybind11::dict("qi"_a = 1.0, "qj"_a = 1.0, "aF"_a = 1.0);
+    auto fourier = pybind11::dict("a"_a = pybind11::make_tuple(0.1, 0.2, 0.3),
+                                  "b"_a = pybind11::make_tuple(0.3, 0.2, 0.1));
+    auto opp = pybind11::dict("C1"_a = 1.0,
+                              "C2"_a = 1.0,
+                              "eta1"_a = 15.0,
+                              "eta2"_a = 3.0,
+                              "k"_a = 8.0,
+                              "phi"_a = 0.6);
+
+    add_pair_benchmarks<EvaluatorPairLJ>(registry, "LJ", lj, samples, gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairForceShiftedLJ>(registry,
+                                                     "ForceShiftedLJ",
+                                                     lj,
+                                                     samples,
+                                                     gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairLJ1208>(registry, "LJ1208", lj, samples, gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairLJ0804>(registry, "LJ0804", lj, samples, gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairGauss>(registry, "Gauss", lj, samples, gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairMie>(registry, "Mie", mie, samples, gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairExpandedMie>(registry,
+                                                  "ExpandedMie",
+                                                  expanded_mie,
+                                                  samples,
+                                                  gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairYukawa>(registry,
+                                             "Yukawa",
+                                             pybind11::dict("epsilon"_a = 1.0, "kappa"_a = 1.0),
+                                             samples,
+                                             gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairMorse>(
+        registry,
+        "Morse",
+        pybind11::dict("D0"_a = 1.0, "alpha"_a = 3.0, "r0"_a = 1.0),
+        samples,
+        gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairBuckingham>(
+        registry,
+        "Buckingham",
+        pybind11::dict("A"_a = 1.0, "rho"_a = 0.5, "C"_a = 1.0),
+        samples,
+        gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairMoliere>(registry, "Moliere", moliere, samples, gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairZBL>(registry, "ZBL", moliere, samples, gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairDLVO>(
+        registry,
+        "DLVO",
+        pybind11::dict("A"_a = 1.0, "kappa"_a = 1.0, "Z"_a = 1.0),
+        samples,
+        gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairEwald>(registry,
+                                            "Ewald",
+                                            pybind11::dict("kappa"_a = 1.0, "alpha"_a = 0.0),
+                                            samples,
+                                            gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairReactionField>(
+        registry,
+        "ReactionField",
+        pybind11::dict("epsilon"_a = 1.0, "eps_rf"_a = 2.0, "use_charge"_a = true),
+        samples,
+        gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairOPP>(registry, "OPP", opp, samples, gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairTWF>(
+        registry,
+        "TWF",
+        pybind11::dict("epsilon"_a = 1.0, "sigma"_a = 1.0, "alpha"_a = 50.0),
+        samples,
+        gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairFourier>(registry, "Fourier", fourier, samples, gpu_exec_conf);
+    add_pair_benchmarks<EvaluatorPairDPDThermo>(registry,
+                                                "DPDThermo",
+                                                pybind11::dict("A"_a = 1.0, "gamma"_a = 4.5),
+                                                samples,
+                                                gpu_exec_conf);
+
+    return registry.run(argc, argv);
+    }
@@ -0,0 +1,143 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "bench_pair_evaluators.cuh"
+
+#include "hoomd/md/EvaluatorPairBuckingham.h"
+#include "hoomd/md/EvaluatorPairDLVO.h"
+#include "hoomd/md/EvaluatorPairDPDThermo.h"
+#include "hoomd/md/EvaluatorPairEwald.h"
+#include "hoomd/md/EvaluatorPairExpandedMie.h"
+#include "hoomd/md/EvaluatorPairForceShiftedLJ.h"
+#include "hoomd/md/EvaluatorPairFourier.h"
+#include "hoomd/md/EvaluatorPairGauss.h"
+#include "hoomd/md/EvaluatorPairLJ.h"
+#include "hoomd/md/EvaluatorPairLJ0804.h"
+#include "hoomd/md/EvaluatorPairLJ1208.h"
+#include "hoomd/md/EvaluatorPairMie.h"
+#include "hoomd/md/EvaluatorPairMoliere.h"
+#include "hoomd/md/EvaluatorPairMorse.h"
+#include "hoomd/md/EvaluatorPairOPP.h"
+#include "hoomd/md/EvaluatorPairReactionField.h"
+#include "hoomd/md/EvaluatorPairTWF.h"
+#include "hoomd/md/EvaluatorPairYukawa.h"
+#include "hoomd/md/EvaluatorPairZBL.h"
+
+/*! \file bench_pair_evaluators.cu
+    \brief GPU kernels of bench_pair_evaluators.cc
+*/
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace test
+    {
+namespace kernel
+    {
+//! Evaluate the pair force and energy of one sample per thread
+template<class evaluator>
+__global__ void bench_pair(Scalar* d_out,
+                           const Scalar* d_rsq,
+                           const Scalar* d_charge,
+                           const unsigned int n,
+                           const Scalar rcutsq,
+                           const typename evaluator::param_type params)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= n)
+        return;
+
+    evaluator eval(d_rsq[idx], rcutsq, params);
+    if (evaluator::needsDiameter())
+        eval.setDiameter(Scalar(0.5), Scalar(0.5));
+    if (evaluator::needsCharge())
+        eval.setCharge(d_charge[idx], -d_charge[idx]);
+
+    Scalar force_divr(0.0);
+    Scalar pair_eng(0.0);
+    eval.evalForceAndEnergy(force_divr, pair_eng, false);
+    d_out[idx] = force_divr + pair_eng;
+    }
+
+    } // end namespace kernel
+
+template<class evaluator>
+hipError_t gpu_bench_pair(Scalar* d_out,
+                          const Scalar* d_rsq,
+                          const Scalar* d_charge,
+                          unsigned int n,
+                          Scalar rcutsq,
+                          const typename evaluator::param_type& params,
+                          uint64_t iterations,
+                          double& elapsed_time)
+    {
+    const unsigned int block_size = 256;
+
+    hipEvent_t start, stop;
+    hipEventCreate(&start);
+    hipEventCreate(&stop);
+
+    hipEventRecord(start, 0);
+    for (uint64_t i = 0; i < iterations; i++)
+        {
+        hipLaunchKernelGGL((kernel::bench_pair<evaluator>),
+                           dim3(n / block_size + 1),
+                           dim3(block_size),
+                           0,
+                           0,
+                           d_out,
+                           d_rsq,
+                           d_charge,
+                           n,
+                           rcutsq,
+                           params);
+        }
+    hipEventRecord(stop, 0);
+    hipEventSynchronize(stop);
+
+    float elapsed_ms;
+    hipEventElapsedTime(&elapsed_ms, start, stop);
+    elapsed_time = double(elapsed_ms) * 1e-3;
+
+    hipEventDestroy(start);
+    hipEventDestroy(stop);
+    return hipGetLastError();
+    }
+
+//! Explicit template instantiations
+#define INSTANTIATE_BENCH_PAIR(evaluator)                                                       \
+    template hipError_t gpu_bench_pair<evaluator>(Scalar * d_out,                               \
+                                                  const Scalar* d_rsq,                          \
+                                                  const Scalar* d_charge,                       \
+                                                  unsigned int n,                               \
+                                                  Scalar rcutsq,                                \
+                                                  const typename evaluator::param_type& params, \
+                                                  uint64_t iterations,                          \
+                                                  double& elapsed_time);
+
+INSTANTIATE_BENCH_PAIR(EvaluatorPairBuckingham)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairDLVO)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairDPDThermo)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairEwald)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairExpandedMie)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairForceShiftedLJ)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairFourier)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairGauss)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairLJ)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairLJ0804)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairLJ1208)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairMie)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairMoliere)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairMorse)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairOPP)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairReactionField)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairTWF)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairYukawa)
+INSTANTIATE_BENCH_PAIR(EvaluatorPairZBL)
+
+#undef INSTANTIATE_BENCH_PAIR
+
+    } // end namespace test
+    } // end namespace md
+    } // end namespace hoomd
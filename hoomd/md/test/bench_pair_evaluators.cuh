@@ -0,0 +1,41 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file bench_pair_evaluators.cuh
+    \brief Declares the GPU kernel drivers of bench_pair_evaluators.cc
+*/
+
+#pragma once
+
+#include "hoomd/HOOMDMath.h"
+#include <hip/hip_runtime.h>
+
+namespace hoomd
+    {
+namespace md
+    {
+namespace test
+    {
+//! Evaluate the pair force and energy of every sample, repeatedly
+/*! \param d_out Sum of the force and energy of each sample (prevents dead code elimination)
+    \param d_rsq Squared distance of each sample
+    \param d_charge Charge of the first particle in each sample (the second has the opposite)
+    \param n Number of samples
+    \param rcutsq Squared cutoff radius
+    \param params Parameters of the potential
+    \param iterations Number of times to evaluate all samples
+    \param elapsed_time Set to the time of all kernel launches (in seconds)
+*/
+template<class evaluator>
+hipError_t gpu_bench_pair(Scalar* d_out,
+                          const Scalar* d_rsq,
+                          const Scalar* d_charge,
+                          unsigned int n,
+                          Scalar rcutsq,
+                          const typename evaluator::param_type& params,
+                          uint64_t iterations,
+                          double& elapsed_time);
+
+    } // end namespace test
+    } // end namespace md
+    } // end namespace hoomd
@@ -938,6 +938,81 @@ void neighborlist_exclusion_tests(std::shared_ptr<ExecutionConfiguration> exec_c
         }
     }
 
+//! Checks the number of neighbors of each particle
+static void check_n_neigh(std::shared_ptr<NeighborList> nlist,
+                          const std::vector<unsigned int>& n_neigh)
+    {
+    ArrayHandle<unsigned int> h_n_neigh(nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    for (unsigned int i = 0; i < n_neigh.size(); i++)
+        CHECK_EQUAL_UINT(h_n_neigh.data[i], n_neigh[i]);
+    }
+
+//! Tests that the bond derived exclusions follow bonds added and removed during a run
+template<class NL>
+void neighborlist_bond_change_ex_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef_6(
+        new SystemDefinition(6, BoxDim(20.0, 40.0, 60.0), 1, 1, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata_6 = sysdef_6->getParticleData();
+    std::shared_ptr<BondData> bond_data = sysdef_6->getBondData();
+
+        // put all particles within the cutoff of each other, in tag order
+        {
+        ArrayHandle<Scalar4> h_pos(pdata_6->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+
+        for (unsigned int i = 0; i < 6; i++)
+            h_pos.data[i] = make_scalar4(Scalar(0.5) * i, 0, 0, __int_as_scalar(0));
+
+        pdata_6->notifyParticleSort();
+        }
+
+    // the chain 0-1-2-3
+    bond_data->addBondedGroup(Bond(0, 0, 1));
+    unsigned int middle_bond = bond_data->addBondedGroup(Bond(0, 1, 2));
+    bond_data->addBondedGroup(Bond(0, 2, 3));
+
+    auto make_nlist = [&]()
+    {
+        std::shared_ptr<NeighborList> nlist(new NL(sysdef_6, 0.25));
+        auto r_cut
+            = std::make_shared<GlobalArray<Scalar>>(nlist->getTypePairIndexer().getNumElements(),
+                                                    exec_conf);
+            {
+            ArrayHandle<Scalar> h_r_cut(*r_cut, access_location::host, access_mode::overwrite);
+            h_r_cut.data[0] = 3.0;
+            }
+        nlist->addRCutMatrix(r_cut);
+        nlist->setStorageMode(NeighborList::full);
+        nlist->setSingleExclusion("bond");
+        nlist->setSingleExclusion("1-3");
+        nlist->setSingleExclusion("1-4");
+        return nlist;
+    };
+
+    std::shared_ptr<NeighborList> nlist_6 = make_nlist();
+    nlist_6->compute(0);
+    check_n_neigh(nlist_6, {2, 2, 2, 2, 5, 5});
+
+    // extend the chain to 0-1-2-3-4, excluding 4 from 1, 2, and 3
+    bond_data->addBondedGroup(Bond(0, 3, 4));
+    nlist_6->compute(1);
+    check_n_neigh(nlist_6, {2, 1, 1, 1, 2, 5});
+
+    // split the chain into 0-1 and 2-3-4
+    bond_data->removeBondedGroup(middle_bond);
+    nlist_6->compute(2);
+    check_n_neigh(nlist_6, {4, 4, 3, 3, 3, 5});
+
+    // regenerating all exclusions gives the same list
+    std::shared_ptr<NeighborList> nlist_new = make_nlist();
+    nlist_new->compute(2);
+    check_n_neigh(nlist_new, {4, 4, 3, 3, 3, 5});
+    }
+
 //! Tests the ability of the neighbor list to exclude particles from the same body
 template<class NL>
 void neighborlist_body_filter_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -1739,6 +1814,12 @@ UP_TEST(NeighborListBinned_exclusion)
     neighborlist_exclusion_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(
         new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! bond change exclusion test case for binned class
+UP_TEST(NeighborListBinned_bond_change_ex)
+    {
+    neighborlist_bond_change_ex_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 //! large exclusion test case for binned class
 UP_TEST(NeighborListBinned_large_ex)
     {
@@ -1877,6 +1958,12 @@ UP_TEST(NeighborListTree_exclusion)
     neighborlist_exclusion_tests<NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(
         new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! bond change exclusion test case for tree class
+UP_TEST(NeighborListTree_bond_change_ex)
+    {
+    neighborlist_bond_change_ex_tests<NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 //! large exclusion test case for tree class
 UP_TEST(NeighborListTree_large_ex)
     {
@@ -1950,6 +2037,13 @@ UP_TEST(NeighborListGPUBinned_exclusion)
     neighborlist_exclusion_tests<NeighborListGPUBinned>(std::shared_ptr<ExecutionConfiguration>(
         new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
+//! bond change exclusion test case for GPUBinned class
+UP_TEST(NeighborListGPUBinned_bond_change_ex)
+    {
+    neighborlist_bond_change_ex_tests<NeighborListGPUBinned>(
+        std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
 //! large exclusion test case for GPUBinned class
 UP_TEST(NeighborListGPUBinned_large_ex)
     {
@@ -202,6 +202,69 @@ void angle_force_basic_tests(angleforce_creator tf_creator,
         }
     }
 
+//! Checks that spline interpolation is exact for a cubic potential
+void angle_force_spline_tests(angleforce_creator tf_creator,
+                              std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef_3(
+        new SystemDefinition(3, BoxDim(4.5), 1, 0, 1, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata_3 = sysdef_3->getParticleData();
+
+    Scalar3 a = make_scalar3(-1.23, 2.0, 0.1);
+    Scalar3 b = make_scalar3(1.0, 1.0, 1.0);
+    Scalar3 c = make_scalar3(1.0, 0.0, 0.5);
+    pdata_3->setPosition(0, a);
+    pdata_3->setPosition(1, b);
+    pdata_3->setPosition(2, c);
+    sysdef_3->getAngleData()->addBondedGroup(Angle(0, 0, 1, 2));
+
+    // V = theta^3 is reproduced exactly by the spline, even on a coarse table
+    unsigned int width = 11;
+    std::shared_ptr<TableAngleForceCompute> fc_spline = tf_creator(sysdef_3, width);
+    std::vector<Scalar> V, T;
+    for (unsigned int i = 0; i < width; ++i)
+        {
+        Scalar theta = (Scalar)i / (Scalar)(width - 1) * Scalar(M_PI);
+        V.push_back(theta * theta * theta);
+        T.push_back(-Scalar(3.0) * theta * theta);
+        }
+    fc_spline->setTable(0, V, T);
+    fc_spline->setSpline(true);
+    fc_spline->compute(0);
+
+    // a fine table with linear interpolation gives the reference forces
+    unsigned int fine_width = 10001;
+    std::shared_ptr<TableAngleForceCompute> fc_linear = tf_creator(sysdef_3, fine_width);
+    V.clear();
+    T.clear();
+    for (unsigned int i = 0; i < fine_width; ++i)
+        {
+        Scalar theta = (Scalar)i / (Scalar)(fine_width - 1) * Scalar(M_PI);
+        V.push_back(theta * theta * theta);
+        T.push_back(-Scalar(3.0) * theta * theta);
+        }
+    fc_linear->setTable(0, V, T);
+    fc_linear->compute(0);
+
+    Scalar3 dab = a - b;
+    Scalar3 dcb = c - b;
+    Scalar theta = acos(dot(dab, dcb) / sqrt(dot(dab, dab) * dot(dcb, dcb)));
+
+    ArrayHandle<Scalar4> h_force_spline(fc_spline->getForceArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<Scalar4> h_force_linear(fc_linear->getForceArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    for (unsigned int i = 0; i < 3; i++)
+        {
+        MY_CHECK_CLOSE(h_force_spline.data[i].w, theta * theta * theta / Scalar(3.0), tol);
+        MY_CHECK_CLOSE(h_force_spline.data[i].x, h_force_linear.data[i].x, tol);
+        MY_CHECK_CLOSE(h_force_spline.data[i].y, h_force_linear.data[i].y, tol);
+        MY_CHECK_CLOSE(h_force_spline.data[i].z, h_force_linear.data[i].z, tol);
+        }
+    }
+
 #if 0
 //! Compares the output of two TableAngleForceComputes
 void angle_force_comparison_tests(angleforce_creator tf_creator1,
@@ -305,6 +368,15 @@ UP_TEST(TableAngleForceCompute_basic)
                                 new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for spline interpolated angle forces on the CPU
+UP_TEST(TableAngleForceCompute_spline)
+    {
+    angleforce_creator tf_creator = bind(base_class_tf_creator, _1, _2);
+    angle_force_spline_tests(tf_creator,
+                             std::shared_ptr<ExecutionConfiguration>(
+                                 new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_HIP
 //! test case for angle forces on the GPU
 UP_TEST(TableAngleForceComputeGPU_basic)
@@ -315,6 +387,15 @@ UP_TEST(TableAngleForceComputeGPU_basic)
                             std::shared_ptr<ExecutionConfiguration>(
                                 new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
+
+//! test case for spline interpolated angle forces on the GPU
+UP_TEST(TableAngleForceComputeGPU_spline)
+    {
+    angleforce_creator tf_creator = bind(gpu_tf_creator, _1, _2);
+    angle_force_spline_tests(tf_creator,
+                             std::shared_ptr<ExecutionConfiguration>(
+                                 new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
 #if 0
 //! test case for comparing bond GPU and CPU BondForceComputes
 UP_TEST( TableAngleForceComputeGPU_compare )
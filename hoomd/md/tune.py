@@ -0,0 +1,112 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Tune MD performance parameters.
+
+Tuners in `hoomd.md.tune` adjust the performance parameters of MD
+operations while the simulation runs. They do not change the results of the
+simulation.
+"""
+
+from hoomd.md import _md
+from hoomd.md.nlist import NList
+from hoomd.error import SimulationDefinitionError
+from hoomd.operation import Tuner
+from hoomd.trigger import Trigger
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import positive_real
+from hoomd.logging import log
+
+
+class NeighborListBuffer(Tuner):
+    """Tune the neighbor list buffer to minimize the time per step.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps at which to
+            measure the time per step and choose the next buffer.
+        nlist (hoomd.md.nlist.NList): Neighbor list to tune.
+        min_buffer (float): Smallest buffer to try :math:`[\\mathrm{length}]`.
+        max_buffer (float): Largest buffer to try :math:`[\\mathrm{length}]`.
+
+    A larger `hoomd.md.nlist.NList.buffer` makes neighbor list builds less
+    frequent, but adds neighbors that every pair force must skip.
+    `NeighborListBuffer` measures the wall clock time per step between
+    triggered timesteps, which includes both the neighbor list builds and the
+    pair force evaluations, and searches for the buffer that minimizes it.
+    Once the search converges, `NeighborListBuffer` sets the buffer to the
+    fastest value found and increases `hoomd.md.nlist.NList.check_period` to
+    half of the shortest observed rebuild period when that is larger.
+
+    Measurements that include a dangerous build are discarded and halve
+    `hoomd.md.nlist.NList.check_period`, so the tuner does not trade
+    correctness for speed.
+
+    Note:
+        Choose *trigger* so that each measurement includes several neighbor
+        list builds, for example ``hoomd.trigger.Periodic(1000)``.
+
+    Example::
+
+        nlist = hoomd.md.nlist.Cell(buffer=0.4)
+        tuner = hoomd.md.tune.NeighborListBuffer(
+            trigger=hoomd.trigger.Periodic(1000), nlist=nlist)
+        sim.operations.tuners.append(tuner)
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps at which to
+            measure the time per step and choose the next buffer.
+        nlist (hoomd.md.nlist.NList): Neighbor list to tune. This is not
+            settable after construction.
+        min_buffer (float): Smallest buffer to try :math:`[\\mathrm{length}]`.
+        max_buffer (float): Largest buffer to try :math:`[\\mathrm{length}]`.
+    """
+
+    def __init__(self, trigger, nlist, min_buffer=0.05, max_buffer=1.0):
+        param_dict = ParameterDict(trigger=Trigger,
+                                   nlist=NList,
+                                   min_buffer=positive_real,
+                                   max_buffer=positive_real)
+        param_dict.update(
+            dict(trigger=trigger,
+                 nlist=nlist,
+                 min_buffer=min_buffer,
+                 max_buffer=max_buffer))
+        self._add_dependency(nlist)
+        self._param_dict.update(param_dict)
+
+    def _attach(self):
+        # Integrators and their forces are attached before tuners, an unattached
+        # neighbor list is not used by this simulation.
+        if not self.nlist._attached:
+            raise SimulationDefinitionError(
+                "Neighbor list for NeighborListBuffer is not used by the "
+                "simulation integrator.")
+        if self.nlist._simulation is not self._simulation:
+            raise SimulationDefinitionError(
+                "Neighbor list for NeighborListBuffer belongs to another "
+                "simulation.")
+        self._cpp_obj = _md.NeighborListBufferTuner(
+            self._simulation.state._cpp_sys_def, self.trigger,
+            self.nlist._cpp_obj, self.min_buffer, self.max_buffer)
+        # No need to call super, the constructor sets all parameters
+
+    def _handle_removed_dependency(self, nlist):
+        raise SimulationDefinitionError(
+            "The neighbor list this tuner is dependent on is being removed. "
+            "Remove this tuner first to avoid error.")
+
+    def _getattr_param(self, attr):
+        if attr == "nlist":
+            return self._param_dict[attr]
+        return super()._getattr_param(attr)
+
+    def _setattr_param(self, attr, value):
+        if attr == "nlist":
+            raise ValueError("nlist is not settable after construction.")
+        super()._setattr_param(attr, value)
+
+    @log(requires_run=True)
+    def tuned(self):
+        """bool: True when the search has converged."""
+        return self._cpp_obj.tuned
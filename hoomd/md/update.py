@@ -18,6 +18,7 @@ from hoomd.operation import Updater
 from hoomd.data.parameterdicts import ParameterDict
 from hoomd.data.typeconverter import OnlyTypes
 from hoomd.logging import log
+from hoomd.md.nlist import NList
 
 
 class ZeroMomentum(Updater):
@@ -244,6 +245,8 @@ class ActiveRotationalDiffusion(Updater):
     The rotational diffusion is applied to the orientation quaternion
     of each particle. When used with `hoomd.md.force.ActiveOnManifold`,
     rotational diffusion is performed in the tangent plane of the manifold.
+    The orientations are rotated when the active force is next computed, which
+    on the GPU happens in the same kernel that sets the active forces.
 
     Tip:
         Use `hoomd.md.force.Active.create_diffusion_updater` to construct
@@ -298,3 +301,246 @@ class ActiveRotationalDiffusion(Updater):
         if attr == "active_force":
             raise ValueError("active_force is not settable after construction.")
         super()._setattr_param(attr, value)
+
+
+class ReplicaExchange(Updater):
+    r"""Exchange temperatures between replicas in a parallel tempering simulation.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to attempt
+            exchanges.
+        ladder (list[float]): Temperature of each replica
+            :math:`[\mathrm{energy}]`, one per partition.
+
+    `ReplicaExchange` runs parallel tempering with one replica per partition of
+    the `hoomd.communicator.Communicator` (see ``ranks_per_partition``). Each
+    partition simulates its own configuration and starts at the temperature
+    ``ladder[partition]``. Configurations never move between partitions: an
+    accepted exchange swaps only the temperatures of two replicas.
+
+    On each triggered step, the partition roots gather the potential energies of
+    all replicas with a single collective call and attempt exchanges between
+    neighboring temperatures :math:`k` and :math:`k+1` (alternating the even
+    and odd pairs) with the Metropolis probability
+
+    .. math::
+
+        P = \min\left(1, \exp\left[\left(\frac{1}{kT_k} -
+        \frac{1}{kT_{k+1}}\right)(U_k - U_{k+1})\right]\right).
+
+    When the temperature of a replica changes from :math:`kT_{old}` to
+    :math:`kT_{new}`, the velocities and angular momenta are scaled by
+    :math:`\sqrt{kT_{new}/kT_{old}}`.
+
+    Use `kT` as the temperature of the integration methods::
+
+        device = hoomd.device.GPU(
+            communicator=hoomd.communicator.Communicator(
+                ranks_per_partition=1))
+        sim = hoomd.Simulation(device=device, seed=1)
+        # ... set the state of the replica ...
+        remd = hoomd.md.update.ReplicaExchange(
+            trigger=hoomd.trigger.Periodic(1000),
+            ladder=[1.0, 1.1, 1.21, 1.33])
+        nvt = hoomd.md.methods.NVT(filter=hoomd.filter.All(),
+                                   kT=remd.kT,
+                                   tau=1.0)
+        sim.operations.updaters.append(remd)
+
+    Note:
+        All partitions must use the same simulation seed and trigger.
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to attempt
+            exchanges.
+        ladder (list[float]): Temperature of each replica
+            :math:`[\mathrm{energy}]`. This is not settable after
+            construction.
+    """
+
+    def __init__(self, trigger, ladder):
+        super().__init__(trigger)
+        self._param_dict.update(
+            ParameterDict(ladder=[float], _defaults={'ladder': ladder}))
+        self._kT = hoomd.variant.Constant(self.ladder[0])
+
+    def _attach(self):
+        self._cpp_obj = _md.UpdaterReplicaExchange(
+            self._simulation.state._cpp_sys_def,
+            self._simulation.state._get_group(hoomd.filter.All()), self._kT,
+            list(self.ladder))
+        super()._attach()
+
+    @property
+    def kT(self):
+        """hoomd.variant.Constant: Temperature of this replica \
+        :math:`[\\mathrm{energy}]`.
+
+        Pass `kT` to the integration methods of the partition.
+        `ReplicaExchange` sets its value.
+        """
+        return self._kT
+
+    @log(requires_run=True)
+    def ladder_index(self):
+        """int: Index of the temperature of this replica in `ladder`."""
+        return self._cpp_obj.ladder_index
+
+    @log(category='sequence', requires_run=True)
+    def acceptance(self):
+        """list[float]: Fraction of the attempted exchanges accepted between \
+        each pair of neighboring temperatures."""
+        return [
+            accepted / attempted if attempted > 0 else 0.0
+            for accepted, attempted in zip(self._cpp_obj.num_accepted,
+                                           self._cpp_obj.num_attempted)
+        ]
+
+
+class DynamicBond(Updater):
+    r"""Form and break bonds of one type during the simulation.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to update the
+            bonds.
+        nlist (hoomd.md.nlist.NList): Neighbor list that finds the pairs that
+            can bond.
+        bond_type (str): Type of the bonds to form and break.
+        r_form (float): Distance below which bonds can form
+            :math:`[\mathrm{length}]`.
+        p_form (float): Probability to form a bond between a pair closer than
+            ``r_form``.
+        r_break (float): Distance above which bonds can break
+            :math:`[\mathrm{length}]`.
+        p_break (float): Probability to break a bond longer than ``r_break``.
+        max_bonds (int): Maximum number of bonds of type ``bond_type`` on each
+            particle.
+        filter (hoomd.filter.ParticleFilter): Particles that can form bonds.
+
+    On each triggered step, `DynamicBond` first breaks each bond of type
+    ``bond_type`` that is longer than ``r_break`` with probability ``p_break``.
+    It then selects each pair of particles in ``filter`` that is closer than
+    ``r_form`` with probability ``p_form`` and forms bonds between the selected
+    pairs in a random order. It skips pairs that are already bonded (by a bond
+    of any type) and pairs where either particle already has ``max_bonds``
+    bonds of type ``bond_type``.
+
+    The random numbers depend only on the simulation seed, the timestep, and
+    the tags of the pair, so the CPU and GPU implementations form and break the
+    same bonds.
+
+    `DynamicBond` adds ``r_form`` to the cutoff of ``nlist``. The neighbor list
+    excludes bonded pairs when its ``exclusions`` include ``'bond'``. Set
+    ``p_form`` or ``r_form`` to 0 to only break bonds.
+
+    Example::
+
+        nl = hoomd.md.nlist.Cell(buffer=0.4)
+        dynamic_bond = hoomd.md.update.DynamicBond(
+            trigger=hoomd.trigger.Periodic(100),
+            nlist=nl,
+            bond_type='A-A',
+            r_form=1.1,
+            p_form=0.1,
+            r_break=1.5,
+            p_break=0.5,
+            max_bonds=2)
+        sim.operations.updaters.append(dynamic_bond)
+
+    Note:
+        `DynamicBond` does not support MPI domain decomposition.
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to update the
+            bonds.
+        bond_type (str): Type of the bonds to form and break. This is not
+            settable after construction.
+        r_form (float): Distance below which bonds can form
+            :math:`[\mathrm{length}]`.
+        p_form (float): Probability to form a bond between a pair closer than
+            ``r_form``.
+        r_break (float): Distance above which bonds can break
+            :math:`[\mathrm{length}]`.
+        p_break (float): Probability to break a bond longer than ``r_break``.
+        max_bonds (int): Maximum number of bonds of type ``bond_type`` on each
+            particle.
+        filter (hoomd.filter.ParticleFilter): Particles that can form bonds.
+            This is not settable after construction.
+    """
+
+    def __init__(self,
+                 trigger,
+                 nlist,
+                 bond_type,
+                 r_form,
+                 p_form=1.0,
+                 r_break=0.0,
+                 p_break=0.0,
+                 max_bonds=1,
+                 filter=hoomd.filter.All()):
+        super().__init__(trigger)
+        self._nlist = OnlyTypes(NList)(nlist)
+        params = ParameterDict(bond_type=str,
+                               r_form=float,
+                               p_form=float,
+                               r_break=float,
+                               p_break=float,
+                               max_bonds=int,
+                               filter=hoomd.filter.ParticleFilter)
+        params.update(
+            dict(bond_type=bond_type,
+                 r_form=r_form,
+                 p_form=p_form,
+                 r_break=r_break,
+                 p_break=p_break,
+                 max_bonds=max_bonds,
+                 filter=filter))
+        self._param_dict.update(params)
+
+    def _add(self, simulation):
+        if self._nlist._added and self._nlist._simulation != simulation:
+            raise RuntimeError(
+                f"NeighborList associated with {self} is associated with "
+                f"another simulation.")
+        super()._add(simulation)
+        self._nlist._add(simulation)
+        self._add_dependency(self._nlist)
+
+    def _attach(self):
+        if not self._nlist._added:
+            self._nlist._add(self._simulation)
+        elif self._simulation != self._nlist._simulation:
+            raise RuntimeError("{} object's neighbor list is used in a "
+                               "different simulation.".format(type(self)))
+        if not self._nlist._attached:
+            self._nlist._attach()
+
+        sys_def = self._simulation.state._cpp_sys_def
+        bond_type = sys_def.getBondData().getTypeByName(self.bond_type)
+        group = self._simulation.state._get_group(self.filter)
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            cls = _md.DynamicBondUpdater
+        else:
+            cls = _md.DynamicBondUpdaterGPU
+        self._cpp_obj = cls(sys_def, self._nlist._cpp_obj, group, bond_type)
+        super()._attach()
+
+    @property
+    def nlist(self):
+        """hoomd.md.nlist.NList: Neighbor list that finds the pairs that can \
+        bond."""
+        return self._nlist
+
+    @property
+    def _children(self):
+        return [self._nlist]
+
+    @log(requires_run=True)
+    def num_formed(self):
+        """int: Number of bonds formed in the last update."""
+        return self._cpp_obj.num_formed
+
+    @log(requires_run=True)
+    def num_broken(self):
+        """int: Number of bonds broken in the last update."""
+        return self._cpp_obj.num_broken
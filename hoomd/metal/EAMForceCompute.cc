@@ -33,6 +33,9 @@ EAMForceCompute::EAMForceCompute(std::shared_ptr<SystemDefinition> sysdef,
 
     assert(m_pdata);
 
+    GlobalArray<Scalar> dFdP(m_pdata->getN() + m_pdata->getNGhosts(), m_exec_conf);
+    m_dFdP.swap(dFdP);
+
     loadFile(filename, type_of_file);
 
     // initialize the number of types value
@@ -365,15 +368,16 @@ void EAMForceCompute::computeForces(uint64_t timestep)
     // sum up the number of forces calculated
     int64_t n_calc = 0;
 
-    // parameters for each particle
-    vector<Scalar> atomElectronDensity;
-    atomElectronDensity.resize(m_pdata->getN());
-    vector<Scalar> atomDerivativeEmbeddingFunction;
-    atomDerivativeEmbeddingFunction.resize(m_pdata->getN());
-    vector<Scalar> atomEmbeddingFunction;
-    atomEmbeddingFunction.resize(m_pdata->getN());
+    // electron density of each particle, ghosts only collect partial sums with a half neighbor
+    // list
+    const unsigned int n_local_ghost = m_pdata->getN() + m_pdata->getNGhosts();
+    vector<Scalar> atomElectronDensity(n_local_ghost, Scalar(0.0));
     unsigned int ntypes = m_pdata->getNTypes();
 
+    // dF / dP of the local particles and their ghosts
+    if (m_dFdP.getNumElements() < n_local_ghost)
+        m_dFdP.resize(n_local_ghost);
+
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
         // access the particle's position and type
@@ -395,7 +399,7 @@ void EAMForceCompute::computeForces(uint64_t timestep)
             // access the index of this neighbor
             unsigned int k = h_nlist.data[head_i + j];
             // sanity check
-            assert(k < m_pdata->getN());
+            assert(k < n_local_ghost);
 
             // calculate dr
             Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
@@ -438,24 +442,39 @@ void EAMForceCompute::computeForces(uint64_t timestep)
             }
         }
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-        // calculate position rho for F(rho)
-        position = atomElectronDensity[i] * rdrho;
-        int_position = (unsigned int)position;
-        int_position = min(int_position, nrho - 1);
-        remainder = position - int_position;
-
-        idxs = int_position + typei * nrho;
-        v = h_F.data[idxs];
-        dv = h_dF.data[idxs];
-        // compute dF / dP
-        atomDerivativeEmbeddingFunction[i] = dv.z + dv.y * remainder + dv.x * remainder * remainder;
-        // compute embedded energy F(P), sum up each particle
-        h_force.data[i].w += v.w + v.z * remainder + v.y * remainder * remainder
-                             + v.x * remainder * remainder * remainder;
+        ArrayHandle<Scalar> h_dFdP(m_dFdP, access_location::host, access_mode::overwrite);
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            {
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            // calculate position rho for F(rho)
+            position = atomElectronDensity[i] * rdrho;
+            int_position = (unsigned int)position;
+            int_position = min(int_position, nrho - 1);
+            remainder = position - int_position;
+
+            idxs = int_position + typei * nrho;
+            v = h_F.data[idxs];
+            dv = h_dF.data[idxs];
+            // compute dF / dP
+            h_dFdP.data[i] = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+            // compute embedded energy F(P), sum up each particle
+            h_force.data[i].w += v.w + v.z * remainder + v.y * remainder * remainder
+                                 + v.x * remainder * remainder * remainder;
+            }
+        }
+
+#ifdef ENABLE_MPI
+    // the force on a particle depends on dF / dP of its neighbors, get it for the ghosts
+    if (m_sysdef->isDomainDecomposed())
+        {
+        auto comm = m_sysdef->getCommunicator().lock();
+        assert(comm);
+        comm->updateGhostScalars(m_dFdP);
         }
+#endif
+
+    ArrayHandle<Scalar> h_dFdP(m_dFdP, access_location::host, access_mode::read);
 
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
@@ -485,7 +504,7 @@ void EAMForceCompute::computeForces(uint64_t timestep)
             // access the index of this neighbor
             unsigned int k = h_nlist.data[head_i + j];
             // sanity check
-            assert(k < m_pdata->getN());
+            assert(k < n_local_ghost);
 
             // calculate \Delta r
             Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
@@ -536,9 +555,8 @@ void EAMForceCompute::computeForces(uint64_t timestep)
             dv = h_drho.data[idxs];
             Scalar derivativeRhoJ = dv.z + dv.y * remainder + dv.x * remainder * remainder;
             // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
-            Scalar fullDerivativePhi = atomDerivativeEmbeddingFunction[i] * derivativeRhoJ
-                                       + atomDerivativeEmbeddingFunction[k] * derivativeRhoI
-                                       + derivativePhi;
+            Scalar fullDerivativePhi = h_dFdP.data[i] * derivativeRhoJ
+                                       + h_dFdP.data[k] * derivativeRhoI + derivativePhi;
             // compute forces
             Scalar pairForce = -fullDerivativePhi * inverseR;
             viriali[0] += dx.x * dx.x * pairForce;
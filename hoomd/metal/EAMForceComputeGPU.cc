@@ -81,8 +81,76 @@ void EAMForceComputeGPU::computeForces(uint64_t timestep)
         throw runtime_error("Error computing forces in EAMForceComputeGPU");
         }
 
-    // access the neighbor list, which just selects the neighborlist into the device's memory,
-    // copying it there if needed
+    // dF / dP of the local particles and their ghosts
+    const unsigned int n_local_ghost = m_pdata->getN() + m_pdata->getNGhosts();
+    if (m_dFdP.getNumElements() < n_local_ghost)
+        m_dFdP.resize(n_local_ghost);
+
+    BoxDim box = m_pdata->getBox();
+
+        {
+        ArrayHandle<unsigned int> d_n_neigh(this->m_nlist->getNNeighArray(),
+                                            access_location::device,
+                                            access_mode::read);
+        ArrayHandle<unsigned int> d_nlist(this->m_nlist->getNListArray(),
+                                          access_location::device,
+                                          access_mode::read);
+        ArrayHandle<size_t> d_head_list(this->m_nlist->getHeadList(),
+                                        access_location::device,
+                                        access_mode::read);
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::overwrite);
+        ArrayHandle<Scalar> d_virial(m_virial, access_location::device, access_mode::overwrite);
+        ArrayHandle<Scalar4> d_F(m_F, access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_dF(m_dF, access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_rho(m_rho, access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_drho(m_drho, access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_rphi(m_rphi, access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_drphi(m_drphi, access_location::device, access_mode::read);
+        ArrayHandle<kernel::EAMTexInterData> d_eam_data(m_eam_data,
+                                                        access_location::device,
+                                                        access_mode::read);
+        ArrayHandle<Scalar> d_dFdP(m_dFdP, access_location::device, access_mode::overwrite);
+
+        // Compute the densities, embedding energies, and dF / dP of the local particles
+        m_tuner->begin();
+        kernel::gpu_compute_eam_tex_inter_embedding(d_force.data,
+                                                    d_virial.data,
+                                                    m_virial.getPitch(),
+                                                    m_pdata->getN(),
+                                                    d_pos.data,
+                                                    box,
+                                                    d_n_neigh.data,
+                                                    d_nlist.data,
+                                                    d_head_list.data,
+                                                    this->m_nlist->getNListArray().getPitch(),
+                                                    d_eam_data.data,
+                                                    d_dFdP.data,
+                                                    d_F.data,
+                                                    d_rho.data,
+                                                    d_rphi.data,
+                                                    d_dF.data,
+                                                    d_drho.data,
+                                                    d_drphi.data,
+                                                    m_tuner->getParam());
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner->end();
+        }
+
+#ifdef ENABLE_MPI
+    // the force on a particle depends on dF / dP of its neighbors, get it for the ghosts
+    if (m_sysdef->isDomainDecomposed())
+        {
+        auto comm = m_sysdef->getCommunicator().lock();
+        assert(comm);
+        comm->updateGhostScalars(m_dFdP);
+        }
+#endif
+
     ArrayHandle<unsigned int> d_n_neigh(this->m_nlist->getNNeighArray(),
                                         access_location::device,
                                         access_mode::read);
@@ -92,15 +160,9 @@ void EAMForceComputeGPU::computeForces(uint64_t timestep)
     ArrayHandle<size_t> d_head_list(this->m_nlist->getHeadList(),
                                     access_location::device,
                                     access_mode::read);
-
-    // access the particle data
     ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
-    BoxDim box = m_pdata->getBox();
-
-    ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::overwrite);
-    ArrayHandle<Scalar> d_virial(m_virial, access_location::device, access_mode::overwrite);
-
-    // access the potential data
+    ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::readwrite);
+    ArrayHandle<Scalar> d_virial(m_virial, access_location::device, access_mode::readwrite);
     ArrayHandle<Scalar4> d_F(m_F, access_location::device, access_mode::read);
     ArrayHandle<Scalar4> d_dF(m_dF, access_location::device, access_mode::read);
     ArrayHandle<Scalar4> d_rho(m_rho, access_location::device, access_mode::read);
@@ -110,13 +172,9 @@ void EAMForceComputeGPU::computeForces(uint64_t timestep)
     ArrayHandle<kernel::EAMTexInterData> d_eam_data(m_eam_data,
                                                     access_location::device,
                                                     access_mode::read);
+    ArrayHandle<Scalar> d_dFdP(m_dFdP, access_location::device, access_mode::read);
 
-    // Derivative Embedding Function for each atom
-    GPUArray<Scalar> t_dFdP(m_pdata->getN(), m_exec_conf);
-    m_dFdP.swap(t_dFdP);
-    ArrayHandle<Scalar> d_dFdP(m_dFdP, access_location::device, access_mode::overwrite);
-
-    // Compute energy and forces in GPU
+    // Compute the forces from dF / dP of the particles and their neighbors
     m_tuner->begin();
     kernel::gpu_compute_eam_tex_inter_forces(d_force.data,
                                              d_virial.data,
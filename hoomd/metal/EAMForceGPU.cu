@@ -309,50 +309,37 @@ __global__ void gpu_kernel_2(Scalar4* d_force,
         d_virial[i * virial_pitch + idx] = virial[i];
     }
 
-//! compute forces on GPU
-hipError_t gpu_compute_eam_tex_inter_forces(Scalar4* d_force,
-                                            Scalar* d_virial,
-                                            const size_t virial_pitch,
-                                            const unsigned int N,
-                                            const Scalar4* d_pos,
-                                            const BoxDim& box,
-                                            const unsigned int* d_n_neigh,
-                                            const unsigned int* d_nlist,
-                                            const size_t* d_head_list,
-                                            const size_t size_nlist,
-                                            const EAMTexInterData* d_eam_data,
-                                            Scalar* d_dFdP,
-                                            const Scalar4* d_F,
-                                            const Scalar4* d_rho,
-                                            const Scalar4* d_rphi,
-                                            const Scalar4* d_dF,
-                                            const Scalar4* d_drho,
-                                            const Scalar4* d_drphi,
-                                            const unsigned int block_size)
+//! compute the electron densities and embedding energies on GPU
+hipError_t gpu_compute_eam_tex_inter_embedding(Scalar4* d_force,
+                                               Scalar* d_virial,
+                                               const size_t virial_pitch,
+                                               const unsigned int N,
+                                               const Scalar4* d_pos,
+                                               const BoxDim& box,
+                                               const unsigned int* d_n_neigh,
+                                               const unsigned int* d_nlist,
+                                               const size_t* d_head_list,
+                                               const size_t size_nlist,
+                                               const EAMTexInterData* d_eam_data,
+                                               Scalar* d_dFdP,
+                                               const Scalar4* d_F,
+                                               const Scalar4* d_rho,
+                                               const Scalar4* d_rphi,
+                                               const Scalar4* d_dF,
+                                               const Scalar4* d_drho,
+                                               const Scalar4* d_drphi,
+                                               const unsigned int block_size)
     {
-    unsigned int max_block_size_1;
-    unsigned int max_block_size_2;
-
     hipFuncAttributes attr1;
     hipFuncGetAttributes(&attr1, reinterpret_cast<const void*>(gpu_kernel_1));
 
-    hipFuncAttributes attr2;
-    hipFuncGetAttributes(&attr2, reinterpret_cast<const void*>(gpu_kernel_2));
-
-    max_block_size_1 = attr1.maxThreadsPerBlock;
-    max_block_size_2 = attr2.maxThreadsPerBlock;
-
+    unsigned int max_block_size_1 = attr1.maxThreadsPerBlock;
     unsigned int run_block_size_1 = min(block_size, max_block_size_1);
-    unsigned int run_block_size_2 = min(block_size, max_block_size_2);
 
     // setup the grid to run the kernel
-
     dim3 grid_1((int)ceil((double)N / (double)run_block_size_1), 1, 1);
     dim3 threads_1(run_block_size_1, 1, 1);
 
-    dim3 grid_2((int)ceil((double)N / (double)run_block_size_2), 1, 1);
-    dim3 threads_2(run_block_size_2, 1, 1);
-
     hipLaunchKernelGGL(gpu_kernel_1,
                        dim3(grid_1),
                        dim3(threads_1),
@@ -375,6 +362,41 @@ hipError_t gpu_compute_eam_tex_inter_forces(Scalar4* d_force,
                        d_drphi,
                        d_dFdP,
                        d_eam_data);
+
+    return hipSuccess;
+    }
+
+//! compute forces on GPU
+hipError_t gpu_compute_eam_tex_inter_forces(Scalar4* d_force,
+                                            Scalar* d_virial,
+                                            const size_t virial_pitch,
+                                            const unsigned int N,
+                                            const Scalar4* d_pos,
+                                            const BoxDim& box,
+                                            const unsigned int* d_n_neigh,
+                                            const unsigned int* d_nlist,
+                                            const size_t* d_head_list,
+                                            const size_t size_nlist,
+                                            const EAMTexInterData* d_eam_data,
+                                            Scalar* d_dFdP,
+                                            const Scalar4* d_F,
+                                            const Scalar4* d_rho,
+                                            const Scalar4* d_rphi,
+                                            const Scalar4* d_dF,
+                                            const Scalar4* d_drho,
+                                            const Scalar4* d_drphi,
+                                            const unsigned int block_size)
+    {
+    hipFuncAttributes attr2;
+    hipFuncGetAttributes(&attr2, reinterpret_cast<const void*>(gpu_kernel_2));
+
+    unsigned int max_block_size_2 = attr2.maxThreadsPerBlock;
+    unsigned int run_block_size_2 = min(block_size, max_block_size_2);
+
+    // setup the grid to run the kernel
+    dim3 grid_2((int)ceil((double)N / (double)run_block_size_2), 1, 1);
+    dim3 threads_2(run_block_size_2, 1, 1);
+
     hipLaunchKernelGGL(gpu_kernel_2,
                        dim3(grid_2),
                        dim3(threads_2),
@@ -35,7 +35,33 @@ struct EAMTexInterData
     Scalar r_cutsq; //!< r_cut^2
     };
 
+//! Kernel driver that computes the electron densities and embedding energies on the GPU
+/*! The density and embedding function of every particle are evaluated in a single pass over its
+    neighbors, storing only dF/dP per particle for the force kernel.
+*/
+hipError_t gpu_compute_eam_tex_inter_embedding(Scalar4* d_force,
+                                               Scalar* d_virial,
+                                               const size_t virial_pitch,
+                                               const unsigned int N,
+                                               const Scalar4* d_pos,
+                                               const BoxDim& box,
+                                               const unsigned int* d_n_neigh,
+                                               const unsigned int* d_nlist,
+                                               const size_t* d_head_list,
+                                               const size_t size_nlist,
+                                               const EAMTexInterData* d_eam_data,
+                                               Scalar* d_dFdP,
+                                               const Scalar4* d_F,
+                                               const Scalar4* d_rho,
+                                               const Scalar4* d_rphi,
+                                               const Scalar4* d_dF,
+                                               const Scalar4* d_drho,
+                                               const Scalar4* d_drphi,
+                                               const unsigned int block_size);
+
 //! Kernel driver that computes EAM forces on the GPU for EAMForceComputeGPU
+/*! d_dFdP must hold the values of the local particles and their ghosts.
+ */
 hipError_t gpu_compute_eam_tex_inter_forces(Scalar4* d_force,
                                             Scalar* d_virial,
                                             const size_t virial_pitch,
@@ -38,9 +38,6 @@ class eam(force._force):
     (commands eam/alloy and eam/fs) here: http://lammps.sandia.gov/doc/pair_eam.html
     and are also described here: http://enpub.fulton.asu.edu/cms/potentials/submain/format.htm
 
-    .. attention::
-        EAM is **NOT** supported in MPI parallel simulations.
-
     Example::
 
         nl = nlist.cell()
@@ -50,15 +47,6 @@ class eam(force._force):
     """
 
     def __init__(self, file, type, nlist):
-        # Error out in MPI simulations
-        if (hoomd.version.mpi_enabled):
-            if hoomd.context.current.system_definition.getParticleData(
-            ).getDomainDecomposition():
-                hoomd.context.current.device.cpp_msg.error(
-                    "pair.eam is not supported in multi-processor simulations.\n\n"
-                )
-                raise RuntimeError("Error setting up pair potential.")
-
         # initialize the base class
         force._force.__init__(self)
         # Translate type
@@ -2,7 +2,10 @@
 // This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
 
 // Maintainer: joaander All developers are free to add the calls needed to export their modules
+#include "ADIOS2Writer.h"
 #include "Analyzer.h"
+#include "AutotunerCache.h"
+#include "BinaryTableWriter.h"
 #include "BondedGroupData.h"
 #include "BoxResizeUpdater.h"
 #include "CellList.h"
@@ -30,9 +33,11 @@
 #include "PythonLocalDataAccess.h"
 #include "PythonTuner.h"
 #include "PythonUpdater.h"
+#include "RestartWriter.h"
 #include "SFCPackTuner.h"
 #include "SnapshotSystemData.h"
 #include "System.h"
+#include "SystemCheckpoint.h"
 #include "SystemDefinition.h"
 #include "Trigger.h"
 #include "Tuner.h"
@@ -45,9 +50,11 @@
 
 // include GPU classes
 #ifdef ENABLE_HIP
+#include "BoxResizeUpdaterGPU.h"
 #include "CellListGPU.h"
 #include "LoadBalancerGPU.h"
 #include "SFCPackTunerGPU.h"
+#include "UpdaterRemoveDriftGPU.h"
 #include <hip/hip_runtime.h>
 #endif
 
@@ -195,6 +202,8 @@ PYBIND11_MODULE(_hoomd, m)
         .def_static("getCXXCompiler", BuildInfo::getCXXCompiler)
         .def_static("getEnableTBB", BuildInfo::getEnableTBB)
         .def_static("getEnableMPI", BuildInfo::getEnableMPI)
+        .def_static("getEnableADIOS2", BuildInfo::getEnableADIOS2)
+        .def_static("getEnableTorch", BuildInfo::getEnableTorch)
         .def_static("getSourceDir", BuildInfo::getSourceDir)
         .def_static("getInstallDir", BuildInfo::getInstallDir);
 
@@ -227,9 +236,11 @@ PYBIND11_MODULE(_hoomd, m)
     export_LocalParticleData<HOOMDDeviceBuffer>(m, "LocalParticleDataDevice");
 #endif
     export_MPIConfiguration(m);
+    export_AutotunerCache(m);
     export_ExecutionConfiguration(m);
     export_SystemDefinition(m);
     export_SnapshotSystemData(m);
+    export_SystemCheckpoint(m);
     export_BondedGroupData<BondData, Bond>(m, "BondData", "BondDataSnapshot");
     export_BondedGroupData<AngleData, Angle>(m, "AngleData", "AngleDataSnapshot");
     export_BondedGroupData<DihedralData, Dihedral>(m, "DihedralData", "DihedralDataSnapshot");
@@ -259,13 +270,22 @@ PYBIND11_MODULE(_hoomd, m)
 
     // initializers
     export_GSDReader(m);
+    export_DistributedInitializers(m);
     getardump::export_GetarInitializer(m);
 
     // computes
     export_Compute(m);
     export_CellList(m);
+    export_LocalCellListData<HOOMDHostBuffer>(m, "LocalCellListDataHost");
+#if ENABLE_HIP
+    export_LocalCellListData<HOOMDDeviceBuffer>(m, "LocalCellListDataDevice");
+#endif
     export_CellListStencil(m);
     export_ForceCompute(m);
+    export_LocalForceComputeData<HOOMDHostBuffer>(m, "LocalForceComputeDataHost");
+#if ENABLE_HIP
+    export_LocalForceComputeData<HOOMDDeviceBuffer>(m, "LocalForceComputeDataDevice");
+#endif
     export_ForceConstraint(m);
     export_ConstForceCompute(m);
 
@@ -279,6 +299,11 @@ PYBIND11_MODULE(_hoomd, m)
     export_DCDDumpWriter(m);
     getardump::export_GetarDumpWriter(m);
     export_GSDDumpWriter(m);
+    export_BinaryTableWriter(m);
+    export_RestartWriter(m);
+#ifdef ENABLE_ADIOS2
+    export_ADIOS2Writer(m);
+#endif
 
     // updaters
     export_Updater(m);
@@ -286,6 +311,10 @@ PYBIND11_MODULE(_hoomd, m)
     export_Integrator(m);
     export_BoxResizeUpdater(m);
     export_UpdaterRemoveDrift(m);
+#ifdef ENABLE_HIP
+    export_BoxResizeUpdaterGPU(m);
+    export_UpdaterRemoveDriftGPU(m);
+#endif
 
     // tuners
     export_Tuner(m);
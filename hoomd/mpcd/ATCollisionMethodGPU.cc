@@ -23,8 +23,11 @@ mpcd::ATCollisionMethodGPU::ATCollisionMethodGPU(
     std::shared_ptr<Variant> T)
     : mpcd::ATCollisionMethod(sysdata, cur_timestep, period, phase, thermo, rand_thermo, T)
     {
-    m_tuner_draw.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_at_draw", m_exec_conf));
-    m_tuner_apply.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_at_apply", m_exec_conf));
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner_draw.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_at_draw", m_exec_conf));
+    m_tuner_apply.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_at_apply", m_exec_conf));
     }
 
 void mpcd::ATCollisionMethodGPU::drawVelocities(uint64_t timestep)
@@ -32,16 +32,17 @@ mpcd::CellCommunicator::CellCommunicator(std::shared_ptr<SystemDefinition> sysde
 #ifdef ENABLE_HIP
     if (m_exec_conf->isCUDAEnabled())
         {
-        m_tuner_pack.reset(new Autotuner(32,
+        unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+        m_tuner_pack.reset(new Autotuner(warp_size,
                                          1024,
-                                         32,
+                                         warp_size,
                                          5,
                                          100000,
                                          "mpcd_cell_comm_pack_" + std::to_string(m_id),
                                          m_exec_conf));
-        m_tuner_unpack.reset(new Autotuner(32,
+        m_tuner_unpack.reset(new Autotuner(warp_size,
                                            1024,
-                                           32,
+                                           warp_size,
                                            5,
                                            100000,
                                            "mpcd_cell_comm_unpack_" + std::to_string(m_id),
@@ -21,8 +21,8 @@ mpcd::CellList::CellList(std::shared_ptr<SystemDefinition> sysdef,
                          std::shared_ptr<mpcd::ParticleData> mpcd_pdata)
     : Compute(sysdef), m_mpcd_pdata(mpcd_pdata), m_cell_size(1.0), m_cell_np_max(4),
       m_cell_np(m_exec_conf), m_cell_list(m_exec_conf), m_embed_cell_ids(m_exec_conf),
-      m_conditions(m_exec_conf), m_needs_compute_dim(true), m_particles_sorted(false),
-      m_virtual_change(false)
+      m_conditions(m_exec_conf), m_embed_out_of_range(false), m_needs_compute_dim(true),
+      m_particles_sorted(false), m_virtual_change(false)
     {
     assert(m_mpcd_pdata);
     m_exec_conf->msg->notice(5) << "Constructing MPCD CellList" << std::endl;
@@ -93,39 +93,57 @@ void mpcd::CellList::compute(uint64_t timestep)
 
     if (peekCompute(timestep))
         {
+        /*
+         * Embedded particles that have left the local cells are detected while binning, from the
+         * same condition flags that are read to check for overflow, and are migrated afterwards.
+         * The cell list is then rebuilt once, and any particle still outside is an error.
+         */
+        bool allow_embed_migrate = false;
 #ifdef ENABLE_MPI
-        if (m_prof)
-            m_prof->pop(m_exec_conf);
-
-        // exchange embedded particles if necessary
-        if (m_sysdef->isDomainDecomposed() && needsEmbedMigrate(timestep))
-            {
-            m_comm->forceMigrate();
-            m_comm->communicate(timestep);
-            }
-        if (m_prof)
-            m_prof->push(m_exec_conf, "MPCD cell list");
+        allow_embed_migrate = (m_sysdef->isDomainDecomposed() && m_embed_group);
 #endif // ENABLE_MPI
-
-        // resize to be able to hold the number of embedded particles
-        if (m_embed_group)
-            {
-            m_embed_cell_ids.resize(m_embed_group->getNumMembers());
-            }
-
-        bool overflowed = false;
+        bool migrated = false;
         do
             {
-            buildCellList();
+            // resize to be able to hold the number of embedded particles
+            if (m_embed_group)
+                {
+                m_embed_cell_ids.resize(m_embed_group->getNumMembers());
+                }
+
+            m_embed_out_of_range = false;
+            bool overflowed = false;
+            do
+                {
+                buildCellList();
+
+                overflowed = checkConditions(allow_embed_migrate);
 
-            overflowed = checkConditions();
+                if (overflowed)
+                    {
+                    reallocate();
+                    resetConditions();
+                    }
+                } while (overflowed);
 
-            if (overflowed)
+            migrated = false;
+#ifdef ENABLE_MPI
+            // exchange embedded particles if necessary
+            if (allow_embed_migrate && needsEmbedMigrate(timestep))
                 {
-                reallocate();
+                if (m_prof)
+                    m_prof->pop(m_exec_conf);
+                m_comm->forceMigrate();
+                m_comm->communicate(timestep);
+                if (m_prof)
+                    m_prof->push(m_exec_conf, "MPCD cell list");
+
                 resetConditions();
+                allow_embed_migrate = false;
+                migrated = true;
                 }
-            } while (overflowed);
+#endif // ENABLE_MPI
+            } while (migrated);
 
         // we are finished building, explicitly mark everything (rather than using shouldCompute)
         m_first_compute = false;
@@ -533,7 +551,12 @@ bool mpcd::CellList::isCommunicating(mpcd::detail::face dir)
 #endif // ENABLE_MPI
 
 /*!
- * \param timestep Current simulation timestep
+ * Every particle is binned from its position in a single pass. The cell list is only built when
+ * it is needed at a new timestep, which is once per collision, so the particles have streamed and
+ * a new grid shift has been drawn since the last build. Keeping particles in fixed sub-cells to
+ * assemble the shifted cells would not avoid this pass, because the sub-cells would need to be
+ * rebuilt after streaming too. When the particles are sorted, the cell list is remapped by sort()
+ * rather than rebuilt.
  */
 void mpcd::CellList::buildCellList()
     {
@@ -730,56 +753,37 @@ void mpcd::CellList::sort(uint64_t timestep,
     }
 
 #ifdef ENABLE_MPI
+/*!
+ * \param timestep Current timestep
+ * \returns True if an embedded particle on any rank was binned outside the local cells
+ *
+ * The check is made from the condition flags of the last cell list build, so it only requires a
+ * reduction across the ranks.
+ */
 bool mpcd::CellList::needsEmbedMigrate(uint64_t timestep)
     {
-    // no migrate needed if no embedded particles
-    if (!m_embed_group)
-        return false;
-
-    // ensure that the cell list has been sized first
-    computeDimensions();
-
-    // coverage box dimensions, assuming orthorhombic
-    const Scalar3 lo = m_cover_box.getLo();
-    const Scalar3 hi = m_cover_box.getHi();
-    const uchar3 periodic = m_cover_box.getPeriodic();
-    const unsigned int ndim = m_sysdef->getNDimensions();
-
-    // particle data
-    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_group(m_embed_group->getIndexArray(),
-                                      access_location::host,
-                                      access_mode::read);
-    const unsigned int N = m_embed_group->getNumMembers();
-
-    // check if any particle lies outside of the box on this rank
-    char migrate = 0;
-    for (unsigned int i = 0; i < N && !migrate; ++i)
-        {
-        const unsigned int idx = h_group.data[i];
-        const Scalar4 postype = h_pos.data[idx];
-        const Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
-
-        if ((!periodic.x && (pos.x >= hi.x || pos.x < lo.x))
-            || (!periodic.y && (pos.y >= hi.y || pos.y < lo.y))
-            || (!periodic.z && ndim == 3 && (pos.z >= hi.z || pos.z < lo.z)))
-            {
-            migrate = 1;
-            }
-        }
-
-    // reduce across all ranks
+    char migrate = static_cast<char>(m_embed_out_of_range);
     MPI_Allreduce(MPI_IN_PLACE, &migrate, 1, MPI_CHAR, MPI_MAX, m_exec_conf->getMPICommunicator());
 
     return static_cast<bool>(migrate);
     }
 #endif // ENABLE_MPI
 
-bool mpcd::CellList::checkConditions()
+/*!
+ * \param allow_embed_migrate If true, an embedded particle outside the local cells is flagged for
+ *                            migration instead of raising an error
+ * \returns True if the cell list overflowed and must be rebuilt
+ */
+bool mpcd::CellList::checkConditions(bool allow_embed_migrate)
     {
     bool result = false;
 
     uint3 conditions = m_conditions.readFlags();
+    if (allow_embed_migrate && conditions.z > m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual())
+        {
+        m_embed_out_of_range = true;
+        conditions.z = 0;
+        }
 
     if (conditions.x > m_cell_np_max)
         {
@@ -271,11 +271,13 @@ class PYBIND11_EXPORT CellList : public Compute
     std::shared_ptr<Communicator> m_comm;
 
     //! Determine if embedded particles require migration
-    virtual bool needsEmbedMigrate(uint64_t timestep);
+    bool needsEmbedMigrate(uint64_t timestep);
 #endif // ENABLE_MPI
 
+    bool m_embed_out_of_range; //!< True if an embedded particle was binned outside the local cells
+
     //! Check the condition flags
-    bool checkConditions();
+    bool checkConditions(bool allow_embed_migrate = false);
 
     //! Reset the conditions array
     void resetConditions();
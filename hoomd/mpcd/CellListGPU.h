@@ -45,10 +45,6 @@ class PYBIND11_EXPORT CellListGPU : public mpcd::CellList
         m_tuner_cell->setEnabled(enable);
         m_tuner_sort->setPeriod(period);
         m_tuner_sort->setEnabled(enable);
-#ifdef ENABLE_MPI
-        m_tuner_embed_migrate->setPeriod(period);
-        m_tuner_embed_migrate->setEnabled(enable);
-#endif // ENABLE_MPI
         }
 
     protected:
@@ -60,18 +56,9 @@ class PYBIND11_EXPORT CellListGPU : public mpcd::CellList
                       const GPUArray<unsigned int>& order,
                       const GPUArray<unsigned int>& rorder);
 
-#ifdef ENABLE_MPI
-    //! Determine if embedded particles require migration on the gpu
-    virtual bool needsEmbedMigrate(uint64_t timestep);
-    GPUFlags<unsigned int> m_migrate_flag; //!< Flag to signal migration is needed
-#endif                                     // ENABLE_MPI
-
     private:
     std::unique_ptr<Autotuner> m_tuner_cell; //!< Autotuner for the cell list calculation
     std::unique_ptr<Autotuner> m_tuner_sort; //!< Autotuner for sorting the cell list
-#ifdef ENABLE_MPI
-    std::unique_ptr<Autotuner> m_tuner_embed_migrate; //!< Autotuner for checking embedded migration
-#endif                                                // ENABLE_MPI
     };
 
 namespace detail
@@ -22,10 +22,11 @@ mpcd::CellThermoComputeGPU::CellThermoComputeGPU(std::shared_ptr<mpcd::SystemDat
     {
     // construct a range of valid tuner parameters using the block size and number of threads per
     // particle
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
     std::vector<unsigned int> valid_params;
-    for (unsigned int block_size = 32; block_size <= 1024; block_size += 32)
+    for (unsigned int block_size = warp_size; block_size <= 1024; block_size += warp_size)
         {
-        for (auto s : Autotuner::getTppListPow2(this->m_exec_conf->dev_prop.warpSize))
+        for (auto s : Autotuner::getTppListPow2(warp_size))
             {
             valid_params.push_back(block_size * 10000 + s);
             }
@@ -33,11 +34,17 @@ mpcd::CellThermoComputeGPU::CellThermoComputeGPU(std::shared_ptr<mpcd::SystemDat
 
     m_begin_tuner.reset(
         new Autotuner(valid_params, 5, 100000, "mpcd_cell_thermo_begin", m_exec_conf));
-    m_end_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_cell_thermo_end", m_exec_conf));
+    m_end_tuner.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_cell_thermo_end", m_exec_conf));
     m_inner_tuner.reset(
         new Autotuner(valid_params, 5, 100000, "mpcd_cell_thermo_inner", m_exec_conf));
-    m_stage_tuner.reset(
-        new Autotuner(32, 1024, 32, 5, 100000, "mpcd_cell_thermo_stage", m_exec_conf));
+    m_stage_tuner.reset(new Autotuner(warp_size,
+                                      1024,
+                                      warp_size,
+                                      5,
+                                      100000,
+                                      "mpcd_cell_thermo_stage",
+                                      m_exec_conf));
     }
 
 mpcd::CellThermoComputeGPU::~CellThermoComputeGPU() { }
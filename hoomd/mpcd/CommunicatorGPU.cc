@@ -38,7 +38,9 @@ mpcd::CommunicatorGPU::CommunicatorGPU(std::shared_ptr<mpcd::SystemData> system_
     m_num_send.swap(num_send);
 
     // autotuners
-    m_flags_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_comm_flags", m_exec_conf));
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_flags_tuner.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_comm_flags", m_exec_conf));
     }
 
 mpcd::CommunicatorGPU::~CommunicatorGPU() { }
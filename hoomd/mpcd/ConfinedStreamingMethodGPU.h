@@ -47,7 +47,9 @@ class PYBIND11_EXPORT ConfinedStreamingMethodGPU : public mpcd::ConfinedStreamin
                                std::shared_ptr<const Geometry> geom)
         : mpcd::ConfinedStreamingMethod<Geometry>(sysdata, cur_timestep, period, phase, geom)
         {
-        m_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_stream", this->m_exec_conf));
+        unsigned int warp_size = this->m_exec_conf->dev_prop.warpSize;
+        m_tuner.reset(
+            new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_stream", this->m_exec_conf));
         }
 
     //! Implementation of the streaming rule
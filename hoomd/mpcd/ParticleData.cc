@@ -1262,10 +1262,13 @@ void mpcd::ParticleData::setupMPI(std::shared_ptr<DomainDecomposition> decomposi
 #ifdef ENABLE_HIP
     if (m_exec_conf->isCUDAEnabled())
         {
-        m_mark_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_pdata_mark", m_exec_conf));
+        unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+        m_mark_tuner.reset(
+            new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_pdata_mark", m_exec_conf));
         m_remove_tuner.reset(
-            new Autotuner(32, 1024, 32, 5, 100000, "mpcd_pdata_remove", m_exec_conf));
-        m_add_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_pdata_add", m_exec_conf));
+            new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_pdata_remove", m_exec_conf));
+        m_add_tuner.reset(
+            new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_pdata_add", m_exec_conf));
         }
 #endif // ENABLE_HIP
     }
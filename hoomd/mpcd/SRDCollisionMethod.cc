@@ -21,13 +21,17 @@ mpcd::SRDCollisionMethod::SRDCollisionMethod(std::shared_ptr<mpcd::SystemData> s
                                              uint16_t seed,
                                              std::shared_ptr<mpcd::CellThermoCompute> thermo)
     : mpcd::CollisionMethod(sysdata, cur_timestep, period, phase), m_thermo(thermo),
-      m_rotvec(m_exec_conf), m_angle(0.0), m_factors(m_exec_conf)
+      m_rotvec(m_exec_conf), m_angle(0.0), m_factors(m_exec_conf), m_rotvec_drawn(false),
+      m_rotvec_timestep(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing MPCD SRD collision method" << std::endl;
 
     m_thermo->getFlagsSignal()
         .connect<mpcd::SRDCollisionMethod, &mpcd::SRDCollisionMethod::getRequestedThermoFlags>(
             this);
+    m_thermo->getCallbackSignal()
+        .connect<mpcd::SRDCollisionMethod,
+                 &mpcd::SRDCollisionMethod::drawRotationVectorsOverlapped>(this);
     }
 
 mpcd::SRDCollisionMethod::~SRDCollisionMethod()
@@ -37,6 +41,9 @@ mpcd::SRDCollisionMethod::~SRDCollisionMethod()
     m_thermo->getFlagsSignal()
         .disconnect<mpcd::SRDCollisionMethod, &mpcd::SRDCollisionMethod::getRequestedThermoFlags>(
             this);
+    m_thermo->getCallbackSignal()
+        .disconnect<mpcd::SRDCollisionMethod,
+                    &mpcd::SRDCollisionMethod::drawRotationVectorsOverlapped>(this);
     }
 
 void mpcd::SRDCollisionMethod::rule(uint64_t timestep)
@@ -52,8 +59,12 @@ void mpcd::SRDCollisionMethod::rule(uint64_t timestep)
         m_factors.resize(m_cl->getNCells());
         }
 
-    // draw rotation vectors for each cell
-    drawRotationVectors(timestep);
+    // draw rotation vectors for each cell, unless this was already done during the thermo
+    if (!m_rotvec_drawn || m_rotvec_timestep != timestep)
+        {
+        drawRotationVectors(timestep);
+        }
+    m_rotvec_drawn = false;
 
     // apply collision rule
     rotate(timestep);
@@ -61,6 +72,24 @@ void mpcd::SRDCollisionMethod::rule(uint64_t timestep)
         m_prof->pop(m_exec_conf);
     }
 
+/*!
+ * \param timestep Current timestep
+ *
+ * The rotation vectors do not depend on the cell properties, so they are drawn from the thermo
+ * callback while the outer cell properties are communicated. The thermostat factors need the
+ * reduced cell energies, so the vectors are drawn in rule() instead when the thermostat is on.
+ */
+void mpcd::SRDCollisionMethod::drawRotationVectorsOverlapped(uint64_t timestep)
+    {
+    if (m_T)
+        return;
+
+    m_rotvec.resize(m_cl->getNCells());
+    drawRotationVectors(timestep);
+    m_rotvec_drawn = true;
+    m_rotvec_timestep = timestep;
+    }
+
 void mpcd::SRDCollisionMethod::drawRotationVectors(uint64_t timestep)
     {
     // cell indexers and rotation vectors
@@ -180,6 +209,23 @@ void mpcd::SRDCollisionMethod::rotate(uint64_t timestep)
             new ArrayHandle<double>(m_factors, access_location::host, access_mode::read));
         }
 
+    // build the rotation matrix of each cell once, instead of for every particle in the cell
+    const unsigned int n_cells = m_cl->getNCells();
+    m_rotmat.resize(3 * n_cells);
+    for (unsigned int cell = 0; cell < n_cells; ++cell)
+        {
+        const double3 r = h_rotvec.data[cell];
+        m_rotmat[3 * cell] = make_double3(cos_a + r.x * r.x * one_minus_cos_a,
+                                          r.x * r.y * one_minus_cos_a - sin_a * r.z,
+                                          r.x * r.z * one_minus_cos_a + sin_a * r.y);
+        m_rotmat[3 * cell + 1] = make_double3(r.x * r.y * one_minus_cos_a + sin_a * r.z,
+                                              cos_a + r.y * r.y * one_minus_cos_a,
+                                              r.y * r.z * one_minus_cos_a - sin_a * r.x);
+        m_rotmat[3 * cell + 2] = make_double3(r.x * r.z * one_minus_cos_a - sin_a * r.y,
+                                              r.y * r.z * one_minus_cos_a + sin_a * r.x,
+                                              cos_a + r.z * r.z * one_minus_cos_a);
+        }
+
     for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
         {
         double3 vel;
@@ -209,24 +255,15 @@ void mpcd::SRDCollisionMethod::rotate(uint64_t timestep)
         vel.y -= avg_vel.y;
         vel.z -= avg_vel.z;
 
-        // get rotation vector
-        double3 rot_vec = h_rotvec.data[cell];
-
-        // perform the rotation in double precision
-        // TODO: should we optimize out the matrix construction for the CPU?
-        //       Or, consider using vectorization and/or Eigen?
+        // perform the rotation in double precision, summing the terms in the same order as the
+        // GPU kernel
+        const double3 row_x = m_rotmat[3 * cell];
+        const double3 row_y = m_rotmat[3 * cell + 1];
+        const double3 row_z = m_rotmat[3 * cell + 2];
         double3 new_vel;
-        new_vel.x = (cos_a + rot_vec.x * rot_vec.x * one_minus_cos_a) * vel.x;
-        new_vel.x += (rot_vec.x * rot_vec.y * one_minus_cos_a - sin_a * rot_vec.z) * vel.y;
-        new_vel.x += (rot_vec.x * rot_vec.z * one_minus_cos_a + sin_a * rot_vec.y) * vel.z;
-
-        new_vel.y = (cos_a + rot_vec.y * rot_vec.y * one_minus_cos_a) * vel.y;
-        new_vel.y += (rot_vec.x * rot_vec.y * one_minus_cos_a + sin_a * rot_vec.z) * vel.x;
-        new_vel.y += (rot_vec.y * rot_vec.z * one_minus_cos_a - sin_a * rot_vec.x) * vel.z;
-
-        new_vel.z = (cos_a + rot_vec.z * rot_vec.z * one_minus_cos_a) * vel.z;
-        new_vel.z += (rot_vec.x * rot_vec.z * one_minus_cos_a - sin_a * rot_vec.y) * vel.x;
-        new_vel.z += (rot_vec.y * rot_vec.z * one_minus_cos_a + sin_a * rot_vec.x) * vel.y;
+        new_vel.x = row_x.x * vel.x + row_x.y * vel.y + row_x.z * vel.z;
+        new_vel.y = row_y.y * vel.y + row_y.x * vel.x + row_y.z * vel.z;
+        new_vel.z = row_z.z * vel.z + row_z.x * vel.x + row_z.y * vel.y;
 
         // rescale the temperature if thermostatting is enabled
         if (use_thermostat)
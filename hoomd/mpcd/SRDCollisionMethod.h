@@ -94,6 +94,10 @@ class PYBIND11_EXPORT SRDCollisionMethod : public mpcd::CollisionMethod
 
     std::shared_ptr<Variant> m_T; //!< Temperature for thermostat
     GPUVector<double> m_factors;  //!< Cell-level rescale factors
+    std::vector<double3> m_rotmat; //!< Rows of the rotation matrix of each cell (CPU only)
+
+    bool m_rotvec_drawn;        //!< True if the rotation vectors were drawn during the thermo
+    uint64_t m_rotvec_timestep; //!< Timestep the rotation vectors were drawn during the thermo
 
     //! Implementation of the collision rule
     virtual void rule(uint64_t timestep);
@@ -101,6 +105,9 @@ class PYBIND11_EXPORT SRDCollisionMethod : public mpcd::CollisionMethod
     //! Randomly draw cell rotation vectors
     virtual void drawRotationVectors(uint64_t timestep);
 
+    //! Draw the cell rotation vectors while the cell properties are communicated
+    void drawRotationVectorsOverlapped(uint64_t timestep);
+
     //! Apply rotation matrix to velocities
     virtual void rotate(uint64_t timestep);
     };
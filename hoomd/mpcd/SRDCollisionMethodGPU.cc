@@ -21,132 +21,116 @@ mpcd::SRDCollisionMethodGPU::SRDCollisionMethodGPU(std::shared_ptr<mpcd::SystemD
                                                    std::shared_ptr<mpcd::CellThermoCompute> thermo)
     : mpcd::SRDCollisionMethod(sysdata, cur_timestep, period, phase, seed, thermo)
     {
-    m_tuner_rotvec.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_srd_vec", m_exec_conf));
-    m_tuner_rotate.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_srd_rotate", m_exec_conf));
+    // construct a range of valid tuner parameters using the block size and number of threads per
+    // cell
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    std::vector<unsigned int> valid_params;
+    for (unsigned int block_size = warp_size; block_size <= 1024; block_size += warp_size)
+        {
+        for (auto s : Autotuner::getTppListPow2(warp_size))
+            {
+            valid_params.push_back(block_size * 10000 + s);
+            }
+        }
+
+    m_tuner_collide.reset(new Autotuner(valid_params, 5, 100000, "mpcd_srd_collide", m_exec_conf));
+
+    // the rotation vectors are drawn in the collision kernel
+    m_thermo->getCallbackSignal()
+        .disconnect<mpcd::SRDCollisionMethod,
+                    &mpcd::SRDCollisionMethodGPU::drawRotationVectorsOverlapped>(this);
     }
 
-void mpcd::SRDCollisionMethodGPU::drawRotationVectors(uint64_t timestep)
+void mpcd::SRDCollisionMethodGPU::rule(uint64_t timestep)
     {
-    ArrayHandle<double3> d_rotvec(m_rotvec, access_location::device, access_mode::overwrite);
-
-    uint16_t seed = m_sysdef->getSeed();
+    m_thermo->compute(timestep);
 
+    if (m_prof)
+        m_prof->push(m_exec_conf, "MPCD collide");
+    // resize the rotation vectors and rescale factors
+    m_rotvec.resize(m_cl->getNCells());
     if (m_T)
         {
-        ArrayHandle<double> d_factors(m_factors, access_location::device, access_mode::overwrite);
-        ArrayHandle<double3> d_cell_energy(m_thermo->getCellEnergies(),
-                                           access_location::device,
-                                           access_mode::read);
-
-        m_tuner_rotvec->begin();
-        mpcd::gpu::srd_draw_vectors(d_rotvec.data,
-                                    d_factors.data,
-                                    d_cell_energy.data,
-                                    m_cl->getCellIndexer(),
-                                    m_cl->getOriginIndex(),
-                                    m_cl->getGlobalDim(),
-                                    m_cl->getGlobalCellIndexer(),
-                                    timestep,
-                                    seed,
-                                    (*m_T)(timestep),
-                                    m_sysdef->getNDimensions(),
-                                    m_tuner_rotvec->getParam());
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
-        m_tuner_rotvec->end();
-        }
-    else
-        {
-        m_tuner_rotvec->begin();
-        mpcd::gpu::srd_draw_vectors(d_rotvec.data,
-                                    NULL,
-                                    NULL,
-                                    m_cl->getCellIndexer(),
-                                    m_cl->getOriginIndex(),
-                                    m_cl->getGlobalDim(),
-                                    m_cl->getGlobalCellIndexer(),
-                                    timestep,
-                                    seed,
-                                    1.0,
-                                    m_sysdef->getNDimensions(),
-                                    m_tuner_rotvec->getParam());
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
-        m_tuner_rotvec->end();
+        m_factors.resize(m_cl->getNCells());
         }
-    }
 
-void mpcd::SRDCollisionMethodGPU::rotate(uint64_t timestep)
-    {
     // acquire MPCD particle data
     ArrayHandle<Scalar4> d_vel(m_mpcd_pdata->getVelocities(),
                                access_location::device,
                                access_mode::readwrite);
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
-    unsigned int N_tot = N_mpcd;
 
-    // acquire cell velocities and rotation vectors
+    // acquire cell list and cell properties
+    ArrayHandle<unsigned int> d_cell_np(m_cl->getCellSizeArray(),
+                                        access_location::device,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> d_cell_list(m_cl->getCellList(),
+                                          access_location::device,
+                                          access_mode::read);
     ArrayHandle<double4> d_cell_vel(m_thermo->getCellVelocities(),
                                     access_location::device,
                                     access_mode::read);
-    ArrayHandle<double3> d_rotvec(m_rotvec, access_location::device, access_mode::read);
+    ArrayHandle<double3> d_rotvec(m_rotvec, access_location::device, access_mode::overwrite);
 
-    // load scale factors if required
+    // load cell energies and scale factors if required
+    std::unique_ptr<ArrayHandle<double3>> d_cell_energy;
     std::unique_ptr<ArrayHandle<double>> d_factors;
+    Scalar T_set(1.0);
     if (m_T)
         {
+        d_cell_energy.reset(new ArrayHandle<double3>(m_thermo->getCellEnergies(),
+                                                     access_location::device,
+                                                     access_mode::read));
         d_factors.reset(
-            new ArrayHandle<double>(m_factors, access_location::device, access_mode::read));
+            new ArrayHandle<double>(m_factors, access_location::device, access_mode::overwrite));
+        T_set = (*m_T)(timestep);
         }
 
-    if (m_embed_group)
+    // embedded particles are indexed through the cell list, in the order of its group
+    std::unique_ptr<ArrayHandle<Scalar4>> d_vel_embed;
+    std::unique_ptr<ArrayHandle<unsigned int>> d_embed_idx;
+    if (m_cl->getEmbeddedGroup())
         {
-        ArrayHandle<unsigned int> d_embed_group(m_embed_group->getIndexArray(),
-                                                access_location::device,
-                                                access_mode::read);
-        ArrayHandle<Scalar4> d_vel_embed(m_pdata->getVelocities(),
-                                         access_location::device,
-                                         access_mode::readwrite);
-        ArrayHandle<unsigned int> d_embed_cell_ids(m_cl->getEmbeddedGroupCellIds(),
+        d_vel_embed.reset(new ArrayHandle<Scalar4>(m_pdata->getVelocities(),
                                                    access_location::device,
-                                                   access_mode::read);
-
-        N_tot += m_embed_group->getNumMembers();
-
-        m_tuner_rotate->begin();
-        mpcd::gpu::srd_rotate(d_vel.data,
-                              d_vel_embed.data,
-                              d_embed_group.data,
-                              d_embed_cell_ids.data,
-                              d_cell_vel.data,
-                              d_rotvec.data,
-                              m_angle,
-                              (m_T) ? d_factors->data : NULL,
-                              N_mpcd,
-                              N_tot,
-                              m_tuner_rotate->getParam());
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
-        m_tuner_rotate->end();
-        }
-    else
-        {
-        m_tuner_rotate->begin();
-        mpcd::gpu::srd_rotate(d_vel.data,
-                              NULL,
-                              NULL,
-                              NULL,
-                              d_cell_vel.data,
-                              d_rotvec.data,
-                              m_angle,
-                              (m_T) ? d_factors->data : NULL,
-                              N_mpcd,
-                              N_tot,
-                              m_tuner_rotate->getParam());
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
-        m_tuner_rotate->end();
+                                                   access_mode::readwrite));
+        d_embed_idx.reset(
+            new ArrayHandle<unsigned int>(m_cl->getEmbeddedGroup()->getIndexArray(),
+                                          access_location::device,
+                                          access_mode::read));
         }
+
+    mpcd::detail::srd_collide_args_t args(d_vel.data,
+                                          (d_vel_embed) ? d_vel_embed->data : NULL,
+                                          (d_embed_idx) ? d_embed_idx->data : NULL,
+                                          d_rotvec.data,
+                                          (m_T) ? d_factors->data : NULL,
+                                          d_cell_vel.data,
+                                          (m_T) ? d_cell_energy->data : NULL,
+                                          d_cell_np.data,
+                                          d_cell_list.data,
+                                          m_cl->getCellListIndexer(),
+                                          m_cl->getCellIndexer(),
+                                          m_cl->getOriginIndex(),
+                                          m_cl->getGlobalDim(),
+                                          m_cl->getGlobalCellIndexer(),
+                                          timestep,
+                                          m_sysdef->getSeed(),
+                                          T_set,
+                                          m_sysdef->getNDimensions(),
+                                          N_mpcd);
+
+    m_tuner_collide->begin();
+    const unsigned int param = m_tuner_collide->getParam();
+    const unsigned int block_size = param / 10000;
+    const unsigned int tpp = param % 10000;
+    mpcd::gpu::srd_collide(args, m_angle, block_size, tpp);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner_collide->end();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
     }
 
 /*!
@@ -11,6 +11,7 @@
 #include "SRDCollisionMethodGPU.cuh"
 #include "hoomd/RNGIdentifiers.h"
 #include "hoomd/RandomNumbers.h"
+#include "hoomd/WarpTools.cuh"
 
 namespace hoomd
     {
@@ -20,272 +21,276 @@ namespace gpu
     {
 namespace kernel
     {
-template<bool use_thermostat>
-__global__ void srd_draw_vectors(double3* d_rotvec,
-                                 double* d_factors,
-                                 const double3* d_cell_energy,
-                                 const Index3D ci,
-                                 const int3 origin,
-                                 const uint3 global_dim,
-                                 const Index3D global_ci,
-                                 const uint64_t timestep,
-                                 const uint16_t seed,
-                                 const Scalar T_set,
-                                 const unsigned int n_dimensions,
-                                 const unsigned int Ncell)
+//! Draw the cell rotation vectors and rotate the particle velocities in one pass
+/*!
+ * \param args Common arguments to the collision kernel
+ * \param cos_a Cosine of the rotation angle
+ * \param one_minus_cos_a One minus the cosine of the rotation angle
+ * \param sin_a Sine of the rotation angle
+ *
+ * \tparam use_thermostat If true, also draw the cell-level rescale factors
+ * \tparam tpp Number of threads to use per cell
+ *
+ * \b Implementation details:
+ * Using \a tpp threads per cell, the first thread of each cell draws the rotation vector (and
+ * rescale factor) and broadcasts it to the other threads, which then rotate the velocities of
+ * the particles in the cell list. The rotation vectors and factors are still written to global
+ * memory so that they are available after the collision, but they are not read back.
+ */
+template<bool use_thermostat, unsigned int tpp>
+__global__ void srd_collide(const mpcd::detail::srd_collide_args_t args,
+                            const double cos_a,
+                            const double one_minus_cos_a,
+                            const double sin_a)
     {
-    // one thread per cell
-    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-    if (idx >= Ncell)
+    // tpp threads per cell
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= tpp * args.Ncell)
         return;
+    const unsigned int cell_id = idx / tpp;
+    const unsigned int lane = idx % tpp;
 
-    // get local cell triple from 1d index
-    const uint3 cell = ci.getTriple(idx);
-    // shift local cell by local origin, and wrap through global boundaries
-    int3 global_cell
-        = make_int3(origin.x + (int)cell.x, origin.y + (int)cell.y, origin.z + (int)cell.z);
-    if (global_cell.x >= (int)global_dim.x)
-        global_cell.x -= global_dim.x;
-    else if (global_cell.x < 0)
-        global_cell.x += global_dim.x;
-
-    if (global_cell.y >= (int)global_dim.y)
-        global_cell.y -= global_dim.y;
-    else if (global_cell.y < 0)
-        global_cell.y += global_dim.y;
-
-    if (global_cell.z >= (int)global_dim.z)
-        global_cell.z -= global_dim.z;
-    else if (global_cell.z < 0)
-        global_cell.z += global_dim.z;
-
-    // convert global triple to 1d global index
-    const unsigned int global_idx = global_ci(global_cell.x, global_cell.y, global_cell.z);
-
-    // Initialize the PRNG using the cell index, timestep, and seed for the hash
-    hoomd::RandomGenerator rng(
-        hoomd::Seed(hoomd::RNGIdentifier::SRDCollisionMethod, timestep, seed),
-        hoomd::Counter(global_idx));
-
-    // draw rotation vector off the surface of the sphere
-    double3 rotvec;
-    hoomd::SpherePointGenerator<double> sphgen;
-    sphgen(rng, rotvec);
-    d_rotvec[idx] = rotvec;
-
-    if (use_thermostat)
+    double3 rot_vec = make_double3(0.0, 0.0, 0.0);
+    double factor = 1.0;
+    if (lane == 0)
         {
-        const double3 cell_energy = d_cell_energy[idx];
-        const unsigned int np = __double_as_int(cell_energy.z);
-        double factor = 1.0;
-        if (np > 1)
+        // get local cell triple from 1d index
+        const uint3 cell = args.ci.getTriple(cell_id);
+        // shift local cell by local origin, and wrap through global boundaries
+        int3 global_cell = make_int3(args.origin.x + (int)cell.x,
+                                     args.origin.y + (int)cell.y,
+                                     args.origin.z + (int)cell.z);
+        if (global_cell.x >= (int)args.global_dim.x)
+            global_cell.x -= args.global_dim.x;
+        else if (global_cell.x < 0)
+            global_cell.x += args.global_dim.x;
+
+        if (global_cell.y >= (int)args.global_dim.y)
+            global_cell.y -= args.global_dim.y;
+        else if (global_cell.y < 0)
+            global_cell.y += args.global_dim.y;
+
+        if (global_cell.z >= (int)args.global_dim.z)
+            global_cell.z -= args.global_dim.z;
+        else if (global_cell.z < 0)
+            global_cell.z += args.global_dim.z;
+
+        // convert global triple to 1d global index
+        const unsigned int global_idx
+            = args.global_ci(global_cell.x, global_cell.y, global_cell.z);
+
+        // Initialize the PRNG using the cell index, timestep, and seed for the hash
+        hoomd::RandomGenerator rng(
+            hoomd::Seed(hoomd::RNGIdentifier::SRDCollisionMethod, args.timestep, args.seed),
+            hoomd::Counter(global_idx));
+
+        // draw rotation vector off the surface of the sphere
+        hoomd::SpherePointGenerator<double> sphgen;
+        sphgen(rng, rot_vec);
+        args.rotvec[cell_id] = rot_vec;
+
+        if (use_thermostat)
             {
-            // the total number of degrees of freedom in the cell divided by 2
-            const double alpha = n_dimensions * (np - 1) / (double)2.;
-
-            // draw a random kinetic energy for the cell at the set temperature
-            hoomd::GammaDistribution<double> gamma_gen(alpha, T_set);
-            const double rand_ke = gamma_gen(rng);
-
-            // generate the scale factor from the current temperature
-            // (don't use the kinetic energy of this cell, since this
-            // is total not relative to COM)
-            const double cur_ke = alpha * cell_energy.y;
-            factor = (cur_ke > 0.) ? fast::sqrt(rand_ke / cur_ke) : 1.;
+            const double3 cell_energy = args.cell_energy[cell_id];
+            const unsigned int np = __double_as_int(cell_energy.z);
+            if (np > 1)
+                {
+                // the total number of degrees of freedom in the cell divided by 2
+                const double alpha = args.n_dimensions * (np - 1) / (double)2.;
+
+                // draw a random kinetic energy for the cell at the set temperature
+                hoomd::GammaDistribution<double> gamma_gen(alpha, args.T_set);
+                const double rand_ke = gamma_gen(rng);
+
+                // generate the scale factor from the current temperature
+                // (don't use the kinetic energy of this cell, since this
+                // is total not relative to COM)
+                const double cur_ke = alpha * cell_energy.y;
+                factor = (cur_ke > 0.) ? fast::sqrt(rand_ke / cur_ke) : 1.;
+                }
+            args.factors[cell_id] = factor;
             }
-        d_factors[idx] = factor;
         }
-    }
-__global__ void srd_rotate(Scalar4* d_vel,
-                           Scalar4* d_vel_embed,
-                           const unsigned int* d_embed_group,
-                           const unsigned int* d_embed_cell_ids,
-                           const double4* d_cell_vel,
-                           const double3* d_rotvec,
-                           const double cos_a,
-                           const double one_minus_cos_a,
-                           const double sin_a,
-                           const double* d_factors,
-                           const unsigned int N_mpcd,
-                           const unsigned int N_tot)
-    {
-    // one thread per particle
-    unsigned int tid = blockIdx.x * blockDim.x + threadIdx.x;
-    if (tid >= N_tot)
-        return;
 
-    // load particle data
-    double3 vel;
-    unsigned int cell;
-    // these properties are needed for the embedded particles only
-    unsigned int idx(0);
-    double mass(0);
-    if (tid < N_mpcd)
+    // share the rotation with the other threads of the cell
+    if (tpp > 1)
         {
-        const Scalar4 vel_cell = d_vel[tid];
-        vel = make_double3(vel_cell.x, vel_cell.y, vel_cell.z);
-        cell = __scalar_as_int(vel_cell.w);
-        }
-    else
-        {
-        idx = d_embed_group[tid - N_mpcd];
-
-        const Scalar4 vel_mass = d_vel_embed[idx];
-        vel = make_double3(vel_mass.x, vel_mass.y, vel_mass.z);
-        mass = vel_mass.w;
-        cell = d_embed_cell_ids[tid - N_mpcd];
+        hoomd::detail::WarpScan<double, tpp> scanner;
+        rot_vec.x = scanner.Broadcast(rot_vec.x, 0);
+        rot_vec.y = scanner.Broadcast(rot_vec.y, 0);
+        rot_vec.z = scanner.Broadcast(rot_vec.z, 0);
+        if (use_thermostat)
+            factor = scanner.Broadcast(factor, 0);
         }
 
-    // subtract average velocity
-    const double4 avg_vel = d_cell_vel[cell];
-    vel.x -= avg_vel.x;
-    vel.y -= avg_vel.y;
-    vel.z -= avg_vel.z;
-
-    // get rotation vector
-    double3 rot_vec = d_rotvec[cell];
+    // build the rotation matrix once for all the particles this thread handles
+    const double3 row_x = make_double3(cos_a + rot_vec.x * rot_vec.x * one_minus_cos_a,
+                                       rot_vec.x * rot_vec.y * one_minus_cos_a - sin_a * rot_vec.z,
+                                       rot_vec.x * rot_vec.z * one_minus_cos_a + sin_a * rot_vec.y);
+    const double3 row_y = make_double3(rot_vec.x * rot_vec.y * one_minus_cos_a + sin_a * rot_vec.z,
+                                       cos_a + rot_vec.y * rot_vec.y * one_minus_cos_a,
+                                       rot_vec.y * rot_vec.z * one_minus_cos_a - sin_a * rot_vec.x);
+    const double3 row_z = make_double3(rot_vec.x * rot_vec.z * one_minus_cos_a - sin_a * rot_vec.y,
+                                       rot_vec.y * rot_vec.z * one_minus_cos_a + sin_a * rot_vec.x,
+                                       cos_a + rot_vec.z * rot_vec.z * one_minus_cos_a);
+
+    const double4 avg_vel = args.cell_vel[cell_id];
+    const unsigned int np = args.cell_np[cell_id];
+    for (unsigned int offset = lane; offset < np; offset += tpp)
+        {
+        // load particle data
+        const unsigned int cur_p = args.cell_list[args.cli(offset, cell_id)];
+        double3 vel;
+        // these properties are needed for the embedded particles only
+        unsigned int embed_idx(0);
+        double mass(0);
+        if (cur_p < args.N_mpcd)
+            {
+            const Scalar4 vel_cell = args.vel[cur_p];
+            vel = make_double3(vel_cell.x, vel_cell.y, vel_cell.z);
+            }
+        else
+            {
+            embed_idx = args.embed_idx[cur_p - args.N_mpcd];
 
-    // perform the rotation in double precision
-    double3 new_vel;
-    new_vel.x = (cos_a + rot_vec.x * rot_vec.x * one_minus_cos_a) * vel.x;
-    new_vel.x += (rot_vec.x * rot_vec.y * one_minus_cos_a - sin_a * rot_vec.z) * vel.y;
-    new_vel.x += (rot_vec.x * rot_vec.z * one_minus_cos_a + sin_a * rot_vec.y) * vel.z;
+            const Scalar4 vel_mass = args.embed_vel[embed_idx];
+            vel = make_double3(vel_mass.x, vel_mass.y, vel_mass.z);
+            mass = vel_mass.w;
+            }
 
-    new_vel.y = (cos_a + rot_vec.y * rot_vec.y * one_minus_cos_a) * vel.y;
-    new_vel.y += (rot_vec.x * rot_vec.y * one_minus_cos_a + sin_a * rot_vec.z) * vel.x;
-    new_vel.y += (rot_vec.y * rot_vec.z * one_minus_cos_a - sin_a * rot_vec.x) * vel.z;
+        // subtract average velocity
+        vel.x -= avg_vel.x;
+        vel.y -= avg_vel.y;
+        vel.z -= avg_vel.z;
 
-    new_vel.z = (cos_a + rot_vec.z * rot_vec.z * one_minus_cos_a) * vel.z;
-    new_vel.z += (rot_vec.x * rot_vec.z * one_minus_cos_a - sin_a * rot_vec.y) * vel.x;
-    new_vel.z += (rot_vec.y * rot_vec.z * one_minus_cos_a + sin_a * rot_vec.x) * vel.y;
+        // perform the rotation in double precision
+        double3 new_vel;
+        new_vel.x = row_x.x * vel.x + row_x.y * vel.y + row_x.z * vel.z;
+        new_vel.y = row_y.y * vel.y + row_y.x * vel.x + row_y.z * vel.z;
+        new_vel.z = row_z.z * vel.z + row_z.x * vel.x + row_z.y * vel.y;
 
-    // rescale the velocity if factor is available
-    if (d_factors != NULL)
-        {
-        const double factor = d_factors[cell];
-        new_vel.x *= factor;
-        new_vel.y *= factor;
-        new_vel.z *= factor;
-        }
+        // rescale the velocity if thermostatting is enabled
+        if (use_thermostat)
+            {
+            new_vel.x *= factor;
+            new_vel.y *= factor;
+            new_vel.z *= factor;
+            }
 
-    new_vel.x += avg_vel.x;
-    new_vel.y += avg_vel.y;
-    new_vel.z += avg_vel.z;
+        new_vel.x += avg_vel.x;
+        new_vel.y += avg_vel.y;
+        new_vel.z += avg_vel.z;
 
-    // set the new velocity
-    if (tid < N_mpcd)
-        {
-        d_vel[tid] = make_scalar4(new_vel.x, new_vel.y, new_vel.z, __int_as_scalar(cell));
-        }
-    else
-        {
-        d_vel_embed[idx] = make_scalar4(new_vel.x, new_vel.y, new_vel.z, mass);
+        // set the new velocity
+        if (cur_p < args.N_mpcd)
+            {
+            args.vel[cur_p]
+                = make_scalar4(new_vel.x, new_vel.y, new_vel.z, __int_as_scalar(cell_id));
+            }
+        else
+            {
+            args.embed_vel[embed_idx] = make_scalar4(new_vel.x, new_vel.y, new_vel.z, mass);
+            }
         }
     }
     } // end namespace kernel
 
-cudaError_t srd_draw_vectors(double3* d_rotvec,
-                             double* d_factors,
-                             const double3* d_cell_energy,
-                             const Index3D& ci,
-                             const int3 origin,
-                             const uint3 global_dim,
-                             const Index3D& global_ci,
-                             const uint64_t timestep,
-                             const uint16_t seed,
-                             const Scalar T_set,
-                             const unsigned int n_dimensions,
-                             const unsigned int block_size)
+//! Launcher for the SRD collision kernel
+/*!
+ * \param args Common arguments to the collision kernel
+ * \param cos_a Cosine of the rotation angle
+ * \param one_minus_cos_a One minus the cosine of the rotation angle
+ * \param sin_a Sine of the rotation angle
+ * \param block_size Number of threads per block
+ * \param tpp Number of threads per cell
+ *
+ * \tparam cur_tpp Number of threads-per-cell for this template instantiation
+ *
+ * Launchers are recursively instantiated at compile-time in order to match the
+ * correct number of threads at runtime. If the templated number of threads matches
+ * the runtime number of threads, then the kernel is launched. Otherwise, the
+ * next template (with threads reduced by a factor of 2) is launched. This
+ * recursion is broken by a specialized template for 0 threads, which does no
+ * work.
+ */
+template<unsigned int cur_tpp>
+inline void launch_srd_collide(const mpcd::detail::srd_collide_args_t& args,
+                               const double cos_a,
+                               const double one_minus_cos_a,
+                               const double sin_a,
+                               const unsigned int block_size,
+                               const unsigned int tpp)
     {
-    if (d_factors != NULL)
+    if (cur_tpp == tpp)
         {
-        unsigned int max_block_thermostat;
-        cudaFuncAttributes attr;
-        cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::srd_draw_vectors<true>);
-        max_block_thermostat = attr.maxThreadsPerBlock;
-
-        unsigned int run_block_size = min(block_size, max_block_thermostat);
-
-        const unsigned int Ncell = ci.getNumElements();
-        dim3 grid(Ncell / run_block_size + 1);
-        mpcd::gpu::kernel::srd_draw_vectors<true><<<grid, run_block_size>>>(d_rotvec,
-                                                                            d_factors,
-                                                                            d_cell_energy,
-                                                                            ci,
-                                                                            origin,
-                                                                            global_dim,
-                                                                            global_ci,
-                                                                            timestep,
-                                                                            seed,
-                                                                            T_set,
-                                                                            n_dimensions,
-                                                                            Ncell);
+        if (args.factors != NULL)
+            {
+            unsigned int max_block_thermostat;
+            cudaFuncAttributes attr;
+            cudaFuncGetAttributes(&attr,
+                                  (const void*)mpcd::gpu::kernel::srd_collide<true, cur_tpp>);
+            max_block_thermostat = attr.maxThreadsPerBlock;
+
+            unsigned int run_block_size = min(block_size, max_block_thermostat);
+            dim3 grid(cur_tpp * args.Ncell / run_block_size + 1);
+            mpcd::gpu::kernel::srd_collide<true, cur_tpp>
+                <<<grid, run_block_size>>>(args, cos_a, one_minus_cos_a, sin_a);
+            }
+        else
+            {
+            unsigned int max_block_nothermostat;
+            cudaFuncAttributes attr;
+            cudaFuncGetAttributes(&attr,
+                                  (const void*)mpcd::gpu::kernel::srd_collide<false, cur_tpp>);
+            max_block_nothermostat = attr.maxThreadsPerBlock;
+
+            unsigned int run_block_size = min(block_size, max_block_nothermostat);
+            dim3 grid(cur_tpp * args.Ncell / run_block_size + 1);
+            mpcd::gpu::kernel::srd_collide<false, cur_tpp>
+                <<<grid, run_block_size>>>(args, cos_a, one_minus_cos_a, sin_a);
+            }
         }
     else
         {
-        unsigned int max_block_nothermostat;
-        cudaFuncAttributes attr;
-        cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::srd_draw_vectors<false>);
-        max_block_nothermostat = attr.maxThreadsPerBlock;
-
-        unsigned int run_block_size = min(block_size, max_block_nothermostat);
-
-        const unsigned int Ncell = ci.getNumElements();
-        dim3 grid(Ncell / run_block_size + 1);
-        mpcd::gpu::kernel::srd_draw_vectors<false><<<grid, run_block_size>>>(d_rotvec,
-                                                                             d_factors,
-                                                                             d_cell_energy,
-                                                                             ci,
-                                                                             origin,
-                                                                             global_dim,
-                                                                             global_ci,
-                                                                             timestep,
-                                                                             seed,
-                                                                             T_set,
-                                                                             n_dimensions,
-                                                                             Ncell);
+        launch_srd_collide<cur_tpp / 2>(args, cos_a, one_minus_cos_a, sin_a, block_size, tpp);
         }
-
-    return cudaSuccess;
+    }
+//! Template specialization to break recursion
+template<>
+inline void launch_srd_collide<0>(const mpcd::detail::srd_collide_args_t& args,
+                                  const double cos_a,
+                                  const double one_minus_cos_a,
+                                  const double sin_a,
+                                  const unsigned int block_size,
+                                  const unsigned int tpp)
+    {
     }
 
-cudaError_t srd_rotate(Scalar4* d_vel,
-                       Scalar4* d_vel_embed,
-                       const unsigned int* d_embed_group,
-                       const unsigned int* d_embed_cell_ids,
-                       const double4* d_cell_vel,
-                       const double3* d_rotvec,
-                       const double angle,
-                       const double* d_factors,
-                       const unsigned int N_mpcd,
-                       const unsigned int N_tot,
-                       const unsigned int block_size)
+/*!
+ * \param args Common arguments to the collision kernel
+ * \param angle Rotation angle (radians)
+ * \param block_size Number of threads per block
+ * \param tpp Number of threads per cell
+ *
+ * \returns cudaSuccess on completion
+ *
+ * \sa mpcd::gpu::launch_srd_collide
+ * \sa mpcd::gpu::kernel::srd_collide
+ */
+cudaError_t srd_collide(const mpcd::detail::srd_collide_args_t& args,
+                        const double angle,
+                        const unsigned int block_size,
+                        const unsigned int tpp)
     {
-    unsigned int max_block_size;
-    cudaFuncAttributes attr;
-    cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::srd_rotate);
-    max_block_size = attr.maxThreadsPerBlock;
+    if (args.Ncell == 0)
+        return cudaSuccess;
 
     // precompute angles for rotation
     const double cos_a = slow::cos(angle);
     const double one_minus_cos_a = 1.0 - cos_a;
     const double sin_a = slow::sin(angle);
 
-    unsigned int run_block_size = min(block_size, max_block_size);
-    dim3 grid(N_tot / run_block_size + 1);
-    mpcd::gpu::kernel::srd_rotate<<<grid, run_block_size>>>(d_vel,
-                                                            d_vel_embed,
-                                                            d_embed_group,
-                                                            d_embed_cell_ids,
-                                                            d_cell_vel,
-                                                            d_rotvec,
-                                                            cos_a,
-                                                            one_minus_cos_a,
-                                                            sin_a,
-                                                            d_factors,
-                                                            N_mpcd,
-                                                            N_tot);
-
+    launch_srd_collide<32>(args, cos_a, one_minus_cos_a, sin_a, block_size, tpp);
     return cudaSuccess;
     }
 
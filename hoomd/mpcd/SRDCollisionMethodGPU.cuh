@@ -20,32 +20,70 @@ namespace hoomd
     {
 namespace mpcd
     {
+namespace detail
+    {
+//! Convenience struct for the parameters passed to the SRD collision kernel
+struct srd_collide_args_t
+    {
+    srd_collide_args_t(Scalar4* vel_,
+                       Scalar4* embed_vel_,
+                       const unsigned int* embed_idx_,
+                       double3* rotvec_,
+                       double* factors_,
+                       const double4* cell_vel_,
+                       const double3* cell_energy_,
+                       const unsigned int* cell_np_,
+                       const unsigned int* cell_list_,
+                       const Index2D& cli_,
+                       const Index3D& ci_,
+                       const int3 origin_,
+                       const uint3 global_dim_,
+                       const Index3D& global_ci_,
+                       const uint64_t timestep_,
+                       const uint16_t seed_,
+                       const Scalar T_set_,
+                       const unsigned int n_dimensions_,
+                       const unsigned int N_mpcd_)
+        : vel(vel_), embed_vel(embed_vel_), embed_idx(embed_idx_), rotvec(rotvec_),
+          factors(factors_), cell_vel(cell_vel_), cell_energy(cell_energy_), cell_np(cell_np_),
+          cell_list(cell_list_), cli(cli_), ci(ci_), origin(origin_), global_dim(global_dim_),
+          global_ci(global_ci_), timestep(timestep_), seed(seed_), T_set(T_set_),
+          n_dimensions(n_dimensions_), N_mpcd(N_mpcd_), Ncell(ci_.getNumElements())
+        {
+        }
+
+    Scalar4* vel;                  //!< MPCD particle velocities
+    Scalar4* embed_vel;            //!< Embedded particle velocities
+    const unsigned int* embed_idx; //!< Embedded particle indexes
+    double3* rotvec;               //!< Cell rotation vectors (output)
+    double* factors;               //!< Cell rescale factors (output), NULL without thermostat
+
+    const double4* cell_vel;       //!< Cell velocities
+    const double3* cell_energy;    //!< Cell energies
+    const unsigned int* cell_np;   //!< Number of particles per cell
+    const unsigned int* cell_list; //!< MPCD cell list
+    const Index2D cli;             //!< MPCD cell list indexer
+
+    const Index3D ci;                //!< Local cell indexer
+    const int3 origin;               //!< Global index of the local origin cell
+    const uint3 global_dim;          //!< Global cell dimensions
+    const Index3D global_ci;         //!< Global cell indexer
+    const uint64_t timestep;         //!< Current timestep
+    const uint16_t seed;             //!< Seed for the random number generator
+    const Scalar T_set;              //!< Thermostat temperature
+    const unsigned int n_dimensions; //!< Number of dimensions
+    const unsigned int N_mpcd;       //!< Number of MPCD particles
+    const unsigned int Ncell;        //!< Number of local cells
+    };
+    } // end namespace detail
+
 namespace gpu
     {
-cudaError_t srd_draw_vectors(double3* d_rotvec,
-                             double* d_factors,
-                             const double3* d_cell_energy,
-                             const Index3D& ci,
-                             const int3 origin,
-                             const uint3 global_dim,
-                             const Index3D& global_ci,
-                             const uint64_t timestep,
-                             const uint16_t seed,
-                             const Scalar T_set,
-                             const unsigned int n_dimensions,
-                             const unsigned int block_size);
-
-cudaError_t srd_rotate(Scalar4* d_vel,
-                       Scalar4* d_vel_embed,
-                       const unsigned int* d_embed_group,
-                       const unsigned int* d_embed_cell_ids,
-                       const double4* d_cell_vel,
-                       const double3* d_rotvec,
-                       const double angle,
-                       const double* d_factors,
-                       const unsigned int N_mpcd,
-                       const unsigned int N_tot,
-                       const unsigned int block_size);
+//! Kernel driver to draw the rotation vectors and apply the SRD collision rule
+cudaError_t srd_collide(const mpcd::detail::srd_collide_args_t& args,
+                        const double angle,
+                        const unsigned int block_size,
+                        const unsigned int tpp);
 
     }  // end namespace gpu
     }  // end namespace mpcd
@@ -42,22 +42,19 @@ class PYBIND11_EXPORT SRDCollisionMethodGPU : public mpcd::SRDCollisionMethod
         {
         mpcd::SRDCollisionMethod::setAutotunerParams(enable, period);
 
-        m_tuner_rotvec->setPeriod(period);
-        m_tuner_rotvec->setEnabled(enable);
-        m_tuner_rotate->setPeriod(period);
-        m_tuner_rotate->setEnabled(enable);
+        m_tuner_collide->setPeriod(period);
+        m_tuner_collide->setEnabled(enable);
         }
 
     protected:
-    //! Randomly draw cell rotation vectors
-    virtual void drawRotationVectors(uint64_t timestep);
-
-    //! Apply rotation matrix to velocities
-    virtual void rotate(uint64_t timestep);
+    //! Implementation of the collision rule
+    /*!
+     * The rotation vectors are drawn and applied to the velocities in a single kernel.
+     */
+    virtual void rule(uint64_t timestep);
 
     private:
-    std::unique_ptr<Autotuner> m_tuner_rotvec; //!< Tuner for drawing rotation vectors
-    std::unique_ptr<Autotuner> m_tuner_rotate; //!< Tuner for rotating velocities
+    std::unique_ptr<Autotuner> m_tuner_collide; //!< Tuner for the collision kernel
     };
 
 namespace detail
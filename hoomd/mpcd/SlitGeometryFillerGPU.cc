@@ -21,7 +21,9 @@ mpcd::SlitGeometryFillerGPU::SlitGeometryFillerGPU(
     std::shared_ptr<const mpcd::detail::SlitGeometry> geom)
     : mpcd::SlitGeometryFiller(sysdata, density, type, T, geom)
     {
-    m_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_slit_filler", m_exec_conf));
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_slit_filler", m_exec_conf));
     }
 
 /*!
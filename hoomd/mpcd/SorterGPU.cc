@@ -19,20 +19,25 @@ namespace hoomd
 mpcd::SorterGPU::SorterGPU(std::shared_ptr<mpcd::SystemData> sysdata,
                            unsigned int cur_timestep,
                            unsigned int period)
-    : mpcd::Sorter(sysdata, cur_timestep, period)
+    : mpcd::Sorter(sysdata, cur_timestep, period), m_cell_offset(m_exec_conf)
     {
-    m_sentinel_tuner.reset(
-        new Autotuner(32, 1024, 32, 5, 100000, "mpcd_sort_sentinel", m_exec_conf));
-    m_reverse_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_sort_reverse", m_exec_conf));
-    m_apply_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_sort_apply", m_exec_conf));
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_count_tuner.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_sort_count", m_exec_conf));
+    m_order_tuner.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_sort_order", m_exec_conf));
+    m_apply_tuner.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "mpcd_sort_apply", m_exec_conf));
     }
 
 /*!
  * \param timestep Current timestep
  *
- * Performs stream compaction on the GPU of the computed cell list into the order
- * particles appear. This will put the particles into a cell-list order, which
- * should be more friendly for other MPCD cell-based operations.
+ * Generates on the GPU the order the particles appear in the computed cell list.
+ * This will put the particles into a cell-list order, which should be more friendly
+ * for other MPCD cell-based operations. Only the filled entries of each cell are
+ * read: the MPCD particles per cell are counted and scanned into offsets, and then
+ * the order and its reverse are written in one pass over the cells.
  */
 void mpcd::SorterGPU::computeOrder(uint64_t timestep)
     {
@@ -48,62 +53,51 @@ void mpcd::SorterGPU::computeOrder(uint64_t timestep)
         m_prof->push(m_exec_conf, "MPCD sort");
         }
 
-        // fill the empty cell list entries with a sentinel larger than number of MPCD particles
-        {
-        ArrayHandle<unsigned int> d_cell_list(m_cl->getCellList(),
-                                              access_location::device,
-                                              access_mode::readwrite);
-        ArrayHandle<unsigned int> d_cell_np(m_cl->getCellSizeArray(),
-                                            access_location::device,
-                                            access_mode::read);
-
-        m_sentinel_tuner->begin();
-        mpcd::gpu::sort_set_sentinel(d_cell_list.data,
-                                     d_cell_np.data,
-                                     m_cl->getCellListIndexer(),
-                                     0xffffffff,
-                                     m_sentinel_tuner->getParam());
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
-        m_sentinel_tuner->end();
-        }
+    const Index2D& cli = m_cl->getCellListIndexer();
+    m_cell_offset.resize(cli.getH());
 
-        // use thrust to select out the indexes of MPCD particles
-        {
-        ArrayHandle<unsigned int> d_cell_list(m_cl->getCellList(),
-                                              access_location::device,
-                                              access_mode::read);
-        ArrayHandle<unsigned int> d_order(m_order, access_location::device, access_mode::overwrite);
-        const unsigned int num_select
-            = mpcd::gpu::sort_cell_compact(d_order.data,
-                                           d_cell_list.data,
-                                           m_cl->getCellListIndexer().getNumElements(),
-                                           m_mpcd_pdata->getN());
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
-        if (num_select != m_mpcd_pdata->getN())
-            {
-            m_exec_conf->msg->error()
-                << "Error compacting cell list for sorting, lost particles." << std::endl;
-            }
-        }
+    ArrayHandle<unsigned int> d_cell_list(m_cl->getCellList(),
+                                          access_location::device,
+                                          access_mode::read);
+    ArrayHandle<unsigned int> d_cell_np(m_cl->getCellSizeArray(),
+                                        access_location::device,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> d_cell_offset(m_cell_offset,
+                                            access_location::device,
+                                            access_mode::overwrite);
 
-        // fill out the reverse ordering map
-        {
-        ArrayHandle<unsigned int> d_order(m_order, access_location::device, access_mode::read);
-        ArrayHandle<unsigned int> d_rorder(m_rorder,
-                                           access_location::device,
-                                           access_mode::overwrite);
-
-        m_reverse_tuner->begin();
-        mpcd::gpu::sort_gen_reverse(d_rorder.data,
-                                    d_order.data,
-                                    m_mpcd_pdata->getN(),
-                                    m_reverse_tuner->getParam());
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
-        m_reverse_tuner->end();
-        }
+    // count the MPCD particles in each cell and scan the counts into offsets
+    m_count_tuner->begin();
+    mpcd::gpu::sort_count_cells(d_cell_offset.data,
+                                d_cell_list.data,
+                                d_cell_np.data,
+                                cli,
+                                m_mpcd_pdata->getN(),
+                                m_count_tuner->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_count_tuner->end();
+
+    mpcd::gpu::sort_cell_scan(d_cell_offset.data, cli.getH());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    // fill out the ordering map and its reverse
+    ArrayHandle<unsigned int> d_order(m_order, access_location::device, access_mode::overwrite);
+    ArrayHandle<unsigned int> d_rorder(m_rorder, access_location::device, access_mode::overwrite);
+
+    m_order_tuner->begin();
+    mpcd::gpu::sort_cell_order(d_order.data,
+                               d_rorder.data,
+                               d_cell_list.data,
+                               d_cell_np.data,
+                               d_cell_offset.data,
+                               cli,
+                               m_mpcd_pdata->getN(),
+                               m_order_tuner->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_order_tuner->end();
     }
 
 /*!
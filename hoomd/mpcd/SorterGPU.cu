@@ -12,8 +12,8 @@
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
-#include <thrust/copy.h>
 #include <thrust/execution_policy.h>
+#include <thrust/scan.h>
 #pragma GCC diagnostic pop
 
 namespace hoomd
@@ -59,65 +59,89 @@ __global__ void sort_apply(Scalar4* d_pos_alt,
     d_tag_alt[idx] = d_tag[old_idx];
     }
 
-//! Kernel to set the empty-cell-entry sentinel
+//! Kernel to count the MPCD particles in each cell
 /*!
- * \param d_cell_list Cell list to fill in
+ * \param d_cell_offset Number of MPCD particles in each cell (output)
+ * \param d_cell_list Cell list
  * \param d_cell_np Number of particles per cell
  * \param cli Two-dimensional cell-list indexer
- * \param sentinel Value to fill into empty cell-list entries
- * \param N_cli Number of total entries (filled and empty) in the cell list
+ * \param N_mpcd Number of MPCD particles
+ * \param N_cells Number of cells
  *
  * \b Implementation
- * Using one thread per cell-list entry, the 1D kernel index is mapped onto
- * the 2D entry in the cell list. If the current entry is not filled, the entry
- * is filled with the value of \a sentinel. Typically, \a sentinel should be
- * larger than the number of MPCD particles in the system. (A good value would be
- * 0xffffffff). The cell list can subsequently be compacted by mpcd::gpu::sort_cell_compact.
+ * Using one thread per cell, only the filled entries of the cell are read. Virtual and embedded
+ * particles have indexes of at least \a N_mpcd and are not counted.
+ *
+ * The threads of a warp read rows of the cell list that are cli.getW() entries apart, so the reads
+ * of one iteration are not coalesced. A row spans only a few 32 byte sectors, though, and the
+ * later iterations of a thread read the same sectors again through the read-only cache. Each
+ * sector holding filled entries is therefore fetched from memory about once, which is at most
+ * the traffic of the removed sentinel and compaction passes that read every padded entry.
  */
-__global__ void sort_set_sentinel(unsigned int* d_cell_list,
-                                  const unsigned int* d_cell_np,
-                                  const Index2D cli,
-                                  const unsigned int sentinel,
-                                  const unsigned int N_cli)
+__global__ void sort_count_cells(unsigned int* d_cell_offset,
+                                 const unsigned int* d_cell_list,
+                                 const unsigned int* d_cell_np,
+                                 const Index2D cli,
+                                 const unsigned int N_mpcd,
+                                 const unsigned int N_cells)
     {
-    // one thread per cell-list entry
-    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-    if (idx >= N_cli)
+    // one thread per cell
+    const unsigned int cell = blockIdx.x * blockDim.x + threadIdx.x;
+    if (cell >= N_cells)
         return;
 
-    // convert the entry 1D index into a 2D index
-    const unsigned int cell = idx / cli.getW();
-    const unsigned int offset = idx - (cell * cli.getW());
-
-    // if the offset lies outside the number of particles in the cell, fill it with sentinel
     const unsigned int np = d_cell_np[cell];
-    if (offset >= np)
-        d_cell_list[idx] = sentinel;
+    unsigned int count = 0;
+    for (unsigned int offset = 0; offset < np; ++offset)
+        {
+        if (__ldg(d_cell_list + cli(offset, cell)) < N_mpcd)
+            ++count;
+        }
+    d_cell_offset[cell] = count;
     }
 
-//! Kernel to generate the reverse particle mapping
+//! Kernel to generate the sorted particle order from the cell list
 /*!
+ * \param d_order Map of new particle indexes onto old particle indexes (output)
  * \param d_rorder Map of old particle indexes onto new particle indexes (output)
- * \param d_order Map of new particle indexes onto old particle indexes
- * \param N Number of particles
+ * \param d_cell_list Cell list
+ * \param d_cell_np Number of particles per cell
+ * \param d_cell_offset First new particle index of each cell
+ * \param cli Two-dimensional cell-list indexer
+ * \param N_mpcd Number of MPCD particles
+ * \param N_cells Number of cells
  *
  * \b Implementation
- * Using one thread per particle, the map generated by mpcd::gpu::sort_cell_compact
- * is read and reversed so that new particle indexes can be looked up from old
- * particle indexes.
+ * Using one thread per cell, the MPCD particles of the cell are given consecutive new indexes
+ * starting from the exclusive scan of the per-cell counts. Both maps are written in the same pass.
+ * The cell list is read in the same pattern as in mpcd::gpu::kernel::sort_count_cells.
  */
-__global__ void
-sort_gen_reverse(unsigned int* d_rorder, const unsigned int* d_order, const unsigned int N)
+__global__ void sort_cell_order(unsigned int* d_order,
+                                unsigned int* d_rorder,
+                                const unsigned int* d_cell_list,
+                                const unsigned int* d_cell_np,
+                                const unsigned int* d_cell_offset,
+                                const Index2D cli,
+                                const unsigned int N_mpcd,
+                                const unsigned int N_cells)
     {
-    // one thread per particle
-    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
-    if (idx >= N)
+    // one thread per cell
+    const unsigned int cell = blockIdx.x * blockDim.x + threadIdx.x;
+    if (cell >= N_cells)
         return;
 
-    // inverse map the ordering
-    // d_order maps the new index (idx) onto the old index (pid), so we need to flip this around
-    const unsigned int pid = d_order[idx];
-    d_rorder[pid] = idx;
+    const unsigned int np = d_cell_np[cell];
+    unsigned int cur_p = d_cell_offset[cell];
+    for (unsigned int offset = 0; offset < np; ++offset)
+        {
+        const unsigned int pid = __ldg(d_cell_list + cli(offset, cell));
+        if (pid < N_mpcd)
+            {
+            d_order[cur_p] = pid;
+            d_rorder[pid] = cur_p;
+            ++cur_p;
+            }
+        }
     }
 
     } // end namespace kernel
@@ -170,122 +194,101 @@ cudaError_t sort_apply(Scalar4* d_pos_alt,
     }
 
 /*!
- * \param d_cell_list Cell list to fill in
+ * \param d_cell_offset Number of MPCD particles in each cell (output)
+ * \param d_cell_list Cell list
  * \param d_cell_np Number of particles per cell
  * \param cli Two-dimensional cell-list indexer
- * \param sentinel Value to fill into empty cell-list entries
- * \param N_cli Number of total entries (filled and empty) in the cell list
+ * \param N_mpcd Number of MPCD particles
  * \param block_size Number of threads per block
  *
  * \returns cudaSuccess on completion
  *
- * \sa mpcd::gpu::kernel::sort_set_sentinel
+ * \sa mpcd::gpu::kernel::sort_count_cells
  */
-cudaError_t sort_set_sentinel(unsigned int* d_cell_list,
-                              const unsigned int* d_cell_np,
-                              const Index2D& cli,
-                              const unsigned int sentinel,
-                              const unsigned int block_size)
+cudaError_t sort_count_cells(unsigned int* d_cell_offset,
+                             const unsigned int* d_cell_list,
+                             const unsigned int* d_cell_np,
+                             const Index2D& cli,
+                             const unsigned int N_mpcd,
+                             const unsigned int block_size)
     {
+    const unsigned int N_cells = cli.getH();
+    if (N_cells == 0)
+        return cudaSuccess;
+
     unsigned int max_block_size;
     cudaFuncAttributes attr;
-    cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::sort_set_sentinel);
+    cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::sort_count_cells);
     max_block_size = attr.maxThreadsPerBlock;
 
-    const unsigned int N_cli = cli.getNumElements();
-
     unsigned int run_block_size = min(block_size, max_block_size);
-    dim3 grid(N_cli / run_block_size + 1);
-    mpcd::gpu::kernel::sort_set_sentinel<<<grid, run_block_size>>>(d_cell_list,
-                                                                   d_cell_np,
-                                                                   cli,
-                                                                   sentinel,
-                                                                   N_cli);
+    dim3 grid(N_cells / run_block_size + 1);
+    mpcd::gpu::kernel::sort_count_cells<<<grid, run_block_size>>>(d_cell_offset,
+                                                                  d_cell_list,
+                                                                  d_cell_np,
+                                                                  cli,
+                                                                  N_mpcd,
+                                                                  N_cells);
 
     return cudaSuccess;
     }
 
-//! Less-than comparison functor for cell-list compaction
-struct LessThan
-    {
-    //! Constructor
-    /*!
-     * \param compare_ Value to compare less than
-     */
-    __host__ __device__ LessThan(unsigned int compare_) : compare(compare_) { }
-
-    //! Less than comparison functor
-    /*!
-     * \param val
-     * \returns True if \a val is less than \a compare
-     */
-    __host__ __device__ bool operator()(const unsigned int& val) const
-        {
-        return (val < compare);
-        }
-
-    unsigned int compare; //!< Value to compare less-than to
-    };
-
 /*!
- * \param d_order Compacted MPCD particle indexes in cell-list order (output)
- * \param d_cell_list Cell list array to compact
- * \param num_items Number of items in the cell list
- * \param N_mpcd Number of MPCD particles
+ * \param d_cell_offset Number of MPCD particles in each cell, replaced by the first index
+ * \param N_cells Number of cells
  *
- * \returns Number of items selected (should be equal to N_mpcd).
- *
- * \b Implementation
- * thrust::copy_if is used to efficiently compact the MPCD cell list to
- * a stream containing only MPCD particle indexes. First, a sentinel is set to
- * fill in empty entries (mpcd::gpu::sort_set_sentinel). Then, the LessThan functor
- * is used to compare all entries in the cell list, and return only those with
- * indexes less than \a N_mpcd.
- *
- * \b Note
- * A previous version of this function used CUB to perform the select, but this seemed to
- * fail when HOOMD bumped to CUB 1.8.0. Segfaults were encountered when executing DeviceSelect::If.
- * I decided to replace it with thrust since this is not so performance critical, and I was unable
- * to find the proper root cause of it.
+ * thrust::exclusive_scan turns the per-cell counts into the first new particle index of each cell.
  */
-unsigned int sort_cell_compact(unsigned int* d_order,
-                               const unsigned int* d_cell_list,
-                               const unsigned int num_items,
-                               const unsigned int N_mpcd)
+void sort_cell_scan(unsigned int* d_cell_offset, const unsigned int N_cells)
     {
-    unsigned int* last = thrust::copy_if(thrust::device,
-                                         d_cell_list,
-                                         d_cell_list + num_items,
-                                         d_order,
-                                         LessThan(N_mpcd));
-    return (unsigned int)(last - d_order);
+    thrust::exclusive_scan(thrust::device,
+                           d_cell_offset,
+                           d_cell_offset + N_cells,
+                           d_cell_offset);
     }
 
 /*!
+ * \param d_order Map of new particle indexes onto old particle indexes (output)
  * \param d_rorder Map of old particle indexes onto new particle indexes (output)
- * \param d_order Map of new particle indexes onto old particle indexes
- * \param N Number of particles
+ * \param d_cell_list Cell list
+ * \param d_cell_np Number of particles per cell
+ * \param d_cell_offset First new particle index of each cell
+ * \param cli Two-dimensional cell-list indexer
+ * \param N_mpcd Number of MPCD particles
+ * \param block_size Number of threads per block
  *
  * \returns cudaSuccess on completion
  *
- * \sa mpcd::gpu::kernel::sort_gen_reverse
+ * \sa mpcd::gpu::kernel::sort_cell_order
  */
-cudaError_t sort_gen_reverse(unsigned int* d_rorder,
-                             const unsigned int* d_order,
-                             const unsigned int N,
-                             const unsigned int block_size)
+cudaError_t sort_cell_order(unsigned int* d_order,
+                            unsigned int* d_rorder,
+                            const unsigned int* d_cell_list,
+                            const unsigned int* d_cell_np,
+                            const unsigned int* d_cell_offset,
+                            const Index2D& cli,
+                            const unsigned int N_mpcd,
+                            const unsigned int block_size)
     {
-    if (N == 0)
+    const unsigned int N_cells = cli.getH();
+    if (N_cells == 0)
         return cudaSuccess;
 
     unsigned int max_block_size;
     cudaFuncAttributes attr;
-    cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::sort_gen_reverse);
+    cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::sort_cell_order);
     max_block_size = attr.maxThreadsPerBlock;
 
     unsigned int run_block_size = min(block_size, max_block_size);
-    dim3 grid(N / run_block_size + 1);
-    mpcd::gpu::kernel::sort_gen_reverse<<<grid, run_block_size>>>(d_rorder, d_order, N);
+    dim3 grid(N_cells / run_block_size + 1);
+    mpcd::gpu::kernel::sort_cell_order<<<grid, run_block_size>>>(d_order,
+                                                                 d_rorder,
+                                                                 d_cell_list,
+                                                                 d_cell_np,
+                                                                 d_cell_offset,
+                                                                 cli,
+                                                                 N_mpcd,
+                                                                 N_cells);
 
     return cudaSuccess;
     }
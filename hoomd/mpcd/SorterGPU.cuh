@@ -33,24 +33,26 @@ cudaError_t sort_apply(Scalar4* d_pos_alt,
                        const unsigned int N,
                        const unsigned int block_size);
 
-//! Kernel driver to fill empty cell list entries with sentinel
-cudaError_t sort_set_sentinel(unsigned int* d_cell_list,
-                              const unsigned int* d_cell_np,
-                              const Index2D& cli,
-                              const unsigned int sentinel,
-                              const unsigned int block_size);
-
-//! Driver for thrust to perform cell-list stream compaction
-unsigned int sort_cell_compact(unsigned int* d_order,
-                               const unsigned int* d_cell_list,
-                               const unsigned int num_items,
-                               const unsigned int N_mpcd);
-
-//! Kernel driver to reverse map the particle ordering
-cudaError_t sort_gen_reverse(unsigned int* d_rorder,
-                             const unsigned int* d_order,
-                             const unsigned int N,
+//! Kernel driver to count the MPCD particles in each cell
+cudaError_t sort_count_cells(unsigned int* d_cell_offset,
+                             const unsigned int* d_cell_list,
+                             const unsigned int* d_cell_np,
+                             const Index2D& cli,
+                             const unsigned int N_mpcd,
                              const unsigned int block_size);
+
+//! Driver for thrust to scan the per-cell counts into offsets
+void sort_cell_scan(unsigned int* d_cell_offset, const unsigned int N_cells);
+
+//! Kernel driver to generate the sorted order and its reverse from the cell list
+cudaError_t sort_cell_order(unsigned int* d_order,
+                            unsigned int* d_rorder,
+                            const unsigned int* d_cell_list,
+                            const unsigned int* d_cell_np,
+                            const unsigned int* d_cell_offset,
+                            const Index2D& cli,
+                            const unsigned int N_mpcd,
+                            const unsigned int block_size);
     }  // end namespace gpu
     }  // end namespace mpcd
     }  // end namespace hoomd
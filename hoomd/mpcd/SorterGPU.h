@@ -44,19 +44,20 @@ class PYBIND11_EXPORT SorterGPU : public mpcd::Sorter
         {
         mpcd::Sorter::setAutotunerParams(enable, period);
 
-        m_sentinel_tuner->setEnabled(enable);
-        m_sentinel_tuner->setPeriod(period);
-        m_reverse_tuner->setEnabled(enable);
-        m_reverse_tuner->setPeriod(period);
+        m_count_tuner->setEnabled(enable);
+        m_count_tuner->setPeriod(period);
+        m_order_tuner->setEnabled(enable);
+        m_order_tuner->setPeriod(period);
         m_apply_tuner->setEnabled(enable);
         m_apply_tuner->setPeriod(period);
         }
 
     protected:
-    std::unique_ptr<Autotuner>
-        m_sentinel_tuner;                       //!< Kernel tuner for filling sentinels in cell list
-    std::unique_ptr<Autotuner> m_reverse_tuner; //!< Kernel tuner for setting reverse map
-    std::unique_ptr<Autotuner> m_apply_tuner;   //!< Kernel tuner for applying sorted order
+    std::unique_ptr<Autotuner> m_count_tuner; //!< Kernel tuner for counting particles per cell
+    std::unique_ptr<Autotuner> m_order_tuner; //!< Kernel tuner for generating the sorted order
+    std::unique_ptr<Autotuner> m_apply_tuner; //!< Kernel tuner for applying sorted order
+
+    GPUVector<unsigned int> m_cell_offset; //!< First sorted index of the particles in each cell
 
     //! Compute the sorting order at the current timestep on the GPU
     virtual void computeOrder(uint64_t timestep);
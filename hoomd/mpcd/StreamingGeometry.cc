@@ -47,6 +47,35 @@ void export_SlitPoreGeometry(pybind11::module& m)
         .def("getBoundaryCondition", &SlitPoreGeometry::getBoundaryCondition);
     }
 
+void export_TriangleMeshGeometry(pybind11::module& m)
+    {
+    pybind11::class_<TriangleMeshGeometry, std::shared_ptr<TriangleMeshGeometry>>(
+        m,
+        "TriangleMeshGeometry")
+        .def(pybind11::init(
+            [](pybind11::list vertices, pybind11::list triangles, boundary bc)
+            {
+                std::vector<vec3<Scalar>> verts;
+                for (auto v : vertices)
+                    {
+                    pybind11::tuple v_tuple = pybind11::cast<pybind11::tuple>(v);
+                    verts.push_back(vec3<Scalar>(pybind11::cast<Scalar>(v_tuple[0]),
+                                                 pybind11::cast<Scalar>(v_tuple[1]),
+                                                 pybind11::cast<Scalar>(v_tuple[2])));
+                    }
+                std::vector<uint3> tris;
+                for (auto t : triangles)
+                    {
+                    pybind11::tuple t_tuple = pybind11::cast<pybind11::tuple>(t);
+                    tris.push_back(make_uint3(pybind11::cast<unsigned int>(t_tuple[0]),
+                                              pybind11::cast<unsigned int>(t_tuple[1]),
+                                              pybind11::cast<unsigned int>(t_tuple[2])));
+                    }
+                return std::make_shared<TriangleMeshGeometry>(verts, tris, bc);
+            }))
+        .def("getBoundaryCondition", &TriangleMeshGeometry::getBoundaryCondition);
+    }
+
     } // end namespace detail
     } // end namespace mpcd
     } // end namespace hoomd
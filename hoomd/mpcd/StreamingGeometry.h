@@ -17,6 +17,8 @@
 #include "SlitPoreGeometry.h"
 
 #ifndef __HIPCC__
+#include "TriangleMeshGeometry.h"
+
 #include <pybind11/pybind11.h>
 
 namespace hoomd
@@ -37,6 +39,9 @@ void export_SlitGeometry(pybind11::module& m);
 //! Export SlitPoreGeometry to python
 void export_SlitPoreGeometry(pybind11::module& m);
 
+//! Export TriangleMeshGeometry to python
+void export_TriangleMeshGeometry(pybind11::module& m);
+
     }  // end namespace detail
     }  // end namespace mpcd
     }  // end namespace hoomd
@@ -0,0 +1,341 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mphoward
+
+/*!
+ * \file mpcd/TriangleMeshGeometry.h
+ * \brief Definition of the MPCD triangle mesh geometry
+ */
+
+#ifndef MPCD_TRIANGLE_MESH_GEOMETRY_H_
+#define MPCD_TRIANGLE_MESH_GEOMETRY_H_
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "BoundaryCondition.h"
+
+#include "hoomd/AABBTree.h"
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace hoomd
+    {
+namespace mpcd
+    {
+namespace detail
+    {
+//! Solid bodies bounded by a closed triangle mesh
+/*!
+ * This class defines a geometry whose solid regions are enclosed by an arbitrary triangulated
+ * surface, e.g., the obstacles of a porous medium. The triangles are given by three vertex indexes,
+ * ordered counterclockwise when viewed from the fluid so that the normal of each triangle points
+ * out of the solid. The surface must be closed so that the solid can be identified by the parity of
+ * ray crossings, and it must lie inside the simulation box (surfaces are not replicated through
+ * the periodic boundaries).
+ *
+ * The triangle bounding boxes are stored in an AABBTree, so collision detection and the inside /
+ * outside test only check the triangles near the particle.
+ *
+ * \sa mpcd::detail::SlitGeometry for additional discussion of the boundary conditions, etc.
+ */
+class __attribute__((visibility("default"))) TriangleMeshGeometry
+    {
+    public:
+    //! Constructor
+    /*!
+     * \param vertices Vertices of the mesh
+     * \param triangles Vertex indexes of each triangle
+     * \param bc Boundary condition at the wall (slip or no-slip)
+     */
+    TriangleMeshGeometry(const std::vector<vec3<Scalar>>& vertices,
+                         const std::vector<uint3>& triangles,
+                         boundary bc)
+        : m_vertices(vertices), m_triangles(triangles), m_bc(bc)
+        {
+        if (m_triangles.empty())
+            throw std::runtime_error("Triangle mesh geometry requires at least one triangle");
+
+        std::vector<hoomd::detail::AABB> aabbs(m_triangles.size());
+        m_normals.resize(m_triangles.size());
+        for (unsigned int i = 0; i < m_triangles.size(); ++i)
+            {
+            const uint3 tri = m_triangles[i];
+            if (tri.x >= m_vertices.size() || tri.y >= m_vertices.size()
+                || tri.z >= m_vertices.size())
+                throw std::runtime_error("Triangle mesh vertex index out of range");
+
+            const vec3<Scalar> a = m_vertices[tri.x];
+            const vec3<Scalar> b = m_vertices[tri.y];
+            const vec3<Scalar> c = m_vertices[tri.z];
+            const vec3<Scalar> n = cross(b - a, c - a);
+            const Scalar nsq = dot(n, n);
+            if (nsq == Scalar(0))
+                throw std::runtime_error("Triangle mesh contains a degenerate triangle");
+            m_normals[i] = n * fast::rsqrt(nsq);
+
+            const vec3<Scalar> lo(std::min(a.x, std::min(b.x, c.x)),
+                                  std::min(a.y, std::min(b.y, c.y)),
+                                  std::min(a.z, std::min(b.z, c.z)));
+            const vec3<Scalar> hi(std::max(a.x, std::max(b.x, c.x)),
+                                  std::max(a.y, std::max(b.y, c.y)),
+                                  std::max(a.z, std::max(b.z, c.z)));
+            aabbs[i] = hoomd::detail::AABB(lo, hi);
+            m_bounds = (i == 0) ? aabbs[i] : merge(m_bounds, aabbs[i]);
+            }
+        m_tree.buildTree(aabbs.data(), (unsigned int)aabbs.size());
+        }
+
+    //! Detect collision between the particle and the boundary
+    /*!
+     * \param pos Proposed particle position
+     * \param vel Proposed particle velocity
+     * \param dt Integration time remaining (inout).
+     *
+     * \returns True if a collision occurred, and false otherwise
+     *
+     * \post The particle position \a pos is moved to the point of reflection, the velocity \a vel
+     * is updated according to the appropriate bounce back rule, and the integration time \a dt is
+     * decreased to the amount of time remaining.
+     *
+     * The segment traveled during \a dt is tested against the triangles whose bounding boxes it
+     * overlaps, and the first triangle entered from the fluid side is taken as the collision.
+     */
+    bool detectCollision(Scalar3& pos, Scalar3& vel, Scalar& dt) const
+        {
+        const vec3<Scalar> end(pos);
+        const vec3<Scalar> v(vel);
+        const vec3<Scalar> disp = v * dt;
+        const vec3<Scalar> start = end - disp;
+        const hoomd::detail::AABB seg(vec3<Scalar>(std::min(start.x, end.x),
+                                                   std::min(start.y, end.y),
+                                                   std::min(start.z, end.z)),
+                                      vec3<Scalar>(std::max(start.x, end.x),
+                                                   std::max(start.y, end.y),
+                                                   std::max(start.z, end.z)));
+
+        // find the first crossing along the segment (fraction of disp in [0,1])
+        Scalar t_hit(2);
+        unsigned int hit = 0;
+        for (unsigned int node = 0; node < m_tree.getNumNodes(); ++node)
+            {
+            if (!overlap(m_tree.getNodeAABB(node), seg))
+                {
+                node += m_tree.getNodeSkip(node);
+                continue;
+                }
+            if (!m_tree.isNodeLeaf(node))
+                continue;
+
+            for (unsigned int j = 0; j < m_tree.getNodeNumParticles(node); ++j)
+                {
+                const unsigned int tri = m_tree.getNodeParticle(node, j);
+                // only entering the solid (moving against the normal) is a collision
+                if (dot(disp, m_normals[tri]) >= Scalar(0))
+                    continue;
+
+                Scalar t;
+                if (intersectTriangle(tri, start, disp, t) && t <= Scalar(1) && t < t_hit)
+                    {
+                    t_hit = t;
+                    hit = tri;
+                    }
+                }
+            }
+        if (t_hit > Scalar(1))
+            {
+            dt = Scalar(0);
+            return false;
+            }
+
+        // move the particle back to the point of contact, leaving the rest of the time
+        dt = (Scalar(1) - t_hit) * dt;
+        pos = vec_to_scalar3(start + t_hit * disp);
+
+        // update velocity according to boundary conditions
+        // no-slip requires reflection of the tangential components
+        const vec3<Scalar> n = m_normals[hit];
+        const vec3<Scalar> vn = dot(n, v) * n;
+        vec3<Scalar> vnew = v;
+        if (m_bc == boundary::no_slip)
+            {
+            const vec3<Scalar> vt = v - vn;
+            vnew += Scalar(-2) * vt;
+            }
+        // always reflect normal component for no-penetration
+        vnew += Scalar(-2) * vn;
+        vel = vec_to_scalar3(vnew);
+
+        return true;
+        }
+
+    //! Check if a particle is out of bounds
+    /*!
+     * \param pos Current particle position
+     * \returns True if particle is inside a solid, and false otherwise
+     *
+     * A ray is cast from \a pos toward +x, and the point lies in a solid if the ray crosses the
+     * surface an odd number of times.
+     */
+    bool isOutside(const Scalar3& pos) const
+        {
+        const vec3<Scalar> start(pos);
+        const vec3<Scalar> hi = m_bounds.getUpper();
+        if (start.x > hi.x)
+            return false;
+        // the ray is skewed off the axes so it does not graze the edges of axis-aligned meshes
+        const vec3<Scalar> ray
+            = (hi.x - start.x + Scalar(1)) * vec3<Scalar>(1, Scalar(0.3183), Scalar(0.2357));
+        const vec3<Scalar> end = start + ray;
+        const hoomd::detail::AABB seg(start, end);
+
+        unsigned int crossings = 0;
+        for (unsigned int node = 0; node < m_tree.getNumNodes(); ++node)
+            {
+            if (!overlap(m_tree.getNodeAABB(node), seg))
+                {
+                node += m_tree.getNodeSkip(node);
+                continue;
+                }
+            if (!m_tree.isNodeLeaf(node))
+                continue;
+
+            for (unsigned int j = 0; j < m_tree.getNodeNumParticles(node); ++j)
+                {
+                Scalar t;
+                if (intersectTriangle(m_tree.getNodeParticle(node, j), start, ray, t))
+                    ++crossings;
+                }
+            }
+
+        return (crossings % 2 == 1);
+        }
+
+    //! Check if a box may be cut by the surface
+    /*!
+     * \param lo Lower corner of the box
+     * \param hi Upper corner of the box
+     * \returns True if the bounding box of any triangle overlaps the box
+     */
+    bool overlapsBox(const Scalar3& lo, const Scalar3& hi) const
+        {
+        const vec3<Scalar> box_lo(lo), box_hi(hi);
+        const hoomd::detail::AABB box(box_lo, box_hi);
+        for (unsigned int node = 0; node < m_tree.getNumNodes(); ++node)
+            {
+            if (!overlap(m_tree.getNodeAABB(node), box))
+                node += m_tree.getNodeSkip(node);
+            else if (m_tree.isNodeLeaf(node))
+                return true;
+            }
+        return false;
+        }
+
+    //! Validate that the simulation box is large enough for the geometry
+    /*!
+     * \param box Global simulation box
+     * \param cell_size Size of MPCD cell
+     *
+     * The box is large enough for the mesh if the mesh is padded by a cell from every face of the
+     * box, so that cells cut by the surface do not interact through the periodic boundaries.
+     */
+    bool validateBox(const BoxDim& box, Scalar cell_size) const
+        {
+        const Scalar3 hi = box.getHi();
+        const Scalar3 lo = box.getLo();
+        const vec3<Scalar> mesh_lo = m_bounds.getLower();
+        const vec3<Scalar> mesh_hi = m_bounds.getUpper();
+
+        return ((hi.x - mesh_hi.x) >= cell_size && (mesh_lo.x - lo.x) >= cell_size
+                && (hi.y - mesh_hi.y) >= cell_size && (mesh_lo.y - lo.y) >= cell_size
+                && (hi.z - mesh_hi.z) >= cell_size && (mesh_lo.z - lo.z) >= cell_size);
+        }
+
+    //! Get the mesh vertices
+    const std::vector<vec3<Scalar>>& getVertices() const
+        {
+        return m_vertices;
+        }
+
+    //! Get the vertex indexes of the triangles
+    const std::vector<uint3>& getTriangles() const
+        {
+        return m_triangles;
+        }
+
+    //! Get the wall boundary condition
+    /*!
+     * \returns Boundary condition at wall
+     */
+    boundary getBoundaryCondition() const
+        {
+        return m_bc;
+        }
+
+    //! Get the unique name of this geometry
+    static std::string getName()
+        {
+        return std::string("TriangleMesh");
+        }
+
+    private:
+    std::vector<vec3<Scalar>> m_vertices; //!< Mesh vertices
+    std::vector<uint3> m_triangles;       //!< Vertex indexes of each triangle
+    std::vector<vec3<Scalar>> m_normals;  //!< Unit outward (fluid side) normal of each triangle
+    hoomd::detail::AABB m_bounds;         //!< Bounding box of the mesh
+    hoomd::detail::AABBTree m_tree;       //!< Tree of triangle bounding boxes
+    const boundary m_bc;                  //!< Boundary condition
+
+    //! Intersect a segment with a triangle
+    /*!
+     * \param tri Triangle index
+     * \param start Start of the segment
+     * \param disp Displacement along the segment
+     * \param t Fraction of \a disp to the intersection (out)
+     * \returns True if the segment from \a start to \a start + \a disp crosses the triangle
+     *
+     * This is the Moller-Trumbore test.
+     */
+    bool intersectTriangle(unsigned int tri,
+                           const vec3<Scalar>& start,
+                           const vec3<Scalar>& disp,
+                           Scalar& t) const
+        {
+        const uint3 idx = m_triangles[tri];
+        const vec3<Scalar> a = m_vertices[idx.x];
+        const vec3<Scalar> e1 = m_vertices[idx.y] - a;
+        const vec3<Scalar> e2 = m_vertices[idx.z] - a;
+
+        const vec3<Scalar> p = cross(disp, e2);
+        const Scalar det = dot(e1, p);
+        if (det == Scalar(0))
+            return false;
+        const Scalar inv_det = Scalar(1) / det;
+
+        const vec3<Scalar> s = start - a;
+        const Scalar u = dot(s, p) * inv_det;
+        if (u < Scalar(0) || u > Scalar(1))
+            return false;
+
+        const vec3<Scalar> q = cross(s, e1);
+        const Scalar v = dot(disp, q) * inv_det;
+        if (v < Scalar(0) || u + v > Scalar(1))
+            return false;
+
+        t = dot(e2, q) * inv_det;
+        return (t > Scalar(0) && t <= Scalar(1));
+        }
+    };
+
+    } // end namespace detail
+    } // end namespace mpcd
+    } // end namespace hoomd
+
+#endif // MPCD_TRIANGLE_MESH_GEOMETRY_H_
@@ -0,0 +1,244 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mphoward
+
+/*!
+ * \file mpcd/TriangleMeshGeometryFiller.cc
+ * \brief Definition of mpcd::TriangleMeshGeometryFiller
+ */
+
+#include "TriangleMeshGeometryFiller.h"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+namespace hoomd
+    {
+mpcd::TriangleMeshGeometryFiller::TriangleMeshGeometryFiller(
+    std::shared_ptr<mpcd::SystemData> sysdata,
+    Scalar density,
+    unsigned int type,
+    std::shared_ptr<Variant> T,
+    uint16_t seed,
+    std::shared_ptr<const mpcd::detail::TriangleMeshGeometry> geom)
+    : mpcd::VirtualParticleFiller(sysdata, density, type, T)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing MPCD TriangleMeshGeometryFiller" << std::endl;
+
+    setGeometry(geom);
+
+    // unphysical values in cache to always force recompute
+    m_needs_recompute = true;
+    m_recompute_cache = make_scalar3(-1, -1, -1);
+    m_pdata->getBoxChangeSignal()
+        .connect<mpcd::TriangleMeshGeometryFiller,
+                 &mpcd::TriangleMeshGeometryFiller::notifyRecompute>(this);
+    }
+
+mpcd::TriangleMeshGeometryFiller::~TriangleMeshGeometryFiller()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying MPCD TriangleMeshGeometryFiller" << std::endl;
+    m_pdata->getBoxChangeSignal()
+        .disconnect<mpcd::TriangleMeshGeometryFiller,
+                    &mpcd::TriangleMeshGeometryFiller::notifyRecompute>(this);
+    }
+
+void mpcd::TriangleMeshGeometryFiller::computeNumFill()
+    {
+    const Scalar cell_size = m_cl->getCellSize();
+    const Scalar max_shift = m_cl->getMaxGridShift();
+
+    // check if fill-relevant variables have changed (can't use signal because cell list build may
+    // not have triggered yet)
+    m_needs_recompute |= (m_recompute_cache.x != cell_size || m_recompute_cache.y != max_shift
+                          || m_recompute_cache.z != m_density);
+
+    // only recompute if needed
+    if (!m_needs_recompute)
+        return;
+
+    // as a precaution, validate the global box with the current cell list
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    if (!m_geom->validateBox(global_box, cell_size))
+        {
+        m_exec_conf->msg->error()
+            << "Invalid triangle mesh geometry for global box, cannot fill virtual particles."
+            << std::endl;
+        throw std::runtime_error("Invalid triangle mesh geometry for global box");
+        }
+
+    // local domain, and the range of global grid cells that overlap it
+    const BoxDim& box = m_pdata->getBox();
+    const Scalar3 lo = box.getLo();
+    const Scalar3 hi = box.getHi();
+    const Scalar3 global_lo = global_box.getLo();
+    const int3 first = make_int3((int)std::floor((lo.x - global_lo.x) / cell_size),
+                                 (int)std::floor((lo.y - global_lo.y) / cell_size),
+                                 (int)std::floor((lo.z - global_lo.z) / cell_size));
+    const int3 last = make_int3((int)std::ceil((hi.x - global_lo.x) / cell_size),
+                                (int)std::ceil((hi.y - global_lo.y) / cell_size),
+                                (int)std::ceil((hi.z - global_lo.z) / cell_size));
+
+    m_box_lo.clear();
+    m_box_hi.clear();
+    m_box_solid.clear();
+    m_ranges.clear();
+    m_N_fill = 0;
+    const Scalar sample_frac = Scalar(1) / (NUM_SAMPLES * NUM_SAMPLES * NUM_SAMPLES);
+    for (int k = first.z; k < last.z; ++k)
+        {
+        for (int j = first.y; j < last.y; ++j)
+            {
+            for (int i = first.x; i < last.x; ++i)
+                {
+                const Scalar3 cell_lo = global_lo + cell_size * make_scalar3(i, j, k);
+                const Scalar3 cell_hi = cell_lo + make_scalar3(cell_size, cell_size, cell_size);
+
+                // a shifted cell cut by the surface can only reach into a neighboring cell
+                const Scalar3 pad = make_scalar3(cell_size, cell_size, cell_size);
+                if (!m_geom->overlapsBox(cell_lo - pad, cell_hi + pad))
+                    continue;
+
+                // clamp the cell to the local domain
+                const Scalar3 fill_lo = make_scalar3(std::max(cell_lo.x, lo.x),
+                                                     std::max(cell_lo.y, lo.y),
+                                                     std::max(cell_lo.z, lo.z));
+                const Scalar3 fill_hi = make_scalar3(std::min(cell_hi.x, hi.x),
+                                                     std::min(cell_hi.y, hi.y),
+                                                     std::min(cell_hi.z, hi.z));
+                const Scalar3 L = fill_hi - fill_lo;
+                if (L.x <= 0 || L.y <= 0 || L.z <= 0)
+                    continue;
+
+                // estimate the solid fraction at the midpoints of a regular grid
+                unsigned int num_solid = 0;
+                Scalar3 solid = fill_lo;
+                for (unsigned int s = 0; s < NUM_SAMPLES * NUM_SAMPLES * NUM_SAMPLES; ++s)
+                    {
+                    const Scalar3 frac
+                        = make_scalar3(Scalar(s % NUM_SAMPLES + 0.5),
+                                       Scalar((s / NUM_SAMPLES) % NUM_SAMPLES + 0.5),
+                                       Scalar(s / (NUM_SAMPLES * NUM_SAMPLES) + 0.5))
+                          / Scalar(NUM_SAMPLES);
+                    const Scalar3 x = fill_lo + frac * L;
+                    if (m_geom->isOutside(x))
+                        {
+                        solid = x;
+                        ++num_solid;
+                        }
+                    }
+
+                const Scalar volume = L.x * L.y * L.z * num_solid * sample_frac;
+                const unsigned int N_box = (unsigned int)std::round(volume * m_density);
+
+                // only add box if it isn't empty
+                if (N_box != 0)
+                    {
+                    m_box_lo.push_back(fill_lo);
+                    m_box_hi.push_back(fill_hi);
+                    m_box_solid.push_back(solid);
+                    m_ranges.push_back(make_uint2(m_N_fill, m_N_fill + N_box));
+
+                    m_N_fill += N_box;
+                    }
+                }
+            }
+        }
+
+    // size is now updated, cache the cell dimensions used
+    m_needs_recompute = false;
+    m_recompute_cache = make_scalar3(cell_size, max_shift, m_density);
+    }
+
+/*!
+ * \param timestep Current timestep to draw particles
+ */
+void mpcd::TriangleMeshGeometryFiller::drawParticles(uint64_t timestep)
+    {
+    // quit early if not filling to ensure we don't access any memory that hasn't been set
+    if (m_N_fill == 0)
+        return;
+
+    ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<unsigned int> h_tag(m_mpcd_pdata->getTags(),
+                                    access_location::host,
+                                    access_mode::readwrite);
+    const Scalar vel_factor = fast::sqrt((*m_T)(timestep) / m_mpcd_pdata->getMass());
+
+    // set these counters so that they get filled on the first pass
+    int boxid = -1;
+    unsigned int boxlast = 0;
+    Scalar3 lo, hi;
+
+    uint16_t seed = m_sysdef->getSeed();
+
+    // index to start filling from
+    const unsigned int first_idx = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual() - m_N_fill;
+    for (unsigned int i = 0; i < m_N_fill; ++i)
+        {
+        const unsigned int tag = m_first_tag + i;
+        hoomd::RandomGenerator rng(
+            hoomd::Seed(hoomd::RNGIdentifier::TriangleMeshGeometryFiller, timestep, seed),
+            hoomd::Counter(tag));
+
+        // advanced past end of this box range, take the next
+        if (i >= boxlast)
+            {
+            ++boxid;
+            boxlast = m_ranges[boxid].y;
+            lo = m_box_lo[boxid];
+            hi = m_box_hi[boxid];
+            }
+
+        // draw in the box until the point is in the solid, falling back to the known solid point
+        Scalar3 pos = m_box_solid[boxid];
+        for (unsigned int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt)
+            {
+            const Scalar3 trial = make_scalar3(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
+                                               hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
+                                               hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng));
+            if (m_geom->isOutside(trial))
+                {
+                pos = trial;
+                break;
+                }
+            }
+
+        const unsigned int pidx = first_idx + i;
+        h_pos.data[pidx] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(m_type));
+
+        hoomd::NormalDistribution<Scalar> gen(vel_factor, 0.0);
+        Scalar3 vel;
+        gen(vel.x, vel.y, rng);
+        vel.z = gen(rng);
+        h_vel.data[pidx]
+            = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
+        h_tag.data[pidx] = tag;
+        }
+    }
+
+/*!
+ * \param m Python module to export to
+ */
+void mpcd::detail::export_TriangleMeshGeometryFiller(pybind11::module& m)
+    {
+    pybind11::class_<mpcd::TriangleMeshGeometryFiller,
+                     mpcd::VirtualParticleFiller,
+                     std::shared_ptr<mpcd::TriangleMeshGeometryFiller>>(
+        m,
+        "TriangleMeshGeometryFiller")
+        .def(pybind11::init<std::shared_ptr<mpcd::SystemData>,
+                            Scalar,
+                            unsigned int,
+                            std::shared_ptr<Variant>,
+                            unsigned int,
+                            std::shared_ptr<const mpcd::detail::TriangleMeshGeometry>>())
+        .def("setGeometry", &mpcd::TriangleMeshGeometryFiller::setGeometry);
+    }
+
+    } // end namespace hoomd
@@ -0,0 +1,87 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mphoward
+
+/*!
+ * \file mpcd/TriangleMeshGeometryFiller.h
+ * \brief Definition of virtual particle filler for mpcd::detail::TriangleMeshGeometry.
+ */
+
+#ifndef MPCD_TRIANGLE_MESH_GEOMETRY_FILLER_H_
+#define MPCD_TRIANGLE_MESH_GEOMETRY_FILLER_H_
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "TriangleMeshGeometry.h"
+#include "VirtualParticleFiller.h"
+
+#include <pybind11/pybind11.h>
+
+#include <vector>
+
+namespace hoomd
+    {
+namespace mpcd
+    {
+//! Adds virtual particles to the MPCD particle data for TriangleMeshGeometry
+/*!
+ * The fill volume is the solid part of the cells near the surface. A cell is filled if it is within
+ * one cell of the bounding box of any triangle, which covers every cell that can be cut by the
+ * surface after the grid shift. The solid volume of each of these cells is estimated once from a
+ * regular grid of sample points, and the particles are drawn uniformly in the solid part of the
+ * cell by rejection.
+ */
+class PYBIND11_EXPORT TriangleMeshGeometryFiller : public mpcd::VirtualParticleFiller
+    {
+    public:
+    TriangleMeshGeometryFiller(std::shared_ptr<mpcd::SystemData> sysdata,
+                               Scalar density,
+                               unsigned int type,
+                               std::shared_ptr<Variant> T,
+                               uint16_t seed,
+                               std::shared_ptr<const mpcd::detail::TriangleMeshGeometry> geom);
+
+    virtual ~TriangleMeshGeometryFiller();
+
+    void setGeometry(std::shared_ptr<const mpcd::detail::TriangleMeshGeometry> geom)
+        {
+        m_geom = geom;
+        notifyRecompute();
+        }
+
+    protected:
+    std::shared_ptr<const mpcd::detail::TriangleMeshGeometry> m_geom;
+
+    const static unsigned int NUM_SAMPLES = 4;   //!< Samples per dimension for the solid volume
+    const static unsigned int MAX_ATTEMPTS = 64; //!< Rejection attempts per particle
+    std::vector<Scalar3> m_box_lo;               //!< Lower corners of the boxes to fill
+    std::vector<Scalar3> m_box_hi;               //!< Upper corners of the boxes to fill
+    std::vector<Scalar3> m_box_solid;            //!< A known solid point in each box
+    std::vector<uint2> m_ranges;                 //!< Particle tag ranges for filling
+
+    //! Compute the total number of particles to fill
+    virtual void computeNumFill();
+
+    //! Draw particles within the fill volume
+    virtual void drawParticles(uint64_t timestep);
+
+    private:
+    bool m_needs_recompute;
+    Scalar3 m_recompute_cache;
+    void notifyRecompute()
+        {
+        m_needs_recompute = true;
+        }
+    };
+
+namespace detail
+    {
+//! Export TriangleMeshGeometryFiller to python
+void export_TriangleMeshGeometryFiller(pybind11::module& m);
+    }  // end namespace detail
+    }  // end namespace mpcd
+    }  // end namespace hoomd
+#endif // MPCD_TRIANGLE_MESH_GEOMETRY_FILLER_H_
@@ -28,23 +28,37 @@ void mpcd::VirtualParticleFiller::fill(uint64_t timestep)
     // update the fill volume
     computeNumFill();
 
-    // in mpi, do a prefix scan on the tag offset in this range
-    // then shift the first tag by the current number of particles, which ensures a compact tag
-    // array
+    // the tags I own start after all current particles and the particles filled on lower ranks,
+    // which ensures a compact tag array
+    unsigned int N_virtual_global = m_mpcd_pdata->getNVirtual();
     m_first_tag = 0;
 #ifdef ENABLE_MPI
     if (m_exec_conf->getNRanks() > 1)
         {
-        // scan the number to fill to get the tag range I own
-        MPI_Exscan(&m_N_fill,
-                   &m_first_tag,
-                   1,
-                   MPI_UNSIGNED,
-                   MPI_SUM,
-                   m_exec_conf->getMPICommunicator());
+        // gather the current virtual and fill counts of every rank in one collective, rather than
+        // a reduction for the global virtual count followed by a scan of the fill counts
+        const unsigned int nranks = m_exec_conf->getNRanks();
+        const unsigned int rank = m_exec_conf->getRank();
+        const unsigned int local_counts[2] = {m_mpcd_pdata->getNVirtual(), m_N_fill};
+        std::vector<unsigned int> counts(2 * nranks);
+        MPI_Allgather(local_counts,
+                      2,
+                      MPI_UNSIGNED,
+                      counts.data(),
+                      2,
+                      MPI_UNSIGNED,
+                      m_exec_conf->getMPICommunicator());
+
+        N_virtual_global = 0;
+        for (unsigned int r = 0; r < nranks; ++r)
+            {
+            N_virtual_global += counts[2 * r];
+            if (r < rank)
+                m_first_tag += counts[2 * r + 1];
+            }
         }
 #endif // ENABLE_MPI
-    m_first_tag += m_mpcd_pdata->getNGlobal() + m_mpcd_pdata->getNVirtualGlobal();
+    m_first_tag += m_mpcd_pdata->getNGlobal() + N_virtual_global;
 
     // add the new virtual particles locally
     m_mpcd_pdata->addVirtualParticles(m_N_fill);
@@ -50,6 +50,7 @@
 // virtual particle fillers
 #include "SlitGeometryFiller.h"
 #include "SlitPoreGeometryFiller.h"
+#include "TriangleMeshGeometryFiller.h"
 #include "VirtualParticleFiller.h"
 #ifdef ENABLE_HIP
 #include "SlitGeometryFillerGPU.h"
@@ -142,12 +143,14 @@ PYBIND11_MODULE(_mpcd, m)
     mpcd::detail::export_BulkGeometry(m);
     mpcd::detail::export_SlitGeometry(m);
     mpcd::detail::export_SlitPoreGeometry(m);
+    mpcd::detail::export_TriangleMeshGeometry(m);
 
     mpcd::detail::export_StreamingMethod(m);
     mpcd::detail::export_ExternalFieldPolymorph(m);
     mpcd::detail::export_ConfinedStreamingMethod<mpcd::detail::BulkGeometry>(m);
     mpcd::detail::export_ConfinedStreamingMethod<mpcd::detail::SlitGeometry>(m);
     mpcd::detail::export_ConfinedStreamingMethod<mpcd::detail::SlitPoreGeometry>(m);
+    mpcd::detail::export_ConfinedStreamingMethod<mpcd::detail::TriangleMeshGeometry>(m);
 #ifdef ENABLE_HIP
     mpcd::detail::export_ConfinedStreamingMethodGPU<mpcd::detail::BulkGeometry>(m);
     mpcd::detail::export_ConfinedStreamingMethodGPU<mpcd::detail::SlitGeometry>(m);
@@ -164,6 +167,7 @@ PYBIND11_MODULE(_mpcd, m)
     mpcd::detail::export_VirtualParticleFiller(m);
     mpcd::detail::export_SlitGeometryFiller(m);
     mpcd::detail::export_SlitPoreGeometryFiller(m);
+    mpcd::detail::export_TriangleMeshGeometryFiller(m);
 #ifdef ENABLE_HIP
     mpcd::detail::export_SlitGeometryFillerGPU(m);
     mpcd::detail::export_SlitPoreGeometryFillerGPU(m);
@@ -551,3 +551,133 @@ class slit_pore(_streaming_method):
         self._cpp.geometry = _mpcd.SlitPoreGeometry(self.H, self.L, bc)
         if self._filler is not None:
             self._filler.setGeometry(self._cpp.geometry)
+
+
+class mesh(_streaming_method):
+    r""" Triangle mesh streaming geometry.
+
+    Args:
+        vertices (list): (*N*, 3) list of the mesh vertex positions
+        triangles (list): (*M*, 3) list of the vertex indexes of each triangle
+        boundary (str): boundary condition at wall ("slip" or "no_slip"")
+        period (int): Number of integration steps between collisions
+
+    The mesh geometry represents solid bodies of arbitrary shape, such as the
+    obstacles of a porous medium, whose surfaces are given by triangles. The
+    vertices of each triangle must be ordered counterclockwise when viewed from
+    the fluid, so that the triangle normals point out of the solid. The surface
+    must be closed, and it must be padded from every face of the simulation box
+    by at least one MPCD cell because it is not replicated through the periodic
+    boundaries.
+
+    The triangles are stored in a bounding volume hierarchy, so the cost of
+    detecting collisions with the surface grows only logarithmically with the
+    number of triangles.
+
+    The "inside" of the :py:class:`mesh` is the space not enclosed by the
+    surface.
+
+    Note:
+        The mesh geometry is streamed on the CPU, even in GPU simulations.
+
+    Examples::
+
+        stream.mesh(vertices=verts, triangles=tris, period=10)
+
+    """
+
+    def __init__(self, vertices, triangles, boundary="no_slip", period=1):
+        _streaming_method.__init__(self, period)
+
+        self.vertices = [tuple(v) for v in vertices]
+        self.triangles = [tuple(t) for t in triangles]
+        self.boundary = boundary
+
+        bc = self._process_boundary(boundary)
+
+        self._cpp = _mpcd.ConfinedStreamingMethodTriangleMesh(
+            hoomd.context.current.mpcd.data,
+            hoomd.context.current.system.getCurrentTimeStep(), self.period, 0,
+            _mpcd.TriangleMeshGeometry(self.vertices, self.triangles, bc))
+
+    def set_filler(self, density, kT, seed, type='A'):
+        r""" Add virtual particles to the mesh.
+
+        Args:
+            density (float): Density of virtual particles.
+            kT (float): Temperature of virtual particles.
+            seed (int): Seed to pseudo-random number generator for virtual particles.
+            type (str): Type of the MPCD particles to fill with.
+
+        The virtual particle filler draws particles within the volume *enclosed*
+        by the surface that could be overlapped by any cell that is partially
+        *outside* the solid. The solid volume of these cells is estimated once
+        from a regular grid of points in each cell. The particles are drawn from
+        the velocity distribution consistent with *kT* and with the given *density*.
+        The mean of the distribution is zero in *x*, *y*, and *z*. Typically, the
+        virtual particle density and temperature are set to the same conditions
+        as the solvent.
+
+        The virtual particles will act as a weak thermostat on the fluid, and so energy
+        is no longer conserved. Momentum will also be sunk into the walls.
+
+        Example::
+
+            mesh.set_filler(density=5.0, kT=1.0, seed=42)
+
+        """
+        type_id = hoomd.context.current.mpcd.particles.getTypeByName(type)
+        T = hoomd.variant._setup_variant_input(kT)
+
+        if self._filler is None:
+            self._filler = _mpcd.TriangleMeshGeometryFiller(
+                hoomd.context.current.mpcd.data, density, type_id,
+                T.cpp_variant, seed, self._cpp.geometry)
+        else:
+            self._filler.setDensity(density)
+            self._filler.setType(type_id)
+            self._filler.setTemperature(T.cpp_variant)
+            self._filler.setSeed(seed)
+
+    def remove_filler(self):
+        """ Remove the virtual particle filler.
+
+        Example::
+
+            mesh.remove_filler()
+
+        """
+
+        self._filler = None
+
+    def set_params(self, vertices=None, triangles=None, boundary=None):
+        """ Set parameters for the mesh geometry.
+
+        Args:
+            vertices (list): (*N*, 3) list of the mesh vertex positions
+            triangles (list): (*M*, 3) list of the vertex indexes of each triangle
+            boundary (str): boundary condition at wall ("slip" or "no_slip"")
+
+        Changing any of these parameters will require the geometry to be
+        constructed and validated, so do not change these too often.
+
+        Examples::
+
+            mesh.set_params(boundary="slip")
+
+        """
+
+        if vertices is not None:
+            self.vertices = [tuple(v) for v in vertices]
+
+        if triangles is not None:
+            self.triangles = [tuple(t) for t in triangles]
+
+        if boundary is not None:
+            self.boundary = boundary
+
+        bc = self._process_boundary(self.boundary)
+        self._cpp.geometry = _mpcd.TriangleMeshGeometry(self.vertices,
+                                                        self.triangles, bc)
+        if self._filler is not None:
+            self._filler.setGeometry(self._cpp.geometry)
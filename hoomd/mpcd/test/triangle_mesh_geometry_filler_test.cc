@@ -0,0 +1,156 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mphoward
+
+#include "hoomd/mpcd/TriangleMeshGeometryFiller.h"
+
+#include "hoomd/SnapshotSystemData.h"
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN()
+
+using namespace hoomd;
+
+//! Make a solid cube of half edge length \a L centered at the origin
+std::shared_ptr<const mpcd::detail::TriangleMeshGeometry> make_cube(Scalar L,
+                                                                    mpcd::detail::boundary bc)
+    {
+    std::vector<vec3<Scalar>> verts = {vec3<Scalar>(-L, -L, -L),
+                                       vec3<Scalar>(L, -L, -L),
+                                       vec3<Scalar>(L, L, -L),
+                                       vec3<Scalar>(-L, L, -L),
+                                       vec3<Scalar>(-L, -L, L),
+                                       vec3<Scalar>(L, -L, L),
+                                       vec3<Scalar>(L, L, L),
+                                       vec3<Scalar>(-L, L, L)};
+    // normals point out of the cube, into the fluid
+    std::vector<uint3> tris = {make_uint3(0, 2, 1),
+                               make_uint3(0, 3, 2),
+                               make_uint3(4, 5, 6),
+                               make_uint3(4, 6, 7),
+                               make_uint3(0, 1, 5),
+                               make_uint3(0, 5, 4),
+                               make_uint3(2, 3, 7),
+                               make_uint3(2, 7, 6),
+                               make_uint3(1, 2, 6),
+                               make_uint3(1, 6, 5),
+                               make_uint3(0, 4, 7),
+                               make_uint3(0, 7, 3)};
+    return std::make_shared<const mpcd::detail::TriangleMeshGeometry>(verts, tris, bc);
+    }
+
+//! Test the collision and inside / outside checks of the mesh
+UP_TEST(triangle_mesh_geometry)
+    {
+    auto cube = make_cube(4.0, mpcd::detail::boundary::no_slip);
+
+    UP_ASSERT(cube->isOutside(make_scalar3(0, 0, 0)));
+    UP_ASSERT(cube->isOutside(make_scalar3(3.9, -3.9, 3.9)));
+    UP_ASSERT(!cube->isOutside(make_scalar3(4.1, 0, 0)));
+    UP_ASSERT(!cube->isOutside(make_scalar3(-4.1, 0, 0)));
+    UP_ASSERT(!cube->isOutside(make_scalar3(0, 0, 5)));
+
+    // move into the cube through the -x face, which is hit halfway through the step
+    Scalar3 pos = make_scalar3(-3.5, 0.1, 0.2);
+    Scalar3 vel = make_scalar3(1.0, 0.5, -0.5);
+    Scalar dt = 1.0;
+    UP_ASSERT(cube->detectCollision(pos, vel, dt));
+    CHECK_CLOSE(pos.x, -4.0, tol_small);
+    CHECK_CLOSE(pos.y, -0.15, tol_small);
+    CHECK_CLOSE(pos.z, 0.45, tol_small);
+    CHECK_CLOSE(vel.x, -1.0, tol_small);
+    CHECK_CLOSE(vel.y, -0.5, tol_small);
+    CHECK_CLOSE(vel.z, 0.5, tol_small);
+    CHECK_CLOSE(dt, 0.5, tol_small);
+
+    // leaving from the surface is not a collision
+    pos += dt * vel;
+    UP_ASSERT(!cube->detectCollision(pos, vel, dt));
+    CHECK_SMALL(dt, tol_small);
+
+    // slip only reflects the normal component
+    auto slip_cube = make_cube(4.0, mpcd::detail::boundary::slip);
+    pos = make_scalar3(0.1, 0.2, 3.5);
+    vel = make_scalar3(0.5, -0.5, -1.0);
+    dt = 1.0;
+    UP_ASSERT(slip_cube->detectCollision(pos, vel, dt));
+    CHECK_CLOSE(pos.z, 4.0, tol_small);
+    CHECK_CLOSE(vel.x, 0.5, tol_small);
+    CHECK_CLOSE(vel.y, -0.5, tol_small);
+    CHECK_CLOSE(vel.z, 1.0, tol_small);
+    CHECK_CLOSE(dt, 0.5, tol_small);
+
+    // box must be padded by one cell around the mesh
+    UP_ASSERT(cube->validateBox(BoxDim(20.0), 2.0));
+    UP_ASSERT(!cube->validateBox(BoxDim(10.0), 2.0));
+    }
+
+//! Test filling the solid cells near a cube
+UP_TEST(triangle_mesh_fill_basic)
+    {
+    auto exec_conf = std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU);
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = BoxDim(20.0);
+    snap->particle_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    auto mpcd_sys_snap = std::make_shared<mpcd::SystemDataSnapshot>(sysdef);
+        {
+        std::shared_ptr<mpcd::ParticleDataSnapshot> mpcd_snap = mpcd_sys_snap->particles;
+        mpcd_snap->resize(1);
+
+        mpcd_snap->position[0] = vec3<Scalar>(6, -2, 3);
+        mpcd_snap->velocity[0] = vec3<Scalar>(123, 456, 789);
+        }
+    auto mpcd_sys = std::make_shared<mpcd::SystemData>(mpcd_sys_snap);
+    auto pdata = mpcd_sys->getParticleData();
+    mpcd_sys->getCellList()->setCellSize(2.0);
+    UP_ASSERT_EQUAL(pdata->getNVirtual(), 0);
+
+    // cube with half edge 4 aligned with the cell grid
+    auto cube = make_cube(4.0, mpcd::detail::boundary::no_slip);
+    std::shared_ptr<Variant> kT = std::make_shared<VariantConstant>(1.5);
+    std::shared_ptr<mpcd::TriangleMeshGeometryFiller> filler
+        = std::make_shared<mpcd::TriangleMeshGeometryFiller>(mpcd_sys, 2.0, 1, kT, 42, cube);
+
+    /*
+     * Every cell in the cube is within one cell of a face, so the whole cube is filled.
+     */
+    filler->fill(0);
+    UP_ASSERT_EQUAL(pdata->getNVirtual(), 2 * 8 * 8 * 8);
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+
+        // ensure first particle did not get overwritten
+        CHECK_CLOSE(h_pos.data[0].x, 6, tol_small);
+        CHECK_CLOSE(h_pos.data[0].y, -2, tol_small);
+        CHECK_CLOSE(h_pos.data[0].z, 3, tol_small);
+        CHECK_CLOSE(h_vel.data[0].x, 123, tol_small);
+        CHECK_CLOSE(h_vel.data[0].y, 456, tol_small);
+        CHECK_CLOSE(h_vel.data[0].z, 789, tol_small);
+        UP_ASSERT_EQUAL(h_tag.data[0], 0);
+
+        for (unsigned int i = pdata->getN(); i < pdata->getN() + pdata->getNVirtual(); ++i)
+            {
+            UP_ASSERT_EQUAL(h_tag.data[i], i);
+            UP_ASSERT_EQUAL(__scalar_as_int(h_pos.data[i].w), 1);
+
+            const Scalar4 r = h_pos.data[i];
+            UP_ASSERT(cube->isOutside(make_scalar3(r.x, r.y, r.z)));
+            }
+        }
+
+    /*
+     * Shrink the cube so the faces cut through the middle of the cells. The fill is now the
+     * cube of half edge 3 (the cells sliced by the faces are half solid).
+     */
+    pdata->removeVirtualParticles();
+    filler->setGeometry(make_cube(3.0, mpcd::detail::boundary::no_slip));
+    filler->fill(1);
+    UP_ASSERT_EQUAL(pdata->getNVirtual(), 2 * 6 * 6 * 6);
+    }
@@ -11,7 +11,7 @@ from copy import copy
 import itertools
 
 from hoomd.trigger import Trigger
-from hoomd.logging import Loggable
+from hoomd.logging import Loggable, log
 from hoomd.data.parameterdicts import ParameterDict
 from hoomd.error import MutabilityError
 
@@ -307,7 +307,29 @@ class _HOOMDBaseObject(_HOOMDGetSetAttrBase,
         return state
 
 
-class Operation(_HOOMDBaseObject):
+class _TimedObject(_HOOMDBaseObject):
+    """Logs the execution time of the C++ Updater, Analyzer, or Compute."""
+
+    @log(default=False, requires_run=True)
+    def execution_time(self):
+        """float: Total wall clock time spent executing this object \
+        :math:`[\\mathrm{s}]`.
+
+        `execution_time` accumulates from the time the object is attached to
+        the simulation. Log it with a `hoomd.write.Table` or `hoomd.write.GSD`
+        and take the difference between successive entries to monitor the cost
+        of the operation over time.
+
+        Note:
+            GPU kernels execute asynchronously, so the GPU time of one
+            operation may be attributed to a later operation that waits for the
+            kernels to complete. Set `hoomd.Simulation.profiling` to measure
+            GPU kernel times directly.
+        """
+        return self._cpp_obj.execution_time
+
+
+class Operation(_TimedObject):
     """Represents operations that are added to an `hoomd.Operations` object.
 
     Operations in the HOOMD-blue data scheme are objects that *operate* on a
@@ -34,6 +34,10 @@ def test_balance_properties():
     balance.max_iterations = 5
     assert balance.max_iterations == 5
 
+    assert not balance.weighted
+    balance.weighted = True
+    assert balance.weighted
+
 
 def test_attach_detach(simulation_factory, lattice_snapshot_factory):
     snapshot = lattice_snapshot_factory()
@@ -72,6 +76,10 @@ def test_attach_detach(simulation_factory, lattice_snapshot_factory):
     balance.max_iterations = 5
     assert balance.max_iterations == 5
 
+    assert not balance.weighted
+    balance.weighted = True
+    assert balance.weighted
+
     sim.operations.tuners.remove(balance)
 
 
@@ -111,3 +119,33 @@ def test_balance_action(device, simulation_factory, lattice_snapshot_factory):
 
     # the load balance should move the split place down toward the particles
     assert sim.state.domain_decomposition_split_fractions[2][0] < 0.5
+
+
+def test_balance_action_weighted(device, simulation_factory,
+                                 lattice_snapshot_factory):
+    """Test that the load balancer balances the force computation time."""
+    if device.communicator.num_ranks != 2:
+        pytest.skip("Test supports only 2 ranks")
+
+    snapshot = lattice_snapshot_factory()
+
+    # place all particles in the lower MPI domain, so that only it spends time
+    # computing forces
+    box = list(snapshot.configuration.box)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.position[:, 2] -= box[2] / 2
+    box[2] *= 2
+    snapshot.configuration.box = box
+    sim = simulation_factory(snapshot, domain_decomposition=(1, 1, 2))
+
+    lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(buffer=0.4))
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    lj.r_cut[('A', 'A')] = 2.5
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.001, forces=[lj])
+
+    balance = hoomd.tune.LoadBalancer(trigger=hoomd.trigger.Periodic(1),
+                                      weighted=True)
+    sim.operations.tuners.append(balance)
+    sim.run(2)
+
+    assert sim.state.domain_decomposition_split_fractions[2][0] < 0.5
@@ -0,0 +1,65 @@
+import json
+
+import pytest
+
+import hoomd
+from hoomd.benchmarks import benchmarks
+
+
+@pytest.mark.parametrize("name", sorted(benchmarks))
+def test_run(device, name):
+    benchmark = benchmarks[name](device,
+                                 N=512,
+                                 warmup_steps=10,
+                                 benchmark_steps=10,
+                                 repeat=2,
+                                 profile=True)
+    results = benchmark.run()
+
+    assert results['name'] == name
+    assert results['N'] >= 512
+    assert results['steps'] == 10
+    assert len(results['tps_samples']) == 2
+    assert results['tps'] > 0
+    if benchmark.dt is None:
+        assert results['time_per_day'] is None
+        assert results['mps'] > 0
+    else:
+        assert results['time_per_day'] == pytest.approx(results['tps'] * 86400
+                                                        * benchmark.dt)
+    assert results['profile'] is not None
+
+    # the results must be serializable
+    json.dumps(results)
+
+
+def test_lattice_snapshot(device):
+    snapshot = hoomd.benchmarks.make_lattice_snapshot(device, 1000, 1.5)
+    if snapshot.communicator.rank == 0:
+        assert snapshot.particles.N == 1000
+        assert snapshot.configuration.box[0] == pytest.approx(15)
+
+
+def test_communication_breakdown():
+    from hoomd.benchmarks.scaling import communication_breakdown
+
+    def node(time, **children):
+        return dict(time=time, children=children)
+
+    profile = dict(Simulation=node(
+        10.0,
+        Integrator=node(6.0,
+                        comm_ghost_update=node(1.0),
+                        PPPM=node(2.0, **{'ghost cell update': node(0.5)})),
+        NeighborList=node(2.0,
+                          comm_migrate=node(0.25),
+                          comm_ghost_exch=node(0.75)),
+        comm_ghost_update=node(0.5)))
+
+    breakdown = communication_breakdown(profile)
+    assert breakdown == dict(migrate_particles=0.25,
+                             exchange_ghosts=0.75,
+                             update_ghosts=1.5,
+                             update_net_force=0.0,
+                             grid=0.5,
+                             total=10.0)
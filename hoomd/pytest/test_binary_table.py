@@ -0,0 +1,79 @@
+import numpy as np
+import pytest
+
+import hoomd
+import hoomd.write
+
+
+class Counter:
+    """Loggable that returns the number of calls."""
+
+    def __init__(self):
+        self.n = 0
+
+    def __call__(self):
+        self.n += 1
+        return self.n
+
+
+@pytest.fixture
+def logger():
+    logger = hoomd.logging.Logger(categories=['scalar'])
+    logger[('dummy', 'loggable', 'count')] = (Counter(), 'scalar')
+    logger[('dummy', 'loggable', 'float')] = (lambda: 3.1415, 'scalar')
+    return logger
+
+
+def test_invalid_logger():
+    # non-scalar categories are rejected when the writer is created
+    for categories in (['scalar', 'string'], ['scalar', 'sequence']):
+        logger = hoomd.logging.Logger(categories=categories)
+        with pytest.raises(ValueError):
+            hoomd.write.BinaryTable(1, logger, 'log.bin')
+
+
+def test_write_read(simulation_factory, two_particle_snapshot_factory, logger,
+                    tmp_path):
+    filename = tmp_path / 'log.bin'
+    sim = simulation_factory(two_particle_snapshot_factory())
+
+    # write more rows than fit in the buffer to cross flush boundaries
+    table = hoomd.write.BinaryTable(trigger=hoomd.trigger.Periodic(2),
+                                    logger=logger,
+                                    filename=filename,
+                                    buffer_rows=3)
+    sim.operations.writers.append(table)
+    assert table.buffer_rows == 3
+
+    sim.run(20)
+    table.flush()
+
+    if sim.device.communicator.rank == 0:
+        data = hoomd.write.BinaryTable.read(filename)
+        assert data.dtype.names == ('timestep', 'dummy.loggable.count',
+                                    'dummy.loggable.float')
+        np.testing.assert_array_equal(data['timestep'], np.arange(2, 21, 2))
+        np.testing.assert_array_equal(data['dummy.loggable.count'],
+                                      np.arange(1, 11))
+        np.testing.assert_array_equal(data['dummy.loggable.float'], 3.1415)
+
+
+def test_reject_string(simulation_factory, two_particle_snapshot_factory,
+                       logger, tmp_path):
+    # a string quantity added to a scalar logger is rejected when it is written
+    logger[('dummy', 'loggable', 'string')] = (lambda: 'foobarbaz', 'string')
+    sim = simulation_factory(two_particle_snapshot_factory())
+    table = hoomd.write.BinaryTable(trigger=hoomd.trigger.Periodic(1),
+                                    logger=logger,
+                                    filename=tmp_path / 'log.bin')
+    sim.operations.writers.append(table)
+
+    with pytest.raises(ValueError):
+        sim.run(1)
+
+
+def test_read_invalid_file(tmp_path):
+    filename = tmp_path / 'not_a_table.bin'
+    filename.write_bytes(b'0123456789abcdef')
+    with pytest.raises(RuntimeError):
+        hoomd.write.BinaryTable.read(filename)
@@ -48,6 +48,42 @@ def test_common_properties(device, tmp_path):
                               num_cpu_threads=10)
 
 
+def test_memory_placement(device, simulation_factory,
+                          lattice_snapshot_factory):
+    assert device.memory_placement == 'interleave'
+    with pytest.raises(ValueError):
+        device.memory_placement = 'first_touch'
+
+    device.memory_placement = 'partition'
+    assert device.memory_placement == 'partition'
+    sim = simulation_factory(lattice_snapshot_factory(n=40))
+    sim.run(1)
+
+    device.memory_placement = 'interleave'
+    assert device.memory_placement == 'interleave'
+
+
+def test_repeated_messages(device, tmp_path):
+    filename = str(tmp_path / "repeated.txt")
+    device.msg_file = filename
+    for i in range(3):
+        device._cpp_msg.warningRepeated("repeated warning")
+    device._cpp_msg.flushRepeated()
+
+    # closing the file writes the buffered messages
+    device.msg_file = None
+
+    if device.communicator.rank == 0:
+        num_ranks = device.communicator.num_ranks
+        ranks = "1 rank" if num_ranks == 1 else f"{num_ranks} ranks"
+        with open(filename) as f:
+            lines = f.readlines()
+        assert lines == [
+            "*Warning*: repeated warning\n",
+            f"*Warning*: repeated warning ({3 * num_ranks} times on {ranks})\n"
+        ]
+
+
 def _assert_gpu_properties(dev, mem_traceback, gpu_error_checking):
     """Assert properties specific to GPU objects are correct."""
     assert dev.memory_traceback == mem_traceback
@@ -74,6 +110,38 @@ def test_gpu_specific_properties(device):
     assert c[1] >= 0
 
 
+@pytest.mark.gpu
+def test_memory_pool_statistics(device, simulation_factory,
+                                lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory(n=10))
+    sim.run(0)
+
+    stats = device.memory_pool_statistics
+    assert stats['bytes_in_use'] > 0
+    assert stats['bytes_reserved'] >= stats['bytes_in_use']
+    assert stats['peak_bytes_in_use'] >= stats['bytes_in_use']
+    assert stats['peak_bytes_reserved'] >= stats['bytes_reserved']
+    assert stats['num_allocations'] > 0
+
+    device.release_memory_pool()
+    stats = device.memory_pool_statistics
+    assert stats['bytes_reserved'] == stats['bytes_in_use']
+
+
+def test_memory_usage(device, simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory(n=10))
+    sim.run(0)
+
+    usage = device.memory_usage
+    assert usage['ParticleData::m_pos'] >= 1000 * 16
+    assert usage['ParticleData::m_tag'] >= 1000 * 4
+
+    totals = sim.memory_usage
+    assert totals['ParticleData'] >= (usage['ParticleData::m_pos']
+                                      + usage['ParticleData::m_tag'])
+    assert sum(totals.values()) == sum(usage.values())
+
+
 @pytest.mark.gpu
 def test_other_gpu_specifics(device):
     # make sure GPU is available and auto-select gives a GPU
@@ -105,3 +173,35 @@ def test_cpu_build_specifics():
         pytest.skip("Don't run CPU-build specific tests when GPU is available")
     assert not hoomd.device.GPU.is_available()
     assert type(hoomd.device.auto_select()) == hoomd.device.CPU
+
+
+@pytest.mark.gpu
+def test_tuning_cache(device, simulation_factory, lattice_snapshot_factory,
+                      tmp_path):
+    assert device.tuning_cache is None
+    assert device.tuning_drift_tolerance == pytest.approx(0.2)
+
+    filename = tmp_path / "tuning_cache.txt"
+    device.tuning_cache = filename
+    device.tuning_drift_tolerance = 0.5
+    assert device.tuning_cache == str(filename)
+    assert device.tuning_drift_tolerance == pytest.approx(0.5)
+
+    sim = simulation_factory(lattice_snapshot_factory(n=10))
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+    sim.operations.integrator = hoomd.md.Integrator(
+        0.005,
+        methods=[hoomd.md.methods.NVE(hoomd.filter.All())],
+        forces=[lj])
+    sim.run(2000)
+
+    # completed scans store entries for the pair potential
+    if device.communicator.rank == 0:
+        with open(filename) as f:
+            keys = [line.split()[0] for line in f]
+        assert any(key.startswith("pair_lj/") for key in keys)
+
+    device.tuning_cache = None
+    assert device.tuning_cache is None
@@ -0,0 +1,52 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+import os
+import subprocess
+import sys
+
+import pytest
+
+import hoomd
+
+
+def _loaded_modules(environment):
+    """List the hoomd subpackages loaded by ``import hoomd``."""
+    code = ('import sys, hoomd; '
+            'print(" ".join(sorted(m for m in sys.modules '
+            'if m.startswith("hoomd."))))')
+    env = dict(os.environ)
+    env.pop('HOOMD_EAGER_IMPORT', None)
+    env.update(environment)
+    output = subprocess.run([sys.executable, '-c', code],
+                            env=env,
+                            check=True,
+                            capture_output=True,
+                            text=True).stdout
+    return output.split()
+
+
+@pytest.mark.serial
+def test_lazy_import():
+    if not hoomd.version.md_built:
+        pytest.skip('Requires the md subpackage.')
+
+    modules = _loaded_modules({})
+    assert 'hoomd.md' not in modules
+    assert 'hoomd.hpmc' not in modules
+
+    assert 'md' in dir(hoomd)
+    assert hoomd.md.pair.LJ is not None
+
+    with pytest.raises(AttributeError):
+        hoomd.not_a_subpackage
+
+
+@pytest.mark.serial
+def test_eager_import():
+    if not hoomd.version.md_built:
+        pytest.skip('Requires the md subpackage.')
+
+    modules = _loaded_modules({'HOOMD_EAGER_IMPORT': '1'})
+    assert 'hoomd.md' in modules
@@ -0,0 +1,91 @@
+import hoomd
+import numpy as np
+import pytest
+
+
+def test_attach(simulation_factory, two_particle_snapshot_factory, tmp_path):
+    filename = tmp_path / "restart.bin"
+    sim = simulation_factory(two_particle_snapshot_factory())
+    restart = hoomd.write.Restart(trigger=hoomd.trigger.Periodic(1),
+                                  filename=filename)
+    sim.operations.writers.append(restart)
+    sim.run(10)
+    restart.wait()
+    assert restart.filename == str(filename)
+
+
+def _make_nvt(sim):
+    nvt = hoomd.md.methods.NVT(filter=hoomd.filter.All(), kT=1.0, tau=0.5)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005, methods=[nvt])
+    return nvt
+
+
+def test_restart(simulation_factory, lattice_snapshot_factory, tmp_path):
+    filename = tmp_path / "restart.bin"
+    snap = lattice_snapshot_factory(n=4, a=2.0)
+    if snap.communicator.rank == 0:
+        snap.particles.velocity[:] = np.random.default_rng(1).uniform(
+            -1, 1, (snap.particles.N, 3))
+        snap.particles.charge[:] = np.arange(snap.particles.N)
+
+    sim = simulation_factory(snap)
+    nvt = _make_nvt(sim)
+    restart = hoomd.write.Restart(trigger=hoomd.trigger.Periodic(5),
+                                  filename=filename)
+    sim.operations.writers.append(restart)
+    sim.run(5)
+    restart.wait()
+
+    saved = sim.state.get_snapshot()
+    saved_dof = nvt.translational_thermostat_dof
+    assert saved_dof != (0.0, 0.0)
+
+    new_sim = hoomd.Simulation(device=sim.device)
+    new_sim.create_state_from_restart(filename)
+    assert new_sim.timestep == 5
+
+    loaded = new_sim.state.get_snapshot()
+    if loaded.communicator.rank == 0:
+        assert loaded.particles.N == saved.particles.N
+        assert loaded.particles.types == saved.particles.types
+        np.testing.assert_allclose(loaded.configuration.box,
+                                   saved.configuration.box)
+        np.testing.assert_allclose(loaded.particles.position,
+                                   saved.particles.position)
+        np.testing.assert_allclose(loaded.particles.velocity,
+                                   saved.particles.velocity)
+        np.testing.assert_array_equal(loaded.particles.image,
+                                      saved.particles.image)
+        np.testing.assert_allclose(loaded.particles.charge,
+                                   saved.particles.charge)
+
+    new_nvt = _make_nvt(new_sim)
+    new_sim.run(0)
+    assert new_nvt.translational_thermostat_dof == pytest.approx(saved_dof)
+
+
+
+def test_size_hints(simulation_factory, lattice_snapshot_factory, tmp_path):
+    filename = tmp_path / "restart.bin"
+    sim = simulation_factory(lattice_snapshot_factory(n=6, a=1.0))
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+    nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.001,
+                                                    methods=[nve],
+                                                    forces=[lj])
+    restart = hoomd.write.Restart(trigger=hoomd.trigger.Periodic(1),
+                                  filename=filename)
+    sim.operations.writers.append(restart)
+    sim.run(1)
+    restart.wait()
+
+    hint = sim.state._cpp_sys_def.getSizeHint("nlist/Nmax")
+    assert len(hint) == 1
+    assert hint[0] > 4
+
+    new_sim = hoomd.Simulation(device=sim.device)
+    new_sim.create_state_from_restart(filename)
+    new_hint = new_sim.state._cpp_sys_def.getSizeHint("nlist/Nmax")
+    assert new_hint[0] >= hint[0]
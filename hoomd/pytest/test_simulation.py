@@ -2,6 +2,7 @@ import hoomd
 import numpy as np
 import pytest
 from copy import deepcopy
+from io import StringIO
 from hoomd.error import MutabilityError
 from hoomd.logging import LoggerCategories
 from hoomd.conftest import logging_check
@@ -101,6 +102,54 @@ def test_allows_compute_pressure(simulation_factory, lattice_snapshot_factory):
     assert sim.always_compute_pressure is True
 
 
+def test_energy_flag(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory()
+    assert sim.always_compute_energy
+    with pytest.raises(RuntimeError):
+        sim.always_compute_energy = False
+
+    # A logged potential energy must not depend on always_compute_energy.
+    snap = lattice_snapshot_factory(n=6, a=1.2, r=0.1)
+    if snap.communicator.rank == 0:
+        rng = np.random.default_rng(42)
+        snap.particles.velocity[:] = rng.normal(size=(snap.particles.N, 3))
+
+    logged = {}
+    for always_compute_energy in (True, False):
+        sim = simulation_factory(snap)
+        assert sim.always_compute_energy is True
+        sim.always_compute_energy = always_compute_energy
+        assert sim.always_compute_energy is always_compute_energy
+
+        lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(buffer=0.4))
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        lj.r_cut[('A', 'A')] = 2.5
+        nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+        sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                        methods=[nve],
+                                                        forces=[lj])
+        thermo = hoomd.md.compute.ThermodynamicQuantities(
+            filter=hoomd.filter.All())
+        sim.operations.computes.append(thermo)
+
+        logger = hoomd.logging.Logger(categories=['scalar'])
+        logger.add(thermo, quantities=['potential_energy'])
+        output = StringIO()
+        table = hoomd.write.Table(hoomd.trigger.Periodic(7), logger, output)
+        sim.operations.writers.append(table)
+        sim.run(30)
+
+        if sim.device.communicator.rank == 0:
+            rows = output.getvalue().split('\n')[1:]
+            logged[always_compute_energy] = [
+                float(row) for row in rows if row.strip()
+            ]
+
+    if logged:
+        assert len(logged[False]) == 4
+        np.testing.assert_allclose(logged[False], logged[True], rtol=1e-6)
+
+
 def test_run(simulation_factory, lattice_snapshot_factory):
     sim = simulation_factory()
     with pytest.raises(RuntimeError):
@@ -122,6 +171,220 @@ def test_tps(simulation_factory, lattice_snapshot_factory):
     assert sim.tps > 0
 
 
+def test_profile(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory())
+    sim.operations.tuners[0].trigger = hoomd.trigger.Periodic(1)
+    sim.run(5)
+    assert not sim.profiling
+    assert sim.profile is None
+
+    sim.profiling = True
+    sim.run(10)
+    profile = sim.profile
+    assert list(profile.keys()) == ['Simulation']
+    root = profile['Simulation']
+    assert root['time'] > 0
+
+    sfc_pack = root['children']['SFCPack']
+    assert sfc_pack['count'] == 10
+    assert 0 < sfc_pack['time'] <= root['time']
+    assert sfc_pack['gpu_time'] >= 0
+
+    sim.profiling = False
+    sim.run(1)
+    assert sim.profile is None
+
+
+def test_release_gil(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory())
+    assert not sim.release_gil
+
+    class StepRecorder(hoomd.custom.Action):
+
+        def __init__(self):
+            self.steps = []
+
+        def act(self, timestep):
+            self.steps.append(timestep)
+
+    record = StepRecorder()
+    sim.operations.writers.append(
+        hoomd.write.CustomWriter(action=record,
+                                 trigger=hoomd.trigger.Periodic(1)))
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005)
+
+    sim.release_gil = True
+    assert sim.release_gil
+    sim.run(10)
+    assert record.steps == list(range(1, 11))
+
+    sim.release_gil = False
+    sim.run(1)
+    assert record.steps == list(range(1, 12))
+
+
+def test_independent_actions(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory())
+
+    class IndependentRecorder(hoomd.custom.Action):
+        reads = []
+        writes = []
+
+        def __init__(self):
+            self.steps = []
+
+        def act(self, timestep):
+            self.steps.append(timestep)
+
+    class Failure(hoomd.custom.Action):
+        reads = []
+        writes = []
+
+        def act(self, timestep):
+            raise ValueError("failed on the worker")
+
+    record_update = IndependentRecorder()
+    record_write = IndependentRecorder()
+    periodic = hoomd.trigger.Periodic(1)
+    sim.operations.updaters.append(
+        hoomd.update.CustomUpdater(action=record_update, trigger=periodic))
+    sim.operations.writers.append(
+        hoomd.write.CustomWriter(action=record_write, trigger=periodic))
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005)
+    sim.release_gil = True
+
+    sim.run(10)
+    assert record_update.steps == list(range(0, 10))
+    assert record_write.steps == list(range(1, 11))
+
+    sim.operations.writers.append(
+        hoomd.write.CustomWriter(action=Failure(), trigger=periodic))
+    with pytest.raises(ValueError):
+        sim.run(1)
+
+
+def test_max_batch_steps(simulation_factory, lattice_snapshot_factory):
+
+    class StepRecorder(hoomd.custom.Action):
+
+        def __init__(self):
+            self.steps = []
+
+        def act(self, timestep):
+            self.steps.append(timestep)
+
+    def run(max_batch_steps):
+        sim = simulation_factory(lattice_snapshot_factory(n=4, a=1.5, r=0.1))
+        assert sim.max_batch_steps == 1
+        sim.max_batch_steps = max_batch_steps
+
+        nlist = hoomd.md.nlist.Cell(buffer=0.4)
+        lj = hoomd.md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1.0, sigma=1.0)
+        nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+        sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                        methods=[nve],
+                                                        forces=[lj])
+        record = StepRecorder()
+        trigger = hoomd.trigger.Or(
+            [hoomd.trigger.Periodic(7, 3),
+             hoomd.trigger.On(20)])
+        sim.operations.writers.append(
+            hoomd.write.CustomWriter(action=record, trigger=trigger))
+        sim.run(25)
+        assert sim.timestep == 25
+        return record.steps, sim.state.get_snapshot()
+
+    steps, snap = run(1)
+    batched_steps, batched_snap = run(100)
+    assert steps == [3, 10, 17, 20, 24]
+    assert batched_steps == steps
+    if snap.communicator.rank == 0:
+        np.testing.assert_allclose(batched_snap.particles.position,
+                                   snap.particles.position)
+
+
+def test_max_batch_steps_invalid(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory())
+    with pytest.raises(ValueError):
+        sim.max_batch_steps = 0
+
+
+def test_run_concurrently(simulation_factory, lattice_snapshot_factory):
+    sims = [simulation_factory(lattice_snapshot_factory()) for _ in range(3)]
+    for sim in sims:
+        sim.operations.integrator = hoomd.md.Integrator(dt=0.005)
+
+    if sims[0].device.communicator.num_ranks > 1:
+        with pytest.raises(RuntimeError):
+            hoomd.Simulation.run_concurrently(sims, 10)
+        return
+
+    hoomd.Simulation.run_concurrently(sims, 10)
+    for sim in sims:
+        assert sim.timestep == 10
+        assert not sim.release_gil
+
+
+def test_delta_ghost_updates(simulation_factory, lattice_snapshot_factory):
+
+    def run(delta_ghost_updates):
+        sim = simulation_factory(lattice_snapshot_factory(n=8, a=1.5, r=0.1))
+        assert not sim.delta_ghost_updates
+        sim.delta_ghost_updates = delta_ghost_updates
+        assert sim.delta_ghost_updates == delta_ghost_updates
+
+        nlist = hoomd.md.nlist.Cell(buffer=0.4)
+        lj = hoomd.md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+
+        # half of the particles stay in place
+        nve = hoomd.md.methods.NVE(
+            filter=hoomd.filter.Tags(list(range(0, 512, 2))))
+        sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                        forces=[lj],
+                                                        methods=[nve])
+        sim.run(20)
+        return sim.state.get_snapshot()
+
+    snap = run(False)
+    snap_delta = run(True)
+    if snap.communicator.rank == 0:
+        np.testing.assert_array_equal(snap.particles.position,
+                                      snap_delta.particles.position)
+        np.testing.assert_array_equal(snap.particles.velocity,
+                                      snap_delta.particles.velocity)
+
+
+def test_compact_ghost_positions(simulation_factory, lattice_snapshot_factory):
+
+    def run(compact_ghost_positions):
+        sim = simulation_factory(lattice_snapshot_factory(n=8, a=1.5, r=0.1))
+        assert not sim.compact_ghost_positions
+        sim.compact_ghost_positions = compact_ghost_positions
+        assert sim.compact_ghost_positions == compact_ghost_positions
+
+        nlist = hoomd.md.nlist.Cell(buffer=0.4)
+        lj = hoomd.md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+        sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                        forces=[lj],
+                                                        methods=[nve])
+        sim.run(20)
+        return sim.state.get_snapshot()
+
+    snap = run(False)
+    snap_compact = run(True)
+    if snap.communicator.rank == 0:
+        np.testing.assert_allclose(snap.particles.position,
+                                   snap_compact.particles.position,
+                                   rtol=1e-4,
+                                   atol=1e-4)
+        np.testing.assert_array_equal(snap.particles.typeid,
+                                      snap_compact.particles.typeid)
+
+
 def test_timestep(simulation_factory, lattice_snapshot_factory):
     sim = simulation_factory()
     assert sim.timestep is None
@@ -200,6 +463,81 @@ def test_state_from_gsd(device, simulation_factory, lattice_snapshot_factory,
         assert_equivalent_snapshots(snap, sim.state.get_snapshot())
 
 
+@skip_gsd
+def test_state_from_gsd_stream(device, simulation_factory,
+                               lattice_snapshot_factory, tmp_path):
+    d = tmp_path / "sub"
+    d.mkdir()
+    filename = d / "temporary_test_file.gsd"
+
+    sim = simulation_factory(
+        lattice_snapshot_factory(n=10, particle_types=['A', 'B']))
+    snap = update_positions(sim.state.get_snapshot())
+    set_types(snap, random_inds(10), ['A', 'B'], 'B')
+    if device.communicator.rank == 0:
+        snap.particles.mass[:] = 2.0
+        with gsd.hoomd.open(name=filename, mode='wb') as f:
+            f.append(make_gsd_snapshot(snap))
+
+    # use a window that does not evenly divide the number of particles
+    sim = simulation_factory()
+    sim.create_state_from_gsd(filename, stream_window=7)
+    assert_equivalent_snapshots(snap, sim.state.get_snapshot())
+
+
+def test_state_from_lattice(device):
+    sim = hoomd.Simulation(device)
+    sim.create_state_from_lattice(box=hoomd.Box.cube(L=6),
+                                  num_replicas=(3, 3, 3),
+                                  basis_positions=[(0, 0, 0),
+                                                   (0.5, 0.5, 0.5)],
+                                  basis_types=['A', 'B'])
+    assert sim.timestep == 0
+    assert sim.state.N_particles == 54
+    assert sim.state.particle_types == ['A', 'B']
+
+    snap = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        # tag 2 * cell + basis, cells numbered with x fastest
+        cell = np.arange(27)
+        cell_pos = np.stack([cell % 3, (cell // 3) % 3, cell // 9], axis=1)
+        expected = np.empty((54, 3))
+        expected[0::2] = cell_pos * 2 - 3
+        expected[1::2] = cell_pos * 2 - 2
+        np.testing.assert_allclose(snap.particles.position, expected, atol=1e-6)
+        np.testing.assert_equal(snap.particles.typeid, np.tile([0, 1], 27))
+        np.testing.assert_equal(snap.particles.mass, 1.0)
+
+
+def test_state_random(device):
+    sim = hoomd.Simulation(device, seed=5)
+    sim.create_state_random(box=hoomd.Box.cube(L=10),
+                            N_particles={
+                                'A': 150,
+                                'B': 50
+                            },
+                            min_distance=1.0)
+    assert sim.state.N_particles == 200
+    assert sim.state.particle_types == ['A', 'B']
+
+    snap = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        assert np.sum(snap.particles.typeid == 0) == 150
+        pos = snap.particles.position
+        assert np.all(np.abs(pos) <= 5)
+        dr = pos[:, np.newaxis, :] - pos[np.newaxis, :, :]
+        dr -= 10 * np.round(dr / 10)
+        r = np.linalg.norm(dr, axis=2) + 10 * np.eye(200)
+        assert np.min(r) >= 1.0 - 1e-5
+
+
+def test_state_random_requires_seed(device):
+    sim = hoomd.Simulation(device)
+    with pytest.raises(RuntimeError):
+        sim.create_state_random(box=hoomd.Box.cube(L=10),
+                                N_particles={'A': 10})
+
+
 @skip_gsd
 def test_state_from_gsd_snapshot(simulation_factory, lattice_snapshot_factory,
                                  device, state_args, tmp_path):
@@ -416,6 +754,10 @@ def test_logging():
                 'category': LoggerCategories.scalar,
                 'default': True
             },
+            'memory_usage': {
+                'category': LoggerCategories.object,
+                'default': True
+            },
             'seed': {
                 'category': LoggerCategories.scalar,
                 'default': True
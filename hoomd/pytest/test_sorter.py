@@ -2,6 +2,8 @@
 
 from hoomd.conftest import operation_pickling_check
 import hoomd
+import numpy
+import pytest
 
 
 def test_attributes():
@@ -11,6 +13,10 @@ def test_attributes():
 
     assert sorter.trigger is trigger
     assert sorter.grid == 32
+    assert sorter.curve == 'hilbert'
+
+    sorter.curve = 'morton'
+    assert sorter.curve == 'morton'
 
 
 def test_attributes_attached(simulation_factory, two_particle_snapshot_factory):
@@ -26,6 +32,26 @@ def test_attributes_attached(simulation_factory, two_particle_snapshot_factory):
     assert sorter.grid == 32
 
 
+@pytest.mark.parametrize("curve", ['hilbert', 'morton'])
+def test_sort_preserves_particles(curve, simulation_factory,
+                                  lattice_snapshot_factory):
+    """Test that sorting only changes the order of the particles."""
+    snap = lattice_snapshot_factory(n=6, a=1.2, r=0.2)
+    sim = simulation_factory(snap)
+    sim.operations.tuners.clear()
+    sorter = hoomd.tune.ParticleSorter(trigger=hoomd.trigger.Periodic(1),
+                                       grid=64,
+                                       curve=curve)
+    sim.operations.tuners.append(sorter)
+    sim.run(1)
+
+    assert sorter.curve == curve
+    new_snap = sim.state.get_snapshot()
+    if new_snap.communicator.rank == 0:
+        numpy.testing.assert_allclose(new_snap.particles.position,
+                                      snap.particles.position)
+
+
 def test_default_sorter(simulation_factory, two_particle_snapshot_factory):
     """Test that the default Simulation includes a ParticleSorter."""
     sim = simulation_factory(two_particle_snapshot_factory())
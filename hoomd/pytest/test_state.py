@@ -243,6 +243,26 @@ def test_replicate(simulation_factory, lattice_snapshot_factory):
     assert_snapshots_equal(initial_snapshot, new_snapshot)
 
 
+def test_replicate_bonds(simulation_factory, lattice_snapshot_factory):
+    initial_snapshot = lattice_snapshot_factory(a=5, n=2)
+    if initial_snapshot.communicator.rank == 0:
+        initial_snapshot.particles.velocity[:] = [[i, 0, 0] for i in range(8)]
+        initial_snapshot.bonds.types = ['A']
+        initial_snapshot.bonds.N = 2
+        initial_snapshot.bonds.group[:] = [[0, 1], [2, 7]]
+
+    sim = simulation_factory(initial_snapshot)
+
+    initial_snapshot.replicate(3, 2, 1)
+    sim.state.replicate(3, 2, 1)
+    assert sim.state.N_particles == 48
+    new_snapshot = sim.state.get_snapshot()
+    assert_snapshots_equal(initial_snapshot, new_snapshot)
+    if new_snapshot.communicator.rank == 0:
+        numpy.testing.assert_array_equal(new_snapshot.bonds.group,
+                                         initial_snapshot.bonds.group)
+
+
 def test_domain_decomposition(device, simulation_factory,
                               lattice_snapshot_factory):
     snapshot = lattice_snapshot_factory()
@@ -280,3 +300,95 @@ def test_domain_decomposition(device, simulation_factory,
                                                                   [0.25])
     else:
         raise RuntimeError("Test only supports 1 and 2 ranks")
+
+
+def test_domain_decomposition_bisection(simulation_factory,
+                                        lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(a=3, n=10)
+    if snapshot.communicator.rank == 0:
+        # crowd the particles into the lower half of the box along z
+        L = snapshot.configuration.box[2]
+        snapshot.particles.position[:, 2] = (
+            0.5 * snapshot.particles.position[:, 2] - 0.25 * L)
+
+    sim = simulation_factory()
+    if not isinstance(sim.device, hoomd.device.CPU):
+        pytest.skip("Bisection is only supported on the CPU")
+
+    sim.create_state_from_snapshot(snapshot, domain_decomposition='bisection')
+    assert_snapshots_equal(snapshot, sim.state.get_snapshot())
+
+    # the bisection balances the particles among the domains
+    num_ranks = sim.device.communicator.num_ranks
+    assert sim.state.domain_decomposition in ((1, 1, 1), (1, 1, 2))
+    with sim.state.cpu_local_snapshot as data:
+        assert len(data.particles.position) == 1000 // num_ranks
+
+    integrator = hoomd.md.Integrator(dt=0.001)
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    integrator.forces.append(lj)
+    integrator.methods.append(hoomd.md.methods.NVE(filter=hoomd.filter.All()))
+    sim.operations.integrator = integrator
+    sim.run(10)
+
+    new_snapshot = sim.state.get_snapshot()
+    if new_snapshot.communicator.rank == 0:
+        assert new_snapshot.particles.N == snapshot.particles.N
+
+
+def test_particle_resize_policy(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory())
+    assert sim.state.particle_resize_factor == pytest.approx(9 / 8)
+    assert sim.state.particle_shrink_threshold == 0
+
+    sim.state.particle_resize_factor = 1.5
+    sim.state.particle_shrink_threshold = 0.5
+    assert sim.state.particle_resize_factor == 1.5
+    assert sim.state.particle_shrink_threshold == 0.5
+
+    # the arrays would oscillate between two sizes
+    with pytest.raises(RuntimeError):
+        sim.state.particle_shrink_threshold = 0.7
+    with pytest.raises(RuntimeError):
+        sim.state.particle_resize_factor = 2.5
+    with pytest.raises(RuntimeError):
+        sim.state.particle_resize_factor = 1.0
+
+    sim.run(10)
+
+
+def test_checkpoint(simulation_factory, lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory(n=6, a=1.2)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.velocity[:] = numpy.random.default_rng(1).uniform(
+            -1, 1, (snapshot.particles.N, 3))
+    sim = simulation_factory(snapshot)
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    nvt = hoomd.md.methods.NVT(filter=hoomd.filter.All(), kT=1.0, tau=0.5)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                    methods=[nvt],
+                                                    forces=[lj])
+    sim.run(0)
+
+    checkpoint = sim.state.save_checkpoint()
+    saved = sim.state.get_snapshot()
+    sim.run(20)
+    first = sim.state.get_snapshot()
+
+    sim.state.restore_checkpoint(checkpoint)
+    assert_snapshots_equal(saved, sim.state.get_snapshot())
+
+    # the trajectory is reproduced after a restore
+    sim.run(20)
+    second = sim.state.get_snapshot()
+    if second.communicator.rank == 0:
+        numpy.testing.assert_allclose(first.particles.position,
+                                      second.particles.position,
+                                      rtol=1e-4,
+                                      atol=1e-5)
+
+    assert sim.state.save_checkpoint(checkpoint) is checkpoint
@@ -80,6 +80,33 @@ def test_attached_type_checking(attached):
         attached['D'] = dict(bar=2)
 
 
+class DummyBatchCppObj(DummyCppObj):
+
+    def __init__(self):
+        super().__init__()
+        self.batches = []
+
+    def setTypeParamBatch(self, values):  # noqa: N802
+        self.batches.append(sorted(values))
+        self._dict.update(values)
+
+
+def test_batch_set_item(typeparam):
+    cpp_obj = DummyBatchCppObj()
+    typeparam._attach(cpp_obj, DummySimulation())
+    assert cpp_obj.batches == [['A', 'B', 'C']]
+
+    typeparam[['A', 'B']] = dict(bar=2)
+    assert cpp_obj.batches[-1] == ['A', 'B']
+    assert typeparam['A']['bar'] == 2
+    assert typeparam['B']['bar'] == 2
+    assert typeparam['C']['bar'] == 4
+
+    typeparam['C'] = dict(bar=3)
+    assert len(cpp_obj.batches) == 2
+    assert typeparam['C']['bar'] == 3
+
+
 def test_pickling(all_, attached):
     pickling_check(all_)
     pickling_check(attached)
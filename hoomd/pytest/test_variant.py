@@ -232,3 +232,60 @@ def test_custom():
     for i in range(0, 10000, 100):
         assert (hoomd._hoomd._test_variant_call(pkled_variant,
                                                 i) == float(i)**(1 / 2))
+
+
+class CountingVariant(hoomd.variant.Variant):
+
+    def __init__(self):
+        hoomd.variant.Variant.__init__(self)
+        self.calls = 0
+
+    def __call__(self, timestep):
+        self.calls += 1
+        return float(timestep)
+
+    def _min(self):
+        return 0.0
+
+    def _max(self):
+        return 1.0
+
+
+def test_custom_cached():
+    c = CountingVariant()
+
+    # repeated evaluations in the same step call python once
+    for i in range(3):
+        assert hoomd._hoomd._test_variant_call(c, 5) == 5.0
+    assert c.calls == 1
+
+    assert hoomd._hoomd._test_variant_call(c, 6) == 6.0
+    assert c.calls == 2
+
+
+class CustomVectorVariant(hoomd.variant.VectorVariant):
+
+    def __init__(self):
+        hoomd.variant.VectorVariant.__init__(self)
+
+    def __call__(self, timestep):
+        return [1.0, float(timestep)]
+
+    def __len__(self):
+        return 2
+
+
+def test_vector_list():
+    ramp = hoomd.variant.Ramp(0, 10, 0, 10)
+    v = hoomd.variant.VectorList([2.0, ramp])
+    assert len(v) == 2
+    assert v(5) == [2.0, 5.0]
+    assert hoomd._hoomd._test_vector_variant_evaluate(v, 10) == [2.0, 10.0]
+    assert v.variants[1] == ramp
+    pickling_check(v)
+
+
+def test_custom_vector_variant():
+    c = CustomVectorVariant()
+    assert hoomd._hoomd._test_vector_variant_evaluate(c, 3) == [1.0, 3.0]
+    assert hoomd._hoomd._test_vector_variant_evaluate(c, 4) == [1.0, 4.0]
@@ -4,6 +4,7 @@
 
 """Define the Simulation class."""
 import inspect
+import threading
 
 import hoomd._hoomd as _hoomd
 from hoomd.logging import log, Loggable
@@ -39,6 +40,12 @@ class Simulation(metaclass=Loggable):
         self._operations._simulation = self
         self._timestep = None
         self._seed = seed
+        self._profiling = False
+        self._release_gil = False
+        self._max_batch_steps = 1
+        self._delta_ghost_updates = False
+        self._compact_ghost_positions = False
+        self._restart_reader = None
 
     @property
     def device(self):
@@ -121,6 +128,10 @@ class Simulation(metaclass=Loggable):
         if self._seed is not None:
             self._state._cpp_sys_def.setSeed(self._seed)
 
+        self._cpp_sys.enableProfiler(self._profiling)
+        self._cpp_sys.setReleaseGIL(self._release_gil)
+        self._cpp_sys.setMaxBatchSteps(self._max_batch_steps)
+
         self._init_communicator()
 
     def _init_communicator(self):
@@ -134,6 +145,10 @@ class Simulation(metaclass=Loggable):
                 if isinstance(self.device, hoomd.device.CPU):
                     cpp_communicator = _hoomd.Communicator(
                         self.state._cpp_sys_def, decomposition)
+                    cpp_communicator.setDeltaGhostUpdates(
+                        self._delta_ghost_updates)
+                    cpp_communicator.setCompactGhostPositions(
+                        self._compact_ghost_positions)
                 else:
                     cpp_communicator = _hoomd.CommunicatorGPU(
                         self.state._cpp_sys_def, decomposition)
@@ -155,7 +170,8 @@ class Simulation(metaclass=Loggable):
     def create_state_from_gsd(self,
                               filename,
                               frame=-1,
-                              domain_decomposition=(None, None, None)):
+                              domain_decomposition=(None, None, None),
+                              stream_window=0):
         """Create the simulation state from a GSD file.
 
         Args:
@@ -170,7 +186,19 @@ class Simulation(metaclass=Loggable):
                 the x, y, and z directions (e.g. ``(8,4,2)``). Provide a tuple
                 of 3 lists of floats to set the fraction of the simulation box
                 to include in each domain. The sum of each list of floats must
-                be 1.0 (e.g. ``([0.25, 0.75], [0.2, 0.8], [1.0])``).
+                be 1.0 (e.g. ``([0.25, 0.75], [0.2, 0.8], [1.0])``). Provide
+                ``'bisection'`` to choose the number of domains automatically
+                and place the cuts by recursive coordinate bisection so that
+                every domain holds the same number of particles. The bisection
+                requires a CPU device and a system without bonded groups, and
+                cannot be combined with `hoomd.tune.LoadBalancer`.
+
+            stream_window (int): When non-zero, read at most this many
+                particles from the file at a time and send them directly to the
+                MPI ranks that own them. Set `stream_window` to limit the root
+                rank's memory use when initializing very large systems. The
+                default of 0 reads all particles into a snapshot on the root
+                rank.
 
         Note:
             Set any or all of the ``domain_decomposition`` tuple elements to
@@ -180,23 +208,74 @@ class Simulation(metaclass=Loggable):
             automatically selected direction. The default value of ``(None,
             None, None)`` will automatically select the number of domains in all
             directions.
+
+            When every node runs the same number of ranks, the ranks on each
+            node own a compact block of neighboring domains, so that most ghost
+            particles are exchanged within a node.
         """
         if self._state is not None:
             raise RuntimeError("Cannot initialize more than once\n")
         filename = _hoomd.mpi_bcast_str(filename, self.device._cpp_exec_conf)
         # Grab snapshot and timestep
         reader = _hoomd.GSDReader(self.device._cpp_exec_conf, filename,
-                                  abs(frame), frame < 0)
+                                  abs(frame), frame < 0, int(stream_window))
         snapshot = Snapshot._from_cpp_snapshot(reader.getSnapshot(),
                                                self.device.communicator)
 
         step = reader.getTimeStep() if self.timestep is None else self.timestep
-        self._state = State(self, snapshot, domain_decomposition)
+        if reader.getStreamWindow() > 0:
+            # the snapshot holds no particles, they are streamed from reader
+            self._state = State(self, snapshot, domain_decomposition, reader)
+        else:
+            self._state = State(self, snapshot, domain_decomposition)
 
         reader.clearSnapshot()
 
         self._init_system(step)
 
+    def create_state_from_restart(self,
+                                  filename,
+                                  domain_decomposition=(None, None, None)):
+        """Create the simulation state from restart files.
+
+        Args:
+            filename (str): Base file name given to `hoomd.write.Restart`.
+
+            domain_decomposition (tuple): Choose how to distribute the state
+                across MPI ranks with domain decomposition. See
+                `create_state_from_gsd`.
+
+        `create_state_from_restart` reads the files that `hoomd.write.Restart`
+        wrote on every rank, sets `timestep` to the timestep of the restart
+        point (unless it has been set), and restores the state of the
+        integration methods. Add the same integration methods in the same
+        order as in the simulation that wrote the files so that they continue
+        from their saved state. The neighbor and cell lists start with the
+        memory sizes they reached in the simulation that wrote the files,
+        which avoids reallocating them during the first steps. The number of
+        MPI ranks may differ from the number that wrote the files.
+
+        Note:
+            The first call to `run` restores the integrator state again after
+            the integration methods attach, which replaces values such as
+            ``translational_thermostat_dof`` set on the methods.
+        """
+        if self._state is not None:
+            raise RuntimeError("Cannot initialize more than once\n")
+        filename = _hoomd.mpi_bcast_str(str(filename),
+                                        self.device._cpp_exec_conf)
+        reader = _hoomd.RestartReader(self.device._cpp_exec_conf, filename)
+        snapshot = Snapshot._from_cpp_snapshot(reader.getSnapshot(),
+                                               self.device.communicator)
+
+        step = reader.getTimeStep() if self.timestep is None else self.timestep
+        self._state = State(self, snapshot, domain_decomposition)
+        reader.restoreIntegratorVariables(self._state._cpp_sys_def)
+        reader.restoreSizeHints(self._state._cpp_sys_def)
+        self._restart_reader = reader
+
+        self._init_system(step)
+
     def create_state_from_snapshot(self,
                                    snapshot,
                                    domain_decomposition=(None, None, None)):
@@ -213,7 +292,12 @@ class Simulation(metaclass=Loggable):
                 the x, y, and z directions (e.g. ``(8,4,2)``). Provide a tuple
                 of 3 lists of floats to set the fraction of the simulation box
                 to include in each domain. The sum of each list of floats must
-                be 1.0 (e.g. ``([0.25, 0.75], [0.2, 0.8], [1.0])``).
+                be 1.0 (e.g. ``([0.25, 0.75], [0.2, 0.8], [1.0])``). Provide
+                ``'bisection'`` to choose the number of domains automatically
+                and place the cuts by recursive coordinate bisection so that
+                every domain holds the same number of particles. The bisection
+                requires a CPU device and a system without bonded groups, and
+                cannot be combined with `hoomd.tune.LoadBalancer`.
 
         When `timestep` is `None` before calling, `create_state_from_snapshot`
         sets `timestep` to 0.
@@ -227,6 +311,10 @@ class Simulation(metaclass=Loggable):
             None, None)`` will automatically select the number of domains in all
             directions.
 
+            When every node runs the same number of ranks, the ranks on each
+            node own a compact block of neighboring domains, so that most ghost
+            particles are exchanged within a node.
+
         See Also:
             `State.get_snapshot`
 
@@ -253,6 +341,144 @@ class Simulation(metaclass=Loggable):
 
         self._init_system(step)
 
+    def _create_state_distributed(self, box, particle_types, initializer,
+                                  domain_decomposition):
+        """Create the state with particles generated on each rank."""
+        if self._state is not None:
+            raise RuntimeError("Cannot initialize more than once\n")
+        if isinstance(domain_decomposition, str):
+            raise ValueError("Bisection requires particles to place the cuts, "
+                             "choose the domains explicitly.")
+
+        snapshot = Snapshot(self._device.communicator)
+        snapshot.configuration.box = box
+        if snapshot.communicator.rank == 0:
+            snapshot.particles.types = list(particle_types)
+
+        self._state = State(self, snapshot, domain_decomposition, initializer)
+
+        step = 0
+        if self.timestep is not None:
+            step = self.timestep
+
+        self._init_system(step)
+
+    def create_state_from_lattice(self,
+                                  box,
+                                  num_replicas,
+                                  basis_positions=((0, 0, 0),),
+                                  basis_types=('A',),
+                                  domain_decomposition=(None, None, None)):
+        """Create the simulation state with particles on a lattice.
+
+        Args:
+            box (`hoomd.Box` or `hoomd.box.box_like`): Simulation box, which
+                also defines the lattice vectors.
+
+            num_replicas (tuple[int, int, int]): Number of unit cells along
+                each box vector. Set the last element to 1 in 2D.
+
+            basis_positions (list[tuple[float, float, float]]): Fractional
+                coordinates of the particles in the unit cell, each in the
+                range [0,1).
+
+            basis_types (list[str]): Type name of each basis particle.
+
+            domain_decomposition (tuple): Choose how to distribute the state
+                across MPI ranks with domain decomposition. See
+                `create_state_from_snapshot`. ``'bisection'`` is not supported.
+
+        `create_state_from_lattice` divides the box into unit cells with edges
+        ``box.a / num_replicas[0]``, ``box.b / num_replicas[1]``, and
+        ``box.c / num_replicas[2]`` and places the basis particles in each
+        cell. Every MPI rank generates only the particles in its own domain, so
+        no rank ever holds the whole system. Use it to initialize systems that
+        are too large for a snapshot on a single rank.
+
+        The particle types are the distinct `basis_types` in order of first
+        appearance. Particles are numbered by unit cell with the first box
+        vector varying fastest, then by basis particle. All other particle
+        properties take their default values. `create_state_from_lattice` sets
+        `timestep` to 0 when it is `None`.
+
+        Example::
+
+            # 64,000 particles on a body centered cubic lattice
+            sim.create_state_from_lattice(
+                box=hoomd.Box.cube(L=40 * 1.2),
+                num_replicas=(40, 40, 40),
+                basis_positions=[(0, 0, 0), (0.5, 0.5, 0.5)],
+                basis_types=['A', 'B'])
+        """
+        particle_types = list(dict.fromkeys(basis_types))
+        box = hoomd.Box.from_box(box)
+        num_replicas = tuple(int(n) for n in num_replicas)
+        if len(num_replicas) != 3:
+            raise ValueError("num_replicas must have 3 elements.")
+        if len(basis_positions) != len(basis_types):
+            raise ValueError(
+                "basis_positions and basis_types must have the same length.")
+
+        initializer = _hoomd.LatticeInitializer(
+            _hoomd.make_uint3(*num_replicas),
+            [_hoomd.make_scalar3(*map(float, p)) for p in basis_positions],
+            [particle_types.index(t) for t in basis_types])
+        self._create_state_distributed(box, particle_types, initializer,
+                                       domain_decomposition)
+
+    def create_state_random(self,
+                            box,
+                            N_particles,
+                            min_distance=0,
+                            domain_decomposition=(None, None, None)):
+        """Create the simulation state with randomly placed particles.
+
+        Args:
+            box (`hoomd.Box` or `hoomd.box.box_like`): Simulation box.
+
+            N_particles (dict[str, int]): Number of particles of each type.
+
+            min_distance (float): Minimum distance between particles
+                :math:`[\\mathrm{length}]`.
+
+            domain_decomposition (tuple): Choose how to distribute the state
+                across MPI ranks with domain decomposition. See
+                `create_state_from_snapshot`. ``'bisection'`` is not supported.
+
+        `create_state_random` places particles uniformly at random in the box
+        by random sequential addition, rejecting trial positions closer than
+        `min_distance` to a previously placed particle. Every MPI rank
+        generates only the particles in its own domain, so no rank ever holds
+        the whole system. Each rank generates a number of particles in
+        proportion to the volume of its domain and keeps them at least
+        ``min_distance / 2`` away from the boundaries with neighboring domains.
+
+        Random sequential addition fails to place particles at high densities.
+        Use a small `min_distance` and compress or relax the state after
+        initialization. The particle types are the keys of `N_particles` in
+        order. All other particle properties take their default values. The
+        positions depend on `seed`, which must be set, and on the domain
+        decomposition. `create_state_random` sets `timestep` to 0 when it is
+        `None`.
+
+        Example::
+
+            sim.seed = 2
+            sim.create_state_random(box=hoomd.Box.cube(L=100),
+                                    N_particles={'A': 90_000, 'B': 10_000},
+                                    min_distance=0.9)
+        """
+        if self.seed is None:
+            raise RuntimeError("Set seed before calling create_state_random.")
+
+        particle_types = list(N_particles.keys())
+        initializer = _hoomd.RandomSequentialInitializer(
+            [int(N_particles[t]) for t in particle_types], float(min_distance),
+            self.seed)
+        self._create_state_distributed(hoomd.Box.from_box(box),
+                                       particle_types, initializer,
+                                       domain_decomposition)
+
     @property
     def state(self):
         """hoomd.State: The current simulation state."""
@@ -305,6 +531,21 @@ class Simulation(metaclass=Loggable):
         else:
             return self._cpp_sys.getLastTPS()
 
+    @log(category='object')
+    def memory_usage(self):
+        """dict[str, int]: Bytes allocated by each subsystem on the local rank.
+
+        `memory_usage` sums `hoomd.device.Device.memory_usage` by subsystem.
+        Use it to plan the largest system that fits on a device and to find
+        oversized arrays, such as neighbor lists with many more entries than
+        neighbors.
+        """
+        usage = {}
+        for key, nbytes in self.device.memory_usage.items():
+            subsystem = key.split('::')[0]
+            usage[subsystem] = usage.get(subsystem, 0) + nbytes
+        return usage
+
     @log
     def walltime(self):
         """float: The walltime spent during the last call to `run`.
@@ -366,6 +607,202 @@ class Simulation(metaclass=Loggable):
             if value:
                 self._state._cpp_sys_def.getParticleData().setPressureFlag()
 
+    @property
+    def always_compute_energy(self):
+        """bool: Compute the potential energy on every step (defaults to \
+        ``True``).
+
+        Set `always_compute_energy` to `False` to compute the per particle
+        potential energy only on timesteps where it is needed: when a writer
+        with a `hoomd.logging.Logger` is triggered, when a `hoomd.custom.Action`
+        requests ``Action.Flags.POTENTIAL_ENERGY``, or when using the
+        `hoomd.md.minimize.FIRE` integrator. MD pair potentials on the GPU then
+        skip the energy evaluation on the remaining steps.
+
+        The `hoomd.md.force.Force` energy properties always return valid
+        values. Other quantities that sum the potential energy, such as
+        `hoomd.md.compute.ThermodynamicQuantities.potential_energy`, are only
+        valid on the timesteps where it is computed.
+        """
+        if not hasattr(self, '_cpp_sys'):
+            return True
+        else:
+            return self._cpp_sys.getEnergyFlag()
+
+    @always_compute_energy.setter
+    def always_compute_energy(self, value):
+        if not hasattr(self, '_cpp_sys'):
+            raise RuntimeError('Cannot set flag without state')
+        else:
+            self._cpp_sys.setEnergyFlag(value)
+
+    @property
+    def profiling(self):
+        """bool: Profile the time spent by operations (defaults to ``False``).
+
+        When `profiling` is `True`, `run` records the time spent in each
+        compute, updater, writer, and tuner and in the GPU kernels they launch.
+        Read the results from `profile` after `run` completes.
+
+        Note:
+            GPU kernels are timed with events recorded in the GPU stream, which
+            do not synchronize the host with the GPU. The host ``time`` of an
+            operation that executes on the GPU measures only the time to launch
+            its kernels, while ``gpu_time`` measures the kernel execution time.
+        """
+        return self._profiling
+
+    @profiling.setter
+    def profiling(self, value):
+        self._profiling = bool(value)
+        if hasattr(self, '_cpp_sys'):
+            self._cpp_sys.enableProfiler(self._profiling)
+
+    @property
+    def release_gil(self):
+        """bool: Release the GIL while the integrator advances the system \
+        (defaults to ``False``).
+
+        When `release_gil` is `True`, `run` releases the Python global
+        interpreter lock during each integrator step so that other Python
+        threads (for example, ones that post-process data or write files) can
+        execute concurrently with the simulation. The Python tuners, updaters,
+        and writers of each step still run with the lock held, together in one
+        block between integrator steps.
+
+        Warning:
+            Other threads execute while the integrator modifies the system. They
+            must not access the simulation state or the operations attached to
+            the simulation during `run`. Copy any data they need (e.g. in a
+            custom writer) before passing it to another thread.
+        """
+        return self._release_gil
+
+    @release_gil.setter
+    def release_gil(self, value):
+        self._release_gil = bool(value)
+        if hasattr(self, '_cpp_sys'):
+            self._cpp_sys.setReleaseGIL(self._release_gil)
+
+    @property
+    def max_batch_steps(self):
+        """int: Largest number of steps the integrator takes at once when no \
+        operation is due (defaults to 1).
+
+        Between the time steps on which tuners, updaters, or writers execute,
+        `run` hands the integrator batches of up to `max_batch_steps` steps so
+        that it can advance without returning to `run` on every step. This
+        reduces the host overhead of short time steps, especially on the GPU.
+        `run` analyzes `hoomd.trigger.Periodic`, `hoomd.trigger.Before`,
+        `hoomd.trigger.On`, `hoomd.trigger.After`, `hoomd.trigger.And`, and
+        `hoomd.trigger.Or` to find the next step on which an operation is due.
+        Any other trigger (including custom Python triggers) may be active on
+        every step and disables batching while it is attached.
+
+        `tps`, `walltime`, and Python signals (such as a keyboard interrupt) are
+        updated once per batch. Set `max_batch_steps` to 1 to disable batching.
+        """
+        return self._max_batch_steps
+
+    @max_batch_steps.setter
+    def max_batch_steps(self, value):
+        value = int(value)
+        if value < 1:
+            raise ValueError("max_batch_steps must be at least 1.")
+        self._max_batch_steps = value
+        if hasattr(self, '_cpp_sys'):
+            self._cpp_sys.setMaxBatchSteps(self._max_batch_steps)
+
+    @property
+    def delta_ghost_updates(self):
+        """bool: Send only the ghost particles that moved since the last \
+        ghost update (defaults to ``False``).
+
+        In MPI simulations, every rank sends the positions (and velocities and
+        orientations, when needed) of its ghost particles to the neighboring
+        ranks each time step. When `delta_ghost_updates` is `True`, the ranks
+        send only the ghost particles whose values changed since the last
+        update, so that static walls, frozen substrates, and slow particles
+        cost no bandwidth. Each update sends an extra integer per changed ghost
+        particle.
+
+        Note:
+            `delta_ghost_updates` applies to CPU devices with a grid domain
+            decomposition and has no effect in other simulations.
+        """
+        return self._delta_ghost_updates
+
+    @delta_ghost_updates.setter
+    def delta_ghost_updates(self, value):
+        self._delta_ghost_updates = bool(value)
+        if (getattr(self, '_system_communicator', None) is not None
+                and isinstance(self.device, hoomd.device.CPU)):
+            self._system_communicator.setDeltaGhostUpdates(
+                self._delta_ghost_updates)
+
+    @property
+    def compact_ghost_positions(self):
+        """bool: Send ghost particle positions in single precision \
+        (defaults to ``False``).
+
+        In MPI simulations, every rank sends the positions of its ghost
+        particles to the neighboring ranks each time step. When
+        `compact_ghost_positions` is `True`, the ranks send each position as
+        three single precision offsets from the center of the domain face that
+        the ghost particle crosses, and do not send the particle type, which
+        the ranks already exchange when they build the ghost layer. This
+        reduces the size of the position messages by a factor of 2.7 in double
+        precision builds of HOOMD-blue.
+
+        Offsets are rounded to single precision, so ghost particle positions
+        differ from the positions of the particles on their own rank by up to
+        :math:`10^{-7}` times the domain size. Forces between particles on
+        different ranks then differ by a similar relative amount.
+
+        Note:
+            `compact_ghost_positions` applies to CPU devices with a grid
+            domain decomposition and has no effect in other simulations or
+            when `delta_ghost_updates` is `True`.
+        """
+        return self._compact_ghost_positions
+
+    @compact_ghost_positions.setter
+    def compact_ghost_positions(self, value):
+        self._compact_ghost_positions = bool(value)
+        if (getattr(self, '_system_communicator', None) is not None
+                and isinstance(self.device, hoomd.device.CPU)):
+            self._system_communicator.setCompactGhostPositions(
+                self._compact_ghost_positions)
+
+    @property
+    def profile(self):
+        """dict: Per-operation time breakdown of the last profiled `run`.
+
+        `profile` is a nested dictionary with one entry named
+        ``'Simulation'``. Each node in the tree is a dictionary with the keys:
+
+        * ``time`` (float): Total host wall time spent in the operation
+          :math:`[\\mathrm{s}]`.
+        * ``gpu_time`` (float): Total time spent in GPU kernels launched by
+          the operation :math:`[\\mathrm{s}]`.
+        * ``count`` (int): Number of times the operation executed.
+        * ``flop_count`` (int): Estimated floating point operations.
+        * ``byte_count`` (int): Estimated bytes of memory transferred.
+        * ``children`` (dict): Maps the names of the sub-operations to their
+          nodes.
+
+        `profile` is `None` when `profiling` was `False` during the last call
+        to `run`. With MPI domain decomposition, `profile` reports the times
+        on the local rank.
+        """
+        if not hasattr(self, '_cpp_sys'):
+            return None
+
+        profiler = self._cpp_sys.profiler
+        if profiler is None:
+            return None
+        return profiler.getTimings()
+
     def run(self, steps, write_at_start=False):
         """Advance the simulation a number of steps.
 
@@ -427,6 +864,11 @@ class Simulation(metaclass=Loggable):
                 "Cannot call run inside of a local snapshot context manager.")
         if not self.operations._scheduled:
             self.operations._schedule()
+        if self._restart_reader is not None:
+            # replace the integrator state that the methods set when attached
+            self._restart_reader.restoreIntegratorVariables(
+                self._state._cpp_sys_def)
+            self._restart_reader = None
 
         steps_int = int(steps)
         if steps_int < 0 or steps_int > TIMESTEP_MAX - 1:
@@ -435,6 +877,79 @@ class Simulation(metaclass=Loggable):
 
         self._cpp_sys.run(steps_int, write_at_start)
 
+    @staticmethod
+    def run_concurrently(simulations, steps, write_at_start=False):
+        """Advance several independent simulations at the same time.
+
+        Args:
+            simulations (list[Simulation]): Simulations to advance.
+
+            steps (int): Number of steps to advance each simulation.
+
+            write_at_start (bool): Passed to `run`.
+
+        `run_concurrently` calls `run` for each simulation in its own thread
+        with `release_gil` set to `True` and returns after all simulations
+        complete. Use it to fill one GPU with many small systems, such as the
+        replicas of a parameter sweep, that share a single `device`. The host
+        work and kernel launches of one simulation then overlap with the GPU
+        work of the others. When HOOMD-blue is built with
+        ``GPU_PER_THREAD_DEFAULT_STREAM=on``, the kernels of different
+        simulations may also execute concurrently.
+
+        When a simulation raises an exception, `run_concurrently` waits for
+        the other simulations to complete and then raises the first
+        exception.
+
+        Note:
+            Each simulation must be on a device with a single MPI rank.
+
+        Warning:
+            The simulations must not share any operations or custom actions
+            that keep state.
+
+        Example::
+
+            device = hoomd.device.GPU()
+            replicas = [hoomd.Simulation(device=device, seed=i)
+                        for i in range(64)]
+            # ... set the state and operations of each replica ...
+            hoomd.Simulation.run_concurrently(replicas, 10_000)
+        """
+        simulations = list(simulations)
+        for sim in simulations:
+            if sim.device.communicator.num_ranks > 1:
+                raise RuntimeError(
+                    "run_concurrently requires devices with one MPI rank.")
+
+        errors = [None] * len(simulations)
+
+        def advance(i):
+            try:
+                simulations[i].run(steps, write_at_start)
+            except BaseException as error:
+                errors[i] = error
+
+        release_gil = [sim.release_gil for sim in simulations]
+        threads = [
+            threading.Thread(target=advance, args=(i,))
+            for i in range(len(simulations))
+        ]
+        try:
+            for sim in simulations:
+                sim.release_gil = True
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+        finally:
+            for sim, value in zip(simulations, release_gil):
+                sim.release_gil = value
+
+        for error in errors:
+            if error is not None:
+                raise error
+
 
 def _match_class_path(obj, *matches):
     return any(cls.__module__ + '.' + cls.__name__ in matches
@@ -24,6 +24,11 @@ def _create_domain_decomposition(device, box, domain_decomposition):
         domain_decomposition: See Simulation.create_state_from_* for a
           description.
     """
+    bisection = isinstance(domain_decomposition,
+                           str) and domain_decomposition == 'bisection'
+    if bisection:
+        domain_decomposition = (None, None, None)
+
     if (not isinstance(domain_decomposition, collections.abc.Sequence)
             or len(domain_decomposition) != 3):
         raise TypeError("domain_decomposition must be a length 3 sequence")
@@ -58,15 +63,27 @@ def _create_domain_decomposition(device, box, domain_decomposition):
             v[:-1] if v is not None else [] for v in domain_decomposition
         ]
         result = _hoomd.DomainDecomposition(device._cpp_exec_conf, box.getL(),
-                                            *fractions)
+                                            *fractions, True)
     else:
         grid = [v if v is not None else 0 for v in domain_decomposition]
         result = _hoomd.DomainDecomposition(device._cpp_exec_conf, box.getL(),
-                                            *grid, False)
+                                            *grid, True)
 
+    result.setBisection(bisection)
     return result
 
 
+class Checkpoint:
+    """Rank-local copy of the simulation state.
+
+    Create checkpoints with `State.save_checkpoint`.
+    """
+
+    def __init__(self, state):
+        self._state = state
+        self._cpp_obj = _hoomd.SystemCheckpoint(state._cpp_sys_def)
+
+
 class State:
     """The state of a `hoomd.Simulation` object.
 
@@ -220,20 +237,27 @@ class State:
     .. _Kamberaj 2005: http://dx.doi.org/10.1063/1.1906216
     """
 
-    def __init__(self, simulation, snapshot, domain_decomposition):
+    def __init__(self,
+                 simulation,
+                 snapshot,
+                 domain_decomposition,
+                 particle_source=None):
         self._simulation = simulation
         snapshot._broadcast_box()
         decomposition = _create_domain_decomposition(
             simulation.device, snapshot._cpp_obj._global_box,
             domain_decomposition)
 
+        # stream the particles from a GSDReader or generate them on each rank
+        # with a DistributedInitializer when given
+        sys_def_args = [snapshot._cpp_obj]
+        if particle_source is not None:
+            sys_def_args.append(particle_source)
+        sys_def_args.append(simulation.device._cpp_exec_conf)
         if decomposition is not None:
-            self._cpp_sys_def = _hoomd.SystemDefinition(
-                snapshot._cpp_obj, simulation.device._cpp_exec_conf,
-                decomposition)
-        else:
-            self._cpp_sys_def = _hoomd.SystemDefinition(
-                snapshot._cpp_obj, simulation.device._cpp_exec_conf)
+            sys_def_args.append(decomposition)
+
+        self._cpp_sys_def = _hoomd.SystemDefinition(*sys_def_args)
 
         # Necessary for local snapshot API. This is used to ensure two local
         # snapshots are not contexted at once.
@@ -317,6 +341,65 @@ class State:
 
         self._cpp_sys_def.initializeFromSnapshot(snapshot._cpp_obj)
 
+    def save_checkpoint(self, checkpoint=None):
+        """Save the simulation state for a fast rollback.
+
+        Args:
+            checkpoint (Checkpoint): A checkpoint of this state to overwrite.
+              When `None`, create a new checkpoint.
+
+        `save_checkpoint` copies the particle data and the integrator variables
+        (such as thermostat degrees of freedom) into a `Checkpoint` and
+        `restore_checkpoint` copies them back. Unlike `get_snapshot` and
+        `set_snapshot`, checkpoints do not gather or scatter data. Each MPI
+        rank keeps its own particles, and on a GPU the copy stays in device
+        memory. Use checkpoints for methods that return to the same
+        configuration many times, such as forward flux or transition path
+        sampling.
+
+        Note:
+            A checkpoint does not include the bonds, angles, and other bonded
+            groups. Checkpoints of systems with bonded groups are not supported
+            in MPI simulations with more than one rank.
+
+        Note:
+            Restoring a checkpoint does not change the simulation timestep.
+
+        See Also:
+            `restore_checkpoint`
+
+        Returns:
+            Checkpoint: The checkpoint.
+        """
+        if checkpoint is None:
+            checkpoint = Checkpoint(self)
+        elif checkpoint._state is not self:
+            raise RuntimeError("The checkpoint belongs to another state.")
+        checkpoint._cpp_obj.save()
+        return checkpoint
+
+    def restore_checkpoint(self, checkpoint):
+        """Restore the simulation state from a checkpoint.
+
+        Args:
+            checkpoint (Checkpoint): Checkpoint of this state from
+              `save_checkpoint`.
+
+        `restore_checkpoint` copies the saved particles back in place on each
+        MPI rank without communication. The number of particles and the
+        integration methods must be the same as when the checkpoint was saved.
+        A checkpoint may be restored any number of times.
+
+        See Also:
+            `save_checkpoint`
+        """
+        if self._in_context_manager:
+            raise RuntimeError(
+                "Cannot restore a checkpoint inside local snapshot.")
+        if checkpoint._state is not self:
+            raise RuntimeError("The checkpoint belongs to another state.")
+        checkpoint._cpp_obj.restore()
+
     @property
     def particle_types(self):
         """list[str]: List of all particle types in the simulation state."""
@@ -457,10 +540,16 @@ class State:
         factor of ``nx``, ``ny``, and ``nz`` in the direction of the first,
         second, and third box lattice vectors respectively and adjusts the
         particle positions to center them in the new box.
+
+        In MPI simulations, `replicate` broadcasts the initial state to all
+        ranks once, and each rank constructs only the copies of the particles
+        in its own domain. The root rank never holds the replicated state.
         """
+        if self._in_context_manager:
+            raise RuntimeError(
+                "Cannot replicate the state inside local snapshot.")
         snap = self.get_snapshot()
-        snap.replicate(nx, ny, nz)
-        self.set_snapshot(snap)
+        self._cpp_sys_def.replicate(snap._cpp_obj, int(nx), int(ny), int(nz))
 
     def _get_group(self, filter_):
         cls = filter_.__class__
@@ -661,3 +750,35 @@ class State:
             len(particle_data.getDomainDecomposition().getCumulativeFractions(
                 dir)) - 1 for dir in range(3)
         ])
+
+    @property
+    def particle_resize_factor(self):
+        """float: Factor by which the local particle arrays grow when full.
+
+        Each time the arrays grow, every per-particle array in the simulation is
+        reallocated. Larger values reallocate less often and use more memory.
+        Must be greater than 1.
+        """
+        return self._cpp_sys_def.getParticleData().getResizeFactor()
+
+    @particle_resize_factor.setter
+    def particle_resize_factor(self, value):
+        self._cpp_sys_def.getParticleData().setResizeFactor(float(value))
+
+    @property
+    def particle_shrink_threshold(self):
+        """float: Fraction of the capacity below which the local particle \
+        arrays shrink.
+
+        The arrays shrink when the number of local and ghost particles stays
+        below ``particle_shrink_threshold`` times the capacity over 100
+        consecutive changes of the local particle number. Set to 0 to never
+        shrink the arrays.
+        Must be less than ``1 / particle_resize_factor`` so that the arrays do
+        not oscillate between two sizes.
+        """
+        return self._cpp_sys_def.getParticleData().getShrinkThreshold()
+
+    @particle_shrink_threshold.setter
+    def particle_shrink_threshold(self, value):
+        self._cpp_sys_def.getParticleData().setShrinkThreshold(float(value))
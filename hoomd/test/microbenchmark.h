@@ -0,0 +1,230 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file microbenchmark.h
+    \brief A minimal harness to measure the throughput of header-only kernels
+    \details Modeled after Google Benchmark: each benchmark is a function that runs the code under
+    test a given number of iterations. The harness increases the number of iterations until a
+    run takes at least the minimum time and reports the time per iteration and the number of
+    items (e.g. pair evaluations or overlap checks) per second.
+    \note This file should be included only once and by a file that will compile into a
+    microbenchmark executable
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace hoomd
+    {
+namespace test
+    {
+//! Prevent the compiler from optimizing away the computation of a value
+template<class T> inline void do_not_optimize(const T& value)
+    {
+    asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+//! State of one run of a microbenchmark
+class MicroBenchmarkState
+    {
+    public:
+    //! Constructor
+    /*! \param iterations Number of iterations to run
+     */
+    explicit MicroBenchmarkState(uint64_t iterations)
+        : m_iterations(iterations), m_items_per_iteration(1), m_manual_time(-1.0)
+        {
+        }
+
+    //! Get the number of iterations to run
+    uint64_t iterations() const
+        {
+        return m_iterations;
+        }
+
+    //! Set the number of items processed in one iteration
+    void setItemsPerIteration(uint64_t items)
+        {
+        m_items_per_iteration = items;
+        }
+
+    //! Get the number of items processed in one iteration
+    uint64_t getItemsPerIteration() const
+        {
+        return m_items_per_iteration;
+        }
+
+    //! Report the time of the run measured by the benchmark
+    /*! \param seconds Time of all iterations
+
+        GPU benchmarks time the kernels with events and report that time instead of the wall time
+        of the whole function, which includes the setup.
+    */
+    void setManualTime(double seconds)
+        {
+        m_manual_time = seconds;
+        }
+
+    //! Get the time reported with setManualTime, negative when not set
+    double getManualTime() const
+        {
+        return m_manual_time;
+        }
+
+    private:
+    uint64_t m_iterations;          //!< Number of iterations to run
+    uint64_t m_items_per_iteration; //!< Items processed in one iteration
+    double m_manual_time;           //!< Time reported by the benchmark (in seconds)
+    };
+
+//! Collection of microbenchmarks and the driver that runs them
+/*! Register benchmarks with add() and call run() from main(). run() accepts the command line
+    options:
+
+    - `--filter <substring>`: only run the benchmarks with names that contain the substring
+    - `--min-time <seconds>`: minimum time of the measured run (default: 0.5)
+    - `--json <file>`: also write the results to a JSON file
+*/
+class MicroBenchmarkRegistry
+    {
+    public:
+    typedef std::function<void(MicroBenchmarkState&)> function_type;
+
+    //! Register a microbenchmark
+    /*! \param name Name of the benchmark
+        \param function Function that runs state.iterations() iterations of the code under test
+    */
+    void add(const std::string& name, function_type function)
+        {
+        m_benchmarks.push_back(std::make_pair(name, function));
+        }
+
+    //! Run the registered benchmarks
+    /*! \param argc Number of command line arguments
+        \param argv Command line arguments
+        \returns The exit code for main()
+    */
+    int run(int argc, char** argv)
+        {
+        std::string filter;
+        std::string json_filename;
+        double min_time = 0.5;
+
+        for (int i = 1; i < argc; i++)
+            {
+            std::string arg(argv[i]);
+            if (arg == "--filter" && i + 1 < argc)
+                filter = argv[++i];
+            else if (arg == "--min-time" && i + 1 < argc)
+                min_time = std::atof(argv[++i]);
+            else if (arg == "--json" && i + 1 < argc)
+                json_filename = argv[++i];
+            else
+                {
+                std::cerr << "Usage: " << argv[0]
+                          << " [--filter substring] [--min-time seconds] [--json file]"
+                          << std::endl;
+                return 1;
+                }
+            }
+
+        std::cout << std::left << std::setw(40) << "benchmark" << std::right << std::setw(14)
+                  << "iterations" << std::setw(16) << "ns/iteration" << std::setw(16)
+                  << "items/s" << std::endl;
+
+        std::vector<Result> results;
+        for (const auto& benchmark : m_benchmarks)
+            {
+            if (benchmark.first.find(filter) == std::string::npos)
+                continue;
+
+            Result result = measure(benchmark.first, benchmark.second, min_time);
+            std::cout << std::left << std::setw(40) << result.name << std::right
+                      << std::setw(14) << result.iterations << std::setw(16) << std::fixed
+                      << std::setprecision(2) << result.time / double(result.iterations) * 1e9
+                      << std::setw(16) << std::scientific << std::setprecision(4)
+                      << result.items_per_second << std::endl;
+            results.push_back(result);
+            }
+
+        if (!json_filename.empty())
+            writeJSON(json_filename, results);
+
+        return 0;
+        }
+
+    private:
+    //! Measurement of one benchmark
+    struct Result
+        {
+        std::string name;        //!< Name of the benchmark
+        uint64_t iterations;     //!< Number of iterations in the measured run
+        double time;             //!< Time of the measured run (in seconds)
+        double items_per_second; //!< Throughput
+        };
+
+    //! Increase the number of iterations until a run takes at least min_time
+    Result measure(const std::string& name, const function_type& function, double min_time)
+        {
+        uint64_t iterations = 1;
+        while (true)
+            {
+            MicroBenchmarkState state(iterations);
+            auto start = std::chrono::steady_clock::now();
+            function(state);
+            auto end = std::chrono::steady_clock::now();
+
+            double time = state.getManualTime();
+            if (time < 0)
+                time = std::chrono::duration<double>(end - start).count();
+
+            const uint64_t max_iterations = 1000000000;
+            if (time >= min_time || iterations >= max_iterations)
+                {
+                Result result;
+                result.name = name;
+                result.iterations = iterations;
+                result.time = time;
+                result.items_per_second
+                    = double(iterations * state.getItemsPerIteration()) / time;
+                return result;
+                }
+
+            // aim 40% above the minimum time, growing by at most a factor of 10 per run
+            double factor = time > 0 ? min_time * 1.4 / time : 10.0;
+            factor = std::min(std::max(factor, 2.0), 10.0);
+            iterations = std::min(uint64_t(double(iterations) * factor), max_iterations);
+            }
+        }
+
+    //! Write the results as a JSON list
+    void writeJSON(const std::string& filename, const std::vector<Result>& results)
+        {
+        std::ofstream f(filename);
+        f << "[" << std::endl;
+        for (size_t i = 0; i < results.size(); i++)
+            {
+            f << "  {\"name\": \"" << results[i].name
+              << "\", \"iterations\": " << results[i].iterations
+              << ", \"time\": " << std::setprecision(9) << results[i].time
+              << ", \"items_per_second\": " << results[i].items_per_second << "}"
+              << (i + 1 < results.size() ? "," : "") << std::endl;
+            }
+        f << "]" << std::endl;
+        }
+
+    std::vector<std::pair<std::string, function_type>> m_benchmarks; //!< Registered benchmarks
+    };
+
+    } // end namespace test
+    } // end namespace hoomd
@@ -7,6 +7,7 @@
 
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 #include "hoomd/test/upp11_config.h"
@@ -343,6 +344,102 @@ UP_TEST(uniform_float_test)
     check_range(gen, 5000000, a, b);
     }
 
+//! Draws one value from a new RandomGeneratorR per call, as the DPD thermostat does for each pair
+class ReducedRoundPairValue
+    {
+    public:
+    double operator()(hoomd::RandomGenerator& rng)
+        {
+        hoomd::RandomGeneratorR<7> pair_rng(hoomd::Seed(0, 1, 2), hoomd::Counter(m_i, m_j));
+        m_j++;
+        if (m_j == 1000)
+            {
+            m_i++;
+            m_j = 0;
+            }
+        return hoomd::UniformDistribution<double>(-1, 1)(pair_rng);
+        }
+
+    private:
+    unsigned int m_i = 0;
+    unsigned int m_j = 0;
+    };
+
+//! Test case for UniformDistribution with one value per RandomGeneratorR stream
+UP_TEST(reduced_round_pair_uniform_test)
+    {
+    double a = -1, b = 1;
+    double mean = (a + b) / 2.0, var = 1.0 / 12.0 * (b - a) * (b - a), skew = 0.0,
+           exkurtosis = -6.0 / 5.0;
+
+    ReducedRoundPairValue gen;
+    check_moments(gen, 5000000, mean, var, skew, exkurtosis, 0.01);
+    ReducedRoundPairValue gen_range;
+    check_range(gen_range, 5000000, a, b);
+    }
+
+//! Draws values from a BulkRandomGenerator bound to the generator passed in the first call
+template<typename Real> class BulkGen
+    {
+    public:
+    BulkGen(bool normal) : m_normal(normal) { }
+
+    Real operator()(hoomd::RandomGenerator& rng)
+        {
+        if (!m_gen)
+            m_gen.reset(new hoomd::BulkRandomGenerator<Real>(rng));
+        return m_normal ? m_gen->normal(Real(2.0)) : m_gen->uniformNeg11();
+        }
+
+    void reset()
+        {
+        m_gen.reset();
+        }
+
+    private:
+    bool m_normal;
+    std::unique_ptr<hoomd::BulkRandomGenerator<Real>> m_gen;
+    };
+
+//! Test case for BulkRandomGenerator::uniformNeg11
+UP_TEST(bulk_uniform_double_test)
+    {
+    double a = -1, b = 1;
+    double mean = (a + b) / 2.0, var = 1.0 / 12.0 * (b - a) * (b - a), skew = 0.0,
+           exkurtosis = -6.0 / 5.0;
+
+    BulkGen<double> gen(false);
+    check_moments(gen, 5000000, mean, var, skew, exkurtosis, 0.01);
+    gen.reset();
+    check_range(gen, 5000000, a, b);
+    }
+
+//! Test case for BulkRandomGenerator::normal
+UP_TEST(bulk_normal_double_test)
+    {
+    double sigma = 2.0;
+    double mean = 0.0, var = sigma * sigma, skew = 0, exkurtosis = 0.0;
+    BulkGen<double> gen(true);
+    check_moments(gen, 5000000, mean, var, skew, exkurtosis, 0.01);
+    }
+
+//! Test that BulkRandomGenerator uses all bits of each step
+UP_TEST(bulk_step_count_test)
+    {
+    hoomd::RandomGenerator rng(hoomd::Seed(0, 1, 2), hoomd::Counter(4, 5, 6));
+    uint32_t start = rng.getCounter().v[0];
+    hoomd::BulkRandomGenerator<double> gen(rng);
+
+    // three uniform and three normal values take 7 words
+    gen.uniformNeg11();
+    gen.uniformNeg11();
+    gen.uniformNeg11();
+    gen.normal();
+    gen.normal();
+    gen.normal();
+    UP_ASSERT_EQUAL(rng.getCounter().v[0] - start, 4u);
+    }
+
 //! Test case for UniformIntDistribution
 UP_TEST(uniform_int_test_1000)
     {
@@ -261,6 +261,63 @@ UP_TEST(ParticleGroup_sort_test)
         }
     }
 
+//! Checks that groups sharing the membership masks, and groups beyond the 64 mask bits, handle
+//! resorts
+UP_TEST(ParticleGroup_many_groups_test)
+    {
+    std::shared_ptr<SystemDefinition> sysdef = create_sysdef();
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    // more groups than bits in the membership masks, group i contains the particle with tag i % 10
+    std::vector<std::shared_ptr<ParticleGroup>> groups;
+    for (unsigned int i = 0; i < 70; i++)
+        {
+        std::shared_ptr<ParticleFilter> selector(
+            new ParticleFilterTags(std::vector<unsigned int>({i % 10})));
+        groups.push_back(std::make_shared<ParticleGroup>(sysdef, selector));
+        }
+
+    // a released bit is reused without the members of its previous group
+    groups[3].reset();
+    std::shared_ptr<ParticleFilter> selector_empty(new ParticleFilterType(100, 100));
+    groups[3] = std::make_shared<ParticleGroup>(sysdef, selector_empty);
+    CHECK_EQUAL_UINT(groups[3]->getNumMembers(), 0);
+
+        // resort the particles
+        {
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::readwrite);
+        ArrayHandle<unsigned int> h_rtag(pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::readwrite);
+        for (unsigned int i = 0; i < pdata->getN(); i++)
+            {
+            h_tag.data[i] = pdata->getN() - 1 - i;
+            h_rtag.data[i] = pdata->getN() - 1 - i;
+            }
+        }
+
+    pdata->notifyParticleSort();
+
+    for (unsigned int i = 0; i < 70; i++)
+        {
+        if (i == 3)
+            {
+            CHECK_EQUAL_UINT(groups[i]->getNumMembers(), 0);
+            continue;
+            }
+
+        CHECK_EQUAL_UINT(groups[i]->getNumMembers(), 1);
+        CHECK_EQUAL_UINT(groups[i]->getMemberTag(0), i % 10);
+        CHECK_EQUAL_UINT(groups[i]->getMemberIndex(0), pdata->getN() - 1 - i % 10);
+        for (unsigned int j = 0; j < pdata->getN(); j++)
+            {
+            UP_ASSERT_EQUAL(groups[i]->isMember(j), j == pdata->getN() - 1 - i % 10);
+            }
+        }
+    }
+
 //! Checks that ParticleGroup can initialize by particle type
 UP_TEST(ParticleGroup_type_test)
     {
@@ -13,6 +13,7 @@
 
 #include "hoomd/Initializers.h"
 #include "hoomd/ParticleData.h"
+#include "hoomd/ParticleDataSoA.h"
 #include "hoomd/SnapshotSystemData.h"
 
 #include "upp11_config.h"
@@ -615,6 +616,176 @@ UP_TEST(ParticleData_test)
         }
     }
 
+//! Test that ParticleDataSoA mirrors the particle data
+UP_TEST(ParticleDataSoA_test)
+    {
+    BoxDim box(10.0);
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    std::shared_ptr<ParticleData> pdata(new ParticleData(3, box, 2, exec_conf));
+
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar> h_diameter(pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+        for (unsigned int i = 0; i < 3; i++)
+            {
+            h_pos.data[i]
+                = make_scalar4(Scalar(i), Scalar(i + 0.5), -Scalar(i), __int_as_scalar(i % 2));
+            h_vel.data[i]
+                = make_scalar4(Scalar(0.1) * i, Scalar(0.2) * i, Scalar(0.3) * i, Scalar(i + 1));
+            h_diameter.data[i] = Scalar(1.0) + Scalar(i);
+            }
+        }
+
+    Scalar tol = Scalar(1e-6);
+    ParticleDataSoA<float, float> soa(pdata);
+    soa.updatePositions();
+    soa.updateVelocities();
+    soa.updateDiameters();
+
+        {
+        ArrayHandle<Scalar> h_x(soa.getX(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_y(soa.getY(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_z(soa.getZ(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_type(soa.getTypes(), access_location::host, access_mode::read);
+        ArrayHandle<float> h_vx(soa.getVelocityX(), access_location::host, access_mode::read);
+        ArrayHandle<float> h_vy(soa.getVelocityY(), access_location::host, access_mode::read);
+        ArrayHandle<float> h_vz(soa.getVelocityZ(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_mass(soa.getMasses(), access_location::host, access_mode::read);
+        ArrayHandle<float> h_d(soa.getDiameters(), access_location::host, access_mode::read);
+
+        for (unsigned int i = 0; i < 3; i++)
+            {
+            MY_CHECK_CLOSE(h_x.data[i], Scalar(i), tol);
+            MY_CHECK_CLOSE(h_y.data[i], Scalar(i + 0.5), tol);
+            MY_CHECK_CLOSE(h_z.data[i], -Scalar(i), tol);
+            UP_ASSERT_EQUAL(h_type.data[i], i % 2);
+            MY_CHECK_CLOSE(h_vx.data[i], 0.1f * i, tol);
+            MY_CHECK_CLOSE(h_vy.data[i], 0.2f * i, tol);
+            MY_CHECK_CLOSE(h_vz.data[i], 0.3f * i, tol);
+            MY_CHECK_CLOSE(h_mass.data[i], Scalar(i + 1), tol);
+            MY_CHECK_CLOSE(h_d.data[i], 1.0f + i, tol);
+            }
+        }
+
+    // the mirror follows changes of the particle data after an update
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        h_pos.data[1].x = Scalar(4.0);
+        }
+    soa.updatePositions();
+
+    ArrayHandle<Scalar> h_x(soa.getX(), access_location::host, access_mode::read);
+    MY_CHECK_CLOSE(h_x.data[1], 4.0, tol);
+    }
+
+//! Count the emissions of a signal
+struct SignalCounter
+    {
+    void count()
+        {
+        n++;
+        }
+
+    unsigned int n = 0;
+    };
+
+//! Test that a particle number batch emits the global particle number change signal once
+UP_TEST(ParticleData_particle_number_batch_test)
+    {
+    SignalCounter n_global_changes;
+    SignalCounter n_max_changes;
+
+    BoxDim box(10.0);
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    std::shared_ptr<ParticleData> pdata(new ParticleData(3, box, 1, exec_conf));
+    pdata->getGlobalParticleNumberChangeSignal().connect<SignalCounter, &SignalCounter::count>(
+        &n_global_changes);
+    pdata->getMaxParticleNumberChangeSignal().connect<SignalCounter, &SignalCounter::count>(
+        &n_max_changes);
+
+    // adding the reserved particles does not reallocate the arrays
+    pdata->reserveParticles(100);
+    unsigned int n_max_reserved = n_max_changes.n;
+
+    pdata->beginParticleNumberBatch();
+    std::vector<unsigned int> tags;
+    for (unsigned int i = 0; i < 100; i++)
+        tags.push_back(pdata->addParticle(0));
+    for (unsigned int i = 0; i < 50; i++)
+        pdata->removeParticle(tags[2 * i]);
+
+    UP_ASSERT_EQUAL(n_global_changes.n, 0u);
+    UP_ASSERT_EQUAL(pdata->getNGlobal(), 53u);
+    pdata->endParticleNumberBatch();
+
+    UP_ASSERT_EQUAL(n_global_changes.n, 1u);
+    UP_ASSERT_EQUAL(n_max_changes.n, n_max_reserved);
+    UP_ASSERT_EQUAL(pdata->getN(), 53u);
+    UP_ASSERT_EQUAL(pdata->getMaximumTag(), 102u);
+    for (unsigned int i = 0; i < 50; i++)
+        {
+        UP_ASSERT(!pdata->isTagActive(tags[2 * i]));
+        UP_ASSERT(pdata->isTagActive(tags[2 * i + 1]));
+        }
+
+    // a batch without changes does not emit the signal
+    pdata->beginParticleNumberBatch();
+    pdata->endParticleNumberBatch();
+    UP_ASSERT_EQUAL(n_global_changes.n, 1u);
+
+    // removing the largest tag lowers the maximum tag and the active tags stay in order
+    pdata->removeParticle(102);
+    UP_ASSERT_EQUAL(pdata->getMaximumTag(), 100u);
+    UP_ASSERT_EQUAL(pdata->addParticle(0), 102u);
+    UP_ASSERT_EQUAL(pdata->getMaximumTag(), 102u);
+    UP_ASSERT_EQUAL(pdata->getNthTag(3), 4u);
+    UP_ASSERT_EQUAL(pdata->getNthTag(52), 102u);
+    }
+
+//! Test that initializeFromLocal rejects generated tags that are not a permutation
+UP_TEST(ParticleData_initialize_from_local_test)
+    {
+    BoxDim box(10.0);
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    std::shared_ptr<ParticleData> pdata(new ParticleData(3, box, 1, exec_conf));
+    std::vector<std::string> type_mapping(1, "A");
+
+    // generate three particles with the given tags
+    auto initialize = [&](std::vector<unsigned int> tags)
+    {
+        pdata->initializeFromLocal(
+            3,
+            type_mapping,
+            [&](SnapshotParticleData<Scalar>& local, std::vector<unsigned int>& tag)
+            {
+                local.resize(3);
+                for (unsigned int i = 0; i < 3; i++)
+                    local.pos[i] = vec3<Scalar>(Scalar(i), 0, 0);
+                tag = tags;
+            });
+    };
+
+    initialize({2, 0, 1});
+    UP_ASSERT_EQUAL(pdata->getNGlobal(), 3u);
+    UP_ASSERT_EQUAL(pdata->getRTag(2), 0u);
+
+    // a duplicate tag hides a missing tag from the particle count
+    UP_ASSERT_EXCEPTION(std::runtime_error, [&] { initialize({0, 1, 1}); });
+    UP_ASSERT_EXCEPTION(std::runtime_error, [&] { initialize({0, 1, 3}); });
+    }
+
 //! Tests the RandomParticleInitializer class
 UP_TEST(Random_test)
     {
@@ -0,0 +1,67 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <memory>
+
+#include "hoomd/SpatialIndex.h"
+#include "hoomd/SystemDefinition.h"
+
+#include "upp11_config.h"
+
+using namespace std;
+using namespace hoomd;
+
+/*! \file test_spatial_index.cc
+    \brief Implements unit tests for SpatialIndex
+    \ingroup unit_tests
+*/
+HOOMD_UP_MAIN();
+
+//! Test that the trees are reused until the particles change
+UP_TEST(SpatialIndex_reuse)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    std::shared_ptr<SystemDefinition> sysdef(
+        new SystemDefinition(3, BoxDim(10.0), 2, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    pdata->setPosition(0, make_scalar3(-1.0, 0.0, 0.0));
+    pdata->setPosition(1, make_scalar3(1.0, 0.0, 0.0));
+    pdata->setPosition(2, make_scalar3(2.0, 2.0, 2.0));
+    pdata->setType(2, 1);
+
+    // all consumers share the same index
+    std::shared_ptr<SpatialIndex> index = sysdef->getSpatialIndex();
+    UP_ASSERT(index == sysdef->getSpatialIndex());
+
+    const Scalar3 ghost_width = make_scalar3(0.0, 0.0, 0.0);
+    const std::vector<hoomd::detail::AABBTree>& trees = index->getTypeTrees(ghost_width);
+    UP_ASSERT_EQUAL(trees.size(), 2);
+    UP_ASSERT_EQUAL(index->getNumPerType()[0], 2);
+    UP_ASSERT_EQUAL(index->getNumPerType()[1], 1);
+    UP_ASSERT_EQUAL(index->getNumBuilds(), 1);
+
+    // the trees are not rebuilt for the same positions
+    index->getTypeTrees(ghost_width);
+    UP_ASSERT_EQUAL(index->getNumBuilds(), 1);
+
+    // moving a particle rebuilds the trees
+    pdata->setPosition(0, make_scalar3(-2.0, 0.0, 0.0));
+    index->getTypeTrees(ghost_width);
+    UP_ASSERT_EQUAL(index->getNumBuilds(), 2);
+
+    // so does sorting or retyping the particles
+    pdata->notifyParticleSort();
+    index->getTypeTrees(ghost_width);
+    UP_ASSERT_EQUAL(index->getNumBuilds(), 3);
+
+    pdata->setType(0, 1);
+    index->getTypeTrees(ghost_width);
+    UP_ASSERT_EQUAL(index->getNumBuilds(), 4);
+    UP_ASSERT_EQUAL(index->getNumPerType()[0], 1);
+    UP_ASSERT_EQUAL(index->getNumPerType()[1], 2);
+    }
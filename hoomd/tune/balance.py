@@ -19,6 +19,8 @@ class LoadBalancer(Tuner):
         tolerance (`float`): Load imbalance tolerance.
         max_iterations (`int`): Maximum number of iterations to
             attempt in a single step.
+        weighted (`bool`): Balance the time spent computing forces instead of
+            the number of particles when `True`.
 
     `LoadBalancer` adjusts the boundaries of the MPI domains to distribute
     the particle load close to evenly between them. The load imbalance is
@@ -70,6 +72,21 @@ class LoadBalancer(Tuner):
     or to balance once in a short test run and then set the decomposition
     statically in a separate initialization.
 
+    When *weighted* is `True`, the load :math:`W_i` of a rank is the wall
+    time it spent computing the forces of the integrator since the last
+    balancing step, and the imbalance is :math:`I = W_i / \langle W \rangle`.
+    Use this mode when the cost per particle varies strongly in space, for
+    example in dense droplets surrounded by vapor. Each particle carries the
+    average cost of the particles on its rank, so the balancer minimizes the
+    maximum force computation time of any rank. `LoadBalancer` balances by
+    particle number on the first balancing step and whenever a rank has not
+    measured any force computation time.
+
+    Note:
+        Force computes that execute on the GPU are timed on the host. Use
+        *weighted* only with force computes that synchronize with the GPU, as
+        otherwise the measured time does not include the kernel execution time.
+
     Balancing is ignored if there is no domain decomposition available (MPI is
     not built or is running on a single rank).
 
@@ -82,6 +99,8 @@ class LoadBalancer(Tuner):
         tolerance (`float`): Load imbalance tolerance.
         max_iterations (`int`): Maximum number of iterations to
             attempt in a single step.
+        weighted (`bool`): Balance the time spent computing forces instead of
+            the number of particles when `True`.
     """
 
     def __init__(self,
@@ -90,18 +109,21 @@ class LoadBalancer(Tuner):
                  y=True,
                  z=True,
                  tolerance=1.02,
-                 max_iterations=1):
+                 max_iterations=1,
+                 weighted=False):
         defaults = dict(x=x,
                         y=y,
                         z=z,
                         tolerance=tolerance,
                         max_iterations=max_iterations,
+                        weighted=weighted,
                         trigger=trigger)
         self._param_dict = ParameterDict(x=bool,
                                          y=bool,
                                          z=bool,
                                          max_iterations=int,
                                          tolerance=float,
+                                         weighted=bool,
                                          trigger=Trigger)
         self._param_dict.update(defaults)
 
@@ -113,5 +135,6 @@ class LoadBalancer(Tuner):
 
         self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
                                 self.trigger)
+        self._cpp_obj.setSystem(self._simulation._cpp_sys)
 
         super()._attach()
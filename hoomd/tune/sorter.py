@@ -1,7 +1,7 @@
 """Define the ParticleSorter class."""
 
 from hoomd.data.parameterdicts import ParameterDict
-from hoomd.data.typeconverter import OnlyTypes
+from hoomd.data.typeconverter import OnlyTypes, OnlyFrom
 from hoomd.operation import Tuner
 from hoomd.trigger import Trigger
 from hoomd import _hoomd
@@ -20,11 +20,22 @@ class ParticleSorter(Tuner):
             value of `None` sets ``grid=4096`` in 2D simulations and
             ``grid=256`` in 3D simulations.
 
+        curve (str): Space-filling curve to sort along, ``'hilbert'`` or
+            ``'morton'``. Defaults to ``'hilbert'``.
+
     `ParticleSorter` improves simulation performance by sorting the particles in
     memory along a space-filling curve. This takes particles that are close in
     space and places them close in memory, leading to a higher rate of
     cache hits when computing pair potentials.
 
+    The Hilbert curve follows a precomputed traversal order of the grid cells
+    (in 2D, cells are ordered row by row). The Morton (Z-order) curve orders
+    particles by 64-bit keys computed directly from their grid cells, so it
+    needs no traversal order table and supports grids up to ``2**21`` in 3D and
+    ``2**31`` in 2D. On the GPU, the Morton keys are radix sorted on the device
+    and the permutation is applied to all per-particle arrays in one kernel,
+    which makes it cheap enough to sort every few hundred steps.
+
     Note:
         New `hoomd.Operations` instances include a `ParticleSorter`
         constructed with default parameters.
@@ -34,20 +45,25 @@ class ParticleSorter(Tuner):
 
         grid (int): Set the resolution of the space-filling curve.
             `grid` rounds up to the nearest power of 2 when set. Larger values
-            of `grid` provide more accurate space-filling curves, but consume
-            more memory (``grid**D * 4`` bytes, where *D* is the dimensionality
-            of the system).
+            of `grid` provide more accurate space-filling curves, but the
+            Hilbert curve consumes more memory (``grid**D * 4`` bytes, where
+            *D* is the dimensionality of the system).
+
+        curve (str): Space-filling curve to sort along, ``'hilbert'`` or
+            ``'morton'``.
     """
 
-    def __init__(self, trigger=200, grid=None):
+    def __init__(self, trigger=200, grid=None, curve='hilbert'):
         self._param_dict = ParameterDict(
             trigger=Trigger,
             grid=OnlyTypes(int,
                            postprocess=ParticleSorter._to_power_of_two,
                            preprocess=ParticleSorter._natural_number,
-                           allow_none=True))
+                           allow_none=True),
+            curve=OnlyFrom(['hilbert', 'morton']))
         self.trigger = trigger
         self.grid = grid
+        self.curve = curve
 
     @staticmethod
     def _to_power_of_two(value):
@@ -4,6 +4,7 @@
 
 """Implement BoxResize."""
 
+import hoomd
 from hoomd.operation import Updater
 from hoomd.box import Box
 from hoomd.data.parameterdicts import ParameterDict
@@ -71,9 +72,12 @@ class BoxResize(Updater):
 
     def _attach(self):
         group = self._simulation.state._get_group(self.filter)
-        self._cpp_obj = _hoomd.BoxResizeUpdater(
-            self._simulation.state._cpp_sys_def, self.box1, self.box2,
-            self.variant, group)
+        if isinstance(self._simulation.device, hoomd.device.GPU):
+            cpp_cls = _hoomd.BoxResizeUpdaterGPU
+        else:
+            cpp_cls = _hoomd.BoxResizeUpdater
+        self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
+                                self.box1, self.box2, self.variant, group)
         super()._attach()
 
     def get_box(self, timestep):
@@ -106,6 +110,10 @@ class BoxResize(Updater):
                 update.
         """
         group = state._get_group(filter)
-        updater = _hoomd.BoxResizeUpdater(state._cpp_sys_def, state.box, box,
-                                          Constant(1), group)
+        if isinstance(state._simulation.device, hoomd.device.GPU):
+            cpp_cls = _hoomd.BoxResizeUpdaterGPU
+        else:
+            cpp_cls = _hoomd.BoxResizeUpdater
+        updater = cpp_cls(state._cpp_sys_def, state.box, box, Constant(1),
+                          group)
         updater.update(state._simulation.timestep)
@@ -44,9 +44,10 @@ class RemoveDrift(Updater):
 
     def _attach(self):
         if isinstance(self._simulation.device, hoomd.device.GPU):
-            self._simulation.device._cpp_msg.warning(
-                "Falling back on CPU. No GPU implementation available.\n")
+            cpp_cls = _hoomd.UpdaterRemoveDriftGPU
+        else:
+            cpp_cls = _hoomd.UpdaterRemoveDrift
 
-        self._cpp_obj = _hoomd.UpdaterRemoveDrift(
-            self._simulation.state._cpp_sys_def, self.reference_positions)
+        self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
+                                self.reference_positions)
         super()._attach()
@@ -35,6 +35,11 @@ class Variant(_hoomd.Variant):
         :type timestep: int
         :return: The value of the function at the given time step.
         :rtype: float
+
+    Note:
+        HOOMD-blue calls ``__call__`` of a custom variant at most once per time
+        step and reuses the value for all evaluations in that step. The value
+        must depend only on ``timestep``.
     """
 
     @property
@@ -188,3 +193,80 @@ class Power(_hoomd.VariantPower, Variant):
         _hoomd.VariantPower.__init__(self, A, B, power, t_start, t_ramp)
 
     __eq__ = Variant._private_eq
+
+
+class VectorVariant(_hoomd.VectorVariant):
+    """Vector variant base class.
+
+    Vector variants define several values (such as one value per particle type)
+    as a function of the simulation time step and evaluate all of them in one
+    call. Use `VectorList` to combine scalar variants or define your own custom
+    function:
+
+    .. code:: python
+
+        class CustomVectorVariant(hoomd.variant.VectorVariant):
+            def __init__(self):
+                hoomd.variant.VectorVariant.__init__(self)
+
+            def __call__(self, timestep):
+                return [1.0, float(timestep)**(1 / 2)]
+
+            def __len__(self):
+                return 2
+
+    .. py:method:: __call__(timestep)
+
+        Evaluate the function.
+
+        :param timestep: The time step.
+        :type timestep: int
+        :return: The values of the function at the given time step.
+        :rtype: list[float]
+
+    Note:
+        A custom vector variant costs one call into Python per time step,
+        compared to one call per value for a list of custom `Variant` objects.
+        Like `Variant`, HOOMD-blue calls ``__call__`` at most once per time step.
+    """
+
+    def __getstate__(self):
+        """Get the variant's ``__dict__`` attributue."""
+        return self.__dict__
+
+    def __setstate__(self, state):
+        """Restore the state of the variant."""
+        _hoomd.VectorVariant.__init__(self)
+        self.__dict__ = state
+
+
+class VectorList(_hoomd.VectorVariantList, VectorVariant):
+    """A list of variants.
+
+    Args:
+        variants (list[hoomd.variant.Variant or float]): The variants to
+            evaluate. Floats are converted to `Constant` variants.
+
+    :py:class:`VectorList` evaluates all variants in one call:
+
+    .. code-block:: python
+
+        kT = VectorList([1.0, Ramp(1.0, 2.0, 0, 1000)])
+
+    Attributes:
+        variants (list[hoomd.variant.Variant]): The variants to evaluate.
+    """
+
+    def __init__(self, variants):
+        VectorVariant.__init__(self)
+        _hoomd.VectorVariantList.__init__(
+            self,
+            [v if isinstance(v, Variant) else Constant(v) for v in variants])
+
+    def __eq__(self, other):
+        """Return whether two vector variants are equivalent."""
+        if not isinstance(other, VectorVariant):
+            return NotImplemented
+        if not isinstance(other, type(self)):
+            return False
+        return self.variants == other.variants
@@ -5,6 +5,9 @@
 """Version and build information.
 
 Attributes:
+    adios2_enabled (bool): ``True`` when this build includes the ADIOS2
+        trajectory writer.
+
     build_dir (str): The directory where this build was compiled.
 
     compile_date (str): The date this build was compiled.
@@ -50,6 +53,9 @@ Attributes:
 
     tbb_enabled (bool): ``True`` when this build supports TBB threads.
 
+    torch_enabled (bool): ``True`` when this build includes the TorchScript
+        machine-learned potential `hoomd.md.ml.TorchScript`.
+
     version (str): HOOMD-blue package version, following semantic versioning.
 """
 from hoomd import _hoomd
@@ -77,5 +83,7 @@ gpu_platform = _hoomd.BuildInfo.getGPUPlatform()
 cxx_compiler = _hoomd.BuildInfo.getCXXCompiler()
 tbb_enabled = _hoomd.BuildInfo.getEnableTBB()
 mpi_enabled = _hoomd.BuildInfo.getEnableMPI()
+adios2_enabled = _hoomd.BuildInfo.getEnableADIOS2()
+torch_enabled = _hoomd.BuildInfo.getEnableTorch()
 source_dir = _hoomd.BuildInfo.getSourceDir()
 install_dir = _hoomd.BuildInfo.getInstallDir()
@@ -4,7 +4,10 @@
 
 """Writers."""
 
+from hoomd.write.adios2 import ADIOS2
+from hoomd.write.binary_table import BinaryTable
 from hoomd.write.custom_writer import CustomWriter
 from hoomd.write.gsd import GSD
 from hoomd.write.dcd import DCD
+from hoomd.write.restart import Restart
 from hoomd.write.table import Table
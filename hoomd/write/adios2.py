@@ -0,0 +1,73 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Implement ADIOS2."""
+
+from hoomd import _hoomd
+import hoomd.version
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyFrom
+from hoomd.filter import ParticleFilter, All
+from hoomd.operation import Writer
+
+
+class ADIOS2(Writer):
+    """Publish per-rank particle data through ADIOS2.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to write.
+        filename (str): File or stream name to write.
+        filter (hoomd.filter.ParticleFilter): Select the particles to write.
+            Defaults to `hoomd.filter.All`.
+        engine (str): ADIOS2 engine type: ``'BP5'`` writes a file and
+            ``'SST'`` stages the steps in memory for concurrent readers.
+
+    `ADIOS2` writes each frame as one ADIOS2 step. It does not gather the
+    particles to the root rank: each MPI rank writes the selected particles it
+    owns as one block of the global arrays ``particles/tag``,
+    ``particles/typeid``, ``particles/position``, and ``particles/image``. The
+    rows are in rank order, use ``particles/tag`` to identify the particles.
+    The root rank writes ``configuration/step`` and ``configuration/box``, and
+    the type names are stored in the ``particles/types`` attribute. Names and
+    units follow the GSD HOOMD schema.
+
+    With the ``'SST'`` engine, analysis codes on other nodes can read the steps
+    as they are produced, and the simulation ranks only pay the cost of copying
+    their local particles.
+
+    Note:
+        `ADIOS2` is available only when HOOMD-blue is built with
+        ``ENABLE_ADIOS2=on``. See `hoomd.version.adios2_enabled`.
+
+    Examples::
+
+        adios2 = hoomd.write.ADIOS2(trigger=hoomd.trigger.Periodic(100),
+                                    filename='trajectory.bp',
+                                    engine='SST')
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to write.
+        filename (str): File or stream name to write.
+        filter (hoomd.filter.ParticleFilter): Select the particles to write.
+        engine (str): ADIOS2 engine type.
+    """
+
+    def __init__(self, trigger, filename, filter=All(), engine='BP5'):
+
+        super().__init__(trigger)
+        self._param_dict.update(
+            ParameterDict(filename=str(filename),
+                          filter=ParticleFilter,
+                          engine=OnlyFrom(['BP5', 'SST']),
+                          _defaults=dict(filter=filter, engine=engine)))
+
+    def _attach(self):
+        if not hoomd.version.adios2_enabled:
+            raise RuntimeError(
+                "ADIOS2 is not available in this build of HOOMD-blue.")
+
+        self._cpp_obj = _hoomd.ADIOS2Writer(
+            self._simulation.state._cpp_sys_def, self.filename,
+            self._simulation.state._get_group(self.filter), self.engine)
+        super()._attach()
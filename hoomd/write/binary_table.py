@@ -0,0 +1,166 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Implement BinaryTable."""
+
+import struct
+
+import numpy as np
+
+from hoomd import _hoomd
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.logging import LoggerCategories
+from hoomd.operation import Writer
+from hoomd.util import dict_flatten
+
+
+class _BinaryTableLogWriter:
+    """Evaluate the logged quantities for `BinaryTableWriter`.
+
+    The C++ writer calls `values` on every rank each time it is triggered and
+    calls `names` on the root rank before it writes the first row.
+    """
+
+    def __init__(self, logger, header_sep):
+        self.logger = logger
+        self.header_sep = header_sep
+        self._keys = None
+
+    def values(self):
+        log = dict_flatten(self.logger.log())
+        keys = tuple(log.keys())
+        if self._keys is None:
+            self._keys = keys
+        elif keys != self._keys:
+            raise RuntimeError(
+                "BinaryTable: The logged quantities cannot change after the "
+                "first row is written.")
+        for key, (_, category) in log.items():
+            if category != 'scalar':
+                raise ValueError(
+                    f"BinaryTable: {self.header_sep.join(key)} is not a "
+                    f"scalar quantity.")
+        return [value[0] for value in log.values()]
+
+    def names(self):
+        return [self.header_sep.join(key) for key in self._keys]
+
+
+class BinaryTable(Writer):
+    """Write logged scalar quantities to a binary table.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to write.
+        logger (hoomd.logging.Logger): The logger to query for output. Only
+            the 'scalar' category may be set on the logger.
+        filename (str): File name to write. An existing file is overwritten.
+        buffer_rows (int): Number of rows to keep in memory before writing
+            them to the file.
+        header_sep (str): String to use to separate names in the logger's
+            namespace in the column names.
+
+    `BinaryTable` is a low overhead alternative to `Table` for logging scalar
+    quantities frequently. It does not format the values as text. The root
+    rank copies each row into a preallocated buffer and writes `buffer_rows`
+    rows at a time. Call `flush` to write the buffered rows before reading the
+    file while the simulation is running.
+
+    Each row holds the timestep and the float64 value of each logged quantity.
+    Read the file with `read`, which returns a numpy structured array with the
+    fields ``timestep`` and one field per column.
+
+    The logged quantities must not change after the first row is written.
+
+    Examples::
+
+        logger = hoomd.logging.Logger(categories=['scalar'])
+        logger.add(thermo, quantities=['kinetic_temperature', 'pressure'])
+        table = hoomd.write.BinaryTable(trigger=hoomd.trigger.Periodic(10),
+                                        logger=logger,
+                                        filename='log.bin')
+
+        data = hoomd.write.BinaryTable.read('log.bin')
+        kT = data['md.compute.ThermodynamicQuantities.kinetic_temperature']
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to write.
+        logger (hoomd.logging.Logger): The logger to query for output.
+        filename (str): File name to write.
+        buffer_rows (int): Number of rows to keep in memory before writing
+            them to the file.
+        header_sep (str): String to use to separate names in the logger's
+            namespace.
+    """
+
+    _invalid_logger_categories = LoggerCategories.any([
+        'sequence', 'object', 'particle', 'bond', 'angle', 'dihedral',
+        'improper', 'pair', 'constraint', 'string', 'strings'
+    ])
+
+    def __init__(self,
+                 trigger,
+                 logger,
+                 filename,
+                 buffer_rows=1000,
+                 header_sep='.'):
+
+        super().__init__(trigger)
+
+        if (LoggerCategories.scalar not in logger.categories
+                or logger.categories & self._invalid_logger_categories
+                != LoggerCategories.NONE):
+            raise ValueError(
+                "Given Logger must have only the scalar category set.")
+
+        self._param_dict.update(
+            ParameterDict(filename=str(filename),
+                          buffer_rows=int(buffer_rows),
+                          header_sep=str(header_sep)))
+        self._logger = logger
+
+    def _attach(self):
+        self._cpp_obj = _hoomd.BinaryTableWriter(
+            self._simulation.state._cpp_sys_def, self.filename,
+            self.buffer_rows)
+        self._cpp_obj.log_writer = _BinaryTableLogWriter(
+            self._logger, self.header_sep)
+        super()._attach()
+
+    @property
+    def logger(self):
+        """hoomd.logging.Logger: The logger to query for output."""
+        return self._logger
+
+    def flush(self):
+        """Write all buffered rows to the file."""
+        if self._attached:
+            self._cpp_obj.flush()
+
+    @staticmethod
+    def read(filename):
+        """Read a file written by `BinaryTable`.
+
+        Args:
+            filename (str): File name to read.
+
+        Returns:
+            numpy.ndarray: Structured array with one element per row and the
+            fields ``timestep`` and one field per column.
+        """
+        with open(filename, 'rb') as f:
+            if f.read(8) != b'HOOMDTBL':
+                raise RuntimeError(f"{filename} is not a BinaryTable file.")
+            version, n_columns = struct.unpack('<II', f.read(8))
+            if version != 1:
+                raise RuntimeError(
+                    f"Unsupported BinaryTable version {version} in {filename}.")
+
+            names = []
+            for _ in range(n_columns):
+                (length,) = struct.unpack('<I', f.read(4))
+                names.append(f.read(length).decode('utf-8'))
+
+            dtype = np.dtype([('timestep', '<u8')]
+                             + [(name, '<f8') for name in names])
+            return np.fromfile(f, dtype=dtype)
@@ -42,6 +42,10 @@ class GSD(Writer):
             Defaults to ``['property']``.
         log (hoomd.logging.Logger): Provide log quantities to write. Defaults to
             `None`.
+        async_write (bool): When `True`, write frames to the file from a
+            background thread. Defaults to `False`.
+        distributed (bool): When `True`, each MPI rank writes its particles to
+            its own shard file. Defaults to `False`.
 
     `GSD` writes a simulation snapshot to the specified file each time it
     triggers. `GSD` can store all particle, bond, angle, dihedral, improper,
@@ -73,7 +77,9 @@ class GSD(Writer):
     writes non-dynamic quantities only the first frame. When reading a GSD file,
     the data in frame 0 is read when a quantity is missing in frame *i*,
     supplying data that is static over the entire trajectory.  Set the *dynamic*
-    parameter to specify dynamic attributes by category.
+    parameter to specify dynamic attributes by category. `GSD` also omits
+    dynamic per-particle quantities (other than ``particles/position``) from
+    frame *i* when they are identical to the values in frame 0.
 
     Specify the one or more of the following strings in **dynamic** to make the
     corresponding quantities dynamic (**property** is always dynamic):
@@ -112,6 +118,29 @@ class GSD(Writer):
         * constraints/*
         * pairs/*
 
+    When *async_write* is `True`, `GSD` copies each frame into one of two
+    buffers and returns while a background thread writes it to the file. The
+    simulation waits only when both buffers are still being written. Call
+    `flush` before reading the file while the simulation is running.
+
+    When *distributed* is `True`, `GSD` does not gather the particles to the
+    root rank. Each rank writes the selected particles it owns to the shard file
+    ``filename + '.shard<rank>'`` and the root rank writes the frame header,
+    types, topology, and logged quantities to ``filename``, which indexes the
+    shards. `hoomd.Simulation.create_state_from_gsd` merges the shards when
+    reading the file. Particles move between ranks, so the shards store all
+    non-default particle quantities in every frame regardless of *dynamic*.
+    Distributed files can be appended to with at most as many MPI ranks as the
+    run that created them. *async_write* is not supported in distributed mode.
+
+    When *position_precision* is positive, `GSD` rounds each component of
+    ``particles/position`` to the nearest multiple of *position_precision*
+    :math:`[\mathrm{length}]`. The file format is unchanged, but the reduced
+    number of distinct values lets general purpose compressors (such as
+    ``zstd``) shrink archived trajectories considerably. Positions that would
+    round to a point outside the box are written unrounded. A precision of 0
+    (the default) writes positions at full single precision.
+
     See Also:
         See the `GSD documentation <https://gsd.readthedocs.io/>`__, `GSD HOOMD
         Schema <https://gsd.readthedocs.io/en/stable/schema-hoomd.html>`__, and
@@ -141,6 +170,12 @@ class GSD(Writer):
         truncate (bool): When `True`, truncate the file and write a new frame 0
             each time this operation triggers.
         dynamic (list[str]): Quantity categories to save in every frame.
+        async_write (bool): When `True`, write frames to the file from a
+            background thread.
+        distributed (bool): When `True`, each MPI rank writes its particles to
+            its own shard file.
+        position_precision (float): Spacing that position components are
+            rounded to :math:`[\mathrm{length}]`. 0 disables rounding.
     """
 
     def __init__(self,
@@ -150,7 +185,10 @@ class GSD(Writer):
                  mode='ab',
                  truncate=False,
                  dynamic=None,
-                 log=None):
+                 log=None,
+                 async_write=False,
+                 distributed=False,
+                 position_precision=0):
 
         super().__init__(trigger)
 
@@ -165,6 +203,9 @@ class GSD(Writer):
                           mode=str(mode),
                           truncate=bool(truncate),
                           dynamic=[dynamic_validation],
+                          async_write=bool(async_write),
+                          distributed=bool(distributed),
+                          position_precision=float(position_precision),
                           _defaults=dict(filter=filter, dynamic=dynamic)))
 
         self._log = None if log is None else _GSDLogWriter(log)
@@ -194,6 +235,14 @@ class GSD(Writer):
         self._cpp_obj.log_writer = self.log
         super()._attach()
 
+    def flush(self):
+        """Write all buffered frames to the file.
+
+        Has no effect unless `async_write` is `True`.
+        """
+        if self._attached:
+            self._cpp_obj.flush()
+
     @staticmethod
     def write(state, filename, filter=All(), mode='wb', log=None):
         """Write the given simulation state out to a GSD file.
@@ -0,0 +1,64 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Implement Restart."""
+
+from hoomd import _hoomd
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.operation import Writer
+
+
+class Restart(Writer):
+    """Write restart files in the background.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to write.
+        filename (str): Base file name to write. Each MPI rank writes the file
+            ``{filename}.{rank}``.
+
+    `Restart` writes the most recent state of the simulation for use with
+    `hoomd.Simulation.create_state_from_restart`. Each MPI rank copies the
+    particles it owns, the state of the integration methods (such as the
+    thermostat and barostat variables), and the memory sizes of the neighbor
+    and cell lists into a host buffer and a background thread writes the
+    buffer to the rank file while the simulation continues. The particles are
+    not gathered to the root rank. The next write waits for the previous one
+    to complete.
+
+    Each rank file is replaced atomically, so the files always hold a complete
+    restart point once the first write has finished. Call `wait` before
+    reading the files while the simulation is running.
+
+    Note:
+        The files store the particle data and the integrator variables. Bonds
+        and other bonded groups are not stored.
+
+    Examples::
+
+        restart = hoomd.write.Restart(trigger=hoomd.trigger.Periodic(10000),
+                                      filename='restart.bin')
+        sim.operations.writers.append(restart)
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to write.
+        filename (str): Base file name to write.
+    """
+
+    def __init__(self, trigger, filename):
+
+        super().__init__(trigger)
+        self._param_dict.update(ParameterDict(filename=str(filename)))
+
+    def _attach(self):
+        # all ranks write files with the base name given on the root rank
+        filename = _hoomd.mpi_bcast_str(self.filename,
+                                        self._simulation.device._cpp_exec_conf)
+        self._cpp_obj = _hoomd.RestartWriter(
+            self._simulation.state._cpp_sys_def, filename)
+        super()._attach()
+
+    def wait(self):
+        """Wait for the background write to complete."""
+        if self._attached:
+            self._cpp_obj.wait()
@@ -170,7 +170,7 @@ class _TableInternal(_InternalAction):
 
     flags = [
         Action.Flags.ROTATIONAL_KINETIC_ENERGY, Action.Flags.PRESSURE_TENSOR,
-        Action.Flags.EXTERNAL_FIELD_VIRIAL
+        Action.Flags.EXTERNAL_FIELD_VIRIAL, Action.Flags.POTENTIAL_ENERGY
     ]
 
     _skip_for_equality = {"_comm"}